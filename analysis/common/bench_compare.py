@@ -0,0 +1,89 @@
+"""
+Compare two result tables of the rit-scale-bench scenario (`--Output`) and flag the performance
+regressions of the new build.
+
+Rows are matched by node count. For each size the script prints the ratio new/base of the run
+throughput (events per wall-clock second), the setup time, the peak RSS and the resident bytes per
+node, and whether the number of events changed (a MAC/PHY change that alters the simulation, not
+only its speed). A size regresses when its throughput drops, or its setup time, peak RSS or bytes
+per node grow, by more than the tolerance.
+
+Usage:
+    python -m common.bench_compare <base.csv> <new.csv> [--tolerance 0.10]
+
+The exit status is 1 when a size regresses, so the script can gate a build.
+"""
+
+import argparse
+import csv
+import sys
+
+# metric: (label, True if higher is better)
+METRICS = {
+    "events_per_wall_second": ("events/s", True),
+    "setup_seconds": ("setup", False),
+    "peak_rss_kb": ("peak RSS", False),
+    "rss_bytes_per_node": ("B/node", False),
+    "mac_bytes_per_node": ("MAC B/node", False),
+    "teardown_seconds": ("teardown", False),
+}
+
+
+def read_bench(path):
+    """Return {nodes: row} of a rit-scale-bench table."""
+    with open(path, newline="") as f:
+        return {int(row["nodes"]): row for row in csv.DictReader(f)}
+
+
+def compare(base, new, tolerance):
+    """Return the report lines and the sizes that regressed."""
+    lines = []
+    regressed = []
+    header = f"{'nodes':>7}" + "".join(f"{label:>12}" for label, _ in METRICS.values()) + "  events"
+    lines.append(header)
+    for nodes in sorted(set(base) & set(new)):
+        b, n = base[nodes], new[nodes]
+        cells = []
+        worse = False
+        for key, (_, higher_is_better) in METRICS.items():
+            if not b.get(key) or not n.get(key):
+                # column added after one of the two builds
+                cells.append(f"{'n/a':>12}")
+                continue
+            old_value, new_value = float(b[key]), float(n[key])
+            if old_value <= 0:
+                cells.append(f"{'n/a':>12}")
+                continue
+            ratio = new_value / old_value
+            change = (1 - ratio) if higher_is_better else (ratio - 1)
+            worse = worse or change > tolerance
+            cells.append(f"{ratio:>11.3f}x")
+        events = "same" if b["events"] == n["events"] else f"{b['events']} -> {n['events']}"
+        flag = "  REGRESSION" if worse else ""
+        lines.append(f"{nodes:>7}" + "".join(cells) + f"  {events}{flag}")
+        if worse:
+            regressed.append(nodes)
+    missing = sorted(set(base) ^ set(new))
+    if missing:
+        lines.append(f"sizes in only one table: {', '.join(map(str, missing))}")
+    return lines, regressed
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare two rit-scale-bench tables")
+    parser.add_argument("base", help="table of the reference build")
+    parser.add_argument("new", help="table of the build under test")
+    parser.add_argument("--tolerance", type=float, default=0.10,
+                        help="relative change tolerated before a regression (default 0.10)")
+    args = parser.parse_args()
+
+    lines, regressed = compare(read_bench(args.base), read_bench(args.new), args.tolerance)
+    print("\n".join(lines))
+    if regressed:
+        print(f"[BENCH] regression at {', '.join(map(str, regressed))} nodes")
+        sys.exit(1)
+    print("[BENCH] no regression")
+
+
+if __name__ == "__main__":
+    main()
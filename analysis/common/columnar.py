@@ -0,0 +1,224 @@
+"""
+Columnar (Parquet / Arrow IPC) store for the per-node trace logs of a run.
+
+`export_run()` converts the logs of a run directory (binary `*.bin` traces, consolidated
+`trace-NN.*` files or plain `node-*/<log>.csv` files) into one table per log type:
+
+    <run dir>/columnar/<log>.parquet   (or <log>.arrow for Arrow IPC / Feather v2)
+
+Every table has a `node` column, typed numeric columns and dictionary-encoded string
+columns (event, frame type, state, addresses). Rows are sorted by (node, time) and
+written in row groups, so `read_table()` filters on node and time window are pushed
+down to the file reader instead of parsing every row. `io_utils.read_log()` uses the
+table transparently when it exists.
+
+Usage:
+    python -m common.columnar <run dir> [<run dir> ...] [--format parquet|arrow] [--remove-raw]
+"""
+
+import argparse
+from pathlib import Path
+
+import pandas as pd
+
+from common import trace_decoder
+
+COLUMNAR_DIR = "columnar"
+ROW_GROUP_SIZE = 64 * 1024
+
+# Column names of each per-node log, in file order
+LOG_COLUMNS = {
+    "app-txlog.csv": ["time", "uid"],
+    "app-rxlog.csv": ["time", "uid"],
+    "app-hoplatency.csv": ["time", "uid", "hop", "addr", "nwkEnqueue", "macQueueHead",
+                           "beaconWaitStart", "beaconRx", "csStart", "csEnd", "phyTxStart"],
+    "mac-statelog.csv": ["time", "state"],
+    "mac-mode.csv": ["time", "mode"],
+    "mac-txlog.csv": ["time", "event", "frameType", "src", "dst"],
+    "mac-rxlog.csv": ["time", "event", "frameType", "src", "dst"],
+    "mac-beacon-wait.csv": ["time", "event"],
+    "mac-data-wait.csv": ["time", "event"],
+    "nwk-txlog.csv": ["time", "event", "src", "dst", "uid"],
+    "nwk-rxlog.csv": ["time", "event", "src", "dst", "uid"],
+    "phy-statelog.csv": ["time", "state"],
+    "phy-txlog.csv": ["time", "event", "addr"],
+    "phy-rxlog.csv": ["time", "event", "addr", "val"],
+    "phy-dutycycle.csv": ["time", "trxOff", "rxOn", "busyRx", "txOn", "busyTx"],
+    "energy-node.log": ["time", "energy"],
+}
+
+# Columns stored as dictionary-encoded strings; everything else is numeric
+STRING_COLUMNS = {"event", "frameType", "state", "mode", "src", "dst", "addr"}
+
+FORMAT_SUFFIX = {"parquet": ".parquet", "arrow": ".arrow"}
+
+
+def _import_pyarrow():
+    try:
+        import pyarrow  # noqa: F401
+        import pyarrow.dataset  # noqa: F401
+    except ImportError as e:
+        raise ImportError("the columnar store needs pyarrow (pip install pyarrow)") from e
+    return pyarrow
+
+
+def table_path(run_dir, log_name):
+    """Return the columnar table of a log in a run directory, or None if there is none."""
+    base = Path(run_dir) / COLUMNAR_DIR / Path(log_name).stem
+    for suffix in FORMAT_SUFFIX.values():
+        path = base.with_suffix(suffix)
+        if path.exists():
+            return path
+    return None
+
+
+def _typed_frame(rows, columns):
+    """Build a typed DataFrame from (node, fields...) string rows."""
+    df = pd.DataFrame(rows, columns=["node"] + columns)
+    df["node"] = pd.to_numeric(df["node"], errors="coerce").astype("uint32")
+    for col in columns:
+        if col in STRING_COLUMNS:
+            df[col] = df[col].fillna("").astype("category")
+        else:
+            df[col] = pd.to_numeric(df[col], errors="coerce")
+    return df.sort_values(["node", "time"], kind="stable").reset_index(drop=True)
+
+
+def _collect_rows(run_dir):
+    """Return {log name: [(node, fields...)]} for every log of a run."""
+    run_dir = Path(run_dir)
+    rows = {}
+    traced = set()  # (node, log) already read from a binary / consolidated trace
+
+    def add(node, log_name, line):
+        columns = LOG_COLUMNS.get(log_name)
+        if columns is None:
+            return
+        traced.add((str(node), log_name))
+        fields = line.split(",")
+        # Pad / trim like pd.read_csv(names=...) (e.g. the trailing comma of RxEnd)
+        fields = (fields + [None] * len(columns))[:len(columns)]
+        rows.setdefault(log_name, []).append([node] + fields)
+
+    # Binary traces: decode in memory, no intermediate CSV
+    for bin_path in sorted(run_dir.rglob("*.bin")):
+        log_id, node_id, records = trace_decoder.read_binary_trace(bin_path)
+        for rec in records:
+            rec_log = rec["flags"] >> trace_decoder.LOG_ID_SHIFT if log_id == trace_decoder.LOG_MIXED \
+                else log_id
+            line = trace_decoder.format_row(rec_log, rec)
+            if line is not None:
+                node = rec["node"] if log_id == trace_decoder.LOG_MIXED else node_id
+                add(node, trace_decoder.LOG_FILE_NAMES[rec_log], line)
+
+    # Consolidated ASCII traces: <node>,<log>,<line>
+    for csv_path in sorted(run_dir.glob("trace-*.csv")):
+        with open(csv_path, encoding="utf-8") as f:
+            for raw in f:
+                parts = raw.rstrip("\n").split(",", 2)
+                if len(parts) == 3:
+                    add(parts[0], parts[1], parts[2])
+
+    # Plain per-node ASCII logs (skipping CSVs decoded from a trace read above)
+    decoded = set(traced)
+    for node_dir in sorted(run_dir.glob("node-*")):
+        node = node_dir.name[len("node-"):]
+        for log_name in LOG_COLUMNS:
+            path = node_dir / log_name
+            if not path.exists() or (node, log_name) in decoded:
+                continue
+            with open(path, encoding="utf-8") as f:
+                for raw in f:
+                    line = raw.rstrip("\n")
+                    if line:
+                        add(node, log_name, line)
+    return rows
+
+
+def export_run(run_dir, fmt="parquet"):
+    """Write one columnar table per log type of a run. Returns the written paths."""
+    pa = _import_pyarrow()
+    if fmt not in FORMAT_SUFFIX:
+        raise ValueError(f"unknown columnar format {fmt!r}")
+    out_dir = Path(run_dir) / COLUMNAR_DIR
+    out_dir.mkdir(parents=True, exist_ok=True)
+
+    written = []
+    for log_name, rows in _collect_rows(run_dir).items():
+        table = pa.Table.from_pandas(_typed_frame(rows, LOG_COLUMNS[log_name]),
+                                     preserve_index=False)
+        path = out_dir / (Path(log_name).stem + FORMAT_SUFFIX[fmt])
+        if fmt == "parquet":
+            import pyarrow.parquet as pq
+            pq.write_table(table, path, row_group_size=ROW_GROUP_SIZE)
+        else:
+            import pyarrow.feather as feather
+            feather.write_feather(table, path, chunksize=ROW_GROUP_SIZE)
+        written.append(path)
+    return written
+
+
+def read_table(run_dir, log_name, nodes=None, t0=None, t1=None, columns=None):
+    """
+    Read a log of a run from its columnar table with predicate pushdown.
+
+    Args:
+        run_dir: Run directory holding `columnar/`
+        log_name: Log file name (e.g. "mac-txlog.csv")
+        nodes: Node id or list of node ids to keep (None = all)
+        t0, t1: Keep rows with t0 <= time < t1 (None = unbounded)
+        columns: Columns to load (None = all)
+    Returns:
+        pandas.DataFrame, or None if the run has no table for this log
+    """
+    _import_pyarrow()
+    import pyarrow.dataset as ds
+
+    path = table_path(run_dir, log_name)
+    if path is None:
+        return None
+    dataset = ds.dataset(path, format="parquet" if path.suffix == ".parquet" else "ipc")
+
+    expr = None
+
+    def conj(a, b):
+        return b if a is None else a & b
+
+    if nodes is not None:
+        ids = [int(n) for n in (nodes if isinstance(nodes, (list, tuple, set)) else [nodes])]
+        expr = conj(expr, ds.field("node").isin(ids))
+    if t0 is not None:
+        expr = conj(expr, ds.field("time") >= t0)
+    if t1 is not None:
+        expr = conj(expr, ds.field("time") < t1)
+    return dataset.to_table(columns=columns, filter=expr).to_pandas()
+
+
+def remove_raw_logs(run_dir):
+    """Remove the converted logs (node-*/<log>, *.bin, trace-*) once the tables are written."""
+    run_dir = Path(run_dir)
+    for path in run_dir.glob("trace-*"):
+        path.unlink()
+    for node_dir in run_dir.glob("node-*"):
+        for path in node_dir.iterdir():
+            if path.name in LOG_COLUMNS or path.suffix == ".bin":
+                path.unlink()
+        # The node-* directories stay, even empty: the notebooks list them to find the nodes
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert RIT trace logs into columnar tables")
+    parser.add_argument("run_dirs", nargs="+", help="Run directories (e.g. .../SEED01)")
+    parser.add_argument("--format", choices=sorted(FORMAT_SUFFIX), default="parquet")
+    parser.add_argument("--remove-raw", action="store_true",
+                        help="Delete node-* and trace-* files after conversion")
+    args = parser.parse_args()
+    for run_dir in args.run_dirs:
+        paths = export_run(run_dir, args.format)
+        if args.remove_raw:
+            remove_raw_logs(run_dir)
+        print(f"[COLUMNAR] {len(paths)} tables written under {Path(run_dir) / COLUMNAR_DIR}")
+
+
+if __name__ == "__main__":
+    main()
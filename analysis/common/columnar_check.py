@@ -0,0 +1,185 @@
+"""
+Check the columnar store (common.columnar) against the CSV logs it replaces, on a trace tree.
+
+Every run of the tree is copied twice into a scratch directory: one copy keeps its CSV logs,
+the other is exported with `export_run()` and its raw logs removed with `remove_raw_logs()`,
+once per format. Then:
+
+- `io_utils.read_log()` must give the same rows for every node and log from the table as
+  from the CSV, and fail where `pd.read_csv()` fails (missing or empty log);
+- `read_table()` with a node subset and a time window must give the rows of the whole
+  table that match the filter;
+- the string columns must be dictionary-encoded in the files;
+- the pandas summaries of multi_run_analysis.ipynb (summary_check.python_summaries) must
+  be the same on both copies.
+
+The default tree is common/testdata/summary-tree (see summary_check.py).
+
+Usage:
+    python -m common.columnar_check [<tree>] [--format parquet,arrow]
+
+The exit status is 1 when a check fails, so the script can gate a change of the store.
+"""
+
+import argparse
+import math
+import shutil
+import sys
+import tempfile
+from pathlib import Path
+
+from common.summary_check import (
+    DEFAULT_TREE,
+    SUMMARY_FILES,
+    compare_csv,
+    find_runs,
+    python_summaries,
+)
+
+
+def _field(value):
+    """A field as text, with the missing values of both loaders ("", NaN, None) alike."""
+    if value is None or value == "":
+        return ""
+    if isinstance(value, float) and math.isnan(value):
+        return ""
+    try:
+        return repr(float(value))
+    except (TypeError, ValueError):
+        return str(value)
+
+
+def _rows(df):
+    """The rows of a frame as tuples of _field()."""
+    return [tuple(_field(v) for v in row) for row in df.astype(object).itertuples(index=False)]
+
+
+def _read(node, log_name, columns, run_dir):
+    """read_log() of a node, None if it fails."""
+    from common.io_utils import read_log
+
+    try:
+        return read_log(node, log_name, columns, str(run_dir.parent), run_dir.name)
+    except Exception:  # noqa: BLE001 (same net as the aggregate_* functions)
+        return None
+
+
+def check_loader(csv_run, columnar_run):
+    """Differences of read_log() between the CSV and the columnar copy of a run."""
+    from common.columnar import LOG_COLUMNS
+
+    diffs = []
+    nodes = sorted(int(d.name.split("-")[1]) for d in csv_run.glob("node-*") if d.is_dir())
+    for node in nodes:
+        for log_name, columns in LOG_COLUMNS.items():
+            if not (csv_run / f"node-{node}" / log_name).exists():
+                continue
+            want = _read(node, log_name, columns, csv_run)
+            got = _read(node, log_name, columns, columnar_run)
+            if want is None or got is None:
+                if (want is None) != (got is None):
+                    diffs.append(f"node-{node}/{log_name}: read "
+                                 f"{'fails' if want is None else 'works'} on the CSV only")
+                continue
+            want_rows, got_rows = _rows(want), _rows(got)
+            if len(want_rows) != len(got_rows):
+                diffs.append(f"node-{node}/{log_name}: rows {len(want_rows)} | {len(got_rows)}")
+                continue
+            for i, (w, g) in enumerate(zip(want_rows, got_rows)):
+                if w != g:
+                    diffs.append(f"node-{node}/{log_name} row {i}: {w} | {g}")
+                    break
+    return diffs
+
+
+def check_pushdown(columnar_run):
+    """Differences of read_table() filters from the same filter applied to the whole table."""
+    import pyarrow.dataset as ds
+    import pyarrow.types as pat
+
+    from common.columnar import LOG_COLUMNS, STRING_COLUMNS, read_table, table_path
+
+    diffs = []
+    for log_name in LOG_COLUMNS:
+        path = table_path(columnar_run, log_name)
+        if path is None:
+            continue
+        schema = ds.dataset(path, format="parquet" if path.suffix == ".parquet" else "ipc").schema
+        for name in STRING_COLUMNS & set(schema.names):
+            if not pat.is_dictionary(schema.field(name).type):
+                diffs.append(f"{path.name}: {name} is {schema.field(name).type}, not a dictionary")
+
+        full = read_table(columnar_run, log_name)
+        if full.empty:
+            continue
+        ids = sorted(full["node"].unique())[:2]
+        t_min, t_max = full["time"].min(), full["time"].max()
+        t0, t1 = t_min + (t_max - t_min) / 4, t_min + 3 * (t_max - t_min) / 4
+        want = full[full["node"].isin(ids) & (full["time"] >= t0) & (full["time"] < t1)]
+        got = read_table(columnar_run, log_name, nodes=[int(n) for n in ids], t0=t0, t1=t1)
+        if _rows(want) != _rows(got):
+            diffs.append(f"{path.name}: nodes {list(ids)}, [{t0:g}, {t1:g}): "
+                         f"{len(want)} rows filtered | {len(got)} pushed down")
+        node_only = read_table(columnar_run, log_name, nodes=int(ids[0]))
+        if _rows(node_only) != _rows(full[full["node"] == ids[0]]):
+            diffs.append(f"{path.name}: rows of node {ids[0]} differ")
+    return diffs
+
+
+def check_summaries(csv_run, columnar_run):
+    """Differences of the pandas summaries of the two copies of a run."""
+    python_summaries(csv_run)
+    python_summaries(columnar_run)
+    diffs = []
+    for name in SUMMARY_FILES:
+        for diff in compare_csv(csv_run / "summary" / name, columnar_run / "summary" / name):
+            diffs.append(f"{name}: {diff}")
+    return diffs
+
+
+def check(args):
+    try:
+        import pandas  # noqa: F401
+        import pyarrow  # noqa: F401
+    except ImportError:
+        print("pandas and pyarrow are needed (analysis dev shell, flake.nix)")
+        return 2
+
+    from common.columnar import export_run, remove_raw_logs
+
+    tree = Path(args.tree).resolve()
+    runs = [r.relative_to(tree) for r in find_runs(tree)]
+    if not runs:
+        print(f"No run below {tree}")
+        return 2
+
+    failed = False
+    with tempfile.TemporaryDirectory() as scratch:
+        for fmt in args.format.split(","):
+            for run in runs:
+                csv_run = Path(scratch) / fmt / "csv" / run
+                columnar_run = Path(scratch) / fmt / "columnar" / run
+                shutil.copytree(tree / run, csv_run)
+                shutil.copytree(tree / run, columnar_run)
+                paths = export_run(columnar_run, fmt)
+                remove_raw_logs(columnar_run)
+                print(f"{fmt}: {run}: {len(paths)} tables")
+                for label, diffs in [("read_log", check_loader(csv_run, columnar_run)),
+                                     ("read_table", check_pushdown(columnar_run)),
+                                     ("summaries", check_summaries(csv_run, columnar_run))]:
+                    for diff in diffs:
+                        print(f"  {label}: {diff}")
+                        failed = True
+    print("columnar store differs" if failed else "columnar store matches")
+    return 1 if failed else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("tree", nargs="?", default=str(DEFAULT_TREE), help="Trace tree")
+    parser.add_argument("--format", default="parquet,arrow", help="Formats to check")
+    return check(parser.parse_args())
+
+
+if __name__ == "__main__":
+    sys.exit(main())
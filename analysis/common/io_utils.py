@@ -43,11 +43,43 @@ def read_log(node, filename, columns, base_dir, parameter_dir):
     """
     # import os
     # import pandas as pd
-    path = os.path.join(base_dir, parameter_dir, f"node-{node}", filename)
+    run_dir = os.path.join(base_dir, parameter_dir)
+    df = _read_columnar_log(run_dir, node, filename, columns)
+    if df is not None:
+        return df
+    path = os.path.join(run_dir, f"node-{node}", filename)
     # TODO: Add handling for corrupted/broken data
     return pd.read_csv(path, header=None, names=columns, on_bad_lines='skip')
 
 
+def _read_columnar_log(run_dir, node, filename, columns):
+    """Read a node's log from the columnar store of the run (common.columnar), None if absent."""
+    from common import columnar  # lazy: columnar imports pyarrow
+
+    if columnar.table_path(run_dir, filename) is None:
+        return None
+    df = columnar.read_table(run_dir, filename, nodes=node).drop(columns="node")
+    if df.empty:
+        # pd.read_csv() fails on the missing or empty CSV of such a node; the summaries skip it
+        raise pd.errors.EmptyDataError(f"No {filename} rows of node {node} in {run_dir}")
+    # Same positional naming as pd.read_csv(names=columns)
+    df = df.iloc[:, :len(columns)]
+    df.columns = columns
+    return df.reset_index(drop=True)
+
+
+def log_exists(node, filename, base_dir, parameter_dir):
+    """Return True if a node's log exists as a CSV or in the columnar store of the run."""
+    run_dir = os.path.join(base_dir, parameter_dir)
+    if os.path.exists(os.path.join(run_dir, f"node-{node}", filename)):
+        return True
+    from common import columnar
+
+    if columnar.table_path(run_dir, filename) is None:
+        return False
+    return not columnar.read_table(run_dir, filename, nodes=node, columns=["node"]).empty
+
+
 def find_node_dirs(base_dir, scenario_type, module_name, parameter_dir):
     """
     Get a list of node directories using a wildcard search.
@@ -0,0 +1,83 @@
+"""
+Merge and query the end-to-end delay sketches written by the sink applications
+(`RitWpanNetHelper::EnableDelaySketchPerNode()`, `node-*/app-delay-sketch.csv`).
+
+Each file holds cumulative snapshots as `time,lower_ns,upper_ns,count` rows; only the
+last snapshot of a file is used. Buckets are identical for every run (see
+rit-wpan/model/rit-latency-sketch.h), so merging is a per-bucket sum.
+
+Usage:
+    python -m common.latency_sketch <log dir> [<log dir> ...] [-q 0.5 0.95 0.99]
+"""
+
+import argparse
+from collections import defaultdict
+from pathlib import Path
+
+from common.log_constants import APP_DELAY_SKETCH
+
+
+def read_sketch(path):
+    """Return {(lower_ns, upper_ns): count} of the last snapshot of a sketch file."""
+    snapshots = defaultdict(dict)
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if not line:
+                continue
+            time, lower, upper, count = line.split(",")
+            snapshots[float(time)][(int(lower), int(upper))] = int(count)
+    if not snapshots:
+        return {}
+    return snapshots[max(snapshots)]
+
+
+def merge_sketches(sketches):
+    """Sum the bucket counts of several sketches."""
+    merged = defaultdict(int)
+    for sketch in sketches:
+        for bucket, count in sketch.items():
+            merged[bucket] += count
+    return dict(merged)
+
+
+def find_sketch_files(log_dirs):
+    """Find every sketch file below the given run (or sweep) directories."""
+    files = []
+    for log_dir in log_dirs:
+        files.extend(sorted(Path(log_dir).rglob(APP_DELAY_SKETCH)))
+    return files
+
+
+def quantile(sketch, q):
+    """Approximate q-quantile in seconds (bucket midpoint), None if the sketch is empty."""
+    total = sum(sketch.values())
+    if total == 0:
+        return None
+    rank = max(1, int(-(-q * total // 1)))
+    seen = 0
+    for (lower, upper), count in sorted(sketch.items()):
+        seen += count
+        if seen >= rank:
+            return (lower + (upper - lower) // 2) * 1e-9
+    lower, upper = max(sketch)
+    return upper * 1e-9
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Merge delay sketches and print quantiles")
+    parser.add_argument("log_dirs", nargs="+", help="run or sweep directories")
+    parser.add_argument("-q", "--quantiles", nargs="+", type=float, default=[0.5, 0.95, 0.99])
+    args = parser.parse_args()
+
+    files = find_sketch_files(args.log_dirs)
+    merged = merge_sketches(read_sketch(path) for path in files)
+    print(f"files,{len(files)}")
+    print(f"count,{sum(merged.values())}")
+    for q in args.quantiles:
+        value = quantile(merged, q)
+        print(f"p{q * 100:g},{'nan' if value is None else value}")
+
+
+if __name__ == "__main__":
+    main()
@@ -13,9 +13,12 @@ MAC_LOG_FILES = {
 
 PHY_LOG_FILES = {
     "state": "phy-statelog.csv",
+    "duty_cycle": "phy-dutycycle.csv",
     "tx_drop": "phy-txdroplog.csv",
     "rx_drop": "phy-rxdroplog.csv"
 }
 
 APP_TXLOG = "app-txlog.csv"
 APP_RXLOG = "app-rxlog.csv"
+APP_HOPLATENCYLOG = "app-hoplatency.csv"
+APP_DELAY_SKETCH = "app-delay-sketch.csv"
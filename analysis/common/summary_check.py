@@ -0,0 +1,369 @@
+"""
+Check the summaries of the native rit-log-summarize scenario (RitLogSummarizer) against the
+pandas ones of summary_utils.py / aggregate_utils.py on a trace tree, and time both.
+
+The tree is copied into a scratch directory once per summarizer. The pandas side runs the
+post-processing of multi_run_analysis.ipynb (process_simulation_statistics) on every run; the
+native side runs `rit-log-summarize --Overwrite=1` once per thread count. The four
+<run>/summary/*.csv files must have the same columns and rows; a field matches when its text
+is the same, or when both are floats within a relative 1e-12 (last-digit differences of the
+standard deviations). The wall time of each summarizer and the speedup of each thread count
+over the first one are printed.
+
+The default tree is common/testdata/summary-tree, a small run in the ASCII trace format of
+RitWpanNetHelper written by `--generate` (two seeds of five nodes: a sink, duty cycle and
+state-log PHY traces, dropped and duplicated packets, and a node without MAC logs). Larger
+trees for the scaling figures come from `--generate` with more nodes or a longer duration.
+
+Usage:
+    python -m common.summary_check --native <rit-log-summarize binary> [<tree>] [--threads 1,8]
+    python -m common.summary_check --ns3 <ns-3 directory> [<tree>] [--threads 1,8]
+    python -m common.summary_check --generate <tree> [--nodes 5] [--seeds 2] [--duration 300]
+
+The exit status is 1 when a summary differs, so the script can gate a build.
+"""
+
+import argparse
+import csv
+import math
+import os
+import random
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+from pathlib import Path
+
+SUMMARY_FILES = ["app_summary.csv", "mac_summary.csv", "phy_summary.csv", "scenario_summary.csv"]
+DEFAULT_TREE = Path(__file__).resolve().parent / "testdata" / "summary-tree"
+RUN_DIR = "default/rit-wpan/BI1000_TWD5000_DWD10_Days1"
+REL_TOL = 1e-12
+
+
+def find_runs(root):
+    """Return the runs of a tree (directories with a node-N directory), sorted."""
+    root = Path(root)
+    runs = {p.parent for p in root.rglob("node-*") if p.is_dir()}
+    return sorted(runs)
+
+
+# ---------------------------------------------------------------------------------------------
+# Pandas summaries (multi_run_analysis.ipynb)
+# ---------------------------------------------------------------------------------------------
+
+
+def python_summaries(run_dir, app_recv_node=0):
+    """Write <run>/summary/ as process_simulation_statistics() of the notebook does."""
+    import pandas as pd
+
+    from common.aggregate_utils import (
+        aggregate_app_summary,
+        aggregate_mac_summary,
+        aggregate_phy_summary,
+        aggregate_scenario_summary,
+    )
+    from common.log_constants import APP_RXLOG, APP_TXLOG, MAC_LOG_FILES
+
+    run_dir = Path(run_dir)
+    base_dir, parameter_dir = str(run_dir.parent), run_dir.name
+    existing_nodes = []
+    for item in os.listdir(run_dir):
+        if item.startswith("node-") and (run_dir / item).is_dir():
+            try:
+                existing_nodes.append(int(item.split("-")[1]))
+            except (ValueError, IndexError):
+                continue
+    existing_nodes.sort()
+    send_nodes = [n for n in existing_nodes if n != app_recv_node]
+
+    summary_dir = run_dir / "summary"
+    summary_dir.mkdir(exist_ok=True)
+    app = aggregate_app_summary(send_nodes, app_recv_node, APP_TXLOG, APP_RXLOG,
+                                base_dir, parameter_dir)
+    app.to_csv(summary_dir / "app_summary.csv", index=False)
+    mac = aggregate_mac_summary(existing_nodes, MAC_LOG_FILES, base_dir, parameter_dir)
+    mac.to_csv(summary_dir / "mac_summary.csv", index=False)
+    phy = aggregate_phy_summary(existing_nodes, base_dir, parameter_dir)
+    phy.to_csv(summary_dir / "phy_summary.csv", index=False)
+    scenario = pd.DataFrame([aggregate_scenario_summary(app, phy)])
+    scenario.to_csv(summary_dir / "scenario_summary.csv", index=False)
+
+
+# ---------------------------------------------------------------------------------------------
+# Comparison
+# ---------------------------------------------------------------------------------------------
+
+
+def _is_float(text):
+    try:
+        float(text)
+    except ValueError:
+        return False
+    return "." in text or "e" in text or "n" in text
+
+
+def _same_field(a, b):
+    if a == b:
+        return True
+    if _is_float(a) and _is_float(b):
+        return math.isclose(float(a), float(b), rel_tol=REL_TOL, abs_tol=0.0)
+    return False
+
+
+def compare_csv(expected, actual):
+    """Return the differences of two summary files, empty when they match."""
+    with open(expected, newline="") as f:
+        want = list(csv.reader(f))
+    with open(actual, newline="") as f:
+        got = list(csv.reader(f))
+    if not want or not got:
+        return [] if want == got else ["one of the files is empty"]
+    if want[0] != got[0]:
+        return [f"columns: {','.join(want[0])} | {','.join(got[0])}"]
+    diffs = []
+    if len(want) != len(got):
+        diffs.append(f"rows: {len(want) - 1} | {len(got) - 1}")
+    for i, (w, g) in enumerate(zip(want[1:], got[1:]), start=1):
+        for column, a, b in zip(want[0], w, g):
+            if not _same_field(a, b):
+                diffs.append(f"row {i} {column}: {a!r} | {b!r}")
+        if len(w) != len(g):
+            diffs.append(f"row {i}: {len(w)} | {len(g)} fields")
+    return diffs
+
+
+def native_command(args, logs, threads):
+    """Command line of one native summary of a tree."""
+    options = f"--Logs={logs} --Threads={threads} --Overwrite=1"
+    if args.native:
+        return [args.native] + options.split()
+    return [str(Path(args.ns3) / "ns3"), "run", "--no-build", f"rit-log-summarize {options}"]
+
+
+def check(args):
+    try:
+        import pandas  # noqa: F401
+    except ImportError:
+        print("pandas is needed for the reference summaries (analysis dev shell, flake.nix)")
+        return 2
+
+    tree = Path(args.tree).resolve()
+    runs = [r.relative_to(tree) for r in find_runs(tree)]
+    if not runs:
+        print(f"No run below {tree}")
+        return 2
+    threads = [int(t) for t in args.threads.split(",")]
+    log_bytes = sum(p.stat().st_size for p in tree.rglob("node-*/*") if p.is_file())
+
+    failed = False
+    with tempfile.TemporaryDirectory() as scratch:
+        reference = Path(scratch) / "pandas"
+        shutil.copytree(tree, reference)
+        start = time.perf_counter()
+        for run in runs:
+            python_summaries(reference / run)
+        pandas_seconds = time.perf_counter() - start
+        print(f"pandas: {len(runs)} runs, {log_bytes / 1e6:.2f} MB in {pandas_seconds:.2f} s")
+
+        first_seconds = None
+        for n in threads:
+            native = Path(scratch) / f"native-{n}"
+            shutil.copytree(tree, native)
+            start = time.perf_counter()
+            subprocess.run(native_command(args, native, n), check=True,
+                           stdout=subprocess.DEVNULL)
+            seconds = time.perf_counter() - start
+            first_seconds = first_seconds or seconds
+            print(f"native, {n} threads: {seconds:.2f} s | {pandas_seconds / seconds:.1f}x pandas"
+                  f" | {first_seconds / seconds:.2f}x {threads[0]} threads")
+            for run in runs:
+                for name in SUMMARY_FILES:
+                    want = reference / run / "summary" / name
+                    got = native / run / "summary" / name
+                    if not got.exists():
+                        print(f"  {run}/{name}: not written")
+                        failed = True
+                        continue
+                    for diff in compare_csv(want, got):
+                        print(f"  {run}/{name}: {diff}")
+                        failed = True
+    print("summaries differ" if failed else "summaries match")
+    return 1 if failed else 0
+
+
+# ---------------------------------------------------------------------------------------------
+# Trace tree
+# ---------------------------------------------------------------------------------------------
+
+
+def _t(seconds):
+    """A time as Simulator::Now().GetSeconds() is streamed (6 significant digits)."""
+    return f"{seconds:g}"
+
+
+def _addr(node):
+    return f"00:{node:02x}"
+
+
+class _Node:
+    """Per-node logs of a generated run."""
+
+    def __init__(self, node_id):
+        self.id = node_id
+        self.logs = {name: [] for name in [
+            "app-txlog.csv", "app-rxlog.csv", "mac-txlog.csv", "mac-rxlog.csv",
+            "mac-beacon-wait.csv", "mac-data-wait.csv", "mac-statelog.csv",
+            "phy-txlog.csv", "phy-rxlog.csv", "phy-statelog.csv", "phy-dutycycle.csv"]}
+
+    def add(self, name, t, *fields):
+        self.logs[name].append((t, ",".join([_t(t)] + [str(f) for f in fields])))
+
+
+def _generate_run(run_dir, nodes, duration, rng, missing_mac_node):
+    """Write a run: node 0 the sink, the others sending each minute over one hop."""
+    sink = _Node(0)
+    routers = [_Node(i) for i in range(1, nodes)]
+    uid = 1000
+    for node in [sink] + routers:
+        node.add("mac-statelog.csv", 0.0, "MAC IDLE")
+        node.add("phy-statelog.csv", 0.0, "RX_ON" if node.id == 0 else "TRX_OFF")
+    for router in routers:
+        t = rng.uniform(1.0, 60.0)
+        while t < duration - 10:
+            uid += 1 + rng.randrange(3)
+            router.add("app-txlog.csv", t, uid)
+            # RIT: wait for a beacon of the sink, then the data frame and its ACK
+            router.add("mac-beacon-wait.csv", t, "start")
+            router.add("mac-statelog.csv", t, "CSMA")
+            router.add("phy-statelog.csv", t, "RX_ON")
+            if rng.random() < 0.05:
+                end = t + 5.0
+                router.add("mac-beacon-wait.csv", end, "timeout")
+                router.add("mac-txlog.csv", end, "TxDrop", "Data", _addr(router.id), "00:00")
+                router.add("mac-statelog.csv", end, "MAC IDLE")
+                router.add("phy-statelog.csv", end, "TRX_OFF")
+                t += rng.uniform(50.0, 70.0)
+                continue
+            beacon = t + rng.uniform(0.01, 1.0)
+            router.add("mac-beacon-wait.csv", beacon, "end")
+            router.add("mac-rxlog.csv", beacon, "RxOk", "Multipurpose", "00:00", "ff:ff")
+            router.add("phy-rxlog.csv", beacon, "RxEnd", "00:00", "")
+            router.add("phy-statelog.csv", beacon, "TX_ON")
+            tx = beacon + 0.002
+            router.add("mac-statelog.csv", tx, "SENDING")
+            router.add("phy-statelog.csv", tx, "BUSY_TX")
+            router.add("mac-txlog.csv", tx, "Tx", "Data", _addr(router.id), "00:00")
+            router.add("phy-txlog.csv", tx + 0.001, "TxEnd", "00:00")
+            if rng.random() < 0.08:
+                router.add("phy-txlog.csv", tx + 0.001, "TxDrop", "00:00")
+                router.add("mac-txlog.csv", tx + 0.005, "TxDrop", "Data", _addr(router.id),
+                           "00:00")
+            else:
+                rx = tx + 0.0015
+                sink.add("mac-rxlog.csv", rx, "RxOk", "Data", _addr(router.id), "00:00")
+                sink.add("phy-rxlog.csv", rx, "RxEnd", _addr(router.id), "")
+                sink.add("mac-txlog.csv", rx + 0.0002, "Tx", "Ack", "ff:ff", _addr(router.id))
+                router.add("mac-rxlog.csv", rx + 0.0006, "RxOk", "Ack", "ff:ff", "ff:ff")
+                router.add("mac-txlog.csv", rx + 0.0006, "TxOk", "Data", _addr(router.id),
+                           "00:00")
+                delivered = rx + rng.uniform(0.0, 0.05)
+                sink.add("app-rxlog.csv", delivered, uid)
+                if rng.random() < 0.03:
+                    sink.add("app-rxlog.csv", delivered + 1.5, uid)
+            # A retransmitted UID of the application, delivered or not
+            if rng.random() < 0.03:
+                router.add("app-txlog.csv", tx + 2.0, uid)
+            idle = tx + 0.01
+            router.add("mac-statelog.csv", idle, "MAC IDLE")
+            router.add("phy-statelog.csv", idle, "TRX_OFF")
+            t += rng.uniform(55.0, 65.0)
+    # Beacons of the sink each second, a data wait after each, commands now and then
+    for k in range(1, int(duration)):
+        t = k + rng.uniform(-0.01, 0.01)
+        sink.add("mac-txlog.csv", t, "Tx", "Multipurpose", "00:00", "ff:ff")
+        sink.add("mac-txlog.csv", t + 0.001, "TxOk", "Multipurpose", "00:00", "ff:ff")
+        sink.add("phy-txlog.csv", t + 0.001, "TxEnd", "ff:ff")
+        sink.add("mac-data-wait.csv", t + 0.001, "start")
+        sink.add("mac-data-wait.csv", t + 0.011, "timeout" if rng.random() < 0.9 else "end")
+        if rng.random() < 0.02:
+            sink.add("mac-txlog.csv", t + 0.3, "Tx", "Command", "00:00", _addr(1))
+            sink.add("mac-txlog.csv", t + 0.31, "TxDrop" if rng.random() < 0.5 else "TxOk",
+                     "Command", "00:00", _addr(1))
+        if rng.random() < 0.01:
+            sink.add("phy-rxlog.csv", t + 0.5, "RxDrop", "")
+    sink.add("mac-statelog.csv", duration, "MAC IDLE")
+    sink.add("phy-statelog.csv", duration, "RX_ON")
+    for router in routers:
+        router.add("mac-statelog.csv", duration, "MAC IDLE")
+        router.add("phy-statelog.csv", duration, "TRX_OFF")
+
+    for node in [sink] + routers:
+        node_dir = run_dir / f"node-{node.id}"
+        node_dir.mkdir(parents=True, exist_ok=True)
+        # Odd nodes: cumulative duty cycle counters instead of the state log
+        duty = node.id % 2 == 1
+        if duty:
+            node.logs["phy-dutycycle.csv"] = _duty_cycle(node.logs.pop("phy-statelog.csv"),
+                                                         duration)
+        else:
+            del node.logs["phy-dutycycle.csv"]
+        for name, rows in node.logs.items():
+            if node.id == missing_mac_node and name.startswith("mac-"):
+                continue
+            rows.sort(key=lambda row: row[0])
+            with open(node_dir / name, "w") as f:
+                f.writelines(line + "\n" for _, line in rows)
+
+
+def _duty_cycle(state_rows, duration):
+    """Cumulative TRX_OFF, RX_ON, BUSY_RX, TX_ON, BUSY_TX times each 60 s of a state log."""
+    states = ["TRX_OFF", "RX_ON", "BUSY_RX", "TX_ON", "BUSY_TX"]
+    changes = sorted((t, line.split(",")[1]) for t, line in state_rows)
+    totals = dict.fromkeys(states, 0.0)
+    rows = []
+    i = 0
+    current, since = changes[0][1], changes[0][0]
+    for sample in range(60, int(duration) + 1, 60):
+        while i < len(changes) and changes[i][0] <= sample:
+            t, state = changes[i]
+            totals[current] += t - since
+            current, since = state, t
+            i += 1
+        totals[current] += sample - since
+        since = sample
+        rows.append((sample, ",".join([_t(sample)] + [_t(totals[s]) for s in states])))
+    return rows
+
+
+def generate(args):
+    root = Path(args.tree)
+    for seed in range(1, args.seeds + 1):
+        run_dir = root / RUN_DIR / f"SEED{seed:02d}"
+        if run_dir.exists():
+            shutil.rmtree(run_dir)
+        rng = random.Random(seed)
+        # The last node of the second seed lost its MAC logs (a failing node summary)
+        missing = args.nodes - 1 if seed == 2 else -1
+        _generate_run(run_dir, args.nodes, args.duration, rng, missing)
+    print(f"{args.seeds} runs of {args.nodes} nodes written below {root}")
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("tree", nargs="?", default=str(DEFAULT_TREE), help="Trace tree")
+    side = parser.add_mutually_exclusive_group(required=True)
+    side.add_argument("--native", help="rit-log-summarize binary")
+    side.add_argument("--ns3", help="ns-3 directory to `./ns3 run` rit-log-summarize from")
+    side.add_argument("--generate", action="store_true", help="Write a trace tree")
+    parser.add_argument("--threads", default="1", help="Native thread counts, e.g. 1,8")
+    parser.add_argument("--nodes", type=int, default=5, help="Nodes of a generated run")
+    parser.add_argument("--seeds", type=int, default=2, help="Generated runs")
+    parser.add_argument("--duration", type=float, default=300.0, help="Generated run [s]")
+    args = parser.parse_args()
+    return generate(args) if args.generate else check(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
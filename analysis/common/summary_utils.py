@@ -6,8 +6,10 @@ External utility module providing aggregation for APP, MAC, and PHY layers.
 - Parameter and path management is delegated to external classes/modules (e.g., SimulationConfig).
 """
 
+import os
+
 import pandas as pd
-from common.io_utils import read_log
+from common.io_utils import log_exists, read_log
 
 
 def summarize_app_node(node_id, app_txlog, app_rxlog, base_dir, parameter_dir, app_recv_node):
@@ -137,6 +139,10 @@ def summarize_mac_node(node_id, mac_log_files, base_dir, parameter_dir):
     }
 
 
+# Columns of phy-dutycycle.csv (RitWpanNetHelper::EnablePhyDutyCycleTracePerNode)
+DUTY_CYCLE_STATES = ["TRX_OFF", "RX_ON", "BUSY_RX", "TX_ON", "BUSY_TX"]
+
+
 def summarize_phy_node(node_id, base_dir, parameter_dir):
     """
     Aggregate PHY-layer logs.
@@ -151,11 +157,31 @@ def summarize_phy_node(node_id, base_dir, parameter_dir):
     """
     tx_df = read_log(node_id, "phy-txlog.csv", ["time", "event", "addr"], base_dir, parameter_dir)
     rx_df = read_log(node_id, "phy-rxlog.csv", ["time", "event", "addr", "val"], base_dir, parameter_dir)
-    state_df = read_log(node_id, "phy-statelog.csv", ["time", "state"], base_dir, parameter_dir)
     txDropCount = tx_df[tx_df["event"]=="TxDrop"].shape[0] if not tx_df.empty else None
     rxDropCount = rx_df[rx_df["event"]=="RxDrop"].shape[0] if not rx_df.empty else None
     txCount = tx_df[tx_df["event"]=="TxEnd"].shape[0] if not tx_df.empty else None
     rxCount = rx_df[rx_df["event"]=="RxEnd"].shape[0] if not rx_df.empty else None
+    if log_exists(node_id, "phy-dutycycle.csv", base_dir, parameter_dir):
+        # Cumulative time-in-state counters kept by LrWpanPhy: the last row covers the whole run
+        duty_df = read_log(node_id, "phy-dutycycle.csv", ["time"] + DUTY_CYCLE_STATES,
+                           base_dir, parameter_dir)
+        state_ratios = {}
+        if not duty_df.empty:
+            last = duty_df.iloc[-1]
+            total_time = sum(last[s] for s in DUTY_CYCLE_STATES)
+            state_ratios = {f"{s}_ratio": (last[s]/total_time if total_time > 0 else None)
+                            for s in DUTY_CYCLE_STATES}
+        return {
+            "nodeId": node_id,
+            "tx": txCount,
+            "rx": rxCount,
+            "txDrop": txDropCount,
+            "rxDrop": rxDropCount,
+            **state_ratios
+        }
+
+    # Per-transition state log (RitWpanNetHelper::SetPhyStateTraceEnabled(true))
+    state_df = read_log(node_id, "phy-statelog.csv", ["time", "state"], base_dir, parameter_dir)
     idleCount = state_df[state_df["state"]=="TRX_OFF"].shape[0] if not state_df.empty else None
     state_times = {}
     if not state_df.empty:
@@ -0,0 +1,412 @@
+"""
+Run a parameter sweep of an ns-3 scenario (e.g. rit-grid-converge) on a worker pool and
+merge the online summaries of the runs (`--Metrics`, RitMetricsCollector) into one table.
+
+The sweep spec is a JSON file:
+
+    {
+        "ns3_dir": "~/workspace/ns3-rit-mac",
+        "script": "rit-grid-converge",
+        "output_dir": "logs/sweeps/bi-twd",
+        "seed": 1,
+        "runs": 10,
+        "cores": 8,
+        "fixed": {"Placement": "edge", "Density": "low", "App": "periodic", "Days": 1},
+        "grid": {"BI": [5, 10, 20], "TWD": [2000, 5000], "DataCsma": ["true", "false"]}
+    }
+
+Every combination of the `grid` values is a point; each point is run `runs` times (or for
+the listed run numbers) with `--Seed=<seed> --Run=<n>`, so that the runs of a point use
+independent RngSeedManager streams. Each run writes to
+`<output_dir>/<point>/RUNnn/` (`--OutputDir`, raw traces off unless `"traces": true`)
+with its console output in `run.log` and its outcome in `sweep-status`.
+
+A run needs `WorkerThreads` cores when that parameter is set, one otherwise; runs start
+while the budget of `cores` allows. Runs whose status is `ok` are skipped on a restart, so
+an interrupted sweep resumes where it stopped; failed runs are skipped too unless
+`--rerun-failed` is given. `"binary"` runs an already built program directly instead of
+`./ns3 run --no-build`.
+
+`"progress": {"interval": 3600, "stall": 900}` makes each run write a progress report
+every `interval` simulated seconds to `progress.jsonl` (`--Progress`, RitProgressReporter)
+and kills a run whose file has not grown for `stall` wall seconds (status
+`failed stalled`); `timeout` bounds the wall time of a run.
+
+`"prescreen"` runs the analytical predictor of the scenario (`--PredictOnly`,
+RitPerformancePredictor) once per point, into `<output_dir>/<point>/predict/`, before
+the sweep:
+
+    "prescreen": {"max": {"pred_wake_ratio_mean": 0.05, "pred_delay_max": 600},
+                  "min": {"pred_pdr": 0.9},
+                  "order": "pred_delay_mean"}
+
+The runs of a point whose predicted `pred_*` figures break a `max` or `min` bound get the
+status `pruned <key>` and are not simulated (they are checked again on a restart, so
+changed bounds take effect); the others start in increasing order of the `order` figure
+(`-key` for decreasing). A missing prediction prunes nothing. With a prescreen, or with
+`"predict": true`, the runs write their own prediction (`--Predict`).
+
+The merged table (`<output_dir>/sweep-results.csv`) has one row per run: the grid
+parameters, the run number, the status, the `key,value` pairs of
+`summary/scenario-summary.csv` and the `pred_*` figures of the run (or of its point) as
+columns.
+
+Usage:
+    python -m common.sweep <spec.json> [--cores N] [--rerun-failed] [--merge-only]
+                                       [--dry-run] [--no-build]
+"""
+
+import argparse
+import csv
+import itertools
+import json
+import os
+import subprocess
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor
+from pathlib import Path
+
+STATUS_FILE = "sweep-status"
+PROGRESS_FILE = "progress.jsonl"
+RESULTS_FILE = "sweep-results.csv"
+SCENARIO_SUMMARY = os.path.join("summary", "scenario-summary.csv")
+PREDICTION_FILE = "prediction.csv"
+PREDICT_DIR = "predict"
+
+
+def load_spec(path):
+    """Read a sweep spec and fill in the defaults."""
+    with open(path) as f:
+        spec = json.load(f)
+    spec.setdefault("ns3_dir", ".")
+    spec.setdefault("output_dir", os.path.join("logs", "sweeps", Path(path).stem))
+    spec.setdefault("seed", 1)
+    spec.setdefault("runs", 1)
+    spec.setdefault("cores", os.cpu_count() or 1)
+    spec.setdefault("fixed", {})
+    spec.setdefault("grid", {})
+    spec.setdefault("traces", False)
+    spec.setdefault("progress", None)
+    spec.setdefault("prescreen", None)
+    spec.setdefault("predict", bool(spec["prescreen"]))
+    spec["ns3_dir"] = os.path.expanduser(spec["ns3_dir"])
+    if "script" not in spec and "binary" not in spec:
+        raise ValueError("sweep spec needs a 'script' or a 'binary'")
+    return spec
+
+
+def run_numbers(spec):
+    """Run numbers of every point (a count means 1..count)."""
+    runs = spec["runs"]
+    return list(range(1, runs + 1)) if isinstance(runs, int) else [int(r) for r in runs]
+
+
+def point_name(point):
+    """Directory name of a point, e.g. BI5_TWD2000_DataCsmatrue."""
+    return "_".join(f"{key}{format_value(value)}" for key, value in point.items()) or "default"
+
+
+def expand_points(spec):
+    """List the points of the sweep, in grid order."""
+    keys = list(spec["grid"])
+    return [dict(zip(keys, values))
+            for values in itertools.product(*(spec["grid"][k] for k in keys))]
+
+
+def expand_jobs(spec):
+    """List the (point, run, run_dir) jobs of the sweep, in grid order."""
+    jobs = []
+    for point in expand_points(spec):
+        for run in run_numbers(spec):
+            run_dir = os.path.join(spec["output_dir"], point_name(point), f"RUN{run:02d}")
+            jobs.append((point, run, run_dir))
+    return jobs
+
+
+def format_value(value):
+    """Command-line form of a spec value (JSON booleans as true/false)."""
+    if isinstance(value, bool):
+        return "true" if value else "false"
+    return str(value)
+
+
+def predict_dir(spec, point):
+    """Directory of the prescreen prediction of a point."""
+    return os.path.join(spec["output_dir"], point_name(point), PREDICT_DIR)
+
+
+def build_command(spec, point, run, run_dir, predict_only=False):
+    """Argument list of one run (or of the prediction of its point)."""
+    params = dict(spec["fixed"])
+    params.update(point)
+    params.update({
+        "Seed": spec["seed"],
+        "Run": run,
+        "OutputDir": run_dir + "/",
+        "Metrics": not predict_only,
+        "Traces": spec["traces"] and not predict_only,
+    })
+    if predict_only:
+        params["PredictOnly"] = True
+    elif spec["predict"]:
+        params["Predict"] = True
+    if spec["progress"] and not predict_only:
+        params["Progress"] = spec["progress"].get("interval", 3600)
+        params["ProgressFile"] = os.path.join(run_dir, PROGRESS_FILE)
+    args = [f"--{key}={format_value(value)}" for key, value in params.items()]
+    if "binary" in spec:
+        return [os.path.expanduser(spec["binary"])] + args
+    return ["./ns3", "run", "--no-build", " ".join([spec["script"]] + args)]
+
+
+def job_cores(spec, point):
+    """Cores taken by a run: its WorkerThreads, at least one."""
+    params = dict(spec["fixed"])
+    params.update(point)
+    return max(1, int(params.get("WorkerThreads", 1)))
+
+
+def read_status(ns3_dir, run_dir):
+    """Status of a run: 'ok', 'failed ...' or None if it never finished."""
+    path = os.path.join(ns3_dir, run_dir, STATUS_FILE)
+    if not os.path.exists(path):
+        return None
+    with open(path) as f:
+        return f.read().strip() or None
+
+
+class CoreBudget:
+    """Counting semaphore taking a different number of cores per run."""
+
+    def __init__(self, cores):
+        self.free = cores
+        self.total = cores
+        self.cond = threading.Condition()
+
+    def acquire(self, n):
+        n = min(n, self.total)
+        with self.cond:
+            self.cond.wait_for(lambda: self.free >= n)
+            self.free -= n
+        return n
+
+    def release(self, n):
+        with self.cond:
+            self.free += n
+            self.cond.notify_all()
+
+
+def watch_job(proc, progress_path, timeout=None, stall=None, poll=5.0):
+    """Wait for a run, killing it past the timeout or when its progress file stalls.
+
+    Returns None when the run exited by itself, the failure status otherwise.
+    """
+    start = time.monotonic()
+    last_size = -1
+    last_change = start
+    while True:
+        try:
+            proc.wait(timeout=poll)
+            return None
+        except subprocess.TimeoutExpired:
+            pass
+        now = time.monotonic()
+        if timeout is not None and now - start > timeout:
+            status = "failed timeout"
+        elif stall is not None:
+            size = os.path.getsize(progress_path) if os.path.exists(progress_path) else 0
+            if size != last_size:
+                last_size, last_change = size, now
+            status = "failed stalled" if now - last_change > stall else None
+        else:
+            status = None
+        if status is not None:
+            proc.kill()
+            proc.wait()
+            return status
+
+
+def run_job(spec, budget, point, run, run_dir, timeout=None):
+    """Run one point/run and record its status. Returns the status string."""
+    command = build_command(spec, point, run, run_dir)
+    abs_dir = os.path.join(spec["ns3_dir"], run_dir)
+    os.makedirs(abs_dir, exist_ok=True)
+    cores = budget.acquire(job_cores(spec, point))
+    stall = (spec.get("progress") or {}).get("stall")
+    try:
+        with open(os.path.join(abs_dir, "run.log"), "w") as log:
+            proc = subprocess.Popen(command, cwd=spec["ns3_dir"], stdout=log,
+                                    stderr=subprocess.STDOUT)
+            status = watch_job(proc, os.path.join(abs_dir, PROGRESS_FILE), timeout, stall)
+        if status is None:
+            ok = proc.returncode == 0 and os.path.exists(os.path.join(abs_dir, SCENARIO_SUMMARY))
+            status = "ok" if ok else f"failed rc={proc.returncode}"
+    finally:
+        budget.release(cores)
+    with open(os.path.join(abs_dir, STATUS_FILE), "w") as f:
+        f.write(status + "\n")
+    print(f"[SWEEP] {point_name(point)} RUN{run:02d}: {status}", flush=True)
+    return status
+
+
+def predict_point(spec, point):
+    """Run the prediction of a point unless it exists. Returns its pred_* figures."""
+    run_dir = predict_dir(spec, point)
+    abs_dir = os.path.join(spec["ns3_dir"], run_dir)
+    path = os.path.join(abs_dir, PREDICTION_FILE)
+    if not os.path.exists(path):
+        os.makedirs(abs_dir, exist_ok=True)
+        command = build_command(spec, point, run_numbers(spec)[0], run_dir, predict_only=True)
+        with open(os.path.join(abs_dir, "run.log"), "w") as log:
+            subprocess.run(command, cwd=spec["ns3_dir"], stdout=log, stderr=subprocess.STDOUT)
+    if not os.path.exists(path):
+        print(f"[SWEEP] {point_name(point)}: no prediction", flush=True)
+        return {}
+    return {key: float(value) for key, value in read_scenario_summary(path).items()}
+
+
+def prune_reason(spec, prediction):
+    """The first prescreen bound a prediction breaks, None if it meets them all."""
+    prescreen = spec["prescreen"] or {}
+    for key, bound in prescreen.get("max", {}).items():
+        if key in prediction and prediction[key] > bound:
+            return f"{key}>{bound}"
+    for key, bound in prescreen.get("min", {}).items():
+        if key in prediction and prediction[key] < bound:
+            return f"{key}<{bound}"
+    return None
+
+
+def prescreen_sweep(spec):
+    """Predict every point on the worker pool. Returns {point name: pred_* figures}."""
+    points = expand_points(spec)
+    with ThreadPoolExecutor(max_workers=spec["cores"]) as pool:
+        predictions = list(pool.map(lambda point: predict_point(spec, point), points))
+    return {point_name(point): prediction for point, prediction in zip(points, predictions)}
+
+
+def run_sweep(spec, rerun_failed=False, dry_run=False):
+    """Run the jobs not finished yet. Returns (started, skipped, pruned) counts."""
+    predictions = prescreen_sweep(spec) if spec["prescreen"] and not dry_run else {}
+    pending = []
+    skipped = 0
+    pruned = 0
+    for point, run, run_dir in expand_jobs(spec):
+        status = read_status(spec["ns3_dir"], run_dir)
+        pruned_before = status is not None and status.startswith("pruned")
+        if status == "ok" or (status is not None and not pruned_before and not rerun_failed):
+            skipped += 1
+            continue
+        reason = prune_reason(spec, predictions.get(point_name(point), {}))
+        if reason is not None:
+            abs_dir = os.path.join(spec["ns3_dir"], run_dir)
+            os.makedirs(abs_dir, exist_ok=True)
+            with open(os.path.join(abs_dir, STATUS_FILE), "w") as f:
+                f.write(f"pruned {reason}\n")
+            pruned += 1
+            continue
+        pending.append((point, run, run_dir))
+
+    order = (spec["prescreen"] or {}).get("order")
+    if order and predictions:
+        key = order.lstrip("-")
+        sign = -1.0 if order.startswith("-") else 1.0
+
+        def predicted(job):
+            value = predictions.get(point_name(job[0]), {}).get(key)
+            # unpredicted points last
+            return (value is None, sign * value if value is not None else 0.0)
+
+        # stable: the runs of a point stay in run order
+        pending.sort(key=predicted)
+
+    if dry_run:
+        for point, run, run_dir in pending:
+            print(" ".join(build_command(spec, point, run, run_dir)))
+        return len(pending), skipped, pruned
+
+    budget = CoreBudget(spec["cores"])
+    with ThreadPoolExecutor(max_workers=spec["cores"]) as pool:
+        futures = [pool.submit(run_job, spec, budget, point, run, run_dir, spec.get("timeout"))
+                   for point, run, run_dir in pending]
+        for future in futures:
+            future.result()
+    return len(pending), skipped, pruned
+
+
+def read_scenario_summary(path):
+    """Return {key: value} of a scenario-summary.csv."""
+    values = {}
+    with open(path) as f:
+        reader = csv.reader(f)
+        next(reader, None)
+        for row in reader:
+            if len(row) >= 2:
+                values[row[0]] = row[1]
+    return values
+
+
+def merge_results(spec):
+    """Write the merged table of all runs and return its path."""
+    keys = list(spec["grid"])
+    rows = []
+    metric_keys = []
+    prediction_keys = []
+    for point, run, run_dir in expand_jobs(spec):
+        status = read_status(spec["ns3_dir"], run_dir)
+        row = {k: format_value(point[k]) for k in keys}
+        row.update({"Run": run, "status": status or "missing"})
+        summary = os.path.join(spec["ns3_dir"], run_dir, SCENARIO_SUMMARY)
+        if status == "ok" and os.path.exists(summary):
+            for key, value in read_scenario_summary(summary).items():
+                if key not in metric_keys:
+                    metric_keys.append(key)
+                row[key] = value
+        prediction = os.path.join(spec["ns3_dir"], run_dir, PREDICTION_FILE)
+        if not os.path.exists(prediction):
+            prediction = os.path.join(spec["ns3_dir"], predict_dir(spec, point), PREDICTION_FILE)
+        if os.path.exists(prediction):
+            for key, value in read_scenario_summary(prediction).items():
+                if key not in prediction_keys:
+                    prediction_keys.append(key)
+                row[key] = value
+        rows.append(row)
+
+    path = os.path.join(spec["ns3_dir"], spec["output_dir"], RESULTS_FILE)
+    os.makedirs(os.path.dirname(path), exist_ok=True)
+    with open(path, "w", newline="") as f:
+        fieldnames = keys + ["Run", "status"] + metric_keys + prediction_keys
+        writer = csv.DictWriter(f, fieldnames=fieldnames)
+        writer.writeheader()
+        writer.writerows(rows)
+    return path
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Run a parameter sweep and merge its summaries")
+    parser.add_argument("spec", help="sweep spec (JSON)")
+    parser.add_argument("--cores", type=int, help="core budget (overrides the spec)")
+    parser.add_argument("--rerun-failed", action="store_true", help="run failed runs again")
+    parser.add_argument("--merge-only", action="store_true", help="only merge the summaries")
+    parser.add_argument("--dry-run", action="store_true", help="print the pending commands")
+    parser.add_argument("--no-build", action="store_true", help="skip ./ns3 build")
+    args = parser.parse_args()
+
+    spec = load_spec(args.spec)
+    if args.cores:
+        spec["cores"] = args.cores
+
+    if not args.merge_only:
+        if not args.no_build and not args.dry_run and "binary" not in spec:
+            subprocess.run(["./ns3", "build"], cwd=spec["ns3_dir"], check=True)
+        started, skipped, pruned = run_sweep(spec, args.rerun_failed, args.dry_run)
+        if args.dry_run:
+            print(f"[SWEEP] {started} runs pending, {skipped} skipped")
+            return
+        print(f"[SWEEP] {started} runs started, {skipped} skipped, {pruned} pruned")
+    print(f"[SWEEP] results written to {merge_results(spec)}")
+
+
+if __name__ == "__main__":
+    main()
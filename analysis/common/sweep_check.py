@@ -0,0 +1,238 @@
+"""
+Check the sweep driver (common.sweep) end to end with a stand-in scenario.
+
+The stand-in is a small program written to a scratch directory and run as the `"binary"` of
+the spec. It takes the options of rit-grid-converge, sleeps a little, logs when it started and
+stopped, and writes `summary/scenario-summary.csv` (its seed and run number) under
+`--OutputDir`; with `--PredictOnly` it writes `prediction.csv` instead, with a predicted delay
+that grows with `BI`. Then:
+
+- every point and run of the grid gets its own run directory and `--Seed` / `--Run`;
+- the runs never take more than the core budget at once (`WorkerThreads` cores each), and
+  do take all of it;
+- a failed run is recorded, skipped on a restart and run again with `rerun_failed`, while
+  the runs that are `ok` are never run again;
+- `sweep-results.csv` has one row per run with the grid parameters, the status and the
+  summary of the run;
+- a prescreen prunes the points whose prediction breaks a bound, starts the others in the
+  requested order and merges the `pred_*` figures;
+- `watch_job()` kills a run whose progress file stops growing, and not one that reports.
+
+Usage:
+    python -m common.sweep_check
+
+The exit status is 1 when a check fails.
+"""
+
+import csv
+import json
+import os
+import stat
+import subprocess
+import sys
+import tempfile
+import time
+from pathlib import Path
+
+from common.sweep import (
+    expand_jobs,
+    load_spec,
+    merge_results,
+    point_name,
+    read_status,
+    run_sweep,
+    watch_job,
+)
+
+EVENTS_ENV = "SWEEP_CHECK_EVENTS"  # read by STAND_IN
+FAIL_ENV = "SWEEP_CHECK_FAIL"  # "<point>:<run>" failing once
+
+STAND_IN = """\
+import os, sys, time
+args = dict(a[2:].split("=", 1) for a in sys.argv[1:])
+out = args["OutputDir"]
+os.makedirs(os.path.join(out, "summary"), exist_ok=True)
+if args.get("PredictOnly") == "true":
+    with open(os.path.join(out, "prediction.csv"), "w") as f:
+        f.write(f"key,value\\npred_delay_mean,{10 * int(args['BI'])}\\npred_pdr,0.95\\n")
+    sys.exit(0)
+point = f"BI{args['BI']}_DataCsma{args['DataCsma']}"
+line = f"{point} {args['Run']} {args['WorkerThreads']}\\n"
+with open(os.environ["SWEEP_CHECK_EVENTS"], "a") as f:
+    f.write(f"start {time.time()} {line}")
+time.sleep(0.2)
+with open(os.environ["SWEEP_CHECK_EVENTS"], "a") as f:
+    f.write(f"end {time.time()} {line}")
+marker = os.path.join(out, "failed-once")
+if os.environ.get("SWEEP_CHECK_FAIL") == f"{point}:{args['Run']}" and not os.path.exists(marker):
+    open(marker, "w").close()
+    sys.exit(3)
+with open(os.path.join(out, "summary", "scenario-summary.csv"), "w") as f:
+    f.write(f"key,value\\nseed,{args['Seed']}\\nrun,{args['Run']}\\n")
+"""
+
+
+def write_stand_in(scratch):
+    """Write the stand-in scenario and return its path."""
+    path = Path(scratch) / "stand-in"
+    path.write_text(f"#!{sys.executable}\n" + STAND_IN)
+    path.chmod(path.stat().st_mode | stat.S_IXUSR)
+    return path
+
+
+def write_spec(scratch, name, binary, **extra):
+    """Write a sweep spec of six points and three runs and load it."""
+    spec = {
+        "ns3_dir": str(scratch),
+        "binary": str(binary),
+        "output_dir": name,
+        "seed": 7,
+        "runs": 3,
+        "cores": 4,
+        "fixed": {"WorkerThreads": 2, "Days": 1},
+        "grid": {"BI": [5, 10, 20], "DataCsma": [True, False]},
+    }
+    spec.update(extra)
+    path = Path(scratch) / f"{name}.json"
+    with open(path, "w") as f:
+        json.dump(spec, f)
+    return load_spec(path)
+
+
+def read_events(path):
+    """The (kind, time, point, run, cores) lines of the stand-in, in order."""
+    if not os.path.exists(path):
+        return []
+    with open(path) as f:
+        return [(k, float(t), p, int(r), int(c))
+                for k, t, p, r, c in (line.split() for line in f if line.strip())]
+
+
+def peak_cores(events):
+    """The largest number of cores taken at once by the runs of an event log."""
+    taken = peak = 0
+    for kind, _, _, _, cores in sorted(events, key=lambda e: (e[1], e[0] == "start")):
+        taken += cores if kind == "start" else -cores
+        peak = max(peak, taken)
+    return peak
+
+
+def check_runs(scratch, binary, events_path):
+    """Differences of a plain sweep, its restarts and its merged table."""
+    diffs = []
+    spec = write_spec(scratch, "plain", binary)
+    jobs = expand_jobs(spec)
+    if len(jobs) != 18 or len({run_dir for _, _, run_dir in jobs}) != 18:
+        diffs.append(f"{len(jobs)} jobs in {len({j[2] for j in jobs})} directories, not 18")
+
+    os.environ[FAIL_ENV] = "BI10_DataCsmatrue:2"
+    started, skipped, pruned = run_sweep(spec)
+    if (started, skipped, pruned) != (18, 0, 0):
+        diffs.append(f"first pass: started, skipped, pruned = {started}, {skipped}, {pruned}")
+    events = read_events(events_path)
+    if peak_cores(events) != spec["cores"]:
+        diffs.append(f"{peak_cores(events)} cores taken at once, budget {spec['cores']}")
+    failed = [job for job in jobs if read_status(spec["ns3_dir"], job[2]) != "ok"]
+    if [(point_name(p), r) for p, r, _ in failed] != [("BI10_DataCsmatrue", 2)]:
+        diffs.append(f"failed runs {[(point_name(p), r) for p, r, _ in failed]}")
+    else:
+        status = read_status(spec["ns3_dir"], failed[0][2])
+        if status != "failed rc=3":
+            diffs.append(f"status of the failed run: {status}")
+
+    open(events_path, "w").close()
+    if run_sweep(spec) != (0, 18, 0) or read_events(events_path):
+        diffs.append("a restart ran finished or failed runs again")
+    if run_sweep(spec, rerun_failed=True) != (1, 17, 0):
+        diffs.append("rerun_failed did not run exactly the failed run")
+    elif [(e[2], e[3]) for e in read_events(events_path)] != [("BI10_DataCsmatrue", 2)] * 2:
+        diffs.append(f"rerun_failed ran {read_events(events_path)}")
+
+    with open(merge_results(spec)) as f:
+        rows = list(csv.DictReader(f))
+    if len(rows) != 18:
+        diffs.append(f"{len(rows)} merged rows, not 18")
+    for row, (point, run, _) in zip(rows, jobs):
+        want = {"BI": str(point["BI"]), "DataCsma": "true" if point["DataCsma"] else "false",
+                "Run": str(run), "status": "ok", "seed": "7", "run": str(run)}
+        got = {k: row.get(k) for k in want}
+        if got != want:
+            diffs.append(f"merged row {got}, expected {want}")
+    return diffs
+
+
+def check_prescreen(scratch, binary, events_path):
+    """Differences of a prescreened sweep: pruning, start order and merged predictions."""
+    diffs = []
+    prescreen = {"max": {"pred_delay_mean": 150}, "min": {"pred_pdr": 0.9},
+                 "order": "-pred_delay_mean"}
+    spec = write_spec(scratch, "prescreen", binary, prescreen=prescreen, runs=2, cores=2)
+    os.environ.pop(FAIL_ENV, None)
+    open(events_path, "w").close()
+
+    # pred_delay_mean is 10 * BI: BI 20 is pruned, BI 10 runs before BI 5
+    started, skipped, pruned = run_sweep(spec)
+    if (started, skipped, pruned) != (8, 0, 4):
+        diffs.append(f"started, skipped, pruned = {started}, {skipped}, {pruned}")
+    for point, run, run_dir in expand_jobs(spec):
+        status = read_status(spec["ns3_dir"], run_dir)
+        want = "pruned pred_delay_mean>150" if point["BI"] == 20 else "ok"
+        if status != want:
+            diffs.append(f"{point_name(point)} RUN{run:02d}: {status}, expected {want}")
+    order = [e[2] for e in read_events(events_path) if e[0] == "start"]
+    if [p.split("_")[0] for p in order] != ["BI10"] * 4 + ["BI5"] * 4:
+        diffs.append(f"start order {order}")
+
+    with open(merge_results(spec)) as f:
+        rows = list(csv.DictReader(f))
+    for row in rows:
+        if row.get("pred_delay_mean") != str(10 * int(row["BI"])):
+            diffs.append(f"BI{row['BI']} RUN{row['Run']}: pred_delay_mean "
+                         f"{row.get('pred_delay_mean')}")
+    return diffs
+
+
+def check_watch(scratch):
+    """Differences of watch_job() on a stalled run and on a reporting one."""
+    diffs = []
+    progress = Path(scratch) / "progress.jsonl"
+    proc = subprocess.Popen([sys.executable, "-c", "import time; time.sleep(30)"])
+    start = time.monotonic()
+    status = watch_job(proc, str(progress), stall=0.5, poll=0.1)
+    if status != "failed stalled" or time.monotonic() - start > 5 or proc.returncode is None:
+        diffs.append(f"stalled run: {status} after {time.monotonic() - start:.1f} s")
+
+    report = ("import time\n"
+              "for i in range(10):\n"
+              f"    open({str(progress)!r}, 'a').write('{{}}\\n')\n"
+              "    time.sleep(0.2)\n")
+    proc = subprocess.Popen([sys.executable, "-c", report])
+    status = watch_job(proc, str(progress), stall=0.5, poll=0.1)
+    if status is not None or proc.returncode != 0:
+        diffs.append(f"reporting run: {status}, rc={proc.returncode}")
+
+    proc = subprocess.Popen([sys.executable, "-c", "import time; time.sleep(30)"])
+    status = watch_job(proc, str(progress), timeout=0.5, poll=0.1)
+    if status != "failed timeout":
+        diffs.append(f"run past its timeout: {status}")
+    return diffs
+
+
+def main():
+    failed = False
+    with tempfile.TemporaryDirectory() as scratch:
+        binary = write_stand_in(scratch)
+        events_path = os.path.join(scratch, "events")
+        os.environ[EVENTS_ENV] = events_path
+        for label, check in [("runs", lambda: check_runs(scratch, binary, events_path)),
+                             ("prescreen", lambda: check_prescreen(scratch, binary, events_path)),
+                             ("watch", lambda: check_watch(scratch))]:
+            for diff in check():
+                print(f"  {label}: {diff}")
+                failed = True
+    print("sweep driver differs" if failed else "sweep driver matches")
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,315 @@
+"""
+Decoder for the binary trace files written by RitWpanNetHelper (RitTraceFormat::BINARY).
+
+Each `node-*/<log>.bin` file is converted into the `node-*/<log>.csv` file the ASCII
+backend would have written, so `io_utils.read_log()` and the summary scripts keep working.
+Consolidated traces (`RitWpanNetHelper::EnableConsolidatedTraces()`), i.e. `trace-NN.bin`
+and `trace-NN.csv` at the run directory, are split back into the same `node-*` layout.
+
+Usage:
+    python -m common.trace_decoder <log dir> [--remove-bin]
+"""
+
+import argparse
+import os
+import struct
+from pathlib import Path
+
+# Must match RitTraceFileHeader / RitTraceRecord in rit-wpan/helper/rit-trace-writer.h
+HEADER_STRUCT = struct.Struct("<4sHHB3xI")
+RECORD_STRUCT = struct.Struct("<qQQQdIBBBB")
+MAGIC = b"RITT"
+FORMAT_VERSION = 1
+FLAG_HAS_HEADER = 0x01
+
+# RitTraceLogId
+LOG_APP_TX = 0
+LOG_APP_RX = 1
+LOG_MAC_STATE = 2
+LOG_MAC_MODE = 3
+LOG_NWK_TX = 4
+LOG_NWK_RX = 5
+LOG_MAC_TX = 6
+LOG_MAC_RX = 7
+LOG_MAC_BEACON_WAIT = 8
+LOG_MAC_DATA_WAIT = 9
+LOG_PHY_STATE = 10
+LOG_PHY_TX = 11
+LOG_PHY_RX = 12
+LOG_ENERGY = 13
+LOG_MIXED = 0xFF
+LOG_ID_SHIFT = 4
+
+# RitTraceLogId -> per-node CSV file name
+LOG_FILE_NAMES = {
+    LOG_APP_TX: "app-txlog.csv",
+    LOG_APP_RX: "app-rxlog.csv",
+    LOG_MAC_STATE: "mac-statelog.csv",
+    LOG_MAC_MODE: "mac-mode.csv",
+    LOG_NWK_TX: "nwk-txlog.csv",
+    LOG_NWK_RX: "nwk-rxlog.csv",
+    LOG_MAC_TX: "mac-txlog.csv",
+    LOG_MAC_RX: "mac-rxlog.csv",
+    LOG_MAC_BEACON_WAIT: "mac-beacon-wait.csv",
+    LOG_MAC_DATA_WAIT: "mac-data-wait.csv",
+    LOG_PHY_STATE: "phy-statelog.csv",
+    LOG_PHY_TX: "phy-txlog.csv",
+    LOG_PHY_RX: "phy-rxlog.csv",
+    LOG_ENERGY: "energy-node.log",
+}
+
+# RitTraceEvent -> event string of the ASCII logs
+EVENT_NAMES = {
+    0: "",
+    1: "Tx",
+    2: "TxOk",
+    3: "TxDrop",
+    4: "ReTx",
+    5: "RxOk",
+    6: "RxDrop",
+    7: "TxBegin",
+    8: "TxEnd",
+    9: "RxBegin",
+    10: "RxEnd",
+    11: "start",
+    12: "end",
+    13: "skip",
+    14: "timeout",
+}
+
+# operator<<(MacState) in lr-wpan-mac.cc
+MAC_STATE_NAMES = {
+    0: "MAC IDLE",
+    1: "CSMA",
+    2: "SENDING",
+    3: "ACK PENDING",
+    4: "CHANNEL_ACCESS_FAILURE",
+    5: "CHANNEL IDLE",
+    6: "SET PHY to TX ON",
+    7: "MAC GTS PERIOD",
+    8: "SUPERFRAME INACTIVE PERIOD",
+    9: "CSMA DEFERRED TO NEXT PERIOD",
+}
+
+# operator<<(PhyEnumeration) in lr-wpan-phy.cc
+PHY_STATE_NAMES = {
+    0x00: "BUSY",
+    0x01: "BUSY_RX",
+    0x02: "BUSY_TX",
+    0x03: "FORCE_TRX_OFF",
+    0x04: "IDLE",
+    0x05: "INVALID_PARAMETER",
+    0x06: "RX_ON",
+    0x07: "SUCCESS",
+    0x08: "TRX_OFF",
+    0x09: "TX_ON",
+    0x0A: "UNSUPPORTED",
+    0x0B: "READ_ONLY",
+    0x0C: "UNSPECIFIED",
+}
+
+# RitWpanNetHelper::AsciiRitWpanMacModeSink
+MAC_MODE_NAMES = {
+    0: "RIT Disabled",
+    1: "Sender",
+    2: "Receiver",
+    3: "Sleep",
+    4: "Bootstrap",
+    5: "Strobe",
+}
+
+# LrWpanMacHeader::LrWpanMacType
+FRAME_TYPE_NAMES = {
+    0: "Beacon",
+    1: "Data",
+    2: "Ack",
+    3: "Command",
+    5: "Multipurpose",
+}
+
+SHORT_ADDR = 2
+EXT_ADDR = 3
+
+
+def format_time(time_ns: int) -> str:
+    """Format a time like `std::ostream << Time::GetSeconds()` (6 significant digits)."""
+    return "%g" % (time_ns / 1e9)
+
+
+def format_addr(value: int, mode: int) -> str:
+    """Format an address like Mac16Address/Mac64Address operator<< ("ff:ff" if absent)."""
+    if mode == SHORT_ADDR:
+        return ":".join("%02x" % b for b in value.to_bytes(2, "big"))
+    if mode == EXT_ADDR:
+        return ":".join("%02x" % b for b in value.to_bytes(8, "big"))
+    return "ff:ff"
+
+
+def read_binary_trace(path):
+    """
+    Read a binary trace file.
+    Returns (log_id, node_id, records) where records is a list of dicts.
+    """
+    with open(path, "rb") as f:
+        data = f.read()
+    if len(data) < HEADER_STRUCT.size:
+        raise ValueError(f"{path}: truncated header")
+    magic, version, record_size, log_id, node_id = HEADER_STRUCT.unpack_from(data, 0)
+    if magic != MAGIC or version != FORMAT_VERSION or record_size != RECORD_STRUCT.size:
+        raise ValueError(f"{path}: unsupported trace file (magic={magic}, version={version})")
+
+    records = []
+    # A trailing partial record (e.g. aborted run) is ignored
+    end = len(data) - (len(data) - HEADER_STRUCT.size) % record_size
+    for offset in range(HEADER_STRUCT.size, end, record_size):
+        t, uid, src, dst, value, nid, event, arg, modes, flags = RECORD_STRUCT.unpack_from(
+            data, offset)
+        records.append({
+            "time_ns": t, "uid": uid, "src": src, "dst": dst, "value": value,
+            "node": nid, "event": event, "arg": arg,
+            "src_mode": modes & 0x03, "dst_mode": (modes >> 2) & 0x03, "flags": flags,
+        })
+    return log_id, node_id, records
+
+
+def format_row(log_id: int, rec: dict):
+    """Format one record as the CSV line of the ASCII backend (None if it would be skipped)."""
+    t = format_time(rec["time_ns"])
+    event = EVENT_NAMES.get(rec["event"], "")
+    has_header = bool(rec["flags"] & FLAG_HAS_HEADER)
+
+    if log_id in (LOG_APP_TX, LOG_APP_RX):
+        return f"{t},{rec['uid']}"
+    if log_id == LOG_MAC_STATE:
+        return f"{t},{MAC_STATE_NAMES.get(rec['arg'], '')}"
+    if log_id == LOG_MAC_MODE:
+        return f"{t},{MAC_MODE_NAMES.get(rec['arg'], '')}"
+    if log_id == LOG_PHY_STATE:
+        return f"{t},{PHY_STATE_NAMES.get(rec['arg'], '')}"
+    if log_id in (LOG_MAC_BEACON_WAIT, LOG_MAC_DATA_WAIT):
+        return f"{t},{event}"
+    if log_id == LOG_ENERGY:
+        return f"{t},{rec['value']:g}"
+    if log_id in (LOG_NWK_TX, LOG_NWK_RX):
+        src = format_addr(rec["src"], SHORT_ADDR)
+        dst = format_addr(rec["dst"], SHORT_ADDR)
+        return f"{t},{event},{src},{dst},{rec['uid']}"
+    if log_id in (LOG_MAC_TX, LOG_MAC_RX):
+        if not has_header:
+            return None
+        frame = FRAME_TYPE_NAMES.get(rec["arg"], "Unknown")
+        src = format_addr(rec["src"], rec["src_mode"])
+        dst = format_addr(rec["dst"], rec["dst_mode"])
+        return f"{t},{event},{frame},{src},{dst}"
+    if log_id == LOG_PHY_TX:
+        if not has_header:
+            return None
+        return f"{t},{event},{format_addr(rec['dst'], rec['dst_mode'])}"
+    if log_id == LOG_PHY_RX:
+        src = format_addr(rec["src"], rec["src_mode"]) if has_header else ""
+        # The SINR variant (RxEnd) ends with a trailing comma
+        suffix = "," if event == "RxEnd" else ""
+        return f"{t},{event},{src}{suffix}"
+    raise ValueError(f"unknown log id {log_id}")
+
+
+class _NodeLogFiles:
+    """Lazily opened `node-<id>/<log>` files below a run directory."""
+
+    def __init__(self, run_dir):
+        self.run_dir = Path(run_dir)
+        self.files = {}
+
+    def write(self, node, log_name, line):
+        key = (node, log_name)
+        f = self.files.get(key)
+        if f is None:
+            node_dir = self.run_dir / f"node-{node}"
+            node_dir.mkdir(parents=True, exist_ok=True)
+            # A node writes to exactly one shard, so each file has a single source
+            f = open(node_dir / log_name, "w", encoding="utf-8")
+            self.files[key] = f
+        f.write(line + "\n")
+
+    def close(self):
+        for f in self.files.values():
+            f.close()
+        self.files.clear()
+
+
+def split_consolidated_csv(csv_path, run_dir=None) -> int:
+    """Split a consolidated ASCII trace (`<node>,<log>,<line>`) into node-* files."""
+    csv_path = Path(csv_path)
+    out = _NodeLogFiles(run_dir or csv_path.parent)
+    rows = 0
+    try:
+        with open(csv_path, encoding="utf-8") as f:
+            for raw in f:
+                parts = raw.rstrip("\n").split(",", 2)
+                if len(parts) < 3:
+                    continue
+                out.write(parts[0], parts[1], parts[2])
+                rows += 1
+    finally:
+        out.close()
+    return rows
+
+
+def decode_file(bin_path, csv_path=None) -> int:
+    """Decode one binary trace file into CSV. Returns the number of rows written."""
+    bin_path = Path(bin_path)
+    log_id, _, records = read_binary_trace(bin_path)
+    if log_id == LOG_MIXED:
+        out = _NodeLogFiles(bin_path.parent)
+        rows = 0
+        try:
+            for rec in records:
+                rec_log = rec["flags"] >> LOG_ID_SHIFT
+                line = format_row(rec_log, rec)
+                if line is not None:
+                    out.write(rec["node"], LOG_FILE_NAMES[rec_log], line)
+                    rows += 1
+        finally:
+            out.close()
+        return rows
+
+    csv_path = Path(csv_path) if csv_path else bin_path.with_suffix(".csv")
+    rows = 0
+    with open(csv_path, "w", encoding="utf-8") as out:
+        for rec in records:
+            line = format_row(log_id, rec)
+            if line is not None:
+                out.write(line + "\n")
+                rows += 1
+    return rows
+
+
+def decode_tree(base_dir, remove_bin: bool = False) -> int:
+    """
+    Decode every `*.bin` trace and split every consolidated `trace-*.csv` under base_dir
+    (recursively). Returns the number of files processed.
+    """
+    count = 0
+    for bin_path in sorted(Path(base_dir).rglob("*.bin")):
+        decode_file(bin_path)
+        if remove_bin:
+            os.remove(bin_path)
+        count += 1
+    for csv_path in sorted(Path(base_dir).rglob("trace-*.csv")):
+        split_consolidated_csv(csv_path)
+        count += 1
+    return count
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode RIT binary traces into CSV logs")
+    parser.add_argument("log_dir", help="Run directory (e.g. logs/default/<module>/.../SEED01)")
+    parser.add_argument("--remove-bin", action="store_true",
+                        help="Delete .bin files after decoding")
+    args = parser.parse_args()
+    n = decode_tree(args.log_dir, args.remove_bin)
+    print(f"[DECODE] {n} binary trace files decoded under {args.log_dir}")
+
+
+if __name__ == "__main__":
+    main()
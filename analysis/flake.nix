@@ -35,6 +35,7 @@
         python312Packages.plotly # Interactive graphing library for Python
         python312Packages.ipywidgets
         python312Packages.pandas # Data analysis and manipulation library for Python
+        python312Packages.pyarrow # Parquet / Arrow IPC tables (common/columnar.py)
         python312Packages.seaborn
       ];
 
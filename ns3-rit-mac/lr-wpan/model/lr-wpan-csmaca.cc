@@ -12,6 +12,7 @@
 #include "lr-wpan-csmaca.h"
 
 #include "lr-wpan-constants.h"
+#include "lr-wpan-event-profiler.h"
 
 #include "ns3/log.h"
 #include "ns3/random-variable-stream.h"
@@ -31,6 +32,19 @@ namespace lrwpan
 NS_LOG_COMPONENT_DEFINE("LrWpanCsmaCa");
 NS_OBJECT_ENSURE_REGISTERED(LrWpanCsmaCa);
 
+namespace
+{
+
+// Handlers reported to LrWpanEventProfiler
+const uint32_t PROFILE_BACKOFF =
+    LrWpanEventProfiler::RegisterHandler("LrWpanCsmaCa::RandomBackoffDelay");
+const uint32_t PROFILE_CAN_PROCEED =
+    LrWpanEventProfiler::RegisterHandler("LrWpanCsmaCa::CanProceed");
+const uint32_t PROFILE_REQUEST_CCA =
+    LrWpanEventProfiler::RegisterHandler("LrWpanCsmaCa::RequestCCA");
+
+} // namespace
+
 TypeId
 LrWpanCsmaCa::GetTypeId()
 {
@@ -248,18 +262,23 @@ LrWpanCsmaCa::Start()
         Time backoffBoundary = GetTimeToNextSlot();
         m_randomBackoffEvent =
             Simulator::Schedule(backoffBoundary, &LrWpanCsmaCa::RandomBackoffDelay, this);
+        LrWpanEventProfiler::RecordScheduled(PROFILE_BACKOFF);
     }
     else
     {
         NS_LOG_DEBUG("Using Unslotted CSMA-CA");
         m_BE = m_macMinBE;
         m_randomBackoffEvent = Simulator::ScheduleNow(&LrWpanCsmaCa::RandomBackoffDelay, this);
+        LrWpanEventProfiler::RecordScheduled(PROFILE_BACKOFF);
     }
 }
 
 void
 LrWpanCsmaCa::Cancel()
 {
+    LrWpanEventProfiler::RecordCancelled(PROFILE_BACKOFF, m_randomBackoffEvent);
+    LrWpanEventProfiler::RecordCancelled(PROFILE_REQUEST_CCA, m_requestCcaEvent);
+    LrWpanEventProfiler::RecordCancelled(PROFILE_CAN_PROCEED, m_canProceedEvent);
     m_randomBackoffEvent.Cancel();
     m_requestCcaEvent.Cancel();
     m_canProceedEvent.Cancel();
@@ -270,6 +289,7 @@ void
 LrWpanCsmaCa::RandomBackoffDelay()
 {
     NS_LOG_FUNCTION(this);
+    LrWpanEventProfiler::Scope profile(PROFILE_BACKOFF);
 
     uint64_t upperBound = (uint64_t)pow(2, m_BE) - 1;
     Time randomBackoff;
@@ -294,6 +314,7 @@ LrWpanCsmaCa::RandomBackoffDelay()
                      << m_randomBackoffPeriodsLeft << " periods (" << randomBackoff.As(Time::S)
                      << ")");
         m_requestCcaEvent = Simulator::Schedule(randomBackoff, &LrWpanCsmaCa::RequestCCA, this);
+        LrWpanEventProfiler::RecordScheduled(PROFILE_REQUEST_CCA);
     }
     else
     {
@@ -324,6 +345,7 @@ LrWpanCsmaCa::RandomBackoffDelay()
         else
         {
             m_canProceedEvent = Simulator::Schedule(randomBackoff, &LrWpanCsmaCa::CanProceed, this);
+            LrWpanEventProfiler::RecordScheduled(PROFILE_CAN_PROCEED);
         }
     }
 }
@@ -362,6 +384,7 @@ void
 LrWpanCsmaCa::CanProceed()
 {
     NS_LOG_FUNCTION(this);
+    LrWpanEventProfiler::Scope profile(PROFILE_CAN_PROCEED);
 
     Time timeLeftInCap;
     uint16_t ccaSymbols;
@@ -430,6 +453,7 @@ LrWpanCsmaCa::CanProceed()
     else
     {
         m_requestCcaEvent = Simulator::ScheduleNow(&LrWpanCsmaCa::RequestCCA, this);
+        LrWpanEventProfiler::RecordScheduled(PROFILE_REQUEST_CCA);
     }
 }
 
@@ -437,6 +461,7 @@ void
 LrWpanCsmaCa::RequestCCA()
 {
     NS_LOG_FUNCTION(this);
+    LrWpanEventProfiler::Scope profile(PROFILE_REQUEST_CCA);
     m_ccaRequestRunning = true;
     m_mac->GetPhy()->PlmeCcaRequest();
 }
@@ -478,6 +503,7 @@ LrWpanCsmaCa::PlmeCcaConfirm(PhyEnumeration status)
                     NS_LOG_LOGIC("Perform CCA again, m_CW = " << m_CW);
                     m_requestCcaEvent = Simulator::ScheduleNow(&LrWpanCsmaCa::RequestCCA,
                                                                this); // Perform CCA again
+                    LrWpanEventProfiler::RecordScheduled(PROFILE_REQUEST_CCA);
                 }
             }
             else
@@ -515,6 +541,7 @@ LrWpanCsmaCa::PlmeCcaConfirm(PhyEnumeration status)
                 m_randomBackoffEvent =
                     Simulator::ScheduleNow(&LrWpanCsmaCa::RandomBackoffDelay,
                                            this); // Perform another backoff (step 2)
+                LrWpanEventProfiler::RecordScheduled(PROFILE_BACKOFF);
             }
         }
     }
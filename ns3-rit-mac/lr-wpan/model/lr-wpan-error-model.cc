@@ -7,9 +7,13 @@
  */
 #include "lr-wpan-error-model.h"
 
+#include "ns3/boolean.h"
 #include "ns3/log.h"
+#include "ns3/simulator.h"
 
 #include <cmath>
+#include <limits>
+#include <map>
 
 namespace ns3
 {
@@ -19,6 +23,23 @@ namespace lrwpan
 NS_LOG_COMPONENT_DEFINE("LrWpanErrorModel");
 NS_OBJECT_ENSURE_REGISTERED(LrWpanErrorModel);
 
+namespace
+{
+
+/// Shared error models of the current run, by UseLookupTable default
+std::map<bool, Ptr<LrWpanErrorModel>> g_shared;
+
+/**
+ * Release the shared error models at Simulator::Destroy.
+ */
+void
+ClearShared()
+{
+    g_shared.clear();
+}
+
+} // namespace
+
 TypeId
 LrWpanErrorModel::GetTypeId()
 {
@@ -26,11 +47,19 @@ LrWpanErrorModel::GetTypeId()
                             .AddDeprecatedName("ns3::LrWpanErrorModel")
                             .SetParent<Object>()
                             .SetGroupName("LrWpan")
-                            .AddConstructor<LrWpanErrorModel>();
+                            .AddConstructor<LrWpanErrorModel>()
+                            .AddAttribute("UseLookupTable",
+                                          "Compute the chunk success rate from a precomputed "
+                                          "log(1 - BER) table (max. absolute error 2e-5) "
+                                          "instead of the exact formula.",
+                                          BooleanValue(false),
+                                          MakeBooleanAccessor(&LrWpanErrorModel::m_useLookupTable),
+                                          MakeBooleanChecker());
     return tid;
 }
 
 LrWpanErrorModel::LrWpanErrorModel()
+    : m_useLookupTable(false)
 {
     m_binomialCoefficients[0] = 1;
     m_binomialCoefficients[1] = -16;
@@ -51,8 +80,27 @@ LrWpanErrorModel::LrWpanErrorModel()
     m_binomialCoefficients[16] = 1;
 }
 
+Ptr<LrWpanErrorModel>
+LrWpanErrorModel::GetShared()
+{
+    TypeId::AttributeInformation info;
+    GetTypeId().LookupAttributeByName("UseLookupTable", &info);
+    const bool useLookupTable = DynamicCast<const BooleanValue>(info.initialValue)->Get();
+
+    if (g_shared.empty())
+    {
+        Simulator::ScheduleDestroy(&ClearShared);
+    }
+    Ptr<LrWpanErrorModel>& errorModel = g_shared[useLookupTable];
+    if (!errorModel)
+    {
+        errorModel = CreateObject<LrWpanErrorModel>();
+    }
+    return errorModel;
+}
+
 double
-LrWpanErrorModel::GetChunkSuccessRate(double snr, uint32_t nbits) const
+LrWpanErrorModel::GetBer(double snr) const
 {
     double ber = 0.0;
 
@@ -63,8 +111,48 @@ LrWpanErrorModel::GetChunkSuccessRate(double snr, uint32_t nbits) const
 
     ber = ber * 8.0 / 15.0 / 16.0;
 
-    ber = std::min(ber, 1.0);
-    double retval = pow(1.0 - ber, nbits);
+    return std::min(ber, 1.0);
+}
+
+const std::vector<double>&
+LrWpanErrorModel::GetLookupTable() const
+{
+    // Same coefficients for every instance: one table per process
+    static const std::vector<double> table = [this]() {
+        auto n = static_cast<size_t>(std::lround((LUT_MAX_DB - LUT_MIN_DB) / LUT_STEP_DB)) + 1;
+        std::vector<double> t(n);
+        for (size_t i = 0; i < n; i++)
+        {
+            double ber = GetBer(std::pow(10.0, (LUT_MIN_DB + i * LUT_STEP_DB) / 10.0));
+            t[i] = ber < 1.0 ? std::log1p(-ber) : -std::numeric_limits<double>::infinity();
+        }
+        return t;
+    }();
+    return table;
+}
+
+double
+LrWpanErrorModel::GetChunkSuccessRate(double snr, uint32_t nbits) const
+{
+    if (m_useLookupTable && snr > 0.0)
+    {
+        double snrDb = 10.0 * std::log10(snr);
+        if (snrDb >= LUT_MAX_DB)
+        {
+            return 1.0;
+        }
+        if (snrDb >= LUT_MIN_DB)
+        {
+            const std::vector<double>& table = GetLookupTable();
+            double x = (snrDb - LUT_MIN_DB) / LUT_STEP_DB;
+            auto i = std::min(static_cast<size_t>(x), table.size() - 2);
+            double frac = x - i;
+            double log1mBer = table[i] + (table[i + 1] - table[i]) * frac;
+            return std::exp(nbits * log1mBer);
+        }
+    }
+
+    double retval = pow(1.0 - GetBer(snr), nbits);
     return retval;
 }
 } // namespace lrwpan
@@ -10,6 +10,8 @@
 
 #include "ns3/object.h"
 
+#include <vector>
+
 namespace ns3
 {
 namespace lrwpan
@@ -21,6 +23,14 @@ namespace lrwpan
  * Model the error rate for IEEE 802.15.4 2.4 GHz AWGN channel for OQPSK
  * the model description can be found in IEEE Std 802.15.4-2006, section
  * E.4.1.7
+ *
+ * With the UseLookupTable attribute, GetChunkSuccessRate() reads log(1 - BER)
+ * from a table over the SNR in dB (LUT_MIN_DB to LUT_MAX_DB, LUT_STEP_DB steps,
+ * linear interpolation) and returns exp(nbits * log(1 - BER)). The table is
+ * built once per process and shared by all instances. Its maximum absolute
+ * error on the chunk success rate is below LUT_MAX_ERROR for chunks of up to
+ * 1016 bits (aMaxPhyPacketSize); below LUT_MIN_DB the exact formula is used,
+ * above LUT_MAX_DB the BER is below 1e-130 and the chunk is always received.
  */
 class LrWpanErrorModel : public Object
 {
@@ -34,6 +44,16 @@ class LrWpanErrorModel : public Object
 
     LrWpanErrorModel();
 
+    /**
+     * Get an instance shared by the run, created with the current attribute defaults
+     * (one instance per UseLookupTable default). The model is stateless, so any
+     * number of PHYs may share it; its attributes must not be changed. The instances
+     * are released at Simulator::Destroy, and the next run creates new ones.
+     *
+     * @return the shared error model
+     */
+    static Ptr<LrWpanErrorModel> GetShared();
+
     /**
      * Return chunk success rate for given SNR.
      *
@@ -43,7 +63,32 @@ class LrWpanErrorModel : public Object
      */
     double GetChunkSuccessRate(double snr, uint32_t nbits) const;
 
+    static constexpr double LUT_MIN_DB = -20.0;   //!< Lowest SNR of the table [dB]
+    static constexpr double LUT_MAX_DB = 15.0;    //!< Highest SNR of the table [dB]
+    static constexpr double LUT_STEP_DB = 0.01;   //!< Table resolution [dB]
+    static constexpr double LUT_MAX_ERROR = 2e-5; //!< Documented max abs. error of the table
+
   private:
+    /**
+     * Exact bit error rate for a given SNR.
+     *
+     * @param snr SNR expressed as a power ratio (i.e. not in dB)
+     * @return the bit error rate, at most 1
+     */
+    double GetBer(double snr) const;
+
+    /**
+     * Get the shared log(1 - BER) table, building it on first use.
+     *
+     * @return the table, one entry per LUT_STEP_DB from LUT_MIN_DB
+     */
+    const std::vector<double>& GetLookupTable() const;
+
+    /**
+     * Use the precomputed table instead of the exact formula.
+     */
+    bool m_useLookupTable;
+
     /**
      * Array of precalculated binomial coefficients.
      */
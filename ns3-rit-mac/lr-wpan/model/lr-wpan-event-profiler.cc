@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "lr-wpan-event-profiler.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <chrono>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_LOG_COMPONENT_DEFINE("LrWpanEventProfiler");
+
+bool LrWpanEventProfiler::s_enabled = false;
+
+namespace
+{
+
+/**
+ * An open execution scope.
+ */
+struct Frame
+{
+    uint32_t handler;                            //!< Handler id
+    uint32_t node;                               //!< Simulator context
+    std::chrono::steady_clock::time_point start; //!< Entry time
+    double childSeconds;                         //!< Wall time of the nested scopes
+};
+
+/**
+ * State of the profiler. The counters of a node are indexed by handler id;
+ * node slot 0 holds the events outside any node context.
+ */
+struct ProfilerState
+{
+    using NodeCounters = std::vector<LrWpanEventProfiler::Counters>;
+    using StackKey = std::pair<uint32_t, std::vector<uint32_t>>; // node slot, handler ids
+
+    std::vector<std::string> names;                //!< Name of each handler id
+    std::unordered_map<std::string, uint32_t> ids; //!< Id of each handler name
+    std::vector<NodeCounters> nodes;               //!< Counters per node slot
+    std::map<StackKey, double> stacks;             //!< Self wall time per stack [s]
+    std::vector<Frame> open;                       //!< Open scopes, innermost last
+};
+
+ProfilerState&
+GetState()
+{
+    static ProfilerState state;
+    return state;
+}
+
+/**
+ * @brief Node slot of a simulator context.
+ * @param context The context
+ * @return the slot
+ */
+uint32_t
+NodeSlot(uint32_t context)
+{
+    return context == Simulator::NO_CONTEXT ? 0 : context + 1;
+}
+
+/**
+ * @brief Counters of a handler in the current context, created on demand.
+ * @param handler Handler id
+ * @param context The simulator context
+ * @return the counters
+ */
+LrWpanEventProfiler::Counters&
+GetSlot(uint32_t handler, uint32_t context)
+{
+    ProfilerState& state = GetState();
+    NS_ASSERT(handler < state.names.size());
+    const uint32_t slot = NodeSlot(context);
+    if (slot >= state.nodes.size())
+    {
+        state.nodes.resize(slot + 1);
+    }
+    auto& counters = state.nodes[slot];
+    if (handler >= counters.size())
+    {
+        counters.resize(state.names.size());
+    }
+    return counters[handler];
+}
+
+/**
+ * @brief Label of a node slot in the outputs.
+ * @param slot The slot
+ * @return the node id, "-" for slot 0
+ */
+std::string
+SlotLabel(uint32_t slot)
+{
+    return slot == 0 ? std::string("-") : std::to_string(slot - 1);
+}
+
+} // namespace
+
+void
+LrWpanEventProfiler::Enable()
+{
+    s_enabled = true;
+}
+
+void
+LrWpanEventProfiler::Disable()
+{
+    s_enabled = false;
+}
+
+void
+LrWpanEventProfiler::Reset()
+{
+    ProfilerState& state = GetState();
+    NS_ASSERT_MSG(state.open.empty(), "Reset() from inside a profiled handler");
+    state.nodes.clear();
+    state.stacks.clear();
+}
+
+uint32_t
+LrWpanEventProfiler::RegisterHandler(const std::string& name)
+{
+    ProfilerState& state = GetState();
+    auto [it, added] = state.ids.emplace(name, static_cast<uint32_t>(state.names.size()));
+    if (added)
+    {
+        state.names.push_back(name);
+    }
+    return it->second;
+}
+
+void
+LrWpanEventProfiler::DoRecordScheduled(uint32_t handler)
+{
+    GetSlot(handler, Simulator::GetContext()).scheduled++;
+}
+
+void
+LrWpanEventProfiler::DoRecordCancelled(uint32_t handler)
+{
+    GetSlot(handler, Simulator::GetContext()).cancelled++;
+}
+
+void
+LrWpanEventProfiler::Enter(uint32_t handler)
+{
+    GetState().open.push_back(
+        Frame{handler, Simulator::GetContext(), std::chrono::steady_clock::now(), 0});
+}
+
+void
+LrWpanEventProfiler::Leave()
+{
+    ProfilerState& state = GetState();
+    NS_ASSERT(!state.open.empty());
+    const Frame frame = state.open.back();
+    const double elapsed =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - frame.start).count();
+
+    Counters& counters = GetSlot(frame.handler, frame.node);
+    counters.executed++;
+    counters.wallSeconds += elapsed;
+
+    std::vector<uint32_t> stack;
+    stack.reserve(state.open.size());
+    for (const auto& f : state.open)
+    {
+        stack.push_back(f.handler);
+    }
+    state.stacks[{NodeSlot(frame.node), stack}] += elapsed - frame.childSeconds;
+
+    state.open.pop_back();
+    if (!state.open.empty())
+    {
+        state.open.back().childSeconds += elapsed;
+    }
+}
+
+LrWpanEventProfiler::Counters
+LrWpanEventProfiler::GetCounters(uint32_t node, const std::string& name)
+{
+    const ProfilerState& state = GetState();
+    auto id = state.ids.find(name);
+    const uint32_t slot = NodeSlot(node);
+    if (id == state.ids.end() || slot >= state.nodes.size() ||
+        id->second >= state.nodes[slot].size())
+    {
+        return Counters();
+    }
+    return state.nodes[slot][id->second];
+}
+
+LrWpanEventProfiler::Counters
+LrWpanEventProfiler::GetTotal(const std::string& name)
+{
+    const ProfilerState& state = GetState();
+    Counters total;
+    auto id = state.ids.find(name);
+    if (id == state.ids.end())
+    {
+        return total;
+    }
+    for (const auto& counters : state.nodes)
+    {
+        if (id->second < counters.size())
+        {
+            const Counters& c = counters[id->second];
+            total.scheduled += c.scheduled;
+            total.executed += c.executed;
+            total.cancelled += c.cancelled;
+            total.wallSeconds += c.wallSeconds;
+        }
+    }
+    return total;
+}
+
+void
+LrWpanEventProfiler::WriteTable(std::ostream& os)
+{
+    const ProfilerState& state = GetState();
+    os << "node,handler,scheduled,executed,cancelled,wall_us\n";
+    for (uint32_t slot = 0; slot < state.nodes.size(); slot++)
+    {
+        for (uint32_t h = 0; h < state.nodes[slot].size(); h++)
+        {
+            const Counters& c = state.nodes[slot][h];
+            if (c.scheduled == 0 && c.executed == 0 && c.cancelled == 0)
+            {
+                continue;
+            }
+            os << SlotLabel(slot) << "," << state.names[h] << "," << c.scheduled << ","
+               << c.executed << "," << c.cancelled << "," << c.wallSeconds * 1e6 << "\n";
+        }
+    }
+}
+
+void
+LrWpanEventProfiler::WriteFolded(std::ostream& os)
+{
+    const ProfilerState& state = GetState();
+    for (const auto& [key, seconds] : state.stacks)
+    {
+        os << "node-" << SlotLabel(key.first);
+        for (uint32_t h : key.second)
+        {
+            os << ";" << state.names[h];
+        }
+        os << " " << static_cast<uint64_t>(seconds * 1e9) << "\n";
+    }
+}
+
+} // namespace lrwpan
+} // namespace ns3
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef LR_WPAN_EVENT_PROFILER_H
+#define LR_WPAN_EVENT_PROFILER_H
+
+#include "ns3/event-id.h"
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @ingroup lr-wpan
+ *
+ * @brief Opt-in, process-wide profile of the scheduler events of the lr-wpan
+ * and rit-wpan objects, per node and per handler.
+ *
+ * The instrumented handlers (CSMA/CA backoffs and CCAs, PHY CCAs and TRX
+ * turnarounds, RIT MAC timers, Pre-CS CCA confirms, NWK retries) register a
+ * name once and report when one of their events is scheduled, cancelled or
+ * executed; an execution also measures the wall time spent in the handler.
+ * The node is the simulator context of the event.
+ *
+ * When the profiler is disabled (the default) every report is a test of one
+ * static flag. The results are written as a flat table (WriteTable()) and as
+ * folded stacks for flamegraph.pl or speedscope (WriteFolded()), where nested
+ * handlers (a CCA confirm run by the PHY CCA event) show as stacks and the
+ * values are the self wall times in nanoseconds.
+ */
+class LrWpanEventProfiler
+{
+  public:
+    /**
+     * Counters of one handler on one node.
+     */
+    struct Counters
+    {
+        uint64_t scheduled = 0; //!< Events scheduled
+        uint64_t executed = 0;  //!< Events executed
+        uint64_t cancelled = 0; //!< Pending events cancelled or replaced
+        double wallSeconds = 0; //!< Wall time in the handler, nested handlers included
+    };
+
+    /**
+     * @brief Start counting (the counters are kept, see Reset()).
+     */
+    static void Enable();
+
+    /**
+     * @brief Stop counting.
+     */
+    static void Disable();
+
+    /**
+     * @return true if the events are counted
+     */
+    static bool IsEnabled()
+    {
+        return s_enabled;
+    }
+
+    /**
+     * @brief Clear every counter; the registered handlers are kept.
+     */
+    static void Reset();
+
+    /**
+     * @brief Get the id of a handler, registering its name the first time.
+     * @param name Handler name, e.g. "LrWpanCsmaCa::RandomBackoffDelay"
+     * @return the handler id
+     */
+    static uint32_t RegisterHandler(const std::string& name);
+
+    /**
+     * @brief Count an event of a handler scheduled in the current context.
+     * @param handler Handler id
+     */
+    static void RecordScheduled(uint32_t handler)
+    {
+        if (s_enabled)
+        {
+            DoRecordScheduled(handler);
+        }
+    }
+
+    /**
+     * @brief Count the cancellation of an event of a handler, if it is pending.
+     * @param handler Handler id
+     * @param event The event about to be cancelled
+     */
+    static void RecordCancelled(uint32_t handler, const EventId& event)
+    {
+        if (s_enabled && event.IsPending())
+        {
+            DoRecordCancelled(handler);
+        }
+    }
+
+    /**
+     * @brief Count the cancellation of a pending logical event (e.g. a timer).
+     * @param handler Handler id
+     */
+    static void RecordCancelled(uint32_t handler)
+    {
+        if (s_enabled)
+        {
+            DoRecordCancelled(handler);
+        }
+    }
+
+    /**
+     * @brief Counts one execution of a handler and its wall time, from the
+     * construction to the destruction of the scope.
+     */
+    class Scope
+    {
+      public:
+        /**
+         * @param handler Handler id
+         */
+        explicit Scope(uint32_t handler)
+            : m_active(s_enabled)
+        {
+            if (m_active)
+            {
+                Enter(handler);
+            }
+        }
+
+        ~Scope()
+        {
+            if (m_active)
+            {
+                Leave();
+            }
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+      private:
+        bool m_active; //!< Whether the profiler was enabled at the entry
+    };
+
+    /**
+     * @brief Get the counters of a handler on a node.
+     * @param node Node id (simulator context)
+     * @param name Handler name
+     * @return the counters, all zero if the handler never ran there
+     */
+    static Counters GetCounters(uint32_t node, const std::string& name);
+
+    /**
+     * @brief Get the counters of a handler summed over the nodes.
+     * @param name Handler name
+     * @return the counters
+     */
+    static Counters GetTotal(const std::string& name);
+
+    /**
+     * @brief Write one line per node and handler seen:
+     * node,handler,scheduled,executed,cancelled,wall_us (node "-" outside any
+     * node context).
+     * @param os The output stream
+     */
+    static void WriteTable(std::ostream& os);
+
+    /**
+     * @brief Write the folded stacks "node-<id>;<handler>[;<nested>] <self ns>".
+     * @param os The output stream
+     */
+    static void WriteFolded(std::ostream& os);
+
+  private:
+    /**
+     * @brief Count a scheduled event.
+     * @param handler Handler id
+     */
+    static void DoRecordScheduled(uint32_t handler);
+
+    /**
+     * @brief Count a cancelled event.
+     * @param handler Handler id
+     */
+    static void DoRecordCancelled(uint32_t handler);
+
+    /**
+     * @brief Open the execution scope of a handler.
+     * @param handler Handler id
+     */
+    static void Enter(uint32_t handler);
+
+    /**
+     * @brief Close the innermost execution scope.
+     */
+    static void Leave();
+
+    static bool s_enabled; //!< Whether the events are counted
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // LR_WPAN_EVENT_PROFILER_H
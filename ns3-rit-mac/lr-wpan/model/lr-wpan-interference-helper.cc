@@ -8,6 +8,8 @@
  */
 #include "lr-wpan-interference-helper.h"
 
+#include "lr-wpan-spectrum-value-helper.h"
+
 #include "ns3/log.h"
 #include "ns3/spectrum-model.h"
 #include "ns3/spectrum-value.h"
@@ -21,6 +23,8 @@ NS_LOG_COMPONENT_DEFINE("LrWpanInterferenceHelper");
 
 LrWpanInterferenceHelper::LrWpanInterferenceHelper(Ptr<const SpectrumModel> spectrumModel)
     : m_spectrumModel(spectrumModel),
+      m_channel(11),
+      m_inBandPower(0.0),
       m_dirty(false)
 {
     m_signal = Create<SpectrumValue>(m_spectrumModel);
@@ -38,14 +42,39 @@ LrWpanInterferenceHelper::AddSignal(Ptr<const SpectrumValue> signal)
 {
     NS_LOG_FUNCTION(this << signal);
 
+    if (signal->GetSpectrumModel() != m_spectrumModel)
+    {
+        return false;
+    }
+    return AddSignal(signal, LrWpanSpectrumValueHelper::TotalAvgPower(signal, m_channel));
+}
+
+bool
+LrWpanInterferenceHelper::AddSignal(Ptr<const SpectrumValue> signal, double power, double gain)
+{
+    return AddSignal(PeekPointer(signal), signal, power, gain);
+}
+
+bool
+LrWpanInterferenceHelper::AddSignal(const void* id,
+                                    Ptr<const SpectrumValue> signal,
+                                    double power,
+                                    double gain)
+{
+    NS_LOG_FUNCTION(this << id << signal << power << gain);
+
     bool result = false;
 
     if (signal->GetSpectrumModel() == m_spectrumModel)
     {
-        result = m_signals.insert(signal).second;
-        if (result && !m_dirty)
+        result = m_signals.emplace(id, SignalInfo{signal, power, gain}).second;
+        if (result)
         {
-            *m_signal += *signal;
+            m_inBandPower += power;
+            if (!m_dirty)
+            {
+                *m_signal += *signal * gain;
+            }
         }
     }
     return result;
@@ -56,17 +85,32 @@ LrWpanInterferenceHelper::RemoveSignal(Ptr<const SpectrumValue> signal)
 {
     NS_LOG_FUNCTION(this << signal);
 
-    bool result = false;
+    if (signal->GetSpectrumModel() != m_spectrumModel)
+    {
+        return false;
+    }
+    return RemoveSignal(static_cast<const void*>(PeekPointer(signal)));
+}
 
-    if (signal->GetSpectrumModel() == m_spectrumModel)
+bool
+LrWpanInterferenceHelper::RemoveSignal(const void* id)
+{
+    NS_LOG_FUNCTION(this << id);
+
+    auto it = m_signals.find(id);
+    if (it == m_signals.end())
     {
-        result = (m_signals.erase(signal) == 1);
-        if (result)
-        {
-            m_dirty = true;
-        }
+        return false;
     }
-    return result;
+    m_inBandPower -= it->second.power;
+    m_signals.erase(it);
+    // Do not let rounding errors accumulate over long runs
+    if (m_signals.empty() || m_inBandPower < 0.0)
+    {
+        m_inBandPower = 0.0;
+    }
+    m_dirty = true;
+    return true;
 }
 
 void
@@ -75,6 +119,7 @@ LrWpanInterferenceHelper::ClearSignals()
     NS_LOG_FUNCTION(this);
 
     m_signals.clear();
+    m_inBandPower = 0.0;
     m_dirty = true;
 }
 
@@ -89,7 +134,7 @@ LrWpanInterferenceHelper::GetSignalPsd() const
         m_signal = Create<SpectrumValue>(m_spectrumModel);
         for (auto it = m_signals.begin(); it != m_signals.end(); ++it)
         {
-            *m_signal += *(*it);
+            *m_signal += *(it->second.psd) * it->second.gain;
         }
         m_dirty = false;
     }
@@ -97,5 +142,43 @@ LrWpanInterferenceHelper::GetSignalPsd() const
     return m_signal->Copy();
 }
 
+void
+LrWpanInterferenceHelper::SetChannel(uint32_t channel)
+{
+    NS_LOG_FUNCTION(this << channel);
+
+    m_channel = channel;
+    m_inBandPower = 0.0;
+    for (auto& [id, info] : m_signals)
+    {
+        info.power = info.gain * LrWpanSpectrumValueHelper::TotalAvgPower(info.psd, m_channel);
+        m_inBandPower += info.power;
+    }
+}
+
+uint32_t
+LrWpanInterferenceHelper::GetChannel() const
+{
+    return m_channel;
+}
+
+double
+LrWpanInterferenceHelper::GetInBandPower() const
+{
+    return m_inBandPower;
+}
+
+bool
+LrWpanInterferenceHelper::IsEmpty() const
+{
+    return m_signals.empty();
+}
+
+Ptr<const SpectrumModel>
+LrWpanInterferenceHelper::GetSpectrumModel() const
+{
+    return m_spectrumModel;
+}
+
 } // namespace lrwpan
 } // namespace ns3
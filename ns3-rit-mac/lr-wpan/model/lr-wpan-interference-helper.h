@@ -12,7 +12,8 @@
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
 
-#include <set>
+#include <cstdint>
+#include <map>
 
 namespace ns3
 {
@@ -51,6 +52,42 @@ class LrWpanInterferenceHelper : public SimpleRefCount<LrWpanInterferenceHelper>
      */
     bool AddSignal(Ptr<const SpectrumValue> signal);
 
+    /**
+     * Add the given signal whose in-band power on the current channel is already
+     * known (e.g. LrWpanSpectrumSignalParameters::GetInBandPower()).
+     *
+     * @param signal the signal to be added
+     * @param inBandPower the in-band power of the signal on the current channel (W)
+     * @param gain the linear gain not applied to signal yet
+     * (LrWpanSpectrumSignalParameters::psdGain)
+     * @return false, if the signal was not added, true otherwise.
+     */
+    bool AddSignal(Ptr<const SpectrumValue> signal, double inBandPower, double gain = 1.0);
+
+    /**
+     * Add a signal told apart by an identifier instead of its PSD, e.g. the
+     * signal parameters of a reception. Needed when several signals share one
+     * PSD object, like narrowband receptions of a cached transmit PSD
+     * (LrWpanSpectrumValueHelper::GetSharedTxPowerSpectralDensity()).
+     *
+     * @param id the identifier of the signal, used by RemoveSignal(const void*)
+     * @param signal the PSD of the signal
+     * @param inBandPower the in-band power of the signal on the current channel (W)
+     * @param gain the linear gain not applied to signal yet
+     * @return false, if the signal was not added, true otherwise.
+     */
+    bool AddSignal(const void* id,
+                   Ptr<const SpectrumValue> signal,
+                   double inBandPower,
+                   double gain = 1.0);
+
+    /**
+     * Get the channel used to compute the in-band power of the signals.
+     *
+     * @return the channel number
+     */
+    uint32_t GetChannel() const;
+
     /**
      * Remove the given signal to the set of accumulated signals.
      *
@@ -60,6 +97,15 @@ class LrWpanInterferenceHelper : public SimpleRefCount<LrWpanInterferenceHelper>
      */
     bool RemoveSignal(Ptr<const SpectrumValue> signal);
 
+    /**
+     * Remove a signal added by AddSignal(const void*, ...).
+     *
+     * @param id the identifier of the signal
+     * @return false, if the signal was not removed (because it was not added
+     * before), true otherwise.
+     */
+    bool RemoveSignal(const void* id);
+
     /**
      * Remove all currently accumulated signals.
      */
@@ -72,6 +118,30 @@ class LrWpanInterferenceHelper : public SimpleRefCount<LrWpanInterferenceHelper>
      */
     Ptr<SpectrumValue> GetSignalPsd() const;
 
+    /**
+     * Set the channel used to compute the in-band power of the signals.
+     * The per-signal powers and the running total are recomputed.
+     *
+     * @param channel the channel number (see LrWpanSpectrumValueHelper::TotalAvgPower)
+     */
+    void SetChannel(uint32_t channel);
+
+    /**
+     * Get the total in-band power of all accumulated signals on the current channel.
+     * This is equal to TotalAvgPower(GetSignalPsd(), channel), but kept up to date
+     * incrementally by AddSignal() and RemoveSignal() without any PSD copy.
+     *
+     * @return the total in-band power in W
+     */
+    double GetInBandPower() const;
+
+    /**
+     * Check whether no signal is currently accumulated.
+     *
+     * @return true if the helper holds no signal
+     */
+    bool IsEmpty() const;
+
     /**
      * Get the SpectrumModel used by the helper.
      *
@@ -96,9 +166,30 @@ class LrWpanInterferenceHelper : public SimpleRefCount<LrWpanInterferenceHelper>
     Ptr<const SpectrumModel> m_spectrumModel;
 
     /**
-     * The set of accumulated signals.
+     * An accumulated signal.
+     */
+    struct SignalInfo
+    {
+        Ptr<const SpectrumValue> psd; //!< PSD of the signal
+        double power;                 //!< In-band power on m_channel (W)
+        double gain;                  //!< Linear gain not applied to the signal PSD yet
+    };
+
+    /**
+     * The accumulated signals, by identifier (the PSD pointer for the signals
+     * added without one).
+     */
+    std::map<const void*, SignalInfo> m_signals;
+
+    /**
+     * The channel used for the in-band power of the signals.
+     */
+    uint32_t m_channel;
+
+    /**
+     * The running sum of the in-band power of m_signals (W).
      */
-    std::set<Ptr<const SpectrumValue>> m_signals;
+    double m_inBandPower;
 
     /**
      * The precomputed sum of all accumulated signals.
@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef LR_WPAN_LAZY_TRACE_H
+#define LR_WPAN_LAZY_TRACE_H
+
+#include "ns3/callback.h"
+#include "ns3/traced-callback.h"
+
+#include <memory>
+#include <ostream>
+#include <string>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @ingroup lr-wpan
+ *
+ * @brief TracedCallback whose list of sinks is allocated when the first sink connects.
+ *
+ * It takes one pointer in the object instead of an empty std::list, and firing a trace
+ * source nobody connected to is the test of that pointer. It registers with
+ * MakeTraceSourceAccessor() like a TracedCallback; the sinks stay allocated once
+ * connected.
+ *
+ * @tparam Ts The arguments of the sinks
+ */
+template <typename... Ts>
+class LazyTracedCallback
+{
+  public:
+    /**
+     * @brief Append a sink that takes no context.
+     * @param callback The sink
+     */
+    void ConnectWithoutContext(const CallbackBase& callback)
+    {
+        Sinks().ConnectWithoutContext(callback);
+    }
+
+    /**
+     * @brief Append a sink called with a context.
+     * @param callback The sink
+     * @param path The context given to the sink
+     */
+    void Connect(const CallbackBase& callback, std::string path)
+    {
+        Sinks().Connect(callback, path);
+    }
+
+    /**
+     * @brief Remove a sink that takes no context.
+     * @param callback The sink
+     */
+    void DisconnectWithoutContext(const CallbackBase& callback)
+    {
+        if (m_sinks)
+        {
+            m_sinks->DisconnectWithoutContext(callback);
+        }
+    }
+
+    /**
+     * @brief Remove a sink called with a context.
+     * @param callback The sink
+     * @param path Its context
+     */
+    void Disconnect(const CallbackBase& callback, std::string path)
+    {
+        if (m_sinks)
+        {
+            m_sinks->Disconnect(callback, path);
+        }
+    }
+
+    /**
+     * @brief Call the sinks, if any.
+     * @param args The arguments
+     */
+    void operator()(Ts... args) const
+    {
+        if (m_sinks)
+        {
+            (*m_sinks)(args...);
+        }
+    }
+
+    /**
+     * @return true if no sink is connected
+     */
+    bool IsEmpty() const
+    {
+        return !m_sinks || m_sinks->IsEmpty();
+    }
+
+  private:
+    /**
+     * @return the sinks, allocated if needed
+     */
+    TracedCallback<Ts...>& Sinks()
+    {
+        if (!m_sinks)
+        {
+            m_sinks = std::make_unique<TracedCallback<Ts...>>();
+        }
+        return *m_sinks;
+    }
+
+    std::unique_ptr<TracedCallback<Ts...>> m_sinks; //!< The sinks, null until one connects
+};
+
+/**
+ * @ingroup lr-wpan
+ *
+ * @brief TracedValue whose list of sinks is allocated when the first sink connects.
+ *
+ * The sinks are called with the old and the new value on every change, as those of
+ * a TracedValue. The value converts implicitly to T for reading.
+ *
+ * @tparam T The type of the value
+ */
+template <typename T>
+class LazyTracedValue
+{
+  public:
+    LazyTracedValue()
+        : m_v()
+    {
+    }
+
+    /**
+     * @param v The initial value
+     */
+    LazyTracedValue(const T& v)
+        : m_v(v)
+    {
+    }
+
+    /**
+     * @brief Copy the value only, the sinks stay with the original.
+     * @param o The other traced value
+     */
+    LazyTracedValue(const LazyTracedValue& o)
+        : m_v(o.m_v)
+    {
+    }
+
+    /**
+     * @brief Set the value from another one, firing the sinks if it changes.
+     * @param o The other traced value
+     * @return this
+     */
+    LazyTracedValue& operator=(const LazyTracedValue& o)
+    {
+        Set(o.m_v);
+        return *this;
+    }
+
+    /**
+     * @brief Set the value, firing the sinks if it changes.
+     * @param v The new value
+     * @return this
+     */
+    LazyTracedValue& operator=(const T& v)
+    {
+        Set(v);
+        return *this;
+    }
+
+    /**
+     * @brief Set the value, firing the sinks if it changes.
+     * @param v The new value
+     */
+    void Set(const T& v)
+    {
+        if (m_v != v)
+        {
+            m_cb(m_v, v);
+            m_v = v;
+        }
+    }
+
+    /**
+     * @return the value
+     */
+    T Get() const
+    {
+        return m_v;
+    }
+
+    /**
+     * @return the value
+     */
+    operator T() const
+    {
+        return m_v;
+    }
+
+    /**
+     * @brief Append a sink that takes no context.
+     * @param callback The sink
+     */
+    void ConnectWithoutContext(const CallbackBase& callback)
+    {
+        m_cb.ConnectWithoutContext(callback);
+    }
+
+    /**
+     * @brief Append a sink called with a context.
+     * @param callback The sink
+     * @param path The context given to the sink
+     */
+    void Connect(const CallbackBase& callback, std::string path)
+    {
+        m_cb.Connect(callback, path);
+    }
+
+    /**
+     * @brief Remove a sink that takes no context.
+     * @param callback The sink
+     */
+    void DisconnectWithoutContext(const CallbackBase& callback)
+    {
+        m_cb.DisconnectWithoutContext(callback);
+    }
+
+    /**
+     * @brief Remove a sink called with a context.
+     * @param callback The sink
+     * @param path Its context
+     */
+    void Disconnect(const CallbackBase& callback, std::string path)
+    {
+        m_cb.Disconnect(callback, path);
+    }
+
+    /**
+     * @return true if no sink is connected
+     */
+    bool IsEmpty() const
+    {
+        return m_cb.IsEmpty();
+    }
+
+  private:
+    T m_v;                         //!< The value
+    LazyTracedCallback<T, T> m_cb; //!< Sinks of the changes
+};
+
+/**
+ * @brief Output the value of a LazyTracedValue.
+ * @param os The output stream
+ * @param rhs The traced value
+ * @return the output stream
+ */
+template <typename T>
+std::ostream&
+operator<<(std::ostream& os, const LazyTracedValue<T>& rhs)
+{
+    return os << rhs.Get();
+}
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif /* LR_WPAN_LAZY_TRACE_H */
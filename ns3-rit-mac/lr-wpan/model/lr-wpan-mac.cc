@@ -27,6 +27,9 @@
 #include "ns3/simulator.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+#include <limits>
+
 #undef NS_LOG_APPEND_CONTEXT
 #define NS_LOG_APPEND_CONTEXT                                                                      \
     std::clog << "[" << m_shortAddress << " | " << m_macExtendedAddress << "] ";
@@ -233,14 +236,13 @@ LrWpanMac::LrWpanMac()
     m_numLostBeacons = 0;
 
     m_pendPrimitive = MLME_NONE;
-    m_channelScanIndex = 0;
     m_maxEnergyLevel = 0;
 
     m_macResponseWaitTime = lrwpan::aBaseSuperframeDuration * 32;
     m_assocRespCmdWaitTime = 960;
 
     m_maxTxQueueSize = m_txQueue.max_size();
-    m_maxIndTxQueueSize = m_indTxQueue.max_size();
+    m_maxIndTxQueueSize = std::numeric_limits<uint32_t>::max();
 
     m_uniformVar = CreateObject<UniformRandomVariable>();
     m_macDsn = SequenceNumber8(m_uniformVar->GetInteger(0, 255));
@@ -290,12 +292,6 @@ LrWpanMac::DoDispose()
     }
     m_txQueue.clear();
 
-    for (uint32_t i = 0; i < m_indTxQueue.size(); i++)
-    {
-        m_indTxQueue[i]->txQPkt = nullptr;
-    }
-    m_indTxQueue.clear();
-
     m_uniformVar = nullptr;
     m_phy = nullptr;
     m_mcpsDataConfirmCallback = MakeNullCallback<void, McpsDataConfirmParams>();
@@ -311,19 +307,41 @@ LrWpanMac::DoDispose()
     m_mlmeCommStatusIndicationCallback = MakeNullCallback<void, MlmeCommStatusIndicationParams>();
     m_mlmeOrphanIndicationCallback = MakeNullCallback<void, MlmeOrphanIndicationParams>();
 
-    m_panDescriptorList.clear();
-    m_energyDetectList.clear();
-    m_unscannedChannels.clear();
-
-    m_scanEvent.Cancel();
-    m_scanEnergyEvent.Cancel();
-    m_scanOrphanEvent.Cancel();
-    m_beaconEvent.Cancel();
-    m_assocResCmdWaitTimeout.Cancel();
+    if (m_beaconState)
+    {
+        for (auto& [order, indTxQElement] : m_beaconState->indTxQueue)
+        {
+            indTxQElement->txQPkt = nullptr;
+        }
+        m_beaconState->scanEvent.Cancel();
+        m_beaconState->scanEnergyEvent.Cancel();
+        m_beaconState->scanOrphanEvent.Cancel();
+        m_beaconState->beaconEvent.Cancel();
+        m_beaconState->beaconWakeEvent.Cancel();
+        m_beaconState->assocResCmdWaitTimeout.Cancel();
+        m_beaconState = nullptr;
+    }
 
     Object::DoDispose();
 }
 
+LrWpanMac::BeaconState&
+LrWpanMac::GetBeaconState()
+{
+    if (!m_beaconState)
+    {
+        NS_LOG_DEBUG(this << " Allocating the beacon-mode state");
+        m_beaconState = std::make_unique<BeaconState>();
+    }
+    return *m_beaconState;
+}
+
+bool
+LrWpanMac::HasBeaconState() const
+{
+    return m_beaconState != nullptr;
+}
+
 bool
 LrWpanMac::GetRxOnWhenIdle() const
 {
@@ -605,10 +623,10 @@ LrWpanMac::MlmeStartRequest(MlmeStartRequestParams params)
 
     // Mark primitive as pending and save the start params while the new page and channel is set.
     m_pendPrimitive = MLME_START_REQ;
-    m_startParams = params;
+    GetBeaconState().startParams = params;
 
     Ptr<PhyPibAttributes> pibAttr = Create<PhyPibAttributes>();
-    pibAttr->phyCurrentPage = m_startParams.m_logChPage;
+    pibAttr->phyCurrentPage = GetBeaconState().startParams.m_logChPage;
     m_phy->PlmeSetAttributeRequest(PhyPibAttributeIdentifier::phyCurrentPage, pibAttr);
 }
 
@@ -617,11 +635,14 @@ LrWpanMac::MlmeScanRequest(MlmeScanRequestParams params)
 {
     NS_LOG_FUNCTION(this);
 
+    BeaconState& state = GetBeaconState();
+
     MlmeScanConfirmParams confirmParams;
     confirmParams.m_scanType = params.m_scanType;
     confirmParams.m_chPage = params.m_chPage;
 
-    if ((m_scanEvent.IsPending() || m_scanEnergyEvent.IsPending()) || m_scanOrphanEvent.IsPending())
+    if ((state.scanEvent.IsPending() || state.scanEnergyEvent.IsPending()) ||
+        state.scanOrphanEvent.IsPending())
     {
         if (!m_mlmeScanConfirmCallback.IsNull())
         {
@@ -646,25 +667,25 @@ LrWpanMac::MlmeScanRequest(MlmeScanRequestParams params)
     m_macPanIdScan = m_macPanId;
     m_macPanId = 0xFFFF;
 
-    m_panDescriptorList.clear();
-    m_energyDetectList.clear();
-    m_unscannedChannels.clear();
+    state.panDescriptorList.clear();
+    state.energyDetectList.clear();
+    state.unscannedChannels.clear();
 
     // TODO: stop beacon transmission
 
     // Cancel any ongoing CSMA/CA operations and set to unslotted mode for scan
     m_csmaCa->Cancel();
-    m_capEvent.Cancel();
-    m_cfpEvent.Cancel();
-    m_incCapEvent.Cancel();
-    m_incCfpEvent.Cancel();
-    m_trackingEvent.Cancel();
+    state.capEvent.Cancel();
+    state.cfpEvent.Cancel();
+    state.incCapEvent.Cancel();
+    state.incCfpEvent.Cancel();
+    state.trackingEvent.Cancel();
     m_csmaCa->SetUnSlottedCsmaCa();
 
-    m_channelScanIndex = 0;
+    state.channelScanIndex = 0;
 
     // Mark primitive as pending and save the scan params while the new page and/or channel is set.
-    m_scanParams = params;
+    state.scanParams = params;
     m_pendPrimitive = MLME_SCAN_REQ;
 
     Ptr<PhyPibAttributes> pibAttr = Create<PhyPibAttributes>();
@@ -681,7 +702,7 @@ LrWpanMac::MlmeAssociateRequest(MlmeAssociateRequestParams params)
     // the values of the Associate.request params usually come from the information
     // obtained from those operations.
     m_pendPrimitive = MLME_ASSOC_REQ;
-    m_associateParams = params;
+    GetBeaconState().associateParams = params;
     m_ignoreDataCmdAck = false;
 
     bool invalidRequest = false;
@@ -711,7 +732,7 @@ LrWpanMac::MlmeAssociateRequest(MlmeAssociateRequestParams params)
     if (invalidRequest)
     {
         m_pendPrimitive = MLME_NONE;
-        m_associateParams = MlmeAssociateRequestParams();
+        GetBeaconState().associateParams = MlmeAssociateRequestParams();
         NS_LOG_ERROR(this << " Invalid PAN id in Association request");
         if (!m_mlmeAssociateConfirmCallback.IsNull())
         {
@@ -732,17 +753,19 @@ LrWpanMac::MlmeAssociateRequest(MlmeAssociateRequestParams params)
 void
 LrWpanMac::EndAssociateRequest()
 {
+    BeaconState& state = GetBeaconState();
+
     // the primitive is no longer pending (channel & page are set)
     m_pendPrimitive = MLME_NONE;
     // As described in IEEE 802.15.4-2011 (Section 5.1.3.1)
-    m_macPanId = m_associateParams.m_coordPanId;
-    if (m_associateParams.m_coordAddrMode == SHORT_ADDR)
+    m_macPanId = state.associateParams.m_coordPanId;
+    if (state.associateParams.m_coordAddrMode == SHORT_ADDR)
     {
-        m_macCoordShortAddress = m_associateParams.m_coordShortAddr;
+        m_macCoordShortAddress = state.associateParams.m_coordShortAddr;
     }
     else
     {
-        m_macCoordExtendedAddress = m_associateParams.m_coordExtAddr;
+        m_macCoordExtendedAddress = state.associateParams.m_coordExtAddr;
         m_macCoordShortAddress = Mac16Address("ff:fe");
     }
 
@@ -858,6 +881,9 @@ void
 LrWpanMac::MlmeSyncRequest(MlmeSyncRequestParams params)
 {
     NS_LOG_FUNCTION(this);
+
+    BeaconState& state = GetBeaconState();
+
     NS_ASSERT(params.m_logCh <= 26 && m_macPanId != 0xffff);
 
     auto symbolRate = (uint64_t)m_phy->GetDataOrSymbolRate(false); // symbols per second
@@ -866,26 +892,27 @@ LrWpanMac::MlmeSyncRequest(MlmeSyncRequestParams params)
     pibAttr->phyCurrentChannel = params.m_logCh;
     m_phy->PlmeSetAttributeRequest(PhyPibAttributeIdentifier::phyCurrentChannel, pibAttr);
 
-    // Enable Phy receiver
+    // Enable Phy receiver, kept on until the beacon is received
+    state.beaconWake = true;
     m_phy->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_RX_ON);
 
     uint64_t searchSymbols;
     Time searchBeaconTime;
 
-    if (m_trackingEvent.IsPending())
+    if (state.trackingEvent.IsPending())
     {
-        m_trackingEvent.Cancel();
+        state.trackingEvent.Cancel();
     }
 
     if (params.m_trackBcn)
     {
         m_numLostBeacons = 0;
-        // search for a beacon for a time = incomingSuperframe symbols + 960 symbols
+        // search for a beacon for a time = aBaseSuperframeDuration * (2^BO + 1) symbols
         searchSymbols =
-            ((uint64_t)1 << m_incomingBeaconOrder) + 1 * lrwpan::aBaseSuperframeDuration;
+            (((uint64_t)1 << m_incomingBeaconOrder) + 1) * lrwpan::aBaseSuperframeDuration;
         searchBeaconTime = Seconds((double)searchSymbols / symbolRate);
         m_beaconTrackingOn = true;
-        m_trackingEvent =
+        state.trackingEvent =
             Simulator::Schedule(searchBeaconTime, &LrWpanMac::BeaconSearchTimeout, this);
     }
     else
@@ -1251,6 +1278,8 @@ LrWpanMac::SendAssocRequestCommand()
 {
     NS_LOG_FUNCTION(this);
 
+    BeaconState& state = GetBeaconState();
+
     LrWpanMacHeader macHdr(LrWpanMacHeader::LRWPAN_MAC_COMMAND, m_macDsn.GetValue());
     m_macDsn++;
     LrWpanMacTrailer macTrailer;
@@ -1260,22 +1289,24 @@ LrWpanMac::SendAssocRequestCommand()
     macHdr.SetSrcAddrMode(LrWpanMacHeader::EXTADDR);
     macHdr.SetSrcAddrFields(0xffff, GetExtendedAddress());
 
-    if (m_associateParams.m_coordAddrMode == SHORT_ADDR)
+    if (state.associateParams.m_coordAddrMode == SHORT_ADDR)
     {
         macHdr.SetDstAddrMode(LrWpanMacHeader::SHORTADDR);
-        macHdr.SetDstAddrFields(m_associateParams.m_coordPanId, m_associateParams.m_coordShortAddr);
+        macHdr.SetDstAddrFields(state.associateParams.m_coordPanId,
+                                state.associateParams.m_coordShortAddr);
     }
     else
     {
         macHdr.SetDstAddrMode(LrWpanMacHeader::EXTADDR);
-        macHdr.SetDstAddrFields(m_associateParams.m_coordPanId, m_associateParams.m_coordExtAddr);
+        macHdr.SetDstAddrFields(state.associateParams.m_coordPanId,
+                                state.associateParams.m_coordExtAddr);
     }
 
     macHdr.SetSecDisable();
     macHdr.SetAckReq();
 
     CommandPayloadHeader macPayload(CommandPayloadHeader::ASSOCIATION_REQ);
-    macPayload.SetCapabilityField(m_associateParams.m_capabilityInfo);
+    macPayload.SetCapabilityField(state.associateParams.m_capabilityInfo);
 
     commandPacket->AddHeader(macPayload);
     commandPacket->AddHeader(macHdr);
@@ -1400,10 +1431,13 @@ void
 LrWpanMac::EndStartRequest()
 {
     NS_LOG_FUNCTION(this);
+
+    BeaconState& state = GetBeaconState();
+
     // The primitive is no longer pending (Channel & Page have been set)
     m_pendPrimitive = MLME_NONE;
 
-    if (m_startParams.m_coorRealgn) // Coordinator Realignment
+    if (state.startParams.m_coorRealgn) // Coordinator Realignment
     {
         // TODO: Send realignment request command frame in CSMA/CA
         NS_LOG_ERROR(this << " Coordinator realignment request not supported");
@@ -1411,17 +1445,17 @@ LrWpanMac::EndStartRequest()
     }
     else
     {
-        if (m_startParams.m_panCoor)
+        if (state.startParams.m_panCoor)
         {
             m_panCoor = true;
         }
 
         m_coor = true;
-        m_macPanId = m_startParams.m_PanId;
+        m_macPanId = state.startParams.m_PanId;
 
-        NS_ASSERT(m_startParams.m_PanId != 0xffff);
+        NS_ASSERT(state.startParams.m_PanId != 0xffff);
 
-        m_macBeaconOrder = m_startParams.m_bcnOrd;
+        m_macBeaconOrder = state.startParams.m_bcnOrd;
         if (m_macBeaconOrder == 15)
         {
             // Non-beacon enabled PAN
@@ -1431,14 +1465,14 @@ LrWpanMac::EndStartRequest()
             m_beaconInterval = 0;
 
             m_csmaCa->Cancel();
-            m_capEvent.Cancel();
-            m_cfpEvent.Cancel();
-            m_incCapEvent.Cancel();
-            m_incCfpEvent.Cancel();
-            m_trackingEvent.Cancel();
-            m_scanEvent.Cancel();
-            m_scanOrphanEvent.Cancel();
-            m_scanEnergyEvent.Cancel();
+            state.capEvent.Cancel();
+            state.cfpEvent.Cancel();
+            state.incCapEvent.Cancel();
+            state.incCfpEvent.Cancel();
+            state.trackingEvent.Cancel();
+            state.scanEvent.Cancel();
+            state.scanOrphanEvent.Cancel();
+            state.scanEnergyEvent.Cancel();
 
             m_csmaCa->SetUnSlottedCsmaCa();
 
@@ -1453,8 +1487,8 @@ LrWpanMac::EndStartRequest()
         }
         else
         {
-            m_macSuperframeOrder = m_startParams.m_sfrmOrd;
-            m_csmaCa->SetBatteryLifeExtension(m_startParams.m_battLifeExt);
+            m_macSuperframeOrder = state.startParams.m_sfrmOrd;
+            m_csmaCa->SetBatteryLifeExtension(state.startParams.m_battLifeExt);
 
             m_csmaCa->SetSlottedCsmaCa();
 
@@ -1472,7 +1506,7 @@ LrWpanMac::EndStartRequest()
             // TODO: change the beacon sending according to the startTime parameter (if not PAN
             // coordinator)
 
-            m_beaconEvent = Simulator::ScheduleNow(&LrWpanMac::SendOneBeacon, this);
+            state.beaconEvent = Simulator::ScheduleNow(&LrWpanMac::SendOneBeacon, this);
         }
     }
 }
@@ -1482,25 +1516,27 @@ LrWpanMac::EndChannelScan()
 {
     NS_LOG_FUNCTION(this);
 
-    m_channelScanIndex++;
+    BeaconState& state = GetBeaconState();
+
+    state.channelScanIndex++;
 
     bool channelFound = false;
 
-    for (int i = m_channelScanIndex; i <= 26; i++)
+    for (int i = state.channelScanIndex; i <= 26; i++)
     {
-        if ((m_scanParams.m_scanChannels & (1 << m_channelScanIndex)) != 0)
+        if ((state.scanParams.m_scanChannels & (1 << state.channelScanIndex)) != 0)
         {
             channelFound = true;
             break;
         }
-        m_channelScanIndex++;
+        state.channelScanIndex++;
     }
 
     if (channelFound)
     {
         // Switch to the next channel in the list and restart scan
         Ptr<PhyPibAttributes> pibAttr = Create<PhyPibAttributes>();
-        pibAttr->phyCurrentChannel = m_channelScanIndex;
+        pibAttr->phyCurrentChannel = state.channelScanIndex;
         m_phy->PlmeSetAttributeRequest(PhyPibAttributeIdentifier::phyCurrentChannel, pibAttr);
     }
     else
@@ -1513,11 +1549,11 @@ LrWpanMac::EndChannelScan()
         // TODO: restart beacon transmissions that were active before the beginning of the scan
         // (i.e when a coordinator perform a scan and it was already transmitting beacons)
         MlmeScanConfirmParams confirmParams;
-        confirmParams.m_chPage = m_scanParams.m_chPage;
-        confirmParams.m_scanType = m_scanParams.m_scanType;
+        confirmParams.m_chPage = state.scanParams.m_chPage;
+        confirmParams.m_scanType = state.scanParams.m_scanType;
         confirmParams.m_energyDetList = {};
-        confirmParams.m_unscannedCh = m_unscannedChannels;
-        confirmParams.m_resultListSize = m_panDescriptorList.size();
+        confirmParams.m_unscannedCh = state.unscannedChannels;
+        confirmParams.m_resultListSize = state.panDescriptorList.size();
 
         // See IEEE 802.15.4-2011, Table 31 (panDescriptorList value on macAutoRequest)
         // and Section 6.2.10.2
@@ -1526,12 +1562,12 @@ LrWpanMac::EndChannelScan()
         case MLMESCAN_PASSIVE:
             if (m_macAutoRequest)
             {
-                confirmParams.m_panDescList = m_panDescriptorList;
+                confirmParams.m_panDescList = state.panDescriptorList;
             }
             confirmParams.m_status = MacStatus::SUCCESS;
             break;
         case MLMESCAN_ACTIVE:
-            if (m_panDescriptorList.empty())
+            if (state.panDescriptorList.empty())
             {
                 confirmParams.m_status = MacStatus::NO_BEACON;
             }
@@ -1539,7 +1575,7 @@ LrWpanMac::EndChannelScan()
             {
                 if (m_macAutoRequest)
                 {
-                    confirmParams.m_panDescList = m_panDescriptorList;
+                    confirmParams.m_panDescList = state.panDescriptorList;
                 }
                 confirmParams.m_status = MacStatus::SUCCESS;
             }
@@ -1560,8 +1596,8 @@ LrWpanMac::EndChannelScan()
         }
 
         m_pendPrimitive = MLME_NONE;
-        m_channelScanIndex = 0;
-        m_scanParams = {};
+        state.channelScanIndex = 0;
+        state.scanParams = {};
 
         if (!m_mlmeScanConfirmCallback.IsNull())
         {
@@ -1574,28 +1610,31 @@ void
 LrWpanMac::EndChannelEnergyScan()
 {
     NS_LOG_FUNCTION(this);
+
+    BeaconState& state = GetBeaconState();
+
     // Add the results of channel energy scan to the detectList
-    m_energyDetectList.emplace_back(m_maxEnergyLevel);
+    state.energyDetectList.emplace_back(m_maxEnergyLevel);
     m_maxEnergyLevel = 0;
 
-    m_channelScanIndex++;
+    state.channelScanIndex++;
 
     bool channelFound = false;
-    for (int i = m_channelScanIndex; i <= 26; i++)
+    for (int i = state.channelScanIndex; i <= 26; i++)
     {
-        if ((m_scanParams.m_scanChannels & (1 << m_channelScanIndex)) != 0)
+        if ((state.scanParams.m_scanChannels & (1 << state.channelScanIndex)) != 0)
         {
             channelFound = true;
             break;
         }
-        m_channelScanIndex++;
+        state.channelScanIndex++;
     }
 
     if (channelFound)
     {
         // switch to the next channel in the list and restart scan
         Ptr<PhyPibAttributes> pibAttr = Create<PhyPibAttributes>();
-        pibAttr->phyCurrentChannel = m_channelScanIndex;
+        pibAttr->phyCurrentChannel = state.channelScanIndex;
         m_phy->PlmeSetAttributeRequest(PhyPibAttributeIdentifier::phyCurrentChannel, pibAttr);
     }
     else
@@ -1612,13 +1651,13 @@ LrWpanMac::EndChannelEnergyScan()
         MlmeScanConfirmParams confirmParams;
         confirmParams.m_status = MacStatus::SUCCESS;
         confirmParams.m_chPage = m_phy->GetCurrentPage();
-        confirmParams.m_scanType = m_scanParams.m_scanType;
-        confirmParams.m_energyDetList = m_energyDetectList;
-        confirmParams.m_resultListSize = m_energyDetectList.size();
+        confirmParams.m_scanType = state.scanParams.m_scanType;
+        confirmParams.m_energyDetList = state.energyDetectList;
+        confirmParams.m_resultListSize = state.energyDetectList.size();
 
         m_pendPrimitive = MLME_NONE;
-        m_channelScanIndex = 0;
-        m_scanParams = {};
+        state.channelScanIndex = 0;
+        state.scanParams = {};
 
         if (!m_mlmeScanConfirmCallback.IsNull())
         {
@@ -1651,7 +1690,7 @@ LrWpanMac::StartCAP(SuperframeType superframeType)
                                                          << ")");
         NS_LOG_DEBUG("Active Slots duration " << activeSlot << " symbols");
 
-        m_capEvent =
+        GetBeaconState().capEvent =
             Simulator::Schedule(endCapTime, &LrWpanMac::StartCFP, this, SuperframeType::OUTGOING);
     }
     else
@@ -1668,7 +1707,7 @@ LrWpanMac::StartCAP(SuperframeType superframeType)
                                                          << ")");
         NS_LOG_DEBUG("Active Slots duration " << activeSlot << " symbols");
 
-        m_capEvent =
+        GetBeaconState().capEvent =
             Simulator::Schedule(endCapTime, &LrWpanMac::StartCFP, this, SuperframeType::INCOMING);
     }
 
@@ -1698,10 +1737,10 @@ LrWpanMac::StartCFP(SuperframeType superframeType)
         NS_LOG_DEBUG("Incoming superframe CFP duration " << cfpDuration << " symbols ("
                                                          << endCfpTime.As(Time::S) << ")");
 
-        m_incCfpEvent = Simulator::Schedule(endCfpTime,
-                                            &LrWpanMac::StartInactivePeriod,
-                                            this,
-                                            SuperframeType::INCOMING);
+        GetBeaconState().incCfpEvent = Simulator::Schedule(endCfpTime,
+                                                           &LrWpanMac::StartInactivePeriod,
+                                                           this,
+                                                           SuperframeType::INCOMING);
     }
     else
     {
@@ -1717,10 +1756,10 @@ LrWpanMac::StartCFP(SuperframeType superframeType)
         NS_LOG_DEBUG("Outgoing superframe CFP duration " << cfpDuration << " symbols ("
                                                          << endCfpTime.As(Time::S) << ")");
 
-        m_cfpEvent = Simulator::Schedule(endCfpTime,
-                                         &LrWpanMac::StartInactivePeriod,
-                                         this,
-                                         SuperframeType::OUTGOING);
+        GetBeaconState().cfpEvent = Simulator::Schedule(endCfpTime,
+                                                        &LrWpanMac::StartInactivePeriod,
+                                                        this,
+                                                        SuperframeType::OUTGOING);
     }
     // TODO: Start transmit or receive  GTS here.
 }
@@ -1746,7 +1785,24 @@ LrWpanMac::StartInactivePeriod(SuperframeType superframeType)
 
         NS_LOG_DEBUG("Incoming superframe Inactive Portion duration "
                      << inactiveDuration << " symbols (" << endInactiveTime.As(Time::S) << ")");
-        m_beaconEvent = Simulator::Schedule(endInactiveTime, &LrWpanMac::AwaitBeacon, this);
+        GetBeaconState().beaconEvent =
+            Simulator::Schedule(endInactiveTime, &LrWpanMac::AwaitBeacon, this);
+
+        if (!m_macRxOnWhenIdle && inactiveDuration > 0)
+        {
+            // Sleep through the inactive portion; the receiver must be on when the
+            // beacon starts.
+            if (m_macState == MAC_IDLE)
+            {
+                m_phy->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_TRX_OFF);
+            }
+            const uint64_t guard = lrwpan::aTurnaroundTime + lrwpan::aUnitBackoffPeriod;
+            const uint64_t sleep = inactiveDuration > guard ? inactiveDuration - guard : 0;
+            GetBeaconState().beaconWakeEvent =
+                Simulator::Schedule(Seconds((double)sleep / symbolRate),
+                                    &LrWpanMac::WakeForBeacon,
+                                    this);
+        }
     }
     else
     {
@@ -1760,7 +1816,8 @@ LrWpanMac::StartInactivePeriod(SuperframeType superframeType)
 
         NS_LOG_DEBUG("Outgoing superframe Inactive Portion duration "
                      << inactiveDuration << " symbols (" << endInactiveTime.As(Time::S) << ")");
-        m_beaconEvent = Simulator::Schedule(endInactiveTime, &LrWpanMac::SendOneBeacon, this);
+        GetBeaconState().beaconEvent =
+            Simulator::Schedule(endInactiveTime, &LrWpanMac::SendOneBeacon, this);
     }
 }
 
@@ -1776,6 +1833,23 @@ LrWpanMac::AwaitBeacon()
     //       received. See MLME-SyncLoss for details.
 }
 
+void
+LrWpanMac::WakeForBeacon()
+{
+    NS_LOG_FUNCTION(this);
+    GetBeaconState().beaconWake = true;
+    if (m_macState == MAC_IDLE)
+    {
+        m_phy->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_RX_ON);
+    }
+}
+
+bool
+LrWpanMac::IsIdleRxOn() const
+{
+    return m_macRxOnWhenIdle || (m_beaconState && m_beaconState->beaconWake);
+}
+
 void
 LrWpanMac::BeaconSearchTimeout()
 {
@@ -1787,7 +1861,10 @@ LrWpanMac::BeaconSearchTimeout()
         // syncLossParams.m_logCh =
         syncLossParams.m_lossReason = MacStatus::BEACON_LOSS;
         syncLossParams.m_panId = m_macPanId;
-        m_mlmeSyncLossIndicationCallback(syncLossParams);
+        if (!m_mlmeSyncLossIndicationCallback.IsNull())
+        {
+            m_mlmeSyncLossIndicationCallback(syncLossParams);
+        }
 
         m_beaconTrackingOn = false;
         m_numLostBeacons = 0;
@@ -1800,9 +1877,9 @@ LrWpanMac::BeaconSearchTimeout()
         uint64_t searchSymbols;
         Time searchBeaconTime;
         searchSymbols =
-            ((uint64_t)1 << m_incomingBeaconOrder) + 1 * lrwpan::aBaseSuperframeDuration;
+            (((uint64_t)1 << m_incomingBeaconOrder) + 1) * lrwpan::aBaseSuperframeDuration;
         searchBeaconTime = Seconds((double)searchSymbols / symbolRate);
-        m_trackingEvent =
+        GetBeaconState().trackingEvent =
             Simulator::Schedule(searchBeaconTime, &LrWpanMac::BeaconSearchTimeout, this);
     }
 }
@@ -1811,6 +1888,9 @@ void
 LrWpanMac::ReceiveBeacon(uint8_t lqi, Ptr<Packet> p)
 {
     NS_LOG_FUNCTION(this << lqi << p);
+
+    BeaconState& state = GetBeaconState();
+
     // The received beacon size in symbols
     // Beacon = Sync Header (SHR)[5 bytes] +
     //          PHY header (PHR) [1 byte]  +
@@ -1858,7 +1938,7 @@ LrWpanMac::ReceiveBeacon(uint8_t lqi, Ptr<Packet> p)
     panDescriptor.m_timeStamp = m_macBeaconRxTime;
 
     // Process beacon when device belongs to a PAN (associated device)
-    if (!m_scanEvent.IsPending() && m_macPanId == receivedMacHdr.GetDstPanId())
+    if (!state.scanEvent.IsPending() && m_macPanId == receivedMacHdr.GetDstPanId())
     {
         // We need to make sure to cancel any possible ongoing unslotted CSMA/CA
         // operations when receiving a beacon (e.g. Those taking place at the
@@ -1874,6 +1954,8 @@ LrWpanMac::ReceiveBeacon(uint8_t lqi, Ptr<Packet> p)
         if (m_incomingBeaconOrder < 15)
         {
             // Start Beacon-enabled mode
+            state.beaconWake = false;
+            state.beaconWakeEvent.Cancel();
             m_csmaCa->SetSlottedCsmaCa();
             m_incomingBeaconInterval = (static_cast<uint32_t>(1 << m_incomingBeaconOrder)) *
                                        lrwpan::aBaseSuperframeDuration;
@@ -1896,7 +1978,7 @@ LrWpanMac::ReceiveBeacon(uint8_t lqi, Ptr<Packet> p)
             NS_LOG_DEBUG("Incoming superframe Active Portion "
                          << "(Beacon + CAP + CFP): " << m_incomingSuperframeDuration << " symbols");
 
-            m_incCapEvent =
+            state.incCapEvent =
                 Simulator::ScheduleNow(&LrWpanMac::StartCAP, this, SuperframeType::INCOMING);
         }
         else
@@ -1907,7 +1989,7 @@ LrWpanMac::ReceiveBeacon(uint8_t lqi, Ptr<Packet> p)
 
         m_setMacState = Simulator::ScheduleNow(&LrWpanMac::SetLrWpanMacState, this, MAC_IDLE);
     }
-    else if (!m_scanEvent.IsPending() && m_macPanId == 0xFFFF)
+    else if (!state.scanEvent.IsPending() && m_macPanId == 0xFFFF)
     {
         NS_LOG_DEBUG(this << " Device not associated, cannot process beacon");
     }
@@ -1928,12 +2010,12 @@ LrWpanMac::ReceiveBeacon(uint8_t lqi, Ptr<Packet> p)
             }
         }
 
-        if (m_scanEvent.IsPending())
+        if (state.scanEvent.IsPending())
         {
             // Channel scanning is taking place, save only unique PAN descriptors
             bool descriptorExists = false;
 
-            for (const auto& descriptor : m_panDescriptorList)
+            for (const auto& descriptor : state.panDescriptorList)
             {
                 if (descriptor.m_coorAddrMode == SHORT_ADDR)
                 {
@@ -1959,16 +2041,16 @@ LrWpanMac::ReceiveBeacon(uint8_t lqi, Ptr<Packet> p)
 
             if (!descriptorExists)
             {
-                m_panDescriptorList.emplace_back(panDescriptor);
+                state.panDescriptorList.emplace_back(panDescriptor);
             }
             return;
         }
-        else if (m_trackingEvent.IsPending())
+        else if (state.trackingEvent.IsPending())
         {
             // check if MLME-SYNC.request was previously issued and running
             // Sync. is necessary to handle pending messages (indirect
             // transmissions)
-            m_trackingEvent.Cancel();
+            state.trackingEvent.Cancel();
             m_numLostBeacons = 0;
 
             if (m_beaconTrackingOn)
@@ -1977,10 +2059,10 @@ LrWpanMac::ReceiveBeacon(uint8_t lqi, Ptr<Packet> p)
                 uint64_t searchSymbols;
                 Time searchBeaconTime;
 
-                searchSymbols = (static_cast<uint64_t>(1 << m_incomingBeaconOrder)) +
-                                1 * lrwpan::aBaseSuperframeDuration;
-                searchBeaconTime = Seconds(static_cast<double>(searchSymbols / symbolRate));
-                m_trackingEvent =
+                searchSymbols = (static_cast<uint64_t>(1 << m_incomingBeaconOrder) + 1) *
+                                lrwpan::aBaseSuperframeDuration;
+                searchBeaconTime = Seconds(static_cast<double>(searchSymbols) / symbolRate);
+                state.trackingEvent =
                     Simulator::Schedule(searchBeaconTime, &LrWpanMac::BeaconSearchTimeout, this);
             }
 
@@ -2060,14 +2142,14 @@ LrWpanMac::ReceiveCommand(uint8_t lqi, Ptr<Packet> p)
         }
         break;
     case CommandPayloadHeader::COOR_REALIGN:
-        if (m_scanOrphanEvent.IsPending())
+        if (GetBeaconState().scanOrphanEvent.IsPending())
         {
             // Coordinator located, no need to keep scanning other channels
-            m_scanOrphanEvent.Cancel();
+            GetBeaconState().scanOrphanEvent.Cancel();
 
             m_macPanIdScan = 0;
             m_pendPrimitive = MLME_NONE;
-            m_channelScanIndex = 0;
+            GetBeaconState().channelScanIndex = 0;
 
             // Update the device information with the received information
             // from the Coordinator Realigment command.
@@ -2079,12 +2161,12 @@ LrWpanMac::ReceiveCommand(uint8_t lqi, Ptr<Packet> p)
             if (!m_mlmeScanConfirmCallback.IsNull())
             {
                 MlmeScanConfirmParams confirmParams;
-                confirmParams.m_scanType = m_scanParams.m_scanType;
-                confirmParams.m_chPage = m_scanParams.m_chPage;
+                confirmParams.m_scanType = GetBeaconState().scanParams.m_scanType;
+                confirmParams.m_chPage = GetBeaconState().scanParams.m_chPage;
                 confirmParams.m_status = MacStatus::SUCCESS;
                 m_mlmeScanConfirmCallback(confirmParams);
             }
-            m_scanParams = {};
+            GetBeaconState().scanParams = {};
         }
         // TODO: handle Coordinator realignment when not
         //       used during an orphan scan.
@@ -2375,25 +2457,29 @@ LrWpanMac::PdDataIndication(uint32_t psduLength, Ptr<Packet> p, uint8_t lqi)
         acceptFrame = (receivedMacHdr.GetExtDstAddr() == m_macExtendedAddress);
     }
 
-    if (acceptFrame && m_scanEvent.IsPending())
+    // No scan runs before the beacon-mode state is allocated
+    if (m_beaconState)
     {
-        if (!receivedMacHdr.IsBeacon())
+        if (acceptFrame && m_beaconState->scanEvent.IsPending())
         {
-            acceptFrame = false;
+            if (!receivedMacHdr.IsBeacon())
+            {
+                acceptFrame = false;
+            }
         }
-    }
-    else if (acceptFrame && m_scanOrphanEvent.IsPending())
-    {
-        if (!receivedMacHdr.IsCommand())
+        else if (acceptFrame && m_beaconState->scanOrphanEvent.IsPending())
         {
+            if (!receivedMacHdr.IsCommand())
+            {
+                acceptFrame = false;
+            }
+        }
+        else if (m_beaconState->scanEnergyEvent.IsPending())
+        {
+            // Reject any frames if energy scan is running
             acceptFrame = false;
         }
     }
-    else if (m_scanEnergyEvent.IsPending())
-    {
-        // Reject any frames if energy scan is running
-        acceptFrame = false;
-    }
 
     // Check device is panCoor with association permit when receiving Association Request
     // Commands.
@@ -2411,9 +2497,9 @@ LrWpanMac::PdDataIndication(uint32_t psduLength, Ptr<Packet> p, uint8_t lqi)
         // Although ACKs do not use CSMA to to be transmitted, we need to make sure
         // that the transmitted ACK will not collide with the transmission of a beacon
         // when beacon-enabled mode is running in the coordinator.
-        if (acceptFrame && (m_csmaCa->IsSlottedCsmaCa() && m_capEvent.IsPending()))
+        if (acceptFrame && (m_csmaCa->IsSlottedCsmaCa() && GetBeaconState().capEvent.IsPending()))
         {
-            Time timeLeftInCap = Simulator::GetDelayLeft(m_capEvent);
+            Time timeLeftInCap = Simulator::GetDelayLeft(GetBeaconState().capEvent);
             uint64_t ackSymbols = lrwpan::aTurnaroundTime + m_phy->GetPhySHRDuration() +
                                   ceil(6 * m_phy->GetPhySymbolsPerOctet());
             Time ackTime = Seconds((double)ackSymbols / symbolRate);
@@ -2486,9 +2572,10 @@ LrWpanMac::PdDataIndication(uint32_t psduLength, Ptr<Packet> p, uint8_t lqi)
             NS_LOG_DEBUG("Association Request Command Received; processing ACK");
             break;
         case CommandPayloadHeader::ASSOCIATION_RESP: {
-            if (m_assocResCmdWaitTimeout.IsPending())
+            if (GetBeaconState().assocResCmdWaitTimeout.IsPending())
             {
-                m_assocResCmdWaitTimeout.Cancel(); // cancel event to a lost assoc resp cmd.
+                // cancel event to a lost assoc resp cmd.
+                GetBeaconState().assocResCmdWaitTimeout.Cancel();
                 NS_LOG_DEBUG("Association Response Command Received; processing ACK");
             }
             else
@@ -2560,7 +2647,7 @@ LrWpanMac::PdDataIndication(uint32_t psduLength, Ptr<Packet> p, uint8_t lqi)
                         Seconds(static_cast<double>(m_macResponseWaitTime) / symbolRate);
                     if (!m_beaconTrackingOn)
                     {
-                        m_respWaitTimeout =
+                        GetBeaconState().respWaitTimeout =
                             Simulator::Schedule(waitTime, &LrWpanMac::SendDataRequestCommand, this);
                     }
                     else
@@ -2602,7 +2689,7 @@ LrWpanMac::PdDataIndication(uint32_t psduLength, Ptr<Packet> p, uint8_t lqi)
                         double symbolRate = m_phy->GetDataOrSymbolRate(false);
                         Time waitTime =
                             Seconds(static_cast<double>(m_assocRespCmdWaitTime) / symbolRate);
-                        m_assocResCmdWaitTimeout =
+                        GetBeaconState().assocResCmdWaitTimeout =
                             Simulator::Schedule(waitTime, &LrWpanMac::LostAssocRespCommand, this);
                     }
 
@@ -2827,8 +2914,8 @@ LrWpanMac::PrepareRetransmission()
                 m_macPanId = 0xffff;
                 m_macCoordShortAddress = Mac16Address("FF:FF");
                 m_macCoordExtendedAddress = Mac64Address("ff:ff:ff:ff:ff:ff:ff:ed");
-                m_incCapEvent.Cancel();
-                m_incCfpEvent.Cancel();
+                GetBeaconState().incCapEvent.Cancel();
+                GetBeaconState().incCfpEvent.Cancel();
                 m_csmaCa->SetUnSlottedCsmaCa();
                 m_incomingBeaconOrder = 15;
                 m_incomingSuperframeOrder = 15;
@@ -2863,8 +2950,8 @@ LrWpanMac::PrepareRetransmission()
                 m_macPanId = 0xffff;
                 m_macCoordShortAddress = Mac16Address("FF:FF");
                 m_macCoordExtendedAddress = Mac64Address("ff:ff:ff:ff:ff:ff:ff:ed");
-                m_incCapEvent.Cancel();
-                m_incCfpEvent.Cancel();
+                GetBeaconState().incCapEvent.Cancel();
+                GetBeaconState().incCfpEvent.Cancel();
                 m_csmaCa->SetUnSlottedCsmaCa();
                 m_incomingBeaconOrder = 15;
                 m_incomingSuperframeOrder = 15;
@@ -2913,6 +3000,8 @@ LrWpanMac::PrepareRetransmission()
 void
 LrWpanMac::EnqueueInd(Ptr<Packet> p)
 {
+    BeaconState& state = GetBeaconState();
+
     Ptr<IndTxQueueElement> indTxQElement = Create<IndTxQueueElement>();
     LrWpanMacHeader peekedMacHdr;
     p->PeekHeader(peekedMacHdr);
@@ -2925,10 +3014,12 @@ LrWpanMac::EnqueueInd(Ptr<Packet> p)
     if (peekedMacHdr.GetDstAddrMode() == SHORT_ADDR)
     {
         indTxQElement->dstShortAddress = peekedMacHdr.GetShortDstAddr();
+        indTxQElement->dstAddrMode = SHORT_ADDR;
     }
     else
     {
         indTxQElement->dstExtAddress = peekedMacHdr.GetExtDstAddr();
+        indTxQElement->dstAddrMode = EXT_ADDR;
     }
 
     indTxQElement->seqNum = peekedMacHdr.GetSeqNum();
@@ -2947,14 +3038,26 @@ LrWpanMac::EnqueueInd(Ptr<Packet> p)
                m_macTransactionPersistenceTime;
     }
 
-    if (m_indTxQueue.size() < m_maxIndTxQueueSize)
+    if (state.indTxQueue.size() < m_maxIndTxQueueSize)
     {
         double symbolRate = m_phy->GetDataOrSymbolRate(false);
         Time expireTime = Seconds(unit / symbolRate);
         expireTime += Simulator::Now();
         indTxQElement->expireTime = expireTime;
         indTxQElement->txQPkt = p;
-        m_indTxQueue.emplace_back(indTxQElement);
+        indTxQElement->order = state.indTxQueueOrder++;
+        state.indTxQueue.emplace_hint(state.indTxQueue.end(), indTxQElement->order, indTxQElement);
+        if (indTxQElement->dstAddrMode == EXT_ADDR)
+        {
+            state.indTxQueueByExtAddr[indTxQElement->dstExtAddress.ConvertToInt()].push_back(
+                indTxQElement->order);
+        }
+        else
+        {
+            state.indTxQueueByShortAddr[indTxQElement->dstShortAddress.ConvertToInt()].push_back(
+                indTxQElement->order);
+        }
+        state.indTxExpiry.emplace(expireTime, indTxQElement->order);
         m_macIndTxEnqueueTrace(p);
     }
     else
@@ -2979,64 +3082,105 @@ LrWpanMac::EnqueueInd(Ptr<Packet> p)
 bool
 LrWpanMac::DequeueInd(Mac64Address dst, Ptr<IndTxQueueElement> entry)
 {
+    BeaconState& state = GetBeaconState();
+
     PurgeInd();
 
-    for (auto iter = m_indTxQueue.begin(); iter != m_indTxQueue.end(); iter++)
+    auto fifo = state.indTxQueueByExtAddr.find(dst.ConvertToInt());
+    if (fifo == state.indTxQueueByExtAddr.end())
     {
-        if ((*iter)->dstExtAddress == dst)
+        return false;
+    }
+    auto iter = state.indTxQueue.find(fifo->second.front());
+    NS_ASSERT(iter != state.indTxQueue.end());
+    *entry = *iter->second;
+    m_macIndTxDequeueTrace(iter->second->txQPkt->Copy());
+    EraseInd(iter);
+    return true;
+}
+
+void
+LrWpanMac::EraseInd(std::map<uint64_t, Ptr<IndTxQueueElement>>::iterator it)
+{
+    BeaconState& state = GetBeaconState();
+
+    const Ptr<IndTxQueueElement>& indTxQElement = it->second;
+    auto removeFrom = [order = it->first](auto& fifos, auto key) {
+        auto fifo = fifos.find(key);
+        NS_ASSERT(fifo != fifos.end());
+        std::deque<uint64_t>& orders = fifo->second;
+        // Elements mostly leave from the head of their destination FIFO.
+        if (orders.front() == order)
         {
-            *entry = **iter;
-            m_macIndTxDequeueTrace((*iter)->txQPkt->Copy());
-            m_indTxQueue.erase(iter);
-            return true;
+            orders.pop_front();
         }
+        else
+        {
+            orders.erase(std::find(orders.begin(), orders.end(), order));
+        }
+        if (orders.empty())
+        {
+            fifos.erase(fifo);
+        }
+    };
+    if (indTxQElement->dstAddrMode == EXT_ADDR)
+    {
+        removeFrom(state.indTxQueueByExtAddr, indTxQElement->dstExtAddress.ConvertToInt());
+    }
+    else
+    {
+        removeFrom(state.indTxQueueByShortAddr, indTxQElement->dstShortAddress.ConvertToInt());
     }
-    return false;
+    state.indTxQueue.erase(it);
 }
 
 void
 LrWpanMac::PurgeInd()
 {
-    for (uint32_t i = 0; i < m_indTxQueue.size();)
+    BeaconState& state = GetBeaconState();
+
+    while (!state.indTxExpiry.empty() && Simulator::Now() > state.indTxExpiry.top().first)
     {
-        if (Simulator::Now() > m_indTxQueue[i]->expireTime)
+        auto it = state.indTxQueue.find(state.indTxExpiry.top().second);
+        state.indTxExpiry.pop();
+        if (it == state.indTxQueue.end())
         {
-            // Transaction expired, remove and send proper confirmation/indication to a higher layer
-            LrWpanMacHeader peekedMacHdr;
-            m_indTxQueue[i]->txQPkt->PeekHeader(peekedMacHdr);
+            // Already dequeued or removed
+            continue;
+        }
 
-            if (peekedMacHdr.IsCommand())
-            {
-                // IEEE 802.15.4-2006 (Section 7.1.3.3.3)
-                if (!m_mlmeCommStatusIndicationCallback.IsNull())
-                {
-                    MlmeCommStatusIndicationParams commStatusParams;
-                    commStatusParams.m_panId = m_macPanId;
-                    commStatusParams.m_srcAddrMode = LrWpanMacHeader::EXTADDR;
-                    commStatusParams.m_srcExtAddr = peekedMacHdr.GetExtSrcAddr();
-                    commStatusParams.m_dstAddrMode = LrWpanMacHeader::EXTADDR;
-                    commStatusParams.m_dstExtAddr = peekedMacHdr.GetExtDstAddr();
-                    commStatusParams.m_status = MacStatus::TRANSACTION_EXPIRED;
-                    m_mlmeCommStatusIndicationCallback(commStatusParams);
-                }
-            }
-            else if (peekedMacHdr.IsData())
+        // Transaction expired, remove and send proper confirmation/indication to a higher layer
+        Ptr<IndTxQueueElement> indTxQElement = it->second;
+        EraseInd(it);
+        LrWpanMacHeader peekedMacHdr;
+        indTxQElement->txQPkt->PeekHeader(peekedMacHdr);
+
+        if (peekedMacHdr.IsCommand())
+        {
+            // IEEE 802.15.4-2006 (Section 7.1.3.3.3)
+            if (!m_mlmeCommStatusIndicationCallback.IsNull())
             {
-                // IEEE 802.15.4-2006 (Section 7.1.1.1.3)
-                if (!m_mcpsDataConfirmCallback.IsNull())
-                {
-                    McpsDataConfirmParams confParams;
-                    confParams.m_status = MacStatus::TRANSACTION_EXPIRED;
-                    m_mcpsDataConfirmCallback(confParams);
-                }
+                MlmeCommStatusIndicationParams commStatusParams;
+                commStatusParams.m_panId = m_macPanId;
+                commStatusParams.m_srcAddrMode = LrWpanMacHeader::EXTADDR;
+                commStatusParams.m_srcExtAddr = peekedMacHdr.GetExtSrcAddr();
+                commStatusParams.m_dstAddrMode = LrWpanMacHeader::EXTADDR;
+                commStatusParams.m_dstExtAddr = peekedMacHdr.GetExtDstAddr();
+                commStatusParams.m_status = MacStatus::TRANSACTION_EXPIRED;
+                m_mlmeCommStatusIndicationCallback(commStatusParams);
             }
-            m_macIndTxDropTrace(m_indTxQueue[i]->txQPkt->Copy());
-            m_indTxQueue.erase(m_indTxQueue.begin() + i);
         }
-        else
+        else if (peekedMacHdr.IsData())
         {
-            i++;
+            // IEEE 802.15.4-2006 (Section 7.1.1.1.3)
+            if (!m_mcpsDataConfirmCallback.IsNull())
+            {
+                McpsDataConfirmParams confParams;
+                confParams.m_status = MacStatus::TRANSACTION_EXPIRED;
+                m_mcpsDataConfirmCallback(confParams);
+            }
         }
+        m_macIndTxDropTrace(indTxQElement->txQPkt->Copy());
     }
 }
 
@@ -3052,7 +3196,12 @@ LrWpanMac::PrintPendingTxQueue(std::ostream& os) const
        << "    Frame type    |"
        << "    Expire time\n";
 
-    for (auto transaction : m_indTxQueue)
+    if (!m_beaconState)
+    {
+        return;
+    }
+
+    for (const auto& [order, transaction] : m_beaconState->indTxQueue)
     {
         transaction->txQPkt->PeekHeader(peekedMacHdr);
         os << transaction->dstExtAddress << "           "
@@ -3126,28 +3275,33 @@ LrWpanMac::AssignStreams(int64_t stream)
 void
 LrWpanMac::RemovePendTxQElement(Ptr<Packet> p)
 {
+    BeaconState& state = GetBeaconState();
+
     LrWpanMacHeader peekedMacHdr;
     p->PeekHeader(peekedMacHdr);
 
-    for (auto it = m_indTxQueue.begin(); it != m_indTxQueue.end(); it++)
+    // Only the FIFO of the destination is searched, oldest element first.
+    const std::deque<uint64_t>* orders = nullptr;
+    if (peekedMacHdr.GetDstAddrMode() == EXT_ADDR)
     {
-        if (peekedMacHdr.GetDstAddrMode() == EXT_ADDR)
-        {
-            if (((*it)->dstExtAddress == peekedMacHdr.GetExtDstAddr()) &&
-                ((*it)->seqNum == peekedMacHdr.GetSeqNum()))
-            {
-                m_macIndTxDequeueTrace(p);
-                m_indTxQueue.erase(it);
-                break;
-            }
-        }
-        else if (peekedMacHdr.GetDstAddrMode() == SHORT_ADDR)
+        auto fifo = state.indTxQueueByExtAddr.find(peekedMacHdr.GetExtDstAddr().ConvertToInt());
+        orders = fifo != state.indTxQueueByExtAddr.end() ? &fifo->second : nullptr;
+    }
+    else if (peekedMacHdr.GetDstAddrMode() == SHORT_ADDR)
+    {
+        auto fifo = state.indTxQueueByShortAddr.find(peekedMacHdr.GetShortDstAddr().ConvertToInt());
+        orders = fifo != state.indTxQueueByShortAddr.end() ? &fifo->second : nullptr;
+    }
+
+    if (orders)
+    {
+        for (uint64_t order : *orders)
         {
-            if (((*it)->dstShortAddress == peekedMacHdr.GetShortDstAddr()) &&
-                ((*it)->seqNum == peekedMacHdr.GetSeqNum()))
+            auto it = state.indTxQueue.find(order);
+            if (it->second->seqNum == peekedMacHdr.GetSeqNum())
             {
                 m_macIndTxDequeueTrace(p);
-                m_indTxQueue.erase(it);
+                EraseInd(it);
                 break;
             }
         }
@@ -3190,9 +3344,9 @@ LrWpanMac::PdDataConfirm(PhyEnumeration status)
                     m_macBeaconTxTime =
                         Simulator::Now() - Seconds(static_cast<double>(beaconSymbols) / symbolRate);
 
-                    m_capEvent = Simulator::ScheduleNow(&LrWpanMac::StartCAP,
-                                                        this,
-                                                        SuperframeType::OUTGOING);
+                    GetBeaconState().capEvent = Simulator::ScheduleNow(&LrWpanMac::StartCAP,
+                                                                       this,
+                                                                       SuperframeType::OUTGOING);
                     NS_LOG_DEBUG("Beacon Sent (m_macBeaconTxTime: " << m_macBeaconTxTime.As(Time::S)
                                                                     << ")");
 
@@ -3338,8 +3492,8 @@ LrWpanMac::PdDataConfirm(PhyEnumeration status)
                         m_macPanId = 0xffff;
                         m_macCoordShortAddress = Mac16Address("FF:FF");
                         m_macCoordExtendedAddress = Mac64Address("ff:ff:ff:ff:ff:ff:ff:ed");
-                        m_incCapEvent.Cancel();
-                        m_incCfpEvent.Cancel();
+                        GetBeaconState().incCapEvent.Cancel();
+                        GetBeaconState().incCfpEvent.Cancel();
                         m_csmaCa->SetUnSlottedCsmaCa();
                         m_incomingBeaconOrder = 15;
                         m_incomingSuperframeOrder = 15;
@@ -3350,8 +3504,8 @@ LrWpanMac::PdDataConfirm(PhyEnumeration status)
                         m_macPanId = 0xffff;
                         m_macCoordShortAddress = Mac16Address("FF:FF");
                         m_macCoordExtendedAddress = Mac64Address("ff:ff:ff:ff:ff:ff:ff:ed");
-                        m_incCapEvent.Cancel();
-                        m_incCfpEvent.Cancel();
+                        GetBeaconState().incCapEvent.Cancel();
+                        GetBeaconState().incCfpEvent.Cancel();
                         m_csmaCa->SetUnSlottedCsmaCa();
                         m_incomingBeaconOrder = 15;
                         m_incomingSuperframeOrder = 15;
@@ -3432,8 +3586,8 @@ LrWpanMac::PlmeEdConfirm(PhyEnumeration status, uint8_t energyLevel)
         m_maxEnergyLevel = energyLevel;
     }
 
-    if (Simulator::GetDelayLeft(m_scanEnergyEvent) >
-        Seconds(8.0 / m_phy->GetDataOrSymbolRate(false)))
+    if (m_beaconState && Simulator::GetDelayLeft(m_beaconState->scanEnergyEvent) >
+                             Seconds(8.0 / m_phy->GetDataOrSymbolRate(false)))
     {
         m_phy->PlmeEdRequest();
     }
@@ -3474,7 +3628,8 @@ LrWpanMac::PlmeSetTRXStateConfirm(PhyEnumeration status)
         NS_ASSERT(status == IEEE_802_15_4_PHY_RX_ON || status == IEEE_802_15_4_PHY_SUCCESS ||
                   status == IEEE_802_15_4_PHY_TRX_OFF);
 
-        if (status == IEEE_802_15_4_PHY_RX_ON && m_scanEnergyEvent.IsPending())
+        if (status == IEEE_802_15_4_PHY_RX_ON && m_beaconState &&
+            m_beaconState->scanEnergyEvent.IsPending())
         {
             // Kick start Energy Detection Scan
             m_phy->PlmeEdRequest();
@@ -3504,24 +3659,26 @@ LrWpanMac::PlmeSetAttributeConfirm(PhyEnumeration status, PhyPibAttributeIdentif
     NS_LOG_FUNCTION(this << status << id);
     if (id == PhyPibAttributeIdentifier::phyCurrentPage && m_pendPrimitive == MLME_SCAN_REQ)
     {
+        BeaconState& state = GetBeaconState();
+
         if (status == PhyEnumeration::IEEE_802_15_4_PHY_SUCCESS)
         {
             // get the first channel to scan from scan channel list
             bool channelFound = false;
-            for (int i = m_channelScanIndex; i <= 26; i++)
+            for (int i = state.channelScanIndex; i <= 26; i++)
             {
-                if ((m_scanParams.m_scanChannels & (1 << m_channelScanIndex)) != 0)
+                if ((state.scanParams.m_scanChannels & (1 << state.channelScanIndex)) != 0)
                 {
                     channelFound = true;
                     break;
                 }
-                m_channelScanIndex++;
+                state.channelScanIndex++;
             }
 
             if (channelFound)
             {
                 Ptr<PhyPibAttributes> pibAttr = Create<PhyPibAttributes>();
-                pibAttr->phyCurrentChannel = m_channelScanIndex;
+                pibAttr->phyCurrentChannel = state.channelScanIndex;
                 m_phy->PlmeSetAttributeRequest(PhyPibAttributeIdentifier::phyCurrentChannel,
                                                pibAttr);
             }
@@ -3531,8 +3688,8 @@ LrWpanMac::PlmeSetAttributeConfirm(PhyEnumeration status, PhyPibAttributeIdentif
             if (!m_mlmeScanConfirmCallback.IsNull())
             {
                 MlmeScanConfirmParams confirmParams;
-                confirmParams.m_scanType = m_scanParams.m_scanType;
-                confirmParams.m_chPage = m_scanParams.m_chPage;
+                confirmParams.m_scanType = state.scanParams.m_scanType;
+                confirmParams.m_chPage = state.scanParams.m_chPage;
                 confirmParams.m_status = MacStatus::INVALID_PARAMETER;
                 m_mlmeScanConfirmCallback(confirmParams);
             }
@@ -3541,51 +3698,55 @@ LrWpanMac::PlmeSetAttributeConfirm(PhyEnumeration status, PhyPibAttributeIdentif
     }
     else if (id == PhyPibAttributeIdentifier::phyCurrentChannel && m_pendPrimitive == MLME_SCAN_REQ)
     {
+        BeaconState& state = GetBeaconState();
+
         if (status == PhyEnumeration::IEEE_802_15_4_PHY_SUCCESS)
         {
             auto symbolRate = static_cast<uint64_t>(m_phy->GetDataOrSymbolRate(false));
             Time nextScanTime;
 
-            if (m_scanParams.m_scanType == MLMESCAN_ORPHAN)
+            if (state.scanParams.m_scanType == MLMESCAN_ORPHAN)
             {
                 nextScanTime = Seconds(static_cast<double>(m_macResponseWaitTime) / symbolRate);
             }
             else
             {
                 uint64_t scanDurationSym =
-                    lrwpan::aBaseSuperframeDuration * (pow(2, m_scanParams.m_scanDuration) + 1);
+                    lrwpan::aBaseSuperframeDuration * (pow(2, state.scanParams.m_scanDuration) + 1);
 
                 nextScanTime = Seconds(static_cast<double>(scanDurationSym) / symbolRate);
             }
 
-            switch (m_scanParams.m_scanType)
+            switch (state.scanParams.m_scanType)
             {
             case MLMESCAN_ED:
                 m_maxEnergyLevel = 0;
-                m_scanEnergyEvent =
+                state.scanEnergyEvent =
                     Simulator::Schedule(nextScanTime, &LrWpanMac::EndChannelEnergyScan, this);
                 // set phy to RX_ON and kick start  the first PLME-ED.request
                 m_phy->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_RX_ON);
                 break;
             case MLMESCAN_ACTIVE:
-                m_scanEvent = Simulator::Schedule(nextScanTime, &LrWpanMac::EndChannelScan, this);
+                state.scanEvent =
+                    Simulator::Schedule(nextScanTime, &LrWpanMac::EndChannelScan, this);
                 SendBeaconRequestCommand();
                 break;
             case MLMESCAN_PASSIVE:
-                m_scanEvent = Simulator::Schedule(nextScanTime, &LrWpanMac::EndChannelScan, this);
+                state.scanEvent =
+                    Simulator::Schedule(nextScanTime, &LrWpanMac::EndChannelScan, this);
                 // turn back the phy to RX_ON after setting Page/channel
                 m_phy->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_RX_ON);
                 break;
             case MLMESCAN_ORPHAN:
-                m_scanOrphanEvent =
+                state.scanOrphanEvent =
                     Simulator::Schedule(nextScanTime, &LrWpanMac::EndChannelScan, this);
                 SendOrphanNotificationCommand();
                 break;
 
             default:
                 MlmeScanConfirmParams confirmParams;
-                confirmParams.m_scanType = m_scanParams.m_scanType;
-                confirmParams.m_chPage = m_scanParams.m_chPage;
+                confirmParams.m_scanType = state.scanParams.m_scanType;
+                confirmParams.m_chPage = state.scanParams.m_chPage;
                 confirmParams.m_status = MacStatus::INVALID_PARAMETER;
                 if (!m_mlmeScanConfirmCallback.IsNull())
                 {
@@ -3600,12 +3761,12 @@ LrWpanMac::PlmeSetAttributeConfirm(PhyEnumeration status, PhyPibAttributeIdentif
             if (!m_mlmeScanConfirmCallback.IsNull())
             {
                 MlmeScanConfirmParams confirmParams;
-                confirmParams.m_scanType = m_scanParams.m_scanType;
-                confirmParams.m_chPage = m_scanParams.m_chPage;
+                confirmParams.m_scanType = state.scanParams.m_scanType;
+                confirmParams.m_chPage = state.scanParams.m_chPage;
                 confirmParams.m_status = MacStatus::INVALID_PARAMETER;
                 m_mlmeScanConfirmCallback(confirmParams);
             }
-            NS_LOG_ERROR("Channel " << m_channelScanIndex
+            NS_LOG_ERROR("Channel " << state.channelScanIndex
                                     << " could not be set in the current page");
         }
     }
@@ -3614,7 +3775,7 @@ LrWpanMac::PlmeSetAttributeConfirm(PhyEnumeration status, PhyPibAttributeIdentif
         if (status == PhyEnumeration::IEEE_802_15_4_PHY_SUCCESS)
         {
             Ptr<PhyPibAttributes> pibAttr = Create<PhyPibAttributes>();
-            pibAttr->phyCurrentChannel = m_startParams.m_logCh;
+            pibAttr->phyCurrentChannel = GetBeaconState().startParams.m_logCh;
             m_phy->PlmeSetAttributeRequest(PhyPibAttributeIdentifier::phyCurrentChannel, pibAttr);
         }
         else
@@ -3651,7 +3812,7 @@ LrWpanMac::PlmeSetAttributeConfirm(PhyEnumeration status, PhyPibAttributeIdentif
         if (status == PhyEnumeration::IEEE_802_15_4_PHY_SUCCESS)
         {
             Ptr<PhyPibAttributes> pibAttr = Create<PhyPibAttributes>();
-            pibAttr->phyCurrentChannel = m_associateParams.m_chNum;
+            pibAttr->phyCurrentChannel = GetBeaconState().associateParams.m_chNum;
             m_phy->PlmeSetAttributeRequest(PhyPibAttributeIdentifier::phyCurrentChannel, pibAttr);
         }
         else
@@ -3659,8 +3820,8 @@ LrWpanMac::PlmeSetAttributeConfirm(PhyEnumeration status, PhyPibAttributeIdentif
             m_macPanId = 0xffff;
             m_macCoordShortAddress = Mac16Address("FF:FF");
             m_macCoordExtendedAddress = Mac64Address("ff:ff:ff:ff:ff:ff:ff:ed");
-            m_incCapEvent.Cancel();
-            m_incCfpEvent.Cancel();
+            GetBeaconState().incCapEvent.Cancel();
+            GetBeaconState().incCfpEvent.Cancel();
             m_csmaCa->SetUnSlottedCsmaCa();
             m_incomingBeaconOrder = 15;
             m_incomingSuperframeOrder = 15;
@@ -3687,8 +3848,8 @@ LrWpanMac::PlmeSetAttributeConfirm(PhyEnumeration status, PhyPibAttributeIdentif
             m_macPanId = 0xffff;
             m_macCoordShortAddress = Mac16Address("FF:FF");
             m_macCoordExtendedAddress = Mac64Address("ff:ff:ff:ff:ff:ff:ff:ed");
-            m_incCapEvent.Cancel();
-            m_incCfpEvent.Cancel();
+            GetBeaconState().incCapEvent.Cancel();
+            GetBeaconState().incCfpEvent.Cancel();
             m_csmaCa->SetUnSlottedCsmaCa();
             m_incomingBeaconOrder = 15;
             m_incomingSuperframeOrder = 15;
@@ -3739,7 +3900,7 @@ LrWpanMac::SetLrWpanMacState(MacState macState)
     if (macState == MAC_IDLE)
     {
         ChangeMacState(MAC_IDLE);
-        if (m_macRxOnWhenIdle)
+        if (IsIdleRxOn())
         {
             m_phy->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_RX_ON);
         }
@@ -3790,8 +3951,8 @@ LrWpanMac::SetLrWpanMacState(MacState macState)
                 m_macPanId = 0xffff;
                 m_macCoordShortAddress = Mac16Address("FF:FF");
                 m_macCoordExtendedAddress = Mac64Address("ff:ff:ff:ff:ff:ff:ff:ed");
-                m_incCapEvent.Cancel();
-                m_incCfpEvent.Cancel();
+                GetBeaconState().incCapEvent.Cancel();
+                GetBeaconState().incCfpEvent.Cancel();
                 m_csmaCa->SetUnSlottedCsmaCa();
                 m_incomingBeaconOrder = 15;
                 m_incomingSuperframeOrder = 15;
@@ -3824,8 +3985,8 @@ LrWpanMac::SetLrWpanMacState(MacState macState)
                 m_macPanId = 0xffff;
                 m_macCoordShortAddress = Mac16Address("FF:FF");
                 m_macCoordExtendedAddress = Mac64Address("ff:ff:ff:ff:ff:ff:ff:ed");
-                m_incCapEvent.Cancel();
-                m_incCfpEvent.Cancel();
+                GetBeaconState().incCapEvent.Cancel();
+                GetBeaconState().incCfpEvent.Cancel();
                 m_csmaCa->SetUnSlottedCsmaCa();
                 m_incomingBeaconOrder = 15;
                 m_incomingSuperframeOrder = 15;
@@ -3853,18 +4014,18 @@ LrWpanMac::SetLrWpanMacState(MacState macState)
                 break;
             }
             case CommandPayloadHeader::ORPHAN_NOTIF: {
-                if (m_scanOrphanEvent.IsPending())
+                if (GetBeaconState().scanOrphanEvent.IsPending())
                 {
-                    m_unscannedChannels.emplace_back(m_phy->GetCurrentChannelNum());
+                    GetBeaconState().unscannedChannels.emplace_back(m_phy->GetCurrentChannelNum());
                 }
                 // TODO: Handle orphan notification command during a
                 //       channel access failure when not is not scanning.
                 break;
             }
             case CommandPayloadHeader::BEACON_REQ: {
-                if (m_scanEvent.IsPending())
+                if (GetBeaconState().scanEvent.IsPending())
                 {
-                    m_unscannedChannels.emplace_back(m_phy->GetCurrentChannelNum());
+                    GetBeaconState().unscannedChannels.emplace_back(m_phy->GetCurrentChannelNum());
                 }
                 // TODO: Handle beacon request command during a
                 //       channel access failure when not scanning.
@@ -3898,7 +4059,7 @@ LrWpanMac::SetLrWpanMacState(MacState macState)
         }
 
         ChangeMacState(MAC_IDLE);
-        if (m_macRxOnWhenIdle)
+        if (IsIdleRxOn())
         {
             m_phy->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_RX_ON);
         }
@@ -15,6 +15,7 @@
 #define LR_WPAN_MAC_H
 
 #include "lr-wpan-fields.h"
+#include "lr-wpan-lazy-trace.h"
 #include "lr-wpan-mac-base.h"
 #include "lr-wpan-phy.h"
 
@@ -24,7 +25,13 @@
 #include "ns3/traced-value.h"
 
 #include <deque>
+#include <functional>
+#include <map>
 #include <memory>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace ns3
 {
@@ -175,6 +182,10 @@ class LrWpanMac : public LrWpanMacBase
     /**
      * Set if the receiver should be enabled when the MAC is idle.
      *
+     * A device tracking the beacons of a beacon-enabled PAN with the receiver off when
+     * idle sleeps through the inactive portion of the incoming superframes and turns the
+     * receiver on a turnaround and a backoff period ahead of the next beacon.
+     *
      * @param rxOnWhenIdle set to true to enable the receiver during idle periods
      */
     void SetRxOnWhenIdle(bool rxOnWhenIdle);
@@ -701,6 +712,14 @@ class LrWpanMac : public LrWpanMacBase
      */
     void PrintTxQueue(std::ostream& os) const;
 
+    /**
+     * Check if the state of beacon-enabled operation, scans, association and indirect
+     * transmissions was allocated.
+     *
+     * @return True if the MAC used any of them
+     */
+    bool HasBeaconState() const;
+
     /**
      * Assign a fixed random variable stream number to the random variables
      * used by this model.  Return the number of streams that have been assigned.
@@ -759,13 +778,13 @@ class LrWpanMac : public LrWpanMacBase
      *
      * @param txQElement The element added to the Tx Queue.
      */
-    void EnqueueTxQElement(Ptr<TxQueueElement> txQElement);
+    virtual void EnqueueTxQElement(Ptr<TxQueueElement> txQElement);
 
     /**
      * Remove the tip of the transmission queue, including clean up related to the
      * last packet transmission.
      */
-    void RemoveFirstTxQElement();
+    virtual void RemoveFirstTxQElement();
 
     /**
      * Used to process the reception of data.
@@ -800,7 +819,7 @@ class LrWpanMac : public LrWpanMacBase
      *
      * @see class CallBackTraceSource
      */
-    TracedCallback<Ptr<const Packet>> m_macRxTrace;
+    LazyTracedCallback<Ptr<const Packet>> m_macRxTrace;
 
     /**
      * The trace source fired for packets successfully received by the device
@@ -809,7 +828,7 @@ class LrWpanMac : public LrWpanMacBase
      *
      * @see class CallBackTraceSource
      */
-    TracedCallback<Ptr<const Packet>> m_macRxDropTrace;
+    LazyTracedCallback<Ptr<const Packet>> m_macRxDropTrace;
 
     /**
      * The PHY associated with this MAC.
@@ -819,7 +838,7 @@ class LrWpanMac : public LrWpanMacBase
     /**
      * The current state of the MAC layer.
      */
-    TracedValue<MacState> m_macState;
+    LazyTracedValue<MacState> m_macState;
 
     /**
      * The CSMA/CA implementation used by this MAC.
@@ -860,8 +879,161 @@ class LrWpanMac : public LrWpanMacBase
         Mac64Address dstExtAddress;   //!< The destination extended Mac Address
         Ptr<Packet> txQPkt;           //!< Queued packet.
         Time expireTime; //!< The expiration time of the packet in the indirect transmission queue.
+        AddressMode dstAddrMode;      //!< Destination address used: SHORT_ADDR or EXT_ADDR
+        uint64_t order;               //!< Key of the element in the pending transaction list
+    };
+
+    /**
+     * @brief The state of beacon-enabled operation, scans, association and indirect
+     *        transmissions, allocated by GetBeaconState() the first time it is used.
+     */
+    struct BeaconState
+    {
+        /**
+         * The indirect transmit queue used by the MAC pending messages (The pending transaction
+         * list), keyed and ordered by the enqueue order of the elements.
+         */
+        std::map<uint64_t, Ptr<IndTxQueueElement>> indTxQueue;
+
+        /**
+         * The enqueue order of the next element of the pending transaction list.
+         */
+        uint64_t indTxQueueOrder{0};
+
+        /**
+         * The elements of the pending transaction list for each extended destination address,
+         * oldest first.
+         */
+        std::unordered_map<uint64_t, std::deque<uint64_t>> indTxQueueByExtAddr;
+
+        /**
+         * The elements of the pending transaction list for each short destination address,
+         * oldest first.
+         */
+        std::unordered_map<uint16_t, std::deque<uint64_t>> indTxQueueByShortAddr;
+
+        /**
+         * The expiration times of the elements of the pending transaction list, earliest on top.
+         * Elements removed before they expire are skipped when their time comes up.
+         */
+        std::priority_queue<std::pair<Time, uint64_t>,
+                            std::vector<std::pair<Time, uint64_t>>,
+                            std::greater<>>
+            indTxExpiry;
+
+        /**
+         * The list of PAN descriptors accumulated during channel scans, used to select a PAN to
+         * associate.
+         */
+        std::vector<PanDescriptor> panDescriptorList;
+
+        /**
+         * The list of energy measurements, one for each channel searched during an ED scan.
+         */
+        std::vector<uint8_t> energyDetectList;
+
+        /**
+         * The list of unscanned channels during a scan operation.
+         */
+        std::vector<uint8_t> unscannedChannels;
+
+        /**
+         * The parameters used during a MLME-SCAN.request. These parameters are stored here while
+         * PLME-SET (set channel page, set channel number) and other operations take place.
+         */
+        MlmeScanRequestParams scanParams;
+
+        /**
+         * The parameters used during a MLME-START.request. These parameters are stored here while
+         * PLME-SET operations (set channel page, set channel number) take place.
+         */
+        MlmeStartRequestParams startParams;
+
+        /**
+         * The parameters used during a MLME-ASSOCIATE.request. These parameters are stored here
+         * while PLME-SET operations (set channel page, set channel number) take place.
+         */
+        MlmeAssociateRequestParams associateParams;
+
+        /**
+         * The channel list index used to obtain the current scanned channel.
+         */
+        uint16_t channelScanIndex{0};
+
+        /**
+         * Scheduler event for a response to a request command frame.
+         */
+        EventId respWaitTimeout;
+
+        /**
+         * Scheduler event for the lost of a association response command frame.
+         */
+        EventId assocResCmdWaitTimeout;
+
+        /**
+         * Scheduler event for generation of one beacon.
+         */
+        EventId beaconEvent;
+
+        /**
+         * Scheduler event for the end of the outgoing superframe CAP.
+         **/
+        EventId capEvent;
+
+        /**
+         * Scheduler event for the end of the outgoing superframe CFP.
+         */
+        EventId cfpEvent;
+
+        /**
+         * Scheduler event for the end of the incoming superframe CAP.
+         **/
+        EventId incCapEvent;
+
+        /**
+         * Scheduler event for the end of the incoming superframe CFP.
+         */
+        EventId incCfpEvent;
+
+        /**
+         * Scheduler event to track the incoming beacons.
+         */
+        EventId trackingEvent;
+
+        /**
+         * Scheduler event turning the receiver on ahead of the next incoming beacon
+         * (macRxOnWhenIdle false).
+         */
+        EventId beaconWakeEvent;
+
+        /**
+         * Whether the receiver stays on while the MAC is idle because an incoming beacon is
+         * awaited (macRxOnWhenIdle false).
+         */
+        bool beaconWake{false};
+
+        /**
+         * Scheduler event for the end of an ACTIVE or PASSIVE channel scan.
+         */
+        EventId scanEvent;
+
+        /**
+         * Scheduler event for the end of an ORPHAN channel scan.
+         */
+        EventId scanOrphanEvent;
+
+        /**
+         * Scheduler event for the end of a ED channel scan.
+         */
+        EventId scanEnergyEvent;
     };
 
+    /**
+     * @brief Get the beacon-mode state, allocating it if needed.
+     * @return the beacon-mode state
+     */
+    BeaconState& GetBeaconState();
+
     /**
      * Process a frame when promiscuous mode is active.
      *
@@ -962,6 +1134,20 @@ class LrWpanMac : public LrWpanMacBase
      */
     void AwaitBeacon();
 
+    /**
+     * Turn the receiver on ahead of the next incoming beacon, for a device with the
+     * receiver off when idle.
+     */
+    void WakeForBeacon();
+
+    /**
+     * Check if the receiver is on while the MAC is idle: macRxOnWhenIdle, or an incoming
+     * beacon awaited.
+     *
+     * @return true if the receiver stays on when idle
+     */
+    bool IsIdleRxOn() const;
+
     /**
      * Called if the device is unable to locate a beacon in the time set by MLME-SYNC.request.
      */
@@ -1029,6 +1215,14 @@ class LrWpanMac : public LrWpanMacBase
      */
     void PurgeInd();
 
+    /**
+     * Remove an element from the pending transaction list and from the FIFO of its
+     * destination.
+     *
+     * @param it The element in m_indTxQueue
+     */
+    void EraseInd(std::map<uint64_t, Ptr<IndTxQueueElement>>::iterator it);
+
     /**
      * Remove an element from the pending transaction list.
      *
@@ -1070,7 +1264,7 @@ class LrWpanMac : public LrWpanMacBase
     /**
      * The trace source is fired at the end of any Interframe Space (IFS).
      */
-    TracedCallback<Time> m_macIfsEndTrace;
+    LazyTracedCallback<Time> m_macIfsEndTrace;
 
     /**
      * The trace source fired when packets are considered as successfully sent
@@ -1082,7 +1276,7 @@ class LrWpanMac : public LrWpanMacBase
      *
      * @see class CallBackTraceSource
      */
-    TracedCallback<Ptr<const Packet>, uint8_t, uint8_t> m_sentPktTrace;
+    LazyTracedCallback<Ptr<const Packet>, uint8_t, uint8_t> m_sentPktTrace;
 
     /**
      * The trace source fired when packets come into the "top" of the device
@@ -1090,7 +1284,7 @@ class LrWpanMac : public LrWpanMacBase
      *
      * @see class CallBackTraceSource
      */
-    TracedCallback<Ptr<const Packet>> m_macTxEnqueueTrace;
+    LazyTracedCallback<Ptr<const Packet>> m_macTxEnqueueTrace;
 
     /**
      * The trace source fired when packets are dequeued from the
@@ -1098,7 +1292,7 @@ class LrWpanMac : public LrWpanMacBase
      *
      * @see class CallBackTraceSource
      */
-    TracedCallback<Ptr<const Packet>> m_macTxDequeueTrace;
+    LazyTracedCallback<Ptr<const Packet>> m_macTxDequeueTrace;
 
     /**
      * The trace source fired when packets come into the "top" of the device
@@ -1106,7 +1300,7 @@ class LrWpanMac : public LrWpanMacBase
      * (pending transaction list).
      * @see class CallBackTraceSource
      */
-    TracedCallback<Ptr<const Packet>> m_macIndTxEnqueueTrace;
+    LazyTracedCallback<Ptr<const Packet>> m_macIndTxEnqueueTrace;
 
     /**
      * The trace source fired when packets are dequeued from the
@@ -1114,14 +1308,14 @@ class LrWpanMac : public LrWpanMacBase
      *
      * @see class CallBackTraceSource
      */
-    TracedCallback<Ptr<const Packet>> m_macIndTxDequeueTrace;
+    LazyTracedCallback<Ptr<const Packet>> m_macIndTxDequeueTrace;
 
     /**
      * The trace source fired when packets are being sent down to L1.
      *
      * @see class CallBackTraceSource
      */
-    TracedCallback<Ptr<const Packet>> m_macTxTrace;
+    LazyTracedCallback<Ptr<const Packet>> m_macTxTrace;
 
     /**
      * The trace source fired when packets where successfully transmitted, that is
@@ -1130,7 +1324,7 @@ class LrWpanMac : public LrWpanMacBase
      *
      * @see class CallBackTraceSource
      */
-    TracedCallback<Ptr<const Packet>> m_macTxOkTrace;
+    LazyTracedCallback<Ptr<const Packet>> m_macTxOkTrace;
 
     /**
      * The trace source fired when packets are dropped due to missing ACKs or
@@ -1138,7 +1332,7 @@ class LrWpanMac : public LrWpanMacBase
      *
      * @see class CallBackTraceSource
      */
-    TracedCallback<Ptr<const Packet>> m_macTxDropTrace;
+    LazyTracedCallback<Ptr<const Packet>> m_macTxDropTrace;
 
     /**
      * The trace source fired when packets are dropped due to indirect Tx queue
@@ -1146,7 +1340,7 @@ class LrWpanMac : public LrWpanMacBase
      *
      * @see class CallBackTraceSource
      */
-    TracedCallback<Ptr<const Packet>> m_macIndTxDropTrace;
+    LazyTracedCallback<Ptr<const Packet>> m_macIndTxDropTrace;
 
     /**
      * The trace source fired for packets successfully received by the device
@@ -1155,7 +1349,7 @@ class LrWpanMac : public LrWpanMacBase
      *
      * @see class CallBackTraceSource
      */
-    TracedCallback<Ptr<const Packet>> m_macPromiscRxTrace;
+    LazyTracedCallback<Ptr<const Packet>> m_macPromiscRxTrace;
 
     /**
      * A trace source that emulates a non-promiscuous protocol sniffer connected
@@ -1175,7 +1369,7 @@ class LrWpanMac : public LrWpanMacBase
      *
      * @see class CallBackTraceSource
      */
-    TracedCallback<Ptr<const Packet>> m_snifferTrace;
+    LazyTracedCallback<Ptr<const Packet>> m_snifferTrace;
 
     /**
      * A trace source that emulates a promiscuous mode protocol sniffer connected
@@ -1195,7 +1389,7 @@ class LrWpanMac : public LrWpanMacBase
      *
      * @see class CallBackTraceSource
      */
-    TracedCallback<Ptr<const Packet>> m_promiscSnifferTrace;
+    LazyTracedCallback<Ptr<const Packet>> m_promiscSnifferTrace;
 
     /**
      * A trace source that fires when the MAC changes states.
@@ -1206,17 +1400,17 @@ class LrWpanMac : public LrWpanMacBase
      * TracedValue.
      */
     // NS_DEPRECATED() - tag for future removal
-    TracedCallback<MacState, MacState> m_macStateLogger;
+    LazyTracedCallback<MacState, MacState> m_macStateLogger;
 
     /**
      * The current period of the incoming superframe.
      */
-    TracedValue<SuperframeStatus> m_incSuperframeStatus;
+    LazyTracedValue<SuperframeStatus> m_incSuperframeStatus;
 
     /**
      * The current period of the outgoing superframe.
      */
-    TracedValue<SuperframeStatus> m_outSuperframeStatus;
+    LazyTracedValue<SuperframeStatus> m_outSuperframeStatus;
 
     /**
      * The command request packet received. Briefly stored to proceed with operations
@@ -1225,10 +1419,10 @@ class LrWpanMac : public LrWpanMacBase
     Ptr<Packet> m_rxPkt;
 
     /**
-     * The indirect transmit queue used by the MAC pending messages (The pending transaction
-     * list).
+     * The beacon-mode state, null until the MAC uses a beacon, a scan, an association or an
+     * indirect transmission. A MAC that only sends and receives data frames never allocates it.
      */
-    std::deque<Ptr<IndTxQueueElement>> m_indTxQueue;
+    std::unique_ptr<BeaconState> m_beaconState;
 
     /**
      * The maximum size of the transmit queue.
@@ -1240,45 +1434,6 @@ class LrWpanMac : public LrWpanMacBase
      */
     uint32_t m_maxIndTxQueueSize;
 
-    /**
-     * The list of PAN descriptors accumulated during channel scans, used to select a PAN to
-     * associate.
-     */
-    std::vector<PanDescriptor> m_panDescriptorList;
-
-    /**
-     * The list of energy measurements, one for each channel searched during an ED scan.
-     */
-    std::vector<uint8_t> m_energyDetectList;
-
-    /**
-     * The list of unscanned channels during a scan operation.
-     */
-    std::vector<uint8_t> m_unscannedChannels;
-
-    /**
-     * The parameters used during a MLME-SCAN.request. These parameters are stored here while
-     * PLME-SET (set channel page, set channel number) and other operations take place.
-     */
-    MlmeScanRequestParams m_scanParams;
-
-    /**
-     * The parameters used during a MLME-START.request. These parameters are stored here while
-     * PLME-SET operations (set channel page, set channel number) take place.
-     */
-    MlmeStartRequestParams m_startParams;
-
-    /**
-     * The parameters used during a MLME-ASSOCIATE.request. These parameters are stored here while
-     * PLME-SET operations (set channel page, set channel number) take place.
-     */
-    MlmeAssociateRequestParams m_associateParams;
-
-    /**
-     * The channel list index used to obtain the current scanned channel.
-     */
-    uint16_t m_channelScanIndex;
-
     /**
      * Indicates the pending primitive when PLME.SET operation (page or channel switch) is called
      * from within another MLME primitive (e.g. Association, Scan, Sync, Start).
@@ -1309,16 +1464,6 @@ class LrWpanMac : public LrWpanMacBase
 
     bool m_ignoreDataCmdAck;
 
-    /**
-     * Scheduler event for a response to a request command frame.
-     */
-    EventId m_respWaitTimeout;
-
-    /**
-     * Scheduler event for the lost of a association response command frame.
-     */
-    EventId m_assocResCmdWaitTimeout;
-
     /**
      * Scheduler event for a deferred MAC state change.
      */
@@ -1329,51 +1474,6 @@ class LrWpanMac : public LrWpanMacBase
      */
     EventId m_ifsEvent;
 
-    /**
-     * Scheduler event for generation of one beacon.
-     */
-    EventId m_beaconEvent;
-
-    /**
-     * Scheduler event for the end of the outgoing superframe CAP.
-     **/
-    EventId m_capEvent;
-
-    /**
-     * Scheduler event for the end of the outgoing superframe CFP.
-     */
-    EventId m_cfpEvent;
-
-    /**
-     * Scheduler event for the end of the incoming superframe CAP.
-     **/
-    EventId m_incCapEvent;
-
-    /**
-     * Scheduler event for the end of the incoming superframe CFP.
-     */
-    EventId m_incCfpEvent;
-
-    /**
-     * Scheduler event to track the incoming beacons.
-     */
-    EventId m_trackingEvent;
-
-    /**
-     * Scheduler event for the end of an ACTIVE or PASSIVE channel scan.
-     */
-    EventId m_scanEvent;
-
-    /**
-     * Scheduler event for the end of an ORPHAN channel scan.
-     */
-    EventId m_scanOrphanEvent;
-
-    /**
-     * Scheduler event for the end of a ED channel scan.
-     */
-    EventId m_scanEnergyEvent;
-
     /**
      * The uniform random variable used in this mac layer
      */
@@ -11,8 +11,11 @@
 
 #include "lr-wpan-constants.h"
 #include "lr-wpan-error-model.h"
+#include "lr-wpan-event-profiler.h"
 #include "lr-wpan-lqi-tag.h"
+#include "lr-wpan-mac-header.h"
 #include "lr-wpan-net-device.h"
+#include "lr-wpan-spectrum-channel.h"
 #include "lr-wpan-spectrum-signal-parameters.h"
 #include "lr-wpan-spectrum-value-helper.h"
 
@@ -32,6 +35,8 @@
 #include "ns3/spectrum-channel.h"
 #include "ns3/spectrum-value.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 namespace lrwpan
@@ -40,6 +45,16 @@ namespace lrwpan
 NS_LOG_COMPONENT_DEFINE("LrWpanPhy");
 NS_OBJECT_ENSURE_REGISTERED(LrWpanPhy);
 
+namespace
+{
+
+// Handlers reported to LrWpanEventProfiler
+const uint32_t PROFILE_END_CCA = LrWpanEventProfiler::RegisterHandler("LrWpanPhy::EndCca");
+const uint32_t PROFILE_TURNAROUND =
+    LrWpanEventProfiler::RegisterHandler("LrWpanPhy::EndSetTRXState");
+
+} // namespace
+
 /**
  * The data and symbol rates for the different PHY options.
  * See Table 1 in section 6.1.1 IEEE 802.15.4-2006, IEEE 802.15.4c-2009, IEEE 802.15.4d-2009.
@@ -149,6 +164,19 @@ LrWpanPhy::GetTypeId()
                           PointerValue(),
                           MakePointerAccessor(&LrWpanPhy::m_postReceptionErrorModel),
                           MakePointerChecker<ErrorModel>())
+            .AddAttribute("DutyCycleSnapshotInterval",
+                          "Interval of the DutyCycleSnapshot trace. Zero disables the "
+                          "periodic snapshots; the counters are always maintained.",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&LrWpanPhy::SetDutyCycleSnapshotInterval,
+                                           &LrWpanPhy::GetDutyCycleSnapshotInterval),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("WakeRatio",
+                          "The fraction of time the transceiver was not in TRX_OFF.",
+                          TypeId::ATTR_GET,
+                          DoubleValue(0.0),
+                          MakeDoubleAccessor(&LrWpanPhy::GetWakeRatio),
+                          MakeDoubleChecker<double>())
             .AddTraceSource("TrxStateValue",
                             "The state of the transceiver",
                             MakeTraceSourceAccessor(&LrWpanPhy::m_trxState),
@@ -187,16 +215,34 @@ LrWpanPhy::GetTypeId()
                             "Trace source indicating a packet has been "
                             "dropped by the device during reception",
                             MakeTraceSourceAccessor(&LrWpanPhy::m_phyRxDropTrace),
-                            "ns3::Packet::TracedCallback");
+                            "ns3::Packet::TracedCallback")
+            .AddTraceSource("PhyRxHeaderDrop",
+                            "Trace source indicating a packet has been "
+                            "dropped after its MAC header was rejected, "
+                            "with the airtime of the packet left",
+                            MakeTraceSourceAccessor(&LrWpanPhy::m_phyRxHeaderDropTrace),
+                            "ns3::lrwpan::LrWpanPhy::HeaderDropTracedCallback")
+            .AddTraceSource("DutyCycleSnapshot",
+                            "Periodic snapshot of the cumulative time spent in "
+                            "each transceiver state",
+                            MakeTraceSourceAccessor(&LrWpanPhy::m_dutyCycleSnapshotTrace),
+                            "ns3::lrwpan::LrWpanPhy::DutyCycleTracedCallback");
     return tid;
 }
 
 LrWpanPhy::LrWpanPhy()
-    : m_edRequest(),
+    : m_noiseInBandPower(0.0),
+      m_farFieldNoise(0.0),
+      m_edRequest(),
       m_setTRXState()
 {
     m_trxState = IEEE_802_15_4_PHY_TRX_OFF;
     m_trxStatePending = IEEE_802_15_4_PHY_IDLE;
+    m_rxOnAfterTx = false;
+    m_suppressNextTx = false;
+    m_deferNextTx = false;
+    m_accountedState = IEEE_802_15_4_PHY_TRX_OFF;
+    m_ccaIdle = false;
 
     // default PHY PIB attributes
     m_phyPIBAttributes.phyTransmitPower = 0;
@@ -209,6 +255,7 @@ LrWpanPhy::LrWpanPhy()
     m_random->SetAttribute("Max", DoubleValue(1.0));
 
     m_isRxCanceled = false;
+    m_dutyCycleLastChange = Simulator::Now();
     ChangeTrxState(IEEE_802_15_4_PHY_TRX_OFF);
 }
 
@@ -239,6 +286,12 @@ LrWpanPhy::DoInitialize()
             NS_LOG_WARN("Mobility not found, propagation models might not work properly");
         }
     }
+
+    if (m_dutyCycleSnapshotInterval.IsStrictlyPositive() && !m_dutyCycleSnapshotEvent.IsPending())
+    {
+        m_dutyCycleSnapshotEvent =
+            Simulator::Schedule(m_dutyCycleSnapshotInterval, &LrWpanPhy::DutyCycleSnapshot, this);
+    }
 }
 
 void
@@ -248,8 +301,23 @@ LrWpanPhy::DoDispose()
 
     // Cancel pending transceiver state change, if one is in progress.
     m_setTRXState.Cancel();
+
+    // Close the duty cycle accounting and report the last (partial) interval.
+    AccumulateDutyCycle();
+    if (m_dutyCycleSnapshotEvent.IsPending())
+    {
+        m_dutyCycleSnapshotEvent.Cancel();
+        m_dutyCycleSnapshotTrace(m_dutyCycle);
+    }
     m_trxState = IEEE_802_15_4_PHY_TRX_OFF;
     m_trxStatePending = IEEE_802_15_4_PHY_IDLE;
+    m_rxOnAfterTx = false;
+    m_suppressNextTx = false;
+    m_deferNextTx = false;
+    m_deferredTx = nullptr;
+    m_deferredTxTargets.clear();
+    m_accountedUntil = Time();
+    m_wakeCallback = MakeNullCallback<void, Ptr<LrWpanPhy>>();
 
     m_mobility = nullptr;
     m_device = nullptr;
@@ -260,6 +328,7 @@ LrWpanPhy::DoDispose()
     m_signal = nullptr;
     m_errorModel = nullptr;
     m_currentRxPacket.first = nullptr;
+    m_rxState = RxState();
     m_currentTxPacket.first = nullptr;
     m_postReceptionErrorModel = nullptr;
 
@@ -267,9 +336,12 @@ LrWpanPhy::DoDispose()
     m_edRequest.Cancel();
     m_setTRXState.Cancel();
     m_pdDataRequest.Cancel();
+    m_headerRx.Cancel();
 
     m_random = nullptr;
     m_pdDataIndicationCallback = MakeNullCallback<void, uint32_t, Ptr<Packet>, uint8_t>();
+    m_pdHeaderIndicationCallback =
+        MakeNullCallback<bool, Ptr<const Packet>, const LrWpanMacHeader&, Time>();
     m_pdDataConfirmCallback = MakeNullCallback<void, PhyEnumeration>();
     m_plmeCcaConfirmCallback = MakeNullCallback<void, PhyEnumeration>();
     m_plmeEdConfirmCallback = MakeNullCallback<void, PhyEnumeration, uint8_t>();
@@ -372,9 +444,8 @@ LrWpanPhy::StartRx(Ptr<SpectrumSignalParameters> spectrumRxParams)
         // Update the average receive power during ED.
         Time now = Simulator::Now();
         m_edPower.averagePower +=
-            LrWpanSpectrumValueHelper::TotalAvgPower(m_signal->GetSignalPsd(),
-                                                     m_phyPIBAttributes.phyCurrentChannel) *
-            (now - m_edPower.lastUpdate).GetTimeStep() / m_edPower.measurementLength.GetTimeStep();
+            m_signal->GetInBandPower() * (now - m_edPower.lastUpdate).GetTimeStep() /
+            m_edPower.measurementLength.GetTimeStep();
         m_edPower.lastUpdate = now;
     }
 
@@ -389,9 +460,8 @@ LrWpanPhy::StartRx(Ptr<SpectrumSignalParameters> spectrumRxParams)
         // Update peak power if CCA is in progress.
         if (!m_ccaRequest.IsExpired())
         {
-            double power =
-                LrWpanSpectrumValueHelper::TotalAvgPower(m_signal->GetSignalPsd(),
-                                                         m_phyPIBAttributes.phyCurrentChannel);
+            m_ccaIdle = false;
+            double power = m_signal->GetInBandPower();
             if (m_ccaPeakPower < power)
             {
                 m_ccaPeakPower = power;
@@ -408,6 +478,12 @@ LrWpanPhy::StartRx(Ptr<SpectrumSignalParameters> spectrumRxParams)
     Ptr<Packet> p = (lrWpanRxParams->packetBurst->GetPackets()).front();
     NS_ASSERT(p);
 
+    // Integrate the received PSD once; every later decision on this frame reuses it.
+    double rxPower = lrWpanRxParams->GetInBandPower(m_phyPIBAttributes.phyCurrentChannel);
+    // The PSD may be shared with other receptions (narrowband mode, cached transmit PSD),
+    // so the reception is accounted for by its parameters.
+    const void* rxId = PeekPointer(spectrumRxParams);
+
     // Prevent PHY from receiving another packet while switching the transceiver state.
     if (m_trxState == IEEE_802_15_4_PHY_RX_ON && !m_setTRXState.IsPending())
     {
@@ -427,21 +503,10 @@ LrWpanPhy::StartRx(Ptr<SpectrumSignalParameters> spectrumRxParams)
 
         // Add any incoming packet to the current interference before checking the
         // SINR.
-        NS_LOG_DEBUG(this << " receiving packet with power: "
-                          << 10 * log10(LrWpanSpectrumValueHelper::TotalAvgPower(
-                                      lrWpanRxParams->psd,
-                                      m_phyPIBAttributes.phyCurrentChannel)) +
-                                 30
+        NS_LOG_DEBUG(this << " receiving packet with power: " << 10 * log10(rxPower) + 30
                           << "dBm");
-        m_signal->AddSignal(lrWpanRxParams->psd);
-        Ptr<SpectrumValue> interferenceAndNoise = m_signal->GetSignalPsd();
-        *interferenceAndNoise -= *lrWpanRxParams->psd;
-        *interferenceAndNoise += *m_noise;
-        double sinr =
-            LrWpanSpectrumValueHelper::TotalAvgPower(lrWpanRxParams->psd,
-                                                     m_phyPIBAttributes.phyCurrentChannel) /
-            LrWpanSpectrumValueHelper::TotalAvgPower(interferenceAndNoise,
-                                                     m_phyPIBAttributes.phyCurrentChannel);
+        m_signal->AddSignal(rxId, lrWpanRxParams->psd, rxPower, lrWpanRxParams->psdGain);
+        double sinr = GetSinr(lrWpanRxParams);
 
         // Std. 802.15.4-2006, appendix E, Figure E.2
         // At SNR < -5 the BER is less than 10e-1.
@@ -450,9 +515,36 @@ LrWpanPhy::StartRx(Ptr<SpectrumSignalParameters> spectrumRxParams)
         {
             ChangeTrxState(IEEE_802_15_4_PHY_BUSY_RX);
             m_currentRxPacket = std::make_pair(lrWpanRxParams, false);
+            m_rxState.packet = p;
+            m_rxState.signalPower = rxPower;
+            m_rxState.bitsPerMs = GetDataOrSymbolRate(true) / 1000;
+            // The LQI is the total packet success rate scaled to 0-255.
+            // If not already set, initialize to 255.
+            LrWpanLqiTag tag(std::numeric_limits<uint8_t>::max());
+            p->PeekPacketTag(tag);
+            m_rxState.lqi = tag.Get();
             m_phyRxBeginTrace(p);
 
             m_rxLastUpdate = Simulator::Now();
+
+            if (!m_pdHeaderIndicationCallback.IsNull())
+            {
+                LrWpanMacHeader macHdr;
+                p->PeekHeader(macHdr);
+                Time headerTime =
+                    GetPpduHeaderTxTime() +
+                    Seconds(macHdr.GetSerializedSize() * 8.0 / GetDataOrSymbolRate(true));
+                if (headerTime < spectrumRxParams->duration)
+                {
+                    m_headerRx.Cancel();
+                    m_headerRx = Simulator::Schedule(headerTime,
+                                                     &LrWpanPhy::HeaderRx,
+                                                     this,
+                                                     lrWpanRxParams,
+                                                     macHdr,
+                                                     spectrumRxParams->duration - headerTime);
+                }
+            }
         }
         else
         {
@@ -471,7 +563,7 @@ LrWpanPhy::StartRx(Ptr<SpectrumSignalParameters> spectrumRxParams)
         // Add the incoming packet to the current interference after we have
         // checked for successful reception of the current packet for the time
         // before the additional interference.
-        m_signal->AddSignal(lrWpanRxParams->psd);
+        m_signal->AddSignal(rxId, lrWpanRxParams->psd, rxPower, lrWpanRxParams->psdGain);
     }
     else
     {
@@ -480,15 +572,14 @@ LrWpanPhy::StartRx(Ptr<SpectrumSignalParameters> spectrumRxParams)
         m_phyRxDropTrace(p);
 
         // Add the signal power to the interference, anyway.
-        m_signal->AddSignal(lrWpanRxParams->psd);
+        m_signal->AddSignal(rxId, lrWpanRxParams->psd, rxPower, lrWpanRxParams->psdGain);
     }
 
     // Update peak power if CCA is in progress.
     if (!m_ccaRequest.IsExpired())
     {
-        double power =
-            LrWpanSpectrumValueHelper::TotalAvgPower(m_signal->GetSignalPsd(),
-                                                     m_phyPIBAttributes.phyCurrentChannel);
+        m_ccaIdle = false;
+        double power = m_signal->GetInBandPower();
         if (m_ccaPeakPower < power)
         {
             m_ccaPeakPower = power;
@@ -516,9 +607,6 @@ void
 LrWpanPhy::CheckInterference()
 {
     // Calculate whether packet was lost.
-    LrWpanSpectrumValueHelper psdHelper;
-    Ptr<LrWpanSpectrumSignalParameters> currentRxParams = m_currentRxPacket.first;
-
     // We are currently receiving a packet.
     if (m_trxState == IEEE_802_15_4_PHY_BUSY_RX)
     {
@@ -529,29 +617,16 @@ LrWpanPhy::CheckInterference()
             return;
         }
 
-        Ptr<Packet> currentPacket = currentRxParams->packetBurst->GetPackets().front();
         if (m_errorModel)
         {
             // How many bits did we receive since the last calculation?
             double t = (Simulator::Now() - m_rxLastUpdate).ToDouble(Time::MS);
-            uint32_t chunkSize = ceil(t * (GetDataOrSymbolRate(true) / 1000));
-            Ptr<SpectrumValue> interferenceAndNoise = m_signal->GetSignalPsd();
-            *interferenceAndNoise -= *currentRxParams->psd;
-            *interferenceAndNoise += *m_noise;
-            double sinr =
-                LrWpanSpectrumValueHelper::TotalAvgPower(currentRxParams->psd,
-                                                         m_phyPIBAttributes.phyCurrentChannel) /
-                LrWpanSpectrumValueHelper::TotalAvgPower(interferenceAndNoise,
-                                                         m_phyPIBAttributes.phyCurrentChannel);
+            uint32_t chunkSize = ceil(t * m_rxState.bitsPerMs);
+            double sinr = GetSinr(m_rxState.signalPower);
             double per = 1.0 - m_errorModel->GetChunkSuccessRate(sinr, chunkSize);
 
-            // The LQI is the total packet success rate scaled to 0-255.
-            // If not already set, initialize to 255.
-            LrWpanLqiTag tag(std::numeric_limits<uint8_t>::max());
-            currentPacket->PeekPacketTag(tag);
-            uint8_t lqi = tag.Get();
-            tag.Set(lqi - (per * lqi));
-            currentPacket->ReplacePacketTag(tag);
+            // Only the state is updated here; EndRx() writes the LQI tag.
+            m_rxState.lqi = static_cast<uint8_t>(m_rxState.lqi - (per * m_rxState.lqi));
 
             if (m_random->GetValue() < per)
             {
@@ -580,9 +655,8 @@ LrWpanPhy::EndRx(Ptr<SpectrumSignalParameters> par)
         // Update the average receive power during ED.
         Time now = Simulator::Now();
         m_edPower.averagePower +=
-            LrWpanSpectrumValueHelper::TotalAvgPower(m_signal->GetSignalPsd(),
-                                                     m_phyPIBAttributes.phyCurrentChannel) *
-            (now - m_edPower.lastUpdate).GetTimeStep() / m_edPower.measurementLength.GetTimeStep();
+            m_signal->GetInBandPower() * (now - m_edPower.lastUpdate).GetTimeStep() /
+            m_edPower.measurementLength.GetTimeStep();
         m_edPower.lastUpdate = now;
     }
 
@@ -593,7 +667,14 @@ LrWpanPhy::EndRx(Ptr<SpectrumSignalParameters> par)
     }
 
     // Update the interference.
-    m_signal->RemoveSignal(par->psd);
+    if (params)
+    {
+        m_signal->RemoveSignal(static_cast<const void*>(PeekPointer(par)));
+    }
+    else
+    {
+        m_signal->RemoveSignal(par->psd);
+    }
 
     if (!params)
     {
@@ -605,7 +686,7 @@ LrWpanPhy::EndRx(Ptr<SpectrumSignalParameters> par)
     // If this is the end of the currently received packet, check if reception was successful.
     if (currentRxParams == params)
     {
-        Ptr<Packet> currentPacket = currentRxParams->packetBurst->GetPackets().front();
+        Ptr<Packet> currentPacket = m_rxState.packet;
         NS_ASSERT(currentPacket);
 
         if (m_postReceptionErrorModel &&
@@ -615,10 +696,15 @@ LrWpanPhy::EndRx(Ptr<SpectrumSignalParameters> par)
             m_currentRxPacket.second = true;
         }
 
-        // If there is no error model attached to the PHY, we always report the maximum LQI value.
-        LrWpanLqiTag tag(std::numeric_limits<uint8_t>::max());
-        currentPacket->PeekPacketTag(tag);
-        m_phyRxEndTrace(currentPacket, tag.Get());
+        // If there is no error model attached to the PHY, we always report the maximum LQI value
+        // (or the one the frame was tagged with).
+        uint8_t lqi = m_rxState.lqi;
+        if (m_errorModel)
+        {
+            currentPacket->ReplacePacketTag(LrWpanLqiTag(lqi));
+        }
+        m_rxState.packet = nullptr;
+        m_phyRxEndTrace(currentPacket, lqi);
 
         if (!m_currentRxPacket.second)
         {
@@ -629,7 +715,7 @@ LrWpanPhy::EndRx(Ptr<SpectrumSignalParameters> par)
             // The packet was successfully received, push it up the stack.
             if (!m_pdDataIndicationCallback.IsNull())
             {
-                m_pdDataIndicationCallback(currentPacket->GetSize(), currentPacket, tag.Get());
+                m_pdDataIndicationCallback(currentPacket->GetSize(), currentPacket, lqi);
             }
         }
         else
@@ -661,11 +747,53 @@ LrWpanPhy::EndRx(Ptr<SpectrumSignalParameters> par)
     }
 }
 
+void
+LrWpanPhy::HeaderRx(Ptr<LrWpanSpectrumSignalParameters> params,
+                    LrWpanMacHeader macHdr,
+                    Time remaining)
+{
+    NS_LOG_FUNCTION(this << params << remaining);
+
+    // The frame was lost or the reception canceled in the meantime.
+    if (m_currentRxPacket.first != params || m_currentRxPacket.second ||
+        m_trxState != IEEE_802_15_4_PHY_BUSY_RX)
+    {
+        return;
+    }
+
+    Ptr<Packet> currentPacket = m_rxState.packet;
+    if (m_pdHeaderIndicationCallback(currentPacket, macHdr, remaining))
+    {
+        return;
+    }
+
+    // The MAC is not interested in this frame: release the receiver, the rest of
+    // the frame is only interference. EndRx() removes the signal as usual.
+    NS_LOG_DEBUG("Frame rejected after the MAC header, " << remaining.As(Time::US) << " left");
+    uint8_t lqi = m_rxState.lqi;
+    if (m_errorModel)
+    {
+        currentPacket->ReplacePacketTag(LrWpanLqiTag(lqi));
+    }
+    m_rxState.packet = nullptr;
+    m_phyRxEndTrace(currentPacket, lqi);
+    m_phyRxHeaderDropTrace(currentPacket, remaining);
+    m_phyRxDropTrace(currentPacket);
+    m_currentRxPacket = std::make_pair(nullptr, true);
+    ChangeTrxState(IEEE_802_15_4_PHY_RX_ON);
+}
+
 void
 LrWpanPhy::PdDataRequest(const uint32_t psduLength, Ptr<Packet> p)
 {
     NS_LOG_FUNCTION(this << psduLength << p);
 
+    // The suppression only applies to this request, whatever its outcome.
+    bool suppressTx = m_suppressNextTx;
+    m_suppressNextTx = false;
+    bool deferTx = m_deferNextTx;
+    m_deferNextTx = false;
+
     if (psduLength > lrwpan::aMaxPhyPacketSize)
     {
         if (!m_pdDataConfirmCallback.IsNull())
@@ -697,10 +825,26 @@ LrWpanPhy::PdDataRequest(const uint32_t psduLength, Ptr<Packet> p)
             txParams->txPhy = GetObject<SpectrumPhy>();
             txParams->psd = m_txPsd;
             txParams->txAntenna = m_antenna;
+            txParams->txChannel = m_phyPIBAttributes.phyCurrentChannel;
             Ptr<PacketBurst> pb = CreateObject<PacketBurst>();
             pb->AddPacket(p);
             txParams->packetBurst = pb;
-            m_channel->StartTx(txParams);
+            if (suppressTx)
+            {
+                NS_LOG_DEBUG("Transmission kept off the channel");
+            }
+            else if (deferTx)
+            {
+                // A copy, so that later changes to the packet do not reach the receivers.
+                NS_LOG_DEBUG("Transmission deferred until a receiver wakes up");
+                m_deferredTx = txParams->Copy();
+                m_deferredTxStart = Simulator::Now();
+                m_deferredTxEnd = m_deferredTxStart + txParams->duration + m_deferredTxMaxDelay;
+            }
+            else
+            {
+                m_channel->StartTx(txParams);
+            }
             // TODO 同時刻にスケジュールされた場合の挙動をチェックする
             if (m_EndRx.IsPending())
             {
@@ -754,8 +898,12 @@ LrWpanPhy::PlmeCcaRequest()
     if (m_trxState == IEEE_802_15_4_PHY_RX_ON || m_trxState == IEEE_802_15_4_PHY_BUSY_RX)
     {
         m_ccaPeakPower = 0.0;
+        // Nothing is on the air at the start of the CCA: unless StartRx() sees a
+        // signal before EndCca(), the channel is idle in every CCA mode.
+        m_ccaIdle = (m_trxState == IEEE_802_15_4_PHY_RX_ON) && m_signal->IsEmpty();
         Time ccaTime = Seconds(8.0 / GetDataOrSymbolRate(false));
         m_ccaRequest = Simulator::Schedule(ccaTime, &LrWpanPhy::EndCca, this);
+        LrWpanEventProfiler::RecordScheduled(PROFILE_END_CCA);
     }
     else
     {
@@ -777,6 +925,7 @@ void
 LrWpanPhy::CcaCancel()
 {
     NS_LOG_FUNCTION(this);
+    LrWpanEventProfiler::RecordCancelled(PROFILE_END_CCA, m_ccaRequest);
     m_ccaRequest.Cancel();
 }
 
@@ -839,6 +988,97 @@ LrWpanPhy::PlmeGetAttributeRequest(PhyPibAttributeIdentifier id)
     }
 }
 
+void
+LrWpanPhy::SuppressNextTx()
+{
+    NS_LOG_FUNCTION(this);
+    m_suppressNextTx = true;
+}
+
+bool
+LrWpanPhy::DeferNextTx()
+{
+    NS_LOG_FUNCTION(this);
+
+    Ptr<LrWpanSpectrumChannel> channel = DynamicCast<LrWpanSpectrumChannel>(m_channel);
+    if (!channel || IsDeferredTxOnAir())
+    {
+        return false;
+    }
+    m_deferredTx = nullptr;
+    if (!channel->GetDeferrableTargets(GetObject<SpectrumPhy>(),
+                                       m_txPsd,
+                                       m_phyPIBAttributes.phyCurrentChannel,
+                                       m_deferredTxTargets,
+                                       m_deferredTxMaxDelay))
+    {
+        return false;
+    }
+    m_deferNextTx = true;
+    return true;
+}
+
+void
+LrWpanPhy::DeliverDeferredTx(Ptr<SpectrumPhy> rxPhy)
+{
+    NS_LOG_FUNCTION(this << rxPhy);
+
+    if (!IsDeferredTxOnAir())
+    {
+        return;
+    }
+    auto it = std::find(m_deferredTxTargets.begin(), m_deferredTxTargets.end(), rxPhy);
+    if (it == m_deferredTxTargets.end())
+    {
+        return;
+    }
+    m_deferredTxTargets.erase(it);
+    DynamicCast<LrWpanSpectrumChannel>(m_channel)->DeliverDeferredTx(m_deferredTx,
+                                                                      m_deferredTxStart,
+                                                                      rxPhy);
+}
+
+bool
+LrWpanPhy::IsDeferredTxOnAir() const
+{
+    return m_deferredTx && !m_deferredTxTargets.empty() && Simulator::Now() < m_deferredTxEnd;
+}
+
+bool
+LrWpanPhy::PdDataRequestThenRxOn(const uint32_t psduLength, Ptr<Packet> p)
+{
+    NS_LOG_FUNCTION(this << psduLength << p);
+
+    if (m_trxState != IEEE_802_15_4_PHY_TRX_OFF && m_trxState != IEEE_802_15_4_PHY_TX_ON)
+    {
+        return false;
+    }
+
+    // Same as PlmeSetTRXStateRequest(TX_ON) from TRX_OFF, minus the confirm:
+    // a switch still in progress is overridden and TX_ON is entered at once.
+    if (!m_setTRXState.IsExpired())
+    {
+        NS_LOG_DEBUG("Cancel m_setTRXState");
+        LrWpanEventProfiler::RecordCancelled(PROFILE_TURNAROUND, m_setTRXState);
+        m_setTRXState.Cancel();
+    }
+    m_trxStatePending = IEEE_802_15_4_PHY_IDLE;
+    if (m_trxState == IEEE_802_15_4_PHY_TRX_OFF)
+    {
+        CancelEd(IEEE_802_15_4_PHY_TX_ON);
+        ChangeTrxState(IEEE_802_15_4_PHY_TX_ON);
+    }
+
+    m_rxOnAfterTx = true;
+    PdDataRequest(psduLength, p);
+    if (m_trxState != IEEE_802_15_4_PHY_BUSY_TX)
+    {
+        // The frame was rejected (e.g. too long); PD-DATA.confirm has been sent.
+        m_rxOnAfterTx = false;
+    }
+    return true;
+}
+
 // Section 6.2.2.7.3
 void
 LrWpanPhy::PlmeSetTRXStateRequest(PhyEnumeration state)
@@ -863,6 +1103,7 @@ LrWpanPhy::PlmeSetTRXStateRequest(PhyEnumeration state)
         {
             NS_LOG_DEBUG("Cancel m_setTRXState");
             // Keep the transceiver state as the old state before the switching attempt.
+            LrWpanEventProfiler::RecordCancelled(PROFILE_TURNAROUND, m_setTRXState);
             m_setTRXState.Cancel();
         }
     }
@@ -944,6 +1185,7 @@ LrWpanPhy::PlmeSetTRXStateRequest(PhyEnumeration state)
             // If CCA is in progress, cancel CCA and return BUSY.
             if (!m_ccaRequest.IsExpired())
             {
+                LrWpanEventProfiler::RecordCancelled(PROFILE_END_CCA, m_ccaRequest);
                 m_ccaRequest.Cancel();
                 if (!m_plmeCcaConfirmCallback.IsNull())
                 {
@@ -956,6 +1198,7 @@ LrWpanPhy::PlmeSetTRXStateRequest(PhyEnumeration state)
             // Delay for turnaround time (BUSY_RX|RX_ON ---> TX_ON)
             Time setTime = Seconds((double)lrwpan::aTurnaroundTime / GetDataOrSymbolRate(false));
             m_setTRXState = Simulator::Schedule(setTime, &LrWpanPhy::EndSetTRXState, this);
+            LrWpanEventProfiler::RecordScheduled(PROFILE_TURNAROUND);
             return;
         }
         else if (m_trxState == IEEE_802_15_4_PHY_BUSY_TX || m_trxState == IEEE_802_15_4_PHY_TX_ON)
@@ -1034,6 +1277,7 @@ LrWpanPhy::PlmeSetTRXStateRequest(PhyEnumeration state)
 
             Time setTime = Seconds((double)lrwpan::aTurnaroundTime / GetDataOrSymbolRate(false));
             m_setTRXState = Simulator::Schedule(setTime, &LrWpanPhy::EndSetTRXState, this);
+            LrWpanEventProfiler::RecordScheduled(PROFILE_TURNAROUND);
             return;
         }
         else if (m_trxState == IEEE_802_15_4_PHY_BUSY_RX)
@@ -1113,6 +1357,7 @@ LrWpanPhy::PlmeSetAttributeRequest(PhyPibAttributeIdentifier id, Ptr<PhyPibAttri
             if (m_trxStatePending != IEEE_802_15_4_PHY_IDLE)
             {
                 m_trxStatePending = IEEE_802_15_4_PHY_IDLE;
+                LrWpanEventProfiler::RecordCancelled(PROFILE_TURNAROUND, m_setTRXState);
                 m_setTRXState.Cancel();
                 if (!m_plmeSetTRXStateConfirmCallback.IsNull())
                 {
@@ -1282,6 +1527,7 @@ LrWpanPhy::PlmeSetAttributeRequest(PhyPibAttributeIdentifier id, Ptr<PhyPibAttri
             if (m_trxStatePending != IEEE_802_15_4_PHY_IDLE)
             {
                 m_trxStatePending = IEEE_802_15_4_PHY_IDLE;
+                LrWpanEventProfiler::RecordCancelled(PROFILE_TURNAROUND, m_setTRXState);
                 m_setTRXState.Cancel();
                 if (!m_plmeSetTRXStateConfirmCallback.IsNull())
                 {
@@ -1307,8 +1553,8 @@ LrWpanPhy::PlmeSetAttributeRequest(PhyPibAttributeIdentifier id, Ptr<PhyPibAttri
 
             m_phyPIBAttributes.phyCurrentChannel = attribute->phyCurrentChannel;
 
-            // use the prev configured sensitivity before changing the channel
-            SetRxSensitivity(WToDbm(m_rxSensitivity));
+            // keep the configured sensitivity and the signals in the air
+            RetuneChannel();
         }
         break;
     }
@@ -1333,8 +1579,7 @@ LrWpanPhy::PlmeSetAttributeRequest(PhyPibAttributeIdentifier id, Ptr<PhyPibAttri
         else
         {
             m_phyPIBAttributes.phyTransmitPower = attribute->phyTransmitPower;
-            LrWpanSpectrumValueHelper psdHelper;
-            m_txPsd = psdHelper.CreateTxPowerSpectralDensity(
+            m_txPsd = LrWpanSpectrumValueHelper::GetSharedTxPowerSpectralDensity(
                 GetNominalTxPowerFromPib(m_phyPIBAttributes.phyTransmitPower),
                 m_phyPIBAttributes.phyCurrentChannel);
         }
@@ -1370,6 +1615,13 @@ LrWpanPhy::SetPdDataIndicationCallback(PdDataIndicationCallback c)
     m_pdDataIndicationCallback = c;
 }
 
+void
+LrWpanPhy::SetPdHeaderIndicationCallback(PdHeaderIndicationCallback c)
+{
+    NS_LOG_FUNCTION(this);
+    m_pdHeaderIndicationCallback = c;
+}
+
 void
 LrWpanPhy::SetPdDataConfirmCallback(PdDataConfirmCallback c)
 {
@@ -1412,15 +1664,200 @@ LrWpanPhy::SetPlmeSetAttributeConfirmCallback(PlmeSetAttributeConfirmCallback c)
     m_plmeSetAttributeConfirmCallback = c;
 }
 
+void
+LrWpanPhy::SetWakeCallback(PhyWakeCallback c)
+{
+    NS_LOG_FUNCTION(this);
+    m_wakeCallback = c;
+}
+
 void
 LrWpanPhy::ChangeTrxState(PhyEnumeration newState)
 {
     NS_LOG_LOGIC(this << " state: " << m_trxState << " -> " << newState);
 
+    const bool wake =
+        m_trxState == IEEE_802_15_4_PHY_TRX_OFF && newState != IEEE_802_15_4_PHY_TRX_OFF;
+    if (wake && !m_wakeCallback.IsNull())
+    {
+        // Still in TRX_OFF: what the callback delivers reaches a transceiver that is off.
+        m_wakeCallback(this);
+    }
+
+    AccumulateDutyCycle();
+    if (wake)
+    {
+        m_accountedUntil = Time();
+    }
     m_trxStateLogger(Simulator::Now(), m_trxState, newState);
     m_trxState = newState;
 }
 
+/**
+ * Add a duration to the duty cycle counter of a transceiver state.
+ *
+ * @param counters the counters to update
+ * @param state the transceiver state the duration was spent in
+ * @param elapsed the duration
+ */
+static void
+AddDutyCycleTime(PhyDutyCycleCounters& counters, PhyEnumeration state, Time elapsed)
+{
+    switch (state)
+    {
+    case IEEE_802_15_4_PHY_TRX_OFF:
+        counters.trxOff += elapsed;
+        break;
+    case IEEE_802_15_4_PHY_RX_ON:
+        counters.rxOn += elapsed;
+        break;
+    case IEEE_802_15_4_PHY_BUSY_RX:
+        counters.busyRx += elapsed;
+        break;
+    case IEEE_802_15_4_PHY_TX_ON:
+        counters.txOn += elapsed;
+        break;
+    case IEEE_802_15_4_PHY_BUSY_TX:
+        counters.busyTx += elapsed;
+        break;
+    default:
+        // Not a transceiver state; nothing to account
+        break;
+    }
+}
+
+void
+LrWpanPhy::AccumulateDutyCycle()
+{
+    Time now = Simulator::Now();
+    AddDutyCycleInterval(m_dutyCycle, m_dutyCycleLastChange, now);
+    m_dutyCycleLastChange = now;
+}
+
+void
+LrWpanPhy::AddDutyCycleInterval(PhyDutyCycleCounters& counters, Time from, Time to) const
+{
+    if (m_trxState == IEEE_802_15_4_PHY_TRX_OFF && from < m_accountedUntil)
+    {
+        Time accountedEnd = std::min(to, m_accountedUntil);
+        AddDutyCycleTime(counters, m_accountedState, accountedEnd - from);
+        from = accountedEnd;
+    }
+    AddDutyCycleTime(counters, m_trxState, to - from);
+}
+
+void
+LrWpanPhy::AccountTrxOffAs(PhyEnumeration state, Time until)
+{
+    NS_LOG_FUNCTION(this << state << until);
+    AccumulateDutyCycle();
+    m_accountedState = state;
+    m_accountedUntil = until;
+}
+
+void
+LrWpanPhy::EnterAccountedState()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(m_trxState == IEEE_802_15_4_PHY_TRX_OFF);
+    ChangeTrxState(m_accountedState);
+}
+
+bool
+LrWpanPhy::IsTrxStateTraced() const
+{
+    return !m_trxStateLogger.IsEmpty();
+}
+
+bool
+LrWpanPhy::IsRxDropTraced() const
+{
+    return !m_phyRxDropTrace.IsEmpty();
+}
+
+PhyEnumeration
+LrWpanPhy::GetTrxState() const
+{
+    return m_trxState;
+}
+
+bool
+LrWpanPhy::IsQuiescent() const
+{
+    return m_trxState == IEEE_802_15_4_PHY_TRX_OFF &&
+           m_trxStatePending == IEEE_802_15_4_PHY_IDLE && !m_setTRXState.IsPending() &&
+           !m_pdDataRequest.IsPending() && !m_ccaRequest.IsPending() && !m_edRequest.IsPending() &&
+           Simulator::Now() >= m_accountedUntil;
+}
+
+PhyDutyCycleCounters
+LrWpanPhy::GetDutyCycleCounters() const
+{
+    PhyDutyCycleCounters counters = m_dutyCycle;
+    AddDutyCycleInterval(counters, m_dutyCycleLastChange, Simulator::Now());
+    return counters;
+}
+
+void
+LrWpanPhy::ResetDutyCycleCounters()
+{
+    NS_LOG_FUNCTION(this);
+    m_dutyCycle = PhyDutyCycleCounters();
+    m_dutyCycleLastChange = Simulator::Now();
+}
+
+double
+LrWpanPhy::GetWakeRatio() const
+{
+    return GetDutyCycleCounters().GetWakeRatio();
+}
+
+void
+LrWpanPhy::SetDutyCycleSnapshotInterval(Time interval)
+{
+    NS_LOG_FUNCTION(this << interval);
+    m_dutyCycleSnapshotInterval = interval;
+    m_dutyCycleSnapshotEvent.Cancel();
+    // Before initialization the first snapshot is scheduled by DoInitialize()
+    if (IsInitialized() && interval.IsStrictlyPositive())
+    {
+        m_dutyCycleSnapshotEvent =
+            Simulator::Schedule(interval, &LrWpanPhy::DutyCycleSnapshot, this);
+    }
+}
+
+Time
+LrWpanPhy::GetDutyCycleSnapshotInterval() const
+{
+    return m_dutyCycleSnapshotInterval;
+}
+
+void
+LrWpanPhy::DutyCycleSnapshot()
+{
+    AccumulateDutyCycle();
+    m_dutyCycleSnapshotTrace(m_dutyCycle);
+    m_dutyCycleSnapshotEvent =
+        Simulator::Schedule(m_dutyCycleSnapshotInterval, &LrWpanPhy::DutyCycleSnapshot, this);
+}
+
+Time
+PhyDutyCycleCounters::GetTotal() const
+{
+    return trxOff + rxOn + busyRx + txOn + busyTx;
+}
+
+double
+PhyDutyCycleCounters::GetWakeRatio() const
+{
+    Time total = GetTotal();
+    if (!total.IsStrictlyPositive())
+    {
+        return 0.0;
+    }
+    return 1.0 - trxOff.GetSeconds() / total.GetSeconds();
+}
+
 bool
 LrWpanPhy::PhyIsBusy() const
 {
@@ -1451,9 +1888,7 @@ LrWpanPhy::EndEd()
     NS_LOG_FUNCTION(this);
 
     m_edPower.averagePower +=
-        LrWpanSpectrumValueHelper::TotalAvgPower(m_signal->GetSignalPsd(),
-                                                 m_phyPIBAttributes.phyCurrentChannel) *
-        (Simulator::Now() - m_edPower.lastUpdate).GetTimeStep() /
+        m_signal->GetInBandPower() * (Simulator::Now() - m_edPower.lastUpdate).GetTimeStep() /
         m_edPower.measurementLength.GetTimeStep();
 
     uint8_t energyLevel;
@@ -1485,11 +1920,23 @@ void
 LrWpanPhy::EndCca()
 {
     NS_LOG_FUNCTION(this);
+    LrWpanEventProfiler::Scope profile(PROFILE_END_CCA);
     PhyEnumeration sensedChannelState = IEEE_802_15_4_PHY_UNSPECIFIED;
 
+    if (m_ccaIdle)
+    {
+        m_ccaIdle = false;
+        NS_LOG_LOGIC(this << "channel sensed state: " << IEEE_802_15_4_PHY_IDLE
+                          << " (no signal during CCA)");
+        if (!m_plmeCcaConfirmCallback.IsNull())
+        {
+            m_plmeCcaConfirmCallback(IEEE_802_15_4_PHY_IDLE);
+        }
+        return;
+    }
+
     // Update peak power.
-    double power = LrWpanSpectrumValueHelper::TotalAvgPower(m_signal->GetSignalPsd(),
-                                                            m_phyPIBAttributes.phyCurrentChannel);
+    double power = m_signal->GetInBandPower();
     if (m_ccaPeakPower < power)
     {
         m_ccaPeakPower = power;
@@ -1560,6 +2007,7 @@ void
 LrWpanPhy::EndSetTRXState()
 {
     NS_LOG_FUNCTION(this);
+    LrWpanEventProfiler::Scope profile(PROFILE_TURNAROUND);
 
     NS_ABORT_IF((m_trxStatePending != IEEE_802_15_4_PHY_RX_ON) &&
                 (m_trxStatePending != IEEE_802_15_4_PHY_TX_ON));
@@ -1621,6 +2069,20 @@ LrWpanPhy::EndTx()
     m_currentTxPacket.first = nullptr;
     m_currentTxPacket.second = false;
 
+    // Fused wake-up/transmission: continue with RX_ON unless the MAC asked for
+    // another state from the confirm or the transmission was aborted.
+    if (m_rxOnAfterTx)
+    {
+        m_rxOnAfterTx = false;
+        if (m_trxStatePending == IEEE_802_15_4_PHY_IDLE && !m_setTRXState.IsPending() &&
+            m_trxState == IEEE_802_15_4_PHY_BUSY_TX)
+        {
+            NS_LOG_DEBUG("Switch to RX_ON after the fused transmission");
+            ChangeTrxState(IEEE_802_15_4_PHY_RX_ON);
+            return;
+        }
+    }
+
     NS_LOG_DEBUG("aaa");
     // We may be waiting to apply a pending state change.
     if (m_trxStatePending != IEEE_802_15_4_PHY_IDLE)
@@ -1814,6 +2276,7 @@ LrWpanPhy::SetPhyOption(PhyOption phyOption)
 
     m_rxLastUpdate = Seconds(0);
     m_currentRxPacket = std::make_pair(nullptr, true);
+    m_rxState = RxState();
     m_currentTxPacket = std::make_pair(nullptr, true);
     m_errorModel = nullptr;
 }
@@ -1851,20 +2314,42 @@ LrWpanPhy::SetRxSensitivity(double dbmSensitivity)
     // supported.
     double maxRxSensitivityW = DbmToW(-106.58);
 
+    // The PSDs only depend on their parameters: they are shared by all the PHYs.
     LrWpanSpectrumValueHelper psdHelper;
-    m_txPsd = psdHelper.CreateTxPowerSpectralDensity(
+    m_txPsd = LrWpanSpectrumValueHelper::GetSharedTxPowerSpectralDensity(
         GetNominalTxPowerFromPib(m_phyPIBAttributes.phyTransmitPower),
         m_phyPIBAttributes.phyCurrentChannel);
     // Update thermal noise + noise factor added.
     long double noiseFactor = DbmToW(dbmSensitivity) / maxRxSensitivityW;
     psdHelper.SetNoiseFactor(noiseFactor);
-    m_noise = psdHelper.CreateNoisePowerSpectralDensity(m_phyPIBAttributes.phyCurrentChannel);
+    m_noise = psdHelper.GetSharedNoisePowerSpectralDensity(m_phyPIBAttributes.phyCurrentChannel);
+
+    UpdateNoiseInBandPower();
 
     m_signal = Create<LrWpanInterferenceHelper>(m_noise->GetSpectrumModel());
+    m_signal->SetChannel(m_phyPIBAttributes.phyCurrentChannel);
     // Change receiver sensitivity from dBm to Watts
     m_rxSensitivity = DbmToW(dbmSensitivity);
 }
 
+void
+LrWpanPhy::RetuneChannel()
+{
+    NS_LOG_FUNCTION(this << static_cast<uint32_t>(m_phyPIBAttributes.phyCurrentChannel));
+
+    // Same PSDs as SetRxSensitivity() with the configured sensitivity, from the shared caches
+    LrWpanSpectrumValueHelper psdHelper;
+    m_txPsd = LrWpanSpectrumValueHelper::GetSharedTxPowerSpectralDensity(
+        GetNominalTxPowerFromPib(m_phyPIBAttributes.phyTransmitPower),
+        m_phyPIBAttributes.phyCurrentChannel);
+    psdHelper.SetNoiseFactor(m_rxSensitivity / DbmToW(-106.58));
+    m_noise = psdHelper.GetSharedNoisePowerSpectralDensity(m_phyPIBAttributes.phyCurrentChannel);
+    UpdateNoiseInBandPower();
+
+    // Only the in-band powers of the signals change
+    m_signal->SetChannel(m_phyPIBAttributes.phyCurrentChannel);
+}
+
 double
 LrWpanPhy::GetRxSensitivity()
 {
@@ -1889,6 +2374,13 @@ LrWpanPhy::SetTxPowerSpectralDensity(Ptr<SpectrumValue> txPsd)
     NS_LOG_INFO("\t computed tx_psd: " << *txPsd << "\t stored tx_psd: " << *m_txPsd);
 }
 
+Ptr<SpectrumValue>
+LrWpanPhy::GetTxPowerSpectralDensity() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_txPsd;
+}
+
 void
 LrWpanPhy::SetNoisePowerSpectralDensity(Ptr<const SpectrumValue> noisePsd)
 {
@@ -1896,6 +2388,7 @@ LrWpanPhy::SetNoisePowerSpectralDensity(Ptr<const SpectrumValue> noisePsd)
     NS_LOG_INFO("\t computed noise_psd: " << *noisePsd);
     NS_ASSERT(noisePsd);
     m_noise = noisePsd;
+    UpdateNoiseInBandPower();
 }
 
 Ptr<const SpectrumValue>
@@ -1939,12 +2432,54 @@ LrWpanPhy::GetPhySymbolsPerOctet() const
     return dataSymbolRates[m_phyOption].symbolRate / (dataSymbolRates[m_phyOption].bitRate / 8);
 }
 
+void
+LrWpanPhy::UpdateNoiseInBandPower()
+{
+    // TotalAvgPower() only covers the 2.4 GHz channels (11-26)
+    uint32_t channel = m_phyPIBAttributes.phyCurrentChannel;
+    m_noiseInBandPower = (channel >= 11 && channel <= 26)
+                             ? LrWpanSpectrumValueHelper::TotalAvgPower(m_noise, channel)
+                             : 0.0;
+}
+
+double
+LrWpanPhy::GetSinr(Ptr<LrWpanSpectrumSignalParameters> params) const
+{
+    return GetSinr(params->GetInBandPower(m_phyPIBAttributes.phyCurrentChannel));
+}
+
+double
+LrWpanPhy::GetSinr(double signalPower) const
+{
+    // All in-band powers on the current channel: the interference is the running
+    // total of the interference helper minus the signal itself.
+    double interference = std::max(0.0, m_signal->GetInBandPower() - signalPower);
+    return signalPower / (interference + m_noiseInBandPower + m_farFieldNoise);
+}
+
+void
+LrWpanPhy::SetFarFieldNoise(double power)
+{
+    NS_LOG_FUNCTION(this << power);
+    NS_ASSERT(power >= 0);
+    if (power != m_farFieldNoise)
+    {
+        // close the current SINR chunk with the former noise
+        CheckInterference();
+        m_farFieldNoise = power;
+    }
+}
+
+double
+LrWpanPhy::GetFarFieldNoise() const
+{
+    return m_farFieldNoise;
+}
+
 double
 LrWpanPhy::GetCurrentSignalPsd()
 {
-    double powerWatts =
-        LrWpanSpectrumValueHelper::TotalAvgPower(m_signal->GetSignalPsd(),
-                                                 m_phyPIBAttributes.phyCurrentChannel);
+    double powerWatts = m_signal->GetInBandPower();
     return WToDbm(powerWatts);
 }
 
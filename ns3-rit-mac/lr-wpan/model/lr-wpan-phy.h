@@ -13,11 +13,13 @@
 #include "lr-wpan-interference-helper.h"
 
 #include "ns3/event-id.h"
+#include "ns3/nstime.h"
 #include "ns3/spectrum-phy.h"
 #include "ns3/traced-callback.h"
 #include "ns3/traced-value.h"
 
 #include <iostream>
+#include <vector>
 
 namespace ns3
 {
@@ -36,6 +38,8 @@ namespace lrwpan
 {
 
 class LrWpanErrorModel;
+class LrWpanMacHeader;
+class LrWpanPhy;
 struct LrWpanSpectrumSignalParameters;
 
 /**
@@ -194,6 +198,19 @@ struct PhyPibAttributes : public SimpleRefCount<PhyPibAttributes>
  */
 typedef Callback<void, uint32_t, Ptr<Packet>, uint8_t> PdDataIndicationCallback;
 
+/**
+ * @ingroup lr-wpan
+ *
+ * Indication of the end of the MAC header (MHR) of the frame being received.
+ * Not part of the standard PD SAP.
+ *
+ * @param p the packet being received
+ * @param macHdr the MAC header of the packet
+ * @param remaining the remaining duration of the frame
+ * @return true to go on receiving the frame, false to drop it
+ */
+typedef Callback<bool, Ptr<const Packet>, const LrWpanMacHeader&, Time> PdHeaderIndicationCallback;
+
 /**
  * @ingroup lr-wpan
  *
@@ -253,6 +270,43 @@ typedef Callback<void, PhyEnumeration> PlmeSetTRXStateConfirmCallback;
  */
 typedef Callback<void, PhyEnumeration, PhyPibAttributeIdentifier> PlmeSetAttributeConfirmCallback;
 
+/**
+ * @ingroup lr-wpan
+ *
+ * Callback called when a transceiver leaves TRX_OFF, before the new state is entered.
+ *
+ * @param phy the PHY waking up
+ */
+typedef Callback<void, Ptr<LrWpanPhy>> PhyWakeCallback;
+
+/**
+ * @ingroup lr-wpan
+ *
+ * Cumulative time spent by the transceiver in each TRX state.
+ */
+struct PhyDutyCycleCounters
+{
+    Time trxOff; //!< Time in TRX_OFF
+    Time rxOn;   //!< Time in RX_ON (idle listening, CCA, ED)
+    Time busyRx; //!< Time in BUSY_RX (frame reception)
+    Time txOn;   //!< Time in TX_ON (idle, ready to transmit)
+    Time busyTx; //!< Time in BUSY_TX (frame transmission)
+
+    /**
+     * Get the total time covered by the counters.
+     *
+     * @return the sum of all the counters
+     */
+    Time GetTotal() const;
+
+    /**
+     * Get the fraction of time the transceiver was not in TRX_OFF.
+     *
+     * @return the wake ratio, or 0 if no time was accumulated yet
+     */
+    double GetWakeRatio() const;
+};
+
 /**
  * @ingroup lr-wpan
  *
@@ -305,6 +359,13 @@ class LrWpanPhy : public SpectrumPhy
      */
     void SetTxPowerSpectralDensity(Ptr<SpectrumValue> txPsd);
 
+    /**
+     * Get the Power Spectral Density of the transmissions.
+     *
+     * @return the transmit PSD
+     */
+    Ptr<SpectrumValue> GetTxPowerSpectralDensity() const;
+
     /**
      * Set the noise power spectral density.
      *
@@ -364,6 +425,58 @@ class LrWpanPhy : public SpectrumPhy
      */
     void PdDataRequest(const uint32_t psduLength, Ptr<Packet> p);
 
+    /**
+     * Wake up the transceiver, transmit a frame and switch to RX_ON at the end
+     * of the transmission, without the intermediate PLME-SET-TRX-STATE
+     * request/confirm round trips. The trxState trace shows the same
+     * TRX_OFF -> TX_ON -> BUSY_TX -> RX_ON sequence as the separate primitives.
+     *
+     * PD-DATA.confirm is delivered as for PdDataRequest. RX_ON is entered right
+     * after it unless the MAC requested a state change from the confirm, in which
+     * case a PLME-SET-TRX-STATE.confirm (SUCCESS) follows as usual.
+     *
+     * @param psduLength number of bytes in the PSDU
+     * @param p the packet to be transmitted
+     * @return false (and nothing is done) if the transceiver is neither in
+     *         TRX_OFF nor in TX_ON
+     */
+    bool PdDataRequestThenRxOn(const uint32_t psduLength, Ptr<Packet> p);
+
+    /**
+     * Do not put the next transmitted frame on the channel. The transceiver goes
+     * through the same states and fires the same traces and confirms as for a real
+     * transmission, but no receiver sees the signal.
+     */
+    void SuppressNextTx();
+
+    /**
+     * Keep the next transmitted frame off the channel until a receiver wakes up.
+     * The transceiver goes through the same states and fires the same traces and
+     * confirms as for a real transmission. The receivers it reaches are taken from
+     * the LrWpanSpectrumChannel (see LrWpanSpectrumChannel::GetDeferrableTargets());
+     * DeliverDeferredTx() hands the signal to one of them, from the time of the call
+     * to the end the frame would have reached without the deferral.
+     *
+     * @return false (and nothing is deferred) if the channel cannot tell the receivers
+     *         of the transmission in advance
+     */
+    bool DeferNextTx();
+
+    /**
+     * Deliver the deferred transmission to one of its receivers, at its arrival time
+     * or, if the arrival has passed, what is left of it. Every receiver gets it at
+     * most once; nothing is done once the frame left the air.
+     *
+     * @param rxPhy the receiver
+     */
+    void DeliverDeferredTx(Ptr<SpectrumPhy> rxPhy);
+
+    /**
+     * @return true if the deferred transmission would still be on the air at one of
+     *         its receivers
+     */
+    bool IsDeferredTxOnAir() const;
+
     /**
      * IEEE 802.15.4-2006 section 6.2.2.1
      * PLME-CCA.request
@@ -416,6 +529,16 @@ class LrWpanPhy : public SpectrumPhy
      */
     void SetPdDataIndicationCallback(PdDataIndicationCallback c);
 
+    /**
+     * set the callback for the end of the MAC header of a received frame.
+     * When the callback returns false, the frame is dropped and the
+     * transceiver goes back to RX_ON for the rest of the frame, which only
+     * counts as interference. Without a callback, frames are not parsed
+     * during the reception.
+     * @param c the callback
+     */
+    void SetPdHeaderIndicationCallback(PdHeaderIndicationCallback c);
+
     /**
      * set the callback for the end of a TX, as part of the
      * interconnections between the PHY and the MAC. The callback
@@ -464,6 +587,13 @@ class LrWpanPhy : public SpectrumPhy
      */
     void SetPlmeSetAttributeConfirmCallback(PlmeSetAttributeConfirmCallback c);
 
+    /**
+     * set the callback called when the transceiver leaves TRX_OFF, before the new
+     * state is entered and before its traces are fired.
+     * @param c the callback
+     */
+    void SetWakeCallback(PhyWakeCallback c);
+
     /**
      * Get The current channel page number in use in this PHY from the PIB attributes.
      *
@@ -529,6 +659,40 @@ class LrWpanPhy : public SpectrumPhy
      */
     double GetPhySymbolsPerOctet() const;
 
+    /**
+     * Get the SINR of a signal taking part in the current interference, computed
+     * from in-band powers on the current channel.
+     *
+     * @param params the signal (already added to the interference helper)
+     * @return the SINR (linear)
+     */
+    double GetSinr(Ptr<LrWpanSpectrumSignalParameters> params) const;
+
+    /**
+     * Get the SINR of a signal taking part in the current interference.
+     *
+     * @param signalPower the in-band power of the signal on the current channel [W]
+     * @return the SINR (linear)
+     */
+    double GetSinr(double signalPower) const;
+
+    /**
+     * Set the aggregate in-band power of the far-field signals the channel does not
+     * deliver (see LrWpanSpectrumChannel FarFieldRadius). It adds to the noise of the
+     * SINR from now on; the reception under way is checked up to now with the former
+     * value.
+     *
+     * @param power the mean far-field power on the current channel [W]
+     */
+    void SetFarFieldNoise(double power);
+
+    /**
+     * Get the aggregate in-band power of the far-field signals.
+     *
+     * @return the far-field power [W], 0 without far-field abstraction
+     */
+    double GetFarFieldNoise() const;
+
     /**
      * Get the current accumulated sum of signals in the transceiver including
      * signals considered as interference.
@@ -546,6 +710,98 @@ class LrWpanPhy : public SpectrumPhy
      */
     int64_t AssignStreams(int64_t stream);
 
+    /**
+     * Get the time spent in each transceiver state since the creation of the PHY
+     * (or the last ResetDutyCycleCounters()), including the current state up to now.
+     *
+     * @return the duty cycle counters
+     */
+    PhyDutyCycleCounters GetDutyCycleCounters() const;
+
+    /**
+     * Get the current transceiver state.
+     *
+     * @return the transceiver state
+     */
+    PhyEnumeration GetTrxState() const;
+
+    /**
+     * Check whether the transceiver is off and stays off until a new request:
+     * no state switch, transmission, CCA or ED is pending, and the time in TRX_OFF
+     * is not accounted as another state (see AccountTrxOffAs).
+     *
+     * @return true if the transceiver is quiescent in TRX_OFF
+     */
+    bool IsQuiescent() const;
+
+    /**
+     * Account the time spent in TRX_OFF from now on as spent in another state, up to a
+     * given time. The state and its traces are those of TRX_OFF; only the duty cycle
+     * counters (and the energy drawn from them) see the other state. Leaving TRX_OFF
+     * ends the accounting.
+     *
+     * @param state the state the time is accounted for
+     * @param until the end of the accounting
+     */
+    void AccountTrxOffAs(PhyEnumeration state, Time until);
+
+    /**
+     * Enter the state set by AccountTrxOffAs(), without a PLME-SET-TRX-STATE.confirm,
+     * as if the transceiver had been in it since the accounting started.
+     */
+    void EnterAccountedState();
+
+    /**
+     * @return true if a sink is connected to the TrxState trace
+     */
+    bool IsTrxStateTraced() const;
+
+    /**
+     * @return true if a sink is connected to the PhyRxDrop trace
+     */
+    bool IsRxDropTraced() const;
+
+    /**
+     * Restart the duty cycle accounting from the current time.
+     */
+    void ResetDutyCycleCounters();
+
+    /**
+     * Get the fraction of time the transceiver was not in TRX_OFF.
+     *
+     * @return the wake ratio
+     */
+    double GetWakeRatio() const;
+
+    /**
+     * Set the interval of the DutyCycleSnapshot trace (zero disables it).
+     *
+     * @param interval the snapshot interval
+     */
+    void SetDutyCycleSnapshotInterval(Time interval);
+
+    /**
+     * Get the interval of the DutyCycleSnapshot trace.
+     *
+     * @return the snapshot interval
+     */
+    Time GetDutyCycleSnapshotInterval() const;
+
+    /**
+     * TracedCallback signature for duty cycle snapshots.
+     *
+     * @param [in] counters The cumulative time spent in each state.
+     */
+    typedef void (*DutyCycleTracedCallback)(const PhyDutyCycleCounters& counters);
+
+    /**
+     * TracedCallback signature for frames dropped after their MAC header.
+     *
+     * @param [in] packet The frame.
+     * @param [in] remaining The airtime of the frame left when it was dropped.
+     */
+    typedef void (*HeaderDropTracedCallback)(Ptr<const Packet> packet, Time remaining);
+
     /**
      * TracedCallback signature for Trx state change events.
      *
@@ -578,6 +834,26 @@ class LrWpanPhy : public SpectrumPhy
      */
     void ChangeTrxState(PhyEnumeration newState);
 
+    /**
+     * Add the time since the last state change to the counter of the current state.
+     */
+    void AccumulateDutyCycle();
+
+    /**
+     * Add an interval spent in the current state to duty cycle counters, the part of
+     * it covered by AccountTrxOffAs() going to the accounted state.
+     *
+     * @param counters the counters to update
+     * @param from the start of the interval
+     * @param to the end of the interval
+     */
+    void AddDutyCycleInterval(PhyDutyCycleCounters& counters, Time from, Time to) const;
+
+    /**
+     * Fire the DutyCycleSnapshot trace and schedule the next snapshot.
+     */
+    void DutyCycleSnapshot();
+
     /**
      * Get the currently configured PHY option.
      * See IEEE 802.15.4-2006, section 6.1.2, Table 2.
@@ -611,6 +887,19 @@ class LrWpanPhy : public SpectrumPhy
      */
     void EndRx(Ptr<SpectrumSignalParameters> params);
 
+    /**
+     * Report the MAC header of the frame currently received to the MAC and drop
+     * the frame if the MAC rejects it. A dropped frame fires PhyRxEnd,
+     * PhyRxHeaderDrop and PhyRxDrop at once, as EndRx() does for a lost frame.
+     *
+     * @param params signal parameters of the packet
+     * @param macHdr the MAC header of the packet
+     * @param remaining the remaining duration of the frame
+     */
+    void HeaderRx(Ptr<LrWpanSpectrumSignalParameters> params,
+                  LrWpanMacHeader macHdr,
+                  Time remaining);
+
     /**
      * Cancel an ongoing ED procedure. This is called when the transceiver is
      * switched off or set to TX mode. This calls the appropriate confirm callback
@@ -717,6 +1006,8 @@ class LrWpanPhy : public SpectrumPhy
      * of a signal is traced. The received completed signal might represent
      * a complete packet or a packet that is later on dropped because of interference,
      * cancellation or post-rx corruption. Second quantity is the received SINR (LQI).
+     * A frame the MAC rejects after its header ends its reception at the header
+     * indication (see m_phyRxHeaderDropTrace).
      *
      * @see class CallBackTraceSource
      */
@@ -731,6 +1022,15 @@ class LrWpanPhy : public SpectrumPhy
      */
     TracedCallback<Ptr<const Packet>> m_phyRxDropTrace;
 
+    /**
+     * The trace source fired when the MAC rejects a frame after its header, just
+     * before the PhyRxDrop of that frame, with the airtime of the frame left. It
+     * tells this drop from those of m_phyRxDropTrace at the end of the frame.
+     *
+     * @see class CallBackTraceSource
+     */
+    TracedCallback<Ptr<const Packet>, Time> m_phyRxHeaderDropTrace;
+
     /**
      * The trace source fired when the phy layer changes the transceiver state.
      *
@@ -742,6 +1042,14 @@ class LrWpanPhy : public SpectrumPhy
     // NS_DEPRECATED() - tag for future removal
     TracedCallback<Time, PhyEnumeration, PhyEnumeration> m_trxStateLogger;
 
+    /**
+     * The trace source fired periodically with the cumulative time spent in
+     * each transceiver state (see DutyCycleSnapshotInterval).
+     *
+     * @see class CallBackTraceSource
+     */
+    TracedCallback<const PhyDutyCycleCounters&> m_dutyCycleSnapshotTrace;
+
     /**
      * Calculates the nominal transmit power of the device in decibels relative to 1 mW
      * according to the representation of the PIB attribute phyTransmitPower.
@@ -796,6 +1104,18 @@ class LrWpanPhy : public SpectrumPhy
      */
     Ptr<AntennaModel> m_antenna;
 
+    /**
+     * Recompute m_noiseInBandPower after a change of the noise PSD or the channel.
+     */
+    void UpdateNoiseInBandPower();
+
+    /**
+     * Move the PSDs and the interference helper to the current channel. Unlike
+     * SetRxSensitivity(), the signals in the air are kept: frequent retuning (e.g. a
+     * multi-channel RIT MAC) neither reallocates the helper nor loses the interference.
+     */
+    void RetuneChannel();
+
     /**
      * The transmit power spectral density.
      */
@@ -806,6 +1126,16 @@ class LrWpanPhy : public SpectrumPhy
      */
     Ptr<const SpectrumValue> m_noise;
 
+    /**
+     * The in-band power of m_noise on the current channel [W].
+     */
+    double m_noiseInBandPower;
+
+    /**
+     * The in-band power of the far-field signals set by the channel [W].
+     */
+    double m_farFieldNoise;
+
     /**
      * The error model describing the bit and packet error rates.
      */
@@ -828,6 +1158,26 @@ class LrWpanPhy : public SpectrumPhy
      */
     PhyEnumeration m_trxStatePending;
 
+    /**
+     * The cumulative time spent in each transceiver state, up to m_dutyCycleLastChange.
+     */
+    PhyDutyCycleCounters m_dutyCycle;
+
+    /**
+     * The time of the last transceiver state change (or counter reset).
+     */
+    Time m_dutyCycleLastChange;
+
+    /**
+     * The interval of the DutyCycleSnapshot trace (zero = disabled).
+     */
+    Time m_dutyCycleSnapshotInterval;
+
+    /**
+     * Scheduler event of the next duty cycle snapshot.
+     */
+    EventId m_dutyCycleSnapshotEvent;
+
     // Callbacks
     /**
      * This callback is used to notify incoming packets to the MAC layer.
@@ -835,6 +1185,12 @@ class LrWpanPhy : public SpectrumPhy
      */
     PdDataIndicationCallback m_pdDataIndicationCallback;
 
+    /**
+     * This callback is used to report the MAC header of an incoming packet to
+     * the MAC layer before the end of the reception.
+     */
+    PdHeaderIndicationCallback m_pdHeaderIndicationCallback;
+
     /**
      * This callback is used to report packet transmission status to the MAC layer.
      * See IEEE 802.15.4-2006, section 6.2.1.2.
@@ -886,6 +1242,12 @@ class LrWpanPhy : public SpectrumPhy
      */
     double m_ccaPeakPower;
 
+    /**
+     * Indicates that the running CCA started on an empty channel and no signal
+     * arrived since, so its result is IDLE without evaluating the CCA mode.
+     */
+    bool m_ccaIdle;
+
     /**
      * The receiver sensitivity.
      */
@@ -896,6 +1258,63 @@ class LrWpanPhy : public SpectrumPhy
      */
     bool m_isRxCanceled;
 
+    /**
+     * Indicates if the transceiver switches to RX_ON at the end of the current
+     * transmission (see PdDataRequestThenRxOn).
+     */
+    bool m_rxOnAfterTx;
+
+    /**
+     * Indicates if the next transmitted frame is kept off the channel (see
+     * SuppressNextTx).
+     */
+    bool m_suppressNextTx;
+
+    /**
+     * Indicates if the next transmitted frame is deferred (see DeferNextTx).
+     */
+    bool m_deferNextTx;
+
+    /**
+     * The deferred transmission, until it left the air.
+     */
+    Ptr<SpectrumSignalParameters> m_deferredTx;
+
+    /**
+     * The receivers the deferred transmission was not delivered to yet.
+     */
+    std::vector<Ptr<SpectrumPhy>> m_deferredTxTargets;
+
+    /**
+     * The start of the deferred transmission.
+     */
+    Time m_deferredTxStart;
+
+    /**
+     * The time the deferred transmission leaves the air at its farthest receiver.
+     */
+    Time m_deferredTxEnd;
+
+    /**
+     * The largest propagation delay to the receivers of the deferred transmission.
+     */
+    Time m_deferredTxMaxDelay;
+
+    /**
+     * The state the time in TRX_OFF is accounted for (see AccountTrxOffAs).
+     */
+    PhyEnumeration m_accountedState;
+
+    /**
+     * The end of the accounting of TRX_OFF as m_accountedState.
+     */
+    Time m_accountedUntil;
+
+    /**
+     * The callback called when the transceiver leaves TRX_OFF.
+     */
+    PhyWakeCallback m_wakeCallback;
+
     /**
      * The accumulated signals currently received by the transceiver, including
      * the signal of a possibly received packet, as well as all signals
@@ -916,6 +1335,24 @@ class LrWpanPhy : public SpectrumPhy
      */
     std::pair<Ptr<LrWpanSpectrumSignalParameters>, bool> m_currentRxPacket;
 
+    /**
+     * Scalars of the frame currently received, set once in StartRx() so that every
+     * interference chunk is evaluated without touching the packet or its tags.
+     */
+    struct RxState
+    {
+        Ptr<Packet> packet;    //!< The frame of m_currentRxPacket
+        double signalPower{0}; //!< In-band power of the frame on the current channel [W]
+        double bitsPerMs{0};   //!< Data rate of the frame [bit/ms]
+        uint8_t lqi{255};      //!< LQI so far: success rate of the chunks scaled to 0-255
+    };
+
+    /**
+     * The state of the reception in progress, written to the LrWpanLqiTag of the frame
+     * once in EndRx().
+     */
+    RxState m_rxState;
+
     Ptr<LrWpanSpectrumSignalParameters> m_isRxCanceledParams;
 
     /**
@@ -948,6 +1385,11 @@ class LrWpanPhy : public SpectrumPhy
 
     EventId m_EndRx;
 
+    /**
+     * Scheduler event of the end of the MAC header of the frame being received.
+     */
+    EventId m_headerRx;
+
     /**
      * Uniform random variable stream.
      */
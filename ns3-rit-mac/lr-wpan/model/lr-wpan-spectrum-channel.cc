@@ -0,0 +1,1640 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+#include "lr-wpan-spectrum-channel.h"
+
+#include "lr-wpan-phy.h"
+
+#include "lr-wpan-spectrum-signal-parameters.h"
+#include "lr-wpan-spectrum-value-helper.h"
+
+#include "ns3/angles.h"
+#include "ns3/antenna-model.h"
+#include "ns3/boolean.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/mobility-model.h"
+#include "ns3/net-device.h"
+#include "ns3/node.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/simulator.h"
+#include "ns3/spectrum-phy.h"
+#include "ns3/spectrum-propagation-loss-model.h"
+#include "ns3/spectrum-transmit-filter.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/uinteger.h"
+#include "ns3/vector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <thread>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_LOG_COMPONENT_DEFINE("LrWpanSpectrumChannel");
+NS_OBJECT_ENSURE_REGISTERED(LrWpanSpectrumChannel);
+
+/**
+ * Persistent threads running the iterations of a loop together with the simulator
+ * thread.
+ */
+class LrWpanSpectrumChannel::WorkerPool
+{
+  public:
+    /**
+     * @param nThreads the number of threads to start
+     */
+    explicit WorkerPool(uint32_t nThreads);
+    ~WorkerPool();
+
+    /**
+     * Run fn(i) for every i in [0, n) and return when all the iterations are done.
+     * fn must not touch any ns-3 object shared with other iterations.
+     *
+     * @param n the number of iterations
+     * @param fn the loop body
+     */
+    void ParallelFor(std::size_t n, const std::function<void(std::size_t)>& fn);
+
+    /**
+     * @return the number of threads
+     */
+    uint32_t GetNThreads() const;
+
+  private:
+    /** Thread main loop. */
+    void Run();
+
+    /** Run iterations until none is left. */
+    void Work();
+
+    static constexpr std::size_t CHUNK = 16; //!< Iterations taken at once by a thread
+
+    std::vector<std::thread> m_threads;            //!< Worker threads
+    std::mutex m_mutex;                            //!< Protects the fields below
+    std::condition_variable m_startCv;             //!< Signals a new loop or the stop
+    std::condition_variable m_doneCv;              //!< Signals the end of a loop
+    const std::function<void(std::size_t)>* m_fn;  //!< Current loop body
+    std::size_t m_n;                               //!< Current number of iterations
+    std::atomic<std::size_t> m_next;               //!< Next iteration to run
+    uint64_t m_generation;                         //!< Loop counter
+    uint32_t m_busy;                               //!< Threads still in the current loop
+    bool m_stop;                                   //!< Stop the threads
+};
+
+LrWpanSpectrumChannel::WorkerPool::WorkerPool(uint32_t nThreads)
+    : m_fn(nullptr),
+      m_n(0),
+      m_next(0),
+      m_generation(0),
+      m_busy(0),
+      m_stop(false)
+{
+    for (uint32_t i = 0; i < nThreads; i++)
+    {
+        m_threads.emplace_back(&WorkerPool::Run, this);
+    }
+}
+
+LrWpanSpectrumChannel::WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_startCv.notify_all();
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+uint32_t
+LrWpanSpectrumChannel::WorkerPool::GetNThreads() const
+{
+    return m_threads.size();
+}
+
+void
+LrWpanSpectrumChannel::WorkerPool::Work()
+{
+    for (;;)
+    {
+        std::size_t begin = m_next.fetch_add(CHUNK);
+        if (begin >= m_n)
+        {
+            return;
+        }
+        std::size_t end = std::min(begin + CHUNK, m_n);
+        for (std::size_t i = begin; i < end; i++)
+        {
+            (*m_fn)(i);
+        }
+    }
+}
+
+void
+LrWpanSpectrumChannel::WorkerPool::Run()
+{
+    uint64_t seen = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_startCv.wait(lock, [&]() { return m_stop || m_generation != seen; });
+            if (m_stop)
+            {
+                return;
+            }
+            seen = m_generation;
+        }
+        Work();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_busy == 0)
+            {
+                m_doneCv.notify_one();
+            }
+        }
+    }
+}
+
+void
+LrWpanSpectrumChannel::WorkerPool::ParallelFor(std::size_t n,
+                                               const std::function<void(std::size_t)>& fn)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_fn = &fn;
+        m_n = n;
+        m_next = 0;
+        m_busy = m_threads.size();
+        m_generation++;
+    }
+    m_startCv.notify_all();
+    Work();
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_doneCv.wait(lock, [&]() { return m_busy == 0; });
+    m_fn = nullptr;
+}
+
+TypeId
+LrWpanSpectrumChannel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::lrwpan::LrWpanSpectrumChannel")
+            .AddDeprecatedName("ns3::LrWpanSpectrumChannel")
+            .SetParent<SpectrumChannel>()
+            .SetGroupName("LrWpan")
+            .AddConstructor<LrWpanSpectrumChannel>()
+            .AddAttribute("RangeCulling",
+                          "Only deliver a transmission to the receivers whose received power "
+                          "can reach RxSensitivity - InterferenceMargin.",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&LrWpanSpectrumChannel::m_rangeCulling),
+                          MakeBooleanChecker())
+            .AddAttribute("ChannelFiltering",
+                          "Do not deliver a LrWpanPhy transmission to the LrWpanPhy tuned to "
+                          "another channel.",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&LrWpanSpectrumChannel::m_channelFiltering),
+                          MakeBooleanChecker())
+            .AddAttribute("RxSensitivity",
+                          "The receiver sensitivity used for the culling (dBm).",
+                          DoubleValue(-106.58),
+                          MakeDoubleAccessor(&LrWpanSpectrumChannel::m_rxSensitivity),
+                          MakeDoubleChecker<double>())
+            .AddAttribute("InterferenceMargin",
+                          "Margin below the sensitivity (dB): weaker signals are neither "
+                          "received nor counted as interference.",
+                          DoubleValue(10.0),
+                          MakeDoubleAccessor(&LrWpanSpectrumChannel::m_interferenceMargin),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("PathLossCache",
+                          "Cache the path loss and delay between the PHYs using "
+                          "ConstantPositionMobilityModel.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&LrWpanSpectrumChannel::m_pathLossCacheEnabled),
+                          MakeBooleanChecker())
+            .AddAttribute("MaxPathLossCacheEntries",
+                          "The maximum number of (tx PHY, rx PHY) pairs in the path loss cache.",
+                          UintegerValue(1000000),
+                          MakeUintegerAccessor(&LrWpanSpectrumChannel::m_maxPathLossCacheEntries),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("Narrowband",
+                          "Share the transmitted PSD between the receivers of a LrWpan signal "
+                          "and only carry the path gain as a scalar.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&LrWpanSpectrumChannel::m_narrowband),
+                          MakeBooleanChecker())
+            .AddAttribute("WorkerThreads",
+                          "The number of threads computing the propagation losses of a "
+                          "transmission besides the simulator thread (0 = sequential).",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&LrWpanSpectrumChannel::SetWorkerThreads,
+                                               &LrWpanSpectrumChannel::GetWorkerThreads),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("ParallelMinReceivers",
+                          "The number of receivers from which the worker threads are used.",
+                          UintegerValue(256),
+                          MakeUintegerAccessor(&LrWpanSpectrumChannel::m_parallelMinReceivers),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("MobilityUpdateInterval",
+                          "Period of the neighbour set updates of the PHYs whose mobility model "
+                          "moves between two course changes (0 = on course changes only).",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&LrWpanSpectrumChannel::m_mobilityUpdateInterval),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("NeighbourGridCellSize",
+                          "Side of the grid cells of the PHYs using ConstantPositionMobilityModel "
+                          "(m), used with a single LogDistancePropagationLossModel (0 = no grid).",
+                          DoubleValue(0.0),
+                          MakeDoubleAccessor(&LrWpanSpectrumChannel::m_gridCellSize),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("FarFieldRadius",
+                          "Distance (m) beyond which a listed LrWpanPhy gets the signals as an "
+                          "aggregate noise instead of receiving them (0 = deliver them all).",
+                          DoubleValue(0.0),
+                          MakeDoubleAccessor(&LrWpanSpectrumChannel::SetFarFieldRadius,
+                                             &LrWpanSpectrumChannel::GetFarFieldRadius),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("FarFieldWindow",
+                          "Window over which the far-field energy of a receiver is averaged "
+                          "into the noise of the next window.",
+                          TimeValue(Seconds(1)),
+                          MakeTimeAccessor(&LrWpanSpectrumChannel::m_farFieldWindow),
+                          MakeTimeChecker(MicroSeconds(1)));
+    return tid;
+}
+
+LrWpanSpectrumChannel::LrWpanSpectrumChannel()
+    : m_rangeCulling(true),
+      m_channelFiltering(true),
+      m_rxSensitivity(-106.58),
+      m_interferenceMargin(10.0),
+      m_pathLossCacheEnabled(false),
+      m_maxPathLossCacheEntries(1000000),
+      m_narrowband(false),
+      m_parallelMinReceivers(256),
+      m_nForeignTransmissions(0),
+      m_mobilityUpdateInterval(Seconds(0)),
+      m_nNeighbourUpdates(0),
+      m_nReceiverListChanges(0),
+      m_gridCellSize(0.0),
+      m_gridValid(false),
+      m_maxListPowerDbm(-std::numeric_limits<double>::infinity()),
+      m_farFieldRadius(0.0),
+      m_farFieldWindow(Seconds(1)),
+      m_nFarFieldSignals(0),
+      m_listingIndexChanges(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+LrWpanSpectrumChannel::~LrWpanSpectrumChannel()
+{
+}
+
+void
+LrWpanSpectrumChannel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    for (const auto& mobility : m_trackedMobility)
+    {
+        mobility->TraceDisconnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&LrWpanSpectrumChannel::CourseChanged, this));
+    }
+    m_trackedMobility.clear();
+    m_mobilityUpdateEvent.Cancel();
+    m_farFieldEvent.Cancel();
+    m_farFieldEnergy.clear();
+    m_receiverLists.clear();
+    m_listedBy.clear();
+    m_listingIndex.clear();
+    m_listChangeCallback = MakeNullCallback<void>();
+    m_grid.clear();
+    m_gridOutside.clear();
+    m_pathLossCache.clear();
+    m_workers.reset();
+    m_regions.clear();
+    m_remoteTxCallback = MakeNullCallback<void, uint32_t, Ptr<SpectrumSignalParameters>>();
+    m_localRegion.reset();
+    m_phyList.clear();
+    m_phySet.clear();
+    m_phyIndex.clear();
+    m_spectrumModel = nullptr;
+    SpectrumChannel::DoDispose();
+}
+
+void
+LrWpanSpectrumChannel::AddRx(Ptr<SpectrumPhy> phy)
+{
+    NS_LOG_FUNCTION(this << phy);
+
+    // remove a previous entry of this phy if it exists
+    RemoveRx(phy);
+    m_phyList.push_back(phy);
+    m_phySet.insert(PeekPointer(phy));
+    m_phyIndex[PeekPointer(phy)] = m_phyList.size() - 1;
+    m_gridValid = false;
+    InvalidateReceiverLists();
+}
+
+void
+LrWpanSpectrumChannel::RemoveRx(Ptr<SpectrumPhy> phy)
+{
+    NS_LOG_FUNCTION(this << phy);
+    // the set spares the search of m_phyList when adding new receivers
+    if (m_phySet.erase(PeekPointer(phy)) == 0)
+    {
+        return;
+    }
+    auto it = std::find(m_phyList.begin(), m_phyList.end(), phy);
+    if (it != m_phyList.end())
+    {
+        m_phyList.erase(it);
+        m_phyIndex.clear();
+        for (std::size_t i = 0; i < m_phyList.size(); i++)
+        {
+            m_phyIndex[PeekPointer(m_phyList[i])] = i;
+        }
+        m_gridValid = false;
+        InvalidateReceiverLists();
+        ClearPathLossCache();
+    }
+    m_farFieldEnergy.erase(PeekPointer(phy));
+}
+
+void
+LrWpanSpectrumChannel::ReserveReceivers(std::size_t n)
+{
+    NS_LOG_FUNCTION(this << n);
+    m_phyList.reserve(n);
+    m_phySet.reserve(n);
+}
+
+void
+LrWpanSpectrumChannel::InvalidateReceiverLists()
+{
+    NS_LOG_FUNCTION(this);
+    m_receiverLists.clear();
+    m_listedBy.clear();
+    m_nReceiverListChanges++;
+    if (!m_listChangeCallback.IsNull())
+    {
+        m_listChangeCallback();
+    }
+}
+
+std::size_t
+LrWpanSpectrumChannel::GetNListedReceivers(Ptr<const SpectrumPhy> txPhy) const
+{
+    auto it = m_receiverLists.find(txPhy);
+    return it != m_receiverLists.end() ? it->second.receivers.size() : 0;
+}
+
+bool
+LrWpanSpectrumChannel::GetListedReceivers(Ptr<const SpectrumPhy> txPhy,
+                                          std::vector<Ptr<SpectrumPhy>>& receivers) const
+{
+    receivers.clear();
+    auto it = m_receiverLists.find(txPhy);
+    if (it == m_receiverLists.end())
+    {
+        return false;
+    }
+    for (const auto& receiver : it->second.receivers)
+    {
+        receivers.push_back(receiver.phy);
+    }
+    return true;
+}
+
+uint64_t
+LrWpanSpectrumChannel::GetNNeighbourUpdates() const
+{
+    return m_nNeighbourUpdates;
+}
+
+uint64_t
+LrWpanSpectrumChannel::GetNReceiverListChanges() const
+{
+    return m_nReceiverListChanges;
+}
+
+void
+LrWpanSpectrumChannel::SetReceiverListChangeCallback(Callback<void> cb)
+{
+    NS_LOG_FUNCTION(this);
+    m_listChangeCallback = cb;
+}
+
+bool
+LrWpanSpectrumChannel::GetListingTransmitters(Ptr<const SpectrumPhy> rxPhy,
+                                              std::vector<Ptr<const SpectrumPhy>>& transmitters)
+{
+    transmitters.clear();
+    if (!m_rangeCulling || !m_remoteTxCallback.IsNull() || m_localRegion)
+    {
+        return false;
+    }
+    if (m_listingIndexChanges != m_nReceiverListChanges || m_listingIndex.empty())
+    {
+        m_listingIndex.clear();
+        for (const auto& [txPhy, list] : m_receiverLists)
+        {
+            for (const auto& receiver : list.receivers)
+            {
+                m_listingIndex[PeekPointer(receiver.phy)].push_back(txPhy);
+            }
+        }
+        m_listingIndexChanges = m_nReceiverListChanges;
+    }
+    auto it = m_listingIndex.find(PeekPointer(rxPhy));
+    if (it != m_listingIndex.end())
+    {
+        transmitters = it->second;
+    }
+    return true;
+}
+
+bool
+LrWpanSpectrumChannel::GetDeferrableTargets(Ptr<const SpectrumPhy> txPhy,
+                                            Ptr<const SpectrumValue> txPsd,
+                                            uint8_t txChannel,
+                                            std::vector<Ptr<SpectrumPhy>>& targets,
+                                            Time& maxDelay)
+{
+    targets.clear();
+    maxDelay = Time();
+
+    // What StartTx() does must not depend on the time of the delivery: no trace sink
+    // nor region sees the transmission, and the receivers get it from the list alone.
+    const bool fixedDelay =
+        !m_propagationDelay || DynamicCast<ConstantSpeedPropagationDelayModel>(m_propagationDelay);
+    if (!m_rangeCulling || m_farFieldRadius > 0 || m_filter || m_spectrumPropagationLoss ||
+        !m_remoteTxCallback.IsNull() || m_localRegion || !m_spectrumModel ||
+        !m_txSigParamsTrace.IsEmpty() || !m_gainTrace.IsEmpty() || !m_pathLossTrace.IsEmpty() ||
+        !IsDeterministicLoss() || !fixedDelay)
+    {
+        return false;
+    }
+
+    // A list built for a weaker transmission would be rebuilt by StartTx().
+    const double txPowerDbm = 10.0 * std::log10(Integral(*txPsd)) + 30.0;
+    auto it = m_receiverLists.find(txPhy);
+    if (it == m_receiverLists.end() || it->second.txPowerDbm < txPowerDbm)
+    {
+        return false;
+    }
+    Ptr<MobilityModel> senderMobility = txPhy->GetMobility();
+    if (!DynamicCast<ConstantPositionMobilityModel>(senderMobility))
+    {
+        return false;
+    }
+
+    const int32_t channel = m_channelFiltering ? txChannel : -1;
+    const double floorDbm = m_rxSensitivity - m_interferenceMargin;
+    for (const auto& receiver : it->second.receivers)
+    {
+        // the receivers GetTargets() would return
+        if (txPowerDbm - receiver.lossDb < floorDbm ||
+            IsOnOtherChannel(channel, receiver.lrWpanPhy))
+        {
+            continue;
+        }
+        Ptr<MobilityModel> receiverMobility = receiver.phy->GetMobility();
+        if (!DynamicCast<ConstantPositionMobilityModel>(receiverMobility))
+        {
+            targets.clear();
+            return false;
+        }
+        if (m_propagationDelay)
+        {
+            maxDelay =
+                std::max(maxDelay, m_propagationDelay->GetDelay(senderMobility, receiverMobility));
+        }
+        targets.push_back(receiver.phy);
+    }
+    return true;
+}
+
+void
+LrWpanSpectrumChannel::DeliverDeferredTx(Ptr<SpectrumSignalParameters> txParams,
+                                         Time txStart,
+                                         Ptr<SpectrumPhy> rxPhy)
+{
+    NS_LOG_FUNCTION(this << txParams->txPhy << txStart << rxPhy);
+
+    Ptr<LrWpanSpectrumSignalParameters> narrowbandParams;
+    if (m_narrowband && !m_spectrumPropagationLoss)
+    {
+        narrowbandParams = DynamicCast<LrWpanSpectrumSignalParameters>(txParams);
+    }
+    Time delay;
+    Ptr<SpectrumSignalParameters> rxParams = GetRxParams(txParams,
+                                                         narrowbandParams,
+                                                         txParams->txPhy->GetMobility(),
+                                                         rxPhy,
+                                                         nullptr,
+                                                         delay);
+    if (!rxParams)
+    {
+        return;
+    }
+
+    const Time now = Simulator::Now();
+    const Time arrival = txStart + delay;
+    if (arrival > now)
+    {
+        ScheduleStartRx(rxParams, rxPhy, arrival - now);
+        return;
+    }
+    // The receiver wakes up during the frame: it gets the rest of it, ending as the
+    // frame would have.
+    const Time left = arrival + rxParams->duration - now;
+    if (left.IsStrictlyPositive())
+    {
+        rxParams->duration = left;
+        rxPhy->StartRx(rxParams);
+    }
+}
+
+bool
+LrWpanSpectrumChannel::IsDeterministicLoss() const
+{
+    for (Ptr<PropagationLossModel> model = m_propagationLoss; model; model = model->GetNext())
+    {
+        if (!DynamicCast<LogDistancePropagationLossModel>(model) &&
+            !DynamicCast<ThreeLogDistancePropagationLossModel>(model) &&
+            !DynamicCast<FriisPropagationLossModel>(model) &&
+            !DynamicCast<TwoRayGroundPropagationLossModel>(model) &&
+            !DynamicCast<FixedRssLossModel>(model) &&
+            !DynamicCast<RangePropagationLossModel>(model) &&
+            !DynamicCast<MatrixPropagationLossModel>(model))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+LrWpanSpectrumChannel::ClearPathLossCache()
+{
+    NS_LOG_FUNCTION(this);
+    m_pathLossCache.clear();
+}
+
+std::size_t
+LrWpanSpectrumChannel::GetPathLossCacheSize() const
+{
+    return m_pathLossCache.size();
+}
+
+void
+LrWpanSpectrumChannel::SetWorkerThreads(uint32_t nThreads)
+{
+    NS_LOG_FUNCTION(this << nThreads);
+    m_workers.reset();
+    if (nThreads > 0)
+    {
+        m_workers = std::make_unique<WorkerPool>(nThreads);
+    }
+}
+
+uint32_t
+LrWpanSpectrumChannel::GetWorkerThreads() const
+{
+    return m_workers ? m_workers->GetNThreads() : 0;
+}
+
+void
+LrWpanSpectrumChannel::SetFarFieldRadius(double radius)
+{
+    NS_LOG_FUNCTION(this << radius);
+    m_farFieldRadius = radius;
+    InvalidateReceiverLists();
+}
+
+double
+LrWpanSpectrumChannel::GetFarFieldRadius() const
+{
+    return m_farFieldRadius;
+}
+
+uint64_t
+LrWpanSpectrumChannel::GetNFarFieldSignals() const
+{
+    return m_nFarFieldSignals;
+}
+
+void
+LrWpanSpectrumChannel::SetRegion(Ptr<const SpectrumPhy> phy, uint32_t region)
+{
+    NS_LOG_FUNCTION(this << phy << region);
+    m_regions[phy] = region;
+}
+
+uint32_t
+LrWpanSpectrumChannel::GetRegion(Ptr<const SpectrumPhy> phy) const
+{
+    auto it = m_regions.find(phy);
+    if (it != m_regions.end())
+    {
+        return it->second;
+    }
+    Ptr<NetDevice> netDevice = phy->GetDevice();
+    return netDevice && netDevice->GetNode() ? netDevice->GetNode()->GetSystemId() : 0;
+}
+
+void
+LrWpanSpectrumChannel::SetRemoteTxCallback(RemoteTxCallback cb)
+{
+    NS_LOG_FUNCTION(this);
+    m_remoteTxCallback = cb;
+}
+
+void
+LrWpanSpectrumChannel::SetLocalRegion(uint32_t region)
+{
+    NS_LOG_FUNCTION(this << region);
+    m_localRegion = region;
+}
+
+uint64_t
+LrWpanSpectrumChannel::GetNForeignTransmissions() const
+{
+    return m_nForeignTransmissions;
+}
+
+std::size_t
+LrWpanSpectrumChannel::PhyPairHash::operator()(const PhyPair& key) const
+{
+    std::size_t h1 = std::hash<const SpectrumPhy*>()(PeekPointer(key.first));
+    std::size_t h2 = std::hash<const SpectrumPhy*>()(PeekPointer(key.second));
+    return h1 ^ (h2 + 0x9e3779b97f4a7c15ULL + (h1 << 6) + (h1 >> 2));
+}
+
+void
+LrWpanSpectrumChannel::CourseChanged(Ptr<const MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << mobility);
+    const MobilityModel* moved = PeekPointer(mobility);
+    for (auto it = m_pathLossCache.begin(); it != m_pathLossCache.end();)
+    {
+        if (it->second.senderMobility == moved || it->second.receiverMobility == moved)
+        {
+            it = m_pathLossCache.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    UpdateNeighbours(mobility);
+    ScheduleMobilityUpdate(mobility);
+}
+
+void
+LrWpanSpectrumChannel::UpdateNeighbours(Ptr<const MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << mobility);
+    std::vector<Ptr<SpectrumPhy>> moved;
+    for (const auto& phy : m_phyList)
+    {
+        if (PeekPointer(phy->GetMobility()) == PeekPointer(mobility))
+        {
+            moved.push_back(phy);
+        }
+    }
+    if (moved.empty())
+    {
+        return;
+    }
+    m_nReceiverListChanges++;
+    const bool fixed = DynamicCast<const ConstantPositionMobilityModel>(mobility) != nullptr;
+    if (fixed)
+    {
+        m_gridValid = false;
+    }
+
+    // The lists that may change: every list, or with the grid, the lists of the
+    // transmitters listing a moved PHY and of those within range of its new position.
+    std::set<Ptr<const SpectrumPhy>> transmitters;
+    const double range = GetCullingRange(m_maxListPowerDbm);
+    if (fixed || std::isinf(range))
+    {
+        for (const auto& [txPhy, list] : m_receiverLists)
+        {
+            transmitters.insert(txPhy);
+        }
+    }
+    else
+    {
+        for (const auto& phy : moved)
+        {
+            auto it = m_listedBy.find(PeekPointer(phy));
+            if (it != m_listedBy.end())
+            {
+                transmitters.insert(it->second.begin(), it->second.end());
+                m_listedBy.erase(it);
+            }
+        }
+        std::vector<std::size_t> nearby;
+        GetNearbyPhys(mobility->GetPosition(), range, nearby);
+        for (std::size_t i : nearby)
+        {
+            if (m_receiverLists.count(m_phyList[i]))
+            {
+                transmitters.insert(m_phyList[i]);
+            }
+        }
+    }
+    // The moved PHYs get new lists at their next transmission.
+    for (const auto& phy : moved)
+    {
+        m_receiverLists.erase(phy);
+        transmitters.erase(phy);
+    }
+
+    const double floorDbm = m_rxSensitivity - m_interferenceMargin;
+    Ptr<MobilityModel> receiverMobility = moved.front()->GetMobility();
+    auto byIndex = [this](const Receiver& receiver, std::size_t index) {
+        return m_phyIndex.at(PeekPointer(receiver.phy)) < index;
+    };
+    for (const auto& txPhy : transmitters)
+    {
+        auto listIt = m_receiverLists.find(txPhy);
+        if (listIt == m_receiverLists.end())
+        {
+            continue;
+        }
+        ReceiverList& list = listIt->second;
+        Ptr<MobilityModel> senderMobility = txPhy->GetMobility();
+        Ptr<NetDevice> txNetDevice = txPhy->GetDevice();
+        for (const auto& rxPhy : moved)
+        {
+            m_nNeighbourUpdates++;
+            auto& receivers = list.receivers;
+            receivers.erase(std::remove_if(receivers.begin(),
+                                           receivers.end(),
+                                           [&rxPhy](const Receiver& receiver) {
+                                               return receiver.phy == rxPhy;
+                                           }),
+                            receivers.end());
+            Ptr<NetDevice> rxNetDevice = rxPhy->GetDevice();
+            if (rxNetDevice && txNetDevice &&
+                rxNetDevice->GetNode()->GetId() == txNetDevice->GetNode()->GetId())
+            {
+                continue;
+            }
+            double lossDb = -std::numeric_limits<double>::infinity();
+            if (senderMobility && receiverMobility)
+            {
+                lossDb =
+                    GetPathLoss(list.gains, senderMobility, rxPhy, receiverMobility).pathLossDb;
+            }
+            if (list.txPowerDbm - lossDb >= floorDbm)
+            {
+                // the receivers stay in the order of m_phyList
+                const std::size_t index = m_phyIndex.at(PeekPointer(rxPhy));
+                const LrWpanPhy* lrWpanPhy = PeekPointer(DynamicCast<LrWpanPhy>(rxPhy));
+                receivers.insert(
+                    std::lower_bound(receivers.begin(), receivers.end(), index, byIndex),
+                    {rxPhy,
+                     lossDb,
+                     lrWpanPhy,
+                     IsFarField(senderMobility, receiverMobility, lrWpanPhy)});
+                if (!fixed)
+                {
+                    m_listedBy[PeekPointer(rxPhy)].insert(txPhy);
+                }
+            }
+        }
+    }
+    if (!m_listChangeCallback.IsNull())
+    {
+        m_listChangeCallback();
+    }
+}
+
+void
+LrWpanSpectrumChannel::UpdateMovingNeighbours()
+{
+    NS_LOG_FUNCTION(this);
+    bool moving = false;
+    for (const auto& mobility : m_trackedMobility)
+    {
+        if (mobility->GetVelocity().GetLength() > 0)
+        {
+            UpdateNeighbours(mobility);
+            moving = true;
+        }
+    }
+    // A waypoint reached above may have scheduled the next update already.
+    if (moving && !m_mobilityUpdateEvent.IsPending())
+    {
+        m_mobilityUpdateEvent = Simulator::Schedule(m_mobilityUpdateInterval,
+                                                    &LrWpanSpectrumChannel::UpdateMovingNeighbours,
+                                                    this);
+    }
+}
+
+void
+LrWpanSpectrumChannel::ScheduleMobilityUpdate(Ptr<const MobilityModel> mobility)
+{
+    if (m_mobilityUpdateInterval.IsStrictlyPositive() && !m_mobilityUpdateEvent.IsPending() &&
+        mobility->GetVelocity().GetLength() > 0)
+    {
+        m_mobilityUpdateEvent = Simulator::Schedule(m_mobilityUpdateInterval,
+                                                    &LrWpanSpectrumChannel::UpdateMovingNeighbours,
+                                                    this);
+    }
+}
+
+double
+LrWpanSpectrumChannel::GetCullingRange(double txPowerDbm) const
+{
+    Ptr<LogDistancePropagationLossModel> logDistance =
+        DynamicCast<LogDistancePropagationLossModel>(m_propagationLoss);
+    if (m_gridCellSize <= 0 || !logDistance || logDistance->GetNext() || std::isinf(txPowerDbm))
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+    DoubleValue exponent;
+    DoubleValue referenceDistance;
+    DoubleValue referenceLoss;
+    logDistance->GetAttribute("Exponent", exponent);
+    logDistance->GetAttribute("ReferenceDistance", referenceDistance);
+    logDistance->GetAttribute("ReferenceLoss", referenceLoss);
+
+    // Beyond the reference distance the power falls by 10 n log10(d / d0) dB.
+    const double marginDb =
+        txPowerDbm - referenceLoss.Get() - (m_rxSensitivity - m_interferenceMargin);
+    if (marginDb <= 0)
+    {
+        return referenceDistance.Get();
+    }
+    // a little over, for the rounding of the loss model
+    return referenceDistance.Get() * std::pow(10.0, marginDb / (10 * exponent.Get())) * 1.000001;
+}
+
+uint64_t
+LrWpanSpectrumChannel::GetCellKey(int64_t column, int64_t row)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(column)) << 32) |
+           static_cast<uint32_t>(row);
+}
+
+void
+LrWpanSpectrumChannel::GetNearbyPhys(const Vector& position,
+                                     double range,
+                                     std::vector<std::size_t>& indices)
+{
+    indices.clear();
+    if (std::isinf(range) || m_gridCellSize <= 0)
+    {
+        indices.resize(m_phyList.size());
+        std::iota(indices.begin(), indices.end(), 0);
+        return;
+    }
+    if (!m_gridValid)
+    {
+        m_grid.clear();
+        m_gridOutside.clear();
+        for (std::size_t i = 0; i < m_phyList.size(); i++)
+        {
+            Ptr<MobilityModel> mobility = m_phyList[i]->GetMobility();
+            // a PHY moved by SetPosition() changes of cell
+            TrackMobility(mobility);
+            if (mobility && DynamicCast<ConstantPositionMobilityModel>(mobility))
+            {
+                const Vector p = mobility->GetPosition();
+                m_grid[GetCellKey(std::floor(p.x / m_gridCellSize),
+                                  std::floor(p.y / m_gridCellSize))]
+                    .push_back(i);
+            }
+            else
+            {
+                m_gridOutside.push_back(i);
+            }
+        }
+        m_gridValid = true;
+    }
+
+    const auto column0 = static_cast<int64_t>(std::floor((position.x - range) / m_gridCellSize));
+    const auto column1 = static_cast<int64_t>(std::floor((position.x + range) / m_gridCellSize));
+    const auto row0 = static_cast<int64_t>(std::floor((position.y - range) / m_gridCellSize));
+    const auto row1 = static_cast<int64_t>(std::floor((position.y + range) / m_gridCellSize));
+    if (static_cast<double>(column1 - column0 + 1) * (row1 - row0 + 1) > m_grid.size())
+    {
+        // fewer occupied cells than cells in range
+        for (const auto& [key, cell] : m_grid)
+        {
+            indices.insert(indices.end(), cell.begin(), cell.end());
+        }
+    }
+    else
+    {
+        for (int64_t column = column0; column <= column1; column++)
+        {
+            for (int64_t row = row0; row <= row1; row++)
+            {
+                auto it = m_grid.find(GetCellKey(column, row));
+                if (it != m_grid.end())
+                {
+                    indices.insert(indices.end(), it->second.begin(), it->second.end());
+                }
+            }
+        }
+    }
+    indices.insert(indices.end(), m_gridOutside.begin(), m_gridOutside.end());
+    std::sort(indices.begin(), indices.end());
+}
+
+void
+LrWpanSpectrumChannel::TrackMobility(Ptr<MobilityModel> mobility)
+{
+    if (mobility && m_trackedMobility.insert(mobility).second)
+    {
+        mobility->TraceConnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&LrWpanSpectrumChannel::CourseChanged, this));
+        ScheduleMobilityUpdate(mobility);
+    }
+}
+
+LrWpanSpectrumChannel::PathLoss
+LrWpanSpectrumChannel::CalcAntennaGains(Ptr<SpectrumSignalParameters> txParams,
+                                        Ptr<MobilityModel> senderMobility,
+                                        Ptr<SpectrumPhy> rxPhy,
+                                        Ptr<MobilityModel> receiverMobility)
+{
+    PathLoss loss{0, 0, 0, 0, 1, MicroSeconds(0), false};
+    if (txParams->txAntenna)
+    {
+        Angles txAngles(receiverMobility->GetPosition(), senderMobility->GetPosition());
+        loss.txAntennaGain = txParams->txAntenna->GetGainDb(txAngles);
+        NS_LOG_LOGIC("txAntennaGain = " << loss.txAntennaGain << " dB");
+        loss.pathLossDb -= loss.txAntennaGain;
+    }
+    Ptr<AntennaModel> rxAntenna = DynamicCast<AntennaModel>(rxPhy->GetAntenna());
+    if (rxAntenna)
+    {
+        Angles rxAngles(senderMobility->GetPosition(), receiverMobility->GetPosition());
+        loss.rxAntennaGain = rxAntenna->GetGainDb(rxAngles);
+        NS_LOG_LOGIC("rxAntennaGain = " << loss.rxAntennaGain << " dB");
+        loss.pathLossDb -= loss.rxAntennaGain;
+    }
+    return loss;
+}
+
+LrWpanSpectrumChannel::PathLoss
+LrWpanSpectrumChannel::CalcPathLoss(Ptr<SpectrumSignalParameters> txParams,
+                                    Ptr<MobilityModel> senderMobility,
+                                    Ptr<SpectrumPhy> rxPhy,
+                                    Ptr<MobilityModel> receiverMobility)
+{
+    PathLoss loss = CalcAntennaGains(txParams, senderMobility, rxPhy, receiverMobility);
+    if (m_propagationLoss)
+    {
+        loss.propagationGainDb =
+            m_propagationLoss->CalcRxPower(0, senderMobility, receiverMobility);
+        NS_LOG_LOGIC("propagationGainDb = " << loss.propagationGainDb << " dB");
+        loss.pathLossDb -= loss.propagationGainDb;
+    }
+    NS_LOG_LOGIC("total pathLoss = " << loss.pathLossDb << " dB");
+    loss.pathGainLinear = std::pow(10.0, (-loss.pathLossDb) / 10.0);
+    return loss;
+}
+
+LrWpanSpectrumChannel::PathLoss
+LrWpanSpectrumChannel::GetPathLoss(Ptr<SpectrumSignalParameters> txParams,
+                                   Ptr<MobilityModel> senderMobility,
+                                   Ptr<SpectrumPhy> rxPhy,
+                                   Ptr<MobilityModel> receiverMobility,
+                                   const PathLoss* precomputed)
+{
+    if (!m_pathLossCacheEnabled)
+    {
+        return precomputed ? *precomputed
+                           : CalcPathLoss(txParams, senderMobility, rxPhy, receiverMobility);
+    }
+
+    PhyPair key(txParams->txPhy, rxPhy);
+    auto it = m_pathLossCache.find(key);
+    if (it != m_pathLossCache.end() &&
+        it->second.senderMobility == PeekPointer(senderMobility) &&
+        it->second.receiverMobility == PeekPointer(receiverMobility))
+    {
+        return it->second.loss;
+    }
+
+    PathLoss loss = precomputed ? *precomputed
+                                : CalcPathLoss(txParams, senderMobility, rxPhy, receiverMobility);
+    if (it != m_pathLossCache.end())
+    {
+        // a PHY changed its MobilityModel
+        m_pathLossCache.erase(it);
+    }
+    if (m_pathLossCache.size() < m_maxPathLossCacheEntries &&
+        DynamicCast<ConstantPositionMobilityModel>(senderMobility) &&
+        DynamicCast<ConstantPositionMobilityModel>(receiverMobility))
+    {
+        if (m_propagationDelay)
+        {
+            loss.delay = m_propagationDelay->GetDelay(senderMobility, receiverMobility);
+            loss.hasDelay = true;
+        }
+        TrackMobility(senderMobility);
+        TrackMobility(receiverMobility);
+        m_pathLossCache.emplace(key,
+                                PathLossEntry{PeekPointer(senderMobility),
+                                              PeekPointer(receiverMobility),
+                                              loss});
+    }
+    return loss;
+}
+
+std::vector<bool>
+LrWpanSpectrumChannel::PrecomputePathLosses(Ptr<SpectrumSignalParameters> txParams,
+                                            Ptr<MobilityModel> senderMobility,
+                                            const std::vector<Ptr<SpectrumPhy>>& rxPhys,
+                                            std::vector<PathLoss>& losses)
+{
+    std::vector<bool> computed(rxPhys.size(), false);
+    Ptr<LogDistancePropagationLossModel> logDistance =
+        DynamicCast<LogDistancePropagationLossModel>(m_propagationLoss);
+    if (!m_workers || !senderMobility || rxPhys.size() < m_parallelMinReceivers || !logDistance ||
+        logDistance->GetNext())
+    {
+        return computed;
+    }
+
+    DoubleValue exponent;
+    DoubleValue referenceDistance;
+    DoubleValue referenceLoss;
+    logDistance->GetAttribute("Exponent", exponent);
+    logDistance->GetAttribute("ReferenceDistance", referenceDistance);
+    logDistance->GetAttribute("ReferenceLoss", referenceLoss);
+
+    // Simulator thread: everything touching ns-3 objects
+    losses.assign(rxPhys.size(), PathLoss{0, 0, 0, 0, 1, MicroSeconds(0), false});
+    std::vector<std::size_t> jobs;
+    std::vector<Vector> positions;
+    Vector senderPosition = senderMobility->GetPosition();
+    for (std::size_t i = 0; i < rxPhys.size(); i++)
+    {
+        Ptr<MobilityModel> receiverMobility = rxPhys[i]->GetMobility();
+        if (!receiverMobility)
+        {
+            continue;
+        }
+        if (m_pathLossCacheEnabled)
+        {
+            auto it = m_pathLossCache.find(PhyPair(txParams->txPhy, rxPhys[i]));
+            if (it != m_pathLossCache.end() &&
+                it->second.senderMobility == PeekPointer(senderMobility) &&
+                it->second.receiverMobility == PeekPointer(receiverMobility))
+            {
+                continue;
+            }
+        }
+        losses[i] = CalcAntennaGains(txParams, senderMobility, rxPhys[i], receiverMobility);
+        jobs.push_back(i);
+        positions.push_back(receiverMobility->GetPosition());
+    }
+
+    // Worker threads: LogDistancePropagationLossModel::DoCalcRxPower() for 0 dBm
+    double n = exponent.Get();
+    double d0 = referenceDistance.Get();
+    double l0 = referenceLoss.Get();
+    m_workers->ParallelFor(jobs.size(), [&](std::size_t j) {
+        PathLoss& loss = losses[jobs[j]];
+        double distance = CalculateDistance(senderPosition, positions[j]);
+        if (distance <= d0)
+        {
+            loss.propagationGainDb = 0 - l0;
+        }
+        else
+        {
+            double pathLossDb = 10 * n * std::log10(distance / d0);
+            double rxc = -l0 - pathLossDb;
+            loss.propagationGainDb = 0 + rxc;
+        }
+        loss.pathLossDb -= loss.propagationGainDb;
+        loss.pathGainLinear = std::pow(10.0, (-loss.pathLossDb) / 10.0);
+    });
+
+    for (std::size_t i : jobs)
+    {
+        computed[i] = true;
+    }
+    NS_LOG_LOGIC(jobs.size() << " path losses computed by " << m_workers->GetNThreads() + 1
+                             << " threads");
+    return computed;
+}
+
+const LrWpanSpectrumChannel::ReceiverList&
+LrWpanSpectrumChannel::GetReceiverList(Ptr<SpectrumSignalParameters> txParams, double txPowerDbm)
+{
+    auto it = m_receiverLists.find(txParams->txPhy);
+    if (it != m_receiverLists.end() && it->second.txPowerDbm >= txPowerDbm)
+    {
+        return it->second;
+    }
+
+    NS_LOG_LOGIC("building the receiver list of " << txParams->txPhy << " for " << txPowerDbm
+                                                  << " dBm");
+    ReceiverList& list = m_receiverLists[txParams->txPhy];
+    m_nReceiverListChanges++;
+    list.txPowerDbm = txPowerDbm;
+    list.receivers.clear();
+    // the transmitter and its antenna, for the path losses of the neighbour set updates
+    list.gains = Create<SpectrumSignalParameters>();
+    list.gains->txPhy = txParams->txPhy;
+    list.gains->txAntenna = txParams->txAntenna;
+    m_maxListPowerDbm = std::max(m_maxListPowerDbm, txPowerDbm);
+
+    double floorDbm = m_rxSensitivity - m_interferenceMargin;
+    Ptr<MobilityModel> senderMobility = txParams->txPhy->GetMobility();
+    Ptr<NetDevice> txNetDevice = txParams->txPhy->GetDevice();
+    TrackMobility(senderMobility);
+
+    // with the grid, only the PHYs of the cells within range
+    std::vector<std::size_t> nearby;
+    GetNearbyPhys(senderMobility ? senderMobility->GetPosition() : Vector(),
+                  senderMobility ? GetCullingRange(txPowerDbm)
+                                 : std::numeric_limits<double>::infinity(),
+                  nearby);
+    std::vector<Ptr<SpectrumPhy>> candidates;
+    for (std::size_t index : nearby)
+    {
+        const Ptr<SpectrumPhy>& rxPhy = m_phyList[index];
+        Ptr<NetDevice> rxNetDevice = rxPhy->GetDevice();
+        if (!(rxNetDevice && txNetDevice &&
+              rxNetDevice->GetNode()->GetId() == txNetDevice->GetNode()->GetId()))
+        {
+            candidates.push_back(rxPhy);
+        }
+    }
+    std::vector<PathLoss> losses;
+    std::vector<bool> computed = PrecomputePathLosses(txParams, senderMobility, candidates, losses);
+
+    for (std::size_t i = 0; i < candidates.size(); i++)
+    {
+        const Ptr<SpectrumPhy>& rxPhy = candidates[i];
+        Ptr<MobilityModel> receiverMobility = rxPhy->GetMobility();
+        TrackMobility(receiverMobility);
+        double lossDb = -std::numeric_limits<double>::infinity();
+        if (senderMobility && receiverMobility)
+        {
+            lossDb = GetPathLoss(txParams,
+                                 senderMobility,
+                                 rxPhy,
+                                 receiverMobility,
+                                 computed[i] ? &losses[i] : nullptr)
+                         .pathLossDb;
+        }
+        if (txPowerDbm - lossDb >= floorDbm)
+        {
+            const LrWpanPhy* lrWpanPhy = PeekPointer(DynamicCast<LrWpanPhy>(rxPhy));
+            list.receivers.push_back({rxPhy,
+                                      lossDb,
+                                      lrWpanPhy,
+                                      IsFarField(senderMobility, receiverMobility, lrWpanPhy)});
+            if (receiverMobility && !DynamicCast<ConstantPositionMobilityModel>(receiverMobility))
+            {
+                m_listedBy[PeekPointer(rxPhy)].insert(txParams->txPhy);
+            }
+        }
+    }
+    NS_LOG_LOGIC(list.receivers.size() << " of " << m_phyList.size() << " receivers listed");
+    if (!m_listChangeCallback.IsNull())
+    {
+        m_listChangeCallback();
+    }
+    return list;
+}
+
+void
+LrWpanSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
+{
+    NS_LOG_FUNCTION(this << txParams->psd << txParams->duration << txParams->txPhy);
+    NS_ASSERT_MSG(txParams->psd, "NULL txPsd");
+    NS_ASSERT_MSG(txParams->txPhy, "NULL txPhy");
+
+    if (m_localRegion && GetRegion(txParams->txPhy) != *m_localRegion)
+    {
+        // a copy of a PHY simulated by another process
+        NS_LOG_LOGIC("transmission of " << txParams->txPhy << " of another region dropped");
+        m_nForeignTransmissions++;
+        return;
+    }
+
+    // Trace the signal parameters
+    m_txSigParamsTrace(txParams);
+
+    // just a sanity check routine. We might want to remove it to save some computational load --
+    // one "if" statement  ;-)
+    if (!m_spectrumModel)
+    {
+        // first pak, record SpectrumModel
+        m_spectrumModel = txParams->psd->GetSpectrumModel();
+    }
+    else
+    {
+        // all attached SpectrumPhy instances must use the same SpectrumModel
+        NS_ASSERT(*(txParams->psd->GetSpectrumModel()) == *m_spectrumModel);
+    }
+
+    std::vector<const Receiver*> farField;
+    std::vector<Ptr<SpectrumPhy>> targets = GetTargets(txParams, farField);
+    if (!m_remoteTxCallback.IsNull())
+    {
+        // keep the receivers of the region of the transmitter, hand over the others
+        const uint32_t txRegion = GetRegion(txParams->txPhy);
+        std::set<uint32_t> remoteRegions;
+        std::vector<Ptr<SpectrumPhy>> local;
+        for (const auto& rxPhy : targets)
+        {
+            const uint32_t rxRegion = GetRegion(rxPhy);
+            if (rxRegion == txRegion)
+            {
+                local.push_back(rxPhy);
+            }
+            else
+            {
+                remoteRegions.insert(rxRegion);
+            }
+        }
+        // the far-field noise of a region is added there too
+        std::vector<const Receiver*> localFarField;
+        for (const Receiver* receiver : farField)
+        {
+            const uint32_t rxRegion = GetRegion(receiver->phy);
+            if (rxRegion == txRegion)
+            {
+                localFarField.push_back(receiver);
+            }
+            else
+            {
+                remoteRegions.insert(rxRegion);
+            }
+        }
+        farField.swap(localFarField);
+        for (uint32_t region : remoteRegions)
+        {
+            NS_LOG_LOGIC("transmission of " << txParams->txPhy << " handed over to region "
+                                            << region);
+            m_remoteTxCallback(region, txParams);
+        }
+        targets.swap(local);
+    }
+    AddFarFieldSignals(txParams, farField);
+    DeliverAll(txParams, targets);
+}
+
+void
+LrWpanSpectrumChannel::StartRemoteTx(Ptr<SpectrumSignalParameters> txParams, uint32_t region)
+{
+    NS_LOG_FUNCTION(this << txParams->txPhy << region);
+    NS_ASSERT_MSG(txParams->txPhy, "NULL txPhy");
+
+    std::vector<Ptr<SpectrumPhy>> targets;
+    std::vector<const Receiver*> farField;
+    for (const auto& rxPhy : GetTargets(txParams, farField))
+    {
+        if (GetRegion(rxPhy) == region)
+        {
+            targets.push_back(rxPhy);
+        }
+    }
+    farField.erase(std::remove_if(farField.begin(),
+                                  farField.end(),
+                                  [this, region](const Receiver* receiver) {
+                                      return GetRegion(receiver->phy) != region;
+                                  }),
+                   farField.end());
+    AddFarFieldSignals(txParams, farField);
+    DeliverAll(txParams, targets);
+}
+
+std::vector<Ptr<SpectrumPhy>>
+LrWpanSpectrumChannel::GetTargets(Ptr<SpectrumSignalParameters> txParams,
+                                  std::vector<const Receiver*>& farField)
+{
+    std::vector<Ptr<SpectrumPhy>> targets;
+    farField.clear();
+    int32_t txChannel = -1;
+    if (m_channelFiltering)
+    {
+        if (auto lrWpanParams = DynamicCast<LrWpanSpectrumSignalParameters>(txParams))
+        {
+            txChannel = lrWpanParams->txChannel;
+        }
+    }
+
+    if (!m_rangeCulling)
+    {
+        Ptr<NetDevice> txNetDevice = txParams->txPhy->GetDevice();
+        for (const auto& rxPhy : m_phyList)
+        {
+            Ptr<NetDevice> rxNetDevice = rxPhy->GetDevice();
+            if (rxNetDevice && txNetDevice &&
+                rxNetDevice->GetNode()->GetId() == txNetDevice->GetNode()->GetId())
+            {
+                NS_LOG_DEBUG("Skipping the pathloss calculation among different antennas of the "
+                             "same node, not supported yet by any pathloss model in ns-3.");
+                continue;
+            }
+            if (txChannel >= 0 &&
+                IsOnOtherChannel(txChannel, PeekPointer(DynamicCast<LrWpanPhy>(rxPhy))))
+            {
+                continue;
+            }
+            targets.push_back(rxPhy);
+        }
+    }
+    else
+    {
+        double txPowerDbm = 10.0 * std::log10(Integral(*txParams->psd)) + 30.0;
+        double floorDbm = m_rxSensitivity - m_interferenceMargin;
+        for (const auto& receiver : GetReceiverList(txParams, txPowerDbm).receivers)
+        {
+            // skip the receivers listed for a stronger transmission
+            if (txPowerDbm - receiver.lossDb >= floorDbm &&
+                !IsOnOtherChannel(txChannel, receiver.lrWpanPhy))
+            {
+                if (receiver.farField)
+                {
+                    farField.push_back(&receiver);
+                }
+                else
+                {
+                    targets.push_back(receiver.phy);
+                }
+            }
+        }
+    }
+    return targets;
+}
+
+bool
+LrWpanSpectrumChannel::IsFarField(Ptr<const MobilityModel> senderMobility,
+                                  Ptr<const MobilityModel> receiverMobility,
+                                  const LrWpanPhy* rxPhy) const
+{
+    return m_farFieldRadius > 0 && rxPhy && senderMobility && receiverMobility &&
+           senderMobility->GetDistanceFrom(receiverMobility) > m_farFieldRadius;
+}
+
+void
+LrWpanSpectrumChannel::AddFarFieldSignals(Ptr<SpectrumSignalParameters> txParams,
+                                          const std::vector<const Receiver*>& receivers)
+{
+    if (receivers.empty())
+    {
+        return;
+    }
+    NS_LOG_LOGIC(receivers.size() << " far-field signals of " << txParams->txPhy);
+    const double seconds = txParams->duration.GetSeconds();
+    uint32_t inBandChannel = 0;
+    double inBandPower = 0;
+    for (const Receiver* receiver : receivers)
+    {
+        // the in-band power of the transmitted PSD on the channel of the receiver
+        const uint32_t channel = receiver->lrWpanPhy->GetCurrentChannelNum();
+        if (channel != inBandChannel)
+        {
+            inBandChannel = channel;
+            inBandPower = (channel >= 11 && channel <= 26)
+                              ? LrWpanSpectrumValueHelper::TotalAvgPower(txParams->psd, channel)
+                              : Integral(*txParams->psd);
+        }
+        auto [it, inserted] = m_farFieldEnergy.try_emplace(PeekPointer(receiver->phy));
+        if (inserted)
+        {
+            it->second = {DynamicCast<LrWpanPhy>(receiver->phy), 0.0};
+        }
+        it->second.energy += inBandPower * std::pow(10.0, -receiver->lossDb / 10.0) * seconds;
+    }
+    m_nFarFieldSignals += receivers.size();
+    if (!m_farFieldEvent.IsPending())
+    {
+        m_farFieldEvent = Simulator::Schedule(m_farFieldWindow,
+                                              &LrWpanSpectrumChannel::UpdateFarFieldNoise,
+                                              this);
+    }
+}
+
+void
+LrWpanSpectrumChannel::UpdateFarFieldNoise()
+{
+    NS_LOG_FUNCTION(this);
+    const double window = m_farFieldWindow.GetSeconds();
+    for (auto it = m_farFieldEnergy.begin(); it != m_farFieldEnergy.end();)
+    {
+        FarFieldEnergy& farField = it->second;
+        farField.phy->SetFarFieldNoise(farField.energy / window);
+        if (farField.energy > 0)
+        {
+            farField.energy = 0;
+            ++it;
+        }
+        else
+        {
+            // silent for a whole window, the noise is back to 0
+            it = m_farFieldEnergy.erase(it);
+        }
+    }
+    if (!m_farFieldEnergy.empty())
+    {
+        m_farFieldEvent = Simulator::Schedule(m_farFieldWindow,
+                                              &LrWpanSpectrumChannel::UpdateFarFieldNoise,
+                                              this);
+    }
+}
+
+bool
+LrWpanSpectrumChannel::IsOnOtherChannel(int32_t txChannel, const LrWpanPhy* rxPhy) const
+{
+    return txChannel >= 0 && rxPhy &&
+           rxPhy->GetCurrentChannelNum() != static_cast<uint32_t>(txChannel);
+}
+
+void
+LrWpanSpectrumChannel::DeliverAll(Ptr<SpectrumSignalParameters> txParams,
+                                  const std::vector<Ptr<SpectrumPhy>>& targets)
+{
+    Ptr<MobilityModel> senderMobility = txParams->txPhy->GetMobility();
+
+    // Frequency-selective losses need the PSD of every receiver
+    Ptr<LrWpanSpectrumSignalParameters> narrowbandParams;
+    if (m_narrowband && !m_spectrumPropagationLoss)
+    {
+        narrowbandParams = DynamicCast<LrWpanSpectrumSignalParameters>(txParams);
+    }
+
+    std::vector<PathLoss> losses;
+    std::vector<bool> computed = PrecomputePathLosses(txParams, senderMobility, targets, losses);
+    for (std::size_t i = 0; i < targets.size(); i++)
+    {
+        Deliver(txParams,
+                narrowbandParams,
+                senderMobility,
+                targets[i],
+                computed[i] ? &losses[i] : nullptr);
+    }
+}
+
+void
+LrWpanSpectrumChannel::Deliver(Ptr<SpectrumSignalParameters> txParams,
+                               Ptr<LrWpanSpectrumSignalParameters> narrowbandParams,
+                               Ptr<MobilityModel> senderMobility,
+                               Ptr<SpectrumPhy> rxPhy,
+                               const PathLoss* precomputed)
+{
+    Time delay;
+    Ptr<SpectrumSignalParameters> rxParams =
+        GetRxParams(txParams, narrowbandParams, senderMobility, rxPhy, precomputed, delay);
+    if (rxParams)
+    {
+        ScheduleStartRx(rxParams, rxPhy, delay);
+    }
+}
+
+Ptr<SpectrumSignalParameters>
+LrWpanSpectrumChannel::GetRxParams(Ptr<SpectrumSignalParameters> txParams,
+                                   Ptr<LrWpanSpectrumSignalParameters> narrowbandParams,
+                                   Ptr<MobilityModel> senderMobility,
+                                   Ptr<SpectrumPhy> rxPhy,
+                                   const PathLoss* precomputed,
+                                   Time& delay)
+{
+    delay = MicroSeconds(0);
+    if (m_filter && m_filter->Filter(txParams, rxPhy))
+    {
+        return nullptr;
+    }
+
+    Ptr<MobilityModel> receiverMobility = rxPhy->GetMobility();
+    double pathGainLinear = 1.0;
+
+    if (senderMobility && receiverMobility)
+    {
+        PathLoss loss =
+            GetPathLoss(txParams, senderMobility, rxPhy, receiverMobility, precomputed);
+        m_gainTrace(senderMobility,
+                    receiverMobility,
+                    loss.txAntennaGain,
+                    loss.rxAntennaGain,
+                    loss.propagationGainDb,
+                    loss.pathLossDb);
+        m_pathLossTrace(txParams->txPhy, rxPhy, loss.pathLossDb);
+        if (loss.pathLossDb > m_maxLossDb)
+        {
+            // beyond m_maxLossDb we consider that the signal is not received
+            return nullptr;
+        }
+        pathGainLinear = loss.pathGainLinear;
+
+        if (m_propagationDelay)
+        {
+            delay = loss.hasDelay ? loss.delay
+                                  : m_propagationDelay->GetDelay(senderMobility, receiverMobility);
+        }
+    }
+
+    Ptr<SpectrumSignalParameters> rxParams;
+    if (narrowbandParams)
+    {
+        // share the transmitted PSD, only the gain travels with the copy
+        rxParams = narrowbandParams->CopyWithGain(pathGainLinear);
+    }
+    else
+    {
+        NS_LOG_LOGIC("copying signal parameters " << txParams);
+        rxParams = txParams->Copy();
+        if (senderMobility && receiverMobility)
+        {
+            *(rxParams->psd) *= pathGainLinear;
+            if (m_spectrumPropagationLoss)
+            {
+                rxParams->psd =
+                    m_spectrumPropagationLoss->CalcRxPowerSpectralDensity(rxParams,
+                                                                          senderMobility,
+                                                                          receiverMobility);
+            }
+        }
+    }
+
+    return rxParams;
+}
+
+void
+LrWpanSpectrumChannel::ScheduleStartRx(Ptr<SpectrumSignalParameters> rxParams,
+                                       Ptr<SpectrumPhy> rxPhy,
+                                       Time delay)
+{
+    Ptr<NetDevice> netDev = rxPhy->GetDevice();
+    if (netDev)
+    {
+        // the receiver has a NetDevice, so we expect that it is attached to a Node
+        uint32_t dstNode = netDev->GetNode()->GetId();
+        Simulator::ScheduleWithContext(dstNode,
+                                       delay,
+                                       &LrWpanSpectrumChannel::StartRx,
+                                       this,
+                                       rxParams,
+                                       rxPhy);
+    }
+    else
+    {
+        // the receiver is not attached to a NetDevice, so we cannot assume that it is attached
+        // to a node
+        Simulator::Schedule(delay, &LrWpanSpectrumChannel::StartRx, this, rxParams, rxPhy);
+    }
+}
+
+void
+LrWpanSpectrumChannel::StartRx(Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver)
+{
+    NS_LOG_FUNCTION(this << params);
+    receiver->StartRx(params);
+}
+
+std::size_t
+LrWpanSpectrumChannel::GetNDevices() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_phyList.size();
+}
+
+Ptr<NetDevice>
+LrWpanSpectrumChannel::GetDevice(std::size_t i) const
+{
+    NS_LOG_FUNCTION(this << i);
+    return m_phyList.at(i)->GetDevice()->GetObject<NetDevice>();
+}
+
+} // namespace lrwpan
+} // namespace ns3
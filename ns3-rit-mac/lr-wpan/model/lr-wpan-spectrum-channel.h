@@ -0,0 +1,737 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+#ifndef LR_WPAN_SPECTRUM_CHANNEL_H
+#define LR_WPAN_SPECTRUM_CHANNEL_H
+
+#include "ns3/callback.h"
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/spectrum-channel.h"
+#include "ns3/vector.h"
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+class MobilityModel;
+
+namespace lrwpan
+{
+
+class LrWpanPhy;
+struct LrWpanSpectrumSignalParameters;
+
+/**
+ * @ingroup lr-wpan
+ *
+ * @brief Single-model spectrum channel that only delivers a transmission to the
+ * receivers that can hear it.
+ *
+ * The delivery of a signal follows SingleModelSpectrumChannel (antenna gains,
+ * propagation loss, MaxLossDb, spectrum propagation loss, delay, traces). In
+ * addition, the channel keeps, per transmitter, the list of receivers whose
+ * received power can reach the floor RxSensitivity - InterferenceMargin. A
+ * transmission is only delivered to the listed receivers above the floor for its
+ * power, so far-away receivers cost neither a path loss computation, a PSD copy nor
+ * a StartRx event. Listed receivers keep the order in which they were added to the
+ * channel, so the StartRx events are scheduled in the same order as with
+ * SingleModelSpectrumChannel.
+ *
+ * A list is built on the first transmission of a transmitter, for the total power
+ * of that transmission, and rebuilt when a stronger transmission is sent. All lists
+ * are dropped when a receiver is added or removed. When a MobilityModel of the
+ * channel fires CourseChange, only the neighbour sets of its PHYs are updated: their
+ * own lists are dropped, and each other list gains or loses them after one path loss
+ * computation, the other receivers being unchanged. Call InvalidateReceiverLists()
+ * after replacing the MobilityModel of a PHY or reconfiguring the propagation loss
+ * models.
+ *
+ * A mobility model moving between two course changes (e.g. WaypointMobilityModel
+ * between its waypoints) leaves the lists as they were at the last update. With
+ * MobilityUpdateInterval set, the neighbour sets of the PHYs of the moving models
+ * are updated that often, for as long as their velocity is not zero.
+ *
+ * With NeighbourGridCellSize set and a single LogDistancePropagationLossModel, the
+ * PHYs using ConstantPositionMobilityModel are kept in a grid of square cells: the
+ * list of a transmitter is built from the cells within the range of its power, and a
+ * moving PHY is only checked against the lists of the transmitters within range of
+ * its new position and of those listing it. The range assumes antenna gains of at
+ * most 0 dB, as with the isotropic antennas of LrWpanPhy.
+ *
+ * With PathLossCache enabled, the path loss (antenna gains and propagation loss)
+ * and the propagation delay between two PHYs using ConstantPositionMobilityModel
+ * are computed once and kept in a sparse cache keyed by (tx PHY, rx PHY). The cache
+ * is filled lazily and stops growing at MaxPathLossCacheEntries entries; the pairs
+ * that did not fit are computed on every frame as without the cache. The entries of
+ * a MobilityModel are dropped when it fires CourseChange, and an entry is ignored
+ * when one of its PHYs uses another MobilityModel. Call ClearPathLossCache() after
+ * reconfiguring the propagation models.
+ *
+ * With Narrowband enabled, the receivers of a LrWpanSpectrumSignalParameters
+ * signal share the transmitted PSD instead of receiving a scaled copy, and the
+ * path gain travels as LrWpanSpectrumSignalParameters::psdGain. LrWpanPhy only
+ * uses the in-band power of the signals (GetInBandPower()), so sensitivity, SINR
+ * chunking, CCA and ED behave as with the per-receiver PSDs, but no SpectrumValue
+ * is allocated nor scaled per receiver. The mode is meant for single-channel
+ * studies: it is ignored when a SpectrumPropagationLossModel is set.
+ *
+ * With WorkerThreads > 0, the propagation losses of a transmission (or of the
+ * receiver list being built) that are not in the cache are computed by a pool of
+ * worker threads once at least ParallelMinReceivers receivers are involved. The
+ * signal copies and the StartRx events are still made by the simulator thread, in
+ * receiver order, so the results do not depend on the number of threads. Since
+ * ns-3 reference counts are not thread-safe, the workers only evaluate a single
+ * LogDistancePropagationLossModel from copied positions; other loss models are
+ * computed sequentially.
+ *
+ * With a RemoteTxCallback set, the channel is split into regions: each PHY is in
+ * the region given by SetRegion(), or else in the region of the SystemId of its
+ * node. A transmission is only delivered to the receivers of the region of the
+ * transmitter; the callback is called once per other region holding a listed
+ * receiver, and StartRemoteTx() delivers the signal there. The two calls may run
+ * in different processes (e.g. one per MPI rank holding a copy of every PHY), or
+ * be connected directly to count the traffic crossing the regions. Only the
+ * transmitters close to another region call the callback. In a process simulating
+ * one region, SetLocalRegion() keeps the copies of the PHYs of the other regions
+ * off the channel: their transmissions are dropped before the TxSigParams trace.
+ *
+ * With ChannelFiltering enabled, a signal transmitted by a LrWpanPhy is not
+ * delivered to the LrWpanPhy tuned to another channel at the start of the
+ * transmission. The 2.4 GHz O-QPSK PSDs of two channels do not overlap, so only
+ * the copies, events and SINR updates of zero in-band power are saved: several
+ * RIT neighbourhoods on distinct channels cost about what one does. A receiver
+ * retuning to the channel during the frame does not see it, as if it retuned
+ * with the legacy LrWpanPhy (which dropped the signals in the air).
+ *
+ * With FarFieldRadius set, the listed LrWpanPhy farther than that from the transmitter
+ * do not receive the signal: no copy, StartRx/EndRx events nor interference helper
+ * update. The channel instead adds the energy each of them would have received (in-band
+ * power times airtime) to a per-receiver total, and every FarFieldWindow hands the mean
+ * power of the last window to LrWpanPhy::SetFarFieldNoise(), which adds it to the noise
+ * of the SINR. The far nodes thus weigh with their actual beacon rates and airtimes, as
+ * a noise floor following the traffic one window late. Far-field signals are neither
+ * decoded nor seen by CCA and ED, so the radius should lie well beyond the reception
+ * range. The abstraction needs RangeCulling; lowering InterferenceMargin adds the
+ * weaker far signals to the floor.
+ *
+ * A LrWpanPhy may defer a transmission (LrWpanPhy::DeferNextTx()) when the channel
+ * can tell its receivers beforehand, and deliver it to a receiver only when that
+ * one wakes up (DeliverDeferredTx()). The receivers then see the signal as if it
+ * had been sent at its start, or its end part when they wake up during it.
+ *
+ * The culling and the cache assume a deterministic propagation loss (e.g. the
+ * log-distance model of the RIT scenarios). Receivers without a MobilityModel are
+ * never culled.
+ */
+class LrWpanSpectrumChannel : public SpectrumChannel
+{
+  public:
+    /**
+     * Get the type ID.
+     *
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    LrWpanSpectrumChannel();
+    ~LrWpanSpectrumChannel() override;
+
+    /**
+     * Callback called for a transmission reaching the receivers of another region:
+     * the region, the transmitted signal.
+     */
+    typedef Callback<void, uint32_t, Ptr<SpectrumSignalParameters>> RemoteTxCallback;
+
+    // inherited from SpectrumChannel
+    void AddRx(Ptr<SpectrumPhy> phy) override;
+    void RemoveRx(Ptr<SpectrumPhy> phy) override;
+    void StartTx(Ptr<SpectrumSignalParameters> params) override;
+
+    // inherited from Channel
+    std::size_t GetNDevices() const override;
+    Ptr<NetDevice> GetDevice(std::size_t i) const override;
+
+    /**
+     * Reserve room for receivers, before adding many of them.
+     *
+     * @param n the expected total number of receivers
+     */
+    void ReserveReceivers(std::size_t n);
+
+    /**
+     * Drop the receiver lists of every transmitter. They are rebuilt on the next
+     * transmission.
+     */
+    void InvalidateReceiverLists();
+
+    /**
+     * Get the number of receivers currently listed for a transmitter.
+     *
+     * @param txPhy the transmitter
+     * @return the number of receivers, 0 if no list was built yet
+     */
+    std::size_t GetNListedReceivers(Ptr<const SpectrumPhy> txPhy) const;
+
+    /**
+     * Get the receivers currently listed for a transmitter, i.e. the receivers its
+     * last transmission could reach above the culling floor.
+     *
+     * @param txPhy the transmitter
+     * @param receivers filled with the listed receivers
+     * @return false if no list was built yet for the transmitter
+     */
+    bool GetListedReceivers(Ptr<const SpectrumPhy> txPhy,
+                            std::vector<Ptr<SpectrumPhy>>& receivers) const;
+
+    /**
+     * Get the number of neighbour set updates made for the PHYs that moved, i.e. of
+     * receiver lists checked against a moved PHY.
+     *
+     * @return the number of updates
+     */
+    uint64_t GetNNeighbourUpdates() const;
+
+    /**
+     * Get the number of changes made to the receiver lists: lists built, updated by a
+     * move or dropped. A copy of a list is current while the number is unchanged.
+     *
+     * @return the number of changes
+     */
+    uint64_t GetNReceiverListChanges() const;
+
+    /**
+     * Set the callback called after every change counted by GetNReceiverListChanges().
+     *
+     * @param cb the callback, null for none
+     */
+    void SetReceiverListChangeCallback(Callback<void> cb);
+
+    /**
+     * Get the transmitters listing a receiver, i.e. the PHYs whose transmissions reach
+     * it above the culling floor. The PHYs with no list yet are not known; building
+     * their list is a change of the lists.
+     *
+     * @param rxPhy the receiver
+     * @param transmitters filled with the transmitters
+     * @return false if the lists do not tell the transmitters reaching the receiver:
+     *         RangeCulling disabled, or the channel split into regions
+     */
+    bool GetListingTransmitters(Ptr<const SpectrumPhy> rxPhy,
+                                std::vector<Ptr<const SpectrumPhy>>& transmitters);
+
+    /**
+     * Get the receivers of a transmission that is not started yet, when they are
+     * known beforehand: the PHYs of the current list of the transmitter above the
+     * culling floor (and on its channel with ChannelFiltering), all of them using
+     * ConstantPositionMobilityModel, with a deterministic propagation loss and delay,
+     * no transmit filter, spectrum propagation loss, far field, regions or trace sink
+     * of TxSigParams, Gain and PathLoss.
+     *
+     * @param txPhy the transmitter
+     * @param txPsd the transmitted PSD
+     * @param txChannel the channel of the transmission
+     * @param targets filled with the receivers
+     * @param maxDelay set to the largest propagation delay to the receivers
+     * @return false if the receivers are not known beforehand
+     */
+    bool GetDeferrableTargets(Ptr<const SpectrumPhy> txPhy,
+                              Ptr<const SpectrumValue> txPsd,
+                              uint8_t txChannel,
+                              std::vector<Ptr<SpectrumPhy>>& targets,
+                              Time& maxDelay);
+
+    /**
+     * Deliver a deferred transmission to one of the receivers given by
+     * GetDeferrableTargets(): at its arrival time if it is still to come, else what is
+     * left of the frame at once, or nothing once the frame has passed.
+     *
+     * @param txParams the transmitted signal
+     * @param txStart the start of the transmission
+     * @param rxPhy the receiver
+     */
+    void DeliverDeferredTx(Ptr<SpectrumSignalParameters> txParams,
+                           Time txStart,
+                           Ptr<SpectrumPhy> rxPhy);
+
+    /**
+     * Drop every entry of the path loss cache.
+     */
+    void ClearPathLossCache();
+
+    /**
+     * Get the number of entries of the path loss cache.
+     *
+     * @return the number of (tx PHY, rx PHY) pairs in the cache
+     */
+    std::size_t GetPathLossCacheSize() const;
+
+    /**
+     * Set the number of worker threads computing the propagation losses.
+     *
+     * @param nThreads the number of threads besides the simulator thread (0 = none)
+     */
+    void SetWorkerThreads(uint32_t nThreads);
+
+    /**
+     * Get the number of worker threads.
+     *
+     * @return the number of worker threads
+     */
+    uint32_t GetWorkerThreads() const;
+
+    /**
+     * Set the region of a PHY, in place of the SystemId of its node.
+     *
+     * @param phy the PHY
+     * @param region the region
+     */
+    void SetRegion(Ptr<const SpectrumPhy> phy, uint32_t region);
+
+    /**
+     * Get the region of a PHY.
+     *
+     * @param phy the PHY
+     * @return the region set by SetRegion(), else the SystemId of its node (0 without node)
+     */
+    uint32_t GetRegion(Ptr<const SpectrumPhy> phy) const;
+
+    /**
+     * Split the channel into regions. A null callback delivers every transmission to
+     * all its receivers again.
+     *
+     * @param cb the callback called for the transmissions reaching other regions
+     */
+    void SetRemoteTxCallback(RemoteTxCallback cb);
+
+    /**
+     * Deliver a transmission of another region to the receivers of a region. The
+     * transmitter PHY of the signal must be attached to this channel (or to a copy of
+     * it holding the same PHYs).
+     *
+     * @param txParams the signal passed to the RemoteTxCallback
+     * @param region the region of the receivers
+     */
+    void StartRemoteTx(Ptr<SpectrumSignalParameters> txParams, uint32_t region);
+
+    /**
+     * Simulate one region in this process: StartTx() drops the transmissions of the
+     * PHYs of the other regions, which are copies of PHYs simulated elsewhere.
+     *
+     * @param region the region of this process
+     */
+    void SetLocalRegion(uint32_t region);
+
+    /**
+     * @return the number of transmissions dropped since their PHY is of another
+     *         region than the one set by SetLocalRegion()
+     */
+    uint64_t GetNForeignTransmissions() const;
+
+    /**
+     * Set the distance beyond which a listed LrWpanPhy gets the signals as far-field
+     * noise instead of receiving them. The receiver lists are rebuilt.
+     *
+     * @param radius the radius (m), 0 to deliver every listed signal
+     */
+    void SetFarFieldRadius(double radius);
+
+    /**
+     * Get the far-field radius.
+     *
+     * @return the radius (m), 0 if disabled
+     */
+    double GetFarFieldRadius() const;
+
+    /**
+     * Get the number of signals accounted for as far-field noise instead of being
+     * delivered, one per (transmission, receiver).
+     *
+     * @return the number of far-field signals
+     */
+    uint64_t GetNFarFieldSignals() const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    class WorkerPool;
+
+    /**
+     * A receiver of a transmitter.
+     */
+    struct Receiver
+    {
+        Ptr<SpectrumPhy> phy;       //!< The receiver
+        double lossDb;              //!< Path loss from the transmitter (-inf when unknown)
+        const LrWpanPhy* lrWpanPhy; //!< phy as an LrWpanPhy, or nullptr
+        bool farField;              //!< Beyond FarFieldRadius, gets the signals as noise
+    };
+
+    /**
+     * The far-field energy received by a LrWpanPhy during the current window.
+     */
+    struct FarFieldEnergy
+    {
+        Ptr<LrWpanPhy> phy; //!< The receiver
+        double energy;      //!< In-band energy of the window (J)
+    };
+
+    /**
+     * The receivers of a transmitter.
+     */
+    struct ReceiverList
+    {
+        double txPowerDbm;                   //!< Transmit power the list was built for
+        std::vector<Receiver> receivers;     //!< Listed receivers
+        Ptr<SpectrumSignalParameters> gains; //!< Transmitter and antenna, for the updates
+    };
+
+    /**
+     * The path loss and delay between a transmitter and a receiver.
+     */
+    struct PathLoss
+    {
+        double txAntennaGain;     //!< Transmitter antenna gain (dB)
+        double rxAntennaGain;     //!< Receiver antenna gain (dB)
+        double propagationGainDb; //!< Propagation gain (dB)
+        double pathLossDb;        //!< Total path loss (dB)
+        double pathGainLinear;    //!< Total path gain (linear)
+        Time delay;               //!< Propagation delay (when hasDelay)
+        bool hasDelay;            //!< The delay was computed with the loss
+    };
+
+    /**
+     * A path loss cache entry.
+     */
+    struct PathLossEntry
+    {
+        const MobilityModel* senderMobility;   //!< Mobility of the transmitter
+        const MobilityModel* receiverMobility; //!< Mobility of the receiver
+        PathLoss loss;                         //!< Cached path loss
+    };
+
+    /**
+     * Key of the path loss cache: (tx PHY, rx PHY).
+     */
+    using PhyPair = std::pair<Ptr<const SpectrumPhy>, Ptr<const SpectrumPhy>>;
+
+    /**
+     * Hash of a PhyPair.
+     */
+    struct PhyPairHash
+    {
+        /**
+         * @param key the key
+         * @return the hash value
+         */
+        std::size_t operator()(const PhyPair& key) const;
+    };
+
+    /**
+     * Get the receiver list of a transmitter, building it if needed.
+     *
+     * @param txParams the parameters of the transmission
+     * @param txPowerDbm the total transmit power of the transmission (dBm)
+     * @return the receiver list
+     */
+    const ReceiverList& GetReceiverList(Ptr<SpectrumSignalParameters> txParams,
+                                        double txPowerDbm);
+
+    /**
+     * Compute the antenna gains between a transmitter and a receiver.
+     *
+     * @param txParams the parameters of the transmission
+     * @param senderMobility the mobility of the transmitter
+     * @param rxPhy the receiver
+     * @param receiverMobility the mobility of the receiver
+     * @return the path loss without the propagation loss
+     */
+    PathLoss CalcAntennaGains(Ptr<SpectrumSignalParameters> txParams,
+                              Ptr<MobilityModel> senderMobility,
+                              Ptr<SpectrumPhy> rxPhy,
+                              Ptr<MobilityModel> receiverMobility);
+
+    /**
+     * Compute the path loss between a transmitter and a receiver.
+     *
+     * @param txParams the parameters of the transmission
+     * @param senderMobility the mobility of the transmitter
+     * @param rxPhy the receiver
+     * @param receiverMobility the mobility of the receiver
+     * @return the path loss
+     */
+    PathLoss CalcPathLoss(Ptr<SpectrumSignalParameters> txParams,
+                          Ptr<MobilityModel> senderMobility,
+                          Ptr<SpectrumPhy> rxPhy,
+                          Ptr<MobilityModel> receiverMobility);
+
+    /**
+     * Get the path loss between a transmitter and a receiver, from the cache when
+     * possible. Cached entries also hold the propagation delay.
+     *
+     * @param txParams the parameters of the transmission
+     * @param senderMobility the mobility of the transmitter
+     * @param rxPhy the receiver
+     * @param receiverMobility the mobility of the receiver
+     * @param precomputed the path loss computed by PrecomputePathLosses(), if any
+     * @return the path loss
+     */
+    PathLoss GetPathLoss(Ptr<SpectrumSignalParameters> txParams,
+                         Ptr<MobilityModel> senderMobility,
+                         Ptr<SpectrumPhy> rxPhy,
+                         Ptr<MobilityModel> receiverMobility,
+                         const PathLoss* precomputed = nullptr);
+
+    /**
+     * Compute the path losses from a transmitter to several receivers with the worker
+     * threads. Nothing is computed when the threads are disabled, the receivers are
+     * too few or the propagation loss model cannot be evaluated by the workers.
+     *
+     * @param txParams the parameters of the transmission
+     * @param senderMobility the mobility of the transmitter
+     * @param rxPhys the receivers
+     * @param losses the path losses, indexed as rxPhys
+     * @return for each receiver, whether its path loss was computed
+     */
+    std::vector<bool> PrecomputePathLosses(Ptr<SpectrumSignalParameters> txParams,
+                                           Ptr<MobilityModel> senderMobility,
+                                           const std::vector<Ptr<SpectrumPhy>>& rxPhys,
+                                           std::vector<PathLoss>& losses);
+
+    /**
+     * Get the receivers a transmission is delivered to, in receiver order.
+     *
+     * @param txParams the parameters of the transmission
+     * @param farField filled with the listed receivers beyond FarFieldRadius
+     * @return the receivers
+     */
+    std::vector<Ptr<SpectrumPhy>> GetTargets(Ptr<SpectrumSignalParameters> txParams,
+                                             std::vector<const Receiver*>& farField);
+
+    /**
+     * Check whether a receiver gets the signals of a transmitter as far-field noise.
+     *
+     * @param senderMobility the mobility of the transmitter
+     * @param receiverMobility the mobility of the receiver
+     * @param rxPhy the receiver as an LrWpanPhy, or nullptr
+     * @return true if the receiver is a LrWpanPhy beyond FarFieldRadius
+     */
+    bool IsFarField(Ptr<const MobilityModel> senderMobility,
+                    Ptr<const MobilityModel> receiverMobility,
+                    const LrWpanPhy* rxPhy) const;
+
+    /**
+     * Add the energy of a transmission to the far-field totals of receivers.
+     *
+     * @param txParams the parameters of the transmission
+     * @param receivers the far-field receivers
+     */
+    void AddFarFieldSignals(Ptr<SpectrumSignalParameters> txParams,
+                            const std::vector<const Receiver*>& receivers);
+
+    /**
+     * Hand the mean far-field power of the window that ends to the receivers, and start
+     * the next window while a receiver has a far-field noise.
+     */
+    void UpdateFarFieldNoise();
+
+    /**
+     * Check whether ChannelFiltering keeps a transmission from a receiver.
+     *
+     * @param txChannel the channel of the transmission, -1 if unknown
+     * @param rxPhy the receiver as an LrWpanPhy, or nullptr
+     * @return true if the receiver is tuned to another channel
+     */
+    bool IsOnOtherChannel(int32_t txChannel, const LrWpanPhy* rxPhy) const;
+
+    /**
+     * Deliver a transmission to several receivers.
+     *
+     * @param txParams the parameters of the transmission
+     * @param targets the receivers
+     */
+    void DeliverAll(Ptr<SpectrumSignalParameters> txParams,
+                    const std::vector<Ptr<SpectrumPhy>>& targets);
+
+    /**
+     * Deliver a transmission to a receiver.
+     *
+     * @param txParams the parameters of the transmission
+     * @param narrowbandParams txParams in narrowband mode, null otherwise
+     * @param senderMobility the mobility of the transmitter
+     * @param rxPhy the receiver
+     * @param precomputed the path loss computed by PrecomputePathLosses(), if any
+     */
+    void Deliver(Ptr<SpectrumSignalParameters> txParams,
+                 Ptr<LrWpanSpectrumSignalParameters> narrowbandParams,
+                 Ptr<MobilityModel> senderMobility,
+                 Ptr<SpectrumPhy> rxPhy,
+                 const PathLoss* precomputed);
+
+    /**
+     * Get the signal of a transmission as received by a receiver.
+     *
+     * @param txParams the parameters of the transmission
+     * @param narrowbandParams txParams in narrowband mode, null otherwise
+     * @param senderMobility the mobility of the transmitter
+     * @param rxPhy the receiver
+     * @param precomputed the path loss computed by PrecomputePathLosses(), if any
+     * @param delay set to the propagation delay
+     * @return the received signal, null if the receiver does not get it
+     */
+    Ptr<SpectrumSignalParameters> GetRxParams(Ptr<SpectrumSignalParameters> txParams,
+                                              Ptr<LrWpanSpectrumSignalParameters> narrowbandParams,
+                                              Ptr<MobilityModel> senderMobility,
+                                              Ptr<SpectrumPhy> rxPhy,
+                                              const PathLoss* precomputed,
+                                              Time& delay);
+
+    /**
+     * Schedule the start of a reception, in the context of the node of the receiver.
+     *
+     * @param rxParams the received signal
+     * @param rxPhy the receiver
+     * @param delay the delay from now
+     */
+    void ScheduleStartRx(Ptr<SpectrumSignalParameters> rxParams,
+                         Ptr<SpectrumPhy> rxPhy,
+                         Time delay);
+
+    /**
+     * @return true if every propagation loss model of the chain gives a loss that only
+     *         depends on the positions
+     */
+    bool IsDeterministicLoss() const;
+
+    /**
+     * Used internally to reschedule transmission after the propagation delay.
+     *
+     * @param params the signal parameters
+     * @param receiver a pointer to the receiver SpectrumPhy
+     */
+    void StartRx(Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver);
+
+    /**
+     * Update the receiver lists and the path loss cache when a node of the channel moves.
+     *
+     * @param mobility the mobility model that changed
+     */
+    void CourseChanged(Ptr<const MobilityModel> mobility);
+
+    /**
+     * Update the neighbour sets of the PHYs of a mobility model that moved: drop their
+     * lists and add them to, or remove them from, the lists of the other transmitters.
+     *
+     * @param mobility the mobility model
+     */
+    void UpdateNeighbours(Ptr<const MobilityModel> mobility);
+
+    /**
+     * Update the neighbour sets of the moving PHYs, every MobilityUpdateInterval while
+     * one of the tracked mobility models moves.
+     */
+    void UpdateMovingNeighbours();
+
+    /**
+     * Schedule UpdateMovingNeighbours() if a mobility model moves and none is scheduled.
+     *
+     * @param mobility the mobility model that may move
+     */
+    void ScheduleMobilityUpdate(Ptr<const MobilityModel> mobility);
+
+    /**
+     * Get the range of a transmission for the culling floor, from the log-distance
+     * model of NeighbourGridCellSize.
+     *
+     * @param txPowerDbm the total transmit power (dBm)
+     * @return the range (m), infinity if the grid is not usable
+     */
+    double GetCullingRange(double txPowerDbm) const;
+
+    /**
+     * Get the PHYs that may lie within a distance of a position: those of the grid
+     * cells around it, then the PHYs out of the grid. The grid is built if needed.
+     *
+     * @param position the position
+     * @param range the distance (m), infinity for every PHY
+     * @param indices filled with the indices in m_phyList, in increasing order
+     */
+    void GetNearbyPhys(const Vector& position, double range, std::vector<std::size_t>& indices);
+
+    /**
+     * Get the key of a grid cell.
+     *
+     * @param column the cell along x, floor(x / NeighbourGridCellSize)
+     * @param row the cell along y, floor(y / NeighbourGridCellSize)
+     * @return the key
+     */
+    static uint64_t GetCellKey(int64_t column, int64_t row);
+
+    /**
+     * Connect to the CourseChange trace of a mobility model (once).
+     *
+     * @param mobility the mobility model
+     */
+    void TrackMobility(Ptr<MobilityModel> mobility);
+
+    std::vector<Ptr<SpectrumPhy>> m_phyList;  //!< The attached receivers
+    std::unordered_set<const SpectrumPhy*> m_phySet; //!< The receivers of m_phyList
+    std::unordered_map<const SpectrumPhy*, std::size_t> m_phyIndex; //!< Index in m_phyList
+    Ptr<const SpectrumModel> m_spectrumModel; //!< SpectrumModel of the channel
+    std::map<Ptr<const SpectrumPhy>, ReceiverList> m_receiverLists; //!< Lists per transmitter
+    std::set<Ptr<MobilityModel>> m_trackedMobility; //!< Mobility models connected to
+    std::unordered_map<PhyPair, PathLossEntry, PhyPairHash> m_pathLossCache; //!< Loss cache
+    bool m_rangeCulling;                            //!< Cull the out-of-range receivers
+    bool m_channelFiltering;                        //!< Skip the receivers on other channels
+    double m_rxSensitivity;                         //!< Receiver sensitivity (dBm)
+    double m_interferenceMargin;                    //!< Margin below the sensitivity (dB)
+    bool m_pathLossCacheEnabled;                    //!< Cache the constant path losses
+    uint32_t m_maxPathLossCacheEntries;             //!< Size cap of the path loss cache
+    bool m_narrowband;                              //!< Share the PSD between the receivers
+    std::unique_ptr<WorkerPool> m_workers;          //!< Path loss worker threads
+    uint32_t m_parallelMinReceivers;                //!< Receivers needed to use the workers
+    std::map<Ptr<const SpectrumPhy>, uint32_t> m_regions; //!< Regions set by SetRegion()
+    RemoteTxCallback m_remoteTxCallback;            //!< Transmissions to other regions
+    std::optional<uint32_t> m_localRegion;          //!< Region of this process, if set
+    uint64_t m_nForeignTransmissions;               //!< Transmissions of other regions
+    Time m_mobilityUpdateInterval;                  //!< Update period of the moving PHYs
+    EventId m_mobilityUpdateEvent;                  //!< Next UpdateMovingNeighbours()
+    uint64_t m_nNeighbourUpdates;                   //!< Lists checked against a moved PHY
+    uint64_t m_nReceiverListChanges;                //!< Lists built, updated or dropped
+    double m_gridCellSize;                          //!< Side of a grid cell (m), 0 if none
+    bool m_gridValid;                               //!< m_grid matches the positions
+    std::unordered_map<uint64_t, std::vector<std::size_t>> m_grid; //!< PHYs per cell
+    std::vector<std::size_t> m_gridOutside;         //!< PHYs out of the grid
+    double m_maxListPowerDbm;                       //!< Strongest power of a list
+    double m_farFieldRadius;                        //!< Far-field radius (m), 0 if none
+    Time m_farFieldWindow;                          //!< Averaging window of the far field
+    EventId m_farFieldEvent;                        //!< Next UpdateFarFieldNoise()
+    uint64_t m_nFarFieldSignals;                    //!< Signals turned into noise
+    /// Far-field energy of the current window per receiver
+    std::unordered_map<const SpectrumPhy*, FarFieldEnergy> m_farFieldEnergy;
+    /// Transmitters listing each receiver not using ConstantPositionMobilityModel
+    std::unordered_map<const SpectrumPhy*, std::set<Ptr<const SpectrumPhy>>> m_listedBy;
+    /// Transmitters listing each receiver, built from the lists by GetListingTransmitters()
+    std::unordered_map<const SpectrumPhy*, std::vector<Ptr<const SpectrumPhy>>> m_listingIndex;
+    uint64_t m_listingIndexChanges;                 //!< List changes m_listingIndex is built at
+    Callback<void> m_listChangeCallback;            //!< Called after every change of the lists
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif /* LR_WPAN_SPECTRUM_CHANNEL_H */
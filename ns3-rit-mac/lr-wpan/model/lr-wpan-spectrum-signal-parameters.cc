@@ -7,6 +7,8 @@
  */
 #include "lr-wpan-spectrum-signal-parameters.h"
 
+#include "lr-wpan-spectrum-value-helper.h"
+
 #include "ns3/log.h"
 #include "ns3/packet-burst.h"
 
@@ -18,13 +20,21 @@ namespace lrwpan
 NS_LOG_COMPONENT_DEFINE("LrWpanSpectrumSignalParameters");
 
 LrWpanSpectrumSignalParameters::LrWpanSpectrumSignalParameters()
+    : psdGain(1.0),
+      inBandPower(-1.0),
+      inBandChannel(0),
+      txChannel(-1)
 {
     NS_LOG_FUNCTION(this);
 }
 
 LrWpanSpectrumSignalParameters::LrWpanSpectrumSignalParameters(
     const LrWpanSpectrumSignalParameters& p)
-    : SpectrumSignalParameters(p)
+    : SpectrumSignalParameters(p),
+      psdGain(p.psdGain),
+      inBandPower(-1.0),
+      inBandChannel(0),
+      txChannel(p.txChannel)
 {
     NS_LOG_FUNCTION(this << &p);
     packetBurst = p.packetBurst->Copy();
@@ -37,5 +47,31 @@ LrWpanSpectrumSignalParameters::Copy() const
     return Create<LrWpanSpectrumSignalParameters>(*this);
 }
 
+Ptr<LrWpanSpectrumSignalParameters>
+LrWpanSpectrumSignalParameters::CopyWithGain(double gain) const
+{
+    NS_LOG_FUNCTION(this << gain);
+    Ptr<LrWpanSpectrumSignalParameters> copy = Create<LrWpanSpectrumSignalParameters>();
+    copy->psd = psd;
+    copy->duration = duration;
+    copy->txPhy = txPhy;
+    copy->txAntenna = txAntenna;
+    copy->packetBurst = packetBurst->Copy();
+    copy->psdGain = psdGain * gain;
+    copy->txChannel = txChannel;
+    return copy;
+}
+
+double
+LrWpanSpectrumSignalParameters::GetInBandPower(uint32_t channel)
+{
+    if (inBandPower < 0.0 || inBandChannel != channel)
+    {
+        inBandPower = psdGain * LrWpanSpectrumValueHelper::TotalAvgPower(psd, channel);
+        inBandChannel = channel;
+    }
+    return inBandPower;
+}
+
 } // namespace lrwpan
 } // namespace ns3
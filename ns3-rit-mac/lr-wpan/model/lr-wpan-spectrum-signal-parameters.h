@@ -39,10 +39,54 @@ struct LrWpanSpectrumSignalParameters : public SpectrumSignalParameters
      */
     LrWpanSpectrumSignalParameters(const LrWpanSpectrumSignalParameters& p);
 
+    /**
+     * Copy the parameters for one receiver of a narrowband channel: psd is shared
+     * with this instance instead of being copied, and the path gain is only
+     * accumulated in psdGain. The MIMO fields of SpectrumSignalParameters are not
+     * copied (unused by lr-wpan).
+     *
+     * @param gain the linear path gain to the receiver
+     * @return the copy
+     */
+    Ptr<LrWpanSpectrumSignalParameters> CopyWithGain(double gain) const;
+
+    /**
+     * Get the in-band average power of psd on a channel. Computed on the first
+     * call and cached on this instance, so that every PHY decision taken during
+     * the reception of the frame reuses the same integration.
+     *
+     * @param channel the channel number (see LrWpanSpectrumValueHelper::TotalAvgPower)
+     * @return the in-band average power in W
+     */
+    double GetInBandPower(uint32_t channel);
+
+    /**
+     * Linear gain not applied to psd yet: the received PSD is psdGain * psd. 1 with
+     * the spectrum channels, the path gain with a narrowband LrWpanSpectrumChannel.
+     */
+    double psdGain;
+
     /**
      * The packet burst being transmitted with this signal
      */
     Ptr<PacketBurst> packetBurst;
+
+    /**
+     * Cached in-band average power of psd on inBandChannel [W], negative if not
+     * computed yet. Not copied: the channel replaces psd on the copy for each receiver.
+     */
+    double inBandPower;
+
+    /**
+     * Channel of the cached in-band power.
+     */
+    uint32_t inBandChannel;
+
+    /**
+     * Channel the signal was transmitted on, -1 if unknown. LrWpanSpectrumChannel
+     * does not deliver the signal to the LrWpanPhy tuned to another channel.
+     */
+    int32_t txChannel;
 };
 
 } // namespace lrwpan
@@ -11,6 +11,8 @@
 #include "ns3/spectrum-value.h"
 
 #include <cmath>
+#include <map>
+#include <utility>
 
 namespace ns3
 {
@@ -117,6 +119,35 @@ LrWpanSpectrumValueHelper::CreateNoisePowerSpectralDensity(uint32_t channel)
     return noisePsd;
 }
 
+Ptr<SpectrumValue>
+LrWpanSpectrumValueHelper::GetSharedTxPowerSpectralDensity(double txPower, uint32_t channel)
+{
+    NS_LOG_FUNCTION(txPower << channel);
+    static std::map<std::pair<double, uint32_t>, Ptr<SpectrumValue>> cache;
+
+    Ptr<SpectrumValue>& txPsd = cache[{txPower, channel}];
+    if (!txPsd)
+    {
+        LrWpanSpectrumValueHelper psdHelper;
+        txPsd = psdHelper.CreateTxPowerSpectralDensity(txPower, channel);
+    }
+    return txPsd;
+}
+
+Ptr<const SpectrumValue>
+LrWpanSpectrumValueHelper::GetSharedNoisePowerSpectralDensity(uint32_t channel)
+{
+    NS_LOG_FUNCTION(this << channel);
+    static std::map<std::pair<double, uint32_t>, Ptr<const SpectrumValue>> cache;
+
+    Ptr<const SpectrumValue>& noisePsd = cache[{m_noiseFactor, channel}];
+    if (!noisePsd)
+    {
+        noisePsd = CreateNoisePowerSpectralDensity(channel);
+    }
+    return noisePsd;
+}
+
 void
 LrWpanSpectrumValueHelper::SetNoiseFactor(double f)
 {
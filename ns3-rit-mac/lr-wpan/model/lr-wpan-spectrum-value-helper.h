@@ -44,6 +44,27 @@ class LrWpanSpectrumValueHelper
      */
     Ptr<SpectrumValue> CreateNoisePowerSpectralDensity(uint32_t channel);
 
+    /**
+     * @brief get the transmit PSD of a power and channel from a process-wide cache
+     *
+     * The same object is returned for the same parameters, so that every PHY
+     * transmitting with them shares one PSD. It must not be modified: use
+     * CreateTxPowerSpectralDensity() for a PSD of one's own.
+     *
+     * @param txPower the power transmission in dBm
+     * @param channel the channel number per IEEE802.15.4
+     * @return a Ptr to the shared SpectrumValue instance
+     */
+    static Ptr<SpectrumValue> GetSharedTxPowerSpectralDensity(double txPower, uint32_t channel);
+
+    /**
+     * @brief get the noise PSD of a channel and of the current noise factor from a
+     * process-wide cache (see GetSharedTxPowerSpectralDensity())
+     * @param channel the channel number per IEEE802.15.4
+     * @return a Ptr to the shared SpectrumValue instance
+     */
+    Ptr<const SpectrumValue> GetSharedNoisePowerSpectralDensity(uint32_t channel);
+
     /**
      * Set the noise factor added to the thermal noise.
      * @param f A dimensionless ratio (i.e. Not in dB)
@@ -586,6 +586,94 @@ CCAVulnerableWindowTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup lr-wpan-test
+ * @ingroup tests
+ *
+ * @brief Test a CCA started on an empty channel, with and without a frame
+ * arriving during the CCA window.
+ */
+class LrWpanCcaEmptyChannelTestCase : public TestCase
+{
+  public:
+    /**
+     * @param interfered Whether a frame starts in the middle of the CCA
+     */
+    LrWpanCcaEmptyChannelTestCase(bool interfered);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Receives a PLME-CCA.confirm
+     * @param status The channel state.
+     */
+    void PlmeCcaConfirm(PhyEnumeration status);
+
+    bool m_interfered;       //!< Whether a frame starts during the CCA
+    PhyEnumeration m_status; //!< Reported channel state
+    Time m_confirmTime;      //!< Time of the confirm
+};
+
+LrWpanCcaEmptyChannelTestCase::LrWpanCcaEmptyChannelTestCase(bool interfered)
+    : TestCase(interfered ? "Test a CCA on an empty channel interrupted by a frame"
+                          : "Test a CCA on an empty channel"),
+      m_interfered(interfered),
+      m_status(IEEE_802_15_4_PHY_UNSPECIFIED)
+{
+}
+
+void
+LrWpanCcaEmptyChannelTestCase::PlmeCcaConfirm(PhyEnumeration status)
+{
+    m_status = status;
+    m_confirmTime = Simulator::Now();
+}
+
+void
+LrWpanCcaEmptyChannelTestCase::DoRun()
+{
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    Ptr<LrWpanPhy> sender = CreateObject<LrWpanPhy>();
+    Ptr<LrWpanPhy> receiver = CreateObject<LrWpanPhy>();
+    sender->SetChannel(channel);
+    receiver->SetChannel(channel);
+    channel->AddRx(receiver);
+    sender->SetMobility(CreateObject<ConstantPositionMobilityModel>());
+    receiver->SetMobility(CreateObject<ConstantPositionMobilityModel>());
+    sender->Initialize();
+    receiver->Initialize();
+    receiver->SetPlmeCcaConfirmCallback(
+        MakeCallback(&LrWpanCcaEmptyChannelTestCase::PlmeCcaConfirm, this));
+
+    sender->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_TX_ON);
+    receiver->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_RX_ON);
+
+    Time ccaStart = MilliSeconds(1);
+    Time ccaDuration = Seconds(8.0 / receiver->GetDataOrSymbolRate(false));
+    Simulator::Schedule(ccaStart, &LrWpanPhy::PlmeCcaRequest, receiver);
+    if (m_interfered)
+    {
+        Ptr<Packet> p = Create<Packet>(20);
+        Simulator::Schedule(ccaStart + ccaDuration / 2,
+                            &LrWpanPhy::PdDataRequest,
+                            sender,
+                            p->GetSize(),
+                            p);
+    }
+    Simulator::Stop(MilliSeconds(5));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_status,
+                          (m_interfered ? IEEE_802_15_4_PHY_BUSY : IEEE_802_15_4_PHY_IDLE),
+                          "Wrong CCA result");
+    NS_TEST_EXPECT_MSG_EQ(m_confirmTime, ccaStart + ccaDuration, "CCA not confirmed in time");
+
+    sender->Dispose();
+    receiver->Dispose();
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup lr-wpan-test
  * @ingroup tests
@@ -603,6 +691,8 @@ LrWpanCcaTestSuite::LrWpanCcaTestSuite()
 {
     AddTestCase(new LrWpanCcaTestCase, TestCase::Duration::QUICK);
     AddTestCase(new CCAVulnerableWindowTest, TestCase::Duration::QUICK);
+    AddTestCase(new LrWpanCcaEmptyChannelTestCase(false), TestCase::Duration::QUICK);
+    AddTestCase(new LrWpanCcaEmptyChannelTestCase(true), TestCase::Duration::QUICK);
 }
 
 static LrWpanCcaTestSuite g_lrWpanCcaTestSuite; //!< Static variable for test initialization
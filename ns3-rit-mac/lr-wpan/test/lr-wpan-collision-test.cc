@@ -11,11 +11,14 @@
 #include "ns3/mac16-address.h"
 #include "ns3/mac64-address.h"
 #include "ns3/mobility-module.h"
+#include "ns3/node-container.h"
 #include "ns3/packet.h"
 #include "ns3/propagation-module.h"
 #include "ns3/spectrum-module.h"
 #include "ns3/test.h"
 
+#include <vector>
+
 using namespace ns3;
 using namespace ns3::lrwpan;
 
@@ -202,6 +205,130 @@ LrWpanCollisionTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup lr-wpan-test
+ * @ingroup tests
+ *
+ * @brief Check that the LQI of a frame received under interference is the same in the
+ *        PhyRxEnd trace, in the data indication and in the LQI tag of the frame.
+ */
+class LrWpanCollisionLqiTestCase : public TestCase
+{
+  public:
+    LrWpanCollisionLqiTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Function called when DataIndication is hit.
+     * @param params The MCPS params.
+     * @param p The packet.
+     */
+    void DataIndication(McpsDataIndicationParams params, Ptr<Packet> p);
+
+    /**
+     * @brief Function called at the end of each reception of the PHY.
+     * @param p The packet.
+     * @param lqi The LQI reported.
+     */
+    void PhyRxEnd(Ptr<const Packet> p, double lqi);
+
+    uint8_t m_rxPackets{0};    //!< Rx packets counter.
+    uint8_t m_traceLqi{0};     //!< LQI of the last PhyRxEnd trace.
+    uint8_t m_indicatedLqi{0}; //!< LQI of the last data indication.
+    uint8_t m_taggedLqi{0};    //!< LQI tag of the last packet indicated.
+};
+
+LrWpanCollisionLqiTestCase::LrWpanCollisionLqiTestCase()
+    : TestCase("Test the LQI of a frame received under interference")
+{
+}
+
+void
+LrWpanCollisionLqiTestCase::DataIndication(McpsDataIndicationParams params, Ptr<Packet> p)
+{
+    m_rxPackets++;
+    m_indicatedLqi = params.m_mpduLinkQuality;
+    LrWpanLqiTag tag;
+    NS_TEST_EXPECT_MSG_EQ(p->PeekPacketTag(tag), true, "The received frame has no LQI tag");
+    m_taggedLqi = tag.Get();
+}
+
+void
+LrWpanCollisionLqiTestCase::PhyRxEnd(Ptr<const Packet> p, double lqi)
+{
+    m_traceLqi = static_cast<uint8_t>(lqi);
+}
+
+void
+LrWpanCollisionLqiTestCase::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(3);
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    // The receiver, a sender 1 m away and an interferer 30 m away
+    std::vector<Ptr<LrWpanNetDevice>> devs;
+    const double x[] = {0, 1, 30};
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        Ptr<LrWpanNetDevice> dev = CreateObject<LrWpanNetDevice>();
+        dev->SetAddress(Mac16Address(static_cast<uint16_t>(i + 1)));
+        dev->SetChannel(channel);
+        nodes.Get(i)->AddDevice(dev);
+        Ptr<ConstantPositionMobilityModel> mobility =
+            CreateObject<ConstantPositionMobilityModel>();
+        mobility->SetPosition(Vector(x[i], 0, 0));
+        dev->GetPhy()->SetMobility(mobility);
+        nodes.Get(i)->AggregateObject(mobility);
+        devs.push_back(dev);
+    }
+    devs[0]->GetMac()->SetMcpsDataIndicationCallback(
+        MakeCallback(&LrWpanCollisionLqiTestCase::DataIndication, this));
+    devs[0]->GetPhy()->TraceConnectWithoutContext(
+        "PhyRxEnd",
+        MakeCallback(&LrWpanCollisionLqiTestCase::PhyRxEnd, this));
+
+    McpsDataRequestParams params;
+    params.m_srcAddrMode = SHORT_ADDR;
+    params.m_dstAddrMode = SHORT_ADDR;
+    params.m_dstPanId = 0;
+    params.m_msduHandle = 0;
+    params.m_dstAddr = Mac16Address("00:01");
+
+    // Disable first backoff
+    for (const auto& dev : devs)
+    {
+        dev->GetCsmaCa()->SetMacMinBE(0);
+    }
+
+    // The far interferer starts during the frame: the receiver evaluates the frame in
+    // two chunks, the second one with the interference.
+    Simulator::Schedule(Seconds(0.1),
+                        &LrWpanMac::McpsDataRequest,
+                        devs[1]->GetMac(),
+                        params,
+                        Create<Packet>(60));
+    params.m_dstAddr = Mac16Address("00:02");
+    Simulator::Schedule(Seconds(0.1005),
+                        &LrWpanMac::McpsDataRequest,
+                        devs[2]->GetMac(),
+                        params,
+                        Create<Packet>(100));
+
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_rxPackets, 1, "The near frame was not received");
+    NS_TEST_EXPECT_MSG_GT(m_indicatedLqi, 0, "No LQI indicated");
+    NS_TEST_EXPECT_MSG_EQ(m_indicatedLqi, m_traceLqi, "LQI of the trace and indication differ");
+    NS_TEST_EXPECT_MSG_EQ(m_indicatedLqi, m_taggedLqi, "LQI tag and indication differ");
+
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup lr-wpan-test
  * @ingroup tests
@@ -218,6 +345,7 @@ LrWpanCollisionTestSuite::LrWpanCollisionTestSuite()
     : TestSuite("lr-wpan-collision", Type::UNIT)
 {
     AddTestCase(new LrWpanCollisionTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new LrWpanCollisionLqiTestCase, TestCase::Duration::QUICK);
 }
 
 static LrWpanCollisionTestSuite
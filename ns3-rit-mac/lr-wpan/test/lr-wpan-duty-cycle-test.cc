@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/log.h"
+#include "ns3/lr-wpan-phy.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/single-model-spectrum-channel.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("lr-wpan-duty-cycle-test");
+
+/**
+ * @ingroup lr-wpan-test
+ * @ingroup tests
+ *
+ * @brief Test the cumulative time-in-state counters of LrWpanPhy
+ */
+class LrWpanDutyCycleTestCase : public TestCase
+{
+  public:
+    LrWpanDutyCycleTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Records a duty cycle snapshot
+     * @param counters The cumulative time spent in each state.
+     */
+    void DutyCycleSnapshot(const PhyDutyCycleCounters& counters);
+
+    std::vector<PhyDutyCycleCounters> m_snapshots; //!< Received snapshots
+};
+
+LrWpanDutyCycleTestCase::LrWpanDutyCycleTestCase()
+    : TestCase("Test the LrWpanPhy duty cycle counters")
+{
+}
+
+void
+LrWpanDutyCycleTestCase::DutyCycleSnapshot(const PhyDutyCycleCounters& counters)
+{
+    m_snapshots.push_back(counters);
+}
+
+void
+LrWpanDutyCycleTestCase::DoRun()
+{
+    Ptr<LrWpanPhy> phy = CreateObject<LrWpanPhy>();
+    phy->SetChannel(CreateObject<SingleModelSpectrumChannel>());
+    phy->SetMobility(CreateObject<ConstantPositionMobilityModel>());
+    phy->SetAttribute("DutyCycleSnapshotInterval", TimeValue(Seconds(1)));
+    phy->TraceConnectWithoutContext(
+        "DutyCycleSnapshot",
+        MakeCallback(&LrWpanDutyCycleTestCase::DutyCycleSnapshot, this));
+    phy->Initialize();
+
+    // TRX_OFF <-> TX_ON transitions are immediate
+    Simulator::Schedule(Seconds(1),
+                        &LrWpanPhy::PlmeSetTRXStateRequest,
+                        phy,
+                        IEEE_802_15_4_PHY_TX_ON);
+    Simulator::Schedule(Seconds(3),
+                        &LrWpanPhy::PlmeSetTRXStateRequest,
+                        phy,
+                        IEEE_802_15_4_PHY_TRX_OFF);
+    Simulator::Stop(Seconds(4.5));
+    Simulator::Run();
+
+    PhyDutyCycleCounters counters = phy->GetDutyCycleCounters();
+    NS_TEST_EXPECT_MSG_EQ(counters.trxOff, Seconds(2.5), "Unexpected TRX_OFF time");
+    NS_TEST_EXPECT_MSG_EQ(counters.txOn, Seconds(2), "Unexpected TX_ON time");
+    NS_TEST_EXPECT_MSG_EQ(counters.rxOn, Seconds(0), "Unexpected RX_ON time");
+    NS_TEST_EXPECT_MSG_EQ(counters.GetTotal(), Seconds(4.5), "Counters do not cover the run");
+    NS_TEST_EXPECT_MSG_EQ_TOL(phy->GetWakeRatio(), 2.0 / 4.5, 1e-9, "Unexpected wake ratio");
+
+    NS_TEST_ASSERT_MSG_EQ(m_snapshots.size(), 4, "Expected one snapshot per second");
+    NS_TEST_EXPECT_MSG_EQ(m_snapshots[1].trxOff, Seconds(1), "Unexpected TRX_OFF time at 2 s");
+    NS_TEST_EXPECT_MSG_EQ(m_snapshots[1].txOn, Seconds(1), "Unexpected TX_ON time at 2 s");
+
+    // Disposing the PHY reports the last partial interval
+    phy->Dispose();
+    NS_TEST_ASSERT_MSG_EQ(m_snapshots.size(), 5, "Expected a final snapshot at dispose");
+    NS_TEST_EXPECT_MSG_EQ(m_snapshots[4].GetTotal(), Seconds(4.5), "Final snapshot incomplete");
+
+    phy->ResetDutyCycleCounters();
+    NS_TEST_EXPECT_MSG_EQ(phy->GetDutyCycleCounters().GetTotal(),
+                          Seconds(0),
+                          "Reset did not clear the counters");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup lr-wpan-test
+ * @ingroup tests
+ *
+ * @brief LrWpan PHY duty cycle TestSuite
+ */
+class LrWpanDutyCycleTestSuite : public TestSuite
+{
+  public:
+    LrWpanDutyCycleTestSuite();
+};
+
+LrWpanDutyCycleTestSuite::LrWpanDutyCycleTestSuite()
+    : TestSuite("lr-wpan-duty-cycle", Type::UNIT)
+{
+    AddTestCase(new LrWpanDutyCycleTestCase, TestCase::Duration::QUICK);
+}
+
+static LrWpanDutyCycleTestSuite
+    g_lrWpanDutyCycleTestSuite; //!< Static variable for test initialization
@@ -5,6 +5,7 @@
  *
  * Author: Tom Henderson <thomas.r.henderson@boeing.com>
  */
+#include "ns3/boolean.h"
 #include "ns3/callback.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/log.h"
@@ -75,6 +76,38 @@ class LrWpanErrorModelTestCase : public TestCase
     void DoRun() override;
 };
 
+/**
+ * @ingroup lr-wpan-test
+ * @ingroup tests
+ *
+ * @brief LrWpan Error model lookup table Test
+ */
+class LrWpanErrorModelLookupTableTestCase : public TestCase
+{
+  public:
+    LrWpanErrorModelLookupTableTestCase();
+    ~LrWpanErrorModelLookupTableTestCase() override;
+
+  private:
+    void DoRun() override;
+};
+
+/**
+ * @ingroup lr-wpan-test
+ * @ingroup tests
+ *
+ * @brief LrWpan shared error model release Test
+ */
+class LrWpanErrorModelSharedTestCase : public TestCase
+{
+  public:
+    LrWpanErrorModelSharedTestCase();
+    ~LrWpanErrorModelSharedTestCase() override;
+
+  private:
+    void DoRun() override;
+};
+
 LrWpanErrorDistanceTestCase::LrWpanErrorDistanceTestCase()
     : TestCase("Test the 802.15.4 error model vs distance"),
       m_received(0)
@@ -184,6 +217,68 @@ LrWpanErrorModelTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ_TOL(ber, 0.175, 0.001, "Model fails for SNR = " << snr);
 }
 
+// ==============================================================================
+LrWpanErrorModelLookupTableTestCase::LrWpanErrorModelLookupTableTestCase()
+    : TestCase("Test the 802.15.4 error model lookup table against the exact formula")
+{
+}
+
+LrWpanErrorModelLookupTableTestCase::~LrWpanErrorModelLookupTableTestCase()
+{
+}
+
+void
+LrWpanErrorModelLookupTableTestCase::DoRun()
+{
+    Ptr<LrWpanErrorModel> exact = CreateObject<LrWpanErrorModel>();
+    Ptr<LrWpanErrorModel> table = CreateObject<LrWpanErrorModel>();
+    table->SetAttribute("UseLookupTable", BooleanValue(true));
+
+    // Sweep off-grid SNR values over (and beyond) the table range
+    for (double snrDb = -25.003; snrDb < 20.0; snrDb += 0.0173)
+    {
+        double snr = pow(10.0, snrDb / 10.0);
+        for (uint32_t nbits : {1, 8, 80, 1016})
+        {
+            NS_TEST_ASSERT_MSG_EQ_TOL(table->GetChunkSuccessRate(snr, nbits),
+                                      exact->GetChunkSuccessRate(snr, nbits),
+                                      LrWpanErrorModel::LUT_MAX_ERROR,
+                                      "Table error too large for SNR = " << snrDb << " dB, "
+                                                                         << nbits << " bits");
+        }
+    }
+}
+
+// ==============================================================================
+LrWpanErrorModelSharedTestCase::LrWpanErrorModelSharedTestCase()
+    : TestCase("Test the release of the shared 802.15.4 error model at Simulator::Destroy")
+{
+}
+
+LrWpanErrorModelSharedTestCase::~LrWpanErrorModelSharedTestCase()
+{
+}
+
+void
+LrWpanErrorModelSharedTestCase::DoRun()
+{
+    Ptr<LrWpanErrorModel> first = LrWpanErrorModel::GetShared();
+    NS_TEST_ASSERT_MSG_EQ(LrWpanErrorModel::GetShared(), first, "Instance not shared");
+
+    Simulator::Destroy();
+    NS_TEST_EXPECT_MSG_EQ(first->GetReferenceCount(),
+                          1,
+                          "Shared instance still held after Simulator::Destroy");
+
+    // The next run gets a new instance, released in turn.
+    Ptr<LrWpanErrorModel> second = LrWpanErrorModel::GetShared();
+    NS_TEST_EXPECT_MSG_NE(second, first, "Released instance returned again");
+    Simulator::Destroy();
+    NS_TEST_EXPECT_MSG_EQ(second->GetReferenceCount(),
+                          1,
+                          "Instance of the second run still held after Simulator::Destroy");
+}
+
 /**
  * @ingroup lr-wpan-test
  * @ingroup tests
@@ -201,6 +296,8 @@ LrWpanErrorModelTestSuite::LrWpanErrorModelTestSuite()
 {
     AddTestCase(new LrWpanErrorModelTestCase, TestCase::Duration::QUICK);
     AddTestCase(new LrWpanErrorDistanceTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new LrWpanErrorModelLookupTableTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new LrWpanErrorModelSharedTestCase, TestCase::Duration::QUICK);
 }
 
 static LrWpanErrorModelTestSuite
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+#include "ns3/log.h"
+#include "ns3/lr-wpan-event-profiler.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <sstream>
+#include <string>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("lr-wpan-event-profiler-test");
+
+/**
+ * @ingroup lr-wpan-test
+ * @ingroup tests
+ *
+ * @brief Check the per-node counters, the nested scopes and the outputs of
+ * LrWpanEventProfiler.
+ */
+class LrWpanEventProfilerTestCase : public TestCase
+{
+  public:
+    LrWpanEventProfilerTestCase();
+    ~LrWpanEventProfilerTestCase() override;
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Schedule two outer events on the current node and cancel one of them.
+     */
+    void Start();
+
+    /**
+     * The outer handler, which runs the inner one.
+     */
+    void Outer();
+
+    uint32_t m_outer; //!< Handler id of Outer()
+    uint32_t m_inner; //!< Handler id of the nested handler
+};
+
+LrWpanEventProfilerTestCase::LrWpanEventProfilerTestCase()
+    : TestCase("Event profiler counters and folded stacks")
+{
+}
+
+LrWpanEventProfilerTestCase::~LrWpanEventProfilerTestCase()
+{
+}
+
+void
+LrWpanEventProfilerTestCase::Start()
+{
+    LrWpanEventProfiler::RecordScheduled(m_outer);
+    Simulator::Schedule(MilliSeconds(1), &LrWpanEventProfilerTestCase::Outer, this);
+    LrWpanEventProfiler::RecordScheduled(m_outer);
+    EventId cancelled =
+        Simulator::Schedule(MilliSeconds(2), &LrWpanEventProfilerTestCase::Outer, this);
+    LrWpanEventProfiler::RecordCancelled(m_outer, cancelled);
+    cancelled.Cancel();
+    // Not pending any more: not counted twice
+    LrWpanEventProfiler::RecordCancelled(m_outer, cancelled);
+}
+
+void
+LrWpanEventProfilerTestCase::Outer()
+{
+    LrWpanEventProfiler::Scope profile(m_outer);
+    LrWpanEventProfiler::Scope nested(m_inner);
+}
+
+void
+LrWpanEventProfilerTestCase::DoRun()
+{
+    m_outer = LrWpanEventProfiler::RegisterHandler("ProfilerTest::Outer");
+    m_inner = LrWpanEventProfiler::RegisterHandler("ProfilerTest::Inner");
+    NS_TEST_ASSERT_MSG_EQ(LrWpanEventProfiler::RegisterHandler("ProfilerTest::Outer"),
+                          m_outer,
+                          "A name registered twice must keep its id");
+
+    // Disabled: nothing is counted
+    LrWpanEventProfiler::Reset();
+    Simulator::ScheduleWithContext(3, Seconds(0), &LrWpanEventProfilerTestCase::Start, this);
+    Simulator::Run();
+    NS_TEST_ASSERT_MSG_EQ(LrWpanEventProfiler::GetTotal("ProfilerTest::Outer").scheduled,
+                          0,
+                          "Events counted while disabled");
+
+    LrWpanEventProfiler::Enable();
+    Simulator::ScheduleWithContext(3, Seconds(1), &LrWpanEventProfilerTestCase::Start, this);
+    Simulator::Run();
+    LrWpanEventProfiler::Disable();
+    Simulator::Destroy();
+
+    const auto outer = LrWpanEventProfiler::GetCounters(3, "ProfilerTest::Outer");
+    NS_TEST_EXPECT_MSG_EQ(outer.scheduled, 2, "Wrong number of scheduled events");
+    NS_TEST_EXPECT_MSG_EQ(outer.executed, 1, "Wrong number of executed events");
+    NS_TEST_EXPECT_MSG_EQ(outer.cancelled, 1, "Wrong number of cancelled events");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(outer.wallSeconds,
+                                LrWpanEventProfiler::GetCounters(3, "ProfilerTest::Inner")
+                                    .wallSeconds,
+                                "The outer wall time must include the nested handler");
+    NS_TEST_EXPECT_MSG_EQ(LrWpanEventProfiler::GetCounters(3, "ProfilerTest::Inner").executed,
+                          1,
+                          "Nested handler not counted");
+    NS_TEST_EXPECT_MSG_EQ(LrWpanEventProfiler::GetCounters(4, "ProfilerTest::Outer").scheduled,
+                          0,
+                          "Events counted on the wrong node");
+
+    std::ostringstream table;
+    LrWpanEventProfiler::WriteTable(table);
+    NS_TEST_EXPECT_MSG_NE(table.str().find("\n3,ProfilerTest::Outer,2,1,1,"),
+                          std::string::npos,
+                          "Row of the outer handler missing: " << table.str());
+    std::ostringstream folded;
+    LrWpanEventProfiler::WriteFolded(folded);
+    NS_TEST_EXPECT_MSG_NE(folded.str().find("node-3;ProfilerTest::Outer;ProfilerTest::Inner "),
+                          std::string::npos,
+                          "Nested stack missing: " << folded.str());
+
+    LrWpanEventProfiler::Reset();
+    NS_TEST_EXPECT_MSG_EQ(LrWpanEventProfiler::GetTotal("ProfilerTest::Outer").executed,
+                          0,
+                          "Counters left after Reset()");
+}
+
+/**
+ * @ingroup lr-wpan-test
+ * @ingroup tests
+ *
+ * @brief LrWpan event profiler TestSuite
+ */
+class LrWpanEventProfilerTestSuite : public TestSuite
+{
+  public:
+    LrWpanEventProfilerTestSuite();
+};
+
+LrWpanEventProfilerTestSuite::LrWpanEventProfilerTestSuite()
+    : TestSuite("lr-wpan-event-profiler", Type::UNIT)
+{
+    AddTestCase(new LrWpanEventProfilerTestCase, TestCase::Duration::QUICK);
+}
+
+static LrWpanEventProfilerTestSuite
+    g_lrWpanEventProfilerTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/log.h"
+#include "ns3/lr-wpan-phy.h"
+#include "ns3/nstime.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/single-model-spectrum-channel.h"
+#include "ns3/test.h"
+
+#include <tuple>
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("lr-wpan-fused-trx-test");
+
+/**
+ * @ingroup lr-wpan-test
+ * @ingroup tests
+ *
+ * @brief Check that PdDataRequestThenRxOn produces the same transceiver state sequence
+ * as PLME-SET-TRX-STATE(TX_ON), PD-DATA and PLME-SET-TRX-STATE(RX_ON) issued separately.
+ */
+class LrWpanFusedTrxTestCase : public TestCase
+{
+  public:
+    LrWpanFusedTrxTestCase();
+
+  private:
+    /// A transceiver state change: time, old state and new state
+    using Transition = std::tuple<Time, PhyEnumeration, PhyEnumeration>;
+
+    void DoRun() override;
+
+    /**
+     * Run a single transmission from TRX_OFF.
+     *
+     * @param fused Whether PdDataRequestThenRxOn is used
+     * @return the transceiver state changes of the sender
+     */
+    std::vector<Transition> RunTransmission(bool fused);
+
+    /**
+     * @brief Receives a TrxState trace
+     * @param time The time of the change.
+     * @param oldState The previous state.
+     * @param newState The new state.
+     */
+    void StateChange(Time time, PhyEnumeration oldState, PhyEnumeration newState);
+
+    /**
+     * @brief Receives a PLME-SET-TRX-STATE.confirm
+     * @param status The status.
+     */
+    void SetTrxStateConfirm(PhyEnumeration status);
+
+    /**
+     * @brief Receives a PD-DATA.confirm
+     * @param status The status.
+     */
+    void DataConfirm(PhyEnumeration status);
+
+    Ptr<LrWpanPhy> m_phy;                  //!< The sender PHY
+    Ptr<Packet> m_packet;                  //!< The frame to transmit
+    bool m_sent;                           //!< Whether PdDataRequest was issued
+    uint32_t m_nDataConfirms;              //!< Number of PD-DATA.confirms
+    std::vector<Transition> m_transitions; //!< Recorded state changes
+};
+
+LrWpanFusedTrxTestCase::LrWpanFusedTrxTestCase()
+    : TestCase("Test the fused wake-up, transmission and RX_ON of LrWpanPhy")
+{
+}
+
+void
+LrWpanFusedTrxTestCase::StateChange(Time time, PhyEnumeration oldState, PhyEnumeration newState)
+{
+    m_transitions.emplace_back(time, oldState, newState);
+}
+
+void
+LrWpanFusedTrxTestCase::SetTrxStateConfirm(PhyEnumeration status)
+{
+    if (status == IEEE_802_15_4_PHY_TX_ON && !m_sent)
+    {
+        m_sent = true;
+        m_phy->PdDataRequest(m_packet->GetSize(), m_packet);
+    }
+}
+
+void
+LrWpanFusedTrxTestCase::DataConfirm(PhyEnumeration status)
+{
+    m_nDataConfirms++;
+}
+
+std::vector<LrWpanFusedTrxTestCase::Transition>
+LrWpanFusedTrxTestCase::RunTransmission(bool fused)
+{
+    m_phy = CreateObject<LrWpanPhy>();
+    m_phy->SetChannel(CreateObject<SingleModelSpectrumChannel>());
+    m_phy->SetMobility(CreateObject<ConstantPositionMobilityModel>());
+    m_phy->Initialize();
+    m_packet = Create<Packet>(40);
+    m_sent = false;
+    m_nDataConfirms = 0;
+    m_transitions.clear();
+
+    m_phy->TraceConnectWithoutContext("TrxState",
+                                      MakeCallback(&LrWpanFusedTrxTestCase::StateChange, this));
+    m_phy->SetPdDataConfirmCallback(MakeCallback(&LrWpanFusedTrxTestCase::DataConfirm, this));
+    if (fused)
+    {
+        Simulator::Schedule(MilliSeconds(1), [this]() {
+            NS_TEST_EXPECT_MSG_EQ(m_phy->PdDataRequestThenRxOn(m_packet->GetSize(), m_packet),
+                                  true,
+                                  "Fused request refused in TRX_OFF");
+        });
+    }
+    else
+    {
+        m_phy->SetPlmeSetTRXStateConfirmCallback(
+            MakeCallback(&LrWpanFusedTrxTestCase::SetTrxStateConfirm, this));
+        Simulator::Schedule(MilliSeconds(1),
+                            &LrWpanPhy::PlmeSetTRXStateRequest,
+                            m_phy,
+                            IEEE_802_15_4_PHY_TX_ON);
+        // RX_ON is requested while the frame is still on the air, as RitWpanMac does.
+        Simulator::Schedule(MicroSeconds(1500),
+                            &LrWpanPhy::PlmeSetTRXStateRequest,
+                            m_phy,
+                            IEEE_802_15_4_PHY_RX_ON);
+    }
+    Simulator::Stop(MilliSeconds(10));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_nDataConfirms, 1, "Expected one PD-DATA.confirm");
+    NS_TEST_EXPECT_MSG_EQ(m_phy->GetTrxState(), IEEE_802_15_4_PHY_RX_ON, "Receiver not on");
+
+    m_phy->Dispose();
+    m_phy = nullptr;
+    Simulator::Destroy();
+    return m_transitions;
+}
+
+void
+LrWpanFusedTrxTestCase::DoRun()
+{
+    std::vector<Transition> separate = RunTransmission(false);
+    std::vector<Transition> fused = RunTransmission(true);
+
+    NS_TEST_ASSERT_MSG_EQ(separate.size(), 3, "Expected TX_ON, BUSY_TX and RX_ON");
+    NS_TEST_ASSERT_MSG_EQ(fused.size(), separate.size(), "Different number of state changes");
+    for (size_t i = 0; i < separate.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(std::get<0>(fused[i]), std::get<0>(separate[i]), "Wrong time");
+        NS_TEST_EXPECT_MSG_EQ(std::get<1>(fused[i]), std::get<1>(separate[i]), "Wrong old state");
+        NS_TEST_EXPECT_MSG_EQ(std::get<2>(fused[i]), std::get<2>(separate[i]), "Wrong new state");
+    }
+}
+
+/**
+ * @ingroup lr-wpan-test
+ * @ingroup tests
+ *
+ * @brief LrWpan PHY fused TRX state transition TestSuite
+ */
+class LrWpanFusedTrxTestSuite : public TestSuite
+{
+  public:
+    LrWpanFusedTrxTestSuite();
+};
+
+LrWpanFusedTrxTestSuite::LrWpanFusedTrxTestSuite()
+    : TestSuite("lr-wpan-fused-trx", Type::UNIT)
+{
+    AddTestCase(new LrWpanFusedTrxTestCase, TestCase::Duration::QUICK);
+}
+
+static LrWpanFusedTrxTestSuite
+    g_lrWpanFusedTrxTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/log.h"
+#include "ns3/lr-wpan-mac-base.h"
+#include "ns3/lr-wpan-mac-header.h"
+#include "ns3/lr-wpan-phy.h"
+#include "ns3/mac16-address.h"
+#include "ns3/nstime.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/single-model-spectrum-channel.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("lr-wpan-header-indication-test");
+
+/**
+ * @ingroup lr-wpan-test
+ * @ingroup tests
+ *
+ * @brief Test the MAC header indication of LrWpanPhy and the early drop of a frame
+ */
+class LrWpanHeaderIndicationTestCase : public TestCase
+{
+  public:
+    /**
+     * @param accept Whether the header callback accepts the frame
+     */
+    LrWpanHeaderIndicationTestCase(bool accept);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Receives a PdData indication
+     * @param psduLength The PSDU length.
+     * @param p The packet.
+     * @param lqi The LQI.
+     */
+    void ReceivePdDataIndication(uint32_t psduLength, Ptr<Packet> p, uint8_t lqi);
+
+    /**
+     * @brief Receives a MAC header indication
+     * @param p The packet.
+     * @param macHdr The MAC header.
+     * @param remaining The remaining duration of the frame.
+     * @return m_accept
+     */
+    bool ReceiveHeaderIndication(Ptr<const Packet> p,
+                                 const LrWpanMacHeader& macHdr,
+                                 Time remaining);
+
+    /**
+     * @brief Receives a PhyRxEnd trace
+     * @param p The packet.
+     * @param lqi The LQI.
+     */
+    void ReceiveRxEnd(Ptr<const Packet> p, double lqi);
+
+    /**
+     * @brief Receives a PhyRxDrop trace
+     * @param p The packet.
+     */
+    void ReceiveRxDrop(Ptr<const Packet> p);
+
+    /**
+     * @brief Receives a PhyRxHeaderDrop trace
+     * @param p The packet.
+     * @param remaining The remaining duration of the frame.
+     */
+    void ReceiveRxHeaderDrop(Ptr<const Packet> p, Time remaining);
+
+    bool m_accept;              //!< Return value of the header callback
+    uint32_t m_nIndications;    //!< Number of PD-DATA.indications
+    uint32_t m_nHeaders;        //!< Number of header indications
+    uint32_t m_nRxEnd;          //!< Number of PhyRxEnd traces
+    uint32_t m_nRxDrop;         //!< Number of PhyRxDrop traces
+    uint32_t m_nRxHeaderDrop;   //!< Number of PhyRxHeaderDrop traces
+    Time m_headerTime;          //!< Time of the header indication
+    Time m_remaining;           //!< Remaining duration reported with the header
+    Time m_rxEndTime;           //!< Time of the last PhyRxEnd trace
+    Time m_rxDropTime;          //!< Time of the last PhyRxDrop trace
+    Time m_headerDropRemaining; //!< Remaining duration reported by PhyRxHeaderDrop
+    Mac16Address m_dstAddr;     //!< Destination address reported with the header
+};
+
+LrWpanHeaderIndicationTestCase::LrWpanHeaderIndicationTestCase(bool accept)
+    : TestCase(accept ? "Test a frame accepted after its MAC header"
+                      : "Test a frame dropped after its MAC header"),
+      m_accept(accept),
+      m_nIndications(0),
+      m_nHeaders(0),
+      m_nRxEnd(0),
+      m_nRxDrop(0),
+      m_nRxHeaderDrop(0)
+{
+}
+
+void
+LrWpanHeaderIndicationTestCase::ReceivePdDataIndication(uint32_t psduLength,
+                                                        Ptr<Packet> p,
+                                                        uint8_t lqi)
+{
+    m_nIndications++;
+}
+
+bool
+LrWpanHeaderIndicationTestCase::ReceiveHeaderIndication(Ptr<const Packet> p,
+                                                        const LrWpanMacHeader& macHdr,
+                                                        Time remaining)
+{
+    m_nHeaders++;
+    m_headerTime = Simulator::Now();
+    m_remaining = remaining;
+    m_dstAddr = macHdr.GetShortDstAddr();
+    return m_accept;
+}
+
+void
+LrWpanHeaderIndicationTestCase::ReceiveRxEnd(Ptr<const Packet> p, double lqi)
+{
+    m_nRxEnd++;
+    m_rxEndTime = Simulator::Now();
+}
+
+void
+LrWpanHeaderIndicationTestCase::ReceiveRxDrop(Ptr<const Packet> p)
+{
+    m_nRxDrop++;
+    m_rxDropTime = Simulator::Now();
+}
+
+void
+LrWpanHeaderIndicationTestCase::ReceiveRxHeaderDrop(Ptr<const Packet> p, Time remaining)
+{
+    m_nRxHeaderDrop++;
+    m_headerDropRemaining = remaining;
+}
+
+void
+LrWpanHeaderIndicationTestCase::DoRun()
+{
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    Ptr<LrWpanPhy> sender = CreateObject<LrWpanPhy>();
+    Ptr<LrWpanPhy> receiver = CreateObject<LrWpanPhy>();
+    sender->SetChannel(channel);
+    receiver->SetChannel(channel);
+    channel->AddRx(receiver);
+    sender->SetMobility(CreateObject<ConstantPositionMobilityModel>());
+    receiver->SetMobility(CreateObject<ConstantPositionMobilityModel>());
+    sender->Initialize();
+    receiver->Initialize();
+
+    receiver->SetPdDataIndicationCallback(
+        MakeCallback(&LrWpanHeaderIndicationTestCase::ReceivePdDataIndication, this));
+    receiver->SetPdHeaderIndicationCallback(
+        MakeCallback(&LrWpanHeaderIndicationTestCase::ReceiveHeaderIndication, this));
+    receiver->TraceConnectWithoutContext(
+        "PhyRxEnd",
+        MakeCallback(&LrWpanHeaderIndicationTestCase::ReceiveRxEnd, this));
+    receiver->TraceConnectWithoutContext(
+        "PhyRxDrop",
+        MakeCallback(&LrWpanHeaderIndicationTestCase::ReceiveRxDrop, this));
+    receiver->TraceConnectWithoutContext(
+        "PhyRxHeaderDrop",
+        MakeCallback(&LrWpanHeaderIndicationTestCase::ReceiveRxHeaderDrop, this));
+
+    LrWpanMacHeader macHdr(LrWpanMacHeader::LRWPAN_MAC_DATA, 1);
+    macHdr.SetDstAddrMode(SHORT_ADDR);
+    macHdr.SetSrcAddrMode(SHORT_ADDR);
+    macHdr.SetDstAddrFields(0x1234, Mac16Address("00:02"));
+    macHdr.SetSrcAddrFields(0x1234, Mac16Address("00:01"));
+    Ptr<Packet> p = Create<Packet>(50);
+    p->AddHeader(macHdr);
+
+    sender->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_TX_ON);
+    receiver->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_RX_ON);
+    Time txStart = MilliSeconds(1);
+    Simulator::Schedule(txStart, &LrWpanPhy::PdDataRequest, sender, p->GetSize(), p);
+    Simulator::Stop(MilliSeconds(10));
+    Simulator::Run();
+
+    double bitRate = receiver->GetDataOrSymbolRate(true);
+    Time headerDuration = Seconds((6 + macHdr.GetSerializedSize()) * 8.0 / bitRate);
+    Time frameDuration = Seconds((6 + p->GetSize()) * 8.0 / bitRate);
+
+    NS_TEST_ASSERT_MSG_EQ(m_nHeaders, 1, "Expected one header indication");
+    NS_TEST_EXPECT_MSG_EQ(m_dstAddr, Mac16Address("00:02"), "Wrong MAC header");
+    NS_TEST_EXPECT_MSG_EQ_TOL(m_headerTime,
+                              txStart + headerDuration,
+                              NanoSeconds(1),
+                              "Header indication not at the end of the MHR");
+    NS_TEST_EXPECT_MSG_EQ_TOL(m_remaining,
+                              frameDuration - headerDuration,
+                              NanoSeconds(1),
+                              "Wrong remaining frame duration");
+
+    // Each frame ends its reception exactly once, a dropped one at its header
+    NS_TEST_EXPECT_MSG_EQ(m_nRxEnd, 1, "Expected one PhyRxEnd");
+    PhyDutyCycleCounters counters = receiver->GetDutyCycleCounters();
+    if (m_accept)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_nIndications, 1, "Accepted frame not indicated");
+        NS_TEST_EXPECT_MSG_EQ(m_nRxDrop, 0, "Accepted frame dropped");
+        NS_TEST_EXPECT_MSG_EQ(m_nRxHeaderDrop, 0, "Accepted frame dropped after its header");
+        NS_TEST_EXPECT_MSG_EQ_TOL(m_rxEndTime,
+                                  txStart + frameDuration,
+                                  NanoSeconds(1),
+                                  "PhyRxEnd not at the end of the frame");
+        NS_TEST_EXPECT_MSG_EQ_TOL(counters.busyRx,
+                                  frameDuration,
+                                  NanoSeconds(1),
+                                  "Receiver not busy for the whole frame");
+    }
+    else
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_nIndications, 0, "Dropped frame indicated");
+        NS_TEST_EXPECT_MSG_EQ(m_nRxHeaderDrop, 1, "Header drop not traced");
+        NS_TEST_EXPECT_MSG_EQ(m_nRxDrop, 1, "Dropped frame not traced as PhyRxDrop");
+        NS_TEST_EXPECT_MSG_EQ(m_headerDropRemaining,
+                              m_remaining,
+                              "Header drop traced with a wrong remaining duration");
+        NS_TEST_EXPECT_MSG_EQ(m_rxEndTime, m_headerTime, "PhyRxEnd not at the header drop");
+        NS_TEST_EXPECT_MSG_EQ(m_rxDropTime, m_headerTime, "PhyRxDrop not at the header drop");
+        NS_TEST_EXPECT_MSG_EQ_TOL(counters.busyRx,
+                                  headerDuration,
+                                  NanoSeconds(1),
+                                  "Receiver busy after the header");
+    }
+
+    sender->Dispose();
+    receiver->Dispose();
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup lr-wpan-test
+ * @ingroup tests
+ *
+ * @brief LrWpan PHY MAC header indication TestSuite
+ */
+class LrWpanHeaderIndicationTestSuite : public TestSuite
+{
+  public:
+    LrWpanHeaderIndicationTestSuite();
+};
+
+LrWpanHeaderIndicationTestSuite::LrWpanHeaderIndicationTestSuite()
+    : TestSuite("lr-wpan-header-indication", Type::UNIT)
+{
+    AddTestCase(new LrWpanHeaderIndicationTestCase(true), TestCase::Duration::QUICK);
+    AddTestCase(new LrWpanHeaderIndicationTestCase(false), TestCase::Duration::QUICK);
+}
+
+static LrWpanHeaderIndicationTestSuite
+    g_lrWpanHeaderIndicationTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+#include "ns3/log.h"
+#include "ns3/lr-wpan-interference-helper.h"
+#include "ns3/lr-wpan-spectrum-signal-parameters.h"
+#include "ns3/lr-wpan-spectrum-value-helper.h"
+#include "ns3/packet-burst.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+/**
+ * @ingroup lr-wpan-test
+ * @ingroup tests
+ *
+ * @brief Check that the running in-band power of LrWpanInterferenceHelper
+ * matches the integration of the accumulated PSD.
+ */
+class LrWpanInterferenceHelperTestCase : public TestCase
+{
+  public:
+    LrWpanInterferenceHelperTestCase();
+    ~LrWpanInterferenceHelperTestCase() override;
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Compare the running total against TotalAvgPower(GetSignalPsd()).
+     *
+     * @param helper the interference helper
+     * @param channel the channel used by the helper
+     * @param msg the test message
+     */
+    void CheckTotal(Ptr<LrWpanInterferenceHelper> helper, uint32_t channel, std::string msg);
+};
+
+LrWpanInterferenceHelperTestCase::LrWpanInterferenceHelperTestCase()
+    : TestCase("Test the incremental in-band power of the 802.15.4 interference helper")
+{
+}
+
+LrWpanInterferenceHelperTestCase::~LrWpanInterferenceHelperTestCase()
+{
+}
+
+void
+LrWpanInterferenceHelperTestCase::CheckTotal(Ptr<LrWpanInterferenceHelper> helper,
+                                             uint32_t channel,
+                                             std::string msg)
+{
+    double expected = LrWpanSpectrumValueHelper::TotalAvgPower(helper->GetSignalPsd(), channel);
+    NS_TEST_ASSERT_MSG_EQ_TOL(helper->GetInBandPower(), expected, expected * 1e-9 + 1e-30, msg);
+}
+
+void
+LrWpanInterferenceHelperTestCase::DoRun()
+{
+    LrWpanSpectrumValueHelper psdHelper;
+    Ptr<SpectrumValue> noise = psdHelper.CreateNoisePowerSpectralDensity(11);
+    Ptr<LrWpanInterferenceHelper> helper =
+        Create<LrWpanInterferenceHelper>(noise->GetSpectrumModel());
+    helper->SetChannel(11);
+
+    // Signals on the current channel and on neighbouring channels
+    std::vector<Ptr<SpectrumValue>> signals;
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        signals.push_back(psdHelper.CreateTxPowerSpectralDensity(-10.0 - 5.0 * i, 11 + (i % 3)));
+    }
+
+    for (const auto& signal : signals)
+    {
+        NS_TEST_ASSERT_MSG_EQ(helper->AddSignal(signal), true, "Signal not added");
+        CheckTotal(helper, 11, "Wrong total after AddSignal");
+    }
+    NS_TEST_ASSERT_MSG_EQ(helper->AddSignal(signals[0]), false, "Signal added twice");
+    CheckTotal(helper, 11, "Duplicate AddSignal changed the total");
+
+    NS_TEST_ASSERT_MSG_EQ(helper->RemoveSignal(signals[2]), true, "Signal not removed");
+    NS_TEST_ASSERT_MSG_EQ(helper->RemoveSignal(signals[2]), false, "Signal removed twice");
+    CheckTotal(helper, 11, "Wrong total after RemoveSignal");
+
+    helper->SetChannel(12);
+    CheckTotal(helper, 12, "Wrong total after SetChannel");
+
+    for (const auto& signal : signals)
+    {
+        helper->RemoveSignal(signal);
+    }
+    NS_TEST_ASSERT_MSG_EQ(helper->GetInBandPower(), 0.0, "Empty helper has residual power");
+
+    helper->AddSignal(signals[1]);
+    helper->ClearSignals();
+    NS_TEST_ASSERT_MSG_EQ(helper->GetInBandPower(), 0.0, "ClearSignals left power");
+
+    // Receptions sharing the cached transmit PSD are told apart by their identifier
+    Ptr<SpectrumValue> shared = LrWpanSpectrumValueHelper::GetSharedTxPowerSpectralDensity(0, 12);
+    NS_TEST_ASSERT_MSG_EQ(LrWpanSpectrumValueHelper::GetSharedTxPowerSpectralDensity(0, 12),
+                          shared,
+                          "Transmit PSD not shared");
+    const int rx[2] = {0, 1};
+    const double power = LrWpanSpectrumValueHelper::TotalAvgPower(shared, 12);
+    NS_TEST_ASSERT_MSG_EQ(helper->AddSignal(&rx[0], shared, power * 0.5, 0.5), true, "Not added");
+    NS_TEST_ASSERT_MSG_EQ(helper->AddSignal(&rx[1], shared, power * 0.25, 0.25), true, "Not added");
+    CheckTotal(helper, 12, "Wrong total of the shared PSD");
+    NS_TEST_ASSERT_MSG_EQ(helper->RemoveSignal(&rx[0]), true, "Signal not removed");
+    NS_TEST_ASSERT_MSG_EQ(helper->RemoveSignal(&rx[0]), false, "Signal removed twice");
+    CheckTotal(helper, 12, "Wrong total after removing one of the shared PSD");
+    NS_TEST_ASSERT_MSG_EQ(helper->IsEmpty(), false, "Both signals of the shared PSD removed");
+    NS_TEST_ASSERT_MSG_EQ(helper->RemoveSignal(&rx[1]), true, "Signal not removed");
+    NS_TEST_ASSERT_MSG_EQ(helper->IsEmpty(), true, "Signal left");
+}
+
+/**
+ * @ingroup lr-wpan-test
+ * @ingroup tests
+ *
+ * @brief Check the in-band power cached on LrWpanSpectrumSignalParameters: one
+ * integration per channel, the path gain applied, a fresh cache on every copy, and
+ * the same interference total as the integration by the helper.
+ */
+class LrWpanSignalInBandPowerTestCase : public TestCase
+{
+  public:
+    LrWpanSignalInBandPowerTestCase();
+    ~LrWpanSignalInBandPowerTestCase() override;
+
+  private:
+    void DoRun() override;
+};
+
+LrWpanSignalInBandPowerTestCase::LrWpanSignalInBandPowerTestCase()
+    : TestCase("Test the in-band power cached on the 802.15.4 signal parameters")
+{
+}
+
+LrWpanSignalInBandPowerTestCase::~LrWpanSignalInBandPowerTestCase()
+{
+}
+
+void
+LrWpanSignalInBandPowerTestCase::DoRun()
+{
+    LrWpanSpectrumValueHelper psdHelper;
+    Ptr<SpectrumValue> strong = psdHelper.CreateTxPowerSpectralDensity(0.0, 11);
+    Ptr<SpectrumValue> weak = psdHelper.CreateTxPowerSpectralDensity(-20.0, 11);
+    const double strongPower = LrWpanSpectrumValueHelper::TotalAvgPower(strong, 11);
+    const double weakPower = LrWpanSpectrumValueHelper::TotalAvgPower(weak, 11);
+
+    Ptr<LrWpanSpectrumSignalParameters> params = Create<LrWpanSpectrumSignalParameters>();
+    params->psd = strong;
+    params->packetBurst = Create<PacketBurst>();
+    NS_TEST_ASSERT_MSG_EQ(params->inBandPower < 0.0, true, "Power cached before the first call");
+    NS_TEST_ASSERT_MSG_EQ_TOL(params->GetInBandPower(11),
+                              strongPower,
+                              strongPower * 1e-12,
+                              "Wrong in-band power");
+
+    // Cached: a later change of psd is not integrated again on the same channel
+    params->psd = weak;
+    NS_TEST_ASSERT_MSG_EQ(params->GetInBandPower(11), params->inBandPower, "Cache not used");
+    NS_TEST_ASSERT_MSG_EQ_TOL(params->GetInBandPower(11),
+                              strongPower,
+                              strongPower * 1e-12,
+                              "Power integrated again");
+    NS_TEST_ASSERT_MSG_EQ_TOL(params->GetInBandPower(12),
+                              LrWpanSpectrumValueHelper::TotalAvgPower(weak, 12),
+                              weakPower * 1e-12 + 1e-30,
+                              "Not integrated again on another channel");
+    NS_TEST_ASSERT_MSG_EQ(params->inBandChannel, 12, "Wrong channel of the cached power");
+
+    // Each receiver's copy integrates its own PSD and path gain
+    Ptr<LrWpanSpectrumSignalParameters> copy =
+        DynamicCast<LrWpanSpectrumSignalParameters>(params->Copy());
+    NS_TEST_ASSERT_MSG_EQ(copy->inBandPower < 0.0, true, "Cache copied");
+    NS_TEST_ASSERT_MSG_EQ_TOL(copy->GetInBandPower(11),
+                              weakPower,
+                              weakPower * 1e-12,
+                              "Wrong in-band power of the copy");
+    Ptr<LrWpanSpectrumSignalParameters> narrowband = params->CopyWithGain(0.5);
+    NS_TEST_ASSERT_MSG_EQ_TOL(narrowband->GetInBandPower(11),
+                              0.5 * weakPower,
+                              weakPower * 1e-12,
+                              "Path gain not applied");
+
+    // The cached power gives the same interference as the integration by the helper
+    Ptr<LrWpanInterferenceHelper> integrated =
+        Create<LrWpanInterferenceHelper>(strong->GetSpectrumModel());
+    Ptr<LrWpanInterferenceHelper> cached =
+        Create<LrWpanInterferenceHelper>(strong->GetSpectrumModel());
+    integrated->SetChannel(11);
+    cached->SetChannel(11);
+    NS_TEST_ASSERT_MSG_EQ(integrated->AddSignal(strong), true, "Signal not added");
+    NS_TEST_ASSERT_MSG_EQ(integrated->AddSignal(weak), true, "Signal not added");
+    NS_TEST_ASSERT_MSG_EQ(cached->AddSignal(strong, strongPower), true, "Signal not added");
+    NS_TEST_ASSERT_MSG_EQ(cached->AddSignal(weak, copy->GetInBandPower(cached->GetChannel())),
+                          true,
+                          "Signal not added");
+    NS_TEST_ASSERT_MSG_EQ_TOL(cached->GetInBandPower(),
+                              integrated->GetInBandPower(),
+                              integrated->GetInBandPower() * 1e-12,
+                              "Cached power differs from the integration");
+    NS_TEST_ASSERT_MSG_EQ(cached->RemoveSignal(weak), true, "Signal not removed");
+    NS_TEST_ASSERT_MSG_EQ_TOL(cached->GetInBandPower(),
+                              strongPower,
+                              strongPower * 1e-9,
+                              "Wrong total after removing the cached signal");
+}
+
+/**
+ * @ingroup lr-wpan-test
+ * @ingroup tests
+ *
+ * @brief LrWpan interference helper TestSuite
+ */
+class LrWpanInterferenceHelperTestSuite : public TestSuite
+{
+  public:
+    LrWpanInterferenceHelperTestSuite();
+};
+
+LrWpanInterferenceHelperTestSuite::LrWpanInterferenceHelperTestSuite()
+    : TestSuite("lr-wpan-interference-helper", Type::UNIT)
+{
+    AddTestCase(new LrWpanInterferenceHelperTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new LrWpanSignalInBandPowerTestCase, TestCase::Duration::QUICK);
+}
+
+static LrWpanInterferenceHelperTestSuite
+    g_lrWpanInterferenceHelperTestSuite; //!< Static variable for test initialization
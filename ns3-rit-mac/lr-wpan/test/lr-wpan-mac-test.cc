@@ -17,6 +17,7 @@
 #include "ns3/single-model-spectrum-channel.h"
 
 #include <iostream>
+#include <vector>
 
 using namespace ns3;
 using namespace ns3::lrwpan;
@@ -703,6 +704,262 @@ TestOrphanScan::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup lr-wpan-test
+ * @ingroup tests
+ *
+ * @brief LrWpanMac with its pending transaction list (indirect transmissions) accessible.
+ */
+class PendingListTestMac : public LrWpanMac
+{
+  public:
+    using LrWpanMac::DequeueInd;
+    using LrWpanMac::EnqueueInd;
+    using LrWpanMac::IndTxQueueElement;
+    using LrWpanMac::RemovePendTxQElement;
+};
+
+/**
+ * @ingroup lr-wpan-test
+ * @ingroup tests
+ *
+ * @brief Test the pending transaction list: destinations served in FIFO order, removal of
+ * the sent frame and purge of the expired transactions in expiry order.
+ */
+class TestPendingTransactionList : public TestCase
+{
+  public:
+    TestPendingTransactionList();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Build a data frame of the pending transaction list.
+     *
+     * @param dst The destination address (Mac16Address or Mac64Address)
+     * @param seqNum The sequence number of the frame
+     * @return the frame
+     */
+    static Ptr<Packet> MakeFrame(const Address& dst, uint8_t seqNum);
+
+    /**
+     * Dequeue the oldest transaction of a destination.
+     *
+     * @param dst The extended destination address
+     * @return the sequence number of the transaction, -1 if none is pending
+     */
+    int DequeueSeqNum(Mac64Address dst);
+
+    Ptr<PendingListTestMac> m_mac;  //!< The MAC under test
+    std::vector<uint8_t> m_dropped; //!< Sequence numbers of the expired transactions
+    uint32_t m_nDequeued{0};        //!< Transactions dequeued or removed
+    uint32_t m_nExpiredConfirms{0}; //!< MCPS-DATA.confirm with TRANSACTION_EXPIRED
+};
+
+TestPendingTransactionList::TestPendingTransactionList()
+    : TestCase("Test the destination FIFOs and the expiry of the pending transaction list")
+{
+}
+
+Ptr<Packet>
+TestPendingTransactionList::MakeFrame(const Address& dst, uint8_t seqNum)
+{
+    LrWpanMacHeader macHdr(LrWpanMacHeader::LRWPAN_MAC_DATA, seqNum);
+    macHdr.SetSrcAddrMode(LrWpanMacHeader::EXTADDR);
+    macHdr.SetSrcAddrFields(1, Mac64Address("00:00:00:00:00:00:00:ff"));
+    if (Mac16Address::IsMatchingType(dst))
+    {
+        macHdr.SetDstAddrMode(LrWpanMacHeader::SHORTADDR);
+        macHdr.SetDstAddrFields(1, Mac16Address::ConvertFrom(dst));
+    }
+    else
+    {
+        macHdr.SetDstAddrMode(LrWpanMacHeader::EXTADDR);
+        macHdr.SetDstAddrFields(1, Mac64Address::ConvertFrom(dst));
+    }
+    macHdr.SetPanIdComp();
+    Ptr<Packet> p = Create<Packet>(10);
+    p->AddHeader(macHdr);
+    return p;
+}
+
+int
+TestPendingTransactionList::DequeueSeqNum(Mac64Address dst)
+{
+    Ptr<PendingListTestMac::IndTxQueueElement> entry =
+        Create<PendingListTestMac::IndTxQueueElement>();
+    return m_mac->DequeueInd(dst, entry) ? entry->seqNum : -1;
+}
+
+void
+TestPendingTransactionList::DoRun()
+{
+    // Non-beacon enabled: the transactions persist 500 * 960 symbols, 7.68 s at 2.4 GHz
+    m_mac = CreateObject<PendingListTestMac>();
+    m_mac->SetPhy(CreateObject<LrWpanPhy>());
+    m_mac->TraceConnectWithoutContext(
+        "MacIndTxDrop",
+        Callback<void, Ptr<const Packet>>([this](Ptr<const Packet> p) {
+            LrWpanMacHeader macHdr;
+            p->PeekHeader(macHdr);
+            m_dropped.push_back(macHdr.GetSeqNum());
+        }));
+    m_mac->TraceConnectWithoutContext(
+        "MacIndTxDequeue",
+        Callback<void, Ptr<const Packet>>([this](Ptr<const Packet>) { m_nDequeued++; }));
+    m_mac->SetMcpsDataConfirmCallback(
+        Callback<void, McpsDataConfirmParams>([this](McpsDataConfirmParams params) {
+            if (params.m_status == MacStatus::TRANSACTION_EXPIRED)
+            {
+                m_nExpiredConfirms++;
+            }
+        }));
+
+    const Mac64Address dev1("00:00:00:00:00:00:00:01");
+    const Mac64Address dev2("00:00:00:00:00:00:00:02");
+    const Mac16Address shortDev("00:05");
+
+    Simulator::Schedule(Seconds(0), [this, dev1, dev2, shortDev]() {
+        m_mac->EnqueueInd(MakeFrame(dev1, 1));
+        m_mac->EnqueueInd(MakeFrame(dev2, 2));
+        m_mac->EnqueueInd(MakeFrame(dev1, 3));
+        m_mac->EnqueueInd(MakeFrame(shortDev, 4));
+        m_mac->EnqueueInd(MakeFrame(shortDev, 5));
+    });
+    Simulator::Schedule(Seconds(1), [this, dev1, shortDev]() {
+        NS_TEST_EXPECT_MSG_EQ(DequeueSeqNum(dev1), 1, "Oldest transaction not dequeued first");
+        NS_TEST_EXPECT_MSG_EQ(DequeueSeqNum(dev1), 3, "Second transaction not dequeued");
+        NS_TEST_EXPECT_MSG_EQ(DequeueSeqNum(dev1), -1, "No transaction left for dev1");
+        // The sent frame leaves the list, whatever its place in the FIFO of its destination
+        m_mac->RemovePendTxQElement(MakeFrame(shortDev, 5));
+        m_mac->RemovePendTxQElement(MakeFrame(shortDev, 9));
+        NS_TEST_EXPECT_MSG_EQ(m_nDequeued, 3, "Wrong number of transactions out");
+    });
+    Simulator::Schedule(Seconds(2), [this, dev1]() { m_mac->EnqueueInd(MakeFrame(dev1, 6)); });
+    Simulator::Schedule(Seconds(8), [this, dev1, dev2]() {
+        // Expired: the frames of dev2 and of the short address, in their enqueue order
+        NS_TEST_EXPECT_MSG_EQ(DequeueSeqNum(dev2), -1, "Expired transaction dequeued");
+        NS_TEST_ASSERT_MSG_EQ(m_dropped.size(), 2, "Wrong number of expired transactions");
+        NS_TEST_EXPECT_MSG_EQ(+m_dropped[0], 2, "Wrong first expired transaction");
+        NS_TEST_EXPECT_MSG_EQ(+m_dropped[1], 4, "Wrong second expired transaction");
+        NS_TEST_EXPECT_MSG_EQ(DequeueSeqNum(dev1), 6, "Transaction expired too early");
+    });
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_nExpiredConfirms, 2, "Expired data frames not confirmed");
+    m_mac->Dispose();
+    m_mac = nullptr;
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup lr-wpan-test
+ * @ingroup tests
+ *
+ * @brief Test a beacon-tracking device with RxOnWhenIdle(false): its PHY is in TRX_OFF
+ * during the inactive portion of the incoming superframe and it still receives every beacon.
+ */
+class TestBeaconTrackingRxOffWhenIdle : public TestCase
+{
+  public:
+    TestBeaconTrackingRxOffWhenIdle();
+
+  private:
+    void DoRun() override;
+
+    uint32_t m_nCap{0};                    //!< Incoming CAPs started by the device
+    std::vector<PhyEnumeration> m_samples; //!< PHY states sampled in the inactive portions
+};
+
+TestBeaconTrackingRxOffWhenIdle::TestBeaconTrackingRxOffWhenIdle()
+    : TestCase("Test the device sleeping through the inactive portion of the superframe")
+{
+}
+
+void
+TestBeaconTrackingRxOffWhenIdle::DoRun()
+{
+    // [00:01] PAN coordinator, BO = 6 (0.983 s), SO = 2 (61 ms) from 2 s
+    // [00:02] Device tracking the beacons, receiver off when idle
+    Ptr<Node> n0 = CreateObject<Node>();
+    Ptr<Node> n1 = CreateObject<Node>();
+    Ptr<LrWpanNetDevice> dev0 = CreateObject<LrWpanNetDevice>();
+    Ptr<LrWpanNetDevice> dev1 = CreateObject<LrWpanNetDevice>();
+    dev0->SetAddress(Mac16Address("00:01"));
+    dev1->SetAddress(Mac16Address("00:02"));
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+    dev0->SetChannel(channel);
+    dev1->SetChannel(channel);
+    n0->AddDevice(dev0);
+    n1->AddDevice(dev1);
+
+    Ptr<ConstantPositionMobilityModel> mobility0 = CreateObject<ConstantPositionMobilityModel>();
+    mobility0->SetPosition(Vector(0, 0, 0));
+    dev0->GetPhy()->SetMobility(mobility0);
+    Ptr<ConstantPositionMobilityModel> mobility1 = CreateObject<ConstantPositionMobilityModel>();
+    mobility1->SetPosition(Vector(0, 10, 0));
+    dev1->GetPhy()->SetMobility(mobility1);
+
+    dev1->GetMac()->TraceConnectWithoutContext(
+        "MacIncSuperframeStatus",
+        Callback<void, SuperframeStatus, SuperframeStatus>(
+            [this](SuperframeStatus, SuperframeStatus newValue) {
+                if (newValue == SuperframeStatus::CAP)
+                {
+                    m_nCap++;
+                }
+            }));
+
+    dev1->GetMac()->SetRxOnWhenIdle(false);
+    dev1->GetMac()->SetPanId(5);
+    dev1->GetMac()->SetAssociatedCoor(Mac16Address("00:01"));
+
+    MlmeSyncRequestParams syncParams;
+    syncParams.m_logCh = 11;
+    syncParams.m_trackBcn = true;
+    Simulator::ScheduleWithContext(2,
+                                   Seconds(1),
+                                   &LrWpanMac::MlmeSyncRequest,
+                                   dev1->GetMac(),
+                                   syncParams);
+
+    MlmeStartRequestParams params;
+    params.m_panCoor = true;
+    params.m_PanId = 5;
+    params.m_bcnOrd = 6;
+    params.m_sfrmOrd = 2;
+    Simulator::ScheduleWithContext(1,
+                                   Seconds(2),
+                                   &LrWpanMac::MlmeStartRequest,
+                                   dev0->GetMac(),
+                                   params);
+
+    // Beacons at about 2, 2.983, 3.966 and 4.949 s
+    for (double t : {2.5, 3.5, 4.45})
+    {
+        Simulator::Schedule(Seconds(t),
+                            [this, dev1]() { m_samples.push_back(dev1->GetPhy()->GetTrxState()); });
+    }
+
+    Simulator::Stop(Seconds(5.5));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_nCap, 4, "Beacons missed by the sleeping device");
+    NS_TEST_ASSERT_MSG_EQ(m_samples.size(), 3, "PHY states not sampled");
+    for (PhyEnumeration state : m_samples)
+    {
+        NS_TEST_EXPECT_MSG_EQ(state,
+                              PhyEnumeration::IEEE_802_15_4_PHY_TRX_OFF,
+                              "PHY not in TRX_OFF during the inactive portion");
+    }
+
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup lr-wpan-test
  * @ingroup tests
@@ -721,6 +978,8 @@ LrWpanMacTestSuite::LrWpanMacTestSuite()
     AddTestCase(new TestRxOffWhenIdleAfterCsmaFailure, TestCase::Duration::QUICK);
     AddTestCase(new TestActiveScanPanDescriptors, TestCase::Duration::QUICK);
     AddTestCase(new TestOrphanScan, TestCase::Duration::QUICK);
+    AddTestCase(new TestPendingTransactionList, TestCase::Duration::QUICK);
+    AddTestCase(new TestBeaconTrackingRxOffWhenIdle, TestCase::Duration::QUICK);
 }
 
 static LrWpanMacTestSuite g_lrWpanMacTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,1003 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+#include "ns3/boolean.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/lr-wpan-interference-helper.h"
+#include "ns3/lr-wpan-phy.h"
+#include "ns3/lr-wpan-spectrum-channel.h"
+#include "ns3/lr-wpan-spectrum-signal-parameters.h"
+#include "ns3/lr-wpan-spectrum-value-helper.h"
+#include "ns3/packet-burst.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/simulator.h"
+#include "ns3/spectrum-phy.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/uinteger.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("lr-wpan-spectrum-channel-test");
+
+/**
+ * @ingroup lr-wpan-test
+ * @ingroup tests
+ *
+ * @brief SpectrumPhy counting the signals delivered by the channel
+ */
+class LrWpanCountingPhy : public SpectrumPhy
+{
+  public:
+    void SetDevice(Ptr<NetDevice> d) override
+    {
+    }
+
+    Ptr<NetDevice> GetDevice() const override
+    {
+        return nullptr;
+    }
+
+    void SetMobility(Ptr<MobilityModel> m) override
+    {
+        m_mobility = m;
+    }
+
+    Ptr<MobilityModel> GetMobility() const override
+    {
+        return m_mobility;
+    }
+
+    void SetChannel(Ptr<SpectrumChannel> c) override
+    {
+    }
+
+    Ptr<const SpectrumModel> GetRxSpectrumModel() const override
+    {
+        return nullptr;
+    }
+
+    Ptr<Object> GetAntenna() const override
+    {
+        return nullptr;
+    }
+
+    void StartRx(Ptr<SpectrumSignalParameters> params) override
+    {
+        m_rxCount++;
+        m_rxParams = DynamicCast<LrWpanSpectrumSignalParameters>(params);
+        m_rxPower = m_rxParams->GetInBandPower(11);
+    }
+
+    uint32_t m_rxCount{0};                          //!< Number of delivered signals
+    double m_rxPower{0};                            //!< In-band power of the last signal (W)
+    Ptr<LrWpanSpectrumSignalParameters> m_rxParams; //!< Last delivered signal
+    Ptr<MobilityModel> m_mobility;                  //!< Mobility model
+};
+
+/**
+ * @ingroup lr-wpan-test
+ * @ingroup tests
+ *
+ * @brief LrWpanPhy counting the signals delivered by the channel
+ */
+class LrWpanCountingLrWpanPhy : public LrWpanPhy
+{
+  public:
+    void StartRx(Ptr<SpectrumSignalParameters> params) override
+    {
+        m_rxCount++;
+        LrWpanPhy::StartRx(params);
+    }
+
+    uint32_t m_rxCount{0}; //!< Number of delivered signals
+};
+
+/**
+ * @ingroup lr-wpan-test
+ * @ingroup tests
+ *
+ * @brief Check that LrWpanSpectrumChannel only delivers the signals of receivers in
+ * range and follows the movements of the nodes.
+ */
+class LrWpanSpectrumChannelTestCase : public TestCase
+{
+  public:
+    LrWpanSpectrumChannelTestCase();
+    ~LrWpanSpectrumChannelTestCase() override;
+
+  private:
+    void DoRun() override;
+};
+
+/**
+ * @ingroup lr-wpan-test
+ * @ingroup tests
+ *
+ * @brief Check the path loss cache of LrWpanSpectrumChannel.
+ */
+class LrWpanSpectrumChannelCacheTestCase : public TestCase
+{
+  public:
+    LrWpanSpectrumChannelCacheTestCase();
+    ~LrWpanSpectrumChannelCacheTestCase() override;
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Send one frame from the first PHY at 0 dBm and run the simulation.
+     *
+     * @param channel the channel
+     * @param txPhy the transmitter
+     */
+    void Transmit(Ptr<LrWpanSpectrumChannel> channel, Ptr<SpectrumPhy> txPhy);
+};
+
+/**
+ * @ingroup lr-wpan-test
+ * @ingroup tests
+ *
+ * @brief Check that the narrowband mode of LrWpanSpectrumChannel delivers the same
+ * in-band powers as the per-receiver PSDs.
+ */
+class LrWpanSpectrumChannelNarrowbandTestCase : public TestCase
+{
+  public:
+    LrWpanSpectrumChannelNarrowbandTestCase();
+    ~LrWpanSpectrumChannelNarrowbandTestCase() override;
+
+  private:
+    void DoRun() override;
+};
+
+/**
+ * @ingroup lr-wpan-test
+ * @ingroup tests
+ *
+ * @brief Check that the worker threads of LrWpanSpectrumChannel deliver the same
+ * signals as the sequential path loss computation.
+ */
+class LrWpanSpectrumChannelParallelTestCase : public TestCase
+{
+  public:
+    LrWpanSpectrumChannelParallelTestCase();
+    ~LrWpanSpectrumChannelParallelTestCase() override;
+
+  private:
+    void DoRun() override;
+};
+
+/**
+ * @ingroup lr-wpan-test
+ * @ingroup tests
+ *
+ * @brief Check that the channel filtering of LrWpanSpectrumChannel skips the LrWpanPhy
+ * tuned to another channel, and follows a retuned PHY.
+ */
+class LrWpanSpectrumChannelFilteringTestCase : public TestCase
+{
+  public:
+    LrWpanSpectrumChannelFilteringTestCase();
+    ~LrWpanSpectrumChannelFilteringTestCase() override;
+
+  private:
+    void DoRun() override;
+};
+
+/**
+ * @ingroup lr-wpan-test
+ * @ingroup tests
+ *
+ * @brief Check that the neighbour set updates of a moving PHY, with and without the
+ * grid, leave the receiver lists as a rebuild would.
+ */
+class LrWpanSpectrumChannelMobilityTestCase : public TestCase
+{
+  public:
+    LrWpanSpectrumChannelMobilityTestCase();
+    ~LrWpanSpectrumChannelMobilityTestCase() override;
+
+  private:
+    void DoRun() override;
+};
+
+/**
+ * @ingroup lr-wpan-test
+ * @ingroup tests
+ *
+ * @brief Check that a LrWpanSpectrumChannel split into regions hands the
+ * transmissions over to the other regions instead of delivering them there.
+ */
+class LrWpanSpectrumChannelRegionTestCase : public TestCase
+{
+  public:
+    LrWpanSpectrumChannelRegionTestCase();
+    ~LrWpanSpectrumChannelRegionTestCase() override;
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Record a transmission handed over to another region.
+     *
+     * @param region the region
+     * @param params the signal
+     */
+    void RemoteTx(uint32_t region, Ptr<SpectrumSignalParameters> params);
+
+    std::vector<uint32_t> m_remoteRegions;                 //!< Regions handed a signal
+    std::vector<Ptr<SpectrumSignalParameters>> m_remoteTx; //!< Signals handed over
+};
+
+/**
+ * @ingroup lr-wpan-test
+ * @ingroup tests
+ *
+ * @brief Check that the far-field noise of LrWpanSpectrumChannel matches the mean
+ * interference power of the same traffic delivered as signals, without delivering it.
+ */
+class LrWpanSpectrumChannelFarFieldTestCase : public TestCase
+{
+  public:
+    LrWpanSpectrumChannelFarFieldTestCase();
+    ~LrWpanSpectrumChannelFarFieldTestCase() override;
+
+  private:
+    void DoRun() override;
+};
+
+LrWpanSpectrumChannelTestCase::LrWpanSpectrumChannelTestCase()
+    : TestCase("Test the range culling of the 802.15.4 spectrum channel")
+{
+}
+
+LrWpanSpectrumChannelTestCase::~LrWpanSpectrumChannelTestCase()
+{
+}
+
+void
+LrWpanSpectrumChannelTestCase::DoRun()
+{
+    Ptr<LrWpanSpectrumChannel> channel = CreateObject<LrWpanSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    // Transmitter at the origin, receivers at 10 m and 10 km
+    std::vector<Ptr<LrWpanCountingPhy>> phys;
+    std::vector<Ptr<ConstantPositionMobilityModel>> mobs;
+    for (double x : {0.0, 10.0, 10000.0})
+    {
+        Ptr<LrWpanCountingPhy> phy = CreateObject<LrWpanCountingPhy>();
+        Ptr<ConstantPositionMobilityModel> mob = CreateObject<ConstantPositionMobilityModel>();
+        mob->SetPosition(Vector(x, 0, 0));
+        phy->SetMobility(mob);
+        channel->AddRx(phy);
+        phys.push_back(phy);
+        mobs.push_back(mob);
+    }
+
+    LrWpanSpectrumValueHelper psdHelper;
+    auto transmit = [&]() {
+        Ptr<LrWpanSpectrumSignalParameters> txParams = Create<LrWpanSpectrumSignalParameters>();
+        txParams->duration = MilliSeconds(1);
+        txParams->txPhy = phys[0];
+        txParams->psd = psdHelper.CreateTxPowerSpectralDensity(0.0, 11);
+        txParams->packetBurst = Create<PacketBurst>();
+        channel->StartTx(txParams);
+        Simulator::Run();
+    };
+
+    const uint64_t nListChanges = channel->GetNReceiverListChanges();
+    transmit();
+    NS_TEST_EXPECT_MSG_EQ(channel->GetNReceiverListChanges(),
+                          nListChanges + 1,
+                          "Built list not counted");
+    NS_TEST_EXPECT_MSG_EQ(phys[1]->m_rxCount, 1, "Receiver in range did not get the signal");
+    NS_TEST_EXPECT_MSG_EQ(phys[2]->m_rxCount, 0, "Receiver out of range got the signal");
+    NS_TEST_EXPECT_MSG_EQ(channel->GetNListedReceivers(phys[0]),
+                          2,
+                          "Wrong receiver list (transmitter and near receiver)");
+    std::vector<Ptr<SpectrumPhy>> listed;
+    NS_TEST_EXPECT_MSG_EQ(channel->GetListedReceivers(phys[0], listed), true, "No receiver list");
+    NS_TEST_EXPECT_MSG_EQ((listed.size() == 2 && listed[1] == phys[1]),
+                          true,
+                          "Wrong listed receivers");
+    NS_TEST_EXPECT_MSG_EQ(channel->GetListedReceivers(phys[1], listed),
+                          false,
+                          "Receiver list of a node that never transmitted");
+
+    // Moving the far receiver next to the transmitter adds it to the list
+    mobs[2]->SetPosition(Vector(0, 20, 0));
+    NS_TEST_EXPECT_MSG_EQ(channel->GetNListedReceivers(phys[0]), 3, "Moved receiver not listed");
+    NS_TEST_EXPECT_MSG_GT(channel->GetNReceiverListChanges(),
+                          nListChanges + 1,
+                          "Updated list not counted");
+    transmit();
+    NS_TEST_EXPECT_MSG_EQ(phys[1]->m_rxCount, 2, "Receiver in range did not get the signal");
+    NS_TEST_EXPECT_MSG_EQ(phys[2]->m_rxCount, 1, "Moved receiver did not get the signal");
+
+    // Without culling every receiver gets the signal
+    mobs[2]->SetPosition(Vector(10000, 0, 0));
+    channel->SetAttribute("RangeCulling", BooleanValue(false));
+    transmit();
+    NS_TEST_EXPECT_MSG_EQ(phys[2]->m_rxCount, 2, "Culling not disabled");
+
+    channel->Dispose();
+    Simulator::Destroy();
+}
+
+// ==============================================================================
+LrWpanSpectrumChannelRegionTestCase::LrWpanSpectrumChannelRegionTestCase()
+    : TestCase("Test the regions of the 802.15.4 spectrum channel")
+{
+}
+
+LrWpanSpectrumChannelRegionTestCase::~LrWpanSpectrumChannelRegionTestCase()
+{
+}
+
+void
+LrWpanSpectrumChannelRegionTestCase::RemoteTx(uint32_t region,
+                                              Ptr<SpectrumSignalParameters> params)
+{
+    m_remoteRegions.push_back(region);
+    m_remoteTx.push_back(params);
+}
+
+void
+LrWpanSpectrumChannelRegionTestCase::DoRun()
+{
+    Ptr<LrWpanSpectrumChannel> channel = CreateObject<LrWpanSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    // Transmitter and a receiver in region 0, receivers of regions 2 and 1 in range,
+    // a receiver of region 3 out of range
+    const std::vector<std::pair<double, uint32_t>> placement{{0.0, 0},
+                                                             {10.0, 0},
+                                                             {20.0, 2},
+                                                             {30.0, 1},
+                                                             {10000.0, 3}};
+    std::vector<Ptr<LrWpanCountingPhy>> phys;
+    for (const auto& [x, region] : placement)
+    {
+        Ptr<LrWpanCountingPhy> phy = CreateObject<LrWpanCountingPhy>();
+        Ptr<ConstantPositionMobilityModel> mob = CreateObject<ConstantPositionMobilityModel>();
+        mob->SetPosition(Vector(x, 0, 0));
+        phy->SetMobility(mob);
+        channel->AddRx(phy);
+        channel->SetRegion(phy, region);
+        phys.push_back(phy);
+    }
+    NS_TEST_EXPECT_MSG_EQ(channel->GetRegion(phys[2]), 2, "Wrong region");
+    channel->SetRemoteTxCallback(
+        MakeCallback(&LrWpanSpectrumChannelRegionTestCase::RemoteTx, this));
+
+    LrWpanSpectrumValueHelper psdHelper;
+    auto transmit = [&]() {
+        Ptr<LrWpanSpectrumSignalParameters> txParams = Create<LrWpanSpectrumSignalParameters>();
+        txParams->duration = MilliSeconds(1);
+        txParams->txPhy = phys[0];
+        txParams->psd = psdHelper.CreateTxPowerSpectralDensity(0.0, 11);
+        txParams->packetBurst = Create<PacketBurst>();
+        channel->StartTx(txParams);
+        Simulator::Run();
+    };
+
+    transmit();
+    NS_TEST_EXPECT_MSG_EQ(phys[1]->m_rxCount, 1, "Receiver of the same region missed the signal");
+    NS_TEST_EXPECT_MSG_EQ(phys[2]->m_rxCount, 0, "Signal delivered to another region");
+    NS_TEST_EXPECT_MSG_EQ(phys[3]->m_rxCount, 0, "Signal delivered to another region");
+    NS_TEST_ASSERT_MSG_EQ(m_remoteRegions.size(), 2, "Wrong number of handed over signals");
+    NS_TEST_EXPECT_MSG_EQ(m_remoteRegions[0], 1, "Regions not handed over in order");
+    NS_TEST_EXPECT_MSG_EQ(m_remoteRegions[1], 2, "Regions not handed over in order");
+
+    // The receiving side delivers the signal to its own region only
+    channel->StartRemoteTx(m_remoteTx[1], 2);
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(phys[2]->m_rxCount, 1, "Handed over signal not delivered");
+    NS_TEST_EXPECT_MSG_EQ(phys[3]->m_rxCount, 0, "Signal delivered to another region");
+    NS_TEST_EXPECT_MSG_EQ(phys[1]->m_rxCount, 1, "Signal delivered twice");
+    NS_TEST_EXPECT_MSG_EQ(phys[4]->m_rxCount, 0, "Receiver out of range got the signal");
+
+    // Without the callback every region gets the signal again
+    channel->SetRemoteTxCallback(
+        MakeNullCallback<void, uint32_t, Ptr<SpectrumSignalParameters>>());
+    transmit();
+    NS_TEST_EXPECT_MSG_EQ(phys[3]->m_rxCount, 1, "Regions not merged");
+    NS_TEST_EXPECT_MSG_EQ(m_remoteRegions.size(), 2, "Signal handed over without callback");
+
+    // A process simulating region 1 drops the transmissions of the copies of region 0
+    channel->SetRemoteTxCallback(
+        MakeCallback(&LrWpanSpectrumChannelRegionTestCase::RemoteTx, this));
+    channel->SetLocalRegion(1);
+    transmit();
+    NS_TEST_EXPECT_MSG_EQ(channel->GetNForeignTransmissions(), 1, "Foreign transmission kept");
+    NS_TEST_EXPECT_MSG_EQ(phys[1]->m_rxCount, 2, "Foreign transmission delivered");
+    NS_TEST_EXPECT_MSG_EQ(m_remoteRegions.size(), 2, "Foreign transmission handed over");
+
+    channel->Dispose();
+    Simulator::Destroy();
+}
+
+// ==============================================================================
+LrWpanSpectrumChannelCacheTestCase::LrWpanSpectrumChannelCacheTestCase()
+    : TestCase("Test the path loss cache of the 802.15.4 spectrum channel")
+{
+}
+
+LrWpanSpectrumChannelCacheTestCase::~LrWpanSpectrumChannelCacheTestCase()
+{
+}
+
+void
+LrWpanSpectrumChannelCacheTestCase::Transmit(Ptr<LrWpanSpectrumChannel> channel,
+                                             Ptr<SpectrumPhy> txPhy)
+{
+    LrWpanSpectrumValueHelper psdHelper;
+    Ptr<LrWpanSpectrumSignalParameters> txParams = Create<LrWpanSpectrumSignalParameters>();
+    txParams->duration = MilliSeconds(1);
+    txParams->txPhy = txPhy;
+    txParams->psd = psdHelper.CreateTxPowerSpectralDensity(0.0, 11);
+    txParams->packetBurst = Create<PacketBurst>();
+    channel->StartTx(txParams);
+    Simulator::Run();
+}
+
+void
+LrWpanSpectrumChannelCacheTestCase::DoRun()
+{
+    // The same topology with and without the cache
+    std::vector<Ptr<LrWpanSpectrumChannel>> channels;
+    std::vector<std::vector<Ptr<LrWpanCountingPhy>>> phys(2);
+    std::vector<Ptr<ConstantPositionMobilityModel>> mobs;
+    for (uint32_t c = 0; c < 2; c++)
+    {
+        Ptr<LrWpanSpectrumChannel> channel = CreateObject<LrWpanSpectrumChannel>();
+        channel->SetAttribute("PathLossCache", BooleanValue(c == 1));
+        channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+        channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+        for (double x : {0.0, 15.0, 40.0})
+        {
+            Ptr<LrWpanCountingPhy> phy = CreateObject<LrWpanCountingPhy>();
+            Ptr<ConstantPositionMobilityModel> mob = CreateObject<ConstantPositionMobilityModel>();
+            mob->SetPosition(Vector(x, 0, 0));
+            phy->SetMobility(mob);
+            channel->AddRx(phy);
+            phys[c].push_back(phy);
+            if (c == 1)
+            {
+                mobs.push_back(mob);
+            }
+        }
+        channels.push_back(channel);
+    }
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        Transmit(channels[0], phys[0][0]);
+        Transmit(channels[1], phys[1][0]);
+    }
+    NS_TEST_EXPECT_MSG_EQ(channels[0]->GetPathLossCacheSize(), 0, "Cache used while disabled");
+    NS_TEST_EXPECT_MSG_EQ(channels[1]->GetPathLossCacheSize(), 3, "Wrong number of cached pairs");
+    for (uint32_t j = 1; j < 3; j++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(phys[1][j]->m_rxCount, 3, "Signal not delivered");
+        NS_TEST_EXPECT_MSG_EQ_TOL(phys[1][j]->m_rxPower,
+                                  phys[0][j]->m_rxPower,
+                                  phys[0][j]->m_rxPower * 1e-12,
+                                  "Cached path loss differs");
+    }
+
+    // Moving a node drops its pairs only; the next frame uses the new position
+    mobs[2]->SetPosition(Vector(80, 0, 0));
+    NS_TEST_EXPECT_MSG_EQ(channels[1]->GetPathLossCacheSize(), 2, "Pairs of the node not dropped");
+    double before = phys[1][2]->m_rxPower;
+    Transmit(channels[1], phys[1][0]);
+    NS_TEST_EXPECT_MSG_LT(phys[1][2]->m_rxPower, before, "Stale path loss after the move");
+
+    // The cache stops growing at its cap
+    channels[1]->ClearPathLossCache();
+    channels[1]->SetAttribute("MaxPathLossCacheEntries", UintegerValue(1));
+    Transmit(channels[1], phys[1][0]);
+    NS_TEST_EXPECT_MSG_EQ(channels[1]->GetPathLossCacheSize(), 1, "Cache cap not applied");
+
+    for (const auto& channel : channels)
+    {
+        channel->Dispose();
+    }
+    Simulator::Destroy();
+}
+
+// ==============================================================================
+LrWpanSpectrumChannelNarrowbandTestCase::LrWpanSpectrumChannelNarrowbandTestCase()
+    : TestCase("Test the narrowband mode of the 802.15.4 spectrum channel")
+{
+}
+
+LrWpanSpectrumChannelNarrowbandTestCase::~LrWpanSpectrumChannelNarrowbandTestCase()
+{
+}
+
+void
+LrWpanSpectrumChannelNarrowbandTestCase::DoRun()
+{
+    LrWpanSpectrumValueHelper psdHelper;
+    Ptr<SpectrumValue> txPsd = psdHelper.CreateTxPowerSpectralDensity(0.0, 11);
+
+    // The same frame through a spectrum and a narrowband channel
+    std::vector<std::vector<Ptr<LrWpanCountingPhy>>> phys(2);
+    for (uint32_t c = 0; c < 2; c++)
+    {
+        Ptr<LrWpanSpectrumChannel> channel = CreateObject<LrWpanSpectrumChannel>();
+        channel->SetAttribute("Narrowband", BooleanValue(c == 1));
+        channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+        for (double x : {0.0, 5.0, 50.0})
+        {
+            Ptr<LrWpanCountingPhy> phy = CreateObject<LrWpanCountingPhy>();
+            Ptr<ConstantPositionMobilityModel> mob = CreateObject<ConstantPositionMobilityModel>();
+            mob->SetPosition(Vector(x, 0, 0));
+            phy->SetMobility(mob);
+            channel->AddRx(phy);
+            phys[c].push_back(phy);
+        }
+
+        Ptr<LrWpanSpectrumSignalParameters> txParams = Create<LrWpanSpectrumSignalParameters>();
+        txParams->duration = MilliSeconds(1);
+        txParams->txPhy = phys[c][0];
+        txParams->psd = txPsd;
+        txParams->packetBurst = Create<PacketBurst>();
+        channel->StartTx(txParams);
+        Simulator::Run();
+        channel->Dispose();
+    }
+
+    for (uint32_t j = 1; j < 3; j++)
+    {
+        NS_TEST_EXPECT_MSG_EQ_TOL(phys[1][j]->m_rxPower,
+                                  phys[0][j]->m_rxPower,
+                                  phys[0][j]->m_rxPower * 1e-12,
+                                  "Narrowband in-band power differs");
+        NS_TEST_EXPECT_MSG_EQ(phys[1][j]->m_rxParams->psd, txPsd, "PSD copied in narrowband mode");
+        NS_TEST_EXPECT_MSG_NE(phys[0][j]->m_rxParams->psd, txPsd, "PSD shared in spectrum mode");
+    }
+
+    // The interference helper sees the same total for both kinds of signals
+    Ptr<LrWpanInterferenceHelper> spectrumHelper =
+        Create<LrWpanInterferenceHelper>(txPsd->GetSpectrumModel());
+    Ptr<LrWpanInterferenceHelper> narrowbandHelper =
+        Create<LrWpanInterferenceHelper>(txPsd->GetSpectrumModel());
+    for (uint32_t j = 1; j < 3; j++)
+    {
+        Ptr<LrWpanSpectrumSignalParameters> sp = phys[0][j]->m_rxParams;
+        Ptr<LrWpanSpectrumSignalParameters> np = phys[1][j]->m_rxParams;
+        spectrumHelper->AddSignal(sp->psd, sp->GetInBandPower(11), sp->psdGain);
+        // distinct keys for the shared PSD
+        narrowbandHelper->AddSignal(np->psd->Copy(), np->GetInBandPower(11), np->psdGain);
+    }
+    spectrumHelper->SetChannel(12);
+    narrowbandHelper->SetChannel(12);
+    NS_TEST_EXPECT_MSG_EQ_TOL(narrowbandHelper->GetInBandPower(),
+                              spectrumHelper->GetInBandPower(),
+                              spectrumHelper->GetInBandPower() * 1e-12,
+                              "Narrowband interference differs after a channel change");
+    NS_TEST_EXPECT_MSG_EQ_TOL(
+        LrWpanSpectrumValueHelper::TotalAvgPower(narrowbandHelper->GetSignalPsd(), 11),
+        LrWpanSpectrumValueHelper::TotalAvgPower(spectrumHelper->GetSignalPsd(), 11),
+        LrWpanSpectrumValueHelper::TotalAvgPower(spectrumHelper->GetSignalPsd(), 11) * 1e-12,
+        "Narrowband interference PSD differs");
+
+    Simulator::Destroy();
+}
+
+// ==============================================================================
+LrWpanSpectrumChannelFilteringTestCase::LrWpanSpectrumChannelFilteringTestCase()
+    : TestCase("Test the channel filtering of the 802.15.4 spectrum channel")
+{
+}
+
+LrWpanSpectrumChannelFilteringTestCase::~LrWpanSpectrumChannelFilteringTestCase()
+{
+}
+
+void
+LrWpanSpectrumChannelFilteringTestCase::DoRun()
+{
+    for (bool culling : {true, false})
+    {
+        Ptr<LrWpanSpectrumChannel> channel = CreateObject<LrWpanSpectrumChannel>();
+        channel->SetAttribute("RangeCulling", BooleanValue(culling));
+        channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+
+        // A transmitter and a receiver on channel 11, a receiver on channel 12
+        std::vector<Ptr<LrWpanCountingLrWpanPhy>> phys;
+        for (uint8_t ch : {11, 11, 12})
+        {
+            Ptr<LrWpanCountingLrWpanPhy> phy = CreateObject<LrWpanCountingLrWpanPhy>();
+            Ptr<ConstantPositionMobilityModel> mob = CreateObject<ConstantPositionMobilityModel>();
+            mob->SetPosition(Vector(phys.size() * 5.0, 0, 0));
+            phy->SetMobility(mob);
+            Ptr<PhyPibAttributes> pib = Create<PhyPibAttributes>();
+            pib->phyCurrentChannel = ch;
+            phy->PlmeSetAttributeRequest(PhyPibAttributeIdentifier::phyCurrentChannel, pib);
+            channel->AddRx(phy);
+            phys.push_back(phy);
+        }
+
+        auto transmit = [&]() {
+            Ptr<LrWpanSpectrumSignalParameters> txParams =
+                Create<LrWpanSpectrumSignalParameters>();
+            txParams->duration = MilliSeconds(1);
+            txParams->txPhy = phys[0];
+            txParams->psd = LrWpanSpectrumValueHelper().CreateTxPowerSpectralDensity(0.0, 11);
+            txParams->txChannel = 11;
+            txParams->packetBurst = Create<PacketBurst>();
+            txParams->packetBurst->AddPacket(Create<Packet>(20));
+            channel->StartTx(txParams);
+            Simulator::Run();
+        };
+
+        transmit();
+        NS_TEST_EXPECT_MSG_EQ(phys[1]->m_rxCount, 1, "Receiver on the channel skipped");
+        NS_TEST_EXPECT_MSG_EQ(phys[2]->m_rxCount, 0, "Receiver on another channel reached");
+
+        // Retuned to the transmitter channel, the receiver gets the next frames
+        Ptr<PhyPibAttributes> pib = Create<PhyPibAttributes>();
+        pib->phyCurrentChannel = 11;
+        phys[2]->PlmeSetAttributeRequest(PhyPibAttributeIdentifier::phyCurrentChannel, pib);
+        NS_TEST_EXPECT_MSG_EQ(+phys[2]->GetCurrentChannelNum(), 11, "PHY not retuned");
+        transmit();
+        NS_TEST_EXPECT_MSG_EQ(phys[2]->m_rxCount, 1, "Retuned receiver skipped");
+
+        // Without filtering, every receiver gets the signal
+        channel->SetAttribute("ChannelFiltering", BooleanValue(false));
+        pib->phyCurrentChannel = 13;
+        phys[2]->PlmeSetAttributeRequest(PhyPibAttributeIdentifier::phyCurrentChannel, pib);
+        transmit();
+        NS_TEST_EXPECT_MSG_EQ(phys[2]->m_rxCount, 2, "Filtered while disabled");
+
+        for (const auto& phy : phys)
+        {
+            phy->Dispose();
+        }
+        channel->Dispose();
+    }
+    Simulator::Destroy();
+}
+
+// ==============================================================================
+LrWpanSpectrumChannelParallelTestCase::LrWpanSpectrumChannelParallelTestCase()
+    : TestCase("Test the worker threads of the 802.15.4 spectrum channel")
+{
+}
+
+LrWpanSpectrumChannelParallelTestCase::~LrWpanSpectrumChannelParallelTestCase()
+{
+}
+
+void
+LrWpanSpectrumChannelParallelTestCase::DoRun()
+{
+    LrWpanSpectrumValueHelper psdHelper;
+    Ptr<SpectrumValue> txPsd = psdHelper.CreateTxPowerSpectralDensity(0.0, 11);
+
+    // Sequential, parallel, and parallel with the path loss cache
+    const uint32_t nPhys = 41;
+    std::vector<std::vector<Ptr<LrWpanCountingPhy>>> phys(3);
+    for (uint32_t c = 0; c < 3; c++)
+    {
+        Ptr<LrWpanSpectrumChannel> channel = CreateObject<LrWpanSpectrumChannel>();
+        channel->SetAttribute("WorkerThreads", UintegerValue(c == 0 ? 0 : 2));
+        channel->SetAttribute("ParallelMinReceivers", UintegerValue(1));
+        channel->SetAttribute("PathLossCache", BooleanValue(c == 2));
+        channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+        channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+        for (uint32_t i = 0; i < nPhys; i++)
+        {
+            Ptr<LrWpanCountingPhy> phy = CreateObject<LrWpanCountingPhy>();
+            Ptr<ConstantPositionMobilityModel> mob = CreateObject<ConstantPositionMobilityModel>();
+            // the first receiver is within the reference distance
+            mob->SetPosition(Vector(i == 0 ? 0.0 : 0.5 + 7.5 * (i - 1), 0, 0));
+            phy->SetMobility(mob);
+            channel->AddRx(phy);
+            phys[c].push_back(phy);
+        }
+
+        // two frames, the second one from the cache
+        for (uint32_t k = 0; k < 2; k++)
+        {
+            Ptr<LrWpanSpectrumSignalParameters> txParams =
+                Create<LrWpanSpectrumSignalParameters>();
+            txParams->duration = MilliSeconds(1);
+            txParams->txPhy = phys[c][0];
+            txParams->psd = txPsd;
+            txParams->packetBurst = Create<PacketBurst>();
+            channel->StartTx(txParams);
+            Simulator::Run();
+        }
+        NS_TEST_EXPECT_MSG_EQ(channel->GetWorkerThreads(),
+                              (c == 0 ? 0u : 2u),
+                              "Wrong thread count");
+        channel->Dispose();
+    }
+
+    uint32_t nReceived = 0;
+    for (uint32_t c = 1; c < 3; c++)
+    {
+        for (uint32_t i = 1; i < nPhys; i++)
+        {
+            NS_TEST_EXPECT_MSG_EQ(phys[c][i]->m_rxCount,
+                                  phys[0][i]->m_rxCount,
+                                  "Parallel channel delivered to another set of receivers");
+            if (phys[0][i]->m_rxCount > 0)
+            {
+                // exact: same operations in the same order
+                NS_TEST_EXPECT_MSG_EQ(phys[c][i]->m_rxPower,
+                                      phys[0][i]->m_rxPower,
+                                      "Parallel path loss differs");
+                nReceived++;
+            }
+        }
+    }
+    NS_TEST_EXPECT_MSG_GT(nReceived, 0, "No receiver in range");
+
+    Simulator::Destroy();
+}
+
+// ==============================================================================
+LrWpanSpectrumChannelMobilityTestCase::LrWpanSpectrumChannelMobilityTestCase()
+    : TestCase("Test the neighbour set updates of the 802.15.4 spectrum channel")
+{
+}
+
+LrWpanSpectrumChannelMobilityTestCase::~LrWpanSpectrumChannelMobilityTestCase()
+{
+}
+
+void
+LrWpanSpectrumChannelMobilityTestCase::DoRun()
+{
+    LrWpanSpectrumValueHelper psdHelper;
+    Ptr<SpectrumValue> txPsd = psdHelper.CreateTxPowerSpectralDensity(0.0, 11);
+
+    for (double cellSize : {0.0, 50.0})
+    {
+        Ptr<LrWpanSpectrumChannel> channel = CreateObject<LrWpanSpectrumChannel>();
+        channel->SetAttribute("NeighbourGridCellSize", DoubleValue(cellSize));
+        channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+        channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+        // Fixed PHYs every 60 m (some 210 m of range at 0 dBm), a mobile one far off
+        std::vector<Ptr<LrWpanCountingPhy>> phys;
+        for (uint32_t i = 0; i < 11; i++)
+        {
+            Ptr<LrWpanCountingPhy> phy = CreateObject<LrWpanCountingPhy>();
+            Ptr<ConstantPositionMobilityModel> mob = CreateObject<ConstantPositionMobilityModel>();
+            mob->SetPosition(Vector(60.0 * i, 0, 0));
+            phy->SetMobility(mob);
+            channel->AddRx(phy);
+            phys.push_back(phy);
+        }
+        Ptr<LrWpanCountingPhy> mobile = CreateObject<LrWpanCountingPhy>();
+        Ptr<ConstantVelocityMobilityModel> mobileMob =
+            CreateObject<ConstantVelocityMobilityModel>();
+        mobileMob->SetPosition(Vector(2000, 0, 0));
+        mobile->SetMobility(mobileMob);
+        channel->AddRx(mobile);
+
+        auto transmitAll = [&]() {
+            for (const auto& phy : phys)
+            {
+                Ptr<LrWpanSpectrumSignalParameters> txParams =
+                    Create<LrWpanSpectrumSignalParameters>();
+                txParams->duration = MilliSeconds(1);
+                txParams->txPhy = phy;
+                txParams->psd = txPsd;
+                txParams->packetBurst = Create<PacketBurst>();
+                channel->StartTx(txParams);
+                Simulator::Run();
+            }
+        };
+        auto listed = [&](uint32_t i, Ptr<SpectrumPhy> rxPhy) {
+            std::vector<Ptr<SpectrumPhy>> receivers;
+            channel->GetListedReceivers(phys[i], receivers);
+            return std::find(receivers.begin(), receivers.end(), rxPhy) != receivers.end();
+        };
+
+        transmitAll();
+        for (const Vector& position : {Vector(130, 0, 0), Vector(470, 30, 0), Vector(5000, 0, 0)})
+        {
+            const uint64_t nUpdates = channel->GetNNeighbourUpdates();
+            mobileMob->SetPosition(position);
+            NS_TEST_EXPECT_MSG_GT(channel->GetNNeighbourUpdates(), nUpdates, "No update");
+            NS_TEST_EXPECT_MSG_LT_OR_EQ(channel->GetNNeighbourUpdates() - nUpdates,
+                                        phys.size(),
+                                        "List checked twice");
+            std::vector<std::vector<Ptr<SpectrumPhy>>> updated(phys.size());
+            for (uint32_t i = 0; i < phys.size(); i++)
+            {
+                NS_TEST_EXPECT_MSG_EQ(channel->GetListedReceivers(phys[i], updated[i]),
+                                      true,
+                                      "List dropped by the move");
+            }
+            channel->InvalidateReceiverLists();
+            transmitAll();
+            for (uint32_t i = 0; i < phys.size(); i++)
+            {
+                std::vector<Ptr<SpectrumPhy>> rebuilt;
+                channel->GetListedReceivers(phys[i], rebuilt);
+                NS_TEST_EXPECT_MSG_EQ((updated[i] == rebuilt),
+                                      true,
+                                      "Updated list differs from the rebuilt one");
+            }
+        }
+        NS_TEST_EXPECT_MSG_EQ(listed(0, mobile), false, "Far mobile PHY still listed");
+
+        // Moving between two course changes, updated every MobilityUpdateInterval
+        channel->SetAttribute("MobilityUpdateInterval", TimeValue(Seconds(1)));
+        mobileMob->SetPosition(Vector(2000, 0, 0));
+        mobileMob->SetVelocity(Vector(-200, 0, 0));
+        Simulator::Stop(Seconds(8.5));
+        Simulator::Run();
+        NS_TEST_EXPECT_MSG_EQ(listed(7, mobile), true, "Passing mobile PHY not listed");
+        NS_TEST_EXPECT_MSG_EQ(listed(0, mobile), false, "Mobile PHY listed out of range");
+        mobileMob->SetVelocity(Vector(0, 0, 0));
+
+        for (const auto& phy : phys)
+        {
+            NS_TEST_EXPECT_MSG_EQ(phy->m_rxCount > 0, true, "Fixed PHY out of every list");
+        }
+        channel->Dispose();
+        Simulator::Destroy();
+    }
+}
+
+// ==============================================================================
+LrWpanSpectrumChannelFarFieldTestCase::LrWpanSpectrumChannelFarFieldTestCase()
+    : TestCase("Test the far-field noise of the 802.15.4 spectrum channel")
+{
+}
+
+LrWpanSpectrumChannelFarFieldTestCase::~LrWpanSpectrumChannelFarFieldTestCase()
+{
+}
+
+void
+LrWpanSpectrumChannelFarFieldTestCase::DoRun()
+{
+    const uint32_t nFar = 8;
+    const Time period = MilliSeconds(50);
+    const Time airtime = MilliSeconds(4);
+    const uint32_t nFrames = 40; // per transmitter, over 2 s
+    LrWpanSpectrumValueHelper psdHelper;
+    Ptr<SpectrumValue> txPsd = psdHelper.CreateTxPowerSpectralDensity(0.0, 11);
+
+    double fullPower = 0;
+    for (double radius : {0.0, 50.0})
+    {
+        Ptr<LrWpanSpectrumChannel> channel = CreateObject<LrWpanSpectrumChannel>();
+        channel->SetAttribute("FarFieldRadius", DoubleValue(radius));
+        channel->SetAttribute("FarFieldWindow", TimeValue(Seconds(1)));
+        channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+
+        // A receiver, a transmitter next to it and far ones above the culling floor
+        Ptr<LrWpanCountingLrWpanPhy> rxPhy = CreateObject<LrWpanCountingLrWpanPhy>();
+        Ptr<ConstantPositionMobilityModel> rxMob = CreateObject<ConstantPositionMobilityModel>();
+        rxPhy->SetMobility(rxMob);
+        channel->AddRx(rxPhy);
+        std::vector<Ptr<LrWpanCountingPhy>> txPhys;
+        for (uint32_t i = 0; i <= nFar; i++)
+        {
+            Ptr<LrWpanCountingPhy> phy = CreateObject<LrWpanCountingPhy>();
+            Ptr<ConstantPositionMobilityModel> mob = CreateObject<ConstantPositionMobilityModel>();
+            mob->SetPosition(Vector(i == 0 ? 10.0 : 80.0 + 10.0 * i, 0, 0));
+            phy->SetMobility(mob);
+            txPhys.push_back(phy);
+        }
+
+        auto transmit = [channel, txPsd, airtime](Ptr<SpectrumPhy> txPhy) {
+            Ptr<LrWpanSpectrumSignalParameters> txParams =
+                Create<LrWpanSpectrumSignalParameters>();
+            txParams->duration = airtime;
+            txParams->txPhy = txPhy;
+            txParams->psd = txPsd;
+            txParams->txChannel = 11;
+            txParams->packetBurst = Create<PacketBurst>();
+            txParams->packetBurst->AddPacket(Create<Packet>(20));
+            channel->StartTx(txParams);
+        };
+        // Staggered beacons of the far transmitters, one frame of the near one
+        for (uint32_t i = 1; i <= nFar; i++)
+        {
+            for (uint32_t k = 0; k < nFrames; k++)
+            {
+                Simulator::Schedule(period * k + MilliSeconds(5 * i), transmit, txPhys[i]);
+            }
+        }
+        Simulator::Schedule(Seconds(2.2), transmit, txPhys[0]);
+
+        // Mean interference power over [1 s, 2 s), sampled off the frame edges
+        double sampled = 0;
+        const uint32_t nSamples = 2000;
+        for (uint32_t s = 0; s < nSamples; s++)
+        {
+            Simulator::Schedule(Seconds(1) + MicroSeconds(500 * s + 250), [&sampled, rxPhy]() {
+                sampled += std::pow(10.0, rxPhy->GetCurrentSignalPsd() / 10.0) / 1000;
+            });
+        }
+        double farFieldNoise = 0;
+        Simulator::Schedule(Seconds(2.5), [&farFieldNoise, rxPhy]() {
+            farFieldNoise = rxPhy->GetFarFieldNoise();
+        });
+        Simulator::Run();
+
+        if (radius == 0)
+        {
+            fullPower = sampled / nSamples;
+            NS_TEST_EXPECT_MSG_EQ(rxPhy->m_rxCount, nFar * nFrames + 1, "Signals not delivered");
+            NS_TEST_EXPECT_MSG_EQ(channel->GetNFarFieldSignals(), 0, "Far field while disabled");
+            NS_TEST_EXPECT_MSG_EQ(farFieldNoise, 0, "Far-field noise while disabled");
+        }
+        else
+        {
+            NS_TEST_EXPECT_MSG_EQ(rxPhy->m_rxCount, 1, "Far signals delivered");
+            NS_TEST_EXPECT_MSG_EQ(channel->GetNFarFieldSignals(),
+                                  nFar * nFrames,
+                                  "Far signals not turned into noise");
+            NS_TEST_EXPECT_MSG_EQ(sampled, 0, "Far signals in the air");
+            NS_TEST_EXPECT_MSG_GT(fullPower, 0, "No interference in the full model");
+            NS_TEST_EXPECT_MSG_EQ_TOL(farFieldNoise,
+                                      fullPower,
+                                      fullPower * 0.01,
+                                      "Far-field noise off the full model");
+            // Silent for a window after the traffic, the noise is gone
+            NS_TEST_EXPECT_MSG_EQ(rxPhy->GetFarFieldNoise(), 0, "Far-field noise left");
+        }
+
+        rxPhy->Dispose();
+        channel->Dispose();
+        Simulator::Destroy();
+    }
+}
+
+/**
+ * @ingroup lr-wpan-test
+ * @ingroup tests
+ *
+ * @brief LrWpan spectrum channel TestSuite
+ */
+class LrWpanSpectrumChannelTestSuite : public TestSuite
+{
+  public:
+    LrWpanSpectrumChannelTestSuite();
+};
+
+LrWpanSpectrumChannelTestSuite::LrWpanSpectrumChannelTestSuite()
+    : TestSuite("lr-wpan-spectrum-channel", Type::UNIT)
+{
+    AddTestCase(new LrWpanSpectrumChannelTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new LrWpanSpectrumChannelRegionTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new LrWpanSpectrumChannelCacheTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new LrWpanSpectrumChannelNarrowbandTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new LrWpanSpectrumChannelFilteringTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new LrWpanSpectrumChannelParallelTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new LrWpanSpectrumChannelMobilityTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new LrWpanSpectrumChannelFarFieldTestCase, TestCase::Duration::QUICK);
+}
+
+static LrWpanSpectrumChannelTestSuite
+    g_lrWpanSpectrumChannelTestSuite; //!< Static variable for test initialization
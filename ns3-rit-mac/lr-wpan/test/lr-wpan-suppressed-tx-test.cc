@@ -0,0 +1,354 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/log.h"
+#include "ns3/lr-wpan-phy.h"
+#include "ns3/lr-wpan-spectrum-channel.h"
+#include "ns3/nstime.h"
+#include "ns3/packet.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/simulator.h"
+#include "ns3/single-model-spectrum-channel.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("lr-wpan-suppressed-tx-test");
+
+/**
+ * @ingroup lr-wpan-test
+ * @ingroup tests
+ *
+ * @brief Check that a transmission kept off the channel with SuppressNextTx goes through
+ * the same sender states and confirms as a real one, and reaches no receiver.
+ */
+class LrWpanSuppressedTxTestCase : public TestCase
+{
+  public:
+    LrWpanSuppressedTxTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Run two transmissions, the first one optionally suppressed.
+     *
+     * @param suppress Whether SuppressNextTx is called before the first transmission
+     */
+    void RunTransmissions(bool suppress);
+
+    /**
+     * @brief Receives a PD-DATA.confirm
+     * @param status The status.
+     */
+    void DataConfirm(PhyEnumeration status);
+
+    /**
+     * @brief Receives a PhyRxBegin trace of the receiver
+     * @param p The packet.
+     */
+    void RxBegin(Ptr<const Packet> p);
+
+    /**
+     * @brief Receives a PhyRxDrop trace of the receiver
+     * @param p The packet.
+     */
+    void RxDrop(Ptr<const Packet> p);
+
+    uint32_t m_nDataConfirms; //!< Number of PD-DATA.confirms of the sender
+    uint32_t m_nRxBegins;     //!< Number of frames seen by the receiver in RX_ON
+    uint32_t m_nRxDrops;      //!< Number of frames dropped by the receiver
+    Time m_busyTx;            //!< BUSY_TX time of the sender
+};
+
+LrWpanSuppressedTxTestCase::LrWpanSuppressedTxTestCase()
+    : TestCase("Test a transmission kept off the channel by LrWpanPhy")
+{
+}
+
+void
+LrWpanSuppressedTxTestCase::DataConfirm(PhyEnumeration status)
+{
+    m_nDataConfirms++;
+}
+
+void
+LrWpanSuppressedTxTestCase::RxBegin(Ptr<const Packet> p)
+{
+    m_nRxBegins++;
+}
+
+void
+LrWpanSuppressedTxTestCase::RxDrop(Ptr<const Packet> p)
+{
+    m_nRxDrops++;
+}
+
+void
+LrWpanSuppressedTxTestCase::RunTransmissions(bool suppress)
+{
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    Ptr<LrWpanPhy> sender = CreateObject<LrWpanPhy>();
+    Ptr<LrWpanPhy> receiver = CreateObject<LrWpanPhy>();
+    sender->SetChannel(channel);
+    receiver->SetChannel(channel);
+    channel->AddRx(receiver);
+    sender->SetMobility(CreateObject<ConstantPositionMobilityModel>());
+    receiver->SetMobility(CreateObject<ConstantPositionMobilityModel>());
+    sender->Initialize();
+    receiver->Initialize();
+    m_nDataConfirms = 0;
+    m_nRxBegins = 0;
+    m_nRxDrops = 0;
+
+    sender->SetPdDataConfirmCallback(MakeCallback(&LrWpanSuppressedTxTestCase::DataConfirm, this));
+    receiver->TraceConnectWithoutContext("PhyRxBegin",
+                                         MakeCallback(&LrWpanSuppressedTxTestCase::RxBegin, this));
+    receiver->TraceConnectWithoutContext("PhyRxDrop",
+                                         MakeCallback(&LrWpanSuppressedTxTestCase::RxDrop, this));
+
+    NS_TEST_EXPECT_MSG_EQ(sender->IsQuiescent(), true, "Sender not quiescent in TRX_OFF");
+    sender->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_TX_ON);
+    NS_TEST_EXPECT_MSG_EQ(sender->IsQuiescent(), false, "Sender quiescent while waking up");
+    receiver->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_RX_ON);
+    if (suppress)
+    {
+        sender->SuppressNextTx();
+    }
+    Ptr<Packet> p = Create<Packet>(40);
+    Simulator::Schedule(MilliSeconds(1), &LrWpanPhy::PdDataRequest, sender, p->GetSize(), p);
+    Simulator::Schedule(MilliSeconds(5), &LrWpanPhy::PdDataRequest, sender, p->GetSize(), p);
+    Simulator::Stop(MilliSeconds(10));
+    Simulator::Run();
+
+    m_busyTx = sender->GetDutyCycleCounters().busyTx;
+
+    sender->Dispose();
+    receiver->Dispose();
+    Simulator::Destroy();
+}
+
+void
+LrWpanSuppressedTxTestCase::DoRun()
+{
+    RunTransmissions(false);
+    NS_TEST_EXPECT_MSG_EQ(m_nDataConfirms, 2, "Expected two PD-DATA.confirms");
+    NS_TEST_EXPECT_MSG_EQ(m_nRxBegins, 2, "Expected two frames at the receiver");
+    Time busyTx = m_busyTx;
+
+    RunTransmissions(true);
+    NS_TEST_EXPECT_MSG_EQ(m_nDataConfirms, 2, "Suppressed frame not confirmed");
+    NS_TEST_EXPECT_MSG_EQ(m_nRxBegins, 1, "Suppressed frame reached the receiver");
+    NS_TEST_EXPECT_MSG_EQ(m_nRxDrops, 0, "Unexpected drop at the receiver");
+    NS_TEST_EXPECT_MSG_EQ(m_busyTx, busyTx, "Suppressed frame changed the sender BUSY_TX time");
+}
+
+/**
+ * @ingroup lr-wpan-test
+ * @ingroup tests
+ *
+ * @brief Check that a transmission deferred with DeferNextTx reaches a receiver waking up
+ * during the frame as a real one does, and that the TRX_OFF time accounted as RX_ON
+ * ends when the transceiver enters RX_ON.
+ */
+class LrWpanDeferredTxTestCase : public TestCase
+{
+  public:
+    LrWpanDeferredTxTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Run two transmissions to a sleeping receiver waking up during the second one.
+     *
+     * @param defer Whether DeferNextTx is called before the second transmission
+     */
+    void RunTransmissions(bool defer);
+
+    /**
+     * Defer the next transmission of the sender, if requested, and send a frame.
+     *
+     * @param defer Whether DeferNextTx is called
+     */
+    void SendFrame(bool defer);
+
+    /**
+     * @brief Receives the wake-up of the receiver and delivers the deferred frame to it
+     * @param phy The waking PHY.
+     */
+    void Wake(Ptr<LrWpanPhy> phy);
+
+    /**
+     * @brief Receives a PLME-CCA.confirm of the receiver
+     * @param status The status.
+     */
+    void CcaConfirm(PhyEnumeration status);
+
+    /**
+     * @brief Receives a PhyRxDrop trace of the receiver
+     * @param p The packet.
+     */
+    void RxDrop(Ptr<const Packet> p);
+
+    Ptr<LrWpanPhy> m_sender;    //!< The sender
+    uint32_t m_nWakes;          //!< Wake-ups of the receiver
+    uint32_t m_nRxDrops;        //!< Number of frames dropped by the receiver
+    PhyEnumeration m_ccaStatus; //!< Result of the CCA of the receiver
+    Time m_rxOn;                //!< RX_ON time of the receiver
+};
+
+LrWpanDeferredTxTestCase::LrWpanDeferredTxTestCase()
+    : TestCase("Test a transmission deferred until its receiver wakes up")
+{
+}
+
+void
+LrWpanDeferredTxTestCase::SendFrame(bool defer)
+{
+    if (defer)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_sender->DeferNextTx(), true, "Transmission not deferred");
+    }
+    Ptr<Packet> p = Create<Packet>(40);
+    m_sender->PdDataRequest(p->GetSize(), p);
+    NS_TEST_EXPECT_MSG_EQ(m_sender->IsDeferredTxOnAir(), defer, "Deferred frame not on air");
+}
+
+void
+LrWpanDeferredTxTestCase::Wake(Ptr<LrWpanPhy> phy)
+{
+    m_nWakes++;
+    NS_TEST_EXPECT_MSG_EQ(phy->GetTrxState(), IEEE_802_15_4_PHY_TRX_OFF, "Woke up too late");
+    m_sender->DeliverDeferredTx(phy);
+    NS_TEST_EXPECT_MSG_EQ(m_sender->IsDeferredTxOnAir(), false, "Delivered frame still on air");
+}
+
+void
+LrWpanDeferredTxTestCase::CcaConfirm(PhyEnumeration status)
+{
+    m_ccaStatus = status;
+}
+
+void
+LrWpanDeferredTxTestCase::RxDrop(Ptr<const Packet> p)
+{
+    m_nRxDrops++;
+}
+
+void
+LrWpanDeferredTxTestCase::RunTransmissions(bool defer)
+{
+    Ptr<LrWpanSpectrumChannel> channel = CreateObject<LrWpanSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+    m_sender = CreateObject<LrWpanPhy>();
+    Ptr<LrWpanPhy> receiver = CreateObject<LrWpanPhy>();
+    Ptr<ConstantPositionMobilityModel> rxMobility = CreateObject<ConstantPositionMobilityModel>();
+    rxMobility->SetPosition(Vector(5, 0, 0));
+    m_sender->SetMobility(CreateObject<ConstantPositionMobilityModel>());
+    receiver->SetMobility(rxMobility);
+    m_sender->SetChannel(channel);
+    receiver->SetChannel(channel);
+    channel->AddRx(receiver);
+    m_sender->Initialize();
+    receiver->Initialize();
+    m_nWakes = 0;
+    m_nRxDrops = 0;
+    m_ccaStatus = IEEE_802_15_4_PHY_UNSPECIFIED;
+
+    receiver->SetWakeCallback(MakeCallback(&LrWpanDeferredTxTestCase::Wake, this));
+    receiver->SetPlmeCcaConfirmCallback(
+        MakeCallback(&LrWpanDeferredTxTestCase::CcaConfirm, this));
+    receiver->TraceConnectWithoutContext("PhyRxDrop",
+                                         MakeCallback(&LrWpanDeferredTxTestCase::RxDrop, this));
+
+    // The first frame builds the receiver list of the sender, the second one is deferred
+    // and the receiver wakes up in its middle: it senses the frame but cannot receive it.
+    m_sender->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_TX_ON);
+    NS_TEST_EXPECT_MSG_EQ(m_sender->DeferNextTx(), false, "Deferred without a receiver list");
+    Simulator::Schedule(MilliSeconds(1), &LrWpanDeferredTxTestCase::SendFrame, this, false);
+    Simulator::Schedule(MilliSeconds(5), &LrWpanDeferredTxTestCase::SendFrame, this, defer);
+    Simulator::Schedule(MicroSeconds(5500),
+                        &LrWpanPhy::PlmeSetTRXStateRequest,
+                        receiver,
+                        IEEE_802_15_4_PHY_RX_ON);
+    Simulator::Schedule(MilliSeconds(6), &LrWpanPhy::PlmeCcaRequest, receiver);
+    Simulator::Stop(MilliSeconds(10));
+    Simulator::Run();
+
+    m_rxOn = receiver->GetDutyCycleCounters().rxOn;
+
+    // TRX_OFF time accounted as RX_ON, up to the entry into RX_ON.
+    receiver->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_TRX_OFF);
+    NS_TEST_EXPECT_MSG_EQ(receiver->IsQuiescent(), true, "Receiver not quiescent in TRX_OFF");
+    const PhyDutyCycleCounters before = receiver->GetDutyCycleCounters();
+    receiver->AccountTrxOffAs(IEEE_802_15_4_PHY_RX_ON, Simulator::Now() + MilliSeconds(4));
+    NS_TEST_EXPECT_MSG_EQ(receiver->IsQuiescent(), false, "Accounted TRX_OFF is quiescent");
+    Simulator::Stop(MilliSeconds(1));
+    Simulator::Run();
+    PhyDutyCycleCounters after = receiver->GetDutyCycleCounters();
+    NS_TEST_EXPECT_MSG_EQ(after.rxOn - before.rxOn, MilliSeconds(1), "RX_ON time not accounted");
+    NS_TEST_EXPECT_MSG_EQ(after.trxOff, before.trxOff, "Accounted time counted as TRX_OFF");
+    const uint32_t nWakes = m_nWakes;
+    receiver->EnterAccountedState();
+    NS_TEST_EXPECT_MSG_EQ(receiver->GetTrxState(), IEEE_802_15_4_PHY_RX_ON, "Not in RX_ON");
+    NS_TEST_EXPECT_MSG_EQ(m_nWakes, nWakes + 1, "Wake callback not called");
+    receiver->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_TRX_OFF);
+    NS_TEST_EXPECT_MSG_EQ(receiver->IsQuiescent(), true, "Accounting kept past RX_ON");
+    Simulator::Stop(MilliSeconds(1));
+    Simulator::Run();
+    after = receiver->GetDutyCycleCounters();
+    NS_TEST_EXPECT_MSG_EQ(after.rxOn - before.rxOn, MilliSeconds(1), "RX_ON after the accounting");
+    NS_TEST_EXPECT_MSG_EQ(after.trxOff - before.trxOff, MilliSeconds(1), "TRX_OFF not counted");
+
+    m_sender->Dispose();
+    receiver->Dispose();
+    m_sender = nullptr;
+    Simulator::Destroy();
+}
+
+void
+LrWpanDeferredTxTestCase::DoRun()
+{
+    RunTransmissions(false);
+    NS_TEST_EXPECT_MSG_EQ(m_nWakes, 2, "Expected two wake-ups of the receiver");
+    NS_TEST_EXPECT_MSG_EQ(m_nRxDrops, 2, "Expected two frames dropped by the receiver");
+    NS_TEST_EXPECT_MSG_EQ(m_ccaStatus, IEEE_802_15_4_PHY_BUSY, "Frame not sensed");
+    Time rxOn = m_rxOn;
+
+    RunTransmissions(true);
+    NS_TEST_EXPECT_MSG_EQ(m_nRxDrops, 2, "Deferred frame not delivered on the wake-up");
+    NS_TEST_EXPECT_MSG_EQ(m_ccaStatus, IEEE_802_15_4_PHY_BUSY, "Deferred frame not sensed");
+    NS_TEST_EXPECT_MSG_EQ(m_rxOn, rxOn, "Deferred frame changed the receiver RX_ON time");
+}
+
+/**
+ * @ingroup lr-wpan-test
+ * @ingroup tests
+ *
+ * @brief LrWpan PHY suppressed transmission TestSuite
+ */
+class LrWpanSuppressedTxTestSuite : public TestSuite
+{
+  public:
+    LrWpanSuppressedTxTestSuite();
+};
+
+LrWpanSuppressedTxTestSuite::LrWpanSuppressedTxTestSuite()
+    : TestSuite("lr-wpan-suppressed-tx", Type::UNIT)
+{
+    AddTestCase(new LrWpanSuppressedTxTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new LrWpanDeferredTxTestCase, TestCase::Duration::QUICK);
+}
+
+static LrWpanSuppressedTxTestSuite
+    g_lrWpanSuppressedTxTestSuite; //!< Static variable for test initialization
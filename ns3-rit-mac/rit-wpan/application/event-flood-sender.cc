@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "event-flood-sender.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/mac16-address.h"
+#include "ns3/mac64-address.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/rit-timestamp-tag.h"
+#include "ns3/simulator.h"
+#include "ns3/socket.h"
+#include "ns3/uinteger.h"
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_LOG_COMPONENT_DEFINE("EventFloodSender");
+NS_OBJECT_ENSURE_REGISTERED(EventFloodSender);
+
+TypeId
+EventFloodSender::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::lrwpan::EventFloodSender")
+            .SetParent<Application>()
+            .SetGroupName("LrWpan")
+            .AddConstructor<EventFloodSender>()
+            .AddAttribute("DstAddress",
+                          "The destination Address",
+                          AddressValue(),
+                          MakeAddressAccessor(&EventFloodSender::m_dstAddr),
+                          MakeAddressChecker())
+            .AddAttribute("TriggerTime",
+                          "Absolute time of the first report",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&EventFloodSender::m_triggerTime),
+                          MakeTimeChecker())
+            .AddAttribute("PacketSize",
+                          "Size of the reports [bytes]",
+                          UintegerValue(20),
+                          MakeUintegerAccessor(&EventFloodSender::m_packetSize),
+                          MakeUintegerChecker<uint16_t>())
+            .AddAttribute("Priority",
+                          "Priority class of the reports, as a SocketPriorityTag (0: untagged)",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&EventFloodSender::m_priority),
+                          MakeUintegerChecker<uint8_t>())
+            .AddAttribute("ReportCount",
+                          "Number of reports sent for the event",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&EventFloodSender::m_reportCount),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("ReportInterval",
+                          "Interval between the reports of the event",
+                          TimeValue(Seconds(1)),
+                          MakeTimeAccessor(&EventFloodSender::m_reportInterval),
+                          MakeTimeChecker())
+            .AddTraceSource("Tx",
+                            "A packet has been sent",
+                            MakeTraceSourceAccessor(&EventFloodSender::m_txTrace),
+                            "ns3::Packet::TracedCallback");
+    return tid;
+}
+
+EventFloodSender::EventFloodSender()
+    : m_dstAddr(),
+      m_triggerTime(Seconds(0)),
+      m_packetSize(20),
+      m_priority(0),
+      m_reportCount(1),
+      m_reportInterval(Seconds(1)),
+      m_reportsSent(0),
+      m_netDevice(nullptr)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+EventFloodSender::~EventFloodSender()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+EventFloodSender::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_sendEvent.Cancel();
+    m_netDevice = nullptr;
+    Application::DoDispose();
+}
+
+void
+EventFloodSender::SetDstAddr(const Address& addr)
+{
+    NS_LOG_FUNCTION(this << addr);
+    NS_ABORT_MSG_UNLESS(Mac16Address::IsMatchingType(addr) || Mac64Address::IsMatchingType(addr),
+                        "Address must be either Mac16Address or Mac64Address");
+    m_dstAddr = addr;
+}
+
+void
+EventFloodSender::SetTriggerTime(Time time)
+{
+    NS_LOG_FUNCTION(this << time);
+    m_triggerTime = time;
+}
+
+Time
+EventFloodSender::GetTriggerTime() const
+{
+    return m_triggerTime;
+}
+
+void
+EventFloodSender::StartApplication()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!m_dstAddr.IsInvalid());
+
+    m_netDevice = GetNode()->GetDevice(0);
+    if (m_netDevice == nullptr)
+    {
+        NS_LOG_ERROR("No LrWpan device found on node " << GetNode()->GetId());
+        return;
+    }
+    if (m_reportsSent >= m_reportCount)
+    {
+        return;
+    }
+
+    NS_LOG_DEBUG("(App Params)[nodeID: " << GetNode()->GetId() << "] TriggerTime="
+                                         << m_triggerTime.As(Time::S)
+                                         << ", ReportCount=" << m_reportCount
+                                         << ", DstAddress=" << m_dstAddr);
+    // Reports missed while the application was stopped are sent at once
+    const Time now = Simulator::Now();
+    const Time next = m_triggerTime + m_reportInterval * m_reportsSent;
+    m_sendEvent =
+        Simulator::Schedule(next > now ? next - now : Time(0), &EventFloodSender::SendReport, this);
+}
+
+void
+EventFloodSender::StopApplication()
+{
+    NS_LOG_FUNCTION(this);
+    m_sendEvent.Cancel();
+    m_netDevice = nullptr;
+}
+
+void
+EventFloodSender::SendReport()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_netDevice)
+    {
+        NS_LOG_ERROR("Cannot send packet: network device not available");
+        return;
+    }
+
+    Ptr<Packet> packet = Create<Packet>(m_packetSize);
+    packet->AddPacketTag(RitTimestampTag(Simulator::Now()));
+    if (m_priority > 0)
+    {
+        SocketPriorityTag priorityTag;
+        priorityTag.SetPriority(m_priority);
+        packet->AddPacketTag(priorityTag);
+    }
+
+    bool sendRequestIssued = false;
+    if (Mac16Address::IsMatchingType(m_dstAddr))
+    {
+        sendRequestIssued = m_netDevice->Send(packet, Mac16Address::ConvertFrom(m_dstAddr), 0);
+    }
+    else
+    {
+        sendRequestIssued = m_netDevice->Send(packet, Mac64Address::ConvertFrom(m_dstAddr), 0);
+    }
+
+    if (sendRequestIssued)
+    {
+        NS_LOG_INFO("[App->NetDev]:At " << Simulator::Now().GetSeconds() << "s node "
+                                        << GetNode()->GetId() << " issued event report "
+                                        << m_reportsSent + 1 << "/" << m_reportCount << " to "
+                                        << m_dstAddr);
+        m_txTrace(packet);
+    }
+    else
+    {
+        NS_LOG_ERROR("Failed to issue send request from node " << GetNode()->GetId());
+    }
+
+    m_reportsSent++;
+    if (m_reportsSent < m_reportCount)
+    {
+        m_sendEvent = Simulator::Schedule(m_reportInterval, &EventFloodSender::SendReport, this);
+    }
+}
+
+} // namespace lrwpan
+} // namespace ns3
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef EVENT_FLOOD_SENDER_H
+#define EVENT_FLOOD_SENDER_H
+
+#include "ns3/address.h"
+#include "ns3/application.h"
+#include "ns3/event-id.h"
+#include "ns3/net-device.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/traced-callback.h"
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @ingroup lr-wpan
+ *
+ * @brief A sender application reporting one correlated event.
+ *
+ * At its trigger time the node sends ReportCount packets, ReportInterval apart, as
+ * a sensor detecting an event would. EventFloodHelper sets the trigger time of each
+ * node from the arrival of an event spreading from an epicentre, so that the
+ * reports of a whole region reach the network within a short time.
+ *
+ * The application is meant to be installed next to the background application of
+ * the node (PeriodicSender, RandomSender, ...): it only sends and leaves the receive
+ * callback of the device to that application. Each packet carries a
+ * RitTimestampTag, and a SocketPriorityTag for a non-zero priority.
+ */
+class EventFloodSender : public Application
+{
+  public:
+    /**
+     * @brief Get the TypeId
+     * @return The TypeId for this class
+     */
+    static TypeId GetTypeId();
+
+    EventFloodSender();
+    ~EventFloodSender() override;
+
+    /**
+     * @brief Set the destination address for packets
+     * @param addr The destination address (Mac16Address or Mac64Address)
+     */
+    void SetDstAddr(const Address& addr);
+
+    /**
+     * @brief Set the time of the first report
+     * @param time Absolute simulation time (a time already past reports at the start)
+     */
+    void SetTriggerTime(Time time);
+
+    /**
+     * @brief Get the time of the first report
+     * @return the trigger time
+     */
+    Time GetTriggerTime() const;
+
+  private:
+    void DoDispose() override;
+    void StartApplication() override;
+    void StopApplication() override;
+
+    /**
+     * @brief Send a report and schedule the next one
+     */
+    void SendReport();
+
+    Address m_dstAddr;          //!< Destination address (Mac16Address or Mac64Address)
+    Time m_triggerTime;         //!< Time of the first report
+    uint16_t m_packetSize;      //!< Size of the reports
+    uint8_t m_priority;         //!< Priority class of the reports (0: untagged)
+    uint32_t m_reportCount;     //!< Reports per event
+    Time m_reportInterval;      //!< Interval between the reports
+    uint32_t m_reportsSent;     //!< Reports sent for the event
+    Ptr<NetDevice> m_netDevice; //!< Network device used for sending
+    EventId m_sendEvent;        //!< Next report
+
+    TracedCallback<Ptr<const Packet>> m_txTrace; //!< Trace of transmitted packets
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // EVENT_FLOOD_SENDER_H
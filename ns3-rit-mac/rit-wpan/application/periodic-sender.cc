@@ -5,7 +5,12 @@
 #include "ns3/net-device.h"
 #include "ns3/node.h"
 #include "ns3/packet.h"
+#include "ns3/rit-timestamp-tag.h"
 #include "ns3/simulator.h"
+#include "ns3/socket.h"
+#include "ns3/string.h"
+
+#include <fstream>
 
 namespace ns3
 {
@@ -46,6 +51,24 @@ PeriodicSender::GetTypeId()
                                           TimeValue(DEFAULT_INITIAL_DELAY),
                                           MakeTimeAccessor(&PeriodicSender::m_initialDelay),
                                           MakeTimeChecker())
+                            .AddAttribute("DelaySketchFile",
+                                          "CSV file receiving the end-to-end delay sketch "
+                                          "(time,lower_ns,upper_ns,count); empty disables it",
+                                          StringValue(""),
+                                          MakeStringAccessor(&PeriodicSender::m_delaySketchFile),
+                                          MakeStringChecker())
+                            .AddAttribute("DelaySketchInterval",
+                                          "Interval of the periodic delay sketch snapshots "
+                                          "(0 = only at the end of the run)",
+                                          TimeValue(Seconds(0)),
+                                          MakeTimeAccessor(&PeriodicSender::m_delaySketchInterval),
+                                          MakeTimeChecker(Seconds(0)))
+                            .AddAttribute("Priority",
+                                          "Priority class of the sent packets, as a "
+                                          "SocketPriorityTag (0: untagged)",
+                                          UintegerValue(0),
+                                          MakeUintegerAccessor(&PeriodicSender::m_priority),
+                                          MakeUintegerChecker<uint8_t>())
                             .AddTraceSource("Tx",
                                             "A packet has been sent",
                                             MakeTraceSourceAccessor(&PeriodicSender::m_txTrace),
@@ -53,7 +76,13 @@ PeriodicSender::GetTypeId()
                             .AddTraceSource("Rx",
                                             "A packet has been received",
                                             MakeTraceSourceAccessor(&PeriodicSender::m_rxTrace),
-                                            "ns3::Packet::TracedCallback");
+                                            "ns3::Packet::TracedCallback")
+                            .AddTraceSource(
+                                "RxHopLatency",
+                                "Per-hop latency breakdown of a received packet, one call "
+                                "per hop (packet, hop index, stage timestamps)",
+                                MakeTraceSourceAccessor(&PeriodicSender::m_rxHopLatencyTrace),
+                                "ns3::lrwpan::PeriodicSender::RxHopLatencyTracedCallback");
     return tid;
 }
 
@@ -61,9 +90,13 @@ PeriodicSender::PeriodicSender()
     : m_interval(DEFAULT_INTERVAL),
       m_initialDelay(DEFAULT_INITIAL_DELAY),
       m_packetSize(DEFAULT_PACKET_SIZE),
+      m_priority(0),
       m_dstAddr(),
       m_netDevice(nullptr),
-      m_noSendFlag(false)
+      m_noSendFlag(false),
+      m_delaySketchInterval(Seconds(0)),
+      m_delaySketchDirty(false),
+      m_delaySketchFileStarted(false)
 {
     NS_LOG_FUNCTION(this);
     m_timeDriftApplier = CreateObject<TimeDriftApplier>();
@@ -74,6 +107,19 @@ PeriodicSender::~PeriodicSender()
     NS_LOG_FUNCTION(this);
 }
 
+void
+PeriodicSender::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    // Runs without StopTime: write the final snapshot here
+    m_delaySketchEvent.Cancel();
+    if (m_delaySketchDirty)
+    {
+        WriteDelaySketch();
+    }
+    Application::DoDispose();
+}
+
 void
 PeriodicSender::SetInterval(Time interval)
 {
@@ -122,6 +168,13 @@ PeriodicSender::StartApplication()
 {
     NS_LOG_FUNCTION(this);
 
+    if (!m_delaySketchFile.empty() && m_delaySketchInterval.IsStrictlyPositive())
+    {
+        m_delaySketchEvent.Cancel();
+        m_delaySketchEvent =
+            Simulator::Schedule(m_delaySketchInterval, &PeriodicSender::PeriodicDelaySketch, this);
+    }
+
     if (m_noSendFlag)
     {
         NS_LOG_DEBUG("PeriodicSender is in no-send mode on node " << GetNode()->GetId());
@@ -164,6 +217,12 @@ PeriodicSender::StopApplication()
         Simulator::Cancel(m_sendEvent);
     }
 
+    m_delaySketchEvent.Cancel();
+    if (m_delaySketchDirty)
+    {
+        WriteDelaySketch();
+    }
+
     // Reset for potential future restart
     m_netDevice = nullptr;
 }
@@ -181,6 +240,13 @@ PeriodicSender::SendPacket()
 
     // Create a new packet with the configured size
     Ptr<Packet> packet = Create<Packet>(m_packetSize);
+    packet->AddPacketTag(RitTimestampTag(Simulator::Now()));
+    if (m_priority > 0)
+    {
+        SocketPriorityTag priorityTag;
+        priorityTag.SetPriority(m_priority);
+        packet->AddPacketTag(priorityTag);
+    }
     bool sendRequestIssued = false;
 
     // Send packet to the configured destination address (Mac16Address or Mac64Address).
@@ -227,8 +293,69 @@ PeriodicSender::ReceivePacket(Ptr<NetDevice> device,
     NS_LOG_INFO("[NetDev->App]:At " << Simulator::Now().GetSeconds() << "s node "
                                     << GetNode()->GetId() << " received packet from " << sender);
     m_rxTrace(packet);
+
+    RitTimestampTag timestamp;
+    if (packet->PeekPacketTag(timestamp))
+    {
+        m_delaySketch.Record(Simulator::Now() - timestamp.Get());
+        m_delaySketchDirty = true;
+    }
+
+    if (!m_rxHopLatencyTrace.IsEmpty())
+    {
+        std::vector<RitHopLatencyRecord> hops = RitHopLatencyTag::Collect(packet);
+        for (uint32_t i = 0; i < hops.size(); i++)
+        {
+            m_rxHopLatencyTrace(packet, i, hops[i]);
+        }
+    }
     return true;
 }
 
+const RitLatencySketch&
+PeriodicSender::GetDelaySketch() const
+{
+    return m_delaySketch;
+}
+
+int64_t
+PeriodicSender::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_timeDriftApplier->AssignStreams(stream);
+    return 1;
+}
+
+void
+PeriodicSender::WriteDelaySketch()
+{
+    NS_LOG_FUNCTION(this);
+    m_delaySketchDirty = false;
+    if (m_delaySketchFile.empty() || m_delaySketch.GetCount() == 0)
+    {
+        return;
+    }
+
+    // Snapshots are cumulative; the first write of the run truncates the file
+    std::ofstream ofs(m_delaySketchFile,
+                      m_delaySketchFileStarted ? std::ios::app : std::ios::trunc);
+    if (!ofs)
+    {
+        NS_LOG_ERROR("Cannot open delay sketch file " << m_delaySketchFile);
+        return;
+    }
+    m_delaySketchFileStarted = true;
+    m_delaySketch.Write(ofs, Simulator::Now());
+}
+
+void
+PeriodicSender::PeriodicDelaySketch()
+{
+    NS_LOG_FUNCTION(this);
+    WriteDelaySketch();
+    m_delaySketchEvent =
+        Simulator::Schedule(m_delaySketchInterval, &PeriodicSender::PeriodicDelaySketch, this);
+}
+
 } // namespace lrwpan
 } // namespace ns3
@@ -5,8 +5,13 @@
 #include "ns3/net-device.h"
 #include "ns3/node.h"
 #include "ns3/packet.h"
+#include "ns3/rit-timestamp-tag.h"
 #include "ns3/random-variable-stream.h"
 #include "ns3/simulator.h"
+#include "ns3/socket.h"
+#include "ns3/string.h"
+
+#include <fstream>
 
 namespace ns3
 {
@@ -53,6 +58,24 @@ RandomSender::GetTypeId()
                                           TimeValue(DEFAULT_INITIAL_DELAY),
                                           MakeTimeAccessor(&RandomSender::m_initialDelay),
                                           MakeTimeChecker())
+                            .AddAttribute("DelaySketchFile",
+                                          "CSV file receiving the end-to-end delay sketch "
+                                          "(time,lower_ns,upper_ns,count); empty disables it",
+                                          StringValue(""),
+                                          MakeStringAccessor(&RandomSender::m_delaySketchFile),
+                                          MakeStringChecker())
+                            .AddAttribute("DelaySketchInterval",
+                                          "Interval of the periodic delay sketch snapshots "
+                                          "(0 = only at the end of the run)",
+                                          TimeValue(Seconds(0)),
+                                          MakeTimeAccessor(&RandomSender::m_delaySketchInterval),
+                                          MakeTimeChecker(Seconds(0)))
+                            .AddAttribute("Priority",
+                                          "Priority class of the sent packets, as a "
+                                          "SocketPriorityTag (0: untagged)",
+                                          UintegerValue(0),
+                                          MakeUintegerAccessor(&RandomSender::m_priority),
+                                          MakeUintegerChecker<uint8_t>())
                             .AddTraceSource("Tx",
                                             "A packet has been sent",
                                             MakeTraceSourceAccessor(&RandomSender::m_txTrace),
@@ -60,7 +83,13 @@ RandomSender::GetTypeId()
                             .AddTraceSource("Rx",
                                             "A packet has been received",
                                             MakeTraceSourceAccessor(&RandomSender::m_rxTrace),
-                                            "ns3::Packet::TracedCallback");
+                                            "ns3::Packet::TracedCallback")
+                            .AddTraceSource(
+                                "RxHopLatency",
+                                "Per-hop latency breakdown of a received packet, one call "
+                                "per hop (packet, hop index, stage timestamps)",
+                                MakeTraceSourceAccessor(&RandomSender::m_rxHopLatencyTrace),
+                                "ns3::lrwpan::RandomSender::RxHopLatencyTracedCallback");
     return tid;
 }
 
@@ -69,9 +98,13 @@ RandomSender::RandomSender()
       m_maxInterval(DEFAULT_MAX_INTERVAL),
       m_initialDelay(DEFAULT_INITIAL_DELAY),
       m_packetSize(DEFAULT_PACKET_SIZE),
+      m_priority(0),
       m_dstAddr(),
       m_netDevice(nullptr),
-      m_noSendFlag(false)
+      m_noSendFlag(false),
+      m_delaySketchInterval(Seconds(0)),
+      m_delaySketchDirty(false),
+      m_delaySketchFileStarted(false)
 {
     NS_LOG_FUNCTION(this);
     m_timeDriftApplier = CreateObject<TimeDriftApplier>();
@@ -83,6 +116,19 @@ RandomSender::~RandomSender()
     NS_LOG_FUNCTION(this);
 }
 
+void
+RandomSender::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    // Runs without StopTime: write the final snapshot here
+    m_delaySketchEvent.Cancel();
+    if (m_delaySketchDirty)
+    {
+        WriteDelaySketch();
+    }
+    Application::DoDispose();
+}
+
 void
 RandomSender::SetMinInterval(Time minInterval)
 {
@@ -138,6 +184,13 @@ RandomSender::StartApplication()
 {
     NS_LOG_FUNCTION(this);
 
+    if (!m_delaySketchFile.empty() && m_delaySketchInterval.IsStrictlyPositive())
+    {
+        m_delaySketchEvent.Cancel();
+        m_delaySketchEvent =
+            Simulator::Schedule(m_delaySketchInterval, &RandomSender::PeriodicDelaySketch, this);
+    }
+
     if (m_noSendFlag)
     {
         NS_LOG_DEBUG("RandomSender is in no-send mode on node " << GetNode()->GetId());
@@ -181,6 +234,12 @@ RandomSender::StopApplication()
         Simulator::Cancel(m_sendEvent);
     }
 
+    m_delaySketchEvent.Cancel();
+    if (m_delaySketchDirty)
+    {
+        WriteDelaySketch();
+    }
+
     // Reset for potential future restart
     m_netDevice = nullptr;
 }
@@ -198,6 +257,13 @@ RandomSender::SendPacket()
 
     // Create a new packet with the configured size
     Ptr<Packet> packet = Create<Packet>(m_packetSize);
+    packet->AddPacketTag(RitTimestampTag(Simulator::Now()));
+    if (m_priority > 0)
+    {
+        SocketPriorityTag priorityTag;
+        priorityTag.SetPriority(m_priority);
+        packet->AddPacketTag(priorityTag);
+    }
     bool sendRequestIssued = false;
 
     // Send packet to the configured destination address (Mac16Address or Mac64Address).
@@ -247,9 +313,71 @@ RandomSender::ReceivePacket(Ptr<NetDevice> device,
     NS_LOG_INFO("[NetDev->App]:At " << Simulator::Now().GetSeconds() << "s node "
                                     << GetNode()->GetId() << " received packet from " << sender);
     m_rxTrace(packet);
+
+    RitTimestampTag timestamp;
+    if (packet->PeekPacketTag(timestamp))
+    {
+        m_delaySketch.Record(Simulator::Now() - timestamp.Get());
+        m_delaySketchDirty = true;
+    }
+
+    if (!m_rxHopLatencyTrace.IsEmpty())
+    {
+        std::vector<RitHopLatencyRecord> hops = RitHopLatencyTag::Collect(packet);
+        for (uint32_t i = 0; i < hops.size(); i++)
+        {
+            m_rxHopLatencyTrace(packet, i, hops[i]);
+        }
+    }
     return true;
 }
 
+const RitLatencySketch&
+RandomSender::GetDelaySketch() const
+{
+    return m_delaySketch;
+}
+
+int64_t
+RandomSender::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_timeDriftApplier->AssignStreams(stream);
+    m_randomVariable->SetStream(stream + 1);
+    return 2;
+}
+
+void
+RandomSender::WriteDelaySketch()
+{
+    NS_LOG_FUNCTION(this);
+    m_delaySketchDirty = false;
+    if (m_delaySketchFile.empty() || m_delaySketch.GetCount() == 0)
+    {
+        return;
+    }
+
+    // Snapshots are cumulative; the first write of the run truncates the file
+    std::ofstream ofs(m_delaySketchFile,
+                      m_delaySketchFileStarted ? std::ios::app : std::ios::trunc);
+    if (!ofs)
+    {
+        NS_LOG_ERROR("Cannot open delay sketch file " << m_delaySketchFile);
+        return;
+    }
+    m_delaySketchFileStarted = true;
+    m_delaySketch.Write(ofs, Simulator::Now());
+}
+
+void
+RandomSender::PeriodicDelaySketch()
+{
+    NS_LOG_FUNCTION(this);
+    WriteDelaySketch();
+    m_delaySketchEvent =
+        Simulator::Schedule(m_delaySketchInterval, &RandomSender::PeriodicDelaySketch, this);
+}
+
 Time
 RandomSender::GetRandomInterval()
 {
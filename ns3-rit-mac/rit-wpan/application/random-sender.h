@@ -8,10 +8,14 @@
 #include "ns3/mac64-address.h"
 #include "ns3/net-device.h"
 #include "ns3/ptr.h"
+#include "ns3/rit-hop-latency-tag.h"
+#include "ns3/rit-latency-sketch.h"
 #include "ns3/random-variable-stream.h"
 #include "ns3/time-drift-applier.h"
 #include "ns3/traced-callback.h"
 
+#include <string>
+
 namespace ns3
 {
 namespace lrwpan
@@ -96,12 +100,49 @@ class RandomSender : public Application
      */
     void StopApplication() override;
 
+    /**
+     * TracedCallback signature for the per-hop latency breakdown of a received packet.
+     *
+     * @param [in] packet The received packet
+     * @param [in] hop The hop index (0 = origin)
+     * @param [in] record The stage timestamps of the hop
+     */
+    typedef void (*RxHopLatencyTracedCallback)(Ptr<const Packet> packet,
+                                               uint32_t hop,
+                                               const RitHopLatencyRecord& record);
+
     bool ReceivePacket(Ptr<NetDevice> device,
                        Ptr<const Packet> packet,
                        uint16_t protocol,
                        const Address& sender);
 
+    /**
+     * @brief Get the end-to-end delay sketch of the received packets
+     * @return The delay sketch
+     */
+    const RitLatencySketch& GetDelaySketch() const;
+
+    /**
+     * @brief Assign fixed random variable streams to the interval randomization and the
+     *        interval draw.
+     * @param stream First stream index to use
+     * @return the number of stream indices assigned (2)
+     */
+    int64_t AssignStreams(int64_t stream) override;
+
   private:
+    void DoDispose() override;
+
+    /**
+     * @brief Append a snapshot of the delay sketch to DelaySketchFile
+     */
+    void WriteDelaySketch();
+
+    /**
+     * @brief Write a delay sketch snapshot and schedule the next one
+     */
+    void PeriodicDelaySketch();
+
     /**
      * @brief Send a packet
      */
@@ -117,6 +158,7 @@ class RandomSender : public Application
     Time m_maxInterval;         //!< Maximum packet sending interval
     Time m_initialDelay;        //!< Initial delay before starting transmissions
     uint8_t m_packetSize;       //!< Size of packets to send
+    uint8_t m_priority;         //!< Priority class of the sent packets (0: untagged)
     Address m_dstAddr;          //!< Destination address (Mac16Address or Mac64Address)
     Ptr<NetDevice> m_netDevice; //!< Network device used for sending
     EventId m_sendEvent;        //!< Event to schedule the next packet sending
@@ -125,8 +167,17 @@ class RandomSender : public Application
     Ptr<TimeDriftApplier> m_timeDriftApplier;    //!< For randomizing beacon interval
     Ptr<UniformRandomVariable> m_randomVariable; //!< Random variable for interval generation
 
+    RitLatencySketch m_delaySketch; //!< End-to-end delay of the received packets
+    std::string m_delaySketchFile;  //!< Delay sketch output file (empty = no export)
+    Time m_delaySketchInterval;     //!< Periodic snapshot interval (0 = final only)
+    EventId m_delaySketchEvent;     //!< Next periodic snapshot
+    bool m_delaySketchDirty;        //!< Samples recorded since the last snapshot
+    bool m_delaySketchFileStarted;  //!< The output file has been truncated
+
     TracedCallback<Ptr<const Packet>> m_txTrace; //!< Trace of transmitted packets
     TracedCallback<Ptr<const Packet>> m_rxTrace; //!< Trace of received packets
+    TracedCallback<Ptr<const Packet>, uint32_t, const RitHopLatencyRecord&>
+        m_rxHopLatencyTrace; //!< Per-hop latency breakdown of received packets
 };
 
 } // namespace lrwpan
@@ -0,0 +1,350 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-traffic-trace.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_LOG_COMPONENT_DEFINE("RitTrafficTrace");
+NS_OBJECT_ENSURE_REGISTERED(RitTrafficTrace);
+
+TypeId
+RitTrafficTrace::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::lrwpan::RitTrafficTrace")
+            .SetParent<Object>()
+            .SetGroupName("LrWpan")
+            .AddConstructor<RitTrafficTrace>();
+    return tid;
+}
+
+RitTrafficTrace::RitTrafficTrace()
+    : m_records(nullptr),
+      m_nRecords(0),
+      m_nextRecord(0),
+      m_map(nullptr),
+      m_mapSize(0),
+      m_pending(),
+      m_lastTimeNs(0),
+      m_generation(0),
+      m_started(false),
+      m_nDispatched(0),
+      m_nSkipped(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+RitTrafficTrace::~RitTrafficTrace()
+{
+    NS_LOG_FUNCTION(this);
+    Close();
+}
+
+void
+RitTrafficTrace::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    // Drops the pending dispatch
+    m_generation++;
+    m_senders.clear();
+    Close();
+    Object::DoDispose();
+}
+
+void
+RitTrafficTrace::Close()
+{
+    if (m_map)
+    {
+        munmap(m_map, m_mapSize);
+        m_map = nullptr;
+        m_mapSize = 0;
+    }
+    m_records = nullptr;
+    m_nRecords = 0;
+    m_nextRecord = 0;
+    if (m_csv.is_open())
+    {
+        m_csv.close();
+    }
+}
+
+void
+RitTrafficTrace::Open(const std::string& path)
+{
+    NS_LOG_FUNCTION(this << path);
+    NS_ABORT_MSG_IF(m_started, "Traffic trace opened during the replay");
+    Close();
+    m_path = path;
+    m_lastTimeNs = 0;
+    if (path.empty())
+    {
+        return;
+    }
+
+    char magic[4] = {};
+    {
+        std::ifstream probe(path, std::ios::binary);
+        NS_ABORT_MSG_UNLESS(probe.is_open(), "Unable to open traffic trace " << path);
+        probe.read(magic, sizeof(magic));
+    }
+    if (std::memcmp(magic, "RITR", 4) != 0)
+    {
+        m_csv.open(path);
+        NS_ABORT_MSG_UNLESS(m_csv.is_open(), "Unable to open traffic trace " << path);
+        return;
+    }
+
+    const int fd = open(path.c_str(), O_RDONLY);
+    NS_ABORT_MSG_IF(fd < 0, "Unable to open traffic trace " << path);
+    struct stat st;
+    NS_ABORT_MSG_IF(fstat(fd, &st) != 0, "Unable to stat traffic trace " << path);
+    m_mapSize = st.st_size;
+    m_map = mmap(nullptr, m_mapSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    NS_ABORT_MSG_IF(m_map == MAP_FAILED, "Unable to map traffic trace " << path);
+    // The records are read once, in order
+    madvise(m_map, m_mapSize, MADV_SEQUENTIAL);
+
+    RitTrafficFileHeader header;
+    NS_ABORT_MSG_IF(m_mapSize < sizeof(header), "Truncated traffic trace " << path);
+    std::memcpy(&header, m_map, sizeof(header));
+    NS_ABORT_MSG_IF(header.version != FORMAT_VERSION ||
+                        header.recordSize != sizeof(RitTrafficRecord),
+                    "Unsupported traffic trace format in " << path);
+    NS_ABORT_MSG_IF(m_mapSize < sizeof(header) + header.nRecords * sizeof(RitTrafficRecord),
+                    "Truncated traffic trace " << path);
+    m_records = reinterpret_cast<const RitTrafficRecord*>(static_cast<const char*>(m_map) +
+                                                          sizeof(header));
+    m_nRecords = header.nRecords;
+    NS_LOG_INFO("Mapped " << m_nRecords << " traffic records from " << path);
+}
+
+bool
+RitTrafficTrace::ParseLine(const std::string& line, RitTrafficRecord& record)
+{
+    const char* s = line.c_str();
+    while (std::isspace(static_cast<unsigned char>(*s)))
+    {
+        s++;
+    }
+    // Empty line, comment or header
+    if (*s == '\0' || *s == '#' || !(std::isdigit(static_cast<unsigned char>(*s)) || *s == '.'))
+    {
+        return false;
+    }
+
+    char* end = nullptr;
+    const double time = std::strtod(s, &end);
+    NS_ABORT_MSG_IF(*end != ',', "Malformed traffic record: " << line);
+    const unsigned long node = std::strtoul(end + 1, &end, 10);
+    NS_ABORT_MSG_IF(*end != ',', "Malformed traffic record: " << line);
+    const unsigned long size = std::strtoul(end + 1, &end, 10);
+    unsigned long priority = 0;
+    if (*end == ',')
+    {
+        priority = std::strtoul(end + 1, &end, 10);
+    }
+    NS_ABORT_MSG_IF(size > UINT16_MAX || priority > UINT8_MAX,
+                    "Traffic record out of range: " << line);
+
+    record = RitTrafficRecord();
+    record.timeNs = static_cast<int64_t>(std::llround(time * 1e9));
+    record.node = static_cast<uint32_t>(node);
+    record.size = static_cast<uint16_t>(size);
+    record.priority = static_cast<uint8_t>(priority);
+    return true;
+}
+
+bool
+RitTrafficTrace::Next(RitTrafficRecord& record)
+{
+    if (m_records)
+    {
+        if (m_nextRecord >= m_nRecords)
+        {
+            return false;
+        }
+        std::memcpy(&record, m_records + m_nextRecord++, sizeof(record));
+    }
+    else
+    {
+        std::string line;
+        bool found = false;
+        while (!found && std::getline(m_csv, line))
+        {
+            found = ParseLine(line, record);
+        }
+        if (!found)
+        {
+            return false;
+        }
+    }
+    NS_ABORT_MSG_IF(record.timeNs < m_lastTimeNs,
+                    "Traffic trace " << m_path << " not in time order at "
+                                     << NanoSeconds(record.timeNs).As(Time::S));
+    m_lastTimeNs = record.timeNs;
+    return true;
+}
+
+void
+RitTrafficTrace::Register(uint32_t node, uint32_t context, SendCallback cb)
+{
+    NS_LOG_FUNCTION(this << node << context);
+    m_senders[node] = Sender{context, cb};
+    if (!m_started)
+    {
+        m_started = true;
+        ScheduleNext();
+    }
+}
+
+void
+RitTrafficTrace::Unregister(uint32_t node)
+{
+    NS_LOG_FUNCTION(this << node);
+    m_senders.erase(node);
+}
+
+void
+RitTrafficTrace::ScheduleNext()
+{
+    const int64_t now = Simulator::Now().GetNanoSeconds();
+    RitTrafficRecord record;
+    while (Next(record))
+    {
+        if (record.timeNs < now)
+        {
+            // Before the start of the replay
+            m_nSkipped++;
+            continue;
+        }
+        m_pending = record;
+        // A node without a sender yet may register before the record is due: its
+        // context is then only known at the dispatch.
+        auto it = m_senders.find(record.node);
+        const uint32_t context =
+            it != m_senders.end() ? it->second.context : Simulator::GetContext();
+        Simulator::ScheduleWithContext(context,
+                                       NanoSeconds(record.timeNs - now),
+                                       &RitTrafficTrace::Dispatch,
+                                       Ptr<RitTrafficTrace>(this),
+                                       m_generation);
+        return;
+    }
+    NS_LOG_INFO("End of traffic trace " << m_path << ": " << m_nDispatched << " dispatched, "
+                                        << m_nSkipped << " skipped");
+}
+
+void
+RitTrafficTrace::Dispatch(uint64_t generation)
+{
+    if (generation != m_generation)
+    {
+        return;
+    }
+    auto it = m_senders.find(m_pending.node);
+    if (it == m_senders.end())
+    {
+        m_nSkipped++;
+    }
+    else if (it->second.context != Simulator::GetContext())
+    {
+        // Registered after the record was scheduled: move to the context of the node
+        Simulator::ScheduleWithContext(it->second.context,
+                                       Seconds(0),
+                                       [cb = it->second.cb, record = m_pending]() {
+                                           cb(record.size, record.priority);
+                                       });
+        m_nDispatched++;
+    }
+    else
+    {
+        it->second.cb(m_pending.size, m_pending.priority);
+        m_nDispatched++;
+    }
+
+    if (m_senders.empty())
+    {
+        // Every sender stopped: a new registration starts again from its time
+        m_started = false;
+        return;
+    }
+    ScheduleNext();
+}
+
+uint64_t
+RitTrafficTrace::GetNDispatched() const
+{
+    return m_nDispatched;
+}
+
+uint64_t
+RitTrafficTrace::GetNSkipped() const
+{
+    return m_nSkipped;
+}
+
+uint64_t
+RitTrafficTrace::ConvertToBinary(const std::string& csvPath, const std::string& binPath)
+{
+    NS_LOG_FUNCTION(csvPath << binPath);
+    std::ifstream in(csvPath);
+    NS_ABORT_MSG_UNLESS(in.is_open(), "Unable to open traffic trace " << csvPath);
+    std::ofstream out(binPath, std::ios::out | std::ios::binary | std::ios::trunc);
+    NS_ABORT_MSG_UNLESS(out.is_open(), "Unable to open traffic trace " << binPath);
+
+    RitTrafficFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "RITR", 4);
+    header.version = FORMAT_VERSION;
+    header.recordSize = sizeof(RitTrafficRecord);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    std::string line;
+    RitTrafficRecord record;
+    int64_t lastTimeNs = 0;
+    while (std::getline(in, line))
+    {
+        if (!ParseLine(line, record))
+        {
+            continue;
+        }
+        NS_ABORT_MSG_IF(record.timeNs < lastTimeNs,
+                        "Traffic trace " << csvPath << " not in time order");
+        lastTimeNs = record.timeNs;
+        out.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        header.nRecords++;
+    }
+
+    // Record count, known at the end
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    NS_ABORT_MSG_UNLESS(out.good(), "Unable to write traffic trace " << binPath);
+    return header.nRecords;
+}
+
+} // namespace lrwpan
+} // namespace ns3
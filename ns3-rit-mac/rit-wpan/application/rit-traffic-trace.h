@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef RIT_TRAFFIC_TRACE_H
+#define RIT_TRAFFIC_TRACE_H
+
+#include "ns3/callback.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @brief One packet of a traffic trace.
+ */
+struct RitTrafficRecord
+{
+    int64_t timeNs;   //!< Generation time [ns]
+    uint32_t node;    //!< Trace node id
+    uint16_t size;    //!< Payload size [bytes]
+    uint8_t priority; //!< Priority class (0: untagged)
+    uint8_t reserved; //!< Padding, 0
+};
+
+static_assert(sizeof(RitTrafficRecord) == 16, "RitTrafficRecord must stay 16 bytes");
+
+/**
+ * @brief Header of a binary traffic trace file (16 bytes), followed by the
+ *        RitTrafficRecord entries in time order.
+ */
+struct RitTrafficFileHeader
+{
+    char magic[4];       //!< "RITR"
+    uint16_t version;    //!< Format version
+    uint16_t recordSize; //!< sizeof(RitTrafficRecord)
+    uint64_t nRecords;   //!< Number of records
+};
+
+static_assert(sizeof(RitTrafficFileHeader) == 16, "RitTrafficFileHeader must stay 16 bytes");
+
+/**
+ * @ingroup lrwpan
+ *
+ * @brief Streams a traffic trace to the TraceReplaySender applications.
+ *
+ * The trace lists the packets of every node in time order, either as CSV lines
+ * "time_s,node,size,priority" (header line and '#' comments allowed) or as a binary
+ * file (RitTrafficFileHeader and RitTrafficRecord entries), which is memory-mapped.
+ * ConvertToBinary() writes the binary version of a CSV trace.
+ *
+ * Only the next record is held and only its event is scheduled, in the context of the
+ * node it belongs to: a trace of millions of records replays with constant memory.
+ * Records of trace nodes without a registered sender, and records earlier than the
+ * start of the replay, are skipped. A record earlier than the previous one aborts.
+ */
+class RitTrafficTrace : public Object
+{
+  public:
+    /// Format version written to the binary file header
+    static constexpr uint16_t FORMAT_VERSION = 1;
+
+    /**
+     * @brief Callback receiving a packet of the trace.
+     *
+     * Arguments: size [bytes], priority class.
+     */
+    typedef Callback<void, uint16_t, uint8_t> SendCallback;
+
+    /**
+     * @brief Get the TypeId
+     * @return The TypeId for this class
+     */
+    static TypeId GetTypeId();
+
+    RitTrafficTrace();
+    ~RitTrafficTrace() override;
+
+    /**
+     * @brief Open a trace file; the format is detected from its first bytes.
+     * @param path Trace file path
+     */
+    void Open(const std::string& path);
+
+    /**
+     * @brief Register the sender of a trace node. The replay starts with the first
+     *        registration, at the first record not earlier than the current time.
+     * @param node Trace node id
+     * @param context Context (ns-3 node id) of the events of the node
+     * @param cb Callback receiving the packets of the node
+     */
+    void Register(uint32_t node, uint32_t context, SendCallback cb);
+
+    /**
+     * @brief Unregister the sender of a trace node; its next records are skipped.
+     * @param node Trace node id
+     */
+    void Unregister(uint32_t node);
+
+    /**
+     * @brief Read the next record.
+     * @param record The record read
+     * @return false at the end of the trace
+     */
+    bool Next(RitTrafficRecord& record);
+
+    /**
+     * @brief Get the number of records handed to a sender.
+     * @return the number of records dispatched
+     */
+    uint64_t GetNDispatched() const;
+
+    /**
+     * @brief Get the number of records skipped (no sender, or before the replay start).
+     * @return the number of records skipped
+     */
+    uint64_t GetNSkipped() const;
+
+    /**
+     * @brief Write the binary version of a CSV trace.
+     * @param csvPath CSV trace path
+     * @param binPath Binary trace path
+     * @return the number of records written
+     */
+    static uint64_t ConvertToBinary(const std::string& csvPath, const std::string& binPath);
+
+  private:
+    void DoDispose() override;
+
+    /**
+     * @brief Parse a CSV line.
+     * @param line The line
+     * @param record The record parsed
+     * @return false for a header, comment or empty line
+     */
+    static bool ParseLine(const std::string& line, RitTrafficRecord& record);
+
+    /**
+     * @brief Schedule the next record that has a sender, or stop at the end of the trace.
+     */
+    void ScheduleNext();
+
+    /**
+     * @brief Hand the pending record to its sender and schedule the next one.
+     * @param generation m_generation when the record was scheduled
+     */
+    void Dispatch(uint64_t generation);
+
+    /**
+     * @brief Release the file or the mapping.
+     */
+    void Close();
+
+    /**
+     * @brief A registered sender.
+     */
+    struct Sender
+    {
+        uint32_t context; //!< Context of its events
+        SendCallback cb;  //!< Packet callback
+    };
+
+    std::string m_path;                             //!< Trace file path
+    std::ifstream m_csv;                            //!< CSV trace
+    const RitTrafficRecord* m_records;              //!< Mapped binary records, or nullptr
+    uint64_t m_nRecords;                            //!< Mapped records
+    uint64_t m_nextRecord;                          //!< Next mapped record
+    void* m_map;                                    //!< Mapping of the binary file
+    size_t m_mapSize;                               //!< Size of the mapping
+    std::unordered_map<uint32_t, Sender> m_senders; //!< Senders by trace node id
+    RitTrafficRecord m_pending;                     //!< Record of the scheduled dispatch
+    int64_t m_lastTimeNs;                           //!< Time of the last record read
+    uint64_t m_generation;                          //!< Dispatches of an older one are dropped
+    bool m_started;                                 //!< The replay started
+    uint64_t m_nDispatched;                         //!< Records handed to a sender
+    uint64_t m_nSkipped;                            //!< Records skipped
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // RIT_TRAFFIC_TRACE_H
@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "trace-replay-sender.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/mac16-address.h"
+#include "ns3/mac64-address.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/pointer.h"
+#include "ns3/rit-timestamp-tag.h"
+#include "ns3/simulator.h"
+#include "ns3/socket.h"
+#include "ns3/uinteger.h"
+
+#include <limits>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_LOG_COMPONENT_DEFINE("TraceReplaySender");
+NS_OBJECT_ENSURE_REGISTERED(TraceReplaySender);
+
+TypeId
+TraceReplaySender::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::lrwpan::TraceReplaySender")
+            .SetParent<Application>()
+            .SetGroupName("LrWpan")
+            .AddConstructor<TraceReplaySender>()
+            .AddAttribute("DstAddress",
+                          "The destination Address",
+                          AddressValue(),
+                          MakeAddressAccessor(&TraceReplaySender::m_dstAddr),
+                          MakeAddressChecker())
+            .AddAttribute("Trace",
+                          "The shared traffic trace replayed",
+                          PointerValue(),
+                          MakePointerAccessor(&TraceReplaySender::m_trace),
+                          MakePointerChecker<RitTrafficTrace>())
+            .AddAttribute("TraceNodeId",
+                          "Id of this node in the trace (4294967295: the ns-3 node id)",
+                          UintegerValue(std::numeric_limits<uint32_t>::max()),
+                          MakeUintegerAccessor(&TraceReplaySender::m_traceNodeId),
+                          MakeUintegerChecker<uint32_t>())
+            .AddTraceSource("Tx",
+                            "A packet has been sent",
+                            MakeTraceSourceAccessor(&TraceReplaySender::m_txTrace),
+                            "ns3::Packet::TracedCallback")
+            .AddTraceSource("Rx",
+                            "A packet has been received",
+                            MakeTraceSourceAccessor(&TraceReplaySender::m_rxTrace),
+                            "ns3::Packet::TracedCallback");
+    return tid;
+}
+
+TraceReplaySender::TraceReplaySender()
+    : m_dstAddr(),
+      m_trace(nullptr),
+      m_traceNodeId(std::numeric_limits<uint32_t>::max()),
+      m_netDevice(nullptr),
+      m_registered(false)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TraceReplaySender::~TraceReplaySender()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+TraceReplaySender::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_registered)
+    {
+        m_trace->Unregister(GetTraceNodeId());
+        m_registered = false;
+    }
+    m_trace = nullptr;
+    m_netDevice = nullptr;
+    Application::DoDispose();
+}
+
+void
+TraceReplaySender::SetDstAddr(const Address& addr)
+{
+    NS_LOG_FUNCTION(this << addr);
+    NS_ABORT_MSG_UNLESS(Mac16Address::IsMatchingType(addr) || Mac64Address::IsMatchingType(addr),
+                        "Address must be either Mac16Address or Mac64Address");
+    m_dstAddr = addr;
+}
+
+void
+TraceReplaySender::SetTrace(Ptr<RitTrafficTrace> trace)
+{
+    NS_LOG_FUNCTION(this << trace);
+    m_trace = trace;
+}
+
+void
+TraceReplaySender::SetTraceNodeId(uint32_t id)
+{
+    NS_LOG_FUNCTION(this << id);
+    m_traceNodeId = id;
+}
+
+uint32_t
+TraceReplaySender::GetTraceNodeId() const
+{
+    return m_traceNodeId == std::numeric_limits<uint32_t>::max() ? GetNode()->GetId()
+                                                                 : m_traceNodeId;
+}
+
+void
+TraceReplaySender::StartApplication()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_trace)
+    {
+        NS_LOG_DEBUG("TraceReplaySender without a trace on node " << GetNode()->GetId());
+        return;
+    }
+    NS_ASSERT(!m_dstAddr.IsInvalid());
+
+    m_netDevice = GetNode()->GetDevice(0);
+    if (m_netDevice == nullptr)
+    {
+        NS_LOG_ERROR("No LrWpan device found on node " << GetNode()->GetId());
+        return;
+    }
+
+    NS_LOG_DEBUG("(App Params)[nodeID: " << GetNode()->GetId() << "] TraceNodeId="
+                                         << GetTraceNodeId() << ", DstAddress=" << m_dstAddr);
+    m_trace->Register(GetTraceNodeId(),
+                      GetNode()->GetId(),
+                      MakeCallback(&TraceReplaySender::SendPacket, this));
+    m_registered = true;
+}
+
+void
+TraceReplaySender::StopApplication()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_registered)
+    {
+        m_trace->Unregister(GetTraceNodeId());
+        m_registered = false;
+    }
+    m_netDevice = nullptr;
+}
+
+void
+TraceReplaySender::SendPacket(uint16_t size, uint8_t priority)
+{
+    NS_LOG_FUNCTION(this << size << static_cast<uint32_t>(priority));
+    if (!m_netDevice)
+    {
+        NS_LOG_ERROR("Cannot send packet: network device not available");
+        return;
+    }
+
+    Ptr<Packet> packet = Create<Packet>(size);
+    packet->AddPacketTag(RitTimestampTag(Simulator::Now()));
+    if (priority > 0)
+    {
+        SocketPriorityTag priorityTag;
+        priorityTag.SetPriority(priority);
+        packet->AddPacketTag(priorityTag);
+    }
+
+    bool sendRequestIssued = false;
+    if (Mac16Address::IsMatchingType(m_dstAddr))
+    {
+        sendRequestIssued = m_netDevice->Send(packet, Mac16Address::ConvertFrom(m_dstAddr), 0);
+    }
+    else
+    {
+        sendRequestIssued = m_netDevice->Send(packet, Mac64Address::ConvertFrom(m_dstAddr), 0);
+    }
+
+    if (sendRequestIssued)
+    {
+        NS_LOG_INFO("[App->NetDev]:At " << Simulator::Now().GetSeconds() << "s node "
+                                        << GetNode()->GetId() << " issued send request for "
+                                        << size << " bytes to " << m_dstAddr);
+        m_txTrace(packet);
+    }
+    else
+    {
+        NS_LOG_ERROR("Failed to issue send request from node " << GetNode()->GetId());
+    }
+}
+
+bool
+TraceReplaySender::ReceivePacket(Ptr<NetDevice> device,
+                                 Ptr<const Packet> packet,
+                                 uint16_t protocol,
+                                 const Address& sender)
+{
+    NS_LOG_FUNCTION(this << device << packet << protocol << sender);
+    m_rxTrace(packet);
+    return true;
+}
+
+} // namespace lrwpan
+} // namespace ns3
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef TRACE_REPLAY_SENDER_H
+#define TRACE_REPLAY_SENDER_H
+
+#include "ns3/address.h"
+#include "ns3/application.h"
+#include "ns3/net-device.h"
+#include "ns3/ptr.h"
+#include "ns3/rit-traffic-trace.h"
+#include "ns3/traced-callback.h"
+
+#include <cstdint>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @ingroup lr-wpan
+ *
+ * @brief A sender application replaying the packets of one node of a traffic trace.
+ *
+ * The packets (time, size, priority class) come from a RitTrafficTrace shared by the
+ * senders of every node, which streams the trace and schedules only its next record.
+ * Each packet carries a RitTimestampTag, and a SocketPriorityTag for a non-zero
+ * priority, like the packets of RandomSender.
+ */
+class TraceReplaySender : public Application
+{
+  public:
+    /**
+     * @brief Get the TypeId
+     * @return The TypeId for this class
+     */
+    static TypeId GetTypeId();
+
+    TraceReplaySender();
+    ~TraceReplaySender() override;
+
+    /**
+     * @brief Set the destination address for packets
+     * @param addr The destination address (Mac16Address or Mac64Address)
+     */
+    void SetDstAddr(const Address& addr);
+
+    /**
+     * @brief Set the trace replayed
+     * @param trace The shared traffic trace
+     */
+    void SetTrace(Ptr<RitTrafficTrace> trace);
+
+    /**
+     * @brief Set the id of this node in the trace (default: the ns-3 node id)
+     * @param id Trace node id
+     */
+    void SetTraceNodeId(uint32_t id);
+
+    /**
+     * @brief Receive callback of the net device
+     * @param device The device
+     * @param packet The received packet
+     * @param protocol The protocol number
+     * @param sender The sender address
+     * @return true
+     */
+    bool ReceivePacket(Ptr<NetDevice> device,
+                       Ptr<const Packet> packet,
+                       uint16_t protocol,
+                       const Address& sender);
+
+  private:
+    void DoDispose() override;
+    void StartApplication() override;
+    void StopApplication() override;
+
+    /**
+     * @brief Send a packet of the trace
+     * @param size Payload size [bytes]
+     * @param priority Priority class (0: untagged)
+     */
+    void SendPacket(uint16_t size, uint8_t priority);
+
+    /**
+     * @brief Get the id of this node in the trace
+     * @return the trace node id
+     */
+    uint32_t GetTraceNodeId() const;
+
+    Address m_dstAddr;            //!< Destination address (Mac16Address or Mac64Address)
+    Ptr<RitTrafficTrace> m_trace; //!< Shared traffic trace
+    uint32_t m_traceNodeId;       //!< Trace node id, UINT32_MAX for the ns-3 node id
+    Ptr<NetDevice> m_netDevice;   //!< Network device used for sending
+    bool m_registered;            //!< Registered with the trace
+
+    TracedCallback<Ptr<const Packet>> m_txTrace; //!< Trace of transmitted packets
+    TracedCallback<Ptr<const Packet>> m_rxTrace; //!< Trace of received packets
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // TRACE_REPLAY_SENDER_H
@@ -18,16 +18,32 @@
 #include "ns3/core-module.h"
 #include "ns3/mobility-module.h"
 #include "ns3/network-module.h"
+#include "ns3/propagation-module.h"
 #include "ns3/rng-seed-manager.h"
 
+#include "ns3/event-flood-helper.h"
+#include "ns3/lr-wpan-event-profiler.h"
+#include "ns3/lr-wpan-spectrum-channel.h"
 #include "ns3/mac16-address.h"
 #include "ns3/periodic-sender-helper.h"
 #include "ns3/random-sender-helper.h"
+#include "ns3/rit-checkpoint-helper.h"
+#include "ns3/rit-partition-helper.h"
+#include "ns3/rit-performance-predictor.h"
 #include "ns3/rit-rank-helper.h"
+#include "ns3/rit-steady-state-controller.h"
+#include "ns3/rit-timestamp-tag.h"
+#include "ns3/rit-topology-helper.h"
 #include "ns3/rit-wpan-helper.h"
 #include "ns3/rit-wpan-net-device.h"
+#include "ns3/rit-wpan-nwk.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -49,14 +65,33 @@ struct ScenarioConfig
 {
     // RIT parameters (interpreted as milliseconds in the CLI as in the original code)
     double beaconIntervalMs = 5.0;     // BI
+    double sinkBeaconIntervalMs = 0.0; // SinkBI, 0 = BI with the historical divisors
     double dataWaitDurationMs = 10.0;  // DWD
     double txWaitDurationMs = 5000.0;  // TWD
+    uint32_t mainsRouterStride = 0;    // > 0: every Nth router always on with the SinkBI
 
     // Topology / run control
+    std::string scenarioFile; // Key=Value options read before the command line
     int32_t routerNodeCount = 12; // Nodes (if -1, derived from placement/density)
     uint32_t simulationDays = 1;
     double driftRatio = 10.0;
     uint32_t randomSeed = 1;
+    uint32_t runNumber = 0; // 0 = RNG run left at its default
+    std::string outputDir;  // empty = logs/<scenario>/<module>/BI.._SEEDxx/
+    bool rawTraces = true;
+    bool metricsEnabled = false;  // online summaries under <outputDir>summary/
+    bool steadyStateStop = false; // stop once the summaries are in their steady state
+    double steadyStateIntervalSec = 300.0;
+    double steadyStateTarget = 0.05; // relative CI half-width
+    double progressIntervalSec = 0.0; // 0 = no progress reports
+    std::string progressFile;         // empty = stderr
+    bool rangeCulledChannel = false;
+    bool pathLossCache = false;
+    uint32_t workerThreads = 0;
+    uint32_t regions = 1; // > 1: spatial regions of the culled channel, connected in process
+    uint32_t channels = 1; // > 1: per-node receive channels from channel 11
+    bool predict = false;     // analytical prediction in prediction.csv
+    bool predictOnly = false; // exit after the prediction
 
     // MAC module toggles
     bool dataCsmaEnabled = true;
@@ -69,8 +104,47 @@ struct ScenarioConfig
     bool beaconRandomizeEnabled = false;
     bool compactRitDataRequestEnabled = false;
     bool beaconAckEnabled = false;
+    bool earlyRxAbortEnabled = false;
+    bool fusedTrxEnabled = false;
+    bool idleCycleElisionEnabled = false;
+    bool phaseLearningEnabled = false;
+    bool overhearingAvoidanceEnabled = false;
+    bool contentionSlotsEnabled = false;
+    bool beaconDeconflictionEnabled = false;
+    bool dataWaitProbeEnabled = false;
+    bool ackAppointmentsEnabled = false;
+    bool headerIesEnabled = false;
+    bool duplicateFilterEnabled = false;
+    std::string periodPolicy = "none"; // "none", "aimd" or "target"
+
+    // NWK toggles
+    bool aggregationEnabled = false;
+    double aggregationMaxDelayMs = 500.0;
+    bool anycastEnabled = false;
+    bool backpressureEnabled = false;
+    uint32_t backpressureMinHeadroom = 1;
+    uint32_t maxRetries = 0;
+    std::string retryPolicy = "Random"; // "Random" or "Rendezvous"
+    bool duplicateDetection = false;
+    bool bootstrapEnabled = false;
+    bool localRepairEnabled = false;
+    double downlinkIntervalSec = 0.0; // 0 = no downlink traffic
+    double broadcastIntervalSec = 0.0; // 0 = no sink broadcasts
+    uint32_t sinkCount = 1;
+    double rankRangeM = 0.0; // 0 = derived from the router grid or the link budget
+
+    // Warm-up checkpoint
+    double checkpointAtSec = 0.0; // 0 = no checkpoint
+    std::string checkpointFile = "rit-checkpoint.csv";
+    std::string restoreFile; // empty = cold start
+
+    // Event profile
+    std::string profilePrefix; // empty = not profiled
 
     // Scenario variants
+    std::string topology = "grid";      // "grid", "random", "poisson", "clustered" or "csv"
+    std::string topologyFile;           // x,y,type layout of Topology=csv
+    double topologySpacingM = 40.0;     // mean router spacing of the generated layouts
     std::string nodePlacement = "edge"; // "edge" or "center"
     std::string nodeDensity = "low";    // "low" or "middle"
     std::string appType = "periodic";   // "periodic" or "random"
@@ -80,19 +154,91 @@ struct ScenarioConfig
     uint32_t appPeriodicIntervalSec = 300;
     uint32_t appRandomMinIntervalSec = 180;
     uint32_t appRandomMaxIntervalSec = 600;
+
+    // Correlated event flood on top of the application traffic
+    double floodAtSec = 0.0;        // 0 = no event
+    double floodEpicentreX = 0.0;   // epicentre of the event [m]
+    double floodEpicentreY = 0.0;
+    double floodSpeed = 0.0;        // propagation speed [m/s], 0 = every router at once
+    double floodJitterSec = 0.0;    // largest per-router detection delay
+    uint32_t floodReports = 1;      // reports per router
+    double floodReportIntervalSec = 1.0;
 };
 
 void
 BindCommandLine(CommandLine& cmd, ScenarioConfig& cfg)
 {
+    cmd.AddValue("Scenario",
+                 "Scenario file: one Key=Value option per line ('#' comments), read before "
+                 "the other arguments, which override it",
+                 cfg.scenarioFile);
     cmd.AddValue("BI", "Beacon interval (milliseconds)", cfg.beaconIntervalMs);
+    cmd.AddValue("SinkBI",
+                 "Beacon interval of the sinks (milliseconds, 0: BI, divided by 2.5 for "
+                 "edge/middle and by 4 for center/middle)",
+                 cfg.sinkBeaconIntervalMs);
     cmd.AddValue("TWD", "Sender wait duration (milliseconds)", cfg.txWaitDurationMs);
     cmd.AddValue("DWD", "Receiver data wait duration (milliseconds)", cfg.dataWaitDurationMs);
+    cmd.AddValue("MainsRouters",
+                 "Every Nth router is mains-powered: receiver always on and the beacon "
+                 "interval of the sinks (0: battery routers only)",
+                 cfg.mainsRouterStride);
 
     cmd.AddValue("Nodes", "Number of router nodes (-1: auto)", cfg.routerNodeCount);
     cmd.AddValue("Days", "Simulation duration in days", cfg.simulationDays);
     cmd.AddValue("DR", "Drift ratio", cfg.driftRatio);
     cmd.AddValue("Seed", "Random seed", cfg.randomSeed);
+    cmd.AddValue("Run",
+                 "RNG run number under the Seed (0: leave the default run)",
+                 cfg.runNumber);
+    cmd.AddValue("OutputDir",
+                 "Directory of the logs and summaries of this run (empty: derived from the "
+                 "parameters)",
+                 cfg.outputDir);
+    cmd.AddValue("Traces", "Write the per-node logs", cfg.rawTraces);
+    cmd.AddValue("Predict",
+                 "Write the analytical prediction (RitPerformancePredictor) of the network to "
+                 "prediction.csv and prediction-nodes.csv",
+                 cfg.predict);
+    cmd.AddValue("PredictOnly",
+                 "Write the prediction and exit without simulating (implies Predict)",
+                 cfg.predictOnly);
+    cmd.AddValue("Metrics",
+                 "Write the online summary tables (RitMetricsCollector) under summary/",
+                 cfg.metricsEnabled);
+    cmd.AddValue("SteadyStateStop",
+                 "Stop before Days once PDR, delay and wake ratio are in their steady state "
+                 "and known to SteadyStateTarget (needs Metrics)",
+                 cfg.steadyStateStop);
+    cmd.AddValue("SteadyStateInterval",
+                 "Observation interval [s] of the steady-state detection",
+                 cfg.steadyStateIntervalSec);
+    cmd.AddValue("SteadyStateTarget",
+                 "Largest 95% CI half-width relative to the mean for the steady-state stop",
+                 cfg.steadyStateTarget);
+    cmd.AddValue("Progress",
+                 "Report the progress of the run every this many simulated seconds "
+                 "(0: never)",
+                 cfg.progressIntervalSec);
+    cmd.AddValue("ProgressFile",
+                 "JSON-lines file of the progress reports (empty: stderr)",
+                 cfg.progressFile);
+    cmd.AddValue("RangeCulledChannel",
+                 "Only deliver frames to the nodes in radio range (LrWpanSpectrumChannel)",
+                 cfg.rangeCulledChannel);
+    cmd.AddValue("PathLossCache",
+                 "Cache the pairwise path losses (with RangeCulledChannel)",
+                 cfg.pathLossCache);
+    cmd.AddValue("WorkerThreads",
+                 "Threads computing the path losses of a frame (with RangeCulledChannel)",
+                 cfg.workerThreads);
+    cmd.AddValue("Regions",
+                 "Split the culled channel into this many spatial regions and count the "
+                 "transmissions crossing them (with RangeCulledChannel)",
+                 cfg.regions);
+    cmd.AddValue("Channels",
+                 "Receive channels of the nodes, from channel 11 (1: all on one channel)",
+                 cfg.channels);
 
     cmd.AddValue("DataCsma", "Enable CSMA for data transmission", cfg.dataCsmaEnabled);
     cmd.AddValue("BeaconCsma", "Enable CSMA for beacon transmission", cfg.beaconCsmaEnabled);
@@ -107,7 +253,108 @@ BindCommandLine(CommandLine& cmd, ScenarioConfig& cfg)
                  "Enable compact RIT Data Request header",
                  cfg.compactRitDataRequestEnabled);
     cmd.AddValue("BeaconAck", "Enable ACK for beacon transmission", cfg.beaconAckEnabled);
-
+    cmd.AddValue("EarlyRxAbort",
+                 "Drop frames for other nodes after the MAC header",
+                 cfg.earlyRxAbortEnabled);
+    cmd.AddValue("FusedTrx",
+                 "Wake, send the beacon and enter RX in one PHY call",
+                 cfg.fusedTrxEnabled);
+    cmd.AddValue("IdleElision",
+                 "Skip the data wait of idle cycles nobody can hear (needs RangeCulledChannel)",
+                 cfg.idleCycleElisionEnabled);
+    cmd.AddValue("PhaseLearning",
+                 "Wake senders just before the learned beacon of their receiver",
+                 cfg.phaseLearningEnabled);
+    cmd.AddValue("Overhearing",
+                 "End or defer RIT cycles on an overheard foreign rendezvous",
+                 cfg.overhearingAvoidanceEnabled);
+    cmd.AddValue("ContentionSlots",
+                 "Answer beacons in hashed response slots so several senders share one",
+                 cfg.contentionSlotsEnabled);
+    cmd.AddValue("BeaconDeconfliction",
+                 "Move each beacon into the largest gap between the neighbour beacons",
+                 cfg.beaconDeconflictionEnabled);
+    cmd.AddValue("DataWaitProbe",
+                 "End the data wait early when an energy probe finds no sender answering",
+                 cfg.dataWaitProbeEnabled);
+    cmd.AddValue("AckAppointments",
+                 "Grant the next beacon time in the data ACKs; senders sleep until then",
+                 cfg.ackAppointmentsEnabled);
+    cmd.AddValue("HeaderIes",
+                 "Carry header IEs in the RIT Data Requests and data ACKs",
+                 cfg.headerIesEnabled);
+    cmd.AddValue("DuplicateFilter",
+                 "Acknowledge again, but indicate once, a data frame retried after a lost ACK",
+                 cfg.duplicateFilterEnabled);
+    cmd.AddValue("PeriodPolicy",
+                 "Adapt the RIT period of each node to its inbound load (none/aimd/target)",
+                 cfg.periodPolicy);
+    cmd.AddValue("Aggregation",
+                 "Aggregate NWK packets toward the same destination into one MAC frame",
+                 cfg.aggregationEnabled);
+    cmd.AddValue("AggregationDelay",
+                 "Longest aggregation hold time of a NWK packet (milliseconds)",
+                 cfg.aggregationMaxDelayMs);
+    cmd.AddValue("Anycast",
+                 "Send to the first beacon of any lower-rank neighbour with queue headroom",
+                 cfg.anycastEnabled);
+    cmd.AddValue("Backpressure",
+                 "Leave unanswered the beacons of next hops without queue headroom",
+                 cfg.backpressureEnabled);
+    cmd.AddValue("BackpressureMinHeadroom",
+                 "Free queue frames a next hop must advertise (Backpressure)",
+                 cfg.backpressureMinHeadroom);
+    cmd.AddValue("MaxRetries", "NWK retries after a NO_ACK", cfg.maxRetries);
+    cmd.AddValue("RetryPolicy",
+                 "Time of a NWK retry: random delay or next predicted parent beacon "
+                 "(Random/Rendezvous)",
+                 cfg.retryPolicy);
+    cmd.AddValue("DuplicateDetection",
+                 "Drop at the relays and the sink the unicast packets already received",
+                 cfg.duplicateDetection);
+    cmd.AddValue("Bootstrap",
+                 "Discover the router ranks from the beacons instead of the static rank tables",
+                 cfg.bootstrapEnabled);
+    cmd.AddValue("LocalRepair",
+                 "Switch a bootstrapped router to another parent after consecutive failures",
+                 cfg.localRepairEnabled);
+    cmd.AddValue("DownlinkInterval",
+                 "Interval [s] of the source-routed sink packets, sent to the routers in turn "
+                 "(0 disables downlink routing)",
+                 cfg.downlinkIntervalSec);
+    cmd.AddValue("BroadcastInterval",
+                 "Interval [s] of the network-wide broadcasts of the first sink (0: none)",
+                 cfg.broadcastIntervalSec);
+    cmd.AddValue("Sinks",
+                 "Number of sinks; the extra ones sit one grid step past the far edge and "
+                 "the routers send to any sink",
+                 cfg.sinkCount);
+    cmd.AddValue("RankRange",
+                 "Hop range [m] of the static ranks with several sinks or a generated "
+                 "topology (0: 1.5 grid steps, at least the first sink hop; link range of "
+                 "the channel and PHY for a generated topology)",
+                 cfg.rankRangeM);
+    cmd.AddValue("CheckpointAt",
+                 "Time [s] at which the warm-up state is written to CheckpointFile (0: never)",
+                 cfg.checkpointAtSec);
+    cmd.AddValue("CheckpointFile", "Warm-up checkpoint file", cfg.checkpointFile);
+    cmd.AddValue("Restore",
+                 "Checkpoint file to continue from, in place of the bootstrap (empty: cold "
+                 "start)",
+                 cfg.restoreFile);
+    cmd.AddValue("Profile",
+                 "Profile the MAC/PHY/NWK events into <Profile>-events.csv and "
+                 "<Profile>.folded (empty: off)",
+                 cfg.profilePrefix);
+
+    cmd.AddValue("Topology",
+                 "Layout: the hand-made grids of Placement/Density, or a generated or "
+                 "imported one ranked over the link range (grid/random/poisson/clustered/csv)",
+                 cfg.topology);
+    cmd.AddValue("TopologyFile", "x,y,type layout file of Topology=csv", cfg.topologyFile);
+    cmd.AddValue("TopologySpacing",
+                 "Mean router spacing [m] of the generated layouts",
+                 cfg.topologySpacingM);
     cmd.AddValue("Placement", "Node placement type (edge/center)", cfg.nodePlacement);
     cmd.AddValue("Density", "Node density type (low/middle)", cfg.nodeDensity);
     cmd.AddValue("App", "Application type (periodic/random)", cfg.appType);
@@ -122,6 +369,23 @@ BindCommandLine(CommandLine& cmd, ScenarioConfig& cfg)
                  "Maximum interval for random application (seconds)",
                  cfg.appRandomMaxIntervalSec);
     cmd.AddValue("AppPacketSize", "Packet size for application (bytes)", cfg.appPacketSize);
+
+    cmd.AddValue("FloodAt",
+                 "Time [s] an event starts at the epicentre and makes the routers it reaches "
+                 "report (0: no event)",
+                 cfg.floodAtSec);
+    cmd.AddValue("FloodX", "Epicentre x [m] of the event", cfg.floodEpicentreX);
+    cmd.AddValue("FloodY", "Epicentre y [m] of the event", cfg.floodEpicentreY);
+    cmd.AddValue("FloodSpeed",
+                 "Propagation speed [m/s] of the event (0: every router at once)",
+                 cfg.floodSpeed);
+    cmd.AddValue("FloodJitter",
+                 "Largest detection delay [s] of a router after the event reached it",
+                 cfg.floodJitterSec);
+    cmd.AddValue("FloodReports", "Reports of each router for the event", cfg.floodReports);
+    cmd.AddValue("FloodReportInterval",
+                 "Interval [s] between the reports of a router",
+                 cfg.floodReportIntervalSec);
 }
 
 void
@@ -172,6 +436,10 @@ ResolveRouterNodeCount(ScenarioConfig& cfg)
 Time
 EffectiveParentBeaconInterval(const ScenarioConfig& cfg)
 {
+    if (cfg.sinkBeaconIntervalMs > 0.0)
+    {
+        return MilliSeconds(cfg.sinkBeaconIntervalMs);
+    }
     // Preserve the original special-cases exactly.
     if (cfg.nodePlacement == "edge" && cfg.nodeDensity == "middle")
     {
@@ -200,9 +468,116 @@ MakeModuleConfig(const ScenarioConfig& cfg)
     m.beaconRandomizeEnabled = cfg.beaconRandomizeEnabled;
     m.compactRitDataRequestEnabled = cfg.compactRitDataRequestEnabled;
     m.beaconAckEnabled = cfg.beaconAckEnabled;
+    m.earlyRxAbortEnabled = cfg.earlyRxAbortEnabled;
+    m.fusedTrxEnabled = cfg.fusedTrxEnabled;
+    m.idleCycleElisionEnabled = cfg.idleCycleElisionEnabled;
+    m.phaseLearningEnabled = cfg.phaseLearningEnabled;
+    m.overhearingAvoidanceEnabled = cfg.overhearingAvoidanceEnabled;
+    m.contentionSlotsEnabled = cfg.contentionSlotsEnabled;
+    m.beaconDeconflictionEnabled = cfg.beaconDeconflictionEnabled;
+    m.dataWaitProbeEnabled = cfg.dataWaitProbeEnabled;
+    m.ackAppointmentsEnabled = cfg.ackAppointmentsEnabled;
+    m.headerIesEnabled = cfg.headerIesEnabled;
+    m.duplicateFilterEnabled = cfg.duplicateFilterEnabled;
     return m;
 }
 
+/**
+ * Predict the performance of the installed network with RitPerformancePredictor and
+ * write prediction.csv (pred_* key,value) and prediction-nodes.csv to the output
+ * directory (the working directory without OutputDir). The ranks are those known
+ * before the run: a Bootstrap discovers them later. The event flood is not part of
+ * the application rate.
+ */
+void
+WritePrediction(const ScenarioConfig& cfg, NodeContainer allNodes, Ptr<RitWpanNetDevice> routerDev)
+{
+    RitPredictorParameters parameters;
+    parameters.ritPeriod = MilliSeconds(cfg.beaconIntervalMs);
+    parameters.alwaysOnRitPeriod = EffectiveParentBeaconInterval(cfg);
+    parameters.dataWaitDuration = MilliSeconds(cfg.dataWaitDurationMs);
+    parameters.txWaitDuration = MilliSeconds(cfg.txWaitDurationMs);
+    // NWK header (6 bytes), MAC header and FCS (11 bytes)
+    parameters.dataBytes = cfg.appPacketSize + 17;
+    parameters.maxRetries = cfg.maxRetries;
+
+    double range = cfg.rankRangeM;
+    if (range <= 0.0)
+    {
+        range = RitTopologyHelper::GetLinkRange(
+            DynamicCast<SpectrumChannel>(routerDev->GetChannel()),
+            routerDev->GetPhy());
+    }
+    const double appRate =
+        cfg.appType == "random"
+            ? 2.0 / (cfg.appRandomMinIntervalSec + cfg.appRandomMaxIntervalSec)
+            : 1.0 / cfg.appPeriodicIntervalSec;
+
+    RitPerformancePredictor predictor;
+    predictor.SetModuleConfig(MakeModuleConfig(cfg));
+    predictor.SetParameters(parameters);
+    predictor.AddNodes(allNodes, range, appRate);
+    const RitNetworkPrediction prediction = predictor.Predict();
+
+    std::string baseDir = cfg.outputDir;
+    if (!baseDir.empty())
+    {
+        std::filesystem::create_directories(baseDir);
+        if (baseDir.back() != '/')
+        {
+            baseDir += "/";
+        }
+    }
+    std::ofstream summary(baseDir + "prediction.csv");
+    RitPerformancePredictor::WriteSummary(prediction, summary);
+    std::ofstream nodes(baseDir + "prediction-nodes.csv");
+    predictor.WriteNodes(prediction, nodes);
+    NS_LOG_UNCOND("Prediction: wake ratio " << prediction.wakeRatioMean << " (max "
+                                            << prediction.wakeRatioMax << ") | delay "
+                                            << prediction.delayMean << " s (max "
+                                            << prediction.delayMax << " s) | PDR "
+                                            << prediction.pdr
+                                            << (prediction.saturated ? " | saturated" : ""));
+}
+
+/**
+ * Generate or read the layout of Topology (not grid). The generated layouts cover
+ * a square with one router per TopologySpacing^2 and the sink at its centre.
+ */
+RitTopology
+BuildTopology(const ScenarioConfig& cfg, RitTopologyHelper& topologyHelper)
+{
+    if (cfg.topology == "csv")
+    {
+        if (cfg.topologyFile.empty())
+        {
+            NS_FATAL_ERROR("Topology=csv needs a TopologyFile");
+        }
+        return RitTopologyHelper::ReadCsv(cfg.topologyFile);
+    }
+
+    const uint32_t n = static_cast<uint32_t>(std::max(cfg.routerNodeCount, 0));
+    const double side = cfg.topologySpacingM * std::sqrt(static_cast<double>(n));
+    if (cfg.topology == "random")
+    {
+        return topologyHelper.RandomGeometric(n, side, side);
+    }
+    if (cfg.topology == "poisson")
+    {
+        return topologyHelper.PoissonDisc(n, side, side, cfg.topologySpacingM / 2);
+    }
+    if (cfg.topology == "clustered")
+    {
+        // Buildings of about 20 routers
+        return topologyHelper.Clustered(n,
+                                        std::max(1U, n / 20),
+                                        side,
+                                        side,
+                                        2 * cfg.topologySpacingM);
+    }
+    NS_FATAL_ERROR("Unsupported topology: " << cfg.topology);
+}
+
 void
 InstallTopologyEdge(const ScenarioConfig& cfg, NodeContainer routers, NodeContainer parent)
 {
@@ -343,10 +718,76 @@ InstallTopologyCenter(const ScenarioConfig& cfg, NodeContainer routers, NodeCont
     parentMob.Install(parent);
 }
 
+/**
+ * Place the sinks after the first one on a row one grid step past the far edge
+ * of the routers, spread evenly along it, and re-rank the routers by hop count
+ * to the nearest sink (unless they bootstrap).
+ */
 void
-InstallApplications(const ScenarioConfig& cfg, NodeContainer routers, NodeContainer parent)
+InstallExtraSinks(const ScenarioConfig& cfg, NodeContainer routers, NodeContainer sinks)
 {
-    const Mac16Address sink("00:00");
+    double minX = std::numeric_limits<double>::max();
+    double maxX = std::numeric_limits<double>::lowest();
+    double maxY = std::numeric_limits<double>::lowest();
+    std::vector<double> rows;
+    for (uint32_t i = 0; i < routers.GetN(); i++)
+    {
+        const Vector pos = routers.Get(i)->GetObject<MobilityModel>()->GetPosition();
+        minX = std::min(minX, pos.x);
+        maxX = std::max(maxX, pos.x);
+        maxY = std::max(maxY, pos.y);
+        rows.push_back(pos.y);
+    }
+    std::sort(rows.begin(), rows.end());
+    double step = 0.0;
+    for (size_t i = 1; i < rows.size() && step == 0.0; i++)
+    {
+        step = rows[i] - rows[i - 1];
+    }
+
+    auto sinkPos = CreateObject<ListPositionAllocator>();
+    const uint32_t nExtra = sinks.GetN() - 1;
+    for (uint32_t k = 0; k < nExtra; k++)
+    {
+        sinkPos->Add(Vector(minX + (maxX - minX) * (k + 1) / (nExtra + 1), maxY + step, 0.0));
+    }
+    NodeContainer extra;
+    for (uint32_t k = 1; k < sinks.GetN(); k++)
+    {
+        extra.Add(sinks.Get(k));
+    }
+    MobilityHelper sinkMob;
+    sinkMob.SetPositionAllocator(sinkPos);
+    sinkMob.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    sinkMob.Install(extra);
+
+    double range = cfg.rankRangeM;
+    if (range <= 0.0)
+    {
+        // The first sink must reach the routers that had rank 1.
+        Ptr<MobilityModel> first = sinks.Get(0)->GetObject<MobilityModel>();
+        double nearest = std::numeric_limits<double>::max();
+        for (uint32_t i = 0; i < routers.GetN(); i++)
+        {
+            nearest = std::min(nearest,
+                               first->GetDistanceFrom(routers.Get(i)->GetObject<MobilityModel>()));
+        }
+        range = std::max(1.5 * step, nearest * 1.01);
+    }
+
+    // Routers are numbered after the sinks (set by RitWpanNetHelper::InstallSinks()).
+    RitWpanRankHelper rankHelper;
+    rankHelper.Install(routers, sinks, range);
+}
+
+int64_t
+InstallApplications(const ScenarioConfig& cfg,
+                    NodeContainer routers,
+                    NodeContainer parent,
+                    int64_t stream)
+{
+    const Mac16Address sink =
+        cfg.sinkCount > 1 ? RitSimpleRouting::GetAnySinkAddress() : Mac16Address("00:00");
 
     if (cfg.appType == "periodic")
     {
@@ -355,11 +796,12 @@ InstallApplications(const ScenarioConfig& cfg, NodeContainer routers, NodeContai
         routerApp.SetPacketSize(cfg.appPacketSize);
         routerApp.SetDstAddr(sink);
         routerApp.Install(routers);
+        const int64_t span = routerApp.AssignStreams(routers, stream);
 
         PeriodicSenderHelper parentApp;
         parentApp.SetReceiveOnly(true);
         parentApp.Install(parent);
-        return;
+        return std::max(span, parentApp.AssignStreams(parent, stream));
     }
 
     if (cfg.appType == "random")
@@ -370,14 +812,60 @@ InstallApplications(const ScenarioConfig& cfg, NodeContainer routers, NodeContai
         routerApp.SetPacketSize(cfg.appPacketSize);
         routerApp.SetDstAddr(sink);
         routerApp.Install(routers);
+        const int64_t span = routerApp.AssignStreams(routers, stream);
 
         RandomSenderHelper parentApp;
         parentApp.SetReceiveOnly(true);
         parentApp.Install(parent);
-        return;
+        return std::max(span, parentApp.AssignStreams(parent, stream));
     }
 
     NS_FATAL_ERROR("Unsupported application type: " << cfg.appType);
+    return 0;
+}
+
+void
+InstallEventFlood(const ScenarioConfig& cfg, NodeContainer routers, int64_t stream)
+{
+    EventFloodHelper flood;
+    flood.SetDstAddr(cfg.sinkCount > 1 ? RitSimpleRouting::GetAnySinkAddress()
+                                       : Mac16Address("00:00"));
+    flood.SetPacketSize(cfg.appPacketSize);
+    flood.SetEpicentre(Vector(cfg.floodEpicentreX, cfg.floodEpicentreY, 0.0));
+    flood.SetStartTime(Seconds(cfg.floodAtSec));
+    flood.SetSpeed(cfg.floodSpeed);
+    flood.SetJitter(Seconds(cfg.floodJitterSec));
+    flood.SetReports(cfg.floodReports, Seconds(cfg.floodReportIntervalSec));
+    flood.Install(routers);
+    flood.AssignStreams(routers, stream);
+}
+
+void
+SendDownlink(Ptr<RitWpanNetDevice> sink,
+             std::vector<Mac16Address> routers,
+             size_t next,
+             Time interval,
+             uint32_t packetSize)
+{
+    Ptr<Packet> packet = Create<Packet>(packetSize);
+    packet->AddPacketTag(RitTimestampTag(Simulator::Now()));
+    sink->Send(packet, routers[next]);
+    Simulator::Schedule(interval,
+                        &SendDownlink,
+                        sink,
+                        routers,
+                        (next + 1) % routers.size(),
+                        interval,
+                        packetSize);
+}
+
+void
+SendBroadcast(Ptr<RitWpanNetDevice> sink, Time interval, uint32_t packetSize)
+{
+    Ptr<Packet> packet = Create<Packet>(packetSize);
+    packet->AddPacketTag(RitTimestampTag(Simulator::Now()));
+    sink->Send(packet, Mac16Address::GetBroadcast());
+    Simulator::Schedule(interval, &SendBroadcast, sink, interval, packetSize);
 }
 
 void
@@ -386,12 +874,19 @@ PrintRunSummary(const ScenarioConfig& cfg, const std::string& scenarioType)
     NS_LOG_UNCOND("==== Simulation parameters ====");
     NS_LOG_UNCOND("ScenarioType: " << scenarioType
                                   << " | BI: " << cfg.beaconIntervalMs << " ms"
+                                  << " | SinkBI: "
+                                  << EffectiveParentBeaconInterval(cfg).As(Time::MS)
                                   << " | DWD: " << cfg.dataWaitDurationMs << " ms"
                                   << " | TWD: " << cfg.txWaitDurationMs << " ms"
                                   << " | Nodes: " << cfg.routerNodeCount
                                   << " | Days: " << cfg.simulationDays
                                   << " | DR: " << cfg.driftRatio
                                   << " | Seed: " << cfg.randomSeed
+                                  << " | Run: " << cfg.runNumber
+                                  << " | RangeCulledChannel: "
+                                  << (cfg.rangeCulledChannel ? "true" : "false")
+                                  << " | Regions: " << cfg.regions
+                                  << " | Channels: " << cfg.channels
                                   << " | DataCsma: " << (cfg.dataCsmaEnabled ? "true" : "false")
                                   << " | BeaconCsma: " << (cfg.beaconCsmaEnabled ? "true" : "false")
                                   << " | DataPreCs: " << (cfg.dataPreCsEnabled ? "true" : "false")
@@ -401,9 +896,111 @@ PrintRunSummary(const ScenarioConfig& cfg, const std::string& scenarioType)
                                   << " | CompactRitDataRequest: "
                                   << (cfg.compactRitDataRequestEnabled ? "true" : "false")
                                   << " | BeaconAck: " << (cfg.beaconAckEnabled ? "true" : "false")
+                                  << " | EarlyRxAbort: "
+                                  << (cfg.earlyRxAbortEnabled ? "true" : "false")
+                                  << " | FusedTrx: "
+                                  << (cfg.fusedTrxEnabled ? "true" : "false")
+                                  << " | IdleElision: "
+                                  << (cfg.idleCycleElisionEnabled ? "true" : "false")
+                                  << " | PhaseLearning: "
+                                  << (cfg.phaseLearningEnabled ? "true" : "false")
+                                  << " | Overhearing: "
+                                  << (cfg.overhearingAvoidanceEnabled ? "true" : "false")
+                                  << " | ContentionSlots: "
+                                  << (cfg.contentionSlotsEnabled ? "true" : "false")
+                                  << " | BeaconDeconfliction: "
+                                  << (cfg.beaconDeconflictionEnabled ? "true" : "false")
+                                  << " | DataWaitProbe: "
+                                  << (cfg.dataWaitProbeEnabled ? "true" : "false")
+                                  << " | AckAppointments: "
+                                  << (cfg.ackAppointmentsEnabled ? "true" : "false")
+                                  << " | HeaderIes: " << (cfg.headerIesEnabled ? "true" : "false")
+                                  << " | DuplicateFilter: "
+                                  << (cfg.duplicateFilterEnabled ? "true" : "false")
+                                  << " | PeriodPolicy: " << cfg.periodPolicy
+                                  << " | Aggregation: "
+                                  << (cfg.aggregationEnabled ? "true" : "false")
+                                  << " | Anycast: " << (cfg.anycastEnabled ? "true" : "false")
+                                  << " | Backpressure: "
+                                  << (cfg.backpressureEnabled ? "true" : "false")
+                                  << " | MaxRetries: " << cfg.maxRetries
+                                  << " | RetryPolicy: " << cfg.retryPolicy
+                                  << " | DuplicateDetection: "
+                                  << (cfg.duplicateDetection ? "true" : "false")
+                                  << " | Bootstrap: " << (cfg.bootstrapEnabled ? "true" : "false")
+                                  << " | LocalRepair: "
+                                  << (cfg.localRepairEnabled ? "true" : "false")
+                                  << " | DownlinkInterval: " << cfg.downlinkIntervalSec << " s"
+                                  << " | BroadcastInterval: " << cfg.broadcastIntervalSec
+                                  << " s"
+                                  << " | Sinks: " << cfg.sinkCount
+                                  << " | Restore: "
+                                  << (cfg.restoreFile.empty() ? "none" : cfg.restoreFile)
+                                  << " | Profile: "
+                                  << (cfg.profilePrefix.empty() ? "none" : cfg.profilePrefix)
+                                  << " | Scenario: "
+                                  << (cfg.scenarioFile.empty() ? "none" : cfg.scenarioFile)
+                                  << " | Topology: " << cfg.topology
                                   << " | Placement: " << cfg.nodePlacement
                                   << " | Density: " << cfg.nodeDensity
-                                  << " | App: " << cfg.appType);
+                                  << " | App: " << cfg.appType
+                                  << " | FloodAt: " << cfg.floodAtSec << " s"
+                                  << " | SteadyStateStop: "
+                                  << (cfg.steadyStateStop ? "true" : "false"));
+}
+
+/**
+ * Read the options of a scenario file as command-line arguments. Each line holds
+ * one Key=Value option of BindCommandLine() (the leading "--" is optional) or an
+ * attribute default such as ns3::lrwpan::LrWpanErrorModel::UseLookupTable=true;
+ * blank lines and '#' comments are skipped. The file is read line by line, and a
+ * large layout stays in its own file (Topology=csv, TopologyFile=...).
+ */
+std::vector<std::string>
+ReadScenarioFile(const std::string& path, const std::string& program)
+{
+    std::ifstream in(path);
+    if (!in)
+    {
+        NS_FATAL_ERROR("Cannot read scenario file " << path);
+    }
+    std::vector<std::string> args{program};
+    std::string line;
+    while (std::getline(in, line))
+    {
+        line = line.substr(0, line.find('#'));
+        const size_t begin = line.find_first_not_of(" \t\r");
+        if (begin == std::string::npos)
+        {
+            continue;
+        }
+        line = line.substr(begin, line.find_last_not_of(" \t\r") + 1 - begin);
+        if (line.find('=') == std::string::npos)
+        {
+            NS_FATAL_ERROR(path << ": option without a value: " << line);
+        }
+        args.push_back(line.rfind("--", 0) == 0 ? line : "--" + line);
+    }
+    return args;
+}
+
+/**
+ * Find the --Scenario argument before the command line is parsed.
+ */
+std::string
+FindScenarioArgument(int argc, char* argv[])
+{
+    const std::string prefix = "--Scenario=";
+    std::string path;
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        if (arg.rfind(prefix, 0) == 0)
+        {
+            path = arg.substr(prefix.size());
+        }
+    }
+    return path;
 }
 
 } // namespace
@@ -417,71 +1014,351 @@ main(int argc, char* argv[])
 
     CommandLine cmd;
     BindCommandLine(cmd, cfg);
+    const std::string scenarioFile = FindScenarioArgument(argc, argv);
+    if (!scenarioFile.empty())
+    {
+        cmd.Parse(ReadScenarioFile(scenarioFile, argv[0]));
+    }
     cmd.Parse(argc, argv);
 
     ResolveRouterNodeCount(cfg);
     RngSeedManager::SetSeed(cfg.randomSeed);
+    if (cfg.runNumber > 0)
+    {
+        RngSeedManager::SetRun(cfg.runNumber);
+    }
+
+    const std::string scenarioType =
+        MakeScenarioType(cfg.topology == "grid" ? cfg.nodePlacement : cfg.topology,
+                         cfg.nodeDensity,
+                         cfg.appType);
 
-    const std::string scenarioType = MakeScenarioType(cfg.nodePlacement, cfg.nodeDensity, cfg.appType);
+    // ----- Generated or imported layout (sets the node counts) -----
+    RitTopologyHelper topologyHelper;
+    RitTopology topology;
+    const bool gridTopology = cfg.topology == "grid";
+    if (!gridTopology)
+    {
+        topology = BuildTopology(cfg, topologyHelper);
+        cfg.routerNodeCount = static_cast<int32_t>(topology.routers.size());
+        cfg.sinkCount = static_cast<uint32_t>(topology.sinks.size());
+        if (topology.routers.empty())
+        {
+            NS_FATAL_ERROR("The " << cfg.topology << " layout has no router");
+        }
+    }
 
     // ----- Node creation -----
     NodeContainer parentNodes;
     NodeContainer routerNodes;
     NodeContainer allNodes;
-    parentNodes.Create(1);
+    if (cfg.sinkCount == 0)
+    {
+        NS_FATAL_ERROR("At least one sink is needed");
+    }
+    parentNodes.Create(cfg.sinkCount);
     routerNodes.Create(cfg.routerNodeCount);
     allNodes.Add(parentNodes);
     allNodes.Add(routerNodes);
 
+    // ----- NWK defaults (read when the devices create their routing layer) -----
+    Config::SetDefault("ns3::RitSimpleRouting::AggregationEnabled",
+                       BooleanValue(cfg.aggregationEnabled));
+    Config::SetDefault("ns3::RitSimpleRouting::AggregationMaxDelay",
+                       TimeValue(MilliSeconds(cfg.aggregationMaxDelayMs)));
+    Config::SetDefault("ns3::RitSimpleRouting::AnycastEnabled", BooleanValue(cfg.anycastEnabled));
+    Config::SetDefault("ns3::RitSimpleRouting::BackpressureEnabled",
+                       BooleanValue(cfg.backpressureEnabled));
+    Config::SetDefault("ns3::RitSimpleRouting::BackpressureMinHeadroom",
+                       UintegerValue(cfg.backpressureMinHeadroom));
+    Config::SetDefault("ns3::RitSimpleRouting::MaxRetries", UintegerValue(cfg.maxRetries));
+    Config::SetDefault("ns3::RitSimpleRouting::RetryPolicy", StringValue(cfg.retryPolicy));
+    Config::SetDefault("ns3::RitSimpleRouting::DuplicateDetection",
+                       BooleanValue(cfg.duplicateDetection));
+    Config::SetDefault("ns3::RitSimpleRouting::LocalRepair", BooleanValue(cfg.localRepairEnabled));
+    Config::SetDefault("ns3::RitSimpleRouting::DownlinkEnabled",
+                       BooleanValue(cfg.downlinkIntervalSec > 0.0));
+
     // ----- Device installation -----
     RitWpanNetHelper helper;
 
+    Ptr<LrWpanSpectrumChannel> channel;
+    if (cfg.regions > 1 && !cfg.rangeCulledChannel)
+    {
+        NS_FATAL_ERROR("Regions needs RangeCulledChannel");
+    }
+    if (cfg.rangeCulledChannel)
+    {
+        // Same propagation models as the default channel of RitWpanNetHelper
+        channel = CreateObject<LrWpanSpectrumChannel>();
+        channel->SetAttribute("PathLossCache", BooleanValue(cfg.pathLossCache));
+        channel->SetAttribute("WorkerThreads", UintegerValue(cfg.workerThreads));
+        channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+        channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+        helper.SetChannel(channel);
+    }
+
     helper.SetMacRitDataWaitDuration(MilliSeconds(cfg.dataWaitDurationMs));
     helper.SetMacRitTxWaitDuration(MilliSeconds(cfg.txWaitDurationMs));
     helper.SetRitMacDriftRatio(cfg.driftRatio);
     helper.SetRitMacModuleConfig(MakeModuleConfig(cfg));
+    if (cfg.periodPolicy == "aimd")
+    {
+        helper.SetRitPeriodPolicy("ns3::lrwpan::RitAimdPeriodPolicy");
+    }
+    else if (cfg.periodPolicy == "target")
+    {
+        helper.SetRitPeriodPolicy("ns3::lrwpan::RitTargetUtilizationPeriodPolicy");
+    }
+    else if (cfg.periodPolicy != "none")
+    {
+        NS_FATAL_ERROR("Unknown PeriodPolicy: " << cfg.periodPolicy);
+    }
 
     // Parent: RxAlwaysOn = true with an effective BI (preserve original behavior)
     helper.SetMacRitPeriod(EffectiveParentBeaconInterval(cfg));
     helper.SetRxAlwaysOn(true);
-    NetDeviceContainer parentDevices = helper.Install(parentNodes);
+    NetDeviceContainer parentDevices = helper.InstallSinks(parentNodes);
 
     // Routers: RxAlwaysOn = false with baseline BI (preserve original behavior)
     helper.SetMacRitPeriod(MilliSeconds(cfg.beaconIntervalMs));
     helper.SetRxAlwaysOn(false);
-    NetDeviceContainer routerDevices = helper.Install(routerNodes);
+    NetDeviceContainer routerDevices = helper.InstallBulk(routerNodes);
+    const RitInstallReport installReport = helper.GetInstallReport();
+    NS_LOG_UNCOND("Install: " << installReport.devices << " routers in "
+                              << installReport.wallSeconds << " s | "
+                              << installReport.bytesPerDevice << " bytes/device + "
+                              << installReport.sharedBytes << " shared");
 
     // ----- Mobility / ranks -----
-    if (cfg.nodePlacement == "edge")
+    const NodeContainer firstSink(parentNodes.Get(0));
+    if (!gridTopology)
     {
-        InstallTopologyEdge(cfg, routerNodes, parentNodes);
+        // Ranks by hop count over the link budget graph of the channel and PHY
+        topologyHelper.Install(topology, parentNodes, routerNodes);
+        double range = cfg.rankRangeM;
+        if (range <= 0.0)
+        {
+            auto routerDev = DynamicCast<RitWpanNetDevice>(routerDevices.Get(0));
+            range = RitTopologyHelper::GetLinkRange(
+                DynamicCast<SpectrumChannel>(routerDev->GetChannel()),
+                routerDev->GetPhy());
+        }
+        NS_LOG_UNCOND("Topology: " << cfg.topology << " | " << cfg.sinkCount << " sinks, "
+                                   << cfg.routerNodeCount << " routers | link range "
+                                   << range << " m");
+        RitWpanRankHelper rankHelper;
+        rankHelper.Install(routerNodes, parentNodes, range);
+    }
+    else if (cfg.nodePlacement == "edge")
+    {
+        InstallTopologyEdge(cfg, routerNodes, firstSink);
     }
     else if (cfg.nodePlacement == "center")
     {
-        InstallTopologyCenter(cfg, routerNodes, parentNodes);
+        InstallTopologyCenter(cfg, routerNodes, firstSink);
     }
     else
     {
         NS_FATAL_ERROR("Unsupported node placement: " << cfg.nodePlacement);
     }
+    if (gridTopology && cfg.sinkCount > 1)
+    {
+        InstallExtraSinks(cfg, routerNodes, parentNodes);
+    }
 
-    // ----- Parent device metadata -----
+    // ----- Spatial regions (same results, handovers counted for a distributed run) -----
+    RitPartitionHelper partitionHelper;
+    if (cfg.regions > 1)
+    {
+        partitionHelper.SetRegions(allNodes, partitionHelper.Partition(allNodes, cfg.regions));
+        partitionHelper.ConnectInProcess(channel);
+    }
+
+    // ----- Parent device metadata (rank 0, address 00:00 set by InstallSinks) -----
     auto parentDev = DynamicCast<RitWpanNetDevice>(parentDevices.Get(0));
-    parentDev->SetAddress(Mac16Address("00:00"));
-    parentDev->SetRitRank(0);
+    if (cfg.bootstrapEnabled && cfg.restoreFile.empty())
+    {
+        RitWpanRankHelper rankHelper;
+        rankHelper.Bootstrap(routerNodes, Seconds(0));
+    }
+
+    // ----- Receive channels (beacons heard on the own channel only during a bootstrap) -----
+    if (cfg.channels < 1 || cfg.channels > 16)
+    {
+        NS_FATAL_ERROR("Channels must be from 1 to 16: " << cfg.channels);
+    }
+    helper.AssignRxChannels(allNodes, 11, static_cast<uint8_t>(cfg.channels));
+
+    // ----- Random streams (keyed by short address, see RitWpanNetHelper::AssignStreams) -----
+    const int64_t appStream = helper.AssignStreams(allNodes, 0);
 
     // ----- Applications -----
-    InstallApplications(cfg, routerNodes, parentNodes);
+    const int64_t appSpan = InstallApplications(cfg, routerNodes, parentNodes, appStream);
+    if (cfg.floodAtSec > 0.0)
+    {
+        InstallEventFlood(cfg, routerNodes, appStream + appSpan);
+    }
+
+    // ----- Device classes (metrics broken down in class-summary.csv) -----
+    if (cfg.mainsRouterStride > 0)
+    {
+        RitDeviceProfile sink;
+        sink.name = "sink";
+        sink.macRitPeriod = EffectiveParentBeaconInterval(cfg);
+        sink.dataWaitDuration = MilliSeconds(cfg.dataWaitDurationMs);
+        sink.txWaitDuration = MilliSeconds(cfg.txWaitDurationMs);
+        sink.rxAlwaysOn = true;
+        sink.moduleConfig = MakeModuleConfig(cfg);
+        RitDeviceProfile mains = sink;
+        mains.name = "mains-router";
+        RitDeviceProfile leaf = sink;
+        leaf.name = "battery-leaf";
+        leaf.macRitPeriod = MilliSeconds(cfg.beaconIntervalMs);
+        leaf.rxAlwaysOn = false;
+        helper.AddDeviceProfile(sink);
+        helper.AddDeviceProfile(mains);
+        helper.AddDeviceProfile(leaf);
+
+        NodeContainer mainsNodes;
+        NodeContainer leafNodes;
+        for (uint32_t i = 0; i < routerNodes.GetN(); i++)
+        {
+            (i % cfg.mainsRouterStride == 0 ? mainsNodes : leafNodes).Add(routerNodes.Get(i));
+        }
+        helper.AssignDeviceProfile(parentNodes, sink.name);
+        helper.AssignDeviceProfile(mainsNodes, mains.name);
+        helper.AssignDeviceProfile(leafNodes, leaf.name);
+    }
+
+    // ----- Warm-up checkpoint -----
+    RitCheckpointHelper checkpointHelper;
+    if (!cfg.restoreFile.empty())
+    {
+        checkpointHelper.Restore(allNodes, cfg.restoreFile);
+    }
+    if (cfg.checkpointAtSec > 0.0)
+    {
+        checkpointHelper.ScheduleSave(allNodes, Seconds(cfg.checkpointAtSec), cfg.checkpointFile);
+    }
+    if (cfg.downlinkIntervalSec > 0.0 && routerNodes.GetN() > 0)
+    {
+        std::vector<Mac16Address> routers;
+        for (uint32_t i = 0; i < routerDevices.GetN(); i++)
+        {
+            routers.push_back(Mac16Address::ConvertFrom(routerDevices.Get(i)->GetAddress()));
+        }
+        const Time interval = Seconds(cfg.downlinkIntervalSec);
+        Simulator::ScheduleWithContext(parentNodes.Get(0)->GetId(),
+                                       interval,
+                                       &SendDownlink,
+                                       parentDev,
+                                       routers,
+                                       0,
+                                       interval,
+                                       cfg.appPacketSize);
+    }
+    if (cfg.broadcastIntervalSec > 0.0)
+    {
+        const Time interval = Seconds(cfg.broadcastIntervalSec);
+        Simulator::ScheduleWithContext(parentNodes.Get(0)->GetId(),
+                                       interval,
+                                       &SendBroadcast,
+                                       parentDev,
+                                       interval,
+                                       cfg.appPacketSize);
+    }
+
+    // ----- Analytical prediction -----
+    if (cfg.predict || cfg.predictOnly)
+    {
+        WritePrediction(cfg, allNodes, DynamicCast<RitWpanNetDevice>(routerDevices.Get(0)));
+    }
+    if (cfg.predictOnly)
+    {
+        Simulator::Destroy();
+        return 0;
+    }
 
     // ----- Traces -----
     helper.SetScenarioType(scenarioType);
-    helper.EnableAllTracesPerNode(allNodes, cfg.simulationDays, cfg.randomSeed);
+    Ptr<RitMetricsCollector> collector;
+    Ptr<RitSteadyStateController> controller;
+    if (cfg.outputDir.empty())
+    {
+        if (cfg.rawTraces)
+        {
+            helper.EnableAllTracesPerNode(allNodes, cfg.simulationDays, cfg.randomSeed);
+        }
+        if (cfg.metricsEnabled)
+        {
+            collector =
+                helper.EnableMetricsCollector(allNodes, cfg.simulationDays, cfg.randomSeed);
+        }
+    }
+    else
+    {
+        const std::string baseDir =
+            cfg.outputDir.back() == '/' ? cfg.outputDir : cfg.outputDir + "/";
+        if (cfg.rawTraces)
+        {
+            helper.EnableAllTracesPerNode(allNodes, baseDir, cfg.randomSeed);
+        }
+        if (cfg.metricsEnabled)
+        {
+            collector = helper.EnableMetricsCollector(allNodes, baseDir);
+        }
+    }
+    if (cfg.steadyStateStop)
+    {
+        if (!collector)
+        {
+            NS_FATAL_ERROR("SteadyStateStop needs Metrics=true");
+        }
+        controller = Create<RitSteadyStateController>(collector);
+        controller->SetObservationInterval(Seconds(cfg.steadyStateIntervalSec));
+        controller->SetTarget(cfg.steadyStateTarget);
+        controller->Start();
+    }
+    if (cfg.progressIntervalSec > 0.0)
+    {
+        helper.EnableProgressReporter(allNodes,
+                                      Seconds(cfg.progressIntervalSec),
+                                      cfg.progressFile,
+                                      collector);
+    }
 
     // ----- Run -----
     PrintRunSummary(cfg, scenarioType);
     NS_LOG_UNCOND("Simulation starts.");
     Simulator::Stop(Days(cfg.simulationDays));
+    if (!cfg.profilePrefix.empty())
+    {
+        LrWpanEventProfiler::Enable();
+    }
     Simulator::Run();
+    if (controller)
+    {
+        NS_LOG_UNCOND("Steady state: " << (controller->IsConverged() ? "reached" : "not reached")
+                                       << " at " << Simulator::Now().As(Time::S));
+    }
+    if (!cfg.profilePrefix.empty())
+    {
+        LrWpanEventProfiler::Disable();
+        std::ofstream table(cfg.profilePrefix + "-events.csv");
+        LrWpanEventProfiler::WriteTable(table);
+        std::ofstream folded(cfg.profilePrefix + ".folded");
+        LrWpanEventProfiler::WriteFolded(folded);
+        NS_LOG_UNCOND("Event profile written to " << cfg.profilePrefix << "-events.csv and "
+                                                  << cfg.profilePrefix << ".folded");
+    }
+    if (cfg.regions > 1)
+    {
+        NS_LOG_UNCOND("Regions: " << cfg.regions << " | Border nodes: "
+                                  << partitionHelper.GetNBorderNodes() << " of "
+                                  << allNodes.GetN()
+                                  << " | Handovers: " << partitionHelper.GetNHandovers());
+    }
     Simulator::Destroy();
 
     return 0;
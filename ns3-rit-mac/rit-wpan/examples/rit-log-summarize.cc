@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+/*
+ * Summaries of existing trace trees with RitLogSummarizer.
+ *
+ * Every run below Logs (a directory with node-N directories, such as
+ * logs/<scenario>/<module>/BI.._TWD.._DWD.._Days../SEEDxx) gets the
+ * summary/{app,mac,phy,scenario}_summary.csv files of analysis/multi_run_analysis.ipynb,
+ * the per-node CSV logs parsed on Threads threads across the nodes and seeds. The runs
+ * whose four summaries exist are skipped unless Overwrite is set, as the notebook does
+ * without force_rerun, so the notebook then only loads the summaries.
+ *
+ *   ./ns3 run "rit-log-summarize --Logs=logs/default --Threads=16"
+ *
+ * Binary or consolidated traces are decoded first with analysis/common/trace_decoder.py.
+ */
+
+#include "ns3/core-module.h"
+
+#include "ns3/rit-log-summarizer.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+using namespace ns3;
+using namespace lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("RitLogSummarize");
+
+namespace
+{
+
+struct SummarizeConfig
+{
+    std::string logs = "logs"; // tree of runs, or a run
+    uint32_t threads = 0;      // 0 = one per hardware thread
+    uint32_t receiverNode = 0; // APP_RECV_NODE of the notebook
+    bool overwrite = false;    // rewrite the existing summaries
+};
+
+void
+BindCommandLine(CommandLine& cmd, SummarizeConfig& cfg)
+{
+    cmd.AddValue("Logs", "Tree of runs to summarize, or a run", cfg.logs);
+    cmd.AddValue("Threads", "Parsing threads (0 = one per hardware thread)", cfg.threads);
+    cmd.AddValue("Receiver", "Node whose app-rxlog.csv holds the receptions", cfg.receiverNode);
+    cmd.AddValue("Overwrite", "Summarize the runs whose summaries exist", cfg.overwrite);
+}
+
+double
+ElapsedSeconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    SummarizeConfig cfg;
+    CommandLine cmd;
+    BindCommandLine(cmd, cfg);
+    cmd.Parse(argc, argv);
+
+    RitLogSummarizer summarizer;
+    summarizer.SetNThreads(cfg.threads);
+    summarizer.SetReceiverNode(cfg.receiverNode);
+    summarizer.SetOverwrite(cfg.overwrite);
+
+    const auto start = std::chrono::steady_clock::now();
+    const uint32_t nRuns = summarizer.SummarizeTree(cfg.logs);
+    const double seconds = ElapsedSeconds(start);
+    const double megabytes = summarizer.GetNBytes() / 1e6;
+    NS_LOG_UNCOND("[SUMMARY] " << nRuns << " runs summarized, " << summarizer.GetNRunsSkipped()
+                               << " skipped | " << summarizer.GetNNodes() << " nodes | "
+                               << megabytes << " MB in " << seconds << " s ("
+                               << (seconds > 0 ? megabytes / seconds : 0.0) << " MB/s, "
+                               << summarizer.GetNThreads() << " threads)");
+    return 0;
+}
@@ -0,0 +1,378 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+/*
+ * Head-to-head comparison of the RIT MAC with the modes of the stock LrWpanMac.
+ *
+ * The same fixed-seed star (one sink at the centre of a Poisson disc layout of routers,
+ * all of them within link range of the sink, sending periodically to it) is run once
+ * per MAC variant for a fixed simulated duration:
+ *  - rit:    RitWpanMac, routers duty-cycled with the BI, the sink always on with SinkBI;
+ *  - csma:   RIT period 0 (plain LrWpanMac), non-beacon unslotted CSMA/CA, every
+ *            receiver always on;
+ *  - beacon: RIT period 0, the sink is the PAN coordinator of a beacon-enabled PAN
+ *            (BO, SO), the routers track its beacons with slotted CSMA/CA and sleep
+ *            through the inactive portion of the superframe.
+ * Only the MAC changes: the devices, the NWK, the layout, the applications and the
+ * random streams are the same in every run. The stock modes deliver one hop only
+ * (the stock MAC sends to the NWK destination and ns-3 has no beacon-enabled
+ * multi-hop), hence the star; the run stops if a router is out of range of the sink.
+ *
+ * For each variant a CSV row reports the PDR, the mean and percentile end-to-end
+ * delays (RitLatencySketch of the sink), the mean and largest wake ratio of the
+ * routers (PHY time not in TRX_OFF), the wall time, the simulator events executed,
+ * the events per wall-clock second and the peak RSS of the process.
+ *
+ *   ./ns3 run "rit-mac-compare --Mac=all --Routers=20 --SimTime=3600 --BI=1000 --BO=6 --SO=2"
+ *
+ * The peak RSS is the high water mark of the process: run one variant per process
+ * (--Mac=csma) for exact figures.
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/propagation-module.h"
+
+#include "ns3/lr-wpan-spectrum-channel.h"
+#include "ns3/periodic-sender-helper.h"
+#include "ns3/periodic-sender.h"
+#include "ns3/rit-metrics-collector.h"
+#include "ns3/rit-rank-helper.h"
+#include "ns3/rit-topology-helper.h"
+#include "ns3/rit-wpan-helper.h"
+#include "ns3/rit-wpan-net-device.h"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+using namespace lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("RitMacCompare");
+
+namespace
+{
+
+struct CompareConfig
+{
+    std::string macs = "all"; // "rit", "csma", "beacon", a comma list or "all"
+    uint32_t nRouters = 20;
+    double sideM = 60.0;       // side of the square layout, the sink at its centre
+    double minDistanceM = 4.0; // smallest distance between two nodes
+    double simTimeSec = 3600.0;
+    uint32_t randomSeed = 1;
+    double beaconIntervalMs = 1000.0;    // rit: BI of the routers
+    double sinkBeaconIntervalMs = 500.0; // rit: BI of the sink
+    double dataWaitDurationMs = 10.0;
+    double txWaitDurationMs = 5000.0;
+    uint32_t beaconOrder = 6;     // beacon: BO (BI = 15.36 ms * 2^BO)
+    uint32_t superframeOrder = 2; // beacon: SO (active portion = 15.36 ms * 2^SO)
+    uint32_t appIntervalSec = 60;
+    uint32_t appPacketSize = 8;
+    std::string output = "rit-mac-compare.csv";
+    std::string label = "default"; // build under test, e.g. a commit id
+};
+
+struct CompareResult
+{
+    uint32_t nodes = 0;         // routers and the sink
+    uint64_t sent = 0;          // distinct application packets sent
+    uint64_t delivered = 0;     // those delivered to the sink
+    Time delayMean;             // end-to-end delays of the delivered packets
+    Time delayP50;              // median
+    Time delayP95;              // 95th percentile
+    Time delayP99;              // 99th percentile
+    Time delayMax;              // largest
+    double wakeRatioMean = 0.0; // mean of the routers
+    double wakeRatioMax = 0.0;  // largest of the routers
+    double sinkWakeRatio = 0.0; // the sink
+    double runSeconds = 0.0;    // Simulator::Run()
+    uint64_t events = 0;        // events executed by the run
+    uint64_t peakRssKb = 0;     // high water mark of the process
+};
+
+void
+BindCommandLine(CommandLine& cmd, CompareConfig& cfg)
+{
+    cmd.AddValue("Mac", "MAC variants: rit, csma, beacon, a comma list or all", cfg.macs);
+    cmd.AddValue("Routers", "Number of routers", cfg.nRouters);
+    cmd.AddValue("Side", "Side of the square layout, the sink at its centre [m]", cfg.sideM);
+    cmd.AddValue("MinDistance", "Smallest distance between two nodes [m]", cfg.minDistanceM);
+    cmd.AddValue("SimTime", "Simulated duration of each run (seconds)", cfg.simTimeSec);
+    cmd.AddValue("Seed", "Random seed", cfg.randomSeed);
+    cmd.AddValue("BI", "rit: beacon interval of the routers (milliseconds)", cfg.beaconIntervalMs);
+    cmd.AddValue("SinkBI",
+                 "rit: beacon interval of the sink (milliseconds)",
+                 cfg.sinkBeaconIntervalMs);
+    cmd.AddValue("DWD", "rit: receiver data wait duration (milliseconds)", cfg.dataWaitDurationMs);
+    cmd.AddValue("TWD", "rit: sender wait duration (milliseconds)", cfg.txWaitDurationMs);
+    cmd.AddValue("BO", "beacon: beacon order of the coordinator (0-14)", cfg.beaconOrder);
+    cmd.AddValue("SO", "beacon: superframe order of the coordinator (0-BO)", cfg.superframeOrder);
+    cmd.AddValue("AppInterval", "Interval of the periodic senders (seconds)", cfg.appIntervalSec);
+    cmd.AddValue("AppPacketSize", "Packet size of the senders (bytes)", cfg.appPacketSize);
+    cmd.AddValue("Output", "CSV file of the results (overwritten)", cfg.output);
+    cmd.AddValue("Label", "Build label written in each row", cfg.label);
+}
+
+std::vector<std::string>
+ParseMacs(const std::string& macs)
+{
+    if (macs == "all")
+    {
+        return {"rit", "csma", "beacon"};
+    }
+    std::vector<std::string> result;
+    std::stringstream ss(macs);
+    std::string field;
+    while (std::getline(ss, field, ','))
+    {
+        if (field != "rit" && field != "csma" && field != "beacon")
+        {
+            NS_FATAL_ERROR("Unknown Mac variant: " << field);
+        }
+        result.push_back(field);
+    }
+    return result;
+}
+
+/**
+ * Peak resident set size of the process so far.
+ */
+uint64_t
+PeakRssKb()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<uint64_t>(usage.ru_maxrss); // kilobytes on Linux
+}
+
+double
+ElapsedSeconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * Turn the installed devices into a star of the stock LrWpanMac: PAN 0 on every MAC
+ * (the NWK sends with destination PAN 0), and for the beacon variant the sink as the
+ * PAN coordinator and the routers tracking its beacons, receivers off when idle.
+ */
+void
+ConfigureStockMac(const CompareConfig& cfg,
+                  const std::string& mac,
+                  Ptr<RitWpanNetDevice> sinkDev,
+                  NetDeviceContainer routerDevices)
+{
+    const bool beacon = mac == "beacon";
+    sinkDev->GetMac()->SetPanId(0);
+    sinkDev->GetMac()->SetRxOnWhenIdle(true);
+    for (uint32_t i = 0; i < routerDevices.GetN(); i++)
+    {
+        Ptr<RitWpanMac> routerMac = DynamicCast<RitWpanNetDevice>(routerDevices.Get(i))->GetMac();
+        routerMac->SetPanId(0);
+        routerMac->SetRxOnWhenIdle(!beacon);
+        if (beacon)
+        {
+            routerMac->SetAssociatedCoor(Mac16Address("00:00"));
+            MlmeSyncRequestParams syncParams;
+            syncParams.m_logCh = sinkDev->GetPhy()->GetCurrentChannelNum();
+            syncParams.m_trackBcn = true;
+            Simulator::ScheduleWithContext(routerDevices.Get(i)->GetNode()->GetId(),
+                                           MilliSeconds(1),
+                                           &LrWpanMac::MlmeSyncRequest,
+                                           routerMac,
+                                           syncParams);
+        }
+    }
+    if (beacon)
+    {
+        if (cfg.beaconOrder > 14 || cfg.superframeOrder > cfg.beaconOrder)
+        {
+            NS_FATAL_ERROR("BO must be at most 14 and SO at most BO");
+        }
+        MlmeStartRequestParams params;
+        params.m_panCoor = true;
+        params.m_PanId = 0;
+        params.m_logCh = sinkDev->GetPhy()->GetCurrentChannelNum();
+        params.m_bcnOrd = static_cast<uint8_t>(cfg.beaconOrder);
+        params.m_sfrmOrd = static_cast<uint8_t>(cfg.superframeOrder);
+        Simulator::ScheduleWithContext(sinkDev->GetNode()->GetId(),
+                                       MilliSeconds(2),
+                                       &LrWpanMac::MlmeStartRequest,
+                                       sinkDev->GetMac(),
+                                       params);
+    }
+}
+
+CompareResult
+RunVariant(const CompareConfig& cfg, const std::string& mac)
+{
+    CompareResult result;
+    const bool rit = mac == "rit";
+
+    // Layout: the same draw for every variant
+    RitTopologyHelper topologyHelper;
+    topologyHelper.AssignStreams(0);
+    const RitTopology topology =
+        topologyHelper.PoissonDisc(cfg.nRouters, cfg.sideM, cfg.sideM, cfg.minDistanceM);
+
+    NodeContainer sinks;
+    NodeContainer routers;
+    sinks.Create(1);
+    routers.Create(topology.routers.size());
+    result.nodes = 1 + routers.GetN();
+    NodeContainer allNodes(sinks, routers);
+
+    Ptr<LrWpanSpectrumChannel> channel = CreateObject<LrWpanSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    // A zero RIT period leaves RitWpanMac to the plain LrWpanMac
+    RitWpanNetHelper helper;
+    helper.SetChannel(channel);
+    helper.SetMacRitDataWaitDuration(MilliSeconds(cfg.dataWaitDurationMs));
+    helper.SetMacRitTxWaitDuration(MilliSeconds(cfg.txWaitDurationMs));
+    helper.SetMacRitPeriod(rit ? MilliSeconds(cfg.sinkBeaconIntervalMs) : Seconds(0));
+    helper.SetRxAlwaysOn(true);
+    NetDeviceContainer sinkDevices = helper.InstallSinks(sinks);
+    helper.SetMacRitPeriod(rit ? MilliSeconds(cfg.beaconIntervalMs) : Seconds(0));
+    helper.SetRxAlwaysOn(false);
+    NetDeviceContainer routerDevices = helper.Install(routers);
+
+    topologyHelper.Install(topology, sinks, routers);
+    auto sinkDev = DynamicCast<RitWpanNetDevice>(sinkDevices.Get(0));
+    const double range = RitTopologyHelper::GetLinkRange(channel, sinkDev->GetPhy());
+    const Vector sinkPos = sinks.Get(0)->GetObject<MobilityModel>()->GetPosition();
+    for (uint32_t i = 0; i < routers.GetN(); i++)
+    {
+        const Vector pos = routers.Get(i)->GetObject<MobilityModel>()->GetPosition();
+        if (CalculateDistance(pos, sinkPos) > range)
+        {
+            NS_FATAL_ERROR("Router " << i << " out of range of the sink (" << range
+                                     << " m): lower Side");
+        }
+    }
+    RitWpanRankHelper rankHelper;
+    rankHelper.Install(routers, sinks, range);
+    if (!rit)
+    {
+        ConfigureStockMac(cfg, mac, sinkDev, routerDevices);
+    }
+
+    PeriodicSenderHelper app;
+    app.SetPeriod(Seconds(cfg.appIntervalSec));
+    app.SetPacketSize(cfg.appPacketSize);
+    app.SetDstAddr(Mac16Address("00:00"));
+    app.Install(routers);
+    PeriodicSenderHelper sinkApp;
+    sinkApp.SetReceiveOnly(true);
+    sinkApp.Install(sinks);
+    const int64_t appStream = helper.AssignStreams(allNodes, 1);
+    app.AssignStreams(routers, 1 + appStream);
+    sinkApp.AssignStreams(sinks, 1 + appStream);
+
+    Ptr<RitMetricsCollector> collector = Create<RitMetricsCollector>();
+    for (uint32_t i = 0; i < allNodes.GetN(); i++)
+    {
+        collector->Install(allNodes.Get(i));
+    }
+
+    const auto runStart = std::chrono::steady_clock::now();
+    Simulator::Stop(Seconds(cfg.simTimeSec));
+    Simulator::Run();
+    result.runSeconds = ElapsedSeconds(runStart);
+    result.events = Simulator::GetEventCount();
+    result.peakRssKb = PeakRssKb();
+
+    const RitMetricsCollector::Totals totals = collector->GetTotals();
+    result.sent = totals.txUnique;
+    result.delivered = totals.delivered;
+    const RitLatencySketch& delays =
+        DynamicCast<PeriodicSender>(sinks.Get(0)->GetApplication(0))->GetDelaySketch();
+    result.delayMean = delays.GetMean();
+    result.delayP50 = delays.GetQuantile(0.5);
+    result.delayP95 = delays.GetQuantile(0.95);
+    result.delayP99 = delays.GetQuantile(0.99);
+    result.delayMax = delays.GetMax();
+    double wakeSum = 0.0;
+    uint32_t nWake = 0;
+    for (uint32_t i = 0; i < routers.GetN(); i++)
+    {
+        const double wake = collector->GetWakeRatio(routers.Get(i)->GetId());
+        if (wake >= 0.0)
+        {
+            wakeSum += wake;
+            result.wakeRatioMax = std::max(result.wakeRatioMax, wake);
+            nWake++;
+        }
+    }
+    result.wakeRatioMean = nWake > 0 ? wakeSum / nWake : 0.0;
+    result.sinkWakeRatio = collector->GetWakeRatio(sinks.Get(0)->GetId());
+
+    Simulator::Destroy();
+    return result;
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    CompareConfig cfg;
+    CommandLine cmd;
+    BindCommandLine(cmd, cfg);
+    cmd.Parse(argc, argv);
+
+    RngSeedManager::SetSeed(cfg.randomSeed);
+    const std::vector<std::string> macs = ParseMacs(cfg.macs);
+    if (macs.empty() || cfg.nRouters == 0)
+    {
+        NS_FATAL_ERROR("Mac needs a variant and Routers a positive count");
+    }
+
+    std::ofstream out(cfg.output, std::ios::trunc);
+    if (!out)
+    {
+        NS_FATAL_ERROR("Cannot write " << cfg.output);
+    }
+    out << "label,mac,nodes,sim_seconds,sent,delivered,pdr,delay_mean_s,delay_p50_s,"
+           "delay_p95_s,delay_p99_s,delay_max_s,wake_ratio_mean,wake_ratio_max,"
+           "sink_wake_ratio,run_seconds,events,events_per_wall_second,peak_rss_kb\n";
+
+    for (const std::string& mac : macs)
+    {
+        // The fixed streams give every variant the same layout and send times
+        const CompareResult r = RunVariant(cfg, mac);
+        const double pdr = r.sent > 0 ? static_cast<double>(r.delivered) / r.sent : 0.0;
+        const double perWall = r.runSeconds > 0 ? r.events / r.runSeconds : 0.0;
+        out << cfg.label << "," << mac << "," << r.nodes << "," << cfg.simTimeSec << ","
+            << r.sent << "," << r.delivered << "," << pdr << "," << r.delayMean.GetSeconds()
+            << "," << r.delayP50.GetSeconds() << "," << r.delayP95.GetSeconds() << ","
+            << r.delayP99.GetSeconds() << "," << r.delayMax.GetSeconds() << ","
+            << r.wakeRatioMean << "," << r.wakeRatioMax << "," << r.sinkWakeRatio << ","
+            << r.runSeconds << "," << r.events << "," << perWall << "," << r.peakRssKb
+            << "\n";
+        out.flush();
+        NS_LOG_UNCOND("[COMPARE] " << mac << " | PDR " << pdr << " (" << r.delivered << "/"
+                                   << r.sent << ") | delay p50 " << r.delayP50.As(Time::MS)
+                                   << " p99 " << r.delayP99.As(Time::MS) << " | wake "
+                                   << r.wakeRatioMean << " (max " << r.wakeRatioMax
+                                   << ") | run " << r.runSeconds << " s | " << r.events
+                                   << " events (" << perWall << "/s) | peak " << r.peakRssKb
+                                   << " kB");
+    }
+    NS_LOG_UNCOND("[COMPARE] results written to " << cfg.output);
+    return 0;
+}
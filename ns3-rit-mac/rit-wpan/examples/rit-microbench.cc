@@ -0,0 +1,389 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+/*
+ * Microbenchmarks of the lr-wpan and rit-wpan functions that dominate the profiles
+ * of large RIT simulations:
+ *  - LrWpanErrorModel::GetChunkSuccessRate (exact formula and lookup table)
+ *  - LrWpanSpectrumValueHelper::TotalAvgPower
+ *  - LrWpanInterferenceHelper AddSignal/RemoveSignal and GetSignalPsd
+ *  - LrWpanMacHeader, CommandPayloadHeader and RitNwkHeader Serialize/Deserialize
+ *  - Packet::PeekHeader against the fixed layouts of RitFrameCodec on a data frame
+ *  - RitWpanMac::PdDataIndication on a synthetic RIT beacon (RIT Data Request)
+ *
+ * Every benchmark runs on fixed inputs and reports, per call, the wall time, the TSC
+ * cycles (x86 only, 0 elsewhere) and the heap allocations, counted by the replacement
+ * operator new of this program. Run it from scratch/ with an optimized build:
+ *
+ *   ./ns3 run "rit-microbench --Iterations=1000000 --Filter=header --Output=micro.csv"
+ *
+ * The numbers are a baseline for optimization work on these paths, not absolute
+ * figures: compare runs of the same machine only.
+ */
+
+#include "ns3/lr-wpan-error-model.h"
+#include "ns3/lr-wpan-interference-helper.h"
+#include "ns3/lr-wpan-mac-header.h"
+#include "ns3/lr-wpan-mac-pl-headers.h"
+#include "ns3/lr-wpan-mac-trailer.h"
+#include "ns3/lr-wpan-spectrum-value-helper.h"
+#include "ns3/rit-frame-codec.h"
+#include "ns3/rit-wpan-helper.h"
+#include "ns3/rit-wpan-mac.h"
+#include "ns3/rit-wpan-net-device.h"
+#include "ns3/rit-wpan-nwk-header.h"
+
+#include <ns3/core-module.h>
+#include <ns3/network-module.h>
+#include <ns3/single-model-spectrum-channel.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("RitMicrobench");
+
+// Heap allocations of the process, counted by the replacement allocation functions
+// below (the simulation is single-threaded).
+static uint64_t g_allocations = 0;
+
+void*
+operator new(std::size_t size)
+{
+    g_allocations++;
+    if (void* p = std::malloc(size ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void*
+operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace
+{
+
+/**
+ * Read the time stamp counter (0 where there is none).
+ */
+inline uint64_t
+ReadCycles()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/**
+ * Results of the benchmarked calls, so that the compiler keeps them.
+ */
+volatile double g_sink = 0;
+
+struct BenchResult
+{
+    std::string name;
+    uint64_t iterations = 0;
+    double nsPerOp = 0;
+    double cyclesPerOp = 0;
+    double allocsPerOp = 0;
+};
+
+/**
+ * Run op iterations times after a warm-up of iterations / 10 calls.
+ *
+ * @param name Benchmark name
+ * @param iterations Number of measured calls
+ * @param op The benchmarked call
+ * @return the per-call figures
+ */
+BenchResult
+Measure(const std::string& name, uint64_t iterations, const std::function<void(uint64_t)>& op)
+{
+    for (uint64_t i = 0; i < iterations / 10; i++)
+    {
+        op(i);
+    }
+
+    BenchResult result;
+    result.name = name;
+    result.iterations = iterations;
+    const uint64_t allocsBefore = g_allocations;
+    const auto start = std::chrono::steady_clock::now();
+    const uint64_t cyclesBefore = ReadCycles();
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        op(i);
+    }
+    const uint64_t cycles = ReadCycles() - cyclesBefore;
+    const double ns =
+        std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    result.nsPerOp = ns / iterations;
+    result.cyclesPerOp = static_cast<double>(cycles) / iterations;
+    result.allocsPerOp = static_cast<double>(g_allocations - allocsBefore) / iterations;
+    return result;
+}
+
+/**
+ * A data frame header as sent by a RIT router: short addresses, PAN ID compression,
+ * acknowledgment requested.
+ */
+LrWpanMacHeader
+MakeDataHeader()
+{
+    LrWpanMacHeader hdr(LrWpanMacHeader::LRWPAN_MAC_DATA, 42);
+    hdr.SetFrameVer(1);
+    hdr.SetSrcAddrMode(SHORT_ADDR);
+    hdr.SetSrcAddrFields(0x1234, Mac16Address("00:17"));
+    hdr.SetDstAddrMode(SHORT_ADDR);
+    hdr.SetDstAddrFields(0x1234, Mac16Address("00:05"));
+    hdr.SetPanIdComp();
+    hdr.SetSecDisable();
+    hdr.SetAckReq();
+    return hdr;
+}
+
+/**
+ * Benchmark the serialization of a header into a preallocated buffer and its
+ * deserialization back.
+ *
+ * @param results Results to append to
+ * @param name Benchmark name prefix
+ * @param iterations Number of measured calls
+ * @param hdr The header
+ */
+template <typename THeader>
+void
+MeasureHeader(std::vector<BenchResult>& results,
+              const std::string& name,
+              uint64_t iterations,
+              const THeader& hdr)
+{
+    Buffer buffer;
+    buffer.AddAtStart(hdr.GetSerializedSize());
+    results.push_back(Measure(name + "/serialize", iterations, [&](uint64_t) {
+        hdr.Serialize(buffer.Begin());
+    }));
+    THeader decoded;
+    results.push_back(Measure(name + "/deserialize", iterations, [&](uint64_t) {
+        g_sink = decoded.Deserialize(buffer.Begin());
+    }));
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    uint64_t iterations = 1000000;
+    std::string filter;
+    std::string output;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("Iterations", "Measured calls of each benchmark", iterations);
+    cmd.AddValue("Filter", "Only run the benchmarks whose name contains this text", filter);
+    cmd.AddValue("Output", "CSV file of the results (none if empty)", output);
+    cmd.Parse(argc, argv);
+
+    std::vector<BenchResult> results;
+    auto enabled = [&](const std::string& name) {
+        return filter.empty() || name.find(filter) != std::string::npos;
+    };
+
+    // Error model: a 20-byte frame over a sweep of SNRs around the waterfall
+    const std::vector<double> snrs{0.5, 0.8, 1.0, 1.2, 1.5, 2.0, 3.0, 5.0};
+    for (bool lookup : {false, true})
+    {
+        const std::string name =
+            std::string("error-model/chunk-success-rate") + (lookup ? "-lut" : "-exact");
+        if (!enabled(name))
+        {
+            continue;
+        }
+        Ptr<LrWpanErrorModel> errorModel = CreateObject<LrWpanErrorModel>();
+        errorModel->SetAttribute("UseLookupTable", BooleanValue(lookup));
+        results.push_back(Measure(name, iterations, [&](uint64_t i) {
+            g_sink = errorModel->GetChunkSuccessRate(snrs[i % snrs.size()], 160);
+        }));
+    }
+
+    // Spectrum: the TX PSD of channel 11 and four interferers on the channel
+    LrWpanSpectrumValueHelper psdHelper;
+    Ptr<SpectrumValue> txPsd = psdHelper.CreateTxPowerSpectralDensity(0, 11);
+    if (enabled("spectrum/total-avg-power"))
+    {
+        results.push_back(Measure("spectrum/total-avg-power", iterations, [&](uint64_t) {
+            g_sink = LrWpanSpectrumValueHelper::TotalAvgPower(txPsd, 11);
+        }));
+    }
+
+    LrWpanInterferenceHelper interference(txPsd->GetSpectrumModel());
+    interference.SetChannel(11);
+    std::vector<Ptr<SpectrumValue>> background;
+    for (uint32_t k = 0; k < 4; k++)
+    {
+        background.push_back(psdHelper.CreateTxPowerSpectralDensity(-10.0 - k, 11));
+        interference.AddSignal(background.back());
+    }
+    const double txPower = LrWpanSpectrumValueHelper::TotalAvgPower(txPsd, 11);
+    if (enabled("interference/add-remove-signal"))
+    {
+        results.push_back(Measure("interference/add-remove-signal", iterations, [&](uint64_t) {
+            interference.AddSignal(&txPsd, txPsd, txPower);
+            interference.RemoveSignal(&txPsd);
+        }));
+    }
+    if (enabled("interference/get-signal-psd"))
+    {
+        results.push_back(Measure("interference/get-signal-psd", iterations, [&](uint64_t) {
+            g_sink = (*interference.GetSignalPsd())[0];
+        }));
+    }
+
+    // Headers
+    if (enabled("mac-header"))
+    {
+        MeasureHeader(results, "mac-header", iterations, MakeDataHeader());
+
+        // What the MAC and every trace sink do with a received frame
+        Ptr<Packet> frame = Create<Packet>(40);
+        frame->AddHeader(MakeDataHeader());
+        LrWpanMacHeader peeked;
+        results.push_back(Measure("mac-header/peek", iterations, [&](uint64_t) {
+            g_sink = frame->PeekHeader(peeked);
+        }));
+        results.push_back(Measure("mac-header/peek-codec", iterations, [&](uint64_t) {
+            g_sink = RitFrameCodec::PeekMacHeader(frame, peeked);
+        }));
+    }
+    if (enabled("command-payload"))
+    {
+        MeasureHeader(results,
+                      "command-payload",
+                      iterations,
+                      CommandPayloadHeader(CommandPayloadHeader::RIT_DATA_REQ));
+    }
+    if (enabled("nwk-header"))
+    {
+        RitNwkHeader nwkHdr;
+        nwkHdr.SetRank(3);
+        nwkHdr.SetPriority(1);
+        nwkHdr.SetSrcAddr(Mac16Address("00:17"));
+        nwkHdr.SetDstAddr(Mac16Address("00:00"));
+        MeasureHeader(results, "nwk-header", iterations, nwkHdr);
+    }
+
+    // RIT MAC: a receiver-mode router hears the beacon of a neighbour. The frame is
+    // the standard RIT Data Request (broadcast destination) with its FCS.
+    if (enabled("rit-mac/pd-data-indication-beacon"))
+    {
+        NodeContainer nodes;
+        nodes.Create(2);
+        RitWpanNetHelper helper;
+        helper.SetChannel(CreateObject<SingleModelSpectrumChannel>());
+        NetDeviceContainer devices = helper.Install(nodes);
+        Ptr<RitWpanMac> rxMac = DynamicCast<RitWpanNetDevice>(devices.Get(0))->GetMac();
+        Ptr<RitWpanMac> txMac = DynamicCast<RitWpanNetDevice>(devices.Get(1))->GetMac();
+
+        Ptr<Packet> beacon = Create<Packet>();
+        beacon->AddHeader(CommandPayloadHeader(CommandPayloadHeader::RIT_DATA_REQ));
+        LrWpanMacHeader beaconHdr(LrWpanMacHeader::LRWPAN_MAC_COMMAND, 7);
+        beaconHdr.SetFrameVer(1);
+        beaconHdr.SetSrcAddrMode(SHORT_ADDR);
+        beaconHdr.SetSrcAddrFields(txMac->GetPanId(), txMac->GetShortAddress());
+        beaconHdr.SetDstAddrMode(SHORT_ADDR);
+        beaconHdr.SetDstAddrFields(txMac->GetPanId(), Mac16Address("FF:FF"));
+        beaconHdr.SetNoPanIdComp();
+        beaconHdr.SetSecDisable();
+        beaconHdr.SetNoAckReq();
+        beacon->AddHeader(beaconHdr);
+        LrWpanMacTrailer trailer;
+        if (Node::ChecksumEnabled())
+        {
+            trailer.EnableFcs(true);
+            trailer.SetFcs(beacon);
+        }
+        beacon->AddTrailer(trailer);
+
+        results.push_back(
+            Measure("rit-mac/pd-data-indication-beacon", iterations, [&](uint64_t) {
+                rxMac->PdDataIndication(beacon->GetSize(), beacon, 255);
+            }));
+        Simulator::Destroy();
+    }
+
+    std::cout << std::left << std::setw(40) << "benchmark" << std::right << std::setw(12)
+              << "ns/op" << std::setw(12) << "cycles/op" << std::setw(12) << "allocs/op"
+              << std::endl;
+    for (const auto& r : results)
+    {
+        std::cout << std::left << std::setw(40) << r.name << std::right << std::fixed
+                  << std::setprecision(1) << std::setw(12) << r.nsPerOp << std::setw(12)
+                  << r.cyclesPerOp << std::setprecision(2) << std::setw(12) << r.allocsPerOp
+                  << std::endl;
+    }
+
+    if (!output.empty())
+    {
+        std::ofstream out(output, std::ios::trunc);
+        if (!out)
+        {
+            NS_FATAL_ERROR("Cannot write " << output);
+        }
+        out << "benchmark,iterations,ns_per_op,cycles_per_op,allocs_per_op\n";
+        for (const auto& r : results)
+        {
+            out << r.name << "," << r.iterations << "," << r.nsPerOp << "," << r.cyclesPerOp
+                << "," << r.allocsPerOp << "\n";
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+/*
+ * Distributed run of the rit-scale-bench scenario on MPI ranks.
+ *
+ * Every rank builds the same Poisson disc layout of routers around one sink;
+ * RitMpiPartitionHelper gives each rank one spatial region and exchanges the
+ * transmissions crossing the cuts between the ranks, on DistributedSimulatorImpl with
+ * the RIT lookahead (RX-to-TX turnaround plus the propagation delay over MinDistance).
+ * The periodic senders of each rank run on its own routers. Rank 0 writes one CSV row
+ * with the slowest run wall time of the ranks, the events of all ranks, the
+ * transmissions handed over between them and the packets sent and received at the
+ * sink. Needs ns-3 configured with --enable-mpi:
+ *
+ *   ./ns3 run "rit-mpi-bench --Routers=50000 --SimTime=3600" \
+ *       --command-template="mpiexec -np 16 %s"
+ *
+ * The frames crossing the cuts reach the other region one lookahead late (see
+ * RitMpiPartitionHelper): compare the handovers and the sink figures with a single rank
+ * run before trusting a partition. On one rank the nodes are not partitioned, which gives
+ * the unsplit reference of the same scenario:
+ *
+ *   ./ns3 run "rit-mpi-bench --Routers=5000 --Output=single.csv" \
+ *       --command-template="mpiexec -np 1 %s"
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/propagation-module.h"
+
+#include "ns3/lr-wpan-spectrum-channel.h"
+#include "ns3/periodic-sender-helper.h"
+#include "ns3/rit-rank-helper.h"
+#include "ns3/rit-topology-helper.h"
+#include "ns3/rit-wpan-helper.h"
+#include "ns3/rit-wpan-net-device.h"
+#include "ns3/rit-wpan-nwk.h"
+
+#ifdef NS3_MPI
+#include "ns3/mpi-interface.h"
+#include "ns3/rit-mpi-partition-helper.h"
+
+#include <mpi.h>
+#endif
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+using namespace ns3;
+using namespace lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("RitMpiBench");
+
+#ifdef NS3_MPI
+namespace
+{
+
+struct BenchConfig
+{
+    uint32_t routers = 5000;
+    double simTimeSec = 10.0;
+    uint32_t randomSeed = 1;
+    double spacingM = 40.0; // mean router spacing
+    double beaconIntervalMs = 5.0;
+    double sinkBeaconIntervalMs = 2.0;
+    double dataWaitDurationMs = 10.0;
+    double txWaitDurationMs = 5000.0;
+    uint32_t appIntervalSec = 60;
+    uint32_t appPacketSize = 8;
+    double minDistanceM = 0.0; // distance counted in the lookahead
+    std::string output = "rit-mpi-bench.csv";
+    std::string label = "default"; // build under test, e.g. a commit id
+};
+
+uint64_t g_appTx = 0; //!< Packets sent by the local routers
+uint64_t g_sinkRx = 0; //!< Packets received by the sink, if local
+
+void
+AppTx(Ptr<const Packet>)
+{
+    g_appTx++;
+}
+
+void
+SinkRx(Ptr<const Packet>)
+{
+    g_sinkRx++;
+}
+
+double
+ElapsedSeconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+#endif
+
+int
+main(int argc, char* argv[])
+{
+#ifdef NS3_MPI
+    GlobalValue::Bind("SimulatorImplementationType",
+                      StringValue("ns3::DistributedSimulatorImpl"));
+    MpiInterface::Enable(&argc, &argv);
+    const uint32_t rank = MpiInterface::GetSystemId();
+    const uint32_t nRanks = MpiInterface::GetSize();
+
+    BenchConfig cfg;
+    CommandLine cmd;
+    cmd.AddValue("Routers", "Router count", cfg.routers);
+    cmd.AddValue("SimTime", "Simulated duration (seconds)", cfg.simTimeSec);
+    cmd.AddValue("Seed", "Random seed", cfg.randomSeed);
+    cmd.AddValue("Spacing", "Mean router spacing [m]", cfg.spacingM);
+    cmd.AddValue("BI", "Beacon interval of the routers (milliseconds)", cfg.beaconIntervalMs);
+    cmd.AddValue("SinkBI", "Beacon interval of the sink (milliseconds)", cfg.sinkBeaconIntervalMs);
+    cmd.AddValue("DWD", "Receiver data wait duration (milliseconds)", cfg.dataWaitDurationMs);
+    cmd.AddValue("TWD", "Sender wait duration (milliseconds)", cfg.txWaitDurationMs);
+    cmd.AddValue("AppInterval", "Interval of the periodic senders (seconds)", cfg.appIntervalSec);
+    cmd.AddValue("AppPacketSize", "Packet size of the senders (bytes)", cfg.appPacketSize);
+    cmd.AddValue("MinDistance",
+                 "Shortest distance between nodes of two ranks in the lookahead [m]",
+                 cfg.minDistanceM);
+    cmd.AddValue("Output", "CSV file of the results, written by rank 0", cfg.output);
+    cmd.AddValue("Label", "Build label written in the row", cfg.label);
+    cmd.Parse(argc, argv);
+    RngSeedManager::SetSeed(cfg.randomSeed);
+    NS_ABORT_MSG_IF(cfg.routers == 0, "Routers needs a positive router count");
+
+    const auto setupStart = std::chrono::steady_clock::now();
+
+    // Same layout on every rank: one router per spacing^2, at least spacing / 2 apart
+    RitTopologyHelper topologyHelper;
+    topologyHelper.AssignStreams(0);
+    const double side = cfg.spacingM * std::sqrt(static_cast<double>(cfg.routers));
+    const RitTopology topology =
+        topologyHelper.PoissonDisc(cfg.routers, side, side, cfg.spacingM / 2);
+
+    NodeContainer sinks;
+    NodeContainer routers;
+    sinks.Create(1);
+    routers.Create(topology.routers.size());
+    NodeContainer allNodes(sinks, routers);
+
+    Ptr<LrWpanSpectrumChannel> channel = CreateObject<LrWpanSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    RitWpanNetHelper helper;
+    helper.SetChannel(channel);
+    helper.SetMacRitDataWaitDuration(MilliSeconds(cfg.dataWaitDurationMs));
+    helper.SetMacRitTxWaitDuration(MilliSeconds(cfg.txWaitDurationMs));
+    helper.SetMacRitPeriod(MilliSeconds(cfg.sinkBeaconIntervalMs));
+    helper.SetRxAlwaysOn(true);
+    helper.InstallSinks(sinks);
+    helper.SetMacRitPeriod(MilliSeconds(cfg.beaconIntervalMs));
+    helper.SetRxAlwaysOn(false);
+    NetDeviceContainer routerDevices = helper.InstallBulk(routers);
+
+    topologyHelper.Install(topology, sinks, routers);
+    auto routerDev = DynamicCast<RitWpanNetDevice>(routerDevices.Get(0));
+    const double range = RitTopologyHelper::GetLinkRange(channel, routerDev->GetPhy());
+    RitWpanRankHelper rankHelper;
+    rankHelper.Install(routers, sinks, range);
+
+    // One rank runs the whole network, as the reference of the partitioned runs
+    const bool partitioned = nRanks > 1;
+    RitMpiPartitionHelper mpiHelper;
+    mpiHelper.SetMinDistance(cfg.minDistanceM);
+    if (partitioned)
+    {
+        mpiHelper.Install(allNodes, channel);
+    }
+    NodeContainer localRouters = partitioned ? mpiHelper.GetLocalNodes(routers) : routers;
+    const int64_t appStream = helper.AssignStreams(allNodes, 1);
+
+    PeriodicSenderHelper app;
+    app.SetPeriod(Seconds(cfg.appIntervalSec));
+    app.SetPacketSize(cfg.appPacketSize);
+    app.SetDstAddr(Mac16Address("00:00"));
+    ApplicationContainer apps = app.Install(localRouters);
+    app.AssignStreams(localRouters, 1 + appStream);
+    for (auto it = apps.Begin(); it != apps.End(); ++it)
+    {
+        (*it)->TraceConnectWithoutContext("Tx", MakeCallback(&AppTx));
+    }
+    if (!partitioned || mpiHelper.GetLocalNodes(sinks).GetN() > 0)
+    {
+        auto sinkDev = DynamicCast<RitWpanNetDevice>(sinks.Get(0)->GetDevice(0));
+        sinkDev->GetNwk()->TraceConnectWithoutContext("NwkRx", MakeCallback(&SinkRx));
+    }
+    const double setupSeconds = ElapsedSeconds(setupStart);
+
+    const auto runStart = std::chrono::steady_clock::now();
+    Simulator::Stop(Seconds(cfg.simTimeSec));
+    Simulator::Run();
+    const double runSeconds = ElapsedSeconds(runStart);
+
+    NS_LOG_UNCOND("[BENCH] rank " << rank << " | " << localRouters.GetN() << " routers | run "
+                                  << runSeconds << " s | " << Simulator::GetEventCount()
+                                  << " events | sent " << mpiHelper.GetNSent() << " received "
+                                  << mpiHelper.GetNReceived() << " | foreign dropped "
+                                  << channel->GetNForeignTransmissions());
+
+    // totals of the ranks, slowest run
+    uint64_t counts[] = {Simulator::GetEventCount(), mpiHelper.GetNSent(), g_appTx, g_sinkRx};
+    uint64_t totals[] = {0, 0, 0, 0};
+    double times[] = {setupSeconds, runSeconds};
+    double maxTimes[] = {0.0, 0.0};
+    MPI_Comm comm = MpiInterface::GetCommunicator();
+    MPI_Reduce(counts, totals, 4, MPI_UINT64_T, MPI_SUM, 0, comm);
+    MPI_Reduce(times, maxTimes, 2, MPI_DOUBLE, MPI_MAX, 0, comm);
+    const Time lookahead = mpiHelper.GetLookahead();
+
+    if (rank == 0)
+    {
+        std::ofstream out(cfg.output, std::ios::trunc);
+        if (!out)
+        {
+            NS_FATAL_ERROR("Cannot write " << cfg.output);
+        }
+        const double perWall = maxTimes[1] > 0 ? totals[0] / maxTimes[1] : 0.0;
+        const double pdr = totals[2] > 0 ? static_cast<double>(totals[3]) / totals[2] : 0.0;
+        out << "label,ranks,nodes,sim_seconds,lookahead_us,setup_seconds,run_seconds,events,"
+               "events_per_wall_second,handovers,app_tx,sink_rx,pdr\n";
+        out << cfg.label << "," << nRanks << "," << allNodes.GetN() << "," << cfg.simTimeSec
+            << "," << lookahead.GetMicroSeconds() << "," << maxTimes[0] << "," << maxTimes[1]
+            << "," << totals[0] << "," << perWall << "," << totals[1] << "," << totals[2] << ","
+            << totals[3] << "," << pdr << "\n";
+        NS_LOG_UNCOND("[BENCH] " << nRanks << " ranks | " << allNodes.GetN() << " nodes | run "
+                                 << maxTimes[1] << " s | " << totals[0] << " events ("
+                                 << perWall << "/s wall) | " << totals[1] << " handovers | PDR "
+                                 << pdr << " | results written to " << cfg.output);
+    }
+
+    Simulator::Destroy();
+    MpiInterface::Disable();
+    return 0;
+#else
+    NS_FATAL_ERROR("rit-mpi-bench needs ns-3 configured with --enable-mpi");
+    return 1;
+#endif
+}
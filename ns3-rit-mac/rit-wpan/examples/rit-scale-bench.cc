@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+/*
+ * Scalability benchmark of the RIT-WPAN stack.
+ *
+ * The same fixed-seed scenario (one sink at the centre of a Poisson disc layout of
+ * routers sending periodically, ranks from the link range, range-culled channel) is
+ * run at each network size for a fixed simulated duration. For each size a CSV row
+ * reports the setup and run wall times, the simulator events executed, the events
+ * per simulated and per wall-clock second, the peak RSS of the process and the memory
+ * per node (resident growth during the setup, object bytes of the install report and
+ * the MAC share of them).
+ *
+ *   ./ns3 run "rit-scale-bench --Sizes=50,500,5000,20000 --SimTime=10 --Label=abc1234"
+ *
+ * Scheduler selects the event queue (map, heap, calendar or rit, the
+ * RitCalendarScheduler tuned from the beacon intervals); run it once per scheduler
+ * with a different Output to compare them.
+ *
+ * Arena allocates the tables of the rit-wpan objects from a RitRunArena for each run;
+ * FastTeardown ends each run with RitWpanNetHelper::Destroy() instead of
+ * Simulator::Destroy(). The teardown column times either call.
+ *
+ * FarFieldRadius turns the signals received farther than that into the far-field noise
+ * of LrWpanSpectrumChannel; the far_field_signals column counts them. Run it with and
+ * without to weigh the speed-up against the PDR of the RIT metrics.
+ *
+ * Compare two builds with analysis/common/bench_compare.py. The peak RSS is the high
+ * water mark of the process: the sizes are run in ascending order so that each row
+ * holds the peak of its own size, or run one size per process for exact figures.
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/propagation-module.h"
+
+#include "ns3/lr-wpan-spectrum-channel.h"
+#include "ns3/periodic-sender-helper.h"
+#include "ns3/rit-calendar-scheduler.h"
+#include "ns3/rit-rank-helper.h"
+#include "ns3/rit-run-arena.h"
+#include "ns3/rit-topology-helper.h"
+#include "ns3/rit-wpan-helper.h"
+#include "ns3/rit-wpan-net-device.h"
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+using namespace lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("RitScaleBench");
+
+namespace
+{
+
+struct BenchConfig
+{
+    std::string sizes = "50,500,5000,20000"; // router counts
+    double simTimeSec = 10.0;
+    uint32_t randomSeed = 1;
+    double spacingM = 40.0; // mean router spacing
+    double beaconIntervalMs = 5.0;
+    double sinkBeaconIntervalMs = 2.0;
+    double dataWaitDurationMs = 10.0;
+    double txWaitDurationMs = 5000.0;
+    uint32_t appIntervalSec = 60;
+    uint32_t appPacketSize = 8;
+    std::string output = "rit-scale-bench.csv";
+    std::string label = "default"; // build under test, e.g. a commit id
+    std::string scheduler = "map";  // "map", "heap", "calendar" or "rit"
+    bool arena = false;             // RitRunArena per run
+    bool fastTeardown = false;      // RitWpanNetHelper::Destroy()
+    double farFieldRadiusM = 0.0;   // LrWpanSpectrumChannel FarFieldRadius, 0 = none
+};
+
+struct BenchResult
+{
+    uint32_t nodes = 0;              // routers and the sink
+    double setupSeconds = 0.0;       // layout, install, ranks, applications
+    double runSeconds = 0.0;         // Simulator::Run()
+    uint64_t events = 0;             // events executed by the run
+    uint64_t peakRssKb = 0;          // high water mark of the process
+    uint64_t rssBytesPerNode = 0;    // resident growth during the setup, per node
+    uint64_t objectBytesPerNode = 0; // RitInstallReport::bytesPerDevice
+    uint64_t macBytesPerNode = 0;    // RitInstallReport::macBytesPerDevice
+    double teardownSeconds = 0.0;    // Simulator::Destroy()
+    uint64_t farFieldSignals = 0;    // signals turned into far-field noise
+};
+
+void
+BindCommandLine(CommandLine& cmd, BenchConfig& cfg)
+{
+    cmd.AddValue("Sizes", "Comma-separated router counts", cfg.sizes);
+    cmd.AddValue("SimTime", "Simulated duration of each run (seconds)", cfg.simTimeSec);
+    cmd.AddValue("Seed", "Random seed", cfg.randomSeed);
+    cmd.AddValue("Spacing", "Mean router spacing [m]", cfg.spacingM);
+    cmd.AddValue("BI", "Beacon interval of the routers (milliseconds)", cfg.beaconIntervalMs);
+    cmd.AddValue("SinkBI", "Beacon interval of the sink (milliseconds)", cfg.sinkBeaconIntervalMs);
+    cmd.AddValue("DWD", "Receiver data wait duration (milliseconds)", cfg.dataWaitDurationMs);
+    cmd.AddValue("TWD", "Sender wait duration (milliseconds)", cfg.txWaitDurationMs);
+    cmd.AddValue("AppInterval", "Interval of the periodic senders (seconds)", cfg.appIntervalSec);
+    cmd.AddValue("AppPacketSize", "Packet size of the senders (bytes)", cfg.appPacketSize);
+    cmd.AddValue("Output", "CSV file of the results (overwritten)", cfg.output);
+    cmd.AddValue("Label", "Build label written in each row", cfg.label);
+    cmd.AddValue("Scheduler", "Event queue (map/heap/calendar/rit)", cfg.scheduler);
+    cmd.AddValue("Arena", "Allocate the rit-wpan tables from a per-run arena", cfg.arena);
+    cmd.AddValue("FastTeardown", "End the runs with a bulk teardown", cfg.fastTeardown);
+    cmd.AddValue("FarFieldRadius",
+                 "Distance beyond which signals become far-field noise [m] (0 = none)",
+                 cfg.farFieldRadiusM);
+}
+
+/**
+ * TypeId name of a Scheduler option.
+ */
+std::string
+SchedulerTypeName(const std::string& scheduler)
+{
+    if (scheduler == "map")
+    {
+        return "ns3::MapScheduler";
+    }
+    if (scheduler == "heap")
+    {
+        return "ns3::HeapScheduler";
+    }
+    if (scheduler == "calendar")
+    {
+        return "ns3::CalendarScheduler";
+    }
+    if (scheduler == "rit")
+    {
+        return "ns3::lrwpan::RitCalendarScheduler";
+    }
+    NS_FATAL_ERROR("Unknown Scheduler: " << scheduler);
+    return "";
+}
+
+std::vector<uint32_t>
+ParseSizes(const std::string& sizes)
+{
+    std::vector<uint32_t> result;
+    std::stringstream ss(sizes);
+    std::string field;
+    while (std::getline(ss, field, ','))
+    {
+        if (!field.empty())
+        {
+            result.push_back(static_cast<uint32_t>(std::stoul(field)));
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+/**
+ * Resident set size of the process (0 where /proc is not available).
+ */
+uint64_t
+ResidentBytes()
+{
+    std::ifstream statm("/proc/self/statm");
+    uint64_t size = 0;
+    uint64_t resident = 0;
+    if (!(statm >> size >> resident))
+    {
+        return 0;
+    }
+    return resident * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+}
+
+/**
+ * Peak resident set size of the process so far.
+ */
+uint64_t
+PeakRssKb()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<uint64_t>(usage.ru_maxrss); // kilobytes on Linux
+}
+
+double
+ElapsedSeconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+BenchResult
+RunSize(const BenchConfig& cfg, uint32_t nRouters)
+{
+    BenchResult result;
+    const uint64_t rssBefore = ResidentBytes();
+    const auto setupStart = std::chrono::steady_clock::now();
+
+    ObjectFactory scheduler(SchedulerTypeName(cfg.scheduler));
+    Simulator::SetScheduler(scheduler);
+    RitCalendarScheduler::ResetPeriodicSources();
+    if (cfg.arena)
+    {
+        RitRunArena::Enable();
+    }
+
+    // Layout: one router per spacing^2, at least spacing / 2 apart
+    RitTopologyHelper topologyHelper;
+    topologyHelper.AssignStreams(0);
+    const double side = cfg.spacingM * std::sqrt(static_cast<double>(nRouters));
+    const RitTopology topology =
+        topologyHelper.PoissonDisc(nRouters, side, side, cfg.spacingM / 2);
+
+    NodeContainer sinks;
+    NodeContainer routers;
+    sinks.Create(1);
+    routers.Create(topology.routers.size());
+    result.nodes = 1 + routers.GetN();
+    NodeContainer allNodes(sinks, routers);
+
+    Ptr<LrWpanSpectrumChannel> channel = CreateObject<LrWpanSpectrumChannel>();
+    channel->SetFarFieldRadius(cfg.farFieldRadiusM);
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    RitWpanNetHelper helper;
+    helper.SetChannel(channel);
+    helper.SetMacRitDataWaitDuration(MilliSeconds(cfg.dataWaitDurationMs));
+    helper.SetMacRitTxWaitDuration(MilliSeconds(cfg.txWaitDurationMs));
+    helper.SetMacRitPeriod(MilliSeconds(cfg.sinkBeaconIntervalMs));
+    helper.SetRxAlwaysOn(true);
+    helper.InstallSinks(sinks);
+    helper.SetMacRitPeriod(MilliSeconds(cfg.beaconIntervalMs));
+    helper.SetRxAlwaysOn(false);
+    NetDeviceContainer routerDevices = helper.InstallBulk(routers);
+    result.objectBytesPerNode = helper.GetInstallReport().bytesPerDevice;
+    result.macBytesPerNode = helper.GetInstallReport().macBytesPerDevice;
+
+    topologyHelper.Install(topology, sinks, routers);
+    auto routerDev = DynamicCast<RitWpanNetDevice>(routerDevices.Get(0));
+    const double range = RitTopologyHelper::GetLinkRange(channel, routerDev->GetPhy());
+    RitWpanRankHelper rankHelper;
+    rankHelper.Install(routers, sinks, range);
+
+    PeriodicSenderHelper app;
+    app.SetPeriod(Seconds(cfg.appIntervalSec));
+    app.SetPacketSize(cfg.appPacketSize);
+    app.SetDstAddr(Mac16Address("00:00"));
+    app.Install(routers);
+    const int64_t appStream = helper.AssignStreams(allNodes, 1);
+    app.AssignStreams(routers, 1 + appStream);
+
+    result.setupSeconds = ElapsedSeconds(setupStart);
+    const uint64_t rssAfter = ResidentBytes();
+    result.rssBytesPerNode = (rssAfter > rssBefore ? rssAfter - rssBefore : 0) / result.nodes;
+
+    const auto runStart = std::chrono::steady_clock::now();
+    Simulator::Stop(Seconds(cfg.simTimeSec));
+    Simulator::Run();
+    result.runSeconds = ElapsedSeconds(runStart);
+    result.events = Simulator::GetEventCount();
+    result.peakRssKb = PeakRssKb();
+    result.farFieldSignals = channel->GetNFarFieldSignals();
+
+    const auto teardownStart = std::chrono::steady_clock::now();
+    if (cfg.fastTeardown)
+    {
+        RitWpanNetHelper::Destroy();
+    }
+    else
+    {
+        Simulator::Destroy();
+    }
+    result.teardownSeconds = ElapsedSeconds(teardownStart);
+    if (RitRunArena::IsEnabled())
+    {
+        RitRunArena::Disable();
+    }
+    return result;
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    BenchConfig cfg;
+    CommandLine cmd;
+    BindCommandLine(cmd, cfg);
+    cmd.Parse(argc, argv);
+
+    RngSeedManager::SetSeed(cfg.randomSeed);
+    const std::vector<uint32_t> sizes = ParseSizes(cfg.sizes);
+    if (sizes.empty() || sizes.front() == 0)
+    {
+        NS_FATAL_ERROR("Sizes needs positive router counts");
+    }
+
+    std::ofstream out(cfg.output, std::ios::trunc);
+    if (!out)
+    {
+        NS_FATAL_ERROR("Cannot write " << cfg.output);
+    }
+    out << "label,scheduler,nodes,sim_seconds,setup_seconds,run_seconds,events,"
+           "events_per_sim_second,events_per_wall_second,peak_rss_kb,rss_bytes_per_node,"
+           "object_bytes_per_node,mac_bytes_per_node,teardown_seconds,far_field_signals\n";
+
+    for (uint32_t nRouters : sizes)
+    {
+        const BenchResult r = RunSize(cfg, nRouters);
+        const double perSim = r.events / cfg.simTimeSec;
+        const double perWall = r.runSeconds > 0 ? r.events / r.runSeconds : 0.0;
+        out << cfg.label << "," << cfg.scheduler << "," << r.nodes << "," << cfg.simTimeSec << ","
+            << r.setupSeconds << "," << r.runSeconds << "," << r.events << "," << perSim << ","
+            << perWall << "," << r.peakRssKb << "," << r.rssBytesPerNode << ","
+            << r.objectBytesPerNode << "," << r.macBytesPerNode << "," << r.teardownSeconds
+            << "," << r.farFieldSignals << "\n";
+        out.flush();
+        NS_LOG_UNCOND("[BENCH] " << r.nodes << " nodes | setup " << r.setupSeconds << " s | run "
+                                 << r.runSeconds << " s | " << r.events << " events ("
+                                 << perWall << "/s wall, " << perSim << "/s simulated) | peak "
+                                 << r.peakRssKb << " kB | " << r.rssBytesPerNode
+                                 << " B/node | MAC " << r.macBytesPerNode << " B | teardown "
+                                 << r.teardownSeconds << " s | far field "
+                                 << r.farFieldSignals);
+    }
+    NS_LOG_UNCOND("[BENCH] results written to " << cfg.output);
+    return 0;
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "event-flood-helper.h"
+
+#include "ns3/double.h"
+#include "ns3/event-flood-sender.h"
+#include "ns3/log.h"
+#include "ns3/mobility-model.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/rit-wpan-net-device.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_LOG_COMPONENT_DEFINE("EventFloodHelper");
+
+EventFloodHelper::EventFloodHelper()
+    : m_dstAddr(),
+      m_pktSize(20),
+      m_epicentre(),
+      m_start(Seconds(0)),
+      m_speed(std::numeric_limits<double>::infinity()),
+      m_jitter(Seconds(0)),
+      m_reportCount(1),
+      m_reportInterval(Seconds(1))
+{
+    m_factory.SetTypeId("ns3::lrwpan::EventFloodSender");
+
+    m_jitterVariable = CreateObject<UniformRandomVariable>();
+    m_jitterVariable->SetAttribute("Min", DoubleValue(0.0));
+}
+
+EventFloodHelper::~EventFloodHelper()
+{
+}
+
+void
+EventFloodHelper::SetAttribute(std::string name, const AttributeValue& value)
+{
+    m_factory.Set(name, value);
+}
+
+void
+EventFloodHelper::SetDstAddr(const Address& addr)
+{
+    m_dstAddr = addr;
+}
+
+void
+EventFloodHelper::SetPacketSize(uint16_t size)
+{
+    m_pktSize = size;
+}
+
+void
+EventFloodHelper::SetEpicentre(const Vector& epicentre)
+{
+    m_epicentre = epicentre;
+}
+
+void
+EventFloodHelper::SetStartTime(Time start)
+{
+    m_start = start;
+}
+
+void
+EventFloodHelper::SetSpeed(double speed)
+{
+    m_speed = speed > 0.0 ? speed : std::numeric_limits<double>::infinity();
+}
+
+void
+EventFloodHelper::SetJitter(Time jitter)
+{
+    m_jitter = jitter;
+}
+
+void
+EventFloodHelper::SetReports(uint32_t count, Time interval)
+{
+    m_reportCount = count;
+    m_reportInterval = interval;
+}
+
+Time
+EventFloodHelper::GetArrivalTime(Ptr<Node> node) const
+{
+    Ptr<MobilityModel> mobility = node->GetObject<MobilityModel>();
+    if (!mobility || std::isinf(m_speed))
+    {
+        return m_start;
+    }
+    return m_start + Seconds(CalculateDistance(mobility->GetPosition(), m_epicentre) / m_speed);
+}
+
+ApplicationContainer
+EventFloodHelper::Install(Ptr<Node> node) const
+{
+    return ApplicationContainer(InstallPriv(node));
+}
+
+ApplicationContainer
+EventFloodHelper::Install(NodeContainer c) const
+{
+    ApplicationContainer apps;
+    for (auto i = c.Begin(); i != c.End(); ++i)
+    {
+        apps.Add(InstallPriv(*i));
+    }
+    return apps;
+}
+
+Ptr<Application>
+EventFloodHelper::InstallPriv(Ptr<Node> node) const
+{
+    Ptr<EventFloodSender> app = m_factory.Create<EventFloodSender>();
+    app->SetNode(node);
+    app->SetDstAddr(m_dstAddr);
+    app->SetAttribute("PacketSize", UintegerValue(m_pktSize));
+    app->SetAttribute("ReportCount", UintegerValue(m_reportCount));
+    app->SetAttribute("ReportInterval", TimeValue(m_reportInterval));
+    app->SetTriggerTime(GetArrivalTime(node) +
+                        Seconds(m_jitterVariable->GetValue(0.0, m_jitter.GetSeconds())));
+
+    // No receive callback: the background application of the node keeps it
+    node->AddApplication(app);
+    return app;
+}
+
+int64_t
+EventFloodHelper::AssignStreams(NodeContainer c, int64_t stream)
+{
+    int64_t span = 0;
+    for (auto it = c.Begin(); it != c.End(); ++it)
+    {
+        Ptr<Node> node = *it;
+        int64_t key = node->GetId();
+        for (uint32_t i = 0; i < node->GetNDevices(); ++i)
+        {
+            if (auto dev = DynamicCast<RitWpanNetDevice>(node->GetDevice(i)))
+            {
+                key = dev->GetMac()->GetShortAddress().ConvertToInt();
+                break;
+            }
+        }
+
+        Ptr<UniformRandomVariable> jitter = CreateObject<UniformRandomVariable>();
+        jitter->SetStream(stream + key * STREAMS_PER_NODE);
+        for (uint32_t i = 0; i < node->GetNApplications(); ++i)
+        {
+            if (auto app = DynamicCast<EventFloodSender>(node->GetApplication(i)))
+            {
+                app->SetTriggerTime(GetArrivalTime(node) +
+                                    Seconds(jitter->GetValue(0.0, m_jitter.GetSeconds())));
+            }
+        }
+        span = std::max(span, (key + 1) * STREAMS_PER_NODE);
+    }
+    return span;
+}
+
+} // namespace lrwpan
+} // namespace ns3
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef EVENT_FLOOD_HELPER_H
+#define EVENT_FLOOD_HELPER_H
+
+#include "ns3/address.h"
+#include "ns3/application-container.h"
+#include "ns3/attribute.h"
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+#include "ns3/object-factory.h"
+#include "ns3/vector.h"
+
+#include <cstdint>
+#include <string>
+
+namespace ns3
+{
+
+class UniformRandomVariable;
+
+namespace lrwpan
+{
+
+/**
+ * @ingroup lrwpan
+ *
+ * Helper to install EventFloodSender applications reporting one spatially
+ * propagating event.
+ *
+ * The event starts at the epicentre at the start time and spreads at a constant
+ * speed: a node at distance d detects it at start + d / speed, plus a uniform jitter
+ * in [0, jitter] of its own. The distance is taken from the MobilityModel of the node
+ * (a node without one is at the epicentre). An infinite speed (the default) triggers
+ * every node at the start time. Install the background application first: the
+ * event flood application is added next to it.
+ */
+class EventFloodHelper
+{
+  public:
+    EventFloodHelper();
+    ~EventFloodHelper();
+
+    /**
+     * Set an attribute on the underlying EventFloodSender application.
+     */
+    void SetAttribute(std::string name, const AttributeValue& value);
+
+    ApplicationContainer Install(NodeContainer c) const;
+    ApplicationContainer Install(Ptr<Node> node) const;
+
+    void SetDstAddr(const Address& addr);
+    void SetPacketSize(uint16_t size);
+
+    /**
+     * @param epicentre Position where the event starts
+     */
+    void SetEpicentre(const Vector& epicentre);
+
+    /**
+     * @param start Time the event starts at the epicentre
+     */
+    void SetStartTime(Time start);
+
+    /**
+     * @param speed Propagation speed of the event [m/s], infinite or 0 for none
+     */
+    void SetSpeed(double speed);
+
+    /**
+     * @param jitter Largest detection delay of a node after the event reached it
+     */
+    void SetJitter(Time jitter);
+
+    /**
+     * @param count Reports sent by each node
+     * @param interval Interval between the reports of a node
+     */
+    void SetReports(uint32_t count, Time interval);
+
+    /**
+     * Get the time the event reaches a node, without the jitter.
+     *
+     * @param node The node
+     * @return the arrival time of the event
+     */
+    Time GetArrivalTime(Ptr<Node> node) const;
+
+    /**
+     * Number of stream indices reserved for each node by AssignStreams().
+     */
+    static constexpr int64_t STREAMS_PER_NODE = 1;
+
+    /**
+     * Assign fixed random variable streams to the detection jitter of the
+     * EventFloodSender applications of the nodes.
+     *
+     * The jitter of a node is drawn again from stream + key, the key being the short
+     * address of its RitWpanNetDevice (the node id without one), so that it no longer
+     * depends on the installation order. Call it with the configuration used for
+     * Install(), after the addresses are set.
+     *
+     * @param c Nodes whose applications are covered
+     * @param stream First stream index to use
+     * @return the number of stream indices spanned, up to the largest key
+     */
+    int64_t AssignStreams(NodeContainer c, int64_t stream);
+
+  private:
+    Ptr<Application> InstallPriv(Ptr<Node> node) const;
+
+    ObjectFactory m_factory;
+
+    Ptr<UniformRandomVariable> m_jitterVariable;
+
+    Address m_dstAddr;
+    uint16_t m_pktSize;
+    Vector m_epicentre;
+    Time m_start;
+    double m_speed;
+    Time m_jitter;
+    uint32_t m_reportCount;
+    Time m_reportInterval;
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // EVENT_FLOOD_HELPER_H
@@ -8,12 +8,15 @@
 
  #include "random-sender-helper.h"
 
+#include "ns3/abort.h"
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/random-sender.h"
 #include "ns3/random-variable-stream.h"
 #include "ns3/rit-wpan-net-device.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 namespace lrwpan
@@ -123,5 +126,50 @@ RandomSenderHelper::SetReceiveOnly(bool enable)
     m_receiveOnly = enable;
 }
 
+int64_t
+RandomSenderHelper::AssignStreams(NodeContainer c, int64_t stream)
+{
+    // Initial delay + the streams of the application
+    constexpr int64_t streamsPerApp = 3;
+
+    int64_t span = 0;
+    for (auto it = c.Begin(); it != c.End(); ++it)
+    {
+        Ptr<Node> node = *it;
+        int64_t key = node->GetId();
+        for (uint32_t i = 0; i < node->GetNDevices(); ++i)
+        {
+            if (auto dev = DynamicCast<RitWpanNetDevice>(node->GetDevice(i)))
+            {
+                key = dev->GetMac()->GetShortAddress().ConvertToInt();
+                break;
+            }
+        }
+
+        int64_t next = stream + key * STREAMS_PER_NODE;
+        for (uint32_t i = 0; i < node->GetNApplications(); ++i)
+        {
+            Ptr<RandomSender> app = DynamicCast<RandomSender>(node->GetApplication(i));
+            if (!app)
+            {
+                continue;
+            }
+            NS_ABORT_MSG_IF(next + streamsPerApp > stream + (key + 1) * STREAMS_PER_NODE,
+                            "Too many RandomSender applications on node " << node->GetId());
+            if (!m_receiveOnly)
+            {
+                Ptr<UniformRandomVariable> initialDelay = CreateObject<UniformRandomVariable>();
+                initialDelay->SetStream(next);
+                app->SetInitialDelay(
+                    Seconds(initialDelay->GetValue(0.0, m_maxInterval.GetSeconds())));
+            }
+            app->AssignStreams(next + 1);
+            next += streamsPerApp;
+        }
+        span = std::max(span, (key + 1) * STREAMS_PER_NODE);
+    }
+    return span;
+}
+
 } // namespace lrwpan
 } // namespace ns3
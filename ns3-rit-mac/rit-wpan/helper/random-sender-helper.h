@@ -56,6 +56,27 @@ class RandomSenderHelper
      */
     void SetReceiveOnly(bool enable);
 
+    /**
+     * Number of stream indices reserved for each node by AssignStreams().
+     */
+    static constexpr int64_t STREAMS_PER_NODE = 8;
+
+    /**
+     * Assign fixed random variable streams to the RandomSender applications of the nodes.
+     *
+     * The applications of a node take the block of STREAMS_PER_NODE indices starting
+     * at stream + key * STREAMS_PER_NODE, the key being the short address of its
+     * RitWpanNetDevice (the node id without one). The initial delay of each sending
+     * application is drawn again from the first stream of its block, as Install()
+     * did, so that it no longer depends on the installation order. Call it with the
+     * configuration used for Install(), after the addresses are set.
+     *
+     * @param c Nodes whose applications are covered
+     * @param stream First stream index to use
+     * @return the number of stream indices spanned, up to the block of the largest key
+     */
+    int64_t AssignStreams(NodeContainer c, int64_t stream);
+
   private:
     Ptr<Application> InstallPriv(Ptr<Node> node) const;
 
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-async-trace-writer.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+#include <chrono>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_LOG_COMPONENT_DEFINE("RitAsyncTraceWriter");
+
+RitAsyncTraceWriter::RitAsyncTraceWriter(uint32_t capacity, BackpressurePolicy policy)
+    : m_policy(policy)
+{
+    NS_LOG_FUNCTION(this << capacity << policy);
+    NS_ABORT_MSG_IF(capacity < 2, "Async trace ring needs at least two slots");
+    size_t size = 1;
+    while (size < capacity)
+    {
+        size <<= 1;
+    }
+    m_ring.resize(size);
+    m_mask = size - 1;
+}
+
+RitAsyncTraceWriter::~RitAsyncTraceWriter()
+{
+    NS_LOG_FUNCTION(this);
+    Stop();
+}
+
+void
+RitAsyncTraceWriter::Start()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_thread.joinable())
+    {
+        return;
+    }
+    m_stop.store(false, std::memory_order_relaxed);
+    m_thread = std::thread(&RitAsyncTraceWriter::Run, this);
+}
+
+void
+RitAsyncTraceWriter::Stop()
+{
+    if (!m_thread.joinable())
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this);
+    m_stop.store(true, std::memory_order_release);
+    m_thread.join();
+
+    // The writer thread is gone: the simulator thread owns the writers again.
+    for (auto& writer : m_writers)
+    {
+        writer->DetachAsyncWriter();
+        writer->Flush();
+    }
+    m_writers.clear();
+    if (m_dropped.load(std::memory_order_relaxed) > 0)
+    {
+        NS_LOG_WARN("Async trace writer dropped " << m_dropped.load() << " records (ring full)");
+    }
+    NS_LOG_INFO("Async trace writer stopped, producer blocked " << m_blocked << " times");
+}
+
+bool
+RitAsyncTraceWriter::IsRunning() const
+{
+    return m_thread.joinable();
+}
+
+void
+RitAsyncTraceWriter::Register(Ptr<RitBinaryTraceWriter> writer)
+{
+    NS_ABORT_MSG_IF(m_thread.joinable(), "Register trace writers before starting the thread");
+    m_writers.push_back(writer);
+}
+
+bool
+RitAsyncTraceWriter::Push(RitBinaryTraceWriter* target, const RitTraceRecord& record)
+{
+    size_t head = m_head.load(std::memory_order_relaxed);
+    if (head - m_tail.load(std::memory_order_acquire) > m_mask)
+    {
+        if (m_policy == DROP)
+        {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        m_blocked++;
+        while (head - m_tail.load(std::memory_order_acquire) > m_mask)
+        {
+            std::this_thread::yield();
+        }
+    }
+    Entry& slot = m_ring[head & m_mask];
+    slot.target = target;
+    slot.record = record;
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+uint64_t
+RitAsyncTraceWriter::GetDroppedCount() const
+{
+    return m_dropped.load(std::memory_order_relaxed);
+}
+
+uint64_t
+RitAsyncTraceWriter::GetBlockedCount() const
+{
+    return m_blocked;
+}
+
+size_t
+RitAsyncTraceWriter::Drain()
+{
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    size_t head = m_head.load(std::memory_order_acquire);
+    size_t consumed = head - tail;
+    for (; tail != head; ++tail)
+    {
+        const Entry& slot = m_ring[tail & m_mask];
+        slot.target->WriteBuffered(slot.record);
+        // Release slots in batches of a few hundred so the producer sees progress early
+        if ((tail & 0xFF) == 0xFF)
+        {
+            m_tail.store(tail + 1, std::memory_order_release);
+        }
+    }
+    m_tail.store(tail, std::memory_order_release);
+    return consumed;
+}
+
+void
+RitAsyncTraceWriter::Run()
+{
+    while (true)
+    {
+        bool stopping = m_stop.load(std::memory_order_acquire);
+        size_t consumed = Drain();
+        if (stopping && consumed == 0)
+        {
+            break;
+        }
+        if (consumed == 0)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+}
+
+} // namespace lrwpan
+} // namespace ns3
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef RIT_ASYNC_TRACE_WRITER_H
+#define RIT_ASYNC_TRACE_WRITER_H
+
+#include "ns3/ptr.h"
+#include "ns3/rit-trace-writer.h"
+#include "ns3/simple-ref-count.h"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @ingroup lrwpan
+ *
+ * @brief Background writer thread for binary trace records.
+ *
+ * The simulator thread (single producer) pushes records into a lock-free ring;
+ * a background thread (single consumer) moves them into the buffers of their
+ * RitBinaryTraceWriter and performs the disk writes. When the ring is full the
+ * producer either waits for the writer thread (BLOCK) or discards the record
+ * and counts it (DROP).
+ */
+class RitAsyncTraceWriter : public SimpleRefCount<RitAsyncTraceWriter>
+{
+  public:
+    /**
+     * @brief Behaviour of Push() when the ring is full.
+     */
+    enum BackpressurePolicy
+    {
+        BLOCK, //!< Wait until the writer thread frees a slot (no loss)
+        DROP   //!< Discard the record and increment the drop counter
+    };
+
+    /**
+     * @brief Constructor.
+     * @param capacity Ring capacity in records (rounded up to a power of two)
+     * @param policy Backpressure policy
+     */
+    RitAsyncTraceWriter(uint32_t capacity, BackpressurePolicy policy);
+    ~RitAsyncTraceWriter();
+
+    RitAsyncTraceWriter(const RitAsyncTraceWriter&) = delete;
+    RitAsyncTraceWriter& operator=(const RitAsyncTraceWriter&) = delete;
+
+    /** @brief Start the writer thread. */
+    void Start();
+
+    /** @brief Drain the ring, flush all registered writers and join the thread. */
+    void Stop();
+
+    /** @brief Check whether the writer thread is running. */
+    bool IsRunning() const;
+
+    /**
+     * @brief Register a writer served by this thread (kept alive until Stop()).
+     * @param writer Binary trace writer
+     */
+    void Register(Ptr<RitBinaryTraceWriter> writer);
+
+    /**
+     * @brief Queue a record for a registered writer (simulator thread only).
+     * @param target Destination writer
+     * @param record Record to write
+     * @return false if the record was dropped
+     */
+    bool Push(RitBinaryTraceWriter* target, const RitTraceRecord& record);
+
+    /** @brief Get the number of records dropped because the ring was full. */
+    uint64_t GetDroppedCount() const;
+
+    /** @brief Get the number of times the producer had to wait (BLOCK policy). */
+    uint64_t GetBlockedCount() const;
+
+  private:
+    /**
+     * @brief Ring slot.
+     */
+    struct Entry
+    {
+        RitBinaryTraceWriter* target; //!< Destination writer
+        RitTraceRecord record;        //!< Record
+    };
+
+    /** @brief Writer thread main loop. */
+    void Run();
+
+    /**
+     * @brief Move all queued records to their writers (writer thread only).
+     * @return Number of records consumed
+     */
+    size_t Drain();
+
+    std::vector<Entry> m_ring; //!< Ring storage
+    size_t m_mask;             //!< Capacity - 1
+    BackpressurePolicy m_policy;
+
+    alignas(64) std::atomic<size_t> m_head{0}; //!< Next slot to write (producer)
+    alignas(64) std::atomic<size_t> m_tail{0}; //!< Next slot to read (consumer)
+    alignas(64) std::atomic<bool> m_stop{false};
+
+    std::atomic<uint64_t> m_dropped{0}; //!< Records dropped (DROP policy)
+    uint64_t m_blocked = 0;             //!< Producer waits (BLOCK policy)
+
+    std::vector<Ptr<RitBinaryTraceWriter>> m_writers; //!< Registered writers
+    std::thread m_thread;                             //!< Writer thread
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // RIT_ASYNC_TRACE_WRITER_H
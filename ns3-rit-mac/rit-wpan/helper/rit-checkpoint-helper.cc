@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-checkpoint-helper.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/rit-wpan-mac.h"
+#include "ns3/rit-wpan-net-device.h"
+#include "ns3/rit-wpan-nwk.h"
+#include "ns3/simulator.h"
+
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <vector>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_LOG_COMPONENT_DEFINE("RitCheckpointHelper");
+
+namespace
+{
+
+/**
+ * Saved state of one device.
+ */
+struct DeviceCheckpoint
+{
+    RitNwkCheckpoint nwk; //!< Routing layer
+    RitMacCheckpoint mac; //!< MAC
+};
+
+Ptr<RitWpanNetDevice>
+FindRitWpanDevice(Ptr<Node> node)
+{
+    for (uint32_t i = 0; i < node->GetNDevices(); ++i)
+    {
+        if (auto dev = DynamicCast<RitWpanNetDevice>(node->GetDevice(i)))
+        {
+            return dev;
+        }
+    }
+    return nullptr;
+}
+
+std::vector<std::string>
+SplitFields(const std::string& line)
+{
+    std::vector<std::string> fields;
+    std::stringstream ss(line);
+    std::string field;
+    while (std::getline(ss, field, ','))
+    {
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+} // namespace
+
+RitCheckpointHelper::RitCheckpointHelper()
+{
+}
+
+RitCheckpointHelper::~RitCheckpointHelper()
+{
+}
+
+uint32_t
+RitCheckpointHelper::Save(NodeContainer c, const std::string& path) const
+{
+    std::ofstream out(path, std::ios::trunc);
+    NS_ABORT_MSG_IF(!out, "Cannot write checkpoint file " << path);
+    out << std::setprecision(std::numeric_limits<double>::max_digits10);
+    out << "# rit-wpan checkpoint at " << Simulator::Now().GetNanoSeconds() << " ns\n";
+
+    uint32_t saved = 0;
+    for (auto it = c.Begin(); it != c.End(); ++it)
+    {
+        Ptr<RitWpanNetDevice> dev = FindRitWpanDevice(*it);
+        if (!dev)
+        {
+            continue;
+        }
+        const Mac16Address addr = dev->GetMac()->GetShortAddress();
+        const RitNwkCheckpoint nwk = dev->GetNwk()->GetCheckpoint();
+        const RitMacCheckpoint mac = dev->GetMac()->GetCheckpoint();
+
+        out << "node," << addr << "," << nwk.rank << "," << nwk.parent << ","
+            << mac.period.GetNanoSeconds() << "," << mac.nextRequest.GetNanoSeconds() << ","
+            << mac.skewPpm << "\n";
+        for (const auto& n : nwk.neighbours)
+        {
+            out << "neighbour," << addr << "," << n.addr << "," << n.rank << "," << n.lqi << ","
+                << n.prr << "," << n.lastBeacon.GetNanoSeconds() << ","
+                << n.period.GetNanoSeconds() << "," << n.answered << "," << n.stale << "\n";
+        }
+        for (const auto& phase : mac.phases)
+        {
+            out << "phase," << addr << "," << phase.addr << "," << phase.age.GetNanoSeconds()
+                << "," << phase.period.GetNanoSeconds() << "\n";
+        }
+        for (const auto& [node, parent] : nwk.downlinkParents)
+        {
+            out << "route," << addr << "," << node << "," << parent << "\n";
+        }
+        saved++;
+    }
+    NS_LOG_INFO("Checkpoint of " << saved << " devices written to " << path);
+    return saved;
+}
+
+void
+RitCheckpointHelper::ScheduleSave(NodeContainer c, Time at, const std::string& path) const
+{
+    Simulator::Schedule(at - Simulator::Now(), [c, path]() {
+        RitCheckpointHelper helper;
+        helper.Save(c, path);
+    });
+}
+
+uint32_t
+RitCheckpointHelper::Restore(NodeContainer c, const std::string& path) const
+{
+    std::ifstream in(path);
+    NS_ABORT_MSG_IF(!in, "Cannot read checkpoint file " << path);
+
+    std::map<Mac16Address, DeviceCheckpoint> saved;
+    std::string line;
+    uint32_t lineNumber = 0;
+    while (std::getline(in, line))
+    {
+        lineNumber++;
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+        const std::vector<std::string> f = SplitFields(line);
+        const std::string& kind = f[0];
+        const bool valid = (kind == "node" && f.size() == 7) ||
+                           (kind == "neighbour" && f.size() == 10) ||
+                           (kind == "phase" && f.size() == 5) || (kind == "route" && f.size() == 4);
+        NS_ABORT_MSG_IF(!valid, path << ":" << lineNumber << ": malformed record");
+
+        DeviceCheckpoint& state = saved[Mac16Address(f[1].c_str())];
+        if (kind == "node")
+        {
+            state.nwk.rank = static_cast<uint16_t>(std::stoul(f[2]));
+            state.nwk.parent = Mac16Address(f[3].c_str());
+            state.mac.period = NanoSeconds(std::stoll(f[4]));
+            state.mac.nextRequest = NanoSeconds(std::stoll(f[5]));
+            state.mac.skewPpm = std::stod(f[6]);
+        }
+        else if (kind == "neighbour")
+        {
+            RitNeighbour n;
+            n.addr = Mac16Address(f[2].c_str());
+            n.rank = static_cast<uint16_t>(std::stoul(f[3]));
+            n.lqi = std::stod(f[4]);
+            n.prr = std::stod(f[5]);
+            n.lastBeacon = NanoSeconds(std::stoll(f[6]));
+            n.period = NanoSeconds(std::stoll(f[7]));
+            n.answered = f[8] == "1";
+            n.stale = f[9] == "1";
+            state.nwk.neighbours.push_back(n);
+        }
+        else if (kind == "phase")
+        {
+            state.mac.phases.push_back({Mac16Address(f[2].c_str()),
+                                        NanoSeconds(std::stoll(f[3])),
+                                        NanoSeconds(std::stoll(f[4]))});
+        }
+        else
+        {
+            state.nwk.downlinkParents[Mac16Address(f[2].c_str())] = Mac16Address(f[3].c_str());
+        }
+    }
+
+    uint32_t restored = 0;
+    for (auto it = c.Begin(); it != c.End(); ++it)
+    {
+        Ptr<RitWpanNetDevice> dev = FindRitWpanDevice(*it);
+        if (!dev)
+        {
+            continue;
+        }
+        auto state = saved.find(dev->GetMac()->GetShortAddress());
+        if (state == saved.end())
+        {
+            NS_LOG_WARN("No saved state for " << dev->GetMac()->GetShortAddress());
+            continue;
+        }
+        dev->GetNwk()->RestoreCheckpoint(state->second.nwk);
+        dev->GetMac()->RestoreCheckpoint(state->second.mac);
+        restored++;
+    }
+    NS_LOG_INFO("Checkpoint " << path << " restored on " << restored << " devices");
+    return restored;
+}
+
+} // namespace lrwpan
+} // namespace ns3
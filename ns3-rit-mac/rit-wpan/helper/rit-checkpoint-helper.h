@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef NS3_RIT_CHECKPOINT_HELPER_H
+#define NS3_RIT_CHECKPOINT_HELPER_H
+
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+
+#include <cstdint>
+#include <string>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * Helper to save the warm-up state of a RIT network and continue other runs from it.
+ *
+ * A checkpoint holds, for each RitWpanNetDevice, the NWK state (rank, parent,
+ * neighbour table, reported downlink parents, see RitNwkCheckpoint) and the MAC
+ * state (current RIT period, phase of the next RIT request, clock skew, learned
+ * beacon phases, see RitMacCheckpoint). Times are stored relative to the
+ * checkpoint, so a restored run continues at its own time zero, and devices are
+ * keyed by short address, so the restored network may be built in any order.
+ *
+ * The state in flight is not saved: queued and in-progress frames, packets of
+ * the NWK transmit table, the PHY state and the position of the random number
+ * streams. Save at a quiet instant after the warm-up; the restored run draws
+ * its random numbers from its own streams (RitWpanNetHelper::AssignStreams()).
+ *
+ * The file is a text file with one record per line:
+ *  - node,addr,rank,parent,periodNs,nextRequestNs,skewPpm
+ *  - neighbour,addr,neighbour,rank,lqi,prr,ageNs,periodNs,answered,stale
+ *  - phase,addr,neighbour,ageNs,periodNs
+ *  - route,addr,node,parent
+ */
+class RitCheckpointHelper
+{
+  public:
+    RitCheckpointHelper();
+    ~RitCheckpointHelper();
+
+    RitCheckpointHelper(const RitCheckpointHelper&) = delete;
+    RitCheckpointHelper& operator=(const RitCheckpointHelper&) = delete;
+
+    /**
+     * Write the state of the devices of the nodes.
+     *
+     * @param c Nodes to save
+     * @param path Checkpoint file (overwritten)
+     * @return the number of devices saved
+     */
+    uint32_t Save(NodeContainer c, const std::string& path) const;
+
+    /**
+     * Write the state of the devices of the nodes at a given time.
+     *
+     * @param c Nodes to save
+     * @param at Simulation time of the checkpoint
+     * @param path Checkpoint file (overwritten)
+     */
+    void ScheduleSave(NodeContainer c, Time at, const std::string& path) const;
+
+    /**
+     * Continue from a checkpoint: give each device the state saved for its short
+     * address. Call it after the devices are installed and addressed, and
+     * before the simulation starts; devices without a saved state are left as
+     * they are.
+     *
+     * @param c Nodes to restore
+     * @param path Checkpoint file
+     * @return the number of devices restored
+     */
+    uint32_t Restore(NodeContainer c, const std::string& path) const;
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // NS3_RIT_CHECKPOINT_HELPER_H
@@ -0,0 +1,341 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-drive-by-collector.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/lr-wpan-mac-header.h"
+#include "ns3/rit-frame-codec.h"
+#include "ns3/rit-wpan-mac.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_LOG_COMPONENT_DEFINE("RitDriveByCollector");
+
+namespace
+{
+
+/**
+ * @brief Parse a number of a drive-by trace.
+ * @param field The text
+ * @param value The number
+ * @return true if the whole field is a number
+ */
+bool
+ParseNumber(const std::string& field, double& value)
+{
+    char* end = nullptr;
+    value = std::strtod(field.c_str(), &end);
+    return end != field.c_str() && *end == '\0';
+}
+
+/// Airtime of one PSDU byte at 250 kb/s
+const Time BYTE_AIRTIME = MicroSeconds(32);
+
+/// Synchronization header and PHY header of a PPDU [bytes]
+const uint32_t PPDU_OVERHEAD = 6;
+
+} // namespace
+
+RitDriveByCollector::RitDriveByCollector(Ptr<RitWpanNetDevice> collector,
+                                         const std::vector<Ptr<RitWpanNetDevice>>& meters)
+    : m_collector(collector),
+      m_meters(meters),
+      m_contactRange(100.0),
+      m_sampleInterval(MilliSeconds(100)),
+      m_inContact(false)
+{
+    NS_ABORT_MSG_IF(!collector, "RitDriveByCollector needs a collector");
+    m_mobility = DynamicCast<WaypointMobilityModel>(collector->GetPhy()->GetMobility());
+    NS_ABORT_MSG_IF(!m_mobility, "The collector PHY must use a WaypointMobilityModel");
+}
+
+void
+RitDriveByCollector::SetContactRange(double range)
+{
+    m_contactRange = range;
+}
+
+void
+RitDriveByCollector::SetSampleInterval(Time interval)
+{
+    NS_ABORT_MSG_UNLESS(interval.IsStrictlyPositive(), "Invalid sample interval");
+    m_sampleInterval = interval;
+}
+
+void
+RitDriveByCollector::AddPass(Time start, const std::vector<Vector>& route, double speed)
+{
+    NS_ABORT_MSG_IF(speed <= 0, "Invalid speed " << speed);
+    std::vector<Waypoint> timed;
+    Time at = start;
+    for (std::size_t i = 0; i < route.size(); i++)
+    {
+        if (i > 0)
+        {
+            at += Seconds(CalculateDistance(route[i - 1], route[i]) / speed);
+        }
+        timed.emplace_back(at, route[i]);
+    }
+    AddRoute(timed);
+}
+
+void
+RitDriveByCollector::AddRoute(const std::vector<Waypoint>& route)
+{
+    NS_ABORT_MSG_IF(route.size() < 2, "A pass needs two waypoints at least");
+    NS_ABORT_MSG_IF(!m_passes.empty() && route.front().time <= m_passes.back().end,
+                    "Pass starting before the end of the last one");
+    if (!m_passes.empty() && route.front().time - MilliSeconds(1) > m_passes.back().end)
+    {
+        // parked until the pass, then a hop to its first waypoint
+        m_mobility->AddWaypoint(Waypoint(route.front().time - MilliSeconds(1), m_lastPosition));
+    }
+    for (const auto& waypoint : route)
+    {
+        m_mobility->AddWaypoint(waypoint);
+    }
+    Pass pass;
+    pass.start = route.front().time;
+    pass.end = route.back().time;
+    m_passes.push_back(pass);
+    m_lastPosition = route.back().position;
+    NS_LOG_INFO("Pass " << m_passes.size() - 1 << " from " << pass.start.As(Time::S) << " to "
+                        << pass.end.As(Time::S));
+}
+
+void
+RitDriveByCollector::ReadCsv(const std::string& path)
+{
+    std::ifstream in(path);
+    NS_ABORT_MSG_IF(!in, "Cannot read drive-by trace " << path);
+
+    std::vector<Waypoint> route;
+    double routeId = 0;
+    std::string line;
+    uint32_t lineNumber = 0;
+    bool first = true;
+    while (std::getline(in, line))
+    {
+        lineNumber++;
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+        std::vector<std::string> f;
+        std::stringstream ss(line);
+        std::string field;
+        while (std::getline(ss, field, ','))
+        {
+            f.push_back(field);
+        }
+
+        double v[5];
+        bool numeric = f.size() == 5;
+        for (std::size_t i = 0; numeric && i < 5; i++)
+        {
+            numeric = ParseNumber(f[i], v[i]);
+        }
+        if (first && !numeric)
+        {
+            // column names
+            first = false;
+            continue;
+        }
+        first = false;
+        NS_ABORT_MSG_IF(!numeric, path << ":" << lineNumber << ": malformed record");
+        if (!route.empty() && v[0] != routeId)
+        {
+            AddRoute(route);
+            route.clear();
+        }
+        routeId = v[0];
+        route.emplace_back(Seconds(v[1]), Vector(v[2], v[3], v[4]));
+    }
+    if (!route.empty())
+    {
+        AddRoute(route);
+    }
+}
+
+void
+RitDriveByCollector::Start()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(m_passes.empty(), "No pass for the drive-by collector");
+    m_meterAddresses.clear();
+    for (const auto& meter : m_meters)
+    {
+        m_meterAddresses.insert(meter->GetMac()->GetShortAddress());
+    }
+    Ptr<RitDriveByCollector> self(this);
+    m_collector->GetMac()->TraceConnectWithoutContext("MacRx",
+                                                      MakeBoundCallback(&MacRxSink, self));
+    const Time first = std::max(m_passes.front().start, Simulator::Now());
+    m_sampleEvent =
+        Simulator::Schedule(first - Simulator::Now(), &RitDriveByCollector::Sample, self);
+}
+
+uint32_t
+RitDriveByCollector::GetCurrentPass() const
+{
+    const Time now = Simulator::Now();
+    for (uint32_t i = 0; i < m_passes.size(); i++)
+    {
+        if (now >= m_passes[i].start && now < m_passes[i].end)
+        {
+            return i;
+        }
+    }
+    return m_passes.size();
+}
+
+void
+RitDriveByCollector::Sample()
+{
+    const uint32_t current = GetCurrentPass();
+    m_inContact = false;
+    if (current < m_passes.size())
+    {
+        const Vector position = m_mobility->GetPosition();
+        for (const auto& meter : m_meters)
+        {
+            Ptr<MobilityModel> mobility = meter->GetPhy()->GetMobility();
+            if (mobility && CalculateDistance(position, mobility->GetPosition()) <= m_contactRange)
+            {
+                m_inContact = true;
+                break;
+            }
+        }
+        if (m_inContact)
+        {
+            m_passes[current].contactTime += m_sampleInterval;
+        }
+        m_sampleEvent = Simulator::Schedule(m_sampleInterval,
+                                            &RitDriveByCollector::Sample,
+                                            Ptr<RitDriveByCollector>(this));
+        return;
+    }
+    // between two passes: wait for the next one
+    const Time now = Simulator::Now();
+    for (const auto& pass : m_passes)
+    {
+        if (pass.start > now)
+        {
+            m_sampleEvent = Simulator::Schedule(pass.start - now,
+                                                &RitDriveByCollector::Sample,
+                                                Ptr<RitDriveByCollector>(this));
+            return;
+        }
+    }
+}
+
+void
+RitDriveByCollector::MacRxSink(Ptr<RitDriveByCollector> self, Ptr<const Packet> p)
+{
+    LrWpanMacHeader hdr;
+    if (RitFrameCodec::PeekMacHeader(p, hdr) == 0 || !hdr.IsData() ||
+        hdr.GetSrcAddrMode() != SHORT_ADDR ||
+        !self->m_meterAddresses.count(hdr.GetShortSrcAddr()))
+    {
+        return;
+    }
+    const uint32_t current = self->GetCurrentPass();
+    if (current == self->m_passes.size())
+    {
+        return;
+    }
+    Pass& pass = self->m_passes[current];
+    pass.nFrames++;
+    pass.nBytes += p->GetSize();
+    pass.meters.insert(hdr.GetShortSrcAddr());
+    if (self->m_inContact)
+    {
+        pass.contactAirtime += BYTE_AIRTIME * (p->GetSize() + PPDU_OVERHEAD);
+    }
+}
+
+uint32_t
+RitDriveByCollector::GetNPasses() const
+{
+    return m_passes.size();
+}
+
+const RitDriveByCollector::Pass&
+RitDriveByCollector::GetPass(uint32_t pass) const
+{
+    NS_ABORT_MSG_IF(pass >= m_passes.size(), "No pass " << pass);
+    return m_passes[pass];
+}
+
+double
+RitDriveByCollector::GetContactUtilisation(uint32_t pass) const
+{
+    const Pass& p = GetPass(pass);
+    if (!p.contactTime.IsStrictlyPositive())
+    {
+        return -1.0;
+    }
+    return p.contactAirtime.GetSeconds() / p.contactTime.GetSeconds();
+}
+
+void
+RitDriveByCollector::Print(std::ostream& os) const
+{
+    for (uint32_t i = 0; i < m_passes.size(); i++)
+    {
+        const Pass& pass = m_passes[i];
+        os << "pass " << i << ": " << pass.start.GetSeconds() << "-" << pass.end.GetSeconds()
+           << " s, " << pass.nFrames << " frames (" << pass.nBytes << " B) from "
+           << pass.meters.size() << " meters, contact " << pass.contactTime.GetSeconds()
+           << " s, utilisation " << GetContactUtilisation(i) << std::endl;
+    }
+}
+
+void
+RitDriveByCollector::Report(Ptr<RitMetricsCollector> collector) const
+{
+    uint64_t nFrames = 0;
+    uint64_t nMeters = 0;
+    Time contactTime;
+    Time contactAirtime;
+    for (const auto& pass : m_passes)
+    {
+        nFrames += pass.nFrames;
+        nMeters += pass.meters.size();
+        contactTime += pass.contactTime;
+        contactAirtime += pass.contactAirtime;
+    }
+    const double nPasses = m_passes.size();
+    collector->SetScenarioValue("drive_by_passes", nPasses);
+    collector->SetScenarioValue("drive_by_frames_per_pass", nPasses ? nFrames / nPasses : 0.0);
+    collector->SetScenarioValue("drive_by_meters_per_pass", nPasses ? nMeters / nPasses : 0.0);
+    collector->SetScenarioValue("drive_by_contact_time",
+                                nPasses ? contactTime.GetSeconds() / nPasses : 0.0);
+    collector->SetScenarioValue("drive_by_contact_utilisation",
+                                contactTime.IsStrictlyPositive()
+                                    ? contactAirtime.GetSeconds() / contactTime.GetSeconds()
+                                    : -1.0);
+}
+
+} // namespace lrwpan
+} // namespace ns3
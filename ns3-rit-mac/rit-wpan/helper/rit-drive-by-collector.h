@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef RIT_DRIVE_BY_COLLECTOR_H
+#define RIT_DRIVE_BY_COLLECTOR_H
+
+#include "ns3/event-id.h"
+#include "ns3/mac16-address.h"
+#include "ns3/nstime.h"
+#include "ns3/packet.h"
+#include "ns3/ptr.h"
+#include "ns3/rit-metrics-collector.h"
+#include "ns3/rit-wpan-net-device.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/vector.h"
+#include "ns3/waypoint-mobility-model.h"
+
+#include <cstdint>
+#include <ostream>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @ingroup lrwpan
+ *
+ * @brief Drives a mobile RIT collector past fixed meters and accounts the data it
+ *        collects on each pass.
+ *
+ * The collector is a RitWpanNetDevice whose PHY uses a WaypointMobilityModel; a pass
+ * is a route driven at a constant speed from a start time, given with AddPass() or
+ * read from a CSV trace with ReadCsv(). Between two passes the collector is parked at
+ * the end of the first one. The meters are the devices sending to the collector.
+ *
+ * Per pass, the data frames the collector MAC received from the meters and the
+ * meters heard are counted. Every SampleInterval of a pass, the collector is in
+ * contact when a meter lies within ContactRange: the contact time sums those samples,
+ * and the contact-time utilisation is the airtime of the data frames received in
+ * contact over the contact time.
+ *
+ * On a LrWpanSpectrumChannel, set MobilityUpdateInterval (and NeighbourGridCellSize)
+ * so that the receiver lists follow the collector between its waypoints.
+ */
+class RitDriveByCollector : public SimpleRefCount<RitDriveByCollector>
+{
+  public:
+    /**
+     * @brief What the collector got on one pass.
+     */
+    struct Pass
+    {
+        Time start;                    //!< First waypoint
+        Time end;                      //!< Last waypoint
+        uint64_t nFrames = 0;          //!< Data frames received from the meters
+        uint64_t nBytes = 0;           //!< Their PSDU bytes
+        std::set<Mac16Address> meters; //!< Meters heard
+        Time contactTime;              //!< Sampled time with a meter in range
+        Time contactAirtime;           //!< Airtime of the data frames received in contact
+    };
+
+    /**
+     * @param collector The mobile collector
+     * @param meters The devices sending to it
+     */
+    RitDriveByCollector(Ptr<RitWpanNetDevice> collector,
+                        const std::vector<Ptr<RitWpanNetDevice>>& meters);
+
+    /**
+     * @param range Distance within which a meter is in contact (default 100 m)
+     */
+    void SetContactRange(double range);
+
+    /**
+     * @param interval Time between two contact samples (default 100 ms)
+     */
+    void SetSampleInterval(Time interval);
+
+    /**
+     * @brief Add a pass after the last one.
+     * @param start Time the collector leaves the first waypoint
+     * @param route Waypoints, at least two
+     * @param speed Speed between them [m/s]
+     */
+    void AddPass(Time start, const std::vector<Vector>& route, double speed);
+
+    /**
+     * @brief Add the passes of a CSV trace of "pass,time,x,y,z" records (time in
+     *        seconds, increasing); a header line and '#' comments are skipped.
+     * @param path File path
+     */
+    void ReadCsv(const std::string& path);
+
+    /**
+     * @brief Connect to the collector MAC and schedule the contact samples.
+     */
+    void Start();
+
+    /** @brief Get the number of passes. */
+    uint32_t GetNPasses() const;
+
+    /**
+     * @param pass Pass index
+     * @return what the collector got on the pass
+     */
+    const Pass& GetPass(uint32_t pass) const;
+
+    /**
+     * @param pass Pass index
+     * @return the contact-time utilisation of the pass (negative without contact)
+     */
+    double GetContactUtilisation(uint32_t pass) const;
+
+    /**
+     * @brief Print one line per pass.
+     * @param os Output stream
+     */
+    void Print(std::ostream& os) const;
+
+    /**
+     * @brief Write the totals to the scenario summary: drive_by_passes,
+     *        drive_by_frames_per_pass, drive_by_meters_per_pass, drive_by_contact_time
+     *        (mean per pass [s]) and drive_by_contact_utilisation.
+     * @param collector Metrics collector
+     */
+    void Report(Ptr<RitMetricsCollector> collector) const;
+
+  private:
+    /**
+     * @brief Account a frame received by the collector MAC.
+     * @param self The drive-by collector
+     * @param p The frame, MAC header included
+     */
+    static void MacRxSink(Ptr<RitDriveByCollector> self, Ptr<const Packet> p);
+
+    /**
+     * @brief Add the waypoints of a pass, parked at the end of the last pass until then.
+     * @param route Timed waypoints, at least two
+     */
+    void AddRoute(const std::vector<Waypoint>& route);
+
+    /**
+     * @brief Sample the contact of the current pass and schedule the next sample.
+     */
+    void Sample();
+
+    /**
+     * @return the index of the pass under way, GetNPasses() if none
+     */
+    uint32_t GetCurrentPass() const;
+
+    Ptr<RitWpanNetDevice> m_collector;           //!< Mobile collector
+    Ptr<WaypointMobilityModel> m_mobility;       //!< Its mobility
+    std::vector<Ptr<RitWpanNetDevice>> m_meters; //!< Meters
+    std::set<Mac16Address> m_meterAddresses;     //!< Their short addresses
+    std::vector<Pass> m_passes;                  //!< Passes, in time order
+    Vector m_lastPosition;                       //!< Last waypoint added
+    double m_contactRange;                       //!< Contact distance [m]
+    Time m_sampleInterval;                       //!< Contact sample period
+    bool m_inContact;                            //!< A meter was in range at the last sample
+    EventId m_sampleEvent;                       //!< Next contact sample
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // RIT_DRIVE_BY_COLLECTOR_H
@@ -0,0 +1,1329 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-log-summarizer.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_LOG_COMPONENT_DEFINE("RitLogSummarizer");
+
+namespace
+{
+
+/// Summaries of a run, as the notebook checks them
+const char* const SUMMARY_FILES[] = {"app_summary.csv",
+                                     "mac_summary.csv",
+                                     "phy_summary.csv",
+                                     "scenario_summary.csv"};
+
+/// Columns of phy-dutycycle.csv after the time (DUTY_CYCLE_STATES of summary_utils.py)
+const char* const DUTY_CYCLE_STATES[] = {"TRX_OFF", "RX_ON", "BUSY_RX", "TX_ON", "BUSY_TX"};
+
+/// Powers of ten exactly representable as a double
+const double EXACT_POW10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                              1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                              1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+/// Most fields of a log row (phy-dutycycle.csv)
+constexpr size_t MAX_FIELDS = 6;
+
+/**
+ * A read-only log file, memory-mapped, or read in when the mapping fails.
+ */
+class MappedLog
+{
+  public:
+    MappedLog() = default;
+
+    ~MappedLog()
+    {
+        if (m_map)
+        {
+            munmap(m_map, m_size);
+        }
+    }
+
+    MappedLog(const MappedLog&) = delete;
+    MappedLog& operator=(const MappedLog&) = delete;
+
+    /**
+     * @param path The file
+     * @return false if the file cannot be opened
+     */
+    bool Open(const std::string& path)
+    {
+        const int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+        {
+            close(fd);
+            return false;
+        }
+        m_size = static_cast<size_t>(st.st_size);
+        if (m_size == 0)
+        {
+            close(fd);
+            return true;
+        }
+        void* map = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED)
+        {
+            m_map = map;
+            madvise(m_map, m_size, MADV_SEQUENTIAL);
+            close(fd);
+            return true;
+        }
+        m_copy.resize(m_size);
+        size_t done = 0;
+        while (done < m_size)
+        {
+            const ssize_t n = read(fd, &m_copy[done], m_size - done);
+            if (n <= 0)
+            {
+                break;
+            }
+            done += static_cast<size_t>(n);
+        }
+        m_copy.resize(done);
+        m_size = done;
+        close(fd);
+        return true;
+    }
+
+    const char* Begin() const
+    {
+        return m_map ? static_cast<const char*>(m_map) : m_copy.data();
+    }
+
+    const char* End() const
+    {
+        return Begin() + m_size;
+    }
+
+    size_t GetSize() const
+    {
+        return m_size;
+    }
+
+  private:
+    void* m_map = nullptr; //!< Mapping, null when read in or empty
+    size_t m_size = 0;     //!< Bytes of the file
+    std::string m_copy;    //!< Contents when the mapping failed
+};
+
+/**
+ * The fields of a log row; the missing trailing fields are empty, as the NaN of pandas.
+ */
+struct Row
+{
+    std::string_view fields[MAX_FIELDS]; //!< Fields
+    size_t nFields = 0;                  //!< Fields present
+
+    std::string_view Get(size_t i) const
+    {
+        return i < nFields ? fields[i] : std::string_view();
+    }
+
+    bool GetDouble(size_t i, double& value) const
+    {
+        const std::string_view f = Get(i);
+        return RitLogSummarizer::ParseDouble(f.data(), f.data() + f.size(), value);
+    }
+};
+
+/**
+ * Call f on each row of a log without a header, as read_csv(header=None, names=...,
+ * on_bad_lines='skip'): the blank lines and the rows with more than nColumns fields
+ * are skipped.
+ *
+ * @param log The log
+ * @param nColumns The columns of the log
+ * @param f The function, called with a const Row&
+ */
+template <typename F>
+void
+ForEachRow(const MappedLog& log, size_t nColumns, F&& f)
+{
+    const char* p = log.Begin();
+    const char* const end = log.End();
+    Row row;
+    while (p < end)
+    {
+        const char* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        if (!eol)
+        {
+            eol = end;
+        }
+        const char* lineEnd = eol;
+        if (lineEnd > p && lineEnd[-1] == '\r')
+        {
+            lineEnd--;
+        }
+        if (lineEnd > p)
+        {
+            row.nFields = 0;
+            bool tooMany = false;
+            const char* s = p;
+            while (true)
+            {
+                const char* comma =
+                    static_cast<const char*>(std::memchr(s, ',', lineEnd - s));
+                const char* fieldEnd = comma ? comma : lineEnd;
+                if (row.nFields == nColumns)
+                {
+                    tooMany = true;
+                    break;
+                }
+                row.fields[row.nFields++] = std::string_view(s, fieldEnd - s);
+                if (!comma)
+                {
+                    break;
+                }
+                s = comma + 1;
+            }
+            if (!tooMany)
+            {
+                f(row);
+            }
+        }
+        p = eol + 1;
+    }
+}
+
+/**
+ * Time spent in each state of a state log (time,state), in the order the states are
+ * first left, as ratios of the time between the first and the last row.
+ */
+class StateRatioAccumulator
+{
+  public:
+    void Add(std::string_view state, double time)
+    {
+        if (m_nRows == 0)
+        {
+            m_first = time;
+        }
+        else
+        {
+            auto it = m_index.find(m_previousState);
+            if (it == m_index.end())
+            {
+                it = m_index.emplace(m_previousState, m_times.size()).first;
+                m_times.emplace_back(m_previousState, 0.0);
+            }
+            m_times[it->second].second = m_times[it->second].second + (time - m_previous);
+        }
+        m_previousState.assign(state.data(), state.size());
+        m_previous = time;
+        m_nRows++;
+    }
+
+    std::vector<std::pair<std::string, double>> GetRatios() const
+    {
+        const double total = m_nRows > 1 ? m_previous - m_first : 0.0;
+        std::vector<std::pair<std::string, double>> ratios;
+        ratios.reserve(m_times.size());
+        for (const auto& [state, time] : m_times)
+        {
+            ratios.emplace_back(state + "_ratio", total > 0 ? time / total : NAN);
+        }
+        return ratios;
+    }
+
+  private:
+    std::vector<std::pair<std::string, double>> m_times; //!< Time per state
+    std::unordered_map<std::string, size_t> m_index;      //!< State to m_times index
+    std::string m_previousState;                          //!< State of the previous row
+    double m_first = 0.0;                                 //!< Time of the first row
+    double m_previous = 0.0;                              //!< Time of the previous row
+    uint64_t m_nRows = 0;                                 //!< Rows added
+};
+
+/**
+ * Mean start to end time of a wait log (avg_wait of summary_utils.py).
+ *
+ * @param log The log (time,event)
+ * @param nTimeouts The timeout rows
+ * @return the mean wait [ms], NaN without a complete wait
+ */
+double
+AverageWaitMs(const MappedLog& log, uint64_t& nTimeouts)
+{
+    double sum = 0.0;
+    uint64_t nWaits = 0;
+    bool waiting = false;
+    double start = 0.0;
+    nTimeouts = 0;
+    ForEachRow(log, 2, [&](const Row& row) {
+        const std::string_view event = row.Get(1);
+        double time = NAN;
+        row.GetDouble(0, time);
+        if (event == "start")
+        {
+            waiting = true;
+            start = time;
+        }
+        else if (event == "end" && waiting)
+        {
+            sum += time - start;
+            nWaits++;
+            waiting = false;
+        }
+        else if (event == "timeout")
+        {
+            waiting = false;
+            nTimeouts++;
+        }
+    });
+    return nWaits > 0 ? sum / nWaits * 1000 : NAN;
+}
+
+/**
+ * Sum in the order of numpy.add.reduce, which pandas uses: the first value, then the
+ * others by pairs of 8-way unrolled blocks of at most 128 values.
+ *
+ * @param a The values
+ * @param n The number of values
+ * @return the sum
+ */
+double
+PairwiseSum(const double* a, size_t n)
+{
+    if (n < 8)
+    {
+        double res = 0.0;
+        for (size_t i = 0; i < n; i++)
+        {
+            res += a[i];
+        }
+        return res;
+    }
+    if (n <= 128)
+    {
+        double r[8];
+        for (size_t j = 0; j < 8; j++)
+        {
+            r[j] = a[j];
+        }
+        size_t i;
+        for (i = 8; i < n - (n % 8); i += 8)
+        {
+            for (size_t j = 0; j < 8; j++)
+            {
+                r[j] += a[i + j];
+            }
+        }
+        double res = ((r[0] + r[1]) + (r[2] + r[3])) + ((r[4] + r[5]) + (r[6] + r[7]));
+        for (; i < n; i++)
+        {
+            res += a[i];
+        }
+        return res;
+    }
+    size_t n2 = n / 2;
+    n2 -= n2 % 8;
+    return PairwiseSum(a, n2) + PairwiseSum(a + n2, n - n2);
+}
+
+/**
+ * @param values The values
+ * @return their sum in the order of numpy
+ */
+double
+NumpySum(const std::vector<double>& values)
+{
+    if (values.empty())
+    {
+        return 0.0;
+    }
+    return values[0] + PairwiseSum(values.data() + 1, values.size() - 1);
+}
+
+/**
+ * Series.mean(), min(), max() and std() of pandas (nanops without bottleneck).
+ *
+ * @param values The values, NaN dropped
+ * @return the statistics
+ */
+RitSummaryStatistics
+ComputeStatistics(const std::vector<double>& values)
+{
+    RitSummaryStatistics stats;
+    stats.count = static_cast<uint32_t>(values.size());
+    if (values.empty())
+    {
+        return stats;
+    }
+    const double n = static_cast<double>(values.size());
+    stats.mean = NumpySum(values) / n;
+    stats.min = *std::min_element(values.begin(), values.end());
+    stats.max = *std::max_element(values.begin(), values.end());
+    if (values.size() > 1)
+    {
+        std::vector<double> squares;
+        squares.reserve(values.size());
+        for (double v : values)
+        {
+            squares.push_back((stats.mean - v) * (stats.mean - v));
+        }
+        stats.stddev = std::sqrt(NumpySum(squares) / (n - 1));
+    }
+    return stats;
+}
+
+/**
+ * @param os The output stream
+ * @param value The count, written as a float when the column has a missing value
+ * @param asFloat True if another row of the column has no value
+ */
+void
+WriteCount(std::ostream& os, const std::optional<uint64_t>& value, bool asFloat)
+{
+    if (!value)
+    {
+        return;
+    }
+    if (asFloat)
+    {
+        os << RitLogSummarizer::FormatValue(static_cast<double>(*value));
+    }
+    else
+    {
+        os << *value;
+    }
+}
+
+/**
+ * Union of the state ratio columns of the rows, in the order pandas builds a frame
+ * from a list of dicts: the keys in the order first seen.
+ *
+ * @param rows The rows
+ * @return the columns
+ */
+template <typename T>
+std::vector<std::string>
+RatioColumns(const std::vector<T>& rows)
+{
+    std::vector<std::string> columns;
+    std::set<std::string> seen;
+    for (const T& row : rows)
+    {
+        for (const auto& [column, ratio] : row.stateRatios)
+        {
+            if (seen.insert(column).second)
+            {
+                columns.push_back(column);
+            }
+        }
+    }
+    return columns;
+}
+
+/**
+ * @param os The output stream
+ * @param ratios The ratios of a row
+ * @param columns The ratio columns of the frame
+ */
+void
+WriteRatios(std::ostream& os,
+            const std::vector<std::pair<std::string, double>>& ratios,
+            const std::vector<std::string>& columns)
+{
+    for (const std::string& column : columns)
+    {
+        os << ",";
+        for (const auto& [name, ratio] : ratios)
+        {
+            if (name == column)
+            {
+                os << RitLogSummarizer::FormatValue(ratio);
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @param os The output stream
+ * @param stats The statistics
+ */
+void
+WriteStatistics(std::ostream& os, const RitSummaryStatistics& stats)
+{
+    os << RitLogSummarizer::FormatValue(stats.mean) << ","
+       << RitLogSummarizer::FormatValue(stats.min) << ","
+       << RitLogSummarizer::FormatValue(stats.max) << ","
+       << RitLogSummarizer::FormatValue(stats.stddev) << "," << stats.count;
+}
+
+/**
+ * @param path A summary
+ * @return true if it holds a header and a row, as is_valid_csv() of the notebook
+ */
+bool
+HasSummaryRow(const std::string& path)
+{
+    std::ifstream in(path);
+    std::string line;
+    return std::getline(in, line) && std::getline(in, line);
+}
+
+} // namespace
+
+/**
+ * A run in progress: its nodes, the receptions of its receiver and a slot per node
+ * for the summaries, each filled by the task of its node.
+ */
+struct RitLogSummarizer::RunJob
+{
+    std::string dir;                                   //!< Run directory
+    std::vector<uint32_t> nodes;                       //!< Nodes, ascending
+    std::once_flag receiverOnce;                       //!< Guards the receiver load
+    bool receiverOk = false;                           //!< app-rxlog.csv of the receiver read
+    uint64_t receiverRows = 0;                         //!< Rows of app-rxlog.csv
+    std::unordered_map<uint64_t, double> receiverRx;   //!< UID to first reception time
+    std::vector<std::optional<RitAppNodeSummary>> app; //!< APP row per node
+    std::vector<std::optional<RitMacNodeSummary>> mac; //!< MAC row per node
+    std::vector<std::optional<RitPhyNodeSummary>> phy; //!< PHY row per node
+    std::vector<std::string> warnings;                 //!< Missing logs per node
+    std::atomic<size_t> remaining{0};                  //!< Nodes not summarized yet
+    RitRunSummary summary;                             //!< Summaries once complete
+};
+
+RitLogSummarizer::RitLogSummarizer()
+    : m_nThreads(0),
+      m_receiverNode(0),
+      m_overwrite(false),
+      m_nRunsSkipped(0),
+      m_nBytes(0),
+      m_nNodes(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+RitLogSummarizer::~RitLogSummarizer()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+RitLogSummarizer::SetNThreads(uint32_t nThreads)
+{
+    m_nThreads = nThreads;
+}
+
+uint32_t
+RitLogSummarizer::GetNThreads() const
+{
+    if (m_nThreads > 0)
+    {
+        return m_nThreads;
+    }
+    return std::max(1U, std::thread::hardware_concurrency());
+}
+
+void
+RitLogSummarizer::SetReceiverNode(uint32_t nodeId)
+{
+    m_receiverNode = nodeId;
+}
+
+void
+RitLogSummarizer::SetOverwrite(bool overwrite)
+{
+    m_overwrite = overwrite;
+}
+
+uint64_t
+RitLogSummarizer::GetNBytes() const
+{
+    return m_nBytes.load();
+}
+
+uint64_t
+RitLogSummarizer::GetNNodes() const
+{
+    return m_nNodes.load();
+}
+
+uint32_t
+RitLogSummarizer::GetNRunsSkipped() const
+{
+    return m_nRunsSkipped;
+}
+
+std::vector<std::string>
+RitLogSummarizer::FindRuns(const std::string& root)
+{
+    namespace fs = std::filesystem;
+    std::set<std::string> runs;
+    std::error_code ec;
+    auto isNodeDir = [](const fs::directory_entry& entry) {
+        const std::string name = entry.path().filename().string();
+        uint64_t id;
+        std::error_code dirEc;
+        return name.compare(0, 5, "node-") == 0 &&
+               ParseUnsigned(name.data() + 5, name.data() + name.size(), id) &&
+               entry.is_directory(dirEc);
+    };
+    for (auto it = fs::recursive_directory_iterator(root, ec);
+         it != fs::recursive_directory_iterator();
+         it.increment(ec))
+    {
+        if (ec)
+        {
+            break;
+        }
+        if (isNodeDir(*it))
+        {
+            runs.insert(it->path().parent_path().lexically_normal().string());
+            // The node directories hold the logs, not runs
+            it.disable_recursion_pending();
+        }
+    }
+    return std::vector<std::string>(runs.begin(), runs.end());
+}
+
+RitRunSummary
+RitLogSummarizer::SummarizeRun(const std::string& runDir)
+{
+    NS_LOG_FUNCTION(this << runDir);
+    std::vector<std::unique_ptr<RunJob>> jobs;
+    jobs.push_back(std::make_unique<RunJob>());
+    jobs.back()->dir = runDir;
+    Run(jobs, false);
+    return std::move(jobs.back()->summary);
+}
+
+uint32_t
+RitLogSummarizer::SummarizeTree(const std::string& root)
+{
+    NS_LOG_FUNCTION(this << root);
+    std::vector<std::unique_ptr<RunJob>> jobs;
+    for (const std::string& run : FindRuns(root))
+    {
+        bool complete = !m_overwrite;
+        for (const char* file : SUMMARY_FILES)
+        {
+            complete = complete && HasSummaryRow(run + "/summary/" + file);
+        }
+        if (complete)
+        {
+            NS_LOG_INFO("Summaries of " << run << " exist, skipped");
+            m_nRunsSkipped++;
+            continue;
+        }
+        jobs.push_back(std::make_unique<RunJob>());
+        jobs.back()->dir = run;
+    }
+    Run(jobs, true);
+    return jobs.size();
+}
+
+void
+RitLogSummarizer::Run(std::vector<std::unique_ptr<RunJob>>& jobs, bool write)
+{
+    namespace fs = std::filesystem;
+    // The (run, node) tasks, run by run so that few receiver logs are held at once
+    std::vector<std::pair<size_t, size_t>> tasks;
+    for (size_t j = 0; j < jobs.size(); j++)
+    {
+        RunJob& job = *jobs[j];
+        std::error_code ec;
+        for (const fs::directory_entry& entry : fs::directory_iterator(job.dir, ec))
+        {
+            const std::string name = entry.path().filename().string();
+            uint64_t id;
+            std::error_code dirEc;
+            if (name.compare(0, 5, "node-") == 0 &&
+                ParseUnsigned(name.data() + 5, name.data() + name.size(), id) &&
+                entry.is_directory(dirEc))
+            {
+                job.nodes.push_back(static_cast<uint32_t>(id));
+            }
+        }
+        std::sort(job.nodes.begin(), job.nodes.end());
+        job.app.resize(job.nodes.size());
+        job.mac.resize(job.nodes.size());
+        job.phy.resize(job.nodes.size());
+        job.warnings.resize(job.nodes.size());
+        job.remaining = job.nodes.size();
+        if (job.nodes.empty())
+        {
+            NS_LOG_WARN("No node directory in " << job.dir);
+            continue;
+        }
+        for (size_t i = 0; i < job.nodes.size(); i++)
+        {
+            tasks.emplace_back(j, i);
+        }
+    }
+
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        while (true)
+        {
+            const size_t t = next.fetch_add(1);
+            if (t >= tasks.size())
+            {
+                return;
+            }
+            RunJob& job = *jobs[tasks[t].first];
+            SummarizeNode(job, tasks[t].second);
+            if (job.remaining.fetch_sub(1) == 1)
+            {
+                CompleteRun(job);
+                if (write)
+                {
+                    WriteRunSummary(job.summary, job.dir);
+                    job.summary = RitRunSummary();
+                }
+            }
+        }
+    };
+    const size_t nThreads = std::min<size_t>(GetNThreads(), tasks.size());
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < nThreads; i++)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    // The log is not thread-safe: the missing logs are reported once the pool is done
+    for (const auto& job : jobs)
+    {
+        for (size_t i = 0; i < job->nodes.size(); i++)
+        {
+            if (!job->warnings[i].empty())
+            {
+                NS_LOG_WARN(job->dir << "/node-" << job->nodes[i] << ":" << job->warnings[i]);
+            }
+        }
+    }
+}
+
+void
+RitLogSummarizer::SummarizeNode(RunJob& job, size_t index)
+{
+    const uint32_t nodeId = job.nodes[index];
+    const std::string nodeDir = job.dir + "/node-" + std::to_string(nodeId) + "/";
+    std::string& warnings = job.warnings[index];
+    uint64_t nBytes = 0;
+
+    std::call_once(job.receiverOnce, [&]() {
+        MappedLog rxLog;
+        const std::string path =
+            job.dir + "/node-" + std::to_string(m_receiverNode) + "/app-rxlog.csv";
+        if (!rxLog.Open(path))
+        {
+            return;
+        }
+        nBytes += rxLog.GetSize();
+        ForEachRow(rxLog, 2, [&](const Row& row) {
+            job.receiverRows++;
+            double time;
+            uint64_t uid;
+            const std::string_view f = row.Get(1);
+            if (row.GetDouble(0, time) && ParseUnsigned(f.data(), f.data() + f.size(), uid))
+            {
+                job.receiverRx.try_emplace(uid, time);
+            }
+        });
+        job.receiverOk = true;
+    });
+
+    // APP: the UIDs sent against the receptions of the receiver
+    MappedLog appTx;
+    if (!job.receiverOk)
+    {
+        warnings += " no app-rxlog.csv at the receiver";
+    }
+    else if (!appTx.Open(nodeDir + "app-txlog.csv"))
+    {
+        warnings += " no app-txlog.csv";
+    }
+    else
+    {
+        nBytes += appTx.GetSize();
+        std::unordered_map<uint64_t, double> firstTx;
+        std::vector<uint64_t> uids;
+        uint64_t nRows = 0;
+        ForEachRow(appTx, 2, [&](const Row& row) {
+            nRows++;
+            double time;
+            uint64_t uid;
+            const std::string_view f = row.Get(1);
+            if (row.GetDouble(0, time) && ParseUnsigned(f.data(), f.data() + f.size(), uid) &&
+                firstTx.try_emplace(uid, time).second)
+            {
+                uids.push_back(uid);
+            }
+        });
+        RitAppNodeSummary app;
+        app.nodeId = nodeId;
+        double delaySum = 0.0;
+        uint64_t nReceived = 0;
+        for (uint64_t uid : uids)
+        {
+            auto it = job.receiverRx.find(uid);
+            if (it != job.receiverRx.end())
+            {
+                delaySum += it->second - firstTx[uid];
+                nReceived++;
+            }
+        }
+        if (!uids.empty())
+        {
+            app.pdr = static_cast<double>(nReceived) / uids.size();
+        }
+        if (nReceived > 0)
+        {
+            app.avgDelay = delaySum / nReceived;
+        }
+        app.txTotal = nodeId != m_receiverNode ? nRows : 0;
+        app.rxTotal = nodeId == m_receiverNode ? job.receiverRows : 0;
+        job.app[index] = app;
+    }
+
+    // MAC: frame counts, waits and state ratios
+    MappedLog macTx;
+    MappedLog macRx;
+    MappedLog beaconWait;
+    MappedLog dataWait;
+    MappedLog macState;
+    if (!macTx.Open(nodeDir + "mac-txlog.csv") || !macRx.Open(nodeDir + "mac-rxlog.csv") ||
+        !beaconWait.Open(nodeDir + "mac-beacon-wait.csv") ||
+        !dataWait.Open(nodeDir + "mac-data-wait.csv") ||
+        !macState.Open(nodeDir + "mac-statelog.csv"))
+    {
+        warnings += " MAC logs missing";
+    }
+    else
+    {
+        nBytes += macTx.GetSize() + macRx.GetSize() + beaconWait.GetSize() +
+                  dataWait.GetSize() + macState.GetSize();
+        RitMacNodeSummary mac;
+        mac.nodeId = nodeId;
+        ForEachRow(macTx, 5, [&mac](const Row& row) {
+            const std::string_view type = row.Get(1);
+            const std::string_view subtype = row.Get(2);
+            const bool data = subtype == "Data";
+            const bool command = subtype == "Command";
+            const bool multipurpose = subtype == "Multipurpose";
+            if (data || command || multipurpose)
+            {
+                mac.txOk += type == "TxOk";
+                mac.txDrop += type == "TxDrop";
+            }
+            mac.txData += data && type == "Tx";
+            mac.txCommand += command;
+            mac.txMultipurpose += multipurpose;
+            mac.txAck += subtype == "Ack";
+            mac.txDataDrop += data && type == "TxDrop";
+            mac.txCommandDrop += command && type == "TxDrop";
+        });
+        ForEachRow(macRx, 5, [&mac](const Row& row) {
+            const std::string_view status = row.Get(1);
+            const std::string_view subtype = row.Get(2);
+            const bool ok = status == "RxOk";
+            mac.rxOk += ok;
+            mac.rxDrop += status == "timeout";
+            mac.rxData += ok && subtype == "Data";
+            mac.rxCommand += ok && subtype == "Command";
+            mac.rxMultipurpose += ok && subtype == "Multipurpose";
+            mac.rxAck += ok && subtype == "Ack";
+        });
+        mac.avgDataWaitTimeMs = AverageWaitMs(dataWait, mac.rxTimeouts);
+        mac.avgBeaconWaitTimeTxMs = AverageWaitMs(beaconWait, mac.txTimeouts);
+        StateRatioAccumulator states;
+        ForEachRow(macState, 2, [&states](const Row& row) {
+            double time;
+            if (row.GetDouble(0, time))
+            {
+                states.Add(row.Get(1), time);
+            }
+        });
+        mac.stateRatios = states.GetRatios();
+        job.mac[index] = std::move(mac);
+    }
+
+    // PHY: frame counts, and the duty cycle counters or else the state log
+    MappedLog phyTx;
+    MappedLog phyRx;
+    MappedLog phyState;
+    MappedLog dutyCycle;
+    const bool hasDutyCycle = dutyCycle.Open(nodeDir + "phy-dutycycle.csv");
+    if (!phyTx.Open(nodeDir + "phy-txlog.csv") || !phyRx.Open(nodeDir + "phy-rxlog.csv") ||
+        (!hasDutyCycle && !phyState.Open(nodeDir + "phy-statelog.csv")))
+    {
+        warnings += " PHY logs missing";
+    }
+    else
+    {
+        nBytes += phyTx.GetSize() + phyRx.GetSize() + phyState.GetSize() + dutyCycle.GetSize();
+        RitPhyNodeSummary phy;
+        phy.nodeId = nodeId;
+        uint64_t nTxRows = 0;
+        uint64_t nTx = 0;
+        uint64_t nTxDrop = 0;
+        ForEachRow(phyTx, 3, [&](const Row& row) {
+            nTxRows++;
+            nTx += row.Get(1) == "TxEnd";
+            nTxDrop += row.Get(1) == "TxDrop";
+        });
+        if (nTxRows > 0)
+        {
+            phy.tx = nTx;
+            phy.txDrop = nTxDrop;
+        }
+        uint64_t nRxRows = 0;
+        uint64_t nRx = 0;
+        uint64_t nRxDrop = 0;
+        ForEachRow(phyRx, 4, [&](const Row& row) {
+            nRxRows++;
+            nRx += row.Get(1) == "RxEnd";
+            nRxDrop += row.Get(1) == "RxDrop";
+        });
+        if (nRxRows > 0)
+        {
+            phy.rx = nRx;
+            phy.rxDrop = nRxDrop;
+        }
+        if (hasDutyCycle)
+        {
+            // Cumulative counters: the last row covers the whole run
+            double last[5] = {NAN, NAN, NAN, NAN, NAN};
+            bool any = false;
+            ForEachRow(dutyCycle, 6, [&](const Row& row) {
+                any = true;
+                for (size_t s = 0; s < 5; s++)
+                {
+                    last[s] = NAN;
+                    row.GetDouble(s + 1, last[s]);
+                }
+            });
+            if (any)
+            {
+                double total = 0.0;
+                for (double t : last)
+                {
+                    total += t;
+                }
+                for (size_t s = 0; s < 5; s++)
+                {
+                    phy.stateRatios.emplace_back(std::string(DUTY_CYCLE_STATES[s]) + "_ratio",
+                                                 total > 0 ? last[s] / total : NAN);
+                }
+            }
+        }
+        else
+        {
+            StateRatioAccumulator states;
+            ForEachRow(phyState, 2, [&states](const Row& row) {
+                double time;
+                if (row.GetDouble(0, time))
+                {
+                    states.Add(row.Get(1), time);
+                }
+            });
+            phy.stateRatios = states.GetRatios();
+        }
+        job.phy[index] = std::move(phy);
+    }
+
+    m_nBytes += nBytes;
+    m_nNodes++;
+}
+
+void
+RitLogSummarizer::CompleteRun(RunJob& job) const
+{
+    RitRunSummary& summary = job.summary;
+    // The senders, then the receiver (aggregate_app_summary)
+    std::optional<RitAppNodeSummary> receiver;
+    for (size_t i = 0; i < job.nodes.size(); i++)
+    {
+        if (job.nodes[i] == m_receiverNode)
+        {
+            receiver = job.app[i];
+        }
+        else if (job.app[i])
+        {
+            summary.app.push_back(*job.app[i]);
+        }
+        if (job.mac[i])
+        {
+            summary.mac.push_back(std::move(*job.mac[i]));
+        }
+        if (job.phy[i])
+        {
+            summary.phy.push_back(std::move(*job.phy[i]));
+        }
+    }
+    if (receiver)
+    {
+        summary.app.push_back(*receiver);
+    }
+    summary.scenario = SummarizeScenario(summary.app, summary.phy);
+
+    job.receiverRx = std::unordered_map<uint64_t, double>();
+    job.app = decltype(job.app)();
+    job.mac = decltype(job.mac)();
+    job.phy = decltype(job.phy)();
+}
+
+RitScenarioSummary
+RitLogSummarizer::SummarizeScenario(const std::vector<RitAppNodeSummary>& app,
+                                    const std::vector<RitPhyNodeSummary>& phy)
+{
+    std::vector<double> pdr;
+    std::vector<double> delay;
+    for (const RitAppNodeSummary& row : app)
+    {
+        if (row.txTotal == 0)
+        {
+            continue;
+        }
+        if (!std::isnan(row.pdr))
+        {
+            pdr.push_back(row.pdr);
+        }
+        if (!std::isnan(row.avgDelay))
+        {
+            delay.push_back(row.avgDelay);
+        }
+    }
+    std::vector<double> wake;
+    for (const RitPhyNodeSummary& row : phy)
+    {
+        for (const auto& [column, ratio] : row.stateRatios)
+        {
+            if (column == "TRX_OFF_ratio" && !std::isnan(ratio))
+            {
+                wake.push_back(1 - ratio);
+            }
+        }
+    }
+    RitScenarioSummary scenario;
+    scenario.pdr = ComputeStatistics(pdr);
+    scenario.delay = ComputeStatistics(delay);
+    scenario.wakeRatio = ComputeStatistics(wake);
+    return scenario;
+}
+
+void
+RitLogSummarizer::WriteRunSummary(const RitRunSummary& summary, const std::string& runDir)
+{
+    const std::string dir = runDir + "/summary/";
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+    NS_ABORT_MSG_IF(ec, "Unable to create " << dir << ": " << ec.message());
+    void (*writers[])(const RitRunSummary&, std::ostream&) = {&WriteAppSummary,
+                                                              &WriteMacSummary,
+                                                              &WritePhySummary,
+                                                              &WriteScenarioSummary};
+    for (size_t i = 0; i < 4; i++)
+    {
+        std::ofstream os(dir + SUMMARY_FILES[i]);
+        NS_ABORT_MSG_UNLESS(os.is_open(), "Unable to open " << dir << SUMMARY_FILES[i]);
+        writers[i](summary, os);
+    }
+}
+
+void
+RitLogSummarizer::WriteAppSummary(const RitRunSummary& summary, std::ostream& os)
+{
+    os << "pdr,avg_delay,tx_total,rx_total\n";
+    for (const RitAppNodeSummary& row : summary.app)
+    {
+        os << FormatValue(row.pdr) << "," << FormatValue(row.avgDelay) << "," << row.txTotal
+           << "," << row.rxTotal << "\n";
+    }
+}
+
+void
+RitLogSummarizer::WriteMacSummary(const RitRunSummary& summary, std::ostream& os)
+{
+    const std::vector<std::string> ratios = RatioColumns(summary.mac);
+    os << "txOk,txDrop,txData,txCommand,txMultipurpose,txAck,txDataDrop,txCommandDrop,"
+          "rxOk,rxDrop,rxData,rxCommand,rxMultipurpose,rxAck,rxTimeouts,txTimeouts,"
+          "avgDataWaitTimeMs,avgBeaconWaitTimeTxMs";
+    for (const std::string& column : ratios)
+    {
+        os << "," << column;
+    }
+    os << "\n";
+    for (const RitMacNodeSummary& row : summary.mac)
+    {
+        os << row.txOk << "," << row.txDrop << "," << row.txData << "," << row.txCommand << ","
+           << row.txMultipurpose << "," << row.txAck << "," << row.txDataDrop << ","
+           << row.txCommandDrop << "," << row.rxOk << "," << row.rxDrop << "," << row.rxData
+           << "," << row.rxCommand << "," << row.rxMultipurpose << "," << row.rxAck << ","
+           << row.rxTimeouts << "," << row.txTimeouts << ","
+           << FormatValue(row.avgDataWaitTimeMs) << "," << FormatValue(row.avgBeaconWaitTimeTxMs);
+        WriteRatios(os, row.stateRatios, ratios);
+        os << "\n";
+    }
+}
+
+void
+RitLogSummarizer::WritePhySummary(const RitRunSummary& summary, std::ostream& os)
+{
+    const std::vector<std::string> ratios = RatioColumns(summary.phy);
+    // pandas turns an integer column with a missing value into a float column
+    bool txFloat = false;
+    bool rxFloat = false;
+    for (const RitPhyNodeSummary& row : summary.phy)
+    {
+        txFloat = txFloat || !row.tx;
+        rxFloat = rxFloat || !row.rx;
+    }
+    os << "tx,rx,txDrop,rxDrop";
+    for (const std::string& column : ratios)
+    {
+        os << "," << column;
+    }
+    os << "\n";
+    for (const RitPhyNodeSummary& row : summary.phy)
+    {
+        WriteCount(os, row.tx, txFloat);
+        os << ",";
+        WriteCount(os, row.rx, rxFloat);
+        os << ",";
+        WriteCount(os, row.txDrop, txFloat);
+        os << ",";
+        WriteCount(os, row.rxDrop, rxFloat);
+        WriteRatios(os, row.stateRatios, ratios);
+        os << "\n";
+    }
+}
+
+void
+RitLogSummarizer::WriteScenarioSummary(const RitRunSummary& summary, std::ostream& os)
+{
+    os << "pdr_mean,pdr_min,pdr_max,pdr_std,pdr_node_count,"
+          "delay_mean,delay_min,delay_max,delay_std,delay_node_count,"
+          "wake_ratio_mean,wake_ratio_min,wake_ratio_max,wake_ratio_std,wake_node_count\n";
+    WriteStatistics(os, summary.scenario.pdr);
+    os << ",";
+    WriteStatistics(os, summary.scenario.delay);
+    os << ",";
+    WriteStatistics(os, summary.scenario.wakeRatio);
+    os << "\n";
+}
+
+bool
+RitLogSummarizer::ParseDouble(const char* begin, const char* end, double& value)
+{
+    const char* p = begin;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+'))
+    {
+        negative = *p == '-';
+        p++;
+    }
+    uint64_t mantissa = 0;
+    int32_t exponent = 0;
+    uint32_t nSignificant = 0;
+    bool exact = true;
+    bool anyDigit = false;
+    auto digit = [&](char c, bool fraction) {
+        const uint32_t d = c - '0';
+        anyDigit = true;
+        if (mantissa == 0 && d == 0)
+        {
+            exponent -= fraction;
+            return;
+        }
+        if (nSignificant == 19)
+        {
+            // Beyond a uint64_t: left to strtod
+            exact = false;
+            return;
+        }
+        mantissa = mantissa * 10 + d;
+        nSignificant++;
+        exponent -= fraction;
+    };
+    while (p < end && *p >= '0' && *p <= '9')
+    {
+        digit(*p++, false);
+    }
+    if (p < end && *p == '.')
+    {
+        p++;
+        while (p < end && *p >= '0' && *p <= '9')
+        {
+            digit(*p++, true);
+        }
+    }
+    if (anyDigit && p < end && (*p == 'e' || *p == 'E'))
+    {
+        p++;
+        bool negativeExponent = false;
+        if (p < end && (*p == '-' || *p == '+'))
+        {
+            negativeExponent = *p == '-';
+            p++;
+        }
+        if (p == end || *p < '0' || *p > '9')
+        {
+            return false;
+        }
+        int32_t e = 0;
+        while (p < end && *p >= '0' && *p <= '9')
+        {
+            e = std::min(e * 10 + (*p++ - '0'), 100000);
+        }
+        exponent += negativeExponent ? -e : e;
+    }
+    if (anyDigit && p != end)
+    {
+        return false;
+    }
+    if (anyDigit && exact && mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22)
+    {
+        // Exactly rounded: both operands are exact doubles (Clinger's fast path)
+        double v = static_cast<double>(mantissa);
+        v = exponent < 0 ? v / EXACT_POW10[-exponent] : v * EXACT_POW10[exponent];
+        value = negative ? -v : v;
+        return true;
+    }
+    // Long mantissas, large exponents, inf and nan
+    if (begin == end || end - begin > 63)
+    {
+        return false;
+    }
+    char buffer[64];
+    std::memcpy(buffer, begin, end - begin);
+    buffer[end - begin] = '\0';
+    char* parsed = nullptr;
+    const double v = std::strtod(buffer, &parsed);
+    if (parsed != buffer + (end - begin))
+    {
+        return false;
+    }
+    value = v;
+    return true;
+}
+
+bool
+RitLogSummarizer::ParseUnsigned(const char* begin, const char* end, uint64_t& value)
+{
+    if (begin == end)
+    {
+        return false;
+    }
+    uint64_t v = 0;
+    for (const char* p = begin; p < end; p++)
+    {
+        if (*p < '0' || *p > '9')
+        {
+            return false;
+        }
+        const uint64_t d = *p - '0';
+        if (v > (UINT64_MAX - d) / 10)
+        {
+            return false;
+        }
+        v = v * 10 + d;
+    }
+    value = v;
+    return true;
+}
+
+std::string
+RitLogSummarizer::FormatValue(double value)
+{
+    if (std::isnan(value))
+    {
+        return "";
+    }
+    if (std::isinf(value))
+    {
+        return value < 0 ? "-inf" : "inf";
+    }
+    // The shortest digits that read back as the value, as Python repr()
+    char buffer[32];
+    for (int precision = 0; precision < 17; precision++)
+    {
+        std::snprintf(buffer, sizeof(buffer), "%.*e", precision, value);
+        if (std::strtod(buffer, nullptr) == value)
+        {
+            break;
+        }
+    }
+    const char* e = std::strchr(buffer, 'e');
+    std::string digits;
+    for (const char* p = buffer; p < e; p++)
+    {
+        if (*p >= '0' && *p <= '9')
+        {
+            digits.push_back(*p);
+        }
+    }
+    const int exponent = std::atoi(e + 1);
+    std::string text = std::signbit(value) ? "-" : "";
+    if (exponent < -4 || exponent >= 16)
+    {
+        text += digits.substr(0, 1);
+        if (digits.size() > 1)
+        {
+            text += "." + digits.substr(1);
+        }
+        char suffix[16];
+        std::snprintf(suffix,
+                      sizeof(suffix),
+                      "e%c%02d",
+                      exponent < 0 ? '-' : '+',
+                      std::abs(exponent));
+        return text + suffix;
+    }
+    if (exponent < 0)
+    {
+        return text + "0." + std::string(-exponent - 1, '0') + digits;
+    }
+    if (digits.size() <= static_cast<size_t>(exponent) + 1)
+    {
+        return text + digits + std::string(exponent + 1 - digits.size(), '0') + ".0";
+    }
+    return text + digits.substr(0, exponent + 1) + "." + digits.substr(exponent + 1);
+}
+
+} // namespace lrwpan
+} // namespace ns3
@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef NS3_RIT_LOG_SUMMARIZER_H
+#define NS3_RIT_LOG_SUMMARIZER_H
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * APP summary of a node (summarize_app_node of analysis/common/summary_utils.py).
+ */
+struct RitAppNodeSummary
+{
+    uint32_t nodeId = 0;   //!< Node of the node-N directory
+    double pdr = NAN;      //!< Share of the UIDs sent that were received
+    double avgDelay = NAN; //!< Mean first tx to first rx time of the UIDs received [s]
+    uint64_t txTotal = 0;  //!< Rows of app-txlog.csv, 0 for the receiver
+    uint64_t rxTotal = 0;  //!< Rows of app-rxlog.csv for the receiver, 0 for the others
+};
+
+/**
+ * MAC summary of a node (summarize_mac_node of analysis/common/summary_utils.py).
+ */
+struct RitMacNodeSummary
+{
+    uint32_t nodeId = 0;                //!< Node of the node-N directory
+    uint64_t txOk = 0;                  //!< TxOk of the Data, Command and Multipurpose frames
+    uint64_t txDrop = 0;                //!< TxDrop of the Data, Command and Multipurpose frames
+    uint64_t txData = 0;                //!< Tx of the Data frames
+    uint64_t txCommand = 0;             //!< Rows of the Command frames
+    uint64_t txMultipurpose = 0;        //!< Rows of the Multipurpose frames
+    uint64_t txAck = 0;                 //!< Rows of the Ack frames
+    uint64_t txDataDrop = 0;            //!< TxDrop of the Data frames
+    uint64_t txCommandDrop = 0;         //!< TxDrop of the Command frames
+    uint64_t rxOk = 0;                  //!< RxOk rows of mac-rxlog.csv
+    uint64_t rxDrop = 0;                //!< timeout rows of mac-rxlog.csv
+    uint64_t rxData = 0;                //!< RxOk of the Data frames
+    uint64_t rxCommand = 0;             //!< RxOk of the Command frames
+    uint64_t rxMultipurpose = 0;        //!< RxOk of the Multipurpose frames
+    uint64_t rxAck = 0;                 //!< RxOk of the Ack frames
+    uint64_t rxTimeouts = 0;            //!< timeout rows of mac-data-wait.csv
+    uint64_t txTimeouts = 0;            //!< timeout rows of mac-beacon-wait.csv
+    double avgDataWaitTimeMs = NAN;     //!< Mean start to end data wait [ms]
+    double avgBeaconWaitTimeTxMs = NAN; //!< Mean start to end beacon wait [ms]
+    std::vector<std::pair<std::string, double>> stateRatios; //!< mac-statelog.csv ratios
+};
+
+/**
+ * PHY summary of a node (summarize_phy_node of analysis/common/summary_utils.py).
+ */
+struct RitPhyNodeSummary
+{
+    uint32_t nodeId = 0;            //!< Node of the node-N directory
+    std::optional<uint64_t> tx;     //!< TxEnd rows, none if phy-txlog.csv is empty
+    std::optional<uint64_t> rx;     //!< RxEnd rows, none if phy-rxlog.csv is empty
+    std::optional<uint64_t> txDrop; //!< TxDrop rows, none if phy-txlog.csv is empty
+    std::optional<uint64_t> rxDrop; //!< RxDrop rows, none if phy-rxlog.csv is empty
+    std::vector<std::pair<std::string, double>> stateRatios; //!< Duty cycle or state log ratios
+};
+
+/**
+ * Figures of a set of nodes: mean, min, max, sample standard deviation and count, NaN
+ * when there are too few values.
+ */
+struct RitSummaryStatistics
+{
+    double mean = NAN;   //!< Mean
+    double min = NAN;    //!< Smallest value
+    double max = NAN;    //!< Largest value
+    double stddev = NAN; //!< Standard deviation (ddof = 1)
+    uint32_t count = 0;  //!< Values
+};
+
+/**
+ * Scenario summary of a run (summarize_scenario of analysis/common/summary_utils.py).
+ */
+struct RitScenarioSummary
+{
+    RitSummaryStatistics pdr;       //!< PDR of the senders
+    RitSummaryStatistics delay;     //!< Mean delay of the senders [s]
+    RitSummaryStatistics wakeRatio; //!< 1 - TRX_OFF_ratio of the nodes
+};
+
+/**
+ * Summaries of a run, in the row order of the notebook: the senders then the receiver
+ * for the APP summary, all the nodes in ascending order for the MAC and PHY ones.
+ * A node whose logs are missing has no row, as when the Python summary fails on it.
+ */
+struct RitRunSummary
+{
+    std::vector<RitAppNodeSummary> app; //!< app_summary.csv rows
+    std::vector<RitMacNodeSummary> mac; //!< mac_summary.csv rows
+    std::vector<RitPhyNodeSummary> phy; //!< phy_summary.csv rows
+    RitScenarioSummary scenario;        //!< scenario_summary.csv row
+};
+
+/**
+ * Native replacement of the post-processing of analysis/multi_run_analysis.ipynb for
+ * existing trace trees (logs/<scenario>/<module>/BI.._TWD.._DWD.._Days../SEEDxx/node-*).
+ *
+ * The per-node CSV logs of the ASCII trace format are memory-mapped and parsed with a
+ * hand-rolled field splitter and number parser; the (run, node) pairs of a tree are
+ * spread over a pool of threads, the runs in order so that only the receiver logs of
+ * the runs in progress are kept. The last node of a run completes its summaries and
+ * writes <run>/summary/{app,mac,phy,scenario}_summary.csv with the columns, row order
+ * and number format of pandas to_csv(index=False).
+ *
+ * Binary or consolidated traces are read once decoded by
+ * analysis/common/trace_decoder.py; the columnar store of a run (analysis/common/columnar.py)
+ * is not read.
+ */
+class RitLogSummarizer
+{
+  public:
+    RitLogSummarizer();
+    ~RitLogSummarizer();
+
+    RitLogSummarizer(const RitLogSummarizer&) = delete;
+    RitLogSummarizer& operator=(const RitLogSummarizer&) = delete;
+
+    /**
+     * Set the number of parsing threads.
+     *
+     * @param nThreads The threads, 0 for one per hardware thread
+     */
+    void SetNThreads(uint32_t nThreads);
+
+    /**
+     * Get the number of parsing threads.
+     *
+     * @return the threads used by the next summaries
+     */
+    uint32_t GetNThreads() const;
+
+    /**
+     * Set the node whose app-rxlog.csv holds the receptions (APP_RECV_NODE).
+     *
+     * @param nodeId The receiver node, 0 by default
+     */
+    void SetReceiverNode(uint32_t nodeId);
+
+    /**
+     * Set whether SummarizeTree() rewrites the runs whose four summaries exist.
+     *
+     * @param overwrite True to summarize every run
+     */
+    void SetOverwrite(bool overwrite);
+
+    /**
+     * Find the runs of a tree: the directories with a node-N directory.
+     *
+     * @param root The tree, or a run
+     * @return the runs, sorted
+     */
+    static std::vector<std::string> FindRuns(const std::string& root);
+
+    /**
+     * Summarize a run without writing the summaries.
+     *
+     * @param runDir The run directory
+     * @return the summaries
+     */
+    RitRunSummary SummarizeRun(const std::string& runDir);
+
+    /**
+     * Summarize the runs of a tree and write their summary directories.
+     *
+     * @param root The tree, or a run
+     * @return the number of runs written
+     */
+    uint32_t SummarizeTree(const std::string& root);
+
+    /**
+     * Write <runDir>/summary/{app,mac,phy,scenario}_summary.csv.
+     *
+     * @param summary The summaries of the run
+     * @param runDir The run directory
+     */
+    static void WriteRunSummary(const RitRunSummary& summary, const std::string& runDir);
+
+    /**
+     * Write app_summary.csv.
+     *
+     * @param summary The summaries of a run
+     * @param os The output stream
+     */
+    static void WriteAppSummary(const RitRunSummary& summary, std::ostream& os);
+
+    /**
+     * Write mac_summary.csv, one <state>_ratio column per MAC state seen.
+     *
+     * @param summary The summaries of a run
+     * @param os The output stream
+     */
+    static void WriteMacSummary(const RitRunSummary& summary, std::ostream& os);
+
+    /**
+     * Write phy_summary.csv, one <state>_ratio column per PHY state seen.
+     *
+     * @param summary The summaries of a run
+     * @param os The output stream
+     */
+    static void WritePhySummary(const RitRunSummary& summary, std::ostream& os);
+
+    /**
+     * Write scenario_summary.csv.
+     *
+     * @param summary The summaries of a run
+     * @param os The output stream
+     */
+    static void WriteScenarioSummary(const RitRunSummary& summary, std::ostream& os);
+
+    /**
+     * Compute the scenario summary from the APP and PHY rows: the senders (txTotal > 0)
+     * with a PDR or a delay, the nodes with a TRX_OFF ratio.
+     *
+     * @param app The APP rows
+     * @param phy The PHY rows
+     * @return the scenario summary
+     */
+    static RitScenarioSummary SummarizeScenario(const std::vector<RitAppNodeSummary>& app,
+                                                const std::vector<RitPhyNodeSummary>& phy);
+
+    /**
+     * Parse a decimal number (sign, digits, fraction, exponent, or what strtod reads).
+     *
+     * @param begin The first character
+     * @param end One past the last character
+     * @param value The number
+     * @return false unless the whole field is a number
+     */
+    static bool ParseDouble(const char* begin, const char* end, double& value);
+
+    /**
+     * Parse an unsigned decimal integer.
+     *
+     * @param begin The first character
+     * @param end One past the last character
+     * @param value The integer
+     * @return false unless the whole field is an integer that fits 64 bits
+     */
+    static bool ParseUnsigned(const char* begin, const char* end, uint64_t& value);
+
+    /**
+     * Format a number as pandas writes a float: the shortest repr, empty for NaN.
+     *
+     * @param value The number
+     * @return the text
+     */
+    static std::string FormatValue(double value);
+
+    /**
+     * Get the number of bytes of log parsed since the construction.
+     *
+     * @return the bytes
+     */
+    uint64_t GetNBytes() const;
+
+    /**
+     * Get the number of nodes summarized since the construction.
+     *
+     * @return the nodes
+     */
+    uint64_t GetNNodes() const;
+
+    /**
+     * Get the number of runs that SummarizeTree() left as they were.
+     *
+     * @return the runs skipped
+     */
+    uint32_t GetNRunsSkipped() const;
+
+  private:
+    struct RunJob;
+
+    /**
+     * Summarize runs on the thread pool.
+     *
+     * @param jobs The runs
+     * @param write True to write the summaries of each run once complete
+     */
+    void Run(std::vector<std::unique_ptr<RunJob>>& jobs, bool write);
+
+    /**
+     * Summarize a node of a run (thread pool).
+     *
+     * @param job The run
+     * @param index The node, as an index of its nodes
+     */
+    void SummarizeNode(RunJob& job, size_t index);
+
+    /**
+     * Assemble the summaries of a run once its nodes are done (thread pool).
+     *
+     * @param job The run
+     */
+    void CompleteRun(RunJob& job) const;
+
+    uint32_t m_nThreads;            //!< Parsing threads, 0 for the hardware threads
+    uint32_t m_receiverNode;        //!< APP_RECV_NODE
+    bool m_overwrite;               //!< Rewrite existing summaries
+    uint32_t m_nRunsSkipped;        //!< Runs with their summaries left as they were
+    std::atomic<uint64_t> m_nBytes; //!< Bytes of log parsed
+    std::atomic<uint64_t> m_nNodes; //!< Nodes summarized
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // NS3_RIT_LOG_SUMMARIZER_H
@@ -0,0 +1,1099 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-metrics-collector.h"
+
+#include "ns3/abort.h"
+#include "ns3/application.h"
+#include "ns3/event-flood-sender.h"
+#include "ns3/log.h"
+#include "ns3/periodic-sender.h"
+#include "ns3/random-sender.h"
+#include "ns3/rit-wpan-net-device.h"
+#include "ns3/rit-wpan-nwk.h"
+#include "ns3/simulator.h"
+#include "ns3/trace-replay-sender.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <set>
+#include <sstream>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_LOG_COMPONENT_DEFINE("RitMetricsCollector");
+
+namespace
+{
+
+/**
+ * Mean/min/max/sample-std of a list of values, written like summarize_scenario().
+ */
+void
+WriteStats(std::ostream& os, const std::string& prefix, const std::vector<double>& values)
+{
+    if (values.empty())
+    {
+        os << prefix << "_mean,\n"
+           << prefix << "_min,\n"
+           << prefix << "_max,\n"
+           << prefix << "_std,\n";
+        return;
+    }
+    double sum = 0.0;
+    double minV = values.front();
+    double maxV = values.front();
+    for (double v : values)
+    {
+        sum += v;
+        minV = std::min(minV, v);
+        maxV = std::max(maxV, v);
+    }
+    double mean = sum / values.size();
+    double sq = 0.0;
+    for (double v : values)
+    {
+        sq += (v - mean) * (v - mean);
+    }
+    // pandas Series.std(): sample standard deviation (NaN for a single value)
+    double stdDev = values.size() > 1 ? std::sqrt(sq / (values.size() - 1)) : NAN;
+    os << prefix << "_mean," << mean << "\n"
+       << prefix << "_min," << minV << "\n"
+       << prefix << "_max," << maxV << "\n"
+       << prefix << "_std," << stdDev << "\n";
+}
+
+/**
+ * Write a histogram with fixed-width bins, the last one being the overflow bin.
+ */
+void
+WriteHistogram(const std::string& path, Time binWidth, const std::vector<uint64_t>& counts)
+{
+    std::ofstream hist(path);
+    hist << "binStart,binEnd,count\n";
+    for (size_t i = 0; i < counts.size(); ++i)
+    {
+        hist << (binWidth * i).GetSeconds() << ",";
+        if (i + 1 < counts.size())
+        {
+            hist << (binWidth * (i + 1)).GetSeconds();
+        }
+        else
+        {
+            hist << "inf";
+        }
+        hist << "," << counts[i] << "\n";
+    }
+}
+
+std::string
+PhyStateName(PhyEnumeration state)
+{
+    std::ostringstream oss;
+    oss << state;
+    return oss.str();
+}
+
+} // namespace
+
+RitMetricsCollector::RitMetricsCollector()
+{
+    SetLatencyHistogram(MilliSeconds(100), 600);
+}
+
+void
+RitMetricsCollector::SetLatencyHistogram(Time binWidth, uint32_t bins)
+{
+    NS_ABORT_MSG_IF(binWidth.IsZero() || bins == 0, "Invalid latency histogram layout");
+    m_binWidth = binWidth;
+    m_latencyHistogram.assign(bins + 1, 0);
+    m_backoffHistogram.assign(bins + 1, 0);
+}
+
+RitMetricsCollector::NodeMetrics&
+RitMetricsCollector::GetNode(uint32_t nodeId)
+{
+    return m_nodes[nodeId];
+}
+
+void
+RitMetricsCollector::Install(Ptr<Node> node)
+{
+    NS_LOG_FUNCTION(this << node->GetId());
+    uint32_t nodeId = node->GetId();
+    Ptr<RitMetricsCollector> self(this);
+    GetNode(nodeId);
+
+    if (node->GetNApplications() > 0)
+    {
+        Ptr<Application> app = node->GetApplication(0);
+        if (DynamicCast<PeriodicSender>(app) || DynamicCast<RandomSender>(app) ||
+            DynamicCast<TraceReplaySender>(app))
+        {
+            app->TraceConnectWithoutContext("Tx", MakeBoundCallback(&AppTxSink, self, nodeId));
+            app->TraceConnectWithoutContext("Rx", MakeBoundCallback(&AppRxSink, self, nodeId));
+        }
+    }
+    for (uint32_t i = 0; i < node->GetNApplications(); ++i)
+    {
+        if (auto flood = DynamicCast<EventFloodSender>(node->GetApplication(i)))
+        {
+            flood->TraceConnectWithoutContext("Tx",
+                                              MakeBoundCallback(&FloodTxSink, self, nodeId));
+        }
+    }
+
+    for (uint32_t j = 0; j < node->GetNDevices(); ++j)
+    {
+        Ptr<RitWpanNetDevice> dev = DynamicCast<RitWpanNetDevice>(node->GetDevice(j));
+        if (!dev)
+        {
+            continue;
+        }
+        Ptr<RitSimpleRouting> nwk = dev->GetNwk();
+        nwk->TraceConnectWithoutContext("NwkTx",
+                                        MakeBoundCallback(&NwkTxSink, self, nodeId, NWK_TX));
+        nwk->TraceConnectWithoutContext("NwkTxOk",
+                                        MakeBoundCallback(&NwkTxSink, self, nodeId, NWK_TX_OK));
+        nwk->TraceConnectWithoutContext("NwkTxDrop",
+                                        MakeBoundCallback(&NwkTxSink, self, nodeId, NWK_TX_DROP));
+        nwk->TraceConnectWithoutContext("NwkReTx",
+                                        MakeBoundCallback(&NwkTxSink, self, nodeId, NWK_RE_TX));
+        nwk->TraceConnectWithoutContext("NwkReTxBackoff",
+                                        MakeBoundCallback(&ReTxBackoffSink, self));
+        nwk->TraceConnectWithoutContext("NwkBootstrap",
+                                        MakeBoundCallback(&BootstrapSink, self, nodeId));
+        nwk->TraceConnectWithoutContext("NwkDownlinkTx",
+                                        MakeBoundCallback(&DownlinkTxSink, self, nodeId));
+        nwk->TraceConnectWithoutContext("NwkDownlinkRx",
+                                        MakeBoundCallback(&DownlinkRxSink, self, nodeId));
+        nwk->TraceConnectWithoutContext("NwkBroadcastTx",
+                                        MakeBoundCallback(&BroadcastTxSink, self, nodeId));
+        nwk->TraceConnectWithoutContext("NwkBroadcastRx",
+                                        MakeBoundCallback(&BroadcastRxSink, self, nodeId));
+        nwk->TraceConnectWithoutContext("TxTableOccupancy",
+                                        MakeBoundCallback(&TxTableOccupancySink, self, nodeId));
+
+        Ptr<RitWpanMac> mac = dev->GetMac();
+        mac->TraceConnectWithoutContext("TxQueueOccupancy",
+                                        MakeBoundCallback(&QueueOccupancySink, self, nodeId));
+        mac->TraceConnectWithoutContext("TxQueueDequeue",
+                                        MakeBoundCallback(&QueueDequeueSink, self, nodeId));
+        mac->TraceConnectWithoutContext("TxQueueDrop",
+                                        MakeBoundCallback(&QueueDropSink, self, nodeId));
+        mac->TraceConnectWithoutContext("BroadcastTx",
+                                        MakeBoundCallback(&BroadcastFrameSink, self, nodeId));
+
+        dev->TraceConnectWithoutContext(
+            "EnergyExhausted",
+            MakeBoundCallback(&EnergyExhaustedSink, self, nodeId, dev->GetEnergyModel()));
+
+        Ptr<LrWpanPhy> phy = dev->GetPhy();
+        phy->TraceConnectWithoutContext("TrxState",
+                                        MakeBoundCallback(&PhyStateSink, self, nodeId));
+        phy->TraceConnectWithoutContext("PhyTxEnd",
+                                        MakeBoundCallback(&PhyEventSink, self, nodeId, PHY_TX_END));
+        phy->TraceConnectWithoutContext(
+            "PhyTxDrop",
+            MakeBoundCallback(&PhyEventSink, self, nodeId, PHY_TX_DROP));
+        phy->TraceConnectWithoutContext(
+            "PhyRxDrop",
+            MakeBoundCallback(&PhyEventSink, self, nodeId, PHY_RX_DROP));
+        phy->TraceConnectWithoutContext("PhyRxEnd",
+                                        MakeBoundCallback(&PhyRxEndSink, self, nodeId));
+    }
+}
+
+void
+RitMetricsCollector::AppTxSink(Ptr<RitMetricsCollector> collector,
+                               uint32_t nodeId,
+                               Ptr<const Packet> pkt)
+{
+    NodeMetrics& m = collector->GetNode(nodeId);
+    m.appTxRows++;
+    auto inserted = collector->m_pending.emplace(pkt->GetUid(),
+                                                 PendingPacket{nodeId, Simulator::Now(), false});
+    if (inserted.second)
+    {
+        m.appTxUnique++;
+    }
+}
+
+void
+RitMetricsCollector::FloodTxSink(Ptr<RitMetricsCollector> collector,
+                                 uint32_t nodeId,
+                                 Ptr<const Packet> pkt)
+{
+    const Time now = Simulator::Now();
+    auto inserted = collector->m_pending.emplace(pkt->GetUid(), PendingPacket{nodeId, now, true});
+    if (!inserted.second)
+    {
+        return;
+    }
+    if (!collector->m_floodSeen)
+    {
+        collector->m_floodSeen = true;
+        collector->m_floodFirstTx = now;
+    }
+    collector->GetNode(nodeId).floodTx++;
+    collector->m_floodDrainPending = true;
+}
+
+void
+RitMetricsCollector::AppRxSink(Ptr<RitMetricsCollector> collector,
+                               uint32_t nodeId,
+                               Ptr<const Packet> pkt)
+{
+    NodeMetrics& rx = collector->GetNode(nodeId);
+    rx.appRxRows++;
+    auto it = collector->m_pending.find(pkt->GetUid());
+    if (it == collector->m_pending.end())
+    {
+        // Duplicate reception or packet not sent by a monitored node
+        return;
+    }
+    rx.sinkRx++;
+    rx.sinkSources.insert(it->second.srcNode);
+    Time delay = Simulator::Now() - it->second.txTime;
+    NodeMetrics& src = collector->GetNode(it->second.srcNode);
+    if (it->second.flood)
+    {
+        // Kept out of the PDR and latency of the background traffic
+        src.floodDelivered++;
+        src.floodDelaySum += delay.GetSeconds();
+        collector->m_floodLastRx = Simulator::Now();
+        collector->m_pending.erase(it);
+        return;
+    }
+    src.delivered++;
+    src.delaySum += delay.GetSeconds();
+
+    auto bin = static_cast<size_t>(delay.GetInteger() / collector->m_binWidth.GetInteger());
+    bin = std::min(bin, collector->m_latencyHistogram.size() - 1);
+    collector->m_latencyHistogram[bin]++;
+
+    collector->m_pending.erase(it);
+}
+
+void
+RitMetricsCollector::QueueOccupancySink(Ptr<RitMetricsCollector> collector,
+                                        uint32_t nodeId,
+                                        uint32_t oldValue,
+                                        uint32_t newValue)
+{
+    NodeMetrics& m = collector->GetNode(nodeId);
+    collector->m_queuedFrames = collector->m_queuedFrames + newValue - m.queueFrames;
+    m.queueFrames = newValue;
+    m.queuePeak = std::max(m.queuePeak, newValue);
+    if (collector->m_queuedFrames == 0 && collector->m_floodDrainPending)
+    {
+        collector->m_floodDrainPending = false;
+        collector->m_floodQueueDrain = Simulator::Now();
+    }
+}
+
+void
+RitMetricsCollector::QueueDequeueSink(Ptr<RitMetricsCollector> collector,
+                                      uint32_t nodeId,
+                                      Ptr<const Packet> pkt,
+                                      Time sojourn)
+{
+    NodeMetrics& m = collector->GetNode(nodeId);
+    m.queueSojournMax = std::max(m.queueSojournMax, sojourn);
+}
+
+void
+RitMetricsCollector::QueueDropSink(Ptr<RitMetricsCollector> collector,
+                                   uint32_t nodeId,
+                                   Ptr<const Packet> pkt,
+                                   Time sojourn)
+{
+    collector->GetNode(nodeId).queueDrop++;
+}
+
+void
+RitMetricsCollector::TxTableOccupancySink(Ptr<RitMetricsCollector> collector,
+                                          uint32_t nodeId,
+                                          uint32_t oldValue,
+                                          uint32_t newValue)
+{
+    NodeMetrics& m = collector->GetNode(nodeId);
+    m.txTablePeak = std::max(m.txTablePeak, newValue);
+}
+
+void
+RitMetricsCollector::NwkTxSink(Ptr<RitMetricsCollector> collector,
+                               uint32_t nodeId,
+                               NwkTxEvent event,
+                               Ptr<const Packet> pkt)
+{
+    collector->GetNode(nodeId).nwk[event]++;
+}
+
+void
+RitMetricsCollector::ReTxBackoffSink(Ptr<RitMetricsCollector> collector,
+                                     Ptr<const Packet> pkt,
+                                     uint8_t attempt,
+                                     Time delay)
+{
+    if (collector->m_retryHistogram.size() <= attempt)
+    {
+        collector->m_retryHistogram.resize(attempt + 1, 0);
+    }
+    collector->m_retryHistogram[attempt]++;
+
+    auto bin = static_cast<size_t>(delay.GetInteger() / collector->m_binWidth.GetInteger());
+    bin = std::min(bin, collector->m_backoffHistogram.size() - 1);
+    collector->m_backoffHistogram[bin]++;
+}
+
+void
+RitMetricsCollector::BootstrapSink(Ptr<RitMetricsCollector> collector,
+                                   uint32_t nodeId,
+                                   uint16_t rank,
+                                   Mac16Address parent,
+                                   Time elapsed)
+{
+    NodeMetrics& m = collector->GetNode(nodeId);
+    m.bootstrapped = true;
+    m.rank = rank;
+    m.parent = parent;
+    m.bootstrapElapsed = elapsed;
+    m.bootstrapEnd = Simulator::Now();
+}
+
+void
+RitMetricsCollector::DownlinkTxSink(Ptr<RitMetricsCollector> collector,
+                                    uint32_t nodeId,
+                                    Ptr<const Packet> pkt,
+                                    Mac16Address dst,
+                                    uint8_t hops)
+{
+    collector->GetNode(nodeId).downlinkTx++;
+}
+
+void
+RitMetricsCollector::DownlinkRxSink(Ptr<RitMetricsCollector> collector,
+                                    uint32_t nodeId,
+                                    Ptr<const Packet> pkt,
+                                    Time latency,
+                                    uint8_t hops)
+{
+    NodeMetrics& m = collector->GetNode(nodeId);
+    m.downlinkRx++;
+    m.downlinkDelaySum += latency.GetSeconds();
+    m.downlinkHops = hops;
+}
+
+void
+RitMetricsCollector::BroadcastTxSink(Ptr<RitMetricsCollector> collector,
+                                     uint32_t nodeId,
+                                     Ptr<const Packet> pkt,
+                                     Mac16Address origin,
+                                     uint16_t seq,
+                                     uint8_t hops)
+{
+    collector->GetNode(nodeId).broadcastTx++;
+    if (hops == 0)
+    {
+        const uint32_t key = (static_cast<uint32_t>(origin.ConvertToInt()) << 16) | seq;
+        collector->m_broadcasts[key].start = Simulator::Now();
+    }
+}
+
+void
+RitMetricsCollector::BroadcastRxSink(Ptr<RitMetricsCollector> collector,
+                                     uint32_t nodeId,
+                                     Ptr<const Packet> pkt,
+                                     Mac16Address origin,
+                                     uint16_t seq,
+                                     uint8_t hops,
+                                     Time latency)
+{
+    const uint32_t key = (static_cast<uint32_t>(origin.ConvertToInt()) << 16) | seq;
+    auto it = collector->m_broadcasts.find(key);
+    if (it == collector->m_broadcasts.end())
+    {
+        // Started by a node without a collector
+        return;
+    }
+    BroadcastRecord& record = it->second;
+    record.reached++;
+    record.lastRx = Simulator::Now();
+
+    NodeMetrics& m = collector->GetNode(nodeId);
+    m.broadcastRx++;
+    m.broadcastDelaySum += (Simulator::Now() - record.start).GetSeconds();
+    m.broadcastHopsMax = std::max<uint32_t>(m.broadcastHopsMax, hops);
+}
+
+void
+RitMetricsCollector::BroadcastFrameSink(Ptr<RitMetricsCollector> collector,
+                                        uint32_t nodeId,
+                                        Ptr<const Packet> pkt,
+                                        Mac16Address receiver)
+{
+    collector->GetNode(nodeId).broadcastFrames++;
+}
+
+void
+RitMetricsCollector::EnergyExhaustedSink(Ptr<RitMetricsCollector> collector,
+                                         uint32_t nodeId,
+                                         Ptr<RitWpanEnergyModel> energy)
+{
+    NodeMetrics& m = collector->GetNode(nodeId);
+    m.depleted = true;
+    m.depletionTime = energy->IsDepleted() ? energy->GetDepletionTime() : Simulator::Now();
+}
+
+void
+RitMetricsCollector::PhyEventSink(Ptr<RitMetricsCollector> collector,
+                                  uint32_t nodeId,
+                                  PhyEvent event,
+                                  Ptr<const Packet> pkt)
+{
+    collector->GetNode(nodeId).phy[event]++;
+}
+
+void
+RitMetricsCollector::PhyRxEndSink(Ptr<RitMetricsCollector> collector,
+                                  uint32_t nodeId,
+                                  Ptr<const Packet> pkt,
+                                  double sinr)
+{
+    collector->GetNode(nodeId).phy[PHY_RX_END]++;
+}
+
+void
+RitMetricsCollector::PhyStateSink(Ptr<RitMetricsCollector> collector,
+                                  uint32_t nodeId,
+                                  Time time,
+                                  PhyEnumeration oldState,
+                                  PhyEnumeration newState)
+{
+    NodeMetrics& m = collector->GetNode(nodeId);
+    if (!m.phyStateSeen)
+    {
+        m.phyStateSeen = true;
+        m.phyFirstChange = time;
+    }
+    else
+    {
+        // Same accounting as summarize_phy_node(): a state lasts until the next log line
+        m.phyStateTime[m.phyState] += time - m.phyLastChange;
+    }
+    m.phyLastChange = time;
+    m.phyState = newState;
+}
+
+Time
+RitMetricsCollector::GetPhyTotalTime(const NodeMetrics& m) const
+{
+    return m.phyStateSeen ? m.phyLastChange - m.phyFirstChange : Time(0);
+}
+
+uint64_t
+RitMetricsCollector::GetTxCount(uint32_t nodeId) const
+{
+    auto it = m_nodes.find(nodeId);
+    return it != m_nodes.end() ? it->second.appTxRows : 0;
+}
+
+uint64_t
+RitMetricsCollector::GetDeliveredCount(uint32_t nodeId) const
+{
+    auto it = m_nodes.find(nodeId);
+    return it != m_nodes.end() ? it->second.delivered : 0;
+}
+
+double
+RitMetricsCollector::GetPdr(uint32_t nodeId) const
+{
+    auto it = m_nodes.find(nodeId);
+    if (it == m_nodes.end() || it->second.appTxUnique == 0)
+    {
+        return -1.0;
+    }
+    return static_cast<double>(it->second.delivered) / it->second.appTxUnique;
+}
+
+double
+RitMetricsCollector::GetWakeRatio(uint32_t nodeId) const
+{
+    auto it = m_nodes.find(nodeId);
+    if (it == m_nodes.end())
+    {
+        return -1.0;
+    }
+    Time total = GetPhyTotalTime(it->second);
+    auto off = it->second.phyStateTime.find(IEEE_802_15_4_PHY_TRX_OFF);
+    if (!total.IsStrictlyPositive() || off == it->second.phyStateTime.end())
+    {
+        return -1.0;
+    }
+    return 1.0 - off->second.GetSeconds() / total.GetSeconds();
+}
+
+const std::vector<uint64_t>&
+RitMetricsCollector::GetLatencyHistogram() const
+{
+    return m_latencyHistogram;
+}
+
+const std::vector<uint64_t>&
+RitMetricsCollector::GetRetryHistogram() const
+{
+    return m_retryHistogram;
+}
+
+const std::vector<uint64_t>&
+RitMetricsCollector::GetBackoffHistogram() const
+{
+    return m_backoffHistogram;
+}
+
+Time
+RitMetricsCollector::GetConvergenceTime() const
+{
+    Time latest;
+    for (const auto& [nodeId, m] : m_nodes)
+    {
+        if (m.bootstrapped && m.bootstrapEnd > latest)
+        {
+            latest = m.bootstrapEnd;
+        }
+    }
+    return latest;
+}
+
+double
+RitMetricsCollector::GetDownlinkPdr() const
+{
+    uint64_t tx = 0;
+    uint64_t rx = 0;
+    for (const auto& [nodeId, m] : m_nodes)
+    {
+        tx += m.downlinkTx;
+        rx += m.downlinkRx;
+    }
+    return tx > 0 ? static_cast<double>(rx) / tx : -1.0;
+}
+
+double
+RitMetricsCollector::GetBroadcastCoverage() const
+{
+    if (m_broadcasts.empty() || m_nodes.size() < 2)
+    {
+        return -1.0;
+    }
+    double sum = 0.0;
+    for (const auto& [key, record] : m_broadcasts)
+    {
+        sum += static_cast<double>(record.reached) / (m_nodes.size() - 1);
+    }
+    return sum / m_broadcasts.size();
+}
+
+uint64_t
+RitMetricsCollector::GetSinkRxCount(uint32_t nodeId) const
+{
+    auto it = m_nodes.find(nodeId);
+    return it != m_nodes.end() ? it->second.sinkRx : 0;
+}
+
+double
+RitMetricsCollector::GetFloodPdr() const
+{
+    uint64_t tx = 0;
+    uint64_t rx = 0;
+    for (const auto& [nodeId, m] : m_nodes)
+    {
+        tx += m.floodTx;
+        rx += m.floodDelivered;
+    }
+    return tx > 0 ? static_cast<double>(rx) / tx : -1.0;
+}
+
+Time
+RitMetricsCollector::GetFloodTimeToDrain() const
+{
+    return m_floodLastRx > m_floodFirstTx ? m_floodLastRx - m_floodFirstTx : Time(0);
+}
+
+uint32_t
+RitMetricsCollector::GetQueuePeak(uint32_t nodeId) const
+{
+    auto it = m_nodes.find(nodeId);
+    return it != m_nodes.end() ? it->second.queuePeak : 0;
+}
+
+RitMetricsCollector::Totals
+RitMetricsCollector::GetTotals() const
+{
+    Totals totals;
+    for (const auto& [nodeId, m] : m_nodes)
+    {
+        totals.txUnique += m.appTxUnique;
+        totals.delivered += m.delivered;
+        totals.delaySum += m.delaySum;
+        for (const auto& [state, t] : m.phyStateTime)
+        {
+            totals.phyTime += t;
+            if (state == IEEE_802_15_4_PHY_TRX_OFF)
+            {
+                totals.phyOffTime += t;
+            }
+        }
+    }
+    return totals;
+}
+
+void
+RitMetricsCollector::SetScenarioValue(const std::string& key, double value)
+{
+    for (auto& [k, v] : m_scenarioValues)
+    {
+        if (k == key)
+        {
+            v = value;
+            return;
+        }
+    }
+    m_scenarioValues.emplace_back(key, value);
+}
+
+void
+RitMetricsCollector::SetNodeClass(uint32_t nodeId, const std::string& deviceClass)
+{
+    m_nodeClasses[nodeId] = deviceClass;
+}
+
+double
+RitMetricsCollector::GetClassPdr(const std::string& deviceClass) const
+{
+    uint64_t tx = 0;
+    uint64_t delivered = 0;
+    for (const auto& [nodeId, name] : m_nodeClasses)
+    {
+        auto it = m_nodes.find(nodeId);
+        if (name == deviceClass && it != m_nodes.end())
+        {
+            tx += it->second.appTxUnique;
+            delivered += it->second.delivered;
+        }
+    }
+    return tx > 0 ? static_cast<double>(delivered) / tx : -1.0;
+}
+
+void
+RitMetricsCollector::SetLifetimeDeathRatio(double ratio)
+{
+    NS_ABORT_MSG_IF(ratio <= 0.0 || ratio > 1.0, "Invalid lifetime death ratio " << ratio);
+    m_lifetimeDeathRatio = ratio;
+}
+
+Time
+RitMetricsCollector::GetLifetime(double ratio) const
+{
+    std::vector<Time> deaths;
+    for (const auto& [nodeId, m] : m_nodes)
+    {
+        if (m.depleted)
+        {
+            deaths.push_back(m.depletionTime);
+        }
+    }
+    const auto needed = std::max<std::size_t>(
+        1,
+        static_cast<std::size_t>(std::ceil(ratio * m_nodes.size() - 1e-9)));
+    if (deaths.size() < needed)
+    {
+        return Time::Max();
+    }
+    std::nth_element(deaths.begin(), deaths.begin() + (needed - 1), deaths.end());
+    return deaths[needed - 1];
+}
+
+Time
+RitMetricsCollector::GetFirstDeathTime() const
+{
+    return GetLifetime(0.0);
+}
+
+void
+RitMetricsCollector::WriteSummaries(std::string outputDir) const
+{
+    NS_LOG_FUNCTION(this << outputDir);
+    std::filesystem::create_directories(outputDir);
+
+    std::vector<double> pdrValues;
+    std::vector<double> delayValues;
+    std::vector<double> wakeValues;
+
+    // app-summary.csv
+    std::ofstream app(outputDir + "app-summary.csv");
+    app << std::setprecision(10);
+    app << "nodeId,pdr,avg_delay,tx_total,rx_total\n";
+    for (const auto& [nodeId, m] : m_nodes)
+    {
+        app << nodeId << ",";
+        if (m.appTxUnique > 0)
+        {
+            double pdr = static_cast<double>(m.delivered) / m.appTxUnique;
+            app << pdr;
+            pdrValues.push_back(pdr);
+        }
+        app << ",";
+        if (m.delivered > 0)
+        {
+            double delay = m.delaySum / m.delivered;
+            app << delay;
+            delayValues.push_back(delay);
+        }
+        app << "," << m.appTxRows << "," << m.appRxRows << "\n";
+    }
+
+    // phy-summary.csv (one ratio column per state that was left at least once)
+    std::set<PhyEnumeration> states;
+    for (const auto& [nodeId, m] : m_nodes)
+    {
+        for (const auto& [state, t] : m.phyStateTime)
+        {
+            states.insert(state);
+        }
+    }
+    std::ofstream phy(outputDir + "phy-summary.csv");
+    phy << std::setprecision(10);
+    phy << "nodeId,tx,rx,txDrop,rxDrop";
+    for (PhyEnumeration state : states)
+    {
+        phy << "," << PhyStateName(state) << "_ratio";
+    }
+    phy << "\n";
+    for (const auto& [nodeId, m] : m_nodes)
+    {
+        phy << nodeId << "," << m.phy[PHY_TX_END] << "," << m.phy[PHY_RX_END] << ","
+            << m.phy[PHY_TX_DROP] << "," << m.phy[PHY_RX_DROP];
+        Time total = GetPhyTotalTime(m);
+        for (PhyEnumeration state : states)
+        {
+            phy << ",";
+            auto it = m.phyStateTime.find(state);
+            if (it != m.phyStateTime.end() && total.IsStrictlyPositive())
+            {
+                phy << it->second.GetSeconds() / total.GetSeconds();
+            }
+        }
+        phy << "\n";
+        double wake = GetWakeRatio(nodeId);
+        if (wake >= 0.0)
+        {
+            wakeValues.push_back(wake);
+        }
+    }
+
+    // nwk-summary.csv
+    std::ofstream nwk(outputDir + "nwk-summary.csv");
+    nwk << "nodeId,nwkTx,nwkTxOk,nwkTxDrop,nwkReTx\n";
+    for (const auto& [nodeId, m] : m_nodes)
+    {
+        nwk << nodeId << "," << m.nwk[NWK_TX] << "," << m.nwk[NWK_TX_OK] << ","
+            << m.nwk[NWK_TX_DROP] << "," << m.nwk[NWK_RE_TX] << "\n";
+    }
+
+    // scenario-summary.csv (key,value like the summarize_scenario() dict)
+    std::ofstream scenario(outputDir + "scenario-summary.csv");
+    scenario << std::setprecision(10);
+    scenario << "key,value\n";
+    WriteStats(scenario, "pdr", pdrValues);
+    scenario << "pdr_node_count," << pdrValues.size() << "\n";
+    WriteStats(scenario, "delay", delayValues);
+    scenario << "delay_node_count," << delayValues.size() << "\n";
+    WriteStats(scenario, "wake_ratio", wakeValues);
+    scenario << "wake_node_count," << wakeValues.size() << "\n";
+
+    // bootstrap.csv
+    std::vector<double> bootstrapValues;
+    for (const auto& [nodeId, m] : m_nodes)
+    {
+        if (m.bootstrapped)
+        {
+            bootstrapValues.push_back(m.bootstrapElapsed.GetSeconds());
+        }
+    }
+    if (!bootstrapValues.empty())
+    {
+        std::ofstream bootstrap(outputDir + "bootstrap.csv");
+        bootstrap << std::setprecision(10);
+        bootstrap << "nodeId,rank,parent,bootstrap_time,end_time\n";
+        for (const auto& [nodeId, m] : m_nodes)
+        {
+            if (m.bootstrapped)
+            {
+                bootstrap << nodeId << "," << m.rank << "," << m.parent << ","
+                          << m.bootstrapElapsed.GetSeconds() << ","
+                          << m.bootstrapEnd.GetSeconds() << "\n";
+            }
+        }
+        WriteStats(scenario, "bootstrap_time", bootstrapValues);
+        scenario << "bootstrap_node_count," << bootstrapValues.size() << "\n";
+        scenario << "convergence_time," << GetConvergenceTime().GetSeconds() << "\n";
+    }
+
+    // downlink.csv
+    const double downlinkPdr = GetDownlinkPdr();
+    if (downlinkPdr >= 0.0)
+    {
+        std::vector<double> downlinkDelays;
+        std::ofstream downlink(outputDir + "downlink.csv");
+        downlink << std::setprecision(10);
+        downlink << "nodeId,rx,avg_delay,hops\n";
+        for (const auto& [nodeId, m] : m_nodes)
+        {
+            if (m.downlinkRx > 0)
+            {
+                const double avg = m.downlinkDelaySum / m.downlinkRx;
+                downlinkDelays.push_back(avg);
+                downlink << nodeId << "," << m.downlinkRx << "," << avg << ","
+                         << m.downlinkHops << "\n";
+            }
+        }
+        scenario << "downlink_pdr," << downlinkPdr << "\n";
+        WriteStats(scenario, "downlink_delay", downlinkDelays);
+        scenario << "downlink_node_count," << downlinkDelays.size() << "\n";
+    }
+
+    // broadcast.csv
+    const double broadcastCoverage = GetBroadcastCoverage();
+    if (broadcastCoverage >= 0.0)
+    {
+        std::ofstream broadcast(outputDir + "broadcast.csv");
+        broadcast << std::setprecision(10);
+        broadcast << "nodeId,tx,frames,rx,avg_delay,hops\n";
+        uint64_t broadcastTx = 0;
+        for (const auto& [nodeId, m] : m_nodes)
+        {
+            broadcastTx += m.broadcastTx;
+            broadcast << nodeId << "," << m.broadcastTx << "," << m.broadcastFrames << ","
+                      << m.broadcastRx << ",";
+            if (m.broadcastRx > 0)
+            {
+                broadcast << m.broadcastDelaySum / m.broadcastRx;
+            }
+            broadcast << "," << m.broadcastHopsMax << "\n";
+        }
+        std::vector<double> coverageTimes;
+        for (const auto& [key, record] : m_broadcasts)
+        {
+            if (record.reached > 0)
+            {
+                coverageTimes.push_back((record.lastRx - record.start).GetSeconds());
+            }
+        }
+        scenario << "broadcast_count," << m_broadcasts.size() << "\n";
+        scenario << "broadcast_coverage," << broadcastCoverage << "\n";
+        WriteStats(scenario, "broadcast_coverage_time", coverageTimes);
+        scenario << "broadcast_tx_per_node,"
+                 << static_cast<double>(broadcastTx) / (m_broadcasts.size() * m_nodes.size())
+                 << "\n";
+    }
+
+    // sink-load.csv
+    uint64_t totalSinkRx = 0;
+    for (const auto& [nodeId, m] : m_nodes)
+    {
+        totalSinkRx += m.sinkRx;
+    }
+    if (totalSinkRx > 0)
+    {
+        std::ofstream sinkLoad(outputDir + "sink-load.csv");
+        sinkLoad << std::setprecision(10);
+        sinkLoad << "nodeId,rx,share,sources\n";
+        uint32_t sinkCount = 0;
+        double maxShare = 0.0;
+        for (const auto& [nodeId, m] : m_nodes)
+        {
+            if (m.sinkRx > 0)
+            {
+                const double share = static_cast<double>(m.sinkRx) / totalSinkRx;
+                sinkLoad << nodeId << "," << m.sinkRx << "," << share << ","
+                         << m.sinkSources.size() << "\n";
+                maxShare = std::max(maxShare, share);
+                sinkCount++;
+            }
+        }
+        scenario << "sink_count," << sinkCount << "\n";
+        scenario << "sink_load_max_share," << maxShare << "\n";
+    }
+
+    // flood-summary.csv
+    const double floodPdr = GetFloodPdr();
+    if (floodPdr >= 0.0)
+    {
+        std::vector<double> floodDelays;
+        std::ofstream flood(outputDir + "flood-summary.csv");
+        flood << std::setprecision(10);
+        flood << "nodeId,tx,delivered,avg_delay\n";
+        for (const auto& [nodeId, m] : m_nodes)
+        {
+            if (m.floodTx == 0)
+            {
+                continue;
+            }
+            flood << nodeId << "," << m.floodTx << "," << m.floodDelivered << ",";
+            if (m.floodDelivered > 0)
+            {
+                const double avg = m.floodDelaySum / m.floodDelivered;
+                floodDelays.push_back(avg);
+                flood << avg;
+            }
+            flood << "\n";
+        }
+        scenario << "flood_pdr," << floodPdr << "\n";
+        WriteStats(scenario, "flood_delay", floodDelays);
+        scenario << "flood_node_count," << floodDelays.size() << "\n";
+        scenario << "flood_start," << m_floodFirstTx.GetSeconds() << "\n";
+        scenario << "flood_time_to_drain," << GetFloodTimeToDrain().GetSeconds() << "\n";
+        // Empty when a TX queue still held frames at the end of the run
+        scenario << "flood_queue_drain_time,";
+        if (!m_floodDrainPending)
+        {
+            scenario << (m_floodQueueDrain - m_floodFirstTx).GetSeconds();
+        }
+        scenario << "\n";
+    }
+
+    // queue-summary.csv
+    std::ofstream queue(outputDir + "queue-summary.csv");
+    queue << std::setprecision(10);
+    queue << "nodeId,queuePeak,queueDrop,sojournMax,txTablePeak\n";
+    uint32_t queuePeak = 0;
+    uint64_t queueDrops = 0;
+    for (const auto& [nodeId, m] : m_nodes)
+    {
+        queue << nodeId << "," << m.queuePeak << "," << m.queueDrop << ","
+              << m.queueSojournMax.GetSeconds() << "," << m.txTablePeak << "\n";
+        queuePeak = std::max(queuePeak, m.queuePeak);
+        queueDrops += m.queueDrop;
+    }
+    scenario << "queue_peak_max," << queuePeak << "\n";
+    scenario << "queue_drop_total," << queueDrops << "\n";
+
+    // lifetime.csv (nodes whose battery ran out)
+    uint32_t deadNodes = 0;
+    for (const auto& [nodeId, m] : m_nodes)
+    {
+        deadNodes += m.depleted ? 1 : 0;
+    }
+    if (deadNodes > 0)
+    {
+        std::ofstream lifetime(outputDir + "lifetime.csv");
+        lifetime << std::setprecision(10);
+        lifetime << "nodeId,depletion_time\n";
+        for (const auto& [nodeId, m] : m_nodes)
+        {
+            if (m.depleted)
+            {
+                lifetime << nodeId << "," << m.depletionTime.GetSeconds() << "\n";
+            }
+        }
+    }
+    scenario << "lifetime_dead_count," << deadNodes << "\n";
+    scenario << "lifetime_first_death,";
+    if (GetFirstDeathTime() != Time::Max())
+    {
+        scenario << GetFirstDeathTime().GetSeconds();
+    }
+    scenario << "\n";
+    scenario << "lifetime_death_ratio," << m_lifetimeDeathRatio << "\n";
+    scenario << "lifetime_ratio_death,";
+    if (GetLifetime(m_lifetimeDeathRatio) != Time::Max())
+    {
+        scenario << GetLifetime(m_lifetimeDeathRatio).GetSeconds();
+    }
+    scenario << "\n";
+
+    // class-summary.csv (installed nodes with a device class)
+    std::map<std::string, std::vector<uint32_t>> classNodes;
+    for (const auto& [nodeId, name] : m_nodeClasses)
+    {
+        if (m_nodes.count(nodeId))
+        {
+            classNodes[name].push_back(nodeId);
+        }
+    }
+    if (!classNodes.empty())
+    {
+        std::ofstream classes(outputDir + "class-summary.csv");
+        classes << std::setprecision(10);
+        classes << "class,nodes,tx,delivered,pdr,avg_delay,wake_ratio\n";
+        for (const auto& [name, ids] : classNodes)
+        {
+            uint64_t tx = 0;
+            uint64_t delivered = 0;
+            double delaySum = 0.0;
+            double wakeSum = 0.0;
+            uint32_t wakeNodes = 0;
+            for (uint32_t nodeId : ids)
+            {
+                const NodeMetrics& m = m_nodes.at(nodeId);
+                tx += m.appTxUnique;
+                delivered += m.delivered;
+                delaySum += m.delaySum;
+                const double wake = GetWakeRatio(nodeId);
+                if (wake >= 0.0)
+                {
+                    wakeSum += wake;
+                    wakeNodes++;
+                }
+            }
+            classes << name << "," << ids.size() << "," << tx << "," << delivered << ",";
+            if (tx > 0)
+            {
+                classes << static_cast<double>(delivered) / tx;
+            }
+            classes << ",";
+            if (delivered > 0)
+            {
+                classes << delaySum / delivered;
+            }
+            classes << ",";
+            if (wakeNodes > 0)
+            {
+                classes << wakeSum / wakeNodes;
+            }
+            classes << "\n";
+        }
+    }
+
+    for (const auto& [key, value] : m_scenarioValues)
+    {
+        scenario << key << "," << value << "\n";
+    }
+
+    // latency-histogram.csv, backoff-histogram.csv
+    WriteHistogram(outputDir + "latency-histogram.csv", m_binWidth, m_latencyHistogram);
+    WriteHistogram(outputDir + "backoff-histogram.csv", m_binWidth, m_backoffHistogram);
+
+    // retx-histogram.csv
+    std::ofstream retx(outputDir + "retx-histogram.csv");
+    retx << "attempt,count\n";
+    for (size_t i = 1; i < m_retryHistogram.size(); ++i)
+    {
+        retx << i << "," << m_retryHistogram[i] << "\n";
+    }
+}
+
+} // namespace lrwpan
+} // namespace ns3
@@ -0,0 +1,404 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef RIT_METRICS_COLLECTOR_H
+#define RIT_METRICS_COLLECTOR_H
+
+#include "ns3/lr-wpan-phy.h"
+#include "ns3/mac16-address.h"
+#include "ns3/node.h"
+#include "ns3/nstime.h"
+#include "ns3/packet.h"
+#include "ns3/ptr.h"
+#include "ns3/rit-wpan-energy-model.h"
+#include "ns3/simple-ref-count.h"
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @ingroup lrwpan
+ *
+ * @brief Online PDR / end-to-end latency / wake-ratio aggregation.
+ *
+ * Hooks the application Tx/Rx, NWK Tx and PHY traces of each installed node and
+ * keeps running per-node aggregates instead of raw logs. WriteSummaries() (scheduled
+ * at Simulator::Destroy by RitWpanNetHelper::EnableMetricsCollector()) writes the
+ * tables computed by analysis/common/summary_utils.py:
+ *  - app-summary.csv      (summarize_app_node: nodeId,pdr,avg_delay,tx_total,rx_total)
+ *  - phy-summary.csv      (summarize_phy_node: nodeId,tx,rx,txDrop,rxDrop,<STATE>_ratio...)
+ *  - scenario-summary.csv (summarize_scenario: pdr_*, delay_*, wake_ratio_*)
+ * plus nwk-summary.csv (NWK Tx/TxOk/TxDrop/ReTx counters), latency-histogram.csv and,
+ * from the NwkReTxBackoff trace, retx-histogram.csv (retries per attempt number) and
+ * backoff-histogram.csv (retry delays, same bins as the latency). When nodes
+ * bootstrap, bootstrap.csv lists their rank, parent and bootstrap time, and the
+ * scenario summary gets the convergence time of the network. Source-routed
+ * downlink packets (NwkDownlinkTx / NwkDownlinkRx) give downlink.csv and the
+ * downlink PDR and latency of the scenario. sink-load.csv lists, for each node
+ * that received packets of other nodes (the sinks), the packets delivered
+ * there, their share of all deliveries and the number of their origins; the
+ * scenario summary gets the number of sinks and the largest share.
+ * Network-wide broadcasts (NwkBroadcastTx / NwkBroadcastRx, MAC BroadcastTx) give
+ * broadcast.csv (per node: broadcasts started or forwarded, MAC frames, first
+ * receptions, their delay from the start and hops) and the coverage of the
+ * scenario: mean share of the other nodes reached, time to the last first
+ * reception, and NWK transmissions per node and broadcast.
+ *
+ * The reports of the EventFloodSender applications of a node are accounted apart
+ * from its first application: flood-summary.csv lists them per node and the
+ * scenario summary gets their PDR, latency and time to drain (first report to last
+ * delivery), and the time from the first report until every TX queue was empty
+ * after the last one. queue-summary.csv lists the peak MAC TX queue and NWK transmit
+ * table occupancies, the TX queue drops and the longest TX queue sojourn of each
+ * node.
+ *
+ * Nodes given a device class (SetNodeClass(), from RitWpanNetHelper::AssignDeviceProfile())
+ * are summed up per class in class-summary.csv: nodes, packets sent and delivered, PDR,
+ * mean latency and mean wake ratio.
+ *
+ * The nodes whose battery runs out (RitWpanNetDevice EnergyExhausted) give
+ * lifetime.csv (depletion time per node) and the network lifetime of the scenario
+ * summary: the depleted nodes, the time to the first death and the time until the
+ * share of the installed nodes set by SetLifetimeDeathRatio() is dead (empty while
+ * not reached).
+ *
+ * Values set with SetScenarioValue() (e.g. by RitSteadyStateController) end the
+ * scenario summary.
+ */
+class RitMetricsCollector : public SimpleRefCount<RitMetricsCollector>
+{
+  public:
+    /**
+     * @brief Network-wide running totals, sampled by RitSteadyStateController.
+     */
+    struct Totals
+    {
+        uint64_t txUnique = 0;  //!< Distinct application packets sent
+        uint64_t delivered = 0; //!< Those delivered
+        double delaySum = 0.0;  //!< Sum of their end-to-end delays [s]
+        Time phyTime;           //!< PHY state time accounted, all nodes
+        Time phyOffTime;        //!< Part of it in TRX_OFF
+    };
+
+    RitMetricsCollector();
+
+    /**
+     * @brief Set the latency (and retry backoff) histogram layout.
+     * @param binWidth Width of one bin
+     * @param bins Number of bins (an extra overflow bin is always kept)
+     */
+    void SetLatencyHistogram(Time binWidth, uint32_t bins);
+
+    /**
+     * @brief Connect the traces of a node (first application, RitWpanNetDevice NWK and PHY).
+     * @param node Node to monitor
+     */
+    void Install(Ptr<Node> node);
+
+    /**
+     * @brief Write the summary tables.
+     * @param outputDir Output directory (created if needed)
+     */
+    void WriteSummaries(std::string outputDir) const;
+
+    /** @brief Get the number of application packets sent by a node. */
+    uint64_t GetTxCount(uint32_t nodeId) const;
+
+    /** @brief Get the number of application packets of a node delivered to any receiver. */
+    uint64_t GetDeliveredCount(uint32_t nodeId) const;
+
+    /** @brief Get the PDR of a node (negative if it sent nothing). */
+    double GetPdr(uint32_t nodeId) const;
+
+    /** @brief Get the ratio of time the PHY of a node was not in TRX_OFF (negative if unknown). */
+    double GetWakeRatio(uint32_t nodeId) const;
+
+    /** @brief Get the latency histogram counts (last entry is the overflow bin). */
+    const std::vector<uint64_t>& GetLatencyHistogram() const;
+
+    /** @brief Get the number of NWK retries per attempt number (index 0 unused). */
+    const std::vector<uint64_t>& GetRetryHistogram() const;
+
+    /** @brief Get the retry backoff histogram counts (last entry is the overflow bin). */
+    const std::vector<uint64_t>& GetBackoffHistogram() const;
+
+    /** @brief Get the time the last node finished its bootstrap (zero if none did). */
+    Time GetConvergenceTime() const;
+
+    /** @brief Get the ratio of the downlink packets sent that were delivered (negative if none). */
+    double GetDownlinkPdr() const;
+
+    /**
+     * @brief Get the mean share of the other installed nodes that received each
+     * broadcast (negative if none started).
+     */
+    double GetBroadcastCoverage() const;
+
+    /** @brief Get the number of application packets of other nodes delivered at a node. */
+    uint64_t GetSinkRxCount(uint32_t nodeId) const;
+
+    /** @brief Get the ratio of the event flood reports delivered (negative if none sent). */
+    double GetFloodPdr() const;
+
+    /** @brief Get the time from the first event flood report to the last one delivered. */
+    Time GetFloodTimeToDrain() const;
+
+    /** @brief Get the largest number of frames in the MAC TX queue of a node. */
+    uint32_t GetQueuePeak(uint32_t nodeId) const;
+
+    /** @brief Get the running totals of the background traffic and of the PHY states. */
+    Totals GetTotals() const;
+
+    /**
+     * @brief Set a value written at the end of the scenario summary.
+     * @param key Key (a key already set is overwritten in place)
+     * @param value Value
+     */
+    void SetScenarioValue(const std::string& key, double value);
+
+    /**
+     * @brief Account a node under a device class in class-summary.csv.
+     * @param nodeId Node ID (a node set again changes class)
+     * @param deviceClass Name of the class
+     */
+    void SetNodeClass(uint32_t nodeId, const std::string& deviceClass);
+
+    /**
+     * @brief Get the ratio of the application packets of the nodes of a class delivered.
+     * @param deviceClass Name of the class
+     * @return the PDR, negative if its nodes sent nothing
+     */
+    double GetClassPdr(const std::string& deviceClass) const;
+
+    /**
+     * @brief Set the share of the installed nodes dead at the end of the lifetime in the
+     *        scenario summary.
+     * @param ratio Share of the nodes, in (0, 1] (0.5 by default)
+     */
+    void SetLifetimeDeathRatio(double ratio);
+
+    /**
+     * @brief Get the time until a share of the installed nodes depleted their battery.
+     * @param ratio Share of the nodes, in [0, 1]; it counts at least one node
+     * @return the time of that death, Time::Max() if not reached
+     */
+    Time GetLifetime(double ratio) const;
+
+    /** @brief Get the time of the first battery depletion (Time::Max() if none). */
+    Time GetFirstDeathTime() const;
+
+  private:
+    /**
+     * @brief NWK transmit events counted per node.
+     */
+    enum NwkTxEvent : uint8_t
+    {
+        NWK_TX = 0,
+        NWK_TX_OK,
+        NWK_TX_DROP,
+        NWK_RE_TX,
+        NWK_EVENT_COUNT
+    };
+
+    /**
+     * @brief PHY events counted per node.
+     */
+    enum PhyEvent : uint8_t
+    {
+        PHY_TX_END = 0,
+        PHY_RX_END,
+        PHY_TX_DROP,
+        PHY_RX_DROP,
+        PHY_EVENT_COUNT
+    };
+
+    /**
+     * @brief Running aggregates of one node.
+     */
+    struct NodeMetrics
+    {
+        uint64_t appTxRows = 0;      //!< Application Tx trace hits
+        uint64_t appTxUnique = 0;    //!< Distinct packet UIDs sent
+        uint64_t appRxRows = 0;      //!< Application Rx trace hits
+        uint64_t delivered = 0;      //!< Own packets received by some node
+        double delaySum = 0.0;       //!< Sum of end-to-end delays [s]
+        uint64_t nwk[NWK_EVENT_COUNT] = {};
+        uint64_t phy[PHY_EVENT_COUNT] = {};
+        bool phyStateSeen = false;             //!< At least one TrxState event
+        Time phyFirstChange;                   //!< First TrxState event
+        Time phyLastChange;                    //!< Last TrxState event
+        PhyEnumeration phyState = IEEE_802_15_4_PHY_TRX_OFF; //!< State since phyLastChange
+        std::map<PhyEnumeration, Time> phyStateTime; //!< Time per (left) state
+        bool bootstrapped = false;      //!< NwkBootstrap seen
+        uint16_t rank = 0;              //!< Rank taken at the bootstrap
+        Mac16Address parent;            //!< Parent chosen at the bootstrap
+        Time bootstrapElapsed;          //!< Duration of the bootstrap
+        Time bootstrapEnd;              //!< End of the bootstrap
+        uint64_t downlinkTx = 0;        //!< Source-routed packets sent (sink)
+        uint64_t downlinkRx = 0;        //!< Source-routed packets delivered to the node
+        double downlinkDelaySum = 0.0;  //!< Sum of their latencies [s]
+        uint32_t downlinkHops = 0;      //!< Hops of the last one
+        uint64_t sinkRx = 0;            //!< Packets of other nodes first delivered here
+        std::set<uint32_t> sinkSources; //!< Origins of these packets
+        uint64_t floodTx = 0;           //!< Event flood reports sent
+        uint64_t floodDelivered = 0;    //!< Event flood reports received by some node
+        double floodDelaySum = 0.0;     //!< Sum of their end-to-end delays [s]
+        uint32_t queueFrames = 0;       //!< Frames in the MAC TX queue
+        uint32_t queuePeak = 0;         //!< Largest MAC TX queue occupancy
+        uint64_t queueDrop = 0;         //!< Frames dropped by a full MAC TX queue
+        Time queueSojournMax;           //!< Longest MAC TX queue sojourn
+        uint32_t txTablePeak = 0;       //!< Largest NWK transmit table occupancy
+        uint64_t broadcastTx = 0;       //!< Broadcasts started or forwarded (NWK)
+        uint64_t broadcastFrames = 0;   //!< Broadcast frames answering a beacon (MAC)
+        uint64_t broadcastRx = 0;       //!< Broadcasts first received
+        double broadcastDelaySum = 0.0; //!< Sum of their delays from the start [s]
+        uint32_t broadcastHopsMax = 0;  //!< Most hops of one of them
+        bool depleted = false;          //!< Battery depleted
+        Time depletionTime;             //!< Time of the depletion
+    };
+
+    /**
+     * @brief Dissemination of one broadcast.
+     */
+    struct BroadcastRecord
+    {
+        Time start;          //!< Started by its origin
+        Time lastRx;         //!< Last first reception
+        uint32_t reached{0}; //!< Nodes that received it
+    };
+
+    /**
+     * @brief Pending application packet.
+     */
+    struct PendingPacket
+    {
+        uint32_t srcNode; //!< Node that sent the packet
+        Time txTime;      //!< First transmission time
+        bool flood;       //!< Event flood report
+    };
+
+    static void AppTxSink(Ptr<RitMetricsCollector> collector,
+                          uint32_t nodeId,
+                          Ptr<const Packet> pkt);
+    static void AppRxSink(Ptr<RitMetricsCollector> collector,
+                          uint32_t nodeId,
+                          Ptr<const Packet> pkt);
+    static void FloodTxSink(Ptr<RitMetricsCollector> collector,
+                            uint32_t nodeId,
+                            Ptr<const Packet> pkt);
+    static void QueueOccupancySink(Ptr<RitMetricsCollector> collector,
+                                   uint32_t nodeId,
+                                   uint32_t oldValue,
+                                   uint32_t newValue);
+    static void QueueDequeueSink(Ptr<RitMetricsCollector> collector,
+                                 uint32_t nodeId,
+                                 Ptr<const Packet> pkt,
+                                 Time sojourn);
+    static void QueueDropSink(Ptr<RitMetricsCollector> collector,
+                              uint32_t nodeId,
+                              Ptr<const Packet> pkt,
+                              Time sojourn);
+    static void TxTableOccupancySink(Ptr<RitMetricsCollector> collector,
+                                     uint32_t nodeId,
+                                     uint32_t oldValue,
+                                     uint32_t newValue);
+    static void NwkTxSink(Ptr<RitMetricsCollector> collector,
+                          uint32_t nodeId,
+                          NwkTxEvent event,
+                          Ptr<const Packet> pkt);
+    static void ReTxBackoffSink(Ptr<RitMetricsCollector> collector,
+                                Ptr<const Packet> pkt,
+                                uint8_t attempt,
+                                Time delay);
+    static void BootstrapSink(Ptr<RitMetricsCollector> collector,
+                              uint32_t nodeId,
+                              uint16_t rank,
+                              Mac16Address parent,
+                              Time elapsed);
+    static void DownlinkTxSink(Ptr<RitMetricsCollector> collector,
+                               uint32_t nodeId,
+                               Ptr<const Packet> pkt,
+                               Mac16Address dst,
+                               uint8_t hops);
+    static void DownlinkRxSink(Ptr<RitMetricsCollector> collector,
+                               uint32_t nodeId,
+                               Ptr<const Packet> pkt,
+                               Time latency,
+                               uint8_t hops);
+    static void BroadcastTxSink(Ptr<RitMetricsCollector> collector,
+                                uint32_t nodeId,
+                                Ptr<const Packet> pkt,
+                                Mac16Address origin,
+                                uint16_t seq,
+                                uint8_t hops);
+    static void BroadcastRxSink(Ptr<RitMetricsCollector> collector,
+                                uint32_t nodeId,
+                                Ptr<const Packet> pkt,
+                                Mac16Address origin,
+                                uint16_t seq,
+                                uint8_t hops,
+                                Time latency);
+    static void BroadcastFrameSink(Ptr<RitMetricsCollector> collector,
+                                   uint32_t nodeId,
+                                   Ptr<const Packet> pkt,
+                                   Mac16Address receiver);
+    static void EnergyExhaustedSink(Ptr<RitMetricsCollector> collector,
+                                    uint32_t nodeId,
+                                    Ptr<RitWpanEnergyModel> energy);
+    static void PhyEventSink(Ptr<RitMetricsCollector> collector,
+                             uint32_t nodeId,
+                             PhyEvent event,
+                             Ptr<const Packet> pkt);
+    static void PhyRxEndSink(Ptr<RitMetricsCollector> collector,
+                             uint32_t nodeId,
+                             Ptr<const Packet> pkt,
+                             double sinr);
+    static void PhyStateSink(Ptr<RitMetricsCollector> collector,
+                             uint32_t nodeId,
+                             Time time,
+                             PhyEnumeration oldState,
+                             PhyEnumeration newState);
+
+    /** @brief Get (create) the aggregates of a node. */
+    NodeMetrics& GetNode(uint32_t nodeId);
+
+    /** @brief Total time covered by the PHY state log of a node (first to last change). */
+    Time GetPhyTotalTime(const NodeMetrics& m) const;
+
+    std::map<uint32_t, NodeMetrics> m_nodes;                 //!< Per-node aggregates
+    std::unordered_map<uint64_t, PendingPacket> m_pending;   //!< Not yet delivered packets
+    Time m_binWidth;                                         //!< Histogram bin width
+    std::vector<uint64_t> m_latencyHistogram;                //!< Bins + overflow
+    std::vector<uint64_t> m_retryHistogram;                  //!< Retries per attempt number
+    std::vector<uint64_t> m_backoffHistogram;                //!< Bins + overflow
+    uint64_t m_queuedFrames = 0;                             //!< Frames in all TX queues
+    bool m_floodSeen = false;                                //!< An event flood report was sent
+    Time m_floodFirstTx;                                     //!< First event flood report
+    Time m_floodLastRx;                                      //!< Last one delivered
+    Time m_floodQueueDrain;                                  //!< TX queues empty after a report
+    bool m_floodDrainPending = false;                        //!< Queues not yet empty
+    std::map<uint32_t, BroadcastRecord> m_broadcasts;        //!< By origin and sequence
+    std::vector<std::pair<std::string, double>> m_scenarioValues; //!< SetScenarioValue()
+    std::map<uint32_t, std::string> m_nodeClasses;                //!< SetNodeClass()
+    double m_lifetimeDeathRatio = 0.5;                            //!< SetLifetimeDeathRatio()
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // RIT_METRICS_COLLECTOR_H
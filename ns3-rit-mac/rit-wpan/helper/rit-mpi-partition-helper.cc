@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-mpi-partition-helper.h"
+
+#include "ns3/abort.h"
+#include "ns3/antenna-model.h"
+#include "ns3/global-value.h"
+#include "ns3/log.h"
+#include "ns3/lr-wpan-spectrum-signal-parameters.h"
+#include "ns3/mpi-interface.h"
+#include "ns3/mpi-receiver.h"
+#include "ns3/node-list.h"
+#include "ns3/packet-burst.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/rit-partition-helper.h"
+#include "ns3/rit-remote-signal-header.h"
+#include "ns3/rit-wpan-mac.h"
+#include "ns3/rit-wpan-net-device.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_LOG_COMPONENT_DEFINE("RitMpiPartitionHelper");
+
+namespace
+{
+
+constexpr uint32_t NO_REGION = std::numeric_limits<uint32_t>::max(); //!< Node not installed
+
+Ptr<RitWpanNetDevice>
+FindRitWpanDevice(Ptr<Node> node)
+{
+    for (uint32_t i = 0; i < node->GetNDevices(); ++i)
+    {
+        if (auto dev = DynamicCast<RitWpanNetDevice>(node->GetDevice(i)))
+        {
+            return dev;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+/**
+ * Sends the transmissions handed over by the channel to the ranks of their regions
+ * and delivers those received from the other ranks.
+ */
+class RitMpiPartitionHelper::Exchange : public SimpleRefCount<RitMpiPartitionHelper::Exchange>
+{
+  public:
+    /**
+     * @param channel The channel (not owned: it holds the callback to the exchange)
+     * @param lookahead Delay of the transmissions between the ranks
+     * @param mailboxes Node id of the mailbox of each rank
+     */
+    Exchange(LrWpanSpectrumChannel* channel, Time lookahead, std::vector<uint32_t> mailboxes)
+        : m_channel(channel),
+          m_rank(MpiInterface::GetSystemId()),
+          m_lookahead(lookahead),
+          m_mailboxes(std::move(mailboxes))
+    {
+    }
+
+    /**
+     * Send a transmission of a local PHY to the rank of a region.
+     *
+     * @param region The receiving region
+     * @param params The signal
+     */
+    void Handover(uint32_t region, Ptr<SpectrumSignalParameters> params)
+    {
+        auto lrWpanParams = DynamicCast<LrWpanSpectrumSignalParameters>(params);
+        NS_ABORT_MSG_IF(!lrWpanParams || !lrWpanParams->packetBurst ||
+                            lrWpanParams->packetBurst->GetNPackets() != 1,
+                        "Only the signals of a LrWpanPhy can be sent to another rank");
+        Ptr<NetDevice> dev = params->txPhy->GetDevice();
+        NS_ABORT_MSG_IF(!dev || !dev->GetNode(), "Transmitter without node");
+
+        RitRemoteSignalHeader header;
+        header.SetTransmitter(dev->GetNode()->GetId(), dev->GetIfIndex());
+        header.SetTxChannel(static_cast<uint8_t>(lrWpanParams->txChannel));
+        header.SetDuration(params->duration);
+        header.SetPsd(params->psd);
+        Ptr<Packet> p = lrWpanParams->packetBurst->GetPackets().front()->Copy();
+        p->AddHeader(header);
+        MpiInterface::SendPacket(p, Simulator::Now() + m_lookahead, m_mailboxes.at(region), 0);
+        m_nSent++;
+    }
+
+    /**
+     * Deliver a transmission received from another rank to the local region.
+     *
+     * @param p The frame behind its RitRemoteSignalHeader
+     */
+    void Receive(Ptr<Packet> p)
+    {
+        RitRemoteSignalHeader header;
+        p->RemoveHeader(header);
+        Ptr<NetDevice> dev = NodeList::GetNode(header.GetNodeId())->GetDevice(header.GetIfIndex());
+        Ptr<RitWpanNetDevice> ritDev = DynamicCast<RitWpanNetDevice>(dev);
+        NS_ABORT_MSG_IF(!ritDev, "Signal of node " << header.GetNodeId() << " without RIT device");
+        Ptr<LrWpanPhy> phy = ritDev->GetPhy();
+
+        Ptr<LrWpanSpectrumSignalParameters> params = Create<LrWpanSpectrumSignalParameters>();
+        params->duration = header.GetDuration();
+        params->txPhy = phy;
+        params->psd = header.GetPsd(phy->GetRxSpectrumModel());
+        params->txAntenna = DynamicCast<AntennaModel>(phy->GetAntenna());
+        params->txChannel = header.GetTxChannel();
+        Ptr<PacketBurst> pb = CreateObject<PacketBurst>();
+        pb->AddPacket(p);
+        params->packetBurst = pb;
+        m_nReceived++;
+        m_channel->StartRemoteTx(params, m_rank);
+    }
+
+    LrWpanSpectrumChannel* m_channel;  //!< The channel
+    uint32_t m_rank;                   //!< Rank of this process, its region
+    Time m_lookahead;                  //!< Delay of the transmissions between the ranks
+    std::vector<uint32_t> m_mailboxes; //!< Node id of the mailbox of each rank
+    uint64_t m_nSent{0};               //!< Transmissions sent to other ranks
+    uint64_t m_nReceived{0};           //!< Transmissions received from other ranks
+};
+
+RitMpiPartitionHelper::RitMpiPartitionHelper()
+    : m_minDistance(0.0)
+{
+}
+
+RitMpiPartitionHelper::~RitMpiPartitionHelper()
+{
+}
+
+void
+RitMpiPartitionHelper::SetMinDistance(double minDistance)
+{
+    m_minDistance = minDistance;
+}
+
+void
+RitMpiPartitionHelper::Install(NodeContainer c, Ptr<LrWpanSpectrumChannel> channel)
+{
+    NS_ABORT_MSG_IF(!MpiInterface::IsEnabled(), "MPI is not enabled");
+    const uint32_t nRanks = MpiInterface::GetSize();
+    const uint32_t rank = MpiInterface::GetSystemId();
+    NS_ABORT_MSG_IF(nRanks < 2, "A distributed run needs at least two ranks");
+    StringValue impl;
+    GlobalValue::GetValueByName("SimulatorImplementationType", impl);
+    NS_ABORT_MSG_IF(impl.Get() != "ns3::DistributedSimulatorImpl",
+                    "The ranks are synchronised by ns3::DistributedSimulatorImpl, not "
+                        << impl.Get());
+    NS_ABORT_MSG_IF(m_exchange, "Install() already called");
+
+    RitPartitionHelper partitionHelper;
+    const std::vector<uint32_t> regions = partitionHelper.Partition(c, nRanks);
+    partitionHelper.SetRegions(c, regions);
+    m_region.assign(NodeList::GetNNodes(), NO_REGION);
+    Ptr<LrWpanPhy> phy;
+    for (uint32_t i = 0; i < c.GetN(); i++)
+    {
+        m_region[c.Get(i)->GetId()] = regions[i];
+        Ptr<RitWpanNetDevice> dev = FindRitWpanDevice(c.Get(i));
+        if (!dev)
+        {
+            continue;
+        }
+        phy = dev->GetPhy();
+        if (regions[i] != rank)
+        {
+            // a copy of a node of another rank: no RIT cycle of its own
+            Ptr<RitWpanMac> mac = dev->GetMac();
+            mac->SetRitTimes(Seconds(0),
+                             mac->GetRitDataWaitDurationTime(),
+                             mac->GetRitTxWaitDurationTime());
+        }
+    }
+    NS_ABORT_MSG_IF(!phy, "No RIT device on the nodes");
+    const Time lookahead = RitPartitionHelper::GetLookahead(phy, m_minDistance);
+
+    // One mailbox node per rank. The point-to-point links between them carry no
+    // traffic: their delay bounds the lookahead of DistributedSimulatorImpl.
+    std::vector<Ptr<Node>> mailboxes;
+    std::vector<uint32_t> mailboxIds;
+    for (uint32_t r = 0; r < nRanks; r++)
+    {
+        mailboxes.push_back(CreateObject<Node>(r));
+        mailboxIds.push_back(mailboxes.back()->GetId());
+    }
+    PointToPointHelper p2p;
+    p2p.SetChannelAttribute("Delay", TimeValue(lookahead));
+    for (uint32_t r = 1; r < nRanks; r++)
+    {
+        p2p.Install(mailboxes[0], mailboxes[r]);
+    }
+
+    m_exchange = Create<Exchange>(PeekPointer(channel), lookahead, mailboxIds);
+    Ptr<Node> mailbox = mailboxes[rank];
+    for (uint32_t i = 0; i < mailbox->GetNDevices(); i++)
+    {
+        Ptr<MpiReceiver> receiver = mailbox->GetDevice(i)->GetObject<MpiReceiver>();
+        NS_ABORT_MSG_IF(!receiver, "Mailbox link is not a remote point-to-point link");
+        receiver->SetReceiveCallback(MakeCallback(&Exchange::Receive, m_exchange));
+    }
+    channel->SetLocalRegion(rank);
+    channel->SetRemoteTxCallback(MakeCallback(&Exchange::Handover, m_exchange));
+    NS_LOG_INFO("rank " << rank << " of " << nRanks << ", lookahead " << lookahead.As(Time::US));
+}
+
+NodeContainer
+RitMpiPartitionHelper::GetLocalNodes(NodeContainer c) const
+{
+    const uint32_t rank = MpiInterface::GetSystemId();
+    NodeContainer local;
+    for (auto it = c.Begin(); it != c.End(); ++it)
+    {
+        const uint32_t id = (*it)->GetId();
+        NS_ABORT_MSG_IF(id >= m_region.size() || m_region[id] == NO_REGION,
+                        "Node " << id << " not given to Install()");
+        if (m_region[id] == rank)
+        {
+            local.Add(*it);
+        }
+    }
+    return local;
+}
+
+Time
+RitMpiPartitionHelper::GetLookahead() const
+{
+    return m_exchange ? m_exchange->m_lookahead : Time();
+}
+
+uint64_t
+RitMpiPartitionHelper::GetNSent() const
+{
+    return m_exchange ? m_exchange->m_nSent : 0;
+}
+
+uint64_t
+RitMpiPartitionHelper::GetNReceived() const
+{
+    return m_exchange ? m_exchange->m_nReceived : 0;
+}
+
+} // namespace lrwpan
+} // namespace ns3
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef NS3_RIT_MPI_PARTITION_HELPER_H
+#define NS3_RIT_MPI_PARTITION_HELPER_H
+
+#include "ns3/lr-wpan-spectrum-channel.h"
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * Helper to run a RIT network on the ns-3 distributed simulator, one spatial region
+ * per MPI rank (built only with MPI enabled).
+ *
+ * Every rank builds the same network from the same seed, so each holds a copy of
+ * every node. Install() splits the nodes into one region per rank with
+ * RitPartitionHelper, keeps the copies of the nodes of the other ranks off the
+ * channel (LrWpanSpectrumChannel::SetLocalRegion()) with their RIT cycles stopped,
+ * and hands the transmissions of the local nodes that reach receivers of another
+ * region over to that rank as a packet: the frame behind a RitRemoteSignalHeader,
+ * sent with MpiInterface::SendPacket() to a mailbox node of the rank. The rank
+ * rebuilds the signal on its copy of the transmitter and passes it to
+ * LrWpanSpectrumChannel::StartRemoteTx().
+ *
+ * The mailboxes are joined by point-to-point links whose delay is the lookahead,
+ * RitPartitionHelper::GetLookahead() (RX-to-TX turnaround plus the propagation delay
+ * over SetMinDistance()), so DistributedSimulatorImpl synchronises the ranks over
+ * that window. A handed over signal starts at the remote receivers one lookahead
+ * after it started on the air (192 us at 2.4 GHz with the default distance of 0):
+ * the frames crossing the cuts are delayed by that much, and a border node may miss
+ * that first part of a remote frame in a carrier sense. The results are therefore
+ * close to, not identical to, those of the unsplit run.
+ *
+ * Applications, bootstraps and traces are to be installed on GetLocalNodes() only;
+ * each rank writes its own outputs. The node positions must not depend on the rank.
+ */
+class RitMpiPartitionHelper
+{
+  public:
+    RitMpiPartitionHelper();
+    ~RitMpiPartitionHelper();
+
+    RitMpiPartitionHelper(const RitMpiPartitionHelper&) = delete;
+    RitMpiPartitionHelper& operator=(const RitMpiPartitionHelper&) = delete;
+
+    /**
+     * Set the shortest distance between two nodes of different regions counted in
+     * the lookahead (0 by default).
+     *
+     * @param minDistance Distance [m]
+     */
+    void SetMinDistance(double minDistance);
+
+    /**
+     * Split the nodes into one region per rank and connect the ranks. To be called
+     * on every rank in the same order of the script, after the RIT devices are
+     * installed on the nodes and before Simulator::Run(). Aborts unless MPI is
+     * enabled with at least two ranks and the DistributedSimulatorImpl.
+     *
+     * @param c Nodes, all with a MobilityModel
+     * @param channel The channel of their RIT devices
+     */
+    void Install(NodeContainer c, Ptr<LrWpanSpectrumChannel> channel);
+
+    /**
+     * @param c Nodes of the container given to Install()
+     * @return the nodes of c simulated by this rank
+     */
+    NodeContainer GetLocalNodes(NodeContainer c) const;
+
+    /**
+     * @return the lookahead between the ranks (after Install())
+     */
+    Time GetLookahead() const;
+
+    /**
+     * @return the number of transmissions sent to another rank (one per transmission
+     *         and receiving rank)
+     */
+    uint64_t GetNSent() const;
+
+    /**
+     * @return the number of transmissions received from the other ranks
+     */
+    uint64_t GetNReceived() const;
+
+  private:
+    class Exchange;
+
+    double m_minDistance;           //!< Distance counted in the lookahead [m]
+    std::vector<uint32_t> m_region; //!< Region of each node, by node id
+    Ptr<Exchange> m_exchange;       //!< Transmissions exchanged with the other ranks
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // NS3_RIT_MPI_PARTITION_HELPER_H
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-partition-helper.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/lr-wpan-constants.h"
+#include "ns3/mobility-model.h"
+#include "ns3/rit-wpan-net-device.h"
+#include "ns3/simple-ref-count.h"
+
+#include <algorithm>
+#include <numeric>
+#include <set>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_LOG_COMPONENT_DEFINE("RitPartitionHelper");
+
+namespace
+{
+
+constexpr double SPEED_OF_LIGHT = 299792458.0; //!< Propagation speed [m/s]
+
+Ptr<RitWpanNetDevice>
+FindRitWpanDevice(Ptr<Node> node)
+{
+    for (uint32_t i = 0; i < node->GetNDevices(); ++i)
+    {
+        if (auto dev = DynamicCast<RitWpanNetDevice>(node->GetDevice(i)))
+        {
+            return dev;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Give regions [first, first + nRegions) to the nodes of [begin, end).
+ *
+ * @param positions Positions of all the nodes
+ * @param begin First node index
+ * @param end Past the last node index
+ * @param first First region
+ * @param nRegions Number of regions
+ * @param regions Region of each node (filled)
+ */
+void
+Bisect(const std::vector<Vector>& positions,
+       std::vector<uint32_t>::iterator begin,
+       std::vector<uint32_t>::iterator end,
+       uint32_t first,
+       uint32_t nRegions,
+       std::vector<uint32_t>& regions)
+{
+    if (nRegions == 1 || end - begin <= 1)
+    {
+        std::for_each(begin, end, [&](uint32_t i) { regions[i] = first; });
+        return;
+    }
+
+    // cut across the longer extent of the nodes
+    double minX = positions[*begin].x;
+    double maxX = minX;
+    double minY = positions[*begin].y;
+    double maxY = minY;
+    for (auto it = begin; it != end; ++it)
+    {
+        minX = std::min(minX, positions[*it].x);
+        maxX = std::max(maxX, positions[*it].x);
+        minY = std::min(minY, positions[*it].y);
+        maxY = std::max(maxY, positions[*it].y);
+    }
+    const bool alongX = maxX - minX >= maxY - minY;
+    std::stable_sort(begin, end, [&](uint32_t a, uint32_t b) {
+        return alongX ? positions[a].x < positions[b].x : positions[a].y < positions[b].y;
+    });
+
+    const uint32_t nLow = nRegions / 2;
+    auto cut = begin + (end - begin) * nLow / nRegions;
+    Bisect(positions, begin, cut, first, nLow, regions);
+    Bisect(positions, cut, end, first + nLow, nRegions - nLow, regions);
+}
+
+} // namespace
+
+/**
+ * Delivers the transmissions handed over between the regions of a channel in
+ * the same process.
+ */
+class RitPartitionHelper::Bridge : public SimpleRefCount<RitPartitionHelper::Bridge>
+{
+  public:
+    /**
+     * @param channel The channel (not owned: it holds the callback to the bridge)
+     */
+    explicit Bridge(LrWpanSpectrumChannel* channel)
+        : m_channel(channel)
+    {
+    }
+
+    /**
+     * Deliver a handed over transmission to its region.
+     *
+     * @param region The receiving region
+     * @param params The signal
+     */
+    void Handover(uint32_t region, Ptr<SpectrumSignalParameters> params)
+    {
+        m_nHandovers++;
+        m_borderPhys.insert(PeekPointer(params->txPhy));
+        m_channel->StartRemoteTx(params, region);
+    }
+
+    LrWpanSpectrumChannel* m_channel;          //!< The channel
+    uint64_t m_nHandovers{0};                  //!< Transmissions handed over
+    std::set<const SpectrumPhy*> m_borderPhys; //!< Transmitters that handed over
+};
+
+RitPartitionHelper::RitPartitionHelper()
+{
+}
+
+RitPartitionHelper::~RitPartitionHelper()
+{
+}
+
+std::vector<uint32_t>
+RitPartitionHelper::Partition(NodeContainer c, uint32_t nRegions) const
+{
+    NS_ABORT_MSG_IF(nRegions == 0, "At least one region is needed");
+    std::vector<Vector> positions;
+    for (auto it = c.Begin(); it != c.End(); ++it)
+    {
+        Ptr<MobilityModel> mobility = (*it)->GetObject<MobilityModel>();
+        NS_ABORT_MSG_IF(!mobility, "Node " << (*it)->GetId() << " has no MobilityModel");
+        positions.push_back(mobility->GetPosition());
+    }
+
+    std::vector<uint32_t> order(positions.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::vector<uint32_t> regions(positions.size(), 0);
+    Bisect(positions, order.begin(), order.end(), 0, nRegions, regions);
+    return regions;
+}
+
+void
+RitPartitionHelper::SetRegions(NodeContainer c, const std::vector<uint32_t>& regions) const
+{
+    NS_ABORT_MSG_IF(regions.size() != c.GetN(), "One region per node is needed");
+    for (uint32_t i = 0; i < c.GetN(); i++)
+    {
+        Ptr<RitWpanNetDevice> dev = FindRitWpanDevice(c.Get(i));
+        if (!dev)
+        {
+            continue;
+        }
+        Ptr<LrWpanSpectrumChannel> channel =
+            DynamicCast<LrWpanSpectrumChannel>(dev->GetPhy()->GetChannel());
+        NS_ABORT_MSG_IF(!channel, "Regions need a LrWpanSpectrumChannel");
+        channel->SetRegion(dev->GetPhy(), regions[i]);
+    }
+}
+
+void
+RitPartitionHelper::ConnectInProcess(Ptr<LrWpanSpectrumChannel> channel)
+{
+    m_bridge = Create<Bridge>(PeekPointer(channel));
+    channel->SetRemoteTxCallback(MakeCallback(&Bridge::Handover, m_bridge));
+}
+
+uint64_t
+RitPartitionHelper::GetNHandovers() const
+{
+    return m_bridge ? m_bridge->m_nHandovers : 0;
+}
+
+uint32_t
+RitPartitionHelper::GetNBorderNodes() const
+{
+    return m_bridge ? m_bridge->m_borderPhys.size() : 0;
+}
+
+Time
+RitPartitionHelper::GetLookahead(Ptr<LrWpanPhy> phy, double minDistance)
+{
+    const double symbolRate = phy->GetDataOrSymbolRate(false);
+    return Seconds(aTurnaroundTime / symbolRate + minDistance / SPEED_OF_LIGHT);
+}
+
+} // namespace lrwpan
+} // namespace ns3
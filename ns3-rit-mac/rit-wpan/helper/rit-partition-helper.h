@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef NS3_RIT_PARTITION_HELPER_H
+#define NS3_RIT_PARTITION_HELPER_H
+
+#include "ns3/lr-wpan-phy.h"
+#include "ns3/lr-wpan-spectrum-channel.h"
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * Helper to split a RIT network into spatial regions of a LrWpanSpectrumChannel.
+ *
+ * Partition() cuts the area of the nodes into regions of about the same number of
+ * nodes by recursive bisection of their MobilityModel positions, and SetRegions()
+ * gives each RIT device PHY its region on the channel (see
+ * LrWpanSpectrumChannel::SetRegion()). A transmission is then delivered at once in
+ * the region of its transmitter and handed over to the other regions holding
+ * receivers in range of it, so only the nodes along the cuts produce traffic
+ * between the regions.
+ *
+ * ConnectInProcess() delivers the handed over transmissions in the same process
+ * and counts them: the run gives the results of the unsplit channel, and
+ * GetNHandovers() / GetNBorderNodes() tell how much a distributed run (one region
+ * per process, each holding a copy of every PHY) would exchange. GetLookahead() is
+ * the synchronisation window such a run can use between two regions;
+ * RitMpiPartitionHelper runs it on MPI ranks.
+ */
+class RitPartitionHelper
+{
+  public:
+    RitPartitionHelper();
+    ~RitPartitionHelper();
+
+    RitPartitionHelper(const RitPartitionHelper&) = delete;
+    RitPartitionHelper& operator=(const RitPartitionHelper&) = delete;
+
+    /**
+     * Split the nodes into regions by position. Each cut halves the set of nodes
+     * (in proportion to the regions on each side) across its longer extent, so
+     * regions are compact and hold the same number of nodes within one.
+     *
+     * @param c Nodes, all with a MobilityModel
+     * @param nRegions Number of regions (at least 1)
+     * @return the region of each node, in container order
+     */
+    std::vector<uint32_t> Partition(NodeContainer c, uint32_t nRegions) const;
+
+    /**
+     * Set the region of the PHY of the RIT device of each node on its channel,
+     * which must be a LrWpanSpectrumChannel.
+     *
+     * @param c Nodes
+     * @param regions Region of each node, in container order (see Partition())
+     */
+    void SetRegions(NodeContainer c, const std::vector<uint32_t>& regions) const;
+
+    /**
+     * Split the channel into its regions and deliver the transmissions handed
+     * over between them in this process, counting them.
+     *
+     * @param channel The channel
+     */
+    void ConnectInProcess(Ptr<LrWpanSpectrumChannel> channel);
+
+    /**
+     * @return the number of transmissions handed over to another region (one per
+     *         transmission and receiving region)
+     */
+    uint64_t GetNHandovers() const;
+
+    /**
+     * @return the number of transmitters that handed over at least one transmission
+     */
+    uint32_t GetNBorderNodes() const;
+
+    /**
+     * Window over which two regions may run apart: a received frame is answered
+     * no earlier than the RX-to-TX turnaround (aTurnaroundTime symbols) after it
+     * ends, and a signal reaches the other region after the propagation delay
+     * over the shortest cross-region distance.
+     *
+     * @param phy A PHY of the network (for the symbol rate)
+     * @param minDistance Shortest distance between two nodes of different regions [m]
+     * @return the lookahead
+     */
+    static Time GetLookahead(Ptr<LrWpanPhy> phy, double minDistance);
+
+  private:
+    class Bridge;
+
+    Ptr<Bridge> m_bridge; //!< In-process delivery of the handed over transmissions
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // NS3_RIT_PARTITION_HELPER_H
@@ -0,0 +1,529 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-performance-predictor.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/lr-wpan-constants.h"
+#include "ns3/mobility-model.h"
+#include "ns3/rit-wpan-net-device.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <unordered_map>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_LOG_COMPONENT_DEFINE("RitPerformancePredictor");
+
+namespace
+{
+
+constexpr double SYMBOL_SECONDS = 16e-6;      //!< O-QPSK 2.4 GHz symbol (62.5 ksymbol/s)
+constexpr uint32_t CCA_SYMBOLS = 8;           //!< Duration of a CCA
+constexpr uint32_t PHY_OVERHEAD_BYTES = 6;    //!< Synchronization and PHY headers
+constexpr uint32_t BEACON_BYTES = 14;         //!< RIT Data Request, broadcast destination
+constexpr uint32_t COMPACT_BEACON_BYTES = 10; //!< RIT Data Request, source address only
+constexpr uint32_t ACK_BYTES = 5;             //!< Immediate ACK
+constexpr uint32_t CSMA_FIRST_BACKOFFS = 8;   //!< 2^macMinBE of the default CSMA-CA
+constexpr uint32_t MAX_ITERATIONS = 200;      //!< Bound of the fixed-point iteration
+constexpr double TOLERANCE = 1e-9;            //!< Relative change ending the iteration
+
+/**
+ * @param f Failure probability of an attempt
+ * @param attempts Attempts allowed
+ * @return the mean number of attempts made
+ */
+double
+MeanAttempts(double f, uint32_t attempts)
+{
+    return f < 1.0 ? (1.0 - std::pow(f, attempts)) / (1.0 - f) : attempts;
+}
+
+/**
+ * @param values The values
+ * @return their mean, 0 without values
+ */
+double
+Mean(const std::vector<double>& values)
+{
+    if (values.empty())
+    {
+        return 0.0;
+    }
+    double sum = 0.0;
+    for (double v : values)
+    {
+        sum += v;
+    }
+    return sum / values.size();
+}
+
+/**
+ * @param values The values
+ * @return their largest value, 0 without values
+ */
+double
+Max(const std::vector<double>& values)
+{
+    return values.empty() ? 0.0 : *std::max_element(values.begin(), values.end());
+}
+
+} // namespace
+
+RitPerformancePredictor::RitPerformancePredictor() = default;
+RitPerformancePredictor::~RitPerformancePredictor() = default;
+
+void
+RitPerformancePredictor::SetModuleConfig(const RitWpanMacModuleConfig& config)
+{
+    m_config = config;
+}
+
+void
+RitPerformancePredictor::SetParameters(const RitPredictorParameters& parameters)
+{
+    m_parameters = parameters;
+}
+
+void
+RitPerformancePredictor::AddNode(const RitPredictorNode& node)
+{
+    m_nodes.push_back(node);
+}
+
+void
+RitPerformancePredictor::AddNodes(NodeContainer nodes, double range, double appRate)
+{
+    NS_ABORT_MSG_IF(range <= 0.0, "The link range must be positive");
+
+    std::vector<RitPredictorNode> added;
+    std::vector<Vector> positions;
+    std::vector<bool> placed;
+    for (auto i = nodes.Begin(); i != nodes.End(); ++i)
+    {
+        Ptr<RitWpanNetDevice> dev;
+        for (uint32_t d = 0; d < (*i)->GetNDevices() && !dev; ++d)
+        {
+            dev = DynamicCast<RitWpanNetDevice>((*i)->GetDevice(d));
+        }
+        if (!dev)
+        {
+            NS_LOG_WARN("Node " << (*i)->GetId() << " has no RitWpanNetDevice. Skipping.");
+            continue;
+        }
+        RitPredictorNode node;
+        node.rank = dev->GetRitRank();
+        node.rxAlwaysOn = dev->GetMac()->GetRxAlwaysOn();
+        node.appRate = node.rank > 0 ? appRate : 0.0;
+        added.push_back(node);
+        Ptr<MobilityModel> mobility = (*i)->GetObject<MobilityModel>();
+        positions.push_back(mobility ? mobility->GetPosition() : Vector());
+        placed.push_back(mobility != nullptr);
+    }
+
+    // Square cells of one range: the neighbours of a node lie in the 3 x 3 cells around it.
+    auto cellOf = [range](const Vector& p) {
+        const auto x = static_cast<int64_t>(std::floor(p.x / range));
+        const auto y = static_cast<int64_t>(std::floor(p.y / range));
+        return std::make_pair(x, y);
+    };
+    auto key = [](int64_t x, int64_t y) {
+        return (static_cast<uint64_t>(x) << 32) ^ static_cast<uint32_t>(y);
+    };
+    std::unordered_map<uint64_t, std::vector<uint32_t>> cells;
+    for (uint32_t k = 0; k < positions.size(); ++k)
+    {
+        if (placed[k])
+        {
+            const auto [x, y] = cellOf(positions[k]);
+            cells[key(x, y)].push_back(k);
+        }
+    }
+    for (uint32_t k = 0; k < positions.size(); ++k)
+    {
+        if (!placed[k])
+        {
+            continue;
+        }
+        const auto [cx, cy] = cellOf(positions[k]);
+        for (int64_t x = cx - 1; x <= cx + 1; ++x)
+        {
+            for (int64_t y = cy - 1; y <= cy + 1; ++y)
+            {
+                auto cell = cells.find(key(x, y));
+                if (cell == cells.end())
+                {
+                    continue;
+                }
+                for (uint32_t j : cell->second)
+                {
+                    if (j != k && CalculateDistance(positions[k], positions[j]) <= range)
+                    {
+                        added[k].neighbours++;
+                    }
+                }
+            }
+        }
+    }
+    m_nodes.insert(m_nodes.end(), added.begin(), added.end());
+}
+
+void
+RitPerformancePredictor::Clear()
+{
+    m_nodes.clear();
+}
+
+uint32_t
+RitPerformancePredictor::GetNNodes() const
+{
+    return m_nodes.size();
+}
+
+Time
+RitPerformancePredictor::GetFrameAirtime(uint32_t psduBytes)
+{
+    // 250 kb/s: 32 us per byte
+    return MicroSeconds(32 * (PHY_OVERHEAD_BYTES + psduBytes));
+}
+
+double
+RitPerformancePredictor::GetPeriod(const RitPredictorNode& node) const
+{
+    return (node.rxAlwaysOn ? m_parameters.alwaysOnRitPeriod : m_parameters.ritPeriod)
+        .GetSeconds();
+}
+
+RitNetworkPrediction
+RitPerformancePredictor::Predict() const
+{
+    RitNetworkPrediction prediction;
+    const uint32_t n = m_nodes.size();
+    prediction.nodes.resize(n);
+    if (n == 0)
+    {
+        return prediction;
+    }
+    const double inf = std::numeric_limits<double>::infinity();
+
+    // Nodes and mean beacon interval of each rank
+    uint16_t maxRank = 0;
+    for (const auto& node : m_nodes)
+    {
+        maxRank = std::max(maxRank, node.rank);
+    }
+    std::vector<std::vector<uint32_t>> byRank(maxRank + 1);
+    for (uint32_t i = 0; i < n; i++)
+    {
+        byRank[m_nodes[i].rank].push_back(i);
+    }
+    std::vector<double> rankPeriod(maxRank + 1, 0.0);
+    for (uint16_t r = 0; r <= maxRank; r++)
+    {
+        for (uint32_t i : byRank[r])
+        {
+            rankPeriod[r] += GetPeriod(m_nodes[i]) / byRank[r].size();
+        }
+    }
+
+    // Airtimes and module effects
+    const double beaconAir =
+        GetFrameAirtime(m_config.compactRitDataRequestEnabled ? COMPACT_BEACON_BYTES
+                                                              : BEACON_BYTES)
+            .GetSeconds();
+    const double turnaround = aTurnaroundTime * SYMBOL_SECONDS;
+    const double exchange = GetFrameAirtime(m_parameters.dataBytes).GetSeconds() + turnaround +
+                            GetFrameAirtime(ACK_BYTES).GetSeconds();
+    const bool dataCs =
+        m_config.dataCsmaEnabled || m_config.dataPreCsEnabled || m_config.dataPreCsBEnabled;
+    const bool beaconCs =
+        m_config.beaconCsmaEnabled || m_config.beaconPreCsEnabled || m_config.beaconPreCsBEnabled;
+    const double slots = m_config.contentionSlotsEnabled ? m_parameters.contentionSlots : 1;
+    const double spread = slots * (dataCs ? CSMA_FIRST_BACKOFFS : 1);
+    const double dataWait = m_parameters.dataWaitDuration.GetSeconds();
+    double capacity = slots;
+    if (m_config.continuousTxEnabled)
+    {
+        capacity *= std::max(1.0, std::floor(dataWait / exchange));
+    }
+    const double twd = m_parameters.txWaitDuration.GetSeconds();
+    const uint32_t attempts = 1 + m_parameters.maxRetries;
+
+    // Fixed point of the attempt rates: the collisions depend on the attempts of the
+    // other children of the parent rank, the attempts on the collisions.
+    std::vector<double> attempt(n, 0.0);
+    std::vector<double> offered(n, 0.0);
+    std::vector<double> failure(n, 1.0);
+    std::vector<double> collision(n, 0.0);
+    std::vector<double> timeout(n, 0.0);
+    for (uint16_t r = 0; r <= maxRank; r++)
+    {
+        for (uint32_t i : byRank[r])
+        {
+            attempt[i] = r > 0 ? m_nodes[i].appRate : 0.0;
+        }
+    }
+    uint32_t iterations = 0;
+    bool converged = false;
+    while (!converged && iterations < MAX_ITERATIONS)
+    {
+        iterations++;
+        std::vector<double> rankAttempts(maxRank + 2, 0.0);
+        for (uint16_t r = 1; r <= maxRank; r++)
+        {
+            for (uint32_t i : byRank[r])
+            {
+                rankAttempts[r] += attempt[i];
+            }
+        }
+        converged = true;
+        double upperSuccess = 0.0; // delivered by rank r + 1 to rank r
+        for (uint16_t r = maxRank; r >= 1; r--)
+        {
+            const double share = byRank[r].empty() ? 0.0 : upperSuccess / byRank[r].size();
+            const std::size_t nParents = byRank[r - 1].size();
+            const double parentPeriod = rankPeriod[r - 1];
+            const double perBeacon = nParents > 0 ? rankAttempts[r] / nParents * parentPeriod : 0;
+            double rankSuccess = 0.0;
+            for (uint32_t i : byRank[r])
+            {
+                offered[i] = m_nodes[i].appRate + share;
+                if (nParents == 0)
+                {
+                    failure[i] = 1.0;
+                }
+                else
+                {
+                    const double others = std::max(0.0, perBeacon - attempt[i] * parentPeriod);
+                    collision[i] = 1.0 - std::exp(-others / spread);
+                    timeout[i] = parentPeriod > twd ? 1.0 - twd / parentPeriod : 0.0;
+                    failure[i] = 1.0 - (1.0 - collision[i]) * (1.0 - timeout[i]);
+                }
+                const double next = offered[i] * MeanAttempts(failure[i], attempts);
+                // damped, the plain iteration may oscillate under heavy load
+                const double damped = 0.5 * (attempt[i] + next);
+                if (std::abs(damped - attempt[i]) > TOLERANCE * (1.0 + attempt[i]))
+                {
+                    converged = false;
+                }
+                attempt[i] = damped;
+                rankSuccess += offered[i] * (1.0 - std::pow(failure[i], attempts));
+            }
+            upperSuccess = rankSuccess;
+        }
+    }
+    prediction.iterations = iterations;
+    NS_LOG_DEBUG("Fixed point " << (converged ? "reached" : "not reached") << " after "
+                                << iterations << " iterations");
+
+    // Receiver side: exchanges answered and the share of the beacon capacity they use
+    std::vector<double> rankUtilisation(maxRank + 1, 0.0);
+    for (uint16_t r = 0; r <= maxRank; r++)
+    {
+        double upperAttempts = 0.0;
+        if (r < maxRank)
+        {
+            for (uint32_t j : byRank[r + 1])
+            {
+                upperAttempts += attempt[j];
+            }
+        }
+        for (uint32_t i : byRank[r])
+        {
+            RitNodePrediction& p = prediction.nodes[i];
+            p.relayRate = upperAttempts / byRank[r].size();
+            p.relayUtilisation = p.relayRate * GetPeriod(m_nodes[i]) / capacity;
+            rankUtilisation[r] += p.relayUtilisation / byRank[r].size();
+        }
+    }
+
+    // Sender side, from the sinks up: delay and delivery over the ranks below
+    const double csTime = (CCA_SYMBOLS + aTurnaroundTime) * SYMBOL_SECONDS;
+    double probeDelay = aTurnaroundTime * SYMBOL_SECONDS;
+    if (m_config.dataCsmaEnabled)
+    {
+        probeDelay += ((CSMA_FIRST_BACKOFFS - 1) * aUnitBackoffPeriod + CCA_SYMBOLS) *
+                      SYMBOL_SECONDS;
+    }
+    else if (dataCs)
+    {
+        probeDelay += CCA_SYMBOLS * SYMBOL_SECONDS;
+    }
+    probeDelay += m_parameters.dataWaitProbeGuard.GetSeconds();
+    const double fullWait =
+        dataWait + (m_config.contentionSlotsEnabled
+                        ? m_parameters.contentionSlotDuration.GetSeconds() * (slots - 1)
+                        : 0.0);
+    const double idleWait = m_config.dataWaitProbeEnabled && !m_config.contentionSlotsEnabled
+                                ? std::min(probeDelay, fullWait)
+                                : fullWait;
+    const double window = beaconCs ? 2 * csTime : 2 * beaconAir;
+
+    std::vector<double> rankDelay(maxRank + 1, 0.0);
+    std::vector<double> rankDelivery(maxRank + 1, 1.0);
+    for (uint16_t r = 0; r <= maxRank; r++)
+    {
+        const double parentPeriod = r > 0 ? rankPeriod[r - 1] : 0.0;
+        const double parentUtilisation = r > 0 ? rankUtilisation[r - 1] : 0.0;
+        double delaySum = 0.0;
+        double deliverySum = 0.0;
+        for (uint32_t i : byRank[r])
+        {
+            const RitPredictorNode& node = m_nodes[i];
+            RitNodePrediction& p = prediction.nodes[i];
+            const double period = GetPeriod(node);
+            p.offeredRate = offered[i];
+            p.attemptRate = attempt[i];
+            p.dataCollision = collision[i];
+            p.txWaitTimeout = timeout[i];
+            if (r == 0)
+            {
+                p.deliveryProbability = 1.0;
+            }
+            else if (failure[i] >= 1.0)
+            {
+                p.rendezvousDelay = inf;
+                p.pathDelay = inf;
+                p.deliveryProbability = 0.0;
+            }
+            else
+            {
+                // M/D/1 wait behind the other senders of the parent beacons
+                const double queueing =
+                    parentUtilisation < 1.0
+                        ? parentUtilisation / (2 * (1.0 - parentUtilisation)) * parentPeriod
+                        : inf;
+                p.rendezvousDelay = parentPeriod / 2 + exchange +
+                                    (MeanAttempts(failure[i], attempts) - 1.0) * parentPeriod +
+                                    queueing;
+                p.pathDelay = rankDelay[r - 1] + p.rendezvousDelay;
+                p.deliveryProbability =
+                    rankDelivery[r - 1] * (1.0 - std::pow(failure[i], attempts));
+            }
+            delaySum += p.pathDelay;
+            deliverySum += p.deliveryProbability;
+
+            if (node.rxAlwaysOn)
+            {
+                p.wakeRatio = 1.0;
+            }
+            else
+            {
+                const double busy = 1.0 - std::exp(-p.relayRate * period);
+                const double cycle = beaconAir + (beaconCs ? csTime : 0.0) + turnaround +
+                                     busy * fullWait + (1.0 - busy) * idleWait;
+                double listen = 0.0;
+                if (r > 0)
+                {
+                    listen = m_config.phaseLearningEnabled
+                                 ? std::min(m_parameters.phaseLearningGuard.GetSeconds(),
+                                            parentPeriod / 2)
+                                 : std::min(parentPeriod / 2, twd);
+                }
+                p.wakeRatio = std::min(1.0,
+                                       cycle / period + p.relayRate * exchange +
+                                           attempt[i] * (listen + exchange));
+            }
+
+            const bool deconflicted =
+                m_config.beaconDeconflictionEnabled &&
+                node.neighbours * m_parameters.beaconDeconflictGap.GetSeconds() <= period;
+            p.beaconCollision =
+                deconflicted
+                    ? 0.0
+                    : 1.0 - std::pow(1.0 - std::min(1.0, window / period), node.neighbours);
+        }
+        if (!byRank[r].empty())
+        {
+            rankDelay[r] = delaySum / byRank[r].size();
+            rankDelivery[r] = deliverySum / byRank[r].size();
+        }
+    }
+
+    // Network figures
+    std::vector<double> wake;
+    std::vector<double> delay;
+    std::vector<double> delivery;
+    std::vector<double> beacon;
+    std::vector<double> utilisation;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        const RitPredictorNode& node = m_nodes[i];
+        const RitNodePrediction& p = prediction.nodes[i];
+        if (!node.rxAlwaysOn)
+        {
+            wake.push_back(p.wakeRatio);
+        }
+        if (node.rank > 0)
+        {
+            beacon.push_back(p.beaconCollision);
+            if (node.appRate > 0)
+            {
+                delay.push_back(p.pathDelay);
+                delivery.push_back(p.deliveryProbability);
+            }
+        }
+        utilisation.push_back(p.relayUtilisation);
+    }
+    prediction.wakeRatioMean = Mean(wake);
+    prediction.wakeRatioMax = Max(wake);
+    prediction.delayMean = Mean(delay);
+    prediction.delayMax = Max(delay);
+    prediction.pdr = Mean(delivery);
+    prediction.beaconCollisionMean = Mean(beacon);
+    prediction.relayUtilisationMax = Max(utilisation);
+    prediction.saturated = prediction.relayUtilisationMax >= 1.0;
+    return prediction;
+}
+
+void
+RitPerformancePredictor::WriteSummary(const RitNetworkPrediction& prediction, std::ostream& os)
+{
+    os << std::setprecision(10);
+    os << "key,value\n";
+    os << "pred_wake_ratio_mean," << prediction.wakeRatioMean << "\n";
+    os << "pred_wake_ratio_max," << prediction.wakeRatioMax << "\n";
+    os << "pred_delay_mean," << prediction.delayMean << "\n";
+    os << "pred_delay_max," << prediction.delayMax << "\n";
+    os << "pred_pdr," << prediction.pdr << "\n";
+    os << "pred_beacon_collision_mean," << prediction.beaconCollisionMean << "\n";
+    os << "pred_relay_utilisation_max," << prediction.relayUtilisationMax << "\n";
+    os << "pred_saturated," << (prediction.saturated ? 1 : 0) << "\n";
+    os << "pred_iterations," << prediction.iterations << "\n";
+    os << "pred_node_count," << prediction.nodes.size() << "\n";
+}
+
+void
+RitPerformancePredictor::WriteNodes(const RitNetworkPrediction& prediction, std::ostream& os) const
+{
+    NS_ASSERT(prediction.nodes.size() == m_nodes.size());
+    os << std::setprecision(10);
+    os << "index,rank,neighbours,rx_always_on,offered_rate,attempt_rate,relay_rate,wake_ratio,"
+          "rendezvous_delay,path_delay,beacon_collision,data_collision,tx_wait_timeout,"
+          "relay_utilisation,delivery\n";
+    for (uint32_t i = 0; i < m_nodes.size(); i++)
+    {
+        const RitPredictorNode& node = m_nodes[i];
+        const RitNodePrediction& p = prediction.nodes[i];
+        os << i << "," << node.rank << "," << node.neighbours << "," << node.rxAlwaysOn << ","
+           << p.offeredRate << "," << p.attemptRate << "," << p.relayRate << "," << p.wakeRatio
+           << "," << p.rendezvousDelay << "," << p.pathDelay << "," << p.beaconCollision << ","
+           << p.dataCollision << "," << p.txWaitTimeout << "," << p.relayUtilisation << ","
+           << p.deliveryProbability << "\n";
+    }
+}
+
+} // namespace lrwpan
+} // namespace ns3
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef NS3_RIT_PERFORMANCE_PREDICTOR_H
+#define NS3_RIT_PERFORMANCE_PREDICTOR_H
+
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+#include "ns3/rit-wpan-mac.h"
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * RIT timing and frame parameters of a predicted network.
+ */
+struct RitPredictorParameters
+{
+    Time ritPeriod = Seconds(5);                    //!< Beacon interval of the routers (BI)
+    Time alwaysOnRitPeriod = Seconds(5);            //!< Beacon interval of the RxAlwaysOn nodes
+    Time dataWaitDuration = MilliSeconds(10);       //!< Receiver data wait after a beacon (DWD)
+    Time txWaitDuration = MilliSeconds(5000);       //!< Sender wait for the beacon (TWD)
+    uint32_t dataBytes = 30;                        //!< PSDU of a data frame [bytes]
+    uint32_t maxRetries = 0;                        //!< Attempts after a failed exchange
+    uint32_t contentionSlots = 4;                   //!< Response slots (contentionSlotsEnabled)
+    Time contentionSlotDuration = MilliSeconds(6);  //!< Length of a response slot
+    Time phaseLearningGuard = MilliSeconds(2);      //!< Sender listen time (phaseLearningEnabled)
+    Time dataWaitProbeGuard = MicroSeconds(320);    //!< Slack of the data wait probe
+    Time beaconDeconflictGap = MilliSeconds(20);    //!< Gap kept (beaconDeconflictionEnabled)
+};
+
+/**
+ * A node of a predicted network.
+ */
+struct RitPredictorNode
+{
+    uint16_t rank = 1;       //!< Hops to a sink, 0 for a sink
+    uint32_t neighbours = 0; //!< Nodes within link range
+    double appRate = 0.0;    //!< Packets generated per second
+    bool rxAlwaysOn = false; //!< Receiver always on (sinks, mains-powered routers)
+};
+
+/**
+ * Predicted performance of a node.
+ */
+struct RitNodePrediction
+{
+    double offeredRate = 0.0;         //!< Own and relayed packets per second
+    double attemptRate = 0.0;         //!< Exchanges started per second, retries included
+    double relayRate = 0.0;           //!< Exchanges answered per second as a receiver
+    double wakeRatio = 0.0;           //!< Share of the time the transceiver is on
+    double rendezvousDelay = 0.0;     //!< Expected time from the queue to the parent ACK [s]
+    double pathDelay = 0.0;           //!< Expected time to a sink [s]
+    double beaconCollision = 0.0;     //!< Probability that a beacon overlaps a neighbour one
+    double dataCollision = 0.0;       //!< Probability that an exchange meets another sender
+    double txWaitTimeout = 0.0;       //!< Probability that TWD ends before the parent beacon
+    double relayUtilisation = 0.0;    //!< Share of the exchanges a beacon can serve in use
+    double deliveryProbability = 0.0; //!< Probability that a packet reaches a sink
+};
+
+/**
+ * Predicted performance of a network.
+ */
+struct RitNetworkPrediction
+{
+    std::vector<RitNodePrediction> nodes; //!< Per node, in the order they were added
+    double wakeRatioMean = 0.0;           //!< Mean wake ratio of the duty-cycled nodes
+    double wakeRatioMax = 0.0;            //!< Largest wake ratio of a duty-cycled node
+    double delayMean = 0.0;               //!< Mean path delay of the sources [s]
+    double delayMax = 0.0;                //!< Largest path delay of a source [s]
+    double pdr = 0.0;                     //!< Mean delivery probability of the sources
+    double beaconCollisionMean = 0.0;     //!< Mean beacon collision probability of the routers
+    double relayUtilisationMax = 0.0;     //!< Largest relay utilisation
+    bool saturated = false;               //!< A relay gets more than its beacons can serve
+    uint32_t iterations = 0;              //!< Fixed-point iterations run
+};
+
+/**
+ * Closed-form and fixed-point estimates of the performance of a RIT network, to
+ * screen the points of a parameter sweep before simulating them.
+ *
+ * The network is described by its nodes (rank, neighbour count, application rate),
+ * the RIT timing and the module configuration of the MAC. The traffic of each rank
+ * is shared evenly by the nodes of the rank below. A sender waits half a parent
+ * beacon interval on average (a uniform beacon phase), one interval more per retry,
+ * and fails when TWD ends first. The senders answering one beacon collide as Poisson
+ * arrivals spread over the response slots and, with data CSMA or a pre-CS, over the
+ * 2^macMinBE first backoffs. A relay serves one exchange per beacon (one per slot
+ * with contentionSlotsEnabled, a DWD worth of frames of one sender with
+ * continuousTxEnabled), and the queueing behind its beacons is that of an M/D/1
+ * queue. The collisions raise the attempt rates, which raise the collisions: the
+ * attempt rates are iterated to a fixed point.
+ *
+ * The wake ratio of a duty-cycled node adds its beacons (and their carrier sense),
+ * its data waits (cut to the probe delay on idle cycles with dataWaitProbeEnabled)
+ * and the exchanges it answers, to the listen time and exchanges of its own
+ * attempts (the phase learning guard instead of half a parent interval with
+ * phaseLearningEnabled). A beacon collides when another beacon of the same interval
+ * starts within its vulnerable window: two beacon airtimes, or two carrier sense
+ * and turnaround times with a beacon carrier sense. beaconDeconflictionEnabled
+ * removes the collisions of the routers whose neighbour beacons fit an interval.
+ *
+ * The estimates ignore hidden terminals, capture, overhearing and the other modules;
+ * they order the points of a sweep, they do not replace its runs.
+ */
+class RitPerformancePredictor
+{
+  public:
+    RitPerformancePredictor();
+    ~RitPerformancePredictor();
+
+    /**
+     * Set the MAC modules of the network.
+     *
+     * @param config The module configuration of the routers
+     */
+    void SetModuleConfig(const RitWpanMacModuleConfig& config);
+
+    /**
+     * Set the RIT timing and frame parameters.
+     *
+     * @param parameters The parameters
+     */
+    void SetParameters(const RitPredictorParameters& parameters);
+
+    /**
+     * Add a node.
+     *
+     * @param node The node
+     */
+    void AddNode(const RitPredictorNode& node);
+
+    /**
+     * Add the nodes of an installed network: the rank and RxAlwaysOn of their
+     * RitWpanNetDevice, the other nodes of the container within range as neighbours.
+     * The nodes without a RitWpanNetDevice are skipped.
+     *
+     * @param nodes The nodes, sinks included
+     * @param range The link range [m]
+     * @param appRate Packets generated per second by each router
+     */
+    void AddNodes(NodeContainer nodes, double range, double appRate);
+
+    /**
+     * Remove the nodes.
+     */
+    void Clear();
+
+    /**
+     * Get the number of nodes.
+     *
+     * @return the number of nodes
+     */
+    uint32_t GetNNodes() const;
+
+    /**
+     * Predict the performance of the network.
+     *
+     * @return the prediction
+     */
+    RitNetworkPrediction Predict() const;
+
+    /**
+     * Write the network figures of a prediction as key,value lines (pred_* keys, like
+     * scenario-summary.csv).
+     *
+     * @param prediction The prediction
+     * @param os The output stream
+     */
+    static void WriteSummary(const RitNetworkPrediction& prediction, std::ostream& os);
+
+    /**
+     * Write the node figures of a prediction as CSV, one line per node.
+     *
+     * @param prediction The prediction
+     * @param os The output stream
+     */
+    void WriteNodes(const RitNetworkPrediction& prediction, std::ostream& os) const;
+
+    /**
+     * Get the airtime of a frame at 250 kb/s.
+     *
+     * @param psduBytes PSDU of the frame [bytes]
+     * @return the airtime, synchronization header and PHY header included
+     */
+    static Time GetFrameAirtime(uint32_t psduBytes);
+
+  private:
+    /**
+     * Get the beacon interval of a node.
+     *
+     * @param node The node
+     * @return the interval [s]
+     */
+    double GetPeriod(const RitPredictorNode& node) const;
+
+    RitWpanMacModuleConfig m_config;       //!< MAC modules of the routers
+    RitPredictorParameters m_parameters;   //!< RIT timing and frame parameters
+    std::vector<RitPredictorNode> m_nodes; //!< Nodes of the network
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // NS3_RIT_PERFORMANCE_PREDICTOR_H
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-progress-reporter.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/rit-wpan-net-device.h"
+#include "ns3/simulator.h"
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <unistd.h>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_LOG_COMPONENT_DEFINE("RitProgressReporter");
+
+RitProgressReporter::RitProgressReporter()
+    : m_interval(Hours(1)),
+      m_nodes(0),
+      m_senders(0),
+      m_queuedFrames(0),
+      m_eventsLast(0)
+{
+}
+
+void
+RitProgressReporter::SetInterval(Time interval)
+{
+    NS_ABORT_MSG_UNLESS(interval.IsStrictlyPositive(), "Invalid progress report interval");
+    m_interval = interval;
+}
+
+void
+RitProgressReporter::SetOutput(const std::string& path)
+{
+    m_path = path;
+}
+
+void
+RitProgressReporter::SetCollector(Ptr<RitMetricsCollector> collector)
+{
+    m_collector = collector;
+}
+
+void
+RitProgressReporter::Install(Ptr<Node> node)
+{
+    NS_LOG_FUNCTION(this << node->GetId());
+    Ptr<RitProgressReporter> self(this);
+    for (uint32_t j = 0; j < node->GetNDevices(); ++j)
+    {
+        Ptr<RitWpanNetDevice> dev = DynamicCast<RitWpanNetDevice>(node->GetDevice(j));
+        if (!dev)
+        {
+            continue;
+        }
+        Ptr<RitWpanMac> mac = dev->GetMac();
+        mac->TraceConnectWithoutContext("MacMode", MakeBoundCallback(&MacModeSink, self));
+        mac->TraceConnectWithoutContext("TxQueueOccupancy",
+                                        MakeBoundCallback(&QueueOccupancySink, self));
+        m_nodes++;
+        break;
+    }
+}
+
+void
+RitProgressReporter::MacModeSink(Ptr<RitProgressReporter> reporter,
+                                 RitMacMode oldMode,
+                                 RitMacMode newMode)
+{
+    if (oldMode == SENDER_MODE || oldMode == STROBE_MODE)
+    {
+        reporter->m_senders--;
+    }
+    if (newMode == SENDER_MODE || newMode == STROBE_MODE)
+    {
+        reporter->m_senders++;
+    }
+}
+
+void
+RitProgressReporter::QueueOccupancySink(Ptr<RitProgressReporter> reporter,
+                                        uint32_t oldValue,
+                                        uint32_t newValue)
+{
+    reporter->m_queuedFrames = reporter->m_queuedFrames + newValue - oldValue;
+}
+
+uint64_t
+RitProgressReporter::GetRssKb()
+{
+    std::ifstream statm("/proc/self/statm");
+    uint64_t size = 0;
+    uint64_t resident = 0;
+    if (!(statm >> size >> resident))
+    {
+        return 0;
+    }
+    return resident * static_cast<uint64_t>(sysconf(_SC_PAGESIZE)) / 1024;
+}
+
+void
+RitProgressReporter::Start()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_path.empty())
+    {
+        m_out.open(m_path, std::ios::out | std::ios::trunc);
+        NS_ABORT_MSG_UNLESS(m_out.is_open(), "Unable to open progress file " << m_path);
+    }
+    m_wallStart = std::chrono::steady_clock::now();
+    m_wallLast = m_wallStart;
+    m_eventsLast = Simulator::GetEventCount();
+    m_simStart = Simulator::Now();
+    Ptr<RitProgressReporter> self(this);
+    Simulator::Schedule(m_interval, &RitProgressReporter::PeriodicReport, self);
+    Simulator::ScheduleDestroy(&RitProgressReporter::Report, self, true);
+}
+
+void
+RitProgressReporter::PeriodicReport()
+{
+    Report(false);
+    Simulator::Schedule(m_interval,
+                        &RitProgressReporter::PeriodicReport,
+                        Ptr<RitProgressReporter>(this));
+}
+
+void
+RitProgressReporter::Report(bool last)
+{
+    const auto wallNow = std::chrono::steady_clock::now();
+    const double wall = std::chrono::duration<double>(wallNow - m_wallStart).count();
+    const double wallDelta = std::chrono::duration<double>(wallNow - m_wallLast).count();
+    const uint64_t events = Simulator::GetEventCount();
+    const double sim = (Simulator::Now() - m_simStart).GetSeconds();
+    const double ratio = wall > 0.0 ? sim / wall : 0.0;
+    const double eventRate = wallDelta > 0.0 ? (events - m_eventsLast) / wallDelta : 0.0;
+    const double queueDepth = m_nodes > 0 ? static_cast<double>(m_queuedFrames) / m_nodes : 0.0;
+    double pdr = -1.0;
+    if (m_collector)
+    {
+        const RitMetricsCollector::Totals totals = m_collector->GetTotals();
+        if (totals.txUnique > 0)
+        {
+            pdr = static_cast<double>(totals.delivered) / totals.txUnique;
+        }
+    }
+    m_wallLast = wallNow;
+    m_eventsLast = events;
+
+    std::ostringstream line;
+    line << std::setprecision(6);
+    if (m_out.is_open())
+    {
+        line << "{\"sim_time\":" << Simulator::Now().GetSeconds() << ",\"wall_time\":" << wall
+             << ",\"sim_wall_ratio\":" << ratio << ",\"events\":" << events
+             << ",\"events_per_s\":" << eventRate << ",\"rss_kb\":" << GetRssKb()
+             << ",\"queue_depth\":" << queueDepth << ",\"senders\":" << m_senders
+             << ",\"nodes\":" << m_nodes << ",\"pdr\":";
+        if (pdr >= 0.0)
+        {
+            line << pdr;
+        }
+        else
+        {
+            line << "null";
+        }
+        line << ",\"final\":" << (last ? "true" : "false") << "}\n";
+        m_out << line.str() << std::flush;
+        return;
+    }
+    line << "[PROGRESS] sim " << Simulator::Now().As(Time::S) << " | wall " << wall << " s"
+         << " | x" << ratio << " | " << eventRate << " ev/s | RSS " << GetRssKb() << " kB"
+         << " | queue " << queueDepth << " | senders " << m_senders << "/" << m_nodes;
+    if (pdr >= 0.0)
+    {
+        line << " | PDR " << pdr;
+    }
+    if (last)
+    {
+        line << " | done";
+    }
+    std::cerr << line.str() << std::endl;
+}
+
+} // namespace lrwpan
+} // namespace ns3
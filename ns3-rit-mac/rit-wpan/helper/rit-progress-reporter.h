@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef RIT_PROGRESS_REPORTER_H
+#define RIT_PROGRESS_REPORTER_H
+
+#include "ns3/node.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/rit-metrics-collector.h"
+#include "ns3/rit-wpan-mac.h"
+#include "ns3/simple-ref-count.h"
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @ingroup lrwpan
+ *
+ * @brief Low-frequency progress report of a running simulation.
+ *
+ * Every report interval (simulated time) one line gives the simulated time, the
+ * wall time, their ratio, the events executed and the events per wall second since
+ * the previous report, the resident set size, the mean MAC TX queue depth, the nodes
+ * in SENDER_MODE or STROBE_MODE and, with a RitMetricsCollector, the cumulative PDR.
+ * The line goes to stderr, or as a JSON object to a JSON-lines file, flushed at once so
+ * that a sweep driver can watch it. A last line is written at Simulator::Destroy().
+ */
+class RitProgressReporter : public SimpleRefCount<RitProgressReporter>
+{
+  public:
+    RitProgressReporter();
+
+    /**
+     * @param interval Simulated time between two reports (default 1 h)
+     */
+    void SetInterval(Time interval);
+
+    /**
+     * @param path JSON-lines file of the reports (empty: readable lines on stderr)
+     */
+    void SetOutput(const std::string& path);
+
+    /**
+     * @param collector Collector giving the cumulative PDR (none by default)
+     */
+    void SetCollector(Ptr<RitMetricsCollector> collector);
+
+    /**
+     * @brief Follow the MAC mode and TX queue of the RitWpanNetDevice of a node.
+     * @param node Node to follow
+     */
+    void Install(Ptr<Node> node);
+
+    /**
+     * @brief Schedule the first report and the last one at Simulator::Destroy().
+     */
+    void Start();
+
+    /**
+     * @brief Resident set size of the process.
+     * @return the resident set size [kB] (0 where /proc is not available)
+     */
+    static uint64_t GetRssKb();
+
+  private:
+    /**
+     * @brief Write a report.
+     * @param last Whether it is the report of Simulator::Destroy()
+     */
+    void Report(bool last);
+
+    /**
+     * @brief Write a report and schedule the next one.
+     */
+    void PeriodicReport();
+
+    static void MacModeSink(Ptr<RitProgressReporter> reporter,
+                            RitMacMode oldMode,
+                            RitMacMode newMode);
+    static void QueueOccupancySink(Ptr<RitProgressReporter> reporter,
+                                   uint32_t oldValue,
+                                   uint32_t newValue);
+
+    Time m_interval;                                      //!< Report interval
+    std::string m_path;                                   //!< JSON-lines file, or stderr
+    std::ofstream m_out;                                  //!< Open JSON-lines file
+    Ptr<RitMetricsCollector> m_collector;                 //!< Source of the PDR, or null
+    uint32_t m_nodes;                                     //!< Nodes followed
+    uint32_t m_senders;                                   //!< Nodes in SENDER/STROBE_MODE
+    uint64_t m_queuedFrames;                              //!< Frames in all TX queues
+    std::chrono::steady_clock::time_point m_wallStart;    //!< Wall time of Start()
+    std::chrono::steady_clock::time_point m_wallLast;     //!< Wall time of the last report
+    uint64_t m_eventsLast;                                //!< Events at the last report
+    Time m_simStart;                                      //!< Simulated time of Start()
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // RIT_PROGRESS_REPORTER_H
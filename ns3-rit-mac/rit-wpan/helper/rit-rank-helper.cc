@@ -8,9 +8,17 @@
 
 #include "rit-rank-helper.h"
 
+#include "ns3/abort.h"
 #include "ns3/log.h"
+#include "ns3/mobility-model.h"
 #include "ns3/rit-wpan-net-device.h"
+#include "ns3/rit-wpan-nwk.h"
+#include "ns3/simulator.h"
 
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <unordered_map>
 #include <vector>
 
 namespace ns3
@@ -137,5 +145,134 @@ RitWpanRankHelper::Install(NodeContainer c, const std::vector<uint8_t>& rankList
                                      << ").");
 }
 
+void
+RitWpanRankHelper::Install(NodeContainer c, NodeContainer sinks, double range) const
+{
+    NS_ABORT_MSG_IF(sinks.GetN() + c.GetN() > 0xFFFE,
+                    "Too many nodes for the 16-bit short addresses");
+    NS_ABORT_MSG_IF(range <= 0.0, "The hop range must be positive");
+
+    // Breadth-first search from all the sinks at once over the unit-disk graph.
+    // The routers are bucketed in square cells of one range, so the neighbours of
+    // a node lie in the 3 x 3 cells around it.
+    std::vector<Ptr<MobilityModel>> mobilities;
+    for (auto i = sinks.Begin(); i != sinks.End(); ++i)
+    {
+        mobilities.push_back((*i)->GetObject<MobilityModel>());
+    }
+    for (auto i = c.Begin(); i != c.End(); ++i)
+    {
+        mobilities.push_back((*i)->GetObject<MobilityModel>());
+    }
+    std::vector<Vector> positions(mobilities.size());
+    for (uint32_t k = 0; k < mobilities.size(); ++k)
+    {
+        if (mobilities[k])
+        {
+            positions[k] = mobilities[k]->GetPosition();
+        }
+    }
+
+    auto cellOf = [range](const Vector& p) {
+        const auto x = static_cast<int64_t>(std::floor(p.x / range));
+        const auto y = static_cast<int64_t>(std::floor(p.y / range));
+        return std::make_pair(x, y);
+    };
+    auto key = [](int64_t x, int64_t y) {
+        return (static_cast<uint64_t>(x) << 32) ^ static_cast<uint32_t>(y);
+    };
+    const uint32_t nSinks = sinks.GetN();
+    std::unordered_map<uint64_t, std::vector<uint32_t>> cells;
+    for (uint32_t j = nSinks; j < positions.size(); ++j)
+    {
+        if (mobilities[j])
+        {
+            const auto [x, y] = cellOf(positions[j]);
+            cells[key(x, y)].push_back(j);
+        }
+    }
+
+    constexpr uint32_t unreached = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> hops(positions.size(), unreached);
+    std::deque<uint32_t> frontier;
+    for (uint32_t k = 0; k < nSinks; ++k)
+    {
+        if (mobilities[k])
+        {
+            hops[k] = 0;
+            frontier.push_back(k);
+        }
+    }
+    while (!frontier.empty())
+    {
+        const uint32_t k = frontier.front();
+        frontier.pop_front();
+        const auto [cx, cy] = cellOf(positions[k]);
+        for (int64_t x = cx - 1; x <= cx + 1; ++x)
+        {
+            for (int64_t y = cy - 1; y <= cy + 1; ++y)
+            {
+                auto cell = cells.find(key(x, y));
+                if (cell == cells.end())
+                {
+                    continue;
+                }
+                for (uint32_t j : cell->second)
+                {
+                    if (hops[j] == unreached &&
+                        CalculateDistance(positions[k], positions[j]) <= range)
+                    {
+                        hops[j] = hops[k] + 1;
+                        frontier.push_back(j);
+                    }
+                }
+            }
+        }
+    }
+
+    uint32_t assigned = 0;
+    uint16_t nodeId = static_cast<uint16_t>(nSinks);
+    for (uint32_t j = nSinks; j < positions.size(); ++j, ++nodeId)
+    {
+        Ptr<Node> node = c.Get(j - nSinks);
+        auto dev = FindRitWpanDevice(node);
+        if (!dev)
+        {
+            NS_LOG_WARN("Node " << nodeId << " has no RitWpanNetDevice. Skipping.");
+            continue;
+        }
+        dev->SetAddress(nodeId);
+        if (hops[j] == unreached || hops[j] > 0xFF)
+        {
+            NS_LOG_WARN("Node " << nodeId << " cannot reach a sink within " << range
+                                << " m. Rank not set.");
+            continue;
+        }
+        dev->SetRitRank(static_cast<uint8_t>(hops[j]));
+        ++assigned;
+    }
+
+    NS_LOG_INFO("Assigned ranks to " << assigned << " nodes from " << nSinks << " sinks.");
+}
+
+void
+RitWpanRankHelper::Bootstrap(NodeContainer c, Time start) const
+{
+    for (auto i = c.Begin(); i != c.End(); ++i)
+    {
+        Ptr<Node> node = *i;
+        auto dev = FindRitWpanDevice(node);
+        if (!dev)
+        {
+            NS_LOG_WARN("Node " << node->GetId() << " has no RitWpanNetDevice. Skipping.");
+            continue;
+        }
+        Simulator::ScheduleWithContext(node->GetId(),
+                                       start,
+                                       &RitSimpleRouting::Bootstrap,
+                                       dev->GetNwk());
+    }
+}
+
 } // namespace lrwpan
 } // namespace ns3
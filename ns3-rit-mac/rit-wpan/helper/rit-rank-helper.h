@@ -13,6 +13,7 @@
 #define NS3_RIT_WPAN_RANK_HELPER_H
 
 #include "ns3/node-container.h"
+#include "ns3/nstime.h"
 
 #include <cstdint>
 #include <vector>
@@ -50,6 +51,30 @@ class RitWpanRankHelper
      * A rank value of 0 is treated as invalid and skipped.
      */
     void Install(NodeContainer c, const std::vector<uint8_t>& rankList) const;
+
+    /**
+     * Assign ranks as the hop count to the nearest sink, two nodes being
+     * neighbours when their MobilityModel positions are at most range apart.
+     * Nodes are numbered after the sinks (first address = number of sinks), as
+     * set by RitWpanNetHelper::InstallSinks(). Nodes that cannot reach any sink
+     * keep their rank. The search buckets the nodes in cells of one range, so it
+     * takes linear time for layouts of bounded density (see RitTopologyHelper).
+     *
+     * @param c Router nodes
+     * @param sinks Sink nodes (rank 0)
+     * @param range Largest distance of a hop [m]
+     */
+    void Install(NodeContainer c, NodeContainer sinks, double range) const;
+
+    /**
+     * Let the nodes discover their ranks from the beacons of their neighbours
+     * (RitSimpleRouting::Bootstrap()), replacing any rank set by Install().
+     * Addresses are not changed.
+     *
+     * @param c Nodes to bootstrap (not the sink, which keeps rank 0)
+     * @param start Time of the Bootstrap() calls
+     */
+    void Bootstrap(NodeContainer c, Time start) const;
 };
 
 } // namespace lrwpan
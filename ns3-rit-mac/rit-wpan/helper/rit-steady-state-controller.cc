@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-steady-state-controller.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_LOG_COMPONENT_DEFINE("RitSteadyStateController");
+
+namespace
+{
+
+/**
+ * 0.975 quantile of the Student t distribution with df degrees of freedom.
+ */
+double
+StudentT975(uint32_t df)
+{
+    static const double table[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306,
+                                   2.262,  2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120,
+                                   2.110,  2.101, 2.093, 2.086, 2.080, 2.074, 2.069, 2.064,
+                                   2.060,  2.056, 2.052, 2.048, 2.045, 2.042};
+    if (df == 0)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+    if (df <= 30)
+    {
+        return table[df - 1];
+    }
+    // Within 0.005 of the exact quantile past 30 degrees of freedom
+    return 1.96 + 2.4 / df;
+}
+
+} // namespace
+
+RitSteadyStateController::RitSteadyStateController(Ptr<RitMetricsCollector> collector)
+    : m_collector(collector),
+      m_interval(Minutes(10)),
+      m_target(0.05),
+      m_batches(20),
+      m_minObservations(200),
+      m_converged(false)
+{
+    NS_ABORT_MSG_IF(!collector, "RitSteadyStateController needs a metrics collector");
+    for (bool& enabled : m_enabled)
+    {
+        enabled = true;
+    }
+}
+
+void
+RitSteadyStateController::SetObservationInterval(Time interval)
+{
+    NS_ABORT_MSG_UNLESS(interval.IsStrictlyPositive(), "Invalid observation interval");
+    m_interval = interval;
+}
+
+void
+RitSteadyStateController::SetTarget(double halfWidth)
+{
+    m_target = halfWidth;
+}
+
+void
+RitSteadyStateController::SetBatches(uint32_t batches)
+{
+    NS_ABORT_MSG_IF(batches < 2, "Batch means need at least 2 batches");
+    m_batches = batches;
+}
+
+void
+RitSteadyStateController::SetMinObservations(uint32_t observations)
+{
+    m_minObservations = observations;
+}
+
+void
+RitSteadyStateController::SetMetric(Metric metric, bool enabled)
+{
+    NS_ABORT_MSG_IF(metric >= METRIC_COUNT, "Unknown metric");
+    m_enabled[metric] = enabled;
+}
+
+void
+RitSteadyStateController::Start()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_UNLESS(m_enabled[PDR] || m_enabled[DELAY] || m_enabled[WAKE_RATIO],
+                        "No metric selected for the steady-state stop");
+    m_last = m_collector->GetTotals();
+    m_start = Simulator::Now();
+    Simulator::Schedule(m_interval,
+                        &RitSteadyStateController::Observe,
+                        Ptr<RitSteadyStateController>(this));
+}
+
+bool
+RitSteadyStateController::IsConverged() const
+{
+    return m_converged;
+}
+
+std::string
+RitSteadyStateController::GetMetricName(Metric metric)
+{
+    switch (metric)
+    {
+    case PDR:
+        return "pdr";
+    case DELAY:
+        return "delay";
+    case WAKE_RATIO:
+        return "wake_ratio";
+    default:
+        return "unknown";
+    }
+}
+
+size_t
+RitSteadyStateController::MserTruncation(const std::vector<double>& y)
+{
+    constexpr size_t batchSize = 5;
+    const size_t m = y.size() / batchSize;
+    if (m < 2)
+    {
+        return y.size();
+    }
+    std::vector<double> z(m);
+    for (size_t j = 0; j < m; j++)
+    {
+        double sum = 0.0;
+        for (size_t i = 0; i < batchSize; i++)
+        {
+            sum += y[j * batchSize + i];
+        }
+        z[j] = sum / batchSize;
+    }
+
+    // Suffix sums give the MSER statistic of every truncation in one pass
+    double sum = 0.0;
+    double sq = 0.0;
+    size_t best = m;
+    double bestMser = std::numeric_limits<double>::infinity();
+    std::vector<double> mser(m);
+    for (size_t d = m; d-- > 0;)
+    {
+        sum += z[d];
+        sq += z[d] * z[d];
+        const double n = m - d;
+        const double variance = std::max(0.0, sq - sum * sum / n);
+        mser[d] = variance / (n * n);
+    }
+    for (size_t d = 0; d <= m / 2; d++)
+    {
+        if (mser[d] < bestMser)
+        {
+            bestMser = mser[d];
+            best = d;
+        }
+    }
+    // A minimum at the end of the search range: the warm-up is not over
+    if (best == m / 2)
+    {
+        return y.size();
+    }
+    return best * batchSize;
+}
+
+bool
+RitSteadyStateController::BatchMeans(const std::vector<double>& y,
+                                     uint32_t batches,
+                                     double& mean,
+                                     double& halfWidth)
+{
+    const size_t batchSize = batches > 0 ? y.size() / batches : 0;
+    if (batchSize == 0)
+    {
+        return false;
+    }
+    // The oldest observations left over are the closest to the warm-up
+    const size_t first = y.size() - batchSize * batches;
+    std::vector<double> means(batches);
+    double grand = 0.0;
+    for (uint32_t b = 0; b < batches; b++)
+    {
+        double sum = 0.0;
+        for (size_t i = 0; i < batchSize; i++)
+        {
+            sum += y[first + b * batchSize + i];
+        }
+        means[b] = sum / batchSize;
+        grand += means[b];
+    }
+    grand /= batches;
+    double sq = 0.0;
+    for (double v : means)
+    {
+        sq += (v - grand) * (v - grand);
+    }
+    mean = grand;
+    halfWidth = StudentT975(batches - 1) * std::sqrt(sq / (batches - 1) / batches);
+    return true;
+}
+
+void
+RitSteadyStateController::Observe()
+{
+    NS_LOG_FUNCTION(this);
+    const RitMetricsCollector::Totals totals = m_collector->GetTotals();
+    const Time now = Simulator::Now();
+    const uint64_t tx = totals.txUnique - m_last.txUnique;
+    const uint64_t delivered = totals.delivered - m_last.delivered;
+    const Time phy = totals.phyTime - m_last.phyTime;
+    // An interval without the events of a metric gives it no observation
+    if (tx > 0)
+    {
+        m_series[PDR].push_back(static_cast<double>(delivered) / tx);
+        m_times[PDR].push_back(now);
+    }
+    if (delivered > 0)
+    {
+        m_series[DELAY].push_back((totals.delaySum - m_last.delaySum) / delivered);
+        m_times[DELAY].push_back(now);
+    }
+    if (phy.IsStrictlyPositive())
+    {
+        const Time off = totals.phyOffTime - m_last.phyOffTime;
+        m_series[WAKE_RATIO].push_back(1.0 - off.GetSeconds() / phy.GetSeconds());
+        m_times[WAKE_RATIO].push_back(now);
+    }
+    m_last = totals;
+
+    if (Evaluate())
+    {
+        NS_LOG_INFO("Steady state reached at " << now.As(Time::S) << ": stopping");
+        Simulator::Stop();
+        return;
+    }
+    Simulator::Schedule(m_interval,
+                        &RitSteadyStateController::Observe,
+                        Ptr<RitSteadyStateController>(this));
+}
+
+bool
+RitSteadyStateController::Evaluate()
+{
+    const uint32_t minObservations = std::max(m_minObservations, 10 * m_batches);
+    bool converged = true;
+    size_t observations = 0;
+    for (uint8_t i = 0; i < METRIC_COUNT; i++)
+    {
+        if (!m_enabled[i])
+        {
+            continue;
+        }
+        const std::vector<double>& y = m_series[i];
+        observations = std::max(observations, y.size());
+        if (y.size() < minObservations)
+        {
+            converged = false;
+            continue;
+        }
+        const size_t warmup = MserTruncation(y);
+        double mean = 0.0;
+        double halfWidth = 0.0;
+        if (warmup >= y.size() ||
+            !BatchMeans(std::vector<double>(y.begin() + warmup, y.end()),
+                        m_batches,
+                        mean,
+                        halfWidth))
+        {
+            converged = false;
+            continue;
+        }
+        const std::string name = GetMetricName(static_cast<Metric>(i));
+        m_collector->SetScenarioValue(name + "_ss_mean", mean);
+        m_collector->SetScenarioValue(name + "_ss_half_width", halfWidth);
+        m_collector->SetScenarioValue(
+            name + "_ss_warmup",
+            (warmup > 0 ? m_times[i][warmup - 1] : m_start).GetSeconds());
+        converged = converged && halfWidth <= m_target * std::abs(mean);
+    }
+
+    m_converged = converged;
+    m_collector->SetScenarioValue("steady_state_converged", converged ? 1 : 0);
+    m_collector->SetScenarioValue("steady_state_observations", observations);
+    if (converged)
+    {
+        m_collector->SetScenarioValue("steady_state_stop_time", Simulator::Now().GetSeconds());
+    }
+    return converged;
+}
+
+} // namespace lrwpan
+} // namespace ns3
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef RIT_STEADY_STATE_CONTROLLER_H
+#define RIT_STEADY_STATE_CONTROLLER_H
+
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/rit-metrics-collector.h"
+#include "ns3/simple-ref-count.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @ingroup lrwpan
+ *
+ * @brief Stops the simulation once the metrics of a RitMetricsCollector are in their
+ *        steady state and known precisely enough.
+ *
+ * Every observation interval the network-wide totals of the collector are sampled,
+ * giving one observation per metric: the PDR and mean end-to-end delay of the
+ * packets delivered in the interval and the wake ratio of the PHY time of the
+ * interval. For each metric the warm-up is truncated by MSER-5 (the truncation of
+ * batches of 5 observations minimising the marginal standard error, searched over the
+ * first half) and the rest is split into a fixed number of batches, whose means give
+ * a 95% Student t confidence interval. Once the truncation point of every metric lies
+ * in the first half and every half-width is under the target (relative to the mean),
+ * Simulator::Stop() is called.
+ *
+ * The last evaluation is written to the scenario summary of the collector:
+ * steady_state_converged, steady_state_stop_time (when converged),
+ * steady_state_observations and, per metric, <metric>_ss_mean, <metric>_ss_half_width
+ * and <metric>_ss_warmup (end of the truncated warm-up [s]).
+ */
+class RitSteadyStateController : public SimpleRefCount<RitSteadyStateController>
+{
+  public:
+    /**
+     * @brief Metrics the stop decision can take into account.
+     */
+    enum Metric : uint8_t
+    {
+        PDR = 0,
+        DELAY,
+        WAKE_RATIO,
+        METRIC_COUNT
+    };
+
+    /**
+     * @param collector Collector whose totals are sampled
+     */
+    RitSteadyStateController(Ptr<RitMetricsCollector> collector);
+
+    /**
+     * @param interval Time between two observations (default 10 min)
+     */
+    void SetObservationInterval(Time interval);
+
+    /**
+     * @param halfWidth Largest CI half-width relative to the mean (default 0.05)
+     */
+    void SetTarget(double halfWidth);
+
+    /**
+     * @param batches Number of batches of the batch means (default 20)
+     */
+    void SetBatches(uint32_t batches);
+
+    /**
+     * @param observations Observations of a metric before the first evaluation
+     *        (default 200, at least 10 per batch)
+     */
+    void SetMinObservations(uint32_t observations);
+
+    /**
+     * @brief Select the metrics of the stop decision (default: all).
+     * @param metric The metric
+     * @param enabled Whether it must converge
+     */
+    void SetMetric(Metric metric, bool enabled);
+
+    /**
+     * @brief Schedule the first observation.
+     */
+    void Start();
+
+    /** @brief Get whether every selected metric converged. */
+    bool IsConverged() const;
+
+    /**
+     * @brief MSER-5 warm-up truncation.
+     * @param y Observations
+     * @return the number of leading observations to drop (a multiple of 5), or
+     *         y.size() when the minimum lies past the first half of the batches
+     */
+    static size_t MserTruncation(const std::vector<double>& y);
+
+    /**
+     * @brief Batch-means 95% confidence interval.
+     * @param y Observations (after the warm-up)
+     * @param batches Number of batches (the first y.size() % batches observations
+     *        are left out)
+     * @param mean Grand mean of the batches
+     * @param halfWidth Half-width of the interval
+     * @return false when there are fewer observations than batches
+     */
+    static bool BatchMeans(const std::vector<double>& y,
+                           uint32_t batches,
+                           double& mean,
+                           double& halfWidth);
+
+  private:
+    /**
+     * @brief Sample the totals, evaluate the metrics and stop or schedule the next
+     *        observation.
+     */
+    void Observe();
+
+    /**
+     * @brief Evaluate the metrics and record the result in the collector.
+     * @return true when every selected metric converged
+     */
+    bool Evaluate();
+
+    /**
+     * @brief Get the name of a metric in the summary.
+     * @param metric The metric
+     * @return its name
+     */
+    static std::string GetMetricName(Metric metric);
+
+    Ptr<RitMetricsCollector> m_collector;         //!< Sampled collector
+    Time m_interval;                              //!< Observation interval
+    double m_target;                              //!< Relative half-width target
+    uint32_t m_batches;                           //!< Batches of the batch means
+    uint32_t m_minObservations;                   //!< Observations before an evaluation
+    bool m_enabled[METRIC_COUNT];                 //!< Metrics of the stop decision
+    std::vector<double> m_series[METRIC_COUNT];   //!< Observations per metric
+    std::vector<Time> m_times[METRIC_COUNT];      //!< End of their intervals
+    RitMetricsCollector::Totals m_last;           //!< Totals at the last observation
+    Time m_start;                                 //!< First observation
+    bool m_converged;                             //!< Every selected metric converged
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // RIT_STEADY_STATE_CONTROLLER_H
@@ -0,0 +1,394 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-topology-helper.h"
+
+#include "ns3/abort.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/log.h"
+#include "ns3/lr-wpan-spectrum-value-helper.h"
+#include "ns3/mobility-model.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_LOG_COMPONENT_DEFINE("RitTopologyHelper");
+
+namespace
+{
+
+/**
+ * Candidates tried around an active sample before it is retired (Bridson's k).
+ */
+constexpr uint32_t POISSON_DISC_CANDIDATES = 30;
+
+/**
+ * Background grid of Poisson disc sampling: cells of minDistance / sqrt(2) hold at
+ * most one sample, so the samples closer than minDistance to a point lie in the
+ * 5 x 5 cells around it.
+ */
+class PoissonDiscGrid
+{
+  public:
+    /**
+     * @brief Create an empty grid.
+     * @param width Extent of the area along x [m]
+     * @param height Extent of the area along y [m]
+     * @param minDistance Smallest distance between two samples [m]
+     */
+    PoissonDiscGrid(double width, double height, double minDistance)
+        : m_cell(minDistance / std::sqrt(2.0)),
+          m_minDistance(minDistance),
+          m_nx(static_cast<int64_t>(std::ceil(width / m_cell)) + 1),
+          m_ny(static_cast<int64_t>(std::ceil(height / m_cell)) + 1),
+          m_cells(m_nx * m_ny, -1)
+    {
+    }
+
+    /**
+     * @brief Check that no sample is closer than the minimum distance.
+     * @param points The samples
+     * @param p The candidate
+     * @return true if p can be added
+     */
+    bool Fits(const std::vector<Vector>& points, const Vector& p) const
+    {
+        const int64_t cx = CellX(p);
+        const int64_t cy = CellY(p);
+        for (int64_t y = std::max<int64_t>(cy - 2, 0); y <= std::min(cy + 2, m_ny - 1); y++)
+        {
+            for (int64_t x = std::max<int64_t>(cx - 2, 0); x <= std::min(cx + 2, m_nx - 1); x++)
+            {
+                const int32_t k = m_cells[y * m_nx + x];
+                if (k >= 0 && CalculateDistance(points[k], p) < m_minDistance)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Record a sample in its cell.
+     * @param p The sample
+     * @param index Index of the sample
+     */
+    void Add(const Vector& p, int32_t index)
+    {
+        m_cells[CellY(p) * m_nx + CellX(p)] = index;
+    }
+
+  private:
+    /**
+     * @brief Column of a point.
+     * @param p The point
+     * @return the column
+     */
+    int64_t CellX(const Vector& p) const
+    {
+        return static_cast<int64_t>(p.x / m_cell);
+    }
+
+    /**
+     * @brief Row of a point.
+     * @param p The point
+     * @return the row
+     */
+    int64_t CellY(const Vector& p) const
+    {
+        return static_cast<int64_t>(p.y / m_cell);
+    }
+
+    double m_cell;                //!< Cell side [m]
+    double m_minDistance;         //!< Smallest distance between two samples [m]
+    int64_t m_nx;                 //!< Cells along x
+    int64_t m_ny;                 //!< Cells along y
+    std::vector<int32_t> m_cells; //!< Sample of each cell, -1 if none
+};
+
+/**
+ * @brief Parse a number of a layout file.
+ * @param field The text
+ * @param value The number
+ * @return true if the whole field is a number
+ */
+bool
+ParseNumber(const std::string& field, double& value)
+{
+    char* end = nullptr;
+    value = std::strtod(field.c_str(), &end);
+    return end != field.c_str() && *end == '\0';
+}
+
+} // namespace
+
+RitTopologyHelper::RitTopologyHelper()
+{
+    m_uniform = CreateObject<UniformRandomVariable>();
+}
+
+RitTopologyHelper::~RitTopologyHelper()
+{
+}
+
+RitTopology
+RitTopologyHelper::RandomGeometric(uint32_t nRouters, double width, double height)
+{
+    RitTopology topology;
+    topology.sinks.emplace_back(width / 2, height / 2, 0);
+    topology.routers.reserve(nRouters);
+    for (uint32_t i = 0; i < nRouters; i++)
+    {
+        const double x = m_uniform->GetValue(0, width);
+        topology.routers.emplace_back(x, m_uniform->GetValue(0, height), 0);
+    }
+    return topology;
+}
+
+RitTopology
+RitTopologyHelper::PoissonDisc(uint32_t nRouters,
+                               double width,
+                               double height,
+                               double minDistance)
+{
+    NS_ABORT_MSG_IF(minDistance <= 0, "The minimum distance must be positive");
+
+    // Bridson's algorithm, grown from the sink at the centre of the area
+    std::vector<Vector> points{Vector(width / 2, height / 2, 0)};
+    PoissonDiscGrid grid(width, height, minDistance);
+    grid.Add(points[0], 0);
+    std::vector<int32_t> active{0};
+    points.reserve(nRouters + 1);
+
+    while (!active.empty() && points.size() < nRouters + 1)
+    {
+        const size_t slot = std::min(static_cast<size_t>(m_uniform->GetValue(0, active.size())),
+                                     active.size() - 1);
+        const Vector origin = points[active[slot]];
+        bool found = false;
+        for (uint32_t k = 0; k < POISSON_DISC_CANDIDATES && !found; k++)
+        {
+            const double angle = m_uniform->GetValue(0, 2 * M_PI);
+            const double radius = m_uniform->GetValue(minDistance, 2 * minDistance);
+            const Vector p(origin.x + radius * std::cos(angle),
+                           origin.y + radius * std::sin(angle),
+                           0);
+            if (p.x >= 0 && p.x < width && p.y >= 0 && p.y < height && grid.Fits(points, p))
+            {
+                grid.Add(p, static_cast<int32_t>(points.size()));
+                active.push_back(static_cast<int32_t>(points.size()));
+                points.push_back(p);
+                found = true;
+            }
+        }
+        if (!found)
+        {
+            active[slot] = active.back();
+            active.pop_back();
+        }
+    }
+
+    if (points.size() < nRouters + 1)
+    {
+        NS_LOG_WARN("Only " << points.size() - 1 << " of " << nRouters << " routers fit "
+                            << minDistance << " m apart in " << width << " x " << height
+                            << " m");
+    }
+
+    RitTopology topology;
+    topology.sinks.push_back(points[0]);
+    topology.routers.assign(points.begin() + 1, points.end());
+    return topology;
+}
+
+RitTopology
+RitTopologyHelper::Clustered(uint32_t nRouters,
+                             uint32_t nBuildings,
+                             double width,
+                             double height,
+                             double buildingRadius)
+{
+    NS_ABORT_MSG_IF(nBuildings == 0, "At least one building is needed");
+
+    // Buildings stay inside the area when it is large enough
+    const double marginX = std::min(buildingRadius, width / 2);
+    const double marginY = std::min(buildingRadius, height / 2);
+    std::vector<Vector> centres;
+    for (uint32_t b = 0; b < nBuildings; b++)
+    {
+        const double x = m_uniform->GetValue(marginX, width - marginX);
+        centres.emplace_back(x, m_uniform->GetValue(marginY, height - marginY), 0);
+    }
+
+    RitTopology topology;
+    topology.sinks.emplace_back(width / 2, height / 2, 0);
+    topology.routers.reserve(nRouters);
+    for (uint32_t i = 0; i < nRouters; i++)
+    {
+        const Vector& centre = centres[i % nBuildings];
+        const double radius = buildingRadius * std::sqrt(m_uniform->GetValue());
+        const double angle = m_uniform->GetValue(0, 2 * M_PI);
+        topology.routers.emplace_back(
+            std::clamp(centre.x + radius * std::cos(angle), 0.0, width),
+            std::clamp(centre.y + radius * std::sin(angle), 0.0, height),
+            0);
+    }
+    return topology;
+}
+
+RitTopology
+RitTopologyHelper::ReadCsv(const std::string& path)
+{
+    std::ifstream in(path);
+    NS_ABORT_MSG_IF(!in, "Cannot read layout file " << path);
+
+    RitTopology topology;
+    std::string line;
+    uint32_t lineNumber = 0;
+    bool first = true;
+    while (std::getline(in, line))
+    {
+        lineNumber++;
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+        std::vector<std::string> f;
+        std::stringstream ss(line);
+        std::string field;
+        while (std::getline(ss, field, ','))
+        {
+            f.push_back(field);
+        }
+
+        double x = 0;
+        double y = 0;
+        const bool numeric = f.size() == 3 && ParseNumber(f[0], x) && ParseNumber(f[1], y);
+        if (first && !numeric)
+        {
+            // column names
+            first = false;
+            continue;
+        }
+        first = false;
+        NS_ABORT_MSG_IF(!numeric, path << ":" << lineNumber << ": malformed record");
+        if (f[2] == "sink")
+        {
+            topology.sinks.emplace_back(x, y, 0);
+        }
+        else if (f[2] == "router")
+        {
+            topology.routers.emplace_back(x, y, 0);
+        }
+        else
+        {
+            NS_ABORT_MSG(path << ":" << lineNumber << ": unknown node type " << f[2]);
+        }
+    }
+    NS_LOG_INFO("Layout " << path << ": " << topology.sinks.size() << " sinks, "
+                          << topology.routers.size() << " routers");
+    return topology;
+}
+
+void
+RitTopologyHelper::Install(const RitTopology& topology,
+                           NodeContainer sinks,
+                           NodeContainer routers) const
+{
+    NS_ABORT_MSG_IF(sinks.GetN() != topology.sinks.size() ||
+                        routers.GetN() != topology.routers.size(),
+                    "The nodes do not match the layout");
+
+    auto place = [](Ptr<Node> node, const Vector& position) {
+        Ptr<MobilityModel> mobility = node->GetObject<MobilityModel>();
+        if (!mobility)
+        {
+            mobility = CreateObject<ConstantPositionMobilityModel>();
+            node->AggregateObject(mobility);
+        }
+        mobility->SetPosition(position);
+    };
+    for (uint32_t i = 0; i < sinks.GetN(); i++)
+    {
+        place(sinks.Get(i), topology.sinks[i]);
+    }
+    for (uint32_t i = 0; i < routers.GetN(); i++)
+    {
+        place(routers.Get(i), topology.routers[i]);
+    }
+}
+
+double
+RitTopologyHelper::GetLinkRange(Ptr<PropagationLossModel> loss,
+                                double txPowerDbm,
+                                double rxSensitivityDbm,
+                                double maxRange)
+{
+    NS_ABORT_MSG_IF(!loss, "No propagation loss model");
+
+    Ptr<ConstantPositionMobilityModel> a = CreateObject<ConstantPositionMobilityModel>();
+    Ptr<ConstantPositionMobilityModel> b = CreateObject<ConstantPositionMobilityModel>();
+    a->SetPosition(Vector(0, 0, 0));
+    auto received = [&](double distance) {
+        b->SetPosition(Vector(distance, 0, 0));
+        return loss->CalcRxPower(txPowerDbm, a, b) >= rxSensitivityDbm;
+    };
+
+    double lo = 1e-3;
+    double hi = maxRange;
+    if (received(hi))
+    {
+        return hi;
+    }
+    if (!received(lo))
+    {
+        return 0;
+    }
+    // Bisection down to 1 mm
+    while (hi - lo > 1e-3)
+    {
+        const double mid = (lo + hi) / 2;
+        (received(mid) ? lo : hi) = mid;
+    }
+    return lo;
+}
+
+double
+RitTopologyHelper::GetLinkRange(Ptr<SpectrumChannel> channel, Ptr<LrWpanPhy> phy, double maxRange)
+{
+    const double txPowerW =
+        LrWpanSpectrumValueHelper::TotalAvgPower(phy->GetTxPowerSpectralDensity(),
+                                                 phy->GetCurrentChannelNum());
+    return GetLinkRange(channel->GetPropagationLossModel(),
+                        10 * std::log10(txPowerW) + 30,
+                        phy->GetRxSensitivity(),
+                        maxRange);
+}
+
+int64_t
+RitTopologyHelper::AssignStreams(int64_t stream)
+{
+    m_uniform->SetStream(stream);
+    return 1;
+}
+
+} // namespace lrwpan
+} // namespace ns3
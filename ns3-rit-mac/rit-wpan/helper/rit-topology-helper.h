@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef NS3_RIT_TOPOLOGY_HELPER_H
+#define NS3_RIT_TOPOLOGY_HELPER_H
+
+#include "ns3/lr-wpan-phy.h"
+#include "ns3/node-container.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/ptr.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/spectrum-channel.h"
+#include "ns3/vector.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * Node positions of a RIT network layout.
+ */
+struct RitTopology
+{
+    std::vector<Vector> sinks;   //!< Position of each sink
+    std::vector<Vector> routers; //!< Position of each router
+};
+
+/**
+ * Helper to generate or import the layout of a RIT network of any size.
+ *
+ * The generated layouts cover a width x height area from the origin, with one
+ * sink at its centre:
+ *  - RandomGeometric(): routers drawn uniformly over the area;
+ *  - PoissonDisc(): routers drawn at random but never closer than a minimum
+ *    distance (Bridson's algorithm), an even coverage without a grid;
+ *  - Clustered(): routers gathered in buildings, discs drawn over the area.
+ *
+ * ReadCsv() imports a layout of x,y,type lines instead. Every generator runs in
+ * O(n) time (Poisson disc sampling with a background grid), so layouts of
+ * 100k nodes take well under a second; note that the 16-bit short addresses
+ * limit a network to 65534 devices.
+ *
+ * Install() gives the nodes their positions. The static ranks then come from
+ * RitWpanRankHelper::Install(routers, sinks, range) with the range of a link
+ * under the configured channel and PHY (GetLinkRange()).
+ */
+class RitTopologyHelper
+{
+  public:
+    RitTopologyHelper();
+    ~RitTopologyHelper();
+
+    RitTopologyHelper(const RitTopologyHelper&) = delete;
+    RitTopologyHelper& operator=(const RitTopologyHelper&) = delete;
+
+    /**
+     * Draw the routers uniformly over the area.
+     *
+     * @param nRouters Number of routers
+     * @param width Extent of the area along x [m]
+     * @param height Extent of the area along y [m]
+     * @return the layout
+     */
+    RitTopology RandomGeometric(uint32_t nRouters, double width, double height);
+
+    /**
+     * Draw the routers at random, at least minDistance from each other and from
+     * the sink. The area may be too small for nRouters: the layout then stops
+     * with the routers that fit.
+     *
+     * @param nRouters Number of routers
+     * @param width Extent of the area along x [m]
+     * @param height Extent of the area along y [m]
+     * @param minDistance Smallest distance between two nodes [m]
+     * @return the layout
+     */
+    RitTopology PoissonDisc(uint32_t nRouters, double width, double height, double minDistance);
+
+    /**
+     * Gather the routers in buildings: nBuildings discs of the given radius,
+     * centred uniformly over the area, get the routers in turn, each drawn
+     * uniformly over its disc.
+     *
+     * @param nRouters Number of routers
+     * @param nBuildings Number of buildings (at least 1)
+     * @param width Extent of the area along x [m]
+     * @param height Extent of the area along y [m]
+     * @param buildingRadius Radius of a building [m]
+     * @return the layout
+     */
+    RitTopology Clustered(uint32_t nRouters,
+                          uint32_t nBuildings,
+                          double width,
+                          double height,
+                          double buildingRadius);
+
+    /**
+     * Read a layout file, one node per line: x,y,type with type sink or router.
+     * Empty lines, lines starting with '#' and a first line of column names are
+     * skipped.
+     *
+     * @param path Layout file
+     * @return the layout
+     */
+    static RitTopology ReadCsv(const std::string& path);
+
+    /**
+     * Give the nodes the positions of a layout (ConstantPositionMobilityModel).
+     *
+     * @param topology The layout
+     * @param sinks Sink nodes, as many as topology.sinks
+     * @param routers Router nodes, as many as topology.routers
+     */
+    void Install(const RitTopology& topology, NodeContainer sinks, NodeContainer routers) const;
+
+    /**
+     * Get the largest distance at which a frame is still received above the
+     * sensitivity, assuming the loss grows with the distance (deterministic
+     * propagation loss models).
+     *
+     * @param loss The propagation loss model
+     * @param txPowerDbm Transmit power [dBm]
+     * @param rxSensitivityDbm Receiver sensitivity [dBm]
+     * @param maxRange Largest range searched [m]
+     * @return the range [m], 0 if not even a node at 1 mm is received
+     */
+    static double GetLinkRange(Ptr<PropagationLossModel> loss,
+                               double txPowerDbm,
+                               double rxSensitivityDbm,
+                               double maxRange = 10000.0);
+
+    /**
+     * Get the link range with the propagation loss model of a channel and the
+     * transmit power and sensitivity of a PHY.
+     *
+     * @param channel The channel
+     * @param phy A PHY configured as the ones of the network
+     * @param maxRange Largest range searched [m]
+     * @return the range [m]
+     */
+    static double GetLinkRange(Ptr<SpectrumChannel> channel,
+                               Ptr<LrWpanPhy> phy,
+                               double maxRange = 10000.0);
+
+    /**
+     * Assign a fixed random variable stream number to the random variables
+     * used by the generators.
+     *
+     * @param stream First stream index to use
+     * @return the number of stream indices assigned
+     */
+    int64_t AssignStreams(int64_t stream);
+
+  private:
+    Ptr<UniformRandomVariable> m_uniform; //!< Positions and building centres
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // NS3_RIT_TOPOLOGY_HELPER_H
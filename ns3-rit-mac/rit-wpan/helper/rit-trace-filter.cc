@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-trace-filter.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/lr-wpan-mac-header.h"
+#include "ns3/rit-wpan-net-device.h"
+#include "ns3/simulator.h"
+
+#include <cstring>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_LOG_COMPONENT_DEFINE("RitTraceFilter");
+
+RitTraceFamily
+RitTraceFamilyFromLogName(const std::string& logName)
+{
+    static const std::map<std::string, RitTraceFamily> families = {
+        {"app-txlog.csv", RIT_TRACE_FAMILY_APP},
+        {"app-rxlog.csv", RIT_TRACE_FAMILY_APP},
+        {"app-hoplatency.csv", RIT_TRACE_FAMILY_APP},
+        {"mac-statelog.csv", RIT_TRACE_FAMILY_MAC_STATE},
+        {"mac-mode.csv", RIT_TRACE_FAMILY_MAC_MODE},
+        {"nwk-txlog.csv", RIT_TRACE_FAMILY_NWK_TX},
+        {"nwk-rxlog.csv", RIT_TRACE_FAMILY_NWK_RX},
+        {"mac-txlog.csv", RIT_TRACE_FAMILY_MAC_TX},
+        {"mac-rxlog.csv", RIT_TRACE_FAMILY_MAC_RX},
+        {"mac-beacon-wait.csv", RIT_TRACE_FAMILY_MAC_TIMEOUT},
+        {"mac-data-wait.csv", RIT_TRACE_FAMILY_MAC_TIMEOUT},
+        {"phy-dutycycle.csv", RIT_TRACE_FAMILY_PHY_DUTY_CYCLE},
+        {"phy-statelog.csv", RIT_TRACE_FAMILY_PHY_STATE},
+        {"phy-txlog.csv", RIT_TRACE_FAMILY_PHY_TX},
+        {"phy-rxlog.csv", RIT_TRACE_FAMILY_PHY_RX},
+        {"energy-node.log", RIT_TRACE_FAMILY_ENERGY},
+    };
+    auto it = families.find(logName);
+    return it != families.end() ? it->second : RIT_TRACE_FAMILY_NONE;
+}
+
+RitTraceFilter::RitTraceFilter()
+    : m_families(RIT_TRACE_FAMILY_ALL),
+      m_ritDataRequestSampling(1)
+{
+}
+
+void
+RitTraceFilter::SetFamilies(uint32_t families)
+{
+    m_families = families;
+}
+
+uint32_t
+RitTraceFilter::GetFamilies() const
+{
+    return m_families;
+}
+
+bool
+RitTraceFilter::IsFamilyEnabled(RitTraceFamily family) const
+{
+    // Logs outside the known families are only controlled by their own Enable*() call
+    return family == RIT_TRACE_FAMILY_NONE || (m_families & family) != 0;
+}
+
+void
+RitTraceFilter::SetNodePredicate(std::function<bool(Ptr<Node>)> predicate)
+{
+    m_nodePredicate = std::move(predicate);
+}
+
+void
+RitTraceFilter::SetMaxRank(uint8_t maxRank)
+{
+    m_nodePredicate = [maxRank](Ptr<Node> node) {
+        for (uint32_t j = 0; j < node->GetNDevices(); ++j)
+        {
+            Ptr<RitWpanNetDevice> dev = DynamicCast<RitWpanNetDevice>(node->GetDevice(j));
+            if (dev && dev->GetRitRank() <= maxRank)
+            {
+                return true;
+            }
+        }
+        return false;
+    };
+}
+
+bool
+RitTraceFilter::IsNodeSelected(Ptr<Node> node) const
+{
+    return !m_nodePredicate || m_nodePredicate(node);
+}
+
+void
+RitTraceFilter::AddTimeWindow(Time start, Time stop)
+{
+    NS_ABORT_MSG_IF(stop <= start, "Empty trace time window");
+    m_windows.emplace_back(start, stop);
+}
+
+bool
+RitTraceFilter::IsInWindow(Time t) const
+{
+    if (m_windows.empty())
+    {
+        return true;
+    }
+    for (const auto& [start, stop] : m_windows)
+    {
+        if (t >= start && t < stop)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+RitTraceFilter::SetSampling(RitTraceFamily family, uint32_t oneInN)
+{
+    NS_ABORT_MSG_IF(oneInN == 0, "Sampling rate must be at least 1");
+    m_sampling[family] = oneInN;
+}
+
+uint32_t
+RitTraceFilter::GetSampling(RitTraceFamily family) const
+{
+    auto it = m_sampling.find(family);
+    return it != m_sampling.end() ? it->second : 1;
+}
+
+void
+RitTraceFilter::SetRitDataRequestSampling(uint32_t oneInN)
+{
+    NS_ABORT_MSG_IF(oneInN == 0, "Sampling rate must be at least 1");
+    m_ritDataRequestSampling = oneInN;
+}
+
+uint32_t
+RitTraceFilter::GetRitDataRequestSampling() const
+{
+    return m_ritDataRequestSampling;
+}
+
+bool
+RitTraceFilter::HasRecordRules(RitTraceFamily family) const
+{
+    // Cumulative snapshots: dropping rows would lose the run totals
+    if (family == RIT_TRACE_FAMILY_PHY_DUTY_CYCLE || family == RIT_TRACE_FAMILY_NONE)
+    {
+        return false;
+    }
+    return !m_windows.empty() || GetSampling(family) > 1 ||
+           (family == RIT_TRACE_FAMILY_MAC_TX && m_ritDataRequestSampling > 1);
+}
+
+std::function<bool(const RitTraceRecord&)>
+RitTraceFilter::MakeRecordFilter(RitTraceFamily family) const
+{
+    RitTraceFilter filter = *this;
+    uint32_t familySampling = GetSampling(family);
+    uint32_t rdrSampling = family == RIT_TRACE_FAMILY_MAC_TX ? m_ritDataRequestSampling : 1;
+    // Counters live with the writer that owns the predicate: [event][is RIT Data Request]
+    auto counters = std::make_shared<std::map<std::pair<uint8_t, bool>, uint64_t>>();
+    return [filter, familySampling, rdrSampling, counters](const RitTraceRecord& rec) {
+        if (!filter.IsInWindow(NanoSeconds(rec.timeNs)))
+        {
+            return false;
+        }
+        bool rdr = rdrSampling > 1 && (rec.flags & RIT_TRACE_FLAG_HAS_HEADER) &&
+                   rec.arg == LrWpanMacHeader::LRWPAN_MAC_COMMAND;
+        uint32_t oneInN = rdr ? rdrSampling : familySampling;
+        if (oneInN <= 1)
+        {
+            return true;
+        }
+        return (*counters)[{rec.event, rdr}]++ % oneInN == 0;
+    };
+}
+
+RitFilteredTraceStream::FilterLineBuf::FilterLineBuf(RitFilteredTraceStream* owner)
+    : m_owner(owner)
+{
+}
+
+void
+RitFilteredTraceStream::FilterLineBuf::FlushPartial()
+{
+    if (!m_line.empty())
+    {
+        m_owner->ProcessLine(m_line);
+        m_line.clear();
+    }
+}
+
+RitFilteredTraceStream::FilterLineBuf::int_type
+RitFilteredTraceStream::FilterLineBuf::overflow(int_type ch)
+{
+    if (traits_type::eq_int_type(ch, traits_type::eof()))
+    {
+        return traits_type::not_eof(ch);
+    }
+    char c = traits_type::to_char_type(ch);
+    if (c == '\n')
+    {
+        m_owner->ProcessLine(m_line);
+        m_line.clear();
+    }
+    else
+    {
+        m_line.push_back(c);
+    }
+    return ch;
+}
+
+std::streamsize
+RitFilteredTraceStream::FilterLineBuf::xsputn(const char* s, std::streamsize n)
+{
+    const char* end = s + n;
+    while (s < end)
+    {
+        const auto* nl = static_cast<const char*>(std::memchr(s, '\n', end - s));
+        if (!nl)
+        {
+            m_line.append(s, end - s);
+            break;
+        }
+        m_line.append(s, nl - s);
+        m_owner->ProcessLine(m_line);
+        m_line.clear();
+        s = nl + 1;
+    }
+    return n;
+}
+
+int
+RitFilteredTraceStream::FilterLineBuf::sync()
+{
+    // Keep the flush-per-line behaviour of the sinks (std::endl) for the kept lines only
+    if (m_owner->m_pendingFlush)
+    {
+        m_owner->m_out->GetStream()->flush();
+        m_owner->m_pendingFlush = false;
+    }
+    return 0;
+}
+
+RitFilteredTraceStream::RitFilteredTraceStream(const RitTraceFilter& filter,
+                                               RitTraceFamily family,
+                                               Ptr<OutputStreamWrapper> stream)
+    : m_filter(filter),
+      m_family(family),
+      m_out(stream),
+      m_pendingFlush(false)
+{
+    NS_LOG_FUNCTION(this << family);
+    m_buf = std::make_unique<FilterLineBuf>(this);
+    m_os = std::make_unique<std::ostream>(m_buf.get());
+    // The wrapper does not own the ostream; it lives as long as this object.
+    m_stream = Create<OutputStreamWrapper>(m_os.get());
+}
+
+RitFilteredTraceStream::~RitFilteredTraceStream()
+{
+    NS_LOG_FUNCTION(this);
+    Flush();
+}
+
+Ptr<OutputStreamWrapper>
+RitFilteredTraceStream::GetStream() const
+{
+    return m_stream;
+}
+
+void
+RitFilteredTraceStream::Flush()
+{
+    m_buf->FlushPartial();
+    m_out->GetStream()->flush();
+    m_pendingFlush = false;
+}
+
+void
+RitFilteredTraceStream::ProcessLine(const std::string& line)
+{
+    if (!m_filter.IsInWindow(Simulator::Now()))
+    {
+        return;
+    }
+
+    // Lines are "time,event,..."; mac-txlog lines are "time,event,frameType,src,dst"
+    size_t c1 = line.find(',');
+    size_t c2 = c1 == std::string::npos ? std::string::npos : line.find(',', c1 + 1);
+    std::string event = c1 == std::string::npos ? std::string() : line.substr(c1 + 1, c2 - c1 - 1);
+
+    uint32_t oneInN = m_filter.GetSampling(m_family);
+    std::string key = event;
+    if (m_family == RIT_TRACE_FAMILY_MAC_TX && m_filter.GetRitDataRequestSampling() > 1 &&
+        c2 != std::string::npos && line.compare(c2 + 1, 8, "Command,") == 0)
+    {
+        // RIT Data Requests are the only command frames sent by RitWpanMac
+        key = "Command:" + event;
+        oneInN = m_filter.GetRitDataRequestSampling();
+    }
+    if (oneInN > 1 && m_counters[key]++ % oneInN != 0)
+    {
+        return;
+    }
+
+    std::ostream* os = m_out->GetStream();
+    os->write(line.data(), line.size());
+    os->put('\n');
+    m_pendingFlush = true;
+}
+
+} // namespace lrwpan
+} // namespace ns3
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef RIT_TRACE_FILTER_H
+#define RIT_TRACE_FILTER_H
+
+#include "ns3/node.h"
+#include "ns3/nstime.h"
+#include "ns3/output-stream-wrapper.h"
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+
+#include "ns3/rit-trace-writer.h" // RitTraceRecord
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @brief Trace families selectable with RitTraceFilter (bit mask).
+ *
+ * One family per Enable*TracePerNode() wrapper of RitWpanNetHelper.
+ */
+enum RitTraceFamily : uint32_t
+{
+    RIT_TRACE_FAMILY_NONE = 0,
+    RIT_TRACE_FAMILY_APP = 1u << 0,            //!< app-txlog / app-rxlog / app-hoplatency
+    RIT_TRACE_FAMILY_MAC_STATE = 1u << 1,      //!< mac-statelog
+    RIT_TRACE_FAMILY_MAC_MODE = 1u << 2,       //!< mac-mode
+    RIT_TRACE_FAMILY_NWK_TX = 1u << 3,         //!< nwk-txlog
+    RIT_TRACE_FAMILY_NWK_RX = 1u << 4,         //!< nwk-rxlog
+    RIT_TRACE_FAMILY_MAC_TX = 1u << 5,         //!< mac-txlog
+    RIT_TRACE_FAMILY_MAC_RX = 1u << 6,         //!< mac-rxlog
+    RIT_TRACE_FAMILY_MAC_TIMEOUT = 1u << 7,    //!< mac-beacon-wait / mac-data-wait
+    RIT_TRACE_FAMILY_PHY_DUTY_CYCLE = 1u << 8, //!< phy-dutycycle
+    RIT_TRACE_FAMILY_PHY_STATE = 1u << 9,      //!< phy-statelog
+    RIT_TRACE_FAMILY_PHY_TX = 1u << 10,        //!< phy-txlog
+    RIT_TRACE_FAMILY_PHY_RX = 1u << 11,        //!< phy-rxlog
+    RIT_TRACE_FAMILY_ENERGY = 1u << 12,        //!< energy-node.log
+    RIT_TRACE_FAMILY_ALL = 0xFFFFFFFFu,
+};
+
+/**
+ * @brief Map a per-node log file name to its trace family.
+ * @param logName Log file name (e.g., "mac-txlog.csv")
+ * @return The family, RIT_TRACE_FAMILY_NONE for logs outside the known families
+ */
+RitTraceFamily RitTraceFamilyFromLogName(const std::string& logName);
+
+/**
+ * @ingroup lrwpan
+ *
+ * @brief Declarative selection of the trace data written by RitWpanNetHelper.
+ *
+ * A filter combines:
+ *  - the enabled trace families (all by default),
+ *  - a node subset (e.g. SetMaxRank(2) for the nodes close to the sink),
+ *  - simulation time windows; records outside every window are dropped
+ *    (e.g. AddTimeWindow(Hours(1), Time::Max()) to skip the warm-up),
+ *  - 1-in-N sampling of a family, or of the RIT Data Request frames only
+ *    (the command frames of mac-txlog, the most frequent records of a run).
+ *
+ * Families and nodes are resolved when the traces are enabled, so disabled traces
+ * cost nothing. Windows and sampling are applied per record, before any I/O.
+ * Sampling keeps the first of every N records, counted separately per event
+ * (Tx / TxOk / ...) so that the ratios between events are preserved.
+ * phy-dutycycle rows are cumulative and are never dropped by windows or sampling.
+ */
+class RitTraceFilter
+{
+  public:
+    /** @brief Create a filter that keeps everything. */
+    RitTraceFilter();
+
+    /** @brief Set the enabled families (bitwise OR of RitTraceFamily values). */
+    void SetFamilies(uint32_t families);
+
+    /** @brief Get the enabled families. */
+    uint32_t GetFamilies() const;
+
+    /** @brief Check whether a family is enabled. */
+    bool IsFamilyEnabled(RitTraceFamily family) const;
+
+    /**
+     * @brief Select the traced nodes with a predicate (replaces SetMaxRank()).
+     * @param predicate Returns true for the nodes to trace
+     */
+    void SetNodePredicate(std::function<bool(Ptr<Node>)> predicate);
+
+    /**
+     * @brief Trace only the nodes whose RIT rank is at most maxRank.
+     *
+     * The rank is read from the RitWpanNetDevice when the traces are enabled, so
+     * assign ranks (RitWpanRankHelper) first.
+     */
+    void SetMaxRank(uint8_t maxRank);
+
+    /** @brief Check whether a node is traced. */
+    bool IsNodeSelected(Ptr<Node> node) const;
+
+    /**
+     * @brief Keep the records with start <= time < stop. Several windows may be added;
+     * without any window the whole run is kept.
+     */
+    void AddTimeWindow(Time start, Time stop);
+
+    /** @brief Check whether a time falls into a window. */
+    bool IsInWindow(Time t) const;
+
+    /** @brief Keep one record in oneInN for a family (1 = keep all). */
+    void SetSampling(RitTraceFamily family, uint32_t oneInN);
+
+    /** @brief Get the sampling rate of a family. */
+    uint32_t GetSampling(RitTraceFamily family) const;
+
+    /** @brief Keep one RIT Data Request TX record in oneInN in mac-txlog (1 = keep all). */
+    void SetRitDataRequestSampling(uint32_t oneInN);
+
+    /** @brief Get the sampling rate of the RIT Data Request TX records. */
+    uint32_t GetRitDataRequestSampling() const;
+
+    /** @brief Check whether the records of a family need the per-record filter. */
+    bool HasRecordRules(RitTraceFamily family) const;
+
+    /**
+     * @brief Build the per-record filter of a binary trace.
+     * @param family Family of the trace
+     * @return Predicate returning true for the records to write
+     */
+    std::function<bool(const RitTraceRecord&)> MakeRecordFilter(RitTraceFamily family) const;
+
+  private:
+    uint32_t m_families;                                 //!< Enabled families
+    std::function<bool(Ptr<Node>)> m_nodePredicate;      //!< Node subset (empty = all)
+    std::vector<std::pair<Time, Time>> m_windows;        //!< [start, stop) windows
+    std::map<RitTraceFamily, uint32_t> m_sampling;       //!< 1-in-N per family
+    uint32_t m_ritDataRequestSampling;                   //!< 1-in-N for RIT Data Request TX
+};
+
+/**
+ * @ingroup lrwpan
+ *
+ * @brief ASCII trace stream applying the time windows and sampling of a RitTraceFilter.
+ *
+ * GetStream() is handed to the existing ASCII sinks instead of the log stream.
+ * Every complete line is checked against the filter and forwarded to the log
+ * stream only when it is kept.
+ */
+class RitFilteredTraceStream : public SimpleRefCount<RitFilteredTraceStream>
+{
+  public:
+    /**
+     * @param filter Filter to apply (copied)
+     * @param family Family of the log
+     * @param stream Log stream receiving the kept lines
+     */
+    RitFilteredTraceStream(const RitTraceFilter& filter,
+                           RitTraceFamily family,
+                           Ptr<OutputStreamWrapper> stream);
+    ~RitFilteredTraceStream();
+
+    RitFilteredTraceStream(const RitFilteredTraceStream&) = delete;
+    RitFilteredTraceStream& operator=(const RitFilteredTraceStream&) = delete;
+
+    /** @brief Get the stream to hand to the trace sinks. */
+    Ptr<OutputStreamWrapper> GetStream() const;
+
+    /** @brief Forward a pending (unterminated) line, if kept, and flush the log stream. */
+    void Flush();
+
+  private:
+    /**
+     * @brief Line-buffering streambuf that drops the lines rejected by the filter.
+     */
+    class FilterLineBuf : public std::streambuf
+    {
+      public:
+        FilterLineBuf(RitFilteredTraceStream* owner);
+
+        /** @brief Process a partial (unterminated) line, if any. */
+        void FlushPartial();
+
+      protected:
+        int_type overflow(int_type ch) override;
+        std::streamsize xsputn(const char* s, std::streamsize n) override;
+        int sync() override;
+
+      private:
+        RitFilteredTraceStream* m_owner; //!< Owning stream
+        std::string m_line;              //!< Current incomplete line
+    };
+
+    /** @brief Check a complete line (without '\n') and forward it if kept. */
+    void ProcessLine(const std::string& line);
+
+    RitTraceFilter m_filter;                     //!< Filter to apply
+    RitTraceFamily m_family;                     //!< Family of the log
+    Ptr<OutputStreamWrapper> m_out;              //!< Log stream
+    std::map<std::string, uint64_t> m_counters;  //!< Sampling counters per event
+    bool m_pendingFlush;                         //!< Lines forwarded since the last flush
+    std::unique_ptr<FilterLineBuf> m_buf;        //!< Line buffer
+    std::unique_ptr<std::ostream> m_os;          //!< ostream over m_buf
+    Ptr<OutputStreamWrapper> m_stream;           //!< Wrapper over m_os (not owning)
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // RIT_TRACE_FILTER_H
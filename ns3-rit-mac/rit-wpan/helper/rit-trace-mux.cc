@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-trace-mux.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+#include <cstring>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_LOG_COMPONENT_DEFINE("RitTraceMux");
+
+RitTraceMux::TaggedLineBuf::TaggedLineBuf(std::ofstream* file, std::string prefix)
+    : m_file(file),
+      m_prefix(std::move(prefix))
+{
+}
+
+void
+RitTraceMux::TaggedLineBuf::EmitLine()
+{
+    if (m_file->is_open())
+    {
+        m_file->write(m_prefix.data(), m_prefix.size());
+        m_file->write(m_line.data(), m_line.size());
+        m_file->put('\n');
+    }
+    m_line.clear();
+}
+
+void
+RitTraceMux::TaggedLineBuf::FlushPartial()
+{
+    if (!m_line.empty())
+    {
+        EmitLine();
+    }
+}
+
+RitTraceMux::TaggedLineBuf::int_type
+RitTraceMux::TaggedLineBuf::overflow(int_type ch)
+{
+    if (traits_type::eq_int_type(ch, traits_type::eof()))
+    {
+        return traits_type::not_eof(ch);
+    }
+    char c = traits_type::to_char_type(ch);
+    if (c == '\n')
+    {
+        EmitLine();
+    }
+    else
+    {
+        m_line.push_back(c);
+    }
+    return ch;
+}
+
+std::streamsize
+RitTraceMux::TaggedLineBuf::xsputn(const char* s, std::streamsize n)
+{
+    const char* end = s + n;
+    while (s < end)
+    {
+        const auto* nl = static_cast<const char*>(std::memchr(s, '\n', end - s));
+        if (!nl)
+        {
+            m_line.append(s, end - s);
+            break;
+        }
+        m_line.append(s, nl - s);
+        EmitLine();
+        s = nl + 1;
+    }
+    return n;
+}
+
+int
+RitTraceMux::TaggedLineBuf::sync()
+{
+    // Per-line flushes (std::endl) are intentionally not forwarded to the file.
+    return 0;
+}
+
+RitTraceMux::RitTraceMux(const std::string& filePath)
+{
+    NS_LOG_FUNCTION(this << filePath);
+    m_file.open(filePath, std::ios::out | std::ios::trunc);
+    NS_ABORT_MSG_UNLESS(m_file.is_open(), "Unable to open consolidated trace file " << filePath);
+}
+
+RitTraceMux::~RitTraceMux()
+{
+    NS_LOG_FUNCTION(this);
+    Close();
+}
+
+Ptr<OutputStreamWrapper>
+RitTraceMux::GetStream(uint32_t nodeId, const std::string& logName)
+{
+    NS_LOG_FUNCTION(this << nodeId << logName);
+    auto buf = std::make_unique<TaggedLineBuf>(&m_file,
+                                               std::to_string(nodeId) + "," + logName + ",");
+    auto os = std::make_unique<std::ostream>(buf.get());
+    // The wrapper does not own the ostream; it lives as long as this mux.
+    Ptr<OutputStreamWrapper> stream = Create<OutputStreamWrapper>(os.get());
+    m_bufs.push_back(std::move(buf));
+    m_streams.push_back(std::move(os));
+    return stream;
+}
+
+void
+RitTraceMux::Close()
+{
+    if (!m_file.is_open())
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this);
+    for (auto& os : m_streams)
+    {
+        os->flush();
+    }
+    for (auto& buf : m_bufs)
+    {
+        buf->FlushPartial();
+    }
+    m_file.close();
+}
+
+} // namespace lrwpan
+} // namespace ns3
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef RIT_TRACE_MUX_H
+#define RIT_TRACE_MUX_H
+
+#include "ns3/output-stream-wrapper.h"
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @ingroup lrwpan
+ *
+ * @brief Multiplexes many per-node ASCII trace streams into one file.
+ *
+ * Each stream returned by GetStream() behaves like a per-node log file for the
+ * existing trace sinks. Every complete line written to it is prefixed with
+ * "<nodeId>,<logName>," and appended to the shared file. Flushes requested by
+ * the sinks (std::endl) do not reach the disk; the shared file is flushed when
+ * its buffer fills up and on Close().
+ *
+ * Use analysis/common/trace_decoder.py to split the file back into node-* directories.
+ */
+class RitTraceMux : public SimpleRefCount<RitTraceMux>
+{
+  public:
+    /**
+     * @brief Open the shared trace file.
+     * @param filePath Output file path
+     */
+    RitTraceMux(const std::string& filePath);
+    ~RitTraceMux();
+
+    RitTraceMux(const RitTraceMux&) = delete;
+    RitTraceMux& operator=(const RitTraceMux&) = delete;
+
+    /**
+     * @brief Create a stream whose lines are tagged with the node id and log name.
+     * @param nodeId Node id
+     * @param logName Log file name of the equivalent per-node log (e.g., "mac-txlog.csv")
+     * @return Output stream wrapper to hand to the trace sinks
+     */
+    Ptr<OutputStreamWrapper> GetStream(uint32_t nodeId, const std::string& logName);
+
+    /** @brief Write pending lines and close the file; later writes are discarded. */
+    void Close();
+
+  private:
+    /**
+     * @brief Line-buffering streambuf that forwards tagged lines to the shared file.
+     */
+    class TaggedLineBuf : public std::streambuf
+    {
+      public:
+        TaggedLineBuf(std::ofstream* file, std::string prefix);
+
+        /** @brief Forward a partial (unterminated) line, if any. */
+        void FlushPartial();
+
+      protected:
+        int_type overflow(int_type ch) override;
+        std::streamsize xsputn(const char* s, std::streamsize n) override;
+        int sync() override;
+
+      private:
+        /** @brief Emit the current line with its prefix. */
+        void EmitLine();
+
+        std::ofstream* m_file; //!< Shared output file (not owned)
+        std::string m_prefix;  //!< "<nodeId>,<logName>,"
+        std::string m_line;    //!< Current incomplete line
+    };
+
+    std::ofstream m_file;                                //!< Shared output file
+    std::vector<std::unique_ptr<TaggedLineBuf>> m_bufs;  //!< Per-stream line buffers
+    std::vector<std::unique_ptr<std::ostream>> m_streams; //!< Per-stream ostreams
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // RIT_TRACE_MUX_H
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-trace-writer.h"
+
+#include "rit-async-trace-writer.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <cstring>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_LOG_COMPONENT_DEFINE("RitTraceWriter");
+
+RitBinaryTraceWriter::RitBinaryTraceWriter(const std::string& filePath,
+                                           RitTraceLogId logId,
+                                           uint32_t nodeId,
+                                           uint32_t bufferRecords)
+    : m_logId(logId),
+      m_bufferRecords(bufferRecords > 0 ? bufferRecords : 1),
+      m_nodeId(nodeId)
+{
+    NS_LOG_FUNCTION(this << filePath << static_cast<uint32_t>(logId) << nodeId << bufferRecords);
+
+    m_file.open(filePath, std::ios::out | std::ios::binary | std::ios::trunc);
+    NS_ABORT_MSG_UNLESS(m_file.is_open(), "Unable to open binary trace file " << filePath);
+
+    RitTraceFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "RITT", 4);
+    header.version = FORMAT_VERSION;
+    header.recordSize = sizeof(RitTraceRecord);
+    header.logId = logId;
+    header.nodeId = nodeId;
+    m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+RitBinaryTraceWriter::RitBinaryTraceWriter(Ptr<RitBinaryTraceWriter> shared,
+                                           RitTraceLogId logId,
+                                           uint32_t nodeId)
+    : m_shared(shared),
+      m_logId(logId),
+      m_bufferRecords(0),
+      m_nodeId(nodeId)
+{
+    NS_LOG_FUNCTION(this << static_cast<uint32_t>(logId) << nodeId);
+    NS_ASSERT_MSG(shared && shared->m_logId == RIT_TRACE_LOG_MIXED,
+                  "Shared binary trace writer must be opened with RIT_TRACE_LOG_MIXED");
+}
+
+RitBinaryTraceWriter::~RitBinaryTraceWriter()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_shared)
+    {
+        Flush();
+        m_file.close();
+    }
+}
+
+void
+RitBinaryTraceWriter::Write(const RitTraceRecord& record)
+{
+    if (m_filter && !m_filter(record))
+    {
+        return;
+    }
+    if (m_shared)
+    {
+        RitTraceRecord tagged = record;
+        tagged.flags |= static_cast<uint8_t>(m_logId << RIT_TRACE_FLAG_LOG_ID_SHIFT);
+        m_recordCount++;
+        m_shared->Write(tagged);
+        return;
+    }
+    if (m_async && m_async->IsRunning())
+    {
+        if (m_async->Push(this, record))
+        {
+            m_recordCount++;
+        }
+        return;
+    }
+    m_recordCount++;
+    WriteBuffered(record);
+}
+
+void
+RitBinaryTraceWriter::WriteBuffered(const RitTraceRecord& record)
+{
+    if (m_buffer.capacity() == 0)
+    {
+        // Allocate lazily: most per-node logs of a large run stay empty.
+        m_buffer.reserve(m_bufferRecords);
+    }
+    m_buffer.push_back(record);
+    if (m_buffer.size() >= m_bufferRecords)
+    {
+        WriteBlock();
+    }
+}
+
+void
+RitBinaryTraceWriter::Flush()
+{
+    if (m_async && m_async->IsRunning())
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this << m_buffer.size());
+    WriteBlock();
+}
+
+void
+RitBinaryTraceWriter::WriteBlock()
+{
+    // May run on the async writer thread: no logging here.
+    if (m_buffer.empty())
+    {
+        return;
+    }
+    m_file.write(reinterpret_cast<const char*>(m_buffer.data()),
+                 m_buffer.size() * sizeof(RitTraceRecord));
+    m_file.flush();
+    m_buffer.clear();
+}
+
+void
+RitBinaryTraceWriter::AttachAsyncWriter(Ptr<RitAsyncTraceWriter> async)
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT_MSG(!m_shared, "Attach the async writer to the shared writer, not to a view");
+    async->Register(this);
+    m_async = PeekPointer(async);
+}
+
+void
+RitBinaryTraceWriter::DetachAsyncWriter()
+{
+    m_async = nullptr;
+}
+
+void
+RitBinaryTraceWriter::SetRecordFilter(std::function<bool(const RitTraceRecord&)> filter)
+{
+    m_filter = std::move(filter);
+}
+
+uint32_t
+RitBinaryTraceWriter::GetNodeId() const
+{
+    return m_nodeId;
+}
+
+uint64_t
+RitBinaryTraceWriter::GetRecordCount() const
+{
+    return m_recordCount;
+}
+
+RitTraceEvent
+RitTraceWaitEventFromString(const std::string& event)
+{
+    if (event == "start")
+    {
+        return RIT_TRACE_EV_WAIT_START;
+    }
+    else if (event == "end")
+    {
+        return RIT_TRACE_EV_WAIT_END;
+    }
+    else if (event == "skip")
+    {
+        return RIT_TRACE_EV_WAIT_SKIP;
+    }
+    else if (event == "timeout")
+    {
+        return RIT_TRACE_EV_WAIT_TIMEOUT;
+    }
+    return RIT_TRACE_EV_NONE;
+}
+
+} // namespace lrwpan
+} // namespace ns3
@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef RIT_TRACE_WRITER_H
+#define RIT_TRACE_WRITER_H
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+class RitAsyncTraceWriter;
+
+/**
+ * @ingroup lrwpan
+ *
+ * @brief Output format of the per-node traces written by RitWpanNetHelper.
+ */
+enum class RitTraceFormat : uint8_t
+{
+    ASCII,  //!< One CSV line per event (legacy, flushed on every line)
+    BINARY, //!< Fixed-size RitTraceRecord entries, buffered in user space
+};
+
+/**
+ * @brief Identifies which log a binary trace file holds.
+ *
+ * The value is stored in the file header; the decoder uses it to pick the CSV
+ * layout of the corresponding ASCII log (mac-txlog.csv, phy-statelog.csv, ...).
+ */
+enum RitTraceLogId : uint8_t
+{
+    RIT_TRACE_LOG_APP_TX = 0,
+    RIT_TRACE_LOG_APP_RX = 1,
+    RIT_TRACE_LOG_MAC_STATE = 2,
+    RIT_TRACE_LOG_MAC_MODE = 3,
+    RIT_TRACE_LOG_NWK_TX = 4,
+    RIT_TRACE_LOG_NWK_RX = 5,
+    RIT_TRACE_LOG_MAC_TX = 6,
+    RIT_TRACE_LOG_MAC_RX = 7,
+    RIT_TRACE_LOG_MAC_BEACON_WAIT = 8,
+    RIT_TRACE_LOG_MAC_DATA_WAIT = 9,
+    RIT_TRACE_LOG_PHY_STATE = 10,
+    RIT_TRACE_LOG_PHY_TX = 11,
+    RIT_TRACE_LOG_PHY_RX = 12,
+    RIT_TRACE_LOG_ENERGY = 13,
+    RIT_TRACE_LOG_MIXED = 0xFF, //!< Consolidated file, log id stored per record
+};
+
+/**
+ * @brief Event identifiers stored in RitTraceRecord::event.
+ *
+ * Each value maps to the event string of the ASCII logs ("Tx", "RxOk", "start", ...).
+ */
+enum RitTraceEvent : uint8_t
+{
+    RIT_TRACE_EV_NONE = 0,
+    RIT_TRACE_EV_TX = 1,
+    RIT_TRACE_EV_TX_OK = 2,
+    RIT_TRACE_EV_TX_DROP = 3,
+    RIT_TRACE_EV_RE_TX = 4,
+    RIT_TRACE_EV_RX_OK = 5,
+    RIT_TRACE_EV_RX_DROP = 6,
+    RIT_TRACE_EV_TX_BEGIN = 7,
+    RIT_TRACE_EV_TX_END = 8,
+    RIT_TRACE_EV_RX_BEGIN = 9,
+    RIT_TRACE_EV_RX_END = 10,
+    RIT_TRACE_EV_WAIT_START = 11,
+    RIT_TRACE_EV_WAIT_END = 12,
+    RIT_TRACE_EV_WAIT_SKIP = 13,
+    RIT_TRACE_EV_WAIT_TIMEOUT = 14,
+};
+
+/// Record flag: the MAC header could be parsed (addresses are valid)
+constexpr uint8_t RIT_TRACE_FLAG_HAS_HEADER = 0x01;
+/// In consolidated files the RitTraceLogId of a record is stored in the upper flag bits
+constexpr uint8_t RIT_TRACE_FLAG_LOG_ID_SHIFT = 4;
+
+/**
+ * @brief Fixed-size binary trace record (48 bytes, host byte order).
+ *
+ * Field usage depends on the log id of the file:
+ *  - arg: MAC frame type, MacState, PhyEnumeration or RitMacMode
+ *  - src/dst: MAC or NWK addresses, with the address modes in addrModes
+ *    (source in bits 0-1, destination in bits 2-3, values as AddressMode)
+ *  - value: SINR or energy
+ */
+struct RitTraceRecord
+{
+    int64_t timeNs;    //!< Event time [ns]
+    uint64_t uid;      //!< Packet UID (0 if not applicable)
+    uint64_t src;      //!< Source address
+    uint64_t dst;      //!< Destination address
+    double value;      //!< Auxiliary value (SINR, energy)
+    uint32_t nodeId;   //!< Node id
+    uint8_t event;     //!< RitTraceEvent
+    uint8_t arg;       //!< Log-specific argument
+    uint8_t addrModes; //!< Source/destination address modes
+    uint8_t flags;     //!< RIT_TRACE_FLAG_* (+ log id in consolidated files)
+};
+
+static_assert(sizeof(RitTraceRecord) == 48, "RitTraceRecord must stay 48 bytes");
+
+/**
+ * @brief Header written at the beginning of every binary trace file (16 bytes).
+ */
+struct RitTraceFileHeader
+{
+    char magic[4];       //!< "RITT"
+    uint16_t version;    //!< Format version
+    uint16_t recordSize; //!< sizeof(RitTraceRecord)
+    uint8_t logId;       //!< RitTraceLogId
+    uint8_t reserved[3]; //!< Padding
+    uint32_t nodeId;     //!< Node id the file belongs to
+};
+
+static_assert(sizeof(RitTraceFileHeader) == 16, "RitTraceFileHeader must stay 16 bytes");
+
+/**
+ * @ingroup lrwpan
+ *
+ * @brief Buffered writer for fixed-size binary trace records.
+ *
+ * Records are collected in a user-space buffer and written to disk in blocks,
+ * so no per-event formatting or flushing happens on the simulator thread.
+ * The buffer is flushed when full, on Flush() and on destruction.
+ * Use analysis/common/trace_decoder.py to convert the files back into the CSV logs.
+ */
+class RitBinaryTraceWriter : public SimpleRefCount<RitBinaryTraceWriter>
+{
+  public:
+    /// Format version written to the file header
+    static constexpr uint16_t FORMAT_VERSION = 1;
+
+    /**
+     * @brief Open a binary trace file and write its header.
+     * @param filePath Output file path
+     * @param logId Log id stored in the header
+     * @param nodeId Node id stored in the header
+     * @param bufferRecords Number of records buffered before a block write
+     */
+    RitBinaryTraceWriter(const std::string& filePath,
+                         RitTraceLogId logId,
+                         uint32_t nodeId,
+                         uint32_t bufferRecords);
+
+    /**
+     * @brief Create a per-node view on a shared (consolidated) writer.
+     *
+     * Records written to the view are tagged with logId and forwarded to the shared
+     * writer, which must have been opened with RIT_TRACE_LOG_MIXED.
+     *
+     * @param shared Shared writer
+     * @param logId Log id stored in each record
+     * @param nodeId Node id of the view
+     */
+    RitBinaryTraceWriter(Ptr<RitBinaryTraceWriter> shared, RitTraceLogId logId, uint32_t nodeId);
+
+    ~RitBinaryTraceWriter();
+
+    RitBinaryTraceWriter(const RitBinaryTraceWriter&) = delete;
+    RitBinaryTraceWriter& operator=(const RitBinaryTraceWriter&) = delete;
+
+    /**
+     * @brief Write a record.
+     *
+     * Views forward to their shared writer; with an async writer attached the record
+     * is queued for the writer thread, otherwise it is buffered directly.
+     */
+    void Write(const RitTraceRecord& record);
+
+    /** @brief Append a record to the buffer (block write when full); writer thread side. */
+    void WriteBuffered(const RitTraceRecord& record);
+
+    /**
+     * @brief Write all buffered records to the file.
+     *
+     * No-op for views and while an attached async writer is running (it flushes on Stop()).
+     */
+    void Flush();
+
+    /**
+     * @brief Hand the disk I/O of this writer to a background thread.
+     *
+     * The async writer must outlive this writer; RitAsyncTraceWriter::Register() ensures it.
+     *
+     * @param async Async writer (not started yet)
+     */
+    void AttachAsyncWriter(Ptr<RitAsyncTraceWriter> async);
+
+    /** @brief Go back to synchronous writes (called by RitAsyncTraceWriter::Stop()). */
+    void DetachAsyncWriter();
+
+    /**
+     * @brief Drop the records rejected by a predicate before they are buffered.
+     * @param filter Returns true for the records to write (empty = write all)
+     */
+    void SetRecordFilter(std::function<bool(const RitTraceRecord&)> filter);
+
+    /** @brief Get the node id this writer belongs to. */
+    uint32_t GetNodeId() const;
+
+    /** @brief Get the number of records written so far (buffered included). */
+    uint64_t GetRecordCount() const;
+
+  private:
+    /** @brief Write the buffered records to the file as one block. */
+    void WriteBlock();
+
+    Ptr<RitBinaryTraceWriter> m_shared;   //!< Shared writer (views only)
+    RitAsyncTraceWriter* m_async = nullptr; //!< Background writer (not owned)
+    RitTraceLogId m_logId;                //!< Log id of this writer
+    std::function<bool(const RitTraceRecord&)> m_filter; //!< Record filter (RitTraceFilter)
+    std::ofstream m_file;                 //!< Output file
+    std::vector<RitTraceRecord> m_buffer; //!< Pending records
+    uint32_t m_bufferRecords;             //!< Buffer capacity [records]
+    uint32_t m_nodeId;                    //!< Node id
+    uint64_t m_recordCount = 0;           //!< Records written so far
+};
+
+/**
+ * @brief Map a MAC wait-trace event string ("start", "end", ...) to its RitTraceEvent.
+ * @param event Event string emitted by RitWpanMac
+ * @return Event id (RIT_TRACE_EV_NONE if unknown)
+ */
+RitTraceEvent RitTraceWaitEventFromString(const std::string& event);
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // RIT_TRACE_WRITER_H
@@ -10,23 +10,40 @@
 
 #include "periodic-sender-helper.h"
 
+#include "ns3/boolean.h"
+#include "ns3/clock-drift-applier.h"
+#include "ns3/double.h"
 #include "ns3/names.h"
 #include "ns3/periodic-sender.h"
 #include "ns3/random-sender.h"
+#include "ns3/rit-calendar-scheduler.h"
+#include "ns3/rit-frame-codec.h"
+#include "ns3/rit-run-arena.h"
+#include "ns3/rit-wpan-gateway-net-device.h"
 #include "ns3/rit-wpan-mac.h"
 #include "ns3/rit-wpan-net-device.h"
 #include "ns3/rit-wpan-nwk-header.h"
+#include "ns3/rit-wpan-nwk.h"
+#include "ns3/string.h"
+#include "ns3/time-drift-applier.h"
+#include "ns3/trace-replay-sender.h"
+#include "ns3/uinteger.h"
+#include <ns3/abort.h>
 #include <ns3/log.h>
 #include <ns3/lr-wpan-csmaca.h>
 #include <ns3/lr-wpan-error-model.h>
 #include <ns3/lr-wpan-net-device.h>
+#include <ns3/lr-wpan-spectrum-channel.h>
 #include <ns3/mobility-model.h>
 #include <ns3/multi-model-spectrum-channel.h>
 #include <ns3/propagation-delay-model.h>
 #include <ns3/propagation-loss-model.h>
 #include <ns3/single-model-spectrum-channel.h>
 
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
+#include <iomanip>
 #include <iostream>
 #include <sstream>
 
@@ -53,9 +70,8 @@ RitWpanNetHelper::AddMobility(Ptr<LrWpanPhy> phy, Ptr<MobilityModel> m)
     phy->SetMobility(m);
 }
 
-// TODO: complete implementation
-NetDeviceContainer
-RitWpanNetHelper::Install(NodeContainer c)
+void
+RitWpanNetHelper::CreateDefaultChannel()
 {
     if (!m_channel)
     {
@@ -67,34 +83,193 @@ RitWpanNetHelper::Install(NodeContainer c)
         m_channel->AddPropagationLossModel(propModel);
         m_channel->SetPropagationDelayModel(delayModel);
     }
+}
+
+Ptr<RitWpanNetDevice>
+RitWpanNetHelper::CreateDevice(Ptr<Node> node, Ptr<RitWpanNetDevice> netDevice)
+{
+    if (!netDevice)
+    {
+        netDevice = CreateObject<RitWpanNetDevice>();
+    }
+    netDevice->SetChannel(m_channel);
+
+    Ptr<RitWpanMac> ritMac = DynamicCast<RitWpanMac>(netDevice->GetMac());
+    ritMac->SetRxAlwaysOn(m_rxAlwaysOn);
+
+    // RIT parameters
+    netDevice->SetMacRitPeriod(m_macRitPeriod);
+    RitCalendarScheduler::AddPeriodicSource(m_macRitPeriod);
+    netDevice->SetMacRitDataWaitDuration(m_macRitDataWaitDuration);
+    netDevice->SetMacRitTxWaitDuration(m_macRitTxWaitDuration);
+    netDevice->SetRitModuleConfig(m_moduleConfig);
+    if (m_periodPolicyFactory.IsTypeIdSet())
+    {
+        ritMac->SetRitPeriodPolicy(m_periodPolicyFactory.Create<RitPeriodPolicy>());
+    }
+
+    node->AddDevice(netDevice);
+    netDevice->SetNode(node);
+    return netDevice;
+}
+
+namespace
+{
+
+/**
+ * @brief Bytes of the objects of a device stack, without the shareable ones.
+ * @return the bytes
+ */
+uint64_t
+StackObjectBytes()
+{
+    return sizeof(RitWpanNetDevice) + sizeof(LrWpanPhy) + sizeof(RitWpanMac) +
+           sizeof(LrWpanCsmaCa) + sizeof(RitCsmaCaCarrierSense) + sizeof(RitWpanPreCs) +
+           sizeof(RitCarrierSensePipeline) + sizeof(RitSimpleRouting) +
+           sizeof(RitWpanEnergyModel) + sizeof(TimeDriftApplier) + sizeof(ClockDriftApplier) +
+           sizeof(LrWpanInterferenceHelper);
+}
+
+/**
+ * @brief Bytes of a PSD.
+ * @param psd The PSD
+ * @return the bytes
+ */
+uint64_t
+PsdBytes(Ptr<const SpectrumValue> psd)
+{
+    return psd ? sizeof(SpectrumValue) + psd->GetValuesN() * sizeof(double) : 0;
+}
+
+/**
+ * @brief Seconds elapsed since a start time.
+ * @param start The start time
+ * @return the seconds
+ */
+double
+ElapsedSeconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+NetDeviceContainer
+RitWpanNetHelper::Install(NodeContainer c)
+{
+    const auto start = std::chrono::steady_clock::now();
+    CreateDefaultChannel();
 
     NetDeviceContainer devices;
+    uint64_t sharedBytes = 0;
     for (auto i = c.Begin(); i != c.End(); i++)
     {
-        Ptr<Node> node = *i;
+        Ptr<RitWpanNetDevice> netDevice = CreateDevice(*i);
+        // error model and PSDs come from the process-wide caches
+        sharedBytes = sizeof(LrWpanErrorModel) +
+                      PsdBytes(netDevice->GetPhy()->GetTxPowerSpectralDensity()) +
+                      PsdBytes(netDevice->GetPhy()->GetNoisePowerSpectralDensity());
+        devices.Add(netDevice);
+    }
 
-        Ptr<RitWpanNetDevice> netDevice = CreateObject<RitWpanNetDevice>();
-        netDevice->SetChannel(m_channel);
+    m_installReport.devices = devices.GetN();
+    m_installReport.wallSeconds = ElapsedSeconds(start);
+    m_installReport.bytesPerDevice = StackObjectBytes();
+    m_installReport.macBytesPerDevice = sizeof(RitWpanMac);
+    m_installReport.sharedBytes = sharedBytes;
+    return devices;
+}
 
-        Ptr<RitWpanMac> ritMac = DynamicCast<RitWpanMac>(netDevice->GetMac());
-        Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+NetDeviceContainer
+RitWpanNetHelper::InstallBulk(NodeContainer c)
+{
+    const auto start = std::chrono::steady_clock::now();
+    CreateDefaultChannel();
+    if (auto culled = DynamicCast<LrWpanSpectrumChannel>(m_channel))
+    {
+        culled->ReserveReceivers(culled->GetNDevices() + c.GetN());
+    }
 
-        ritMac->SetRxAlwaysOn(m_rxAlwaysOn);
+    NetDeviceContainer devices = Install(c);
+    m_installReport.wallSeconds = ElapsedSeconds(start);
+    return devices;
+}
 
-        // RIT parameters
-        // mac RIT data wait duration
-        netDevice->SetMacRitPeriod(m_macRitPeriod);
-        netDevice->SetMacRitDataWaitDuration(m_macRitDataWaitDuration);
-        netDevice->SetMacRitTxWaitDuration(m_macRitTxWaitDuration);
-        netDevice->SetRitModuleConfig(m_moduleConfig);
+RitInstallReport
+RitWpanNetHelper::GetInstallReport() const
+{
+    return m_installReport;
+}
 
-        node->AddDevice(netDevice);
-        netDevice->SetNode(node);
-        devices.Add(netDevice);
+void
+RitWpanNetHelper::Destroy()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    RitRunArena::BeginBulkTeardown();
+    Simulator::Destroy();
+    RitRunArena::EndBulkTeardown();
+    if (RitRunArena::IsEnabled())
+    {
+        RitRunArena::Disable();
+    }
+}
+
+NetDeviceContainer
+RitWpanNetHelper::InstallSinks(NodeContainer c)
+{
+    NetDeviceContainer devices = Install(c);
+    for (uint32_t i = 0; i < devices.GetN(); i++)
+    {
+        Ptr<RitWpanNetDevice> dev = DynamicCast<RitWpanNetDevice>(devices.Get(i));
+        dev->SetAddress(Mac16Address(static_cast<uint16_t>(i)));
+        dev->SetRitRank(0);
+    }
+    return devices;
+}
+
+NetDeviceContainer
+RitWpanNetHelper::InstallGateways(NodeContainer c, const std::vector<uint8_t>& extraChannels)
+{
+    CreateDefaultChannel();
+
+    NetDeviceContainer devices;
+    for (uint32_t i = 0; i < c.GetN(); i++)
+    {
+        Ptr<RitWpanGatewayNetDevice> gateway = CreateObject<RitWpanGatewayNetDevice>();
+        for (uint8_t channel : extraChannels)
+        {
+            gateway->AddRadio(channel);
+        }
+        CreateDevice(c.Get(i), gateway);
+        gateway->SetAddress(Mac16Address(static_cast<uint16_t>(i)));
+        gateway->SetRitRank(0);
+        devices.Add(gateway);
     }
     return devices;
 }
 
+int64_t
+RitWpanNetHelper::AssignStreams(NodeContainer c, int64_t stream)
+{
+    int64_t span = 0;
+    for (auto it = c.Begin(); it != c.End(); ++it)
+    {
+        for (uint32_t i = 0; i < (*it)->GetNDevices(); i++)
+        {
+            Ptr<RitWpanNetDevice> dev = DynamicCast<RitWpanNetDevice>((*it)->GetDevice(i));
+            if (!dev)
+            {
+                continue;
+            }
+            const int64_t key = dev->GetMac()->GetShortAddress().ConvertToInt();
+            const int64_t used = dev->AssignStreams(stream + key * STREAMS_PER_DEVICE);
+            NS_ASSERT_MSG(used <= STREAMS_PER_DEVICE, "Device uses more than its stream block");
+            span = std::max(span, (key + 1) * STREAMS_PER_DEVICE);
+        }
+    }
+    return span;
+}
+
 Ptr<SpectrumChannel>
 RitWpanNetHelper::GetChannel()
 {
@@ -144,6 +319,106 @@ RitWpanNetHelper::SetRitMacModuleConfig(const RitWpanMacModuleConfig& config)
     m_moduleConfig = config; // RIT MAC module configuration
 }
 
+void
+RitWpanNetHelper::SetRitPeriodPolicy(const std::string& typeId)
+{
+    m_periodPolicyFactory = ObjectFactory();
+    if (!typeId.empty())
+    {
+        m_periodPolicyFactory.SetTypeId(typeId);
+    }
+}
+
+void
+RitWpanNetHelper::AddDeviceProfile(const RitDeviceProfile& profile)
+{
+    NS_ABORT_MSG_IF(profile.name.empty(), "Device profile without name");
+    NS_ABORT_MSG_IF(!profile.macRitPeriod.IsZero() &&
+                        profile.macRitPeriod < profile.dataWaitDuration,
+                    "Device profile " << profile.name
+                                      << ": the RIT period is shorter than the data wait");
+    m_deviceProfiles[profile.name] = profile;
+}
+
+void
+RitWpanNetHelper::AssignDeviceProfile(NodeContainer c, const std::string& name)
+{
+    auto it = m_deviceProfiles.find(name);
+    NS_ABORT_MSG_IF(it == m_deviceProfiles.end(), "Unknown device profile: " << name);
+    const RitDeviceProfile& profile = it->second;
+    if (!profile.macRitPeriod.IsZero())
+    {
+        RitCalendarScheduler::AddPeriodicSource(profile.macRitPeriod);
+    }
+
+    for (auto node = c.Begin(); node != c.End(); ++node)
+    {
+        ForEachRitDevice(*node, [&profile](Ptr<RitWpanNetDevice> dev) {
+            dev->SetMacRitPeriod(profile.macRitPeriod);
+            dev->SetMacRitDataWaitDuration(profile.dataWaitDuration);
+            dev->SetMacRitTxWaitDuration(profile.txWaitDuration);
+            dev->SetRitModuleConfig(profile.moduleConfig);
+            Ptr<RitWpanMac> mac = dev->GetMac();
+            mac->SetRxAlwaysOn(profile.rxAlwaysOn);
+            mac->SetRitTimes(profile.macRitPeriod,
+                             profile.dataWaitDuration,
+                             profile.txWaitDuration);
+        });
+
+        Ptr<Application> app = GetSenderApplication(*node);
+        if (app)
+        {
+            for (const auto& [attribute, value] : profile.trafficAttributes)
+            {
+                NS_ABORT_MSG_UNLESS(app->SetAttributeFailSafe(attribute, StringValue(value)),
+                                    "Device profile " << name << ": cannot set " << attribute
+                                                      << " of the application of node "
+                                                      << (*node)->GetId());
+            }
+        }
+
+        m_deviceClasses[(*node)->GetId()] = name;
+        for (const auto& collector : m_metricsCollectors)
+        {
+            collector->SetNodeClass((*node)->GetId(), name);
+        }
+    }
+}
+
+std::string
+RitWpanNetHelper::GetDeviceClass(uint32_t nodeId) const
+{
+    auto it = m_deviceClasses.find(nodeId);
+    return it != m_deviceClasses.end() ? it->second : std::string();
+}
+
+void
+RitWpanNetHelper::AssignRxChannels(NodeContainer c, uint8_t firstChannel, uint8_t nChannels)
+{
+    NS_ABORT_MSG_IF(nChannels == 0 || firstChannel < 11 || firstChannel + nChannels - 1 > 26,
+                    "Receive channels " << +firstChannel << " + " << +nChannels
+                                        << " outside the 2.4 GHz channels 11-26");
+    if (nChannels == 1)
+    {
+        return;
+    }
+    for (auto it = c.Begin(); it != c.End(); ++it)
+    {
+        for (uint32_t i = 0; i < (*it)->GetNDevices(); i++)
+        {
+            Ptr<RitWpanNetDevice> dev = DynamicCast<RitWpanNetDevice>((*it)->GetDevice(i));
+            if (!dev)
+            {
+                continue;
+            }
+            Ptr<RitWpanMac> mac = dev->GetMac();
+            mac->SetRxChannelPlan(firstChannel, nChannels);
+            mac->SetRxChannel(
+                RitWpanMac::GetPlannedRxChannel(mac->GetShortAddress(), firstChannel, nChannels));
+        }
+    }
+}
+
 void
 RitWpanNetHelper::SetRxAlwaysOn(bool alwaysOn)
 {
@@ -188,18 +463,315 @@ RitWpanNetHelper::EnableTracePerNode(
     const std::string& logName,
     std::function<void(Ptr<Node>, Ptr<OutputStreamWrapper>)> traceSetupFn)
 {
+    RitTraceFamily family = RitTraceFamilyFromLogName(logName);
+    if (!m_traceFilter.IsFamilyEnabled(family))
+    {
+        NS_LOG_DEBUG("Trace " << logName << " disabled by the trace filter");
+        return;
+    }
+    bool filtered = m_traceFilter.HasRecordRules(family);
     for (uint32_t i = 0; i < nodes.GetN(); ++i)
     {
         Ptr<Node> node = nodes.Get(i);
+        if (!m_traceFilter.IsNodeSelected(node))
+        {
+            continue;
+        }
         uint32_t nodeId = node->GetId();
         Ptr<OutputStreamWrapper> stream = GetNodeLogStream(baseDir, nodeId, logName);
+        if (filtered)
+        {
+            Ptr<RitFilteredTraceStream> filteredStream =
+                Create<RitFilteredTraceStream>(m_traceFilter, family, stream);
+            // The sinks only hold the non-owning wrapper; keep the filter until the end
+            Simulator::ScheduleDestroy(&RitFilteredTraceStream::Flush, filteredStream);
+            stream = filteredStream->GetStream();
+        }
         traceSetupFn(node, stream);
     }
 }
 
+void
+RitWpanNetHelper::EnableBinaryTracePerNode(
+    const NodeContainer& nodes,
+    const std::string& baseDir,
+    const std::string& logName,
+    RitTraceLogId logId,
+    std::function<void(Ptr<Node>, Ptr<RitBinaryTraceWriter>)> traceSetupFn)
+{
+    RitTraceFamily family = RitTraceFamilyFromLogName(logName);
+    if (!m_traceFilter.IsFamilyEnabled(family))
+    {
+        NS_LOG_DEBUG("Trace " << logName << " disabled by the trace filter");
+        return;
+    }
+    bool filtered = m_traceFilter.HasRecordRules(family);
+    std::string binName = logName.substr(0, logName.rfind('.')) + ".bin";
+    for (uint32_t i = 0; i < nodes.GetN(); ++i)
+    {
+        Ptr<Node> node = nodes.Get(i);
+        if (!m_traceFilter.IsNodeSelected(node))
+        {
+            continue;
+        }
+        uint32_t nodeId = node->GetId();
+        Ptr<RitBinaryTraceWriter> writer;
+        if (m_traceShards > 0)
+        {
+            writer = Create<RitBinaryTraceWriter>(GetSharedBinaryWriter(baseDir, nodeId),
+                                                  logId,
+                                                  nodeId);
+        }
+        else
+        {
+            std::string filePath = GetNodeLogFilePath(baseDir, nodeId, binName);
+            writer =
+                Create<RitBinaryTraceWriter>(filePath, logId, nodeId, m_binaryTraceBufferRecords);
+            if (Ptr<RitAsyncTraceWriter> async = GetAsyncWriter())
+            {
+                writer->AttachAsyncWriter(async);
+            }
+            // Make sure everything reaches the disk even if trace sources outlive the run
+            Simulator::ScheduleDestroy(&RitBinaryTraceWriter::Flush, writer);
+        }
+        if (filtered)
+        {
+            writer->SetRecordFilter(m_traceFilter.MakeRecordFilter(family));
+        }
+        traceSetupFn(node, writer);
+    }
+}
+
+void
+RitWpanNetHelper::SetTraceFormat(RitTraceFormat format)
+{
+    m_traceFormat = format;
+}
+
+RitTraceFormat
+RitWpanNetHelper::GetTraceFormat() const
+{
+    return m_traceFormat;
+}
+
+void
+RitWpanNetHelper::SetBinaryTraceBufferSize(uint32_t records)
+{
+    NS_ABORT_MSG_IF(records == 0, "Binary trace buffer must hold at least one record");
+    m_binaryTraceBufferRecords = records;
+}
+
+void
+RitWpanNetHelper::SetTraceFilter(const RitTraceFilter& filter)
+{
+    m_traceFilter = filter;
+}
+
+const RitTraceFilter&
+RitWpanNetHelper::GetTraceFilter() const
+{
+    return m_traceFilter;
+}
+
+void
+RitWpanNetHelper::ForEachRitDevice(Ptr<Node> node,
+                                   const std::function<void(Ptr<RitWpanNetDevice>)>& fn)
+{
+    for (uint32_t j = 0; j < node->GetNDevices(); ++j)
+    {
+        Ptr<RitWpanNetDevice> dev = DynamicCast<RitWpanNetDevice>(node->GetDevice(j));
+        if (dev)
+        {
+            fn(dev);
+        }
+    }
+}
+
+Ptr<Application>
+RitWpanNetHelper::GetSenderApplication(Ptr<Node> node)
+{
+    if (node->GetNApplications() == 0)
+    {
+        return nullptr;
+    }
+    Ptr<Application> app = node->GetApplication(0);
+    if (DynamicCast<PeriodicSender>(app) || DynamicCast<RandomSender>(app) ||
+        DynamicCast<TraceReplaySender>(app))
+    {
+        return app;
+    }
+    return nullptr;
+}
+
+RitTraceRecord
+RitWpanNetHelper::MakeTraceRecord(Ptr<RitBinaryTraceWriter> writer, RitTraceEvent event)
+{
+    RitTraceRecord rec{};
+    rec.timeNs = Simulator::Now().GetNanoSeconds();
+    rec.nodeId = writer->GetNodeId();
+    rec.event = event;
+    return rec;
+}
+
+void
+RitWpanNetHelper::BinaryRitWpanMacStateSink(Ptr<RitBinaryTraceWriter> writer,
+                                            lrwpan::MacState oldState,
+                                            lrwpan::MacState newState)
+{
+    RitTraceRecord rec = MakeTraceRecord(writer, RIT_TRACE_EV_NONE);
+    rec.arg = static_cast<uint8_t>(newState);
+    writer->Write(rec);
+}
+
+void
+RitWpanNetHelper::BinaryRitWpanMacModeSink(Ptr<RitBinaryTraceWriter> writer,
+                                           RitMacMode oldMode,
+                                           RitMacMode newMode)
+{
+    RitTraceRecord rec = MakeTraceRecord(writer, RIT_TRACE_EV_NONE);
+    rec.arg = static_cast<uint8_t>(newMode);
+    writer->Write(rec);
+}
+
+void
+RitWpanNetHelper::BinaryRitWpanMacTimeoutSink(Ptr<RitBinaryTraceWriter> writer,
+                                              std::string event,
+                                              Time timestamp)
+{
+    RitTraceRecord rec = MakeTraceRecord(writer, RitTraceWaitEventFromString(event));
+    rec.timeNs = timestamp.GetNanoSeconds();
+    writer->Write(rec);
+}
+
+void
+RitWpanNetHelper::BinaryRitWpanPhyStateSink(Ptr<RitBinaryTraceWriter> writer,
+                                            Time time,
+                                            PhyEnumeration oldState,
+                                            PhyEnumeration newState)
+{
+    RitTraceRecord rec = MakeTraceRecord(writer, RIT_TRACE_EV_NONE);
+    rec.timeNs = time.GetNanoSeconds();
+    rec.arg = static_cast<uint8_t>(newState);
+    writer->Write(rec);
+}
+
+void
+RitWpanNetHelper::BinaryRitWpanNwkSink(Ptr<RitBinaryTraceWriter> writer,
+                                       RitTraceEvent event,
+                                       Ptr<const Packet> pkt)
+{
+    RitNwkHeader hdr;
+    if (!RitFrameCodec::PeekNwkHeader(pkt, hdr))
+    {
+        return;
+    }
+    RitTraceRecord rec = MakeTraceRecord(writer, event);
+    rec.uid = pkt->GetUid();
+    rec.src = hdr.GetSrcAddr().ConvertToInt();
+    rec.dst = hdr.GetDstAddr().ConvertToInt();
+    rec.addrModes = SHORT_ADDR | (SHORT_ADDR << 2);
+    rec.flags = RIT_TRACE_FLAG_HAS_HEADER;
+    writer->Write(rec);
+}
+
+void
+RitWpanNetHelper::FillTracePacketFields(RitTraceRecord& rec, Ptr<const Packet> pkt)
+{
+    if (!pkt)
+    {
+        return;
+    }
+    rec.uid = pkt->GetUid();
+    LrWpanMacHeader hdr;
+    if (!RitFrameCodec::PeekMacHeader(pkt, hdr))
+    {
+        return;
+    }
+    rec.flags = RIT_TRACE_FLAG_HAS_HEADER;
+    rec.arg = static_cast<uint8_t>(hdr.GetType());
+    uint8_t srcMode = hdr.GetSrcAddrMode();
+    uint8_t dstMode = hdr.GetDstAddrMode();
+    if (srcMode == SHORT_ADDR)
+    {
+        rec.src = hdr.GetShortSrcAddr().ConvertToInt();
+    }
+    else if (srcMode == EXT_ADDR)
+    {
+        rec.src = hdr.GetExtSrcAddr().ConvertToInt();
+    }
+    if (dstMode == SHORT_ADDR)
+    {
+        rec.dst = hdr.GetShortDstAddr().ConvertToInt();
+    }
+    else if (dstMode == EXT_ADDR)
+    {
+        rec.dst = hdr.GetExtDstAddr().ConvertToInt();
+    }
+    rec.addrModes = (srcMode & 0x03) | ((dstMode & 0x03) << 2);
+}
+
+void
+RitWpanNetHelper::BinaryRitWpanPacketSink(Ptr<RitBinaryTraceWriter> writer,
+                                          RitTraceEvent event,
+                                          Ptr<const Packet> pkt)
+{
+    RitTraceRecord rec = MakeTraceRecord(writer, event);
+    FillTracePacketFields(rec, pkt);
+    writer->Write(rec);
+}
+
+void
+RitWpanNetHelper::BinaryRitWpanPacketSinrSink(Ptr<RitBinaryTraceWriter> writer,
+                                              RitTraceEvent event,
+                                              Ptr<const Packet> pkt,
+                                              double sinr)
+{
+    RitTraceRecord rec = MakeTraceRecord(writer, event);
+    FillTracePacketFields(rec, pkt);
+    rec.value = sinr;
+    writer->Write(rec);
+}
+
+void
+RitWpanNetHelper::BinaryApplicationSink(Ptr<RitBinaryTraceWriter> writer, Ptr<const Packet> pkt)
+{
+    RitTraceRecord rec = MakeTraceRecord(writer, RIT_TRACE_EV_NONE);
+    rec.uid = pkt->GetUid();
+    writer->Write(rec);
+}
+
+void
+RitWpanNetHelper::BinaryRitWpanEnergySink(Ptr<RitBinaryTraceWriter> writer, double energy)
+{
+    RitTraceRecord rec = MakeTraceRecord(writer, RIT_TRACE_EV_NONE);
+    rec.value = energy;
+    writer->Write(rec);
+}
+
 void
 RitWpanNetHelper::EnableMacStateTracePerNode(const NodeContainer& nodes, const std::string& baseDir)
 {
+    if (m_traceFormat == RitTraceFormat::BINARY)
+    {
+        EnableBinaryTracePerNode(
+            nodes,
+            baseDir,
+            "mac-statelog.csv",
+            RIT_TRACE_LOG_MAC_STATE,
+            [](Ptr<Node> node, Ptr<RitBinaryTraceWriter> writer) {
+                ForEachRitDevice(node, [writer](Ptr<RitWpanNetDevice> dev) {
+                    Ptr<RitWpanMac> mac = dev->GetMac();
+                    if (!mac)
+                    {
+                        return;
+                    }
+                    mac->TraceConnectWithoutContext(
+                        "MacState",
+                        MakeBoundCallback(&RitWpanNetHelper::BinaryRitWpanMacStateSink, writer));
+                });
+            });
+        return;
+    }
     EnableTracePerNode(nodes,
                        baseDir,
                        "mac-statelog.csv",
@@ -229,6 +801,22 @@ RitWpanNetHelper::EnableMacStateTracePerNode(const NodeContainer& nodes, const s
 void
 RitWpanNetHelper::EnableEnergyTracePerNode(const NodeContainer& nodes, const std::string& baseDir)
 {
+    if (m_traceFormat == RitTraceFormat::BINARY)
+    {
+        EnableBinaryTracePerNode(
+            nodes,
+            baseDir,
+            "energy-node.log",
+            RIT_TRACE_LOG_ENERGY,
+            [](Ptr<Node> node, Ptr<RitBinaryTraceWriter> writer) {
+                ForEachRitDevice(node, [writer](Ptr<RitWpanNetDevice> dev) {
+                    dev->TraceConnectWithoutContext(
+                        "EnergyDepletion",
+                        MakeBoundCallback(&RitWpanNetHelper::BinaryRitWpanEnergySink, writer));
+                });
+            });
+        return;
+    }
     EnableTracePerNode(nodes,
                        baseDir,
                        "energy-node.log",
@@ -249,10 +837,81 @@ RitWpanNetHelper::EnableEnergyTracePerNode(const NodeContainer& nodes, const std
                        });
 }
 
+// Hook function for PHY duty cycle snapshots
+void
+RitWpanNetHelper::AsciiRitWpanPhyDutyCycleSink(Ptr<OutputStreamWrapper> stream,
+                                               const PhyDutyCycleCounters& counters)
+{
+    *stream->GetStream() << Simulator::Now().GetSeconds() << "," << counters.trxOff.GetSeconds()
+                         << "," << counters.rxOn.GetSeconds() << "," << counters.busyRx.GetSeconds()
+                         << "," << counters.txOn.GetSeconds() << "," << counters.busyTx.GetSeconds()
+                         << std::endl;
+}
+
+void
+RitWpanNetHelper::SetPhyDutyCycleSnapshotInterval(Time interval)
+{
+    m_phyDutyCycleSnapshotInterval = interval;
+}
+
+void
+RitWpanNetHelper::SetPhyStateTraceEnabled(bool enabled)
+{
+    m_phyStateTraceEnabled = enabled;
+}
+
+// Automated helper method to enable per-node PHY duty cycle logging
+void
+RitWpanNetHelper::EnablePhyDutyCycleTracePerNode(const NodeContainer& nodes,
+                                                 const std::string& baseDir)
+{
+    // One row per snapshot interval: always ASCII, even in RitTraceFormat::BINARY
+    Time interval = m_phyDutyCycleSnapshotInterval;
+    EnableTracePerNode(nodes,
+                       baseDir,
+                       "phy-dutycycle.csv",
+                       [interval](Ptr<Node> node, Ptr<OutputStreamWrapper> stream) {
+                           ForEachRitDevice(node, [stream, interval](Ptr<RitWpanNetDevice> dev) {
+                               Ptr<LrWpanPhy> phy = dev->GetPhy();
+                               if (!phy)
+                               {
+                                   return;
+                               }
+                               phy->SetDutyCycleSnapshotInterval(interval);
+                               phy->TraceConnectWithoutContext(
+                                   "DutyCycleSnapshot",
+                                   MakeBoundCallback(
+                                       &RitWpanNetHelper::AsciiRitWpanPhyDutyCycleSink,
+                                       stream));
+                           });
+                       });
+}
+
 // Automated helper method to enable per-node PHY state tracing
 void
 RitWpanNetHelper::EnablePhyStateTracePerNode(const NodeContainer& nodes, const std::string& baseDir)
 {
+    if (m_traceFormat == RitTraceFormat::BINARY)
+    {
+        EnableBinaryTracePerNode(
+            nodes,
+            baseDir,
+            "phy-statelog.csv",
+            RIT_TRACE_LOG_PHY_STATE,
+            [](Ptr<Node> node, Ptr<RitBinaryTraceWriter> writer) {
+                ForEachRitDevice(node, [writer](Ptr<RitWpanNetDevice> dev) {
+                    Ptr<LrWpanPhy> phy = dev->GetPhy();
+                    if (!phy)
+                    {
+                        return;
+                    }
+                    phy->TraceConnectWithoutContext(
+                        "TrxState",
+                        MakeBoundCallback(&RitWpanNetHelper::BinaryRitWpanPhyStateSink, writer));
+                });
+            });
+        return;
+    }
     NS_LOG_DEBUG("[DEBUG] Enabling PHY state trace for nodes in " << baseDir);
     EnableTracePerNode(
         nodes,
@@ -293,7 +952,7 @@ RitWpanNetHelper::AsciiRitWpanNwkTxSink(Ptr<OutputStreamWrapper> stream,
                                         Ptr<const Packet> pkt)
 {
     RitNwkHeader hdr;
-    if (!pkt->PeekHeader(hdr))
+    if (!RitFrameCodec::PeekNwkHeader(pkt, hdr))
     {
         return;
     }
@@ -320,7 +979,7 @@ RitWpanNetHelper::AsciiRitWpanNwkRxSink(Ptr<OutputStreamWrapper> stream,
                                         Ptr<const Packet> pkt)
 {
     RitNwkHeader hdr;
-    if (!pkt->PeekHeader(hdr))
+    if (!RitFrameCodec::PeekNwkHeader(pkt, hdr))
     {
         return;
     }
@@ -343,6 +1002,44 @@ RitWpanNetHelper::AsciiRitWpanNwkRxSink(Ptr<OutputStreamWrapper> stream,
 void
 RitWpanNetHelper::EnableNwkTxTracePerNode(const NodeContainer& nodes, const std::string& baseDir)
 {
+    if (m_traceFormat == RitTraceFormat::BINARY)
+    {
+        EnableBinaryTracePerNode(
+            nodes,
+            baseDir,
+            "nwk-txlog.csv",
+            RIT_TRACE_LOG_NWK_TX,
+            [](Ptr<Node> node, Ptr<RitBinaryTraceWriter> writer) {
+                ForEachRitDevice(node, [writer](Ptr<RitWpanNetDevice> dev) {
+                    Ptr<RitSimpleRouting> nwk = dev->GetNwk();
+                    if (!nwk)
+                    {
+                        return;
+                    }
+                    nwk->TraceConnectWithoutContext(
+                        "NwkTx",
+                        MakeBoundCallback(&RitWpanNetHelper::BinaryRitWpanNwkSink,
+                                          writer,
+                                          RIT_TRACE_EV_TX));
+                    nwk->TraceConnectWithoutContext(
+                        "NwkTxOk",
+                        MakeBoundCallback(&RitWpanNetHelper::BinaryRitWpanNwkSink,
+                                          writer,
+                                          RIT_TRACE_EV_TX_OK));
+                    nwk->TraceConnectWithoutContext(
+                        "NwkTxDrop",
+                        MakeBoundCallback(&RitWpanNetHelper::BinaryRitWpanNwkSink,
+                                          writer,
+                                          RIT_TRACE_EV_TX_DROP));
+                    nwk->TraceConnectWithoutContext(
+                        "NwkReTx",
+                        MakeBoundCallback(&RitWpanNetHelper::BinaryRitWpanNwkSink,
+                                          writer,
+                                          RIT_TRACE_EV_RE_TX));
+                });
+            });
+        return;
+    }
     EnableTracePerNode(
         nodes,
         baseDir,
@@ -379,6 +1076,34 @@ RitWpanNetHelper::EnableNwkTxTracePerNode(const NodeContainer& nodes, const std:
 void
 RitWpanNetHelper::EnableNwkRxTracePerNode(const NodeContainer& nodes, const std::string& baseDir)
 {
+    if (m_traceFormat == RitTraceFormat::BINARY)
+    {
+        EnableBinaryTracePerNode(
+            nodes,
+            baseDir,
+            "nwk-rxlog.csv",
+            RIT_TRACE_LOG_NWK_RX,
+            [](Ptr<Node> node, Ptr<RitBinaryTraceWriter> writer) {
+                ForEachRitDevice(node, [writer](Ptr<RitWpanNetDevice> dev) {
+                    Ptr<RitSimpleRouting> nwk = dev->GetNwk();
+                    if (!nwk)
+                    {
+                        return;
+                    }
+                    nwk->TraceConnectWithoutContext(
+                        "NwkRx",
+                        MakeBoundCallback(&RitWpanNetHelper::BinaryRitWpanNwkSink,
+                                          writer,
+                                          RIT_TRACE_EV_RX_OK));
+                    nwk->TraceConnectWithoutContext(
+                        "NwkRxDrop",
+                        MakeBoundCallback(&RitWpanNetHelper::BinaryRitWpanNwkSink,
+                                          writer,
+                                          RIT_TRACE_EV_RX_DROP));
+                });
+            });
+        return;
+    }
     EnableTracePerNode(
         nodes,
         baseDir,
@@ -413,7 +1138,7 @@ RitWpanNetHelper::AsciiRitWpanMacTxSink(Ptr<OutputStreamWrapper> stream,
                                         Ptr<const Packet> pkt)
 {
     LrWpanMacHeader hdr;
-    if (!pkt->PeekHeader(hdr))
+    if (!RitFrameCodec::PeekMacHeader(pkt, hdr))
     {
         return;
     }
@@ -481,7 +1206,7 @@ RitWpanNetHelper::AsciiRitWpanMacRxSink(Ptr<OutputStreamWrapper> stream,
                                         Ptr<const Packet> pkt)
 {
     LrWpanMacHeader hdr;
-    if (!pkt->PeekHeader(hdr))
+    if (!RitFrameCodec::PeekMacHeader(pkt, hdr))
     {
         return;
     }
@@ -542,6 +1267,39 @@ RitWpanNetHelper::AsciiRitWpanMacRxSink(Ptr<OutputStreamWrapper> stream,
 void
 RitWpanNetHelper::EnableMacTxTracePerNode(const NodeContainer& nodes, const std::string& baseDir)
 {
+    if (m_traceFormat == RitTraceFormat::BINARY)
+    {
+        EnableBinaryTracePerNode(
+            nodes,
+            baseDir,
+            "mac-txlog.csv",
+            RIT_TRACE_LOG_MAC_TX,
+            [](Ptr<Node> node, Ptr<RitBinaryTraceWriter> writer) {
+                ForEachRitDevice(node, [writer](Ptr<RitWpanNetDevice> dev) {
+                    Ptr<RitWpanMac> mac = dev->GetMac();
+                    if (!mac)
+                    {
+                        return;
+                    }
+                    mac->TraceConnectWithoutContext(
+                        "MacTx",
+                        MakeBoundCallback(&RitWpanNetHelper::BinaryRitWpanPacketSink,
+                                          writer,
+                                          RIT_TRACE_EV_TX));
+                    mac->TraceConnectWithoutContext(
+                        "MacTxOk",
+                        MakeBoundCallback(&RitWpanNetHelper::BinaryRitWpanPacketSink,
+                                          writer,
+                                          RIT_TRACE_EV_TX_OK));
+                    mac->TraceConnectWithoutContext(
+                        "MacTxDrop",
+                        MakeBoundCallback(&RitWpanNetHelper::BinaryRitWpanPacketSink,
+                                          writer,
+                                          RIT_TRACE_EV_TX_DROP));
+                });
+            });
+        return;
+    }
     EnableTracePerNode(
         nodes,
         baseDir,
@@ -575,6 +1333,34 @@ RitWpanNetHelper::EnableMacTxTracePerNode(const NodeContainer& nodes, const std:
 void
 RitWpanNetHelper::EnableMacRxTracePerNode(const NodeContainer& nodes, const std::string& baseDir)
 {
+    if (m_traceFormat == RitTraceFormat::BINARY)
+    {
+        EnableBinaryTracePerNode(
+            nodes,
+            baseDir,
+            "mac-rxlog.csv",
+            RIT_TRACE_LOG_MAC_RX,
+            [](Ptr<Node> node, Ptr<RitBinaryTraceWriter> writer) {
+                ForEachRitDevice(node, [writer](Ptr<RitWpanNetDevice> dev) {
+                    Ptr<RitWpanMac> mac = dev->GetMac();
+                    if (!mac)
+                    {
+                        return;
+                    }
+                    mac->TraceConnectWithoutContext(
+                        "MacRx",
+                        MakeBoundCallback(&RitWpanNetHelper::BinaryRitWpanPacketSink,
+                                          writer,
+                                          RIT_TRACE_EV_RX_OK));
+                    mac->TraceConnectWithoutContext(
+                        "MacRxDrop",
+                        MakeBoundCallback(&RitWpanNetHelper::BinaryRitWpanPacketSink,
+                                          writer,
+                                          RIT_TRACE_EV_RX_DROP));
+                });
+            });
+        return;
+    }
     EnableTracePerNode(
         nodes,
         baseDir,
@@ -609,7 +1395,7 @@ RitWpanNetHelper::AsciiRitWpanPhyTxSink(Ptr<OutputStreamWrapper> stream,
                                         Ptr<const Packet> pkt)
 {
     LrWpanMacHeader hdr;
-    if (!pkt->PeekHeader(hdr))
+    if (!RitFrameCodec::PeekMacHeader(pkt, hdr))
     {
         return;
     }
@@ -642,7 +1428,7 @@ RitWpanNetHelper::AsciiRitWpanPhyRxSink(Ptr<OutputStreamWrapper> stream,
 {
     LrWpanMacHeader hdr;
     std::ostringstream srcMacStream;
-    if (pkt && pkt->PeekHeader(hdr))
+    if (pkt && RitFrameCodec::PeekMacHeader(pkt, hdr))
     {
         if (hdr.GetSrcAddrMode() == SHORT_ADDR)
         {
@@ -671,7 +1457,7 @@ RitWpanNetHelper::AsciiRitWpanPhyRxSink(Ptr<OutputStreamWrapper> stream,
 {
     LrWpanMacHeader hdr;
     std::ostringstream srcMacStream;
-    if (pkt && pkt->PeekHeader(hdr))
+    if (pkt && RitFrameCodec::PeekMacHeader(pkt, hdr))
     {
         if (hdr.GetSrcAddrMode() == SHORT_ADDR)
         {
@@ -695,6 +1481,39 @@ RitWpanNetHelper::AsciiRitWpanPhyRxSink(Ptr<OutputStreamWrapper> stream,
 void
 RitWpanNetHelper::EnablePhyTxTracePerNode(const NodeContainer& nodes, const std::string& baseDir)
 {
+    if (m_traceFormat == RitTraceFormat::BINARY)
+    {
+        EnableBinaryTracePerNode(
+            nodes,
+            baseDir,
+            "phy-txlog.csv",
+            RIT_TRACE_LOG_PHY_TX,
+            [](Ptr<Node> node, Ptr<RitBinaryTraceWriter> writer) {
+                ForEachRitDevice(node, [writer](Ptr<RitWpanNetDevice> dev) {
+                    Ptr<LrWpanPhy> phy = dev->GetPhy();
+                    if (!phy)
+                    {
+                        return;
+                    }
+                    phy->TraceConnectWithoutContext(
+                        "PhyTxBegin",
+                        MakeBoundCallback(&RitWpanNetHelper::BinaryRitWpanPacketSink,
+                                          writer,
+                                          RIT_TRACE_EV_TX_BEGIN));
+                    phy->TraceConnectWithoutContext(
+                        "PhyTxEnd",
+                        MakeBoundCallback(&RitWpanNetHelper::BinaryRitWpanPacketSink,
+                                          writer,
+                                          RIT_TRACE_EV_TX_END));
+                    phy->TraceConnectWithoutContext(
+                        "PhyTxDrop",
+                        MakeBoundCallback(&RitWpanNetHelper::BinaryRitWpanPacketSink,
+                                          writer,
+                                          RIT_TRACE_EV_TX_DROP));
+                });
+            });
+        return;
+    }
     EnableTracePerNode(
         nodes,
         baseDir,
@@ -728,6 +1547,39 @@ RitWpanNetHelper::EnablePhyTxTracePerNode(const NodeContainer& nodes, const std:
 void
 RitWpanNetHelper::EnablePhyRxTracePerNode(const NodeContainer& nodes, const std::string& baseDir)
 {
+    if (m_traceFormat == RitTraceFormat::BINARY)
+    {
+        EnableBinaryTracePerNode(
+            nodes,
+            baseDir,
+            "phy-rxlog.csv",
+            RIT_TRACE_LOG_PHY_RX,
+            [](Ptr<Node> node, Ptr<RitBinaryTraceWriter> writer) {
+                ForEachRitDevice(node, [writer](Ptr<RitWpanNetDevice> dev) {
+                    Ptr<LrWpanPhy> phy = dev->GetPhy();
+                    if (!phy)
+                    {
+                        return;
+                    }
+                    phy->TraceConnectWithoutContext(
+                        "PhyRxBegin",
+                        MakeBoundCallback(&RitWpanNetHelper::BinaryRitWpanPacketSink,
+                                          writer,
+                                          RIT_TRACE_EV_RX_BEGIN));
+                    phy->TraceConnectWithoutContext(
+                        "PhyRxEnd",
+                        MakeBoundCallback(&RitWpanNetHelper::BinaryRitWpanPacketSinrSink,
+                                          writer,
+                                          RIT_TRACE_EV_RX_END));
+                    phy->TraceConnectWithoutContext(
+                        "PhyRxDrop",
+                        MakeBoundCallback(&RitWpanNetHelper::BinaryRitWpanPacketSink,
+                                          writer,
+                                          RIT_TRACE_EV_RX_DROP));
+                });
+            });
+        return;
+    }
     EnableTracePerNode(
         nodes,
         baseDir,
@@ -866,6 +1718,76 @@ RitWpanNetHelper::GetModuleShortName(const RitWpanMacModuleConfig& config) const
     {
         tags.emplace_back("back");
     }
+    if (config.earlyRxAbortEnabled)
+    {
+        tags.emplace_back("early");
+    }
+    if (config.fusedTrxEnabled)
+    {
+        tags.emplace_back("fused");
+    }
+    if (config.idleCycleElisionEnabled)
+    {
+        tags.emplace_back("elide");
+    }
+    if (config.phaseLearningEnabled)
+    {
+        tags.emplace_back("phase");
+    }
+    if (config.overhearingAvoidanceEnabled)
+    {
+        tags.emplace_back("ovh");
+    }
+    if (config.contentionSlotsEnabled)
+    {
+        tags.emplace_back("slots");
+    }
+    if (config.beaconDeconflictionEnabled)
+    {
+        tags.emplace_back("deconf");
+    }
+    if (config.dataWaitProbeEnabled)
+    {
+        tags.emplace_back("probe");
+    }
+    if (config.ackAppointmentsEnabled)
+    {
+        tags.emplace_back("appt");
+    }
+    if (config.headerIesEnabled)
+    {
+        tags.emplace_back("ie");
+    }
+    if (config.duplicateFilterEnabled)
+    {
+        tags.emplace_back("dedup");
+    }
+    if (m_periodPolicyFactory.IsTypeIdSet())
+    {
+        tags.emplace_back("adapt");
+    }
+    // NWK options are set through the RitSimpleRouting attribute defaults
+    TypeId::AttributeInformation nwkOption;
+    if (RitSimpleRouting::GetTypeId().LookupAttributeByName("AggregationEnabled", &nwkOption) &&
+        DynamicCast<const BooleanValue>(nwkOption.initialValue)->Get())
+    {
+        tags.emplace_back("agg");
+    }
+    if (RitSimpleRouting::GetTypeId().LookupAttributeByName("AnycastEnabled", &nwkOption) &&
+        DynamicCast<const BooleanValue>(nwkOption.initialValue)->Get())
+    {
+        tags.emplace_back("any");
+    }
+    if (RitSimpleRouting::GetTypeId().LookupAttributeByName("MaxRetries", &nwkOption) &&
+        DynamicCast<const UintegerValue>(nwkOption.initialValue)->Get() > 0)
+    {
+        tags.emplace_back("retx");
+    }
+    if (RitSimpleRouting::GetTypeId().LookupAttributeByName("DuplicateDetection", &nwkOption) &&
+        DynamicCast<const BooleanValue>(nwkOption.initialValue)->Get())
+    {
+        tags.emplace_back("nwkdedup");
+    }
     // combine
     std::ostringstream oss;
     for (size_t i = 0; i < tags.size(); ++i)
@@ -898,7 +1820,16 @@ RitWpanNetHelper::EnableAllTracesPerNode(const NodeContainer& nodes,
                                         macRitDataWaitDuration,
                                         simulationDays,
                                         runNumber);
-    NS_LOG_DEBUG("[DEBUG] Enabling all traces for nodes in " << baseDir);
+    EnableAllTracesPerNode(nodes, baseDir, seed);
+}
+
+void
+RitWpanNetHelper::EnableAllTracesPerNode(const NodeContainer& nodes,
+                                         const std::string& baseDir,
+                                         uint32_t seed)
+{
+    NS_LOG_DEBUG("[DEBUG] Enabling all traces for nodes in " << baseDir << " (run " << seed
+                                                             << ")");
     EnableApplicationTracePerNode(nodes, baseDir);
     EnableMacStateTracePerNode(nodes, baseDir);
     EnableMacModeTracePerNode(nodes, baseDir);
@@ -907,10 +1838,80 @@ RitWpanNetHelper::EnableAllTracesPerNode(const NodeContainer& nodes,
     EnableMacTxTracePerNode(nodes, baseDir);
     EnableMacRxTracePerNode(nodes, baseDir);
     EnableMacTimeoutTracePerNode(nodes, baseDir);
-    EnablePhyStateTracePerNode(nodes, baseDir);
+    EnablePhyDutyCycleTracePerNode(nodes, baseDir);
+    if (m_phyStateTraceEnabled)
+    {
+        EnablePhyStateTracePerNode(nodes, baseDir);
+    }
     EnablePhyTxTracePerNode(nodes, baseDir);
     EnablePhyRxTracePerNode(nodes, baseDir);
-    // EnableEnergyTracePerNode(nodes, baseDir);
+    EnableEnergyTracePerNode(nodes, baseDir);
+}
+
+void
+RitWpanNetHelper::EnableEnergyModel(const NodeContainer& nodes,
+                                    RitRadioProfile profile,
+                                    double initialEnergy)
+{
+    for (uint32_t i = 0; i < nodes.GetN(); ++i)
+    {
+        ForEachRitDevice(nodes.Get(i), [profile, initialEnergy](Ptr<RitWpanNetDevice> dev) {
+            Ptr<RitWpanEnergyModel> energy = dev->GetEnergyModel();
+            energy->SetRadioProfile(profile);
+            energy->SetAttribute("InitialEnergy", DoubleValue(initialEnergy));
+        });
+    }
+}
+
+Ptr<RitMetricsCollector>
+RitWpanNetHelper::EnableMetricsCollector(const NodeContainer& nodes, const std::string& baseDir)
+{
+    Ptr<RitMetricsCollector> collector = Create<RitMetricsCollector>();
+    for (uint32_t i = 0; i < nodes.GetN(); ++i)
+    {
+        collector->Install(nodes.Get(i));
+    }
+    for (const auto& [nodeId, deviceClass] : m_deviceClasses)
+    {
+        collector->SetNodeClass(nodeId, deviceClass);
+    }
+    m_metricsCollectors.push_back(collector);
+    Simulator::ScheduleDestroy(&RitMetricsCollector::WriteSummaries,
+                               collector,
+                               baseDir + "summary/");
+    return collector;
+}
+
+Ptr<RitMetricsCollector>
+RitWpanNetHelper::EnableMetricsCollector(const NodeContainer& nodes,
+                                         uint32_t simulationTime,
+                                         uint32_t seed)
+{
+    std::string baseDir = GetLogBaseDir(GetModuleShortName(m_moduleConfig),
+                                        m_macRitPeriod.GetMilliSeconds(),
+                                        m_macRitTxWaitDuration.GetMilliSeconds(),
+                                        m_macRitDataWaitDuration.GetMilliSeconds(),
+                                        simulationTime,
+                                        seed);
+    return EnableMetricsCollector(nodes, baseDir);
+}
+
+Ptr<RitProgressReporter>
+RitWpanNetHelper::EnableProgressReporter(const NodeContainer& nodes,
+                                         Time interval,
+                                         const std::string& path,
+                                         Ptr<RitMetricsCollector> collector)
+{
+    Ptr<RitProgressReporter> reporter = Create<RitProgressReporter>();
+    reporter->SetInterval(interval);
+    reporter->SetOutput(path);
+    reporter->SetCollector(collector);
+    for (uint32_t i = 0; i < nodes.GetN(); ++i)
+    {
+        reporter->Install(nodes.Get(i));
+    }
+    reporter->Start();
+    return reporter;
 }
 
 std::string
@@ -932,12 +1933,108 @@ RitWpanNetHelper::GetNodeLogFilePath(const std::string& baseDir,
 Ptr<OutputStreamWrapper>
 RitWpanNetHelper::GetNodeLogStream(const std::string& baseDir,
                                    uint32_t nodeId,
-                                   const std::string& logName) const
+                                   const std::string& logName)
 {
+    if (m_traceShards > 0)
+    {
+        return GetTraceMux(baseDir, nodeId)->GetStream(nodeId, logName);
+    }
     std::string filePath = GetNodeLogFilePath(baseDir, nodeId, logName);
     return Create<OutputStreamWrapper>(filePath, std::ios::out);
 }
 
+void
+RitWpanNetHelper::EnableConsolidatedTraces(uint32_t shards)
+{
+    m_traceShards = shards;
+}
+
+void
+RitWpanNetHelper::EnableAsyncTraceWriter(uint32_t ringCapacity,
+                                         RitAsyncTraceWriter::BackpressurePolicy policy)
+{
+    NS_ABORT_MSG_IF(m_asyncWriter, "Async trace writer already in use");
+    m_asyncTraceEnabled = true;
+    m_asyncRingCapacity = ringCapacity;
+    m_asyncPolicy = policy;
+}
+
+uint64_t
+RitWpanNetHelper::GetAsyncTraceDroppedCount() const
+{
+    return m_asyncWriter ? m_asyncWriter->GetDroppedCount() : 0;
+}
+
+Ptr<RitAsyncTraceWriter>
+RitWpanNetHelper::GetAsyncWriter()
+{
+    if (!m_asyncTraceEnabled)
+    {
+        return nullptr;
+    }
+    if (!m_asyncWriter)
+    {
+        m_asyncWriter = Create<RitAsyncTraceWriter>(m_asyncRingCapacity, m_asyncPolicy);
+        // Writers are registered while traces are enabled; the thread starts with the run
+        Simulator::ScheduleNow(&RitAsyncTraceWriter::Start, m_asyncWriter);
+        Simulator::ScheduleDestroy(&RitAsyncTraceWriter::Stop, m_asyncWriter);
+    }
+    return m_asyncWriter;
+}
+
+std::string
+RitWpanNetHelper::GetShardFilePath(const std::string& baseDir,
+                                   uint32_t nodeId,
+                                   const std::string& extension) const
+{
+    std::ostringstream oss;
+    oss << baseDir << "trace-" << std::setw(2) << std::setfill('0') << (nodeId % m_traceShards)
+        << extension;
+    return oss.str();
+}
+
+Ptr<RitTraceMux>
+RitWpanNetHelper::GetTraceMux(const std::string& baseDir, uint32_t nodeId)
+{
+    std::string filePath = GetShardFilePath(baseDir, nodeId, ".csv");
+    auto it = m_traceMuxes.find(filePath);
+    if (it != m_traceMuxes.end())
+    {
+        return it->second;
+    }
+    std::filesystem::create_directories(baseDir);
+    Ptr<RitTraceMux> mux = Create<RitTraceMux>(filePath);
+    // The mux owns the per-node streams; keep it until the simulation is destroyed
+    Simulator::ScheduleDestroy(&RitTraceMux::Close, mux);
+    m_traceMuxes[filePath] = mux;
+    return mux;
+}
+
+Ptr<RitBinaryTraceWriter>
+RitWpanNetHelper::GetSharedBinaryWriter(const std::string& baseDir, uint32_t nodeId)
+{
+    std::string filePath = GetShardFilePath(baseDir, nodeId, ".bin");
+    auto it = m_sharedBinaryWriters.find(filePath);
+    if (it != m_sharedBinaryWriters.end())
+    {
+        return it->second;
+    }
+    std::filesystem::create_directories(baseDir);
+    // A shared file holds many logs, so scale the buffer with the number of nodes it serves
+    Ptr<RitBinaryTraceWriter> writer =
+        Create<RitBinaryTraceWriter>(filePath,
+                                     RIT_TRACE_LOG_MIXED,
+                                     nodeId % m_traceShards,
+                                     m_binaryTraceBufferRecords * 16);
+    if (Ptr<RitAsyncTraceWriter> async = GetAsyncWriter())
+    {
+        writer->AttachAsyncWriter(async);
+    }
+    Simulator::ScheduleDestroy(&RitBinaryTraceWriter::Flush, writer);
+    m_sharedBinaryWriters[filePath] = writer;
+    return writer;
+}
+
 void
 RitWpanNetHelper::AsciiApplicationTxSink(Ptr<OutputStreamWrapper> stream, Ptr<const Packet> pkt)
 {
@@ -962,6 +2059,24 @@ void
 RitWpanNetHelper::EnableApplicationTxTracePerNode(const NodeContainer& nodes,
                                                   const std::string& baseDir)
 {
+    if (m_traceFormat == RitTraceFormat::BINARY)
+    {
+        EnableBinaryTracePerNode(
+            nodes,
+            baseDir,
+            "app-txlog.csv",
+            RIT_TRACE_LOG_APP_TX,
+            [](Ptr<Node> node, Ptr<RitBinaryTraceWriter> writer) {
+                Ptr<Application> app = GetSenderApplication(node);
+                if (app)
+                {
+                    app->TraceConnectWithoutContext(
+                        "Tx",
+                        MakeBoundCallback(&RitWpanNetHelper::BinaryApplicationSink, writer));
+                }
+            });
+        return;
+    }
     EnableTracePerNode(
         nodes,
         baseDir,
@@ -994,6 +2109,16 @@ RitWpanNetHelper::EnableApplicationTxTracePerNode(const NodeContainer& nodes,
                     MakeBoundCallback(&RitWpanNetHelper::AsciiApplicationTxSink, stream));
                 return;
             }
+
+            // Try TraceReplaySender
+            Ptr<TraceReplaySender> replaySender = DynamicCast<TraceReplaySender>(app);
+            if (replaySender)
+            {
+                replaySender->TraceConnectWithoutContext(
+                    "Tx",
+                    MakeBoundCallback(&RitWpanNetHelper::AsciiApplicationTxSink, stream));
+                return;
+            }
         });
 }
 
@@ -1001,6 +2126,24 @@ void
 RitWpanNetHelper::EnableApplicationRxTracePerNode(const NodeContainer& nodes,
                                                   const std::string& baseDir)
 {
+    if (m_traceFormat == RitTraceFormat::BINARY)
+    {
+        EnableBinaryTracePerNode(
+            nodes,
+            baseDir,
+            "app-rxlog.csv",
+            RIT_TRACE_LOG_APP_RX,
+            [](Ptr<Node> node, Ptr<RitBinaryTraceWriter> writer) {
+                Ptr<Application> app = GetSenderApplication(node);
+                if (app)
+                {
+                    app->TraceConnectWithoutContext(
+                        "Rx",
+                        MakeBoundCallback(&RitWpanNetHelper::BinaryApplicationSink, writer));
+                }
+            });
+        return;
+    }
     EnableTracePerNode(
         nodes,
         baseDir,
@@ -1033,9 +2176,82 @@ RitWpanNetHelper::EnableApplicationRxTracePerNode(const NodeContainer& nodes,
                     MakeBoundCallback(&RitWpanNetHelper::AsciiApplicationRxSink, stream));
                 return;
             }
+
+            // Try TraceReplaySender
+            Ptr<TraceReplaySender> replaySender = DynamicCast<TraceReplaySender>(app);
+            if (replaySender)
+            {
+                replaySender->TraceConnectWithoutContext(
+                    "Rx",
+                    MakeBoundCallback(&RitWpanNetHelper::AsciiApplicationRxSink, stream));
+                return;
+            }
         });
 }
 
+void
+RitWpanNetHelper::AsciiApplicationHopLatencySink(Ptr<OutputStreamWrapper> stream,
+                                                 Ptr<const Packet> pkt,
+                                                 uint32_t hop,
+                                                 const RitHopLatencyRecord& record)
+{
+    *stream->GetStream() << Simulator::Now().GetSeconds() << "," << pkt->GetUid() << "," << hop
+                         << "," << record.addr << "," << record.nwkEnqueue.GetSeconds() << ","
+                         << record.macQueueHead.GetSeconds() << ","
+                         << record.beaconWaitStart.GetSeconds() << ","
+                         << record.beaconRx.GetSeconds() << "," << record.csStart.GetSeconds()
+                         << "," << record.csEnd.GetSeconds() << ","
+                         << record.phyTxStart.GetSeconds() << std::endl;
+}
+
+void
+RitWpanNetHelper::EnableHopLatencyTracePerNode(const NodeContainer& nodes,
+                                               const std::string& baseDir)
+{
+    EnableTracePerNode(nodes,
+                       baseDir,
+                       "app-hoplatency.csv",
+                       [](Ptr<Node> node, Ptr<OutputStreamWrapper> stream) {
+                           ForEachRitDevice(node, [](Ptr<RitWpanNetDevice> dev) {
+                               Ptr<RitWpanMac> mac = dev->GetMac();
+                               if (!mac)
+                               {
+                                   return;
+                               }
+                               mac->SetAttribute("HopLatencyEnabled", BooleanValue(true));
+                           });
+                           Ptr<Application> app = GetSenderApplication(node);
+                           if (app)
+                           {
+                               app->TraceConnectWithoutContext(
+                                   "RxHopLatency",
+                                   MakeBoundCallback(
+                                       &RitWpanNetHelper::AsciiApplicationHopLatencySink,
+                                       stream));
+                           }
+                       });
+}
+
+void
+RitWpanNetHelper::EnableDelaySketchPerNode(const NodeContainer& nodes,
+                                           const std::string& baseDir,
+                                           Time interval)
+{
+    for (uint32_t i = 0; i < nodes.GetN(); ++i)
+    {
+        Ptr<Node> node = nodes.Get(i);
+        Ptr<Application> app = GetSenderApplication(node);
+        if (!app)
+        {
+            continue;
+        }
+        app->SetAttribute(
+            "DelaySketchFile",
+            StringValue(GetNodeLogFilePath(baseDir, node->GetId(), "app-delay-sketch.csv")));
+        app->SetAttribute("DelaySketchInterval", TimeValue(interval));
+    }
+}
+
 // Hook function for MAC timeout events
 void
 RitWpanNetHelper::AsciiRitWpanMacTimeoutSink(Ptr<OutputStreamWrapper> stream,
@@ -1049,6 +2265,44 @@ void
 RitWpanNetHelper::EnableMacTimeoutTracePerNode(const NodeContainer& nodes,
                                                const std::string& baseDir)
 {
+    if (m_traceFormat == RitTraceFormat::BINARY)
+    {
+        EnableBinaryTracePerNode(
+            nodes,
+            baseDir,
+            "mac-beacon-wait.csv",
+            RIT_TRACE_LOG_MAC_BEACON_WAIT,
+            [](Ptr<Node> node, Ptr<RitBinaryTraceWriter> writer) {
+                ForEachRitDevice(node, [writer](Ptr<RitWpanNetDevice> dev) {
+                    Ptr<RitWpanMac> mac = dev->GetMac();
+                    if (!mac)
+                    {
+                        return;
+                    }
+                    mac->TraceConnectWithoutContext(
+                        "BeaconWaitEvent",
+                        MakeBoundCallback(&RitWpanNetHelper::BinaryRitWpanMacTimeoutSink, writer));
+                });
+            });
+        EnableBinaryTracePerNode(
+            nodes,
+            baseDir,
+            "mac-data-wait.csv",
+            RIT_TRACE_LOG_MAC_DATA_WAIT,
+            [](Ptr<Node> node, Ptr<RitBinaryTraceWriter> writer) {
+                ForEachRitDevice(node, [writer](Ptr<RitWpanNetDevice> dev) {
+                    Ptr<RitWpanMac> mac = dev->GetMac();
+                    if (!mac)
+                    {
+                        return;
+                    }
+                    mac->TraceConnectWithoutContext(
+                        "DataWaitEvent",
+                        MakeBoundCallback(&RitWpanNetHelper::BinaryRitWpanMacTimeoutSink, writer));
+                });
+            });
+        return;
+    }
     EnableTracePerNode(
         nodes,
         baseDir,
@@ -1109,6 +2363,9 @@ RitWpanNetHelper::AsciiRitWpanMacModeSink(Ptr<OutputStreamWrapper> stream,
     case RitMacMode::SENDER_MODE:
         macMode = "Sender";
         break;
+    case RitMacMode::STROBE_MODE:
+        macMode = "Strobe";
+        break;
     case RitMacMode::RIT_MODE_DISABLED:
         macMode = "RIT Disabled";
         break;
@@ -1119,6 +2376,27 @@ RitWpanNetHelper::AsciiRitWpanMacModeSink(Ptr<OutputStreamWrapper> stream,
 void
 RitWpanNetHelper::EnableMacModeTracePerNode(const NodeContainer& nodes, const std::string& baseDir)
 {
+    if (m_traceFormat == RitTraceFormat::BINARY)
+    {
+        EnableBinaryTracePerNode(
+            nodes,
+            baseDir,
+            "mac-mode.csv",
+            RIT_TRACE_LOG_MAC_MODE,
+            [](Ptr<Node> node, Ptr<RitBinaryTraceWriter> writer) {
+                ForEachRitDevice(node, [writer](Ptr<RitWpanNetDevice> dev) {
+                    Ptr<RitWpanMac> mac = dev->GetMac();
+                    if (!mac)
+                    {
+                        return;
+                    }
+                    mac->TraceConnectWithoutContext(
+                        "MacMode",
+                        MakeBoundCallback(&RitWpanNetHelper::BinaryRitWpanMacModeSink, writer));
+                });
+            });
+        return;
+    }
     EnableTracePerNode(
         nodes,
         baseDir,
@@ -12,6 +12,7 @@
 #include "ns3/net-device-container.h"
 #include "ns3/node-container.h"
 #include "ns3/nstime.h"
+#include "ns3/object-factory.h"
 #include "ns3/object.h"
 #include "ns3/output-stream-wrapper.h"
 #include "ns3/ptr.h"
@@ -20,15 +21,60 @@
 #include "ns3/rit-wpan-mac.h"        // RitMacMode, MacState, module config
 #include "ns3/rit-wpan-net-device.h" // RitWpanNetDevice
 #include "ns3/lr-wpan-phy.h"         // PhyEnumeration (trace sink signature)
+#include "ns3/rit-async-trace-writer.h" // RitAsyncTraceWriter (background trace I/O)
+#include "ns3/rit-metrics-collector.h" // RitMetricsCollector (online summaries)
+#include "ns3/rit-progress-reporter.h" // RitProgressReporter (live run telemetry)
+#include "ns3/rit-trace-filter.h"    // RitTraceFilter (trace selection / sampling)
+#include "ns3/rit-trace-mux.h"       // RitTraceMux (consolidated ASCII traces)
+#include "ns3/rit-trace-writer.h"    // RitTraceFormat, RitBinaryTraceWriter
 
 #include <functional>
+#include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace ns3
 {
 namespace lrwpan
 {
 
+/**
+ * @brief Cost of the last RitWpanNetHelper::Install() or InstallBulk() call.
+ *
+ * The byte counts add up the sizes of the objects of the stack (device, PHY, MAC,
+ * CSMA-CA, carrier-sense stages, NWK, energy model, drift appliers, interference
+ * helper, error model, PSDs); the heap memory behind their containers, attributes
+ * and traces comes on top of it. They track the per-node footprint from one
+ * version to the next rather than the process size.
+ */
+struct RitInstallReport
+{
+    uint32_t devices = 0;           //!< Devices installed
+    double wallSeconds = 0.0;       //!< Wall-clock time of the call [s]
+    uint64_t bytesPerDevice = 0;    //!< Object bytes owned by each device
+    uint64_t macBytesPerDevice = 0; //!< Of which the RitWpanMac object
+    uint64_t sharedBytes = 0;       //!< Object bytes shared by all the devices
+};
+
+/**
+ * @brief RIT settings of a device class (e.g. mains-powered routers, battery leaves).
+ *
+ * Registered with RitWpanNetHelper::AddDeviceProfile() and applied to installed nodes by
+ * RitWpanNetHelper::AssignDeviceProfile(). The traffic attributes are set on the sender
+ * application of the node (see PeriodicSender, RandomSender), if it has one.
+ */
+struct RitDeviceProfile
+{
+    std::string name;                    //!< Device class, key of the profile
+    Time macRitPeriod;                   //!< RIT beacon interval (BI), zero for no RIT cycle
+    Time dataWaitDuration;               //!< Receiver data wait duration (DWD)
+    Time txWaitDuration;                 //!< Sender TX wait duration (TWD)
+    bool rxAlwaysOn = false;             //!< Receiver kept on between the RIT cycles
+    RitWpanMacModuleConfig moduleConfig; //!< RIT MAC modules
+    std::vector<std::pair<std::string, std::string>> trafficAttributes; //!< Name, value
+};
+
 /**
  * @ingroup lrwpan
  *
@@ -88,6 +134,85 @@ class RitWpanNetHelper
      */
     NetDeviceContainer Install(NodeContainer c);
 
+    /**
+     * @brief Install RitWpanNetDevice on each node, for very large node counts.
+     *
+     * As Install(), but the receiver list of a LrWpanSpectrumChannel is sized for
+     * the new devices first. With both, the devices share the LrWpanErrorModel and
+     * the transmit and noise PSDs of the process (LrWpanErrorModel::GetShared(),
+     * LrWpanSpectrumValueHelper::GetSharedTxPowerSpectralDensity()).
+     * The simulation is the same as with Install().
+     *
+     * @param c Nodes to install devices on
+     * @return Container of installed devices
+     */
+    NetDeviceContainer InstallBulk(NodeContainer c);
+
+    /**
+     * @brief Get the cost of the last Install() or InstallBulk() call.
+     * @return the report (InstallSinks() reports as Install())
+     */
+    RitInstallReport GetInstallReport() const;
+
+    /**
+     * @brief Call Simulator::Destroy() as a bulk teardown of the whole network.
+     *
+     * The rit-wpan objects disposed on the way skip the cancelling of their events and
+     * the emptying of their tables (see RitRunArena), which only costs time when every
+     * node goes at once. A RitRunArena enabled for the run is disabled afterwards, and
+     * released once the last object of the run is freed. Call it at the end of the run
+     * in place of Simulator::Destroy(), and do not reuse the disposed objects.
+     */
+    static void Destroy();
+
+    /**
+     * @brief Install RitWpanNetDevice on the sink nodes of the network.
+     *
+     * As Install(), then each device takes rank 0 and the short address of its
+     * position in the container (00:00 for the first sink). Routers are numbered
+     * after the sinks (see RitWpanRankHelper). Packets sent to
+     * RitSimpleRouting::GetAnySinkAddress() are delivered by whichever sink they
+     * reach.
+     *
+     * @param c Sink nodes
+     * @return Container of installed devices
+     */
+    NetDeviceContainer InstallSinks(NodeContainer c);
+
+    /**
+     * @brief Install multi-radio gateways (RitWpanGatewayNetDevice) on the sink nodes.
+     *
+     * As InstallSinks(), each gateway with a receive-only radio per extra channel beside
+     * radio 0. Give radio 0 its channel with AssignRxChannels() on the whole network,
+     * from a plan that leaves the extra channels out.
+     *
+     * @param c Sink nodes
+     * @param extraChannels Receive channels of the extra radios of each gateway
+     * @return Container of installed devices
+     */
+    NetDeviceContainer InstallGateways(NodeContainer c, const std::vector<uint8_t>& extraChannels);
+
+    /**
+     * @brief Number of stream indices reserved for each device by AssignStreams().
+     */
+    static constexpr int64_t STREAMS_PER_DEVICE = 16;
+
+    /**
+     * @brief Assign fixed random variable streams to the devices of the nodes.
+     *
+     * Each RitWpanNetDevice takes the block of STREAMS_PER_DEVICE indices starting
+     * at stream + address * STREAMS_PER_DEVICE, its short address being the key:
+     * a node draws the same numbers whatever the order in which the nodes were
+     * created and installed and whatever the other nodes of the network. Call it
+     * after the addresses are set and before the simulation starts.
+     *
+     * @param c Nodes whose devices are covered
+     * @param stream First stream index to use
+     * @return the number of stream indices spanned, up to the block of the largest
+     *         address
+     */
+    int64_t AssignStreams(NodeContainer c, int64_t stream);
+
     /**
      * @brief Set extended addresses for devices (reserved for future use / compatibility).
      * @param c NetDeviceContainer
@@ -97,6 +222,53 @@ class RitWpanNetHelper
     /** @brief Set RIT MAC module configuration. */
     void SetRitMacModuleConfig(const RitWpanMacModuleConfig& config);
 
+    /**
+     * @brief Give each installed MAC its own RIT period policy.
+     * @param typeId TypeId of a RitPeriodPolicy subclass, empty for a fixed period
+     */
+    void SetRitPeriodPolicy(const std::string& typeId);
+
+    /**
+     * @brief Register a device class; a profile registered again under its name replaces it.
+     * @param profile The profile
+     */
+    void AddDeviceProfile(const RitDeviceProfile& profile);
+
+    /**
+     * @brief Apply a registered profile to the installed devices of the nodes.
+     *
+     * The RIT times, the receiver mode and the modules of each RitWpanNetDevice take the
+     * values of the profile (the RIT times from the next beacon on), the traffic attributes
+     * go to the sender application, and the nodes are accounted under the class by the
+     * metrics collectors of this helper. Call it after the applications are installed;
+     * the nodes of a mixed network can be installed in one pass and then classified.
+     *
+     * @param c Nodes whose devices are covered
+     * @param name Name of the profile
+     */
+    void AssignDeviceProfile(NodeContainer c, const std::string& name);
+
+    /**
+     * @brief Get the device class of a node.
+     * @param nodeId Node ID
+     * @return the name of the last profile assigned to it, empty if none
+     */
+    std::string GetDeviceClass(uint32_t nodeId) const;
+
+    /**
+     * @brief Give the devices of the nodes per-node receive channels.
+     *
+     * Each MAC beacons and listens on RitWpanMac::GetPlannedRxChannel() of its short
+     * address, from firstChannel to firstChannel + nChannels - 1, and gets the plan
+     * to find the channel of its next hop. Call it after the addresses are set; one
+     * channel leaves the MACs on their PHY channel.
+     *
+     * @param c Nodes whose devices are covered
+     * @param firstChannel First channel of the plan (11 to 26)
+     * @param nChannels Number of channels
+     */
+    void AssignRxChannels(NodeContainer c, uint8_t firstChannel, uint8_t nChannels);
+
     /**
      * @brief Generic helper: enable a per-node trace and write to a per-node log file.
      *
@@ -110,6 +282,87 @@ class RitWpanNetHelper
                             const std::string& logName,
                             std::function<void(Ptr<Node>, Ptr<OutputStreamWrapper>)> traceSetupFn);
 
+    /**
+     * @brief Generic helper: enable a per-node trace written as binary records.
+     *
+     * The log is written to "<logName stem>.bin" next to where the ASCII log would be.
+     *
+     * @param nodes Target nodes
+     * @param baseDir Base directory
+     * @param logName Log file name of the equivalent ASCII log (e.g., "mac-txlog.csv")
+     * @param logId Log id stored in the file header
+     * @param traceSetupFn Callback that connects trace sources on the node
+     */
+    void EnableBinaryTracePerNode(
+        const NodeContainer& nodes,
+        const std::string& baseDir,
+        const std::string& logName,
+        RitTraceLogId logId,
+        std::function<void(Ptr<Node>, Ptr<RitBinaryTraceWriter>)> traceSetupFn);
+
+    /**
+     * @brief Select the output format used by the Enable*TracePerNode() wrappers.
+     *
+     * ASCII (default) writes the CSV logs directly. BINARY writes fixed-size records
+     * through a user-space buffer; convert them with analysis/common/trace_decoder.py.
+     * The energy trace is always written as ASCII.
+     */
+    void SetTraceFormat(RitTraceFormat format);
+
+    /** @brief Get the output format used by the Enable*TracePerNode() wrappers. */
+    RitTraceFormat GetTraceFormat() const;
+
+    /** @brief Set the number of records buffered per binary trace file (default 512). */
+    void SetBinaryTraceBufferSize(uint32_t records);
+
+    /**
+     * @brief Write the traces of all nodes into a few shared files instead of node-* files.
+     *
+     * Node n writes to "<baseDir>trace-<n % shards>.csv" (or ".bin" in BINARY format),
+     * each line/record tagged with node id and log name. EnableTracePerNode() callbacks
+     * are unchanged. Split the files with analysis/common/trace_decoder.py.
+     *
+     * @param shards Number of shard files per run (0 restores per-node files)
+     */
+    void EnableConsolidatedTraces(uint32_t shards = 1);
+
+    /**
+     * @brief Move binary trace disk I/O to a background writer thread.
+     *
+     * Sinks push records into a lock-free single-producer/single-consumer ring; the
+     * writer thread buffers and writes them. Only affects RitTraceFormat::BINARY.
+     *
+     * @param ringCapacity Ring capacity in records (rounded up to a power of two)
+     * @param policy What to do when the ring is full (block the simulator or drop and count)
+     */
+    void EnableAsyncTraceWriter(
+        uint32_t ringCapacity = 65536,
+        RitAsyncTraceWriter::BackpressurePolicy policy = RitAsyncTraceWriter::BLOCK);
+
+    /** @brief Get the number of trace records dropped by the async writer (DROP policy). */
+    uint64_t GetAsyncTraceDroppedCount() const;
+
+    /**
+     * @brief Restrict the traces written by the Enable*TracePerNode() wrappers.
+     *
+     * Applies to every trace enabled after this call, EnableAllTracesPerNode() included:
+     * disabled families and unselected nodes get no log at all, time windows and
+     * sampling are applied per record before any I/O. See RitTraceFilter.
+     *
+     * Example: rank <= 2 only, skip the first hour, 1 in 10 RIT Data Requests
+     * @code
+     * RitTraceFilter filter;
+     * filter.SetMaxRank(2);
+     * filter.AddTimeWindow(Hours(1), Time::Max());
+     * filter.SetRitDataRequestSampling(10);
+     * helper.SetTraceFilter(filter);
+     * @endcode
+     */
+    void SetTraceFilter(const RitTraceFilter& filter);
+
+    /** @brief Get the trace filter (keeps everything by default). */
+    const RitTraceFilter& GetTraceFilter() const;
+
     // Convenience wrappers built on EnableTracePerNode()
     void EnableMacStateTracePerNode(const NodeContainer& nodes, const std::string& baseDir);
     void EnableEnergyTracePerNode(const NodeContainer& nodes, const std::string& baseDir);
@@ -121,6 +374,38 @@ class RitWpanNetHelper
     void EnableMacTimeoutTracePerNode(const NodeContainer& nodes, const std::string& baseDir);
     void EnableMacModeTracePerNode(const NodeContainer& nodes, const std::string& baseDir);
 
+    /**
+     * @brief Configure the radio energy model of the installed devices.
+     *
+     * The consumed energy is reported by the "EnergyDepletion" trace of RitWpanNetDevice
+     * (energy-node.log) and the node lifetime by RitWpanEnergyModel::GetLifetimeEstimate().
+     *
+     * @param nodes Target nodes
+     * @param profile Per-state current draw of the radio
+     * @param initialEnergy Battery capacity [J] (0 = unlimited)
+     */
+    void EnableEnergyModel(const NodeContainer& nodes,
+                           RitRadioProfile profile,
+                           double initialEnergy = 0.0);
+
+    /**
+     * @brief Log the PHY time-in-state counters periodically (phy-dutycycle.csv).
+     *
+     * Each row holds the cumulative TRX_OFF, RX_ON, BUSY_RX, TX_ON and BUSY_TX times in
+     * seconds; the last row is written when the PHY is disposed. This replaces
+     * phy-statelog.csv for wake-ratio analysis.
+     */
+    void EnablePhyDutyCycleTracePerNode(const NodeContainer& nodes, const std::string& baseDir);
+
+    /** @brief Set the snapshot interval used by EnablePhyDutyCycleTracePerNode(). */
+    void SetPhyDutyCycleSnapshotInterval(Time interval);
+
+    /**
+     * @brief Include the per-transition PHY state log (phy-statelog.csv) in
+     * EnableAllTracesPerNode(). Off by default; intended for debugging.
+     */
+    void SetPhyStateTraceEnabled(bool enabled);
+
     /**
      * @brief Enable all traces using a precomputed base directory.
      *
@@ -144,6 +429,39 @@ class RitWpanNetHelper
     /** @brief Enable all traces with base directory automatically derived from current settings. */
     void EnableAllTracesPerNode(const NodeContainer& nodes, uint32_t simulationTime, uint32_t seed);
 
+    /**
+     * @brief Aggregate PDR, latency and wake ratio online instead of post-processing raw logs.
+     *
+     * The summary tables are written to `<baseDir>summary/` at Simulator::Destroy().
+     * Can be combined with or used instead of the per-node traces. The nodes given a
+     * device profile, before or after, are broken down by class (class-summary.csv).
+     *
+     * @param nodes Target nodes
+     * @param baseDir Base directory of the run
+     * @return The collector (e.g. to query results before Simulator::Destroy())
+     */
+    Ptr<RitMetricsCollector> EnableMetricsCollector(const NodeContainer& nodes,
+                                                    const std::string& baseDir);
+
+    /** @brief Enable the metrics collector with base directory derived from current settings. */
+    Ptr<RitMetricsCollector> EnableMetricsCollector(const NodeContainer& nodes,
+                                                    uint32_t simulationTime,
+                                                    uint32_t seed);
+
+    /**
+     * @brief Report the progress of the run every interval of simulated time.
+     *
+     * @param nodes Nodes whose MAC mode and TX queue are followed
+     * @param interval Simulated time between two reports
+     * @param path JSON-lines file of the reports (empty: stderr)
+     * @param collector Collector giving the cumulative PDR (may be null)
+     * @return The started reporter
+     */
+    Ptr<RitProgressReporter> EnableProgressReporter(const NodeContainer& nodes,
+                                                    Time interval,
+                                                    const std::string& path = "",
+                                                    Ptr<RitMetricsCollector> collector = nullptr);
+
     // PHY Tx/Rx trace sinks (ASCII)
     static void AsciiRitWpanPhyTxSink(Ptr<OutputStreamWrapper> stream,
                                       std::string event,
@@ -160,13 +478,42 @@ class RitWpanNetHelper
     void EnablePhyTxTracePerNode(const NodeContainer& nodes, const std::string& baseDir);
     void EnablePhyRxTracePerNode(const NodeContainer& nodes, const std::string& baseDir);
 
-    // Application trace logging (PeriodicSender / RandomSender)
+    // Application trace logging (PeriodicSender / RandomSender / TraceReplaySender)
     void EnableApplicationTxTracePerNode(const NodeContainer& nodes, const std::string& baseDir);
     void EnableApplicationRxTracePerNode(const NodeContainer& nodes, const std::string& baseDir);
     static void AsciiApplicationTxSink(Ptr<OutputStreamWrapper> stream, Ptr<const Packet> pkt);
     static void AsciiApplicationRxSink(Ptr<OutputStreamWrapper> stream, Ptr<const Packet> pkt);
     void EnableApplicationTracePerNode(const NodeContainer& nodes, const std::string& baseDir);
 
+    /**
+     * @brief Log the per-hop latency breakdown of received packets (app-hoplatency.csv).
+     *
+     * Enables the HopLatencyEnabled attribute of the RitWpanMac of every node in the
+     * container (forwarders included) and writes, at the receiving application, one row
+     * per hop: time,uid,hop,addr and the stage timestamps in seconds. Always ASCII.
+     */
+    void EnableHopLatencyTracePerNode(const NodeContainer& nodes, const std::string& baseDir);
+    static void AsciiApplicationHopLatencySink(Ptr<OutputStreamWrapper> stream,
+                                               Ptr<const Packet> pkt,
+                                               uint32_t hop,
+                                               const RitHopLatencyRecord& record);
+
+    /**
+     * @brief Export the end-to-end delay sketch of the receiving applications
+     * (app-delay-sketch.csv).
+     *
+     * Each snapshot appends the cumulative non-empty buckets as time,lower_ns,upper_ns,count;
+     * only nodes that received packets write the file. Sketches of several runs are merged
+     * by analysis/common/latency_sketch.py.
+     *
+     * @param nodes Target nodes
+     * @param baseDir Base directory to write logs into
+     * @param interval Periodic snapshot interval (0 = only at the end of the run)
+     */
+    void EnableDelaySketchPerNode(const NodeContainer& nodes,
+                                  const std::string& baseDir,
+                                  Time interval = Seconds(0));
+
     /** @brief Set scenario type label used for log directory path. */
     void SetScenarioType(const std::string& scenarioType);
 
@@ -198,12 +545,65 @@ class RitWpanNetHelper
                                          PhyEnumeration oldState,
                                          PhyEnumeration newState);
 
+    // PHY duty cycle sink
+    static void AsciiRitWpanPhyDutyCycleSink(Ptr<OutputStreamWrapper> stream,
+                                             const PhyDutyCycleCounters& counters);
+
     // MAC timeout sink
     static void AsciiRitWpanMacTimeoutSink(Ptr<OutputStreamWrapper> stream, std::string event, Time timestamp);
 
     // MAC mode sink
     static void AsciiRitWpanMacModeSink(Ptr<OutputStreamWrapper> stream, RitMacMode oldMode, RitMacMode newMode);
 
+    // Binary sinks (RitTraceFormat::BINARY)
+    static RitTraceRecord MakeTraceRecord(Ptr<RitBinaryTraceWriter> writer, RitTraceEvent event);
+    static void FillTracePacketFields(RitTraceRecord& rec, Ptr<const Packet> pkt);
+    static void BinaryRitWpanMacStateSink(Ptr<RitBinaryTraceWriter> writer,
+                                          lrwpan::MacState oldState,
+                                          lrwpan::MacState newState);
+    static void BinaryRitWpanMacModeSink(Ptr<RitBinaryTraceWriter> writer,
+                                         RitMacMode oldMode,
+                                         RitMacMode newMode);
+    static void BinaryRitWpanMacTimeoutSink(Ptr<RitBinaryTraceWriter> writer,
+                                            std::string event,
+                                            Time timestamp);
+    static void BinaryRitWpanPhyStateSink(Ptr<RitBinaryTraceWriter> writer,
+                                          Time time,
+                                          PhyEnumeration oldState,
+                                          PhyEnumeration newState);
+    static void BinaryRitWpanNwkSink(Ptr<RitBinaryTraceWriter> writer,
+                                     RitTraceEvent event,
+                                     Ptr<const Packet> pkt);
+    static void BinaryRitWpanPacketSink(Ptr<RitBinaryTraceWriter> writer,
+                                        RitTraceEvent event,
+                                        Ptr<const Packet> pkt);
+    static void BinaryRitWpanPacketSinrSink(Ptr<RitBinaryTraceWriter> writer,
+                                            RitTraceEvent event,
+                                            Ptr<const Packet> pkt,
+                                            double sinr);
+    static void BinaryApplicationSink(Ptr<RitBinaryTraceWriter> writer, Ptr<const Packet> pkt);
+    static void BinaryRitWpanEnergySink(Ptr<RitBinaryTraceWriter> writer, double energy);
+
+    /**
+     * @brief Create and configure the device of a node.
+     * @param node The node
+     * @param netDevice The device to configure, a new RitWpanNetDevice if null
+     * @return the device, added to the node
+     */
+    Ptr<RitWpanNetDevice> CreateDevice(Ptr<Node> node, Ptr<RitWpanNetDevice> netDevice = nullptr);
+
+    /**
+     * @brief Create the default channel if none was set.
+     */
+    void CreateDefaultChannel();
+
+    /** @brief Call fn for every RitWpanNetDevice installed on the node. */
+    static void ForEachRitDevice(Ptr<Node> node,
+                                 const std::function<void(Ptr<RitWpanNetDevice>)>& fn);
+
+    /** @brief Get the first application of the node if it is one of the sender applications. */
+    static Ptr<Application> GetSenderApplication(Ptr<Node> node);
+
     // Per-node log helpers
     std::string GetNodeLogDir(const std::string& baseDir, uint32_t nodeId) const;
     std::string GetNodeLogFilePath(const std::string& baseDir,
@@ -211,7 +611,17 @@ class RitWpanNetHelper
                                    const std::string& logName) const;
     Ptr<OutputStreamWrapper> GetNodeLogStream(const std::string& baseDir,
                                               uint32_t nodeId,
-                                              const std::string& logName) const;
+                                              const std::string& logName);
+
+    // Consolidated log helpers
+    std::string GetShardFilePath(const std::string& baseDir,
+                                 uint32_t nodeId,
+                                 const std::string& extension) const;
+    Ptr<RitTraceMux> GetTraceMux(const std::string& baseDir, uint32_t nodeId);
+    Ptr<RitBinaryTraceWriter> GetSharedBinaryWriter(const std::string& baseDir, uint32_t nodeId);
+
+    /** @brief Get (and create on first use) the async writer, or nullptr if disabled. */
+    Ptr<RitAsyncTraceWriter> GetAsyncWriter();
 
     Ptr<SpectrumChannel> m_channel;
     Time m_macRitPeriod;
@@ -220,9 +630,31 @@ class RitWpanNetHelper
     double m_riMacDriftRatio = 0.0;
     bool m_rxAlwaysOn = false;
     RitWpanMacModuleConfig m_moduleConfig;
+    ObjectFactory m_periodPolicyFactory; //!< RIT period policy, unset for a fixed period
+    RitInstallReport m_installReport;    //!< Cost of the last install
+    std::map<std::string, RitDeviceProfile> m_deviceProfiles;  //!< Device classes by name
+    std::map<uint32_t, std::string> m_deviceClasses;           //!< Class of each node ID
+    std::vector<Ptr<RitMetricsCollector>> m_metricsCollectors; //!< Told the node classes
+
+    Time m_phyDutyCycleSnapshotInterval = Seconds(60);
+    bool m_phyStateTraceEnabled = false;
 
     std::string m_baseLogDirectory;
     std::string m_scenarioType = "default";
+
+    RitTraceFormat m_traceFormat = RitTraceFormat::ASCII;
+    uint32_t m_binaryTraceBufferRecords = 512;
+
+    uint32_t m_traceShards = 0; //!< 0: per-node files, otherwise number of shared files
+    std::map<std::string, Ptr<RitTraceMux>> m_traceMuxes;
+    std::map<std::string, Ptr<RitBinaryTraceWriter>> m_sharedBinaryWriters;
+
+    RitTraceFilter m_traceFilter; //!< Trace selection applied by Enable*TracePerNode()
+
+    bool m_asyncTraceEnabled = false;
+    uint32_t m_asyncRingCapacity = 65536;
+    RitAsyncTraceWriter::BackpressurePolicy m_asyncPolicy = RitAsyncTraceWriter::BLOCK;
+    Ptr<RitAsyncTraceWriter> m_asyncWriter;
 };
 
 } // namespace lrwpan
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "trace-replay-sender-helper.h"
+
+#include "ns3/log.h"
+#include "ns3/rit-wpan-net-device.h"
+#include "ns3/trace-replay-sender.h"
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_LOG_COMPONENT_DEFINE("TraceReplaySenderHelper");
+
+TraceReplaySenderHelper::TraceReplaySenderHelper(const std::string& traceFile)
+    : m_dstAddr()
+{
+    m_factory.SetTypeId("ns3::lrwpan::TraceReplaySender");
+    m_trace = CreateObject<RitTrafficTrace>();
+    m_trace->Open(traceFile);
+}
+
+void
+TraceReplaySenderHelper::SetAttribute(std::string name, const AttributeValue& value)
+{
+    m_factory.Set(name, value);
+}
+
+void
+TraceReplaySenderHelper::SetDstAddr(const Address& addr)
+{
+    m_dstAddr = addr;
+}
+
+Ptr<RitTrafficTrace>
+TraceReplaySenderHelper::GetTrace() const
+{
+    return m_trace;
+}
+
+ApplicationContainer
+TraceReplaySenderHelper::Install(Ptr<Node> node) const
+{
+    return ApplicationContainer(InstallPriv(node));
+}
+
+ApplicationContainer
+TraceReplaySenderHelper::Install(NodeContainer c) const
+{
+    ApplicationContainer apps;
+    for (auto i = c.Begin(); i != c.End(); ++i)
+    {
+        apps.Add(InstallPriv(*i));
+    }
+    return apps;
+}
+
+Ptr<Application>
+TraceReplaySenderHelper::InstallPriv(Ptr<Node> node) const
+{
+    Ptr<TraceReplaySender> app = m_factory.Create<TraceReplaySender>();
+    app->SetNode(node);
+    app->SetTrace(m_trace);
+    app->SetDstAddr(m_dstAddr);
+
+    // Register receive callback to the first RitWpanNetDevice found on the node
+    for (uint32_t i = 0; i < node->GetNDevices(); ++i)
+    {
+        if (auto dev = DynamicCast<RitWpanNetDevice>(node->GetDevice(i)))
+        {
+            dev->SetReceiveCallback(MakeCallback(&TraceReplaySender::ReceivePacket, app));
+            break;
+        }
+    }
+
+    node->AddApplication(app);
+    return app;
+}
+
+} // namespace lrwpan
+} // namespace ns3
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef TRACE_REPLAY_SENDER_HELPER_H
+#define TRACE_REPLAY_SENDER_HELPER_H
+
+#include "ns3/address.h"
+#include "ns3/application-container.h"
+#include "ns3/attribute.h"
+#include "ns3/node-container.h"
+#include "ns3/object-factory.h"
+#include "ns3/rit-traffic-trace.h"
+
+#include <string>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @ingroup lrwpan
+ *
+ * Helper to install TraceReplaySender applications replaying one traffic trace.
+ *
+ * Every application installed by a helper shares its RitTrafficTrace. A node is the
+ * trace node of its ns-3 node id unless the TraceNodeId attribute is set.
+ */
+class TraceReplaySenderHelper
+{
+  public:
+    /**
+     * @param traceFile Traffic trace, CSV or binary (RitTrafficTrace)
+     */
+    TraceReplaySenderHelper(const std::string& traceFile);
+
+    /**
+     * Set an attribute on the underlying TraceReplaySender application.
+     */
+    void SetAttribute(std::string name, const AttributeValue& value);
+
+    void SetDstAddr(const Address& addr);
+
+    ApplicationContainer Install(NodeContainer c) const;
+    ApplicationContainer Install(Ptr<Node> node) const;
+
+    /**
+     * @return the trace shared by the installed applications
+     */
+    Ptr<RitTrafficTrace> GetTrace() const;
+
+  private:
+    Ptr<Application> InstallPriv(Ptr<Node> node) const;
+
+    ObjectFactory m_factory;
+    Ptr<RitTrafficTrace> m_trace;
+    Address m_dstAddr;
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // TRACE_REPLAY_SENDER_HELPER_H
@@ -10,16 +10,60 @@
 
 #include <ns3/double.h>
 #include <ns3/log.h>
+#include <ns3/rng-seed-manager.h>
+#include <ns3/simulator.h>
+
+#include <algorithm>
+#include <cmath>
 
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("ClockDriftApplier");
 
+namespace
+{
+
+/**
+ * SplitMix64 finalizer
+ */
+uint64_t
+Mix64(uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+/**
+ * N(0,1) value of a knot (Box-Muller on two hashed uniforms)
+ */
+double
+HashedNormal(uint64_t key, uint64_t k)
+{
+    const uint64_t h1 = Mix64(key ^ Mix64(k));
+    const uint64_t h2 = Mix64(h1);
+    // 53-bit uniforms, u1 in (0, 1] so that the logarithm is finite
+    const double u1 = ((h1 >> 11) + 1) * (1.0 / 9007199254740992.0);
+    const double u2 = (h2 >> 11) * (1.0 / 9007199254740992.0);
+    return std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * M_PI * u2);
+}
+
+} // namespace
+
 ClockDriftApplier::ClockDriftApplier()
     : m_skew(0.0),
       m_K(1e-9), // noise coefficient K (unit: s)
+      m_skewGen(CreateObject<UniformRandomVariable>()),
       m_noiseGen(CreateObject<NormalRandomVariable>()),
+      m_streamsAssigned(false),
+      m_skewFixed(false),
+      m_knotInterval(0.0),
+      m_knotStddev(0.0),
+      m_noiseKey(0),
+      m_knotIndex(0),
+      m_knotNoise(0.0),
       m_minSkewPpm(-250.0),
       m_maxSkewPpm(250.0)
 {
@@ -35,28 +79,125 @@ ClockDriftApplier::SetSkewRange(double minPpm, double maxPpm)
 void
 ClockDriftApplier::Initialize(uint32_t nodeId, uint32_t runId)
 {
-    Ptr<UniformRandomVariable> skewGen = CreateObject<UniformRandomVariable>();
-    skewGen->SetStream(1000 + nodeId);
-
-    double ppm = skewGen->GetValue(m_minSkewPpm, m_maxSkewPpm);
-    m_skew = ppm / 1e6; // Convert ppm to a ratio
-
-    m_noiseGen->SetStream(2000 + runId);
+    if (!m_streamsAssigned)
+    {
+        m_skewGen->SetStream(1000 + nodeId);
+        m_noiseGen->SetStream(2000 + runId);
+    }
+
+    if (!m_skewFixed)
+    {
+        double ppm = m_skewGen->GetValue(m_minSkewPpm, m_maxSkewPpm);
+        m_skew = ppm / 1e6; // Convert ppm to a ratio
+    }
+
+    if (m_knotInterval > 0)
+    {
+        // The noise of a node depends only on the seed, the run, its stream and its id.
+        m_noiseKey = Mix64(Mix64(Mix64(RngSeedManager::GetSeed()) ^ RngSeedManager::GetRun()) ^
+                           static_cast<uint64_t>(m_noiseGen->GetStream())) ^
+                     Mix64(nodeId);
+        m_knotStddev = std::sqrt(m_K * m_knotInterval);
+        m_knotIndex = 0;
+        m_knotNoise = 0.0;
+    }
+
+    NS_LOG_INFO("Initialized ClockDriftApplier with skew = "
+                << GetSkewPpm() << " ppm (" << m_skew << "), stream = " << m_noiseGen->GetStream());
+}
 
-    NS_LOG_INFO("Initialized ClockDriftApplier with skew = " << ppm << " ppm (" << m_skew
-                                                             << "), stream = " << (2000 + runId));
+int64_t
+ClockDriftApplier::AssignStreams(int64_t stream)
+{
+    m_skewGen->SetStream(stream);
+    m_noiseGen->SetStream(stream + 1);
+    m_streamsAssigned = true;
+    return 2;
 }
 
 void
 ClockDriftApplier::SetSkewPpm(double ppm)
 {
     m_skew = ppm / 1e6;
+    m_skewFixed = true;
+}
+
+double
+ClockDriftApplier::GetSkewPpm() const
+{
+    return m_skew * 1e6;
 }
 
 void
 ClockDriftApplier::SetK(double k)
 {
     m_K = k;
+    m_knotStddev = std::sqrt(m_K * m_knotInterval);
+}
+
+void
+ClockDriftApplier::SetKnotInterval(Time interval)
+{
+    NS_ABORT_MSG_IF(interval.IsStrictlyNegative(), "Negative knot interval");
+    m_knotInterval = interval.GetSeconds();
+    m_knotStddev = std::sqrt(m_K * m_knotInterval);
+}
+
+double
+ClockDriftApplier::GetKnotNoise(uint64_t k) const
+{
+    // W(0) = 0 and W(k) = W(k - 1) + N(0, K * spacing): the increments are hashed, so a
+    // query earlier than the cached knot walks again from the origin with the same values.
+    if (k < m_knotIndex)
+    {
+        m_knotIndex = 0;
+        m_knotNoise = 0.0;
+    }
+    for (; m_knotIndex < k; m_knotIndex++)
+    {
+        m_knotNoise += HashedNormal(m_noiseKey, m_knotIndex) * m_knotStddev;
+    }
+    return m_knotNoise;
+}
+
+double
+ClockDriftApplier::GetNoise(double t) const
+{
+    if (t <= 0 || m_knotStddev == 0)
+    {
+        return 0.0;
+    }
+    const double pos = t / m_knotInterval;
+    const uint64_t k = static_cast<uint64_t>(pos);
+    const double w0 = GetKnotNoise(k);
+    const double w1 = w0 + HashedNormal(m_noiseKey, k) * m_knotStddev;
+    return w0 + (w1 - w0) * (pos - k);
+}
+
+Time
+ClockDriftApplier::GetOffset(Time t) const
+{
+    NS_ASSERT_MSG(m_knotInterval > 0, "Closed-form model not enabled");
+    return Seconds(t.GetSeconds() * m_skew + GetNoise(t.GetSeconds()));
+}
+
+Time
+ClockDriftApplier::ApplyAt(Time start, Time inputTime) const
+{
+    NS_ASSERT_MSG(m_knotInterval > 0, "Closed-form model not enabled");
+    const double t0 = start.GetSeconds();
+    const double d = inputTime.GetSeconds();
+    const double delay = d * (1.0 + m_skew) + GetNoise(t0 + d) - GetNoise(t0);
+    return Seconds(std::max(0.0, delay));
+}
+
+Time
+ClockDriftApplier::GetDriftBound(Time horizon) const
+{
+    const double t = std::max(0.0, horizon.GetSeconds());
+    const double skew =
+        std::max({std::abs(m_minSkewPpm) / 1e6, std::abs(m_maxSkewPpm) / 1e6, std::abs(m_skew)});
+    return Seconds(t * skew + 3.0 * std::sqrt(m_K * t));
 }
 
 double
@@ -85,6 +226,10 @@ ClockDriftApplier::GetAdjustedDelay(double t) const
 Time
 ClockDriftApplier::Apply(Time t) const
 {
+    if (m_knotInterval > 0)
+    {
+        return ApplyAt(Simulator::Now(), t);
+    }
     return Seconds(ComputeAdjustedSeconds(t.GetSeconds()));
 }
 
@@ -23,9 +23,20 @@ class ClockDriftApplier : public Object
 
     /**
      * Initialize: set skew and noise based on node ID and run ID
+     *
+     * The streams 1000 + nodeId (skew) and 2000 + runId (noise) are used unless
+     * AssignStreams() was called before.
      */
     void Initialize(uint32_t nodeId, uint32_t runId);
 
+    /**
+     * Assign fixed random variable stream numbers to the skew and noise generators
+     *
+     * @param stream First stream index to use
+     * @return the number of stream indices assigned (2)
+     */
+    int64_t AssignStreams(int64_t stream);
+
     /**
      * Return the global time difference corresponding to n seconds in local time (double version)
      */
@@ -33,14 +44,55 @@ class ClockDriftApplier : public Object
 
     /**
      * Return the global time difference corresponding to inputTime seconds in local time (Time version)
+     *
+     * In the closed-form model the interval starts now (Simulator::Now()).
      */
     Time Apply(Time inputTime) const;
 
+    /**
+     * Return the global duration of the local interval inputTime starting at global time
+     * start, from the closed-form clock offset: inputTime * (1 + skew) + W(start +
+     * inputTime) - W(start)
+     *
+     * Only valid in the closed-form model (SetKnotInterval()).
+     */
+    Time ApplyAt(Time start, Time inputTime) const;
+
+    /**
+     * Return a bound on the clock error accumulated over a local interval of horizon, for
+     * any skew of the range or the one set: the largest |skew| times horizon plus three
+     * standard deviations of the random-walk noise, sqrt(K * horizon)
+     */
+    Time GetDriftBound(Time horizon) const;
+
+    /**
+     * Use the closed-form model: the random-walk noise W(t) is sampled at knots of this
+     * interval, from a hash of the seed, the run, the noise stream and the node, and is
+     * interpolated linearly in between. Apply() then draws no random number and its results
+     * do not depend on the order of the calls. 0 (the default) keeps the per-call draw.
+     *
+     * To be called before Initialize().
+     */
+    void SetKnotInterval(Time interval);
+
+    /**
+     * Return the clock offset (global minus local time) at global time t in the
+     * closed-form model: skew * t + W(t)
+     */
+    Time GetOffset(Time t) const;
+
     /**
      * Explicitly set skew (ppm) from outside (if omitted, uniform random in ±20 ppm)
+     *
+     * A skew set before Initialize() is kept by it.
      */
     void SetSkewPpm(double ppm);
 
+    /**
+     * Return the skew (ppm) in use
+     */
+    double GetSkewPpm() const;
+
     void SetSkewRange(double minPpm, double maxPpm);
 
     /**
@@ -54,9 +106,29 @@ class ClockDriftApplier : public Object
      */
     double ComputeAdjustedSeconds(double inputSeconds) const;
 
+    /**
+     * Random-walk noise of the closed-form model at global time t (seconds)
+     */
+    double GetNoise(double t) const;
+
+    /**
+     * Random-walk noise at knot k, from the cached knot when queried in order
+     */
+    double GetKnotNoise(uint64_t k) const;
+
     double m_skew;                        // Ratio (ppm / 1e6)
     double m_K;                           // Random-walk intensity (linear coefficient of variance)
+    Ptr<UniformRandomVariable> m_skewGen; // Skew draw in [m_minSkewPpm, m_maxSkewPpm]
     Ptr<NormalRandomVariable> m_noiseGen; // N(0,1) random number generator
+    bool m_streamsAssigned;               // AssignStreams() was called
+    bool m_skewFixed;                     // SetSkewPpm() was called
+
+    // Closed-form model
+    double m_knotInterval;        // Knot spacing (s), 0 if the per-call draw is used
+    double m_knotStddev;          // Standard deviation of a knot increment, sqrt(K * spacing)
+    uint64_t m_noiseKey;          // Hash key of the knot increments
+    mutable uint64_t m_knotIndex; // Last knot evaluated
+    mutable double m_knotNoise;   // Noise at that knot
 
     double m_minSkewPpm = -20.0;
     double m_maxSkewPpm = 20.0;
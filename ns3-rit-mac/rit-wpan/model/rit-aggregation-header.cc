@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-aggregation-header.h"
+
+#include "ns3/assert.h"
+
+#include <ostream>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+void
+RitAggregationHeader::AddSubFrame(uint8_t length)
+{
+    NS_ASSERT(m_lengths.size() < UINT8_MAX);
+    m_lengths.push_back(length);
+}
+
+uint8_t
+RitAggregationHeader::GetNSubFrames() const
+{
+    return static_cast<uint8_t>(m_lengths.size());
+}
+
+uint8_t
+RitAggregationHeader::GetSubFrameLength(uint8_t index) const
+{
+    NS_ASSERT(index < m_lengths.size());
+    return m_lengths[index];
+}
+
+uint32_t
+RitAggregationHeader::GetSizeFor(uint32_t nSubFrames)
+{
+    return 1 + nSubFrames;
+}
+
+TypeId
+RitAggregationHeader::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::lrwpan::RitAggregationHeader")
+                            .SetParent<Header>()
+                            .SetGroupName("LrWpan")
+                            .AddConstructor<RitAggregationHeader>();
+    return tid;
+}
+
+TypeId
+RitAggregationHeader::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+void
+RitAggregationHeader::Serialize(Buffer::Iterator start) const
+{
+    start.WriteU8(GetNSubFrames());
+    for (uint8_t length : m_lengths)
+    {
+        start.WriteU8(length);
+    }
+}
+
+uint32_t
+RitAggregationHeader::Deserialize(Buffer::Iterator start)
+{
+    Buffer::Iterator i = start;
+    const uint8_t n = i.ReadU8();
+    m_lengths.resize(n);
+    for (uint8_t k = 0; k < n; k++)
+    {
+        m_lengths[k] = i.ReadU8();
+    }
+    return i.GetDistanceFrom(start);
+}
+
+uint32_t
+RitAggregationHeader::GetSerializedSize() const
+{
+    return GetSizeFor(m_lengths.size());
+}
+
+void
+RitAggregationHeader::Print(std::ostream& os) const
+{
+    os << "RitAggregationHeader: N=" << static_cast<uint32_t>(GetNSubFrames()) << " [";
+    for (size_t k = 0; k < m_lengths.size(); k++)
+    {
+        os << (k ? " " : "") << static_cast<uint32_t>(m_lengths[k]);
+    }
+    os << "]";
+}
+
+} // namespace lrwpan
+} // namespace ns3
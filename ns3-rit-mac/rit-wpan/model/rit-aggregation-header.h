@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef NS3_LRWPAN_RIT_AGGREGATION_HEADER_H
+#define NS3_LRWPAN_RIT_AGGREGATION_HEADER_H
+
+#include "ns3/header.h"
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @ingroup lrwpan
+ *
+ * @brief Sub-frame length table of an aggregated NWK payload.
+ *
+ * When NWK aggregation is enabled, every MAC data frame carries this header
+ * followed by the concatenated NWK packets (each one with its own RitNwkHeader).
+ *
+ * Layout:
+ *  - 1 byte: number of sub-frames N
+ *  - N bytes: length of each sub-frame, in order
+ */
+class RitAggregationHeader : public Header
+{
+  public:
+    RitAggregationHeader() = default;
+    ~RitAggregationHeader() override = default;
+
+    /**
+     * @brief Append a sub-frame to the length table.
+     * @param length Sub-frame length in bytes (NWK header included)
+     */
+    void AddSubFrame(uint8_t length);
+
+    /**
+     * @brief Return the number of sub-frames.
+     */
+    uint8_t GetNSubFrames() const;
+
+    /**
+     * @brief Return the length of a sub-frame.
+     * @param index Sub-frame index
+     */
+    uint8_t GetSubFrameLength(uint8_t index) const;
+
+    /**
+     * @brief Serialized size of a header describing the given number of sub-frames.
+     * @param nSubFrames Number of sub-frames
+     */
+    static uint32_t GetSizeFor(uint32_t nSubFrames);
+
+    // ns-3 Header API
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override;
+    void Serialize(Buffer::Iterator start) const override;
+    uint32_t Deserialize(Buffer::Iterator start) override;
+    uint32_t GetSerializedSize() const override;
+    void Print(std::ostream& os) const override;
+
+  private:
+    std::vector<uint8_t> m_lengths; //!< Sub-frame lengths, in order
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // NS3_LRWPAN_RIT_AGGREGATION_HEADER_H
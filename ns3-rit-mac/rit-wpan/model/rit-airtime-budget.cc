@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-airtime-budget.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+RitAirtimeBudget::RitAirtimeBudget()
+{
+    Configure(Seconds(3600), 0.0, 60);
+}
+
+void
+RitAirtimeBudget::Configure(Time window, double limit, uint32_t nBuckets)
+{
+    nBuckets = std::max<uint32_t>(nBuckets, 1);
+    m_window = window;
+    m_limit = limit;
+    m_bucketWidth = std::max<int64_t>(window.GetNanoSeconds() / nBuckets, 1);
+    m_buckets.assign(nBuckets, 0);
+    m_newest = 0;
+    m_used = 0;
+}
+
+bool
+RitAirtimeBudget::IsEnabled() const
+{
+    return m_limit > 0.0;
+}
+
+void
+RitAirtimeBudget::Advance(Time now)
+{
+    const int64_t bucket = now.GetNanoSeconds() / m_bucketWidth;
+    if (bucket <= m_newest)
+    {
+        return;
+    }
+    const int64_t size = static_cast<int64_t>(m_buckets.size());
+    const int64_t steps = std::min(bucket - m_newest, size);
+    for (int64_t i = 1; i <= steps; i++)
+    {
+        int64_t& slot = m_buckets[(m_newest + i) % size];
+        m_used -= slot;
+        slot = 0;
+    }
+    m_newest = bucket;
+}
+
+void
+RitAirtimeBudget::Record(Time now, Time airtime)
+{
+    Advance(now);
+    m_buckets[m_newest % static_cast<int64_t>(m_buckets.size())] += airtime.GetNanoSeconds();
+    m_used += airtime.GetNanoSeconds();
+}
+
+Time
+RitAirtimeBudget::GetUsed(Time now)
+{
+    Advance(now);
+    return NanoSeconds(m_used);
+}
+
+Time
+RitAirtimeBudget::GetBudget() const
+{
+    return NanoSeconds(static_cast<int64_t>(std::llround(m_limit * m_window.GetNanoSeconds())));
+}
+
+Time
+RitAirtimeBudget::GetWaitTime(Time now, Time airtime)
+{
+    if (!IsEnabled())
+    {
+        return Time();
+    }
+    Advance(now);
+    const int64_t budget = GetBudget().GetNanoSeconds();
+    const int64_t needed = airtime.GetNanoSeconds();
+    if (m_used + needed <= budget)
+    {
+        return Time();
+    }
+    if (needed > budget)
+    {
+        return m_window;
+    }
+
+    // The oldest buckets leave the window first.
+    const int64_t size = static_cast<int64_t>(m_buckets.size());
+    int64_t freed = 0;
+    for (int64_t k = std::max<int64_t>(m_newest - size + 1, 0); k <= m_newest; k++)
+    {
+        freed += m_buckets[k % size];
+        if (m_used - freed + needed <= budget)
+        {
+            return NanoSeconds((k + size) * m_bucketWidth - now.GetNanoSeconds());
+        }
+    }
+    return m_window;
+}
+
+} // namespace lrwpan
+} // namespace ns3
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef RIT_AIRTIME_BUDGET_H
+#define RIT_AIRTIME_BUDGET_H
+
+#include "ns3/nstime.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @ingroup lr-wpan
+ *
+ * @brief Sliding-window accountant of the TX airtime of a node (duty-cycle limit).
+ *
+ * The window is split into equal buckets and a transmission is counted in the bucket
+ * of its end: the airtime used is the sum of the buckets of the last window, which
+ * leaves a bucket early by at most one bucket width. Memory is one counter per bucket,
+ * whatever the number of transmissions (an hour of beacons at a short BI included).
+ * The budget is the limit times the window, e.g. 360 s per hour for a 10% limit.
+ */
+class RitAirtimeBudget
+{
+  public:
+    RitAirtimeBudget();
+
+    /**
+     * @brief Set the window and the limit, and forget the airtime recorded.
+     * @param window Length of the sliding window
+     * @param limit Largest fraction of the window spent transmitting, 0 for no limit
+     * @param nBuckets Buckets of the window
+     */
+    void Configure(Time window, double limit, uint32_t nBuckets);
+
+    /**
+     * @brief Whether a limit is set.
+     * @return true if the transmissions are limited
+     */
+    bool IsEnabled() const;
+
+    /**
+     * @brief Count a transmission.
+     * @param now End of the transmission
+     * @param airtime Its airtime
+     */
+    void Record(Time now, Time airtime);
+
+    /**
+     * @brief Get the airtime spent in the window ending now.
+     * @param now The current time, not earlier than the last call
+     * @return the airtime used
+     */
+    Time GetUsed(Time now);
+
+    /**
+     * @brief Get the airtime the window allows.
+     * @return the limit times the window
+     */
+    Time GetBudget() const;
+
+    /**
+     * @brief Get the wait until a transmission fits in the budget.
+     * @param now The current time, not earlier than the last call
+     * @param airtime Airtime of the transmission
+     * @return zero if it fits now, the window if it never fits
+     */
+    Time GetWaitTime(Time now, Time airtime);
+
+  private:
+    /**
+     * @brief Clear the buckets that left the window.
+     * @param now The current time
+     */
+    void Advance(Time now);
+
+    Time m_window;                  //!< Length of the window
+    double m_limit;                 //!< Fraction of the window, 0 for no limit
+    int64_t m_bucketWidth;          //!< Width of a bucket [ns]
+    std::vector<int64_t> m_buckets; //!< Airtime per bucket [ns], by bucket number modulo size
+    int64_t m_newest;               //!< Number of the newest bucket of the window
+    int64_t m_used;                 //!< Sum of the buckets [ns]
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // RIT_AIRTIME_BUDGET_H
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-appointment-header.h"
+
+#include <algorithm>
+#include <limits>
+#include <ostream>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+namespace
+{
+
+/**
+ * @brief Microseconds of a time, clamped to the 32-bit field.
+ * @param t Time to convert
+ * @return the field value
+ */
+uint32_t
+ToField(Time t)
+{
+    return static_cast<uint32_t>(
+        std::clamp<int64_t>(t.GetMicroSeconds(), 0, std::numeric_limits<uint32_t>::max()));
+}
+
+} // namespace
+
+void
+RitAppointmentHeader::SetOffset(Time offset)
+{
+    m_offsetUs = ToField(offset);
+}
+
+Time
+RitAppointmentHeader::GetOffset() const
+{
+    return MicroSeconds(m_offsetUs);
+}
+
+void
+RitAppointmentHeader::SetPeriod(Time period)
+{
+    m_periodUs = ToField(period);
+}
+
+Time
+RitAppointmentHeader::GetPeriod() const
+{
+    return MicroSeconds(m_periodUs);
+}
+
+TypeId
+RitAppointmentHeader::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::lrwpan::RitAppointmentHeader")
+                            .SetParent<Header>()
+                            .SetGroupName("LrWpan")
+                            .AddConstructor<RitAppointmentHeader>();
+    return tid;
+}
+
+TypeId
+RitAppointmentHeader::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+void
+RitAppointmentHeader::Serialize(Buffer::Iterator start) const
+{
+    start.WriteHtolsbU32(m_offsetUs);
+    start.WriteHtolsbU32(m_periodUs);
+}
+
+uint32_t
+RitAppointmentHeader::Deserialize(Buffer::Iterator start)
+{
+    Buffer::Iterator i = start;
+    m_offsetUs = i.ReadLsbtohU32();
+    m_periodUs = i.ReadLsbtohU32();
+    return i.GetDistanceFrom(start);
+}
+
+uint32_t
+RitAppointmentHeader::GetSerializedSize() const
+{
+    return 8;
+}
+
+void
+RitAppointmentHeader::Print(std::ostream& os) const
+{
+    os << "RitAppointmentHeader: Offset=" << m_offsetUs << "us Period=" << m_periodUs << "us";
+}
+
+} // namespace lrwpan
+} // namespace ns3
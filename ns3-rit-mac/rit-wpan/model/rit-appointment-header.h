@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef NS3_LRWPAN_RIT_APPOINTMENT_HEADER_H
+#define NS3_LRWPAN_RIT_APPOINTMENT_HEADER_H
+
+#include "ns3/header.h"
+#include "ns3/nstime.h"
+
+#include <cstdint>
+#include <ostream>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @ingroup lrwpan
+ *
+ * @brief Beacon appointment granted by a receiver in the payload of the ACK of a data
+ *        frame (ackAppointmentsEnabled).
+ *
+ * The receiver names its next periodic beacon, so that a periodic sender can sleep until
+ * just before it instead of listening for up to TWD. The offset is counted from the end
+ * of the ACK, the time the sender receives it.
+ *
+ * Layout:
+ *  - 4 bytes: delay from the end of the ACK to the next beacon (microseconds)
+ *  - 4 bytes: beacon period of the receiver (microseconds)
+ */
+class RitAppointmentHeader : public Header
+{
+  public:
+    RitAppointmentHeader() = default;
+    ~RitAppointmentHeader() override = default;
+
+    /**
+     * @brief Set the delay from the end of the ACK to the next beacon.
+     * @param offset Delay, rounded down to the microsecond
+     */
+    void SetOffset(Time offset);
+
+    /**
+     * @brief Return the delay from the end of the ACK to the next beacon.
+     */
+    Time GetOffset() const;
+
+    /**
+     * @brief Set the beacon period of the receiver.
+     * @param period Period, rounded down to the microsecond
+     */
+    void SetPeriod(Time period);
+
+    /**
+     * @brief Return the beacon period of the receiver.
+     */
+    Time GetPeriod() const;
+
+    // ns-3 Header API
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override;
+    void Serialize(Buffer::Iterator start) const override;
+    uint32_t Deserialize(Buffer::Iterator start) override;
+    uint32_t GetSerializedSize() const override;
+    void Print(std::ostream& os) const override;
+
+  private:
+    uint32_t m_offsetUs{0}; //!< Delay to the next beacon (us)
+    uint32_t m_periodUs{0}; //!< Beacon period (us)
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // NS3_LRWPAN_RIT_APPOINTMENT_HEADER_H
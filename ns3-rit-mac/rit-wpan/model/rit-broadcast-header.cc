@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-broadcast-header.h"
+
+#include "ns3/address-utils.h"
+
+#include <ostream>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+void
+RitBroadcastHeader::SetOrigin(Mac16Address origin)
+{
+    m_origin = origin;
+}
+
+Mac16Address
+RitBroadcastHeader::GetOrigin() const
+{
+    return m_origin;
+}
+
+void
+RitBroadcastHeader::SetSequence(uint16_t seq)
+{
+    m_seq = seq;
+}
+
+uint16_t
+RitBroadcastHeader::GetSequence() const
+{
+    return m_seq;
+}
+
+void
+RitBroadcastHeader::SetHops(uint8_t hops)
+{
+    m_hops = hops;
+}
+
+uint8_t
+RitBroadcastHeader::GetHops() const
+{
+    return m_hops;
+}
+
+TypeId
+RitBroadcastHeader::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::lrwpan::RitBroadcastHeader")
+                            .SetParent<Header>()
+                            .SetGroupName("LrWpan")
+                            .AddConstructor<RitBroadcastHeader>();
+    return tid;
+}
+
+TypeId
+RitBroadcastHeader::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+void
+RitBroadcastHeader::Serialize(Buffer::Iterator start) const
+{
+    WriteTo(start, m_origin);
+    start.WriteU16(m_seq);
+    start.WriteU8(m_hops);
+}
+
+uint32_t
+RitBroadcastHeader::Deserialize(Buffer::Iterator start)
+{
+    Buffer::Iterator i = start;
+    ReadFrom(i, m_origin);
+    m_seq = i.ReadU16();
+    m_hops = i.ReadU8();
+    return i.GetDistanceFrom(start);
+}
+
+uint32_t
+RitBroadcastHeader::GetSerializedSize() const
+{
+    return 5;
+}
+
+void
+RitBroadcastHeader::Print(std::ostream& os) const
+{
+    os << "RitBroadcastHeader: Origin=" << m_origin << " Seq=" << m_seq
+       << " Hops=" << static_cast<uint32_t>(m_hops);
+}
+
+} // namespace lrwpan
+} // namespace ns3
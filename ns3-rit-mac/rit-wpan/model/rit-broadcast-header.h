@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef NS3_LRWPAN_RIT_BROADCAST_HEADER_H
+#define NS3_LRWPAN_RIT_BROADCAST_HEADER_H
+
+#include "ns3/header.h"
+#include "ns3/mac16-address.h"
+
+#include <cstdint>
+#include <ostream>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @ingroup lrwpan
+ *
+ * @brief Origin and sequence number following a RitNwkHeader addressed to the
+ *        broadcast address.
+ *
+ * The pair identifies a network-wide broadcast for the duplicate cache of the
+ * relays, which also increment the hop count. With the DuplicateDetection attribute
+ * of RitSimpleRouting, it also identifies the unicast packets, following their
+ * RitRouteHeader if any.
+ *
+ * Layout:
+ *  - 2 bytes: short address of the origin
+ *  - 2 bytes: sequence number of the origin
+ *  - 1 byte: hops from the origin
+ */
+class RitBroadcastHeader : public Header
+{
+  public:
+    RitBroadcastHeader() = default;
+    ~RitBroadcastHeader() override = default;
+
+    /**
+     * @brief Set the origin of the broadcast.
+     * @param origin Short address
+     */
+    void SetOrigin(Mac16Address origin);
+
+    /**
+     * @brief Return the origin of the broadcast.
+     */
+    Mac16Address GetOrigin() const;
+
+    /**
+     * @brief Set the sequence number of the broadcast at its origin.
+     * @param seq Sequence number
+     */
+    void SetSequence(uint16_t seq);
+
+    /**
+     * @brief Return the sequence number of the broadcast at its origin.
+     */
+    uint16_t GetSequence() const;
+
+    /**
+     * @brief Set the number of hops from the origin.
+     * @param hops Hops, 0 at the origin
+     */
+    void SetHops(uint8_t hops);
+
+    /**
+     * @brief Return the number of hops from the origin.
+     */
+    uint8_t GetHops() const;
+
+    // ns-3 Header API
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override;
+    void Serialize(Buffer::Iterator start) const override;
+    uint32_t Deserialize(Buffer::Iterator start) override;
+    uint32_t GetSerializedSize() const override;
+    void Print(std::ostream& os) const override;
+
+  private:
+    Mac16Address m_origin; //!< Node that started the broadcast
+    uint16_t m_seq{0};     //!< Sequence number at the origin
+    uint8_t m_hops{0};     //!< Hops from the origin
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // NS3_LRWPAN_RIT_BROADCAST_HEADER_H
@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-calendar-scheduler.h"
+
+#include "ns3/assert.h"
+#include "ns3/event-impl.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_LOG_COMPONENT_DEFINE("RitCalendarScheduler");
+NS_OBJECT_ENSURE_REGISTERED(RitCalendarScheduler);
+
+namespace
+{
+
+constexpr uint32_t MIN_BUCKETS = 2;    //!< Smallest ring
+constexpr uint32_t WIDTH_SAMPLES = 25; //!< Earliest events sampled for the width
+
+/**
+ * Order of the events in a bucket: decreasing, the earliest at the back.
+ */
+bool
+Later(const Scheduler::Event& a, const Scheduler::Event& b)
+{
+    return b < a;
+}
+
+} // namespace
+
+double RitCalendarScheduler::s_beaconRate = 0;
+
+TypeId
+RitCalendarScheduler::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::lrwpan::RitCalendarScheduler")
+            .SetParent<Scheduler>()
+            .SetGroupName("LrWpan")
+            .AddConstructor<RitCalendarScheduler>()
+            .AddAttribute("BucketWidth",
+                          "Width of a bucket (0: from the beacon rate of the RIT devices, "
+                          "or from the queued events)",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&RitCalendarScheduler::m_fixedWidth),
+                          MakeTimeChecker());
+    return tid;
+}
+
+RitCalendarScheduler::RitCalendarScheduler()
+    : m_buckets(MIN_BUCKETS),
+      m_mask(MIN_BUCKETS - 1),
+      m_width(1),
+      m_size(0),
+      m_fixedWidth(),
+      m_lastSlot(0),
+      m_nextValid(false),
+      m_nextBucket(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+RitCalendarScheduler::~RitCalendarScheduler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+RitCalendarScheduler::AddPeriodicSource(Time period)
+{
+    if (period.IsStrictlyPositive())
+    {
+        s_beaconRate += 1.0 / period.GetSeconds();
+    }
+}
+
+void
+RitCalendarScheduler::ResetPeriodicSources()
+{
+    s_beaconRate = 0;
+}
+
+uint32_t
+RitCalendarScheduler::GetNBuckets() const
+{
+    return m_mask + 1;
+}
+
+Time
+RitCalendarScheduler::GetBucketWidth() const
+{
+    return TimeStep(m_width);
+}
+
+void
+RitCalendarScheduler::Insert(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    DoInsert(ev);
+    m_size++;
+    if (m_size > 2 * GetNBuckets())
+    {
+        Resize(2 * GetNBuckets());
+    }
+}
+
+void
+RitCalendarScheduler::DoInsert(const Event& ev)
+{
+    const uint64_t slot = SlotOf(ev.key.m_ts);
+    Bucket& bucket = m_buckets[slot & m_mask];
+    bucket.insert(std::lower_bound(bucket.begin(), bucket.end(), ev, Later), ev);
+
+    if (slot < m_lastSlot)
+    {
+        m_lastSlot = slot;
+    }
+    if (m_nextValid && ev < m_buckets[m_nextBucket].back())
+    {
+        m_nextValid = false;
+    }
+}
+
+bool
+RitCalendarScheduler::IsEmpty() const
+{
+    return m_size == 0;
+}
+
+uint32_t
+RitCalendarScheduler::FindNext() const
+{
+    NS_ASSERT(m_size > 0);
+    if (m_nextValid)
+    {
+        return m_nextBucket;
+    }
+
+    // Walk one round from the current slot: the first bucket whose earliest event
+    // falls in the slot walked holds the earliest event of the queue.
+    for (uint64_t slot = m_lastSlot; slot <= m_lastSlot + m_mask; slot++)
+    {
+        const uint32_t b = slot & m_mask;
+        if (!m_buckets[b].empty() && SlotOf(m_buckets[b].back().key.m_ts) == slot)
+        {
+            m_lastSlot = slot;
+            m_nextBucket = b;
+            m_nextValid = true;
+            return b;
+        }
+    }
+
+    // Nothing within a round: direct search of the earliest bucket head
+    uint32_t best = 0;
+    bool found = false;
+    for (uint32_t b = 0; b <= m_mask; b++)
+    {
+        if (!m_buckets[b].empty() && (!found || m_buckets[b].back() < m_buckets[best].back()))
+        {
+            best = b;
+            found = true;
+        }
+    }
+    NS_ASSERT(found);
+    m_lastSlot = SlotOf(m_buckets[best].back().key.m_ts);
+    m_nextBucket = best;
+    m_nextValid = true;
+    return best;
+}
+
+Scheduler::Event
+RitCalendarScheduler::PeekNext() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_buckets[FindNext()].back();
+}
+
+Scheduler::Event
+RitCalendarScheduler::RemoveNext()
+{
+    NS_LOG_FUNCTION(this);
+    Bucket& bucket = m_buckets[FindNext()];
+    const Event ev = bucket.back();
+    bucket.pop_back();
+    m_size--;
+    m_nextValid = false;
+    if (m_size < GetNBuckets() / 2 && GetNBuckets() > MIN_BUCKETS)
+    {
+        Resize(GetNBuckets() / 2);
+    }
+    return ev;
+}
+
+void
+RitCalendarScheduler::Remove(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    Bucket& bucket = m_buckets[SlotOf(ev.key.m_ts) & m_mask];
+    auto it = std::lower_bound(bucket.begin(), bucket.end(), ev, Later);
+    NS_ASSERT_MSG(it != bucket.end() && it->key.m_uid == ev.key.m_uid, "Event not queued");
+    bucket.erase(it);
+    m_size--;
+    m_nextValid = false;
+    if (m_size < GetNBuckets() / 2 && GetNBuckets() > MIN_BUCKETS)
+    {
+        Resize(GetNBuckets() / 2);
+    }
+}
+
+uint64_t
+RitCalendarScheduler::ChooseWidth() const
+{
+    if (m_fixedWidth.IsStrictlyPositive())
+    {
+        return std::max<int64_t>(m_fixedWidth.GetTimeStep(), 1);
+    }
+    if (s_beaconRate > 0)
+    {
+        return std::max<int64_t>(Seconds(3.0 / s_beaconRate).GetTimeStep(), 1);
+    }
+
+    // Three times the mean spacing of the earliest queued events, so that the far
+    // timers (applications, end of the run) do not widen the buckets.
+    std::vector<uint64_t> ts;
+    ts.reserve(m_size);
+    for (const auto& bucket : m_buckets)
+    {
+        for (const auto& ev : bucket)
+        {
+            ts.push_back(ev.key.m_ts);
+        }
+    }
+    const size_t k = std::min<size_t>(ts.size(), WIDTH_SAMPLES);
+    if (k < 2)
+    {
+        return m_width;
+    }
+    std::nth_element(ts.begin(), ts.begin() + (k - 1), ts.end());
+    const uint64_t first = *std::min_element(ts.begin(), ts.begin() + k);
+    const uint64_t spread = ts[k - 1] - first;
+    return spread == 0 ? m_width : std::max<uint64_t>(3 * spread / (k - 1), 1);
+}
+
+void
+RitCalendarScheduler::Resize(uint32_t nBuckets)
+{
+    NS_LOG_FUNCTION(this << nBuckets);
+    const uint64_t width = ChooseWidth();
+    std::vector<Bucket> old(nBuckets);
+    old.swap(m_buckets);
+    m_mask = nBuckets - 1;
+    m_width = width;
+    m_lastSlot = std::numeric_limits<uint64_t>::max();
+    m_nextValid = false;
+    for (const auto& bucket : old)
+    {
+        for (const auto& ev : bucket)
+        {
+            DoInsert(ev);
+        }
+    }
+    if (m_size == 0)
+    {
+        m_lastSlot = 0;
+    }
+    NS_LOG_DEBUG("Resized to " << nBuckets << " buckets of " << m_width << " steps");
+}
+
+} // namespace lrwpan
+} // namespace ns3
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef RIT_CALENDAR_SCHEDULER_H
+#define RIT_CALENDAR_SCHEDULER_H
+
+#include "ns3/nstime.h"
+#include "ns3/scheduler.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @ingroup lr-wpan
+ *
+ * @brief A calendar queue scheduler tuned for the periodic events of RIT networks.
+ *
+ * The events are hashed by timestamp into a ring of buckets of a fixed width,
+ * each bucket sorted, so that inserting and removing an event costs O(1) when
+ * the buckets hold a few events each (instead of the O(log n) of the map and
+ * heap schedulers). The next event is found by walking the buckets from the
+ * current one; a walk of a whole round without a hit falls back to a direct
+ * search, so far-away events (e.g. application timers) stay correct.
+ *
+ * The number of buckets follows the number of events (doubled above two events
+ * per bucket, halved below one half). The bucket width is, in this order:
+ *  - the BucketWidth attribute, if positive;
+ *  - three times the mean beacon spacing of the network, 1 / (sum of the
+ *    rates 1 / macRitPeriod of the RIT devices), registered by RitWpanNetHelper
+ *    through AddPeriodicSource();
+ *  - three times the mean spacing of the queued events, sampled at each resize.
+ *
+ * Select it with --SchedulerType=ns3::lrwpan::RitCalendarScheduler, or with
+ * Simulator::SetScheduler().
+ */
+class RitCalendarScheduler : public Scheduler
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    RitCalendarScheduler();
+    ~RitCalendarScheduler() override;
+
+    void Insert(const Event& ev) override;
+    bool IsEmpty() const override;
+    Event PeekNext() const override;
+    Event RemoveNext() override;
+    void Remove(const Event& ev) override;
+
+    /**
+     * @brief Register a device beaconing every period, for the bucket width of
+     * the schedulers resized from now on.
+     * @param period The beacon interval (ignored unless positive)
+     */
+    static void AddPeriodicSource(Time period);
+
+    /**
+     * @brief Forget the registered beacon rates.
+     */
+    static void ResetPeriodicSources();
+
+    /**
+     * @return the current number of buckets
+     */
+    uint32_t GetNBuckets() const;
+
+    /**
+     * @return the current bucket width
+     */
+    Time GetBucketWidth() const;
+
+  private:
+    /**
+     * Events of one bucket, in decreasing order: the earliest is the last one.
+     */
+    using Bucket = std::vector<Event>;
+
+    /**
+     * @brief Absolute slot of a timestamp.
+     * @param ts Timestamp (time steps)
+     * @return the slot
+     */
+    uint64_t SlotOf(uint64_t ts) const
+    {
+        return ts / m_width;
+    }
+
+    /**
+     * @brief Insert an event in its bucket.
+     * @param ev The event
+     */
+    void DoInsert(const Event& ev);
+
+    /**
+     * @brief Locate the earliest event and cache it.
+     * @return the bucket of the earliest event
+     */
+    uint32_t FindNext() const;
+
+    /**
+     * @brief Width for the current events and beacon rate.
+     * @return the width (time steps, at least 1)
+     */
+    uint64_t ChooseWidth() const;
+
+    /**
+     * @brief Redistribute the events over a new number of buckets and width.
+     * @param nBuckets The number of buckets (power of 2)
+     */
+    void Resize(uint32_t nBuckets);
+
+    std::vector<Bucket> m_buckets; //!< The ring of buckets
+    uint32_t m_mask;               //!< Number of buckets - 1
+    uint64_t m_width;              //!< Bucket width (time steps)
+    uint32_t m_size;               //!< Events queued
+    Time m_fixedWidth;             //!< BucketWidth attribute, zero for the automatic width
+    mutable uint64_t m_lastSlot;   //!< No event is queued before this slot
+    mutable bool m_nextValid;      //!< Whether m_nextBucket holds the earliest event
+    mutable uint32_t m_nextBucket; //!< Bucket of the earliest event, if m_nextValid
+
+    static double s_beaconRate; //!< Sum of the registered beacon rates [1/s]
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // RIT_CALENDAR_SCHEDULER_H
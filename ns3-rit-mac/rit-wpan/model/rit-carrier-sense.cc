@@ -0,0 +1,494 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-carrier-sense.h"
+
+#include "ns3/log.h"
+#include "ns3/lr-wpan-event-profiler.h"
+#include "ns3/lr-wpan-phy.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_LOG_COMPONENT_DEFINE("RitCarrierSense");
+NS_OBJECT_ENSURE_REGISTERED(RitCarrierSense);
+NS_OBJECT_ENSURE_REGISTERED(RitCsmaCaCarrierSense);
+NS_OBJECT_ENSURE_REGISTERED(RitCarrierSensePipeline);
+
+namespace
+{
+
+// Handler reported to LrWpanEventProfiler
+const uint32_t PROFILE_CCA_CONFIRM =
+    LrWpanEventProfiler::RegisterHandler("RitCarrierSensePipeline::PlmeCcaConfirm");
+
+// Duration of a CCA [symbols]
+constexpr double CCA_SYMBOLS = 8.0;
+
+} // namespace
+
+double
+RitCarrierSenseStats::GetBusyRatio() const
+{
+    return nCca > 0 ? static_cast<double>(nBusy) / nCca : 0.0;
+}
+
+TypeId
+RitCarrierSense::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::RitCarrierSense")
+            .SetParent<Object>()
+            .SetGroupName("RitWpan")
+            .AddTraceSource("Access",
+                            "A channel access ended: its result and its delay",
+                            MakeTraceSourceAccessor(&RitCarrierSense::m_accessTrace),
+                            "ns3::lrwpan::RitCarrierSense::AccessTracedCallback");
+    return tid;
+}
+
+RitCarrierSense::RitCarrierSense()
+    : m_running(false),
+      m_ccaRequestRunning(false)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+RitCarrierSense::~RitCarrierSense()
+{
+    NS_LOG_FUNCTION(this);
+    m_mac = nullptr;
+}
+
+void
+RitCarrierSense::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_lrWpanMacStateCallback = MakeNullCallback<void, MacState>();
+    if (m_mac)
+    {
+        Cancel();
+    }
+    m_mac = nullptr;
+    Object::DoDispose();
+}
+
+void
+RitCarrierSense::SetMac(Ptr<RitWpanMac> mac)
+{
+    NS_LOG_FUNCTION(this << mac);
+    m_mac = mac;
+}
+
+Ptr<RitWpanMac>
+RitCarrierSense::GetMac() const
+{
+    return m_mac;
+}
+
+void
+RitCarrierSense::SetLrWpanMacStateCallback(LrWpanMacStateCallback macState)
+{
+    NS_LOG_FUNCTION(this);
+    m_lrWpanMacStateCallback = macState;
+}
+
+void
+RitCarrierSense::Start()
+{
+    NS_LOG_FUNCTION(this);
+    // An access abandoned without Cancel() (e.g. the MAC cancelled the PHY) is replaced.
+    m_running = true;
+    m_accessStart = Simulator::Now();
+    m_stats.nAccesses++;
+    DoStart();
+}
+
+void
+RitCarrierSense::Cancel()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_ccaRequestRunning)
+    {
+        NS_LOG_DEBUG("Canceling ongoing CCA request");
+        m_mac->GetPhy()->CcaCancel();
+        m_ccaRequestRunning = false;
+    }
+    m_running = false;
+}
+
+bool
+RitCarrierSense::IsRunning() const
+{
+    return m_running;
+}
+
+bool
+RitCarrierSense::PlmeCcaConfirm(PhyEnumeration status)
+{
+    NS_LOG_FUNCTION(this << status);
+
+    // Only the CCA requested by this stage is ours; the PHY may still confirm a CCA of an
+    // access that was canceled, it is then left to the other stages.
+    if (!m_ccaRequestRunning)
+    {
+        return false;
+    }
+    m_ccaRequestRunning = false;
+    CountCca(status, Simulator::Now() - m_ccaStart);
+    DoCcaConfirm(status);
+    return true;
+}
+
+void
+RitCarrierSense::NotifyChannelAssessed(PhyEnumeration status)
+{
+}
+
+const RitCarrierSenseStats&
+RitCarrierSense::GetStats() const
+{
+    return m_stats;
+}
+
+void
+RitCarrierSense::ResetStats()
+{
+    m_stats = RitCarrierSenseStats();
+}
+
+void
+RitCarrierSense::DoCcaConfirm(PhyEnumeration status)
+{
+    NS_LOG_FUNCTION(this << status);
+    Finish(status == IEEE_802_15_4_PHY_IDLE ? CHANNEL_IDLE : CHANNEL_ACCESS_FAILURE);
+}
+
+void
+RitCarrierSense::RequestCca()
+{
+    NS_LOG_FUNCTION(this);
+    NS_LOG_DEBUG("Requesting CCA from PHY");
+
+    m_ccaRequestRunning = true;
+    m_ccaStart = Simulator::Now();
+    m_mac->GetPhy()->PlmeCcaRequest();
+}
+
+void
+RitCarrierSense::CountCca(PhyEnumeration status, Time duration)
+{
+    m_stats.nCca++;
+    if (status != IEEE_802_15_4_PHY_IDLE)
+    {
+        m_stats.nBusy++;
+    }
+    m_stats.rxOnTime += duration;
+}
+
+void
+RitCarrierSense::Finish(MacState result)
+{
+    NS_LOG_FUNCTION(this << result);
+    if (!m_running)
+    {
+        return;
+    }
+    m_running = false;
+
+    const Time delay = Simulator::Now() - m_accessStart;
+    m_stats.addedDelay += delay;
+    if (result == CHANNEL_ACCESS_FAILURE)
+    {
+        m_stats.nFailures++;
+    }
+    m_accessTrace(result, delay);
+
+    NS_LOG_DEBUG("Channel access " << (result == CHANNEL_IDLE ? "IDLE" : "FAILURE") << " after "
+                                   << delay.As(Time::US));
+    if (!m_lrWpanMacStateCallback.IsNull())
+    {
+        m_lrWpanMacStateCallback(result);
+    }
+}
+
+TypeId
+RitCsmaCaCarrierSense::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::RitCsmaCaCarrierSense")
+                            .SetParent<RitCarrierSense>()
+                            .SetGroupName("RitWpan")
+                            .AddConstructor<RitCsmaCaCarrierSense>();
+    return tid;
+}
+
+RitCsmaCaCarrierSense::RitCsmaCaCarrierSense()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+RitCsmaCaCarrierSense::~RitCsmaCaCarrierSense()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+RitCsmaCaCarrierSense::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_csmaCa = nullptr;
+    RitCarrierSense::DoDispose();
+}
+
+void
+RitCsmaCaCarrierSense::SetCsmaCa(Ptr<LrWpanCsmaCa> csmaCa)
+{
+    NS_LOG_FUNCTION(this << csmaCa);
+    m_csmaCa = csmaCa;
+    m_csmaCa->SetLrWpanMacStateCallback(MakeCallback(&RitCsmaCaCarrierSense::CsmaCaState, this));
+}
+
+Ptr<LrWpanCsmaCa>
+RitCsmaCaCarrierSense::GetCsmaCa() const
+{
+    return m_csmaCa;
+}
+
+void
+RitCsmaCaCarrierSense::DoStart()
+{
+    NS_LOG_FUNCTION(this);
+    m_csmaCa->Start();
+}
+
+void
+RitCsmaCaCarrierSense::Cancel()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_csmaCa)
+    {
+        m_csmaCa->Cancel();
+    }
+    RitCarrierSense::Cancel();
+}
+
+bool
+RitCsmaCaCarrierSense::PlmeCcaConfirm(PhyEnumeration status)
+{
+    NS_LOG_FUNCTION(this << status);
+
+    // LrWpanCsmaCa requests its CCAs itself, at the end of each backoff period.
+    if (!IsRunning())
+    {
+        return false;
+    }
+    CountCca(status, Seconds(CCA_SYMBOLS / m_mac->GetPhy()->GetDataOrSymbolRate(false)));
+    m_csmaCa->PlmeCcaConfirm(status);
+    return true;
+}
+
+void
+RitCsmaCaCarrierSense::CsmaCaState(MacState state)
+{
+    NS_LOG_FUNCTION(this << state);
+    if (IsRunning() && (state == CHANNEL_IDLE || state == CHANNEL_ACCESS_FAILURE))
+    {
+        Finish(state);
+    }
+    else if (!m_lrWpanMacStateCallback.IsNull())
+    {
+        // A deferred slotted access, or the CSMA/CA of the plain LrWpanMac.
+        m_lrWpanMacStateCallback(state);
+    }
+}
+
+TypeId
+RitCarrierSensePipeline::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::RitCarrierSensePipeline")
+                            .SetParent<Object>()
+                            .SetGroupName("RitWpan")
+                            .AddConstructor<RitCarrierSensePipeline>();
+    return tid;
+}
+
+RitCarrierSensePipeline::RitCarrierSensePipeline()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+RitCarrierSensePipeline::~RitCarrierSensePipeline()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+RitCarrierSensePipeline::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_mac = nullptr;
+    m_stages.clear();
+    m_selected[RIT_CS_BEACON_FRAME] = nullptr;
+    m_selected[RIT_CS_DATA_FRAME] = nullptr;
+    m_fallbackCcaConfirmCallback = MakeNullCallback<void, PhyEnumeration>();
+    Object::DoDispose();
+}
+
+void
+RitCarrierSensePipeline::SetMac(Ptr<RitWpanMac> mac)
+{
+    NS_LOG_FUNCTION(this << mac);
+    m_mac = mac;
+    for (const auto& entry : m_stages)
+    {
+        Attach(entry.second);
+    }
+}
+
+void
+RitCarrierSensePipeline::Attach(Ptr<RitCarrierSense> stage) const
+{
+    if (m_mac)
+    {
+        stage->SetMac(m_mac);
+        stage->SetLrWpanMacStateCallback(MakeCallback(&RitWpanMac::SetLrWpanMacState, m_mac));
+    }
+}
+
+void
+RitCarrierSensePipeline::AddStage(const std::string& name, Ptr<RitCarrierSense> stage)
+{
+    NS_LOG_FUNCTION(this << name << stage);
+    NS_ASSERT(stage);
+    Attach(stage);
+    for (auto& entry : m_stages)
+    {
+        if (entry.first == name)
+        {
+            entry.second = stage;
+            return;
+        }
+    }
+    m_stages.emplace_back(name, stage);
+}
+
+Ptr<RitCarrierSense>
+RitCarrierSensePipeline::GetStage(const std::string& name) const
+{
+    for (const auto& entry : m_stages)
+    {
+        if (entry.first == name)
+        {
+            return entry.second;
+        }
+    }
+    return nullptr;
+}
+
+std::vector<std::string>
+RitCarrierSensePipeline::GetStageNames() const
+{
+    std::vector<std::string> names;
+    names.reserve(m_stages.size());
+    for (const auto& entry : m_stages)
+    {
+        names.push_back(entry.first);
+    }
+    return names;
+}
+
+void
+RitCarrierSensePipeline::Select(RitCarrierSenseFrame frame, Ptr<RitCarrierSense> stage)
+{
+    NS_LOG_FUNCTION(this << frame << stage);
+    NS_ASSERT_MSG(!stage || std::any_of(m_stages.begin(),
+                                        m_stages.end(),
+                                        [&stage](const auto& entry) {
+                                            return entry.second == stage;
+                                        }),
+                  "Carrier-sense stage selected before AddStage()");
+    m_selected[frame] = stage;
+}
+
+Ptr<RitCarrierSense>
+RitCarrierSensePipeline::GetSelected(RitCarrierSenseFrame frame) const
+{
+    return m_selected[frame];
+}
+
+bool
+RitCarrierSensePipeline::IsEnabled(RitCarrierSenseFrame frame) const
+{
+    return m_selected[frame] != nullptr;
+}
+
+void
+RitCarrierSensePipeline::Start(RitCarrierSenseFrame frame)
+{
+    NS_LOG_FUNCTION(this << frame);
+    NS_ASSERT_MSG(m_selected[frame], "No carrier-sense stage for the frame");
+    m_selected[frame]->Start();
+}
+
+void
+RitCarrierSensePipeline::Cancel()
+{
+    NS_LOG_FUNCTION(this);
+    for (const auto& entry : m_stages)
+    {
+        entry.second->Cancel();
+    }
+}
+
+void
+RitCarrierSensePipeline::SetFallbackCcaConfirmCallback(
+    FallbackCcaConfirmCallback fallbackCcaConfirmCallback)
+{
+    NS_LOG_FUNCTION(this);
+    m_fallbackCcaConfirmCallback = fallbackCcaConfirmCallback;
+}
+
+void
+RitCarrierSensePipeline::PlmeCcaConfirm(PhyEnumeration status)
+{
+    NS_LOG_FUNCTION(this << status);
+    LrWpanEventProfiler::Scope profile(PROFILE_CCA_CONFIRM);
+
+    // The stages see the result before the owner acts on it, which may start the next
+    // access of another stage.
+    for (const auto& entry : m_stages)
+    {
+        entry.second->NotifyChannelAssessed(status);
+    }
+
+    for (const auto& entry : m_stages)
+    {
+        if (entry.second->PlmeCcaConfirm(status))
+        {
+            return;
+        }
+    }
+
+    NS_LOG_DEBUG("CCA confirm of no stage, to the fallback CCA confirm callback.");
+    if (!m_fallbackCcaConfirmCallback.IsNull())
+    {
+        m_fallbackCcaConfirmCallback(status);
+    }
+    else
+    {
+        NS_LOG_WARN("FallbackCcaConfirmCallback is not set — ignoring CCA confirm.");
+    }
+}
+
+} // namespace lrwpan
+} // namespace ns3
@@ -0,0 +1,378 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef RIT_CARRIER_SENSE_H
+#define RIT_CARRIER_SENSE_H
+
+#include "rit-wpan-mac.h"
+
+#include "ns3/lr-wpan-csmaca.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include "ns3/traced-callback.h"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @ingroup lr-wpan
+ *
+ * This method implements the PD SAP: PlmeCcaConfirm
+ *
+ * @param status the status of CCA
+ */
+typedef Callback<void, PhyEnumeration> FallbackCcaConfirmCallback;
+
+/**
+ * @ingroup lr-wpan
+ *
+ * @brief Counters of a carrier-sense stage.
+ */
+struct RitCarrierSenseStats
+{
+    uint32_t nAccesses{0}; //!< Channel accesses started
+    uint32_t nCca{0};      //!< CCAs requested from the PHY
+    uint32_t nBusy{0};     //!< CCAs not assessed idle
+    uint32_t nFailures{0}; //!< Accesses that ended in a channel access failure
+    Time addedDelay;       //!< Sum of the delays from the start of an access to its result
+    Time rxOnTime;         //!< Sum of the CCA durations, the receiver sensing the channel
+
+    /**
+     * @brief Get the share of the CCAs that found the channel busy.
+     * @return nBusy / nCca, 0 without CCA
+     */
+    double GetBusyRatio() const;
+};
+
+/**
+ * @ingroup lr-wpan
+ *
+ * @brief Carrier-sense strategy run by RitWpanMac before a beacon or a data frame.
+ *
+ * The MAC turns its receiver on and calls Start(); the stage reports CHANNEL_IDLE or
+ * CHANNEL_ACCESS_FAILURE through the MAC state callback. A stage owns the PLME-CCA.confirm
+ * of the CCAs it requested (RequestCca()) and sees the result of every other CCA of the
+ * PHY through NotifyChannelAssessed(), so strategies can use recent assessments. The base
+ * class keeps the counters of the stage.
+ */
+class RitCarrierSense : public Object
+{
+  public:
+    /**
+     * Get the type ID.
+     *
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    RitCarrierSense();
+    ~RitCarrierSense() override;
+
+    /**
+     * TracedCallback signature for the result of a channel access.
+     *
+     * @param [in] result CHANNEL_IDLE or CHANNEL_ACCESS_FAILURE
+     * @param [in] delay Time from the start of the access
+     */
+    typedef void (*AccessTracedCallback)(MacState result, Time delay);
+
+    /**
+     * Set the MAC to which this stage is attached to.
+     *
+     * @param mac the used MAC
+     */
+    void SetMac(Ptr<RitWpanMac> mac);
+
+    /**
+     * Get the MAC to which this stage is attached to.
+     *
+     * @return the used MAC
+     */
+    Ptr<RitWpanMac> GetMac() const;
+
+    /**
+     * Set the callback that reports the result of an access to the MAC.
+     *
+     * @param macState the mac state callback
+     */
+    void SetLrWpanMacStateCallback(LrWpanMacStateCallback macState);
+
+    /**
+     * @brief Start a channel access.
+     */
+    void Start();
+
+    /**
+     * @brief Cancel the access in progress, and the CCA it requested.
+     */
+    virtual void Cancel();
+
+    /**
+     * @brief Whether an access is in progress.
+     * @return true between Start() and the result or Cancel()
+     */
+    bool IsRunning() const;
+
+    /**
+     * IEEE 802.15.4-2006 section 6.2.2.2
+     * PLME-CCA.confirm status
+     * @param status TRX_OFF, BUSY or IDLE
+     * @return true if the CCA was requested by this stage, which consumed the result
+     */
+    virtual bool PlmeCcaConfirm(PhyEnumeration status);
+
+    /**
+     * @brief Tell the stage the result of a CCA of the PHY, whichever stage requested it.
+     * @param status TRX_OFF, BUSY or IDLE
+     */
+    virtual void NotifyChannelAssessed(PhyEnumeration status);
+
+    /**
+     * @brief Get the counters of the stage.
+     * @return the counters
+     */
+    const RitCarrierSenseStats& GetStats() const;
+
+    /**
+     * @brief Reset the counters of the stage.
+     */
+    void ResetStats();
+
+  protected:
+    void DoDispose() override;
+
+    /**
+     * @brief Run the strategy of the stage; Start() already counted the access.
+     */
+    virtual void DoStart() = 0;
+
+    /**
+     * @brief Handle the result of a CCA of the stage. Report it, by default.
+     * @param status TRX_OFF, BUSY or IDLE
+     */
+    virtual void DoCcaConfirm(PhyEnumeration status);
+
+    /**
+     * @brief Request a CCA from the PHY; its confirm goes to DoCcaConfirm().
+     */
+    void RequestCca();
+
+    /**
+     * @brief Count a CCA done on behalf of the stage.
+     * @param status Result of the CCA
+     * @param duration Duration of the CCA
+     */
+    void CountCca(PhyEnumeration status, Time duration);
+
+    /**
+     * @brief End the access in progress and report its result to the MAC.
+     * @param result CHANNEL_IDLE or CHANNEL_ACCESS_FAILURE
+     */
+    void Finish(MacState result);
+
+    Ptr<RitWpanMac> m_mac;                           //!< MAC of the stage
+    LrWpanMacStateCallback m_lrWpanMacStateCallback; //!< Reports the result to the MAC
+
+  private:
+    RitCarrierSenseStats m_stats; //!< Counters of the stage
+    bool m_running;               //!< An access is in progress
+    bool m_ccaRequestRunning;     //!< The PHY runs a CCA of the stage
+    Time m_accessStart;           //!< Start of the access in progress
+    Time m_ccaStart;              //!< Start of the CCA in progress
+
+    TracedCallback<MacState, Time> m_accessTrace; //!< Result of an access, its delay
+};
+
+/**
+ * @ingroup lr-wpan
+ *
+ * @brief Unslotted CSMA/CA of LrWpanCsmaCa run as a carrier-sense stage.
+ *
+ * LrWpanCsmaCa reports to the stage, which counts the access and forwards every state
+ * to the MAC, so the CSMA/CA of the plain LrWpanMac (RIT mode off) works unchanged.
+ */
+class RitCsmaCaCarrierSense : public RitCarrierSense
+{
+  public:
+    /**
+     * Get the type ID.
+     *
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    RitCsmaCaCarrierSense();
+    ~RitCsmaCaCarrierSense() override;
+
+    /**
+     * @brief Set the CSMA/CA run by the stage and take its state callback.
+     * @param csmaCa The CSMA/CA of the MAC
+     */
+    void SetCsmaCa(Ptr<LrWpanCsmaCa> csmaCa);
+
+    /**
+     * @brief Get the CSMA/CA run by the stage.
+     * @return the CSMA/CA
+     */
+    Ptr<LrWpanCsmaCa> GetCsmaCa() const;
+
+    void Cancel() override;
+    bool PlmeCcaConfirm(PhyEnumeration status) override;
+
+  private:
+    void DoDispose() override;
+    void DoStart() override;
+
+    /**
+     * @brief State reported by the CSMA/CA.
+     * @param state The state
+     */
+    void CsmaCaState(MacState state);
+
+    Ptr<LrWpanCsmaCa> m_csmaCa; //!< CSMA/CA of the MAC
+};
+
+/**
+ * @ingroup lr-wpan
+ *
+ * @brief Frames of RitWpanMac sent after a carrier sense.
+ */
+enum RitCarrierSenseFrame
+{
+    RIT_CS_BEACON_FRAME = 0, //!< RIT Data Request (beacon)
+    RIT_CS_DATA_FRAME = 1    //!< Data frame of a sender
+};
+
+/**
+ * @ingroup lr-wpan
+ *
+ * @brief Carrier-sense stages of a device and the stage of each frame kind.
+ *
+ * The pipeline receives the PLME-CCA.confirm of the PHY and hands it to the first stage,
+ * in registration order, that requested the CCA; every stage then sees the result. A
+ * confirm no stage requested goes to the fallback callback (the CSMA/CA of the plain
+ * LrWpanMac). A frame kind without stage is sent without carrier sense.
+ */
+class RitCarrierSensePipeline : public Object
+{
+  public:
+    /**
+     * Get the type ID.
+     *
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    RitCarrierSensePipeline();
+    ~RitCarrierSensePipeline() override;
+
+    static constexpr const char* CSMA_CA_STAGE = "csma-ca"; //!< Name of the CSMA/CA stage
+    static constexpr const char* PRE_CS_STAGE = "pre-cs";   //!< Name of the Pre-CS stage
+
+    /**
+     * @brief Set the MAC of the device, and attach the registered stages to it.
+     * @param mac the used MAC
+     */
+    void SetMac(Ptr<RitWpanMac> mac);
+
+    /**
+     * @brief Register a stage, attached to the MAC once it is set. A stage registered
+     *        again under its name is replaced.
+     * @param name Name of the stage
+     * @param stage The stage
+     */
+    void AddStage(const std::string& name, Ptr<RitCarrierSense> stage);
+
+    /**
+     * @brief Get a registered stage.
+     * @param name Name of the stage
+     * @return the stage, nullptr if none has the name
+     */
+    Ptr<RitCarrierSense> GetStage(const std::string& name) const;
+
+    /**
+     * @brief Get the names of the registered stages.
+     * @return the names, in registration order
+     */
+    std::vector<std::string> GetStageNames() const;
+
+    /**
+     * @brief Choose the stage run before a frame kind.
+     *
+     * RitWpanMac::SetModuleConfig() selects the built-in stages from the module flags;
+     * select other stages after it.
+     *
+     * @param frame The frame kind
+     * @param stage A registered stage, nullptr to send without carrier sense
+     */
+    void Select(RitCarrierSenseFrame frame, Ptr<RitCarrierSense> stage);
+
+    /**
+     * @brief Get the stage run before a frame kind.
+     * @param frame The frame kind
+     * @return the stage, nullptr without carrier sense
+     */
+    Ptr<RitCarrierSense> GetSelected(RitCarrierSenseFrame frame) const;
+
+    /**
+     * @brief Whether a frame kind is sent after a carrier sense.
+     * @param frame The frame kind
+     * @return true if a stage is selected for it
+     */
+    bool IsEnabled(RitCarrierSenseFrame frame) const;
+
+    /**
+     * @brief Start the stage of a frame kind.
+     * @param frame The frame kind, with a stage selected
+     */
+    void Start(RitCarrierSenseFrame frame);
+
+    /**
+     * @brief Cancel the accesses of every stage.
+     */
+    void Cancel();
+
+    /**
+     * @brief Set the callback of the CCA confirms no stage requested.
+     * @param fallbackCcaConfirmCallback PLME-CCA.confirm of the plain CSMA/CA
+     */
+    void SetFallbackCcaConfirmCallback(FallbackCcaConfirmCallback fallbackCcaConfirmCallback);
+
+    /**
+     * IEEE 802.15.4-2006 section 6.2.2.2
+     * PLME-CCA.confirm status
+     * @param status TRX_OFF, BUSY or IDLE
+     */
+    void PlmeCcaConfirm(PhyEnumeration status);
+
+  private:
+    void DoDispose() override;
+
+    /**
+     * @brief Attach a stage to the MAC: the stage reports its results to it.
+     * @param stage The stage
+     */
+    void Attach(Ptr<RitCarrierSense> stage) const;
+
+    Ptr<RitWpanMac> m_mac;                                              //!< MAC of the device
+    std::vector<std::pair<std::string, Ptr<RitCarrierSense>>> m_stages; //!< Registered stages
+    Ptr<RitCarrierSense> m_selected[2];                                 //!< Stage by frame kind
+    FallbackCcaConfirmCallback m_fallbackCcaConfirmCallback;            //!< CCAs of no stage
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // RIT_CARRIER_SENSE_H
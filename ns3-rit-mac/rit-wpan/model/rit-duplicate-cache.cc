@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-duplicate-cache.h"
+
+#include "rit-run-arena.h"
+
+#include "ns3/assert.h"
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+RitDuplicateCache::RitDuplicateCache(uint32_t capacity, Time lifetime)
+    : m_entries(RitRunArena::GetResource()),
+      m_nSets(0),
+      m_lifetime(lifetime),
+      m_nEvictions(0)
+{
+    NS_ASSERT(lifetime.IsStrictlyPositive());
+    SetCapacity(capacity);
+}
+
+void
+RitDuplicateCache::SetCapacity(uint32_t capacity)
+{
+    NS_ASSERT(capacity > 0);
+    m_nSets = (capacity + WAYS - 1) / WAYS;
+    m_entries.assign(m_nSets * WAYS, Entry{});
+}
+
+uint32_t
+RitDuplicateCache::GetCapacity() const
+{
+    return m_entries.size();
+}
+
+void
+RitDuplicateCache::SetLifetime(Time lifetime)
+{
+    NS_ASSERT(lifetime.IsStrictlyPositive());
+    m_lifetime = lifetime;
+}
+
+uint32_t
+RitDuplicateCache::GetSet(uint32_t key) const
+{
+    // Fibonacci hashing, then the high bits scaled to the number of sets: consecutive
+    // sequence numbers of a source spread over the sets.
+    const uint32_t hash = key * 0x9e3779b1U;
+    return static_cast<uint32_t>((static_cast<uint64_t>(hash) * m_nSets) >> 32) * WAYS;
+}
+
+bool
+RitDuplicateCache::Insert(uint32_t key, Time now)
+{
+    Entry* set = &m_entries[GetSet(key)];
+    Entry* victim = &set[0];
+    for (uint32_t i = 0; i < WAYS; i++)
+    {
+        Entry& entry = set[i];
+        if (entry.expiry > now && entry.key == key)
+        {
+            return false;
+        }
+        // An expired entry, or else the one recorded first.
+        if (victim->expiry > now && entry.expiry < victim->expiry)
+        {
+            victim = &entry;
+        }
+    }
+    if (victim->expiry > now)
+    {
+        m_nEvictions++;
+    }
+    victim->key = key;
+    victim->expiry = now + m_lifetime;
+    return true;
+}
+
+uint64_t
+RitDuplicateCache::GetNEvictions() const
+{
+    return m_nEvictions;
+}
+
+void
+RitDuplicateCache::Clear()
+{
+    m_entries.assign(m_entries.size(), Entry{});
+}
+
+} // namespace lrwpan
+} // namespace ns3
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef NS3_LRWPAN_RIT_DUPLICATE_CACHE_H
+#define NS3_LRWPAN_RIT_DUPLICATE_CACHE_H
+
+#include "ns3/nstime.h"
+
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @ingroup lrwpan
+ *
+ * @brief Fixed-capacity cache of the frames already received, for duplicate detection.
+ *
+ * A frame is identified by a 32-bit key, e.g. its source and sequence number. The cache
+ * is set-associative: a key hashes to a set of WAYS entries, so a lookup reads at most
+ * WAYS entries whatever the number of sources. An entry expires after the lifetime, which
+ * must be shorter than the time a source takes to reuse a sequence number; a new key
+ * takes an expired entry of its set, or else the oldest one.
+ *
+ * An evicted key is no longer detected, so a duplicate may get through a full cache, but
+ * a new frame is never taken for a duplicate while its key is unused for the lifetime.
+ */
+class RitDuplicateCache
+{
+  public:
+    static constexpr uint32_t WAYS = 4; //!< Entries of a set
+
+    /**
+     * @param capacity Number of entries, rounded up to a multiple of WAYS
+     * @param lifetime Time an entry is kept
+     */
+    explicit RitDuplicateCache(uint32_t capacity = 32, Time lifetime = Seconds(30));
+
+    /**
+     * @brief Set the number of entries, emptying the cache.
+     * @param capacity Number of entries (at least 1), rounded up to a multiple of WAYS
+     */
+    void SetCapacity(uint32_t capacity);
+
+    /**
+     * @return the number of entries
+     */
+    uint32_t GetCapacity() const;
+
+    /**
+     * @brief Set the time an entry is kept, for the keys recorded from now on.
+     * @param lifetime Strictly positive time
+     */
+    void SetLifetime(Time lifetime);
+
+    /**
+     * @brief Look a key up and record it if it is new.
+     * @param key Frame identifier
+     * @param now Current time
+     * @return false if the key was recorded less than the lifetime ago: the frame is a
+     *         duplicate
+     */
+    bool Insert(uint32_t key, Time now);
+
+    /** @brief Get the number of unexpired entries replaced by a new key. */
+    uint64_t GetNEvictions() const;
+
+    /** @brief Remove every entry. */
+    void Clear();
+
+  private:
+    /**
+     * One recorded key.
+     */
+    struct Entry
+    {
+        uint32_t key{0}; //!< Frame identifier
+        Time expiry;     //!< End of the lifetime, zero for a free entry
+    };
+
+    /**
+     * @param key Frame identifier
+     * @return the index of the first entry of the set of the key
+     */
+    uint32_t GetSet(uint32_t key) const;
+
+    std::pmr::vector<Entry> m_entries; //!< Sets of WAYS entries, in the RitRunArena
+    uint32_t m_nSets;                  //!< Number of sets
+    Time m_lifetime;                   //!< Time an entry is kept
+    uint64_t m_nEvictions;             //!< Unexpired entries replaced
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // NS3_LRWPAN_RIT_DUPLICATE_CACHE_H
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-frame-codec.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <cstring>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_LOG_COMPONENT_DEFINE("RitFrameCodec");
+
+namespace
+{
+
+constexpr uint32_t MAX_FAST_MAC_HEADER = 11;    //!< Largest fixed layout (short/short, no comp)
+constexpr uint32_t MAX_MAC_HEADER = 37;         //!< Largest MAC header, security included
+constexpr uint32_t NWK_HEADER_SIZE = 6;         //!< Size of the uncompressed RitNwkHeader
+constexpr uint16_t NWK_DISPATCH_COMPRESSED = 3; //!< Option value of a compressed RitNwkHeader
+
+/**
+ * Read a little-endian 16-bit field.
+ * @param b The first byte
+ * @return the value
+ */
+uint16_t
+ReadLsb16(const uint8_t* b)
+{
+    return static_cast<uint16_t>(b[0] | (b[1] << 8));
+}
+
+/**
+ * Read a short address, in the byte order of WriteTo(Buffer::Iterator&, Mac16Address).
+ * @param b The first byte
+ * @return the address
+ */
+Mac16Address
+ReadShortAddr(const uint8_t* b)
+{
+    Mac16Address addr;
+    addr.CopyFrom(b);
+    return addr;
+}
+
+/**
+ * A MAC header layout without security, fixed by its address modes.
+ */
+template <uint8_t DstMode, uint8_t SrcMode, bool PanIdComp>
+struct MacLayout
+{
+    static_assert(DstMode != LrWpanMacHeader::EXTADDR && SrcMode != LrWpanMacHeader::EXTADDR,
+                  "Only short and absent addresses have a fixed layout");
+
+    static constexpr uint32_t DST_SIZE = DstMode == LrWpanMacHeader::SHORTADDR ? 4 : 0;
+    static constexpr uint32_t SRC_SIZE =
+        SrcMode == LrWpanMacHeader::SHORTADDR ? (PanIdComp ? 2 : 4) : 0;
+    static constexpr uint32_t SIZE = 3 + DST_SIZE + SRC_SIZE; //!< Header size
+
+    /**
+     * Decode the header, as LrWpanMacHeader::Deserialize() would into a new header.
+     * @param b The SIZE header bytes
+     * @param hdr The decoded header
+     */
+    static void Decode(const uint8_t* b, LrWpanMacHeader& hdr)
+    {
+        hdr = LrWpanMacHeader();
+        hdr.SetFrameControl(ReadLsb16(b));
+        hdr.SetSeqNum(b[2]);
+        uint16_t dstPanId = 0;
+        if constexpr (DstMode == LrWpanMacHeader::SHORTADDR)
+        {
+            dstPanId = ReadLsb16(b + 3);
+            hdr.SetDstAddrFields(dstPanId, ReadShortAddr(b + 5));
+        }
+        if constexpr (SrcMode == LrWpanMacHeader::SHORTADDR)
+        {
+            if constexpr (PanIdComp)
+            {
+                hdr.SetSrcAddrFields(dstPanId, ReadShortAddr(b + 3 + DST_SIZE));
+            }
+            else
+            {
+                hdr.SetSrcAddrFields(ReadLsb16(b + 3 + DST_SIZE),
+                                     ReadShortAddr(b + 5 + DST_SIZE));
+            }
+        }
+    }
+};
+
+/**
+ * The last MAC header decoded with a fixed layout, with its bytes.
+ */
+struct MacHeaderCache
+{
+    uint8_t bytes[MAX_FAST_MAC_HEADER]; //!< Header bytes
+    uint32_t size = 0;                  //!< Header size, 0 if empty
+    LrWpanMacHeader hdr;                //!< Decoded header
+};
+
+MacHeaderCache g_macHeaderCache; //!< Shared by every device: a frame is seen by several
+
+/**
+ * Decode a fixed layout, or take it from the cache if the bytes are the same.
+ * @param b The header bytes
+ * @param hdr The decoded header
+ * @return the header size
+ */
+template <typename Layout>
+uint32_t
+DecodeCached(const uint8_t* b, LrWpanMacHeader& hdr)
+{
+    MacHeaderCache& cache = g_macHeaderCache;
+    if (cache.size == Layout::SIZE && std::memcmp(cache.bytes, b, Layout::SIZE) == 0)
+    {
+        hdr = cache.hdr;
+        return Layout::SIZE;
+    }
+    Layout::Decode(b, hdr);
+    std::memcpy(cache.bytes, b, Layout::SIZE);
+    cache.size = Layout::SIZE;
+    cache.hdr = hdr;
+    return Layout::SIZE;
+}
+
+} // namespace
+
+uint32_t
+RitFrameCodec::PeekMacHeader(Ptr<const Packet> p, LrWpanMacHeader& hdr)
+{
+    uint8_t b[MAX_FAST_MAC_HEADER];
+    const uint32_t n = p->CopyData(b, sizeof(b));
+    if (n < 3)
+    {
+        return 0;
+    }
+
+    constexpr uint8_t NONE = LrWpanMacHeader::NOADDR;
+    constexpr uint8_t SHORT = LrWpanMacHeader::SHORTADDR;
+    const uint16_t frameControl = ReadLsb16(b);
+    const bool security = (frameControl >> 3) & 0x01;
+    const bool panIdComp = (frameControl >> 6) & 0x01;
+    const uint8_t dstMode = (frameControl >> 10) & 0x03;
+    const uint8_t srcMode = (frameControl >> 14) & 0x03;
+
+    if (!security && dstMode == SHORT && srcMode == SHORT && panIdComp)
+    {
+        using Layout = MacLayout<SHORT, SHORT, true>;
+        return n < Layout::SIZE ? 0 : DecodeCached<Layout>(b, hdr);
+    }
+    if (!security && dstMode == SHORT && srcMode == SHORT)
+    {
+        using Layout = MacLayout<SHORT, SHORT, false>;
+        return n < Layout::SIZE ? 0 : DecodeCached<Layout>(b, hdr);
+    }
+    if (!security && dstMode == SHORT && srcMode == NONE)
+    {
+        using Layout = MacLayout<SHORT, NONE, true>;
+        return n < Layout::SIZE ? 0 : DecodeCached<Layout>(b, hdr);
+    }
+    if (!security && dstMode == NONE && srcMode == NONE)
+    {
+        using Layout = MacLayout<NONE, NONE, false>;
+        return DecodeCached<Layout>(b, hdr);
+    }
+
+    NS_LOG_LOGIC("No fixed layout for frame control " << frameControl);
+    hdr = LrWpanMacHeader();
+    return p->PeekHeader(hdr);
+}
+
+CommandPayloadHeader::MacCommand
+RitFrameCodec::PeekCommandType(Ptr<const Packet> p, uint32_t macHdrSize)
+{
+    NS_ASSERT(macHdrSize <= MAX_MAC_HEADER);
+    uint8_t b[MAX_MAC_HEADER + 1];
+    if (p->CopyData(b, macHdrSize + 1) <= macHdrSize)
+    {
+        return CommandPayloadHeader::CMD_RESERVED;
+    }
+    // The command identifiers are the values of MacCommand; unknown ones map to
+    // CMD_RESERVED.
+    CommandPayloadHeader payload;
+    payload.SetCommandFrameType(static_cast<CommandPayloadHeader::MacCommand>(b[macHdrSize]));
+    return payload.GetCommandFrameType();
+}
+
+uint32_t
+RitFrameCodec::PeekNwkHeader(Ptr<const Packet> p, RitNwkHeader& hdr)
+{
+    uint8_t b[NWK_HEADER_SIZE];
+    const uint32_t n = p->CopyData(b, sizeof(b));
+    if (n < 2)
+    {
+        return 0;
+    }
+    const uint16_t word = ReadLsb16(b);
+    if (((word >> 12) & 0x3) == NWK_DISPATCH_COMPRESSED)
+    {
+        // Variable layout
+        hdr = RitNwkHeader();
+        return p->PeekHeader(hdr);
+    }
+    if (n < NWK_HEADER_SIZE)
+    {
+        return 0;
+    }
+    hdr.SetCompressed(false);
+    hdr.SetSrcAddrElided(false);
+    hdr.SetPriority(word >> 14);
+    hdr.SetOption(static_cast<RitNwkHeader::Option>((word >> 12) & 0x3));
+    hdr.SetRank(word & RitNwkHeader::MAX_RANK);
+    hdr.SetSrcAddr(ReadShortAddr(b + 2));
+    hdr.SetDstAddr(ReadShortAddr(b + 4));
+    return NWK_HEADER_SIZE;
+}
+
+} // namespace lrwpan
+} // namespace ns3
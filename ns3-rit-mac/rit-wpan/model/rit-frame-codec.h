@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef RIT_FRAME_CODEC_H
+#define RIT_FRAME_CODEC_H
+
+#include "ns3/lr-wpan-mac-header.h"
+#include "ns3/lr-wpan-mac-pl-headers.h"
+#include "ns3/packet.h"
+#include "ns3/rit-wpan-nwk-header.h"
+
+#include <cstdint>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @ingroup lr-wpan
+ *
+ * @brief Fixed-layout decoding of the headers of the frames RIT exchanges.
+ *
+ * Packet::PeekHeader() copies the packet buffer and reads the header byte by byte
+ * through Buffer::Iterator, however often the same frame is inspected (the MAC, then
+ * every trace sink on the transmitter and on each receiver). These functions copy the
+ * header bytes once with Packet::CopyData() and decode them with a layout fixed at
+ * compile time for the address modes RIT uses:
+ *  - short destination, short source, PAN ID compression (data frames, RIT Data Request);
+ *  - short destination, no source (multipurpose Beacon ACK);
+ *  - no address (ACK).
+ * Other layouts (extended addresses, security) go through PeekHeader(). The last decoded
+ * MAC header is kept with its bytes, so a frame inspected again is not decoded again.
+ *
+ * Encoding stays on the Header interface: a frame is serialized once.
+ */
+class RitFrameCodec
+{
+  public:
+    /**
+     * @brief Decode the MAC header at the start of a frame.
+     * @param p The frame
+     * @param hdr The decoded header
+     * @return the header size, 0 if the frame is too short for its header
+     */
+    static uint32_t PeekMacHeader(Ptr<const Packet> p, LrWpanMacHeader& hdr);
+
+    /**
+     * @brief Decode the command frame identifier of a command frame.
+     * @param p The frame, MAC header included
+     * @param macHdrSize Size of its MAC header, as returned by PeekMacHeader()
+     * @return the command type, CMD_RESERVED if there is no payload
+     */
+    static CommandPayloadHeader::MacCommand PeekCommandType(Ptr<const Packet> p,
+                                                              uint32_t macHdrSize);
+
+    /**
+     * @brief Decode the RIT NWK header at the start of a packet (the compressed
+     * format, of variable layout, through PeekHeader()).
+     * @param p The packet
+     * @param hdr The decoded header
+     * @return the header size, 0 if the packet is too short
+     */
+    static uint32_t PeekNwkHeader(Ptr<const Packet> p, RitNwkHeader& hdr);
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // RIT_FRAME_CODEC_H
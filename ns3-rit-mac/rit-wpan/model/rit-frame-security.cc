@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-frame-security.h"
+
+#include "ns3/abort.h"
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+RitFrameSecurity::RitFrameSecurity()
+    : m_secLevel(0),
+      m_keyIdMode(LrWpanMacHeader::NOKEYSOURCE),
+      m_frameCounter(0),
+      m_nReplays(0)
+{
+}
+
+void
+RitFrameSecurity::SetSecLevel(uint8_t secLevel)
+{
+    NS_ABORT_MSG_IF(secLevel > 7, "Invalid security level " << +secLevel);
+    m_secLevel = secLevel;
+}
+
+uint8_t
+RitFrameSecurity::GetSecLevel() const
+{
+    return m_secLevel;
+}
+
+void
+RitFrameSecurity::SetKeyIdMode(uint8_t keyIdMode)
+{
+    NS_ABORT_MSG_IF(keyIdMode > LrWpanMacHeader::LONGKEYSOURCE,
+                    "Invalid key identifier mode " << +keyIdMode);
+    m_keyIdMode = keyIdMode;
+}
+
+uint8_t
+RitFrameSecurity::GetKeyIdMode() const
+{
+    return m_keyIdMode;
+}
+
+bool
+RitFrameSecurity::IsEnabled() const
+{
+    return m_secLevel != 0;
+}
+
+uint32_t
+RitFrameSecurity::GetMicLength(uint8_t secLevel)
+{
+    // MIC-32, MIC-64 and MIC-128, with or without encryption (levels 4 to 7)
+    switch (secLevel & 0x03)
+    {
+    case 1:
+        return 4;
+    case 2:
+        return 8;
+    case 3:
+        return 16;
+    default:
+        return 0;
+    }
+}
+
+uint32_t
+RitFrameSecurity::GetOverhead() const
+{
+    if (!IsEnabled())
+    {
+        return 0;
+    }
+    // Security control and frame counter, then the key identifier
+    static constexpr uint32_t KEY_ID_SIZE[] = {0, 1, 5, 9};
+    return 5 + KEY_ID_SIZE[m_keyIdMode] + GetMicLength(m_secLevel);
+}
+
+void
+RitFrameSecurity::Secure(LrWpanMacHeader& hdr)
+{
+    NS_ABORT_MSG_IF(m_frameCounter == UINT32_MAX, "Frame counter exhausted");
+    hdr.SetSecEnable();
+    hdr.SetFrameVer(1);
+    hdr.SetSecLevel(m_secLevel);
+    hdr.SetKeyIdMode(m_keyIdMode);
+    switch (m_keyIdMode)
+    {
+    case LrWpanMacHeader::NOKEYSOURCE:
+        hdr.SetKeyId(static_cast<uint8_t>(1));
+        break;
+    case LrWpanMacHeader::SHORTKEYSOURCE:
+        hdr.SetKeyId(static_cast<uint32_t>(0), 1);
+        break;
+    case LrWpanMacHeader::LONGKEYSOURCE:
+        hdr.SetKeyId(static_cast<uint64_t>(0), 1);
+        break;
+    default:
+        break;
+    }
+    hdr.SetFrmCounter(m_frameCounter++);
+}
+
+uint32_t
+RitFrameSecurity::GetFrameCounter() const
+{
+    return m_frameCounter;
+}
+
+bool
+RitFrameSecurity::CheckFrameCounter(Mac16Address src, uint32_t frameCounter)
+{
+    auto [it, inserted] = m_neighbourCounters.try_emplace(src.ConvertToInt(), 0);
+    if (!inserted && frameCounter < it->second)
+    {
+        m_nReplays++;
+        return false;
+    }
+    it->second = frameCounter + 1;
+    return true;
+}
+
+uint32_t
+RitFrameSecurity::GetNNeighbours() const
+{
+    return static_cast<uint32_t>(m_neighbourCounters.size());
+}
+
+uint64_t
+RitFrameSecurity::GetNReplays() const
+{
+    return m_nReplays;
+}
+
+} // namespace lrwpan
+} // namespace ns3
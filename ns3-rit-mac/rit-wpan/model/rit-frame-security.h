@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef RIT_FRAME_SECURITY_H
+#define RIT_FRAME_SECURITY_H
+
+#include "ns3/lr-wpan-mac-header.h"
+#include "ns3/mac16-address.h"
+
+#include <cstdint>
+#include <unordered_map>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @ingroup lr-wpan
+ *
+ * @brief Cost model of the IEEE 802.15.4 frame security (AES-CCM*) of a node.
+ *
+ * Nothing is encrypted: a secured frame carries the auxiliary security header of its
+ * security level and key identifier mode, and a MIC of the length of the level in place
+ * of the authentication tag, so its airtime is that of the real frame. Every secured
+ * transmission takes the next value of the frame counter of the node, and the frame
+ * counter of each neighbour is checked against the last one accepted from it (replay
+ * protection) as by the incoming frame security procedure.
+ */
+class RitFrameSecurity
+{
+  public:
+    RitFrameSecurity();
+
+    /**
+     * @brief Set the security level, 0 for unsecured frames.
+     * @param secLevel Security level (0 to 7, e.g. 6 for ENC-MIC-64)
+     */
+    void SetSecLevel(uint8_t secLevel);
+
+    /**
+     * @brief Get the security level.
+     * @return the level, 0 for unsecured frames
+     */
+    uint8_t GetSecLevel() const;
+
+    /**
+     * @brief Set the key identifier mode of the auxiliary security header.
+     * @param keyIdMode Key identifier mode (0 to 3)
+     */
+    void SetKeyIdMode(uint8_t keyIdMode);
+
+    /**
+     * @brief Get the key identifier mode.
+     * @return the mode
+     */
+    uint8_t GetKeyIdMode() const;
+
+    /**
+     * @brief Whether the frames are secured.
+     * @return true if a security level is set
+     */
+    bool IsEnabled() const;
+
+    /**
+     * @brief Get the MIC length of a security level.
+     * @param secLevel Security level
+     * @return 0, 4, 8 or 16 bytes
+     */
+    static uint32_t GetMicLength(uint8_t secLevel);
+
+    /**
+     * @brief Get the bytes security adds to a frame.
+     * @return the auxiliary security header and the MIC, 0 if disabled
+     */
+    uint32_t GetOverhead() const;
+
+    /**
+     * @brief Give a header the auxiliary security header and the next frame counter.
+     * @param hdr The MAC header of a frame about to be sent
+     */
+    void Secure(LrWpanMacHeader& hdr);
+
+    /**
+     * @brief Get the frame counter of the next secured frame.
+     * @return the counter
+     */
+    uint32_t GetFrameCounter() const;
+
+    /**
+     * @brief Check the frame counter of a secured frame against the last one of its source.
+     * @param src Source of the frame
+     * @param frameCounter Its frame counter
+     * @return true if the frame is new and was accepted, false for a replay
+     */
+    bool CheckFrameCounter(Mac16Address src, uint32_t frameCounter);
+
+    /**
+     * @brief Get the number of neighbours whose frame counter is kept.
+     * @return the number of neighbours
+     */
+    uint32_t GetNNeighbours() const;
+
+    /**
+     * @brief Get the number of frames rejected as replays.
+     * @return the number of frames
+     */
+    uint64_t GetNReplays() const;
+
+  private:
+    uint8_t m_secLevel;      //!< Security level, 0 for none
+    uint8_t m_keyIdMode;     //!< Key identifier mode
+    uint32_t m_frameCounter; //!< Frame counter of the next secured frame
+    uint64_t m_nReplays;     //!< Frames rejected as replays
+
+    /// Lowest frame counter still accepted from each neighbour, by short address
+    std::unordered_map<uint16_t, uint32_t> m_neighbourCounters;
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // RIT_FRAME_SECURITY_H
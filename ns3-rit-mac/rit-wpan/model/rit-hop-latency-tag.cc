@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-hop-latency-tag.h"
+
+#include <algorithm>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_OBJECT_ENSURE_REGISTERED(RitHopLatencyTag);
+
+TypeId
+RitHopLatencyTag::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::lrwpan::RitHopLatencyTag")
+                            .SetParent<Tag>()
+                            .SetGroupName("RitWpan")
+                            .AddConstructor<RitHopLatencyTag>();
+    return tid;
+}
+
+TypeId
+RitHopLatencyTag::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+RitHopLatencyTag::RitHopLatencyTag()
+{
+}
+
+RitHopLatencyTag::RitHopLatencyTag(const RitHopLatencyRecord& record)
+    : m_record(record)
+{
+}
+
+uint32_t
+RitHopLatencyTag::GetSerializedSize() const
+{
+    // Short address + 7 stage timestamps (ackRx is not carried)
+    return sizeof(uint16_t) + 7 * sizeof(int64_t);
+}
+
+void
+RitHopLatencyTag::Serialize(TagBuffer i) const
+{
+    uint8_t addr[2];
+    m_record.addr.CopyTo(addr);
+    i.WriteU8(addr[0]);
+    i.WriteU8(addr[1]);
+    i.WriteU64(m_record.nwkEnqueue.GetTimeStep());
+    i.WriteU64(m_record.macQueueHead.GetTimeStep());
+    i.WriteU64(m_record.beaconWaitStart.GetTimeStep());
+    i.WriteU64(m_record.beaconRx.GetTimeStep());
+    i.WriteU64(m_record.csStart.GetTimeStep());
+    i.WriteU64(m_record.csEnd.GetTimeStep());
+    i.WriteU64(m_record.phyTxStart.GetTimeStep());
+}
+
+void
+RitHopLatencyTag::Deserialize(TagBuffer i)
+{
+    uint8_t addr[2];
+    addr[0] = i.ReadU8();
+    addr[1] = i.ReadU8();
+    m_record.addr.CopyFrom(addr);
+    m_record.nwkEnqueue = TimeStep(i.ReadU64());
+    m_record.macQueueHead = TimeStep(i.ReadU64());
+    m_record.beaconWaitStart = TimeStep(i.ReadU64());
+    m_record.beaconRx = TimeStep(i.ReadU64());
+    m_record.csStart = TimeStep(i.ReadU64());
+    m_record.csEnd = TimeStep(i.ReadU64());
+    m_record.phyTxStart = TimeStep(i.ReadU64());
+    m_record.ackRx = Time();
+}
+
+void
+RitHopLatencyTag::Print(std::ostream& os) const
+{
+    os << "addr=" << m_record.addr << " nwkEnqueue=" << m_record.nwkEnqueue.As(Time::S)
+       << " macQueueHead=" << m_record.macQueueHead.As(Time::S)
+       << " beaconWaitStart=" << m_record.beaconWaitStart.As(Time::S)
+       << " beaconRx=" << m_record.beaconRx.As(Time::S)
+       << " csStart=" << m_record.csStart.As(Time::S) << " csEnd=" << m_record.csEnd.As(Time::S)
+       << " phyTxStart=" << m_record.phyTxStart.As(Time::S);
+}
+
+void
+RitHopLatencyTag::Set(const RitHopLatencyRecord& record)
+{
+    m_record = record;
+}
+
+const RitHopLatencyRecord&
+RitHopLatencyTag::Get() const
+{
+    return m_record;
+}
+
+std::vector<RitHopLatencyRecord>
+RitHopLatencyTag::Collect(Ptr<const Packet> p)
+{
+    std::vector<RitHopLatencyRecord> records;
+    ByteTagIterator it = p->GetByteTagIterator();
+    while (it.HasNext())
+    {
+        ByteTagIterator::Item item = it.Next();
+        if (item.GetTypeId() != GetTypeId())
+        {
+            continue;
+        }
+        RitHopLatencyTag tag;
+        item.GetTag(tag);
+        records.push_back(tag.Get());
+    }
+    std::stable_sort(records.begin(),
+                     records.end(),
+                     [](const RitHopLatencyRecord& a, const RitHopLatencyRecord& b) {
+                         return a.phyTxStart < b.phyTxStart;
+                     });
+    return records;
+}
+
+} // namespace lrwpan
+} // namespace ns3
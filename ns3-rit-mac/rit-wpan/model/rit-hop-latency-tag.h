@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef RIT_HOP_LATENCY_TAG_H
+#define RIT_HOP_LATENCY_TAG_H
+
+#include "ns3/mac16-address.h"
+#include "ns3/nstime.h"
+#include "ns3/packet.h"
+#include "ns3/tag.h"
+
+#include <vector>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @ingroup lr-wpan
+ *
+ * Stage timestamps of one hop of a data frame.
+ *
+ * The stages are visited in order, so consecutive differences give the time
+ * spent in each stage. A zero timestamp means the stage was not reached (e.g.
+ * csStart == csEnd when no channel access is configured, ackRx when no ACK was
+ * requested).
+ */
+struct RitHopLatencyRecord
+{
+    Mac16Address addr;    //!< Short address of the transmitting node
+    Time nwkEnqueue;      //!< Handed to the NWK (origin or forwarding)
+    Time macQueueHead;    //!< Became the head of the MAC TX queue
+    Time beaconWaitStart; //!< First beacon wait window opened for this frame
+    Time beaconRx;        //!< RIT Data Request of the receiver received
+    Time csStart;         //!< CSMA/CA or Pre-CS started
+    Time csEnd;           //!< Channel found idle
+    Time phyTxStart;      //!< PD-DATA.request issued
+    Time ackRx;           //!< ACK received (sender side only, not carried by the tag)
+};
+
+/**
+ * @ingroup lr-wpan
+ *
+ * Per-hop latency breakdown carried with a data frame.
+ *
+ * RitWpanMac adds one tag per hop as a byte tag at PHY transmission start.
+ * Byte tags survive header removal and NWK forwarding, so the sink finds the
+ * tags of all hops in the received payload (see Collect()). Packet tags are not
+ * used since a full record does not fit PACKET_TAG_MAX_SIZE.
+ */
+class RitHopLatencyTag : public Tag
+{
+  public:
+    /**
+     * Get the type ID.
+     *
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    TypeId GetInstanceTypeId() const override;
+
+    /**
+     * Create an empty tag.
+     */
+    RitHopLatencyTag();
+
+    /**
+     * Create a tag for the given record.
+     * @param record the stage timestamps of the hop
+     */
+    RitHopLatencyTag(const RitHopLatencyRecord& record);
+
+    uint32_t GetSerializedSize() const override;
+    void Serialize(TagBuffer i) const override;
+    void Deserialize(TagBuffer i) override;
+    void Print(std::ostream& os) const override;
+
+    /**
+     * Set the stage timestamps.
+     *
+     * @param record the stage timestamps of the hop
+     */
+    void Set(const RitHopLatencyRecord& record);
+
+    /**
+     * Get the stage timestamps.
+     *
+     * @return the stage timestamps of the hop
+     */
+    const RitHopLatencyRecord& Get() const;
+
+    /**
+     * Collect the records of all hops carried by a packet, in hop order.
+     *
+     * @param p the packet
+     * @return the hop records (empty if the packet carries no tag)
+     */
+    static std::vector<RitHopLatencyRecord> Collect(Ptr<const Packet> p);
+
+  private:
+    /**
+     * The stage timestamps of the hop.
+     */
+    RitHopLatencyRecord m_record;
+};
+
+} // namespace lrwpan
+} // namespace ns3
+#endif /* RIT_HOP_LATENCY_TAG_H */
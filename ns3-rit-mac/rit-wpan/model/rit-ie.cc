@@ -0,0 +1,363 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-ie.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/buffer.h"
+
+#include <algorithm>
+#include <ostream>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+namespace
+{
+
+/**
+ * Registration of an IE type.
+ */
+struct IeType
+{
+    std::string name;     //!< Name, empty if not registered
+    uint8_t minLength{0}; //!< Shortest content
+    uint8_t maxLength{0}; //!< Longest content
+};
+
+/**
+ * @brief Registered IE types, the RIT ones included.
+ * @return the table, indexed by element ID
+ */
+std::array<IeType, 256>&
+GetTypes()
+{
+    static std::array<IeType, 256> types = []() {
+        std::array<IeType, 256> t{};
+        t[RIT_IE_RANK] = {"Rank", 2, 2};
+        t[RIT_IE_QUEUE_CREDIT] = {"QueueCredit", 1, 1};
+        t[RIT_IE_PHASE] = {"Phase", 8, 8};
+        t[RIT_IE_CHANNEL] = {"Channel", 1, 1};
+        t[RIT_IE_APPOINTMENT] = {"Appointment", 8, 8};
+        return t;
+    }();
+    return types;
+}
+
+} // namespace
+
+void
+RitIeRegistry::Register(uint8_t id, const std::string& name, uint8_t minLength, uint8_t maxLength)
+{
+    NS_ABORT_MSG_IF(id >= RIT_IE_HT1, "Element ID " << +id << " is a termination IE");
+    NS_ABORT_MSG_IF(name.empty(), "IE type without a name");
+    NS_ABORT_MSG_IF(minLength > maxLength || maxLength > RitIeList::MAX_LENGTH,
+                    "Bad lengths of the IE type " << name);
+    GetTypes()[id] = {name, minLength, maxLength};
+}
+
+bool
+RitIeRegistry::IsRegistered(uint8_t id)
+{
+    return !GetTypes()[id].name.empty();
+}
+
+std::string
+RitIeRegistry::GetName(uint8_t id)
+{
+    return GetTypes()[id].name;
+}
+
+bool
+RitIeRegistry::IsValidLength(uint8_t id, uint8_t length)
+{
+    const IeType& type = GetTypes()[id];
+    return type.name.empty() || (length >= type.minLength && length <= type.maxLength);
+}
+
+void
+RitIeList::AddDescriptor(uint8_t id, uint8_t length)
+{
+    NS_ASSERT_MSG(length <= MAX_LENGTH, "Header IE content of " << +length << " bytes");
+    NS_ASSERT_MSG(id < RIT_IE_HT1, "Termination IEs are added by Encode()");
+    // Bits 0-6: length, bits 7-14: element ID, bit 15: type 0 (header IE)
+    const uint16_t descriptor = (length & 0x7f) | (static_cast<uint16_t>(id) << 7);
+    m_bytes.push_back(descriptor & 0xff);
+    m_bytes.push_back(descriptor >> 8);
+}
+
+void
+RitIeList::Add(uint8_t id, const uint8_t* data, uint8_t length)
+{
+    AddDescriptor(id, length);
+    m_bytes.insert(m_bytes.end(), data, data + length);
+}
+
+void
+RitIeList::AddU8(uint8_t id, uint8_t value)
+{
+    Add(id, &value, 1);
+}
+
+void
+RitIeList::AddU16(uint8_t id, uint16_t value)
+{
+    const uint8_t data[2] = {static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8)};
+    Add(id, data, sizeof(data));
+}
+
+void
+RitIeList::AddU32(uint8_t id, uint32_t value)
+{
+    uint8_t data[4];
+    for (uint32_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+    Add(id, data, sizeof(data));
+}
+
+void
+RitIeList::AddHeader(uint8_t id, const Header& header)
+{
+    const uint32_t length = header.GetSerializedSize();
+    NS_ASSERT_MSG(length <= MAX_LENGTH, "Header of " << length << " bytes in an IE");
+    Buffer buffer;
+    buffer.AddAtStart(length);
+    header.Serialize(buffer.Begin());
+    AddDescriptor(id, static_cast<uint8_t>(length));
+    const size_t start = m_bytes.size();
+    m_bytes.resize(start + length);
+    buffer.CopyData(m_bytes.data() + start, length);
+}
+
+void
+RitIeList::Clear()
+{
+    m_bytes.clear();
+}
+
+bool
+RitIeList::IsEmpty() const
+{
+    return m_bytes.empty();
+}
+
+std::vector<uint8_t>
+RitIeList::Encode(bool payloadFollows) const
+{
+    std::vector<uint8_t> bytes;
+    bytes.reserve(GetEncodedSize(payloadFollows));
+    bytes.insert(bytes.end(), m_bytes.begin(), m_bytes.end());
+    if (payloadFollows)
+    {
+        const uint16_t descriptor = static_cast<uint16_t>(RIT_IE_HT2) << 7;
+        bytes.push_back(descriptor & 0xff);
+        bytes.push_back(descriptor >> 8);
+    }
+    return bytes;
+}
+
+uint32_t
+RitIeList::GetEncodedSize(bool payloadFollows) const
+{
+    return m_bytes.size() + (payloadFollows ? DESCRIPTOR_SIZE : 0);
+}
+
+bool
+RitIeView::Parse(const uint8_t* data, uint32_t size)
+{
+    m_nEntries = 0;
+    m_size = 0;
+    m_terminated = false;
+    uint32_t pos = 0;
+    uint8_t used = 0;
+    while (pos + RitIeList::DESCRIPTOR_SIZE <= size)
+    {
+        const uint16_t descriptor = data[pos] | (static_cast<uint16_t>(data[pos + 1]) << 8);
+        const uint8_t length = descriptor & 0x7f;
+        const uint8_t id = (descriptor >> 7) & 0xff;
+        pos += RitIeList::DESCRIPTOR_SIZE;
+        if (!(descriptor & 0x8000) && (id == RIT_IE_HT1 || id == RIT_IE_HT2))
+        {
+            m_size = pos;
+            m_terminated = true;
+            return true;
+        }
+        // A payload IE needs a Header Termination 1 before it.
+        if ((descriptor & 0x8000) || pos + length > size ||
+            !RitIeRegistry::IsValidLength(id, length) ||
+            m_nEntries == MAX_IES || used + length > MAX_BYTES)
+        {
+            m_nEntries = 0;
+            return false;
+        }
+        std::copy(data + pos, data + pos + length, m_bytes.begin() + used);
+        m_entries[m_nEntries++] = {id, length, used};
+        used += length;
+        pos += length;
+    }
+    if (pos != size)
+    {
+        m_nEntries = 0;
+        return false; // A truncated descriptor
+    }
+    m_size = pos;
+    return true;
+}
+
+bool
+RitIeView::Parse(Ptr<const Packet> p)
+{
+    // A list that fits in the view is at most its IEs, their descriptors and a termination.
+    std::array<uint8_t, MAX_BYTES + (MAX_IES + 1) * RitIeList::DESCRIPTOR_SIZE> data;
+    const uint32_t size = p->CopyData(data.data(), data.size());
+    if (!Parse(data.data(), size))
+    {
+        return false;
+    }
+    // Without a termination the list runs to the end of the packet.
+    if (!m_terminated && size < p->GetSize())
+    {
+        m_nEntries = 0;
+        m_size = 0;
+        return false; // Longer than the view
+    }
+    return true;
+}
+
+uint32_t
+RitIeView::GetSerializedSize() const
+{
+    return m_size;
+}
+
+uint8_t
+RitIeView::GetN() const
+{
+    return m_nEntries;
+}
+
+uint8_t
+RitIeView::GetId(uint8_t i) const
+{
+    NS_ASSERT(i < m_nEntries);
+    return m_entries[i].id;
+}
+
+const RitIeView::Entry*
+RitIeView::Lookup(uint8_t id) const
+{
+    for (uint8_t i = 0; i < m_nEntries; i++)
+    {
+        if (m_entries[i].id == id)
+        {
+            return &m_entries[i];
+        }
+    }
+    return nullptr;
+}
+
+bool
+RitIeView::Contains(uint8_t id) const
+{
+    return Lookup(id) != nullptr;
+}
+
+bool
+RitIeView::Find(uint8_t id, const uint8_t*& data, uint8_t& length) const
+{
+    const Entry* entry = Lookup(id);
+    if (!entry)
+    {
+        return false;
+    }
+    data = m_bytes.data() + entry->offset;
+    length = entry->length;
+    return true;
+}
+
+bool
+RitIeView::GetU8(uint8_t id, uint8_t& value) const
+{
+    const Entry* entry = Lookup(id);
+    if (!entry || entry->length != 1)
+    {
+        return false;
+    }
+    value = m_bytes[entry->offset];
+    return true;
+}
+
+bool
+RitIeView::GetU16(uint8_t id, uint16_t& value) const
+{
+    const Entry* entry = Lookup(id);
+    if (!entry || entry->length != 2)
+    {
+        return false;
+    }
+    value = m_bytes[entry->offset] | (static_cast<uint16_t>(m_bytes[entry->offset + 1]) << 8);
+    return true;
+}
+
+bool
+RitIeView::GetU32(uint8_t id, uint32_t& value) const
+{
+    const Entry* entry = Lookup(id);
+    if (!entry || entry->length != 4)
+    {
+        return false;
+    }
+    value = 0;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        value |= static_cast<uint32_t>(m_bytes[entry->offset + i]) << (8 * i);
+    }
+    return true;
+}
+
+bool
+RitIeView::GetHeader(uint8_t id, Header& header) const
+{
+    const Entry* entry = Lookup(id);
+    if (!entry || entry->length < header.GetSerializedSize())
+    {
+        return false;
+    }
+    Buffer buffer;
+    buffer.AddAtStart(entry->length);
+    buffer.Begin().Write(m_bytes.data() + entry->offset, entry->length);
+    header.Deserialize(buffer.Begin());
+    return true;
+}
+
+void
+RitIeView::Print(std::ostream& os) const
+{
+    for (uint8_t i = 0; i < m_nEntries; i++)
+    {
+        const std::string name = RitIeRegistry::GetName(m_entries[i].id);
+        os << (i == 0 ? "" : " ");
+        if (name.empty())
+        {
+            os << "IE-0x" << std::hex << +m_entries[i].id << std::dec;
+        }
+        else
+        {
+            os << name;
+        }
+        os << "(" << +m_entries[i].length << ")";
+    }
+}
+
+} // namespace lrwpan
+} // namespace ns3
@@ -0,0 +1,298 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef NS3_LRWPAN_RIT_IE_H
+#define NS3_LRWPAN_RIT_IE_H
+
+#include "ns3/header.h"
+#include "ns3/packet.h"
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @ingroup lrwpan
+ *
+ * @brief Element IDs of the RIT header IEs, from the range IEEE 802.15.4-2020 Table
+ *        7-7 leaves unassigned.
+ */
+enum RitIeId : uint8_t
+{
+    RIT_IE_RANK = 0x40,         //!< Routing rank of the beaconing node (2 bytes)
+    RIT_IE_QUEUE_CREDIT = 0x41, //!< Frames the node can still take (1 byte)
+    RIT_IE_PHASE = 0x42,        //!< Beacon phase and period (8 bytes)
+    RIT_IE_CHANNEL = 0x43,      //!< Receive channel (1 byte)
+    RIT_IE_APPOINTMENT = 0x44,  //!< Beacon appointment, a RitAppointmentHeader (8 bytes)
+    RIT_IE_HT1 = 0x7e,          //!< Header Termination 1: payload IEs follow
+    RIT_IE_HT2 = 0x7f,          //!< Header Termination 2: the MAC payload follows
+};
+
+/**
+ * @ingroup lrwpan
+ *
+ * @brief Registry of the header IE types, checked by RitIeView::Parse().
+ *
+ * A registered IE of the wrong length makes the list malformed; unregistered IEs are
+ * kept without a check, as IEEE 802.15.4 lets a receiver ignore the IEs it does not
+ * know. The RIT IEs (RitIeId) are registered from the start.
+ */
+class RitIeRegistry
+{
+  public:
+    /**
+     * @brief Register an IE type, or change its name and lengths.
+     * @param id Element ID, below RIT_IE_HT1
+     * @param name Name used by RitIeView::Print()
+     * @param minLength Shortest content
+     * @param maxLength Longest content
+     */
+    static void Register(uint8_t id, const std::string& name, uint8_t minLength, uint8_t maxLength);
+
+    /**
+     * @param id Element ID
+     * @return true if the IE type is registered
+     */
+    static bool IsRegistered(uint8_t id);
+
+    /**
+     * @param id Element ID
+     * @return the name of the IE type, empty if it is not registered
+     */
+    static std::string GetName(uint8_t id);
+
+    /**
+     * @brief Check the content length of an IE against its registration.
+     * @param id Element ID
+     * @param length Content length
+     * @return false if the IE type is registered for other lengths
+     */
+    static bool IsValidLength(uint8_t id, uint8_t length);
+};
+
+/**
+ * @ingroup lrwpan
+ *
+ * @brief Encoder of a list of header IEs.
+ *
+ * Each IE is a 2-byte descriptor (bits 0-6: content length, bits 7-14: element ID,
+ * bit 15: type 0) followed by its content, as the header IEs of IEEE 802.15.4-2020
+ * 7.4.2.1.
+ */
+class RitIeList
+{
+  public:
+    static constexpr uint8_t DESCRIPTOR_SIZE = 2; //!< Size of an IE descriptor
+    static constexpr uint8_t MAX_LENGTH = 127;    //!< Longest content of a header IE
+
+    /**
+     * @brief Append an IE.
+     * @param id Element ID
+     * @param data Content
+     * @param length Content length, up to MAX_LENGTH
+     */
+    void Add(uint8_t id, const uint8_t* data, uint8_t length);
+
+    /**
+     * @brief Append an IE of one byte.
+     * @param id Element ID
+     * @param value Content
+     */
+    void AddU8(uint8_t id, uint8_t value);
+
+    /**
+     * @brief Append an IE of two bytes, little endian.
+     * @param id Element ID
+     * @param value Content
+     */
+    void AddU16(uint8_t id, uint16_t value);
+
+    /**
+     * @brief Append an IE of four bytes, little endian.
+     * @param id Element ID
+     * @param value Content
+     */
+    void AddU32(uint8_t id, uint32_t value);
+
+    /**
+     * @brief Append an IE holding a serialized header.
+     * @param id Element ID
+     * @param header Content, up to MAX_LENGTH bytes
+     */
+    void AddHeader(uint8_t id, const Header& header);
+
+    /**
+     * @brief Remove every IE.
+     */
+    void Clear();
+
+    /**
+     * @return true without any IE
+     */
+    bool IsEmpty() const;
+
+    /**
+     * @brief Encode the list.
+     * @param payloadFollows Whether the MAC payload follows, ending the list with a
+     *        Header Termination 2 IE
+     * @return the octets of the list
+     */
+    std::vector<uint8_t> Encode(bool payloadFollows) const;
+
+    /**
+     * @param payloadFollows As in Encode()
+     * @return the size of the encoded list
+     */
+    uint32_t GetEncodedSize(bool payloadFollows) const;
+
+  private:
+    /**
+     * @brief Append a descriptor.
+     * @param id Element ID
+     * @param length Content length
+     */
+    void AddDescriptor(uint8_t id, uint8_t length);
+
+    std::vector<uint8_t> m_bytes; //!< Encoded IEs, without termination
+};
+
+/**
+ * @ingroup lrwpan
+ *
+ * @brief Parsed list of header IEs, with a fixed size and no allocation.
+ *
+ * Parse() keeps up to MAX_IES IEs and MAX_BYTES of content inline, so the view can be
+ * passed by value in the MLME indications. Lookups return the content of the first IE
+ * with the given ID.
+ */
+class RitIeView
+{
+  public:
+    static constexpr uint8_t MAX_IES = 8;    //!< IEs kept
+    static constexpr uint8_t MAX_BYTES = 64; //!< Content bytes kept
+
+    /**
+     * @brief Parse a list of header IEs, up to a termination IE or the end of the data.
+     * @param data Start of the list
+     * @param size Bytes available
+     * @return false if the list is malformed or does not fit in the view; the view is
+     *         then empty
+     */
+    bool Parse(const uint8_t* data, uint32_t size);
+
+    /**
+     * @brief Parse the list at the start of a packet.
+     * @param p Packet, left unchanged
+     * @return as Parse(const uint8_t*, uint32_t)
+     */
+    bool Parse(Ptr<const Packet> p);
+
+    /**
+     * @return the bytes taken by the list in the frame, termination included
+     */
+    uint32_t GetSerializedSize() const;
+
+    /**
+     * @return the number of IEs
+     */
+    uint8_t GetN() const;
+
+    /**
+     * @param i Index, below GetN()
+     * @return the element ID of the IE
+     */
+    uint8_t GetId(uint8_t i) const;
+
+    /**
+     * @param id Element ID
+     * @return true if an IE has this ID
+     */
+    bool Contains(uint8_t id) const;
+
+    /**
+     * @brief Find an IE.
+     * @param id Element ID
+     * @param [out] data Start of its content, valid as long as the view
+     * @param [out] length Content length
+     * @return false if no IE has this ID
+     */
+    bool Find(uint8_t id, const uint8_t*& data, uint8_t& length) const;
+
+    /**
+     * @brief Read an IE of one byte.
+     * @param id Element ID
+     * @param [out] value Content
+     * @return false if no IE of one byte has this ID
+     */
+    bool GetU8(uint8_t id, uint8_t& value) const;
+
+    /**
+     * @brief Read an IE of two bytes.
+     * @param id Element ID
+     * @param [out] value Content
+     * @return false if no IE of two bytes has this ID
+     */
+    bool GetU16(uint8_t id, uint16_t& value) const;
+
+    /**
+     * @brief Read an IE of four bytes.
+     * @param id Element ID
+     * @param [out] value Content
+     * @return false if no IE of four bytes has this ID
+     */
+    bool GetU32(uint8_t id, uint32_t& value) const;
+
+    /**
+     * @brief Deserialize the header held by an IE.
+     * @param id Element ID
+     * @param [out] header Header read
+     * @return false if no IE has this ID or it is shorter than the header
+     */
+    bool GetHeader(uint8_t id, Header& header) const;
+
+    /**
+     * @brief Print the IEs with their registered names.
+     * @param os The output stream
+     */
+    void Print(std::ostream& os) const;
+
+  private:
+    /**
+     * One parsed IE.
+     */
+    struct Entry
+    {
+        uint8_t id;     //!< Element ID
+        uint8_t length; //!< Content length
+        uint8_t offset; //!< Content offset in m_bytes
+    };
+
+    /**
+     * @param id Element ID
+     * @return the first entry with this ID, nullptr if none
+     */
+    const Entry* Lookup(uint8_t id) const;
+
+    std::array<Entry, MAX_IES> m_entries{};   //!< Parsed IEs
+    std::array<uint8_t, MAX_BYTES> m_bytes{}; //!< Contents of the IEs
+    uint8_t m_nEntries{0};                    //!< Number of parsed IEs
+    uint32_t m_size{0};                       //!< Bytes parsed, termination included
+    bool m_terminated{false};                 //!< The list ended with a termination IE
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // NS3_LRWPAN_RIT_IE_H
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-latency-sketch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+namespace
+{
+constexpr uint64_t LINEAR_LIMIT = uint64_t(1) << RitLatencySketch::SUB_BUCKET_BITS;
+constexpr uint64_t HALF_BUCKETS = LINEAR_LIMIT >> 1;
+} // namespace
+
+RitLatencySketch::RitLatencySketch()
+{
+    Reset();
+}
+
+uint32_t
+RitLatencySketch::GetBucketIndex(uint64_t value)
+{
+    if (value < LINEAR_LIMIT)
+    {
+        return static_cast<uint32_t>(value);
+    }
+    // Keep the SUB_BUCKET_BITS most significant bits of the value
+    uint32_t msb = 63;
+    while (!(value >> msb))
+    {
+        msb--;
+    }
+    uint32_t shift = msb - (SUB_BUCKET_BITS - 1);
+    return static_cast<uint32_t>(shift * HALF_BUCKETS + (value >> shift));
+}
+
+uint64_t
+RitLatencySketch::GetBucketLower(uint32_t index)
+{
+    if (index < LINEAR_LIMIT)
+    {
+        return index;
+    }
+    uint64_t shift = index / HALF_BUCKETS - 1;
+    uint64_t mantissa = index - shift * HALF_BUCKETS;
+    return mantissa << shift;
+}
+
+uint64_t
+RitLatencySketch::GetBucketUpper(uint32_t index)
+{
+    if (index < LINEAR_LIMIT)
+    {
+        return index;
+    }
+    uint64_t shift = index / HALF_BUCKETS - 1;
+    return GetBucketLower(index) + (uint64_t(1) << shift) - 1;
+}
+
+void
+RitLatencySketch::Record(Time delay)
+{
+    int64_t ns = delay.GetNanoSeconds();
+    uint64_t value = ns > 0 ? static_cast<uint64_t>(ns) : 0;
+    uint32_t index = GetBucketIndex(value);
+    if (index >= m_counts.size())
+    {
+        m_counts.resize(index + 1, 0);
+    }
+    m_counts[index]++;
+    m_count++;
+    m_min = std::min(m_min, value);
+    m_max = std::max(m_max, value);
+    m_sum += static_cast<double>(value);
+}
+
+void
+RitLatencySketch::Merge(const RitLatencySketch& other)
+{
+    if (other.m_count == 0)
+    {
+        return;
+    }
+    if (other.m_counts.size() > m_counts.size())
+    {
+        m_counts.resize(other.m_counts.size(), 0);
+    }
+    for (size_t i = 0; i < other.m_counts.size(); i++)
+    {
+        m_counts[i] += other.m_counts[i];
+    }
+    m_count += other.m_count;
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+    m_sum += other.m_sum;
+}
+
+void
+RitLatencySketch::Reset()
+{
+    m_counts.clear();
+    m_count = 0;
+    m_min = std::numeric_limits<uint64_t>::max();
+    m_max = 0;
+    m_sum = 0.0;
+}
+
+uint64_t
+RitLatencySketch::GetCount() const
+{
+    return m_count;
+}
+
+Time
+RitLatencySketch::GetMin() const
+{
+    return m_count ? NanoSeconds(m_min) : Time();
+}
+
+Time
+RitLatencySketch::GetMax() const
+{
+    return m_count ? NanoSeconds(m_max) : Time();
+}
+
+Time
+RitLatencySketch::GetMean() const
+{
+    return m_count ? NanoSeconds(static_cast<int64_t>(m_sum / m_count)) : Time();
+}
+
+Time
+RitLatencySketch::GetQuantile(double q) const
+{
+    if (m_count == 0)
+    {
+        return Time();
+    }
+    if (q <= 0.0)
+    {
+        return GetMin();
+    }
+    if (q >= 1.0)
+    {
+        return GetMax();
+    }
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * m_count)));
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < m_counts.size(); i++)
+    {
+        seen += m_counts[i];
+        if (seen >= rank)
+        {
+            uint64_t mid = GetBucketLower(i) + (GetBucketUpper(i) - GetBucketLower(i)) / 2;
+            return NanoSeconds(std::clamp(mid, m_min, m_max));
+        }
+    }
+    return GetMax();
+}
+
+void
+RitLatencySketch::Write(std::ostream& os, Time now) const
+{
+    for (uint32_t i = 0; i < m_counts.size(); i++)
+    {
+        if (m_counts[i])
+        {
+            os << now.GetSeconds() << "," << GetBucketLower(i) << "," << GetBucketUpper(i) << ","
+               << m_counts[i] << "\n";
+        }
+    }
+}
+
+} // namespace lrwpan
+} // namespace ns3
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef RIT_LATENCY_SKETCH_H
+#define RIT_LATENCY_SKETCH_H
+
+#include "ns3/nstime.h"
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @ingroup lr-wpan
+ *
+ * @brief Mergeable streaming quantile sketch of delays (HDR-style histogram).
+ *
+ * Delays are counted in log-linear buckets of nanoseconds: values below
+ * 2^SUB_BUCKET_BITS ns get their own bucket, larger values share a bucket with
+ * a relative width of at most 2^-(SUB_BUCKET_BITS-1) (0.8 %). Memory is bounded
+ * by the largest recorded delay, not by the number of samples, and two sketches
+ * merge by adding their bucket counts, so sketches of many seeds can be combined
+ * without re-reading the rx logs (see analysis/common/latency_sketch.py).
+ */
+class RitLatencySketch
+{
+  public:
+    static constexpr uint32_t SUB_BUCKET_BITS = 8; //!< Linear sub-buckets per octave (log2)
+
+    RitLatencySketch();
+
+    /**
+     * @brief Record one delay sample (negative values are counted as zero).
+     * @param delay The delay
+     */
+    void Record(Time delay);
+
+    /**
+     * @brief Add the samples of another sketch.
+     * @param other The sketch to merge
+     */
+    void Merge(const RitLatencySketch& other);
+
+    /** @brief Forget all samples. */
+    void Reset();
+
+    /** @brief Get the number of samples. */
+    uint64_t GetCount() const;
+
+    /** @brief Get the smallest sample (zero if empty). */
+    Time GetMin() const;
+
+    /** @brief Get the largest sample (zero if empty). */
+    Time GetMax() const;
+
+    /** @brief Get the exact mean of the samples (zero if empty). */
+    Time GetMean() const;
+
+    /**
+     * @brief Get an approximate quantile.
+     * @param q The quantile in [0, 1] (e.g. 0.99)
+     * @return The midpoint of the bucket holding the q-th sample, clamped to [min, max]
+     */
+    Time GetQuantile(double q) const;
+
+    /**
+     * @brief Write the non-empty buckets as CSV rows "time,lower_ns,upper_ns,count".
+     * @param os The output stream
+     * @param now The snapshot time written in the first column
+     */
+    void Write(std::ostream& os, Time now) const;
+
+    /** @brief Get the bucket of a value in ns. */
+    static uint32_t GetBucketIndex(uint64_t value);
+
+    /** @brief Get the smallest value in ns counted in a bucket. */
+    static uint64_t GetBucketLower(uint32_t index);
+
+    /** @brief Get the largest value in ns counted in a bucket. */
+    static uint64_t GetBucketUpper(uint32_t index);
+
+  private:
+    std::vector<uint64_t> m_counts; //!< Per-bucket counts (grown on demand)
+    uint64_t m_count;               //!< Number of samples
+    uint64_t m_min;                 //!< Smallest sample [ns]
+    uint64_t m_max;                 //!< Largest sample [ns]
+    double m_sum;                   //!< Sum of the samples [ns]
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // RIT_LATENCY_SKETCH_H
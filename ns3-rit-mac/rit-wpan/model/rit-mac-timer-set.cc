@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-mac-timer-set.h"
+
+#include "rit-run-arena.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/lr-wpan-event-profiler.h"
+#include "ns3/rit-realtime-monitor.h"
+#include "ns3/simulator.h"
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_LOG_COMPONENT_DEFINE("RitMacTimerSet");
+
+RitMacTimerSet::RitMacTimerSet(uint32_t nTimers)
+    : m_timers(nTimers,
+               Timer{Callback<void>(), Time(), 0, false, NO_PROFILE, 0},
+               RitRunArena::GetResource()),
+      m_eventTime(Time::Max()),
+      m_nextSeq(0),
+      m_nScheduled(0)
+{
+}
+
+RitMacTimerSet::~RitMacTimerSet()
+{
+    m_event.Cancel();
+}
+
+void
+RitMacTimerSet::SetHandler(uint32_t id, Callback<void> handler, const std::string& profileName)
+{
+    NS_ASSERT(id < m_timers.size());
+    m_timers[id].handler = handler;
+    m_timers[id].profileId =
+        profileName.empty() ? NO_PROFILE : LrWpanEventProfiler::RegisterHandler(profileName);
+    if (!profileName.empty())
+    {
+        m_timers[id].monitorId = RitRealtimeMonitor::RegisterHandler(profileName);
+    }
+}
+
+void
+RitMacTimerSet::Schedule(uint32_t id, Time delay)
+{
+    NS_LOG_FUNCTION(this << id << delay);
+    NS_ASSERT(id < m_timers.size());
+    NS_ASSERT(!delay.IsNegative());
+    Timer& timer = m_timers[id];
+    if (LrWpanEventProfiler::IsEnabled() && timer.profileId != NO_PROFILE)
+    {
+        // Moving a pending timer cancels its previous deadline.
+        if (timer.pending)
+        {
+            LrWpanEventProfiler::RecordCancelled(timer.profileId);
+        }
+        LrWpanEventProfiler::RecordScheduled(timer.profileId);
+    }
+    timer.deadline = Simulator::Now() + delay;
+    timer.seq = m_nextSeq++;
+    timer.pending = true;
+    Rearm();
+}
+
+void
+RitMacTimerSet::Cancel(uint32_t id)
+{
+    NS_LOG_FUNCTION(this << id);
+    NS_ASSERT(id < m_timers.size());
+    // The shared event is left in place; it moves on when it fires.
+    if (m_timers[id].pending && m_timers[id].profileId != NO_PROFILE)
+    {
+        LrWpanEventProfiler::RecordCancelled(m_timers[id].profileId);
+    }
+    m_timers[id].pending = false;
+}
+
+void
+RitMacTimerSet::CancelAll()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto& timer : m_timers)
+    {
+        if (timer.pending && timer.profileId != NO_PROFILE)
+        {
+            LrWpanEventProfiler::RecordCancelled(timer.profileId);
+        }
+        timer.pending = false;
+    }
+    m_event.Cancel();
+    m_eventTime = Time::Max();
+}
+
+bool
+RitMacTimerSet::IsPending(uint32_t id) const
+{
+    NS_ASSERT(id < m_timers.size());
+    return m_timers[id].pending;
+}
+
+bool
+RitMacTimerSet::IsExpired(uint32_t id) const
+{
+    return !IsPending(id);
+}
+
+Time
+RitMacTimerSet::GetDelayLeft(uint32_t id) const
+{
+    NS_ASSERT(id < m_timers.size());
+    return m_timers[id].pending ? m_timers[id].deadline - Simulator::Now() : Time();
+}
+
+uint64_t
+RitMacTimerSet::GetNScheduledEvents() const
+{
+    return m_nScheduled;
+}
+
+void
+RitMacTimerSet::Expire()
+{
+    NS_LOG_FUNCTION(this);
+    m_eventTime = Time::Max();
+    const Time now = Simulator::Now();
+    // Timers armed by the handlers below wait for a new event.
+    const uint64_t lastSeq = m_nextSeq;
+
+    while (true)
+    {
+        Timer* due = nullptr;
+        for (auto& timer : m_timers)
+        {
+            if (timer.pending && timer.deadline <= now && timer.seq < lastSeq &&
+                (!due || timer.deadline < due->deadline ||
+                 (timer.deadline == due->deadline && timer.seq < due->seq)))
+            {
+                due = &timer;
+            }
+        }
+        if (!due)
+        {
+            break;
+        }
+        due->pending = false;
+        if (!due->handler.IsNull())
+        {
+            if (due->profileId == NO_PROFILE)
+            {
+                due->handler();
+            }
+            else
+            {
+                RitRealtimeMonitor::RecordLateness(due->monitorId, due->deadline);
+                LrWpanEventProfiler::Scope profile(due->profileId);
+                due->handler();
+            }
+        }
+    }
+    Rearm();
+}
+
+void
+RitMacTimerSet::Rearm()
+{
+    Time earliest = Time::Max();
+    for (const auto& timer : m_timers)
+    {
+        if (timer.pending && timer.deadline < earliest)
+        {
+            earliest = timer.deadline;
+        }
+    }
+    if (earliest == Time::Max())
+    {
+        return;
+    }
+    if (m_event.IsPending() && m_eventTime <= earliest)
+    {
+        return;
+    }
+    m_event.Cancel();
+    m_event = Simulator::Schedule(earliest - Simulator::Now(), &RitMacTimerSet::Expire, this);
+    m_eventTime = earliest;
+    m_nScheduled++;
+}
+
+} // namespace lrwpan
+} // namespace ns3
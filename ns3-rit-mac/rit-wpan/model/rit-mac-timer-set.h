@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef RIT_MAC_TIMER_SET_H
+#define RIT_MAC_TIMER_SET_H
+
+#include "ns3/callback.h"
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @ingroup lr-wpan
+ *
+ * @brief A fixed set of logical timers sharing one scheduler event.
+ *
+ * Only the earliest deadline is kept in the simulator event queue. Cancelling a
+ * timer or moving it to a later deadline does not touch the queue: the shared
+ * event fires, finds nothing due and moves itself to the next deadline. Only a
+ * deadline earlier than the shared event reschedules it.
+ *
+ * Timers due at the same time expire in the order they were armed. A timer armed
+ * by a handler for the current time expires in a new event, after the events
+ * already queued for that time, as with Simulator::ScheduleNow.
+ *
+ * Against the other events due at the same time, the order differs from one EventId
+ * per timer: the timers run when the shared event does, and the shared event keeps the
+ * place it took in the queue when it was last scheduled. A timer armed for the time of
+ * the shared event therefore runs before the events queued for that time in between,
+ * while a deadline that moves the shared event earlier puts it after every event
+ * already queued for the new time. Code that relies on the order of a timer and an
+ * event of another object at one instant must not use this class.
+ */
+class RitMacTimerSet
+{
+  public:
+    /**
+     * @param nTimers Number of logical timers (ids 0 to nTimers - 1)
+     */
+    explicit RitMacTimerSet(uint32_t nTimers);
+    ~RitMacTimerSet();
+
+    /**
+     * @brief Set the function called when a timer expires.
+     * @param id Timer id
+     * @param handler The handler
+     * @param profileName Name of the handler in LrWpanEventProfiler and RitRealtimeMonitor
+     *        (not profiled if empty)
+     */
+    void SetHandler(uint32_t id, Callback<void> handler, const std::string& profileName = "");
+
+    /**
+     * @brief Arm a timer, replacing its previous deadline if it is pending.
+     * @param id Timer id
+     * @param delay Delay from now to the expiration
+     */
+    void Schedule(uint32_t id, Time delay);
+
+    /**
+     * @brief Disarm a timer. No-op if it is not pending.
+     * @param id Timer id
+     */
+    void Cancel(uint32_t id);
+
+    /**
+     * @brief Disarm every timer and remove the shared event.
+     */
+    void CancelAll();
+
+    /**
+     * @param id Timer id
+     * @return true if the timer is armed and has not expired yet
+     */
+    bool IsPending(uint32_t id) const;
+
+    /**
+     * @param id Timer id
+     * @return true if the timer is not pending
+     */
+    bool IsExpired(uint32_t id) const;
+
+    /**
+     * @param id Timer id
+     * @return the time left before the expiration, zero if the timer is not pending
+     */
+    Time GetDelayLeft(uint32_t id) const;
+
+    /**
+     * @brief Number of scheduler events created so far.
+     */
+    uint64_t GetNScheduledEvents() const;
+
+  private:
+    /**
+     * A logical timer.
+     */
+    struct Timer
+    {
+        Callback<void> handler; //!< Called at the expiration
+        Time deadline;          //!< Absolute expiration time
+        uint64_t seq;           //!< Arming order, breaks deadline ties
+        bool pending;           //!< Whether the timer is armed
+        uint32_t profileId;     //!< LrWpanEventProfiler handler id, NO_PROFILE if none
+        uint32_t monitorId;     //!< RitRealtimeMonitor handler id, if profiled
+    };
+
+    /**
+     * @brief Shared event handler: expire the due timers and move the event on.
+     */
+    void Expire();
+
+    /**
+     * @brief Make sure the shared event fires no later than the earliest deadline.
+     */
+    void Rearm();
+
+    static constexpr uint32_t NO_PROFILE = UINT32_MAX; //!< Timer not profiled
+
+    std::pmr::vector<Timer> m_timers; //!< Logical timers, indexed by id, in the RitRunArena
+    EventId m_event;                  //!< The shared scheduler event
+    Time m_eventTime;                 //!< Expiration time of m_event
+    uint64_t m_nextSeq;               //!< Sequence number of the next arming
+    uint64_t m_nScheduled;            //!< Scheduler events created
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // RIT_MAC_TIMER_SET_H
@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-neighbour-table.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_LOG_COMPONENT_DEFINE("RitNeighbourTable");
+
+double
+RitNeighbour::GetEtx() const
+{
+    // A link that never delivers counts as 100 transmissions.
+    return 1.0 / std::max(prr, 0.01);
+}
+
+RitNeighbourTable::RitNeighbourTable(uint32_t capacity)
+    : m_entries(RitRunArena::GetResource()),
+      m_capacity(capacity),
+      m_weight(0.125),
+      m_staleTime(Seconds(60)),
+      m_hasProtected(false),
+      m_nEvictions(0),
+      m_nRejections(0)
+{
+    NS_ASSERT(capacity > 0);
+    m_entries.reserve(capacity);
+}
+
+void
+RitNeighbourTable::SetCapacity(uint32_t capacity)
+{
+    NS_ASSERT(capacity > 0);
+    m_capacity = capacity;
+    while (m_entries.size() > m_capacity)
+    {
+        auto victim = m_entries.end();
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+        {
+            if ((!m_hasProtected || it->addr != m_protected) &&
+                (victim == m_entries.end() || IsWorse(*it, *victim)))
+            {
+                victim = it;
+            }
+        }
+        NS_ASSERT(victim != m_entries.end());
+        m_entries.erase(victim);
+    }
+    m_entries.reserve(m_capacity);
+}
+
+void
+RitNeighbourTable::SetEwmaWeight(double weight)
+{
+    NS_ASSERT(weight > 0.0 && weight <= 1.0);
+    m_weight = weight;
+}
+
+void
+RitNeighbourTable::SetStaleTime(Time staleTime)
+{
+    m_staleTime = staleTime;
+}
+
+void
+RitNeighbourTable::SetProtected(Mac16Address addr)
+{
+    m_protected = addr;
+    m_hasProtected = true;
+}
+
+void
+RitNeighbourTable::ClearProtected()
+{
+    m_hasProtected = false;
+}
+
+RitNeighbour*
+RitNeighbourTable::NotifyBeacon(Mac16Address addr, uint16_t rank, uint8_t lqi, Time now)
+{
+    NS_LOG_FUNCTION(this << addr << rank << (uint32_t)lqi);
+
+    RitNeighbour* entry = Find(addr);
+    if (entry)
+    {
+        entry->rank = rank;
+        entry->stale = false;
+        entry->lqi += m_weight * (lqi - entry->lqi);
+        entry->period = now - entry->lastBeacon;
+        entry->lastBeacon = now;
+        return entry;
+    }
+
+    RitNeighbour newcomer;
+    newcomer.addr = addr;
+    newcomer.rank = rank;
+    newcomer.lqi = lqi;
+    newcomer.prr = std::max(lqi / 255.0, 0.01);
+    newcomer.lastBeacon = now;
+
+    if (m_entries.size() < m_capacity)
+    {
+        m_entries.push_back(newcomer);
+        return &m_entries.back();
+    }
+
+    // Full: a failed entry, the least recently heard entry if it is stale, otherwise
+    // the worst parent.
+    auto failed = m_entries.end();
+    auto oldest = m_entries.end();
+    auto worst = m_entries.end();
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        if (m_hasProtected && it->addr == m_protected)
+        {
+            continue;
+        }
+        if (it->stale && failed == m_entries.end())
+        {
+            failed = it;
+        }
+        if (oldest == m_entries.end() || it->lastBeacon < oldest->lastBeacon)
+        {
+            oldest = it;
+        }
+        if (worst == m_entries.end() || IsWorse(*it, *worst))
+        {
+            worst = it;
+        }
+    }
+
+    auto victim = failed;
+    if (victim == m_entries.end() && oldest != m_entries.end() &&
+        now - oldest->lastBeacon > m_staleTime)
+    {
+        victim = oldest;
+    }
+    if (victim == m_entries.end() && worst != m_entries.end() && rank < worst->rank)
+    {
+        victim = worst;
+    }
+    if (victim == m_entries.end())
+    {
+        NS_LOG_DEBUG("Neighbour table full; " << addr << " left out.");
+        m_nRejections++;
+        return nullptr;
+    }
+
+    NS_LOG_DEBUG("Neighbour " << victim->addr << " replaced by " << addr);
+    *victim = newcomer;
+    m_nEvictions++;
+    return &*victim;
+}
+
+void
+RitNeighbourTable::NotifyTxOutcome(Mac16Address addr, bool acked)
+{
+    RitNeighbour* entry = Find(addr);
+    if (!entry)
+    {
+        return;
+    }
+    entry->prr += m_weight * ((acked ? 1.0 : 0.0) - entry->prr);
+}
+
+void
+RitNeighbourTable::MarkStale(Mac16Address addr)
+{
+    NS_LOG_FUNCTION(this << addr);
+    if (RitNeighbour* entry = Find(addr))
+    {
+        entry->stale = true;
+    }
+}
+
+RitNeighbour*
+RitNeighbourTable::Find(Mac16Address addr)
+{
+    for (auto& entry : m_entries)
+    {
+        if (entry.addr == addr)
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+const RitNeighbour*
+RitNeighbourTable::Find(Mac16Address addr) const
+{
+    return const_cast<RitNeighbourTable*>(this)->Find(addr);
+}
+
+const RitNeighbour*
+RitNeighbourTable::SelectParent(uint8_t minLqi, double maxEtx, uint16_t maxRank) const
+{
+    const RitNeighbour* best = nullptr;
+    for (const auto& entry : m_entries)
+    {
+        if (entry.stale || entry.rank >= RitNwkHeader::MAX_RANK || entry.rank > maxRank ||
+            entry.lqi < minLqi || (maxEtx > 0.0 && entry.GetEtx() > maxEtx))
+        {
+            continue;
+        }
+        if (!best || IsWorse(*best, entry))
+        {
+            best = &entry;
+        }
+    }
+    return best;
+}
+
+const std::pmr::vector<RitNeighbour>&
+RitNeighbourTable::GetEntries() const
+{
+    return m_entries;
+}
+
+uint64_t
+RitNeighbourTable::GetNEvictions() const
+{
+    return m_nEvictions;
+}
+
+uint64_t
+RitNeighbourTable::GetNRejections() const
+{
+    return m_nRejections;
+}
+
+bool
+RitNeighbourTable::Restore(const RitNeighbour& entry)
+{
+    NS_LOG_FUNCTION(this << entry.addr);
+    if (RitNeighbour* existing = Find(entry.addr))
+    {
+        *existing = entry;
+        return true;
+    }
+    if (m_entries.size() >= m_capacity)
+    {
+        m_nRejections++;
+        return false;
+    }
+    m_entries.push_back(entry);
+    return true;
+}
+
+void
+RitNeighbourTable::Clear()
+{
+    m_entries.clear();
+}
+
+bool
+RitNeighbourTable::IsWorse(const RitNeighbour& a, const RitNeighbour& b)
+{
+    if (a.rank != b.rank)
+    {
+        return a.rank > b.rank;
+    }
+    return a.GetEtx() > b.GetEtx();
+}
+
+} // namespace lrwpan
+} // namespace ns3
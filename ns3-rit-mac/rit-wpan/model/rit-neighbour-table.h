@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef RIT_NEIGHBOUR_TABLE_H
+#define RIT_NEIGHBOUR_TABLE_H
+
+#include "rit-run-arena.h"
+#include "rit-wpan-nwk-header.h"
+
+#include "ns3/mac16-address.h"
+#include "ns3/nstime.h"
+
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @brief A neighbour heard through its RIT Data Requests.
+ */
+struct RitNeighbour
+{
+    Mac16Address addr;                     //!< Short address
+    uint16_t rank{RitNwkHeader::MAX_RANK}; //!< Rank advertised in the last beacon
+    double lqi{0.0};                       //!< EWMA of the beacon LQI
+    double prr{1.0};                       //!< EWMA of the acknowledged exchanges, 1 / ETX
+    Time lastBeacon;                       //!< Reception time of the last beacon
+    Time period;                           //!< Last beacon interval, zero after a single beacon
+    bool answered{false};                  //!< One of its beacons was answered with data
+    bool stale{false};                     //!< Marked failed, cleared by its next beacon
+    uint8_t energy{UINT8_MAX};             //!< Residual energy level of its last beacon
+
+    /**
+     * @return the expected number of transmissions of a frame to this neighbour
+     */
+    double GetEtx() const;
+};
+
+/**
+ * @ingroup lr-wpan
+ *
+ * @brief Fixed-capacity table of the beaconing neighbours of a node.
+ *
+ * Each beacon updates the rank, the LQI average and the beacon phase of its
+ * source; each data exchange answering a beacon updates the delivery ratio of
+ * the neighbour, the ETX being its inverse. A new neighbour starts with the
+ * delivery ratio given by its LQI (LQI / 255).
+ *
+ * When the table is full, a new neighbour replaces an entry marked stale or the
+ * least recently heard entry if no beacon came from it for the stale time,
+ * otherwise the worst entry (highest rank, then highest ETX) if the newcomer
+ * has a lower rank. The protected entry (the parent) is never replaced.
+ * Entries are kept in a vector searched linearly, the capacity being a few
+ * tens at most; its memory comes from the RitRunArena of the table creation.
+ */
+class RitNeighbourTable
+{
+  public:
+    /**
+     * @param capacity Largest number of entries
+     */
+    explicit RitNeighbourTable(uint32_t capacity = 16);
+
+    /**
+     * @brief Set the largest number of entries, dropping the worst ones if needed.
+     * @param capacity Largest number of entries (at least 1)
+     */
+    void SetCapacity(uint32_t capacity);
+
+    /**
+     * @brief Set the weight of a new sample in the LQI and delivery averages.
+     * @param weight Weight in (0, 1]
+     */
+    void SetEwmaWeight(double weight);
+
+    /**
+     * @brief Set the time after which an entry may be replaced by any newcomer.
+     * @param staleTime Time since the last beacon
+     */
+    void SetStaleTime(Time staleTime);
+
+    /**
+     * @brief Set the entry that is never replaced (e.g. the parent).
+     * @param addr Short address
+     */
+    void SetProtected(Mac16Address addr);
+
+    /** @brief Let every entry be replaced. */
+    void ClearProtected();
+
+    /**
+     * @brief Record a beacon.
+     * @param addr Source of the beacon
+     * @param rank Rank advertised in the beacon
+     * @param lqi LQI of the beacon
+     * @param now Reception time
+     * @return the entry of the neighbour, or nullptr if the table had no room for it
+     */
+    RitNeighbour* NotifyBeacon(Mac16Address addr, uint16_t rank, uint8_t lqi, Time now);
+
+    /**
+     * @brief Record the outcome of a data exchange with a neighbour.
+     * @param addr Receiver of the exchange
+     * @param acked Whether the data frame was acknowledged
+     */
+    void NotifyTxOutcome(Mac16Address addr, bool acked);
+
+    /**
+     * @brief Mark a neighbour as failed until its next beacon: it is not chosen as
+     *        parent and is the first entry replaced.
+     * @param addr Short address
+     */
+    void MarkStale(Mac16Address addr);
+
+    /**
+     * @param addr Short address
+     * @return the entry of the neighbour, or nullptr if it is not in the table
+     */
+    RitNeighbour* Find(Mac16Address addr);
+
+    /**
+     * @param addr Short address
+     * @return the entry of the neighbour, or nullptr if it is not in the table
+     */
+    const RitNeighbour* Find(Mac16Address addr) const;
+
+    /**
+     * @brief Choose a parent among the entries not marked stale: lowest rank, then
+     *        lowest ETX.
+     * @param minLqi Lowest LQI average of a parent
+     * @param maxEtx Largest ETX of a parent, zero for no limit
+     * @param maxRank Largest rank of a parent
+     * @return the best entry, or nullptr if no neighbour with a known rank qualifies
+     */
+    const RitNeighbour* SelectParent(uint8_t minLqi,
+                                     double maxEtx,
+                                     uint16_t maxRank = RitNwkHeader::MAX_RANK - 1) const;
+
+    /** @brief Get the entries, in no particular order. */
+    const std::pmr::vector<RitNeighbour>& GetEntries() const;
+
+    /** @brief Get the number of entries replaced by a newcomer. */
+    uint64_t GetNEvictions() const;
+
+    /** @brief Get the number of newcomers left out of a full table. */
+    uint64_t GetNRejections() const;
+
+    /**
+     * @brief Put back an entry saved by a checkpoint, replacing the entry of the
+     *        same neighbour.
+     * @param entry The entry
+     * @return false if the table has no room for a new neighbour
+     */
+    bool Restore(const RitNeighbour& entry);
+
+    /** @brief Remove every entry. */
+    void Clear();
+
+  private:
+    /**
+     * @param a An entry
+     * @param b Another entry
+     * @return true if a is a worse parent than b
+     */
+    static bool IsWorse(const RitNeighbour& a, const RitNeighbour& b);
+
+    std::pmr::vector<RitNeighbour> m_entries; //!< Neighbours, at most m_capacity
+    uint32_t m_capacity;                      //!< Largest number of entries
+    double m_weight;                          //!< EWMA weight of a new sample
+    Time m_staleTime;                         //!< Age of a replaceable entry
+    Mac16Address m_protected;                 //!< Entry never replaced
+    bool m_hasProtected;                      //!< Whether m_protected is set
+    uint64_t m_nEvictions;                    //!< Entries replaced
+    uint64_t m_nRejections;                   //!< Newcomers left out
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // RIT_NEIGHBOUR_TABLE_H
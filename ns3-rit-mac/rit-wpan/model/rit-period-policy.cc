@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-period-policy.h"
+
+#include "ns3/double.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_LOG_COMPONENT_DEFINE("RitPeriodPolicy");
+
+NS_OBJECT_ENSURE_REGISTERED(RitPeriodPolicy);
+NS_OBJECT_ENSURE_REGISTERED(RitAimdPeriodPolicy);
+NS_OBJECT_ENSURE_REGISTERED(RitTargetUtilizationPeriodPolicy);
+
+TypeId
+RitPeriodPolicy::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::lrwpan::RitPeriodPolicy").SetParent<Object>().SetGroupName("LrWpan");
+    return tid;
+}
+
+TypeId
+RitAimdPeriodPolicy::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::lrwpan::RitAimdPeriodPolicy")
+            .SetParent<RitPeriodPolicy>()
+            .SetGroupName("LrWpan")
+            .AddConstructor<RitAimdPeriodPolicy>()
+            .AddAttribute("IncreaseStep",
+                          "Period added after a window without inbound data",
+                          TimeValue(MilliSeconds(500)),
+                          MakeTimeAccessor(&RitAimdPeriodPolicy::m_increaseStep),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("DecreaseFactor",
+                          "Period divisor after a window with inbound data",
+                          DoubleValue(2.0),
+                          MakeDoubleAccessor(&RitAimdPeriodPolicy::m_decreaseFactor),
+                          MakeDoubleChecker<double>(1.0));
+    return tid;
+}
+
+RitAimdPeriodPolicy::RitAimdPeriodPolicy()
+    : m_increaseStep(MilliSeconds(500)),
+      m_decreaseFactor(2.0)
+{
+}
+
+Time
+RitAimdPeriodPolicy::Update(Time period, const RitPeriodLoad& load)
+{
+    NS_LOG_FUNCTION(this << period << load.answered);
+    if (load.answered > 0)
+    {
+        return Seconds(period.GetSeconds() / m_decreaseFactor);
+    }
+    return period + m_increaseStep;
+}
+
+TypeId
+RitTargetUtilizationPeriodPolicy::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::lrwpan::RitTargetUtilizationPeriodPolicy")
+            .SetParent<RitPeriodPolicy>()
+            .SetGroupName("LrWpan")
+            .AddConstructor<RitTargetUtilizationPeriodPolicy>()
+            .AddAttribute("TargetUtilization",
+                          "Target share of beacons followed by a data frame",
+                          DoubleValue(0.5),
+                          MakeDoubleAccessor(
+                              &RitTargetUtilizationPeriodPolicy::m_targetUtilization),
+                          MakeDoubleChecker<double>(0.01, 1.0))
+            .AddAttribute("MaxStepFactor",
+                          "Largest change of the period per window (multiplicative)",
+                          DoubleValue(2.0),
+                          MakeDoubleAccessor(&RitTargetUtilizationPeriodPolicy::m_maxStepFactor),
+                          MakeDoubleChecker<double>(1.0));
+    return tid;
+}
+
+RitTargetUtilizationPeriodPolicy::RitTargetUtilizationPeriodPolicy()
+    : m_targetUtilization(0.5),
+      m_maxStepFactor(2.0)
+{
+}
+
+Time
+RitTargetUtilizationPeriodPolicy::Update(Time period, const RitPeriodLoad& load)
+{
+    NS_LOG_FUNCTION(this << period << load.answered << load.beacons);
+    if (load.beacons == 0)
+    {
+        return period;
+    }
+    // Frames announcing more data count as demand the beacons did not serve.
+    const double utilization =
+        static_cast<double>(load.answered + load.backlogged) / load.beacons;
+    double factor = m_maxStepFactor;
+    if (utilization > 0)
+    {
+        factor = std::clamp(m_targetUtilization / utilization,
+                            1.0 / m_maxStepFactor,
+                            m_maxStepFactor);
+    }
+    return Seconds(period.GetSeconds() * factor);
+}
+
+} // namespace lrwpan
+} // namespace ns3
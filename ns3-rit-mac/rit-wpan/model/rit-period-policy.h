@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef RIT_PERIOD_POLICY_H
+#define RIT_PERIOD_POLICY_H
+
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+
+#include <cstdint>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @ingroup lr-wpan
+ *
+ * Inbound load of a RIT receiver over one adaptation window.
+ */
+struct RitPeriodLoad
+{
+    uint32_t beacons{0};    //!< RIT Data Requests scheduled (sent or elided)
+    uint32_t answered{0};   //!< Beacons followed by at least one data frame
+    uint32_t frames{0};     //!< Data frames received
+    uint32_t backlogged{0}; //!< Data frames announcing more data (continuousTxEnabled)
+};
+
+/**
+ * @ingroup lr-wpan
+ *
+ * @brief Policy adjusting the RIT period of a node from its inbound load.
+ *
+ * RitWpanMac calls Update() at the end of every adaptation window and clamps the
+ * result to its configured bounds.
+ */
+class RitPeriodPolicy : public Object
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * @brief Compute the RIT period for the next window.
+     * @param period The current RIT period
+     * @param load The load observed during the window that just ended
+     * @return the new RIT period (before clamping)
+     */
+    virtual Time Update(Time period, const RitPeriodLoad& load) = 0;
+};
+
+/**
+ * @ingroup lr-wpan
+ *
+ * @brief Additive-increase / multiplicative-decrease of the RIT period.
+ *
+ * A window with inbound data divides the period by DecreaseFactor, so a busy
+ * receiver beacons more often at once. An idle window adds IncreaseStep.
+ */
+class RitAimdPeriodPolicy : public RitPeriodPolicy
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    RitAimdPeriodPolicy();
+
+    Time Update(Time period, const RitPeriodLoad& load) override;
+
+  private:
+    Time m_increaseStep;     //!< Period added after an idle window
+    double m_decreaseFactor; //!< Period divisor after a busy window
+};
+
+/**
+ * @ingroup lr-wpan
+ *
+ * @brief Keep the share of answered beacons close to a target.
+ *
+ * The period is scaled by TargetUtilization / utilization, with the change per window
+ * limited to MaxStepFactor either way. Utilization is the share of answered beacons,
+ * plus the frames that announced more data. A receiver that beacons with no
+ * answer slows down, one whose every beacon is answered speeds up.
+ */
+class RitTargetUtilizationPeriodPolicy : public RitPeriodPolicy
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    RitTargetUtilizationPeriodPolicy();
+
+    Time Update(Time period, const RitPeriodLoad& load) override;
+
+  private:
+    double m_targetUtilization; //!< Target share of answered beacons
+    double m_maxStepFactor;     //!< Largest change of the period per window
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // RIT_PERIOD_POLICY_H
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-realtime-monitor.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/realtime-simulator-impl.h"
+#include "ns3/simulator.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_LOG_COMPONENT_DEFINE("RitRealtimeMonitor");
+
+bool RitRealtimeMonitor::s_enabled = false;
+
+namespace
+{
+
+/**
+ * State of the monitor, indexed by handler id.
+ */
+struct MonitorState
+{
+    std::vector<std::string> names;                  //!< Name of each handler id
+    std::unordered_map<std::string, uint32_t> ids;   //!< Id of each handler name
+    std::vector<Time> budgets;                       //!< Budget of each handler, 0 for default
+    std::vector<RitRealtimeMonitor::Counters> stats; //!< Counters of each handler
+    Time defaultBudget{MilliSeconds(1)};             //!< Budget of the handlers without one
+    bool abortOnMiss{false};                         //!< A miss aborts the run
+};
+
+MonitorState&
+GetState()
+{
+    static MonitorState state;
+    return state;
+}
+
+/**
+ * @brief Budget of a handler.
+ * @param handler Handler id
+ * @return its budget, or the default one
+ */
+Time
+GetBudget(uint32_t handler)
+{
+    const MonitorState& state = GetState();
+    return state.budgets[handler].IsZero() ? state.defaultBudget : state.budgets[handler];
+}
+
+} // namespace
+
+Time
+RitRealtimeMonitor::Counters::GetMeanLateness() const
+{
+    return executed == 0 ? Time() : totalLateness / static_cast<int64_t>(executed);
+}
+
+void
+RitRealtimeMonitor::Enable()
+{
+    s_enabled = true;
+}
+
+void
+RitRealtimeMonitor::Disable()
+{
+    s_enabled = false;
+}
+
+void
+RitRealtimeMonitor::Reset()
+{
+    for (auto& counters : GetState().stats)
+    {
+        counters = Counters();
+    }
+}
+
+uint32_t
+RitRealtimeMonitor::RegisterHandler(const std::string& name, Time budget)
+{
+    MonitorState& state = GetState();
+    auto [it, added] = state.ids.emplace(name, static_cast<uint32_t>(state.names.size()));
+    if (added)
+    {
+        state.names.push_back(name);
+        state.budgets.push_back(budget);
+        state.stats.emplace_back();
+    }
+    return it->second;
+}
+
+void
+RitRealtimeMonitor::SetBudget(const std::string& name, Time budget)
+{
+    NS_ABORT_MSG_IF(!budget.IsStrictlyPositive(), "The budget of " << name << " is not positive");
+    GetState().budgets[RegisterHandler(name)] = budget;
+}
+
+void
+RitRealtimeMonitor::SetDefaultBudget(Time budget)
+{
+    NS_ABORT_MSG_IF(!budget.IsStrictlyPositive(), "The default budget is not positive");
+    GetState().defaultBudget = budget;
+}
+
+void
+RitRealtimeMonitor::SetAbortOnMiss(bool abort)
+{
+    GetState().abortOnMiss = abort;
+}
+
+void
+RitRealtimeMonitor::DoRecordLateness(uint32_t handler, Time deadline)
+{
+    Ptr<RealtimeSimulatorImpl> impl =
+        DynamicCast<RealtimeSimulatorImpl>(Simulator::GetImplementation());
+    if (!impl)
+    {
+        return;
+    }
+    MonitorState& state = GetState();
+    NS_ASSERT(handler < state.stats.size());
+    const Time lateness = Max(impl->RealtimeNow() - deadline, Time());
+
+    Counters& counters = state.stats[handler];
+    counters.executed++;
+    counters.totalLateness += lateness;
+    counters.maxLateness = Max(counters.maxLateness, lateness);
+    const Time budget = GetBudget(handler);
+    if (lateness > budget)
+    {
+        counters.misses++;
+        NS_LOG_WARN(state.names[handler] << " due at " << deadline.As(Time::S) << " ran "
+                                         << lateness.As(Time::US) << " late (budget "
+                                         << budget.As(Time::US) << ")");
+        NS_ABORT_MSG_IF(state.abortOnMiss,
+                        state.names[handler] << " missed its deadline by "
+                                             << (lateness - budget).As(Time::US));
+    }
+}
+
+RitRealtimeMonitor::Counters
+RitRealtimeMonitor::GetCounters(const std::string& name)
+{
+    const MonitorState& state = GetState();
+    auto it = state.ids.find(name);
+    return it == state.ids.end() ? Counters() : state.stats[it->second];
+}
+
+uint64_t
+RitRealtimeMonitor::GetNMisses()
+{
+    uint64_t misses = 0;
+    for (const auto& counters : GetState().stats)
+    {
+        misses += counters.misses;
+    }
+    return misses;
+}
+
+void
+RitRealtimeMonitor::WriteTable(std::ostream& os)
+{
+    const MonitorState& state = GetState();
+    os << "handler,executed,misses,mean_us,max_us,budget_us\n";
+    for (uint32_t i = 0; i < state.names.size(); i++)
+    {
+        const Counters& counters = state.stats[i];
+        if (counters.executed == 0)
+        {
+            continue;
+        }
+        os << state.names[i] << "," << counters.executed << "," << counters.misses << ","
+           << counters.GetMeanLateness().GetMicroSeconds() << ","
+           << counters.maxLateness.GetMicroSeconds() << "," << GetBudget(i).GetMicroSeconds()
+           << "\n";
+    }
+}
+
+} // namespace lrwpan
+} // namespace ns3
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef RIT_REALTIME_MONITOR_H
+#define RIT_REALTIME_MONITOR_H
+
+#include "ns3/nstime.h"
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @ingroup lr-wpan
+ *
+ * @brief Opt-in, process-wide lateness of the RIT timers against the wall clock, for runs
+ * on RealtimeSimulatorImpl (emulation against real devices).
+ *
+ * The instrumented handlers (the RIT MAC timers, e.g. PeriodicRitDataRequest, and the ACK
+ * turnaround of a received data frame) report the simulated time they were due; the
+ * lateness is how far the wall clock of the real-time scheduler is past it when the
+ * handler runs. A handler late by more than its budget is a deadline miss: it is counted,
+ * logged, and aborts the run if AbortOnMiss is set, so a hot path over its budget cannot
+ * go unnoticed. With another simulator implementation, or when the monitor is disabled
+ * (the default), nothing is recorded and every report is a test of one static flag.
+ */
+class RitRealtimeMonitor
+{
+  public:
+    /**
+     * Counters of one handler.
+     */
+    struct Counters
+    {
+        uint64_t executed = 0; //!< Executions recorded
+        uint64_t misses = 0;   //!< Executions later than the budget
+        Time totalLateness;    //!< Sum of the lateness
+        Time maxLateness;      //!< Largest lateness
+
+        /**
+         * @return the mean lateness, zero without execution
+         */
+        Time GetMeanLateness() const;
+    };
+
+    /**
+     * @brief Start recording (the counters are kept, see Reset()).
+     */
+    static void Enable();
+
+    /**
+     * @brief Stop recording.
+     */
+    static void Disable();
+
+    /**
+     * @return true if the lateness is recorded
+     */
+    static bool IsEnabled()
+    {
+        return s_enabled;
+    }
+
+    /**
+     * @brief Clear every counter; the handlers and their budgets are kept.
+     */
+    static void Reset();
+
+    /**
+     * @brief Get the id of a handler, registering its name the first time.
+     * @param name Handler name, e.g. "RitWpanMac::PeriodicRitDataRequest"
+     * @param budget Budget of the handler, the default budget if zero
+     * @return the handler id
+     */
+    static uint32_t RegisterHandler(const std::string& name, Time budget = Time());
+
+    /**
+     * @brief Set the lateness budget of a handler, registering it if needed.
+     * @param name Handler name
+     * @param budget Largest lateness that is not a miss
+     */
+    static void SetBudget(const std::string& name, Time budget);
+
+    /**
+     * @brief Set the budget of the handlers registered without one (1 ms by default).
+     * @param budget Largest lateness that is not a miss
+     */
+    static void SetDefaultBudget(Time budget);
+
+    /**
+     * @brief Whether a deadline miss aborts the run (false by default).
+     * @param abort true to abort at the first miss
+     */
+    static void SetAbortOnMiss(bool abort);
+
+    /**
+     * @brief Record an execution of a handler due at a simulated time.
+     * @param handler Handler id
+     * @param deadline Simulated time the handler was due
+     */
+    static void RecordLateness(uint32_t handler, Time deadline)
+    {
+        if (s_enabled)
+        {
+            DoRecordLateness(handler, deadline);
+        }
+    }
+
+    /**
+     * @brief Get the counters of a handler.
+     * @param name Handler name
+     * @return the counters, all zero if the handler never ran late or on time
+     */
+    static Counters GetCounters(const std::string& name);
+
+    /**
+     * @brief Get the deadline misses of every handler.
+     * @return the number of misses
+     */
+    static uint64_t GetNMisses();
+
+    /**
+     * @brief Write one line per handler recorded:
+     * handler,executed,misses,mean_us,max_us,budget_us
+     * @param os The output stream
+     */
+    static void WriteTable(std::ostream& os);
+
+  private:
+    /**
+     * @brief Record an execution in real-time mode.
+     * @param handler Handler id
+     * @param deadline Simulated time the handler was due
+     */
+    static void DoRecordLateness(uint32_t handler, Time deadline);
+
+    static bool s_enabled; //!< Whether the lateness is recorded
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // RIT_REALTIME_MONITOR_H
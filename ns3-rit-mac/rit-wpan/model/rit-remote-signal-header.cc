@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-remote-signal-header.h"
+
+#include "ns3/abort.h"
+
+#include <cstring>
+#include <limits>
+#include <ostream>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+void
+RitRemoteSignalHeader::SetTransmitter(uint32_t nodeId, uint32_t ifIndex)
+{
+    m_nodeId = nodeId;
+    m_ifIndex = ifIndex;
+}
+
+uint32_t
+RitRemoteSignalHeader::GetNodeId() const
+{
+    return m_nodeId;
+}
+
+uint32_t
+RitRemoteSignalHeader::GetIfIndex() const
+{
+    return m_ifIndex;
+}
+
+void
+RitRemoteSignalHeader::SetTxChannel(uint8_t channel)
+{
+    m_txChannel = channel;
+}
+
+uint8_t
+RitRemoteSignalHeader::GetTxChannel() const
+{
+    return m_txChannel;
+}
+
+void
+RitRemoteSignalHeader::SetDuration(Time duration)
+{
+    m_duration = duration;
+}
+
+Time
+RitRemoteSignalHeader::GetDuration() const
+{
+    return m_duration;
+}
+
+void
+RitRemoteSignalHeader::SetPsd(Ptr<const SpectrumValue> psd)
+{
+    NS_ABORT_MSG_IF(psd->GetValuesN() > std::numeric_limits<uint16_t>::max(),
+                    "PSD of " << psd->GetValuesN() << " bins too large");
+    m_nBins = static_cast<uint16_t>(psd->GetValuesN());
+    m_psd.clear();
+    for (uint16_t i = 0; i < m_nBins; i++)
+    {
+        const double value = (*psd)[i];
+        if (value != 0.0)
+        {
+            m_psd.emplace_back(i, value);
+        }
+    }
+}
+
+Ptr<SpectrumValue>
+RitRemoteSignalHeader::GetPsd(Ptr<const SpectrumModel> model) const
+{
+    NS_ABORT_MSG_IF(model->GetNumBands() != m_nBins,
+                    "Spectrum model of " << model->GetNumBands() << " bins for a PSD of "
+                                         << m_nBins);
+    Ptr<SpectrumValue> psd = Create<SpectrumValue>(model);
+    for (const auto& [bin, value] : m_psd)
+    {
+        (*psd)[bin] = value;
+    }
+    return psd;
+}
+
+TypeId
+RitRemoteSignalHeader::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::lrwpan::RitRemoteSignalHeader")
+                            .SetParent<Header>()
+                            .SetGroupName("LrWpan")
+                            .AddConstructor<RitRemoteSignalHeader>();
+    return tid;
+}
+
+TypeId
+RitRemoteSignalHeader::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+void
+RitRemoteSignalHeader::Serialize(Buffer::Iterator start) const
+{
+    start.WriteHtonU32(m_nodeId);
+    start.WriteHtonU32(m_ifIndex);
+    start.WriteU8(m_txChannel);
+    start.WriteHtonU64(static_cast<uint64_t>(m_duration.GetTimeStep()));
+    start.WriteHtonU16(m_nBins);
+    start.WriteHtonU16(static_cast<uint16_t>(m_psd.size()));
+    for (const auto& [bin, value] : m_psd)
+    {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        start.WriteHtonU16(bin);
+        start.WriteHtonU64(bits);
+    }
+}
+
+uint32_t
+RitRemoteSignalHeader::Deserialize(Buffer::Iterator start)
+{
+    Buffer::Iterator i = start;
+    m_nodeId = i.ReadNtohU32();
+    m_ifIndex = i.ReadNtohU32();
+    m_txChannel = i.ReadU8();
+    m_duration = TimeStep(static_cast<int64_t>(i.ReadNtohU64()));
+    m_nBins = i.ReadNtohU16();
+    const uint16_t nValues = i.ReadNtohU16();
+    m_psd.clear();
+    for (uint16_t k = 0; k < nValues; k++)
+    {
+        const uint16_t bin = i.ReadNtohU16();
+        const uint64_t bits = i.ReadNtohU64();
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        m_psd.emplace_back(bin, value);
+    }
+    return i.GetDistanceFrom(start);
+}
+
+uint32_t
+RitRemoteSignalHeader::GetSerializedSize() const
+{
+    return 21 + 10 * m_psd.size();
+}
+
+void
+RitRemoteSignalHeader::Print(std::ostream& os) const
+{
+    os << "RitRemoteSignalHeader: Node=" << m_nodeId << " IfIndex=" << m_ifIndex
+       << " Channel=" << static_cast<uint32_t>(m_txChannel) << " Duration=" << m_duration
+       << " Bins=" << m_nBins << " Nonzero=" << m_psd.size();
+}
+
+} // namespace lrwpan
+} // namespace ns3
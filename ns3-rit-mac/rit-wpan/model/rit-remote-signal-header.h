@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef NS3_LRWPAN_RIT_REMOTE_SIGNAL_HEADER_H
+#define NS3_LRWPAN_RIT_REMOTE_SIGNAL_HEADER_H
+
+#include "ns3/header.h"
+#include "ns3/nstime.h"
+#include "ns3/spectrum-value.h"
+
+#include <cstdint>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @ingroup lrwpan
+ *
+ * @brief Signal of a LrWpanPhy handed over to the process simulating another region
+ *        of a LrWpanSpectrumChannel, ahead of the frame it carries.
+ *
+ * The receiving process holds a copy of the transmitting PHY (the device of the same
+ * node and interface index) and rebuilds the signal parameters from it: the PSD is
+ * given on the spectrum model of the copy, which must have as many bins.
+ *
+ * Layout:
+ *  - 4 bytes: node id of the transmitter
+ *  - 4 bytes: interface index of its device
+ *  - 1 byte: channel number the frame is sent on
+ *  - 8 bytes: duration of the signal, in time steps
+ *  - 2 bytes: number of bins of the PSD
+ *  - 2 bytes: number of nonzero bins, then for each of those
+ *    - 2 bytes: bin index
+ *    - 8 bytes: value (IEEE 754 double) [W/Hz]
+ */
+class RitRemoteSignalHeader : public Header
+{
+  public:
+    RitRemoteSignalHeader() = default;
+    ~RitRemoteSignalHeader() override = default;
+
+    /**
+     * @brief Set the device of the transmitter.
+     * @param nodeId Node id
+     * @param ifIndex Interface index of the device on the node
+     */
+    void SetTransmitter(uint32_t nodeId, uint32_t ifIndex);
+
+    /**
+     * @brief Return the node id of the transmitter.
+     */
+    uint32_t GetNodeId() const;
+
+    /**
+     * @brief Return the interface index of the device of the transmitter.
+     */
+    uint32_t GetIfIndex() const;
+
+    /**
+     * @brief Set the channel number the frame is sent on.
+     * @param channel Channel number
+     */
+    void SetTxChannel(uint8_t channel);
+
+    /**
+     * @brief Return the channel number the frame is sent on.
+     */
+    uint8_t GetTxChannel() const;
+
+    /**
+     * @brief Set the duration of the signal.
+     * @param duration Duration
+     */
+    void SetDuration(Time duration);
+
+    /**
+     * @brief Return the duration of the signal.
+     */
+    Time GetDuration() const;
+
+    /**
+     * @brief Set the transmitted PSD (only its nonzero bins are carried).
+     * @param psd PSD
+     */
+    void SetPsd(Ptr<const SpectrumValue> psd);
+
+    /**
+     * @brief Return the transmitted PSD on a spectrum model.
+     * @param model Spectrum model with the number of bins of the PSD that was set
+     * @return a new PSD
+     */
+    Ptr<SpectrumValue> GetPsd(Ptr<const SpectrumModel> model) const;
+
+    // ns-3 Header API
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override;
+    void Serialize(Buffer::Iterator start) const override;
+    uint32_t Deserialize(Buffer::Iterator start) override;
+    uint32_t GetSerializedSize() const override;
+    void Print(std::ostream& os) const override;
+
+  private:
+    uint32_t m_nodeId{0};                           //!< Node of the transmitter
+    uint32_t m_ifIndex{0};                          //!< Device of the transmitter
+    uint8_t m_txChannel{0};                         //!< Channel number of the frame
+    Time m_duration;                                //!< Duration of the signal
+    uint16_t m_nBins{0};                            //!< Bins of the PSD
+    std::vector<std::pair<uint16_t, double>> m_psd; //!< Nonzero bins of the PSD
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // NS3_LRWPAN_RIT_REMOTE_SIGNAL_HEADER_H
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-route-header.h"
+
+#include "ns3/address-utils.h"
+#include "ns3/assert.h"
+
+#include <ostream>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+void
+RitRouteHeader::AddAddress(Mac16Address addr)
+{
+    NS_ASSERT(m_addresses.size() < MAX_ADDRESSES);
+    m_addresses.push_back(addr);
+}
+
+uint8_t
+RitRouteHeader::GetNAddresses() const
+{
+    return static_cast<uint8_t>(m_addresses.size());
+}
+
+Mac16Address
+RitRouteHeader::GetAddress(uint8_t index) const
+{
+    NS_ASSERT(index < m_addresses.size());
+    return m_addresses[index];
+}
+
+void
+RitRouteHeader::SetIndex(uint8_t index)
+{
+    NS_ASSERT(index <= m_addresses.size());
+    m_index = index;
+}
+
+uint8_t
+RitRouteHeader::GetIndex() const
+{
+    return m_index;
+}
+
+TypeId
+RitRouteHeader::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::lrwpan::RitRouteHeader")
+                            .SetParent<Header>()
+                            .SetGroupName("LrWpan")
+                            .AddConstructor<RitRouteHeader>();
+    return tid;
+}
+
+TypeId
+RitRouteHeader::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+void
+RitRouteHeader::Serialize(Buffer::Iterator start) const
+{
+    start.WriteU8(static_cast<uint8_t>(GetNAddresses() << 4) | m_index);
+    for (const Mac16Address& addr : m_addresses)
+    {
+        WriteTo(start, addr);
+    }
+}
+
+uint32_t
+RitRouteHeader::Deserialize(Buffer::Iterator start)
+{
+    Buffer::Iterator i = start;
+    const uint8_t word = i.ReadU8();
+    m_addresses.resize(word >> 4);
+    m_index = word & 0x0f;
+    for (auto& addr : m_addresses)
+    {
+        ReadFrom(i, addr);
+    }
+    return i.GetDistanceFrom(start);
+}
+
+uint32_t
+RitRouteHeader::GetSerializedSize() const
+{
+    return 1 + 2 * m_addresses.size();
+}
+
+void
+RitRouteHeader::Print(std::ostream& os) const
+{
+    os << "RitRouteHeader: Index=" << static_cast<uint32_t>(m_index) << " [";
+    for (size_t k = 0; k < m_addresses.size(); k++)
+    {
+        os << (k ? " " : "") << m_addresses[k];
+    }
+    os << "]";
+}
+
+} // namespace lrwpan
+} // namespace ns3
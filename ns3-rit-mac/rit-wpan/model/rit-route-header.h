@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef NS3_LRWPAN_RIT_ROUTE_HEADER_H
+#define NS3_LRWPAN_RIT_ROUTE_HEADER_H
+
+#include "ns3/header.h"
+#include "ns3/mac16-address.h"
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @ingroup lrwpan
+ *
+ * @brief Address list following a RitNwkHeader with a route option.
+ *
+ * With RitNwkHeader::OPTION_SOURCE_ROUTE the list holds the relays from the
+ * sink to the destination (the destination itself excluded) and the index is
+ * the next relay to visit. With RitNwkHeader::OPTION_ROUTE_REPORT it holds the
+ * reporting node and its parent.
+ *
+ * Layout:
+ *  - 1 byte: number of addresses N (high nibble) and index (low nibble)
+ *  - N x 2 bytes: short addresses, in order
+ */
+class RitRouteHeader : public Header
+{
+  public:
+    RitRouteHeader() = default;
+    ~RitRouteHeader() override = default;
+
+    static constexpr uint8_t MAX_ADDRESSES = 15; //!< Longest address list
+
+    /**
+     * @brief Append an address to the list.
+     * @param addr Short address
+     */
+    void AddAddress(Mac16Address addr);
+
+    /**
+     * @brief Return the number of addresses.
+     */
+    uint8_t GetNAddresses() const;
+
+    /**
+     * @brief Return an address of the list.
+     * @param index Position in the list
+     */
+    Mac16Address GetAddress(uint8_t index) const;
+
+    /**
+     * @brief Set the position of the next relay.
+     * @param index Position, up to the number of addresses
+     */
+    void SetIndex(uint8_t index);
+
+    /**
+     * @brief Return the position of the next relay.
+     */
+    uint8_t GetIndex() const;
+
+    // ns-3 Header API
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override;
+    void Serialize(Buffer::Iterator start) const override;
+    uint32_t Deserialize(Buffer::Iterator start) override;
+    uint32_t GetSerializedSize() const override;
+    void Print(std::ostream& os) const override;
+
+  private:
+    std::vector<Mac16Address> m_addresses; //!< Addresses, in order
+    uint8_t m_index{0};                    //!< Position of the next relay
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // NS3_LRWPAN_RIT_ROUTE_HEADER_H
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-run-arena.h"
+
+#include "ns3/log.h"
+
+#include <optional>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_LOG_COMPONENT_DEFINE("RitRunArena");
+
+namespace
+{
+
+/**
+ * @brief Monotonic arena counting its live blocks, released when the last one is freed
+ *        once it no longer serves new objects.
+ *
+ * The objects created while it was open keep allocating from it: a released arena
+ * starts over with new chunks.
+ */
+class CountingArena : public std::pmr::memory_resource
+{
+  public:
+    /**
+     * @param chunkBytes Size of the first chunk
+     */
+    void Open(std::size_t chunkBytes)
+    {
+        m_chunkBytes = chunkBytes;
+        m_open = true;
+    }
+
+    /** @brief Serve no new object, release once the live blocks are freed. */
+    void Close()
+    {
+        m_open = false;
+        ReleaseIfUnused();
+    }
+
+    bool m_open{false};          //!< Serving new objects
+    bool m_bulkTeardown{false};  //!< A bulk teardown is under way
+    uint64_t m_nBytes{0};        //!< Bytes allocated since the last release
+    uint64_t m_nLive{0};         //!< Blocks not freed yet
+    uint64_t m_nReleases{0};     //!< Releases of the arena
+    std::size_t m_chunkBytes{0}; //!< Size of the first chunk of an arena
+
+  private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        if (!m_arena)
+        {
+            m_arena.emplace(m_chunkBytes, std::pmr::new_delete_resource());
+        }
+        m_nLive++;
+        m_nBytes += bytes;
+        return m_arena->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+    {
+        NS_ASSERT(m_nLive > 0);
+        m_nLive--;
+        ReleaseIfUnused();
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    /** @brief Give the chunks back to the heap if no block is live after Close(). */
+    void ReleaseIfUnused()
+    {
+        if (!m_open && m_nLive == 0 && m_arena)
+        {
+            NS_LOG_DEBUG("Releasing the arena after " << m_nBytes << " bytes");
+            m_arena.reset();
+            m_nBytes = 0;
+            m_nReleases++;
+        }
+    }
+
+    std::optional<std::pmr::monotonic_buffer_resource> m_arena; //!< The chunks, if any
+};
+
+/**
+ * @return the arena, never destroyed so that objects outliving the statics still free
+ *         their blocks in it
+ */
+CountingArena&
+Arena()
+{
+    static CountingArena* arena = new CountingArena;
+    return *arena;
+}
+
+} // namespace
+
+void
+RitRunArena::Enable(std::size_t chunkBytes)
+{
+    NS_LOG_FUNCTION(chunkBytes);
+    NS_ASSERT(chunkBytes > 0);
+    Arena().Open(chunkBytes);
+}
+
+void
+RitRunArena::Disable()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    Arena().Close();
+}
+
+bool
+RitRunArena::IsEnabled()
+{
+    return Arena().m_open;
+}
+
+std::pmr::memory_resource*
+RitRunArena::GetResource()
+{
+    CountingArena& arena = Arena();
+    return arena.m_open ? static_cast<std::pmr::memory_resource*>(&arena)
+                        : std::pmr::new_delete_resource();
+}
+
+uint64_t
+RitRunArena::GetNBytes()
+{
+    return Arena().m_nBytes;
+}
+
+uint64_t
+RitRunArena::GetNLiveBlocks()
+{
+    return Arena().m_nLive;
+}
+
+uint64_t
+RitRunArena::GetNReleases()
+{
+    return Arena().m_nReleases;
+}
+
+void
+RitRunArena::BeginBulkTeardown()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    Arena().m_bulkTeardown = true;
+}
+
+void
+RitRunArena::EndBulkTeardown()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    Arena().m_bulkTeardown = false;
+}
+
+bool
+RitRunArena::IsBulkTeardown()
+{
+    return Arena().m_bulkTeardown;
+}
+
+} // namespace lrwpan
+} // namespace ns3
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef RIT_RUN_ARENA_H
+#define RIT_RUN_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @ingroup lr-wpan
+ *
+ * @brief Per-run arena of the auxiliary allocations of the rit-wpan objects, and the
+ *        bulk teardown of a whole network.
+ *
+ * The neighbour tables, NWK transmit slots, duplicate caches, MAC timer sets, queue
+ * bookkeeping and hop latency records take their memory from GetResource(). It is the
+ * heap by default; between Enable() and Disable(), the objects created take it from a
+ * monotonic arena instead: allocations are carved out of large chunks and freeing them
+ * costs nothing. The chunks go back to the heap at once when the last block of the
+ * arena is freed after Disable(), i.e. when the objects of the run are gone.
+ *
+ * During a bulk teardown (BeginBulkTeardown() to EndBulkTeardown(), see
+ * RitWpanNetHelper::Destroy()), the DoDispose() of the rit-wpan objects skip what only
+ * unwinds state the whole network drops anyway: cancelling their timers one by one,
+ * emptying their containers and unregistering from the other nodes.
+ *
+ * The arena is not thread-safe: the objects using it belong to the simulation thread.
+ */
+class RitRunArena
+{
+  public:
+    /**
+     * @brief Take the allocations of the objects created from now on from the arena.
+     * @param chunkBytes Size of the first chunk of a new arena [bytes]
+     */
+    static void Enable(std::size_t chunkBytes = 64 * 1024);
+
+    /**
+     * @brief Take the allocations of the objects created from now on from the heap; the
+     *        arena is released when its last block is freed.
+     */
+    static void Disable();
+
+    /**
+     * @return true between Enable() and Disable()
+     */
+    static bool IsEnabled();
+
+    /**
+     * @return the memory resource of the objects created now
+     */
+    static std::pmr::memory_resource* GetResource();
+
+    /**
+     * @return the bytes allocated from the arena since it was last released
+     */
+    static uint64_t GetNBytes();
+
+    /**
+     * @return the blocks of the arena not freed yet
+     */
+    static uint64_t GetNLiveBlocks();
+
+    /**
+     * @return the times the arena was released
+     */
+    static uint64_t GetNReleases();
+
+    /** @brief Announce that every rit-wpan object is about to be disposed. */
+    static void BeginBulkTeardown();
+
+    /** @brief End the bulk teardown. */
+    static void EndBulkTeardown();
+
+    /**
+     * @return true during a bulk teardown
+     */
+    static bool IsBulkTeardown();
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // RIT_RUN_ARENA_H
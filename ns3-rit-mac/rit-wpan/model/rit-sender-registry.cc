@@ -0,0 +1,365 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-sender-registry.h"
+
+#include "ns3/log.h"
+#include "ns3/lr-wpan-phy.h"
+#include "ns3/lr-wpan-spectrum-channel.h"
+#include "ns3/spectrum-phy.h"
+
+#include <algorithm>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_LOG_COMPONENT_DEFINE("RitSenderRegistry");
+
+NS_OBJECT_ENSURE_REGISTERED(RitSenderRegistry);
+
+TypeId
+RitSenderRegistry::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::lrwpan::RitSenderRegistry")
+                            .SetParent<Object>()
+                            .SetGroupName("LrWpan")
+                            .AddConstructor<RitSenderRegistry>();
+    return tid;
+}
+
+RitSenderRegistry::RitSenderRegistry()
+    : m_channel(nullptr),
+      m_nUnlisted(0),
+      m_listChanges(0),
+      m_nextWatchId(0)
+{
+}
+
+RitSenderRegistry::~RitSenderRegistry()
+{
+}
+
+void
+RitSenderRegistry::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    for (const auto& phy : m_hooked)
+    {
+        phy->SetWakeCallback(MakeNullCallback<void, Ptr<LrWpanPhy>>());
+    }
+    m_hooked.clear();
+    m_watches.clear();
+    m_watchIds.clear();
+    m_watchers.clear();
+    if (m_channel)
+    {
+        m_channel->SetReceiverListChangeCallback(MakeNullCallback<void>());
+    }
+    m_senders.clear();
+    m_coverage.clear();
+    m_nUnlisted = 0;
+    m_channel = nullptr;
+    Object::DoDispose();
+}
+
+Ptr<RitSenderRegistry>
+RitSenderRegistry::Get(Ptr<LrWpanSpectrumChannel> channel)
+{
+    Ptr<RitSenderRegistry> registry = channel->GetObject<RitSenderRegistry>();
+    if (!registry)
+    {
+        registry = CreateObject<RitSenderRegistry>();
+        // A raw pointer: the aggregation already ties the two lifetimes
+        registry->m_channel = PeekPointer(channel);
+        registry->m_listChanges = channel->GetNReceiverListChanges();
+        channel->SetReceiverListChangeCallback(
+            MakeCallback(&RitSenderRegistry::NotifyListChange, PeekPointer(registry)));
+        channel->AggregateObject(registry);
+    }
+    return registry;
+}
+
+void
+RitSenderRegistry::Add(Ptr<const SpectrumPhy> sender)
+{
+    NS_LOG_FUNCTION(this << sender);
+    if (!m_channel)
+    {
+        return;
+    }
+    Sync();
+    auto it = m_senders.find(sender);
+    if (it != m_senders.end())
+    {
+        Uncover(it->second);
+    }
+    std::vector<const SpectrumPhy*>& reach = m_senders[sender];
+    Cover(sender, reach);
+
+    if (m_watches.empty())
+    {
+        return;
+    }
+    // The watched PHYs the sender reaches, or all of them if it may be anywhere.
+    std::set<uint64_t> ids;
+    if (reach.empty())
+    {
+        for (const auto& [id, watched] : m_watches)
+        {
+            ids.insert(id);
+        }
+    }
+    for (const SpectrumPhy* phy : reach)
+    {
+        auto watchIt = m_watchIds.find(phy);
+        if (watchIt != m_watchIds.end())
+        {
+            ids.insert(watchIt->second);
+        }
+    }
+    WakeWatches(ids);
+}
+
+void
+RitSenderRegistry::Remove(Ptr<const SpectrumPhy> sender)
+{
+    NS_LOG_FUNCTION(this << sender);
+    auto it = m_senders.find(sender);
+    if (it == m_senders.end())
+    {
+        return;
+    }
+    Uncover(it->second);
+    m_senders.erase(it);
+}
+
+std::size_t
+RitSenderRegistry::GetNSenders() const
+{
+    return m_senders.size();
+}
+
+bool
+RitSenderRegistry::IsNearSender(Ptr<const SpectrumPhy> phy)
+{
+    Sync();
+    auto it = m_coverage.find(PeekPointer(phy));
+    return it != m_coverage.end() && it->second > 0;
+}
+
+bool
+RitSenderRegistry::HasUnlistedSenders()
+{
+    Sync();
+    return m_nUnlisted > 0;
+}
+
+bool
+RitSenderRegistry::Watch(Ptr<const LrWpanPhy> phy, WakeCallback wake)
+{
+    NS_LOG_FUNCTION(this << phy);
+    Unwatch(phy);
+    if (!m_channel || HasUnlistedSenders() || IsNearSender(phy))
+    {
+        return false;
+    }
+
+    std::vector<Ptr<SpectrumPhy>> receivers;
+    std::vector<Ptr<const SpectrumPhy>> transmitters;
+    if (!m_channel->GetListedReceivers(phy, receivers) ||
+        !m_channel->GetListingTransmitters(phy, transmitters))
+    {
+        return false;
+    }
+    std::vector<Ptr<const SpectrumPhy>> candidates(receivers.begin(), receivers.end());
+    candidates.insert(candidates.end(), transmitters.begin(), transmitters.end());
+
+    std::set<Ptr<LrWpanPhy>> around;
+    for (const auto& other : candidates)
+    {
+        if (PeekPointer(other) == PeekPointer(phy))
+        {
+            continue;
+        }
+        Ptr<LrWpanPhy> otherPhy = DynamicCast<LrWpanPhy>(ConstCast<SpectrumPhy>(other));
+        if (!otherPhy || !otherPhy->IsQuiescent() || otherPhy->IsRxDropTraced())
+        {
+            return false;
+        }
+        around.insert(otherPhy);
+    }
+
+    const uint64_t id = m_nextWatchId++;
+    Watched& watched = m_watches[id];
+    watched.phy = PeekPointer(phy);
+    watched.wake = wake;
+    for (const auto& otherPhy : around)
+    {
+        if (m_hooked.insert(otherPhy).second)
+        {
+            otherPhy->SetWakeCallback(MakeCallback(&RitSenderRegistry::NotifyWake, this));
+        }
+        watched.around.push_back(PeekPointer(otherPhy));
+        m_watchers[PeekPointer(otherPhy)].push_back(id);
+    }
+    m_watchIds[PeekPointer(phy)] = id;
+    return true;
+}
+
+void
+RitSenderRegistry::Unwatch(Ptr<const LrWpanPhy> phy)
+{
+    auto idIt = m_watchIds.find(PeekPointer(phy));
+    if (idIt == m_watchIds.end())
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this << phy);
+    const uint64_t id = idIt->second;
+    m_watchIds.erase(idIt);
+    auto watchIt = m_watches.find(id);
+    for (const SpectrumPhy* other : watchIt->second.around)
+    {
+        auto it = m_watchers.find(other);
+        std::vector<uint64_t>& ids = it->second;
+        ids.erase(std::find(ids.begin(), ids.end(), id));
+        if (ids.empty())
+        {
+            m_watchers.erase(it);
+        }
+    }
+    m_watches.erase(watchIt);
+}
+
+std::size_t
+RitSenderRegistry::GetNWatches() const
+{
+    return m_watches.size();
+}
+
+void
+RitSenderRegistry::NotifyWake(Ptr<LrWpanPhy> phy)
+{
+    auto it = m_watchers.find(PeekPointer(phy));
+    if (it == m_watchers.end())
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this << phy);
+    // A callback may end its watch or others: go through a copy.
+    const std::vector<uint64_t> ids = it->second;
+    for (uint64_t id : ids)
+    {
+        auto watchIt = m_watches.find(id);
+        if (watchIt != m_watches.end())
+        {
+            // A copy too: the callback may end the watch holding it.
+            WakeCallback wake = watchIt->second.wake;
+            wake(phy);
+        }
+    }
+}
+
+void
+RitSenderRegistry::NotifyListChange()
+{
+    if (m_watches.empty())
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this);
+    std::set<uint64_t> ids;
+    for (const auto& [id, watched] : m_watches)
+    {
+        ids.insert(id);
+    }
+    WakeWatches(ids);
+}
+
+void
+RitSenderRegistry::WakeWatches(const std::set<uint64_t>& ids)
+{
+    for (uint64_t id : ids)
+    {
+        auto watchIt = m_watches.find(id);
+        if (watchIt != m_watches.end())
+        {
+            WakeCallback wake = watchIt->second.wake;
+            wake(nullptr);
+        }
+    }
+}
+
+void
+RitSenderRegistry::Cover(Ptr<const SpectrumPhy> sender, std::vector<const SpectrumPhy*>& reach)
+{
+    reach.clear();
+    std::vector<Ptr<SpectrumPhy>> receivers;
+    if (!m_channel->GetListedReceivers(sender, receivers))
+    {
+        m_nUnlisted++;
+        return;
+    }
+    reach.push_back(PeekPointer(sender));
+    for (const auto& rxPhy : receivers)
+    {
+        // the channel lists the transmitter too
+        if (rxPhy != sender)
+        {
+            reach.push_back(PeekPointer(rxPhy));
+        }
+    }
+    for (const SpectrumPhy* phy : reach)
+    {
+        m_coverage[phy]++;
+    }
+}
+
+void
+RitSenderRegistry::Uncover(const std::vector<const SpectrumPhy*>& reach)
+{
+    if (reach.empty())
+    {
+        NS_ASSERT(m_nUnlisted > 0);
+        m_nUnlisted--;
+        return;
+    }
+    for (const SpectrumPhy* phy : reach)
+    {
+        auto it = m_coverage.find(phy);
+        NS_ASSERT(it != m_coverage.end() && it->second > 0);
+        if (--it->second == 0)
+        {
+            m_coverage.erase(it);
+        }
+    }
+}
+
+void
+RitSenderRegistry::Sync()
+{
+    if (!m_channel || m_channel->GetNReceiverListChanges() == m_listChanges)
+    {
+        return;
+    }
+    // Lists change on the first transmissions and after topology changes, so this
+    // stays rare in a steady state; it costs the senders times their receivers.
+    NS_LOG_LOGIC("refreshing " << m_senders.size() << " sender lists");
+    m_listChanges = m_channel->GetNReceiverListChanges();
+    m_coverage.clear();
+    m_nUnlisted = 0;
+    for (auto& [sender, reach] : m_senders)
+    {
+        Cover(sender, reach);
+    }
+}
+
+} // namespace lrwpan
+} // namespace ns3
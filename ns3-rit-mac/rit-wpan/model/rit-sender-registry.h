@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef RIT_SENDER_REGISTRY_H
+#define RIT_SENDER_REGISTRY_H
+
+#include "ns3/callback.h"
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+class SpectrumPhy;
+
+namespace lrwpan
+{
+
+class LrWpanPhy;
+class LrWpanSpectrumChannel;
+
+/**
+ * @ingroup lr-wpan
+ *
+ * @brief The RIT senders of one LrWpanSpectrumChannel and the PHYs they can reach.
+ *
+ * The registry is aggregated to its channel, so it lives and dies with the channel
+ * (and with the run) and two channels never see each other's senders. Each sender
+ * is stored with a copy of its receiver list, and every listed PHY counts the
+ * senders reaching it: IsNearSender() is a lookup, whatever the number of nodes.
+ * The copies are refreshed when the channel reports a change to its lists. A sender
+ * without a list yet may reach any PHY, which HasUnlistedSenders() reports.
+ *
+ * A PHY with no sender around may be watched (Watch()) while its MAC skips an idle
+ * cycle: the registry calls it back as soon as one of the PHYs its frames reach, or
+ * whose frames reach it, leaves TRX_OFF, a sender reaching it registers, or the
+ * channel changes its lists.
+ *
+ * Only the simulator thread uses the registry (the channel workers compute path
+ * losses, not MAC events).
+ */
+class RitSenderRegistry : public Object
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    RitSenderRegistry();
+    ~RitSenderRegistry() override;
+
+    /**
+     * @brief Get the registry of a channel, aggregating one to it on the first call.
+     * @param channel The channel
+     * @return the registry of the channel
+     */
+    static Ptr<RitSenderRegistry> Get(Ptr<LrWpanSpectrumChannel> channel);
+
+    /**
+     * @brief Register a sender (again, if it is registered).
+     * @param sender The PHY of the sender
+     */
+    void Add(Ptr<const SpectrumPhy> sender);
+
+    /**
+     * @brief Unregister a sender, if it is registered.
+     * @param sender The PHY of the sender
+     */
+    void Remove(Ptr<const SpectrumPhy> sender);
+
+    /**
+     * @brief Get the number of registered senders.
+     * @return the number of senders
+     */
+    std::size_t GetNSenders() const;
+
+    /**
+     * @brief Whether a listed sender is, or reaches, a PHY.
+     * @param phy The PHY
+     * @return true if a sender with a receiver list is the PHY or lists it
+     */
+    bool IsNearSender(Ptr<const SpectrumPhy> phy);
+
+    /**
+     * @brief Whether a sender has no receiver list on the channel yet.
+     * @return true if a sender may reach any PHY
+     */
+    bool HasUnlistedSenders();
+
+    /**
+     * @brief Callback of a watched PHY: the PHY around it that wakes up, or null when
+     *        a sender reaching it registered or the lists of the channel changed.
+     */
+    typedef Callback<void, Ptr<SpectrumPhy>> WakeCallback;
+
+    /**
+     * @brief Watch a PHY (again, if it is watched). The PHYs around it are those listed
+     *        by its receiver list and those listing it; each must be a LrWpanPhy
+     *        quiescent in TRX_OFF with no PhyRxDrop sink.
+     * @param phy The PHY
+     * @param wake The callback
+     * @return false (and the PHY is not watched) if a sender is near the PHY or may be
+     *         anywhere, if the lists do not tell the PHYs around it, or if one of them
+     *         is not quiescent
+     */
+    bool Watch(Ptr<const LrWpanPhy> phy, WakeCallback wake);
+
+    /**
+     * @brief Stop watching a PHY, if it is watched.
+     * @param phy The PHY
+     */
+    void Unwatch(Ptr<const LrWpanPhy> phy);
+
+    /**
+     * @brief Get the number of watched PHYs.
+     * @return the number of watches
+     */
+    std::size_t GetNWatches() const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /**
+     * @brief Copy the receiver list of a sender and count it in the PHYs it reaches.
+     * @param sender The PHY of the sender
+     * @param reach Filled with the PHYs reached, empty if the sender has no list
+     */
+    void Cover(Ptr<const SpectrumPhy> sender, std::vector<const SpectrumPhy*>& reach);
+
+    /**
+     * @brief Uncount a sender from the PHYs it reaches.
+     * @param reach The PHYs reached, empty if the sender had no list
+     */
+    void Uncover(const std::vector<const SpectrumPhy*>& reach);
+
+    /**
+     * @brief Refresh the copies of the receiver lists after a change on the channel.
+     */
+    void Sync();
+
+    /**
+     * @brief Call back the watches of the PHYs around a PHY leaving TRX_OFF.
+     * @param phy The PHY
+     */
+    void NotifyWake(Ptr<LrWpanPhy> phy);
+
+    /**
+     * @brief Call back every watch after a change of the lists of the channel.
+     */
+    void NotifyListChange();
+
+    /**
+     * @brief Call back watches with a null PHY, in the order they were set.
+     * @param ids The watches
+     */
+    void WakeWatches(const std::set<uint64_t>& ids);
+
+    /**
+     * A watched PHY.
+     */
+    struct Watched
+    {
+        const SpectrumPhy* phy;                 //!< The PHY
+        WakeCallback wake;                      //!< Its callback
+        std::vector<const SpectrumPhy*> around; //!< The PHYs around it
+    };
+
+    LrWpanSpectrumChannel* m_channel; //!< Channel the registry is aggregated to
+    /// PHYs reached by each sender, the sender itself first (empty without a list)
+    std::map<Ptr<const SpectrumPhy>, std::vector<const SpectrumPhy*>> m_senders;
+    std::unordered_map<const SpectrumPhy*, uint32_t> m_coverage; //!< Senders reaching a PHY
+    uint32_t m_nUnlisted;   //!< Senders without a receiver list
+    uint64_t m_listChanges; //!< List changes of the channel at the last copy
+    std::map<uint64_t, Watched> m_watches;                      //!< Watches, by setting order
+    std::unordered_map<const SpectrumPhy*, uint64_t> m_watchIds; //!< Watch of a watched PHY
+    /// Watches each PHY is around, by setting order
+    std::unordered_map<const SpectrumPhy*, std::vector<uint64_t>> m_watchers;
+    std::set<Ptr<LrWpanPhy>> m_hooked; //!< PHYs whose wake callback is NotifyWake()
+    uint64_t m_nextWatchId;            //!< Id of the next watch
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // RIT_SENDER_REGISTRY_H
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-timestamp-tag.h"
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_OBJECT_ENSURE_REGISTERED(RitTimestampTag);
+
+TypeId
+RitTimestampTag::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::lrwpan::RitTimestampTag")
+                            .SetParent<Tag>()
+                            .SetGroupName("RitWpan")
+                            .AddConstructor<RitTimestampTag>();
+    return tid;
+}
+
+TypeId
+RitTimestampTag::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+RitTimestampTag::RitTimestampTag()
+{
+}
+
+RitTimestampTag::RitTimestampTag(Time timestamp)
+    : m_timestamp(timestamp)
+{
+}
+
+uint32_t
+RitTimestampTag::GetSerializedSize() const
+{
+    return sizeof(int64_t);
+}
+
+void
+RitTimestampTag::Serialize(TagBuffer i) const
+{
+    i.WriteU64(m_timestamp.GetTimeStep());
+}
+
+void
+RitTimestampTag::Deserialize(TagBuffer i)
+{
+    m_timestamp = TimeStep(i.ReadU64());
+}
+
+void
+RitTimestampTag::Print(std::ostream& os) const
+{
+    os << "Timestamp = " << m_timestamp.As(Time::S);
+}
+
+void
+RitTimestampTag::Set(Time timestamp)
+{
+    m_timestamp = timestamp;
+}
+
+Time
+RitTimestampTag::Get() const
+{
+    return m_timestamp;
+}
+
+} // namespace lrwpan
+} // namespace ns3
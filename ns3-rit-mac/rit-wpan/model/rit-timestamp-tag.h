@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef RIT_TIMESTAMP_TAG_H
+#define RIT_TIMESTAMP_TAG_H
+
+#include "ns3/nstime.h"
+#include "ns3/tag.h"
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @ingroup lr-wpan
+ * Represent the generation time of an application packet.
+ *
+ * PeriodicSender and RandomSender add this packet tag to every packet they
+ * send, so that the receiving application can compute the end-to-end delay
+ * without changing the payload size.
+ */
+class RitTimestampTag : public Tag
+{
+  public:
+    /**
+     * Get the type ID.
+     *
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    TypeId GetInstanceTypeId() const override;
+
+    /**
+     * Create a RitTimestampTag with a zero timestamp.
+     */
+    RitTimestampTag();
+
+    /**
+     * Create a RitTimestampTag with the given timestamp.
+     * @param timestamp The generation time.
+     */
+    RitTimestampTag(Time timestamp);
+
+    uint32_t GetSerializedSize() const override;
+    void Serialize(TagBuffer i) const override;
+    void Deserialize(TagBuffer i) override;
+    void Print(std::ostream& os) const override;
+
+    /**
+     * Set the timestamp.
+     *
+     * @param timestamp the generation time
+     */
+    void Set(Time timestamp);
+
+    /**
+     * Get the timestamp.
+     *
+     * @return the generation time
+     */
+    Time Get() const;
+
+  private:
+    /**
+     * The generation time of the packet.
+     */
+    Time m_timestamp;
+};
+
+} // namespace lrwpan
+} // namespace ns3
+#endif /* RIT_TIMESTAMP_TAG_H */
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-wpan-energy-model.h"
+
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_LOG_COMPONENT_DEFINE("RitWpanEnergyModel");
+NS_OBJECT_ENSURE_REGISTERED(RitWpanEnergyModel);
+
+TypeId
+RitWpanEnergyModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::lrwpan::RitWpanEnergyModel")
+            .SetParent<Object>()
+            .SetGroupName("RitWpan")
+            .AddConstructor<RitWpanEnergyModel>()
+            .AddAttribute("SupplyVoltage",
+                          "The supply voltage [V].",
+                          DoubleValue(3.0),
+                          MakeDoubleAccessor(&RitWpanEnergyModel::m_supplyVoltage),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("TrxOffCurrent",
+                          "The current draw in TRX_OFF (sleep) [A].",
+                          DoubleValue(1.3e-6),
+                          MakeDoubleAccessor(&RitWpanEnergyModel::m_trxOffCurrent),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("RxOnCurrent",
+                          "The current draw in RX_ON (idle listening) [A].",
+                          DoubleValue(20e-3),
+                          MakeDoubleAccessor(&RitWpanEnergyModel::m_rxOnCurrent),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("BusyRxCurrent",
+                          "The current draw in BUSY_RX [A].",
+                          DoubleValue(20e-3),
+                          MakeDoubleAccessor(&RitWpanEnergyModel::m_busyRxCurrent),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("TxOnCurrent",
+                          "The current draw in TX_ON (ready to transmit) [A].",
+                          DoubleValue(20e-3),
+                          MakeDoubleAccessor(&RitWpanEnergyModel::m_txOnCurrent),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("BusyTxCurrent",
+                          "The current draw in BUSY_TX [A].",
+                          DoubleValue(24e-3),
+                          MakeDoubleAccessor(&RitWpanEnergyModel::m_busyTxCurrent),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("InitialEnergy",
+                          "The battery capacity [J]. Zero means unlimited.",
+                          DoubleValue(0.0),
+                          MakeDoubleAccessor(&RitWpanEnergyModel::m_initialEnergy),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("UpdateInterval",
+                          "The interval of the periodic energy report and depletion check. "
+                          "Zero disables the periodic update.",
+                          TimeValue(Seconds(60)),
+                          MakeTimeAccessor(&RitWpanEnergyModel::m_updateInterval),
+                          MakeTimeChecker(Seconds(0)));
+    return tid;
+}
+
+RitWpanEnergyModel::RitWpanEnergyModel()
+{
+    NS_LOG_FUNCTION(this);
+    m_lastUpdateEnergy = 0.0;
+    m_depletionTime = Time::Max();
+}
+
+RitWpanEnergyModel::~RitWpanEnergyModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+RitWpanEnergyModel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_updateEvent.Cancel();
+    m_energyUpdateCallback = MakeNullCallback<void, double>();
+    m_energyDepletedCallback = MakeNullCallback<void>();
+    m_phy = nullptr;
+    Object::DoDispose();
+}
+
+void
+RitWpanEnergyModel::SetPhy(Ptr<LrWpanPhy> phy)
+{
+    NS_LOG_FUNCTION(this << phy);
+    m_phy = phy;
+}
+
+void
+RitWpanEnergyModel::SetRadioProfile(RitRadioProfile profile)
+{
+    NS_LOG_FUNCTION(this << profile);
+    switch (profile)
+    {
+    case RIT_RADIO_CC2538:
+        m_trxOffCurrent = 1.3e-6;
+        m_rxOnCurrent = 20e-3;
+        m_busyRxCurrent = 20e-3;
+        m_txOnCurrent = 20e-3;
+        m_busyTxCurrent = 24e-3;
+        break;
+    case RIT_RADIO_AT86RF233:
+        m_trxOffCurrent = 0.2e-6;
+        m_rxOnCurrent = 11.8e-3;
+        m_busyRxCurrent = 11.8e-3;
+        m_txOnCurrent = 5.2e-3; // PLL_ON
+        m_busyTxCurrent = 13.8e-3;
+        break;
+    default:
+        NS_FATAL_ERROR("Unknown radio profile " << profile);
+    }
+}
+
+void
+RitWpanEnergyModel::SetEnergyUpdateCallback(RitEnergyUpdateCallback cb)
+{
+    m_energyUpdateCallback = cb;
+}
+
+void
+RitWpanEnergyModel::SetEnergyDepletedCallback(RitEnergyDepletedCallback cb)
+{
+    m_energyDepletedCallback = cb;
+}
+
+void
+RitWpanEnergyModel::Start()
+{
+    NS_LOG_FUNCTION(this);
+    m_lastUpdateTime = Simulator::Now();
+    m_lastUpdateEnergy = GetConsumedEnergy();
+    m_updateEvent.Cancel();
+    if (m_updateInterval.IsStrictlyPositive())
+    {
+        m_updateEvent = Simulator::Schedule(m_updateInterval, &RitWpanEnergyModel::Update, this);
+    }
+}
+
+double
+RitWpanEnergyModel::ComputeEnergy(const PhyDutyCycleCounters& counters) const
+{
+    double charge = counters.trxOff.GetSeconds() * m_trxOffCurrent +
+                    counters.rxOn.GetSeconds() * m_rxOnCurrent +
+                    counters.busyRx.GetSeconds() * m_busyRxCurrent +
+                    counters.txOn.GetSeconds() * m_txOnCurrent +
+                    counters.busyTx.GetSeconds() * m_busyTxCurrent;
+    return charge * m_supplyVoltage;
+}
+
+double
+RitWpanEnergyModel::GetConsumedEnergy() const
+{
+    if (!m_phy)
+    {
+        return 0.0;
+    }
+    return ComputeEnergy(m_phy->GetDutyCycleCounters());
+}
+
+double
+RitWpanEnergyModel::GetRemainingEnergy() const
+{
+    if (m_initialEnergy <= 0.0)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+    return std::max(0.0, m_initialEnergy - GetConsumedEnergy());
+}
+
+double
+RitWpanEnergyModel::GetRemainingFraction() const
+{
+    if (m_initialEnergy <= 0.0)
+    {
+        return 1.0;
+    }
+    return GetRemainingEnergy() / m_initialEnergy;
+}
+
+double
+RitWpanEnergyModel::GetAveragePower() const
+{
+    if (!m_phy)
+    {
+        return 0.0;
+    }
+    PhyDutyCycleCounters counters = m_phy->GetDutyCycleCounters();
+    Time total = counters.GetTotal();
+    if (!total.IsStrictlyPositive())
+    {
+        return 0.0;
+    }
+    return ComputeEnergy(counters) / total.GetSeconds();
+}
+
+bool
+RitWpanEnergyModel::IsDepleted() const
+{
+    return m_depletionTime != Time::Max();
+}
+
+Time
+RitWpanEnergyModel::GetDepletionTime() const
+{
+    return m_depletionTime;
+}
+
+Time
+RitWpanEnergyModel::GetLifetimeEstimate() const
+{
+    if (IsDepleted())
+    {
+        return m_depletionTime;
+    }
+    double power = GetAveragePower();
+    if (m_initialEnergy <= 0.0 || power <= 0.0)
+    {
+        return Time::Max();
+    }
+    return Seconds(m_initialEnergy / power);
+}
+
+void
+RitWpanEnergyModel::Update()
+{
+    Time now = Simulator::Now();
+    double consumed = GetConsumedEnergy();
+
+    if (m_initialEnergy > 0.0 && !IsDepleted() && consumed >= m_initialEnergy)
+    {
+        // Assume a constant power over the last interval to locate the crossing.
+        double fraction = (m_initialEnergy - m_lastUpdateEnergy) / (consumed - m_lastUpdateEnergy);
+        m_depletionTime = m_lastUpdateTime + Seconds((now - m_lastUpdateTime).GetSeconds() * fraction);
+        NS_LOG_INFO("Battery depleted at " << m_depletionTime.As(Time::S));
+        if (!m_energyDepletedCallback.IsNull())
+        {
+            m_energyDepletedCallback();
+        }
+    }
+
+    if (!m_energyUpdateCallback.IsNull())
+    {
+        m_energyUpdateCallback(consumed);
+    }
+
+    m_lastUpdateTime = now;
+    m_lastUpdateEnergy = consumed;
+    m_updateEvent = Simulator::Schedule(m_updateInterval, &RitWpanEnergyModel::Update, this);
+}
+
+} // namespace lrwpan
+} // namespace ns3
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef RIT_WPAN_ENERGY_MODEL_H
+#define RIT_WPAN_ENERGY_MODEL_H
+
+#include "ns3/event-id.h"
+#include "ns3/lr-wpan-phy.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * @ingroup lr-wpan
+ *
+ * Radio current profiles (datasheet typical values, radio only).
+ */
+enum RitRadioProfile
+{
+    RIT_RADIO_CC2538 = 0,   //!< TI CC2538: PM2 1.3 uA, RX 20 mA, TX (0 dBm) 24 mA
+    RIT_RADIO_AT86RF233 = 1 //!< Microchip AT86RF233: SLEEP 0.2 uA, RX 11.8 mA, TX (0 dBm) 13.8 mA
+};
+
+/**
+ * @ingroup lr-wpan
+ *
+ * This method reports the energy consumed by the radio so far.
+ *
+ * @param consumed the consumed energy in J
+ */
+typedef Callback<void, double> RitEnergyUpdateCallback;
+
+/**
+ * @ingroup lr-wpan
+ *
+ * This method notifies that the battery is empty.
+ */
+typedef Callback<void> RitEnergyDepletedCallback;
+
+/**
+ * @ingroup lr-wpan
+ *
+ * @brief State-based radio energy model for RitWpanNetDevice
+ *
+ * The consumed energy is computed from the time-in-state counters of the
+ * LrWpanPhy (see LrWpanPhy::GetDutyCycleCounters()) and a per-state current
+ * draw, so no per-transition bookkeeping is needed. A periodic update reports
+ * the consumed energy and detects battery depletion; the depletion time is
+ * interpolated inside the update interval.
+ */
+class RitWpanEnergyModel : public Object
+{
+  public:
+    /**
+     * Get the type ID.
+     *
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * Default constructor.
+     */
+    RitWpanEnergyModel();
+
+    /**
+     * Destructor.
+     */
+    ~RitWpanEnergyModel() override;
+
+    /**
+     * Set the PHY whose state counters drive the model.
+     *
+     * @param phy the PHY
+     */
+    void SetPhy(Ptr<LrWpanPhy> phy);
+
+    /**
+     * Load the per-state currents of a radio.
+     *
+     * @param profile the radio profile
+     */
+    void SetRadioProfile(RitRadioProfile profile);
+
+    /**
+     * Set the callback fired at every periodic update.
+     *
+     * @param cb the callback
+     */
+    void SetEnergyUpdateCallback(RitEnergyUpdateCallback cb);
+
+    /**
+     * Set the callback fired once when the battery is empty.
+     *
+     * @param cb the callback
+     */
+    void SetEnergyDepletedCallback(RitEnergyDepletedCallback cb);
+
+    /**
+     * Start the periodic update (no-op if the update interval is zero).
+     */
+    void Start();
+
+    /**
+     * Get the energy consumed by the radio so far.
+     *
+     * @return the consumed energy in J
+     */
+    double GetConsumedEnergy() const;
+
+    /**
+     * Get the energy left in the battery.
+     *
+     * @return the remaining energy in J (infinite if InitialEnergy is zero)
+     */
+    double GetRemainingEnergy() const;
+
+    /**
+     * Get the share of the battery left.
+     *
+     * @return the remaining energy over InitialEnergy, 1 if InitialEnergy is zero
+     */
+    double GetRemainingFraction() const;
+
+    /**
+     * Get the average power drawn by the radio so far.
+     *
+     * @return the average power in W
+     */
+    double GetAveragePower() const;
+
+    /**
+     * Check whether the battery has been depleted.
+     *
+     * @return true if the battery is empty
+     */
+    bool IsDepleted() const;
+
+    /**
+     * Get the time the battery was depleted.
+     *
+     * @return the depletion time, or Time::Max() if not depleted yet
+     */
+    Time GetDepletionTime() const;
+
+    /**
+     * Get the node lifetime: the depletion time if the battery is empty, otherwise
+     * the extrapolation of the current average power.
+     *
+     * @return the lifetime, or Time::Max() if it cannot be estimated
+     */
+    Time GetLifetimeEstimate() const;
+
+  private:
+    void DoDispose() override;
+
+    /**
+     * Compute the consumed energy for the given counters.
+     *
+     * @param counters time spent in each transceiver state
+     * @return the consumed energy in J
+     */
+    double ComputeEnergy(const PhyDutyCycleCounters& counters) const;
+
+    /**
+     * Periodic update: report the consumed energy and check for depletion.
+     */
+    void Update();
+
+    Ptr<LrWpanPhy> m_phy; //!< PHY providing the state counters
+
+    double m_supplyVoltage; //!< Supply voltage [V]
+    double m_trxOffCurrent; //!< Current in TRX_OFF [A]
+    double m_rxOnCurrent;   //!< Current in RX_ON [A]
+    double m_busyRxCurrent; //!< Current in BUSY_RX [A]
+    double m_txOnCurrent;   //!< Current in TX_ON [A]
+    double m_busyTxCurrent; //!< Current in BUSY_TX [A]
+    double m_initialEnergy; //!< Battery capacity [J], 0 = unlimited
+
+    Time m_updateInterval;      //!< Periodic update interval
+    EventId m_updateEvent;      //!< Next periodic update
+    Time m_lastUpdateTime;      //!< Time of the previous update
+    double m_lastUpdateEnergy;  //!< Consumed energy at the previous update [J]
+    Time m_depletionTime;       //!< Battery depletion time (Time::Max() if alive)
+
+    RitEnergyUpdateCallback m_energyUpdateCallback;     //!< Periodic report
+    RitEnergyDepletedCallback m_energyDepletedCallback; //!< Depletion notification
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // RIT_WPAN_ENERGY_MODEL_H
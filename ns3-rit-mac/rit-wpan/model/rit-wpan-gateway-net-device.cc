@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include "rit-wpan-gateway-net-device.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+NS_LOG_COMPONENT_DEFINE("RitWpanGatewayNetDevice");
+NS_OBJECT_ENSURE_REGISTERED(RitWpanGatewayNetDevice);
+
+TypeId
+RitWpanGatewayNetDevice::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::RitWpanGatewayNetDevice")
+            .SetParent<RitWpanNetDevice>()
+            .SetGroupName("LrWpan")
+            .AddConstructor<RitWpanGatewayNetDevice>()
+            .AddAttribute("RebalanceInterval",
+                          "Period of the load balancing of the children over the radios",
+                          TimeValue(Seconds(10)),
+                          MakeTimeAccessor(&RitWpanGatewayNetDevice::m_rebalanceInterval),
+                          MakeTimeChecker(MilliSeconds(1)))
+            .AddAttribute("RebalanceMargin",
+                          "Frames a radio must receive in a RebalanceInterval beyond the least "
+                          "loaded radio to redirect children to it",
+                          UintegerValue(2),
+                          MakeUintegerAccessor(&RitWpanGatewayNetDevice::m_rebalanceMargin),
+                          MakeUintegerChecker<uint32_t>())
+            .AddTraceSource("RadioRx",
+                            "A radio handed a data frame to the NWK",
+                            MakeTraceSourceAccessor(&RitWpanGatewayNetDevice::m_radioRxTrace),
+                            "ns3::lrwpan::RitWpanGatewayNetDevice::RadioRxTracedCallback")
+            .AddTraceSource("RadioRedirect",
+                            "A radio advertised the channel of another one in its next beacon",
+                            MakeTraceSourceAccessor(
+                                &RitWpanGatewayNetDevice::m_radioRedirectTrace),
+                            "ns3::lrwpan::RitWpanGatewayNetDevice::RadioRedirectTracedCallback");
+    return tid;
+}
+
+RitWpanGatewayNetDevice::RitWpanGatewayNetDevice()
+{
+    NS_LOG_FUNCTION(this);
+    m_radios.resize(1);
+    m_rebalanceInterval = Seconds(10);
+    m_rebalanceMargin = 2;
+}
+
+RitWpanGatewayNetDevice::~RitWpanGatewayNetDevice()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+RitWpanGatewayNetDevice::AddRadio(uint8_t channel)
+{
+    NS_LOG_FUNCTION(this << +channel);
+    NS_ABORT_MSG_IF(IsInitialized(), "Radios cannot be added after initialization");
+    NS_ABORT_MSG_IF(channel == 0, "A radio needs a receive channel");
+    Radio radio;
+    radio.channel = channel;
+    m_radios.push_back(radio);
+}
+
+void
+RitWpanGatewayNetDevice::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_rebalanceEvent.Cancel();
+    for (uint32_t i = 1; i < m_radios.size(); i++)
+    {
+        Radio& radio = m_radios[i];
+        if (radio.mac)
+        {
+            radio.phy->Dispose();
+            radio.mac->Dispose();
+            radio.csmaca->Dispose();
+            radio.carrierSense->Dispose();
+            radio.csmacaStage->Dispose();
+            radio.precs->Dispose();
+        }
+    }
+    m_radios.clear();
+    m_childRadio.clear();
+    RitWpanNetDevice::DoDispose();
+}
+
+void
+RitWpanGatewayNetDevice::DoInitialize()
+{
+    NS_LOG_FUNCTION(this);
+    RitWpanNetDevice::DoInitialize();
+
+    Radio& primary = m_radios[0];
+    primary.phy = GetPhy();
+    primary.mac = GetMac();
+    primary.channel = primary.mac->GetRxChannel();
+    NS_ABORT_MSG_IF(m_radios.size() > 1 && primary.channel == 0,
+                    "A multi-radio gateway needs the RxChannel of radio 0");
+    for (uint32_t i = 1; i < m_radios.size(); i++)
+    {
+        for (uint32_t j = 0; j < i; j++)
+        {
+            NS_ABORT_MSG_IF(m_radios[j].channel == m_radios[i].channel,
+                            "Radios " << j << " and " << i << " share channel "
+                                      << +m_radios[i].channel);
+        }
+    }
+
+    // Radio 0 is indicated through the gateway too, for the per-radio counts.
+    primary.mac->SetMcpsDataIndicationCallback(
+        MakeBoundCallback(&RitWpanGatewayNetDevice::RadioDataIndication, this, 0));
+    for (uint32_t i = 1; i < m_radios.size(); i++)
+    {
+        StartRadio(m_radios[i]);
+        m_radios[i].mac->SetMcpsDataIndicationCallback(
+            MakeBoundCallback(&RitWpanGatewayNetDevice::RadioDataIndication, this, i));
+        GetNwk()->AddRadioMac(m_radios[i].mac);
+    }
+
+    if (m_radios.size() > 1)
+    {
+        m_rebalanceEvent = Simulator::Schedule(m_rebalanceInterval,
+                                               &RitWpanGatewayNetDevice::Rebalance,
+                                               this);
+    }
+}
+
+void
+RitWpanGatewayNetDevice::StartRadio(Radio& radio)
+{
+    NS_LOG_FUNCTION(this << +radio.channel);
+    const Ptr<LrWpanPhy> phy0 = GetPhy();
+    const Ptr<RitWpanMac> mac0 = GetMac();
+
+    radio.phy = CreateObject<LrWpanPhy>();
+    radio.mac = CreateObject<RitWpanMac>();
+    radio.csmaca = CreateObject<LrWpanCsmaCa>();
+    radio.csmacaStage = CreateObject<RitCsmaCaCarrierSense>();
+    radio.precs = CreateObject<RitWpanPreCs>();
+    radio.carrierSense = CreateObject<RitCarrierSensePipeline>();
+    radio.carrierSense->AddStage(RitCarrierSensePipeline::PRE_CS_STAGE, radio.precs);
+    radio.carrierSense->AddStage(RitCarrierSensePipeline::CSMA_CA_STAGE, radio.csmacaStage);
+
+    // The MAC attributes of radio 0, its channel aside; objects are not shared.
+    for (TypeId tid = mac0->GetInstanceTypeId(); tid.HasParent(); tid = tid.GetParent())
+    {
+        for (std::size_t i = 0; i < tid.GetAttributeN(); i++)
+        {
+            const TypeId::AttributeInformation info = tid.GetAttribute(i);
+            const std::string valueType = info.checker->GetValueTypeName();
+            if (!(info.flags & TypeId::ATTR_SET) || !(info.flags & TypeId::ATTR_GET) ||
+                info.name == "RxChannel" || valueType == "ns3::PointerValue" ||
+                valueType == "ns3::ObjectPtrContainerValue")
+            {
+                continue;
+            }
+            Ptr<AttributeValue> value = info.checker->Create();
+            if (info.accessor->Get(PeekPointer(mac0), *value))
+            {
+                info.accessor->Set(PeekPointer(radio.mac), *value);
+            }
+        }
+    }
+
+    // The antenna of radio 0, on the same spectrum channel.
+    radio.phy->SetMobility(phy0->GetMobility());
+    radio.phy->SetChannel(phy0->GetChannel());
+    phy0->GetChannel()->AddRx(radio.phy);
+    radio.phy->SetErrorModel(phy0->GetErrorModel());
+    radio.phy->SetDevice(this);
+
+    // The wiring of RitWpanNetDevice::CompleteConfig(); the radio sends no data frames.
+    radio.mac->SetPhy(radio.phy);
+    radio.mac->SetCsmaCa(radio.csmaca);
+    radio.csmaca->SetMac(radio.mac);
+    radio.csmacaStage->SetCsmaCa(radio.csmaca);
+    radio.carrierSense->SetMac(radio.mac);
+    radio.mac->SetCarrierSense(radio.carrierSense);
+
+    radio.phy->SetPdDataIndicationCallback(
+        MakeCallback(&RitWpanMac::PdDataIndication, radio.mac));
+    radio.phy->SetPdDataConfirmCallback(MakeCallback(&RitWpanMac::PdDataConfirm, radio.mac));
+    radio.phy->SetPlmeGetAttributeConfirmCallback(
+        MakeCallback(&RitWpanMac::PlmeGetAttributeConfirm, radio.mac));
+    radio.phy->SetPlmeSetTRXStateConfirmCallback(
+        MakeCallback(&RitWpanMac::PlmeSetTRXStateConfirm, radio.mac));
+    radio.phy->SetPlmeSetAttributeConfirmCallback(
+        MakeCallback(&RitWpanMac::PlmeSetAttributeConfirm, radio.mac));
+    radio.phy->SetPlmeEdConfirmCallback(MakeCallback(&RitWpanMac::PlmeEdConfirm, radio.mac));
+    radio.phy->SetPlmeCcaConfirmCallback(
+        MakeCallback(&RitCarrierSensePipeline::PlmeCcaConfirm, radio.carrierSense));
+    radio.carrierSense->SetFallbackCcaConfirmCallback(
+        MakeCallback(&LrWpanCsmaCa::PlmeCcaConfirm, radio.csmaca));
+
+    radio.mac->SetShortAddress(mac0->GetShortAddress());
+    radio.mac->SetPanId(mac0->GetPanId());
+    radio.mac->SetRxAlwaysOn(mac0->GetRxAlwaysOn());
+    radio.mac->SetRxChannel(radio.channel);
+
+    radio.phy->Initialize();
+    radio.mac->Initialize();
+    radio.mac->SetModuleConfig(mac0->GetModuleConfig());
+    radio.mac->SetRitTimes(mac0->GetRitPeriodTime(),
+                           mac0->GetRitDataWaitDurationTime(),
+                           mac0->GetRitTxWaitDurationTime());
+}
+
+void
+RitWpanGatewayNetDevice::RadioDataIndication(RitWpanGatewayNetDevice* device,
+                                             uint32_t radio,
+                                             McpsDataIndicationParams params,
+                                             Ptr<Packet> p)
+{
+    Radio& r = device->m_radios[radio];
+    r.nRx++;
+    r.load++;
+    if (params.m_srcAddrMode == SHORT_ADDR)
+    {
+        device->m_childRadio[params.m_srcAddr] = radio;
+    }
+    device->m_radioRxTrace(radio, params.m_srcAddr, p);
+    device->GetNwk()->McpsDataIndication(params, p);
+}
+
+void
+RitWpanGatewayNetDevice::Rebalance()
+{
+    NS_LOG_FUNCTION(this);
+    uint32_t busiest = 0;
+    uint32_t idlest = 0;
+    for (uint32_t i = 1; i < m_radios.size(); i++)
+    {
+        if (m_radios[i].load > m_radios[busiest].load)
+        {
+            busiest = i;
+        }
+        if (m_radios[i].load < m_radios[idlest].load)
+        {
+            idlest = i;
+        }
+    }
+    if (m_radios[busiest].load > m_radios[idlest].load + m_rebalanceMargin)
+    {
+        NS_LOG_DEBUG("Radio " << busiest << " (" << m_radios[busiest].load
+                              << " frames) redirects to " << idlest << " ("
+                              << m_radios[idlest].load << " frames)");
+        m_radios[busiest].mac->RedirectNextBeacon(m_radios[idlest].channel);
+        m_radios[busiest].nRedirects++;
+        m_radioRedirectTrace(busiest, idlest);
+    }
+    for (auto& radio : m_radios)
+    {
+        radio.load = 0;
+    }
+    m_rebalanceEvent =
+        Simulator::Schedule(m_rebalanceInterval, &RitWpanGatewayNetDevice::Rebalance, this);
+}
+
+uint32_t
+RitWpanGatewayNetDevice::GetNRadios() const
+{
+    return m_radios.size();
+}
+
+Ptr<RitWpanMac>
+RitWpanGatewayNetDevice::GetRadioMac(uint32_t radio) const
+{
+    NS_ASSERT(radio < m_radios.size());
+    return radio == 0 ? GetMac() : m_radios[radio].mac;
+}
+
+Ptr<LrWpanPhy>
+RitWpanGatewayNetDevice::GetRadioPhy(uint32_t radio) const
+{
+    NS_ASSERT(radio < m_radios.size());
+    return radio == 0 ? GetPhy() : m_radios[radio].phy;
+}
+
+uint8_t
+RitWpanGatewayNetDevice::GetRadioChannel(uint32_t radio) const
+{
+    NS_ASSERT(radio < m_radios.size());
+    return radio == 0 ? GetMac()->GetRxChannel() : m_radios[radio].channel;
+}
+
+uint64_t
+RitWpanGatewayNetDevice::GetRadioNRx(uint32_t radio) const
+{
+    NS_ASSERT(radio < m_radios.size());
+    return m_radios[radio].nRx;
+}
+
+uint64_t
+RitWpanGatewayNetDevice::GetRadioNRedirects(uint32_t radio) const
+{
+    NS_ASSERT(radio < m_radios.size());
+    return m_radios[radio].nRedirects;
+}
+
+uint32_t
+RitWpanGatewayNetDevice::GetRadioNChildren(uint32_t radio) const
+{
+    NS_ASSERT(radio < m_radios.size());
+    uint32_t n = 0;
+    for (const auto& [child, r] : m_childRadio)
+    {
+        n += r == radio ? 1 : 0;
+    }
+    return n;
+}
+
+} // namespace lrwpan
+} // namespace ns3
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#ifndef NS3_LRWPAN_RIT_WPAN_GATEWAY_NET_DEVICE_H
+#define NS3_LRWPAN_RIT_WPAN_GATEWAY_NET_DEVICE_H
+
+#include "rit-wpan-net-device.h"
+
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/traced-callback.h"
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace ns3
+{
+namespace lrwpan
+{
+
+/**
+ * \ingroup ri-pan
+ *
+ * \brief Multi-radio RIT gateway: several PHY and RIT-MAC pairs on different channels
+ *        behind one short address and one NWK.
+ *
+ * Radio 0 is the PHY and MAC of RitWpanNetDevice, on its RxChannel. AddRadio() adds a
+ * receive-only radio per further channel, which beacons the same RIT request payload at
+ * its own phase. Every radio hands its data frames to the one NWK, so the upward traffic
+ * of all the radios is merged there (with DuplicateDetection, a frame received by two
+ * radios is forwarded once); the transmissions of the NWK stay on radio 0.
+ *
+ * Every RebalanceInterval, the radio that received the most frames advertises the
+ * channel of the least loaded one in its next beacon (RitWpanMac::RedirectNextBeacon),
+ * whenever the gap exceeds RebalanceMargin: the children answering that beacon move
+ * over. The network must use RxChannel, e.g. RitWpanNetHelper::AssignRxChannels, and
+ * the channels of the extra radios must be left out of the plan of its neighbours.
+ *
+ * The energy model and AssignStreams() cover radio 0 only.
+ */
+class RitWpanGatewayNetDevice : public RitWpanNetDevice
+{
+  public:
+    static TypeId GetTypeId();
+
+    RitWpanGatewayNetDevice();
+    ~RitWpanGatewayNetDevice() override;
+
+    /**
+     * \brief Add a receive-only radio, built at initialization with the MAC attributes,
+     *        the module config and the RIT times of radio 0.
+     * \param channel Its receive channel, other than the one of every other radio
+     */
+    void AddRadio(uint8_t channel);
+
+    /**
+     * \return the number of radios, radio 0 included
+     */
+    uint32_t GetNRadios() const;
+
+    /**
+     * \param radio Radio index
+     * \return the MAC of the radio
+     */
+    Ptr<RitWpanMac> GetRadioMac(uint32_t radio) const;
+
+    /**
+     * \param radio Radio index
+     * \return the PHY of the radio
+     */
+    Ptr<LrWpanPhy> GetRadioPhy(uint32_t radio) const;
+
+    /**
+     * \param radio Radio index
+     * \return the receive channel of the radio
+     */
+    uint8_t GetRadioChannel(uint32_t radio) const;
+
+    /**
+     * \param radio Radio index
+     * \return the number of data frames the radio handed to the NWK
+     */
+    uint64_t GetRadioNRx(uint32_t radio) const;
+
+    /**
+     * \param radio Radio index
+     * \return the number of redirects the radio advertised
+     */
+    uint64_t GetRadioNRedirects(uint32_t radio) const;
+
+    /**
+     * \param radio Radio index
+     * \return the number of children whose last frame the radio received
+     */
+    uint32_t GetRadioNChildren(uint32_t radio) const;
+
+    /**
+     * TracedCallback signature for the frames received by a radio.
+     *
+     * \param [in] radio Radio index
+     * \param [in] src MAC source of the frame
+     * \param [in] packet The MSDU
+     */
+    typedef void (*RadioRxTracedCallback)(uint32_t radio,
+                                          Mac16Address src,
+                                          Ptr<const Packet> packet);
+
+    /**
+     * TracedCallback signature for the redirects of the load balancing.
+     *
+     * \param [in] from Radio advertising the redirect
+     * \param [in] to Radio whose channel is advertised
+     */
+    typedef void (*RadioRedirectTracedCallback)(uint32_t from, uint32_t to);
+
+  protected:
+    void DoDispose() override;
+    void DoInitialize() override;
+
+  private:
+    /**
+     * One radio of the gateway.
+     */
+    struct Radio
+    {
+        uint8_t channel{0};                        //!< Receive channel
+        Ptr<LrWpanPhy> phy;                        //!< PHY
+        Ptr<RitWpanMac> mac;                       //!< RIT MAC
+        Ptr<LrWpanCsmaCa> csmaca;                  //!< CSMA/CA of the MAC
+        Ptr<RitCsmaCaCarrierSense> csmacaStage;    //!< CSMA/CA stage of the pipeline
+        Ptr<RitWpanPreCs> precs;                   //!< Pre-CS stage of the pipeline
+        Ptr<RitCarrierSensePipeline> carrierSense; //!< Carrier-sense stages of the MAC
+        uint64_t nRx{0};                           //!< Data frames handed to the NWK
+        uint64_t nRedirects{0};                    //!< Redirects advertised
+        uint64_t load{0};                          //!< Data frames since the last rebalance
+    };
+
+    /**
+     * \brief Build and start an extra radio, a copy of radio 0 on its own channel.
+     * \param radio The radio, its channel set
+     */
+    void StartRadio(Radio& radio);
+
+    /**
+     * \brief Count a data frame of a radio and hand it to the NWK.
+     * \param device The gateway
+     * \param radio Radio index
+     * \param params Indication parameters
+     * \param p The MSDU
+     */
+    static void RadioDataIndication(RitWpanGatewayNetDevice* device,
+                                    uint32_t radio,
+                                    McpsDataIndicationParams params,
+                                    Ptr<Packet> p);
+
+    /**
+     * \brief Redirect children from the busiest radio to the least loaded one.
+     */
+    void Rebalance();
+
+    std::vector<Radio> m_radios;                   //!< Radio 0 and the extra radios
+    std::map<Mac16Address, uint32_t> m_childRadio; //!< Radio of the last frame of each child
+    Time m_rebalanceInterval;                      //!< Period of the load balancing
+    uint32_t m_rebalanceMargin;                    //!< Load gap below which no child moves
+    EventId m_rebalanceEvent;                      //!< Next rebalance
+
+    /// Data frame handed to the NWK by a radio
+    TracedCallback<uint32_t, Mac16Address, Ptr<const Packet>> m_radioRxTrace;
+    TracedCallback<uint32_t, uint32_t> m_radioRedirectTrace; //!< Redirect advertised
+};
+
+} // namespace lrwpan
+} // namespace ns3
+
+#endif // NS3_LRWPAN_RIT_WPAN_GATEWAY_NET_DEVICE_H
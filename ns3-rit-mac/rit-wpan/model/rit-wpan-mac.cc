@@ -10,19 +10,34 @@
 
 #include "rit-wpan-mac.h"
 
+#include "rit-appointment-header.h"
+#include "rit-carrier-sense.h"
+#include "rit-frame-codec.h"
+#include "rit-ie.h"
+#include "rit-realtime-monitor.h"
+#include "rit-run-arena.h"
+#include "rit-sender-registry.h"
 #include "rit-sub-header.h"
-#include "rit-wpan-precs.h"
-#include "rit-wpan-precsb.h"
 
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/enum.h"
 #include "ns3/lr-wpan-constants.h"
 #include "ns3/lr-wpan-csmaca.h"
 #include "ns3/lr-wpan-mac-header.h"
 #include "ns3/lr-wpan-mac-pl-headers.h"
 #include "ns3/lr-wpan-mac-trailer.h"
+#include "ns3/lr-wpan-phy.h"
+#include "ns3/lr-wpan-spectrum-channel.h"
 #include "ns3/node.h"
+#include "ns3/pointer.h"
 #include "ns3/simulator.h"
+#include "ns3/uinteger.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
+#include <vector>
 
 #undef NS_LOG_APPEND_CONTEXT
 #define NS_LOG_APPEND_CONTEXT                                                                     \
@@ -30,7 +45,7 @@
             << m_macRitPeriodTime.Get().GetSeconds() << "s|"                                      \
             << m_macRitTxWaitDurationTime.Get().GetMilliSeconds() << "ms|"                        \
             << m_ritMacMode << "|Qs:" << static_cast<uint32_t>(m_txQueue.size()) << "|"           \
-            << m_macState << "|" << m_periodicRitDataRequestEvent.IsPending() << "] ";
+            << m_macState << "|" << m_ritTimers.IsPending(RIT_PERIODIC_REQUEST_TIMER) << "] ";
 
 namespace ns3
 {
@@ -40,6 +55,19 @@ namespace lrwpan
 NS_LOG_COMPONENT_DEFINE("RitWpanMac");
 NS_OBJECT_ENSURE_REGISTERED(RitWpanMac);
 
+/// PSDU size of an ACK frame (frame control, sequence number and FCS)
+static constexpr uint32_t ACK_FRAME_SIZE = 5;
+
+/// Longest header IE list of an ACK, the most a RitIeView takes (headerIesEnabled)
+static constexpr uint32_t MAX_ACK_IE_SIZE =
+    RitIeView::MAX_BYTES + RitIeView::MAX_IES * RitIeList::DESCRIPTOR_SIZE;
+
+/// Duration of a CCA [symbols]
+static constexpr double CCA_SYMBOLS = 8.0;
+
+/// Buckets of the DutyCycleWindow
+static constexpr uint32_t DUTY_CYCLE_BUCKETS = 60;
+
 std::ostream&
 operator<<(std::ostream& os, const RitMacMode& ritMode)
 {
@@ -60,6 +88,9 @@ operator<<(std::ostream& os, const RitMacMode& ritMode)
     case BOOTSTRAP_MODE:
         os << "BOOTSTRAP";
         break;
+    case STROBE_MODE:
+        os << "STROBE";
+        break;
     }
     return os;
 }
@@ -87,6 +118,202 @@ RitWpanMac::GetTypeId()
                           UintegerValue(65),
                           MakeUintegerAccessor(&RitWpanMac::m_macRitTxWaitDuration),
                           MakeUintegerChecker<uint32_t>())
+            .AddAttribute("HopLatencyEnabled",
+                          "Stamp the per-hop latency stages of data frames and attach a "
+                          "RitHopLatencyTag at PHY transmission start",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&RitWpanMac::m_hopLatencyEnabled),
+                          MakeBooleanChecker())
+            .AddAttribute("PhaseLockGuard",
+                          "Fixed half-width of the sender listen window around a predicted "
+                          "beacon (phaseLearningEnabled); covers the beacon airtime and jitter",
+                          TimeValue(MilliSeconds(5)),
+                          MakeTimeAccessor(&RitWpanMac::m_phaseLockGuard),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("PhaseLockDriftPpm",
+                          "Growth of the listen window half-width with the time since the "
+                          "beacon was last heard (ppm, phaseLearningEnabled)",
+                          DoubleValue(40.0),
+                          MakeDoubleAccessor(&RitWpanMac::m_phaseLockDriftPpm),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("ContentionSlots",
+                          "Response slots after a beacon, one data exchange each "
+                          "(contentionSlotsEnabled)",
+                          UintegerValue(4),
+                          MakeUintegerAccessor(&RitWpanMac::m_contentionSlots),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("ContentionSlotDuration",
+                          "Length of a response slot; covers a data frame, its ACK and the "
+                          "carrier sense (contentionSlotsEnabled)",
+                          TimeValue(MilliSeconds(6)),
+                          MakeTimeAccessor(&RitWpanMac::m_contentionSlotDuration),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("BeaconDeconflictGap",
+                          "Smallest separation kept between the beacon and a neighbour beacon; "
+                          "covers the beacon airtime, its carrier sense and a short exchange "
+                          "(beaconDeconflictionEnabled)",
+                          TimeValue(MilliSeconds(20)),
+                          MakeTimeAccessor(&RitWpanMac::m_beaconDeconflictGap),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("DataWaitProbeGuard",
+                          "Slack of the data wait probe after the latest time a sender "
+                          "answering the beacon starts its frame (dataWaitProbeEnabled)",
+                          TimeValue(MicroSeconds(320)),
+                          MakeTimeAccessor(&RitWpanMac::m_dataWaitProbeGuard),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("AppointmentGuard",
+                          "Sender listen window around a beacon appointed in an ACK, clock "
+                          "drift excluded; covers the carrier sense and airtime of the beacon "
+                          "(ackAppointmentsEnabled)",
+                          TimeValue(MilliSeconds(4)),
+                          MakeTimeAccessor(&RitWpanMac::m_appointmentGuard),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("DuplicateCacheSize",
+                          "Source and DSN pairs of the data frames received kept to detect "
+                          "the retries of a frame whose ACK was lost (duplicateFilterEnabled)",
+                          UintegerValue(32),
+                          MakeUintegerAccessor(&RitWpanMac::m_duplicateCacheSize),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("DuplicateLifetime",
+                          "Time a source and DSN are kept; shorter than the time a neighbour "
+                          "takes to send 256 frames (duplicateFilterEnabled)",
+                          TimeValue(Seconds(30)),
+                          MakeTimeAccessor(&RitWpanMac::m_duplicateLifetime),
+                          MakeTimeChecker(MilliSeconds(1)))
+            .AddAttribute("TxQueueCapacity",
+                          "Frames the TX queue holds (0: unbounded)",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&RitWpanMac::m_txQueueCapacity),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("TxQueueDropPolicy",
+                          "Frame dropped when a frame arrives at a full TX queue",
+                          EnumValue(RIT_TX_QUEUE_TAIL_DROP),
+                          MakeEnumAccessor<RitTxQueueDropPolicy>(&RitWpanMac::m_txQueueDropPolicy),
+                          MakeEnumChecker(RIT_TX_QUEUE_TAIL_DROP,
+                                          "TailDrop",
+                                          RIT_TX_QUEUE_HEAD_DROP,
+                                          "HeadDrop",
+                                          RIT_TX_QUEUE_ORIGIN_DROP,
+                                          "OriginDrop"))
+            .AddAttribute("TxQueuePriorityEnabled",
+                          "Serve the TX queue by NWK priority class, FIFO within a class",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&RitWpanMac::m_txQueuePriorityEnabled),
+                          MakeBooleanChecker())
+            .AddAttribute("RitPeriodPolicy",
+                          "Policy adapting the RIT period to the inbound load (null: fixed)",
+                          PointerValue(),
+                          MakePointerAccessor(&RitWpanMac::SetRitPeriodPolicy,
+                                              &RitWpanMac::GetRitPeriodPolicy),
+                          MakePointerChecker<RitPeriodPolicy>())
+            .AddAttribute("RitPeriodMin",
+                          "Lower bound of the adapted RIT period (0: a quarter of the "
+                          "configured period), never below the data wait duration",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&RitWpanMac::m_ritPeriodMin),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("RitPeriodMax",
+                          "Upper bound of the adapted RIT period (0: four times the "
+                          "configured period)",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&RitWpanMac::m_ritPeriodMax),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("RitPeriodAdaptationWindow",
+                          "Load observation window of the RIT period policy",
+                          TimeValue(Seconds(60)),
+                          MakeTimeAccessor(&RitWpanMac::m_periodAdaptationWindow),
+                          MakeTimeChecker(MilliSeconds(1)))
+            .AddAttribute("ClockDriftKnotInterval",
+                          "Knot spacing of the closed-form clock drift: the random-walk "
+                          "noise is sampled at these knots and interpolated, so the beacon "
+                          "times draw no random number (0: one noise draw per beacon)",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&RitWpanMac::m_clockDriftKnotInterval),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("RxChannel",
+                          "Channel this node beacons and listens on; senders retune to it "
+                          "(0: single channel, the PHY channel is kept)",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&RitWpanMac::SetRxChannel,
+                                               &RitWpanMac::GetRxChannel),
+                          MakeUintegerChecker<uint8_t>(0, 26))
+            .AddAttribute("ChannelSwitchTime",
+                          "Synthesizer settling time of a sender retune, radio off (RxChannel)",
+                          TimeValue(MicroSeconds(192)),
+                          MakeTimeAccessor(&RitWpanMac::m_channelSwitchTime),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("BroadcastHoldTime",
+                          "Time a broadcast data frame stays at the head of the TX queue, "
+                          "answering the first beacon of each neighbour (0: the TWD, one "
+                          "beacon period of every neighbour)",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&RitWpanMac::m_broadcastHoldTime),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("HybridQueueThreshold",
+                          "TX queue length above which a sender cycle wakes the last receiver "
+                          "with a train of its head-of-line data frame instead of waiting for "
+                          "its beacon (0: never)",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&RitWpanMac::m_hybridQueueThreshold),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("StrobeTrainTime",
+                          "Longest frame train before falling back to the beacon wait (0: one "
+                          "RIT period and DWD, a data wait of every receiver)",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&RitWpanMac::m_strobeTrainTime),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("DutyCycleLimit",
+                          "Largest fraction of DutyCycleWindow spent transmitting, e.g. 0.1 "
+                          "for a 10% regulatory limit (0: no limit)",
+                          DoubleValue(0.0),
+                          MakeDoubleAccessor(&RitWpanMac::m_dutyCycleLimit),
+                          MakeDoubleChecker<double>(0.0, 1.0))
+            .AddAttribute("DutyCycleWindow",
+                          "Sliding window of the duty-cycle limit",
+                          TimeValue(Seconds(3600)),
+                          MakeTimeAccessor(&RitWpanMac::m_dutyCycleWindow),
+                          MakeTimeChecker(MilliSeconds(1)))
+            .AddAttribute("DutyCyclePolicy",
+                          "Beacon that does not fit in the duty-cycle limit: skipped, or "
+                          "skipped with the next one put off until it fits",
+                          EnumValue(RIT_DUTY_CYCLE_SKIP_BEACON),
+                          MakeEnumAccessor<RitDutyCyclePolicy>(&RitWpanMac::m_dutyCyclePolicy),
+                          MakeEnumChecker(RIT_DUTY_CYCLE_SKIP_BEACON,
+                                          "SkipBeacon",
+                                          RIT_DUTY_CYCLE_LENGTHEN_PERIOD,
+                                          "LengthenPeriod"))
+            .AddAttribute("SecurityLevel",
+                          "Security level of the frames, e.g. 5 for ENC-MIC-32 or 6 for "
+                          "ENC-MIC-64: auxiliary security header and MIC added (0: unsecured)",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&RitWpanMac::SetSecurityLevel,
+                                               &RitWpanMac::GetSecurityLevel),
+                          MakeUintegerChecker<uint8_t>(0, 7))
+            .AddAttribute("SecurityKeyIdMode",
+                          "Key identifier mode of the auxiliary security header: 0 to 3 for "
+                          "0, 1, 5 or 9 key identifier bytes (SecurityLevel)",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&RitWpanMac::SetSecurityKeyIdMode,
+                                               &RitWpanMac::GetSecurityKeyIdMode),
+                          MakeUintegerChecker<uint8_t>(0, 3))
+            .AddAttribute("SecureRitDataRequest",
+                          "Secure the RIT Data Requests as well as the data frames "
+                          "(SecurityLevel)",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&RitWpanMac::m_secureRitDataRequest),
+                          MakeBooleanChecker())
+            .AddAttribute("SecurityEncryptDelay",
+                          "Encryption of a data frame on the MCU, from the beacon it answers "
+                          "to its carrier sense (SecurityLevel)",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&RitWpanMac::m_securityEncryptDelay),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("SecurityDecryptDelay",
+                          "Decryption of a secured data frame received, before it is "
+                          "indicated to the upper layer; one frame at a time",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&RitWpanMac::m_securityDecryptDelay),
+                          MakeTimeChecker(Seconds(0)))
             .AddTraceSource("MacMode",
                             "Current RIT MAC mode",
                             MakeTraceSourceAccessor(&RitWpanMac::m_ritMacMode),
@@ -95,6 +322,10 @@ RitWpanMac::GetTypeId()
                             "Trace of macRitPeriod changes",
                             MakeTraceSourceAccessor(&RitWpanMac::m_macRitPeriod),
                             "ns3::TracedValueCallback::Uint32")
+            .AddTraceSource("MacRitPeriodTime",
+                            "Trace of RIT period time changes, adaptations included",
+                            MakeTraceSourceAccessor(&RitWpanMac::m_macRitPeriodTime),
+                            "ns3::TracedValueCallback::Time")
             .AddTraceSource("MacRitDataWaitDuration",
                             "Trace of macRitDataWaitDuration changes",
                             MakeTraceSourceAccessor(&RitWpanMac::m_macRitDataWaitDuration),
@@ -110,21 +341,156 @@ RitWpanMac::GetTypeId()
             .AddTraceSource("DataWaitEvent",
                             "Data wait events (start, end, timeout) with timestamps",
                             MakeTraceSourceAccessor(&RitWpanMac::m_dataWaitTrace),
-                            "ns3::TracedCallback::StringTime");
+                            "ns3::TracedCallback::StringTime")
+            .AddTraceSource("HopLatency",
+                            "Stage timestamps of a data frame successfully sent by this node",
+                            MakeTraceSourceAccessor(&RitWpanMac::m_hopLatencyTrace),
+                            "ns3::lrwpan::RitWpanMac::HopLatencyTracedCallback")
+            .AddTraceSource("BroadcastTx",
+                            "A broadcast data frame answered the beacon of a neighbour",
+                            MakeTraceSourceAccessor(&RitWpanMac::m_broadcastTxTrace),
+                            "ns3::lrwpan::RitWpanMac::BroadcastTxTracedCallback")
+            .AddTraceSource("TxQueueOccupancy",
+                            "Number of frames in the TX queue",
+                            MakeTraceSourceAccessor(&RitWpanMac::m_txQueueOccupancy),
+                            "ns3::TracedValueCallback::Uint32")
+            .AddTraceSource("TxQueueEnqueue",
+                            "A frame entered the TX queue",
+                            MakeTraceSourceAccessor(&RitWpanMac::m_txQueueEnqueueTrace),
+                            "ns3::lrwpan::RitWpanMac::TxQueueTracedCallback")
+            .AddTraceSource("TxQueueDequeue",
+                            "A frame left the TX queue after its transmission, with its "
+                            "sojourn time",
+                            MakeTraceSourceAccessor(&RitWpanMac::m_txQueueDequeueTrace),
+                            "ns3::lrwpan::RitWpanMac::TxQueueTracedCallback")
+            .AddTraceSource("TxQueueDrop",
+                            "A frame dropped by a full TX queue, with its sojourn time",
+                            MakeTraceSourceAccessor(&RitWpanMac::m_txQueueDropTrace),
+                            "ns3::lrwpan::RitWpanMac::TxQueueTracedCallback")
+            .AddTraceSource("DutyCycle",
+                            "A transmission put off by the duty-cycle limit, with the wait "
+                            "until it fits",
+                            MakeTraceSourceAccessor(&RitWpanMac::m_dutyCycleTrace),
+                            "ns3::lrwpan::RitWpanMac::DutyCycleTracedCallback")
+            .AddTraceSource("MacRxDuplicate",
+                            "A data frame acknowledged again but not indicated, its source "
+                            "and DSN being in the duplicate cache (duplicateFilterEnabled)",
+                            MakeTraceSourceAccessor(&RitWpanMac::m_macRxDuplicateTrace),
+                            "ns3::Packet::TracedCallback");
     return tid;
 }
 
 RitWpanMac::RitWpanMac()
+    : m_ritTimers(RIT_TIMER_COUNT),
+      m_beaconPhases(RitRunArena::GetResource()),
+      m_appointments(RitRunArena::GetResource()),
+      m_hopLatency(RitRunArena::GetResource()),
+      m_pendingTxClass(RitRunArena::GetResource()),
+      m_txQueueEntries(RitRunArena::GetResource())
 {
     NS_LOG_FUNCTION(this);
+    m_ritTimers.SetHandler(RIT_DATA_WAIT_TIMER,
+                           MakeCallback(&RitWpanMac::ReceiverCycleTimeout, this),
+                           "RitWpanMac::ReceiverCycleTimeout");
+    m_ritTimers.SetHandler(RIT_TX_WAIT_TIMER,
+                           MakeCallback(&RitWpanMac::SenderCycleTimeout, this),
+                           "RitWpanMac::SenderCycleTimeout");
+    m_ritTimers.SetHandler(RIT_PERIODIC_REQUEST_TIMER,
+                           MakeCallback(&RitWpanMac::PeriodicRitDataRequest, this),
+                           "RitWpanMac::PeriodicRitDataRequest");
+    m_ritTimers.SetHandler(RIT_RX_RESUME_TIMER,
+                           MakeCallback(&RitWpanMac::ResumeRx, this),
+                           "RitWpanMac::ResumeRx");
+    m_ritTimers.SetHandler(RIT_PHASE_WAKE_TIMER,
+                           MakeCallback(&RitWpanMac::PhaseLockedWakeup, this),
+                           "RitWpanMac::PhaseLockedWakeup");
+    m_ritTimers.SetHandler(RIT_PERIOD_ADAPT_TIMER,
+                           MakeCallback(&RitWpanMac::AdaptRitPeriod, this),
+                           "RitWpanMac::AdaptRitPeriod");
+    m_ritTimers.SetHandler(RIT_CONTENTION_SLOT_TIMER,
+                           MakeCallback(&RitWpanMac::SendRitResponse, this),
+                           "RitWpanMac::SendRitResponse");
+    m_ritTimers.SetHandler(RIT_BOOTSTRAP_TIMER,
+                           MakeCallback(&RitWpanMac::BootstrapTimeout, this),
+                           "RitWpanMac::BootstrapTimeout");
+    m_ritTimers.SetHandler(RIT_CHANNEL_SWITCH_TIMER,
+                           MakeCallback(&RitWpanMac::StartRitTxWaitPeriod, this),
+                           "RitWpanMac::StartRitTxWaitPeriod");
+    m_ritTimers.SetHandler(RIT_STROBE_TIMER,
+                           MakeCallback(&RitWpanMac::SendStrobe, this),
+                           "RitWpanMac::SendStrobe");
+    m_ritTimers.SetHandler(RIT_ENCRYPT_TIMER,
+                           MakeCallback(&RitWpanMac::TransmitRitData, this),
+                           "RitWpanMac::TransmitRitData");
+    m_ritTimers.SetHandler(RIT_DATA_WAIT_PROBE_TIMER,
+                           MakeCallback(&RitWpanMac::ProbeDataWait, this),
+                           "RitWpanMac::ProbeDataWait");
     // Initialize RIT-specific parameters
     ChangeRitMacMode(RIT_MODE_DISABLED);
     m_timeDriftApplier = CreateObject<TimeDriftApplier>();
     m_timeDriftApplier->SetDriftRatio(10); // Set a default drift ratio of 10%
     m_clockDriftApplier = CreateObject<ClockDriftApplier>();
+    m_clockDriftKnotInterval = Seconds(0);
+    m_initialPhase = CreateObject<UniformRandomVariable>();
     m_rxAlwaysOn = false; // Default to false, can be set later
+    m_hopLatencyEnabled = false;
+    m_txQueueCapacity = 0;
+    m_txQueueDropPolicy = RIT_TX_QUEUE_TAIL_DROP;
+    m_txQueuePriorityEnabled = false;
+    m_txQueueOccupancy = 0;
+    m_nElidedCycles = 0;
+    m_overheardBeaconValid = false;
+    m_nOverheardRxShortcuts = 0;
+    m_nOverheardTxDeferrals = 0;
+    m_continuousRxEnabled = false;
+    m_burstMoreData = false;
+    m_framePendingRx = false;
+    m_phaseTargetValid = false;
+    m_phaseLockGuard = MilliSeconds(5);
+    m_contentionSlots = 4;
+    m_contentionSlotDuration = MilliSeconds(6);
+    m_lastRxRitReqSeqNum = 0;
+    m_beaconDeconflictGap = MilliSeconds(20);
+    m_nBeaconPhaseShifts = 0;
+    m_dataWaitProbeGuard = MicroSeconds(320);
+    m_dataWaitProbePending = false;
+    m_dataWaitActivity = false;
+    m_nDataWaitProbeShortcuts = 0;
+    m_phaseLockDriftPpm = 40.0;
+    m_appointmentGuard = MilliSeconds(4);
+    m_nAppointmentsGranted = 0;
+    m_nAppointmentsReceived = 0;
+    m_duplicateCacheSize = 32;
+    m_duplicateLifetime = Seconds(30);
+    m_nRxDuplicates = 0;
+    m_periodAdaptationWindow = Seconds(60);
+    m_beaconAnswered = false;
+    m_rxChannel = 0;
+    m_redirectChannel = 0;
+    m_nBeaconRedirects = 0;
+    m_planFirstChannel = 0;
+    m_planChannels = 0;
+    m_channelSwitchTime = MicroSeconds(192);
+    m_nChannelSwitches = 0;
+    m_broadcastHoldTime = Seconds(0);
+    m_nBroadcastTx = 0;
+    m_hybridQueueThreshold = 0;
+    m_strobeTrainTime = Seconds(0);
+    m_hybridPeerValid = false;
+    m_nStrobeFrames = 0;
+    m_dutyCycleLimit = 0.0;
+    m_dutyCycleWindow = Seconds(3600);
+    m_dutyCyclePolicy = RIT_DUTY_CYCLE_SKIP_BEACON;
+    m_nDutyCycleDeferrals = 0;
+    m_secureRitDataRequest = true;
+    m_ritDataRequestSecured = false;
+    m_securityEncryptDelay = Seconds(0);
+    m_securityDecryptDelay = Seconds(0);
+    m_idleCyclePhase = IDLE_CYCLE_NONE;
+    m_idleCycleInterrupted = false;
 
     m_macRitPeriodTime = Seconds(5);
+    m_nominalRitPeriodTime = m_macRitPeriodTime;
     m_macRitDataWaitDurationTime = MilliSeconds(10);
     m_macRitTxWaitDurationTime = MilliSeconds(5000);
 
@@ -140,7 +506,22 @@ RitWpanMac::DoInitialize()
 {
     NS_LOG_FUNCTION(this);
     ChangeRitMacMode(SLEEP_MODE); // Initial mode at initialization (before starting RIT cycle)
+    m_clockDriftApplier->SetKnotInterval(m_clockDriftKnotInterval);
     m_clockDriftApplier->Initialize(m_shortAddress.ConvertToInt(), 1);
+    m_airtimeBudget.Configure(m_dutyCycleWindow, m_dutyCycleLimit, DUTY_CYCLE_BUCKETS);
+    m_rxDuplicates.SetCapacity(m_duplicateCacheSize);
+    m_rxDuplicates.SetLifetime(m_duplicateLifetime);
+    TuneChannel(m_rxChannel);
+    if (m_moduleConfig.idleCycleElisionEnabled)
+    {
+        // Every sender of the channel registers once the registry exists
+        Ptr<LrWpanSpectrumChannel> channel =
+            m_phy ? DynamicCast<LrWpanSpectrumChannel>(m_phy->GetChannel()) : nullptr;
+        if (channel)
+        {
+            m_senderRegistry = RitSenderRegistry::Get(channel);
+        }
+    }
     LrWpanMac::DoInitialize();
 }
 
@@ -148,10 +529,35 @@ void
 RitWpanMac::DoDispose()
 {
     NS_LOG_FUNCTION(this);
-    // Cancel any scheduled events
-    m_ritDataWaitTimeout.Cancel();
-    m_ritTxWaitTimeout.Cancel();
-    m_periodicRitDataRequestEvent.Cancel();
+    if (RitRunArena::IsBulkTeardown())
+    {
+        // The events die with the simulator and the containers with the object
+    }
+    else
+    {
+        // Cancel any scheduled events
+        m_ritTimers.CancelAll();
+        m_earlyRxAbortEvent.Cancel();
+        m_decryptEvent.Cancel();
+        m_decryptQueue.clear();
+        m_hopLatency.clear();
+        m_pendingTxClass.clear();
+        m_txQueueEntries.clear();
+        m_beaconPhases.clear();
+        m_appointments.clear();
+        m_rxDuplicates.Clear();
+        if (m_senderRegistry)
+        {
+            m_senderRegistry->Unwatch(m_phy);
+            m_senderRegistry->Remove(m_phy);
+        }
+    }
+    m_senderRegistry = nullptr;
+    m_idleCyclePhase = IDLE_CYCLE_NONE;
+    m_periodPolicy = nullptr;
+    m_initialPhase = nullptr;
+    m_ritDataRequestTemplate = nullptr;
+    m_carrierSense = nullptr;
 
     // Chain up to the parent class
     LrWpanMac::DoDispose();
@@ -161,6 +567,7 @@ void
 RitWpanMac::McpsDataRequest(McpsDataRequestParams params, Ptr<Packet> p)
 {
     NS_LOG_FUNCTION(this << p);
+    ResumeElidedDataWait();
 
     if (!IsRitModeEnabled())
     {
@@ -174,7 +581,8 @@ RitWpanMac::McpsDataRequest(McpsDataRequestParams params, Ptr<Packet> p)
     LrWpanMacHeader macHdr(LrWpanMacHeader::LRWPAN_MAC_DATA, m_macDsn.GetValue());
     m_macDsn++;
 
-    if (p->GetSize() > lrwpan::aMaxPhyPacketSize - lrwpan::aMinMPDUOverhead)
+    if (p->GetSize() + m_frameSecurity.GetOverhead() >
+        lrwpan::aMaxPhyPacketSize - lrwpan::aMinMPDUOverhead)
     {
         NS_LOG_ERROR(this << " packet too big: " << p->GetSize());
         confirmParams.m_status = MacStatus::FRAME_TOO_LONG;
@@ -259,7 +667,15 @@ RitWpanMac::McpsDataRequest(McpsDataRequestParams params, Ptr<Packet> p)
         macHdr.SetPanIdComp();
     }
 
-    macHdr.SetSecDisable();
+    if (m_frameSecurity.IsEnabled())
+    {
+        // The frame counter is taken again at each transmission (SecureTxQElement()).
+        m_frameSecurity.Secure(macHdr);
+    }
+    else
+    {
+        macHdr.SetSecDisable();
+    }
     // extract the first 3 bits in TxOptions
     int b0 = params.m_txOptions & TX_OPTION_ACK;
     int b1 = params.m_txOptions & TX_OPTION_GTS;
@@ -309,24 +725,21 @@ RitWpanMac::McpsDataRequest(McpsDataRequestParams params, Ptr<Packet> p)
         return;
     }
 
-    /*
-    * NOTE [EXPERIMENTAL / DISABLED]:
-    * The RIT sub-header was experimentally used to carry control flags
-    * (e.g., continuous transmission indication).
-    * It is currently disabled to keep the packet format minimal and
-    * preserve backward compatibility with existing evaluation scripts.
-    * This block is intentionally kept for future experimental extensions.
-    */
-    // RitSubHeader ritSubHdr;
-    // if (m_moduleConfig.continuousTxEnabled && m_txQueue.size() > 1)
-    // {
-    //     ritSubHdr.SetContinuous(true);
-    // }
-    // else
-    // {
-    //     ritSubHdr.SetContinuous(false);
-    // }
-    // p->AddHeader(ritSubHdr);
+    // *module* Continuous TX: data frames carry a RIT sub-header between the MHR and
+    // the MSDU. Its CONTINUOUS flag is set per transmission in DoSendRitData().
+    // Without the module the packet format stays minimal.
+    // The MSDU is kept apart so that DoSendRitData() can readdress the frame without
+    // parsing it again.
+    // Frame security: the MIC follows the MAC payload; it is kept with the MSDU.
+    if (m_frameSecurity.IsEnabled())
+    {
+        p->AddAtEnd(Create<Packet>(RitFrameSecurity::GetMicLength(m_frameSecurity.GetSecLevel())));
+    }
+    Ptr<const Packet> msdu = p->Copy();
+    if (m_moduleConfig.continuousTxEnabled)
+    {
+        p->AddHeader(RitSubHeader());
+    }
 
     // RIT Direct Tx
     // RIT direct transmission:
@@ -350,6 +763,25 @@ RitWpanMac::McpsDataRequest(McpsDataRequestParams params, Ptr<Packet> p)
     txQElement->txQMsduHandle = params.m_msduHandle;
     txQElement->txQPkt = p;
     EnqueueTxQElement(txQElement);
+    auto entry = m_txQueueEntries.find(PeekPointer(txQElement));
+    if (entry != m_txQueueEntries.end())
+    {
+        entry->second.macHdr = macHdr;
+        entry->second.hasSubHdr = m_moduleConfig.continuousTxEnabled;
+        entry->second.msdu = msdu;
+    }
+
+    if (m_hopLatencyEnabled)
+    {
+        RitHopLatencyRecord& record = m_hopLatency[params.m_msduHandle];
+        record.addr = GetShortAddress();
+        if (record.nwkEnqueue.IsZero())
+        {
+            // Not requested through RitSimpleRouting
+            record.nwkEnqueue = Simulator::Now();
+        }
+        StampQueueHead();
+    }
 
     if (m_ritMacMode == SLEEP_MODE)
     {
@@ -368,20 +800,14 @@ RitWpanMac::PdDataIndication(uint32_t psduLength, Ptr<Packet> p, uint8_t lqi)
         LrWpanMac::PdDataIndication(psduLength, p, lqi);
         return;
     }
+    // *module* Data wait probe: a frame heard keeps the data wait.
+    m_dataWaitActivity = true;
 
+    // The frame is only peeked here: rejected frames are never copied, and the
+    // MSDU of accepted frames is handed up as a fragment sharing the same buffer.
     bool acceptFrame;
-    Ptr<Packet> originalPkt = p->Copy(); // because we will strip headers
-
-    LrWpanMacTrailer receivedMacTrailer;
-    p->RemoveTrailer(receivedMacTrailer);
-
-    if (Node::ChecksumEnabled())
-    {
-        receivedMacTrailer.EnableFcs(true);
-    }
-
     LrWpanMacHeader receivedMacHdr;
-    p->RemoveHeader(receivedMacHdr);
+    RitFrameCodec::PeekMacHeader(p, receivedMacHdr);
 
     // From section 7.5.6.2 Reception and rejection, IEEE 802.15.4-2006
     // - Level 1 filtering: Test FCS field and reject if frame fails.
@@ -393,68 +819,31 @@ RitWpanMac::PdDataIndication(uint32_t psduLength, Ptr<Packet> p, uint8_t lqi)
     //   srcPanId = m_macPanId if only srcAddr field in Data or Command frame,accept frame if
     //   srcPanId=m_macPanId.
 
-    // Level 1 filtering: FCS check
-    if (!receivedMacTrailer.CheckFcs(p))
+    // Level 1 filtering: FCS check over the MHR and the MAC payload
+    if (Node::ChecksumEnabled())
     {
-        m_macRxDropTrace(originalPkt);
-        return;
+        LrWpanMacTrailer receivedMacTrailer;
+        p->PeekTrailer(receivedMacTrailer);
+        receivedMacTrailer.EnableFcs(true);
+        if (!receivedMacTrailer.CheckFcs(
+                p->CreateFragment(0, p->GetSize() - receivedMacTrailer.GetSerializedSize())))
+        {
+            m_macRxDropTrace(p);
+            return;
+        }
     }
 
     // Level 2 filtering: Promiscuous mode
     if (m_macPromiscuousMode)
     {
         // NOTE: Promiscuous trace is disabled in RIT for performance, enable if needed
-        // PrintPacket(originalPkt);
-        // ReceiveInPromiscuousMode(lqi, originalPkt);
+        // PrintPacket(p);
+        // ReceiveInPromiscuousMode(lqi, p);
         return;
     }
 
     // Level 3 filtering: RIT-specific reception logic
-    acceptFrame = (receivedMacHdr.GetType() != LrWpanMacHeader::LRWPAN_MAC_RESERVED);
-
-    // TODO: Support newer RIT frame versions (e.g., Frame Version 2).
-    if (acceptFrame)
-    {
-        acceptFrame = (receivedMacHdr.GetFrameVer() <= 1);
-    }
-
-    if (acceptFrame && (receivedMacHdr.GetDstAddrMode() > 1))
-    {
-        // Accept frame if one of the following is true:
-
-        // 1) Have the same macPanId
-        // 2) Is Message to all PANs
-        // 3) Is a command frame and the macPanId is not present
-        acceptFrame = (receivedMacHdr.GetDstPanId() == m_macPanId ||
-                       receivedMacHdr.GetDstPanId() == 0xffff) ||
-                      (m_macPanId == 0xffff && receivedMacHdr.IsCommand());
-    }
-
-    if (acceptFrame && (receivedMacHdr.GetDstAddrMode() == SHORT_ADDR))
-    {
-        if (receivedMacHdr.GetShortDstAddr() == m_shortAddress)
-        {
-            // unicast, for me
-            acceptFrame = true;
-        }
-        else if ((receivedMacHdr.GetShortDstAddr().IsBroadcast() ||
-                  receivedMacHdr.GetShortDstAddr().IsMulticast()) &&
-                 receivedMacHdr.IsCommand())
-        {
-            // Broadcast or multicast only command frame.
-            // Discard broadcast/multicast with the ACK bit set.
-            acceptFrame = !receivedMacHdr.IsAckReq();
-        }
-        else
-        {
-            acceptFrame = false;
-        }
-    }
-
-    if (acceptFrame && (receivedMacHdr.GetDstAddrMode() == EXT_ADDR))
-    {
-        acceptFrame = (receivedMacHdr.GetExtDstAddr() == m_macExtendedAddress);
-    }
+    acceptFrame = IsFrameAccepted(receivedMacHdr);
 
     // Check for Association Request Command in beacon-enabled CAP-based operation.
     // This logic is NOT applicable to RIT mode, but ACK-required RIT commands may be added in
@@ -471,21 +860,34 @@ RitWpanMac::PdDataIndication(uint32_t psduLength, Ptr<Packet> p, uint8_t lqi)
         NS_LOG_DEBUG("Frame not accepted: " << "Type=" << receivedMacHdr.GetType()
                                             << ", SrcAddr=" << receivedMacHdr.GetShortSrcAddr()
                                             << ", DstAddr=" << receivedMacHdr.GetShortDstAddr());
-        m_macRxDropTrace(originalPkt);
+        m_macRxDropTrace(p);
+        OverhearForeignFrame(receivedMacHdr);
+        return;
+    }
+
+    // Frame security: drop the replays of secured frames (incoming frame security).
+    if (receivedMacHdr.IsSecEnable() && receivedMacHdr.GetSrcAddrMode() == SHORT_ADDR &&
+        !m_frameSecurity.CheckFrameCounter(receivedMacHdr.GetShortSrcAddr(),
+                                           receivedMacHdr.GetFrmCounter()))
+    {
+        NS_LOG_DEBUG("Frame counter " << receivedMacHdr.GetFrmCounter() << " of "
+                                      << receivedMacHdr.GetShortSrcAddr()
+                                      << " already seen; replay dropped.");
+        m_macRxDropTrace(p);
         return;
     }
 
-    m_macRxTrace(originalPkt);
+    m_macRxTrace(p);
     if (receivedMacHdr.IsCommand())
     {
-        ReceiveCommand(lqi, originalPkt); // Process RIT Data Request command
+        ReceiveCommand(lqi, p, receivedMacHdr); // Process RIT Data Request command
     }
     else if (receivedMacHdr.IsData() && m_ritMacMode == RECEIVER_MODE)
     {
         // Trace data wait end event
         m_dataWaitTrace("end", Simulator::Now());
 
-        ReceiveData(lqi, originalPkt);
+        ReceiveData(lqi, p, receivedMacHdr);
 
         if (receivedMacHdr.IsAckReq())
         {
@@ -506,50 +908,63 @@ RitWpanMac::PdDataIndication(uint32_t psduLength, Ptr<Packet> p, uint8_t lqi)
                 // Currently we simply restart CSMA/CA after sending the ACK.
                 NS_LOG_DEBUG("Received a packet with ACK required while in CSMA. Cancel "
                              "current CSMA-CA");
-                m_preCsB->Cancel();
-                m_preCs->Cancel();
-                m_csmaCa->Cancel();
+                if (m_carrierSense)
+                {
+                    m_carrierSense->Cancel();
+                }
+                else
+                {
+                    m_csmaCa->Cancel();
+                }
             }
             // Cancel any pending MAC state change, ACKs have higher priority.
             m_setMacState.Cancel();
             ChangeMacState(MAC_IDLE);
 
-            // save received packet and LQI to process the appropriate indication/response
-            // after sending ACK (PD-DATA.confirm)
-            m_rxPkt = originalPkt->Copy();
+            // The data frame was already indicated by ReceiveData(), so unlike LrWpanMac,
+            // the frame is not kept in m_rxPkt for PD-DATA.confirm of the ACK.
             m_lastRxFrameLqi = lqi;
+            m_framePendingRx = receivedMacHdr.IsFrmPend();
+
+            // Real-time runs: the ACK is due one turnaround after the end of the frame.
+            if (RitRealtimeMonitor::IsEnabled())
+            {
+                const Time turnaround = Seconds(static_cast<double>(lrwpan::aTurnaroundTime) /
+                                                m_phy->GetDataOrSymbolRate(false));
+                static const uint32_t ackTurnaround =
+                    RitRealtimeMonitor::RegisterHandler("RitWpanMac::AckTurnaround", turnaround);
+                RitRealtimeMonitor::RecordLateness(ackTurnaround, Simulator::Now());
+            }
+            // *module* ACK appointments, header IEs: the ACK carries a payload.
+            if (m_moduleConfig.ackAppointmentsEnabled || m_moduleConfig.headerIesEnabled)
+            {
+                m_setMacState = Simulator::ScheduleNow(&RitWpanMac::SendRitAck,
+                                                       this,
+                                                       receivedMacHdr.GetSeqNum());
+            }
+            else
+            {
+                m_setMacState =
+                    Simulator::ScheduleNow(&LrWpanMac::SendAck, this, receivedMacHdr.GetSeqNum());
+            }
 
-            /*
-            * NOTE [EXPERIMENTAL / DISABLED]:
-            * Reception-side handling of the RIT sub-header was experimentally implemented
-            * to inspect control flags such as continuous transmission indication.
-            *
-            * This logic is currently disabled to keep the receive path aligned with
-            * the minimal packet format used in the evaluation.
-            * The code is preserved for future experimental extensions and debugging.
-            */
-            // RitSubHeader ritSubHdr;
-            // p->RemoveHeader(ritSubHdr);
-            // if (ritSubHdr.isContinuous())
-            // {
-            //     m_continuousRxEnabled = true; // Enable continuous reception
-            // }
-
-            m_setMacState =
-                Simulator::ScheduleNow(&LrWpanMac::SendAck, this, receivedMacHdr.GetSeqNum());
-
-            // extend Receiver Timeout
-            m_ritDataWaitTimeout.Cancel();
-            m_ritDataWaitTimeout = Simulator::Schedule(GetRitDataWaitDurationTime(),
-                                                       &RitWpanMac::ReceiverCycleTimeout,
-                                                       this);
+            // extend Receiver Timeout (re-armed in place)
+            m_ritTimers.Schedule(RIT_DATA_WAIT_TIMER, GetRitDataWaitDurationTime());
             return;
         }
-        // else if (m_continuousRxEnabled)
-        // {
-        //     return;
-        // }
-        else
+        else if (m_continuousRxEnabled)
+        {
+            // *module* Continuous TX: the sender announced more data; keep listening.
+            m_ritTimers.Schedule(RIT_DATA_WAIT_TIMER, GetContinuousTxTimeoutTime());
+        }
+        else if (receivedMacHdr.GetDstAddrMode() == SHORT_ADDR &&
+                 receivedMacHdr.GetShortDstAddr().IsBroadcast())
+        {
+            // A broadcast frame may answer the beacon of another node: the data wait
+            // runs on for a frame addressed to this one.
+            NS_LOG_DEBUG("Broadcast data received; data wait continues.");
+        }
+        else if (!ContinueContentionSlots())
         {
             EndReceiverCycle(); // Set the MAC state to sleep mode after data reception
         }
@@ -560,24 +975,31 @@ RitWpanMac::PdDataIndication(uint32_t psduLength, Ptr<Packet> p, uint8_t lqi)
         if (m_ritMacMode == RECEIVER_MODE)
         {
             NS_LOG_DEBUG("Received multipurpose frame, extend the data wait time.");
-            m_ritDataWaitTimeout.Cancel(); // Cancel the current data wait timeout
+            // The current data wait timeout is replaced.
             // TODO M: set current extend data wait time
-            m_ritDataWaitTimeout = Simulator::Schedule(GetContinuousTxTimeoutTime(),
-                                                       &RitWpanMac::ReceiverCycleTimeout,
-                                                       this);
+            m_ritTimers.Schedule(RIT_DATA_WAIT_TIMER, GetContinuousTxTimeoutTime());
         }
     }
     else if (receivedMacHdr.IsAcknowledgment() && m_txPkt && m_macState == MAC_ACK_PENDING)
     {
         LrWpanMacHeader peekedMacHdr;
-        m_txPkt->PeekHeader(peekedMacHdr);
+        RitFrameCodec::PeekMacHeader(m_txPkt, peekedMacHdr);
         // If it is an ACK with the expected sequence number, finish the transmission
         if (receivedMacHdr.GetSeqNum() == peekedMacHdr.GetSeqNum())
         {
             NS_LOG_DEBUG("Ack received");
             m_ritSending = false;      // Clear the sending flag
             m_ackWaitTimeout.Cancel(); // Cancel the ACK wait timeout
+            // A frame train wakes this receiver next time the queue is deep.
+            m_hybridPeer = peekedMacHdr.GetShortDstAddr();
+            m_hybridPeerValid = true;
+            // *module* ACK appointments, header IEs: read the payload of the ACK.
+            if (m_moduleConfig.ackAppointmentsEnabled || m_moduleConfig.headerIesEnabled)
+            {
+                ReceiveAckPayload(GetMacPayload(p, receivedMacHdr), m_hybridPeer);
+            }
             m_macTxOkTrace(m_txPkt);
+            FinishHopLatency(true);
 
             if (!m_mcpsDataConfirmCallback.IsNull())
             {
@@ -590,22 +1012,235 @@ RitWpanMac::PdDataIndication(uint32_t psduLength, Ptr<Packet> p, uint8_t lqi)
 
             m_setMacState.Cancel();
             m_setMacState = Simulator::ScheduleNow(&LrWpanMac::SetLrWpanMacState, this, MAC_IDLE);
-            // if (m_moduleConfig.continuousTxEnabled && m_txQueue.size() > 0)
-            // {
-            //     // TODO: Consider IFS handling before sending the next packet.
-            //     NS_LOG_DEBUG("RIT continuous transmission enabled, waiting for next packet.");
-            //     DoSendRitData();
-            //     return;
-            // }
+            Time ifsWaitTime =
+                Seconds(static_cast<double>(GetIfsSize()) / m_phy->GetDataOrSymbolRate(false));
             RemoveFirstTxQElement();
+            if ((m_ritMacMode == STROBE_MODE && !m_txQueue.empty() && !IsBroadcastHead()) ||
+                ContinueBurst())
+            {
+                // *module* Continuous TX, or the burst of a frame train: the next frame
+                // follows after the IFS.
+                m_ifsEvent = Simulator::Schedule(ifsWaitTime,
+                                                 &RitWpanMac::IfsWaitTimeout,
+                                                 this,
+                                                 ifsWaitTime);
+                return;
+            }
             EndSenderCycle();
         }
         else
         {
             // TODO: check mac sequence
             // WARN: i don't care about mac sequence is correct or not.
-            // LrWpanMac::PdDataIndication(psduLength, originalPkt, lqi);
+            // LrWpanMac::PdDataIndication(psduLength, p, lqi);
+        }
+    }
+}
+
+bool
+RitWpanMac::IsFrameAccepted(const LrWpanMacHeader& macHdr) const
+{
+    bool acceptFrame = (macHdr.GetType() != LrWpanMacHeader::LRWPAN_MAC_RESERVED);
+
+    // TODO: Support newer RIT frame versions (e.g., Frame Version 2).
+    if (acceptFrame)
+    {
+        acceptFrame = (macHdr.GetFrameVer() <= 1);
+    }
+
+    if (acceptFrame && (macHdr.GetDstAddrMode() > 1))
+    {
+        // Accept frame if one of the following is true:
+
+        // 1) Have the same macPanId
+        // 2) Is Message to all PANs
+        // 3) Is a command frame and the macPanId is not present
+        acceptFrame = (macHdr.GetDstPanId() == m_macPanId || macHdr.GetDstPanId() == 0xffff) ||
+                      (m_macPanId == 0xffff && macHdr.IsCommand());
+    }
+
+    if (acceptFrame && (macHdr.GetDstAddrMode() == SHORT_ADDR))
+    {
+        if (macHdr.GetShortDstAddr() == m_shortAddress)
+        {
+            // unicast, for me
+            acceptFrame = true;
+        }
+        else if ((macHdr.GetShortDstAddr().IsBroadcast() ||
+                  macHdr.GetShortDstAddr().IsMulticast()) &&
+                 (macHdr.IsCommand() || macHdr.IsData()))
+        {
+            // Broadcast or multicast command frame, or RIT broadcast data.
+            // Discard broadcast/multicast with the ACK bit set.
+            acceptFrame = !macHdr.IsAckReq();
+        }
+        else
+        {
+            acceptFrame = false;
+        }
+    }
+
+    if (acceptFrame && (macHdr.GetDstAddrMode() == EXT_ADDR))
+    {
+        acceptFrame = (macHdr.GetExtDstAddr() == m_macExtendedAddress);
+    }
+
+    return acceptFrame;
+}
+
+bool
+RitWpanMac::PdHeaderIndication(Ptr<const Packet> p, const LrWpanMacHeader& macHdr, Time remaining)
+{
+    NS_LOG_FUNCTION(this << p << remaining);
+    // *module* Data wait probe: a frame heard keeps the data wait.
+    m_dataWaitActivity = true;
+
+    // Level 1 (FCS) filtering needs the whole frame: accepted frames are checked
+    // again at PD-DATA.indication.
+    if (!IsRitModeEnabled() || m_macPromiscuousMode || IsFrameAccepted(macHdr))
+    {
+        return true;
+    }
+
+    NS_LOG_DEBUG("Frame rejected after the MAC header: Type=" << macHdr.GetType()
+                                                               << ", DstAddr="
+                                                               << macHdr.GetShortDstAddr());
+    m_macRxDropTrace(p);
+    if (m_moduleConfig.overhearingAvoidanceEnabled)
+    {
+        Simulator::ScheduleNow(&RitWpanMac::OverhearForeignFrame, this, macHdr);
+    }
+
+    // Nothing else can be received before the end of this frame: sleep meanwhile
+    // when waiting for data. The PHY releases the receiver first, hence ScheduleNow.
+    Time turnaround = Seconds(static_cast<double>(lrwpan::aTurnaroundTime) /
+                              m_phy->GetDataOrSymbolRate(false));
+    if (m_ritMacMode == RECEIVER_MODE && m_macState == MAC_IDLE && !m_rxAlwaysOn &&
+        remaining > turnaround)
+    {
+        m_earlyRxAbortEvent.Cancel();
+        m_earlyRxAbortEvent = Simulator::ScheduleNow(&RitWpanMac::SleepUntilFrameEnd,
+                                                     this,
+                                                     remaining - turnaround);
+    }
+    return false;
+}
+
+void
+RitWpanMac::SleepUntilFrameEnd(Time remaining)
+{
+    NS_LOG_FUNCTION(this << remaining);
+
+    if (m_ritMacMode != RECEIVER_MODE || m_macState != MAC_IDLE ||
+        !m_ritTimers.IsPending(RIT_DATA_WAIT_TIMER))
+    {
+        return;
+    }
+    m_phy->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_TRX_OFF);
+    m_ritTimers.Schedule(RIT_RX_RESUME_TIMER, remaining);
+}
+
+void
+RitWpanMac::ResumeRx()
+{
+    NS_LOG_FUNCTION(this);
+
+    // The data wait may have ended (sleep or sender cycle) in the meantime.
+    if (m_ritMacMode == RECEIVER_MODE && m_macState == MAC_IDLE &&
+        m_ritTimers.IsPending(RIT_DATA_WAIT_TIMER))
+    {
+        m_phy->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_RX_ON);
+    }
+}
+
+void
+RitWpanMac::OverhearForeignFrame(LrWpanMacHeader macHdr)
+{
+    NS_LOG_FUNCTION(this);
+
+    if (!m_moduleConfig.overhearingAvoidanceEnabled || m_rxAlwaysOn ||
+        m_macState != MAC_IDLE || !(macHdr.IsData() || macHdr.IsMultipurpose()) ||
+        macHdr.GetDstAddrMode() != SHORT_ADDR || macHdr.GetShortDstAddr().IsBroadcast() ||
+        macHdr.GetShortDstAddr().IsMulticast())
+    {
+        return;
+    }
+    const Mac16Address peer = macHdr.GetShortDstAddr();
+
+    // *module* Overhearing avoidance: the neighbour whose beacon we heard is now busy with
+    // another sender. A data frame names it; a beacon ACK (no source address) answers the
+    // last beacon heard.
+    if (m_ritMacMode == RECEIVER_MODE)
+    {
+        if (!m_ritTimers.IsPending(RIT_DATA_WAIT_TIMER) || m_beaconAnswered ||
+            m_continuousRxEnabled || !m_overheardBeaconValid ||
+            (macHdr.IsData() && peer != m_overheardBeaconSrc))
+        {
+            return;
         }
+        NS_LOG_DEBUG("Rendezvous of " << m_overheardBeaconSrc << " overheard; end the data wait.");
+        m_nOverheardRxShortcuts++;
+        m_dataWaitTrace("overheard", Simulator::Now());
+        EndReceiverCycle();
+        return;
+    }
+
+    // *module* Overhearing avoidance: another sender got the beacon of our receiver. Sleep
+    // until its next beacon instead of listening for the rest of TWD.
+    if (m_ritMacMode != SENDER_MODE || m_ritSending || m_txQueue.empty() || !macHdr.IsData() ||
+        m_moduleConfig.beaconRandomizeEnabled)
+    {
+        return;
+    }
+    LrWpanMacHeader headHdr;
+    RitFrameCodec::PeekMacHeader(m_txQueue.front()->txQPkt, headHdr);
+    if (headHdr.GetDstAddrMode() != SHORT_ADDR || headHdr.GetShortDstAddr() != peer)
+    {
+        return;
+    }
+
+    m_phaseTarget = peer;
+    m_phaseTargetValid = true;
+    Time wakeDelay;
+    Time window;
+    if (!PredictTargetBeacon(wakeDelay, window))
+    {
+        // The data frame followed a beacon by less than DWD: the next one is due about one
+        // RIT period after it.
+        const Time dataWait = GetRitDataWaitDurationTime();
+        wakeDelay = GetRitPeriodTime() - dataWait - m_phaseLockGuard;
+        window = dataWait + m_phaseLockGuard * 2;
+    }
+    if (!wakeDelay.IsStrictlyPositive())
+    {
+        return;
+    }
+
+    NS_LOG_DEBUG("Receiver " << peer << " busy; beacon wait deferred by "
+                             << wakeDelay.As(Time::MS));
+    m_nOverheardTxDeferrals++;
+    m_beaconWaitTrace("deferred", Simulator::Now());
+    m_ritTimers.Cancel(RIT_TX_WAIT_TIMER);
+    m_phaseLockTxWait = window;
+    m_ritTimers.Schedule(RIT_PHASE_WAKE_TIMER, wakeDelay);
+    SetSleep();
+}
+
+void
+RitWpanMac::ConfigureHeaderIndication()
+{
+    if (!m_phy)
+    {
+        return;
+    }
+    if (m_moduleConfig.earlyRxAbortEnabled)
+    {
+        m_phy->SetPdHeaderIndicationCallback(MakeCallback(&RitWpanMac::PdHeaderIndication, this));
+    }
+    else
+    {
+        m_phy->SetPdHeaderIndicationCallback(
+            MakeNullCallback<bool, Ptr<const Packet>, const LrWpanMacHeader&, Time>());
     }
 }
 
@@ -627,7 +1262,18 @@ RitWpanMac::PdDataConfirm(PhyEnumeration status)
     // NOTE: symbolRate can be used to compute IFS durations if needed.
     // symbolRate = m_phy->GetDataOrSymbolRate(false); // symbols per second
 
-    m_txPkt->PeekHeader(macHdr);
+    const uint32_t macHdrSize = RitFrameCodec::PeekMacHeader(m_txPkt, macHdr);
+
+    // TX airtime.
+    if (status == IEEE_802_15_4_PHY_SUCCESS)
+    {
+        const Time airtime = GetFrameAirtime(m_txPkt->GetSize());
+        m_txAirtime += airtime;
+        if (m_airtimeBudget.IsEnabled())
+        {
+            m_airtimeBudget.Record(Simulator::Now(), airtime);
+        }
+    }
 
     if (status == IEEE_802_15_4_PHY_SUCCESS)
     {
@@ -635,13 +1281,10 @@ RitWpanMac::PdDataConfirm(PhyEnumeration status)
         {
             if (macHdr.IsCommand())
             {
-                Ptr<Packet> txOriginalPkt = m_txPkt->Copy();
-                LrWpanMacHeader txMacHdr;
-                txOriginalPkt->RemoveHeader(txMacHdr);
-                CommandPayloadHeader txMacPayload;
-                txOriginalPkt->RemoveHeader(txMacPayload);
+                const CommandPayloadHeader::MacCommand txCommand =
+                    RitFrameCodec::PeekCommandType(m_txPkt, macHdrSize);
 
-                if (txMacPayload.GetCommandFrameType() == CommandPayloadHeader::RIT_DATA_REQ)
+                if (txCommand == CommandPayloadHeader::RIT_DATA_REQ)
                 {
                     // NS_ASSERT(m_csmaCa->IsUnSlottedCsmaCa());
                     NS_LOG_DEBUG("RIT request command transmitted successfully.");
@@ -649,16 +1292,36 @@ RitWpanMac::PdDataConfirm(PhyEnumeration status)
                     // Trace data wait start event.
                     m_dataWaitTrace("start", Simulator::Now());
 
+                    // *module* Idle-cycle elision: nothing happened around this node during
+                    // the beacon and nothing can during the data wait, so skip it.
+                    if (m_idleCyclePhase == IDLE_CYCLE_BEACON)
+                    {
+                        if (CanElideDataWait())
+                        {
+                            ElideDataWait();
+                            return;
+                        }
+                        EndIdleCycleWatch();
+                    }
+
                     // TODO: Adjust behavior depending on whether RIT-LE is used.
                     StartRitDataWaitPeriod(); // Start the RIT data wait period.
                     m_lastDataTxStartTime = Simulator::Now();
+
+                    // *module* Fused TRX: StartRitDataWaitPeriod() already set the MAC
+                    // to IDLE with RX_ON pending, so the deferred MAC_IDLE is redundant.
+                    if (m_moduleConfig.fusedTrxEnabled)
+                    {
+                        m_setMacState.Cancel();
+                        return;
+                    }
                 }
                 else
                 {
                     NS_LOG_DEBUG(
                         "error! RIT request command not sent, but PdDataConfirm called with "
                         "status SUCCESS."
-                        << txMacPayload.GetCommandFrameType());
+                        << txCommand);
                 }
             }
             else if (macHdr.IsData())
@@ -669,6 +1332,18 @@ RitWpanMac::PdDataConfirm(PhyEnumeration status)
                     NS_LOG_DEBUG("RIT data transmission completed successfully, waiting for ACK.");
                     Time waitTime = Seconds(static_cast<double>(GetMacAckWaitDuration()) /
                                             m_phy->GetDataOrSymbolRate(false));
+                    // *module* ACK appointments, header IEs: the ACK is longer by its payload.
+                    if (m_moduleConfig.headerIesEnabled)
+                    {
+                        waitTime += GetFrameAirtime(ACK_FRAME_SIZE + MAX_ACK_IE_SIZE) -
+                                    GetFrameAirtime(ACK_FRAME_SIZE);
+                    }
+                    else if (m_moduleConfig.ackAppointmentsEnabled)
+                    {
+                        const uint32_t apptSize = RitAppointmentHeader().GetSerializedSize();
+                        waitTime += GetFrameAirtime(ACK_FRAME_SIZE + apptSize) -
+                                    GetFrameAirtime(ACK_FRAME_SIZE);
+                    }
                     NS_ASSERT(m_ackWaitTimeout.IsExpired());
                     m_ackWaitTimeout =
                         Simulator::Schedule(waitTime, &RitWpanMac::AckWaitTimeout, this);
@@ -679,11 +1354,32 @@ RitWpanMac::PdDataConfirm(PhyEnumeration status)
                     NS_LOG_DEBUG("end ack wait timeout scheduled");
                     return;
                 }
+                else if (macHdr.GetDstAddrMode() == SHORT_ADDR &&
+                         macHdr.GetShortDstAddr().IsBroadcast())
+                {
+                    // Broadcast: the frame stays queued for the other beacons of its hold.
+                    NS_LOG_DEBUG("RIT broadcast answered the beacon of "
+                                 << m_lastRxRitReqFrameSrcAddr);
+                    m_ritSending = false;
+                    m_macTxOkTrace(m_txPkt);
+                    m_broadcastServed.insert(m_lastRxRitReqFrameSrcAddr);
+                    m_nBroadcastTx++;
+                    m_broadcastTxTrace(m_txPkt, m_lastRxRitReqFrameSrcAddr);
+                    if (m_broadcastHoldEnd.IsZero())
+                    {
+                        // Sent in a burst: the hold starts with this first beacon.
+                        m_broadcastHoldEnd = Simulator::Now() + GetBroadcastHoldTime();
+                    }
+                    NS_ASSERT(m_ritTimers.IsExpired(RIT_TX_WAIT_TIMER));
+                    m_ritTimers.Schedule(RIT_TX_WAIT_TIMER,
+                                         std::max(m_broadcastHoldEnd - Simulator::Now(), Time()));
+                }
                 else
                 {
                     NS_LOG_DEBUG("RIT data transmission completed successfully (no ACK required).");
                     m_ritSending = false; // Clear the sending flag.
                     m_macTxOkTrace(m_txPkt);
+                    FinishHopLatency(false);
 
                     if (!m_mcpsDataConfirmCallback.IsNull())
                     {
@@ -694,19 +1390,20 @@ RitWpanMac::PdDataConfirm(PhyEnumeration status)
                         m_mcpsDataConfirmCallback(confirmParams);
                     }
 
-                    if (m_moduleConfig.continuousTxEnabled && m_txQueue.size() > 0)
-                    {
-                        NS_LOG_DEBUG(
-                            "RIT continuous transmission enabled, waiting for next packet.");
-                        // TODO: Consider IFS handling before sending the next packet.
-                        DoSendRitData();
-                        return;
-                    }
-
                     // Handle RIT data transmission completion.
-                    NS_ASSERT(m_ritTxWaitTimeout.IsExpired());
+                    NS_ASSERT(m_ritTimers.IsExpired(RIT_TX_WAIT_TIMER));
+                    Time burstIfsTime = Seconds(static_cast<double>(GetIfsSize()) /
+                                                m_phy->GetDataOrSymbolRate(false));
                     RemoveFirstTxQElement(); // Remove the first element from the Tx queue.
-                    EndSenderCycle();
+                    if (ContinueBurst())
+                    {
+                        // *module* Continuous TX: the next frame follows after the IFS.
+                        ifsWaitTime = burstIfsTime;
+                    }
+                    else
+                    {
+                        EndSenderCycle();
+                    }
                 }
             }
             else if (macHdr.IsMultipurpose())
@@ -727,22 +1424,28 @@ RitWpanMac::PdDataConfirm(PhyEnumeration status)
             // Clear the packet buffer for the ACK packet sent.
             m_txPkt = nullptr;
 
-            // RIT module: continuous transmission handling.
-            if (m_moduleConfig.continuousTxEnabled && m_continuousRxEnabled)
+            // *module* Continuous TX: the sender announced more data, in the RIT sub-header
+            // or with the frame pending bit; listen for it (the MAC returns to IDLE with
+            // RX_ON below).
+            if ((m_moduleConfig.continuousTxEnabled && m_continuousRxEnabled) ||
+                m_framePendingRx)
             {
-                m_ritDataWaitTimeout = Simulator::Schedule(GetContinuousTxTimeoutTime(),
-                                                           &RitWpanMac::ReceiverCycleTimeout,
-                                                           this);
-                return;
+                m_ritTimers.Schedule(RIT_DATA_WAIT_TIMER, GetContinuousTxTimeoutTime());
+            }
+            else if (!ContinueContentionSlots())
+            {
+                // End the receiver cycle after successfully transmitting an ACK.
+                EndReceiverCycle();
             }
-
-            // End the receiver cycle after successfully transmitting an ACK.
-            EndReceiverCycle();
         }
     }
     else
     {
         NS_LOG_DEBUG("RIT data transmission failed with status: " << status);
+        if (m_idleCyclePhase == IDLE_CYCLE_BEACON)
+        {
+            EndIdleCycleWatch();
+        }
         m_macTxDropTrace(m_txPkt);
         m_txPkt = nullptr; // Clear the packet buffer.
     }
@@ -781,18 +1484,33 @@ RitWpanMac::PlmeSetTRXStateConfirm(PhyEnumeration status)
     else if (m_macState == MAC_CSMA &&
              (status == IEEE_802_15_4_PHY_RX_ON || status == IEEE_802_15_4_PHY_SUCCESS))
     {
-        // Start CSMA-related processing as soon as the receiver is enabled.
+        // Start the carrier-sense stage of the frame as soon as the receiver is enabled.
         LrWpanMacHeader macHdr;
-        m_txPkt->PeekHeader(macHdr);
+        RitFrameCodec::PeekMacHeader(m_txPkt, macHdr);
 
-        if ((macHdr.IsCommand() && m_moduleConfig.beaconPreCsEnabled) ||
-            (macHdr.IsData() && m_moduleConfig.dataPreCsEnabled))
+        const RitCarrierSenseFrame frame =
+            macHdr.IsCommand() ? RIT_CS_BEACON_FRAME : RIT_CS_DATA_FRAME;
+        if (m_carrierSense && m_carrierSense->IsEnabled(frame))
         {
-            NS_LOG_DEBUG("Start Pre-CS");
-            m_preCs->Start();
+            NS_LOG_DEBUG("Start carrier sense");
+            m_carrierSense->Start(frame);
             return;
         }
     }
+    else if (m_macState == MAC_SENDING && IsSenderMode() && m_hopLatencyEnabled &&
+             (status == IEEE_802_15_4_PHY_TX_ON || status == IEEE_802_15_4_PHY_SUCCESS))
+    {
+        LrWpanMacHeader macHdr;
+        RitFrameCodec::PeekMacHeader(m_txPkt, macHdr);
+        RitHopLatencyRecord* record = GetHeadHopLatency();
+        if (macHdr.IsData() && record)
+        {
+            // Tag a copy so that a retransmission of the queued frame is tagged only once.
+            record->phyTxStart = Simulator::Now();
+            m_txPkt = m_txPkt->Copy();
+            m_txPkt->AddByteTag(RitHopLatencyTag(*record));
+        }
+    }
 
     // Fall back to the base LrWpanMac implementation.
     LrWpanMac::PlmeSetTRXStateConfirm(status);
@@ -818,6 +1536,7 @@ RitWpanMac::PlmeSetTRXStateConfirm(PhyEnumeration status)
 void
 RitWpanMac::MlmeSetRequest(MacPibAttributeIdentifier id, Ptr<MacPibAttributes> attribute)
 {
+    ResumeElidedDataWait();
     MlmeSetConfirmParams confirmParams;
     confirmParams.m_status = MacStatus::SUCCESS;
 
@@ -832,7 +1551,10 @@ RitWpanMac::MlmeSetRequest(MacPibAttributeIdentifier id, Ptr<MacPibAttributes> a
 
             if (m_macRitPeriod == 0u)
             {
-                StopRitCycle();
+                if (m_ritMacMode != RIT_MODE_DISABLED)
+                {
+                    StopRitCycle();
+                }
             }
             else if (m_ritMacMode == RIT_MODE_DISABLED)
             {
@@ -850,16 +1572,21 @@ RitWpanMac::MlmeSetRequest(MacPibAttributeIdentifier id, Ptr<MacPibAttributes> a
         else if (id == static_cast<MacPibAttributeIdentifier>(macRitRequestPayload))
         {
             m_macRitRequestPayload = attribute->macRitRequestPayload;
+            m_ritDataRequestTemplate = nullptr;
         }
         else if (id == static_cast<MacPibAttributeIdentifier>(macRitPeriodTime))
         {
             // Apply the new value first, then start/stop the RIT cycle accordingly.
             m_macRitPeriodTime = attribute->macRitPeriodTime;
+            m_nominalRitPeriodTime = m_macRitPeriodTime;
 
             if (m_macRitPeriodTime.Get().IsZero())
             {
-                NS_LOG_DEBUG("RIT period time set to zero, stopping RIT cycle.");
-                StopRitCycle();
+                if (m_ritMacMode != RIT_MODE_DISABLED)
+                {
+                    NS_LOG_DEBUG("RIT period time set to zero, stopping RIT cycle.");
+                    StopRitCycle();
+                }
             }
             else if (m_ritMacMode == RIT_MODE_DISABLED)
             {
@@ -891,6 +1618,30 @@ RitWpanMac::MlmeSetRequest(MacPibAttributeIdentifier id, Ptr<MacPibAttributes> a
     }
 }
 
+void
+RitWpanMac::SetRitTimes(Time period, Time dataWaitDuration, Time txWaitDuration)
+{
+    NS_LOG_FUNCTION(this << period << dataWaitDuration << txWaitDuration);
+    ResumeElidedDataWait();
+    m_macRitDataWaitDurationTime = dataWaitDuration;
+    m_macRitTxWaitDurationTime = txWaitDuration;
+    m_macRitPeriodTime = period;
+    m_nominalRitPeriodTime = period;
+
+    if (period.IsZero())
+    {
+        if (m_ritMacMode != RIT_MODE_DISABLED)
+        {
+            NS_LOG_DEBUG("RIT period time set to zero, stopping RIT cycle.");
+            StopRitCycle();
+        }
+    }
+    else if (m_ritMacMode == RIT_MODE_DISABLED)
+    {
+        StartRitCycle();
+    }
+}
+
 /**
  * Handle MLME-GET.request for RIT-specific PIB-like attributes.
  *
@@ -983,9 +1734,30 @@ RitWpanMac::IfsWaitTimeout(Time ifsTime)
 
     m_macIfsEndTrace(ifsTime);
 
+    if (m_ritMacMode == STROBE_MODE)
+    {
+        // The next frame of the burst; a train again if the receiver went to sleep.
+        m_strobeEnd = Simulator::Now() + GetStrobeTrainTime();
+        m_ritSending = true;
+        PruneHopLatency();
+        StampQueueHead();
+        if (IsHeadOverAirtimeBudget())
+        {
+            EndSenderCycle();
+            return;
+        }
+        SendStrobe();
+        return;
+    }
     if (m_ritMacMode == SENDER_MODE)
     {
         NS_LOG_DEBUG("RIT continuous transmission or beacon ACK enabled; sending next packet.");
+        if (IsHeadOverAirtimeBudget())
+        {
+            // The rest of the burst waits for a later sender cycle.
+            EndSenderCycle();
+            return;
+        }
         NS_ASSERT((m_moduleConfig.continuousTxEnabled || m_moduleConfig.beaconAckEnabled) &&
                   m_txQueue.size() > 0);
         DoSendRitData(); // Immediately transmit the next RIT data frame
@@ -1014,6 +1786,14 @@ RitWpanMac::SetLrWpanMacState(MacState macState)
         return;
     }
 
+    if (m_macState == MAC_CSMA && macState == CHANNEL_IDLE && IsSenderMode())
+    {
+        if (RitHopLatencyRecord* record = GetHeadHopLatency())
+        {
+            record->csEnd = Simulator::Now();
+        }
+    }
+
     if (m_macState == MAC_CSMA && macState == CHANNEL_ACCESS_FAILURE)
     {
         NS_ASSERT(m_txPkt);
@@ -1024,9 +1804,8 @@ RitWpanMac::SetLrWpanMacState(MacState macState)
 
         m_macTxDropTrace(m_txPkt);
 
-        Ptr<Packet> pkt = m_txPkt->Copy();
         LrWpanMacHeader macHdr;
-        pkt->RemoveHeader(macHdr);
+        const uint32_t macHdrSize = RitFrameCodec::PeekMacHeader(m_txPkt, macHdr);
 
         if (macHdr.IsData())
         {
@@ -1048,10 +1827,10 @@ RitWpanMac::SetLrWpanMacState(MacState macState)
         }
         else if (macHdr.IsCommand())
         {
-            CommandPayloadHeader cmdPayload;
-            pkt->RemoveHeader(cmdPayload);
+            const CommandPayloadHeader::MacCommand command =
+                RitFrameCodec::PeekCommandType(m_txPkt, macHdrSize);
 
-            switch (cmdPayload.GetCommandFrameType())
+            switch (command)
             {
             case CommandPayloadHeader::RIT_DATA_REQ:
                 NS_LOG_DEBUG("RIT Beacon CSMA failed, End Receiver Cycle.");
@@ -1065,7 +1844,7 @@ RitWpanMac::SetLrWpanMacState(MacState macState)
 
             default:
                 NS_LOG_ERROR("Unknown command frame type in RitWpanMac::SetLrWpanMacState: "
-                             << static_cast<int>(cmdPayload.GetCommandFrameType()));
+                             << static_cast<int>(command));
                 break;
             }
         }
@@ -1085,8 +1864,9 @@ void
 RitWpanMac::PeriodicRitDataRequest()
 {
     NS_LOG_FUNCTION(this);
+    ResumeElidedDataWait();
     NS_ASSERT(IsRitModeEnabled());
-    NS_ASSERT(!m_periodicRitDataRequestEvent.IsPending());
+    NS_ASSERT(!m_ritTimers.IsPending(RIT_PERIODIC_REQUEST_TIMER));
     NS_LOG_DEBUG("Periodic RIT data request initiated.");
 
     // Schedule the next beacon transmission
@@ -1100,12 +1880,16 @@ RitWpanMac::PeriodicRitDataRequest()
         NS_LOG_DEBUG("[RIT Module] Beacon interval randomized: "
                      << ritPeriodTime.As(Time::S) << " seconds.");
     }
+    // *module* Beacon de-confliction: keep clear of the learned neighbour beacons.
+    else if (m_moduleConfig.beaconDeconflictionEnabled)
+    {
+        ritPeriodTime += DeconflictBeaconPhase(ritPeriodTime);
+    }
 
-    m_periodicRitDataRequestEvent =
-        Simulator::Schedule(ritPeriodTime, &RitWpanMac::PeriodicRitDataRequest, this);
+    m_ritTimers.Schedule(RIT_PERIODIC_REQUEST_TIMER, ritPeriodTime);
 
     // Skip beacon transmission while operating in sender mode
-    if (m_ritMacMode == SENDER_MODE)
+    if (IsSenderMode())
     {
         NS_LOG_DEBUG("Currently in SENDER MODE, skipping RIT data request.");
     }
@@ -1117,37 +1901,81 @@ RitWpanMac::PeriodicRitDataRequest()
             return;
         }
 
+        // Duty-cycle limit: the beacon and the ACK of the data it invites must fit.
+        if (m_airtimeBudget.IsEnabled())
+        {
+            if (!m_ritDataRequestTemplate)
+            {
+                BuildRitDataRequestTemplate();
+            }
+            const uint32_t beaconSize = m_ritDataRequestHdr.GetSerializedSize() +
+                                        m_ritDataRequestTemplate->GetSize() + 2;
+            const bool lengthen = m_dutyCyclePolicy == RIT_DUTY_CYCLE_LENGTHEN_PERIOD;
+            const Time wait = CheckTxAirtime(
+                GetFrameAirtime(beaconSize) + GetFrameAirtime(ACK_FRAME_SIZE),
+                lengthen ? "period-lengthen" : "beacon-skip");
+            if (wait.IsStrictlyPositive())
+            {
+                if (lengthen && wait > m_ritTimers.GetDelayLeft(RIT_PERIODIC_REQUEST_TIMER))
+                {
+                    m_ritTimers.Cancel(RIT_PERIODIC_REQUEST_TIMER);
+                    m_ritTimers.Schedule(RIT_PERIODIC_REQUEST_TIMER, wait);
+                }
+                return;
+            }
+        }
+
         // In receiver mode, transmit the RIT data request as usual
         ChangeRitMacMode(RECEIVER_MODE);
+        TuneChannel(m_rxChannel);
+        m_periodLoad.beacons++;
+        m_beaconAnswered = false;
         DoSendRitDataRequest();
     }
 }
 
 void
-RitWpanMac::DoSendRitDataRequest()
+RitWpanMac::BuildRitDataRequestTemplate()
 {
     NS_LOG_FUNCTION(this);
-    NS_ASSERT(IsRitModeEnabled());
-    NS_ASSERT_MSG(m_macState == MAC_IDLE,
-                  "RIT Data Request can only be sent when MAC is in IDLE state. Now macState is "
-                      << m_macState);
 
-    // Build the packet for the RIT Data Request command.
+    // Build the command payload of the RIT Data Request.
     // If no payload is configured, transmit an empty command payload.
-    Ptr<Packet> ritDataRequestPacket = Create<Packet>();
-    if (m_macRitRequestPayload.empty())
+    if (m_moduleConfig.headerIesEnabled)
     {
-        ritDataRequestPacket = Create<Packet>();
+        // *module* Header IEs: the IE list, ended by a Header Termination 2 IE, comes first.
+        std::vector<uint8_t> payload = m_ritRequestIes.Encode(true);
+        payload.insert(payload.end(), m_macRitRequestPayload.begin(), m_macRitRequestPayload.end());
+        m_ritDataRequestTemplate = Create<Packet>(payload.data(), payload.size());
+    }
+    else if (m_macRitRequestPayload.empty())
+    {
+        m_ritDataRequestTemplate = Create<Packet>();
     }
     else
     {
-        ritDataRequestPacket =
+        m_ritDataRequestTemplate =
             Create<Packet>(m_macRitRequestPayload.data(), m_macRitRequestPayload.size());
     }
+    // Advertise the receive channel in the last payload octet, or the redirect one.
+    const uint8_t channel = m_redirectChannel != 0 ? m_redirectChannel : m_rxChannel;
+    if (channel != 0)
+    {
+        m_ritDataRequestTemplate->AddAtEnd(Create<Packet>(&channel, 1));
+    }
+    // Frame security: the MIC follows the command payload; the header is secured per beacon.
+    m_ritDataRequestSecured = m_frameSecurity.IsEnabled() && m_secureRitDataRequest;
+    if (m_ritDataRequestSecured)
+    {
+        m_ritDataRequestTemplate->AddAtEnd(
+            Create<Packet>(RitFrameSecurity::GetMicLength(m_frameSecurity.GetSecLevel())));
+    }
+    CommandPayloadHeader ritCmdHdr(CommandPayloadHeader::RIT_DATA_REQ);
+    m_ritDataRequestTemplate->AddHeader(ritCmdHdr);
 
     // Build the MAC header for the RIT Data Request command.
-    LrWpanMacHeader macHdr(LrWpanMacHeader::LRWPAN_MAC_COMMAND, m_macDsn.GetValue());
-    m_macDsn++;
+    // The sequence number is set per beacon.
+    LrWpanMacHeader macHdr(LrWpanMacHeader::LRWPAN_MAC_COMMAND, 0);
     macHdr.SetFrameVer(1);
 
     // *module* Compact RIT Data Request:
@@ -1176,9 +2004,44 @@ RitWpanMac::DoSendRitDataRequest()
     // Therefore, the RIT Data Request command itself does not request an ACK.
     macHdr.SetNoAckReq();
 
-    CommandPayloadHeader ritCmdHdr(CommandPayloadHeader::RIT_DATA_REQ);
-    ritDataRequestPacket->AddHeader(ritCmdHdr);
-    ritDataRequestPacket->AddHeader(macHdr);
+    m_ritDataRequestHdr = macHdr;
+}
+
+void
+RitWpanMac::DoSendRitDataRequest()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(IsRitModeEnabled());
+    NS_ASSERT_MSG(m_macState == MAC_IDLE,
+                  "RIT Data Request can only be sent when MAC is in IDLE state. Now macState is "
+                      << m_macState);
+
+    // The command payload and the MAC header only change with the module config,
+    // the RIT request payload or the device address; rebuild them only then.
+    if (!m_ritDataRequestTemplate ||
+        m_ritDataRequestHdr.GetShortSrcAddr() != GetShortAddress() ||
+        m_ritDataRequestHdr.GetSrcPanId() != GetPanId() ||
+        m_ritDataRequestSecured != (m_frameSecurity.IsEnabled() && m_secureRitDataRequest))
+    {
+        BuildRitDataRequestTemplate();
+    }
+
+    // Per beacon, only the DSN, the frame counter and the FCS change.
+    Ptr<Packet> ritDataRequestPacket = m_ritDataRequestTemplate->Copy();
+    if (m_redirectChannel != 0)
+    {
+        // A redirect is advertised once: the next beacon gets the own channel back.
+        m_redirectChannel = 0;
+        m_ritDataRequestTemplate = nullptr;
+        m_nBeaconRedirects++;
+    }
+    m_ritDataRequestHdr.SetSeqNum(m_macDsn.GetValue());
+    m_macDsn++;
+    if (m_ritDataRequestSecured)
+    {
+        m_frameSecurity.Secure(m_ritDataRequestHdr);
+    }
+    ritDataRequestPacket->AddHeader(m_ritDataRequestHdr);
 
     // Append FCS if ChecksumEnabled is set globally.
     LrWpanMacTrailer macTrailer;
@@ -1189,9 +2052,8 @@ RitWpanMac::DoSendRitDataRequest()
     }
     ritDataRequestPacket->AddTrailer(macTrailer);
 
-    // Transmit the beacon either with CSMA/CA (or Pre-CS variants), or directly.
-    if (m_moduleConfig.beaconCsmaEnabled || m_moduleConfig.beaconPreCsEnabled ||
-        m_moduleConfig.beaconPreCsBEnabled)
+    // Transmit the beacon either after its carrier-sense stage, or directly.
+    if (m_carrierSense && m_carrierSense->IsEnabled(RIT_CS_BEACON_FRAME))
     {
         NS_LOG_DEBUG("RIT beacon transmission with Unslotted CSMA/CA");
 
@@ -1211,10 +2073,204 @@ RitWpanMac::DoSendRitDataRequest()
         NS_LOG_DEBUG("RIT beacon transmission NO CSMA/CA");
         m_txPkt = ritDataRequestPacket;
         ChangeMacState(MAC_SENDING);
+
+        // *module* Idle-cycle elision: watch the neighbourhood during the beacon.
+        if (m_moduleConfig.idleCycleElisionEnabled)
+        {
+            StartIdleCycleWatch();
+        }
+
+        // *module* Fused TRX: skip the TX_ON request/confirm round trip and let the
+        // PHY enter RX_ON right after the beacon for the data-wait window.
+        PhyEnumeration trxState = m_phy->GetTrxState();
+        if (m_moduleConfig.fusedTrxEnabled &&
+            (trxState == IEEE_802_15_4_PHY_TRX_OFF || trxState == IEEE_802_15_4_PHY_TX_ON))
+        {
+            m_promiscSnifferTrace(m_txPkt);
+            m_snifferTrace(m_txPkt);
+            m_macTxTrace(m_txPkt);
+            m_phy->PdDataRequestThenRxOn(m_txPkt->GetSize(), m_txPkt);
+            return;
+        }
         m_phy->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_TX_ON);
     }
 }
 
+void
+RitWpanMac::StartIdleCycleWatch()
+{
+    NS_LOG_FUNCTION(this);
+
+    // A beacon still on air from the last elided cycle keeps the watch of that cycle.
+    if (m_idleCyclePhase == IDLE_CYCLE_TAIL)
+    {
+        EndIdleCycleWatch();
+    }
+    if (m_idleCyclePhase != IDLE_CYCLE_NONE || m_rxAlwaysOn || !m_senderRegistry)
+    {
+        return;
+    }
+
+    // The registry refuses the watch while a sender or an awake PHY is around; the PHY
+    // refuses the deferral when the channel cannot tell who the beacon reaches.
+    if (!m_senderRegistry->Watch(m_phy, MakeCallback(&RitWpanMac::IdleCycleInterrupted, this)))
+    {
+        return;
+    }
+    if (!m_phy->DeferNextTx())
+    {
+        m_senderRegistry->Unwatch(m_phy);
+        return;
+    }
+    NS_LOG_DEBUG("RIT beacon deferred, idle neighbourhood watched");
+    m_idleCyclePhase = IDLE_CYCLE_BEACON;
+    m_idleCycleInterrupted = false;
+}
+
+void
+RitWpanMac::IdleCycleInterrupted(Ptr<SpectrumPhy> phy)
+{
+    NS_LOG_FUNCTION(this << phy);
+
+    // The waking PHY gets what is left of the beacon before it leaves TRX_OFF.
+    if (phy)
+    {
+        m_phy->DeliverDeferredTx(phy);
+    }
+
+    switch (m_idleCyclePhase)
+    {
+    case IDLE_CYCLE_BEACON:
+        m_idleCycleInterrupted = true;
+        break;
+    case IDLE_CYCLE_DATA_WAIT:
+        ResumeElidedDataWait();
+        break;
+    case IDLE_CYCLE_TAIL:
+        if (!m_phy->IsDeferredTxOnAir())
+        {
+            EndIdleCycleWatch();
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+bool
+RitWpanMac::CanElideDataWait() const
+{
+    if (m_idleCycleInterrupted || m_rxAlwaysOn)
+    {
+        return false;
+    }
+
+    // These traces would see the node asleep instead of in its data wait.
+    if (!m_macStateLogger.IsEmpty() || !m_ritMacMode.IsEmpty() || !m_dataWaitTrace.IsEmpty() ||
+        m_phy->IsTrxStateTraced())
+    {
+        return false;
+    }
+
+    // The data wait must only wait: no slot, probe or pending exchange of this node ends it
+    // or acts during it.
+    if (m_moduleConfig.contentionSlotsEnabled || m_moduleConfig.dataWaitProbeEnabled ||
+        m_continuousRxEnabled || m_framePendingRx || !m_txQueue.empty())
+    {
+        return false;
+    }
+    if (m_ifsEvent.IsPending() || m_ackWaitTimeout.IsPending() ||
+        m_earlyRxAbortEvent.IsPending() || m_decryptEvent.IsPending())
+    {
+        return false;
+    }
+    const bool hasValidWait =
+        (m_useTimeBasedRitParams && (m_macRitDataWaitDurationTime > Seconds(0))) ||
+        (!m_useTimeBasedRitParams && (m_macRitDataWaitDuration > 0));
+    if (!hasValidWait)
+    {
+        return false;
+    }
+
+    // Only the timers that start the next cycle may run, and not before the wait is over.
+    const Time dataWaitTime = GetRitDataWaitDurationTime();
+    for (uint32_t id = 0; id < RIT_TIMER_COUNT; id++)
+    {
+        if (!m_ritTimers.IsPending(id))
+        {
+            continue;
+        }
+        if ((id != RIT_PERIODIC_REQUEST_TIMER && id != RIT_PERIOD_ADAPT_TIMER) ||
+            m_ritTimers.GetDelayLeft(id) <= dataWaitTime)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+RitWpanMac::ElideDataWait()
+{
+    NS_LOG_FUNCTION(this);
+    NS_LOG_DEBUG("RIT data wait skipped (idle neighbourhood)");
+
+    // The state the data wait would leave behind, with its RX time accounted.
+    const Time now = Simulator::Now();
+    m_elidedDataWaitEnd = now + GetRitDataWaitDurationTime();
+    m_overheardBeaconValid = false;
+    m_dataWaitActivity = false;
+    ChangeMacState(MAC_IDLE);
+    ChangeRitMacMode(SLEEP_MODE);
+    SetRxOnWhenIdle(false); // TRX_OFF once the beacon is over
+    m_phy->AccountTrxOffAs(IEEE_802_15_4_PHY_RX_ON, m_elidedDataWaitEnd);
+    m_nElidedCycles++;
+    m_lastDataTxStartTime = now;
+    m_setMacState.Cancel();
+    m_idleCyclePhase = IDLE_CYCLE_DATA_WAIT;
+}
+
+void
+RitWpanMac::ResumeElidedDataWait()
+{
+    if (m_idleCyclePhase == IDLE_CYCLE_BEACON)
+    {
+        m_idleCycleInterrupted = true;
+        return;
+    }
+    if (m_idleCyclePhase != IDLE_CYCLE_DATA_WAIT)
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this);
+    EndIdleCycleWatch();
+
+    const Time left = m_elidedDataWaitEnd - Simulator::Now();
+    if (!left.IsStrictlyPositive())
+    {
+        return;
+    }
+    NS_LOG_DEBUG("RIT data wait resumed, " << left.As(Time::MS) << " left");
+    // Straight to RX_ON: the data wait has been in RX_ON since the beacon.
+    ChangeRitMacMode(RECEIVER_MODE);
+    m_macRxOnWhenIdle = true;
+    m_phy->EnterAccountedState();
+    m_ritTimers.Schedule(RIT_DATA_WAIT_TIMER, left);
+}
+
+void
+RitWpanMac::EndIdleCycleWatch()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_phy->IsDeferredTxOnAir())
+    {
+        m_idleCyclePhase = IDLE_CYCLE_TAIL;
+        return;
+    }
+    m_senderRegistry->Unwatch(m_phy);
+    m_idleCyclePhase = IDLE_CYCLE_NONE;
+}
+
 void
 RitWpanMac::SendRitData()
 {
@@ -1224,19 +2280,34 @@ RitWpanMac::SendRitData()
 
     if (m_macState == MAC_IDLE)
     {
+        if (IsHeadOverAirtimeBudget())
+        {
+            // The frame stays queued; the beacon is left unanswered.
+            EndSenderCycle();
+            return;
+        }
         // Trace: beacon-wait period ended (a valid trigger to attempt transmission).
         m_beaconWaitTrace("end", Simulator::Now());
+        m_ritTimers.Cancel(RIT_TX_WAIT_TIMER);
         m_ritSending = true;
+        // *module* Phase learning: the sender locks on the receiver it sends to.
+        m_phaseTarget = m_lastRxRitReqFrameSrcAddr;
+        m_phaseTargetValid = true;
 
-        if (m_moduleConfig.beaconAckEnabled)
+        // *module* Contention slots: answer in the hashed slot, radio off until then.
+        if (m_moduleConfig.contentionSlotsEnabled)
         {
-            NS_LOG_DEBUG("RIT beacon ACK enabled; sending Beacon ACK (multipurpose frame) first.");
-            DoSendRitBeaconAck();
-            return;
+            const uint32_t slot = GetContentionSlot();
+            if (slot > 0)
+            {
+                NS_LOG_DEBUG("Answering the beacon of " << m_lastRxRitReqFrameSrcAddr
+                                                        << " in slot " << slot);
+                m_phy->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_TRX_OFF);
+                m_ritTimers.Schedule(RIT_CONTENTION_SLOT_TIMER, m_contentionSlotDuration * slot);
+                return;
+            }
         }
-
-        // Transmit the queued data frame (destination is set based on the last received RIT request).
-        DoSendRitData();
+        SendRitResponse();
     }
     else
     {
@@ -1246,6 +2317,54 @@ RitWpanMac::SendRitData()
     }
 }
 
+void
+RitWpanMac::SendRitResponse()
+{
+    NS_LOG_FUNCTION(this);
+
+    // The sender cycle may have ended (queue flushed, RIT stopped) while waiting for the slot.
+    if (m_ritMacMode != SENDER_MODE || !m_ritSending || m_txQueue.empty() ||
+        m_macState != MAC_IDLE)
+    {
+        return;
+    }
+
+    if (m_moduleConfig.beaconAckEnabled)
+    {
+        NS_LOG_DEBUG("RIT beacon ACK enabled; sending Beacon ACK (multipurpose frame) first.");
+        DoSendRitBeaconAck();
+        return;
+    }
+
+    // Transmit the queued data frame (destination is set based on the last received RIT request).
+    DoSendRitData();
+}
+
+uint32_t
+RitWpanMac::GetContentionSlot() const
+{
+    uint8_t addr[2];
+    GetShortAddress().CopyTo(addr);
+    // Knuth multiplicative hash of address and DSN, upper bits used.
+    uint32_t key = (static_cast<uint32_t>(addr[0]) << 16) | (static_cast<uint32_t>(addr[1]) << 8) |
+                   m_lastRxRitReqSeqNum;
+    key *= 2654435761U;
+    return (key >> 16) % m_contentionSlots;
+}
+
+bool
+RitWpanMac::ContinueContentionSlots()
+{
+    if (!m_moduleConfig.contentionSlotsEnabled || m_ritMacMode != RECEIVER_MODE ||
+        Simulator::Now() >= m_contentionSlotsEnd)
+    {
+        return false;
+    }
+    // Another slot may hold a sender: listen until the last one has had its DWD.
+    m_ritTimers.Schedule(RIT_DATA_WAIT_TIMER, m_contentionSlotsEnd - Simulator::Now());
+    return true;
+}
+
 void
 RitWpanMac::DoSendRitData()
 {
@@ -1253,38 +2372,65 @@ RitWpanMac::DoSendRitData()
     NS_ASSERT(IsRitModeEnabled() && m_ritMacMode == SENDER_MODE);
     NS_ASSERT(m_txQueue.size() > 0);
 
-    // Update the destination address of the head-of-line data frame to the sender of the
-    // most recently received RIT Data Request (i.e., the current intended receiver).
+    // Address the head-of-line data frame to the sender of the most recently received
+    // RIT Data Request (i.e., the current intended receiver).
     Ptr<TxQueueElement> txQElement = m_txQueue.front();
-    Ptr<Packet> pkt = txQElement->txQPkt->Copy();
-
-    LrWpanMacHeader macHdr;
-    pkt->RemoveHeader(macHdr);
-    macHdr.SetDstAddrMode(SHORT_ADDR);
-    macHdr.SetDstAddrFields(GetPanId(), m_lastRxRitReqFrameSrcAddr);
-    pkt->AddHeader(macHdr);
-
-    txQElement->txQPkt = pkt;
+    if (IsBroadcastHead())
+    {
+        // A broadcast frame answers every beacon of its hold as it was queued.
+        m_burstMoreData = false;
+    }
+    else
+    {
+        AddressTxQElement(txQElement);
+    }
 
     NS_LOG_DEBUG("RIT data request command from " << m_lastRxRitReqFrameSrcAddr);
     NS_LOG_DEBUG("DoSendRitData: payload size=" << txQElement->txQPkt->GetSize() << " bytes | "
-                                               << "src=" << macHdr.GetShortSrcAddr() << " | "
-                                               << "dst=" << macHdr.GetShortDstAddr());
+                                               << "dst=" << m_lastRxRitReqFrameSrcAddr);
+
+    if (m_frameSecurity.IsEnabled())
+    {
+        SecureTxQElement(txQElement);
+        // The MCU encrypts the frame before its carrier sense.
+        if (m_securityEncryptDelay.IsStrictlyPositive())
+        {
+            m_ritTimers.Schedule(RIT_ENCRYPT_TIMER, m_securityEncryptDelay);
+            return;
+        }
+    }
+    TransmitRitData();
+}
 
-    // Transmit the data either with CSMA/CA (or Pre-CS variants), or directly.
-    if (m_moduleConfig.dataCsmaEnabled || m_moduleConfig.dataPreCsEnabled ||
-        m_moduleConfig.dataPreCsBEnabled)
+void
+RitWpanMac::TransmitRitData()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_ritMacMode != SENDER_MODE || m_txQueue.empty())
     {
-        NS_ASSERT_MSG(
-            !(m_moduleConfig.dataCsmaEnabled && m_moduleConfig.dataPreCsEnabled),
-            "Only one of dataCsmaEnabled or dataPreCsEnabled can be true at the same time.");
+        return;
+    }
+    Ptr<TxQueueElement> txQElement = m_txQueue.front();
 
+    // Transmit the data either after its carrier-sense stage, or directly.
+    if (m_carrierSense && m_carrierSense->IsEnabled(RIT_CS_DATA_FRAME))
+    {
         NS_LOG_DEBUG("RIT data transmission with Unslotted CSMA/CA");
+        if (RitHopLatencyRecord* record = GetHeadHopLatency())
+        {
+            record->csStart = Simulator::Now();
+            record->csEnd = Time();
+        }
         CheckQueue();
     }
     else
     {
         NS_LOG_DEBUG("RIT data transmission NO CSMA/CA");
+        if (RitHopLatencyRecord* record = GetHeadHopLatency())
+        {
+            record->csStart = Simulator::Now();
+            record->csEnd = Simulator::Now();
+        }
         m_txPkt = txQElement->txQPkt;
         ChangeMacState(MAC_SENDING);
         m_phy->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_TX_ON);
@@ -1338,64 +2484,57 @@ RitWpanMac::DoSendRitBeaconAck()
 }
 
 void
-RitWpanMac::ReceiveCommand(uint8_t lqi, Ptr<Packet> p)
+RitWpanMac::ReceiveCommand(uint8_t lqi,
+                           Ptr<const Packet> frame,
+                           const LrWpanMacHeader& receivedMacHdr)
 {
-    NS_LOG_FUNCTION(this << lqi << p);
+    NS_LOG_FUNCTION(this << lqi << frame);
 
     NS_LOG_DEBUG("RIT command frame received; processing...");
-    LrWpanMacHeader receivedMacHdr;
-    p->RemoveHeader(receivedMacHdr);
+    Ptr<Packet> p = GetMacPayload(frame, receivedMacHdr);
 
     // Peek the command type first, then strip it only when we actually handle it.
-    CommandPayloadHeader peekedPayload;
-    p->PeekHeader(peekedPayload);
-
-    switch (peekedPayload.GetCommandFrameType())
+    switch (RitFrameCodec::PeekCommandType(p, 0))
     {
     case CommandPayloadHeader::RIT_DATA_REQ:
     {
-        if (m_ritMacMode == SENDER_MODE)
+        if (m_moduleConfig.phaseLearningEnabled || m_moduleConfig.beaconDeconflictionEnabled)
         {
-            // Ignore a new request while we are already in the middle of sending.
+            LearnBeaconPhase(receivedMacHdr.GetShortSrcAddr());
+        }
+
+        if (m_ritMacMode == SENDER_MODE)
+        {
+            // Ignore a new request while we are already in the middle of sending.
             if (m_ritSending)
             {
                 NS_LOG_DEBUG("RIT_DATA_REQ received in SENDER_MODE, but already sending; ignored.");
                 break;
             }
+            if (m_broadcastServed.count(receivedMacHdr.GetShortSrcAddr()) > 0 &&
+                IsBroadcastHead())
+            {
+                NS_LOG_DEBUG("RIT_DATA_REQ of a neighbour already given the broadcast; ignored.");
+                break;
+            }
 
-            // A valid RIT request arrived: cancel the sender wait timeout and prepare for data TX.
-            m_ritTxWaitTimeout.Cancel();
+            // A RIT request arrived; the sender wait timeout is cancelled by SendRitData() if
+            // the NWK layer answers it, and keeps running otherwise.
+            if (RitHopLatencyRecord* record = GetHeadHopLatency())
+            {
+                record->beaconRx = Simulator::Now();
+            }
 
             CommandPayloadHeader receivedRitPayload;
             p->RemoveHeader(receivedRitPayload);
-
-            MlmeRitRequestIndicationParams ritReqParams;
-
-            ritReqParams.m_srcAddrMode = receivedMacHdr.GetSrcAddrMode();
-            ritReqParams.m_srcPanId = receivedMacHdr.GetSrcPanId();
-            ritReqParams.m_srcAddr = receivedMacHdr.GetShortSrcAddr();
-            ritReqParams.m_srcExtAddr = receivedMacHdr.GetExtSrcAddr();
+            LearnRxChannel(p, receivedMacHdr.GetShortSrcAddr());
 
             // Used by DoSendRitData() to set the unicast destination.
             m_lastRxRitReqFrameSrcAddr = receivedMacHdr.GetShortSrcAddr();
+            m_lastRxRitReqSeqNum = receivedMacHdr.GetSeqNum();
 
-            ritReqParams.m_dstAddrMode = receivedMacHdr.GetDstAddrMode();
-            ritReqParams.m_dstPanId = receivedMacHdr.GetDstPanId();
-            ritReqParams.m_dstAddr = receivedMacHdr.GetShortDstAddr();
-            ritReqParams.m_dstExtAddr = receivedMacHdr.GetExtDstAddr();
-
-            std::vector<uint8_t> payload(p->GetSize());
-            p->CopyData(payload.data(), payload.size());
-            ritReqParams.m_ritRequestPayload = payload;
-
-            ritReqParams.m_linkQuality = lqi;
-            ritReqParams.m_dsn = receivedMacHdr.GetSeqNum();
-
-            // Timestamp is exported in symbols (16 us per symbol at 2.4 GHz O-QPSK).
-            ritReqParams.m_timestamp = Simulator::Now().GetMicroSeconds() / 16;
-
-            // Security-related fields are currently not populated for RIT extensions.
-            // TODO: Fill ritReqParams with security information if/when enabled.
+            MlmeRitRequestIndicationParams ritReqParams =
+                MakeRitRequestIndication(lqi, p, receivedMacHdr);
 
             if (!m_mlmeRitRequestIndicationCallback.IsNull())
             {
@@ -1411,10 +2550,26 @@ RitWpanMac::ReceiveCommand(uint8_t lqi, Ptr<Packet> p)
         {
             // Receiving RIT_DATA_REQ while being a receiver is unexpected in this implementation.
             NS_LOG_DEBUG("RIT_DATA_REQ received in RECEIVER_MODE; not handled (unexpected).");
+            // *module* Overhearing avoidance: remember whose rendezvous may follow.
+            m_overheardBeaconSrc = receivedMacHdr.GetShortSrcAddr();
+            m_overheardBeaconValid = true;
+        }
+        else if (m_ritMacMode == STROBE_MODE)
+        {
+            // The next copy of the train falls in the data wait that follows the beacon.
+            NS_LOG_DEBUG("RIT_DATA_REQ received in STROBE_MODE; ignored.");
         }
         else if (m_ritMacMode == BOOTSTRAP_MODE)
         {
-            // TODO: Define bootstrap behavior for RIT commands if needed.
+            // Every beacon heard is a candidate parent for the NWK layer; nothing is sent.
+            CommandPayloadHeader receivedRitPayload;
+            p->RemoveHeader(receivedRitPayload);
+            LearnRxChannel(p, receivedMacHdr.GetShortSrcAddr());
+            if (!m_mlmeRitRequestIndicationCallback.IsNull())
+            {
+                m_mlmeRitRequestIndicationCallback(
+                    MakeRitRequestIndication(lqi, p, receivedMacHdr));
+            }
         }
         else
         {
@@ -1436,39 +2591,110 @@ RitWpanMac::ReceiveCommand(uint8_t lqi, Ptr<Packet> p)
     }
 }
 
-void
-RitWpanMac::ReceiveData(uint8_t lqi, Ptr<Packet> p)
+MlmeRitRequestIndicationParams
+RitWpanMac::MakeRitRequestIndication(uint8_t lqi,
+                                     Ptr<const Packet> payload,
+                                     const LrWpanMacHeader& receivedMacHdr) const
 {
-    NS_LOG_FUNCTION(this << lqi << p);
+    MlmeRitRequestIndicationParams ritReqParams;
 
-    LrWpanMacTrailer receivedMacTrailer;
-    p->RemoveTrailer(receivedMacTrailer);
+    ritReqParams.m_srcAddrMode = receivedMacHdr.GetSrcAddrMode();
+    ritReqParams.m_srcPanId = receivedMacHdr.GetSrcPanId();
+    ritReqParams.m_srcAddr = receivedMacHdr.GetShortSrcAddr();
+    ritReqParams.m_srcExtAddr = receivedMacHdr.GetExtSrcAddr();
 
-    LrWpanMacHeader receivedMacHdr;
-    p->RemoveHeader(receivedMacHdr);
-
-    /*
-     * NOTE [EXPERIMENTAL / DISABLED]:
-     * Reception-side handling of the RIT sub-header was experimentally implemented
-     * to inspect control flags (e.g., continuous transmission indication).
-     *
-     * This logic is currently disabled to keep the receive path aligned with the
-     * minimal packet format used in the evaluation.
-     * The code is preserved for future experimental extensions and debugging.
-     */
-    // RitSubHeader ritSubHdr;
-    // p->RemoveHeader(ritSubHdr);
+    ritReqParams.m_dstAddrMode = receivedMacHdr.GetDstAddrMode();
+    ritReqParams.m_dstPanId = receivedMacHdr.GetDstPanId();
+    ritReqParams.m_dstAddr = receivedMacHdr.GetShortDstAddr();
+    ritReqParams.m_dstExtAddr = receivedMacHdr.GetExtDstAddr();
+
+    // *module* Header IEs: parsed ahead of the payload, which starts after them.
+    uint32_t iesSize = 0;
+    if (m_moduleConfig.headerIesEnabled)
+    {
+        if (ritReqParams.m_headerIeList.Parse(payload))
+        {
+            iesSize = ritReqParams.m_headerIeList.GetSerializedSize();
+        }
+        else
+        {
+            NS_LOG_DEBUG("Malformed header IEs in the RIT request of "
+                         << receivedMacHdr.GetShortSrcAddr());
+        }
+    }
+    std::vector<uint8_t> data(payload->GetSize());
+    payload->CopyData(data.data(), data.size());
+    data.erase(data.begin(), data.begin() + iesSize);
+    ritReqParams.m_ritRequestPayload = data;
+
+    ritReqParams.m_linkQuality = lqi;
+    ritReqParams.m_dsn = receivedMacHdr.GetSeqNum();
+
+    // Timestamp is exported in symbols (16 us per symbol at 2.4 GHz O-QPSK).
+    ritReqParams.m_timestamp = Simulator::Now().GetMicroSeconds() / 16;
+
+    // Security-related fields are currently not populated for RIT extensions.
+    // TODO: Fill ritReqParams with security information if/when enabled.
+    return ritReqParams;
+}
+
+void
+RitWpanMac::ReceiveData(uint8_t lqi,
+                        Ptr<const Packet> frame,
+                        const LrWpanMacHeader& receivedMacHdr)
+{
+    NS_LOG_FUNCTION(this << lqi << frame);
 
     NS_LOG_DEBUG("Data packet for this node; forwarding up. dst="
                  << receivedMacHdr.GetShortDstAddr() << " self=" << m_shortAddress
                  << " src=" << receivedMacHdr.GetShortSrcAddr());
 
-    if (m_ritMacMode == SENDER_MODE)
+    if (IsSenderMode())
     {
-        NS_LOG_WARN("Data received in SENDER_MODE; ignoring (possible fast mode switch).");
+        NS_LOG_WARN("Data received in " << m_ritMacMode
+                                        << "; ignoring (possible fast mode switch).");
         return;
     }
 
+    Ptr<Packet> msdu = GetMacPayload(frame, receivedMacHdr);
+
+    // *module* Continuous TX: strip the RIT sub-header and remember whether the sender
+    // has more frames for this rendezvous.
+    if (m_moduleConfig.continuousTxEnabled)
+    {
+        RitSubHeader ritSubHdr;
+        msdu->RemoveHeader(ritSubHdr);
+        m_continuousRxEnabled = ritSubHdr.isContinuous();
+        if (m_continuousRxEnabled)
+        {
+            m_periodLoad.backlogged++;
+        }
+    }
+    m_periodLoad.frames++;
+    if (m_ritMacMode == RECEIVER_MODE && !m_beaconAnswered)
+    {
+        m_beaconAnswered = true;
+        m_periodLoad.answered++;
+    }
+
+    // *module* Duplicate filter: a retry of a frame whose ACK was lost is acknowledged
+    // again, but not indicated twice.
+    if (m_moduleConfig.duplicateFilterEnabled && receivedMacHdr.GetSrcAddrMode() == SHORT_ADDR)
+    {
+        const uint32_t key =
+            (static_cast<uint32_t>(receivedMacHdr.GetShortSrcAddr().ConvertToInt()) << 8) |
+            receivedMacHdr.GetSeqNum();
+        if (!m_rxDuplicates.Insert(key, Simulator::Now()))
+        {
+            NS_LOG_DEBUG("Data frame " << +receivedMacHdr.GetSeqNum() << " of "
+                                       << receivedMacHdr.GetShortSrcAddr()
+                                       << " already received; not indicated.");
+            m_nRxDuplicates++;
+            m_macRxDuplicateTrace(frame);
+            return;
+        }
+    }
+
     if (!m_mcpsDataIndicationCallback.IsNull())
     {
         McpsDataIndicationParams params;
@@ -1503,8 +2729,76 @@ RitWpanMac::ReceiveData(uint8_t lqi, Ptr<Packet> p)
             break;
         }
 
-        m_mcpsDataIndicationCallback(params, p);
+        // Frame security: the MCU decrypts the secured frames one after the other.
+        if (receivedMacHdr.IsSecEnable() && m_securityDecryptDelay.IsStrictlyPositive())
+        {
+            m_decryptQueue.emplace_back(params, msdu);
+            if (!m_decryptEvent.IsPending())
+            {
+                m_decryptEvent =
+                    Simulator::Schedule(m_securityDecryptDelay, &RitWpanMac::DecryptionDone, this);
+            }
+            return;
+        }
+        m_mcpsDataIndicationCallback(params, msdu);
+    }
+}
+
+void
+RitWpanMac::DecryptionDone()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!m_decryptQueue.empty());
+    auto [params, msdu] = std::move(m_decryptQueue.front());
+    m_decryptQueue.pop_front();
+    if (!m_decryptQueue.empty())
+    {
+        m_decryptEvent =
+            Simulator::Schedule(m_securityDecryptDelay, &RitWpanMac::DecryptionDone, this);
+    }
+    if (!m_mcpsDataIndicationCallback.IsNull())
+    {
+        m_mcpsDataIndicationCallback(params, msdu);
+    }
+}
+
+Ptr<Packet>
+RitWpanMac::GetMacPayload(Ptr<const Packet> frame, const LrWpanMacHeader& macHdr) const
+{
+    uint32_t mhrSize = macHdr.GetSerializedSize();
+    // The MIC of a secured frame is not part of the payload.
+    uint32_t mfrSize = LrWpanMacTrailer().GetSerializedSize() +
+                       (macHdr.IsSecEnable() ? RitFrameSecurity::GetMicLength(macHdr.GetSecLevel())
+                                             : 0);
+    NS_ASSERT(frame->GetSize() >= mhrSize + mfrSize);
+    return frame->CreateFragment(mhrSize, frame->GetSize() - mhrSize - mfrSize);
+}
+
+bool
+RitWpanMac::ContinueBurst()
+{
+    if (!m_moduleConfig.continuousTxEnabled || !m_burstMoreData || m_txQueue.empty())
+    {
+        return false;
+    }
+    NS_LOG_DEBUG("RIT continuous transmission: " << m_txQueue.size() << " frame(s) left for "
+                                                 << m_lastRxRitReqFrameSrcAddr);
+    m_burstMoreData = false;
+    // Keep ignoring other beacons until the burst is over.
+    m_ritSending = true;
+
+    PruneHopLatency();
+    StampQueueHead();
+    if (RitHopLatencyRecord* record = GetHeadHopLatency())
+    {
+        // The frame rides on the rendezvous of the previous one.
+        if (record->beaconWaitStart.IsZero())
+        {
+            record->beaconWaitStart = Simulator::Now();
+        }
+        record->beaconRx = Simulator::Now();
     }
+    return true;
 }
 
 void
@@ -1517,6 +2811,7 @@ RitWpanMac::StartRitDataWaitPeriod()
     // The MAC is forced to IDLE so that incoming frames can be processed immediately.
     SetRxOnWhenIdle(true);
     SetLrWpanMacState(MAC_IDLE);
+    m_overheardBeaconValid = false;
 
     const bool hasValidWait =
         (m_useTimeBasedRitParams && (m_macRitDataWaitDurationTime > Seconds(0))) ||
@@ -1532,10 +2827,98 @@ RitWpanMac::StartRitDataWaitPeriod()
         return;
     }
 
-    const Time dataWaitTime = GetRitDataWaitDurationTime();
-    NS_ASSERT(m_ritDataWaitTimeout.IsExpired());
-    m_ritDataWaitTimeout =
-        Simulator::Schedule(dataWaitTime, &RitWpanMac::ReceiverCycleTimeout, this);
+    Time dataWaitTime = GetRitDataWaitDurationTime();
+    // *module* Contention slots: the sender of the last slot also gets a full DWD.
+    if (m_moduleConfig.contentionSlotsEnabled)
+    {
+        dataWaitTime += m_contentionSlotDuration * (m_contentionSlots - 1);
+        m_contentionSlotsEnd = Simulator::Now() + dataWaitTime;
+    }
+    NS_ASSERT(m_ritTimers.IsExpired(RIT_DATA_WAIT_TIMER));
+    m_ritTimers.Schedule(RIT_DATA_WAIT_TIMER, dataWaitTime);
+
+    // *module* Data wait probe: listen for the whole DWD only if a sender started to answer.
+    // The slots of the senders do not start together, so they keep the full data wait.
+    m_dataWaitActivity = false;
+    if (m_moduleConfig.dataWaitProbeEnabled && !m_moduleConfig.contentionSlotsEnabled &&
+        !m_rxAlwaysOn)
+    {
+        const Time probeDelay = GetDataWaitProbeDelay();
+        if (probeDelay < dataWaitTime)
+        {
+            m_ritTimers.Schedule(RIT_DATA_WAIT_PROBE_TIMER, probeDelay);
+        }
+    }
+}
+
+Time
+RitWpanMac::GetDataWaitProbeDelay() const
+{
+    // The sender turns its transceiver around after receiving the beacon and after its
+    // carrier sense.
+    double symbols = lrwpan::aTurnaroundTime;
+    Ptr<RitCarrierSense> stage =
+        m_carrierSense ? m_carrierSense->GetSelected(RIT_CS_DATA_FRAME) : nullptr;
+    if (Ptr<RitCsmaCaCarrierSense> csmaCa = DynamicCast<RitCsmaCaCarrierSense>(stage))
+    {
+        const uint32_t maxFirstBackoff = (1U << csmaCa->GetCsmaCa()->GetMacMinBE()) - 1;
+        symbols += maxFirstBackoff * lrwpan::aUnitBackoffPeriod + CCA_SYMBOLS;
+    }
+    else if (stage)
+    {
+        symbols += CCA_SYMBOLS;
+    }
+
+    Time delay = Seconds(symbols / m_phy->GetDataOrSymbolRate(false)) + m_dataWaitProbeGuard;
+    if (m_frameSecurity.IsEnabled())
+    {
+        delay += m_securityEncryptDelay;
+    }
+    return delay;
+}
+
+void
+RitWpanMac::ProbeDataWait()
+{
+    NS_LOG_FUNCTION(this);
+
+    // A frame heard meanwhile (beacon ACK, data, foreign frame) or the receiver turned off
+    // by the early RX abort keeps the data wait as it is.
+    if (m_ritMacMode != RECEIVER_MODE || m_macState != MAC_IDLE ||
+        !m_ritTimers.IsPending(RIT_DATA_WAIT_TIMER) || m_dataWaitActivity)
+    {
+        return;
+    }
+    m_dataWaitProbePending = true;
+    m_phy->PlmeEdRequest();
+}
+
+void
+RitWpanMac::PlmeEdConfirm(PhyEnumeration status, uint8_t energyLevel)
+{
+    NS_LOG_FUNCTION(this << status << static_cast<uint32_t>(energyLevel));
+
+    if (!m_dataWaitProbePending)
+    {
+        LrWpanMac::PlmeEdConfirm(status, energyLevel);
+        return;
+    }
+    m_dataWaitProbePending = false;
+
+    // Energy on the channel (at least 10 dB over the sensitivity) or a frame being
+    // received: a sender may be answering, the data wait runs to its end.
+    if (status != IEEE_802_15_4_PHY_SUCCESS || energyLevel > 0 ||
+        m_phy->GetTrxState() == IEEE_802_15_4_PHY_BUSY_RX || m_ritMacMode != RECEIVER_MODE ||
+        m_macState != MAC_IDLE || !m_ritTimers.IsPending(RIT_DATA_WAIT_TIMER) ||
+        m_dataWaitActivity)
+    {
+        return;
+    }
+    NS_LOG_DEBUG("No energy " << GetDataWaitProbeDelay().As(Time::US)
+                              << " into the data wait; end the receiver cycle.");
+    m_nDataWaitProbeShortcuts++;
+    m_dataWaitTrace("probe-idle", Simulator::Now());
+    EndReceiverCycle();
 }
 
 void
@@ -1547,6 +2930,13 @@ RitWpanMac::StartRitTxWaitPeriod()
     // Mark the start of the sender-side beacon-wait phase.
     // This trace records when the sender enters a wait window in which RX is kept on.
     m_beaconWaitTrace("start", Simulator::Now());
+    if (RitHopLatencyRecord* record = GetHeadHopLatency())
+    {
+        if (record->beaconWaitStart.IsZero())
+        {
+            record->beaconWaitStart = Simulator::Now();
+        }
+    }
 
     SetRxOnWhenIdle(true);
     SetLrWpanMacState(MAC_IDLE);
@@ -1562,10 +2952,23 @@ RitWpanMac::StartRitTxWaitPeriod()
         return;
     }
 
-    const Time txWaitTime = GetRitTxWaitDurationTime();
-    NS_ASSERT(m_ritTxWaitTimeout.IsExpired());
-    m_ritTxWaitTimeout =
-        Simulator::Schedule(txWaitTime, &RitWpanMac::SenderCycleTimeout, this);
+    Time txWaitTime = GetRitTxWaitDurationTime();
+    if (IsBroadcastHead())
+    {
+        // A broadcast frame listens for the beacons of every neighbour until its hold ends.
+        if (m_broadcastHoldEnd.IsZero())
+        {
+            m_broadcastHoldEnd = Simulator::Now() + GetBroadcastHoldTime();
+        }
+        txWaitTime = std::max(m_broadcastHoldEnd - Simulator::Now(), Time());
+    }
+    else if (m_phaseLockTxWait.IsStrictlyPositive())
+    {
+        // *module* Phase learning: listen only around the predicted beacon.
+        txWaitTime = std::min(txWaitTime, m_phaseLockTxWait);
+    }
+    NS_ASSERT(m_ritTimers.IsExpired(RIT_TX_WAIT_TIMER));
+    m_ritTimers.Schedule(RIT_TX_WAIT_TIMER, txWaitTime);
 }
 
 void
@@ -1574,11 +2977,35 @@ RitWpanMac::SenderCycleTimeout()
     NS_LOG_FUNCTION(this);
     NS_ASSERT(IsRitModeEnabled() && m_ritMacMode == SENDER_MODE);
 
+    if (!m_broadcastHoldEnd.IsZero() && IsBroadcastHead())
+    {
+        EndBroadcastHold();
+        return;
+    }
+
+    // *module* Phase learning: the predicted beacon was missed; forget the estimate
+    // and keep listening for a full TWD.
+    if (m_phaseLockTxWait.IsStrictlyPositive())
+    {
+        NS_LOG_DEBUG("Predicted beacon of " << m_phaseTarget << " missed; full TWD.");
+        m_beaconPhases.erase(m_phaseTarget);
+        m_appointments.erase(m_phaseTarget);
+        m_phaseTargetValid = false;
+        m_phaseLockTxWait = Time();
+        m_ritTimers.Schedule(RIT_TX_WAIT_TIMER, GetRitTxWaitDurationTime());
+        return;
+    }
+
     // Record that the sender-side beacon-wait window has timed out.
     m_beaconWaitTrace("timeout", Simulator::Now());
 
     // End the current sender cycle (cleanup + transition to sleep).
     EndSenderCycle();
+
+    if (!m_mlmeRitTxWaitTimeoutCallback.IsNull())
+    {
+        m_mlmeRitTxWaitTimeoutCallback();
+    }
 }
 
 void
@@ -1586,16 +3013,30 @@ RitWpanMac::EndSenderCycle()
 {
     NS_LOG_FUNCTION(this);
     NS_ASSERT(IsRitModeEnabled());
-    NS_ASSERT(m_ritMacMode == SENDER_MODE);
+    NS_ASSERT(IsSenderMode());
 
     // Cancel any remaining sender-side wait timer (if still pending).
-    if (!m_ritTxWaitTimeout.IsExpired())
+    if (!m_ritTimers.IsExpired(RIT_TX_WAIT_TIMER))
     {
-        m_ritTxWaitTimeout.Cancel();
+        m_ritTimers.Cancel(RIT_TX_WAIT_TIMER);
     }
 
     // Clear the "currently sending" guard for the sender cycle.
     m_ritSending = false;
+    m_phaseLockTxWait = Time();
+    m_ritTimers.Cancel(RIT_CONTENTION_SLOT_TIMER);
+    m_ritTimers.Cancel(RIT_CHANNEL_SWITCH_TIMER);
+    m_ritTimers.Cancel(RIT_STROBE_TIMER);
+    m_ritTimers.Cancel(RIT_ENCRYPT_TIMER);
+    m_broadcastHoldEnd = Time();
+    m_broadcastServed.clear();
+
+    // The head-of-line frame may have changed (sent or dropped).
+    PruneHopLatency();
+    StampQueueHead();
+
+    // Back to the own receive channel for the next beacon.
+    TuneChannel(m_rxChannel);
 
     // Transition to sleep (PHY forced off unless rxAlwaysOn is enabled).
     SetSleep();
@@ -1621,11 +3062,14 @@ RitWpanMac::EndReceiverCycle()
                       << m_ritMacMode << this);
 
     // Cancel the receiver-side data wait timer if it is still pending.
-    if (m_ritDataWaitTimeout.IsPending())
+    if (m_ritTimers.IsPending(RIT_DATA_WAIT_TIMER))
     {
         NS_LOG_DEBUG("End Rx Data, end RIT receiver cycle.");
-        m_ritDataWaitTimeout.Cancel();
+        m_ritTimers.Cancel(RIT_DATA_WAIT_TIMER);
     }
+    m_ritTimers.Cancel(RIT_DATA_WAIT_PROBE_TIMER);
+    m_continuousRxEnabled = false;
+    m_framePendingRx = false;
 
     // Transition to sleep (PHY forced off unless rxAlwaysOn is enabled).
     SetSleep();
@@ -1646,6 +3090,32 @@ RitWpanMac::AckWaitTimeout()
     // by the base MAC timeout path, then we switch back to sleep).
     NS_LOG_DEBUG("ACK wait timeout, ending RIT sender cycle.");
 
+    // Frame train: the ACK wait is the gap between two copies, in which the receiver
+    // may beacon and open its data wait.
+    if (m_ritMacMode == STROBE_MODE)
+    {
+        m_setMacState.Cancel();
+        ChangeMacState(MAC_IDLE);
+        if (IsHeadOverAirtimeBudget())
+        {
+            // The train stops; the receiver is kept for a later one.
+            m_txPkt = nullptr;
+            EndSenderCycle();
+            return;
+        }
+        if (Simulator::Now() < m_strobeEnd)
+        {
+            SendStrobe();
+            return;
+        }
+        NS_LOG_DEBUG("Frame train to " << m_hybridPeer << " unanswered; back to RIT.");
+        m_hybridPeerValid = false;
+        m_ritSending = false;
+        m_txPkt = nullptr;
+        StartSenderCycle();
+        return;
+    }
+
     if (m_ritMacMode != SENDER_MODE)
     {
         NS_LOG_ERROR("ACK wait timeout occurred in an invalid RIT mode: " << m_ritMacMode);
@@ -1686,33 +3156,49 @@ RitWpanMac::StartRitCycle()
     }
 
     // Start the periodic RIT Data Request (beacon) scheduler.
-    NS_ASSERT(!m_periodicRitDataRequestEvent.IsPending());
+    NS_ASSERT(!m_ritTimers.IsPending(RIT_PERIODIC_REQUEST_TIMER));
 
     // Enter sleep between periodic wakeups (unless rxAlwaysOn is enabled elsewhere).
     ChangeRitMacMode(SLEEP_MODE);
     SetRxOnWhenIdle(false);
 
     // Randomize the initial phase to avoid starting all nodes at the same instant.
-    Ptr<UniformRandomVariable> initialDelay = CreateObject<UniformRandomVariable>();
-    const double delaySec = initialDelay->GetValue(0.0, period.GetSeconds());
+    const double delaySec = m_initialPhase->GetValue(0.0, period.GetSeconds());
+
+    m_ritTimers.Schedule(RIT_PERIODIC_REQUEST_TIMER, Seconds(delaySec));
 
-    m_periodicRitDataRequestEvent =
-        Simulator::Schedule(Seconds(delaySec), &RitWpanMac::PeriodicRitDataRequest, this);
+    if (m_periodPolicy)
+    {
+        m_periodLoad = RitPeriodLoad();
+        m_ritTimers.Schedule(RIT_PERIOD_ADAPT_TIMER, m_periodAdaptationWindow);
+    }
 }
 
 void
 RitWpanMac::StopRitCycle()
 {
     NS_LOG_FUNCTION(this);
-    NS_ASSERT(IsRitModeEnabled());
+    ResumeElidedDataWait();
+    // The period may already be zero: the PIB setters stop the cycle after clearing it.
+    NS_ASSERT(m_ritMacMode != RIT_MODE_DISABLED);
     NS_LOG_DEBUG("Stopping RIT cycle.");
 
     // Stop periodic scheduling and any ongoing sender/receiver wait windows.
     // This is the symmetric counterpart of StartRitCycle(), and it forcefully returns
     // the RIT MAC to the disabled state.
-    m_periodicRitDataRequestEvent.Cancel();
-    m_ritDataWaitTimeout.Cancel();
-    m_ritTxWaitTimeout.Cancel();
+    m_ritTimers.Cancel(RIT_PERIODIC_REQUEST_TIMER);
+    m_ritTimers.Cancel(RIT_DATA_WAIT_TIMER);
+    m_ritTimers.Cancel(RIT_TX_WAIT_TIMER);
+    m_ritTimers.Cancel(RIT_PHASE_WAKE_TIMER);
+    m_ritTimers.Cancel(RIT_PERIOD_ADAPT_TIMER);
+    m_ritTimers.Cancel(RIT_CONTENTION_SLOT_TIMER);
+    m_ritTimers.Cancel(RIT_BOOTSTRAP_TIMER);
+    m_ritTimers.Cancel(RIT_CHANNEL_SWITCH_TIMER);
+    m_ritTimers.Cancel(RIT_STROBE_TIMER);
+    m_phaseLockTxWait = Time();
+    m_broadcastHoldEnd = Time();
+    m_broadcastServed.clear();
+    TuneChannel(m_rxChannel);
 
     // Clear RIT mode and leave the base MAC in a safe idle state.
     ChangeRitMacMode(RIT_MODE_DISABLED);
@@ -1722,6 +3208,88 @@ RitWpanMac::StopRitCycle()
     // until ongoing operations settle. For now, we stop immediately to match the user's intent.
 }
 
+void
+RitWpanMac::MlmeBootstrapRequest(Time duration)
+{
+    NS_LOG_FUNCTION(this << duration);
+    ResumeElidedDataWait();
+    NS_ASSERT(duration.IsStrictlyPositive());
+
+    if (m_ritMacMode != RIT_MODE_DISABLED && m_ritMacMode != BOOTSTRAP_MODE &&
+        IsRitModeEnabled())
+    {
+        StopRitCycle();
+    }
+
+    // Listen for the whole duration, whatever rxAlwaysOn says.
+    ChangeRitMacMode(BOOTSTRAP_MODE);
+    SetRxOnWhenIdle(true);
+    SetLrWpanMacState(MAC_IDLE);
+    m_ritTimers.Schedule(RIT_BOOTSTRAP_TIMER, duration);
+}
+
+void
+RitWpanMac::BootstrapTimeout()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(m_ritMacMode == BOOTSTRAP_MODE);
+    ChangeRitMacMode(RIT_MODE_DISABLED);
+
+    if (!m_mlmeBootstrapConfirmCallback.IsNull())
+    {
+        m_mlmeBootstrapConfirmCallback();
+    }
+
+    // The confirm may have started another listen period.
+    if (m_ritMacMode == RIT_MODE_DISABLED && IsRitModeEnabled())
+    {
+        StartRitCycle();
+        if (!m_rxAlwaysOn)
+        {
+            m_phy->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_FORCE_TRX_OFF);
+        }
+    }
+}
+
+void
+RitWpanMac::SetMlmeBootstrapConfirmCallback(MlmeBootstrapConfirmCallback c)
+{
+    m_mlmeBootstrapConfirmCallback = c;
+}
+
+void
+RitWpanMac::SetMlmeRitTxWaitTimeoutCallback(MlmeRitTxWaitTimeoutCallback c)
+{
+    m_mlmeRitTxWaitTimeoutCallback = c;
+}
+
+void
+RitWpanMac::SetMlmeAckIeIndicationCallback(MlmeAckIeIndicationCallback c)
+{
+    m_mlmeAckIeIndicationCallback = c;
+}
+
+void
+RitWpanMac::SetRitRequestIes(const RitIeList& ies)
+{
+    NS_LOG_FUNCTION(this);
+    m_ritRequestIes = ies;
+    // The beacons carry them from the next one on.
+    m_ritDataRequestTemplate = nullptr;
+}
+
+void
+RitWpanMac::SetAckIes(const RitIeList& ies)
+{
+    NS_LOG_FUNCTION(this);
+    // Room is left for the appointment IE.
+    NS_ABORT_MSG_IF(ies.GetEncodedSize(false) + RitIeList::DESCRIPTOR_SIZE +
+                            RitAppointmentHeader().GetSerializedSize() >
+                        MAX_ACK_IE_SIZE,
+                    "Header IEs of the ACKs longer than " << MAX_ACK_IE_SIZE << " bytes");
+    m_ackIes = ies;
+}
+
 void
 RitWpanMac::SetSleep()
 {
@@ -1729,7 +3297,8 @@ RitWpanMac::SetSleep()
     NS_ASSERT(IsRitModeEnabled());
 
     // RIT sleep transition should occur only when there is no active sender/receiver wait window.
-    NS_ASSERT(m_ritDataWaitTimeout.IsExpired() && m_ritTxWaitTimeout.IsExpired());
+    NS_ASSERT(m_ritTimers.IsExpired(RIT_DATA_WAIT_TIMER) &&
+              m_ritTimers.IsExpired(RIT_TX_WAIT_TIMER));
 
     // Keep the base MAC state consistent before touching the PHY.
     ChangeMacState(MAC_IDLE);
@@ -1758,73 +3327,1388 @@ RitWpanMac::CheckTxAndStartSender()
         return false; // No packets to transmit.
     }
 
+    // A wake-up planned by phase learning or overhearing avoidance is kept.
+    if (m_ritTimers.IsPending(RIT_PHASE_WAKE_TIMER))
+    {
+        return false;
+    }
+
+    // Duty-cycle limit: the frame waits for a later period.
+    if (IsHeadOverAirtimeBudget())
+    {
+        return false;
+    }
+
+    // Deep queue: wake the last receiver with a frame train instead of waiting.
+    if (StartStrobeTrain())
+    {
+        return true;
+    }
+
+    // *module* Phase learning: sleep until shortly before the predicted beacon of the
+    // last receiver instead of listening for up to TWD right away. A broadcast frame
+    // listens for every neighbour.
+    if ((m_moduleConfig.phaseLearningEnabled || m_moduleConfig.ackAppointmentsEnabled) &&
+        !IsBroadcastHead())
+    {
+        Time wakeDelay;
+        Time window;
+        if (PredictTargetBeacon(wakeDelay, window))
+        {
+            NS_LOG_DEBUG("Sender wake-up planned in " << wakeDelay.As(Time::MS) << " for "
+                                                      << window.As(Time::MS));
+            m_phaseLockTxWait = window;
+            m_ritTimers.Schedule(RIT_PHASE_WAKE_TIMER, wakeDelay);
+            return false;
+        }
+    }
+
     // If there is at least one packet queued, switch to sender mode and open
     // the sender-side TX wait window (beacon wait window).
-    NS_ASSERT(m_ritMacMode != SENDER_MODE);
+    NS_ASSERT(!IsSenderMode());
     NS_LOG_DEBUG("tx queue size: " << static_cast<int>(m_txQueue.size()));
 
-    ChangeRitMacMode(SENDER_MODE);
-    StartRitTxWaitPeriod();
+    StartSenderCycle();
     return true;
 }
 
 void
-RitWpanMac::ChangeRitMacMode(RitMacMode newMode)
+RitWpanMac::StartSenderCycle()
 {
-    // Avoid redundant state transitions. This also prevents duplicate logs/traces
-    // when the mode is already set to the requested value.
-    if (m_ritMacMode == newMode)
+    NS_LOG_FUNCTION(this);
+    ChangeRitMacMode(SENDER_MODE);
+
+    // The beacon wait opens once the synthesizer has settled on the receiver channel.
+    if (TuneChannel(GetSenderChannel()) && m_channelSwitchTime.IsStrictlyPositive())
     {
-        NS_LOG_LOGIC(this << " RIT MAC mode unchanged: " << m_ritMacMode);
+        m_ritTimers.Schedule(RIT_CHANNEL_SWITCH_TIMER, m_channelSwitchTime);
         return;
     }
-
-    NS_LOG_LOGIC(this << " change RIT MAC mode from " << m_ritMacMode << " to " << newMode);
-    m_ritMacMode = newMode;
+    StartRitTxWaitPeriod();
 }
 
-Time
-RitWpanMac::DurationToTime(uint64_t duration) const
+uint8_t
+RitWpanMac::GetSenderChannel() const
 {
-    // Convert a RIT "duration" value (in units of aBaseSuperframeDuration) into a Time.
-    // This path is valid only when the PIB parameters are used.
-    NS_ASSERT(!m_useTimeBasedRitParams);
-
-    const uint64_t symbols = duration * aBaseSuperframeDuration;
-    const double symbolRate = m_phy->GetDataOrSymbolRate(false); // symbols per second
-    return Seconds(static_cast<double>(symbols) / symbolRate);
+    if (m_rxChannel == 0 || m_txQueue.empty())
+    {
+        return m_rxChannel;
+    }
+    LrWpanMacHeader headHdr;
+    RitFrameCodec::PeekMacHeader(m_txQueue.front()->txQPkt, headHdr);
+    const uint8_t channel = headHdr.GetDstAddrMode() == SHORT_ADDR
+                                ? GetNeighbourRxChannel(headHdr.GetShortDstAddr())
+                                : 0;
+    // Broadcast or unknown destination: stay on the own channel
+    return channel != 0 ? channel : m_rxChannel;
 }
 
 bool
-RitWpanMac::IsRitModeEnabled() const
+RitWpanMac::TuneChannel(uint8_t channel)
 {
-    // RIT is considered enabled when the configured period is positive.
-    // - Time-based mode: enabled iff macRitPeriodTime > 0
-    // - PIB mode : enabled iff macRitPeriod > 0
-    if (m_useTimeBasedRitParams)
+    if (channel == 0 || !m_phy || m_phy->GetCurrentChannelNum() == channel)
     {
-        return m_macRitPeriodTime.Get().IsPositive();
+        return false;
     }
-    return m_macRitPeriod > 0u;
+    NS_LOG_DEBUG("Retune from channel " << +m_phy->GetCurrentChannelNum() << " to "
+                                        << +channel);
+    Ptr<PhyPibAttributes> pibAttr = Create<PhyPibAttributes>();
+    pibAttr->phyCurrentChannel = channel;
+    m_phy->PlmeSetAttributeRequest(PhyPibAttributeIdentifier::phyCurrentChannel, pibAttr);
+    m_nChannelSwitches++;
+
+    // The PHY is left off by the channel change; before the start, DoInitialize() sets it.
+    if (IsInitialized())
+    {
+        SetRxOnWhenIdle(m_macRxOnWhenIdle);
+    }
+    return true;
 }
 
 void
-RitWpanMac::SetPreCs(Ptr<RitWpanPreCs> preCs)
+RitWpanMac::LearnRxChannel(Ptr<Packet> p, Mac16Address src)
 {
-    // Inject the Pre-CS module implementation.
-    // The actual start/cancel decision is made in the TX path depending on the module flags.
-    NS_LOG_FUNCTION(this << preCs);
-    m_preCs = preCs;
-}
+    if (m_rxChannel == 0 || p->GetSize() == 0)
+    {
+        return;
+    }
+    std::vector<uint8_t> payload(p->GetSize());
+    p->CopyData(payload.data(), payload.size());
+    p->RemoveAtEnd(1);
+    if (payload.back() == 0)
+    {
+        return;
+    }
+    auto it = m_neighbourChannels.find(src);
+    if (it != m_neighbourChannels.end() && it->second != payload.back())
+    {
+        // Another radio of the neighbour, beaconing at its own phase.
+        m_beaconPhases.erase(src);
+        m_appointments.erase(src);
+    }
+    m_neighbourChannels[src] = payload.back();
+}
+
+void
+RitWpanMac::SetRxChannel(uint8_t channel)
+{
+    NS_LOG_FUNCTION(this << +channel);
+    ResumeElidedDataWait();
+    m_rxChannel = channel;
+    // The beacons advertise it.
+    m_ritDataRequestTemplate = nullptr;
+    if (!IsSenderMode())
+    {
+        TuneChannel(m_rxChannel);
+    }
+}
+
+uint8_t
+RitWpanMac::GetRxChannel() const
+{
+    return m_rxChannel;
+}
+
+void
+RitWpanMac::RedirectNextBeacon(uint8_t channel)
+{
+    NS_LOG_FUNCTION(this << +channel);
+    NS_ASSERT_MSG(m_rxChannel != 0 || channel == 0, "A redirect needs a receive channel");
+    if (channel == m_rxChannel)
+    {
+        channel = 0;
+    }
+    if (channel != m_redirectChannel)
+    {
+        m_redirectChannel = channel;
+        m_ritDataRequestTemplate = nullptr;
+    }
+}
+
+uint64_t
+RitWpanMac::GetNBeaconRedirects() const
+{
+    return m_nBeaconRedirects;
+}
+
+void
+RitWpanMac::SetNeighbourRxChannel(Mac16Address neighbour, uint8_t channel)
+{
+    NS_LOG_FUNCTION(this << neighbour << +channel);
+    if (channel == 0)
+    {
+        m_neighbourChannels.erase(neighbour);
+    }
+    else
+    {
+        m_neighbourChannels[neighbour] = channel;
+    }
+}
+
+uint8_t
+RitWpanMac::GetNeighbourRxChannel(Mac16Address neighbour) const
+{
+    auto it = m_neighbourChannels.find(neighbour);
+    if (it != m_neighbourChannels.end())
+    {
+        return it->second;
+    }
+    if (m_planChannels == 0 || neighbour.IsBroadcast())
+    {
+        return 0;
+    }
+    return GetPlannedRxChannel(neighbour, m_planFirstChannel, m_planChannels);
+}
+
+void
+RitWpanMac::SetRxChannelPlan(uint8_t firstChannel, uint8_t nChannels)
+{
+    NS_LOG_FUNCTION(this << +firstChannel << +nChannels);
+    m_planFirstChannel = firstChannel;
+    m_planChannels = nChannels;
+}
+
+uint8_t
+RitWpanMac::GetPlannedRxChannel(Mac16Address addr, uint8_t firstChannel, uint8_t nChannels)
+{
+    NS_ASSERT(nChannels > 0);
+    return static_cast<uint8_t>(firstChannel + addr.ConvertToInt() % nChannels);
+}
+
+uint64_t
+RitWpanMac::GetNChannelSwitches() const
+{
+    return m_nChannelSwitches;
+}
+
+uint64_t
+RitWpanMac::GetNBroadcastTx() const
+{
+    return m_nBroadcastTx;
+}
+
+uint64_t
+RitWpanMac::GetNStrobeFrames() const
+{
+    return m_nStrobeFrames;
+}
+
+Time
+RitWpanMac::GetTxAirtime() const
+{
+    return m_txAirtime;
+}
+
+uint64_t
+RitWpanMac::GetNDutyCycleDeferrals() const
+{
+    return m_nDutyCycleDeferrals;
+}
+
+const RitFrameSecurity&
+RitWpanMac::GetFrameSecurity() const
+{
+    return m_frameSecurity;
+}
+
+void
+RitWpanMac::SetSecurityLevel(uint8_t secLevel)
+{
+    m_frameSecurity.SetSecLevel(secLevel);
+    // The MIC length of the cached RIT Data Request depends on the level.
+    m_ritDataRequestTemplate = nullptr;
+}
+
+uint8_t
+RitWpanMac::GetSecurityLevel() const
+{
+    return m_frameSecurity.GetSecLevel();
+}
+
+void
+RitWpanMac::SetSecurityKeyIdMode(uint8_t keyIdMode)
+{
+    m_frameSecurity.SetKeyIdMode(keyIdMode);
+}
+
+uint8_t
+RitWpanMac::GetSecurityKeyIdMode() const
+{
+    return m_frameSecurity.GetKeyIdMode();
+}
+
+Time
+RitWpanMac::GetFrameAirtime(uint32_t size) const
+{
+    const uint64_t symbols =
+        m_phy->GetPhySHRDuration() +
+        static_cast<uint64_t>(std::ceil((1 + size) * m_phy->GetPhySymbolsPerOctet()));
+    return Seconds(static_cast<double>(symbols) / m_phy->GetDataOrSymbolRate(false));
+}
+
+Time
+RitWpanMac::CheckTxAirtime(Time airtime, const std::string& action)
+{
+    const Time wait = m_airtimeBudget.GetWaitTime(Simulator::Now(), airtime);
+    if (wait.IsStrictlyPositive())
+    {
+        NS_LOG_DEBUG("Duty-cycle limit: " << action << ", " << wait.As(Time::S)
+                                          << " until the airtime fits");
+        m_nDutyCycleDeferrals++;
+        m_dutyCycleTrace(action, wait);
+    }
+    return wait;
+}
+
+bool
+RitWpanMac::IsHeadOverAirtimeBudget()
+{
+    if (!m_airtimeBudget.IsEnabled() || m_txQueue.empty())
+    {
+        return false;
+    }
+    const Time airtime = GetFrameAirtime(m_txQueue.front()->txQPkt->GetSize());
+    return CheckTxAirtime(airtime, "data-defer").IsStrictlyPositive();
+}
+
+bool
+RitWpanMac::IsSenderMode() const
+{
+    return m_ritMacMode == SENDER_MODE || m_ritMacMode == STROBE_MODE;
+}
+
+bool
+RitWpanMac::StartStrobeTrain()
+{
+    if (m_hybridQueueThreshold == 0 || m_txQueue.size() <= m_hybridQueueThreshold ||
+        !m_hybridPeerValid || IsBroadcastHead())
+    {
+        return false;
+    }
+    NS_ASSERT(!IsSenderMode());
+    NS_LOG_DEBUG("TX queue of " << m_txQueue.size() << " frames; frame train to "
+                                << m_hybridPeer);
+    ChangeRitMacMode(STROBE_MODE);
+    m_ritSending = true;
+    // Used by AddressTxQElement() as for the receiver of a beacon.
+    m_lastRxRitReqFrameSrcAddr = m_hybridPeer;
+    m_strobeEnd = Simulator::Now() + GetStrobeTrainTime();
+    PruneHopLatency();
+    StampQueueHead();
+    if (RitHopLatencyRecord* record = GetHeadHopLatency())
+    {
+        if (record->beaconWaitStart.IsZero())
+        {
+            record->beaconWaitStart = Simulator::Now();
+        }
+    }
+    SetRxOnWhenIdle(true);
+    SetLrWpanMacState(MAC_IDLE);
+
+    const uint8_t channel = GetNeighbourRxChannel(m_hybridPeer);
+    if (TuneChannel(channel != 0 ? channel : m_rxChannel) &&
+        m_channelSwitchTime.IsStrictlyPositive())
+    {
+        m_ritTimers.Schedule(RIT_STROBE_TIMER, m_channelSwitchTime);
+        return true;
+    }
+    SendStrobe();
+    return true;
+}
+
+void
+RitWpanMac::SendStrobe()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_ritMacMode != STROBE_MODE || m_txQueue.empty() || m_macState != MAC_IDLE)
+    {
+        return;
+    }
+
+    // Every copy goes out right away: the train keeps the channel, its gaps are the
+    // ACK waits.
+    Ptr<TxQueueElement> txQElement = m_txQueue.front();
+    AddressTxQElement(txQElement);
+    if (m_frameSecurity.IsEnabled())
+    {
+        SecureTxQElement(txQElement);
+    }
+    m_nStrobeFrames++;
+    if (RitHopLatencyRecord* record = GetHeadHopLatency())
+    {
+        record->csStart = Simulator::Now();
+        record->csEnd = Simulator::Now();
+    }
+    m_txPkt = txQElement->txQPkt;
+    ChangeMacState(MAC_SENDING);
+    m_phy->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_TX_ON);
+}
+
+Time
+RitWpanMac::GetStrobeTrainTime() const
+{
+    if (m_strobeTrainTime.IsStrictlyPositive())
+    {
+        return m_strobeTrainTime;
+    }
+    return GetRitPeriodTime() + GetRitDataWaitDurationTime();
+}
+
+bool
+RitWpanMac::IsBroadcastHead() const
+{
+    if (m_txQueue.empty())
+    {
+        return false;
+    }
+    LrWpanMacHeader headHdr;
+    RitFrameCodec::PeekMacHeader(m_txQueue.front()->txQPkt, headHdr);
+    return headHdr.GetDstAddrMode() == SHORT_ADDR && headHdr.GetShortDstAddr().IsBroadcast();
+}
+
+Time
+RitWpanMac::GetBroadcastHoldTime() const
+{
+    return m_broadcastHoldTime.IsStrictlyPositive() ? m_broadcastHoldTime
+                                                    : GetRitTxWaitDurationTime();
+}
+
+void
+RitWpanMac::EndBroadcastHold()
+{
+    NS_LOG_FUNCTION(this);
+    NS_LOG_DEBUG("RIT broadcast hold over: " << m_broadcastServed.size()
+                                            << " beacon(s) answered");
+    m_beaconWaitTrace("timeout", Simulator::Now());
+    FinishHopLatency(false);
+
+    if (!m_mcpsDataConfirmCallback.IsNull())
+    {
+        McpsDataConfirmParams confirmParams;
+        confirmParams.m_status =
+            m_broadcastServed.empty() ? MacStatus::NO_ACK : MacStatus::SUCCESS;
+        confirmParams.m_msduHandle = m_txQueue.front()->txQMsduHandle;
+        m_mcpsDataConfirmCallback(confirmParams);
+    }
+    RemoveFirstTxQElement();
+    EndSenderCycle();
+}
+
+void
+RitWpanMac::LearnBeaconPhase(Mac16Address src)
+{
+    NS_LOG_FUNCTION(this << src);
+    const Time now = Simulator::Now();
+
+    auto it = m_beaconPhases.find(src);
+    if (it == m_beaconPhases.end())
+    {
+        // Until a second beacon is heard, assume the neighbour uses our nominal period.
+        m_beaconPhases[src] = RitBeaconPhase{now, GetRitPeriodTime()};
+        return;
+    }
+
+    RitBeaconPhase& phase = it->second;
+    const Time elapsed = now - phase.lastBeacon;
+    const double nPeriods = std::round(elapsed.GetSeconds() / phase.period.GetSeconds());
+    if (nPeriods >= 1)
+    {
+        // The measured period absorbs the relative clock drift of the neighbour.
+        const Time measured = elapsed / static_cast<int64_t>(nPeriods);
+        if (std::abs(measured.GetSeconds() / phase.period.GetSeconds() - 1.0) < 0.01)
+        {
+            phase.period = measured;
+        }
+        else
+        {
+            // The neighbour moved its beacon (de-confliction, period adaptation): start over.
+            phase.period = GetRitPeriodTime();
+        }
+    }
+    phase.lastBeacon = now;
+}
+
+Time
+RitWpanMac::DeconflictBeaconPhase(Time period)
+{
+    NS_LOG_FUNCTION(this << period);
+
+    // Phases of the neighbour beacons heard recently, relative to the beacon about to be
+    // sent: the next one is due at phase 0 (one period from now) without a shift.
+    const Time now = Simulator::Now();
+    const Mac16Address self = GetShortAddress();
+    std::vector<Time> phases;
+    bool conflict = false;
+    for (const auto& [src, phase] : m_beaconPhases)
+    {
+        if (!phase.period.IsStrictlyPositive() || now - phase.lastBeacon > phase.period * 4)
+        {
+            continue; // Not heard for a while: not a neighbour to plan around any more
+        }
+        const auto k = static_cast<int64_t>(
+            std::ceil((now - phase.lastBeacon).GetSeconds() / phase.period.GetSeconds()));
+        const Time offset = (phase.lastBeacon + phase.period * k - now) % period;
+        phases.push_back(offset);
+        if ((offset < m_beaconDeconflictGap || period - offset < m_beaconDeconflictGap) &&
+            src < self)
+        {
+            conflict = true;
+        }
+    }
+    if (!conflict)
+    {
+        return Time();
+    }
+
+    // Middle of the largest circular gap between the neighbour beacons.
+    std::sort(phases.begin(), phases.end());
+    Time bestStart = phases.back();
+    Time bestGap = phases.front() + period - phases.back();
+    for (size_t i = 1; i < phases.size(); i++)
+    {
+        if (phases[i] - phases[i - 1] > bestGap)
+        {
+            bestStart = phases[i - 1];
+            bestGap = phases[i] - phases[i - 1];
+        }
+    }
+    if (bestGap < m_beaconDeconflictGap * 2)
+    {
+        return Time(); // No room anywhere: moving would only trade one conflict for another
+    }
+    const Time shift = (bestStart + bestGap / 2) % period;
+    NS_LOG_DEBUG("Beacon phase moved by " << shift.As(Time::MS) << " into a gap of "
+                                          << bestGap.As(Time::MS));
+    m_nBeaconPhaseShifts++;
+    return shift;
+}
+
+bool
+RitWpanMac::PredictTargetBeacon(Time& wakeDelay, Time& window) const
+{
+    return m_phaseTargetValid && PredictBeacon(m_phaseTarget, wakeDelay, window);
+}
+
+bool
+RitWpanMac::GetTxQueueHeadHandle(uint8_t& msduHandle) const
+{
+    if (m_txQueue.empty())
+    {
+        return false;
+    }
+    msduHandle = m_txQueue.front()->txQMsduHandle;
+    return true;
+}
+
+uint32_t
+RitWpanMac::GetTxQueueOccupancy() const
+{
+    return m_txQueueOccupancy;
+}
+
+uint32_t
+RitWpanMac::GetTxQueueCapacity() const
+{
+    return m_txQueueCapacity;
+}
+
+bool
+RitWpanMac::PredictBeacon(Mac16Address neighbour, Time& wakeDelay, Time& window) const
+{
+    // Randomized beacon intervals have no phase to learn.
+    if (m_moduleConfig.beaconRandomizeEnabled)
+    {
+        return false;
+    }
+    // *module* ACK appointments: the receiver told when it beacons.
+    if (m_moduleConfig.ackAppointmentsEnabled &&
+        PredictAppointment(neighbour, wakeDelay, window))
+    {
+        return true;
+    }
+    auto it = m_beaconPhases.find(neighbour);
+    if (it == m_beaconPhases.end() || !it->second.period.IsStrictlyPositive())
+    {
+        return false;
+    }
+
+    const RitBeaconPhase& phase = it->second;
+    const Time now = Simulator::Now();
+    auto k = static_cast<int64_t>((now - phase.lastBeacon).GetSeconds() /
+                                  phase.period.GetSeconds());
+    for (k = std::max<int64_t>(k, 1);; k++)
+    {
+        const Time horizon = phase.period * k;
+        const Time guard =
+            m_phaseLockGuard + Seconds(horizon.GetSeconds() * m_phaseLockDriftPpm * 1e-6);
+        if (guard * 2 >= phase.period)
+        {
+            return false; // Too long since the last beacon: the window spans the period
+        }
+        const Time open = phase.lastBeacon + horizon - guard;
+        if (open > now)
+        {
+            wakeDelay = open - now;
+            window = guard * 2;
+            return true;
+        }
+    }
+}
+
+bool
+RitWpanMac::PredictAppointment(Mac16Address neighbour, Time& wakeDelay, Time& window) const
+{
+    auto it = m_appointments.find(neighbour);
+    if (it == m_appointments.end())
+    {
+        return false;
+    }
+
+    const RitAppointment& appointment = it->second;
+    const Time now = Simulator::Now();
+    auto k = std::max<int64_t>(
+        0,
+        static_cast<int64_t>((now - appointment.beacon).GetSeconds() /
+                             appointment.period.GetSeconds()));
+    for (;; k++)
+    {
+        const Time beacon = appointment.beacon + appointment.period * k;
+        // Both clocks drift from the grant on: the receiver's beacon and our wake-up.
+        const Time drift = m_clockDriftApplier->GetDriftBound(beacon - appointment.granted) * 2;
+        if ((m_appointmentGuard + drift * 2) * 2 >= appointment.period)
+        {
+            return false; // The appointment is too old to save much of TWD
+        }
+        const Time open = beacon - drift;
+        if (open > now)
+        {
+            wakeDelay = open - now;
+            window = m_appointmentGuard + drift * 2;
+            return true;
+        }
+    }
+}
+
+void
+RitWpanMac::ReceiveAckPayload(Ptr<const Packet> payload, Mac16Address peer)
+{
+    RitAppointmentHeader appointment;
+    bool appointed = false;
+    if (m_moduleConfig.headerIesEnabled)
+    {
+        RitIeView ies;
+        if (!ies.Parse(payload))
+        {
+            NS_LOG_DEBUG("Malformed header IEs in the ACK of " << peer << "; ignored.");
+            return;
+        }
+        appointed = ies.GetHeader(RIT_IE_APPOINTMENT, appointment);
+        if (ies.GetN() > 0 && !m_mlmeAckIeIndicationCallback.IsNull())
+        {
+            m_mlmeAckIeIndicationCallback(peer, ies);
+        }
+    }
+    else if (payload->GetSize() >= appointment.GetSerializedSize())
+    {
+        payload->PeekHeader(appointment);
+        appointed = true;
+    }
+
+    // *module* ACK appointments: keep the beacon the receiver appointed.
+    if (appointed && m_moduleConfig.ackAppointmentsEnabled &&
+        appointment.GetPeriod().IsStrictlyPositive())
+    {
+        const Time now = Simulator::Now();
+        m_appointments[peer] =
+            RitAppointment{now + appointment.GetOffset(), appointment.GetPeriod(), now};
+        m_nAppointmentsReceived++;
+    }
+}
+
+Time
+RitWpanMac::GetAckEndDelay(uint32_t ackSize) const
+{
+    const Time turnaround = Seconds(static_cast<double>(lrwpan::aTurnaroundTime) /
+                                    m_phy->GetDataOrSymbolRate(false));
+    return turnaround + GetFrameAirtime(ackSize);
+}
+
+void
+RitWpanMac::SendRitAck(uint8_t seqno)
+{
+    NS_LOG_FUNCTION(this << static_cast<uint32_t>(seqno));
+
+    NS_ASSERT(m_macState == MAC_IDLE);
+
+    LrWpanMacHeader macHdr(LrWpanMacHeader::LRWPAN_MAC_ACKNOWLEDGMENT, seqno);
+    LrWpanMacTrailer macTrailer;
+    const bool ies = m_moduleConfig.headerIesEnabled;
+    RitAppointmentHeader appointment;
+    bool granted = false;
+    if (m_moduleConfig.ackAppointmentsEnabled && !m_moduleConfig.beaconRandomizeEnabled &&
+        m_ritTimers.IsPending(RIT_PERIODIC_REQUEST_TIMER))
+    {
+        // The sender counts the offset from the end of the ACK it receives.
+        const uint32_t ackSize =
+            macHdr.GetSerializedSize() + appointment.GetSerializedSize() +
+            (ies ? m_ackIes.GetEncodedSize(false) + RitIeList::DESCRIPTOR_SIZE : 0) +
+            macTrailer.GetSerializedSize();
+        const Time offset =
+            m_ritTimers.GetDelayLeft(RIT_PERIODIC_REQUEST_TIMER) - GetAckEndDelay(ackSize);
+        // No appointment when the beacon is due before the ACK is over.
+        if (offset.IsStrictlyPositive())
+        {
+            appointment.SetOffset(offset);
+            appointment.SetPeriod(GetRitPeriodTime());
+            NS_LOG_DEBUG("Beacon appointment in " << offset.As(Time::MS) << " granted in the ACK");
+            m_nAppointmentsGranted++;
+            granted = true;
+        }
+    }
+
+    Ptr<Packet> ackPacket;
+    if (ies && (granted || !m_ackIes.IsEmpty()))
+    {
+        RitIeList list = m_ackIes;
+        if (granted)
+        {
+            list.AddHeader(RIT_IE_APPOINTMENT, appointment);
+        }
+        // The IEs run to the MFR: no termination.
+        const std::vector<uint8_t> bytes = list.Encode(false);
+        ackPacket = Create<Packet>(bytes.data(), bytes.size());
+    }
+    else if (granted && !ies)
+    {
+        ackPacket = Create<Packet>(0);
+        ackPacket->AddHeader(appointment);
+    }
+    else
+    {
+        LrWpanMac::SendAck(seqno);
+        return;
+    }
+    ackPacket->AddHeader(macHdr);
+    // Calculate FCS if the global attribute ChecksumEnabled is set.
+    if (Node::ChecksumEnabled())
+    {
+        macTrailer.EnableFcs(true);
+        macTrailer.SetFcs(ackPacket);
+    }
+    ackPacket->AddTrailer(macTrailer);
+
+    // Switch transceiver to TX mode. Proceed sending the Ack on confirm.
+    m_txPkt = ackPacket;
+    ChangeMacState(MAC_SENDING);
+    m_phy->PlmeSetTRXStateRequest(IEEE_802_15_4_PHY_TX_ON);
+}
+
+void
+RitWpanMac::PhaseLockedWakeup()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_txQueue.empty())
+    {
+        m_phaseLockTxWait = Time();
+        return;
+    }
+
+    if (m_ritMacMode != SLEEP_MODE)
+    {
+        // Busy with our own receiver cycle: aim for the following beacon.
+        Time wakeDelay;
+        Time window;
+        if (PredictTargetBeacon(wakeDelay, window))
+        {
+            m_phaseLockTxWait = window;
+            m_ritTimers.Schedule(RIT_PHASE_WAKE_TIMER, wakeDelay);
+        }
+        else
+        {
+            // Started with a full TWD by the next CheckTxAndStartSender().
+            m_phaseLockTxWait = Time();
+        }
+        return;
+    }
+
+    StartSenderCycle();
+}
+
+void
+RitWpanMac::SetRitPeriodPolicy(Ptr<RitPeriodPolicy> policy)
+{
+    NS_LOG_FUNCTION(this << policy);
+    m_periodPolicy = policy;
+    if (!m_periodPolicy)
+    {
+        m_ritTimers.Cancel(RIT_PERIOD_ADAPT_TIMER);
+    }
+    else if (IsRitModeEnabled() && !m_ritTimers.IsPending(RIT_PERIOD_ADAPT_TIMER))
+    {
+        m_periodLoad = RitPeriodLoad();
+        m_ritTimers.Schedule(RIT_PERIOD_ADAPT_TIMER, m_periodAdaptationWindow);
+    }
+}
+
+Ptr<RitPeriodPolicy>
+RitWpanMac::GetRitPeriodPolicy() const
+{
+    return m_periodPolicy;
+}
+
+void
+RitWpanMac::AdaptRitPeriod()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(m_periodPolicy);
+
+    const RitPeriodLoad load = m_periodLoad;
+    m_periodLoad = RitPeriodLoad();
+    m_ritTimers.Schedule(RIT_PERIOD_ADAPT_TIMER, m_periodAdaptationWindow);
+
+    // Only the time-based period is adapted.
+    if (!m_useTimeBasedRitParams)
+    {
+        return;
+    }
+
+    Time minPeriod = m_ritPeriodMin.IsStrictlyPositive() ? m_ritPeriodMin
+                                                         : m_nominalRitPeriodTime / 4;
+    const Time maxPeriod = m_ritPeriodMax.IsStrictlyPositive() ? m_ritPeriodMax
+                                                               : m_nominalRitPeriodTime * 4;
+    minPeriod = std::max(minPeriod, GetRitDataWaitDurationTime());
+
+    const Time period = m_periodPolicy->Update(GetRitPeriodTime(), load);
+    const Time clamped = std::clamp(period, minPeriod, std::max(minPeriod, maxPeriod));
+    if (clamped != m_macRitPeriodTime.Get())
+    {
+        NS_LOG_DEBUG("RIT period adapted from " << m_macRitPeriodTime.Get().As(Time::MS) << " to "
+                                                << clamped.As(Time::MS) << " (beacons "
+                                                << load.beacons << ", answered " << load.answered
+                                                << ")");
+        // Effective from the next beacon.
+        m_macRitPeriodTime = clamped;
+    }
+}
+
+void
+RitWpanMac::ChangeRitMacMode(RitMacMode newMode)
+{
+    // Avoid redundant state transitions. This also prevents duplicate logs/traces
+    // when the mode is already set to the requested value.
+    if (m_ritMacMode == newMode)
+    {
+        NS_LOG_LOGIC(this << " RIT MAC mode unchanged: " << m_ritMacMode);
+        return;
+    }
+
+    NS_LOG_LOGIC(this << " change RIT MAC mode from " << m_ritMacMode << " to " << newMode);
+    if (newMode == SENDER_MODE || newMode == STROBE_MODE)
+    {
+        // The registry exists only when a MAC of the channel uses the elision
+        if (!m_senderRegistry && m_phy)
+        {
+            Ptr<Channel> channel = m_phy->GetChannel();
+            m_senderRegistry = channel ? channel->GetObject<RitSenderRegistry>() : nullptr;
+        }
+        if (m_senderRegistry)
+        {
+            m_senderRegistry->Add(m_phy);
+        }
+    }
+    else if (IsSenderMode() && m_senderRegistry)
+    {
+        m_senderRegistry->Remove(m_phy);
+    }
+    m_ritMacMode = newMode;
+}
+
+Time
+RitWpanMac::DurationToTime(uint64_t duration) const
+{
+    // Convert a RIT "duration" value (in units of aBaseSuperframeDuration) into a Time.
+    // This path is valid only when the PIB parameters are used.
+    NS_ASSERT(!m_useTimeBasedRitParams);
+
+    const uint64_t symbols = duration * aBaseSuperframeDuration;
+    const double symbolRate = m_phy->GetDataOrSymbolRate(false); // symbols per second
+    return Seconds(static_cast<double>(symbols) / symbolRate);
+}
+
+bool
+RitWpanMac::IsRitModeEnabled() const
+{
+    // RIT is considered enabled when the configured period is positive.
+    // - Time-based mode: enabled iff macRitPeriodTime > 0
+    // - PIB mode : enabled iff macRitPeriod > 0
+    if (m_useTimeBasedRitParams)
+    {
+        return m_macRitPeriodTime.Get().IsStrictlyPositive();
+    }
+    return m_macRitPeriod > 0u;
+}
+
+void
+RitWpanMac::SetCarrierSense(Ptr<RitCarrierSensePipeline> carrierSense)
+{
+    // Inject the carrier-sense stages. The TX path only asks the pipeline whether a frame
+    // kind has a stage and starts it.
+    NS_LOG_FUNCTION(this << carrierSense);
+    m_carrierSense = carrierSense;
+    ApplyCarrierSenseConfig();
+}
+
+Ptr<RitCarrierSensePipeline>
+RitWpanMac::GetCarrierSense() const
+{
+    return m_carrierSense;
+}
+
+void
+RitWpanMac::ApplyCarrierSenseConfig()
+{
+    if (!m_carrierSense)
+    {
+        return;
+    }
+
+    // Nothing ever started a Pre-CSB stage: its flags keep sending after CSMA/CA.
+    Ptr<RitCarrierSense> csmaCa = m_carrierSense->GetStage(RitCarrierSensePipeline::CSMA_CA_STAGE);
+    Ptr<RitCarrierSense> preCs = m_carrierSense->GetStage(RitCarrierSensePipeline::PRE_CS_STAGE);
+    Ptr<RitCarrierSense> beacon;
+    if (m_moduleConfig.beaconPreCsEnabled)
+    {
+        beacon = preCs;
+    }
+    else if (m_moduleConfig.beaconCsmaEnabled || m_moduleConfig.beaconPreCsBEnabled)
+    {
+        beacon = csmaCa;
+    }
+    Ptr<RitCarrierSense> data;
+    if (m_moduleConfig.dataPreCsEnabled)
+    {
+        data = preCs;
+    }
+    else if (m_moduleConfig.dataCsmaEnabled || m_moduleConfig.dataPreCsBEnabled)
+    {
+        data = csmaCa;
+    }
+    m_carrierSense->Select(RIT_CS_BEACON_FRAME, beacon);
+    m_carrierSense->Select(RIT_CS_DATA_FRAME, data);
+}
+
+void
+RitWpanMac::NotifyNwkEnqueue(uint8_t msduHandle)
+{
+    NS_LOG_FUNCTION(this << static_cast<uint32_t>(msduHandle));
+    if (!m_hopLatencyEnabled)
+    {
+        return;
+    }
+    // A stale record of a handle that wrapped around is simply replaced.
+    RitHopLatencyRecord record;
+    record.nwkEnqueue = Simulator::Now();
+    m_hopLatency[msduHandle] = record;
+}
+
+RitHopLatencyRecord*
+RitWpanMac::GetHeadHopLatency()
+{
+    if (!m_hopLatencyEnabled || m_txQueue.empty())
+    {
+        return nullptr;
+    }
+    auto it = m_hopLatency.find(m_txQueue.front()->txQMsduHandle);
+    return it != m_hopLatency.end() ? &it->second : nullptr;
+}
+
+void
+RitWpanMac::StampQueueHead()
+{
+    RitHopLatencyRecord* record = GetHeadHopLatency();
+    if (record && record->macQueueHead.IsZero())
+    {
+        record->macQueueHead = Simulator::Now();
+    }
+}
+
+void
+RitWpanMac::FinishHopLatency(bool acked)
+{
+    RitHopLatencyRecord* record = GetHeadHopLatency();
+    if (!record)
+    {
+        return;
+    }
+    if (acked)
+    {
+        record->ackRx = Simulator::Now();
+    }
+    m_hopLatencyTrace(*record);
+    m_hopLatency.erase(m_txQueue.front()->txQMsduHandle);
+}
+
+void
+RitWpanMac::NotifyNwkTxClass(uint8_t msduHandle, const RitTxQueueClass& txClass)
+{
+    NS_LOG_FUNCTION(this << static_cast<uint32_t>(msduHandle)
+                         << static_cast<uint32_t>(txClass.priority) << txClass.origin);
+    m_pendingTxClass[msduHandle] = txClass;
+}
+
+void
+RitWpanMac::EnqueueTxQElement(Ptr<TxQueueElement> txQElement)
+{
+    NS_LOG_FUNCTION(this << static_cast<uint32_t>(txQElement->txQMsduHandle));
+
+    RitTxQueueEntry entry;
+    entry.txClass.origin = GetShortAddress();
+    entry.enqueueTime = Simulator::Now();
+    auto pending = m_pendingTxClass.find(txQElement->txQMsduHandle);
+    if (pending != m_pendingTxClass.end())
+    {
+        entry.txClass = pending->second;
+        m_pendingTxClass.erase(pending);
+    }
+
+    if (m_txQueueCapacity > 0 && m_txQueue.size() >= m_txQueueCapacity)
+    {
+        const size_t victim = SelectTxQueueVictim(entry.txClass);
+        if (victim == m_txQueue.size())
+        {
+            NS_LOG_DEBUG("TX queue full (" << m_txQueue.size() << "), dropping the new frame");
+            m_macTxDropTrace(txQElement->txQPkt);
+            m_txQueueDropTrace(txQElement->txQPkt, Time());
+            if (!m_mcpsDataConfirmCallback.IsNull())
+            {
+                McpsDataConfirmParams confirmParams;
+                confirmParams.m_msduHandle = txQElement->txQMsduHandle;
+                confirmParams.m_status = MacStatus::TRANSACTION_OVERFLOW;
+                m_mcpsDataConfirmCallback(confirmParams);
+            }
+            return;
+        }
+        DropTxQElement(victim);
+    }
+
+    // Behind the frames of the same or a higher class.
+    auto position = m_txQueue.end();
+    if (m_txQueuePriorityEnabled)
+    {
+        for (size_t i = GetFirstMovableTxQIndex(); i < m_txQueue.size(); i++)
+        {
+            if (GetTxQueueClass(i).priority < entry.txClass.priority)
+            {
+                position = m_txQueue.begin() + i;
+                break;
+            }
+        }
+    }
+    m_txQueueEntries[PeekPointer(txQElement)] = entry;
+    m_txQueue.insert(position, txQElement);
+    m_txQueueOccupancy = m_txQueue.size();
+    m_macTxEnqueueTrace(txQElement->txQPkt);
+    m_txQueueEnqueueTrace(txQElement->txQPkt, Time());
+}
+
+void
+RitWpanMac::RemoveFirstTxQElement()
+{
+    NS_ASSERT(!m_txQueue.empty());
+    const TxQueueElement* head = PeekPointer(m_txQueue.front());
+    Ptr<const Packet> p = head->txQPkt;
+    Time sojourn;
+    auto it = m_txQueueEntries.find(head);
+    if (it != m_txQueueEntries.end())
+    {
+        sojourn = Simulator::Now() - it->second.enqueueTime;
+        m_txQueueEntries.erase(it);
+    }
+
+    LrWpanMac::RemoveFirstTxQElement();
+    m_txQueueOccupancy = m_txQueue.size();
+    m_txQueueDequeueTrace(p, sojourn);
+}
+
+size_t
+RitWpanMac::GetFirstMovableTxQIndex() const
+{
+    return (!m_txQueue.empty() && (m_txPkt || IsSenderMode())) ? 1 : 0;
+}
+
+RitTxQueueClass
+RitWpanMac::GetTxQueueClass(size_t index) const
+{
+    auto it = m_txQueueEntries.find(PeekPointer(m_txQueue[index]));
+    if (it != m_txQueueEntries.end())
+    {
+        return it->second.txClass;
+    }
+    // Queued without EnqueueTxQElement (indirect transmission)
+    RitTxQueueClass txClass;
+    txClass.origin = GetShortAddress();
+    return txClass;
+}
+
+size_t
+RitWpanMac::SelectTxQueueVictim(const RitTxQueueClass& txClass) const
+{
+    const size_t first = GetFirstMovableTxQIndex();
+    // With priorities, a frame only pushes out frames of its own or a lower class.
+    auto droppable = [this, &txClass](size_t i) {
+        return !m_txQueuePriorityEnabled || GetTxQueueClass(i).priority <= txClass.priority;
+    };
+
+    switch (m_txQueueDropPolicy)
+    {
+    case RIT_TX_QUEUE_HEAD_DROP:
+        for (size_t i = first; i < m_txQueue.size(); i++)
+        {
+            if (droppable(i))
+            {
+                return i;
+            }
+        }
+        break;
+    case RIT_TX_QUEUE_ORIGIN_DROP:
+        // An origin without queued frames loses its new frame instead.
+        for (size_t i = first; i < m_txQueue.size(); i++)
+        {
+            if (droppable(i) && GetTxQueueClass(i).origin == txClass.origin)
+            {
+                return i;
+            }
+        }
+        break;
+    case RIT_TX_QUEUE_TAIL_DROP:
+        // The queue is sorted by class: the last frame is the lowest one.
+        if (m_txQueuePriorityEnabled && m_txQueue.size() > first &&
+            GetTxQueueClass(m_txQueue.size() - 1).priority < txClass.priority)
+        {
+            return m_txQueue.size() - 1;
+        }
+        break;
+    }
+    return m_txQueue.size();
+}
+
+void
+RitWpanMac::DropTxQElement(size_t index)
+{
+    NS_ASSERT(index >= GetFirstMovableTxQIndex() && index < m_txQueue.size());
+    Ptr<TxQueueElement> txQElement = m_txQueue[index];
+    Time sojourn;
+    auto it = m_txQueueEntries.find(PeekPointer(txQElement));
+    if (it != m_txQueueEntries.end())
+    {
+        sojourn = Simulator::Now() - it->second.enqueueTime;
+        m_txQueueEntries.erase(it);
+    }
+    m_txQueue.erase(m_txQueue.begin() + index);
+    m_txQueueOccupancy = m_txQueue.size();
+    m_hopLatency.erase(txQElement->txQMsduHandle);
+
+    NS_LOG_DEBUG("TX queue full, dropping queued frame " << index << " after "
+                                                        << sojourn.As(Time::MS));
+    m_macTxDropTrace(txQElement->txQPkt);
+    m_txQueueDropTrace(txQElement->txQPkt, sojourn);
+    if (!m_mcpsDataConfirmCallback.IsNull())
+    {
+        McpsDataConfirmParams confirmParams;
+        confirmParams.m_msduHandle = txQElement->txQMsduHandle;
+        confirmParams.m_status = MacStatus::TRANSACTION_OVERFLOW;
+        m_mcpsDataConfirmCallback(confirmParams);
+    }
+}
+
+void
+RitWpanMac::AddressTxQElement(Ptr<TxQueueElement> txQElement)
+{
+    NS_LOG_FUNCTION(this << static_cast<uint32_t>(txQElement->txQMsduHandle));
+    auto it = m_txQueueEntries.find(PeekPointer(txQElement));
+    RitTxQueueEntry unqueued;
+    RitTxQueueEntry& entry = it != m_txQueueEntries.end() ? it->second : unqueued;
+    if (!entry.msdu)
+    {
+        // Not queued by McpsDataRequest(): split the frame (once, if it has an entry).
+        Ptr<Packet> msdu = txQElement->txQPkt->Copy();
+        LrWpanMacTrailer macTrailer;
+        msdu->RemoveTrailer(macTrailer);
+        msdu->RemoveHeader(entry.macHdr);
+        entry.hasSubHdr = m_moduleConfig.continuousTxEnabled;
+        if (entry.hasSubHdr)
+        {
+            msdu->RemoveHeader(entry.subHdr);
+        }
+        entry.msdu = msdu;
+    }
+
+    // *module* Continuous TX: announce whether more queued frames follow in this
+    // rendezvous. Every queued frame goes to the receiver of the current beacon.
+    m_burstMoreData = entry.hasSubHdr && m_txQueue.size() > 1;
+    // The burst of a frame train announces the next frame with the frame pending bit.
+    const bool framePending = m_ritMacMode == STROBE_MODE && m_txQueue.size() > 1;
+    if (entry.macHdr.GetDstAddrMode() == SHORT_ADDR &&
+        entry.macHdr.GetShortDstAddr() == m_lastRxRitReqFrameSrcAddr &&
+        (!entry.hasSubHdr || entry.subHdr.isContinuous() == m_burstMoreData) &&
+        entry.macHdr.IsFrmPend() == framePending)
+    {
+        return;
+    }
+
+    entry.macHdr.SetDstAddrMode(SHORT_ADDR);
+    entry.macHdr.SetDstAddrFields(GetPanId(), m_lastRxRitReqFrameSrcAddr);
+    entry.subHdr.SetContinuous(m_burstMoreData);
+    if (framePending)
+    {
+        entry.macHdr.SetFrmPend();
+    }
+    else
+    {
+        entry.macHdr.SetNoFrmPend();
+    }
+
+    Ptr<Packet> pkt = entry.msdu->Copy();
+    if (entry.hasSubHdr)
+    {
+        pkt->AddHeader(entry.subHdr);
+    }
+    pkt->AddHeader(entry.macHdr);
+    // The FCS covers the new header.
+    LrWpanMacTrailer macTrailer;
+    if (Node::ChecksumEnabled())
+    {
+        macTrailer.EnableFcs(true);
+        macTrailer.SetFcs(pkt);
+    }
+    pkt->AddTrailer(macTrailer);
+    txQElement->txQPkt = pkt;
+}
+
+void
+RitWpanMac::SecureTxQElement(Ptr<TxQueueElement> txQElement)
+{
+    NS_LOG_FUNCTION(this << static_cast<uint32_t>(txQElement->txQMsduHandle));
+    Ptr<Packet> pkt = txQElement->txQPkt->Copy();
+    LrWpanMacTrailer macTrailer;
+    pkt->RemoveTrailer(macTrailer);
+    LrWpanMacHeader macHdr;
+    pkt->RemoveHeader(macHdr);
+    m_frameSecurity.Secure(macHdr);
+    pkt->AddHeader(macHdr);
+    if (Node::ChecksumEnabled())
+    {
+        macTrailer.EnableFcs(true);
+        macTrailer.SetFcs(pkt);
+    }
+    pkt->AddTrailer(macTrailer);
+    txQElement->txQPkt = pkt;
+
+    // Keep the header of the queue entry in step for the next readdressing.
+    auto it = m_txQueueEntries.find(PeekPointer(txQElement));
+    if (it != m_txQueueEntries.end() && it->second.msdu)
+    {
+        it->second.macHdr = macHdr;
+    }
+}
+
+void
+RitWpanMac::PruneHopLatency()
+{
+    if (m_hopLatency.empty())
+    {
+        return;
+    }
+    for (auto it = m_hopLatency.begin(); it != m_hopLatency.end();)
+    {
+        bool queued = false;
+        for (const auto& txQElement : m_txQueue)
+        {
+            if (txQElement->txQMsduHandle == it->first)
+            {
+                queued = true;
+                break;
+            }
+        }
+        it = queued ? std::next(it) : m_hopLatency.erase(it);
+    }
+}
 
 void
 RitWpanMac::SetRxAlwaysOn(bool alwaysOn)
 {
     NS_LOG_FUNCTION(this << alwaysOn);
+    ResumeElidedDataWait();
     // Configure whether the receiver should stay enabled even when the MAC is idle.
     m_rxAlwaysOn = alwaysOn;
 }
 
+bool
+RitWpanMac::GetRxAlwaysOn() const
+{
+    return m_rxAlwaysOn;
+}
+
+RitMacCheckpoint
+RitWpanMac::GetCheckpoint() const
+{
+    const Time now = Simulator::Now();
+    RitMacCheckpoint checkpoint;
+    checkpoint.period = GetRitPeriodTime();
+    checkpoint.nextRequest = m_ritTimers.GetDelayLeft(RIT_PERIODIC_REQUEST_TIMER);
+    checkpoint.skewPpm = m_clockDriftApplier->GetSkewPpm();
+    for (const auto& [addr, phase] : m_beaconPhases)
+    {
+        checkpoint.phases.push_back({addr, now - phase.lastBeacon, phase.period});
+    }
+    return checkpoint;
+}
+
+void
+RitWpanMac::RestoreCheckpoint(const RitMacCheckpoint& checkpoint)
+{
+    NS_LOG_FUNCTION(this << checkpoint.period << checkpoint.nextRequest);
+    ResumeElidedDataWait();
+    const Time now = Simulator::Now();
+    if (checkpoint.period.IsStrictlyPositive())
+    {
+        m_macRitPeriodTime = checkpoint.period;
+    }
+    m_clockDriftApplier->SetSkewPpm(checkpoint.skewPpm);
+    m_beaconPhases.clear();
+    m_appointments.clear();
+    for (const auto& phase : checkpoint.phases)
+    {
+        m_beaconPhases[phase.addr] = RitBeaconPhase{now - phase.age, phase.period};
+    }
+    if (m_ritTimers.IsPending(RIT_PERIODIC_REQUEST_TIMER) &&
+        checkpoint.nextRequest.IsStrictlyPositive())
+    {
+        m_ritTimers.Schedule(RIT_PERIODIC_REQUEST_TIMER, checkpoint.nextRequest);
+    }
+}
+
+int64_t
+RitWpanMac::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    int64_t currentStream = stream;
+    currentStream += LrWpanMac::AssignStreams(currentStream);
+    m_initialPhase->SetStream(currentStream++);
+    currentStream += m_timeDriftApplier->AssignStreams(currentStream);
+    currentStream += m_clockDriftApplier->AssignStreams(currentStream);
+    return currentStream - stream;
+}
+
+uint64_t
+RitWpanMac::GetNElidedCycles() const
+{
+    return m_nElidedCycles;
+}
+
+uint64_t
+RitWpanMac::GetNOverheardRxShortcuts() const
+{
+    return m_nOverheardRxShortcuts;
+}
+
+uint64_t
+RitWpanMac::GetNDataWaitProbeShortcuts() const
+{
+    return m_nDataWaitProbeShortcuts;
+}
+
+uint64_t
+RitWpanMac::GetNAppointmentsGranted() const
+{
+    return m_nAppointmentsGranted;
+}
+
+uint64_t
+RitWpanMac::GetNAppointmentsReceived() const
+{
+    return m_nAppointmentsReceived;
+}
+
+uint64_t
+RitWpanMac::GetNRxDuplicates() const
+{
+    return m_nRxDuplicates;
+}
+
+uint64_t
+RitWpanMac::GetNOverheardTxDeferrals() const
+{
+    return m_nOverheardTxDeferrals;
+}
+
+uint64_t
+RitWpanMac::GetNBeaconPhaseShifts() const
+{
+    return m_nBeaconPhaseShifts;
+}
+
 // Return the effective RIT period as a Time value.
 // Depending on the configuration, this is either taken directly from the
 // time-based parameter or converted from the legacy duration-based value.
@@ -1880,17 +4764,35 @@ RitWpanMac::GetRitTxWaitDurationTime() const
 Time
 RitWpanMac::GetContinuousTxTimeoutTime() const
 {
-    // TODO: Accurately derive the extended data-reception wait time for continuous transmission.
-    //       This may depend on the last data TX duration or PHY parameters.
-    // return m_lastDataTxDuration;
-    return MilliSeconds(10);
+    // Wait for the next frame of a burst (or the data after a beacon ACK): the sender's
+    // LIFS and RX-to-TX turnaround, its channel access and a frame of the maximum size.
+    uint64_t symbols = m_macLIFSPeriod + lrwpan::aTurnaroundTime;
+    if (m_carrierSense && m_carrierSense->IsEnabled(RIT_CS_DATA_FRAME))
+    {
+        // Worst case of unslotted CSMA/CA: every backoff at its maximum, each followed by a
+        // CCA (8 symbols). It also bounds the stages that sense less.
+        uint8_t be = m_csmaCa->GetMacMinBE();
+        for (uint8_t nb = 0; nb <= m_csmaCa->GetMacMaxCSMABackoffs(); nb++)
+        {
+            symbols += ((uint64_t(1) << be) - 1) * lrwpan::aUnitBackoffPeriod + 8;
+            be = std::min<uint8_t>(be + 1, m_csmaCa->GetMacMaxBE());
+        }
+    }
+    symbols += m_phy->GetPhySHRDuration();
+    symbols += static_cast<uint64_t>(std::ceil((1 + lrwpan::aMaxPhyPacketSize) *
+                                               m_phy->GetPhySymbolsPerOctet()));
+    return Seconds(static_cast<double>(symbols) / m_phy->GetDataOrSymbolRate(false));
 }
 
 void
 RitWpanMac::SetModuleConfig(const RitWpanMacModuleConfig& config)
 {
+    ResumeElidedDataWait();
     // Apply the RIT MAC module configuration (feature flags and behavior switches).
     m_moduleConfig = config;
+    m_ritDataRequestTemplate = nullptr;
+    ConfigureHeaderIndication();
+    ApplyCarrierSenseConfig();
 }
 
 RitWpanMacModuleConfig
@@ -1913,9 +4815,13 @@ void
 RitWpanMac::SetRitModuleConfig(const RitWpanMacModuleConfig& config)
 {
     NS_LOG_FUNCTION(this);
+    ResumeElidedDataWait();
     // Set the RIT MAC module configuration (feature flags and behavior options).
     // This overwrites the current configuration without changing ongoing state.
     m_moduleConfig = config;
+    m_ritDataRequestTemplate = nullptr;
+    ConfigureHeaderIndication();
+    ApplyCarrierSenseConfig();
 }
 
 
@@ -13,17 +13,33 @@
 #include "ns3/clock-drift-applier.h"
 #include "ns3/lr-wpan-mac-header.h"
 #include "ns3/lr-wpan-mac.h"
+#include "ns3/rit-airtime-budget.h"
+#include "ns3/rit-duplicate-cache.h"
+#include "ns3/rit-frame-security.h"
+#include "ns3/rit-ie.h"
+#include "ns3/rit-mac-timer-set.h"
+#include "ns3/rit-hop-latency-tag.h"
+#include "ns3/rit-period-policy.h"
+#include "ns3/rit-run-arena.h"
+#include "ns3/rit-sub-header.h"
 #include "ns3/time-drift-applier.h"
 
 #include <cstdint>
+#include <deque>
+#include <map>
+#include <memory_resource>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace ns3
 {
 namespace lrwpan
 {
 
-class RitWpanPreCs;
-class RitWpanPreCsB;
+class RitCarrierSensePipeline;
+class RitSenderRegistry;
 
 /**
  * @brief Enum representing the MAC operation mode.
@@ -34,7 +50,36 @@ enum RitMacMode
     SENDER_MODE,
     RECEIVER_MODE,
     SLEEP_MODE,
-    BOOTSTRAP_MODE
+    BOOTSTRAP_MODE,
+    STROBE_MODE
+};
+
+/**
+ * @brief Queue class of a data frame, given by the NWK layer.
+ */
+struct RitTxQueueClass
+{
+    uint8_t priority{0}; //!< Priority class, higher classes are served first
+    Mac16Address origin; //!< Node the frame comes from (previous hop when forwarded)
+};
+
+/**
+ * @brief Frame dropped by a full TX queue (TxQueueCapacity).
+ */
+enum RitTxQueueDropPolicy
+{
+    RIT_TX_QUEUE_TAIL_DROP,   //!< The arriving frame
+    RIT_TX_QUEUE_HEAD_DROP,   //!< The oldest queued frame
+    RIT_TX_QUEUE_ORIGIN_DROP, //!< The oldest queued frame from the origin of the arriving one
+};
+
+/**
+ * @brief Beacon that does not fit in the TX airtime budget (DutyCycleLimit).
+ */
+enum RitDutyCyclePolicy
+{
+    RIT_DUTY_CYCLE_SKIP_BEACON,     //!< Skipped, the next one is due a period later
+    RIT_DUTY_CYCLE_LENGTHEN_PERIOD, //!< Skipped, the next one is sent once it fits
 };
 
 /**
@@ -56,7 +101,7 @@ struct MlmeRitRequestIndicationParams
     Mac64Address m_dstExtAddr;  //!< Destination extended address (if applicable)
 
     std::vector<uint8_t> m_ritRequestPayload; //!< RIT Request Payload field (octet stream)
-    // std::vector<HeaderIe> m_headerIeList;   //!< List of header IEs (excluding Termination IE)
+    RitIeView m_headerIeList; //!< Header IEs, excluding Termination IE (headerIesEnabled)
     // std::vector<PayloadIe> m_payloadIeList; //!< List of payload IEs (excluding Termination IE)
 
     uint8_t m_linkQuality{0};   //!< LQI value (0x00 to 0xff)
@@ -147,6 +192,15 @@ struct MlmeRitResponseConfirmParams
 using MlmeRitRequestIndicationCallback =
     Callback<void, MlmeRitRequestIndicationParams>; //!< Callback for MLME-RIT-REQ.indication
 
+using MlmeBootstrapConfirmCallback =
+    Callback<void>; //!< Callback for the end of a bootstrap listen period
+
+using MlmeRitTxWaitTimeoutCallback =
+    Callback<void>; //!< Callback for a sender cycle that heard no RIT Data Request
+
+using MlmeAckIeIndicationCallback =
+    Callback<void, Mac16Address, RitIeView>; //!< Header IEs in the ACK of a data frame sent
+
 using MlmeRitRequestConfirmCallback =
     Callback<void, MacStatus>; //!< Callback for MLME-RIT-REQ.confirm
 
@@ -180,6 +234,43 @@ struct RitWpanMacModuleConfig
     bool beaconRandomizeEnabled = false;
     bool compactRitDataRequestEnabled = false;
     bool beaconAckEnabled = false;
+    bool earlyRxAbortEnabled = false; //!< Drop frames for other nodes after the MAC header
+    bool fusedTrxEnabled = false;     //!< Wake, send the beacon and enter RX in one PHY call
+    /// Skip the data wait of idle cycles nobody can hear or disturb, waking up only if a
+    /// neighbour does (needs range culling and a RitSenderRegistry)
+    bool idleCycleElisionEnabled = false;
+    bool phaseLearningEnabled = false; //!< Wake the sender just before the receiver's beacon
+    bool overhearingAvoidanceEnabled = false; //!< Cut cycles short on a foreign rendezvous
+    bool contentionSlotsEnabled = false; //!< Serve several senders per beacon in slots
+    bool beaconDeconflictionEnabled = false; //!< Move the beacon away from neighbour beacons
+    bool dataWaitProbeEnabled = false; //!< End the data wait when no sender answers the beacon
+    bool ackAppointmentsEnabled = false; //!< Grant the next beacon time in the data ACK
+    bool headerIesEnabled = false; //!< Header IEs in the RIT Data Requests and data ACKs
+    bool duplicateFilterEnabled = false; //!< Indicate a retried data frame only once
+};
+
+/**
+ * @brief Warm-up state of a RitWpanMac, saved by a checkpoint.
+ *
+ * Times are relative to the checkpoint. Queued frames, frame exchanges in
+ * progress and the PHY state are not part of it.
+ */
+struct RitMacCheckpoint
+{
+    /**
+     * @brief Learned beacon phase of a neighbour (phaseLearningEnabled).
+     */
+    struct Phase
+    {
+        Mac16Address addr; //!< Beaconing neighbour
+        Time age;          //!< Time since its last beacon
+        Time period;       //!< Estimated beacon period
+    };
+
+    Time period;               //!< Current RIT period, period adaptation included
+    Time nextRequest;          //!< Delay to the next periodic RIT request, zero if none
+    double skewPpm{0.0};       //!< Clock skew
+    std::vector<Phase> phases; //!< Learned beacon phases
 };
 
 class RitWpanMac : public LrWpanMac
@@ -203,6 +294,19 @@ class RitWpanMac : public LrWpanMac
      */
     void MlmeSetRequest(MacPibAttributeIdentifier id, Ptr<MacPibAttributes> attribute) override;
 
+    /**
+     * @brief Set the RIT durations at once.
+     *
+     * Same as the MLME-SET.requests of macRitDataWaitDurationTime,
+     * macRitTxWaitDurationTime and macRitPeriodTime, in that order, without
+     * the PIB attribute object and the confirms.
+     *
+     * @param period RIT period (zero stops the RIT cycle)
+     * @param dataWaitDuration Receiver data wait duration after a beacon
+     * @param txWaitDuration Sender wait duration for a beacon
+     */
+    void SetRitTimes(Time period, Time dataWaitDuration, Time txWaitDuration);
+
     /**
      * @brief MLME-GET.request from upper layer.
      * @param id Attribute identifier
@@ -224,21 +328,97 @@ class RitWpanMac : public LrWpanMac
      */
     void SetMlmeRitRequestIndicationCallback(MlmeRitRequestIndicationCallback c);
 
+    /**
+     * @brief Listen for RIT Data Requests for a bounded time (BOOTSTRAP_MODE).
+     *
+     * Stops the RIT cycle and keeps the receiver on. Every RIT Data Request heard is
+     * passed to the MLME-RIT-REQ.indication callback and nothing is sent. At the end
+     * the bootstrap confirm callback is called, then the RIT cycle restarts unless
+     * the callback requested another listen period.
+     * @param duration Listen duration
+     */
+    void MlmeBootstrapRequest(Time duration);
+
+    /**
+     * @brief Set the callback for the end of a bootstrap listen period.
+     */
+    void SetMlmeBootstrapConfirmCallback(MlmeBootstrapConfirmCallback c);
+
+    /**
+     * @brief Set the callback for a sender cycle ended by the TWD timeout.
+     */
+    void SetMlmeRitTxWaitTimeoutCallback(MlmeRitTxWaitTimeoutCallback c);
+
+    /**
+     * @brief Set the callback for the header IEs in the ACK of a data frame sent
+     *        (headerIesEnabled).
+     *
+     * Called with the receiver and the parsed IEs, the appointment IE included.
+     */
+    void SetMlmeAckIeIndicationCallback(MlmeAckIeIndicationCallback c);
+
+    /**
+     * @brief Set the header IEs of the RIT Data Requests (headerIesEnabled).
+     *
+     * They precede macRitRequestPayload and reach the neighbours in the m_headerIeList of
+     * the MLME-RIT-REQ.indication, the payload starting after them.
+     * @param ies IEs of the next beacons
+     */
+    void SetRitRequestIes(const RitIeList& ies);
+
+    /**
+     * @brief Set the header IEs of the ACKs of data frames (headerIesEnabled).
+     *
+     * The appointment IE of ackAppointmentsEnabled follows them. The list must leave room
+     * for it within the RitIeView capacity.
+     * @param ies IEs of the next ACKs
+     */
+    void SetAckIes(const RitIeList& ies);
+
     /**
      * @brief PD-DATA.indication callback from PHY layer.
      */
     void PdDataIndication(uint32_t psduLength, Ptr<Packet> p, uint8_t lqi) override;
 
+    /**
+     * @brief MAC header indication callback from PHY layer (earlyRxAbortEnabled).
+     *
+     * Runs the Level 3 filter on the MAC header. The frames that would be rejected
+     * at PD-DATA.indication are dropped right away; in RECEIVER_MODE the transceiver
+     * is also turned off for the rest of the frame.
+     * @param p The packet being received
+     * @param macHdr MAC header of the packet
+     * @param remaining Remaining duration of the frame
+     * @return true to go on receiving the frame
+     */
+    bool PdHeaderIndication(Ptr<const Packet> p, const LrWpanMacHeader& macHdr, Time remaining);
+
     /**
      * @brief PD-DATA.confirm callback from PHY layer.
      */
     void PdDataConfirm(PhyEnumeration status) override;
 
+    /**
+     * @brief PLME-ED.confirm callback from PHY layer.
+     *
+     * The result of the data wait probe (dataWaitProbeEnabled) is consumed here; any other
+     * energy detection is left to LrWpanMac.
+     * @param status SUCCESS, TRX_OFF or TX_ON
+     * @param energyLevel The energy level measured
+     */
+    void PlmeEdConfirm(PhyEnumeration status, uint8_t energyLevel);
+
     /**
      * @brief IFS wait timeout handler.
      */
     void IfsWaitTimeout(Time ifsTime) override;
 
+    /**
+     * @brief Set the RIT module configuration.
+     *
+     * Also (un)registers the MAC header indication of the PHY for earlyRxAbortEnabled, and
+     * selects the carrier-sense stages of the CSMA / Pre-CS flags.
+     */
     void SetModuleConfig(const RitWpanMacModuleConfig& config);
     RitWpanMacModuleConfig GetModuleConfig() const;
 
@@ -247,7 +427,18 @@ class RitWpanMac : public LrWpanMac
      */
     void SetRitModuleConfig(const RitWpanMacModuleConfig& config);
 
-    void SetPreCs(Ptr<RitWpanPreCs> preCs);
+    /**
+     * @brief Set the carrier-sense stages run before beacons and data frames.
+     *
+     * The module flags select the stage of each frame kind (see SetModuleConfig()).
+     */
+    void SetCarrierSense(Ptr<RitCarrierSensePipeline> carrierSense);
+
+    /**
+     * @brief Get the carrier-sense stages of the MAC.
+     * @return the stages, with their counters
+     */
+    Ptr<RitCarrierSensePipeline> GetCarrierSense() const;
 
     /**
      * @brief Trigger RIT data transmission (sender-side).
@@ -259,6 +450,320 @@ class RitWpanMac : public LrWpanMac
      */
     void SetRxAlwaysOn(bool alwaysOn);
 
+    /**
+     * @brief Get receiver always-on behavior.
+     * @return true if the receiver stays on between the RIT cycles
+     */
+    bool GetRxAlwaysOn() const;
+
+    /**
+     * @brief Get the warm-up state of the MAC.
+     * @return the state, times relative to now
+     */
+    RitMacCheckpoint GetCheckpoint() const;
+
+    /**
+     * @brief Continue from a saved warm-up state.
+     *
+     * Sets the RIT period, the clock skew and the learned beacon phases, and moves
+     * the next periodic RIT request if the RIT cycle runs. Call it after the
+     * device is configured and before the simulation starts.
+     *
+     * @param checkpoint The state
+     */
+    void RestoreCheckpoint(const RitMacCheckpoint& checkpoint);
+
+    /**
+     * @brief Assign fixed random variable streams to the MAC.
+     *
+     * Covers the base MAC and its CSMA/CA (2), the initial RIT phase (1), the
+     * beacon interval randomization (1) and the clock drift (2).
+     *
+     * @param stream First stream index to use
+     * @return the number of stream indices assigned (6)
+     */
+    int64_t AssignStreams(int64_t stream);
+
+    /**
+     * @brief Number of idle cycles whose data wait was skipped (idleCycleElisionEnabled).
+     */
+    uint64_t GetNElidedCycles() const;
+
+    /**
+     * @brief Number of data waits ended on an overheard foreign rendezvous
+     *        (overhearingAvoidanceEnabled).
+     */
+    uint64_t GetNOverheardRxShortcuts() const;
+
+    /**
+     * @brief Number of beacon waits deferred because the receiver was overheard busy with
+     *        another sender (overhearingAvoidanceEnabled).
+     */
+    uint64_t GetNOverheardTxDeferrals() const;
+
+    /**
+     * @brief Number of data waits ended because the probe found no energy
+     *        (dataWaitProbeEnabled).
+     */
+    uint64_t GetNDataWaitProbeShortcuts() const;
+
+    /**
+     * @brief Delay of the data wait probe from the start of the data wait
+     *        (dataWaitProbeEnabled).
+     *
+     * A sender answering the beacon turns its transceiver around after the carrier sense
+     * selected for data frames: no carrier sense, a single CCA (Pre-CS), or the longest
+     * first backoff of its CSMA/CA (macMinBE) followed by a CCA. The MCU encrypts a secured
+     * frame before (SecurityEncryptDelay). The probe starts once every sender must have
+     * started its frame, DataWaitProbeGuard later.
+     * @return the probe delay
+     */
+    Time GetDataWaitProbeDelay() const;
+
+    /**
+     * @brief Number of beacon appointments granted in the ACK of a data frame
+     *        (ackAppointmentsEnabled).
+     */
+    uint64_t GetNAppointmentsGranted() const;
+
+    /**
+     * @brief Number of beacon appointments received in the ACK of a data frame
+     *        (ackAppointmentsEnabled).
+     */
+    uint64_t GetNAppointmentsReceived() const;
+
+    /**
+     * @brief Number of data frames acknowledged but not indicated, their source and DSN
+     *        being in the duplicate cache (duplicateFilterEnabled).
+     */
+    uint64_t GetNRxDuplicates() const;
+
+    /**
+     * @brief Number of beacon phase shifts away from a neighbour beacon
+     *        (beaconDeconflictionEnabled).
+     */
+    uint64_t GetNBeaconPhaseShifts() const;
+
+    /**
+     * @brief Set the channel this node beacons and listens on.
+     *
+     * With a receive channel set, the beacons carry it as the last octet of their
+     * command payload, and the sender retunes to the receive channel of the head-of-line
+     * destination when it enters SENDER_MODE (ChannelSwitchTime later it opens the beacon
+     * wait), then back to its own one. The setting must be shared by the whole network.
+     * @param channel The receive channel (0: single channel, the PHY channel is kept)
+     */
+    void SetRxChannel(uint8_t channel);
+
+    /**
+     * @brief Get the channel this node beacons and listens on.
+     * @return the receive channel, 0 if unset
+     */
+    uint8_t GetRxChannel() const;
+
+    /**
+     * @brief Advertise another receive channel in the next RIT Data Request (RxChannel).
+     *
+     * The senders that hear that beacon learn the channel: they answer it here, then send
+     * their next frames on the given channel. A multi-radio gateway moves children from
+     * a busy radio to an idle one this way.
+     * @param channel The channel to advertise once (0: cancel)
+     */
+    void RedirectNextBeacon(uint8_t channel);
+
+    /**
+     * @brief Number of RIT Data Requests sent with a redirect channel.
+     */
+    uint64_t GetNBeaconRedirects() const;
+
+    /**
+     * @brief Set the receive channel of a neighbour (RxChannel). The beacons heard from
+     *        the neighbour update it.
+     * @param neighbour Short address of the neighbour
+     * @param channel Its receive channel (0: forget it, back to the channel plan)
+     */
+    void SetNeighbourRxChannel(Mac16Address neighbour, uint8_t channel);
+
+    /**
+     * @brief Get the receive channel of a neighbour.
+     * @param neighbour Short address of the neighbour
+     * @return its receive channel (learned, set or planned), 0 if unknown
+     */
+    uint8_t GetNeighbourRxChannel(Mac16Address neighbour) const;
+
+    /**
+     * @brief Set the channel plan of the network (RxChannel): a neighbour without an
+     *        entry of its own listens on GetPlannedRxChannel() of its short address.
+     * @param firstChannel First channel of the plan
+     * @param nChannels Number of channels of the plan (0: no plan)
+     */
+    void SetRxChannelPlan(uint8_t firstChannel, uint8_t nChannels);
+
+    /**
+     * @brief Receive channel of a node in a channel plan.
+     * @param addr Short address of the node
+     * @param firstChannel First channel of the plan
+     * @param nChannels Number of channels of the plan
+     * @return firstChannel + (addr mod nChannels)
+     */
+    static uint8_t GetPlannedRxChannel(Mac16Address addr, uint8_t firstChannel, uint8_t nChannels);
+
+    /**
+     * @brief Number of PHY channel changes (RxChannel).
+     */
+    uint64_t GetNChannelSwitches() const;
+
+    /**
+     * @brief Number of broadcast data frames sent, one per beacon answered.
+     *
+     * A frame addressed to the broadcast short address stays at the head of the TX
+     * queue for BroadcastHoldTime and answers the first beacon of each neighbour heard
+     * meanwhile, without an ACK. It is then confirmed SUCCESS, or NO_ACK if no beacon
+     * was heard.
+     */
+    uint64_t GetNBroadcastTx() const;
+
+    /**
+     * @brief Number of data frames sent in frame trains, one per copy.
+     *
+     * With more than HybridQueueThreshold frames queued, a sender cycle does not wait
+     * for a beacon: in STROBE_MODE, the head frame is sent to the last receiver that
+     * acknowledged a frame, again after each ACK wait, until the data wait that follows
+     * a beacon of the receiver catches a copy (StrobeTrainTime at most). The queued
+     * frames follow with the frame pending bit, which keeps the receiver listening,
+     * and the sender is back to RIT once the queue is empty. An unanswered train falls
+     * back to a RIT sender cycle and forgets the receiver.
+     */
+    uint64_t GetNStrobeFrames() const;
+
+    /**
+     * @brief Total airtime of the frames transmitted (beacons, data, ACKs).
+     * @return the TX airtime since the start
+     */
+    Time GetTxAirtime() const;
+
+    /**
+     * @brief Number of transmissions put off by the TX airtime budget.
+     *
+     * With a DutyCycleLimit, the airtime transmitted over the last DutyCycleWindow
+     * may not exceed the limit times the window. A beacon is sent only if its airtime
+     * and that of the ACK of the data it invites fit, and is otherwise skipped
+     * (DutyCyclePolicy: the next one is due a period later, or once it fits). A data
+     * frame that does not fit stays queued: no sender cycle starts, or the current one
+     * ends, until a later period. Each case fires the DutyCycle trace.
+     */
+    uint64_t GetNDutyCycleDeferrals() const;
+
+    /**
+     * @brief Get the frame security cost model of the MAC.
+     *
+     * With a SecurityLevel, data frames, and RIT Data Requests unless
+     * SecureRitDataRequest is off, carry the auxiliary security header and the MIC of
+     * the level. A data frame answering a beacon is sent SecurityEncryptDelay after
+     * it, and a secured data frame received is indicated to the upper layer
+     * SecurityDecryptDelay after the previous one was, as by a single crypto engine.
+     * Secured frames older than the last frame counter of their source are dropped as
+     * replays.
+     * @return the model
+     */
+    const RitFrameSecurity& GetFrameSecurity() const;
+
+    /**
+     * @brief Set the policy adapting the RIT period to the inbound load.
+     *
+     * Every RitPeriodAdaptationWindow, the policy gets the load of the window and
+     * returns the next period, clamped to [RitPeriodMin, RitPeriodMax]. Null keeps
+     * the configured period.
+     * @param policy The policy
+     */
+    void SetRitPeriodPolicy(Ptr<RitPeriodPolicy> policy);
+
+    /**
+     * @brief Get the policy adapting the RIT period.
+     * @return the policy, or nullptr
+     */
+    Ptr<RitPeriodPolicy> GetRitPeriodPolicy() const;
+
+    /**
+     * @brief Record the NWK enqueue time of the frame requested next with this handle.
+     *
+     * No-op unless the HopLatencyEnabled attribute is set.
+     * @param msduHandle MSDU handle of the upcoming MCPS-DATA.request
+     */
+    void NotifyNwkEnqueue(uint8_t msduHandle);
+
+    /**
+     * @brief Set the queue class of the frame requested next with this handle.
+     *
+     * Frames without a class get priority 0 and this node as origin.
+     * @param msduHandle MSDU handle of the upcoming MCPS-DATA.request
+     * @param txClass Priority class and origin of the frame
+     */
+    void NotifyNwkTxClass(uint8_t msduHandle, const RitTxQueueClass& txClass);
+
+    /**
+     * TracedCallback signature for the TX queue events.
+     *
+     * @param [in] packet The frame
+     * @param [in] sojourn Time the frame spent in the TX queue (zero at enqueue)
+     */
+    typedef void (*TxQueueTracedCallback)(Ptr<const Packet> packet, Time sojourn);
+
+    /**
+     * TracedCallback signature for the per-hop latency breakdown.
+     *
+     * @param [in] record The stage timestamps of the hop
+     */
+    typedef void (*HopLatencyTracedCallback)(const RitHopLatencyRecord& record);
+
+    /**
+     * TracedCallback signature for a broadcast frame answering a beacon.
+     *
+     * @param [in] packet The frame
+     * @param [in] receiver Source of the beacon answered
+     */
+    typedef void (*BroadcastTxTracedCallback)(Ptr<const Packet> packet, Mac16Address receiver);
+
+    /**
+     * TracedCallback signature for a transmission put off by the TX airtime budget.
+     *
+     * @param [in] action "beacon-skip", "period-lengthen" or "data-defer"
+     * @param [in] wait Time until the transmission fits in the budget
+     */
+    typedef void (*DutyCycleTracedCallback)(std::string action, Time wait);
+
+    /**
+     * @brief Predict the next listen window for the beacon of a neighbour.
+     *
+     * Uses the beacon phases learned with phaseLearningEnabled or
+     * beaconDeconflictionEnabled; the window is centred on the predicted beacon.
+     * @param neighbour Short address of the beaconing neighbour
+     * @param [out] wakeDelay Delay from now to the opening of the window
+     * @param [out] window Length of the window
+     * @return false if there is no usable estimate for this neighbour
+     */
+    bool PredictBeacon(Mac16Address neighbour, Time& wakeDelay, Time& window) const;
+
+    /**
+     * @brief Get the MSDU handle of the head-of-line frame, the one the next
+     *        answered beacon receives.
+     * @param [out] msduHandle MSDU handle of the frame
+     * @return false if the queue is empty
+     */
+    bool GetTxQueueHeadHandle(uint8_t& msduHandle) const;
+
+    /**
+     * @brief Get the number of frames in the TX queue.
+     * @return the TX queue occupancy
+     */
+    uint32_t GetTxQueueOccupancy() const;
+
+    /**
+     * @brief Get the number of frames the TX queue holds (TxQueueCapacity).
+     * @return the TX queue capacity, 0 for unbounded
+     */
+    uint32_t GetTxQueueCapacity() const;
+
     // Time-based parameter getters
     Time GetRitPeriodTime() const;
     Time GetRitDataWaitDurationTime() const;
@@ -281,18 +786,166 @@ class RitWpanMac : public LrWpanMac
     void DoDispose() override;
 
     void Sleep();
-    void Bootstrap();
+    void BootstrapTimeout(); //!< End of a bootstrap listen period
     void RelayRequest(Ptr<Packet> relayPkt);
 
+    /**
+     * @brief Build the MLME-RIT-REQ.indication of a received RIT Data Request.
+     * @param lqi LQI of the frame
+     * @param payload RIT request payload, after the command header
+     * @param receivedMacHdr MAC header of the frame
+     * @return the indication parameters
+     */
+    MlmeRitRequestIndicationParams MakeRitRequestIndication(
+        uint8_t lqi,
+        Ptr<const Packet> payload,
+        const LrWpanMacHeader& receivedMacHdr) const;
+
     void ChangeRitMacMode(RitMacMode ritMacMode);
 
     void PeriodicRitDataRequest(); //!< Periodic RIT data request in sender mode
     void DoSendRitData();          //!< Process RIT data transmission
+    void TransmitRitData();        //!< Transmit the addressed, secured data frame
+    void DecryptionDone();         //!< Indicate the oldest data frame being decrypted
     void DoSendRitDataRequest();   //!< Send RIT Data Request command
     void DoSendRitBeaconAck();     //!< Send RIT Beacon Acknowledgment command
 
-    void ReceiveCommand(uint8_t lqi, Ptr<Packet> p);
-    void ReceiveData(uint8_t lqi, Ptr<Packet> p);
+    /**
+     * @brief Build the cached RIT Data Request command payload and MAC header.
+     */
+    void BuildRitDataRequestTemplate();
+
+    /**
+     * @brief Get the airtime of a frame: SHR, PHR and PSDU.
+     * @param size PSDU size [bytes]
+     * @return the airtime
+     */
+    Time GetFrameAirtime(uint32_t size) const;
+
+    /**
+     * @brief Check a transmission against the TX airtime budget (DutyCycleLimit).
+     *
+     * A transmission that does not fit is counted and traced.
+     * @param airtime Airtime of the transmission, with the replies it commits this node to
+     * @param action Trace label of the deferral
+     * @return zero if it fits, otherwise the wait until it does
+     */
+    Time CheckTxAirtime(Time airtime, const std::string& action);
+
+    /**
+     * @brief Whether the head-of-line data frame must wait for the TX airtime budget.
+     * @return true if the frame does not fit (traced as "data-defer")
+     */
+    bool IsHeadOverAirtimeBudget();
+
+    /**
+     * @brief Watch the neighbourhood of this node for the RIT Data Request about to be sent
+     *        (idleCycleElisionEnabled).
+     *
+     * Idle cycle elision: when no node in SENDER_MODE can reach this node and every
+     * receiver of the beacon is quiescent in TRX_OFF, nothing can happen during the data
+     * wait that follows the beacon. The cycle then takes two events (the period timer and
+     * the end of the beacon) instead of the data wait timer, two TRX changes and their
+     * confirms.
+     *
+     * - The RitSenderRegistry watches the PHYs that can reach this node or that it can
+     *   reach, and the receiver lists of the channel.
+     * - The beacon is deferred by the PHY (LrWpanPhy::DeferNextTx): it goes on air for this
+     *   node, its airtime and energy are accounted, but the channel does not deliver it to
+     *   the sleeping receivers.
+     * - At the end of the beacon, the data wait is skipped (ElideDataWait): the PHY goes to
+     *   TRX_OFF, its time up to the end of the data wait is accounted as RX_ON, the MAC goes
+     *   to sleep and the next cycle starts from the period timer as usual.
+     *
+     * The first wake-up of a watched PHY, a new sender or a changed receiver list
+     * (IdleCycleInterrupted) delivers what is left of the beacon to the waking PHY and puts
+     * back the data wait that the run without the elision would be in, for the time it has
+     * left. Everything that a frame exchange can see is thus as without the elision: the
+     * frames, the receptions, the drops, the interference, the energy and the counters.
+     *
+     * The elision is disabled while the MAC state, RIT mode, data wait or TRX state of this
+     * node is traced, since those traces would see the collapsed state. Within that, it
+     * stays exact except for:
+     * - the order of events at the same instant as the wake-up, and the rounding of the
+     *   interference sums of a receiver that gets the beacon late;
+     * - the getters of the MAC and PHY states (LrWpanPhy::GetTrxState and its
+     *   TrxStateValue trace, GetRitMacMode, GetRxOnWhenIdle) and a checkpoint saved during
+     *   a skipped data wait, which see the node asleep;
+     * - the event counts of LrWpanEventProfiler and RitRealtimeMonitor.
+     */
+    void StartIdleCycleWatch();
+
+    /**
+     * @brief Called by the RitSenderRegistry when a watched PHY wakes up, a sender
+     *        registers or a receiver list changes.
+     * @param phy The PHY waking up, null for a sender or a list change
+     */
+    void IdleCycleInterrupted(Ptr<SpectrumPhy> phy);
+
+    /**
+     * @brief Check whether the data wait starting now can be skipped.
+     *
+     * True when the watch saw no activity during the beacon, no trace shows the states
+     * being collapsed, and the data wait would only wait: no queued frame, no pending
+     * exchange, no contention slot or probe, and no other RIT timer due before its end.
+     * @return true if the data wait can be skipped
+     */
+    bool CanElideDataWait() const;
+
+    /**
+     * @brief Skip the data wait starting now: sleep and account the time as in RX_ON.
+     */
+    void ElideDataWait();
+
+    /**
+     * @brief Put back the data wait being skipped, for the time it has left.
+     *
+     * Called first by the entry points that depend on the state of the data wait (a data
+     * request, a PIB or configuration change, the next cycle). During the beacon, marks
+     * the cycle as not to be elided instead.
+     */
+    void ResumeElidedDataWait();
+
+    /**
+     * @brief End the watch of the cycle, or keep it while the deferred beacon is on air.
+     */
+    void EndIdleCycleWatch();
+
+    /**
+     * @brief Process an accepted command frame.
+     * @param lqi LQI of the frame
+     * @param frame The received frame (MHR, payload and MFR), left unchanged
+     * @param receivedMacHdr MAC header of the frame
+     */
+    void ReceiveCommand(uint8_t lqi,
+                        Ptr<const Packet> frame,
+                        const LrWpanMacHeader& receivedMacHdr);
+
+    /**
+     * @brief Process an accepted data frame and pass its MSDU to the upper layer.
+     * @param lqi LQI of the frame
+     * @param frame The received frame (MHR, payload and MFR), left unchanged
+     * @param receivedMacHdr MAC header of the frame
+     */
+    void ReceiveData(uint8_t lqi, Ptr<const Packet> frame, const LrWpanMacHeader& receivedMacHdr);
+
+    /**
+     * @brief Get the MAC payload of a received frame without copying its bytes.
+     * @param frame The received frame (MHR, payload and MFR)
+     * @param macHdr MAC header of the frame
+     * @return A fragment of the frame without MHR and MFR
+     */
+    Ptr<Packet> GetMacPayload(Ptr<const Packet> frame, const LrWpanMacHeader& macHdr) const;
+
+    /**
+     * @brief Go on with the next queued frame after a successful data transmission
+     *        (continuousTxEnabled).
+     *
+     * Call after the sent frame was removed from the queue.
+     * @return true if the sent frame announced more data and a frame is queued; the
+     *         caller then sends it after the IFS instead of ending the sender cycle
+     */
+    bool ContinueBurst();
 
     void StartRitDataWaitPeriod();
     void StartRitTxWaitPeriod();
@@ -321,6 +974,221 @@ class RitWpanMac : public LrWpanMac
     void SetSleep();  //!< Set MAC into sleep state
 
     bool CheckTxAndStartSender();
+
+    /**
+     * @brief Record the time of a beacon and refine the period estimate of its sender
+     *        (phaseLearningEnabled, beaconDeconflictionEnabled).
+     * @param src Short address of the beacon sender
+     */
+    void LearnBeaconPhase(Mac16Address src);
+
+    /**
+     * @brief Predict the next listen window for the beacon of the last receiver
+     *        (phaseLearningEnabled).
+     *
+     * See PredictBeacon(). The half-width of the window is the PhaseLockGuard attribute
+     * plus PhaseLockDriftPpm of the time since the beacon was last heard.
+     * @param [out] wakeDelay Delay from now to the opening of the window
+     * @param [out] window Length of the window
+     * @return false if there is no usable estimate; the sender then listens for TWD
+     */
+    bool PredictTargetBeacon(Time& wakeDelay, Time& window) const;
+
+    /**
+     * @brief Predict the next listen window for the beacon a neighbour appointed in its
+     *        last ACK (ackAppointmentsEnabled).
+     *
+     * The window opens before the appointed beacon by the drift both clocks may have
+     * accumulated since the grant (ClockDriftApplier::GetDriftBound()) and is
+     * AppointmentGuard longer than twice that drift.
+     * @param neighbour Short address of the receiver
+     * @param [out] wakeDelay Delay from now to the opening of the window
+     * @param [out] window Length of the window
+     * @return false without an appointment, or once the window would span half a period
+     */
+    bool PredictAppointment(Mac16Address neighbour, Time& wakeDelay, Time& window) const;
+
+    /**
+     * @brief Send the ACK of a data frame with a payload (ackAppointmentsEnabled,
+     *        headerIesEnabled).
+     *
+     * As LrWpanMac::SendAck(), with a RitAppointmentHeader naming the next periodic beacon
+     * as the payload, or, with headerIesEnabled, the IEs of SetAckIes() followed by an
+     * appointment IE. Without either the ACK is the plain one.
+     * @param seqno Sequence number of the data frame
+     */
+    void SendRitAck(uint8_t seqno);
+
+    /**
+     * @brief Read the payload of the ACK of a data frame sent: the appointment and, with
+     *        headerIesEnabled, the IEs for the MLME callback.
+     * @param payload MAC payload of the ACK
+     * @param peer Receiver of the data frame
+     */
+    void ReceiveAckPayload(Ptr<const Packet> payload, Mac16Address peer);
+
+    /**
+     * @brief Delay from now to the end of an ACK sent one turnaround later.
+     * @param ackSize Size of the ACK, MHR and MFR included
+     * @return the delay
+     */
+    Time GetAckEndDelay(uint32_t ackSize) const;
+
+    /**
+     * @brief Open the sender listen window planned by CheckTxAndStartSender().
+     */
+    void PhaseLockedWakeup();
+
+    /**
+     * @brief Enter SENDER_MODE and open the beacon wait, after retuning to the receive
+     *        channel of the head-of-line destination (RxChannel).
+     */
+    void StartSenderCycle();
+
+    /**
+     * @brief Get the channel the head-of-line frame is sent on.
+     * @return the receive channel of its destination if known, RxChannel otherwise
+     */
+    uint8_t GetSenderChannel() const;
+
+    /**
+     * @brief Retune the PHY, keeping the receiver on or off as the MAC wants it.
+     * @param channel The channel (0: no change)
+     * @return true if the PHY changed channel
+     */
+    bool TuneChannel(uint8_t channel);
+
+    /**
+     * @brief Strip the receive channel advertised at the end of a beacon payload and
+     *        record it (RxChannel).
+     * @param p Command payload, RIT Data Request header removed
+     * @param src Short address of the beacon sender
+     */
+    void LearnRxChannel(Ptr<Packet> p, Mac16Address src);
+
+    /**
+     * @brief Whether the head-of-line frame is addressed to the broadcast short address.
+     * @return true for a broadcast frame held for BroadcastHoldTime
+     */
+    bool IsBroadcastHead() const;
+
+    /**
+     * @brief Hold of a broadcast frame.
+     * @return BroadcastHoldTime, or the TWD if zero
+     */
+    Time GetBroadcastHoldTime() const;
+
+    /**
+     * @brief End of the hold of the head-of-line broadcast frame: confirm and remove it.
+     */
+    void EndBroadcastHold();
+
+    /**
+     * @brief Whether a sender cycle is running (SENDER_MODE or STROBE_MODE).
+     * @return true in a sender cycle
+     */
+    bool IsSenderMode() const;
+
+    /**
+     * @brief Start a frame train instead of a beacon wait if the TX queue is deep
+     *        (HybridQueueThreshold) and a receiver is known.
+     * @return true if the train started
+     */
+    bool StartStrobeTrain();
+
+    /**
+     * @brief Send the next copy of the head-of-line frame of the train, without CSMA.
+     */
+    void SendStrobe();
+
+    /**
+     * @brief Longest frame train.
+     * @return StrobeTrainTime, or one RIT period and DWD if zero
+     */
+    Time GetStrobeTrainTime() const;
+
+    /**
+     * @brief Response slot of this sender after the last beacon (contentionSlotsEnabled).
+     *
+     * Hashed from the short address of the sender and the DSN of the beacon, so that two
+     * senders sharing a slot after one beacon are likely apart after the next one.
+     * @return slot index in [0, ContentionSlots)
+     */
+    uint32_t GetContentionSlot() const;
+
+    /**
+     * @brief Delay of the next beacon moving it into the largest gap between the neighbour
+     *        beacons (beaconDeconflictionEnabled).
+     *
+     * The beacon moves only when a neighbour beacon is predicted closer than
+     * BeaconDeconflictGap and that neighbour has a smaller short address, so that one
+     * node of each conflicting pair keeps its phase.
+     * @param period Period of the beacon being scheduled
+     * @return delay added to the period, zero to keep the phase
+     */
+    Time DeconflictBeaconPhase(Time period);
+
+    /**
+     * @brief Send the Beacon ACK or the data frame answering the last beacon.
+     */
+    void SendRitResponse();
+
+    /**
+     * @brief Keep the receiver awake until the end of the response slots
+     *        (contentionSlotsEnabled).
+     * @return true if the data wait was re-armed, false if the receiver cycle can end
+     */
+    bool ContinueContentionSlots();
+
+    /**
+     * @brief End of an adaptation window: let the policy set the next RIT period.
+     */
+    void AdaptRitPeriod();
+
+    /**
+     * @brief Level 3 filtering of a received frame (IEEE 802.15.4-2006 7.5.6.2).
+     * @param macHdr MAC header of the frame
+     * @return true if the frame is to be processed by this node
+     */
+    bool IsFrameAccepted(const LrWpanMacHeader& macHdr) const;
+
+    /**
+     * @brief Register the PHY MAC header indication according to the module config.
+     */
+    void ConfigureHeaderIndication();
+
+    /**
+     * @brief Select the carrier-sense stage of beacons and data frames from the module flags.
+     */
+    void ApplyCarrierSenseConfig();
+
+    /**
+     * @brief Turn the receiver off for the rest of a frame rejected after its header.
+     * @param remaining Remaining duration of the frame
+     */
+    void SleepUntilFrameEnd(Time remaining);
+
+    /**
+     * @brief Use a frame addressed to another node to end or defer the current cycle
+     *        (overhearingAvoidanceEnabled).
+     *
+     * In RECEIVER_MODE, a data frame sent to the neighbour whose beacon was heard during
+     * the data wait, or a beacon ACK answering it, ends the receiver cycle. In SENDER_MODE,
+     * a data frame sent to the receiver of the queue head defers the beacon wait to the
+     * next beacon of that receiver.
+     * @param macHdr MAC header of the frame
+     */
+    void OverhearForeignFrame(LrWpanMacHeader macHdr);
+
+    /**
+     * @brief Turn the receiver back on after SleepUntilFrameEnd() if still waiting for data.
+     */
+    void ResumeRx();
+
+    /**
+     * @brief Measure the energy on the channel early in the data wait (dataWaitProbeEnabled).
+     */
+    void ProbeDataWait();
     bool IsRitModeEnabled() const;
     Time DurationToTime(uint64_t duration) const;
 
@@ -331,11 +1199,117 @@ class RitWpanMac : public LrWpanMac
      */
     Time GetContinuousTxTimeoutTime() const;
 
+    /**
+     * @brief Get the latency record of the head-of-line frame.
+     * @return the record, or nullptr if hop latency is disabled or the queue is empty
+     */
+    RitHopLatencyRecord* GetHeadHopLatency();
+
+    /**
+     * @brief Stamp the MAC queue head time of the head-of-line frame (first time only).
+     */
+    void StampQueueHead();
+
+    /**
+     * @brief Report the latency record of the head-of-line frame after a successful TX.
+     * @param acked Whether the frame was acknowledged (stamps ackRx)
+     */
+    void FinishHopLatency(bool acked);
+
+    /**
+     * @brief Drop the latency records of frames no longer in the TX queue.
+     */
+    void PruneHopLatency();
+
+    /**
+     * @brief Queue a frame according to TxQueueCapacity, TxQueueDropPolicy and
+     * TxQueuePriorityEnabled.
+     * @param txQElement The frame
+     */
+    void EnqueueTxQElement(Ptr<TxQueueElement> txQElement) override;
+
+    /**
+     * @brief Remove the head frame and report its sojourn time.
+     */
+    void RemoveFirstTxQElement() override;
+
+    /**
+     * @brief Index of the first queued frame that can be reordered or dropped.
+     *
+     * The head frame is pinned once a transmission or a sender cycle uses it.
+     */
+    size_t GetFirstMovableTxQIndex() const;
+
+    /**
+     * @param index Index in m_txQueue
+     * @return the queue class of the frame
+     */
+    RitTxQueueClass GetTxQueueClass(size_t index) const;
+
+    /**
+     * @brief Choose the frame to drop when a frame arrives at a full queue.
+     * @param txClass Class of the arriving frame
+     * @return the index of the queued victim, or m_txQueue.size() for the arriving frame
+     */
+    size_t SelectTxQueueVictim(const RitTxQueueClass& txClass) const;
+
+    /**
+     * @brief Drop a queued frame and confirm it with TRANSACTION_OVERFLOW.
+     * @param index Index in m_txQueue, not the pinned head frame
+     */
+    void DropTxQElement(size_t index);
+
+    /**
+     * @brief Address the head-of-line data frame to the receiver of the current beacon.
+     *
+     * The queued frame is never rewritten: a new frame is built from the header and the
+     * shared MSDU of its queue entry only when the destination, the CONTINUOUS flag or the
+     * frame pending bit (frame train burst) changes, so a retry to the same receiver sends
+     * the queued frame as is.
+     * @param txQElement The head of m_txQueue
+     */
+    void AddressTxQElement(Ptr<TxQueueElement> txQElement);
+
+    /**
+     * @brief Give the head-of-line data frame the next frame counter (frame security).
+     *
+     * Beacons and data frames share the counter, so a frame sent after later beacons
+     * must not keep the counter it was queued with.
+     * @param txQElement The head of m_txQueue
+     */
+    void SecureTxQElement(Ptr<TxQueueElement> txQElement);
+
+    /**
+     * @brief Set the security level of the frames (SecurityLevel attribute).
+     * @param secLevel Security level, 0 for unsecured frames
+     */
+    void SetSecurityLevel(uint8_t secLevel);
+
+    /**
+     * @brief Get the security level of the frames.
+     * @return the level
+     */
+    uint8_t GetSecurityLevel() const;
+
+    /**
+     * @brief Set the key identifier mode of the frames (SecurityKeyIdMode attribute).
+     * @param keyIdMode Key identifier mode
+     */
+    void SetSecurityKeyIdMode(uint8_t keyIdMode);
+
+    /**
+     * @brief Get the key identifier mode of the frames.
+     * @return the mode
+     */
+    uint8_t GetSecurityKeyIdMode() const;
+
     /* Member variables */
 
     // Behavior flags
     bool m_rxAlwaysOn;            //!< Receiver always-on flag (e.g., for a parent device)
-    bool m_continuousRxEnabled;   //!< Continuous reception enable flag
+    bool m_continuousRxEnabled;   //!< The last data frame announced more data
+    bool m_burstMoreData;         //!< The data frame being sent announces more data
+    bool m_framePendingRx;        //!< The last data frame acknowledged had frame pending
 
     bool m_useTimeBasedRitParams = true; //!< Use time-based RIT parameters
     bool m_ritSending = false;           //!< Whether RIT data is currently being sent
@@ -345,46 +1319,221 @@ class RitWpanMac : public LrWpanMac
     TracedValue<uint8_t> m_macRitDataWaitDuration; //!< RX wait after RIT (0x00 ~ 0xFF)
     TracedValue<uint32_t> m_macRitTxWaitDuration; //!< Beacon wait (>= macRitPeriod, up to 0xFFFFFF)
     std::vector<uint8_t> m_macRitRequestPayload; //!< Payload for RIT command transmission
+    Ptr<Packet> m_ritDataRequestTemplate; //!< Cached RIT Data Request without MHR and FCS
+    LrWpanMacHeader m_ritDataRequestHdr;  //!< Cached RIT Data Request MHR (DSN set per beacon)
+    uint64_t m_nElidedCycles;             //!< Idle cycles whose data wait was skipped
+    Mac16Address m_overheardBeaconSrc;    //!< Source of the beacon heard during the data wait
+    bool m_overheardBeaconValid;          //!< Whether m_overheardBeaconSrc is set
+    uint64_t m_nOverheardRxShortcuts;     //!< Data waits ended on a foreign rendezvous
+    uint64_t m_nOverheardTxDeferrals;     //!< Beacon waits deferred on a busy receiver
 
     // Time-based RIT parameters
-    TracedValue<Time> m_macRitPeriodTime;           //!< RIT period time
-    TracedValue<Time> m_macRitDataWaitDurationTime; //!< RIT data wait duration time
-    TracedValue<Time> m_macRitTxWaitDurationTime;   //!< RIT transmission wait duration time
+    LazyTracedValue<Time> m_macRitPeriodTime;           //!< RIT period time
+    LazyTracedValue<Time> m_macRitDataWaitDurationTime; //!< RIT data wait duration time
+    LazyTracedValue<Time> m_macRitTxWaitDurationTime;   //!< RIT transmission wait duration time
+
+    // Load-adaptive RIT period
+    Ptr<RitPeriodPolicy> m_periodPolicy; //!< Adapts the period, null for a fixed one
+    Time m_nominalRitPeriodTime;         //!< Period set through MLME-SET
+    Time m_ritPeriodMin;                 //!< Lower bound, zero for nominal / 4
+    Time m_ritPeriodMax;                 //!< Upper bound, zero for nominal * 4
+    Time m_periodAdaptationWindow;       //!< Length of an adaptation window
+    RitPeriodLoad m_periodLoad;          //!< Load of the current window
+    bool m_beaconAnswered;               //!< A data frame followed the last beacon
 
     // RIT mode
-    TracedValue<RitMacMode> m_ritMacMode; //!< Current RIT MAC mode
+    LazyTracedValue<RitMacMode> m_ritMacMode; //!< Current RIT MAC mode
 
     // RIT events
-    EventId m_ritDataWaitTimeout;          //!< Data wait timeout event
-    EventId m_ritTxWaitTimeout;            //!< TX wait timeout event
-    EventId m_periodicRitDataRequestEvent; //!< Periodic data request event
+    /**
+     * Logical timers of m_ritTimers.
+     */
+    enum RitTimerId : uint32_t
+    {
+        RIT_DATA_WAIT_TIMER,        //!< Data wait timeout (ReceiverCycleTimeout)
+        RIT_TX_WAIT_TIMER,          //!< TX wait timeout (SenderCycleTimeout)
+        RIT_PERIODIC_REQUEST_TIMER, //!< Periodic data request (PeriodicRitDataRequest)
+        RIT_RX_RESUME_TIMER,        //!< Receiver back on after a rejected frame (ResumeRx)
+        RIT_PHASE_WAKE_TIMER,       //!< Sender wake-up before a beacon (PhaseLockedWakeup)
+        RIT_PERIOD_ADAPT_TIMER,     //!< End of an adaptation window (AdaptRitPeriod)
+        RIT_CONTENTION_SLOT_TIMER,  //!< Start of the response slot (SendRitResponse)
+        RIT_BOOTSTRAP_TIMER,        //!< End of a bootstrap listen period (BootstrapTimeout)
+        RIT_CHANNEL_SWITCH_TIMER,   //!< Sender retuned (StartRitTxWaitPeriod)
+        RIT_STROBE_TIMER,           //!< Frame train sender retuned (SendStrobe)
+        RIT_ENCRYPT_TIMER,          //!< Data frame encrypted (TransmitRitData)
+        RIT_DATA_WAIT_PROBE_TIMER,  //!< Energy probe of the data wait (ProbeDataWait)
+        RIT_TIMER_COUNT             //!< Number of timers
+    };
+
+    RitMacTimerSet m_ritTimers;  //!< RIT timers, one scheduler event for all of them
+    EventId m_earlyRxAbortEvent; //!< Receiver off after a rejected header
 
     MlmeRitRequestIndicationCallback m_mlmeRitRequestIndicationCallback; //!< MLME-RIT-REQ.indication
+    MlmeBootstrapConfirmCallback m_mlmeBootstrapConfirmCallback; //!< End of a bootstrap listen
+    MlmeRitTxWaitTimeoutCallback m_mlmeRitTxWaitTimeoutCallback; //!< Sender cycle without beacon
+    MlmeAckIeIndicationCallback m_mlmeAckIeIndicationCallback;   //!< Header IEs of an ACK
 
     Mac16Address m_lastRxRitReqFrameSrcAddr; //!< Source address of last received RIT request frame
 
+    /**
+     * Learned beacon timing of a neighbour (phaseLearningEnabled).
+     */
+    struct RitBeaconPhase
+    {
+        Time lastBeacon; //!< Reception time of the last beacon heard
+        Time period;     //!< Estimated beacon period, relative drift included
+    };
+
+    std::pmr::map<Mac16Address, RitBeaconPhase> m_beaconPhases; //!< Learned phases per neighbour
+    Mac16Address m_phaseTarget; //!< Receiver of the last data frame sent
+    bool m_phaseTargetValid;    //!< Whether m_phaseTarget is set
+    Time m_phaseLockTxWait;     //!< Planned listen window, zero for a full TWD
+    Time m_phaseLockGuard;      //!< Fixed half-width of the listen window
+    double m_phaseLockDriftPpm; //!< Growth of the half-width with the prediction horizon
+
+    /**
+     * Beacon appointment granted by a receiver (ackAppointmentsEnabled).
+     */
+    struct RitAppointment
+    {
+        Time beacon;  //!< Appointed beacon
+        Time period;  //!< Beacon period of the receiver
+        Time granted; //!< Reception time of the ACK
+    };
+
+    std::pmr::map<Mac16Address, RitAppointment> m_appointments; //!< Appointments per receiver
+    Time m_appointmentGuard;                                    //!< Listen window without drift
+    uint64_t m_nAppointmentsGranted;                            //!< Appointments sent in ACKs
+    uint64_t m_nAppointmentsReceived;                           //!< Appointments stored
+
+    RitIeList m_ritRequestIes; //!< Header IEs of the RIT Data Requests (headerIesEnabled)
+    RitIeList m_ackIes;        //!< Header IEs of the data ACKs (headerIesEnabled)
+
+    RitDuplicateCache m_rxDuplicates; //!< Data frames received, by source and DSN
+    uint32_t m_duplicateCacheSize;    //!< Entries of m_rxDuplicates
+    Time m_duplicateLifetime;         //!< Time a source and DSN stay in m_rxDuplicates
+    uint64_t m_nRxDuplicates;         //!< Data frames received again, not indicated
+    LazyTracedCallback<Ptr<const Packet>> m_macRxDuplicateTrace; //!< Data frame received again
+
+    uint32_t m_contentionSlots;    //!< Response slots after a beacon
+    Time m_contentionSlotDuration; //!< Length of a response slot
+    uint8_t m_lastRxRitReqSeqNum;  //!< DSN of the last beacon answered
+    Time m_contentionSlotsEnd;     //!< End of the data wait covering every slot
+
+    Time m_dataWaitProbeGuard;          //!< Slack of the probe after the latest response start
+    bool m_dataWaitProbePending;        //!< The PHY measures the energy for the probe
+    bool m_dataWaitActivity;            //!< A frame was heard since the data wait started
+    uint64_t m_nDataWaitProbeShortcuts; //!< Data waits ended on an idle probe
+
+    Time m_beaconDeconflictGap;    //!< Smallest separation from a neighbour beacon
+    uint64_t m_nBeaconPhaseShifts; //!< Beacon phase shifts taken
+
+    uint8_t m_rxChannel;                                 //!< Own receive channel, 0 if unset
+    uint8_t m_redirectChannel;                           //!< Advertised once instead, 0 if none
+    uint64_t m_nBeaconRedirects;                         //!< Beacons sent with a redirect
+    Time m_channelSwitchTime;                            //!< Settling time of a retune
+    std::map<Mac16Address, uint8_t> m_neighbourChannels; //!< Receive channels of neighbours
+    uint8_t m_planFirstChannel;                          //!< First channel of the plan
+    uint8_t m_planChannels;                              //!< Channels of the plan, 0 if none
+    uint64_t m_nChannelSwitches;                         //!< PHY channel changes
+
+    Time m_broadcastHoldTime;                 //!< Hold of a broadcast frame, zero for the TWD
+    Time m_broadcastHoldEnd;                  //!< End of the current hold, zero if none
+    std::set<Mac16Address> m_broadcastServed; //!< Beacon sources answered in the hold
+    uint64_t m_nBroadcastTx;                  //!< Broadcast frames sent
+
+    uint32_t m_hybridQueueThreshold; //!< Queue length starting a frame train, 0 if never
+    Time m_strobeTrainTime;          //!< Longest frame train, zero for period and DWD
+    Time m_strobeEnd;                //!< End of the current frame train
+    Mac16Address m_hybridPeer;       //!< Last receiver that acknowledged a frame
+    bool m_hybridPeerValid;          //!< m_hybridPeer is set
+    uint64_t m_nStrobeFrames;        //!< Data frames sent in frame trains
+
+    double m_dutyCycleLimit;              //!< Largest TX fraction of the window, 0 for none
+    Time m_dutyCycleWindow;               //!< Window of the duty-cycle limit
+    RitDutyCyclePolicy m_dutyCyclePolicy; //!< Handling of a beacon over the budget
+    RitAirtimeBudget m_airtimeBudget;     //!< TX airtime of the window
+    Time m_txAirtime;                     //!< TX airtime since the start
+    uint64_t m_nDutyCycleDeferrals;       //!< Transmissions put off by the budget
+
+    LazyTracedCallback<std::string, Time> m_dutyCycleTrace; //!< Transmission put off, wait
+
+    RitFrameSecurity m_frameSecurity; //!< Frame security cost model
+    bool m_secureRitDataRequest;      //!< RIT Data Requests secured as well
+    bool m_ritDataRequestSecured;     //!< The cached RIT Data Request carries a MIC
+    Time m_securityEncryptDelay;      //!< Encryption of a data frame answering a beacon
+    Time m_securityDecryptDelay;      //!< Decryption of a secured data frame received
+    EventId m_decryptEvent;           //!< Decryption of the head of m_decryptQueue done
+
+    /// Secured data frames received and being decrypted, with their indication
+    std::deque<std::pair<McpsDataIndicationParams, Ptr<Packet>>> m_decryptQueue;
+
     Ptr<TimeDriftApplier> m_timeDriftApplier;   //!< Used for beacon interval randomization
     Ptr<ClockDriftApplier> m_clockDriftApplier; //!< Used for clock drift correction
+    Time m_clockDriftKnotInterval;              //!< Knots of the closed-form drift, 0 if unused
+    Ptr<UniformRandomVariable> m_initialPhase;  //!< Initial phase of the RIT cycle
 
-    Ptr<RitWpanPreCs> m_preCs;     //!< Pre-CS implementation
-    Ptr<RitWpanPreCsB> m_preCsB;   //!< Pre-CSB implementation
+    Ptr<RitCarrierSensePipeline> m_carrierSense; //!< Carrier-sense stages
+    Ptr<RitSenderRegistry> m_senderRegistry;     //!< Senders of the channel, for the elision
+
+    /**
+     * Steps of the idle cycle elision.
+     */
+    enum IdleCyclePhase : uint8_t
+    {
+        IDLE_CYCLE_NONE,      //!< Not watched
+        IDLE_CYCLE_BEACON,    //!< Watched, the deferred beacon is being sent
+        IDLE_CYCLE_DATA_WAIT, //!< The data wait is being skipped
+        IDLE_CYCLE_TAIL,      //!< Cycle over, the deferred beacon is still on air
+    };
+
+    IdleCyclePhase m_idleCyclePhase; //!< Step of the idle cycle elision
+    bool m_idleCycleInterrupted;     //!< Activity seen during the deferred beacon
+    Time m_elidedDataWaitEnd;        //!< End of the data wait being skipped
 
     RitWpanMacModuleConfig m_moduleConfig;
 
     // Trace: MAC timeout events
-    TracedCallback<Time, std::string> m_macTimeoutEventTrace;
-
-    // Trace values for timeout durations
-    TracedValue<Time> m_beaconWaitTimeoutTime;
-    TracedValue<Time> m_dataWaitTimeoutTime;
+    LazyTracedCallback<Time, std::string> m_macTimeoutEventTrace;
 
     // Measurement: start times for waiting
     Time m_beaconWaitStartTime;
     Time m_dataWaitStartTime;
 
     // Trace: measured waiting durations
-    TracedCallback<std::string, Time> m_beaconWaitTrace;
-    TracedCallback<std::string, Time> m_dataWaitTrace;
+    LazyTracedCallback<std::string, Time> m_beaconWaitTrace;
+    LazyTracedCallback<std::string, Time> m_dataWaitTrace;
+
+    // Per-hop latency breakdown (keyed by MSDU handle)
+    bool m_hopLatencyEnabled;                                 //!< Stamp and tag data frames
+    std::pmr::map<uint8_t, RitHopLatencyRecord> m_hopLatency; //!< Records of queued frames
+    LazyTracedCallback<const RitHopLatencyRecord&> m_hopLatencyTrace; //!< Completed hop records
+    LazyTracedCallback<Ptr<const Packet>, Mac16Address> m_broadcastTxTrace; //!< Beacon answered
+
+    /**
+     * Queue bookkeeping of a frame in m_txQueue.
+     */
+    struct RitTxQueueEntry
+    {
+        RitTxQueueClass txClass; //!< Priority class and origin
+        Time enqueueTime;        //!< Time the frame entered the queue
+        // Parts of a data frame, txQPkt being their last materialized PSDU
+        LrWpanMacHeader macHdr;  //!< MAC header of the frame
+        RitSubHeader subHdr;     //!< RIT sub-header, if hasSubHdr
+        bool hasSubHdr = false;  //!< Whether the frame carries a RIT sub-header
+        Ptr<const Packet> msdu;  //!< MSDU, shared by every PSDU of the frame (null if unset)
+    };
+
+    // TX queue discipline
+    uint32_t m_txQueueCapacity;                 //!< Frames the queue holds, 0 for unbounded
+    RitTxQueueDropPolicy m_txQueueDropPolicy;   //!< Victim of a full queue
+    bool m_txQueuePriorityEnabled;              //!< Serve frames by priority class
+    std::pmr::map<uint8_t, RitTxQueueClass> m_pendingTxClass; //!< Classes of upcoming requests
+    std::pmr::unordered_map<const TxQueueElement*, RitTxQueueEntry> m_txQueueEntries; //!< Queued
+    LazyTracedValue<uint32_t> m_txQueueOccupancy;                      //!< Frames in the queue
+    LazyTracedCallback<Ptr<const Packet>, Time> m_txQueueEnqueueTrace; //!< Frame queued
+    LazyTracedCallback<Ptr<const Packet>, Time> m_txQueueDequeueTrace; //!< Frame done, sojourn
+    LazyTracedCallback<Ptr<const Packet>, Time> m_txQueueDropTrace;    //!< Frame dropped, sojourn
 };
 
 } // namespace lrwpan
@@ -13,6 +13,8 @@
 #include "ns3/lr-wpan-error-model.h"
 #include "ns3/node.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 namespace lrwpan
@@ -48,7 +50,22 @@ RitWpanNetDevice::GetTypeId()
                           "The NWK layer attached to this device.",
                           PointerValue(),
                           MakePointerAccessor(&RitWpanNetDevice::GetNwk, &RitWpanNetDevice::SetNwk),
-                          MakePointerChecker<RitSimpleRouting>());
+                          MakePointerChecker<RitSimpleRouting>())
+            .AddAttribute("EnergyModel",
+                          "The radio energy model attached to this device.",
+                          PointerValue(),
+                          MakePointerAccessor(&RitWpanNetDevice::GetEnergyModel,
+                                              &RitWpanNetDevice::SetEnergyModel),
+                          MakePointerChecker<RitWpanEnergyModel>())
+            .AddTraceSource("EnergyDepletion",
+                            "Energy consumed by the radio so far [J], reported every "
+                            "RitWpanEnergyModel::UpdateInterval",
+                            MakeTraceSourceAccessor(&RitWpanNetDevice::m_energyDepletionTrace),
+                            "ns3::TracedValueCallback::Double")
+            .AddTraceSource("EnergyExhausted",
+                            "The battery of the device has been depleted",
+                            MakeTraceSourceAccessor(&RitWpanNetDevice::m_energyExhaustedTrace),
+                            "ns3::TracedValueCallback::Void");
     return tid;
 }
 
@@ -66,8 +83,12 @@ RitWpanNetDevice::RitWpanNetDevice()
     m_nwk = CreateObject<RitSimpleRouting>();
 
     m_csmaca = CreateObject<LrWpanCsmaCa>();
+    m_csmacaStage = CreateObject<RitCsmaCaCarrierSense>();
     m_precs = CreateObject<RitWpanPreCs>();
-    m_precsb = CreateObject<RitWpanPreCsB>();
+    m_carrierSense = CreateObject<RitCarrierSensePipeline>();
+    m_carrierSense->AddStage(RitCarrierSensePipeline::PRE_CS_STAGE, m_precs);
+    m_carrierSense->AddStage(RitCarrierSensePipeline::CSMA_CA_STAGE, m_csmacaStage);
+    m_energyModel = CreateObject<RitWpanEnergyModel>();
 
     m_channel = nullptr;
     m_node = nullptr;
@@ -87,15 +108,20 @@ RitWpanNetDevice::DoDispose()
     m_mac->Dispose();
     m_nwk->Dispose();
     m_csmaca->Dispose();
+    m_carrierSense->Dispose();
+    m_csmacaStage->Dispose();
     m_precs->Dispose();
-    m_precsb->Dispose();
+    m_energyModel->Dispose();
 
     m_phy = nullptr;
     m_mac = nullptr;
     m_nwk = nullptr;
     m_csmaca = nullptr;
+    m_csmacaStage = nullptr;
     m_precs = nullptr;
-    m_precsb = nullptr;
+    m_carrierSense = nullptr;
+    m_energyModel = nullptr;
+    m_errorModel = nullptr;
 
     m_channel = nullptr;
     m_node = nullptr;
@@ -112,6 +138,14 @@ RitWpanNetDevice::DoInitialize()
     m_mac->Initialize();
 
     CompleteConfig();
+    m_nwk->SetEnergyModel(m_energyModel);
+    m_nwk->Initialize();
+
+    m_energyModel->SetPhy(m_phy);
+    m_energyModel->SetEnergyUpdateCallback(MakeCallback(&RitWpanNetDevice::OnEnergyUpdate, this));
+    m_energyModel->SetEnergyDepletedCallback(
+        MakeCallback(&RitWpanNetDevice::OnEnergyDepleted, this));
+    m_energyModel->Start();
 
     NetDevice::DoInitialize();
 }
@@ -126,7 +160,7 @@ RitWpanNetDevice::CompleteConfig()
     {
         return;
     }
-    if (!m_node || !m_phy || !m_mac || !m_nwk || !m_csmaca || !m_precs || !m_precsb)
+    if (!m_node || !m_phy || !m_mac || !m_nwk || !m_csmaca)
     {
         return;
     }
@@ -136,16 +170,17 @@ RitWpanNetDevice::CompleteConfig()
 
     m_mac->SetPhy(m_phy);
     m_mac->SetCsmaCa(m_csmaca);
-    m_mac->SetPreCs(m_precs);
-    m_mac->SetPreCsB(m_precsb);
-
     m_csmaca->SetMac(m_mac);
-    m_precs->SetMac(m_mac);
-    m_precsb->SetMac(m_mac);
+    m_csmacaStage->SetCsmaCa(m_csmaca);
+    m_carrierSense->SetMac(m_mac);
+    m_mac->SetCarrierSense(m_carrierSense);
 
     // PHY error model + device back-pointer.
-    Ptr<LrWpanErrorModel> model = CreateObject<LrWpanErrorModel>();
-    m_phy->SetErrorModel(model);
+    if (!m_errorModel)
+    {
+        m_errorModel = LrWpanErrorModel::GetShared();
+    }
+    m_phy->SetErrorModel(m_errorModel);
     m_phy->SetDevice(this);
 
     // Rank propagation (NetDevice -> NWK).
@@ -158,6 +193,10 @@ RitWpanNetDevice::CompleteConfig()
     // MAC callbacks to NWK.
     m_mac->SetMlmeRitRequestIndicationCallback(
         MakeCallback(&RitSimpleRouting::MlmeRitRequestIndication, m_nwk));
+    m_mac->SetMlmeBootstrapConfirmCallback(
+        MakeCallback(&RitSimpleRouting::MlmeBootstrapConfirm, m_nwk));
+    m_mac->SetMlmeRitTxWaitTimeoutCallback(
+        MakeCallback(&RitSimpleRouting::MlmeRitTxWaitTimeout, m_nwk));
     m_mac->SetMcpsDataIndicationCallback(
         MakeCallback(&RitSimpleRouting::McpsDataIndication, m_nwk));
     m_mac->SetMcpsDataConfirmCallback(MakeCallback(&RitSimpleRouting::McpsDataConfirm, m_nwk));
@@ -171,28 +210,17 @@ RitWpanNetDevice::CompleteConfig()
         MakeCallback(&RitWpanMac::PlmeSetTRXStateConfirm, m_mac));
     m_phy->SetPlmeSetAttributeConfirmCallback(
         MakeCallback(&RitWpanMac::PlmeSetAttributeConfirm, m_mac));
+    m_phy->SetPlmeEdConfirmCallback(MakeCallback(&RitWpanMac::PlmeEdConfirm, m_mac));
 
-    // Carrier sense chain (PreCsB -> PreCs -> CSMA/CA).
-    m_phy->SetPlmeCcaConfirmCallback(MakeCallback(&RitWpanPreCsB::PlmeCcaConfirm, m_precsb));
-    m_precsb->SetFallbackCcaConfirmCallback(MakeCallback(&RitWpanPreCs::PlmeCcaConfirm, m_precs));
-    m_precs->SetFallbackCcaConfirmCallback(MakeCallback(&LrWpanCsmaCa::PlmeCcaConfirm, m_csmaca));
-
-    // State callbacks back to MAC.
-    m_csmaca->SetLrWpanMacStateCallback(MakeCallback(&RitWpanMac::SetLrWpanMacState, m_mac));
-    m_precs->SetLrWpanMacStateCallback(MakeCallback(&RitWpanMac::SetLrWpanMacState, m_mac));
-    m_precsb->SetLrWpanMacStateCallback(MakeCallback(&RitWpanMac::SetLrWpanMacState, m_mac));
+    // Carrier sense: the pipeline hands each CCA confirm to the stage that requested it,
+    // the others to the CSMA/CA of the plain LrWpanMac. The stages report to the MAC.
+    m_phy->SetPlmeCcaConfirmCallback(
+        MakeCallback(&RitCarrierSensePipeline::PlmeCcaConfirm, m_carrierSense));
+    m_carrierSense->SetFallbackCcaConfirmCallback(
+        MakeCallback(&LrWpanCsmaCa::PlmeCcaConfirm, m_csmaca));
 
     // --- Apply RIT PIB parameters (stored in this NetDevice) ---
-    Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
-
-    pibAttr->macRitDataWaitDurationTime = m_macRitDataWaitDuration;
-    m_mac->MlmeSetRequest(macRitDataWaitDurationTime, pibAttr);
-
-    pibAttr->macRitTxWaitDurationTime = m_macRitTxWaitDuration;
-    m_mac->MlmeSetRequest(macRitTxWaitDurationTime, pibAttr);
-
-    pibAttr->macRitPeriodTime = m_macRitPeriod;
-    m_mac->MlmeSetRequest(macRitPeriodTime, pibAttr);
+    m_mac->SetRitTimes(m_macRitPeriod, m_macRitDataWaitDuration, m_macRitTxWaitDuration);
 
     // Module config (CSMA / Pre-CS / Pre-CSB / ACK / Randomization / etc.)
     m_mac->SetModuleConfig(m_moduleConfig);
@@ -232,6 +260,14 @@ RitWpanNetDevice::SetCsmaCa(Ptr<LrWpanCsmaCa> csmaca)
     CompleteConfig();
 }
 
+void
+RitWpanNetDevice::SetEnergyModel(Ptr<RitWpanEnergyModel> energyModel)
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(IsInitialized(), "Energy model cannot be set after initialization");
+    m_energyModel = energyModel;
+}
+
 void
 RitWpanNetDevice::SetChannel(Ptr<SpectrumChannel> channel)
 {
@@ -241,6 +277,17 @@ RitWpanNetDevice::SetChannel(Ptr<SpectrumChannel> channel)
     channel->AddRx(m_phy);
 }
 
+void
+RitWpanNetDevice::SetErrorModel(Ptr<LrWpanErrorModel> errorModel)
+{
+    NS_LOG_FUNCTION(this << errorModel);
+    m_errorModel = errorModel;
+    if (m_configComplete)
+    {
+        m_phy->SetErrorModel(errorModel);
+    }
+}
+
 void
 RitWpanNetDevice::SetRitRank(uint8_t rank)
 {
@@ -261,6 +308,11 @@ RitWpanNetDevice::SetRitRank(uint8_t rank)
 uint8_t
 RitWpanNetDevice::GetRitRank() const
 {
+    // The NWK rank may have been discovered by RitSimpleRouting::Bootstrap().
+    if (m_nwk)
+    {
+        return static_cast<uint8_t>(std::min<uint16_t>(m_nwk->GetRank(), 0xFF));
+    }
     return m_rank;
 }
 
@@ -345,6 +397,18 @@ RitWpanNetDevice::GetCsmaCa() const
     return m_csmaca;
 }
 
+Ptr<RitWpanEnergyModel>
+RitWpanNetDevice::GetEnergyModel() const
+{
+    return m_energyModel;
+}
+
+Ptr<RitCarrierSensePipeline>
+RitWpanNetDevice::GetCarrierSense() const
+{
+    return m_carrierSense;
+}
+
 Ptr<Channel>
 RitWpanNetDevice::GetChannel() const
 {
@@ -359,21 +423,33 @@ RitWpanNetDevice::DoGetChannel() const
     return m_phy->GetChannel();
 }
 
-void
+int64_t
+RitWpanNetDevice::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    // The MAC covers the CSMA/CA it is wired to by CompleteConfig().
+    NS_ASSERT_MSG(m_configComplete, "AssignStreams() before the device is added to a node");
+    int64_t currentStream = stream;
+    currentStream += m_mac->AssignStreams(currentStream);
+    currentStream += m_phy->AssignStreams(currentStream);
+    currentStream += m_nwk->AssignStreams(currentStream);
+    return currentStream - stream;
+}
+
+bool
 RitWpanNetDevice::Send(Ptr<Packet> packet, Mac16Address m16DstAddr)
 {
     NS_LOG_FUNCTION(this << packet);
 
     // Non-IP: delegate to NWK layer.
-    m_nwk->SendRequest(packet, m16DstAddr);
+    return m_nwk->SendRequest(packet, m16DstAddr);
 }
 
 bool
 RitWpanNetDevice::Send(Ptr<Packet> packet, const Address& dest, uint16_t protocolNumber)
 {
     (void)protocolNumber; // unused for non-IP device
-    Send(packet, Mac16Address::ConvertFrom(dest));
-    return true;
+    return Send(packet, Mac16Address::ConvertFrom(dest));
 }
 
 void
@@ -461,5 +537,20 @@ RitWpanNetDevice::OnNwkReceive(Ptr<Packet> packet, const Mac16Address& srcAddr)
     m_receiveCallback(this, packet, 0, srcAddr);
 }
 
+void
+RitWpanNetDevice::OnEnergyUpdate(double consumed)
+{
+    m_energyDepletionTrace(consumed);
+}
+
+void
+RitWpanNetDevice::OnEnergyDepleted()
+{
+    NS_LOG_FUNCTION(this);
+    NS_LOG_INFO("[RIT-ENERGY] Node " << (m_node ? m_node->GetId() : 0) << " battery depleted at "
+                                     << m_energyModel->GetDepletionTime().As(Time::S));
+    m_energyExhaustedTrace();
+}
+
 } // namespace lrwpan
 } // namespace ns3
@@ -10,16 +10,19 @@
 #ifndef RIT_WPAN_NET_DEVICE_H
 #define RIT_WPAN_NET_DEVICE_H
 
+#include "rit-carrier-sense.h"
+#include "rit-wpan-energy-model.h"
 #include "rit-wpan-mac.h"
 #include "rit-wpan-nwk.h"
 #include "rit-wpan-precs.h"
-#include "rit-wpan-precsb.h"
 
 #include <ns3/lr-wpan-csmaca.h>
+#include <ns3/lr-wpan-error-model.h>
 #include <ns3/lr-wpan-phy.h>
 #include <ns3/net-device.h>
 #include <ns3/simulator.h>
 #include <ns3/spectrum-channel.h>
+#include <ns3/traced-callback.h>
 
 namespace ns3
 {
@@ -53,8 +56,16 @@ class RitWpanNetDevice : public NetDevice
     void SetMac(Ptr<RitWpanMac> mac);
     void SetPhy(Ptr<LrWpanPhy> phy);
     void SetCsmaCa(Ptr<LrWpanCsmaCa> csmaca);
+    void SetEnergyModel(Ptr<RitWpanEnergyModel> energyModel);
     void SetChannel(Ptr<SpectrumChannel> channel);
 
+    /**
+     * @brief Set the PHY error model. Without it, the configuration gives the PHY the
+     *        process-wide LrWpanErrorModel::GetShared() (the model is stateless).
+     * @param errorModel The error model
+     */
+    void SetErrorModel(Ptr<LrWpanErrorModel> errorModel);
+
     /* ---- RIT-specific configuration ---- */
     void SetRitRank(uint8_t rank);
     void SetMacRitPeriod(Time macRitPeriod);
@@ -67,12 +78,27 @@ class RitWpanNetDevice : public NetDevice
     Ptr<RitWpanMac> GetMac() const;
     Ptr<LrWpanPhy> GetPhy() const;
     Ptr<LrWpanCsmaCa> GetCsmaCa() const;
+    Ptr<RitWpanEnergyModel> GetEnergyModel() const;
+
+    /**
+     * @brief Get the carrier-sense stages of the MAC: add a stage and select it to
+     *        change the carrier sense of beacons or data frames.
+     * @return the stages, "csma-ca" and "pre-cs" registered
+     */
+    Ptr<RitCarrierSensePipeline> GetCarrierSense() const;
 
     Ptr<Channel> GetChannel() const override;
     uint8_t GetRitRank() const;
 
+    /**
+     * @brief Assign fixed random variable streams to the NWK, MAC and PHY.
+     * @param stream First stream index to use
+     * @return the number of stream indices assigned
+     */
+    int64_t AssignStreams(int64_t stream);
+
     /* ---- Packet transmission ---- */
-    void Send(Ptr<Packet> packet, Mac16Address dst);
+    bool Send(Ptr<Packet> packet, Mac16Address dst);
     bool Send(Ptr<Packet> packet, const Address& dest, uint16_t protocolNumber) override;
 
     /* ---- NetDevice API (used) ---- */
@@ -118,13 +144,15 @@ class RitWpanNetDevice : public NetDevice
   protected:
     void ForwardUp(Ptr<Packet>, Mac48Address, Mac48Address) override {}
 
-  private:
     void DoDispose() override;
     void DoInitialize() override;
 
+  private:
     Ptr<SpectrumChannel> DoGetChannel() const;
     void CompleteConfig();
     void OnNwkReceive(Ptr<Packet> packet, const Mac16Address& srcAddr);
+    void OnEnergyUpdate(double consumed);
+    void OnEnergyDepleted();
 
     /* ---- Core components ---- */
     Ptr<Node> m_node;
@@ -132,8 +160,11 @@ class RitWpanNetDevice : public NetDevice
     Ptr<RitWpanMac> m_mac;
     Ptr<RitSimpleRouting> m_nwk;
     Ptr<LrWpanCsmaCa> m_csmaca;
+    Ptr<RitCsmaCaCarrierSense> m_csmacaStage;
     Ptr<RitWpanPreCs> m_precs;
-    Ptr<RitWpanPreCsB> m_precsb;
+    Ptr<RitCarrierSensePipeline> m_carrierSense;
+    Ptr<RitWpanEnergyModel> m_energyModel;
+    Ptr<LrWpanErrorModel> m_errorModel;
 
     uint8_t m_rank;
     bool m_configComplete;
@@ -146,6 +177,10 @@ class RitWpanNetDevice : public NetDevice
     RitWpanMacModuleConfig m_moduleConfig;
 
     ReceiveCallback m_receiveCallback;
+
+    /* ---- Energy traces ---- */
+    TracedCallback<double> m_energyDepletionTrace; //!< Consumed radio energy [J], periodic
+    TracedCallback<> m_energyExhaustedTrace;       //!< Battery depleted
 };
 
 } // namespace lrwpan
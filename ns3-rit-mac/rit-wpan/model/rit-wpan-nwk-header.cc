@@ -15,7 +15,7 @@
  *
  * The header carries only the essential information required for
  * rank-based forwarding:
- *  - Node rank
+ *  - Node rank (12 bits), option (2 bits) and priority class (2 bits)
  *  - Source short address
  *  - Destination short address
  *
@@ -27,6 +27,7 @@
 #include "rit-wpan-nwk-header.h"
 
 #include "ns3/address-utils.h"
+#include "ns3/assert.h"
 
 #include <cstdint>
 
@@ -35,10 +36,25 @@ namespace ns3
 namespace lrwpan
 {
 
+namespace
+{
+
+constexpr uint16_t DISPATCH_COMPRESSED = 3; //!< Option value of the compressed rank word
+constexpr uint16_t DST_INLINE = 0;          //!< Destination carried inline
+constexpr uint16_t DST_ANY_SINK = 1;        //!< Destination elided: any sink
+constexpr uint16_t DST_BROADCAST = 2;       //!< Destination elided: broadcast
+constexpr uint16_t RANK_INLINE = 0x7f;      //!< Compressed rank code: rank follows
+
+} // namespace
+
 RitNwkHeader::RitNwkHeader()
+    : m_compressed(false),
+      m_srcElided(false)
 {
     // Default rank initialization
     SetRank(0);
+    SetPriority(0);
+    SetOption(OPTION_NONE);
 }
 
 RitNwkHeader::~RitNwkHeader()
@@ -57,6 +73,31 @@ RitNwkHeader::GetRank() const
     return m_rank;
 }
 
+void
+RitNwkHeader::SetPriority(uint8_t priority)
+{
+    NS_ASSERT(priority <= MAX_PRIORITY);
+    m_priority = priority;
+}
+
+uint8_t
+RitNwkHeader::GetPriority() const
+{
+    return m_priority;
+}
+
+void
+RitNwkHeader::SetOption(Option option)
+{
+    m_option = option;
+}
+
+RitNwkHeader::Option
+RitNwkHeader::GetOption() const
+{
+    return m_option;
+}
+
 void
 RitNwkHeader::SetSrcAddr(Mac16Address addr)
 {
@@ -81,16 +122,81 @@ RitNwkHeader::GetDstAddr() const
     return m_dstAddr;
 }
 
+void
+RitNwkHeader::SetCompressed(bool compressed)
+{
+    m_compressed = compressed;
+}
+
+bool
+RitNwkHeader::IsCompressed() const
+{
+    return m_compressed;
+}
+
+void
+RitNwkHeader::SetSrcAddrElided(bool elided)
+{
+    m_srcElided = elided;
+}
+
+bool
+RitNwkHeader::IsSrcAddrElided() const
+{
+    return m_srcElided;
+}
+
+uint8_t
+RitNwkHeader::GetDstCode() const
+{
+    if (m_dstAddr == Mac16Address(ANY_SINK_ADDR))
+    {
+        return DST_ANY_SINK;
+    }
+    if (m_dstAddr.IsBroadcast())
+    {
+        return DST_BROADCAST;
+    }
+    return DST_INLINE;
+}
+
 void
 RitNwkHeader::Serialize(Buffer::Iterator start) const
 {
     Buffer::Iterator i = start;
 
+    if (m_compressed)
+    {
+        // Compressed format: dispatch word, then the fields that are not elided.
+        NS_ASSERT(m_rank <= MAX_RANK);
+        const uint16_t dstCode = GetDstCode();
+        const uint16_t rankCode = m_rank < RANK_INLINE ? m_rank : RANK_INLINE;
+        i.WriteU16(static_cast<uint16_t>(m_priority << 14) |
+                   static_cast<uint16_t>(DISPATCH_COMPRESSED << 12) |
+                   static_cast<uint16_t>(m_option << 10) | static_cast<uint16_t>(dstCode << 8) |
+                   static_cast<uint16_t>(m_srcElided << 7) | rankCode);
+        if (rankCode == RANK_INLINE)
+        {
+            i.WriteU16(m_rank);
+        }
+        if (!m_srcElided)
+        {
+            WriteTo(i, m_srcAddr);
+        }
+        if (dstCode == DST_INLINE)
+        {
+            WriteTo(i, m_dstAddr);
+        }
+        return;
+    }
+
     // Serialize fields in fixed order:
-    // 1) Rank
+    // 1) Priority (2 MSBs), option (2 bits) and rank (12 LSBs)
     // 2) Source short address
     // 3) Destination short address
-    i.WriteU16(m_rank);
+    NS_ASSERT(m_rank <= MAX_RANK);
+    i.WriteU16(static_cast<uint16_t>(m_priority << 14) | static_cast<uint16_t>(m_option << 12) |
+               m_rank);
     WriteTo(i, m_srcAddr);
     WriteTo(i, m_dstAddr);
 }
@@ -101,7 +207,44 @@ RitNwkHeader::Deserialize(Buffer::Iterator start)
     Buffer::Iterator i = start;
 
     // Deserialize fields in the same order as serialization
-    m_rank = i.ReadU16();
+    const uint16_t word = i.ReadU16();
+    m_priority = word >> 14;
+    if (((word >> 12) & 0x3) == DISPATCH_COMPRESSED)
+    {
+        m_compressed = true;
+        m_option = static_cast<Option>((word >> 10) & 0x3);
+        const uint16_t dstCode = (word >> 8) & 0x3;
+        m_srcElided = (word >> 7) & 0x1;
+        m_rank = word & RANK_INLINE;
+        if (m_rank == RANK_INLINE)
+        {
+            m_rank = i.ReadU16() & MAX_RANK;
+        }
+        // An elided source stays unset until the receiver sets the MAC source.
+        m_srcAddr = Mac16Address();
+        if (!m_srcElided)
+        {
+            ReadFrom(i, m_srcAddr);
+        }
+        switch (dstCode)
+        {
+        case DST_ANY_SINK:
+            m_dstAddr = Mac16Address(ANY_SINK_ADDR);
+            break;
+        case DST_BROADCAST:
+            m_dstAddr = Mac16Address::GetBroadcast();
+            break;
+        default:
+            ReadFrom(i, m_dstAddr);
+            break;
+        }
+        return i.GetDistanceFrom(start);
+    }
+
+    m_compressed = false;
+    m_srcElided = false;
+    m_option = static_cast<Option>((word >> 12) & 0x3);
+    m_rank = word & MAX_RANK;
     ReadFrom(i, m_srcAddr);
     ReadFrom(i, m_dstAddr);
 
@@ -111,10 +254,16 @@ RitNwkHeader::Deserialize(Buffer::Iterator start)
 uint32_t
 RitNwkHeader::GetSerializedSize() const
 {
-    // Rank: 2 bytes
+    // Priority, option and rank: 2 bytes
     // Source address: 2 bytes
     // Destination address: 2 bytes
-    return 6;
+    if (!m_compressed)
+    {
+        return 6;
+    }
+    // Compressed: dispatch word, then the rank, source and destination if not elided
+    return 2 + (m_rank < RANK_INLINE ? 0 : 2) + (m_srcElided ? 0 : 2) +
+           (GetDstCode() == DST_INLINE ? 2 : 0);
 }
 
 TypeId
@@ -140,8 +289,12 @@ RitNwkHeader::Print(std::ostream& os) const
 {
     os << "RitNwkHeader"
        << " [Rank=" << m_rank
+       << ", Priority=" << static_cast<uint32_t>(m_priority)
+       << ", Option=" << static_cast<uint32_t>(m_option)
        << ", Src=" << m_srcAddr
        << ", Dst=" << m_dstAddr
+       << (m_compressed ? ", Compressed" : "")
+       << (m_srcElided ? ", SrcElided" : "")
        << "]";
 }
 
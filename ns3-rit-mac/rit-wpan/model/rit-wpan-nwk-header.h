@@ -23,6 +23,19 @@ namespace lrwpan
  *
  * This header is used by the simplified routing logic implemented
  * for receiver-initiated (RIT) MAC protocol evaluation.
+ *
+ * The uncompressed format is the 16-bit rank word (priority, option, rank)
+ * followed by the source and destination addresses: 6 bytes. The compressed
+ * format (SetCompressed()) reuses the reserved option value 3 of the rank word
+ * as its dispatch, so that both formats are decoded by every node:
+ *
+ *   bits 15-14 priority, 13-12 dispatch (3), 11-10 option,
+ *   bits 9-8 destination (0 inline, 1 any sink, 2 broadcast),
+ *   bit 7 source elided (it is the MAC source of the frame),
+ *   bits 6-0 rank (0 to 126; 127: the rank follows in 16 bits),
+ *
+ * followed by the inline rank, source and destination, when present. An uplink
+ * packet to the sinks, or a beacon payload, takes 2 bytes instead of 6.
  */
 class RitNwkHeader : public Header
 {
@@ -36,6 +49,36 @@ class RitNwkHeader : public Header
     /** Get the node rank */
     uint16_t GetRank() const;
 
+    /**
+     * Set the priority class of the packet (0 = lowest, up to MAX_PRIORITY).
+     *
+     * The class and the option share the rank word on the wire: ranks are
+     * limited to 12 bits (MAX_RANK).
+     */
+    void SetPriority(uint8_t priority);
+
+    /** Get the priority class of the packet */
+    uint8_t GetPriority() const;
+
+    static constexpr uint8_t MAX_PRIORITY = 3;   //!< Highest priority class
+    static constexpr uint16_t MAX_RANK = 0x0fff; //!< Largest rank on the wire
+
+    /**
+     * Header that follows this one, if any.
+     */
+    enum Option : uint8_t
+    {
+        OPTION_NONE = 0,         //!< Payload follows
+        OPTION_SOURCE_ROUTE = 1, //!< RitRouteHeader with the relays to the destination
+        OPTION_ROUTE_REPORT = 2, //!< RitRouteHeader with the origin and its parent
+    };
+
+    /** Set the header that follows this one */
+    void SetOption(Option option);
+
+    /** Get the header that follows this one */
+    Option GetOption() const;
+
     /** Set the source MAC short address */
     void SetSrcAddr(Mac16Address addr);
 
@@ -48,6 +91,24 @@ class RitNwkHeader : public Header
     /** Get the destination MAC short address */
     Mac16Address GetDstAddr() const;
 
+    /** Destination address of the packets to any sink (RitSimpleRouting) */
+    static constexpr uint16_t ANY_SINK_ADDR = 0xFFFD;
+
+    /** Serialize the header in the compressed format */
+    void SetCompressed(bool compressed);
+
+    /** Whether the header uses (or was received in) the compressed format */
+    bool IsCompressed() const;
+
+    /**
+     * Elide the source in the compressed format: it is the MAC source of the
+     * frame. A receiver sets the source back from the MAC source (SetSrcAddr()).
+     */
+    void SetSrcAddrElided(bool elided);
+
+    /** Whether the source is (or was) elided */
+    bool IsSrcAddrElided() const;
+
     // ns-3 Header API
     static TypeId GetTypeId();
     TypeId GetInstanceTypeId() const override;
@@ -57,9 +118,19 @@ class RitNwkHeader : public Header
     void Print(std::ostream& os) const override;
 
   private:
+    /**
+     * Destination code of the compressed format.
+     * \return the code of the destination
+     */
+    uint8_t GetDstCode() const;
+
     uint16_t m_rank;        //!< Node rank used for rank-based forwarding
+    uint8_t m_priority;     //!< Priority class, carried in the top bits of the rank word
+    Option m_option;        //!< Following header, carried below the priority class
     Mac16Address m_srcAddr; //!< Source address (currently optional in RIT mode)
     Mac16Address m_dstAddr; //!< Destination address
+    bool m_compressed;      //!< Compressed format
+    bool m_srcElided;       //!< Source elided in the compressed format
 };
 
 } // namespace lrwpan
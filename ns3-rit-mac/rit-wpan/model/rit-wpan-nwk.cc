@@ -21,6 +21,10 @@
  *  - Rank-based routing without route discovery or maintenance
  *  - Uplink-oriented, tree-like forwarding
  *  - Best-effort retransmission on MAC-layer failures
+ *  - Optional aggregation of packets toward the same destination
+ *  - Optional anycast to any lower-rank neighbour with queue headroom
+ *  - Optional backpressure: beacons of next hops without headroom left unanswered
+ *  - Network-wide broadcast with duplicate cache and Trickle-style suppression
  *
  * This implementation is required to enable multi-hop evaluation,
  * while keeping the network-layer behavior simple and deterministic
@@ -28,13 +32,25 @@
  */
 
 #include "rit-wpan-nwk.h"
+#include "rit-aggregation-header.h"
+#include "rit-route-header.h"
+#include "rit-run-arena.h"
+#include "rit-timestamp-tag.h"
 #include "rit-wpan-nwk-header.h"
 
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/enum.h"
 #include "ns3/log.h"
+#include "ns3/lr-wpan-event-profiler.h"
 #include "ns3/mac16-address.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
+#include "ns3/socket.h"
+#include "ns3/uinteger.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
 
 namespace ns3
@@ -45,6 +61,15 @@ namespace lrwpan
 NS_LOG_COMPONENT_DEFINE("RitSimpleRouting");
 NS_OBJECT_ENSURE_REGISTERED(RitSimpleRouting);
 
+namespace
+{
+
+// Handler reported to LrWpanEventProfiler
+const uint32_t PROFILE_RETRY =
+    LrWpanEventProfiler::RegisterHandler("RitSimpleRouting::RetrySendRequest");
+
+} // namespace
+
 TypeId
 RitSimpleRouting::GetTypeId()
 {
@@ -53,6 +78,195 @@ RitSimpleRouting::GetTypeId()
             .SetParent<Object>()
             .SetGroupName("LrWpan")
             .AddConstructor<RitSimpleRouting>()
+            .AddAttribute("AggregationEnabled",
+                          "Aggregate packets toward the same destination into one MAC frame. "
+                          "Must be the same on every node.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&RitSimpleRouting::m_aggregationEnabled),
+                          MakeBooleanChecker())
+            .AddAttribute("AggregationMaxDelay",
+                          "Longest time a packet waits for others before its frame is sent",
+                          TimeValue(MilliSeconds(500)),
+                          MakeTimeAccessor(&RitSimpleRouting::m_aggregationMaxDelay),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("AggregationMaxBytes",
+                          "Largest aggregated MSDU (length table and NWK headers included)",
+                          UintegerValue(90),
+                          MakeUintegerAccessor(&RitSimpleRouting::m_aggregationMaxBytes),
+                          MakeUintegerChecker<uint32_t>(8, 255))
+            .AddAttribute("AnycastEnabled",
+                          "Advertise the queue headroom in the RIT request payload and send to "
+                          "any lower-rank neighbour with enough headroom. "
+                          "Must be the same on every node.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&RitSimpleRouting::m_anycastEnabled),
+                          MakeBooleanChecker())
+            .AddAttribute("AnycastQueueCapacity",
+                          "MAC frames this node accepts to hold; the advertised headroom is "
+                          "the capacity minus the frames waiting in the MAC, at most the free "
+                          "room of a bounded MAC TX queue (AnycastEnabled, BackpressureEnabled)",
+                          UintegerValue(8),
+                          MakeUintegerAccessor(&RitSimpleRouting::m_anycastQueueCapacity),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("AnycastMinHeadroom",
+                          "Headroom a neighbour must advertise to be used as next hop",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&RitSimpleRouting::m_anycastMinHeadroom),
+                          MakeUintegerChecker<uint8_t>())
+            .AddAttribute("BackpressureEnabled",
+                          "Advertise the queue headroom in the RIT request payload and leave "
+                          "unanswered the beacons of next hops with too little headroom. "
+                          "Must be the same on every node.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&RitSimpleRouting::m_backpressureEnabled),
+                          MakeBooleanChecker())
+            .AddAttribute("BackpressureMinHeadroom",
+                          "Headroom a next hop must advertise for its beacon to be answered",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&RitSimpleRouting::m_backpressureMinHeadroom),
+                          MakeUintegerChecker<uint8_t>())
+            .AddAttribute("MaxRetries",
+                          "Times a packet is sent again after a NO_ACK",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&RitSimpleRouting::m_maxRetries),
+                          MakeUintegerChecker<uint8_t>())
+            .AddAttribute("RetryPolicy",
+                          "When a packet is sent again: after a random delay, or shortly "
+                          "before the next predicted beacon of a parent",
+                          EnumValue(RIT_RETRY_RANDOM),
+                          MakeEnumAccessor<RitRetryPolicy>(&RitSimpleRouting::m_retryPolicy),
+                          MakeEnumChecker(RIT_RETRY_RANDOM,
+                                          "Random",
+                                          RIT_RETRY_RENDEZVOUS,
+                                          "Rendezvous"))
+            .AddAttribute("BootstrapDuration",
+                          "Listen period of Bootstrap(); zero listens for two RIT periods",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&RitSimpleRouting::m_bootstrapDuration),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("LinkCost",
+                          "Rank added to the rank of the parent by Bootstrap(), also the rank "
+                          "difference of the parents whose beacons are answered",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&RitSimpleRouting::m_linkCost),
+                          MakeUintegerChecker<uint16_t>(1, 255))
+            .AddAttribute("MinParentLqi",
+                          "Lowest LQI of a beacon taken as parent by Bootstrap()",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&RitSimpleRouting::m_minParentLqi),
+                          MakeUintegerChecker<uint8_t>())
+            .AddAttribute("LocalRepair",
+                          "Switch to another parent of the neighbour table after "
+                          "RepairThreshold consecutive failed exchanges",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&RitSimpleRouting::m_localRepairEnabled),
+                          MakeBooleanChecker())
+            .AddAttribute("RepairThreshold",
+                          "Consecutive NO_ACK confirms or TWD timeouts that mark the parent "
+                          "stale",
+                          UintegerValue(3),
+                          MakeUintegerAccessor(&RitSimpleRouting::m_repairThreshold),
+                          MakeUintegerChecker<uint8_t>(1, 255))
+            .AddAttribute("DownlinkEnabled",
+                          "Report the parent in uplink packets and source-route the packets "
+                          "sent by the sink (rank 0) along the reported parents",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&RitSimpleRouting::m_downlinkEnabled),
+                          MakeBooleanChecker())
+            .AddAttribute("RouteReportInterval",
+                          "Longest time between two parent reports of a node whose parent "
+                          "did not change",
+                          TimeValue(Seconds(60)),
+                          MakeTimeAccessor(&RitSimpleRouting::m_routeReportInterval),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("NeighbourTableSize",
+                          "Largest number of neighbours kept from their beacons",
+                          UintegerValue(16),
+                          MakeUintegerAccessor(&RitSimpleRouting::m_neighbourTableSize),
+                          MakeUintegerChecker<uint32_t>(1, 255))
+            .AddAttribute("NeighbourStaleTime",
+                          "Time without a beacon after which a neighbour may be replaced by "
+                          "any newcomer of a full table",
+                          TimeValue(Seconds(60)),
+                          MakeTimeAccessor(&RitSimpleRouting::m_neighbourStaleTime),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("MaxParentEtx",
+                          "Largest ETX of a parent chosen by Bootstrap() or of a beacon "
+                          "answered with data; zero for no limit",
+                          DoubleValue(0.0),
+                          MakeDoubleAccessor(&RitSimpleRouting::m_maxParentEtx),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("TxTableSize",
+                          "Packets the NWK layer can hold between their arrival and their "
+                          "final confirm, retries included",
+                          UintegerValue(256),
+                          MakeUintegerAccessor(&RitSimpleRouting::m_txTableSize),
+                          MakeUintegerChecker<uint32_t>(1, 256))
+            .AddAttribute("RetryMaxDelay",
+                          "Upper bound of the uniform retry delay (Random RetryPolicy)",
+                          TimeValue(Seconds(5)),
+                          MakeTimeAccessor(&RitSimpleRouting::m_retryMaxDelay),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("HeaderCompression",
+                          "Send the NWK headers of data packets and beacons in the compressed "
+                          "format. Every node decodes both formats.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&RitSimpleRouting::m_headerCompression),
+                          MakeBooleanChecker())
+            .AddAttribute("BroadcastInterval",
+                          "Trickle interval I of the broadcast forwards: a new broadcast is "
+                          "forwarded at a random time in [I/2, I); zero for two RIT periods",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&RitSimpleRouting::m_broadcastInterval),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("BroadcastRedundancy",
+                          "Copies of a broadcast received before its forward is due that "
+                          "suppress the forward (Trickle k); zero never suppresses",
+                          UintegerValue(2),
+                          MakeUintegerAccessor(&RitSimpleRouting::m_broadcastRedundancy),
+                          MakeUintegerChecker<uint8_t>())
+            .AddAttribute("DuplicateDetection",
+                          "Unicast packets carry their origin and a sequence number, and the "
+                          "relays and the destination drop the copies already received, e.g. "
+                          "after a lost ACK. Every node must use the same setting.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&RitSimpleRouting::m_duplicateDetection),
+                          MakeBooleanChecker())
+            .AddAttribute("DuplicateCacheSize",
+                          "Origin and sequence number pairs kept (DuplicateDetection)",
+                          UintegerValue(64),
+                          MakeUintegerAccessor(&RitSimpleRouting::m_duplicateCacheSize),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("DuplicateLifetime",
+                          "Time an origin and sequence number are kept; longer than the "
+                          "retries of a packet (DuplicateDetection)",
+                          TimeValue(Seconds(60)),
+                          MakeTimeAccessor(&RitSimpleRouting::m_duplicateLifetime),
+                          MakeTimeChecker(MilliSeconds(1)))
+            .AddAttribute("EnergyBalancingEnabled",
+                          "The RIT request payload advertises the residual energy, and the "
+                          "beacons of the eligible next hops are answered in proportion to "
+                          "it. Every node must use the same setting.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&RitSimpleRouting::m_energyBalancing),
+                          MakeBooleanChecker())
+            .AddAttribute("LowEnergyThreshold",
+                          "Residual share of the battery below which a relay advertises no "
+                          "energy and lengthens its RIT period; zero disables it",
+                          DoubleValue(0.0),
+                          MakeDoubleAccessor(&RitSimpleRouting::m_lowEnergyThreshold),
+                          MakeDoubleChecker<double>(0.0, 1.0))
+            .AddAttribute("LowEnergyPeriodFactor",
+                          "RIT period multiplier of a relay in the low-battery mode",
+                          DoubleValue(2.0),
+                          MakeDoubleAccessor(&RitSimpleRouting::m_lowEnergyPeriodFactor),
+                          MakeDoubleChecker<double>(1.0))
+            .AddAttribute("EnergyCheckInterval",
+                          "Time between two reads of the residual energy "
+                          "(EnergyBalancingEnabled, LowEnergyThreshold)",
+                          TimeValue(Seconds(60)),
+                          MakeTimeAccessor(&RitSimpleRouting::m_energyCheckInterval),
+                          MakeTimeChecker(MilliSeconds(1)))
             .AddTraceSource("NwkTx",
                             "NWK layer transmit trace",
                             MakeTraceSourceAccessor(&RitSimpleRouting::m_nwkTxTrace),
@@ -76,24 +290,354 @@ RitSimpleRouting::GetTypeId()
             .AddTraceSource("NwkReTx",
                             "NWK layer re-transmit packet trace",
                             MakeTraceSourceAccessor(&RitSimpleRouting::m_nwkReTxTrace),
-                            "ns3::Packet::TracedCallback");
+                            "ns3::Packet::TracedCallback")
+            .AddTraceSource("NwkReTxBackoff",
+                            "Retransmission scheduled: packet, attempt number and delay",
+                            MakeTraceSourceAccessor(&RitSimpleRouting::m_nwkReTxBackoffTrace),
+                            "ns3::lrwpan::RitSimpleRouting::ReTxBackoffTracedCallback")
+            .AddTraceSource("TxTableOccupancy",
+                            "Slots of the transmit table in use",
+                            MakeTraceSourceAccessor(&RitSimpleRouting::m_txTableOccupancy),
+                            "ns3::TracedValueCallback::Uint32")
+            .AddTraceSource("NwkBootstrap",
+                            "Bootstrap finished: rank, parent and time since Bootstrap()",
+                            MakeTraceSourceAccessor(&RitSimpleRouting::m_nwkBootstrapTrace),
+                            "ns3::lrwpan::RitSimpleRouting::BootstrapTracedCallback")
+            .AddTraceSource("NwkRepair",
+                            "Parent marked stale: old parent, new parent and new rank",
+                            MakeTraceSourceAccessor(&RitSimpleRouting::m_nwkRepairTrace),
+                            "ns3::lrwpan::RitSimpleRouting::RepairTracedCallback")
+            .AddTraceSource("NwkDownlinkTx",
+                            "Source-routed packet sent by the sink: packet, destination and "
+                            "hops",
+                            MakeTraceSourceAccessor(&RitSimpleRouting::m_nwkDownlinkTxTrace),
+                            "ns3::lrwpan::RitSimpleRouting::DownlinkTxTracedCallback")
+            .AddTraceSource("NwkDownlinkRx",
+                            "Source-routed packet delivered: packet, latency from its "
+                            "RitTimestampTag (zero without) and hops",
+                            MakeTraceSourceAccessor(&RitSimpleRouting::m_nwkDownlinkRxTrace),
+                            "ns3::lrwpan::RitSimpleRouting::DownlinkRxTracedCallback")
+            .AddTraceSource("NwkBroadcastTx",
+                            "Broadcast started or forwarded: packet, origin, sequence number "
+                            "and hops",
+                            MakeTraceSourceAccessor(&RitSimpleRouting::m_nwkBroadcastTxTrace),
+                            "ns3::lrwpan::RitSimpleRouting::BroadcastTxTracedCallback")
+            .AddTraceSource("NwkBroadcastRx",
+                            "First reception of a broadcast: packet, origin, sequence number, "
+                            "hops and latency from its RitTimestampTag (zero without)",
+                            MakeTraceSourceAccessor(&RitSimpleRouting::m_nwkBroadcastRxTrace),
+                            "ns3::lrwpan::RitSimpleRouting::BroadcastRxTracedCallback")
+            .AddTraceSource("NwkBroadcastSuppress",
+                            "Broadcast forward suppressed: origin, sequence number and copies "
+                            "received",
+                            MakeTraceSourceAccessor(
+                                &RitSimpleRouting::m_nwkBroadcastSuppressTrace),
+                            "ns3::lrwpan::RitSimpleRouting::BroadcastSuppressTracedCallback")
+            .AddTraceSource("NwkBackpressure",
+                            "Beacon left unanswered: beaconing next hop and advertised headroom",
+                            MakeTraceSourceAccessor(&RitSimpleRouting::m_nwkBackpressureTrace),
+                            "ns3::lrwpan::RitSimpleRouting::BackpressureTracedCallback")
+            .AddTraceSource("NwkLowEnergy",
+                            "Low-battery mode entered: residual share of the battery",
+                            MakeTraceSourceAccessor(&RitSimpleRouting::m_nwkLowEnergyTrace),
+                            "ns3::lrwpan::RitSimpleRouting::LowEnergyTracedCallback")
+            .AddTraceSource("NwkRxDuplicate",
+                            "Unicast packet received again and dropped: packet, origin and "
+                            "sequence number (DuplicateDetection)",
+                            MakeTraceSourceAccessor(&RitSimpleRouting::m_nwkRxDuplicateTrace),
+                            "ns3::lrwpan::RitSimpleRouting::DuplicateTracedCallback");
     return tid;
 }
 
 RitSimpleRouting::RitSimpleRouting()
+    : m_txTable(RitRunArena::GetResource()),
+      m_freeTxSlots(RitRunArena::GetResource()),
+      m_aggregationBuffers(RitRunArena::GetResource()),
+      m_broadcastSeen(RitRunArena::GetResource()),
+      m_pendingBroadcasts(RitRunArena::GetResource())
 {
     m_txPkt = nullptr;
     m_reTxDelay = CreateObject<UniformRandomVariable>();
+    m_maxRetries = 0;
+    m_retryPolicy = RIT_RETRY_RANDOM;
+    m_retryMaxDelay = Seconds(5);
+    m_aggregationEnabled = false;
+    m_aggregationMaxBytes = 90;
+    m_anycastEnabled = false;
+    m_anycastQueueCapacity = 8;
+    m_anycastMinHeadroom = 1;
+    m_advertisedHeadroom = 0;
+    m_backpressureEnabled = false;
+    m_backpressureMinHeadroom = 1;
+    m_backpressureSkipped = false;
+    m_txTableSize = 256;
+    m_msduHead.fill(-1);
+    m_nQueuedMsdus = 0;
+    m_txTableOccupancy = 0;
+    m_rank = 0;
+    m_bootstrapDuration = Seconds(0);
+    m_linkCost = 1;
+    m_minParentLqi = 0;
+    m_bootstrapping = false;
+    m_parent = Mac16Address::GetBroadcast();
+    m_neighbourTableSize = 16;
+    m_neighbourStaleTime = Seconds(60);
+    m_maxParentEtx = 0.0;
+    m_lastPeerValid = false;
+    m_localRepairEnabled = false;
+    m_repairThreshold = 3;
+    m_consecutiveFailures = 0;
+    m_downlinkEnabled = false;
+    m_routeReportInterval = Seconds(60);
+    m_uplinkPeerValid = false;
+    m_reportValid = false;
+    m_headerCompression = false;
+    m_broadcastInterval = Seconds(0);
+    m_broadcastRedundancy = 2;
+    m_broadcastSeq = 0;
+    m_duplicateDetection = false;
+    m_duplicateCacheSize = 64;
+    m_duplicateLifetime = Seconds(60);
+    m_unicastSeq = 0;
+    m_energyBalancing = false;
+    m_lowEnergyThreshold = 0.0;
+    m_lowEnergyPeriodFactor = 2.0;
+    m_energyCheckInterval = Seconds(60);
+    m_energyRng = CreateObject<UniformRandomVariable>();
+    m_advertisedEnergy = UINT8_MAX;
+    m_lowEnergy = false;
 }
 
 RitSimpleRouting::~RitSimpleRouting() = default;
 
+void
+RitSimpleRouting::DoInitialize()
+{
+    m_neighbours.SetCapacity(m_neighbourTableSize);
+    m_neighbours.SetStaleTime(m_neighbourStaleTime);
+    m_rxDuplicates.SetCapacity(m_duplicateCacheSize);
+    m_rxDuplicates.SetLifetime(m_duplicateLifetime);
+
+    // The attributes may have changed since SetRank() built the payload.
+    if (m_mac)
+    {
+        UpdateRitRequestPayload();
+    }
+    if (m_energyModel && (m_energyBalancing || m_lowEnergyThreshold > 0.0))
+    {
+        m_energyCheckEvent =
+            Simulator::Schedule(m_energyCheckInterval, &RitSimpleRouting::CheckEnergy, this);
+    }
+    Object::DoInitialize();
+}
+
+void
+RitSimpleRouting::DoDispose()
+{
+    // In a bulk teardown, the events die with the simulator and the tables with the object
+    if (!RitRunArena::IsBulkTeardown())
+    {
+        for (auto& entry : m_aggregationBuffers)
+        {
+            entry.second.flushEvent.Cancel();
+        }
+        m_aggregationBuffers.clear();
+        m_txTable.clear();
+        m_freeTxSlots.clear();
+        m_msduHead.fill(-1);
+        m_nQueuedMsdus = 0;
+        m_neighbours.Clear();
+        m_downlinkParents.clear();
+        for (auto& entry : m_pendingBroadcasts)
+        {
+            entry.second.forwardEvent.Cancel();
+        }
+        m_pendingBroadcasts.clear();
+        m_broadcastSeen.clear();
+        m_rxDuplicates.Clear();
+        m_energyCheckEvent.Cancel();
+    }
+    m_radioMacs.clear();
+    m_energyModel = nullptr;
+    Object::DoDispose();
+}
+
 void
 RitSimpleRouting::Bootstrap()
 {
-    // NOTE [NOT IMPLEMENTED]:
-    // Bootstrap procedures (e.g., parent discovery / rank negotiation)
-    // are intentionally omitted in this simplified implementation.
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(m_mac);
+
+    if (!m_bootstrapping)
+    {
+        m_bootstrapping = true;
+        m_bootstrapStart = Simulator::Now();
+        m_parent = Mac16Address::GetBroadcast();
+        m_neighbours.ClearProtected();
+        m_consecutiveFailures = 0;
+        SetRank(RANK_UNKNOWN);
+    }
+
+    Time duration = m_bootstrapDuration;
+    if (!duration.IsStrictlyPositive())
+    {
+        // Two periods, so that a neighbour beacon is heard despite drift and randomization.
+        duration = m_mac->GetRitPeriodTime() * 2;
+    }
+    m_mac->MlmeBootstrapRequest(duration);
+}
+
+void
+RitSimpleRouting::MlmeBootstrapConfirm()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (!m_bootstrapping)
+    {
+        return;
+    }
+    const RitNeighbour* parent = m_neighbours.SelectParent(m_minParentLqi, m_maxParentEtx);
+    if (!parent)
+    {
+        NS_LOG_DEBUG("No parent heard; listening again.");
+        Bootstrap();
+        return;
+    }
+
+    m_bootstrapping = false;
+    m_parent = parent->addr;
+    m_neighbours.SetProtected(m_parent);
+    const uint16_t rank =
+        static_cast<uint16_t>(std::min<uint32_t>(parent->rank + m_linkCost, RANK_UNKNOWN - 1));
+    NS_LOG_DEBUG("Bootstrap done: rank " << rank << " via " << m_parent << " (LQI "
+                                         << parent->lqi << ", ETX " << parent->GetEtx() << ")");
+    SetRank(rank);
+    m_nwkBootstrapTrace(rank, m_parent, Simulator::Now() - m_bootstrapStart);
+}
+
+Mac16Address
+RitSimpleRouting::GetParent() const
+{
+    return m_parent;
+}
+
+const RitNeighbourTable&
+RitSimpleRouting::GetNeighbourTable() const
+{
+    return m_neighbours;
+}
+
+RitNwkCheckpoint
+RitSimpleRouting::GetCheckpoint() const
+{
+    const Time now = Simulator::Now();
+    RitNwkCheckpoint checkpoint;
+    checkpoint.rank = m_rank;
+    checkpoint.parent = m_parent;
+    checkpoint.neighbours.assign(m_neighbours.GetEntries().begin(),
+                                 m_neighbours.GetEntries().end());
+    for (auto& entry : checkpoint.neighbours)
+    {
+        entry.lastBeacon = now - entry.lastBeacon;
+    }
+    checkpoint.downlinkParents = m_downlinkParents;
+    return checkpoint;
+}
+
+void
+RitSimpleRouting::RestoreCheckpoint(const RitNwkCheckpoint& checkpoint)
+{
+    NS_LOG_FUNCTION(this << checkpoint.rank << checkpoint.parent);
+    const Time now = Simulator::Now();
+
+    // DoInitialize() may not have run yet.
+    m_neighbours.SetCapacity(m_neighbourTableSize);
+    m_neighbours.SetStaleTime(m_neighbourStaleTime);
+    m_neighbours.Clear();
+    for (RitNeighbour entry : checkpoint.neighbours)
+    {
+        entry.lastBeacon = now - entry.lastBeacon;
+        if (!m_neighbours.Restore(entry))
+        {
+            NS_LOG_DEBUG("No room for neighbour " << entry.addr);
+        }
+    }
+
+    m_bootstrapping = false;
+    m_consecutiveFailures = 0;
+    m_parent = checkpoint.parent;
+    if (m_parent.IsBroadcast())
+    {
+        m_neighbours.ClearProtected();
+    }
+    else
+    {
+        m_neighbours.SetProtected(m_parent);
+    }
+    m_downlinkParents = checkpoint.downlinkParents;
+    m_reportValid = false;
+    SetRank(checkpoint.rank);
+}
+
+void
+RitSimpleRouting::MlmeRitTxWaitTimeout()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_backpressureSkipped)
+    {
+        // Only congested next hops beaconed: the frame waits, the link did not fail.
+        m_backpressureSkipped = false;
+        return;
+    }
+    NotifyLinkFailure();
+}
+
+void
+RitSimpleRouting::NotifyLinkFailure()
+{
+    if (!m_localRepairEnabled || m_bootstrapping || m_parent.IsBroadcast())
+    {
+        return;
+    }
+    if (++m_consecutiveFailures >= m_repairThreshold)
+    {
+        RepairParent();
+    }
+}
+
+void
+RitSimpleRouting::RepairParent()
+{
+    NS_LOG_FUNCTION(this);
+
+    const Mac16Address oldParent = m_parent;
+    m_consecutiveFailures = 0;
+    m_neighbours.MarkStale(oldParent);
+    m_neighbours.ClearProtected();
+
+    // A neighbour of higher rank may route through this node.
+    const RitNeighbour* parent =
+        m_neighbours.SelectParent(m_minParentLqi, m_maxParentEtx, m_rank);
+    if (!parent)
+    {
+        NS_LOG_DEBUG("No other parent for " << oldParent << "; bootstrapping again.");
+        m_nwkRepairTrace(oldParent, Mac16Address::GetBroadcast(), RANK_UNKNOWN);
+        // Not from within a MAC confirm: the bootstrap stops the RIT cycle.
+        Simulator::ScheduleNow(&RitSimpleRouting::Bootstrap, this);
+        return;
+    }
+
+    m_parent = parent->addr;
+    m_neighbours.SetProtected(m_parent);
+    const uint16_t rank =
+        static_cast<uint16_t>(std::min<uint32_t>(parent->rank + m_linkCost, RANK_UNKNOWN - 1));
+    NS_LOG_DEBUG("Parent " << oldParent << " stale; switched to " << m_parent << ", rank "
+                           << rank);
+    if (rank != m_rank)
+    {
+        SetRank(rank);
+    }
+    m_nwkRepairTrace(oldParent, m_parent, rank);
 }
 
 void
@@ -101,16 +645,100 @@ RitSimpleRouting::McpsDataIndication(McpsDataIndicationParams params, Ptr<Packet
 {
     NS_LOG_FUNCTION_NOARGS();
 
+    if (!m_aggregationEnabled)
+    {
+        ReceivePacket(p, params.m_srcAddr);
+        return;
+    }
+
+    RitAggregationHeader aggHdr;
+    p->RemoveHeader(aggHdr);
+
+    uint32_t offset = 0;
+    for (uint8_t k = 0; k < aggHdr.GetNSubFrames(); k++)
+    {
+        const uint32_t length = aggHdr.GetSubFrameLength(k);
+        if (offset + length > p->GetSize())
+        {
+            NS_LOG_WARN("Truncated aggregate; dropping the remaining sub-frames.");
+            m_nwkRxDropTrace(p);
+            return;
+        }
+        Ptr<Packet> sub = p->CreateFragment(offset, length);
+        offset += length;
+
+        // The sender timestamp travels as a byte tag inside the aggregate.
+        RitTimestampTag timestamp;
+        if (!sub->PeekPacketTag(timestamp) && sub->FindFirstMatchingByteTag(timestamp))
+        {
+            sub->AddPacketTag(timestamp);
+        }
+        ReceivePacket(sub, params.m_srcAddr);
+    }
+}
+
+void
+RitSimpleRouting::ReceivePacket(Ptr<Packet> p, Mac16Address macSrc)
+{
     RitNwkHeader nwkHdr;
     p->RemoveHeader(nwkHdr);
+    if (nwkHdr.IsSrcAddrElided())
+    {
+        nwkHdr.SetSrcAddr(macSrc);
+    }
 
     NS_LOG_DEBUG("McpsDataIndication: SrcAddr=" << nwkHdr.GetSrcAddr()
                                                 << ", DstAddr=" << nwkHdr.GetDstAddr()
                                                 << ", Rank=" << nwkHdr.GetRank());
 
-    // Case 1: The packet is destined to this node.
-    if (nwkHdr.GetDstAddr() == m_shortAddr)
+    // Case 0: Network-wide broadcast, whatever the rank.
+    if (nwkHdr.GetDstAddr().IsBroadcast())
+    {
+        ReceiveBroadcast(p, nwkHdr);
+        return;
+    }
+
+    RitRouteHeader routeHdr;
+    if (nwkHdr.GetOption() != RitNwkHeader::OPTION_NONE)
     {
+        p->RemoveHeader(routeHdr);
+    }
+
+    // The origin and sequence number identify the packet whatever its path.
+    RitBroadcastHeader seqHdr;
+    if (m_duplicateDetection)
+    {
+        p->RemoveHeader(seqHdr);
+        const uint32_t key =
+            (static_cast<uint32_t>(seqHdr.GetOrigin().ConvertToInt()) << 16) | seqHdr.GetSequence();
+        if (!m_rxDuplicates.Insert(key, Simulator::Now()))
+        {
+            NS_LOG_DEBUG("Duplicate packet " << seqHdr.GetOrigin() << "/" << seqHdr.GetSequence()
+                                             << " from " << nwkHdr.GetSrcAddr());
+            m_nwkRxDuplicateTrace(p, seqHdr.GetOrigin(), seqHdr.GetSequence());
+            return;
+        }
+        seqHdr.SetHops(static_cast<uint8_t>(std::min<uint32_t>(seqHdr.GetHops() + 1, 255)));
+    }
+
+    // Case 1: The packet is destined to this node, or to any sink at a sink.
+    if (nwkHdr.GetDstAddr() == m_shortAddr ||
+        (m_rank == 0 && nwkHdr.GetDstAddr() == GetAnySinkAddress()))
+    {
+        if (nwkHdr.GetOption() == RitNwkHeader::OPTION_ROUTE_REPORT &&
+            routeHdr.GetNAddresses() >= 2)
+        {
+            m_downlinkParents[routeHdr.GetAddress(0)] = routeHdr.GetAddress(1);
+        }
+        else if (nwkHdr.GetOption() == RitNwkHeader::OPTION_SOURCE_ROUTE)
+        {
+            RitTimestampTag timestamp;
+            const Time latency = p->PeekPacketTag(timestamp)
+                                     ? Simulator::Now() - timestamp.Get()
+                                     : Time();
+            m_nwkDownlinkRxTrace(p, latency, routeHdr.GetNAddresses() + 1);
+        }
+
         if (m_nwkRxCallback.IsNull())
         {
             NS_LOG_DEBUG("Packet is for me but no RX callback is set; dropping.");
@@ -123,8 +751,40 @@ RitSimpleRouting::McpsDataIndication(McpsDataIndicationParams params, Ptr<Packet
         return;
     }
 
+    // Case 2: Downlink relay: on to the next address of the source route.
+    if (nwkHdr.GetOption() == RitNwkHeader::OPTION_SOURCE_ROUTE)
+    {
+        const uint8_t index = routeHdr.GetIndex();
+        if (index >= routeHdr.GetNAddresses() || routeHdr.GetAddress(index) != m_shortAddr)
+        {
+            NS_LOG_DEBUG("Dropping downlink packet (not the next relay of its route).");
+            m_nwkRxDropTrace(p);
+            return;
+        }
+        routeHdr.SetIndex(index + 1);
+        const Mac16Address nextHop = index + 1 < routeHdr.GetNAddresses()
+                                         ? routeHdr.GetAddress(index + 1)
+                                         : nwkHdr.GetDstAddr();
+        NS_LOG_DEBUG("Relaying downlink packet to " << nextHop);
+        m_nwkRxTrace(p);
+        if (m_duplicateDetection)
+        {
+            p->AddHeader(seqHdr);
+        }
+        p->AddHeader(routeHdr);
+        RitTxQueueClass txClass;
+        txClass.priority = nwkHdr.GetPriority();
+        txClass.origin = nwkHdr.GetSrcAddr();
+        SendNewRequest(p,
+                       nwkHdr.GetDstAddr(),
+                       txClass,
+                       RitNwkHeader::OPTION_SOURCE_ROUTE,
+                       nextHop);
+        return;
+    }
+
     /*
-     * Case 2: Forwarding (simplified).
+     * Case 3: Forwarding (simplified).
      * NOTE [EXPERIMENTAL]:
      * Current behavior: forward only if the packet rank is higher than my rank.
      * This is used as a simplified tree-based uplink forwarding rule.
@@ -139,7 +799,20 @@ RitSimpleRouting::McpsDataIndication(McpsDataIndicationParams params, Ptr<Packet
         // IMPORTANT: Keep forwarding behavior unchanged.
         // (Even if a "parent" address is conceptually expected, the current logic forwards to
         //  nwkHdr.GetDstAddr() via SendRequest, as implemented originally.)
-        SendRequest(p, nwkHdr.GetDstAddr());
+        // The priority class travels with the packet; the origin is the previous hop.
+        RitTxQueueClass txClass;
+        txClass.priority = nwkHdr.GetPriority();
+        txClass.origin = nwkHdr.GetSrcAddr();
+        if (m_duplicateDetection)
+        {
+            p->AddHeader(seqHdr);
+        }
+        if (nwkHdr.GetOption() != RitNwkHeader::OPTION_NONE)
+        {
+            // The route report travels unchanged to the sink.
+            p->AddHeader(routeHdr);
+        }
+        SendNewRequest(p, nwkHdr.GetDstAddr(), txClass, nwkHdr.GetOption());
         return;
     }
 
@@ -154,29 +827,72 @@ RitSimpleRouting::McpsDataConfirm(McpsDataConfirmParams params)
 
     const uint8_t msduHandle = params.m_msduHandle;
 
-    // Resolve NWK handle from MAC handle.
-    auto it = m_msduToNwkHandleMap.find(msduHandle);
-    if (it == m_msduToNwkHandleMap.end())
+    // Resolve NWK handles from MAC handle (several for an aggregated frame).
+    int16_t nwkHandle = m_msduHead[msduHandle];
+    if (nwkHandle < 0)
     {
         NS_LOG_WARN("Unknown msduHandle: " << (uint32_t)msduHandle);
         return;
     }
 
-    const uint8_t nwkHandle = it->second;
+    m_msduHead[msduHandle] = -1;
+    m_nQueuedMsdus--;
+    // A broadcast is not acknowledged: its outcome says nothing of a link.
+    const bool broadcast = m_txTable[nwkHandle].nextHop.IsBroadcast();
+    if (m_lastPeerValid && !broadcast &&
+        (params.m_status == MacStatus::SUCCESS || params.m_status == MacStatus::NO_ACK))
+    {
+        m_neighbours.NotifyTxOutcome(m_lastPeer, params.m_status == MacStatus::SUCCESS);
+    }
+    const bool downlink = m_txTable[nwkHandle].downlink;
+    if (broadcast)
+    {
+        NS_LOG_DEBUG("Broadcast hold over: " << params.m_status);
+    }
+    else if (params.m_status == MacStatus::SUCCESS)
+    {
+        m_consecutiveFailures = 0;
+        if (!downlink && m_lastPeerValid)
+        {
+            m_uplinkPeer = m_lastPeer;
+            m_uplinkPeerValid = true;
+        }
+    }
+    else if (params.m_status == MacStatus::NO_ACK && !downlink)
+    {
+        NotifyLinkFailure();
+    }
+    if ((m_anycastEnabled || m_backpressureEnabled) && GetQueueHeadroom() != m_advertisedHeadroom)
+    {
+        UpdateRitRequestPayload();
+    }
+
+    while (nwkHandle >= 0)
+    {
+        // NwkDataConfirm() unlinks the entry and may release it.
+        const int16_t next = m_txTable[nwkHandle].nextInMsdu;
+        NwkDataConfirm(static_cast<uint8_t>(nwkHandle), params.m_status);
+        nwkHandle = next;
+    }
+}
 
-    auto pktIt = m_handleToPktMap.find(nwkHandle);
-    if (pktIt == m_handleToPktMap.end())
+void
+RitSimpleRouting::NwkDataConfirm(uint8_t nwkHandle, MacStatus status)
+{
+    if (nwkHandle >= m_txTable.size() || !m_txTable[nwkHandle].inUse)
     {
         NS_LOG_WARN("Packet not found for nwkHandle=" << (uint32_t)nwkHandle);
-        m_msduToNwkHandleMap.erase(msduHandle);
         return;
     }
 
-    Ptr<Packet> packet = pktIt->second.first;
-    const Mac16Address dst = pktIt->second.second;
-    const uint8_t retries = m_retryCountMap[nwkHandle];
+    TxEntry& entry = m_txTable[nwkHandle];
+    entry.msduHandle = -1;
+    entry.nextInMsdu = -1;
+    Ptr<Packet> packet = entry.packet;
+    const Mac16Address dst = entry.nextHop;
+    const uint8_t retries = entry.retries;
 
-    switch (params.m_status)
+    switch (status)
     {
     case MacStatus::SUCCESS:
         NS_LOG_DEBUG("Tx SUCCESS: nwkHandle=" << (uint32_t)nwkHandle);
@@ -184,12 +900,12 @@ RitSimpleRouting::McpsDataConfirm(McpsDataConfirmParams params)
         break;
 
     case MacStatus::NO_ACK:
-        NS_LOG_DEBUG("Tx RETRY (" << (uint32_t)retries << "/" << (uint32_t)MAX_RETRIES
+        NS_LOG_DEBUG("Tx RETRY (" << (uint32_t)retries << "/" << (uint32_t)m_maxRetries
                                   << ") nwkHandle=" << (uint32_t)nwkHandle);
 
-        if (retries < MAX_RETRIES)
+        if (retries < m_maxRetries)
         {
-            m_retryCountMap[nwkHandle] = retries + 1;
+            entry.retries = retries + 1;
 
             // Keep behavior: remove header before re-adding it in SendRequest().
             RitNwkHeader nwkHdr;
@@ -197,24 +913,16 @@ RitSimpleRouting::McpsDataConfirm(McpsDataConfirmParams params)
 
             m_nwkReTxTrace(packet);
 
-            /*
-             * NOTE [EXPERIMENTAL]:
-             * Retransmission delay is randomized with a fixed range (0..5 seconds),
-             * kept intentionally simple for evaluation.
-             */
-            const Time delay = Seconds(m_reTxDelay->GetValue(0, 5));
-
-            Simulator::Schedule(
-                delay,
-                static_cast<void (RitSimpleRouting::*)(Ptr<Packet>, Mac16Address, uint8_t)>(
-                    &RitSimpleRouting::SendRequest),
-                this,
-                packet,
-                dst,
-                nwkHandle);
-
-            // Keep original cleanup behavior.
-            m_msduToNwkHandleMap.erase(msduHandle);
+            const Time delay = GetRetryDelay();
+            m_nwkReTxBackoffTrace(packet, static_cast<uint8_t>(retries + 1), delay);
+
+            Simulator::Schedule(delay,
+                                &RitSimpleRouting::RetrySendRequest,
+                                this,
+                                packet,
+                                dst,
+                                nwkHandle);
+            LrWpanEventProfiler::RecordScheduled(PROFILE_RETRY);
             return;
         }
 
@@ -227,15 +935,12 @@ RitSimpleRouting::McpsDataConfirm(McpsDataConfirmParams params)
         // fallthrough
 
     default:
-        NS_LOG_DEBUG("Tx FAILED with status=" << params.m_status);
+        NS_LOG_DEBUG("Tx FAILED with status=" << status);
         m_nwkTxDropTrace(packet);
         break;
     }
 
-    // Cleanup (keep behavior unchanged).
-    m_handleToPktMap.erase(nwkHandle);
-    m_retryCountMap.erase(nwkHandle);
-    m_msduToNwkHandleMap.erase(msduHandle);
+    ReleaseTxEntry(nwkHandle);
 }
 
 void
@@ -247,16 +952,118 @@ RitSimpleRouting::MlmeRitRequestIndication(MlmeRitRequestIndicationParams params
         Create<Packet>(params.m_ritRequestPayload.data(), params.m_ritRequestPayload.size());
 
     RitNwkHeader nwkHdr;
-    ritPayload->PeekHeader(nwkHdr);
+    ritPayload->RemoveHeader(nwkHdr);
+    if (nwkHdr.IsSrcAddrElided())
+    {
+        nwkHdr.SetSrcAddr(params.m_srcAddr);
+    }
+
+    RitNeighbour* neighbour = m_neighbours.NotifyBeacon(params.m_srcAddr,
+                                                        nwkHdr.GetRank(),
+                                                        params.m_linkQuality,
+                                                        Simulator::Now());
+
+    // After the NWK header: the queue headroom (AnycastEnabled, BackpressureEnabled),
+    // then the residual energy level (EnergyBalancingEnabled).
+    uint8_t extra[2] = {0, 0};
+    const uint32_t nExtra = ritPayload->CopyData(extra, sizeof(extra));
+    uint32_t nHeadroom = nExtra;
+    uint8_t energy = UINT8_MAX;
+    if (m_energyBalancing && nExtra >= 1)
+    {
+        energy = extra[nExtra - 1];
+        nHeadroom--;
+        if (neighbour)
+        {
+            neighbour->energy = energy;
+        }
+    }
+    // A beacon without the headroom byte does not restrict the choice.
+    const bool headroomAdvertised = nHeadroom >= 1;
+    const uint8_t headroom = headroomAdvertised ? extra[0] : 0;
+
+    if (m_bootstrapping)
+    {
+        // The parent is chosen from the table at the end of the listen period.
+        return;
+    }
+
+    uint8_t headMsdu;
+    const bool headKnown = m_mac->GetTxQueueHeadHandle(headMsdu) && m_msduHead[headMsdu] >= 0;
+
+    // Broadcast: the head-of-line frame answers every neighbour, each once (MAC).
+    if (headKnown && m_txTable[m_msduHead[headMsdu]].nextHop.IsBroadcast())
+    {
+        NS_LOG_DEBUG("Answering the RIT request of " << params.m_srcAddr << " with a broadcast");
+        Simulator::ScheduleNow(&RitWpanMac::SendRitData, m_mac);
+        return;
+    }
+
+    // Downlink: the head-of-line frame waits for the beacon of its next hop.
+    if (headKnown && m_txTable[m_msduHead[headMsdu]].downlink)
+    {
+        const Mac16Address downHop = m_txTable[m_msduHead[headMsdu]].downHop;
+        if (params.m_srcAddr != downHop)
+        {
+            NS_LOG_DEBUG("RIT request ignored (downlink frame for " << downHop << ")");
+            return;
+        }
+        NS_LOG_DEBUG("Processing RIT request from downlink next hop " << downHop);
+        m_lastPeer = params.m_srcAddr;
+        m_lastPeerValid = true;
+        m_backpressureSkipped = false;
+        Simulator::ScheduleNow(&RitWpanMac::SendRitData, m_mac);
+        return;
+    }
 
     /*
      * NOTE [EXPERIMENTAL]:
      * This is a simplified policy to trigger MAC transmission upon receiving a
      * RIT request from a lower-rank node.
      */
-    if (nwkHdr.GetRank() + 1 == m_rank)
+    bool eligible = IsEligibleRank(nwkHdr.GetRank());
+    if (m_anycastEnabled)
+    {
+        // Anycast: any lower-rank neighbour that can still queue our frame.
+        eligible = eligible && (!headroomAdvertised || headroom >= m_anycastMinHeadroom);
+        NS_LOG_DEBUG("RIT request from rank " << nwkHdr.GetRank()
+                                              << " with headroom " << (uint32_t)headroom);
+    }
+
+    if (eligible && neighbour && m_maxParentEtx > 0.0 && neighbour->GetEtx() > m_maxParentEtx)
+    {
+        NS_LOG_DEBUG("RIT request ignored (ETX " << neighbour->GetEtx() << ")");
+        return;
+    }
+
+    // Backpressure: the frame waits here rather than at a full next hop.
+    if (eligible && m_backpressureEnabled && headroomAdvertised &&
+        headroom < m_backpressureMinHeadroom)
+    {
+        NS_LOG_DEBUG("RIT request ignored (headroom " << +headroom << ")");
+        m_backpressureSkipped = true;
+        m_nwkBackpressureTrace(params.m_srcAddr, headroom);
+        return;
+    }
+
+    // Energy balancing: the eligible next hops share the traffic by residual energy.
+    if (eligible && m_energyBalancing && !AcceptByEnergy(energy))
+    {
+        NS_LOG_DEBUG("RIT request ignored (energy level " << +energy << ")");
+        m_backpressureSkipped = true;
+        return;
+    }
+
+    if (eligible)
     {
         NS_LOG_DEBUG("Processing RIT request from lower rank: " << nwkHdr.GetRank());
+        if (neighbour)
+        {
+            neighbour->answered = true;
+        }
+        m_lastPeer = params.m_srcAddr;
+        m_lastPeerValid = true;
+        m_backpressureSkipped = false;
         Simulator::ScheduleNow(&RitWpanMac::SendRitData, m_mac);
     }
     else
@@ -265,13 +1072,340 @@ RitSimpleRouting::MlmeRitRequestIndication(MlmeRitRequestIndicationParams params
     }
 }
 
-// New transmission request (allocate NWK handle internally).
 void
+RitSimpleRouting::RetrySendRequest(Ptr<Packet> packet, Mac16Address dst, uint8_t nwkHandle)
+{
+    LrWpanEventProfiler::Scope profile(PROFILE_RETRY);
+    SendRequest(packet, dst, nwkHandle);
+}
+
+Time
+RitSimpleRouting::GetRetryDelay() const
+{
+    if (m_retryPolicy == RIT_RETRY_RANDOM)
+    {
+        /*
+         * NOTE [EXPERIMENTAL]:
+         * Retransmission delay is randomized with a fixed range, kept intentionally
+         * simple for evaluation.
+         */
+        return Seconds(m_reTxDelay->GetValue(0, m_retryMaxDelay.GetSeconds()));
+    }
+
+    // Earliest learned beacon among the parents, the failed one included.
+    bool predicted = false;
+    Time earliest;
+    for (const RitNeighbour& peer : m_neighbours.GetEntries())
+    {
+        if (!peer.answered || (m_maxParentEtx > 0.0 && peer.GetEtx() > m_maxParentEtx))
+        {
+            continue;
+        }
+        Time wakeDelay;
+        Time window;
+        if (m_mac->PredictBeacon(peer.addr, wakeDelay, window) &&
+            (!predicted || wakeDelay < earliest))
+        {
+            earliest = wakeDelay;
+            predicted = true;
+        }
+    }
+    if (predicted)
+    {
+        return earliest;
+    }
+
+    // The failed exchange closely followed the beacon of the parent: listen from about
+    // one DWD before its next beacon.
+    const Time delay = m_mac->GetRitPeriodTime() - m_mac->GetRitDataWaitDurationTime() * 2;
+    return delay.IsStrictlyPositive() ? delay : Time();
+}
+
+// New transmission request (allocate NWK handle internally).
+bool
 RitSimpleRouting::SendRequest(Ptr<Packet> packet, Mac16Address dst)
 {
-    const uint8_t nwkHandle = m_nwkHandle.GetValue();
-    m_retryCountMap[nwkHandle] = 0;
+    RitTxQueueClass txClass;
+    txClass.origin = m_shortAddr;
+    SocketPriorityTag priorityTag;
+    if (packet->PeekPacketTag(priorityTag))
+    {
+        txClass.priority = std::min(priorityTag.GetPriority(), RitNwkHeader::MAX_PRIORITY);
+    }
+
+    if (dst.IsBroadcast())
+    {
+        return SendBroadcast(packet, txClass);
+    }
+    // Under the route headers, so that the relays and the NWK retries keep it.
+    if (m_duplicateDetection)
+    {
+        RitBroadcastHeader seqHdr;
+        seqHdr.SetOrigin(m_shortAddr);
+        seqHdr.SetSequence(m_unicastSeq++);
+        packet->AddHeader(seqHdr);
+    }
+    if (!m_downlinkEnabled)
+    {
+        return SendNewRequest(packet, dst, txClass);
+    }
+    if (m_rank == 0)
+    {
+        return SendDownlink(packet, dst, txClass);
+    }
+
+    // Uplink: piggyback the parent when it changed or the report is due.
+    Mac16Address parent = m_uplinkPeerValid ? m_uplinkPeer : m_parent;
+    if (parent.IsBroadcast() || (m_reportValid && parent == m_reportedParent &&
+                                 Simulator::Now() - m_reportTime < m_routeReportInterval))
+    {
+        return SendNewRequest(packet, dst, txClass);
+    }
+    RitRouteHeader report;
+    report.AddAddress(m_shortAddr);
+    report.AddAddress(parent);
+    packet->AddHeader(report);
+    m_reportedParent = parent;
+    m_reportTime = Simulator::Now();
+    m_reportValid = true;
+    return SendNewRequest(packet, dst, txClass, RitNwkHeader::OPTION_ROUTE_REPORT);
+}
+
+bool
+RitSimpleRouting::SendBroadcast(Ptr<Packet> packet, const RitTxQueueClass& txClass)
+{
+    NS_LOG_FUNCTION(this << packet);
+
+    RitBroadcastHeader bcastHdr;
+    bcastHdr.SetOrigin(m_shortAddr);
+    bcastHdr.SetSequence(m_broadcastSeq++);
+    // The own broadcast comes back from the neighbours that forward it.
+    CacheBroadcast(m_shortAddr, bcastHdr.GetSequence());
+    packet->AddHeader(bcastHdr);
+    m_nwkBroadcastTxTrace(packet, m_shortAddr, bcastHdr.GetSequence(), 0);
+    return SendNewRequest(packet, Mac16Address::GetBroadcast(), txClass);
+}
+
+void
+RitSimpleRouting::ReceiveBroadcast(Ptr<Packet> p, const RitNwkHeader& nwkHdr)
+{
+    RitBroadcastHeader bcastHdr;
+    p->RemoveHeader(bcastHdr);
+    const Mac16Address origin = bcastHdr.GetOrigin();
+    const uint16_t seq = bcastHdr.GetSequence();
+    const uint32_t key = (static_cast<uint32_t>(origin.ConvertToInt()) << 16) | seq;
+
+    if (!CacheBroadcast(origin, seq))
+    {
+        // A copy received while the forward waits counts toward its suppression.
+        auto it = m_pendingBroadcasts.find(key);
+        if (it != m_pendingBroadcasts.end() && it->second.heard < UINT8_MAX)
+        {
+            it->second.heard++;
+        }
+        NS_LOG_DEBUG("Duplicate broadcast " << origin << "/" << seq << " from "
+                                            << nwkHdr.GetSrcAddr());
+        return;
+    }
+
+    bcastHdr.SetHops(static_cast<uint8_t>(std::min<uint32_t>(bcastHdr.GetHops() + 1, 255)));
+    RitTimestampTag timestamp;
+    const Time latency =
+        p->PeekPacketTag(timestamp) ? Simulator::Now() - timestamp.Get() : Time();
+    NS_LOG_DEBUG("Broadcast " << origin << "/" << seq << " received after "
+                              << (uint32_t)bcastHdr.GetHops() << " hop(s)");
+    m_nwkBroadcastRxTrace(p, origin, seq, bcastHdr.GetHops(), latency);
+
+    // Trickle: forward at a random time of the second half of the interval.
+    const Time interval = GetBroadcastInterval();
+    PendingBroadcast& pending = m_pendingBroadcasts[key];
+    pending.packet = p->Copy();
+    pending.header = bcastHdr;
+    pending.txClass.priority = nwkHdr.GetPriority();
+    pending.txClass.origin = nwkHdr.GetSrcAddr();
+    pending.heard = 0;
+    pending.forwardEvent =
+        Simulator::Schedule(Seconds(m_reTxDelay->GetValue(interval.GetSeconds() / 2,
+                                                          interval.GetSeconds())),
+                            &RitSimpleRouting::ForwardBroadcast,
+                            this,
+                            key);
+
+    if (m_nwkRxCallback.IsNull())
+    {
+        NS_LOG_DEBUG("Broadcast received but no RX callback is set.");
+        return;
+    }
+    m_nwkRxTrace(p);
+    m_nwkRxCallback(p, origin);
+}
+
+void
+RitSimpleRouting::ForwardBroadcast(uint32_t key)
+{
+    auto it = m_pendingBroadcasts.find(key);
+    if (it == m_pendingBroadcasts.end())
+    {
+        return;
+    }
+    PendingBroadcast pending = std::move(it->second);
+    m_pendingBroadcasts.erase(it);
+
+    const Mac16Address origin = pending.header.GetOrigin();
+    const uint16_t seq = pending.header.GetSequence();
+    if (m_broadcastRedundancy > 0 && pending.heard >= m_broadcastRedundancy)
+    {
+        NS_LOG_DEBUG("Broadcast " << origin << "/" << seq << " suppressed ("
+                                  << (uint32_t)pending.heard << " copies)");
+        m_nwkBroadcastSuppressTrace(origin, seq, pending.heard);
+        return;
+    }
+    pending.packet->AddHeader(pending.header);
+    m_nwkBroadcastTxTrace(pending.packet, origin, seq, pending.header.GetHops());
+    SendNewRequest(pending.packet, Mac16Address::GetBroadcast(), pending.txClass);
+}
+
+bool
+RitSimpleRouting::CacheBroadcast(Mac16Address origin, uint16_t seq)
+{
+    auto [it, inserted] = m_broadcastSeen.try_emplace(origin);
+    BroadcastSeen& seen = it->second;
+    if (inserted)
+    {
+        seen.last = seq;
+        seen.window = 1;
+        return true;
+    }
+
+    // Serial number arithmetic: newer if less than half the sequence space ahead.
+    const int32_t ahead = static_cast<int16_t>(static_cast<uint16_t>(seq - seen.last));
+    if (ahead > 0)
+    {
+        seen.window = ahead < 32 ? (seen.window << ahead) | 1 : 1;
+        seen.last = seq;
+        return true;
+    }
+    // Older than the window: taken as a duplicate.
+    if (-ahead >= 32)
+    {
+        return false;
+    }
+    const uint32_t bit = 1U << -ahead;
+    if (seen.window & bit)
+    {
+        return false;
+    }
+    seen.window |= bit;
+    return true;
+}
+
+Time
+RitSimpleRouting::GetBroadcastInterval() const
+{
+    if (m_broadcastInterval.IsStrictlyPositive())
+    {
+        return m_broadcastInterval;
+    }
+    // Every neighbour beacons, hence may deliver its copy, within one period.
+    return m_mac->GetRitPeriodTime() * 2;
+}
+
+bool
+RitSimpleRouting::SendDownlink(Ptr<Packet> packet,
+                               Mac16Address dst,
+                               const RitTxQueueClass& txClass)
+{
+    NS_LOG_FUNCTION(this << packet << dst);
+
+    // Walk the reported parents from the destination up to this node.
+    std::vector<Mac16Address> relays;
+    Mac16Address node = dst;
+    while (true)
+    {
+        auto it = m_downlinkParents.find(node);
+        if (it == m_downlinkParents.end() || relays.size() >= RitRouteHeader::MAX_ADDRESSES)
+        {
+            NS_LOG_DEBUG("No downlink route to " << dst << "; dropping packet.");
+            m_nwkTxDropTrace(packet);
+            return false;
+        }
+        if (it->second == m_shortAddr)
+        {
+            break;
+        }
+        relays.push_back(it->second);
+        node = it->second;
+    }
+
+    RitRouteHeader route;
+    for (auto it = relays.rbegin(); it != relays.rend(); ++it)
+    {
+        route.AddAddress(*it);
+    }
+    packet->AddHeader(route);
+    const Mac16Address nextHop = relays.empty() ? dst : relays.back();
+    m_nwkDownlinkTxTrace(packet, dst, static_cast<uint8_t>(relays.size() + 1));
+    return SendNewRequest(packet, dst, txClass, RitNwkHeader::OPTION_SOURCE_ROUTE, nextHop);
+}
+
+bool
+RitSimpleRouting::SendNewRequest(Ptr<Packet> packet,
+                                 Mac16Address dst,
+                                 const RitTxQueueClass& txClass,
+                                 RitNwkHeader::Option option,
+                                 Mac16Address downHop)
+{
+    uint8_t nwkHandle;
+    if (!AllocateTxEntry(nwkHandle))
+    {
+        NS_LOG_DEBUG("Transmit table full (" << m_txTable.size() << " slots); dropping packet.");
+        m_nwkTxDropTrace(packet);
+        return false;
+    }
+
+    TxEntry& entry = m_txTable[nwkHandle];
+    entry.txClass = txClass;
+    entry.enqueueTime = Simulator::Now();
+    entry.option = option;
+    entry.downlink = !downHop.IsBroadcast();
+    entry.downHop = downHop;
     SendRequest(packet, dst, nwkHandle);
+    return true;
+}
+
+bool
+RitSimpleRouting::AllocateTxEntry(uint8_t& nwkHandle)
+{
+    if (m_txTable.empty())
+    {
+        // Sized at the first packet, once the attributes are set.
+        m_txTable.resize(m_txTableSize);
+        m_freeTxSlots.reserve(m_txTableSize);
+        for (uint32_t i = m_txTableSize; i > 0; i--)
+        {
+            m_freeTxSlots.push_back(static_cast<uint8_t>(i - 1));
+        }
+    }
+    if (m_freeTxSlots.empty())
+    {
+        return false;
+    }
+
+    nwkHandle = m_freeTxSlots.back();
+    m_freeTxSlots.pop_back();
+    m_txTable[nwkHandle] = TxEntry();
+    m_txTable[nwkHandle].inUse = true;
+    m_txTableOccupancy = m_txTableOccupancy + 1;
+    return true;
+}
+
+void
+RitSimpleRouting::ReleaseTxEntry(uint8_t nwkHandle)
+{
+    NS_ASSERT(m_txTable[nwkHandle].inUse && m_txTable[nwkHandle].msduHandle < 0);
+    m_txTable[nwkHandle] = TxEntry();
+    m_freeTxSlots.push_back(nwkHandle);
+    m_txTableOccupancy = m_txTableOccupancy - 1;
 }
 
 // Retransmission / handle-specified request.
@@ -279,7 +1413,122 @@ void
 RitSimpleRouting::SendRequest(Ptr<Packet> packet, Mac16Address dst, uint8_t nwkHandle)
 {
     NS_LOG_FUNCTION(this << packet << dst << (uint32_t)nwkHandle);
+    NS_ASSERT_MSG(nwkHandle < m_txTable.size() && m_txTable[nwkHandle].inUse,
+                  "NWK handle " << (uint32_t)nwkHandle << " not allocated");
+    TxEntry& entry = m_txTable[nwkHandle];
+
+    // Add network header (keep fields unchanged).
+    RitNwkHeader hdr;
+    hdr.SetSrcAddr(m_shortAddr);
+    hdr.SetDstAddr(dst);
+    hdr.SetRank(m_rank);
+    hdr.SetPriority(entry.txClass.priority);
+    hdr.SetOption(entry.option);
+    hdr.SetCompressed(m_headerCompression);
+
+    // Trace and store a copy (keep behavior unchanged).
+    Ptr<Packet> pktCopy;
+    if (m_headerCompression)
+    {
+        // The NWK source is this hop, i.e. the MAC source of the frame: it is elided on
+        // the air, and kept in the copy for the trace sinks that only see the NWK packet.
+        pktCopy = packet->Copy();
+        pktCopy->AddHeader(hdr);
+        hdr.SetSrcAddrElided(true);
+        packet->AddHeader(hdr);
+    }
+    else
+    {
+        packet->AddHeader(hdr);
+        pktCopy = packet->Copy();
+    }
+    m_nwkTxTrace(pktCopy);
+
+    entry.packet = pktCopy;
+    entry.nextHop = dst;
 
+    // A downlink packet goes to its relay; uplink packets go to any eligible beacon.
+    const Mac16Address macDst = entry.downlink ? entry.downHop : dst;
+    if (m_aggregationEnabled)
+    {
+        Aggregate(packet, macDst, nwkHandle);
+        return;
+    }
+    SendMsdu(packet, macDst, {nwkHandle});
+}
+
+void
+RitSimpleRouting::Aggregate(Ptr<Packet> packet, Mac16Address dst, uint8_t nwkHandle)
+{
+    NS_LOG_FUNCTION(this << packet << dst << (uint32_t)nwkHandle);
+
+    AggregationBuffer& buffer = m_aggregationBuffers[dst];
+    const uint32_t size = buffer.bytes + packet->GetSize() +
+                          RitAggregationHeader::GetSizeFor(buffer.packets.size() + 1);
+    if (!buffer.packets.empty() && size > m_aggregationMaxBytes)
+    {
+        FlushAggregate(dst);
+    }
+
+    // Packet tags do not survive Packet::AddAtEnd; the sender timestamp is
+    // carried as a byte tag over the sub-frame instead.
+    RitTimestampTag timestamp;
+    if (packet->PeekPacketTag(timestamp) && !packet->FindFirstMatchingByteTag(timestamp))
+    {
+        packet->AddByteTag(timestamp);
+    }
+
+    buffer.packets.push_back(packet);
+    buffer.nwkHandles.push_back(nwkHandle);
+    buffer.bytes += packet->GetSize();
+    if (!buffer.flushEvent.IsPending())
+    {
+        buffer.flushEvent = Simulator::Schedule(m_aggregationMaxDelay,
+                                                &RitSimpleRouting::FlushAggregate,
+                                                this,
+                                                dst);
+    }
+}
+
+void
+RitSimpleRouting::FlushAggregate(Mac16Address dst)
+{
+    NS_LOG_FUNCTION(this << dst);
+
+    auto it = m_aggregationBuffers.find(dst);
+    if (it == m_aggregationBuffers.end() || it->second.packets.empty())
+    {
+        return;
+    }
+    AggregationBuffer buffer = std::move(it->second);
+    m_aggregationBuffers.erase(it);
+    buffer.flushEvent.Cancel();
+
+    RitAggregationHeader aggHdr;
+    Ptr<Packet> msdu = Create<Packet>();
+    for (const auto& packet : buffer.packets)
+    {
+        aggHdr.AddSubFrame(static_cast<uint8_t>(packet->GetSize()));
+        msdu->AddAtEnd(packet);
+    }
+    msdu->AddHeader(aggHdr);
+
+    NS_LOG_DEBUG("Aggregated " << buffer.packets.size() << " packets into " << msdu->GetSize()
+                               << " bytes toward " << dst);
+    SendMsdu(msdu, dst, buffer.nwkHandles);
+}
+
+void
+RitSimpleRouting::SendMsdu(Ptr<Packet> msdu,
+                           Mac16Address dst,
+                           const std::vector<uint8_t>& nwkHandles)
+{
+    // Next MSDU handle not held by a frame still at the MAC. There are fewer such
+    // frames than table slots, the ones being sent being still unlinked.
+    while (m_msduHead[m_macHandle.GetValue()] >= 0)
+    {
+        m_macHandle++;
+    }
     const uint8_t msduHandle = m_macHandle.GetValue();
     m_macHandle++;
 
@@ -290,22 +1539,47 @@ RitSimpleRouting::SendRequest(Ptr<Packet> packet, Mac16Address dst, uint8_t nwkH
     params.m_msduHandle = msduHandle;
     params.m_txOptions |= TX_OPTION_ACK;
 
-    // Add network header (keep fields unchanged).
-    RitNwkHeader hdr;
-    hdr.SetSrcAddr(m_shortAddr);
-    hdr.SetDstAddr(dst);
-    hdr.SetRank(m_rank);
-    packet->AddHeader(hdr);
+    // Chain the packets of the MSDU. An aggregate takes the highest class of its
+    // packets and the origin of the first.
+    RitTxQueueClass txClass = m_txTable[nwkHandles.front()].txClass;
+    int16_t next = -1;
+    for (auto it = nwkHandles.rbegin(); it != nwkHandles.rend(); ++it)
+    {
+        TxEntry& entry = m_txTable[*it];
+        entry.msduHandle = msduHandle;
+        entry.nextInMsdu = next;
+        next = *it;
+        txClass.priority = std::max(txClass.priority, entry.txClass.priority);
+    }
+    m_msduHead[msduHandle] = next;
+    m_nQueuedMsdus++;
 
-    // Trace and store a copy (keep behavior unchanged).
-    Ptr<Packet> pktCopy = packet->Copy();
-    m_nwkTxTrace(pktCopy);
+    m_mac->NotifyNwkEnqueue(msduHandle);
+    m_mac->NotifyNwkTxClass(msduHandle, txClass);
+    m_mac->McpsDataRequest(params, msdu);
 
-    // Register handle mappings (keep behavior unchanged).
-    m_handleToPktMap[nwkHandle] = std::make_pair(pktCopy, dst);
-    m_msduToNwkHandleMap[msduHandle] = nwkHandle;
+    if ((m_anycastEnabled || m_backpressureEnabled) && GetQueueHeadroom() != m_advertisedHeadroom)
+    {
+        UpdateRitRequestPayload();
+    }
+}
 
-    m_mac->McpsDataRequest(params, packet);
+uint8_t
+RitSimpleRouting::GetQueueHeadroom() const
+{
+    const uint32_t queued = m_nQueuedMsdus;
+    if (queued >= m_anycastQueueCapacity)
+    {
+        return 0;
+    }
+    uint32_t headroom = m_anycastQueueCapacity - queued;
+    const uint32_t macCapacity = m_mac->GetTxQueueCapacity();
+    if (macCapacity > 0)
+    {
+        const uint32_t macQueued = m_mac->GetTxQueueOccupancy();
+        headroom = std::min(headroom, macCapacity > macQueued ? macCapacity - macQueued : 0);
+    }
+    return static_cast<uint8_t>(std::min<uint32_t>(headroom, 255));
 }
 
 void
@@ -320,18 +1594,147 @@ RitSimpleRouting::GetMac() const
     return m_mac;
 }
 
+void
+RitSimpleRouting::AddRadioMac(Ptr<RitWpanMac> mac)
+{
+    NS_LOG_FUNCTION(this << mac);
+    m_radioMacs.push_back(mac);
+    if (m_mac)
+    {
+        UpdateRitRequestPayload();
+    }
+}
+
+int64_t
+RitSimpleRouting::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_reTxDelay->SetStream(stream);
+    m_energyRng->SetStream(stream + 1);
+    return 2;
+}
+
+void
+RitSimpleRouting::SetEnergyModel(Ptr<RitWpanEnergyModel> energyModel)
+{
+    NS_LOG_FUNCTION(this << energyModel);
+    m_energyModel = energyModel;
+}
+
+uint8_t
+RitSimpleRouting::GetEnergyLevel() const
+{
+    if (m_lowEnergy)
+    {
+        return 0;
+    }
+    if (!m_energyModel)
+    {
+        return UINT8_MAX;
+    }
+    return static_cast<uint8_t>(std::lround(m_energyModel->GetRemainingFraction() * UINT8_MAX));
+}
+
+bool
+RitSimpleRouting::IsLowEnergy() const
+{
+    return m_lowEnergy;
+}
+
+void
+RitSimpleRouting::CheckEnergy()
+{
+    NS_LOG_FUNCTION(this);
+    const double residual = m_energyModel->GetRemainingFraction();
+    // The sinks carry every subtree and have no alternative: they keep their cycle.
+    if (!m_lowEnergy && m_rank != 0 && residual < m_lowEnergyThreshold)
+    {
+        NS_LOG_DEBUG("Low-battery mode at a residual share of " << residual);
+        m_lowEnergy = true;
+        if (m_lowEnergyPeriodFactor > 1.0)
+        {
+            Ptr<MacPibAttributes> attribute = Create<MacPibAttributes>();
+            attribute->macRitPeriodTime =
+                Seconds(m_mac->GetRitPeriodTime().GetSeconds() * m_lowEnergyPeriodFactor);
+            m_mac->MlmeSetRequest(macRitPeriodTime, attribute);
+        }
+        m_nwkLowEnergyTrace(residual);
+    }
+    if (m_energyBalancing && GetEnergyLevel() != m_advertisedEnergy)
+    {
+        UpdateRitRequestPayload();
+    }
+    if (!m_energyModel->IsDepleted())
+    {
+        m_energyCheckEvent =
+            Simulator::Schedule(m_energyCheckInterval, &RitSimpleRouting::CheckEnergy, this);
+    }
+}
+
+bool
+RitSimpleRouting::IsEligibleRank(uint16_t rank) const
+{
+    return m_anycastEnabled ? rank < m_rank : rank + m_linkCost == m_rank;
+}
+
+bool
+RitSimpleRouting::AcceptByEnergy(uint8_t level)
+{
+    const Time now = Simulator::Now();
+    uint8_t best = 0;
+    for (const RitNeighbour& peer : m_neighbours.GetEntries())
+    {
+        if (peer.stale || !IsEligibleRank(peer.rank) ||
+            now - peer.lastBeacon > m_neighbourStaleTime ||
+            (m_maxParentEtx > 0.0 && peer.GetEtx() > m_maxParentEtx))
+        {
+            continue;
+        }
+        best = std::max(best, peer.energy);
+    }
+    if (best == 0 || level >= best)
+    {
+        return true;
+    }
+    return m_energyRng->GetValue() * best < level;
+}
+
 void
 RitSimpleRouting::SetRank(uint16_t rank)
 {
     NS_LOG_FUNCTION(this << rank);
     m_rank = rank;
+    UpdateRitRequestPayload();
+}
 
+void
+RitSimpleRouting::UpdateRitRequestPayload()
+{
     // Build and set RIT request payload (keep behavior unchanged).
     RitNwkHeader nwkHeader;
     nwkHeader.SetDstAddr(Mac16Address("FF:FF"));
     nwkHeader.SetRank(m_rank);
+    if (m_headerCompression)
+    {
+        // The beaconing node is the MAC source of the beacon.
+        nwkHeader.SetSrcAddr(m_shortAddr);
+        nwkHeader.SetCompressed(true);
+        nwkHeader.SetSrcAddrElided(true);
+    }
 
     Ptr<Packet> ritRequestPayload = Create<Packet>(0);
+    if (m_anycastEnabled || m_backpressureEnabled)
+    {
+        // One byte of queue headroom after the NWK header.
+        m_advertisedHeadroom = GetQueueHeadroom();
+        ritRequestPayload = Create<Packet>(&m_advertisedHeadroom, 1);
+    }
+    if (m_energyBalancing)
+    {
+        // The residual energy level in the last byte.
+        m_advertisedEnergy = GetEnergyLevel();
+        ritRequestPayload->AddAtEnd(Create<Packet>(&m_advertisedEnergy, 1));
+    }
     ritRequestPayload->AddHeader(nwkHeader);
 
     std::vector<uint8_t> payload(ritRequestPayload->GetSize());
@@ -342,6 +1745,10 @@ RitSimpleRouting::SetRank(uint16_t rank)
     attribute->macRitRequestPayload = payload;
 
     m_mac->MlmeSetRequest(id, attribute);
+    for (const auto& mac : m_radioMacs)
+    {
+        mac->MlmeSetRequest(id, attribute);
+    }
 }
 
 uint16_t
@@ -350,6 +1757,12 @@ RitSimpleRouting::GetRank() const
     return m_rank;
 }
 
+Mac16Address
+RitSimpleRouting::GetAnySinkAddress()
+{
+    return Mac16Address(RitNwkHeader::ANY_SINK_ADDR);
+}
+
 void
 RitSimpleRouting::SetShortAddress(Mac16Address addr)
 {
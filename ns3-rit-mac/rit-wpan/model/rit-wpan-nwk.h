@@ -10,19 +10,53 @@
 #ifndef RIT_WPAN_NWK_H
 #define RIT_WPAN_NWK_H
 
+#include "rit-broadcast-header.h"
+#include "rit-duplicate-cache.h"
+#include "rit-neighbour-table.h"
+#include "rit-wpan-energy-model.h"
 #include "rit-wpan-mac.h"
+#include "rit-wpan-nwk-header.h"
 
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
 #include "ns3/object.h"
 #include "ns3/random-variable-stream.h"
+#include "ns3/traced-value.h"
 
+#include <array>
 #include <cstdint>
 #include <map>
+#include <memory_resource>
+#include <vector>
 
 namespace ns3
 {
 namespace lrwpan
 {
 
+/**
+ * \brief When a NWK packet is sent again after a NO_ACK (MaxRetries)
+ */
+enum RitRetryPolicy
+{
+    RIT_RETRY_RANDOM,     //!< After a uniform delay in [0, RetryMaxDelay]
+    RIT_RETRY_RENDEZVOUS, //!< Shortly before the next predicted beacon of a parent
+};
+
+/**
+ * \brief Warm-up state of a RitSimpleRouting, saved by a checkpoint
+ *
+ * Times are relative to the checkpoint. Packets in the transmit table and in
+ * the aggregation buffers are not part of it.
+ */
+struct RitNwkCheckpoint
+{
+    uint16_t rank{RitNwkHeader::MAX_RANK}; //!< Rank of the node
+    Mac16Address parent;                   //!< Parent, broadcast if none
+    std::vector<RitNeighbour> neighbours;  //!< Neighbour table, lastBeacon holding the age
+    std::map<Mac16Address, Mac16Address> downlinkParents; //!< Reported parents (sink)
+};
+
 /**
  * \brief Simplified rank-based routing layer for RIT-WPAN evaluation
  *
@@ -32,8 +66,101 @@ namespace lrwpan
  * Packet forwarding decisions are made solely based on node rank,
  * assuming a static tree topology rooted at a designated parent.
  *
+ * With AggregationEnabled, packets toward the same destination are held for
+ * up to AggregationMaxDelay and sent as one MAC data frame carrying a
+ * RitAggregationHeader, up to AggregationMaxBytes of MSDU. The setting must
+ * be the same on every node, since the receiver always expects the header.
+ *
+ * With AnycastEnabled, the RIT request payload also advertises the queue
+ * headroom of the beaconing node, and a sender takes the first beacon of any
+ * neighbour with a lower rank and at least AnycastMinHeadroom free frames
+ * (instead of rank - 1 neighbours only). This setting must also be the same
+ * on every node.
+ *
+ * With BackpressureEnabled, the RIT request payload carries the same headroom
+ * byte, and a sender leaves unanswered the beacon of a next hop advertising
+ * fewer than BackpressureMinHeadroom free frames: the frame stays in its own
+ * queue instead of being dropped or stalled at a full parent, and a sender
+ * cycle that met only such beacons is not a link failure. With anycast, the
+ * beacon of another lower-rank neighbour takes the frame. This setting must
+ * also be the same on every node.
+ *
+ * The priority class of a local packet is taken from its SocketPriorityTag
+ * (0 to RitNwkHeader::MAX_PRIORITY) and carried in the RitNwkHeader, so that
+ * relays keep it. Each MSDU is handed to the MAC with its class and origin
+ * (the previous hop of a forwarded packet) for the TX queue discipline.
+ *
+ * A packet whose frame was not acknowledged is sent again up to MaxRetries
+ * times. With the Rendezvous RetryPolicy, it is handed back to the MAC shortly
+ * before the earliest predicted beacon of the neighbours whose beacons were
+ * answered so far (the failed parent or, with AnycastEnabled, another one).
+ * Without a learned phase, the next beacon of the failed parent is assumed
+ * one RIT period after the failed exchange. NwkReTxBackoff reports the
+ * attempt number and the delay of each retry.
+ *
+ * Outstanding packets live in a transmit table of TxTableSize slots, the slot
+ * index being the NWK handle. A new packet finds no slot when the table is
+ * full: it is dropped (NwkTxDrop) and SendRequest() returns false, which the
+ * device passes to the application.
+ *
+ * Every beacon indicated by the MAC updates a neighbour table of at most
+ * NeighbourTableSize entries (rank, LQI average, beacon interval) and every
+ * data confirm updates the delivery ratio, hence the ETX, of the neighbour the
+ * frame answered. Rendezvous retries consider the answered neighbours whose
+ * ETX is within MaxParentEtx.
+ *
+ * Bootstrap() replaces a static rank: the MAC listens for BootstrapDuration in
+ * BOOTSTRAP_MODE and the node takes rank = best parent rank + LinkCost among
+ * the table entries with an LQI average of at least MinParentLqi (lowest rank
+ * first, then lowest ETX). The parent is never evicted from the table. Without
+ * any parent the node listens again. NwkBootstrap reports the rank, the parent
+ * and the time since Bootstrap() was called.
+ *
+ * With LocalRepair, RepairThreshold consecutive failures (NO_ACK confirms or
+ * sender cycles ended by the TWD timeout, whichever neighbour answered) mark
+ * the parent stale and the node switches to the best other table entry of rank
+ * at most its own, taking that rank + LinkCost. Its beacons are answered from
+ * the next sender cycle, within one RIT period. Without such an entry the node
+ * bootstraps again. NwkRepair reports each switch.
+ *
+ * With DownlinkEnabled, uplink packets piggyback a route report (the origin
+ * and the neighbour that last acknowledged its uplink traffic, or its parent)
+ * when that parent changes or every RouteReportInterval. The sink (rank 0)
+ * keeps the reported parents and sends its own packets with a source route
+ * (RitRouteHeader) built from them; a packet without a route is dropped. A
+ * downlink frame at the head of the MAC queue answers only the beacon of its
+ * next relay, whatever its rank. NwkDownlinkTx / NwkDownlinkRx report the
+ * hops and the end-to-end latency of these packets.
+ *
+ * Several nodes may have rank 0. Each router then sends toward the nearest of
+ * these sinks by rank, and a packet addressed to GetAnySinkAddress() is
+ * delivered by the sink it reaches; a sink learns the downlink routes of the
+ * routers whose reports reach it.
+ *
+ * With EnergyBalancingEnabled, the RIT request payload ends with the residual
+ * energy of the beaconing node (0 to 255 of its battery, 255 without one),
+ * refreshed every EnergyCheckInterval. A sender answers the beacon of an
+ * eligible next hop with the probability of its level over the best level among
+ * the eligible neighbours heard within NeighbourStaleTime, so that the traffic
+ * of a subtree is spread over its equal-rank parents by their residual energy;
+ * the beacons left unanswered are not link failures. A relay whose residual
+ * share falls below LowEnergyThreshold enters a low-battery mode for good: it
+ * advertises level 0, so that its children leave it whenever another parent
+ * remains, and multiplies its RIT period by LowEnergyPeriodFactor. NwkLowEnergy
+ * reports the switch. This setting must also be the same on every node.
+ *
+ * A packet sent to the broadcast address is a network-wide broadcast: it
+ * carries a RitBroadcastHeader (origin, sequence number, hops), and its frame
+ * answers the first beacon of every neighbour during the hold of the MAC
+ * (BroadcastHoldTime), whatever their rank. A per-origin sequence cache drops
+ * the copies already received. A new broadcast is delivered, then forwarded
+ * at a random time in [I/2, I) of BroadcastInterval I, unless
+ * BroadcastRedundancy copies were received meanwhile (Trickle suppression).
+ * NwkBroadcastTx / NwkBroadcastRx / NwkBroadcastSuppress report the
+ * transmissions, the first receptions and the suppressed forwards.
+ *
  * NOTE:
- *  - No route discovery or maintenance is implemented.
+ *  - No route maintenance is implemented; the rank is kept after bootstrap.
  *  - This class is tightly coupled with the evaluation scenarios.
  */
 class RitSimpleRouting : public Object
@@ -53,14 +180,66 @@ class RitSimpleRouting : public Object
     ~RitSimpleRouting() override;
 
     /**
-     * \brief Bootstrap procedure (not implemented)
+     * Rank of a node that has not found a parent yet. Its beacons are never
+     * taken as a parent.
+     */
+    static constexpr uint16_t RANK_UNKNOWN = RitNwkHeader::MAX_RANK;
+
+    /**
+     * \brief Get the destination standing for any sink
      *
-     * NOTE [NOT IMPLEMENTED / OUT OF SCOPE]:
-     * Dynamic bootstrap logic is intentionally omitted in this
-     * simplified evaluation-oriented implementation.
+     * A packet sent to this address is delivered by the first rank-0 node it
+     * reaches; the rank rule takes it to the nearest sink.
+     * \return The reserved short address 0xFFFD
+     */
+    static Mac16Address GetAnySinkAddress();
+
+    /**
+     * \brief Discover the rank and the parent from the neighbour beacons
+     *
+     * The rank is RANK_UNKNOWN until a parent is found.
      */
     void Bootstrap();
 
+    /**
+     * \brief Handle the end of a bootstrap listen period from MAC
+     */
+    void MlmeBootstrapConfirm();
+
+    /**
+     * \brief Handle a sender cycle ended without any RIT request from MAC
+     */
+    void MlmeRitTxWaitTimeout();
+
+    /**
+     * \brief Get the parent chosen by Bootstrap()
+     * \return Short address of the parent, or the broadcast address if none
+     */
+    Mac16Address GetParent() const;
+
+    /**
+     * \brief Get the neighbour table
+     * \return The neighbours heard through their beacons
+     */
+    const RitNeighbourTable& GetNeighbourTable() const;
+
+    /**
+     * \brief Get the warm-up state of the routing layer
+     * \return The state, times relative to now
+     */
+    RitNwkCheckpoint GetCheckpoint() const;
+
+    /**
+     * \brief Continue from a saved warm-up state
+     *
+     * Sets the rank, the parent, the neighbour table and the reported parents,
+     * and ends a bootstrap in progress. Call it before the simulation starts,
+     * in place of Bootstrap().
+     *
+     * \param checkpoint The state
+     */
+    void RestoreCheckpoint(const RitNwkCheckpoint& checkpoint);
+
     /**
      * \brief Handle incoming RIT request indication from MAC
      *
@@ -80,6 +259,41 @@ class RitSimpleRouting : public Object
      */
     Ptr<RitWpanMac> GetMac() const;
 
+    /**
+     * \brief Add a further MAC of a multi-radio gateway. It beacons the RIT request
+     *        payload of the MAC of SetMac(), which keeps every transmission; the gateway
+     *        device hands its data indications over.
+     * \param mac Pointer to RitWpanMac
+     */
+    void AddRadioMac(Ptr<RitWpanMac> mac);
+
+    /**
+     * \brief Set the energy model giving the residual energy of the node
+     *        (EnergyBalancingEnabled, LowEnergyThreshold)
+     * \param energyModel Energy model of the device, null for none
+     */
+    void SetEnergyModel(Ptr<RitWpanEnergyModel> energyModel);
+
+    /**
+     * \brief Get the residual energy level advertised in the RIT request payload
+     * \return 0 to 255 of the battery, 255 without one, 0 in the low-battery mode
+     */
+    uint8_t GetEnergyLevel() const;
+
+    /**
+     * \brief Get whether the node entered the low-battery mode (LowEnergyThreshold)
+     * \return true once its residual share fell below the threshold
+     */
+    bool IsLowEnergy() const;
+
+    /**
+     * \brief Assign fixed random variable streams to the retry delay and the energy
+     *        balancing draws
+     * \param stream First stream index to use
+     * \return The number of stream indices assigned (2)
+     */
+    int64_t AssignStreams(int64_t stream);
+
     /**
      * \brief Set the rank of this node
      * \param rank Rank value
@@ -105,15 +319,16 @@ class RitSimpleRouting : public Object
      *
      * \param packet Packet to send
      * \param dst Destination MAC address
+     * \return false if the transmit table is full; the packet is dropped
      */
-    void SendRequest(Ptr<Packet> packet, Mac16Address dst);
+    bool SendRequest(Ptr<Packet> packet, Mac16Address dst);
 
     /**
      * \brief Send or re-send a packet with a specified network handle
      *
      * \param packet Packet to send
      * \param dst Destination MAC address
-     * \param nwkHandle Network-layer handle
+     * \param nwkHandle Network-layer handle, allocated in the transmit table
      */
     void SendRequest(Ptr<Packet> packet, Mac16Address dst, uint8_t nwkHandle);
 
@@ -143,7 +358,362 @@ class RitSimpleRouting : public Object
      */
     void SetNwkRxCallback(NwkRxCallback cb);
 
+    /**
+     * TracedCallback signature for the scheduling of a retransmission.
+     *
+     * \param [in] packet The packet, without its RitNwkHeader
+     * \param [in] attempt Retransmission number, from 1
+     * \param [in] delay Delay before the packet is handed to the MAC again
+     */
+    typedef void (*ReTxBackoffTracedCallback)(Ptr<const Packet> packet,
+                                              uint8_t attempt,
+                                              Time delay);
+
+    /**
+     * TracedCallback signature for the end of the bootstrap.
+     *
+     * \param [in] rank Rank taken by the node
+     * \param [in] parent Parent whose beacon gave the rank
+     * \param [in] elapsed Time since Bootstrap() was called
+     */
+    typedef void (*BootstrapTracedCallback)(uint16_t rank, Mac16Address parent, Time elapsed);
+
+    /**
+     * TracedCallback signature for a parent switch.
+     *
+     * \param [in] oldParent Parent marked stale
+     * \param [in] newParent New parent, the broadcast address if the node bootstraps again
+     * \param [in] rank New rank, RANK_UNKNOWN if the node bootstraps again
+     */
+    typedef void (*RepairTracedCallback)(Mac16Address oldParent,
+                                         Mac16Address newParent,
+                                         uint16_t rank);
+
+    /**
+     * TracedCallback signature for a source-routed packet sent by the sink.
+     *
+     * \param [in] packet The packet, with its RitRouteHeader
+     * \param [in] dst Destination
+     * \param [in] hops Hops of the route
+     */
+    typedef void (*DownlinkTxTracedCallback)(Ptr<const Packet> packet,
+                                             Mac16Address dst,
+                                             uint8_t hops);
+
+    /**
+     * TracedCallback signature for a source-routed packet delivered.
+     *
+     * \param [in] packet The packet, without its headers
+     * \param [in] latency Time since the RitTimestampTag of the packet, zero without
+     * \param [in] hops Hops of the route
+     */
+    typedef void (*DownlinkRxTracedCallback)(Ptr<const Packet> packet,
+                                             Time latency,
+                                             uint8_t hops);
+
+    /**
+     * TracedCallback signature for a broadcast handed to the MAC.
+     *
+     * \param [in] packet The packet, with its RitBroadcastHeader
+     * \param [in] origin Node that started the broadcast
+     * \param [in] seq Sequence number at the origin
+     * \param [in] hops Hops from the origin, 0 at the origin
+     */
+    typedef void (*BroadcastTxTracedCallback)(Ptr<const Packet> packet,
+                                              Mac16Address origin,
+                                              uint16_t seq,
+                                              uint8_t hops);
+
+    /**
+     * TracedCallback signature for the first reception of a broadcast.
+     *
+     * \param [in] packet The packet, without its headers
+     * \param [in] origin Node that started the broadcast
+     * \param [in] seq Sequence number at the origin
+     * \param [in] hops Hops from the origin
+     * \param [in] latency Time since the RitTimestampTag of the packet, zero without
+     */
+    typedef void (*BroadcastRxTracedCallback)(Ptr<const Packet> packet,
+                                              Mac16Address origin,
+                                              uint16_t seq,
+                                              uint8_t hops,
+                                              Time latency);
+
+    /**
+     * TracedCallback signature for a suppressed broadcast forward.
+     *
+     * \param [in] origin Node that started the broadcast
+     * \param [in] seq Sequence number at the origin
+     * \param [in] heard Copies received before the forward was due
+     */
+    typedef void (*BroadcastSuppressTracedCallback)(Mac16Address origin,
+                                                    uint16_t seq,
+                                                    uint8_t heard);
+
+    /**
+     * TracedCallback signature for a beacon left unanswered by backpressure.
+     *
+     * \param [in] neighbour Beaconing next hop
+     * \param [in] headroom Headroom it advertised
+     */
+    typedef void (*BackpressureTracedCallback)(Mac16Address neighbour, uint8_t headroom);
+
+    /**
+     * TracedCallback signature for the switch to the low-battery mode.
+     *
+     * \param [in] residual Residual share of the battery
+     */
+    typedef void (*LowEnergyTracedCallback)(double residual);
+
+    /**
+     * TracedCallback signature for a unicast packet received again (DuplicateDetection).
+     *
+     * \param [in] packet Packet without its headers
+     * \param [in] origin Node that sent the packet first
+     * \param [in] seq Sequence number at the origin
+     */
+    typedef void (*DuplicateTracedCallback)(Ptr<const Packet> packet,
+                                            Mac16Address origin,
+                                            uint16_t seq);
+
   private:
+    void DoInitialize() override;
+    void DoDispose() override;
+
+    /**
+     * \brief Process a single received NWK packet (deliver, forward or drop)
+     *
+     * \param p Packet starting with its RitNwkHeader
+     * \param macSrc MAC source of the frame, the source of a compressed header
+     */
+    void ReceivePacket(Ptr<Packet> p, Mac16Address macSrc);
+
+    /**
+     * \brief Handle the MAC outcome of one NWK packet
+     *
+     * \param nwkHandle Network-layer handle
+     * \param status MAC status of the frame that carried the packet
+     */
+    void NwkDataConfirm(uint8_t nwkHandle, MacStatus status);
+
+    /**
+     * \brief Add a packet to the aggregation buffer of its destination
+     *
+     * \param packet Packet with its RitNwkHeader
+     * \param dst Destination MAC address
+     * \param nwkHandle Network-layer handle
+     */
+    void Aggregate(Ptr<Packet> packet, Mac16Address dst, uint8_t nwkHandle);
+
+    /**
+     * \brief Send the aggregation buffer of a destination as one MAC frame
+     *
+     * \param dst Destination MAC address
+     */
+    void FlushAggregate(Mac16Address dst);
+
+    /**
+     * \brief Hand an MSDU to the MAC
+     *
+     * \param msdu The MSDU
+     * \param dst Destination MAC address
+     * \param nwkHandles Network-layer handles of the packets in the MSDU
+     */
+    void SendMsdu(Ptr<Packet> msdu, Mac16Address dst, const std::vector<uint8_t>& nwkHandles);
+
+    /**
+     * \brief Send a new packet with a new network handle
+     *
+     * \param packet Packet to send, without RitNwkHeader
+     * \param dst Destination MAC address
+     * \param txClass Priority class and origin of the packet
+     * \param option Header at the front of the packet (RitRouteHeader or none)
+     * \param downHop Relay of a downlink packet, broadcast for an uplink one
+     * \return false if the transmit table is full; the packet is dropped
+     */
+    bool SendNewRequest(Ptr<Packet> packet,
+                        Mac16Address dst,
+                        const RitTxQueueClass& txClass,
+                        RitNwkHeader::Option option = RitNwkHeader::OPTION_NONE,
+                        Mac16Address downHop = Mac16Address::GetBroadcast());
+
+    /**
+     * \brief Take a free slot of the transmit table
+     *
+     * \param [out] nwkHandle Handle of the slot
+     * \return false if every slot is in use
+     */
+    bool AllocateTxEntry(uint8_t& nwkHandle);
+
+    /**
+     * \brief Free the slot of a packet that left the NWK layer
+     *
+     * \param nwkHandle Handle of the slot
+     */
+    void ReleaseTxEntry(uint8_t nwkHandle);
+
+    /**
+     * \brief Delay before a packet is sent again, according to RetryPolicy
+     * \return the delay
+     */
+    Time GetRetryDelay() const;
+
+    /**
+     * \brief Re-send a packet after its retry delay (the retry event)
+     *
+     * \param packet Packet to send, without NWK header
+     * \param dst Destination MAC address
+     * \param nwkHandle Network-layer handle of the packet
+     */
+    void RetrySendRequest(Ptr<Packet> packet, Mac16Address dst, uint8_t nwkHandle);
+
+    /**
+     * \brief Send a packet of the sink along the reported parents
+     *
+     * \param packet Packet to send, without RitNwkHeader
+     * \param dst Destination
+     * \param txClass Priority class and origin of the packet
+     * \return false if no route is known or the transmit table is full; the packet is dropped
+     */
+    bool SendDownlink(Ptr<Packet> packet, Mac16Address dst, const RitTxQueueClass& txClass);
+
+    /**
+     * \brief Start a network-wide broadcast
+     *
+     * \param packet Packet to send, without RitNwkHeader
+     * \param txClass Priority class and origin of the packet
+     * \return false if the transmit table is full; the packet is dropped
+     */
+    bool SendBroadcast(Ptr<Packet> packet, const RitTxQueueClass& txClass);
+
+    /**
+     * \brief Deliver a new broadcast and schedule its forward, or count a copy
+     *
+     * \param p Packet starting with its RitBroadcastHeader
+     * \param nwkHdr Its RitNwkHeader
+     */
+    void ReceiveBroadcast(Ptr<Packet> p, const RitNwkHeader& nwkHdr);
+
+    /**
+     * \brief Forward a broadcast at the end of its wait, unless enough copies were heard
+     *
+     * \param key Key of the pending forward
+     */
+    void ForwardBroadcast(uint32_t key);
+
+    /**
+     * \brief Record a broadcast in the duplicate cache
+     *
+     * \param origin Node that started the broadcast
+     * \param seq Sequence number at the origin
+     * \return false if it was already received
+     */
+    bool CacheBroadcast(Mac16Address origin, uint16_t seq);
+
+    /**
+     * \brief Trickle interval of the broadcast forwards
+     * \return BroadcastInterval, or two RIT periods if zero
+     */
+    Time GetBroadcastInterval() const;
+
+    /**
+     * \brief Count a failed exchange and switch the parent after RepairThreshold in a row
+     */
+    void NotifyLinkFailure();
+
+    /**
+     * \brief Mark the parent stale and take the best other neighbour as parent
+     */
+    void RepairParent();
+
+    /**
+     * \brief Queue headroom advertised in the RIT request payload (AnycastEnabled,
+     *        BackpressureEnabled)
+     *
+     * AnycastQueueCapacity minus the MSDUs waiting in the MAC, bounded by the free
+     * room of the MAC TX queue when it has a TxQueueCapacity.
+     * \return free frames in the MAC queue, saturated to 255
+     */
+    uint8_t GetQueueHeadroom() const;
+
+    /**
+     * \brief Rebuild the RIT request payload from the rank (and headroom) of this node
+     */
+    void UpdateRitRequestPayload();
+
+    /**
+     * \brief Refresh the advertised energy level and enter the low-battery mode when
+     *        due, every EnergyCheckInterval
+     */
+    void CheckEnergy();
+
+    /**
+     * \brief Draw whether the beacon of an eligible next hop is answered (EnergyBalancing)
+     *
+     * The probability is the level of the next hop over the best level among the
+     * eligible neighbours heard within the stale time, one if none has energy left.
+     * \param level Residual energy level advertised in the beacon
+     * \return true to answer the beacon
+     */
+    bool AcceptByEnergy(uint8_t level);
+
+    /**
+     * \brief Whether a neighbour of the given rank is an eligible next hop
+     * \param rank Rank advertised by the neighbour
+     * \return true for rank - LinkCost (any lower rank with AnycastEnabled)
+     */
+    bool IsEligibleRank(uint16_t rank) const;
+
+    /**
+     * A slot of the transmit table: one outstanding NWK packet.
+     */
+    struct TxEntry
+    {
+        bool inUse{false};       //!< Whether the slot holds a packet
+        Ptr<Packet> packet;      //!< Copy with its RitNwkHeader, for traces and retries
+        Mac16Address nextHop;    //!< NWK destination, handed to the MAC unless downlink
+        uint8_t retries{0};      //!< Retransmissions so far
+        int16_t msduHandle{-1};  //!< MSDU carrying the packet, -1 while not at the MAC
+        int16_t nextInMsdu{-1};  //!< Next packet of the same MSDU, -1 for the last
+        Time enqueueTime;        //!< Arrival at the NWK layer
+        RitTxQueueClass txClass; //!< Priority class and origin
+        RitNwkHeader::Option option{RitNwkHeader::OPTION_NONE}; //!< Header after RitNwkHeader
+        bool downlink{false};    //!< Sent only to the beacon of downHop
+        Mac16Address downHop;    //!< Relay of a downlink packet
+    };
+
+    /**
+     * Duplicate cache entry of one broadcast origin.
+     */
+    struct BroadcastSeen
+    {
+        uint16_t last{0};   //!< Highest sequence number received
+        uint32_t window{0}; //!< Bit k: last - k received
+    };
+
+    /**
+     * A broadcast waiting for its forward.
+     */
+    struct PendingBroadcast
+    {
+        Ptr<Packet> packet;        //!< Packet without its headers
+        RitBroadcastHeader header; //!< Header to forward, hops incremented
+        RitTxQueueClass txClass;   //!< Priority class and previous hop
+        uint8_t heard{0};          //!< Copies received since the first one
+        EventId forwardEvent;      //!< End of the wait
+    };
+
+    /**
+     * Packets waiting to be aggregated toward one destination.
+     */
+    struct AggregationBuffer
+    {
+        std::vector<Ptr<Packet>> packets; //!< Packets with their NWK headers
+        std::vector<uint8_t> nwkHandles;  //!< Handles of the packets
+        uint32_t bytes{0};                //!< Sum of the packet sizes
+        EventId flushEvent;               //!< Max-delay flush
+    };
+
     // Node attributes
     uint16_t m_rank;            //!< Rank of this node
     Mac16Address m_shortAddr;   //!< Short MAC address
@@ -156,24 +726,114 @@ class RitSimpleRouting : public Object
     TracedCallback<Ptr<const Packet>> m_nwkRxTrace;
     TracedCallback<Ptr<const Packet>> m_nwkRxDropTrace;
     TracedCallback<Ptr<const Packet>> m_nwkReTxTrace;
+    TracedCallback<Ptr<const Packet>, uint8_t, Time> m_nwkReTxBackoffTrace;
+    TracedCallback<uint16_t, Mac16Address, Time> m_nwkBootstrapTrace;
+    TracedCallback<Mac16Address, Mac16Address, uint16_t> m_nwkRepairTrace;
+    TracedCallback<Ptr<const Packet>, Mac16Address, uint8_t> m_nwkDownlinkTxTrace;
+    TracedCallback<Ptr<const Packet>, Time, uint8_t> m_nwkDownlinkRxTrace;
+    TracedCallback<Ptr<const Packet>, Mac16Address, uint16_t, uint8_t> m_nwkBroadcastTxTrace;
+    TracedCallback<Ptr<const Packet>, Mac16Address, uint16_t, uint8_t, Time> m_nwkBroadcastRxTrace;
+    TracedCallback<Mac16Address, uint16_t, uint8_t> m_nwkBroadcastSuppressTrace;
+    TracedCallback<Mac16Address, uint8_t> m_nwkBackpressureTrace;
+    TracedCallback<double> m_nwkLowEnergyTrace;
+    TracedCallback<Ptr<const Packet>, Mac16Address, uint16_t> m_nwkRxDuplicateTrace;
 
     // Upper-layer callback
     NwkRxCallback m_nwkRxCallback;
 
     // Underlying MAC
     Ptr<RitWpanMac> m_mac;
+    std::vector<Ptr<RitWpanMac>> m_radioMacs; //!< Further receive-only MACs (AddRadioMac)
 
-    // Handle and retry management
-    std::map<uint8_t, std::pair<Ptr<Packet>, Mac16Address>> m_handleToPktMap;
-    std::map<uint8_t, uint8_t> m_retryCountMap;
-    std::map<uint8_t, uint8_t> m_msduToNwkHandleMap;
+    // Transmit table
+    uint32_t m_txTableSize;                   //!< Slots of the table, read at the first packet
+    bool m_headerCompression;                 //!< Send compressed NWK headers
+    std::pmr::vector<TxEntry> m_txTable;      //!< Outstanding packets, indexed by NWK handle
+    std::pmr::vector<uint8_t> m_freeTxSlots;  //!< Free NWK handles
+    std::array<int16_t, 256> m_msduHead;      //!< First packet per MSDU handle, -1 if unused
+    uint32_t m_nQueuedMsdus;                  //!< MSDUs handed to the MAC and not confirmed
+    TracedValue<uint32_t> m_txTableOccupancy; //!< Slots in use
 
-    SequenceNumber8 m_nwkHandle;
     SequenceNumber8 m_macHandle;
 
-    static constexpr uint8_t MAX_RETRIES = 0;
-
+    // Retransmission
+    uint8_t m_maxRetries;         //!< Retries after a NO_ACK
+    RitRetryPolicy m_retryPolicy; //!< Time of a retry
+    Time m_retryMaxDelay;         //!< Upper bound of the random retry delay
     Ptr<UniformRandomVariable> m_reTxDelay;
+
+    // Neighbours
+    RitNeighbourTable m_neighbours; //!< Neighbours heard through their beacons
+    uint32_t m_neighbourTableSize;  //!< Capacity of m_neighbours
+    Time m_neighbourStaleTime;      //!< Age of a replaceable neighbour
+    double m_maxParentEtx;          //!< Largest ETX of a parent, zero for no limit
+    Mac16Address m_lastPeer;        //!< Neighbour of the last answered beacon
+    bool m_lastPeerValid;           //!< Whether m_lastPeer is set
+
+    // Aggregation
+    bool m_aggregationEnabled;      //!< Whether NWK packets are aggregated
+    Time m_aggregationMaxDelay;     //!< Longest hold time of a buffered packet
+    uint32_t m_aggregationMaxBytes; //!< Largest aggregated MSDU
+    std::pmr::map<Mac16Address, AggregationBuffer> m_aggregationBuffers; //!< Per destination
+
+    // Anycast
+    bool m_anycastEnabled;           //!< Take beacons of any lower-rank neighbour
+    uint32_t m_anycastQueueCapacity; //!< MAC frames a node accepts to hold
+    uint8_t m_anycastMinHeadroom;    //!< Headroom required from a next hop
+    uint8_t m_advertisedHeadroom;    //!< Headroom in the current RIT request payload
+
+    // Backpressure
+    bool m_backpressureEnabled;        //!< Leave beacons of congested next hops unanswered
+    uint8_t m_backpressureMinHeadroom; //!< Headroom a next hop must advertise
+    bool m_backpressureSkipped;        //!< A beacon was left unanswered in this sender cycle
+
+    // Bootstrap
+    Time m_bootstrapDuration; //!< Listen period, zero for two RIT periods
+    uint16_t m_linkCost;      //!< Rank added to the parent rank
+    uint8_t m_minParentLqi;   //!< Lowest LQI of a parent beacon
+    bool m_bootstrapping;     //!< Bootstrap() called and no parent found yet
+    Time m_bootstrapStart;    //!< Time of the Bootstrap() call
+    Mac16Address m_parent;    //!< Chosen parent, broadcast if none
+
+    // Local repair
+    bool m_localRepairEnabled;     //!< Switch the parent after consecutive failures
+    uint8_t m_repairThreshold;     //!< Consecutive failures before a switch
+    uint8_t m_consecutiveFailures; //!< Failures since the last acknowledged exchange
+
+    // Downlink
+    bool m_downlinkEnabled;        //!< Route reports and sink source routes
+    Time m_routeReportInterval;    //!< Longest time between two identical reports
+    Mac16Address m_uplinkPeer;     //!< Last neighbour that acknowledged an uplink frame
+    bool m_uplinkPeerValid;        //!< Whether m_uplinkPeer is set
+    Mac16Address m_reportedParent; //!< Parent in the last report
+    Time m_reportTime;             //!< Time of the last report
+    bool m_reportValid;            //!< Whether a report was sent
+    std::map<Mac16Address, Mac16Address> m_downlinkParents; //!< Reported parent of each node
+
+    // Network-wide broadcast
+    Time m_broadcastInterval;      //!< Trickle interval, zero for two RIT periods
+    uint8_t m_broadcastRedundancy; //!< Copies that suppress a forward, 0 for none
+    uint16_t m_broadcastSeq;       //!< Sequence number of the next own broadcast
+    std::pmr::map<Mac16Address, BroadcastSeen> m_broadcastSeen;    //!< Duplicate cache per origin
+    std::pmr::map<uint32_t, PendingBroadcast> m_pendingBroadcasts; //!< By origin and sequence
+
+    // End-to-end duplicate detection
+    bool m_duplicateDetection;        //!< Unicast packets carry their origin and sequence
+    uint32_t m_duplicateCacheSize;    //!< Entries of m_rxDuplicates
+    Time m_duplicateLifetime;         //!< Time an origin and sequence stay in m_rxDuplicates
+    uint16_t m_unicastSeq;            //!< Sequence number of the next own unicast packet
+    RitDuplicateCache m_rxDuplicates; //!< Unicast packets received, by origin and sequence
+
+    // Energy balancing
+    bool m_energyBalancing;                 //!< Next hops weighted by their residual energy
+    double m_lowEnergyThreshold;            //!< Residual share of the low-battery mode, 0 for none
+    double m_lowEnergyPeriodFactor;         //!< RIT period multiplier in the low-battery mode
+    Time m_energyCheckInterval;             //!< Period of CheckEnergy()
+    Ptr<RitWpanEnergyModel> m_energyModel;  //!< Residual energy of the node, null if none
+    Ptr<UniformRandomVariable> m_energyRng; //!< Draws of AcceptByEnergy()
+    uint8_t m_advertisedEnergy;             //!< Level in the current RIT request payload
+    bool m_lowEnergy;                       //!< Low-battery mode entered
+    EventId m_energyCheckEvent;             //!< Next CheckEnergy()
 };
 
 } // namespace lrwpan
@@ -11,6 +11,7 @@
 #include "rit-wpan-precs.h"
 
 #include "ns3/log.h"
+#include "ns3/nstime.h"
 #include "ns3/simulator.h"
 
 namespace ns3
@@ -20,12 +21,13 @@ namespace lrwpan
 
 NS_LOG_COMPONENT_DEFINE("RitWpanPreCs");
 NS_OBJECT_ENSURE_REGISTERED(RitWpanPreCs);
+NS_OBJECT_ENSURE_REGISTERED(RitWpanCachedPreCs);
 
 TypeId
 RitWpanPreCs::GetTypeId()
 {
     static TypeId tid = TypeId("ns3::RitWpanPreCs")
-                            .SetParent<Object>()
+                            .SetParent<RitCarrierSense>()
                             .SetGroupName("RitWpan")
                             .AddConstructor<RitWpanPreCs>();
     return tid;
@@ -34,132 +36,104 @@ RitWpanPreCs::GetTypeId()
 RitWpanPreCs::RitWpanPreCs()
 {
     NS_LOG_FUNCTION(this);
-    m_ccaRequestRunning = false;
 }
 
 RitWpanPreCs::~RitWpanPreCs()
 {
     NS_LOG_FUNCTION(this);
-    m_mac = nullptr;
 }
 
 void
-RitWpanPreCs::DoDispose()
+RitWpanPreCs::DoStart()
 {
     NS_LOG_FUNCTION(this);
-    m_lrWpanMacStateCallback = MakeNullCallback<void, MacState>();
-    Cancel();
-    m_mac = nullptr;
-    Object::DoDispose();
+    NS_LOG_DEBUG("Starting Pre-CS algorithm - immediate CCA request");
+
+    // Pre-CS performs immediate CCA without any backoff or delay. The result is reported
+    // as is: the channel is idle, or the access fails without retry.
+    RequestCca();
 }
 
-void
-RitWpanPreCs::SetMac(Ptr<RitWpanMac> mac)
+TypeId
+RitWpanCachedPreCs::GetTypeId()
 {
-    NS_LOG_FUNCTION(this << mac);
-    m_mac = mac;
+    static TypeId tid =
+        TypeId("ns3::RitWpanCachedPreCs")
+            .SetParent<RitWpanPreCs>()
+            .SetGroupName("RitWpan")
+            .AddConstructor<RitWpanCachedPreCs>()
+            .AddAttribute("BusyHoldTime",
+                          "How long a busy CCA makes the accesses fail without CCA",
+                          TimeValue(MicroSeconds(4256)),
+                          MakeTimeAccessor(&RitWpanCachedPreCs::m_busyHoldTime),
+                          MakeTimeChecker(Time(0)));
+    return tid;
 }
 
-Ptr<RitWpanMac>
-RitWpanPreCs::GetMac() const
+RitWpanCachedPreCs::RitWpanCachedPreCs()
+    : m_busyKnown(false),
+      m_nHits(0)
 {
     NS_LOG_FUNCTION(this);
-    return m_mac;
 }
 
-void
-RitWpanPreCs::SetLrWpanMacStateCallback(LrWpanMacStateCallback lrWpanMacStatusCallback)
+RitWpanCachedPreCs::~RitWpanCachedPreCs()
 {
     NS_LOG_FUNCTION(this);
-    m_lrWpanMacStateCallback = lrWpanMacStatusCallback;
 }
 
 void
-RitWpanPreCs::SetFallbackCcaConfirmCallback(FallbackCcaConfirmCallback fallbackCcaConfirmCallback)
+RitWpanCachedPreCs::DoDispose()
 {
     NS_LOG_FUNCTION(this);
-    m_fallbackCcaConfirmCallback = fallbackCcaConfirmCallback;
+    m_hitEvent.Cancel();
+    RitWpanPreCs::DoDispose();
 }
 
 void
-RitWpanPreCs::Start()
+RitWpanCachedPreCs::Cancel()
 {
     NS_LOG_FUNCTION(this);
-    NS_LOG_DEBUG("Starting Pre-CS algorithm - immediate CCA request");
-
-    // Pre-CS performs immediate CCA without any backoff or delay
-    RequestCCA();
+    m_hitEvent.Cancel();
+    RitWpanPreCs::Cancel();
 }
 
 void
-RitWpanPreCs::Cancel()
+RitWpanCachedPreCs::NotifyChannelAssessed(PhyEnumeration status)
 {
-    NS_LOG_FUNCTION(this);
-
-    if (m_ccaRequestRunning)
+    NS_LOG_FUNCTION(this << status);
+    if (status == IEEE_802_15_4_PHY_BUSY)
     {
-        NS_LOG_DEBUG("Canceling ongoing CCA request");
-        m_mac->GetPhy()->CcaCancel();
-        m_ccaRequestRunning = false;
+        m_busyKnown = true;
+        m_lastBusy = Simulator::Now();
+    }
+    else if (status == IEEE_802_15_4_PHY_IDLE)
+    {
+        m_busyKnown = false;
     }
 }
 
-void
-RitWpanPreCs::RequestCCA()
+uint32_t
+RitWpanCachedPreCs::GetNCacheHits() const
 {
-    NS_LOG_FUNCTION(this);
-    NS_LOG_DEBUG("Requesting CCA from PHY");
-
-    m_ccaRequestRunning = true;
-    m_mac->GetPhy()->PlmeCcaRequest();
+    return m_nHits;
 }
 
 void
-RitWpanPreCs::PlmeCcaConfirm(PhyEnumeration status)
+RitWpanCachedPreCs::DoStart()
 {
-    NS_LOG_FUNCTION(this << status);
-
-    // Only react on this event, if we are actually waiting for a CCA.
-    // If the Pre-CS algorithm was canceled, we could still receive this event from
-    // the PHY. In this case we ignore the event.
-    if (m_ccaRequestRunning)
-    {
-        m_ccaRequestRunning = false;
-
-        if (status == IEEE_802_15_4_PHY_IDLE)
-        {
-            NS_LOG_DEBUG("Channel assessed as IDLE - notifying MAC to proceed");
-
-            // Channel is idle, notify MAC that transmission can proceed
-            if (!m_lrWpanMacStateCallback.IsNull())
-            {
-                m_lrWpanMacStateCallback(CHANNEL_IDLE);
-            }
-        }
-        else
-        {
-            NS_LOG_DEBUG("Channel assessed as BUSY - notifying MAC of access failure");
-
-            // Channel is busy, notify MAC of immediate failure
-            // No retry or backoff in Pre-CS
-            if (!m_lrWpanMacStateCallback.IsNull())
-            {
-                m_lrWpanMacStateCallback(CHANNEL_ACCESS_FAILURE);
-            }
-        }
-    }
-    else
+    NS_LOG_FUNCTION(this);
+    if (m_busyKnown && Simulator::Now() - m_lastBusy < m_busyHoldTime)
     {
-        NS_LOG_DEBUG("Fallback to CSMA-CA via fallback CCA confirm callback.");
-        if (!m_fallbackCcaConfirmCallback.IsNull())
-        {
-            m_fallbackCcaConfirmCallback(status);
-        }
-        else
-        {
-            NS_LOG_WARN("FallbackCcaConfirmCallback is not set — ignoring CCA confirm.");
-        }
+        NS_LOG_DEBUG("Channel busy " << (Simulator::Now() - m_lastBusy).As(Time::US)
+                                     << " ago - access failure without CCA");
+        m_nHits++;
+        // Reported like a CCA result, after the MAC's confirm handler returned.
+        m_hitEvent =
+            Simulator::ScheduleNow(&RitWpanCachedPreCs::Finish, this, CHANNEL_ACCESS_FAILURE);
+        return;
     }
+    RitWpanPreCs::DoStart();
 }
 
 } // namespace lrwpan
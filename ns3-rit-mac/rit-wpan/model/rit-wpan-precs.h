@@ -11,32 +11,16 @@
 #ifndef RIT_WPAN_PRECS_H
 #define RIT_WPAN_PRECS_H
 
-#include "rit-wpan-mac.h"
+#include "rit-carrier-sense.h"
 
 #include "ns3/event-id.h"
-#include "ns3/object.h"
+#include "ns3/nstime.h"
 
 namespace ns3
 {
 namespace lrwpan
 {
 
-/**
- * @ingroup lr-wpan
- *
- * This method informs the MAC whether the channel is idle or busy for Pre-CS.
- */
-typedef Callback<void, MacState> LrWpanMacStateCallback;
-
-/**
- * @ingroup lr-wpan
- *
- * This method implements the PD SAP: PlmeCcaConfirm
- *
- * @param status the status of CCA
- */
-typedef Callback<void, PhyEnumeration> FallbackCcaConfirmCallback;
-
 /**
  * @ingroup lr-wpan
  *
@@ -53,7 +37,7 @@ typedef Callback<void, PhyEnumeration> FallbackCcaConfirmCallback;
  *
  * Intended to reduce power and delay overhead when sending lightweight control frames.
  */
-class RitWpanPreCs : public Object
+class RitWpanPreCs : public RitCarrierSense
 {
   public:
     /**
@@ -73,80 +57,57 @@ class RitWpanPreCs : public Object
      */
     ~RitWpanPreCs() override;
 
+  protected:
     /**
-     * Set the MAC to which this Pre-CS implementation is attached to.
-     *
-     * @param mac the used MAC
-     */
-    void SetMac(Ptr<RitWpanMac> mac);
-
-    /**
-     * Get the MAC to which this Pre-CS implementation is attached to.
-     *
-     * @return the used MAC
+     * Start Pre-CS algorithm (immediate CCA request).
+     * Performs a single carrier sense attempt without backoff or retry.
      */
-    Ptr<RitWpanMac> GetMac() const;
+    void DoStart() override;
+};
 
+/**
+ * @ingroup lr-wpan
+ *
+ * @brief Pre-CS that remembers a recent busy channel.
+ *
+ * A CCA of any stage that finds the channel busy is remembered for BusyHoldTime; an
+ * access started meanwhile fails at once, without CCA, and an idle CCA forgets the busy
+ * result. About a maximum-size frame, the default hold spares the CCAs that would land
+ * in the same foreign frame.
+ */
+class RitWpanCachedPreCs : public RitWpanPreCs
+{
+  public:
     /**
-     * Set the callback function to the MAC. Used at the end of a Channel Assessment, as part of the
-     * interconnections between the Pre-CS and the MAC. The callback
-     * lets MAC know a channel is either idle or busy.
+     * Get the type ID.
      *
-     * @param macState the mac state callback
+     * @return the object TypeId
      */
-    void SetLrWpanMacStateCallback(LrWpanMacStateCallback macState);
-
-    void SetFallbackCcaConfirmCallback(FallbackCcaConfirmCallback fallbackCcaConfirmCallback);
+    static TypeId GetTypeId();
 
-    /**
-     * Start Pre-CS algorithm (immediate CCA request).
-     * Performs a single carrier sense attempt without backoff or retry.
-     */
-    void Start();
+    RitWpanCachedPreCs();
+    ~RitWpanCachedPreCs() override;
 
-    /**
-     * Cancel Pre-CS algorithm.
-     * Cancels any ongoing CCA request.
-     */
-    void Cancel();
+    void Cancel() override;
+    void NotifyChannelAssessed(PhyEnumeration status) override;
 
     /**
-     * Request the Phy to perform CCA (single attempt)
+     * @brief Get the accesses answered from the remembered busy channel.
+     * @return the accesses failed without CCA
      */
-    void RequestCCA();
+    uint32_t GetNCacheHits() const;
 
-    /**
-     * IEEE 802.15.4-2006 section 6.2.2.2
-     * PLME-CCA.confirm status
-     * @param status TRX_OFF, BUSY or IDLE
-     *
-     * When Phy has completed CCA, it calls back here which executes the final step
-     * of the Pre-CS algorithm.
-     * It checks if the Channel is idle and immediately notifies the MAC.
-     * If channel is busy, notifies channel access failure immediately.
-     */
-    void PlmeCcaConfirm(PhyEnumeration status);
+  protected:
+    void DoStart() override;
 
   private:
     void DoDispose() override;
 
-    /**
-     * The callback to inform the configured MAC of the Pre-CS result.
-     */
-    LrWpanMacStateCallback m_lrWpanMacStateCallback;
-
-    FallbackCcaConfirmCallback m_fallbackCcaConfirmCallback;
-
-    /**
-     * The MAC instance for which this Pre-CS implementation is configured.
-     */
-    Ptr<RitWpanMac> m_mac;
-
-    /**
-     * Flag indicating that the PHY is currently running a CCA. Used to prevent
-     * reporting the channel status to the MAC while canceling the Pre-CS algorithm.
-     */
-    bool m_ccaRequestRunning;
+    Time m_busyHoldTime; //!< How long a busy CCA is remembered
+    Time m_lastBusy;     //!< End of the last busy CCA
+    bool m_busyKnown;    //!< A busy CCA is remembered
+    uint32_t m_nHits;    //!< Accesses failed without CCA
+    EventId m_hitEvent;  //!< Pending report of a failure without CCA
 };
 
 } // namespace lrwpan
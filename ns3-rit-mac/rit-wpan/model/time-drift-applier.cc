@@ -32,6 +32,13 @@ TimeDriftApplier::SetDriftRatio(double driftRatio)
     m_driftRatio = driftRatio;
 }
 
+int64_t
+TimeDriftApplier::AssignStreams(int64_t stream)
+{
+    m_rng->SetStream(stream);
+    return 1;
+}
+
 Time
 TimeDriftApplier::ApplyByRatio(Time inputTime) const
 {
@@ -49,9 +56,8 @@ TimeDriftApplier::ApplyByRatio(Time inputTime, double driftRatio) const
     double minDrift = -inputTimeMs * driftRatio / 100.0;
     double maxDrift = inputTimeMs * driftRatio / 100.0;
 
-    m_rng->SetAttribute("Min", DoubleValue(minDrift));
-    m_rng->SetAttribute("Max", DoubleValue(maxDrift));
-    double randomDelay = m_rng->GetValue();
+    // Same draw as setting the Min and Max attributes, without the attribute lookups
+    double randomDelay = m_rng->GetValue(minDrift, maxDrift);
     Time randomizedTime = inputTime + MilliSeconds(randomDelay);
 
     NS_LOG_DEBUG("Input Time: " << inputTime.GetMilliSeconds()
@@ -27,6 +27,14 @@ class TimeDriftApplier : public Object
     Time ApplyByRatio(Time inputTime) const;
     Time ApplyByRatio(Time inputTime, double driftRatio) const;
 
+    /**
+     * Assign a fixed random variable stream number to the drift generator
+     *
+     * @param stream First stream index to use
+     * @return the number of stream indices assigned (1)
+     */
+    int64_t AssignStreams(int64_t stream);
+
   private:
     double m_driftRatio; // percent (e.g. 10.0 means ±10%)
     Ptr<UniformRandomVariable> m_rng;
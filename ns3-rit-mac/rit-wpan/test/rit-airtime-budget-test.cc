@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/log.h>
+#include <ns3/nstime.h>
+#include <ns3/rit-airtime-budget.h>
+#include <ns3/test.h>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-airtime-budget-test");
+
+/**
+ * @brief Check the sliding window of RitAirtimeBudget: the airtime leaves the window
+ *        bucket by bucket, and the wait is the time until enough of it has left.
+ */
+class RitAirtimeBudgetWindowTest : public TestCase
+{
+  public:
+    RitAirtimeBudgetWindowTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitAirtimeBudgetWindowTest::RitAirtimeBudgetWindowTest()
+    : TestCase("Sliding-window TX airtime budget")
+{
+}
+
+void
+RitAirtimeBudgetWindowTest::DoRun()
+{
+    RitAirtimeBudget budget;
+    NS_TEST_EXPECT_MSG_EQ(budget.IsEnabled(), false, "Limited by default");
+    NS_TEST_EXPECT_MSG_EQ(budget.GetWaitTime(Seconds(1), Seconds(100)),
+                          Time(),
+                          "Wait without a limit");
+
+    // 10% of 100 s in 10 buckets of 10 s: 10 s of airtime
+    budget.Configure(Seconds(100), 0.1, 10);
+    NS_TEST_EXPECT_MSG_EQ(budget.GetBudget(), Seconds(10), "Wrong budget");
+    budget.Record(Seconds(5), Seconds(4));
+    budget.Record(Seconds(25), Seconds(5));
+    NS_TEST_EXPECT_MSG_EQ(budget.GetUsed(Seconds(30)), Seconds(9), "Wrong airtime used");
+    NS_TEST_EXPECT_MSG_EQ(budget.GetWaitTime(Seconds(30), Seconds(1)), Time(), "Fits");
+
+    // 2 s only fit once the first bucket (0-10 s) leaves the window, at 100 s
+    NS_TEST_EXPECT_MSG_EQ(budget.GetWaitTime(Seconds(30), Seconds(2)),
+                          Seconds(70),
+                          "Wrong wait for the oldest bucket");
+    // 6 s need the bucket of 20-30 s to leave as well, at 120 s
+    NS_TEST_EXPECT_MSG_EQ(budget.GetWaitTime(Seconds(30), Seconds(6)),
+                          Seconds(90),
+                          "Wrong wait for two buckets");
+    NS_TEST_EXPECT_MSG_EQ(budget.GetWaitTime(Seconds(30), Seconds(11)),
+                          Seconds(100),
+                          "A transmission over the budget must wait a window");
+
+    NS_TEST_EXPECT_MSG_EQ(budget.GetUsed(Seconds(110)), Seconds(5), "Oldest bucket kept");
+    NS_TEST_EXPECT_MSG_EQ(budget.GetWaitTime(Seconds(110), Seconds(2)), Time(), "Freed");
+    NS_TEST_EXPECT_MSG_EQ(budget.GetUsed(Seconds(1000)), Time(), "Window not emptied");
+
+    budget.Record(Seconds(1000), Seconds(1));
+    NS_TEST_EXPECT_MSG_EQ(budget.GetUsed(Seconds(1000)), Seconds(1), "Wrong airtime after a gap");
+}
+
+class RitAirtimeBudgetTestSuite : public TestSuite
+{
+  public:
+    RitAirtimeBudgetTestSuite();
+};
+
+RitAirtimeBudgetTestSuite::RitAirtimeBudgetTestSuite()
+    : TestSuite("rit-airtime-budget", Type::UNIT)
+{
+    AddTestCase(new RitAirtimeBudgetWindowTest, Duration::QUICK);
+}
+
+static RitAirtimeBudgetTestSuite g_ritAirtimeBudgetTestSuite;
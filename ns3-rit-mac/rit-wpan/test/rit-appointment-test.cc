@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/core-module.h>
+#include <ns3/log.h>
+#include <ns3/network-module.h>
+#include <ns3/packet.h>
+#include <ns3/propagation-delay-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/rit-appointment-header.h>
+#include <ns3/rit-wpan-mac.h>
+#include <ns3/rit-wpan-net-device.h>
+#include <ns3/single-model-spectrum-channel.h>
+
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-appointment-test");
+
+/**
+ * @brief Check that RitAppointmentHeader serializes to 8 bytes and reads back the
+ *        offset and period at the microsecond.
+ */
+class RitAppointmentHeaderTest : public TestCase
+{
+  public:
+    RitAppointmentHeaderTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitAppointmentHeaderTest::RitAppointmentHeaderTest()
+    : TestCase("RitAppointmentHeader round trip")
+{
+}
+
+void
+RitAppointmentHeaderTest::DoRun()
+{
+    RitAppointmentHeader header;
+    header.SetOffset(MicroSeconds(987654));
+    header.SetPeriod(Seconds(1));
+    Ptr<Packet> p = Create<Packet>(0);
+    p->AddHeader(header);
+    NS_TEST_EXPECT_MSG_EQ(p->GetSize(), 8, "Wrong serialized size");
+
+    RitAppointmentHeader read;
+    p->RemoveHeader(read);
+    NS_TEST_EXPECT_MSG_EQ(read.GetOffset(), MicroSeconds(987654), "Wrong offset");
+    NS_TEST_EXPECT_MSG_EQ(read.GetPeriod(), Seconds(1), "Wrong period");
+
+    // Negative offsets are clamped to zero
+    header.SetOffset(MicroSeconds(-5));
+    NS_TEST_EXPECT_MSG_EQ(header.GetOffset(), Time(), "Negative offset not clamped");
+}
+
+/**
+ * @brief Check that a periodic sender sleeps until the beacon its receiver appointed in
+ *        the last ACK, without phase learning, and still delivers every frame
+ *        (ackAppointmentsEnabled).
+ */
+class RitAppointmentWakeupTest : public TestCase
+{
+  public:
+    RitAppointmentWakeupTest();
+
+  private:
+    /**
+     * @brief Record the time spent in SENDER_MODE by the sender.
+     * @param oldMode The previous mode
+     * @param newMode The new mode
+     */
+    void ModeChanged(RitMacMode oldMode, RitMacMode newMode);
+
+    /**
+     * @brief Count the data frames received by the receiver.
+     * @param dev The device
+     * @param pkt The packet
+     * @param proto The protocol number
+     * @param addr The source address
+     * @return true
+     */
+    bool DataIndication(Ptr<NetDevice> dev,
+                        Ptr<const Packet> pkt,
+                        uint16_t proto,
+                        const Address& addr);
+    void DoRun() override;
+
+    Time m_senderModeStart;          //!< Start of the current SENDER_MODE period
+    std::vector<Time> m_senderTimes; //!< Length of each SENDER_MODE period
+    uint32_t m_nRx{0};               //!< Data frames received
+};
+
+RitAppointmentWakeupTest::RitAppointmentWakeupTest()
+    : TestCase("Sender wake-up on the beacon appointed in the ACK (RIT)")
+{
+}
+
+void
+RitAppointmentWakeupTest::ModeChanged(RitMacMode oldMode, RitMacMode newMode)
+{
+    if (newMode == SENDER_MODE)
+    {
+        m_senderModeStart = Simulator::Now();
+    }
+    else if (oldMode == SENDER_MODE)
+    {
+        m_senderTimes.push_back(Simulator::Now() - m_senderModeStart);
+    }
+}
+
+bool
+RitAppointmentWakeupTest::DataIndication(Ptr<NetDevice> dev,
+                                         Ptr<const Packet> pkt,
+                                         uint16_t proto,
+                                         const Address& addr)
+{
+    m_nRx++;
+    return true;
+}
+
+void
+RitAppointmentWakeupTest::DoRun()
+{
+    Ptr<Node> receiverNode = CreateObject<Node>();
+    Ptr<Node> senderNode = CreateObject<Node>();
+    Ptr<RitWpanNetDevice> receiverDevice = CreateObject<RitWpanNetDevice>();
+    Ptr<RitWpanNetDevice> senderDevice = CreateObject<RitWpanNetDevice>();
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+    receiverDevice->SetChannel(channel);
+    senderDevice->SetChannel(channel);
+
+    receiverDevice->SetAddress(Mac16Address("00:00"));
+    receiverDevice->SetRitRank(0);
+    senderDevice->SetAddress(Mac16Address("00:01"));
+    senderDevice->SetRitRank(1);
+    receiverNode->AddDevice(receiverDevice);
+    senderNode->AddDevice(senderDevice);
+    receiverDevice->SetReceiveCallback(
+        MakeCallback(&RitAppointmentWakeupTest::DataIndication, this));
+
+    RitWpanMacModuleConfig config;
+    config.ackAppointmentsEnabled = true;
+    Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+    pibAttr->macRitPeriodTime = Time(Seconds(1));
+    for (const auto& device : {senderDevice, receiverDevice})
+    {
+        device->GetMac()->SetModuleConfig(config);
+        device->GetMac()->MlmeSetRequest(macRitPeriodTime, pibAttr);
+    }
+    senderDevice->GetMac()->TraceConnectWithoutContext(
+        "MacMode",
+        MakeCallback(&RitAppointmentWakeupTest::ModeChanged, this));
+
+    // The first ACK grants the appointment, the next frames keep it
+    for (double t : {8.0, 20.3, 33.7})
+    {
+        Simulator::ScheduleWithContext(senderNode->GetId(), Seconds(t), [=]() {
+            senderDevice->Send(Create<Packet>(20), Mac16Address("00:00"), 0);
+        });
+    }
+
+    Simulator::Stop(Seconds(40.0));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_nRx, 3, "Not every frame was received");
+    NS_TEST_EXPECT_MSG_EQ(receiverDevice->GetMac()->GetNAppointmentsGranted(),
+                          3,
+                          "One appointment per ACK expected");
+    NS_TEST_EXPECT_MSG_EQ(senderDevice->GetMac()->GetNAppointmentsReceived(),
+                          3,
+                          "Appointments not stored by the sender");
+    NS_TEST_ASSERT_MSG_EQ(m_senderTimes.size(), 3, "Expected one sender cycle per packet");
+    // AppointmentGuard (4 ms) plus twice the drift bound of two clocks (±250 ppm) over
+    // about 13 s, and the data exchange
+    for (size_t i = 1; i < m_senderTimes.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_LT(m_senderTimes[i],
+                              MilliSeconds(40),
+                              "Sender not woken around the appointed beacon");
+    }
+
+    Simulator::Destroy();
+}
+
+class RitAppointmentTestSuite : public TestSuite
+{
+  public:
+    RitAppointmentTestSuite();
+};
+
+RitAppointmentTestSuite::RitAppointmentTestSuite()
+    : TestSuite("rit-appointment", Type::UNIT)
+{
+    AddTestCase(new RitAppointmentHeaderTest, Duration::QUICK);
+    AddTestCase(new RitAppointmentWakeupTest, Duration::QUICK);
+}
+
+static RitAppointmentTestSuite g_ritAppointmentTestSuite;
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/core-module.h>
+#include <ns3/log.h>
+#include <ns3/lr-wpan-phy.h>
+#include <ns3/network-module.h>
+#include <ns3/packet.h>
+#include <ns3/propagation-delay-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/rit-wpan-mac.h>
+#include <ns3/rit-wpan-net-device.h>
+#include <ns3/single-model-spectrum-channel.h>
+#include <ns3/test.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-beacon-deconfliction-test");
+
+/**
+ * @brief Check that two neighbours whose beacons start 5 ms apart end up apart: the node
+ *        with the larger address moves once, into the middle of the free period, and the
+ *        other keeps its phase. Without the module the beacons stay 5 ms apart.
+ */
+class RitBeaconDeconflictionTest : public TestCase
+{
+  public:
+    RitBeaconDeconflictionTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Run the two neighbours.
+     * @param enabled beaconDeconflictionEnabled of both nodes
+     * @param shifts Beacon phase shifts of the node with the larger address, then the other
+     * @return the separation of their last beacons within the period
+     */
+    Time Run(bool enabled, std::vector<uint64_t>& shifts);
+};
+
+RitBeaconDeconflictionTest::RitBeaconDeconflictionTest()
+    : TestCase("Beacon phases of two neighbours moved apart")
+{
+}
+
+Time
+RitBeaconDeconflictionTest::Run(bool enabled, std::vector<uint64_t>& shifts)
+{
+    RitWpanMacModuleConfig config;
+    config.beaconDeconflictionEnabled = enabled;
+    const Time period = Seconds(1);
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    // 00:02 starts its cycle first, 00:01 5 ms later: 00:02 hears the beacon of 00:01 in its
+    // data wait. Both draw their initial phase from the same stream, hence the same delay.
+    std::vector<Ptr<RitWpanNetDevice>> devices;
+    std::vector<std::vector<Time>> beacons(2);
+    for (uint16_t i = 0; i < 2; i++)
+    {
+        Ptr<Node> node = CreateObject<Node>();
+        Ptr<RitWpanNetDevice> device = CreateObject<RitWpanNetDevice>();
+        device->SetChannel(channel);
+        device->SetAddress(Mac16Address(static_cast<uint16_t>(2 - i)));
+        node->AddDevice(device);
+        device->SetRitRank(1);
+        device->AssignStreams(0);
+        device->GetMac()->SetModuleConfig(config);
+        // Without traffic, every frame sent is a beacon
+        std::vector<Time>* times = &beacons[i];
+        device->GetPhy()->TraceConnectWithoutContext(
+            "PhyTxBegin",
+            Callback<void, Ptr<const Packet>>(
+                [times](Ptr<const Packet>) { times->push_back(Simulator::Now()); }));
+        Ptr<RitWpanMac> mac = device->GetMac();
+        Simulator::ScheduleWithContext(node->GetId(), MilliSeconds(5 * i), [mac, period]() {
+            mac->SetRitTimes(period, MilliSeconds(10), Seconds(5));
+        });
+        devices.push_back(device);
+    }
+
+    Simulator::Stop(Seconds(30));
+    Simulator::Run();
+
+    shifts = {devices[0]->GetMac()->GetNBeaconPhaseShifts(),
+              devices[1]->GetMac()->GetNBeaconPhaseShifts()};
+    Simulator::Destroy();
+
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(beacons[0].size(), 25, "Beacons of 00:02 missing");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(beacons[1].size(), 25, "Beacons of 00:01 missing");
+    if (beacons[0].empty() || beacons[1].empty())
+    {
+        return Time();
+    }
+    NS_TEST_EXPECT_MSG_LT(Abs(beacons[1].front() - beacons[0].front() - MilliSeconds(5)),
+                          MicroSeconds(10),
+                          "First beacons not 5 ms apart");
+    const Time diff = Abs(beacons[0].back() - beacons[1].back()) % period;
+    return std::min(diff, period - diff);
+}
+
+void
+RitBeaconDeconflictionTest::DoRun()
+{
+    std::vector<uint64_t> shifts;
+    const Time apartOff = Run(false, shifts);
+    NS_TEST_EXPECT_MSG_EQ(shifts[0] + shifts[1], 0, "Beacon moved with the module off");
+    NS_TEST_EXPECT_MSG_LT(apartOff, MilliSeconds(20), "Beacons drifted apart on their own");
+
+    const Time apartOn = Run(true, shifts);
+    NS_TEST_EXPECT_MSG_EQ(shifts[0], 1, "00:02 did not move exactly once");
+    NS_TEST_EXPECT_MSG_EQ(shifts[1], 0, "00:01 (smaller address) moved");
+    // Moved to the middle of the gap left by the only neighbour beacon
+    NS_TEST_EXPECT_MSG_GT(apartOn, MilliSeconds(400), "Beacons still close after the move");
+}
+
+class RitBeaconDeconflictionTestSuite : public TestSuite
+{
+  public:
+    RitBeaconDeconflictionTestSuite();
+};
+
+RitBeaconDeconflictionTestSuite::RitBeaconDeconflictionTestSuite()
+    : TestSuite("rit-beacon-deconfliction", Type::UNIT)
+{
+    AddTestCase(new RitBeaconDeconflictionTest, Duration::QUICK);
+}
+
+static RitBeaconDeconflictionTestSuite g_ritBeaconDeconflictionTestSuite;
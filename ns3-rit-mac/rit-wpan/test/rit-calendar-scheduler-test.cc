@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/log.h>
+#include <ns3/nstime.h>
+#include <ns3/object-factory.h>
+#include <ns3/rit-calendar-scheduler.h>
+#include <ns3/simulator.h>
+#include <ns3/test.h>
+
+#include <cstdint>
+#include <iterator>
+#include <set>
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-calendar-scheduler-test");
+
+/**
+ * @brief Check the order of RitCalendarScheduler against a sorted reference under
+ *        random inserts, removals and resizes, for a few bucket widths.
+ */
+class RitCalendarSchedulerOrderTest : public TestCase
+{
+  public:
+    RitCalendarSchedulerOrderTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Run the random sequence with one bucket width.
+     * @param width The BucketWidth attribute (0 for the automatic width)
+     */
+    void RunWidth(Time width);
+};
+
+RitCalendarSchedulerOrderTest::RitCalendarSchedulerOrderTest()
+    : TestCase("Calendar scheduler order under inserts, removals and resizes")
+{
+}
+
+void
+RitCalendarSchedulerOrderTest::RunWidth(Time width)
+{
+    Ptr<RitCalendarScheduler> scheduler = CreateObject<RitCalendarScheduler>();
+    scheduler->SetAttribute("BucketWidth", TimeValue(width));
+
+    auto less = [](const Scheduler::Event& a, const Scheduler::Event& b) { return a < b; };
+    std::set<Scheduler::Event, decltype(less)> reference(less);
+    uint64_t lcg = 12345;
+    auto next = [&lcg]() {
+        lcg = lcg * 6364136223846793005ULL + 1442695040888963407ULL;
+        return lcg >> 33;
+    };
+
+    uint64_t now = 0;
+    uint32_t uid = 0;
+    for (uint32_t step = 0; step < 20000; step++)
+    {
+        const uint64_t r = next() % 10;
+        if (r < 5 || reference.empty())
+        {
+            // Mostly periodic offsets, with a few far timers and ties
+            const uint64_t offsets[] = {0, 5000, 10000, 15000, 2000000, 5000000000ULL};
+            Scheduler::Event ev;
+            ev.impl = nullptr;
+            ev.key.m_ts = now + offsets[next() % 6] + (next() % 3) * 100;
+            ev.key.m_uid = uid++;
+            ev.key.m_context = 0;
+            scheduler->Insert(ev);
+            reference.insert(ev);
+        }
+        else if (r < 8)
+        {
+            const Scheduler::Event expected = *reference.begin();
+            reference.erase(reference.begin());
+            NS_TEST_ASSERT_MSG_EQ(scheduler->PeekNext().key.m_uid,
+                                  expected.key.m_uid,
+                                  "Wrong next event at step " << step);
+            const Scheduler::Event ev = scheduler->RemoveNext();
+            NS_TEST_ASSERT_MSG_EQ(ev.key.m_uid, expected.key.m_uid, "Wrong removed event");
+            now = ev.key.m_ts;
+        }
+        else
+        {
+            // Cancel a pending event
+            auto it = reference.begin();
+            std::advance(it, next() % reference.size());
+            scheduler->Remove(*it);
+            reference.erase(it);
+        }
+        NS_TEST_ASSERT_MSG_EQ(scheduler->IsEmpty(), reference.empty(), "Wrong emptiness");
+    }
+
+    while (!reference.empty())
+    {
+        NS_TEST_ASSERT_MSG_EQ(scheduler->RemoveNext().key.m_uid,
+                              reference.begin()->key.m_uid,
+                              "Wrong order while draining");
+        reference.erase(reference.begin());
+    }
+    NS_TEST_ASSERT_MSG_EQ(scheduler->IsEmpty(), true, "Events left");
+}
+
+void
+RitCalendarSchedulerOrderTest::DoRun()
+{
+    RitCalendarScheduler::ResetPeriodicSources();
+    RunWidth(Seconds(0));
+    RunWidth(NanoSeconds(1));
+    RunWidth(MicroSeconds(7));
+    RunWidth(Seconds(1));
+    RitCalendarScheduler::AddPeriodicSource(MilliSeconds(5));
+    RunWidth(Seconds(0));
+    RitCalendarScheduler::ResetPeriodicSources();
+}
+
+/**
+ * @brief Check a simulation run on RitCalendarScheduler: periodic timers, a
+ *        cancellation and the bucket width derived from the beacon rate.
+ */
+class RitCalendarSchedulerSimulatorTest : public TestCase
+{
+  public:
+    RitCalendarSchedulerSimulatorTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief A periodic timer of one node.
+     * @param id Timer id
+     */
+    void Tick(uint32_t id);
+
+    std::vector<std::pair<uint32_t, Time>> m_ticks; //!< Timer ids and times
+};
+
+RitCalendarSchedulerSimulatorTest::RitCalendarSchedulerSimulatorTest()
+    : TestCase("Simulation on the calendar scheduler")
+{
+}
+
+void
+RitCalendarSchedulerSimulatorTest::Tick(uint32_t id)
+{
+    m_ticks.emplace_back(id, Simulator::Now());
+    if (Simulator::Now() < MilliSeconds(50))
+    {
+        Simulator::Schedule(MilliSeconds(5), &RitCalendarSchedulerSimulatorTest::Tick, this, id);
+    }
+}
+
+void
+RitCalendarSchedulerSimulatorTest::DoRun()
+{
+    RitCalendarScheduler::ResetPeriodicSources();
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        RitCalendarScheduler::AddPeriodicSource(MilliSeconds(5));
+    }
+    ObjectFactory factory("ns3::lrwpan::RitCalendarScheduler");
+    Simulator::SetScheduler(factory);
+
+    for (uint32_t id = 0; id < 100; id++)
+    {
+        Simulator::Schedule(MicroSeconds(37 * id),
+                            &RitCalendarSchedulerSimulatorTest::Tick,
+                            this,
+                            id);
+    }
+    EventId cancelled =
+        Simulator::Schedule(MilliSeconds(20), &RitCalendarSchedulerSimulatorTest::Tick, this, 999);
+    cancelled.Cancel();
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_ticks.size(), 100 * 11, "Wrong number of ticks");
+    for (size_t i = 1; i < m_ticks.size(); i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ((m_ticks[i].second >= m_ticks[i - 1].second),
+                              true,
+                              "Ticks out of order at " << i);
+        NS_TEST_ASSERT_MSG_NE(m_ticks[i].first, 999, "Cancelled event executed");
+    }
+    // Ties run in scheduling order: the timers of one round keep their order.
+    NS_TEST_EXPECT_MSG_EQ(m_ticks[100].first, 0, "Wrong order of the second round");
+    NS_TEST_EXPECT_MSG_EQ(m_ticks[100].second, MilliSeconds(5), "Wrong time of the second round");
+
+    Simulator::Destroy();
+    RitCalendarScheduler::ResetPeriodicSources();
+
+    // One beacon every 50 us: buckets of 150 us
+    Ptr<RitCalendarScheduler> scheduler = CreateObject<RitCalendarScheduler>();
+    RitCalendarScheduler::AddPeriodicSource(MicroSeconds(50));
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        Scheduler::Event ev{nullptr, {i * 1000ULL, i, 0}};
+        scheduler->Insert(ev);
+    }
+    NS_TEST_EXPECT_MSG_EQ_TOL(scheduler->GetBucketWidth().GetMicroSeconds(),
+                              150,
+                              1,
+                              "Width not derived from the beacon rate");
+    NS_TEST_EXPECT_MSG_GT(scheduler->GetNBuckets(), 2, "Ring not grown");
+    RitCalendarScheduler::ResetPeriodicSources();
+}
+
+class RitCalendarSchedulerTestSuite : public TestSuite
+{
+  public:
+    RitCalendarSchedulerTestSuite();
+};
+
+RitCalendarSchedulerTestSuite::RitCalendarSchedulerTestSuite()
+    : TestSuite("rit-calendar-scheduler", Type::UNIT)
+{
+    AddTestCase(new RitCalendarSchedulerOrderTest, Duration::QUICK);
+    AddTestCase(new RitCalendarSchedulerSimulatorTest, Duration::QUICK);
+}
+
+static RitCalendarSchedulerTestSuite g_ritCalendarSchedulerTestSuite;
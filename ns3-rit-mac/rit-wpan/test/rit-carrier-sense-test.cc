@@ -0,0 +1,390 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/core-module.h>
+#include <ns3/log.h>
+#include <ns3/network-module.h>
+#include <ns3/packet.h>
+#include <ns3/propagation-delay-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/rit-carrier-sense.h>
+#include <ns3/rit-wpan-mac.h>
+#include <ns3/rit-wpan-net-device.h>
+#include <ns3/rit-wpan-precs.h>
+#include <ns3/single-model-spectrum-channel.h>
+
+#include <string>
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-carrier-sense-test");
+
+/**
+ * @brief Check that the module flags select the carrier-sense stages, that a stage
+ *        plugged in after the configuration replaces them, and that every stage counts
+ *        its accesses and CCAs.
+ */
+class RitCarrierSensePipelineTest : public TestCase
+{
+  public:
+    RitCarrierSensePipelineTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Receive callback of the receiver.
+     * @param dev The device
+     * @param pkt The packet
+     * @param proto The protocol
+     * @param addr The sender address
+     * @return true
+     */
+    bool DataIndication(Ptr<NetDevice> dev,
+                        Ptr<const Packet> pkt,
+                        uint16_t proto,
+                        const Address& addr);
+
+    uint32_t m_nRx{0}; //!< Frames received
+};
+
+RitCarrierSensePipelineTest::RitCarrierSensePipelineTest()
+    : TestCase("Carrier-sense stages selected by the module flags or plugged in")
+{
+}
+
+bool
+RitCarrierSensePipelineTest::DataIndication(Ptr<NetDevice> dev,
+                                            Ptr<const Packet> pkt,
+                                            uint16_t proto,
+                                            const Address& addr)
+{
+    m_nRx++;
+    return true;
+}
+
+void
+RitCarrierSensePipelineTest::DoRun()
+{
+    Ptr<Node> receiverNode = CreateObject<Node>();
+    Ptr<Node> senderNode = CreateObject<Node>();
+    Ptr<RitWpanNetDevice> receiverDevice = CreateObject<RitWpanNetDevice>();
+    Ptr<RitWpanNetDevice> senderDevice = CreateObject<RitWpanNetDevice>();
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+    receiverDevice->SetChannel(channel);
+    senderDevice->SetChannel(channel);
+
+    receiverDevice->SetAddress(Mac16Address("00:00"));
+    receiverDevice->SetRitRank(0);
+    senderDevice->SetAddress(Mac16Address("00:01"));
+    senderDevice->SetRitRank(1);
+    receiverNode->AddDevice(receiverDevice);
+    senderNode->AddDevice(senderDevice);
+    receiverDevice->SetReceiveCallback(
+        MakeCallback(&RitCarrierSensePipelineTest::DataIndication, this));
+
+    RitWpanMacModuleConfig config;
+    config.beaconCsmaEnabled = true;
+    config.dataPreCsEnabled = true;
+    Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+    pibAttr->macRitPeriodTime = Time(Seconds(1));
+    for (const auto& device : {senderDevice, receiverDevice})
+    {
+        device->GetMac()->SetModuleConfig(config);
+        device->GetMac()->MlmeSetRequest(macRitPeriodTime, pibAttr);
+    }
+
+    Ptr<RitCarrierSensePipeline> senderCs = senderDevice->GetCarrierSense();
+    Ptr<RitCarrierSense> senderCsma = senderCs->GetStage(RitCarrierSensePipeline::CSMA_CA_STAGE);
+    Ptr<RitCarrierSense> senderPreCs = senderCs->GetStage(RitCarrierSensePipeline::PRE_CS_STAGE);
+    NS_TEST_ASSERT_MSG_EQ(static_cast<bool>(senderCsma), true, "No CSMA/CA stage");
+    NS_TEST_ASSERT_MSG_EQ(static_cast<bool>(senderPreCs), true, "No Pre-CS stage");
+    NS_TEST_EXPECT_MSG_EQ(senderCs->GetSelected(RIT_CS_BEACON_FRAME),
+                          senderCsma,
+                          "beaconCsmaEnabled did not select CSMA/CA");
+    NS_TEST_EXPECT_MSG_EQ(senderCs->GetSelected(RIT_CS_DATA_FRAME),
+                          senderPreCs,
+                          "dataPreCsEnabled did not select Pre-CS");
+
+    // The beacons of the receiver go through a stage the MAC does not know.
+    Ptr<RitCarrierSensePipeline> receiverCs = receiverDevice->GetCarrierSense();
+    Ptr<RitWpanCachedPreCs> cached = CreateObject<RitWpanCachedPreCs>();
+    receiverCs->AddStage("cached-pre-cs", cached);
+    receiverCs->Select(RIT_CS_BEACON_FRAME, cached);
+
+    Simulator::ScheduleWithContext(senderNode->GetId(), Seconds(8.0), [=]() {
+        senderDevice->Send(Create<Packet>(30), Mac16Address("00:00"), 0);
+    });
+
+    Simulator::Stop(Seconds(12.0));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_nRx, 1, "The frame sent after Pre-CS was not received");
+
+    // Pre-CS: one CCA of 8 symbols (128 us at 250 kb/s) per access, and nothing more.
+    const RitCarrierSenseStats& preCs = senderPreCs->GetStats();
+    NS_TEST_EXPECT_MSG_GT(preCs.nAccesses, 0, "The data frame was not sent after Pre-CS");
+    NS_TEST_EXPECT_MSG_EQ(preCs.nCca, preCs.nAccesses, "Pre-CS is a single CCA");
+    NS_TEST_EXPECT_MSG_EQ(preCs.nFailures, 0, "Busy channel without other traffic");
+    NS_TEST_EXPECT_MSG_EQ(preCs.rxOnTime,
+                          MicroSeconds(128) * preCs.nCca,
+                          "Wrong sensing time of Pre-CS");
+    NS_TEST_EXPECT_MSG_EQ(preCs.addedDelay, preCs.rxOnTime, "Pre-CS only adds its CCA");
+
+    const RitCarrierSenseStats& csma = senderCsma->GetStats();
+    NS_TEST_EXPECT_MSG_GT(csma.nAccesses, 0, "The beacons were not sent after CSMA/CA");
+    NS_TEST_EXPECT_MSG_GT(csma.nCca, 0, "CCAs of CSMA/CA not counted");
+    NS_TEST_EXPECT_MSG_GT(csma.addedDelay, csma.rxOnTime, "CSMA/CA backoffs not counted");
+
+    NS_TEST_EXPECT_MSG_GT(cached->GetStats().nAccesses, 0, "The plugged stage was not run");
+    NS_TEST_EXPECT_MSG_EQ(cached->GetNCacheHits(), 0, "Busy channel without other traffic");
+    NS_TEST_EXPECT_MSG_EQ(receiverCs->GetStage(RitCarrierSensePipeline::CSMA_CA_STAGE)
+                              ->GetStats()
+                              .nAccesses,
+                          0,
+                          "The replaced stage still ran");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @brief Check that RitWpanCachedPreCs fails an access without CCA while a busy CCA is
+ *        remembered, and runs its CCA once the hold expired or an idle CCA was seen.
+ */
+class RitCachedPreCsTest : public TestCase
+{
+  public:
+    RitCachedPreCsTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Result callback of the stage.
+     * @param state The result
+     */
+    void AccessResult(MacState state);
+
+    std::vector<MacState> m_results; //!< Results reported
+    std::vector<Time> m_resultTimes; //!< Times of the results
+};
+
+RitCachedPreCsTest::RitCachedPreCsTest()
+    : TestCase("Pre-CS with a cached busy channel")
+{
+}
+
+void
+RitCachedPreCsTest::AccessResult(MacState state)
+{
+    m_results.push_back(state);
+    m_resultTimes.push_back(Simulator::Now());
+}
+
+void
+RitCachedPreCsTest::DoRun()
+{
+    Ptr<Node> node = CreateObject<Node>();
+    Ptr<RitWpanNetDevice> device = CreateObject<RitWpanNetDevice>();
+    device->SetChannel(CreateObject<SingleModelSpectrumChannel>());
+    device->SetAddress(Mac16Address("00:01"));
+    node->AddDevice(device);
+
+    Ptr<RitWpanCachedPreCs> cached = CreateObject<RitWpanCachedPreCs>();
+    cached->SetAttribute("BusyHoldTime", TimeValue(MilliSeconds(5)));
+    device->GetCarrierSense()->AddStage("cached-pre-cs", cached);
+    cached->SetLrWpanMacStateCallback(MakeCallback(&RitCachedPreCsTest::AccessResult, this));
+
+    Simulator::Schedule(Seconds(1), [=]() {
+        cached->NotifyChannelAssessed(IEEE_802_15_4_PHY_BUSY);
+        cached->Start();
+    });
+    Simulator::Schedule(Seconds(1.004), &RitCarrierSense::Start, cached);
+    // Hold expired: a real CCA
+    Simulator::Schedule(Seconds(1.010), &RitCarrierSense::Start, cached);
+    // An idle CCA forgets the busy one
+    Simulator::Schedule(Seconds(1.020), [=]() {
+        cached->NotifyChannelAssessed(IEEE_802_15_4_PHY_BUSY);
+        cached->NotifyChannelAssessed(IEEE_802_15_4_PHY_IDLE);
+        cached->Start();
+    });
+    // A canceled access reports nothing
+    Simulator::Schedule(Seconds(1.030), [=]() {
+        cached->NotifyChannelAssessed(IEEE_802_15_4_PHY_BUSY);
+        cached->Start();
+        cached->Cancel();
+    });
+    Simulator::Stop(Seconds(2));
+    Simulator::Run();
+
+    const RitCarrierSenseStats& stats = cached->GetStats();
+    NS_TEST_EXPECT_MSG_EQ(stats.nAccesses, 5, "Wrong number of accesses");
+    NS_TEST_EXPECT_MSG_EQ(cached->GetNCacheHits(), 3, "Wrong number of cache hits");
+    NS_TEST_EXPECT_MSG_EQ(stats.nCca, 2, "CCA not skipped, or not run after the hold");
+    NS_TEST_ASSERT_MSG_EQ(m_results.size(), 4, "Wrong number of results");
+    NS_TEST_EXPECT_MSG_EQ(m_results[0], CHANNEL_ACCESS_FAILURE, "Busy channel forgotten");
+    NS_TEST_EXPECT_MSG_EQ(m_resultTimes[0], Seconds(1), "Cache hit not reported at once");
+    NS_TEST_EXPECT_MSG_EQ(m_results[1], CHANNEL_ACCESS_FAILURE, "Busy channel forgotten");
+    NS_TEST_EXPECT_MSG_EQ(m_resultTimes[1], Seconds(1.004), "Cache hit not reported at once");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(m_resultTimes[2], Seconds(1.010), "Result before the CCA");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @brief Check that the data wait probe ends the data waits nobody answers, right after
+ *        the latest start of a response behind Pre-CS, and keeps the one a sender answers.
+ */
+class RitDataWaitProbeTest : public TestCase
+{
+  public:
+    RitDataWaitProbeTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Receive callback of the receiver.
+     * @param dev The device
+     * @param pkt The packet
+     * @param proto The protocol
+     * @param addr The sender address
+     * @return true
+     */
+    bool DataIndication(Ptr<NetDevice> dev,
+                        Ptr<const Packet> pkt,
+                        uint16_t proto,
+                        const Address& addr);
+
+    /**
+     * @brief Data wait events of the receiver.
+     * @param event The event
+     * @param time Time of the event
+     */
+    void DataWaitEvent(std::string event, Time time);
+
+    uint32_t m_nRx{0};        //!< Frames received
+    uint32_t m_nStarts{0};    //!< Data waits started
+    uint32_t m_nProbeIdle{0}; //!< Data waits ended by the probe
+    Time m_lastStart;         //!< Start of the last data wait
+    Time m_longestShortened;  //!< Longest data wait ended by the probe
+};
+
+RitDataWaitProbeTest::RitDataWaitProbeTest()
+    : TestCase("Data wait ended early by an idle energy probe")
+{
+}
+
+bool
+RitDataWaitProbeTest::DataIndication(Ptr<NetDevice> dev,
+                                     Ptr<const Packet> pkt,
+                                     uint16_t proto,
+                                     const Address& addr)
+{
+    m_nRx++;
+    return true;
+}
+
+void
+RitDataWaitProbeTest::DataWaitEvent(std::string event, Time time)
+{
+    if (event == "start")
+    {
+        m_nStarts++;
+        m_lastStart = time;
+    }
+    else if (event == "probe-idle")
+    {
+        m_nProbeIdle++;
+        m_longestShortened = Max(m_longestShortened, time - m_lastStart);
+    }
+}
+
+void
+RitDataWaitProbeTest::DoRun()
+{
+    Ptr<Node> receiverNode = CreateObject<Node>();
+    Ptr<Node> senderNode = CreateObject<Node>();
+    Ptr<RitWpanNetDevice> receiverDevice = CreateObject<RitWpanNetDevice>();
+    Ptr<RitWpanNetDevice> senderDevice = CreateObject<RitWpanNetDevice>();
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+    receiverDevice->SetChannel(channel);
+    senderDevice->SetChannel(channel);
+
+    receiverDevice->SetAddress(Mac16Address("00:00"));
+    receiverDevice->SetRitRank(0);
+    senderDevice->SetAddress(Mac16Address("00:01"));
+    senderDevice->SetRitRank(1);
+    receiverNode->AddDevice(receiverDevice);
+    senderNode->AddDevice(senderDevice);
+    receiverDevice->SetReceiveCallback(MakeCallback(&RitDataWaitProbeTest::DataIndication, this));
+    receiverDevice->GetMac()->TraceConnectWithoutContext(
+        "DataWaitEvent",
+        MakeCallback(&RitDataWaitProbeTest::DataWaitEvent, this));
+
+    RitWpanMacModuleConfig config;
+    config.dataPreCsEnabled = true;
+    config.dataWaitProbeEnabled = true;
+    Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+    pibAttr->macRitPeriodTime = Time(Seconds(1));
+    for (const auto& device : {senderDevice, receiverDevice})
+    {
+        device->GetMac()->SetModuleConfig(config);
+        device->GetMac()->MlmeSetRequest(macRitPeriodTime, pibAttr);
+    }
+
+    // Behind Pre-CS: turnaround (12 symbols) and CCA (8 symbols) at 16 us, then the guard
+    Ptr<RitWpanMac> receiverMac = receiverDevice->GetMac();
+    NS_TEST_EXPECT_MSG_EQ(receiverMac->GetDataWaitProbeDelay(),
+                          MicroSeconds(320 + 320),
+                          "Wrong probe delay behind Pre-CS");
+
+    Simulator::ScheduleWithContext(senderNode->GetId(), Seconds(8.0), [=]() {
+        senderDevice->Send(Create<Packet>(30), Mac16Address("00:00"), 0);
+    });
+
+    Simulator::Stop(Seconds(12.0));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_nRx, 1, "The answer to the beacon was cut off by the probe");
+    NS_TEST_EXPECT_MSG_GT(m_nProbeIdle, 0, "No data wait ended by the probe");
+    NS_TEST_EXPECT_MSG_LT(m_nProbeIdle, m_nStarts, "The answered data wait was ended too");
+    NS_TEST_EXPECT_MSG_EQ(receiverMac->GetNDataWaitProbeShortcuts(),
+                          m_nProbeIdle,
+                          "Shortcuts not counted");
+    // The probe ends its energy detection (8 symbols) after the probe delay.
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(m_longestShortened,
+                                MicroSeconds(640 + 128),
+                                "Data wait not ended right after the probe");
+
+    Simulator::Destroy();
+}
+
+class RitCarrierSenseTestSuite : public TestSuite
+{
+  public:
+    RitCarrierSenseTestSuite();
+};
+
+RitCarrierSenseTestSuite::RitCarrierSenseTestSuite()
+    : TestSuite("rit-carrier-sense", Type::UNIT)
+{
+    AddTestCase(new RitCarrierSensePipelineTest, Duration::QUICK);
+    AddTestCase(new RitCachedPreCsTest, Duration::QUICK);
+    AddTestCase(new RitDataWaitProbeTest, Duration::QUICK);
+}
+
+static RitCarrierSenseTestSuite g_ritCarrierSenseTestSuite;
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/core-module.h>
+#include <ns3/log.h>
+#include <ns3/network-module.h>
+#include <ns3/packet.h>
+#include <ns3/propagation-delay-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/rit-checkpoint-helper.h>
+#include <ns3/rit-wpan-mac.h>
+#include <ns3/rit-wpan-net-device.h>
+#include <ns3/rit-wpan-nwk.h>
+#include <ns3/single-model-spectrum-channel.h>
+#include <ns3/test.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-checkpoint-test");
+
+/**
+ * @brief Check that a network restored from a checkpoint continues with the
+ *        saved routing and MAC state instead of bootstrapping again.
+ */
+class RitCheckpointRestoreTest : public TestCase
+{
+  public:
+    RitCheckpointRestoreTest();
+
+  private:
+    /**
+     * @brief Count the packets delivered at the sink.
+     * @param dev The device
+     * @param pkt The packet
+     * @param proto The protocol number
+     * @param addr The source address
+     * @return true
+     */
+    bool DataIndication(Ptr<NetDevice> dev,
+                        Ptr<const Packet> pkt,
+                        uint16_t proto,
+                        const Address& addr);
+
+    /**
+     * @brief Count the bootstraps.
+     * @param rank Rank taken
+     * @param parent Parent chosen
+     * @param elapsed Duration of the bootstrap
+     */
+    void Bootstrapped(uint16_t rank, Mac16Address parent, Time elapsed);
+
+    /**
+     * @brief Create a sink (00:00) and two routers, all in range.
+     * @param reversed Create the devices in the reverse address order
+     * @return the nodes, in creation order
+     */
+    NodeContainer CreateNetwork(bool reversed);
+
+    /**
+     * @brief Find the device of a short address.
+     * @param nodes The nodes
+     * @param addr Short address
+     * @return the device
+     */
+    static Ptr<RitWpanNetDevice> FindDevice(NodeContainer nodes, Mac16Address addr);
+
+    void DoRun() override;
+
+    uint32_t m_nSinkRx{0};     //!< Packets delivered at the sink
+    uint32_t m_nBootstraps{0}; //!< Bootstraps completed
+};
+
+RitCheckpointRestoreTest::RitCheckpointRestoreTest()
+    : TestCase("Warm-up checkpoint saved and restored")
+{
+}
+
+bool
+RitCheckpointRestoreTest::DataIndication(Ptr<NetDevice> dev,
+                                         Ptr<const Packet> pkt,
+                                         uint16_t proto,
+                                         const Address& addr)
+{
+    m_nSinkRx++;
+    return true;
+}
+
+void
+RitCheckpointRestoreTest::Bootstrapped(uint16_t rank, Mac16Address parent, Time elapsed)
+{
+    m_nBootstraps++;
+}
+
+NodeContainer
+RitCheckpointRestoreTest::CreateNetwork(bool reversed)
+{
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    NodeContainer nodes;
+    Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+    pibAttr->macRitPeriodTime = Time(Seconds(1));
+    for (uint16_t i = 0; i < 3; i++)
+    {
+        const uint16_t addr = reversed ? 2 - i : i;
+        Ptr<Node> node = CreateObject<Node>();
+        Ptr<RitWpanNetDevice> device = CreateObject<RitWpanNetDevice>();
+        device->SetChannel(channel);
+        device->SetAddress(Mac16Address(addr));
+        node->AddDevice(device);
+        device->SetRitRank(0);
+        device->GetMac()->MlmeSetRequest(macRitPeriodTime, pibAttr);
+        device->GetNwk()->TraceConnectWithoutContext(
+            "NwkBootstrap",
+            MakeCallback(&RitCheckpointRestoreTest::Bootstrapped, this));
+        if (addr == 0)
+        {
+            device->SetReceiveCallback(
+                MakeCallback(&RitCheckpointRestoreTest::DataIndication, this));
+        }
+        nodes.Add(node);
+    }
+    return nodes;
+}
+
+Ptr<RitWpanNetDevice>
+RitCheckpointRestoreTest::FindDevice(NodeContainer nodes, Mac16Address addr)
+{
+    for (uint32_t i = 0; i < nodes.GetN(); i++)
+    {
+        Ptr<RitWpanNetDevice> dev = DynamicCast<RitWpanNetDevice>(nodes.Get(i)->GetDevice(0));
+        if (dev->GetMac()->GetShortAddress() == addr)
+        {
+            return dev;
+        }
+    }
+    return nullptr;
+}
+
+void
+RitCheckpointRestoreTest::DoRun()
+{
+    const std::string path = CreateTempDirFilename("rit-checkpoint.csv");
+    const std::vector<Mac16Address> routers{Mac16Address("00:01"), Mac16Address("00:02")};
+
+    // Warm-up: the routers bootstrap, then the state is saved at 6 s
+    NodeContainer nodes = CreateNetwork(false);
+    for (const auto& addr : routers)
+    {
+        Ptr<RitWpanNetDevice> dev = FindDevice(nodes, addr);
+        Simulator::ScheduleWithContext(dev->GetNode()->GetId(),
+                                       Seconds(0.5),
+                                       &RitSimpleRouting::Bootstrap,
+                                       dev->GetNwk());
+    }
+    RitCheckpointHelper checkpointHelper;
+    checkpointHelper.ScheduleSave(nodes, Seconds(6), path);
+    std::map<Mac16Address, RitNwkCheckpoint> nwkSaved;
+    std::map<Mac16Address, RitMacCheckpoint> macSaved;
+    Simulator::Schedule(Seconds(6), [&]() {
+        for (const auto& addr : routers)
+        {
+            Ptr<RitWpanNetDevice> dev = FindDevice(nodes, addr);
+            nwkSaved[addr] = dev->GetNwk()->GetCheckpoint();
+            macSaved[addr] = dev->GetMac()->GetCheckpoint();
+        }
+    });
+    Simulator::Stop(Seconds(6.5));
+    Simulator::Run();
+    Simulator::Destroy();
+    NS_TEST_ASSERT_MSG_EQ(m_nBootstraps, 2, "Warm-up bootstrap not completed");
+
+    // Restored network, built in the other order and never bootstrapped
+    m_nBootstraps = 0;
+    nodes = CreateNetwork(true);
+    NS_TEST_ASSERT_MSG_EQ(checkpointHelper.Restore(nodes, path), 3, "Wrong number restored");
+
+    for (const auto& addr : routers)
+    {
+        Ptr<RitWpanNetDevice> dev = FindDevice(nodes, addr);
+        const RitNwkCheckpoint nwk = dev->GetNwk()->GetCheckpoint();
+        const RitMacCheckpoint mac = dev->GetMac()->GetCheckpoint();
+        NS_TEST_EXPECT_MSG_EQ(nwk.rank, 1, "Rank not restored");
+        NS_TEST_EXPECT_MSG_EQ(dev->GetNwk()->GetParent(), Mac16Address("00:00"), "Wrong parent");
+        NS_TEST_ASSERT_MSG_EQ(nwk.neighbours.size(),
+                              nwkSaved[addr].neighbours.size(),
+                              "Neighbour table not restored");
+        for (size_t i = 0; i < nwk.neighbours.size(); i++)
+        {
+            const RitNeighbour& saved = nwkSaved[addr].neighbours[i];
+            NS_TEST_EXPECT_MSG_EQ(nwk.neighbours[i].addr, saved.addr, "Wrong neighbour");
+            NS_TEST_EXPECT_MSG_EQ(nwk.neighbours[i].rank, saved.rank, "Wrong neighbour rank");
+            NS_TEST_EXPECT_MSG_EQ(nwk.neighbours[i].lqi, saved.lqi, "Wrong LQI average");
+            NS_TEST_EXPECT_MSG_EQ(nwk.neighbours[i].lastBeacon,
+                                  saved.lastBeacon,
+                                  "Wrong age of the last beacon");
+        }
+        NS_TEST_EXPECT_MSG_EQ(mac.period, macSaved[addr].period, "RIT period not restored");
+        NS_TEST_EXPECT_MSG_EQ(mac.nextRequest,
+                              macSaved[addr].nextRequest,
+                              "RIT phase not restored");
+        NS_TEST_EXPECT_MSG_EQ_TOL(mac.skewPpm, macSaved[addr].skewPpm, 1e-9, "Wrong skew");
+    }
+
+    Ptr<RitWpanNetDevice> sender = FindDevice(nodes, routers[1]);
+    Simulator::ScheduleWithContext(sender->GetNode()->GetId(), Seconds(1), [=]() {
+        sender->Send(Create<Packet>(20), Mac16Address("00:00"), 0);
+    });
+    Simulator::Stop(Seconds(5));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_EXPECT_MSG_EQ(m_nBootstraps, 0, "Restored routers bootstrapped again");
+    NS_TEST_EXPECT_MSG_EQ(m_nSinkRx, 1, "Packet not delivered after the restore");
+}
+
+class RitCheckpointTestSuite : public TestSuite
+{
+  public:
+    RitCheckpointTestSuite();
+};
+
+RitCheckpointTestSuite::RitCheckpointTestSuite()
+    : TestSuite("rit-checkpoint", Type::UNIT)
+{
+    AddTestCase(new RitCheckpointRestoreTest, Duration::QUICK);
+}
+
+static RitCheckpointTestSuite g_ritCheckpointTestSuite;
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/clock-drift-applier.h>
+#include <ns3/log.h>
+#include <ns3/nstime.h>
+#include <ns3/test.h>
+
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("rit-clock-drift-test");
+
+/**
+ * @brief Check the closed-form clock drift: the offsets do not depend on the order of
+ *        the queries, consecutive intervals add up to the offset, and the skew alone
+ *        gives the linear drift.
+ */
+class RitClockDriftClosedFormTest : public TestCase
+{
+  public:
+    RitClockDriftClosedFormTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Create a closed-form applier.
+     * @param nodeId Node id
+     * @param k Random-walk intensity
+     * @return the applier
+     */
+    Ptr<ClockDriftApplier> MakeApplier(uint32_t nodeId, double k);
+};
+
+RitClockDriftClosedFormTest::RitClockDriftClosedFormTest()
+    : TestCase("Closed-form clock drift offsets")
+{
+}
+
+Ptr<ClockDriftApplier>
+RitClockDriftClosedFormTest::MakeApplier(uint32_t nodeId, double k)
+{
+    Ptr<ClockDriftApplier> drift = CreateObject<ClockDriftApplier>();
+    drift->SetSkewPpm(30.0);
+    drift->SetK(k);
+    drift->SetKnotInterval(Seconds(10));
+    drift->Initialize(nodeId, 1);
+    return drift;
+}
+
+void
+RitClockDriftClosedFormTest::DoRun()
+{
+    // Skew only: the offset is linear in time
+    Ptr<ClockDriftApplier> linear = MakeApplier(3, 0.0);
+    NS_TEST_EXPECT_MSG_EQ_TOL(linear->GetOffset(Seconds(1000)).GetSeconds(),
+                              0.03,
+                              1e-9,
+                              "Wrong skew offset");
+    NS_TEST_EXPECT_MSG_EQ_TOL(linear->ApplyAt(Seconds(500), Seconds(5)).GetSeconds(),
+                              5.00015,
+                              1e-9,
+                              "Wrong interval");
+
+    // Queries in order and out of order give the same offsets
+    const std::vector<double> times = {0.0, 3.0, 17.5, 100.0, 4321.0, 86400.0, 20.0, 0.5};
+    Ptr<ClockDriftApplier> forward = MakeApplier(5, 1e-9);
+    std::vector<Time> offsets;
+    for (double t : times)
+    {
+        offsets.push_back(forward->GetOffset(Seconds(t)));
+    }
+    Ptr<ClockDriftApplier> backward = MakeApplier(5, 1e-9);
+    for (size_t i = times.size(); i-- > 0;)
+    {
+        NS_TEST_EXPECT_MSG_EQ(backward->GetOffset(Seconds(times[i])),
+                              offsets[i],
+                              "Offset depends on the query order at " << times[i] << " s");
+    }
+    NS_TEST_EXPECT_MSG_EQ(forward->GetOffset(Seconds(0)), Seconds(0), "Offset at the origin");
+    NS_TEST_EXPECT_MSG_NE(MakeApplier(6, 1e-9)->GetOffset(Seconds(86400)),
+                          offsets[5],
+                          "Same noise for two nodes");
+
+    // Consecutive beacon intervals add up to the offset change over the run: the local
+    // time elapsed is the number of intervals times the local period.
+    Ptr<ClockDriftApplier> beacons = MakeApplier(7, 1e-9);
+    const Time start = Seconds(1);
+    Time now = start;
+    uint32_t n = 0;
+    for (; now < Seconds(200); n++)
+    {
+        now += beacons->ApplyAt(now, MilliSeconds(50));
+    }
+    const Time local = (now - start) - (beacons->GetOffset(now) - beacons->GetOffset(start));
+    NS_TEST_EXPECT_MSG_EQ_TOL(local.GetSeconds(), n * 0.05, 1e-5, "Intervals do not add up");
+}
+
+class RitClockDriftTestSuite : public TestSuite
+{
+  public:
+    RitClockDriftTestSuite();
+};
+
+RitClockDriftTestSuite::RitClockDriftTestSuite()
+    : TestSuite("rit-clock-drift", Type::UNIT)
+{
+    AddTestCase(new RitClockDriftClosedFormTest, Duration::QUICK);
+}
+
+static RitClockDriftTestSuite g_ritClockDriftTestSuite;
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/core-module.h>
+#include <ns3/log.h>
+#include <ns3/network-module.h>
+#include <ns3/packet.h>
+#include <ns3/propagation-delay-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/rit-wpan-mac.h>
+#include <ns3/rit-wpan-net-device.h>
+#include <ns3/single-model-spectrum-channel.h>
+#include <ns3/test.h>
+
+#include <cmath>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-contention-slots-test");
+
+/**
+ * @brief Check that one beacon serves several senders in distinct response slots: three
+ *        senders waiting for the same sink beacon are received within one data wait, one
+ *        slot or more apart, and more frames get through than without the slots.
+ */
+class RitContentionSlotsTest : public TestCase
+{
+  public:
+    RitContentionSlotsTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Run the scenario with or without contention slots.
+     * @param enabled contentionSlotsEnabled of every node
+     * @return the frames received by the sink
+     */
+    uint32_t Run(bool enabled);
+
+    static constexpr uint32_t N_SLOTS = 8; //!< ContentionSlots of the test
+};
+
+RitContentionSlotsTest::RitContentionSlotsTest()
+    : TestCase("Several senders served per beacon in hashed response slots")
+{
+}
+
+uint32_t
+RitContentionSlotsTest::Run(bool enabled)
+{
+    RitWpanMacModuleConfig config;
+    config.contentionSlotsEnabled = enabled;
+    const Time slot = MilliSeconds(6);
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+    std::vector<Ptr<RitWpanNetDevice>> devices;
+    for (uint16_t i = 0; i < 4; i++)
+    {
+        Ptr<Node> node = CreateObject<Node>();
+        Ptr<RitWpanNetDevice> device = CreateObject<RitWpanNetDevice>();
+        device->SetChannel(channel);
+        device->SetAddress(Mac16Address(i));
+        node->AddDevice(device);
+        device->SetRitRank(i == 0 ? 0 : 1);
+        device->AssignStreams(100 * i);
+        device->GetMac()->SetAttribute("ContentionSlots", UintegerValue(N_SLOTS));
+        device->GetMac()->SetAttribute("ContentionSlotDuration", TimeValue(slot));
+        device->GetMac()->SetModuleConfig(config);
+        device->GetMac()->SetRitTimes(Seconds(1), MilliSeconds(10), Seconds(5));
+        devices.push_back(device);
+    }
+
+    std::vector<std::pair<Time, Mac16Address>> rx;
+    devices[0]->SetReceiveCallback(
+        Callback<bool, Ptr<NetDevice>, Ptr<const Packet>, uint16_t, const Address&>(
+            [&rx](Ptr<NetDevice>, Ptr<const Packet>, uint16_t, const Address& src) {
+                rx.emplace_back(Simulator::Now(), Mac16Address::ConvertFrom(src));
+                return true;
+            }));
+
+    // Every sender has a frame for the same sink beacon, ten times
+    for (uint32_t k = 0; k < 10; k++)
+    {
+        for (uint32_t i = 1; i < devices.size(); i++)
+        {
+            Ptr<RitWpanNetDevice> sender = devices[i];
+            Simulator::ScheduleWithContext(sender->GetNode()->GetId(), Seconds(5 + 3 * k), [=]() {
+                sender->Send(Create<Packet>(20), Mac16Address("00:00"), 0);
+            });
+        }
+    }
+
+    Simulator::Stop(Seconds(40));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    // Receptions of one beacon: closer than the slots plus a data wait
+    const Time span = slot * N_SLOTS + MilliSeconds(10);
+    const double tolerance = MilliSeconds(1).GetSeconds() / slot.GetSeconds();
+    uint32_t nShared = 0;
+    for (size_t first = 0; first < rx.size();)
+    {
+        size_t last = first;
+        std::set<Mac16Address> senders{rx[first].second};
+        while (last + 1 < rx.size() && rx[last + 1].first - rx[first].first < span)
+        {
+            last++;
+            // Same frame length in every slot: the receptions are whole slots apart
+            const double slots = (rx[last].first - rx[last - 1].first).GetSeconds() /
+                                 slot.GetSeconds();
+            NS_TEST_EXPECT_MSG_GT_OR_EQ(std::lround(slots), 1, "Two frames in one slot");
+            NS_TEST_EXPECT_MSG_LT(std::abs(slots - std::lround(slots)),
+                                  tolerance,
+                                  "Reception off the slot grid at " << rx[last].first.As(Time::S));
+            senders.insert(rx[last].second);
+        }
+        NS_TEST_EXPECT_MSG_EQ(senders.size(), last - first + 1, "A sender served twice");
+        if (last > first)
+        {
+            nShared++;
+        }
+        first = last + 1;
+    }
+    if (enabled)
+    {
+        NS_TEST_EXPECT_MSG_GT(nShared, 0, "No beacon served several senders");
+    }
+    else
+    {
+        NS_TEST_EXPECT_MSG_EQ(nShared, 0, "Several senders served without the slots");
+    }
+    return rx.size();
+}
+
+void
+RitContentionSlotsTest::DoRun()
+{
+    const uint32_t nRxOff = Run(false);
+    const uint32_t nRxOn = Run(true);
+    NS_TEST_EXPECT_MSG_GT(nRxOn, nRxOff, "The slots did not resolve the contention");
+}
+
+class RitContentionSlotsTestSuite : public TestSuite
+{
+  public:
+    RitContentionSlotsTestSuite();
+};
+
+RitContentionSlotsTestSuite::RitContentionSlotsTestSuite()
+    : TestSuite("rit-contention-slots", Type::UNIT)
+{
+    AddTestCase(new RitContentionSlotsTest, Duration::QUICK);
+}
+
+static RitContentionSlotsTestSuite g_ritContentionSlotsTestSuite;
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/core-module.h>
+#include <ns3/log.h>
+#include <ns3/network-module.h>
+#include <ns3/periodic-sender-helper.h>
+#include <ns3/periodic-sender.h>
+#include <ns3/rit-metrics-collector.h>
+#include <ns3/rit-wpan-helper.h>
+#include <ns3/rit-wpan-net-device.h>
+#include <ns3/test.h>
+
+#include <fstream>
+#include <string>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-device-profile-test");
+
+/**
+ * @brief Check that device profiles assigned after a single install give each class its
+ *        RIT times, receiver mode and traffic, and that the metrics are broken down by class.
+ */
+class RitDeviceProfileAssignTest : public TestCase
+{
+  public:
+    RitDeviceProfileAssignTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitDeviceProfileAssignTest::RitDeviceProfileAssignTest()
+    : TestCase("Per-class RIT profiles assigned after install")
+{
+}
+
+void
+RitDeviceProfileAssignTest::DoRun()
+{
+    NodeContainer sinks;
+    sinks.Create(1);
+    NodeContainer leaves;
+    leaves.Create(2);
+    NodeContainer nodes(sinks, leaves);
+
+    // One install with the same settings for every node
+    RitWpanNetHelper helper;
+    helper.SetMacRitPeriod(Seconds(1));
+    helper.SetMacRitDataWaitDuration(MilliSeconds(10));
+    helper.SetMacRitTxWaitDuration(Seconds(5));
+    NetDeviceContainer devices = helper.Install(nodes);
+    for (uint32_t i = 0; i < devices.GetN(); i++)
+    {
+        Ptr<RitWpanNetDevice> dev = DynamicCast<RitWpanNetDevice>(devices.Get(i));
+        dev->SetAddress(Mac16Address(static_cast<uint16_t>(i)));
+        dev->SetRitRank(i == 0 ? 0 : 1);
+    }
+
+    PeriodicSenderHelper sinkApp;
+    sinkApp.SetReceiveOnly(true);
+    sinkApp.Install(sinks);
+    PeriodicSenderHelper leafApp;
+    leafApp.SetPeriod(Seconds(30));
+    leafApp.SetPacketSize(20);
+    leafApp.SetDstAddr(Mac16Address("00:00"));
+    ApplicationContainer leafApps = leafApp.Install(leaves);
+
+    // Enabled before the assignment: the classes reach it all the same
+    const std::string baseDir = CreateTempDirFilename("rit-device-profile/");
+    Ptr<RitMetricsCollector> collector = helper.EnableMetricsCollector(nodes, baseDir);
+
+    RitDeviceProfile mains;
+    mains.name = "mains";
+    mains.macRitPeriod = MilliSeconds(500);
+    mains.dataWaitDuration = MilliSeconds(10);
+    mains.txWaitDuration = Seconds(5);
+    mains.rxAlwaysOn = true;
+    RitDeviceProfile leaf;
+    leaf.name = "leaf";
+    leaf.macRitPeriod = Seconds(2);
+    leaf.dataWaitDuration = MilliSeconds(20);
+    leaf.txWaitDuration = Seconds(5);
+    leaf.trafficAttributes.emplace_back("Interval", "5s");
+    helper.AddDeviceProfile(mains);
+    helper.AddDeviceProfile(leaf);
+    helper.AssignDeviceProfile(sinks, "mains");
+    helper.AssignDeviceProfile(leaves, "leaf");
+
+    Ptr<RitWpanMac> sinkMac = DynamicCast<RitWpanNetDevice>(devices.Get(0))->GetMac();
+    NS_TEST_EXPECT_MSG_EQ(sinkMac->GetRitPeriodTime(), MilliSeconds(500), "Wrong sink BI");
+    NS_TEST_EXPECT_MSG_EQ(sinkMac->GetRxAlwaysOn(), true, "Sink receiver not always on");
+    for (uint32_t i = 1; i < devices.GetN(); i++)
+    {
+        Ptr<RitWpanMac> mac = DynamicCast<RitWpanNetDevice>(devices.Get(i))->GetMac();
+        NS_TEST_EXPECT_MSG_EQ(mac->GetRitPeriodTime(), Seconds(2), "Wrong leaf BI");
+        NS_TEST_EXPECT_MSG_EQ(mac->GetRitDataWaitDurationTime(),
+                              MilliSeconds(20),
+                              "Wrong leaf DWD");
+        NS_TEST_EXPECT_MSG_EQ(mac->GetRxAlwaysOn(), false, "Leaf receiver always on");
+        TimeValue interval;
+        leafApps.Get(i - 1)->GetAttribute("Interval", interval);
+        NS_TEST_EXPECT_MSG_EQ(interval.Get(), Seconds(5), "Traffic of the profile not set");
+        NS_TEST_EXPECT_MSG_EQ(helper.GetDeviceClass(leaves.Get(i - 1)->GetId()),
+                              "leaf",
+                              "Wrong device class");
+    }
+    NS_TEST_EXPECT_MSG_EQ(helper.GetDeviceClass(sinks.Get(0)->GetId()), "mains", "Wrong class");
+
+    Simulator::Stop(Seconds(60));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_GT(collector->GetClassPdr("leaf"), 0.0, "No leaf packet delivered");
+    NS_TEST_EXPECT_MSG_LT(collector->GetClassPdr("mains"), 0.0, "The sink sent nothing");
+    NS_TEST_EXPECT_MSG_LT(collector->GetClassPdr("unknown"), 0.0, "Class without nodes");
+
+    Simulator::Destroy();
+
+    std::ifstream classes(baseDir + "summary/class-summary.csv");
+    NS_TEST_ASSERT_MSG_EQ(classes.is_open(), true, "class-summary.csv not written");
+    std::string line;
+    std::getline(classes, line);
+    NS_TEST_EXPECT_MSG_EQ(line, "class,nodes,tx,delivered,pdr,avg_delay,wake_ratio", "Header");
+    std::getline(classes, line);
+    NS_TEST_EXPECT_MSG_EQ(line.rfind("leaf,2,", 0) == 0, true, "Wrong leaf row: " << line);
+    std::getline(classes, line);
+    NS_TEST_EXPECT_MSG_EQ(line.rfind("mains,1,0,0,", 0) == 0, true, "Wrong mains row: " << line);
+}
+
+class RitDeviceProfileTestSuite : public TestSuite
+{
+  public:
+    RitDeviceProfileTestSuite();
+};
+
+RitDeviceProfileTestSuite::RitDeviceProfileTestSuite()
+    : TestSuite("rit-device-profile", Type::UNIT)
+{
+    AddTestCase(new RitDeviceProfileAssignTest, Duration::QUICK);
+}
+
+static RitDeviceProfileTestSuite g_ritDeviceProfileTestSuite;
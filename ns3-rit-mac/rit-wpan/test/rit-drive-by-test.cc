@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/core-module.h>
+#include <ns3/log.h>
+#include <ns3/lr-wpan-spectrum-channel.h>
+#include <ns3/network-module.h>
+#include <ns3/packet.h>
+#include <ns3/propagation-delay-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/rit-drive-by-collector.h>
+#include <ns3/rit-wpan-mac.h>
+#include <ns3/rit-wpan-net-device.h>
+#include <ns3/waypoint-mobility-model.h>
+
+#include <fstream>
+#include <sstream>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-drive-by-test");
+
+/**
+ * @brief Check that a collector driven twice past three meters, once from a route and
+ *        once from a CSV trace, collects their data on both passes while the channel
+ *        updates its neighbour set only.
+ */
+class RitDriveByCollectorTest : public TestCase
+{
+  public:
+    RitDriveByCollectorTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitDriveByCollectorTest::RitDriveByCollectorTest()
+    : TestCase("RitDriveByCollector passes and contact-time utilisation")
+{
+}
+
+void
+RitDriveByCollectorTest::DoRun()
+{
+    Ptr<LrWpanSpectrumChannel> channel = CreateObject<LrWpanSpectrumChannel>();
+    channel->SetAttribute("MobilityUpdateInterval", TimeValue(Seconds(1)));
+    channel->SetAttribute("NeighbourGridCellSize", DoubleValue(50));
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    // Collector on a road along y = 0, meters 20 m off it and 200 m apart
+    Ptr<Node> collectorNode = CreateObject<Node>();
+    Ptr<RitWpanNetDevice> collector = CreateObject<RitWpanNetDevice>();
+    collector->SetChannel(channel);
+    collector->SetAddress(Mac16Address("00:00"));
+    collector->SetRitRank(0);
+    collector->GetPhy()->SetMobility(CreateObject<WaypointMobilityModel>());
+    collectorNode->AddDevice(collector);
+
+    std::vector<Ptr<RitWpanNetDevice>> meters;
+    std::vector<Ptr<Node>> meterNodes;
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        Ptr<Node> node = CreateObject<Node>();
+        Ptr<RitWpanNetDevice> device = CreateObject<RitWpanNetDevice>();
+        device->SetChannel(channel);
+        device->SetAddress(Mac16Address(static_cast<uint16_t>(i + 1)));
+        device->SetRitRank(1);
+        Ptr<ConstantPositionMobilityModel> mob = CreateObject<ConstantPositionMobilityModel>();
+        mob->SetPosition(Vector(200.0 * i, 20, 0));
+        device->GetPhy()->SetMobility(mob);
+        node->AddDevice(device);
+        meters.push_back(device);
+        meterNodes.push_back(node);
+    }
+
+    Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+    pibAttr->macRitPeriodTime = Time(Seconds(1));
+    collector->GetMac()->MlmeSetRequest(macRitPeriodTime, pibAttr);
+    for (const auto& meter : meters)
+    {
+        meter->GetMac()->MlmeSetRequest(macRitPeriodTime, pibAttr);
+    }
+
+    // Out along the road at 10 m/s, then back from a trace
+    Ptr<RitDriveByCollector> driveBy = Create<RitDriveByCollector>(collector, meters);
+    driveBy->AddPass(Seconds(5), {Vector(-150, 0, 0), Vector(550, 0, 0)}, 10);
+    const std::string path = CreateTempDirFilename("rit-drive-by.csv");
+    {
+        std::ofstream out(path);
+        out << "pass,time,x,y,z\n"
+            << "# way back\n"
+            << "1,100,550,0,0\n"
+            << "1,170,-150,0,0\n";
+    }
+    driveBy->ReadCsv(path);
+    driveBy->Start();
+
+    for (uint32_t i = 0; i < meters.size(); i++)
+    {
+        Ptr<RitWpanNetDevice> device = meters[i];
+        for (uint32_t k = 0; k < 85; k++)
+        {
+            const Time at = Seconds(5) + MilliSeconds(2000 * k + 300 * i);
+            Simulator::ScheduleWithContext(meterNodes[i]->GetId(), at, [=]() {
+                device->Send(Create<Packet>(20), Mac16Address("00:00"), 0);
+            });
+        }
+    }
+
+    Simulator::Stop(Seconds(180));
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(driveBy->GetNPasses(), 2, "Wrong number of passes");
+    for (uint32_t pass = 0; pass < 2; pass++)
+    {
+        const RitDriveByCollector::Pass& p = driveBy->GetPass(pass);
+        NS_TEST_EXPECT_MSG_EQ(p.end - p.start, Seconds(70), "Wrong pass duration");
+        NS_TEST_EXPECT_MSG_GT(p.nFrames, 0, "Nothing collected on the pass");
+        NS_TEST_EXPECT_MSG_EQ(p.meters.size(), 3, "A meter passed unheard");
+        // each meter is within 100 m over some 196 m of the 700 m road
+        NS_TEST_EXPECT_MSG_GT(p.contactTime, Seconds(55), "Contact time too short");
+        NS_TEST_EXPECT_MSG_LT(p.contactTime, Seconds(62), "Contact time too long");
+        NS_TEST_EXPECT_MSG_GT(driveBy->GetContactUtilisation(pass), 0, "No data in contact");
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(driveBy->GetContactUtilisation(pass),
+                                    1,
+                                    "Contact more than fully used");
+    }
+    NS_TEST_EXPECT_MSG_GT(channel->GetNNeighbourUpdates(), 0, "No neighbour set update");
+
+    std::ostringstream os;
+    driveBy->Print(os);
+    NS_TEST_EXPECT_MSG_EQ(os.str().find("pass 1: 100-170 s") != std::string::npos,
+                          true,
+                          "Pass of the trace not printed");
+
+    channel->Dispose();
+    Simulator::Destroy();
+}
+
+class RitDriveByTestSuite : public TestSuite
+{
+  public:
+    RitDriveByTestSuite();
+};
+
+RitDriveByTestSuite::RitDriveByTestSuite()
+    : TestSuite("rit-drive-by", Type::UNIT)
+{
+    AddTestCase(new RitDriveByCollectorTest, Duration::QUICK);
+}
+
+static RitDriveByTestSuite g_ritDriveByTestSuite;
@@ -0,0 +1,343 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/core-module.h>
+#include <ns3/error-model.h>
+#include <ns3/log.h>
+#include <ns3/lr-wpan-mac-header.h>
+#include <ns3/network-module.h>
+#include <ns3/packet.h>
+#include <ns3/propagation-delay-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/rit-duplicate-cache.h>
+#include <ns3/rit-wpan-mac.h>
+#include <ns3/rit-wpan-net-device.h>
+#include <ns3/rit-wpan-nwk.h>
+#include <ns3/single-model-spectrum-channel.h>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-duplicate-cache-test");
+
+/**
+ * @brief Post-reception error model losing the first ACK frames, so that the sender
+ *        retries a frame the receiver already has.
+ */
+class RitAckLossErrorModel : public ErrorModel
+{
+  public:
+    /**
+     * @param nLosses ACK frames lost
+     */
+    explicit RitAckLossErrorModel(uint32_t nLosses = 1)
+        : m_nLosses(nLosses)
+    {
+    }
+
+  private:
+    bool DoCorrupt(Ptr<Packet> p) override
+    {
+        LrWpanMacHeader macHdr;
+        p->PeekHeader(macHdr);
+        if (macHdr.IsAcknowledgment() && m_nLosses > 0)
+        {
+            m_nLosses--;
+            return true;
+        }
+        return false;
+    }
+
+    void DoReset() override
+    {
+    }
+
+    uint32_t m_nLosses; //!< ACK frames still to lose
+};
+
+/**
+ * @brief Check the lookups, the expiry and the bounded capacity of RitDuplicateCache.
+ */
+class RitDuplicateCacheTest : public TestCase
+{
+  public:
+    RitDuplicateCacheTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitDuplicateCacheTest::RitDuplicateCacheTest()
+    : TestCase("RitDuplicateCache lookups, expiry and capacity")
+{
+}
+
+void
+RitDuplicateCacheTest::DoRun()
+{
+    RitDuplicateCache cache(6, Seconds(10));
+    NS_TEST_EXPECT_MSG_EQ(cache.GetCapacity(), 8, "Capacity not rounded up to whole sets");
+
+    NS_TEST_EXPECT_MSG_EQ(cache.Insert(0x0102, Seconds(1)), true, "New key taken as duplicate");
+    NS_TEST_EXPECT_MSG_EQ(cache.Insert(0x0102, Seconds(2)), false, "Duplicate not detected");
+    NS_TEST_EXPECT_MSG_EQ(cache.Insert(0x0103, Seconds(2)), true, "Other key taken as duplicate");
+    // The first key expires 10 s after it was recorded, whatever its duplicates.
+    NS_TEST_EXPECT_MSG_EQ(cache.Insert(0x0102, Seconds(11)), true, "Expired key still detected");
+
+    // Many more keys than entries: the cache stays bounded and evicts the oldest.
+    cache.Clear();
+    for (uint32_t key = 0; key < 100; key++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(cache.Insert(key, MilliSeconds(key)), true, "Key taken as duplicate");
+    }
+    NS_TEST_EXPECT_MSG_EQ(cache.GetCapacity(), 8, "Capacity changed by the insertions");
+    NS_TEST_EXPECT_MSG_EQ(cache.GetNEvictions(), 92, "Every key beyond the capacity evicts one");
+    NS_TEST_EXPECT_MSG_EQ(cache.Insert(99, MilliSeconds(100)), false, "Last key evicted");
+}
+
+/**
+ * @brief Check that a data frame retried by the MAC after a lost ACK is acknowledged
+ *        again but indicated once (duplicateFilterEnabled).
+ */
+class RitMacDuplicateFilterTest : public TestCase
+{
+  public:
+    RitMacDuplicateFilterTest();
+
+  private:
+    /**
+     * @brief Count the packets delivered at the receiver.
+     * @param dev The device
+     * @param pkt The packet
+     * @param proto The protocol number
+     * @param addr The source address
+     * @return true
+     */
+    bool DataIndication(Ptr<NetDevice> dev,
+                        Ptr<const Packet> pkt,
+                        uint16_t proto,
+                        const Address& addr);
+
+    /**
+     * @brief Count the duplicates dropped by the receiver MAC.
+     * @param p The frame
+     */
+    void MacRxDuplicate(Ptr<const Packet> p);
+
+    void DoRun() override;
+
+    uint32_t m_nRx{0};         //!< Packets delivered
+    uint32_t m_nDuplicates{0}; //!< MacRxDuplicate traces
+};
+
+RitMacDuplicateFilterTest::RitMacDuplicateFilterTest()
+    : TestCase("RitWpanMac duplicate filter of the frames retried after a lost ACK")
+{
+}
+
+bool
+RitMacDuplicateFilterTest::DataIndication(Ptr<NetDevice> dev,
+                                          Ptr<const Packet> pkt,
+                                          uint16_t proto,
+                                          const Address& addr)
+{
+    m_nRx++;
+    return true;
+}
+
+void
+RitMacDuplicateFilterTest::MacRxDuplicate(Ptr<const Packet> p)
+{
+    m_nDuplicates++;
+}
+
+void
+RitMacDuplicateFilterTest::DoRun()
+{
+    Ptr<Node> receiverNode = CreateObject<Node>();
+    Ptr<Node> senderNode = CreateObject<Node>();
+    Ptr<RitWpanNetDevice> receiverDevice = CreateObject<RitWpanNetDevice>();
+    Ptr<RitWpanNetDevice> senderDevice = CreateObject<RitWpanNetDevice>();
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+    receiverDevice->SetChannel(channel);
+    senderDevice->SetChannel(channel);
+
+    receiverDevice->SetAddress(Mac16Address("00:00"));
+    receiverDevice->SetRitRank(0);
+    senderDevice->SetAddress(Mac16Address("00:01"));
+    senderDevice->SetRitRank(1);
+    receiverNode->AddDevice(receiverDevice);
+    senderNode->AddDevice(senderDevice);
+    receiverDevice->SetReceiveCallback(
+        MakeCallback(&RitMacDuplicateFilterTest::DataIndication, this));
+
+    RitWpanMacModuleConfig config;
+    config.duplicateFilterEnabled = true;
+    Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+    pibAttr->macRitPeriodTime = Time(Seconds(1));
+    for (const auto& device : {senderDevice, receiverDevice})
+    {
+        device->GetMac()->SetModuleConfig(config);
+        device->GetMac()->MlmeSetRequest(macRitPeriodTime, pibAttr);
+    }
+    // The MAC retries the frame itself, with the same DSN.
+    senderDevice->GetMac()->SetMacMaxFrameRetries(1);
+    senderDevice->GetPhy()->SetPostReceptionErrorModel(CreateObject<RitAckLossErrorModel>());
+    receiverDevice->GetMac()->TraceConnectWithoutContext(
+        "MacRxDuplicate",
+        MakeCallback(&RitMacDuplicateFilterTest::MacRxDuplicate, this));
+
+    Simulator::ScheduleWithContext(senderNode->GetId(), Seconds(8.0), [=]() {
+        senderDevice->Send(Create<Packet>(20), Mac16Address("00:00"), 0);
+    });
+
+    Simulator::Stop(Seconds(20.0));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_nRx, 1, "Retried frame indicated twice, or not at all");
+    NS_TEST_EXPECT_MSG_EQ(m_nDuplicates, 1, "Retry not taken as a duplicate");
+    NS_TEST_EXPECT_MSG_EQ(receiverDevice->GetMac()->GetNRxDuplicates(),
+                          1,
+                          "Duplicate not counted");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @brief Check that a packet sent again by the NWK after a lost ACK, in a new MAC frame,
+ *        is delivered once at the sink (DuplicateDetection).
+ */
+class RitNwkDuplicateDetectionTest : public TestCase
+{
+  public:
+    RitNwkDuplicateDetectionTest();
+
+  private:
+    /**
+     * @brief Count the packets delivered at the sink.
+     * @param dev The device
+     * @param pkt The packet
+     * @param proto The protocol number
+     * @param addr The source address
+     * @return true
+     */
+    bool DataIndication(Ptr<NetDevice> dev,
+                        Ptr<const Packet> pkt,
+                        uint16_t proto,
+                        const Address& addr);
+
+    /**
+     * @brief Record the duplicates dropped by the sink.
+     * @param p The packet
+     * @param origin Node that sent the packet first
+     * @param seq Sequence number at the origin
+     */
+    void NwkRxDuplicate(Ptr<const Packet> p, Mac16Address origin, uint16_t seq);
+
+    void DoRun() override;
+
+    uint32_t m_nRx{0};         //!< Packets delivered
+    uint32_t m_nDuplicates{0}; //!< NwkRxDuplicate traces
+    Mac16Address m_origin;     //!< Origin of the last duplicate
+    uint16_t m_seq{0xffff};    //!< Sequence number of the last duplicate
+};
+
+RitNwkDuplicateDetectionTest::RitNwkDuplicateDetectionTest()
+    : TestCase("RitSimpleRouting end-to-end duplicate detection of the NWK retries")
+{
+}
+
+bool
+RitNwkDuplicateDetectionTest::DataIndication(Ptr<NetDevice> dev,
+                                             Ptr<const Packet> pkt,
+                                             uint16_t proto,
+                                             const Address& addr)
+{
+    m_nRx++;
+    return true;
+}
+
+void
+RitNwkDuplicateDetectionTest::NwkRxDuplicate(Ptr<const Packet> p,
+                                             Mac16Address origin,
+                                             uint16_t seq)
+{
+    m_nDuplicates++;
+    m_origin = origin;
+    m_seq = seq;
+}
+
+void
+RitNwkDuplicateDetectionTest::DoRun()
+{
+    Ptr<Node> sinkNode = CreateObject<Node>();
+    Ptr<Node> senderNode = CreateObject<Node>();
+    Ptr<RitWpanNetDevice> sinkDevice = CreateObject<RitWpanNetDevice>();
+    Ptr<RitWpanNetDevice> senderDevice = CreateObject<RitWpanNetDevice>();
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+    sinkDevice->SetChannel(channel);
+    senderDevice->SetChannel(channel);
+
+    sinkDevice->SetAddress(Mac16Address("00:00"));
+    sinkDevice->SetRitRank(0);
+    senderDevice->SetAddress(Mac16Address("00:01"));
+    senderDevice->SetRitRank(1);
+    sinkNode->AddDevice(sinkDevice);
+    senderNode->AddDevice(senderDevice);
+    sinkDevice->SetReceiveCallback(
+        MakeCallback(&RitNwkDuplicateDetectionTest::DataIndication, this));
+
+    Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+    pibAttr->macRitPeriodTime = Time(Seconds(1));
+    for (const auto& device : {senderDevice, sinkDevice})
+    {
+        device->GetNwk()->SetAttribute("DuplicateDetection", BooleanValue(true));
+        device->GetNwk()->SetAttribute("MaxRetries", UintegerValue(1));
+        device->GetMac()->MlmeSetRequest(macRitPeriodTime, pibAttr);
+    }
+    senderDevice->GetPhy()->SetPostReceptionErrorModel(CreateObject<RitAckLossErrorModel>());
+    sinkDevice->GetNwk()->TraceConnectWithoutContext(
+        "NwkRxDuplicate",
+        MakeCallback(&RitNwkDuplicateDetectionTest::NwkRxDuplicate, this));
+
+    Simulator::ScheduleWithContext(senderNode->GetId(), Seconds(8.0), [=]() {
+        senderDevice->Send(Create<Packet>(20), Mac16Address("00:00"), 0);
+    });
+
+    Simulator::Stop(Seconds(20.0));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_nRx, 1, "Retried packet delivered twice, or not at all");
+    NS_TEST_EXPECT_MSG_EQ(m_nDuplicates, 1, "Retry not taken as a duplicate");
+    NS_TEST_EXPECT_MSG_EQ(m_origin, Mac16Address("00:01"), "Wrong origin of the duplicate");
+    NS_TEST_EXPECT_MSG_EQ(m_seq, 0, "Wrong sequence number of the duplicate");
+
+    Simulator::Destroy();
+}
+
+class RitDuplicateCacheTestSuite : public TestSuite
+{
+  public:
+    RitDuplicateCacheTestSuite();
+};
+
+RitDuplicateCacheTestSuite::RitDuplicateCacheTestSuite()
+    : TestSuite("rit-duplicate-cache", Type::UNIT)
+{
+    AddTestCase(new RitDuplicateCacheTest, Duration::QUICK);
+    AddTestCase(new RitMacDuplicateFilterTest, Duration::QUICK);
+    AddTestCase(new RitNwkDuplicateDetectionTest, Duration::QUICK);
+}
+
+static RitDuplicateCacheTestSuite g_ritDuplicateCacheTestSuite;
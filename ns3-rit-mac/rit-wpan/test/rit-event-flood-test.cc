@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/application-container.h>
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/event-flood-helper.h>
+#include <ns3/event-flood-sender.h>
+#include <ns3/log.h>
+#include <ns3/mac16-address.h>
+#include <ns3/node-container.h>
+#include <ns3/nstime.h>
+#include <ns3/simulator.h>
+#include <ns3/test.h>
+
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-event-flood-test");
+
+/**
+ * @brief Check the trigger times set by EventFloodHelper: the event reaches a node
+ *        after its distance over the speed, the jitter stays in its bound, and the
+ *        assigned streams give the same jitter whatever the installation order.
+ */
+class RitEventFloodTriggerTest : public TestCase
+{
+  public:
+    RitEventFloodTriggerTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Get the trigger times of the installed applications.
+     * @param apps The applications
+     * @return the trigger time of each application
+     */
+    static std::vector<Time> GetTriggers(const ApplicationContainer& apps);
+};
+
+RitEventFloodTriggerTest::RitEventFloodTriggerTest()
+    : TestCase("Event flood trigger times")
+{
+}
+
+std::vector<Time>
+RitEventFloodTriggerTest::GetTriggers(const ApplicationContainer& apps)
+{
+    std::vector<Time> triggers;
+    for (uint32_t i = 0; i < apps.GetN(); i++)
+    {
+        triggers.push_back(DynamicCast<EventFloodSender>(apps.Get(i))->GetTriggerTime());
+    }
+    return triggers;
+}
+
+void
+RitEventFloodTriggerTest::DoRun()
+{
+    // Nodes 0, 30 and 50 m away from the epicentre
+    NodeContainer nodes;
+    nodes.Create(3);
+    const std::vector<Vector> positions = {{10, 10, 0}, {40, 10, 0}, {40, 50, 0}};
+    for (uint32_t i = 0; i < nodes.GetN(); i++)
+    {
+        Ptr<ConstantPositionMobilityModel> mobility =
+            CreateObject<ConstantPositionMobilityModel>();
+        mobility->SetPosition(positions[i]);
+        nodes.Get(i)->AggregateObject(mobility);
+    }
+
+    EventFloodHelper flood;
+    flood.SetDstAddr(Mac16Address("00:00"));
+    flood.SetEpicentre(Vector(10, 10, 0));
+    flood.SetStartTime(Seconds(100));
+    flood.SetSpeed(10.0);
+    std::vector<Time> triggers = GetTriggers(flood.Install(nodes));
+    NS_TEST_EXPECT_MSG_EQ(triggers[0], Seconds(100), "Epicentre not triggered at the start");
+    NS_TEST_EXPECT_MSG_EQ(triggers[1], Seconds(103), "Wrong arrival time");
+    NS_TEST_EXPECT_MSG_EQ(triggers[2], Seconds(105), "Wrong arrival time");
+
+    // No propagation: every node at the start
+    flood.SetSpeed(0.0);
+    for (const Time& t : GetTriggers(flood.Install(nodes)))
+    {
+        NS_TEST_EXPECT_MSG_EQ(t, Seconds(100), "Instantaneous event not at the start");
+    }
+
+    // Jitter within its bound, and keyed by node rather than by installation order
+    EventFloodHelper jittered;
+    jittered.SetDstAddr(Mac16Address("00:00"));
+    jittered.SetEpicentre(Vector(10, 10, 0));
+    jittered.SetStartTime(Seconds(100));
+    jittered.SetSpeed(10.0);
+    jittered.SetJitter(Seconds(2));
+    NodeContainer forward(nodes.Get(0), nodes.Get(1), nodes.Get(2));
+    NodeContainer backward(nodes.Get(2), nodes.Get(1), nodes.Get(0));
+    ApplicationContainer forwardApps = jittered.Install(forward);
+    jittered.AssignStreams(forward, 1000);
+    ApplicationContainer backwardApps = jittered.Install(backward);
+    jittered.AssignStreams(backward, 1000);
+    const std::vector<Time> first = GetTriggers(forwardApps);
+    const std::vector<Time> second = GetTriggers(backwardApps);
+    const std::vector<double> arrival = {100, 103, 105};
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        NS_TEST_EXPECT_MSG_GT_OR_EQ(first[i], Seconds(arrival[i]), "Jitter before the arrival");
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(first[i],
+                                    Seconds(arrival[i] + 2),
+                                    "Jitter past its bound");
+        NS_TEST_EXPECT_MSG_EQ(first[i], second[2 - i], "Jitter depends on the order");
+    }
+
+    Simulator::Destroy();
+}
+
+class RitEventFloodTestSuite : public TestSuite
+{
+  public:
+    RitEventFloodTestSuite();
+};
+
+RitEventFloodTestSuite::RitEventFloodTestSuite()
+    : TestSuite("rit-event-flood", Type::UNIT)
+{
+    AddTestCase(new RitEventFloodTriggerTest, Duration::QUICK);
+}
+
+static RitEventFloodTestSuite g_ritEventFloodTestSuite;
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/log.h>
+#include <ns3/lr-wpan-mac-header.h>
+#include <ns3/lr-wpan-mac-pl-headers.h>
+#include <ns3/packet.h>
+#include <ns3/rit-frame-codec.h>
+#include <ns3/rit-wpan-nwk-header.h>
+#include <ns3/test.h>
+
+#include <string>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-frame-codec-test");
+
+/**
+ * @brief Check that RitFrameCodec decodes the MAC headers of the RIT frames, and the
+ *        ones it has no fixed layout for, as Packet::PeekHeader() does.
+ */
+class RitFrameCodecMacHeaderTest : public TestCase
+{
+  public:
+    RitFrameCodecMacHeaderTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Decode a frame with both paths and compare the headers.
+     * @param name Frame description
+     * @param hdr The MAC header of the frame
+     */
+    void Check(const std::string& name, const LrWpanMacHeader& hdr);
+};
+
+RitFrameCodecMacHeaderTest::RitFrameCodecMacHeaderTest()
+    : TestCase("Fixed-layout MAC header decoding")
+{
+}
+
+void
+RitFrameCodecMacHeaderTest::Check(const std::string& name, const LrWpanMacHeader& hdr)
+{
+    Ptr<Packet> frame = Create<Packet>(20);
+    frame->AddHeader(hdr);
+
+    LrWpanMacHeader expected;
+    const uint32_t expectedSize = frame->PeekHeader(expected);
+    LrWpanMacHeader decoded;
+    NS_TEST_ASSERT_MSG_EQ(RitFrameCodec::PeekMacHeader(frame, decoded),
+                          expectedSize,
+                          name << ": wrong header size");
+    NS_TEST_EXPECT_MSG_EQ(decoded.GetFrameControl(), expected.GetFrameControl(), name);
+    NS_TEST_EXPECT_MSG_EQ(+decoded.GetSeqNum(), +expected.GetSeqNum(), name);
+    NS_TEST_EXPECT_MSG_EQ(decoded.GetSerializedSize(), expectedSize, name);
+    if (expected.GetDstAddrMode() == SHORT_ADDR)
+    {
+        NS_TEST_EXPECT_MSG_EQ(decoded.GetDstPanId(), expected.GetDstPanId(), name);
+        NS_TEST_EXPECT_MSG_EQ(decoded.GetShortDstAddr(), expected.GetShortDstAddr(), name);
+    }
+    if (expected.GetSrcAddrMode() == SHORT_ADDR)
+    {
+        NS_TEST_EXPECT_MSG_EQ(decoded.GetSrcPanId(), expected.GetSrcPanId(), name);
+        NS_TEST_EXPECT_MSG_EQ(decoded.GetShortSrcAddr(), expected.GetShortSrcAddr(), name);
+    }
+    if (expected.GetSrcAddrMode() == EXT_ADDR)
+    {
+        NS_TEST_EXPECT_MSG_EQ(decoded.GetExtSrcAddr(), expected.GetExtSrcAddr(), name);
+    }
+}
+
+void
+RitFrameCodecMacHeaderTest::DoRun()
+{
+    LrWpanMacHeader data(LrWpanMacHeader::LRWPAN_MAC_DATA, 42);
+    data.SetSrcAddrMode(SHORT_ADDR);
+    data.SetSrcAddrFields(0x1234, Mac16Address("00:17"));
+    data.SetDstAddrMode(SHORT_ADDR);
+    data.SetDstAddrFields(0x1234, Mac16Address("00:05"));
+    data.SetPanIdComp();
+    data.SetSecDisable();
+    data.SetAckReq();
+    Check("data", data);
+
+    // Same layout, other bytes: not taken from the cache
+    data.SetSeqNum(43);
+    data.SetDstAddrFields(0x1234, Mac16Address("00:06"));
+    Check("data, second frame", data);
+
+    LrWpanMacHeader beacon(LrWpanMacHeader::LRWPAN_MAC_COMMAND, 7);
+    beacon.SetFrameVer(1);
+    beacon.SetSrcAddrMode(SHORT_ADDR);
+    beacon.SetSrcAddrFields(0xabcd, Mac16Address("00:02"));
+    beacon.SetDstAddrMode(SHORT_ADDR);
+    beacon.SetDstAddrFields(0xabcd, Mac16Address("ff:ff"));
+    beacon.SetPanIdComp();
+    beacon.SetSecDisable();
+    Check("RIT Data Request", beacon);
+
+    LrWpanMacHeader twoPans = beacon;
+    twoPans.SetNoPanIdComp();
+    twoPans.SetSrcAddrFields(0x0001, Mac16Address("00:02"));
+    Check("short addresses, two PAN IDs", twoPans);
+
+    LrWpanMacHeader beaconAck(LrWpanMacHeader::LRWPAN_MAC_MULTIPURPOSE, 9);
+    beaconAck.SetFrameVer(1);
+    beaconAck.SetSrcAddrMode(NO_PANID_ADDR);
+    beaconAck.SetDstAddrMode(SHORT_ADDR);
+    beaconAck.SetDstAddrFields(0xabcd, Mac16Address("00:03"));
+    beaconAck.SetPanIdComp();
+    beaconAck.SetSecDisable();
+    Check("Beacon ACK", beaconAck);
+
+    LrWpanMacHeader ack(LrWpanMacHeader::LRWPAN_MAC_ACKNOWLEDGMENT, 42);
+    ack.SetSrcAddrMode(NO_PANID_ADDR);
+    ack.SetDstAddrMode(NO_PANID_ADDR);
+    ack.SetSecDisable();
+    Check("ACK", ack);
+
+    LrWpanMacHeader extended = data;
+    extended.SetSrcAddrMode(EXT_ADDR);
+    extended.SetSrcAddrFields(0x1234, Mac64Address("00:11:22:33:44:55:66:77"));
+    Check("extended source (no fixed layout)", extended);
+
+    // A frame shorter than its header
+    Ptr<Packet> truncated = Create<Packet>();
+    truncated->AddHeader(data);
+    truncated->RemoveAtEnd(2);
+    LrWpanMacHeader decoded;
+    NS_TEST_EXPECT_MSG_EQ(RitFrameCodec::PeekMacHeader(truncated, decoded),
+                          0,
+                          "Truncated frame decoded");
+}
+
+/**
+ * @brief Check the command type and RIT NWK header decoding of RitFrameCodec.
+ */
+class RitFrameCodecPayloadTest : public TestCase
+{
+  public:
+    RitFrameCodecPayloadTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitFrameCodecPayloadTest::RitFrameCodecPayloadTest()
+    : TestCase("Command type and NWK header decoding")
+{
+}
+
+void
+RitFrameCodecPayloadTest::DoRun()
+{
+    LrWpanMacHeader macHdr(LrWpanMacHeader::LRWPAN_MAC_COMMAND, 7);
+    macHdr.SetSrcAddrMode(SHORT_ADDR);
+    macHdr.SetSrcAddrFields(0xabcd, Mac16Address("00:02"));
+    macHdr.SetDstAddrMode(SHORT_ADDR);
+    macHdr.SetDstAddrFields(0xabcd, Mac16Address("ff:ff"));
+    macHdr.SetPanIdComp();
+    macHdr.SetSecDisable();
+
+    Ptr<Packet> beacon = Create<Packet>();
+    beacon->AddHeader(CommandPayloadHeader(CommandPayloadHeader::RIT_DATA_REQ));
+    beacon->AddHeader(macHdr);
+    LrWpanMacHeader decoded;
+    const uint32_t size = RitFrameCodec::PeekMacHeader(beacon, decoded);
+    NS_TEST_EXPECT_MSG_EQ(RitFrameCodec::PeekCommandType(beacon, size),
+                          CommandPayloadHeader::RIT_DATA_REQ,
+                          "Wrong command type");
+
+    Ptr<Packet> empty = Create<Packet>();
+    empty->AddHeader(macHdr);
+    NS_TEST_EXPECT_MSG_EQ(RitFrameCodec::PeekCommandType(empty, size),
+                          CommandPayloadHeader::CMD_RESERVED,
+                          "Command type read past the frame");
+
+    RitNwkHeader nwkHdr;
+    nwkHdr.SetRank(RitNwkHeader::MAX_RANK);
+    nwkHdr.SetPriority(2);
+    nwkHdr.SetOption(RitNwkHeader::OPTION_ROUTE_REPORT);
+    nwkHdr.SetSrcAddr(Mac16Address("00:17"));
+    nwkHdr.SetDstAddr(Mac16Address("00:00"));
+    Ptr<Packet> packet = Create<Packet>(10);
+    packet->AddHeader(nwkHdr);
+
+    RitNwkHeader nwkDecoded;
+    NS_TEST_ASSERT_MSG_EQ(RitFrameCodec::PeekNwkHeader(packet, nwkDecoded),
+                          nwkHdr.GetSerializedSize(),
+                          "Wrong NWK header size");
+    NS_TEST_EXPECT_MSG_EQ(nwkDecoded.GetRank(), RitNwkHeader::MAX_RANK, "Wrong rank");
+    NS_TEST_EXPECT_MSG_EQ(+nwkDecoded.GetPriority(), 2, "Wrong priority");
+    NS_TEST_EXPECT_MSG_EQ(nwkDecoded.GetOption(), RitNwkHeader::OPTION_ROUTE_REPORT, "Option");
+    NS_TEST_EXPECT_MSG_EQ(nwkDecoded.GetSrcAddr(), Mac16Address("00:17"), "Wrong source");
+    NS_TEST_EXPECT_MSG_EQ(nwkDecoded.GetDstAddr(), Mac16Address("00:00"), "Wrong destination");
+    NS_TEST_EXPECT_MSG_EQ(RitFrameCodec::PeekNwkHeader(Create<Packet>(4), nwkDecoded),
+                          0,
+                          "Short packet decoded");
+}
+
+class RitFrameCodecTestSuite : public TestSuite
+{
+  public:
+    RitFrameCodecTestSuite();
+};
+
+RitFrameCodecTestSuite::RitFrameCodecTestSuite()
+    : TestSuite("rit-frame-codec", Type::UNIT)
+{
+    AddTestCase(new RitFrameCodecMacHeaderTest, Duration::QUICK);
+    AddTestCase(new RitFrameCodecPayloadTest, Duration::QUICK);
+}
+
+static RitFrameCodecTestSuite g_ritFrameCodecTestSuite;
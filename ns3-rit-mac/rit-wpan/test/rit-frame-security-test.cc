@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/core-module.h>
+#include <ns3/log.h>
+#include <ns3/lr-wpan-phy.h>
+#include <ns3/network-module.h>
+#include <ns3/packet.h>
+#include <ns3/propagation-delay-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/rit-frame-security.h>
+#include <ns3/rit-wpan-mac.h>
+#include <ns3/rit-wpan-net-device.h>
+#include <ns3/single-model-spectrum-channel.h>
+#include <ns3/test.h>
+
+#include <algorithm>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-frame-security-test");
+
+/**
+ * @brief Check that RitFrameSecurity gives a header the auxiliary security header of its
+ *        level and key identifier mode, counts its frames and rejects replayed counters.
+ */
+class RitFrameSecurityOverheadTest : public TestCase
+{
+  public:
+    RitFrameSecurityOverheadTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitFrameSecurityOverheadTest::RitFrameSecurityOverheadTest()
+    : TestCase("Auxiliary security header, MIC and replay protection")
+{
+}
+
+void
+RitFrameSecurityOverheadTest::DoRun()
+{
+    NS_TEST_EXPECT_MSG_EQ(RitFrameSecurity::GetMicLength(0), 0, "Unsecured level with a MIC");
+    NS_TEST_EXPECT_MSG_EQ(RitFrameSecurity::GetMicLength(4), 0, "ENC has no MIC");
+    NS_TEST_EXPECT_MSG_EQ(RitFrameSecurity::GetMicLength(5), 4, "Wrong ENC-MIC-32");
+    NS_TEST_EXPECT_MSG_EQ(RitFrameSecurity::GetMicLength(6), 8, "Wrong ENC-MIC-64");
+    NS_TEST_EXPECT_MSG_EQ(RitFrameSecurity::GetMicLength(3), 16, "Wrong MIC-128");
+
+    RitFrameSecurity security;
+    NS_TEST_EXPECT_MSG_EQ(security.IsEnabled(), false, "Secured by default");
+    NS_TEST_EXPECT_MSG_EQ(security.GetOverhead(), 0, "Overhead of unsecured frames");
+
+    LrWpanMacHeader hdr(LrWpanMacHeader::LRWPAN_MAC_DATA, 1);
+    hdr.SetSrcAddrMode(LrWpanMacHeader::SHORTADDR);
+    hdr.SetDstAddrMode(LrWpanMacHeader::SHORTADDR);
+    hdr.SetSrcAddrFields(1, Mac16Address("00:01"));
+    hdr.SetDstAddrFields(1, Mac16Address("00:00"));
+    hdr.SetPanIdComp();
+    hdr.SetSecDisable();
+    const uint32_t plainSize = hdr.GetSerializedSize();
+
+    // Key index only: security control, frame counter and one key identifier byte
+    security.SetSecLevel(6);
+    NS_TEST_EXPECT_MSG_EQ(security.GetOverhead(), 5 + 1 + 8, "Wrong ENC-MIC-64 overhead");
+    security.Secure(hdr);
+    NS_TEST_EXPECT_MSG_EQ(hdr.IsSecEnable(), true, "Header not secured");
+    NS_TEST_EXPECT_MSG_EQ(hdr.GetSerializedSize(), plainSize + 5 + 1, "Wrong header size");
+    NS_TEST_EXPECT_MSG_EQ(hdr.GetFrmCounter(), 0, "Wrong first frame counter");
+    security.Secure(hdr);
+    NS_TEST_EXPECT_MSG_EQ(hdr.GetFrmCounter(), 1, "Frame counter not advanced");
+    NS_TEST_EXPECT_MSG_EQ(security.GetFrameCounter(), 2, "Wrong next frame counter");
+
+    // The header round-trips with its auxiliary security header.
+    Ptr<Packet> p = Create<Packet>(10);
+    p->AddHeader(hdr);
+    LrWpanMacHeader decoded;
+    p->RemoveHeader(decoded);
+    NS_TEST_EXPECT_MSG_EQ(decoded.GetFrmCounter(), 1, "Frame counter not serialized");
+    NS_TEST_EXPECT_MSG_EQ(+decoded.GetSecLevel(), 6, "Security level not serialized");
+
+    security.SetKeyIdMode(LrWpanMacHeader::LONGKEYSOURCE);
+    NS_TEST_EXPECT_MSG_EQ(security.GetOverhead(), 5 + 9 + 8, "Wrong 8-byte key source");
+
+    const Mac16Address neighbour("00:02");
+    NS_TEST_EXPECT_MSG_EQ(security.CheckFrameCounter(neighbour, 7), true, "First frame refused");
+    NS_TEST_EXPECT_MSG_EQ(security.CheckFrameCounter(neighbour, 7), false, "Replay accepted");
+    NS_TEST_EXPECT_MSG_EQ(security.CheckFrameCounter(neighbour, 3), false, "Old frame accepted");
+    NS_TEST_EXPECT_MSG_EQ(security.CheckFrameCounter(neighbour, 20), true, "Gap refused");
+    NS_TEST_EXPECT_MSG_EQ(security.CheckFrameCounter(Mac16Address("00:03"), 0),
+                          true,
+                          "Counters of another neighbour");
+    NS_TEST_EXPECT_MSG_EQ(security.GetNNeighbours(), 2, "Wrong number of neighbours");
+    NS_TEST_EXPECT_MSG_EQ(security.GetNReplays(), 2, "Wrong number of replays");
+}
+
+/**
+ * @brief Check that secured RIT frames carry the security overhead on the air, are
+ *        delivered with their original payload after the decryption delay, and that
+ *        both ends keep the frame counter of the other.
+ */
+class RitFrameSecurityLinkTest : public TestCase
+{
+  public:
+    RitFrameSecurityLinkTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Result of one run of the link.
+     */
+    struct LinkResult
+    {
+        uint32_t maxPsduSize{0}; //!< Largest PSDU sent by the sender
+        uint32_t nRx{0};         //!< Frames received
+        uint32_t rxSize{0};      //!< Size of the last frame received
+        Time macRxTime;          //!< Time the MAC accepted the last data frame
+        Time rxTime;             //!< Time the last frame was indicated
+    };
+
+    /**
+     * @brief Run a sender and a receiver and send one frame.
+     * @param secLevel Security level of both devices
+     * @param decryptDelay Decryption delay of the receiver
+     * @return the result
+     */
+    LinkResult RunLink(uint8_t secLevel, Time decryptDelay);
+
+    LinkResult m_result;              //!< Result of the run in progress
+    uint32_t m_senderNeighbours{0};   //!< Neighbours known to the sender
+    uint32_t m_receiverNeighbours{0}; //!< Neighbours known to the receiver
+    uint32_t m_senderFrameCounter{0}; //!< Next frame counter of the sender
+    uint64_t m_replays{0};            //!< Replays rejected by both ends
+};
+
+RitFrameSecurityLinkTest::RitFrameSecurityLinkTest()
+    : TestCase("Secured RIT data frames over a link")
+{
+}
+
+RitFrameSecurityLinkTest::LinkResult
+RitFrameSecurityLinkTest::RunLink(uint8_t secLevel, Time decryptDelay)
+{
+    m_result = LinkResult();
+    Ptr<Node> receiverNode = CreateObject<Node>();
+    Ptr<Node> senderNode = CreateObject<Node>();
+    Ptr<RitWpanNetDevice> receiverDevice = CreateObject<RitWpanNetDevice>();
+    Ptr<RitWpanNetDevice> senderDevice = CreateObject<RitWpanNetDevice>();
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+    receiverDevice->SetChannel(channel);
+    senderDevice->SetChannel(channel);
+
+    receiverDevice->SetAddress(Mac16Address("00:00"));
+    receiverDevice->SetRitRank(0);
+    senderDevice->SetAddress(Mac16Address("00:01"));
+    senderDevice->SetRitRank(1);
+    receiverNode->AddDevice(receiverDevice);
+    senderNode->AddDevice(senderDevice);
+
+    Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+    pibAttr->macRitPeriodTime = Time(Seconds(1));
+    for (const auto& device : {senderDevice, receiverDevice})
+    {
+        device->GetMac()->MlmeSetRequest(macRitPeriodTime, pibAttr);
+        device->GetMac()->SetAttribute("SecurityLevel", UintegerValue(secLevel));
+    }
+    receiverDevice->GetMac()->SetAttribute("SecurityDecryptDelay", TimeValue(decryptDelay));
+
+    senderDevice->GetPhy()->TraceConnectWithoutContext(
+        "PhyTxBegin",
+        Callback<void, Ptr<const Packet>>([this](Ptr<const Packet> p) {
+            m_result.maxPsduSize = std::max(m_result.maxPsduSize, p->GetSize());
+        }));
+    // Beacons are shorter than the data frame of 30 bytes.
+    receiverDevice->GetMac()->TraceConnectWithoutContext(
+        "MacRx",
+        Callback<void, Ptr<const Packet>>([this](Ptr<const Packet> p) {
+            if (p->GetSize() > 30)
+            {
+                m_result.macRxTime = Simulator::Now();
+            }
+        }));
+    receiverDevice->SetReceiveCallback(
+        Callback<bool, Ptr<NetDevice>, Ptr<const Packet>, uint16_t, const Address&>(
+            [this](Ptr<NetDevice>, Ptr<const Packet> p, uint16_t, const Address&) {
+                m_result.nRx++;
+                m_result.rxSize = p->GetSize();
+                m_result.rxTime = Simulator::Now();
+                return true;
+            }));
+
+    Simulator::ScheduleWithContext(senderNode->GetId(), Seconds(8.0), [=]() {
+        senderDevice->Send(Create<Packet>(30), Mac16Address("00:00"), 0);
+    });
+
+    Simulator::Stop(Seconds(12.0));
+    Simulator::Run();
+
+    const RitFrameSecurity& senderSecurity = senderDevice->GetMac()->GetFrameSecurity();
+    const RitFrameSecurity& receiverSecurity = receiverDevice->GetMac()->GetFrameSecurity();
+    m_senderNeighbours = senderSecurity.GetNNeighbours();
+    m_receiverNeighbours = receiverSecurity.GetNNeighbours();
+    m_senderFrameCounter = senderSecurity.GetFrameCounter();
+    m_replays = senderSecurity.GetNReplays() + receiverSecurity.GetNReplays();
+
+    Simulator::Destroy();
+    return m_result;
+}
+
+void
+RitFrameSecurityLinkTest::DoRun()
+{
+    const LinkResult plain = RunLink(0, Seconds(0));
+    NS_TEST_ASSERT_MSG_EQ(plain.nRx, 1, "Unsecured frame not received");
+    NS_TEST_EXPECT_MSG_EQ(m_senderFrameCounter, 0, "Unsecured frames counted");
+    NS_TEST_EXPECT_MSG_EQ(m_receiverNeighbours, 0, "Counters kept for unsecured frames");
+
+    // ENC-MIC-32 with a key index: 5 + 1 + 4 bytes
+    const LinkResult secured = RunLink(5, MilliSeconds(2));
+    NS_TEST_ASSERT_MSG_EQ(secured.nRx, 1, "Secured frame not received");
+    NS_TEST_EXPECT_MSG_EQ(secured.rxSize, plain.rxSize, "MIC left in the payload");
+    NS_TEST_EXPECT_MSG_EQ(secured.maxPsduSize,
+                          plain.maxPsduSize + 10,
+                          "Wrong security overhead of the data frame");
+    NS_TEST_EXPECT_MSG_EQ(plain.rxTime, plain.macRxTime, "Unsecured frame delayed");
+    NS_TEST_EXPECT_MSG_EQ(secured.rxTime,
+                          secured.macRxTime + MilliSeconds(2),
+                          "Frame not indicated after its decryption");
+    NS_TEST_EXPECT_MSG_GT(m_senderFrameCounter, 1, "Beacons and data not counted");
+    NS_TEST_EXPECT_MSG_EQ(m_senderNeighbours, 1, "Beacons of the receiver not checked");
+    NS_TEST_EXPECT_MSG_EQ(m_receiverNeighbours, 1, "Data frame of the sender not checked");
+    NS_TEST_EXPECT_MSG_EQ(m_replays, 0, "Fresh frames taken for replays");
+}
+
+class RitFrameSecurityTestSuite : public TestSuite
+{
+  public:
+    RitFrameSecurityTestSuite();
+};
+
+RitFrameSecurityTestSuite::RitFrameSecurityTestSuite()
+    : TestSuite("rit-frame-security", Type::UNIT)
+{
+    AddTestCase(new RitFrameSecurityOverheadTest, Duration::QUICK);
+    AddTestCase(new RitFrameSecurityLinkTest, Duration::QUICK);
+}
+
+static RitFrameSecurityTestSuite g_ritFrameSecurityTestSuite;
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/boolean.h>
+#include <ns3/core-module.h>
+#include <ns3/log.h>
+#include <ns3/network-module.h>
+#include <ns3/packet.h>
+#include <ns3/propagation-delay-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/rit-wpan-gateway-net-device.h>
+#include <ns3/rit-wpan-mac.h>
+#include <ns3/rit-wpan-net-device.h>
+#include <ns3/rit-wpan-nwk.h>
+#include <ns3/single-model-spectrum-channel.h>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-gateway-test");
+
+/**
+ * @brief Check that a two-radio gateway moves children to its idle radio and delivers
+ *        the frames of both radios through its one NWK.
+ */
+class RitGatewayLoadBalancingTest : public TestCase
+{
+  public:
+    RitGatewayLoadBalancingTest();
+
+  private:
+    /**
+     * @brief Count the packets delivered at the gateway.
+     * @param dev The device
+     * @param pkt The packet
+     * @param proto The protocol number
+     * @param addr The source address
+     * @return true
+     */
+    bool DataIndication(Ptr<NetDevice> dev,
+                        Ptr<const Packet> pkt,
+                        uint16_t proto,
+                        const Address& addr);
+
+    /**
+     * @brief Count the redirects of the gateway.
+     * @param from Radio advertising the redirect
+     * @param to Radio whose channel is advertised
+     */
+    void RadioRedirect(uint32_t from, uint32_t to);
+
+    void DoRun() override;
+
+    uint32_t m_nRx{0};        //!< Packets delivered
+    uint32_t m_nRedirects{0}; //!< RadioRedirect traces
+};
+
+RitGatewayLoadBalancingTest::RitGatewayLoadBalancingTest()
+    : TestCase("RitWpanGatewayNetDevice load balancing and merged delivery")
+{
+}
+
+bool
+RitGatewayLoadBalancingTest::DataIndication(Ptr<NetDevice> dev,
+                                            Ptr<const Packet> pkt,
+                                            uint16_t proto,
+                                            const Address& addr)
+{
+    m_nRx++;
+    return true;
+}
+
+void
+RitGatewayLoadBalancingTest::RadioRedirect(uint32_t from, uint32_t to)
+{
+    m_nRedirects++;
+}
+
+void
+RitGatewayLoadBalancingTest::DoRun()
+{
+    const uint32_t nChildren = 4;
+    const uint32_t nPackets = 20;
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    // Radio 0 on channel 11 of the plan {11, 12}, radio 1 on channel 13 out of it.
+    Ptr<Node> gatewayNode = CreateObject<Node>();
+    Ptr<RitWpanGatewayNetDevice> gateway = CreateObject<RitWpanGatewayNetDevice>();
+    gateway->SetAttribute("RebalanceInterval", TimeValue(Seconds(5)));
+    gateway->AddRadio(13);
+    gateway->SetChannel(channel);
+    gateway->SetAddress(Mac16Address("00:00"));
+    gateway->SetRitRank(0);
+    gatewayNode->AddDevice(gateway);
+    gateway->SetReceiveCallback(MakeCallback(&RitGatewayLoadBalancingTest::DataIndication, this));
+    gateway->TraceConnectWithoutContext(
+        "RadioRedirect",
+        MakeCallback(&RitGatewayLoadBalancingTest::RadioRedirect, this));
+
+    std::vector<Ptr<RitWpanNetDevice>> devices{gateway};
+    std::vector<Ptr<Node>> childNodes;
+    for (uint32_t i = 1; i <= nChildren; i++)
+    {
+        Ptr<Node> node = CreateObject<Node>();
+        Ptr<RitWpanNetDevice> device = CreateObject<RitWpanNetDevice>();
+        device->SetChannel(channel);
+        device->SetAddress(Mac16Address(static_cast<uint16_t>(i)));
+        device->SetRitRank(1);
+        node->AddDevice(device);
+        devices.push_back(device);
+        childNodes.push_back(node);
+    }
+
+    Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+    pibAttr->macRitPeriodTime = Time(Seconds(1));
+    for (const auto& device : devices)
+    {
+        Ptr<RitWpanMac> mac = device->GetMac();
+        mac->MlmeSetRequest(macRitPeriodTime, pibAttr);
+        mac->SetRxChannelPlan(11, 2);
+        mac->SetRxChannel(RitWpanMac::GetPlannedRxChannel(mac->GetShortAddress(), 11, 2));
+        device->GetNwk()->SetAttribute("DuplicateDetection", BooleanValue(true));
+    }
+
+    for (uint32_t i = 0; i < nChildren; i++)
+    {
+        Ptr<RitWpanNetDevice> device = devices[i + 1];
+        for (uint32_t k = 0; k < nPackets; k++)
+        {
+            const Time at = Seconds(5) + MilliSeconds(2000 * k + 450 * i);
+            Simulator::ScheduleWithContext(childNodes[i]->GetId(), at, [=]() {
+                device->Send(Create<Packet>(20), Mac16Address("00:00"), 0);
+            });
+        }
+    }
+
+    Simulator::Stop(Seconds(60.0));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(gateway->GetNRadios(), 2, "Wrong number of radios");
+    NS_TEST_EXPECT_MSG_EQ(+gateway->GetRadioChannel(0), 11, "Radio 0 off its planned channel");
+    NS_TEST_EXPECT_MSG_EQ(+gateway->GetRadioMac(1)->GetRxChannel(), 13, "Radio 1 off channel");
+    NS_TEST_EXPECT_MSG_EQ(gateway->GetRadioMac(1)->GetShortAddress(),
+                          Mac16Address("00:00"),
+                          "Radio 1 under another address");
+
+    // The children start on radio 0; the redirects move some of them to radio 1.
+    NS_TEST_EXPECT_MSG_GT(m_nRedirects, 0, "No child redirected");
+    NS_TEST_EXPECT_MSG_EQ(m_nRedirects,
+                          gateway->GetRadioNRedirects(0) + gateway->GetRadioNRedirects(1),
+                          "Redirects not counted per radio");
+    NS_TEST_EXPECT_MSG_GT(gateway->GetRadioNRx(0), 0, "Nothing received on radio 0");
+    NS_TEST_EXPECT_MSG_GT(gateway->GetRadioNRx(1), 0, "Nothing received on radio 1");
+    NS_TEST_EXPECT_MSG_EQ(gateway->GetRadioNChildren(0) + gateway->GetRadioNChildren(1),
+                          nChildren,
+                          "A child heard on no radio");
+
+    // Merged delivery: what either radio received went up the one NWK, once.
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(m_nRx, nChildren * nPackets, "Packet delivered twice");
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(m_nRx,
+                                gateway->GetRadioNRx(0) + gateway->GetRadioNRx(1),
+                                "Packet delivered without a radio");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(m_nRx, nChildren * nPackets * 9 / 10, "Packets lost");
+
+    Simulator::Destroy();
+}
+
+class RitGatewayTestSuite : public TestSuite
+{
+  public:
+    RitGatewayTestSuite();
+};
+
+RitGatewayTestSuite::RitGatewayTestSuite()
+    : TestSuite("rit-gateway", Type::UNIT)
+{
+    AddTestCase(new RitGatewayLoadBalancingTest, Duration::QUICK);
+}
+
+static RitGatewayTestSuite g_ritGatewayTestSuite;
@@ -0,0 +1,420 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/core-module.h>
+#include <ns3/log.h>
+#include <ns3/mobility-module.h>
+#include <ns3/network-module.h>
+#include <ns3/periodic-sender-helper.h>
+#include <ns3/random-sender-helper.h>
+#include <ns3/rit-metrics-collector.h>
+#include <ns3/rit-rank-helper.h>
+#include <ns3/rit-wpan-helper.h>
+#include <ns3/test.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-golden-metrics-test");
+
+namespace
+{
+
+/**
+ * A small fixed-seed scenario of rit-grid-converge: the edge-low or center-middle grid
+ * with the periodic or random traffic, at a 1 s BI and for 600 s.
+ */
+struct RitGoldenScenario
+{
+    std::string placement; //!< "edge" (15 routers, low) or "center" (48 routers, middle)
+    std::string app;       //!< "periodic" or "random"
+};
+
+/**
+ * Figures of a run, and the budgets of the golden file.
+ */
+struct RitGoldenMetrics
+{
+    double pdr = NAN;         //!< Distinct packets delivered over those sent
+    double avgDelay = NAN;    //!< Mean end-to-end delay of those delivered [s]
+    double wakeRatio = NAN;   //!< Mean share of time the routers were not in TRX_OFF
+    uint64_t events = 0;      //!< Events executed by Simulator::Run()
+    uint64_t eventBudget = 0; //!< Events allowed (golden file only)
+    double wallSeconds = NAN; //!< Wall time of Simulator::Run(), or the time allowed [s]
+};
+
+constexpr double SIM_TIME_SEC = 600;        //!< Simulated time of a scenario
+constexpr double PDR_TOL = 0.02;            //!< Absolute PDR tolerance
+constexpr double DELAY_TOL = 0.05;          //!< Relative mean delay tolerance
+constexpr double WAKE_RATIO_TOL = 0.05;     //!< Relative wake ratio tolerance
+constexpr double EVENT_TOL = 0.05;          //!< Relative event count tolerance
+constexpr double EVENT_HEADROOM = 1.02;     //!< Event budget recorded over the count
+constexpr double WALL_HEADROOM = 5.0;       //!< Wall time budget recorded over the time
+constexpr double MIN_WALL_BUDGET_SEC = 2.0; //!< Smallest wall time budget recorded
+
+const char* const GOLDEN_HEADER = "pdr,avg_delay,wake_ratio,events,event_budget,wall_budget";
+
+/// Opt-in wall time check, a machine-dependent figure (NS_GLOBAL_VALUE=RitGoldenWallBudget=1)
+GlobalValue g_ritGoldenWallBudget("RitGoldenWallBudget",
+                                  "Check the wall time of the golden scenarios against their "
+                                  "budget",
+                                  BooleanValue(false),
+                                  MakeBooleanChecker());
+
+} // namespace
+
+/**
+ * @brief Run a small fixed-seed RIT scenario and compare its PDR, mean delay, router wake
+ *        ratio and event count with the golden file test/rit-golden-<scenario>.csv, and
+ *        its events with the budget of that file.
+ *
+ * The golden files are (re)written from the current tree with
+ *
+ *   ./test.py -s rit-golden-metrics --update-data
+ *
+ * which records the budgets with a headroom over the figures measured; a scenario without
+ * its golden file fails. The wall time budget depends on the machine, so it is only checked
+ * with NS_GLOBAL_VALUE=RitGoldenWallBudget=1 on the machine that recorded it.
+ */
+class RitGoldenMetricsTest : public TestCase
+{
+  public:
+    /**
+     * @brief Constructor.
+     * @param scenario The scenario
+     */
+    RitGoldenMetricsTest(const RitGoldenScenario& scenario);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Get the name of a scenario, e.g. edge-low-periodic.
+     * @param scenario The scenario
+     * @return the name
+     */
+    static std::string GetName(const RitGoldenScenario& scenario);
+
+    /**
+     * @brief Place the sink and the routers and set the router ranks as
+     *        InstallTopologyEdge() and InstallTopologyCenter() of rit-grid-converge do.
+     * @param sinks The sink
+     * @param routers The routers
+     */
+    void InstallTopology(NodeContainer sinks, NodeContainer routers) const;
+
+    /**
+     * @brief Install the traffic of the routers and the receive-only sink application.
+     * @param sinks The sink
+     * @param routers The routers
+     * @param stream The first stream of the applications
+     */
+    void InstallApplications(NodeContainer sinks, NodeContainer routers, int64_t stream) const;
+
+    /**
+     * @brief Build and run the scenario.
+     * @return the figures of the run
+     */
+    RitGoldenMetrics RunScenario() const;
+
+    /**
+     * @brief Read a golden file.
+     * @param path The file
+     * @param golden The figures and budgets read
+     * @return false if the file is missing or has no row
+     */
+    static bool ReadGolden(const std::string& path, RitGoldenMetrics& golden);
+
+    /**
+     * @brief Write the figures of a run and the budgets recorded from them.
+     * @param path The file
+     * @param measured The figures of the run
+     */
+    static void WriteGolden(const std::string& path, const RitGoldenMetrics& measured);
+
+    RitGoldenScenario m_scenario; //!< Scenario run
+};
+
+RitGoldenMetricsTest::RitGoldenMetricsTest(const RitGoldenScenario& scenario)
+    : TestCase("Golden metrics and budgets of " + GetName(scenario)),
+      m_scenario(scenario)
+{
+}
+
+std::string
+RitGoldenMetricsTest::GetName(const RitGoldenScenario& scenario)
+{
+    return (scenario.placement == "edge" ? "edge-low-" : "center-middle-") + scenario.app;
+}
+
+void
+RitGoldenMetricsTest::InstallTopology(NodeContainer sinks, NodeContainer routers) const
+{
+    auto positionAlloc = CreateObject<GridPositionAllocator>();
+    positionAlloc->SetMinX(0.0);
+    positionAlloc->SetMinY(0.0);
+    positionAlloc->SetLayoutType(GridPositionAllocator::ROW_FIRST);
+    Vector sinkPos;
+    RitWpanRankHelper rankHelper;
+    MobilityHelper mob;
+    mob.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    if (m_scenario.placement == "edge")
+    {
+        // 3 columns, 70 m spacing, sink above the top edge
+        positionAlloc->SetDeltaX(70.0);
+        positionAlloc->SetDeltaY(70.0);
+        positionAlloc->SetN(3);
+        mob.SetPositionAllocator(positionAlloc);
+        mob.Install(routers);
+        rankHelper.Install(routers, 3);
+        sinkPos = Vector(70.0, -70.0, 0.0);
+    }
+    else
+    {
+        // 7 columns, 40 m spacing, sink in the middle
+        positionAlloc->SetDeltaX(40.0);
+        positionAlloc->SetDeltaY(40.0);
+        positionAlloc->SetN(7);
+        mob.SetPositionAllocator(positionAlloc);
+        mob.Install(routers);
+        const std::vector<uint8_t> ranks = {
+            3, 3, 3, 3, 3, 3, 3, 3, 2, 2, 2, 2, 2, 3, 3, 2, 1, 1, 1, 2, 3, 3, 2, 1, 0,
+            1, 2, 3, 3, 2, 1, 1, 1, 2, 3, 3, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3,
+        };
+        rankHelper.Install(routers, ranks);
+        sinkPos = Vector(120.0, 120.0, 0.0);
+    }
+
+    auto sinkAlloc = CreateObject<ListPositionAllocator>();
+    sinkAlloc->Add(sinkPos);
+    MobilityHelper sinkMob;
+    sinkMob.SetPositionAllocator(sinkAlloc);
+    sinkMob.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    sinkMob.Install(sinks);
+}
+
+void
+RitGoldenMetricsTest::InstallApplications(NodeContainer sinks,
+                                          NodeContainer routers,
+                                          int64_t stream) const
+{
+    if (m_scenario.app == "periodic")
+    {
+        PeriodicSenderHelper routerApp;
+        routerApp.SetPeriod(Seconds(60));
+        routerApp.SetPacketSize(8);
+        routerApp.SetDstAddr(Mac16Address("00:00"));
+        routerApp.Install(routers);
+        routerApp.AssignStreams(routers, stream);
+
+        PeriodicSenderHelper sinkApp;
+        sinkApp.SetReceiveOnly(true);
+        sinkApp.Install(sinks);
+        sinkApp.AssignStreams(sinks, stream);
+        return;
+    }
+
+    RandomSenderHelper routerApp;
+    routerApp.SetMinInterval(Seconds(30));
+    routerApp.SetMaxInterval(Seconds(90));
+    routerApp.SetPacketSize(8);
+    routerApp.SetDstAddr(Mac16Address("00:00"));
+    routerApp.Install(routers);
+    routerApp.AssignStreams(routers, stream);
+
+    RandomSenderHelper sinkApp;
+    sinkApp.SetReceiveOnly(true);
+    sinkApp.Install(sinks);
+    sinkApp.AssignStreams(sinks, stream);
+}
+
+RitGoldenMetrics
+RitGoldenMetricsTest::RunScenario() const
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    const bool edge = m_scenario.placement == "edge";
+    NodeContainer sinks;
+    NodeContainer routers;
+    sinks.Create(1);
+    routers.Create(edge ? 15 : 48);
+    NodeContainer allNodes(sinks, routers);
+
+    // Sink BI of EffectiveParentBeaconInterval(): BI for edge-low, BI / 4 for center-middle
+    RitWpanNetHelper helper;
+    helper.SetMacRitDataWaitDuration(MilliSeconds(10));
+    helper.SetMacRitTxWaitDuration(MilliSeconds(5000));
+    helper.SetMacRitPeriod(edge ? MilliSeconds(1000) : MilliSeconds(250));
+    helper.SetRxAlwaysOn(true);
+    helper.InstallSinks(sinks);
+    helper.SetMacRitPeriod(MilliSeconds(1000));
+    helper.SetRxAlwaysOn(false);
+    helper.Install(routers);
+
+    InstallTopology(sinks, routers);
+    const int64_t appStream = helper.AssignStreams(allNodes, 0);
+    InstallApplications(sinks, routers, appStream);
+
+    Ptr<RitMetricsCollector> collector = Create<RitMetricsCollector>();
+    for (uint32_t i = 0; i < allNodes.GetN(); i++)
+    {
+        collector->Install(allNodes.Get(i));
+    }
+
+    RitGoldenMetrics measured;
+    const uint64_t eventsBefore = Simulator::GetEventCount();
+    const auto runStart = std::chrono::steady_clock::now();
+    Simulator::Stop(Seconds(SIM_TIME_SEC));
+    Simulator::Run();
+    measured.wallSeconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count();
+    measured.events = Simulator::GetEventCount() - eventsBefore;
+
+    const RitMetricsCollector::Totals totals = collector->GetTotals();
+    if (totals.txUnique > 0)
+    {
+        measured.pdr = static_cast<double>(totals.delivered) / totals.txUnique;
+    }
+    if (totals.delivered > 0)
+    {
+        measured.avgDelay = totals.delaySum / totals.delivered;
+    }
+    double wakeSum = 0.0;
+    uint32_t nWake = 0;
+    for (uint32_t i = 0; i < routers.GetN(); i++)
+    {
+        const double wake = collector->GetWakeRatio(routers.Get(i)->GetId());
+        if (wake >= 0.0)
+        {
+            wakeSum += wake;
+            nWake++;
+        }
+    }
+    if (nWake > 0)
+    {
+        measured.wakeRatio = wakeSum / nWake;
+    }
+
+    Simulator::Destroy();
+    return measured;
+}
+
+bool
+RitGoldenMetricsTest::ReadGolden(const std::string& path, RitGoldenMetrics& golden)
+{
+    std::ifstream in(path);
+    std::string header;
+    std::string row;
+    if (!std::getline(in, header) || !std::getline(in, row) || header != GOLDEN_HEADER)
+    {
+        return false;
+    }
+    std::istringstream fields(row);
+    char comma = 0;
+    fields >> golden.pdr >> comma >> golden.avgDelay >> comma >> golden.wakeRatio >> comma >>
+        golden.events >> comma >> golden.eventBudget >> comma >> golden.wallSeconds;
+    return !fields.fail();
+}
+
+void
+RitGoldenMetricsTest::WriteGolden(const std::string& path, const RitGoldenMetrics& measured)
+{
+    std::ofstream out(path);
+    out << GOLDEN_HEADER << "\n"
+        << std::setprecision(9) << measured.pdr << "," << measured.avgDelay << ","
+        << measured.wakeRatio << "," << measured.events << ","
+        << static_cast<uint64_t>(std::ceil(measured.events * EVENT_HEADROOM)) << ","
+        << std::setprecision(3)
+        << std::max(MIN_WALL_BUDGET_SEC, std::ceil(measured.wallSeconds * WALL_HEADROOM)) << "\n";
+}
+
+void
+RitGoldenMetricsTest::DoRun()
+{
+    SetDataDir(NS_TEST_SOURCEDIR);
+    const std::string name = GetName(m_scenario);
+    const std::string file = "rit-golden-" + name + ".csv";
+
+    RitGoldenMetrics golden;
+    const bool hasGolden = ReadGolden(CreateDataDirFilename(file), golden);
+    const RitGoldenMetrics measured = RunScenario();
+
+    // --update-data points the temporary file at the data directory
+    const std::string output = CreateTempDirFilename(file);
+    WriteGolden(output, measured);
+    if (output == CreateDataDirFilename(file))
+    {
+        NS_LOG_UNCOND("[GOLDEN] " << name << " recorded in " << output);
+        return;
+    }
+
+    NS_TEST_ASSERT_MSG_EQ(hasGolden,
+                          true,
+                          name << ": no golden figures in " << file
+                               << ", record them with ./test.py -s rit-golden-metrics"
+                               << " --update-data");
+
+    NS_TEST_EXPECT_MSG_EQ_TOL(measured.pdr, golden.pdr, PDR_TOL, name << ": PDR changed");
+    NS_TEST_EXPECT_MSG_EQ_TOL(measured.avgDelay,
+                              golden.avgDelay,
+                              DELAY_TOL * golden.avgDelay,
+                              name << ": mean delay changed");
+    NS_TEST_EXPECT_MSG_EQ_TOL(measured.wakeRatio,
+                              golden.wakeRatio,
+                              WAKE_RATIO_TOL * golden.wakeRatio,
+                              name << ": wake ratio changed");
+    NS_TEST_EXPECT_MSG_EQ_TOL(static_cast<double>(measured.events),
+                              static_cast<double>(golden.events),
+                              EVENT_TOL * golden.events,
+                              name << ": event count changed");
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(measured.events,
+                                golden.eventBudget,
+                                name << ": " << measured.events << " events, budget "
+                                     << golden.eventBudget);
+    BooleanValue wallBudget;
+    GlobalValue::GetValueByName("RitGoldenWallBudget", wallBudget);
+    if (wallBudget.Get())
+    {
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(measured.wallSeconds,
+                                    golden.wallSeconds,
+                                    name << ": " << measured.wallSeconds
+                                         << " s of wall time, budget " << golden.wallSeconds
+                                         << " s");
+    }
+}
+
+class RitGoldenMetricsTestSuite : public TestSuite
+{
+  public:
+    RitGoldenMetricsTestSuite();
+};
+
+RitGoldenMetricsTestSuite::RitGoldenMetricsTestSuite()
+    : TestSuite("rit-golden-metrics", Type::UNIT)
+{
+    for (const char* placement : {"edge", "center"})
+    {
+        for (const char* app : {"periodic", "random"})
+        {
+            AddTestCase(new RitGoldenMetricsTest({placement, app}), Duration::QUICK);
+        }
+    }
+}
+
+static RitGoldenMetricsTestSuite g_ritGoldenMetricsTestSuite;
@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/boolean.h>
+#include <ns3/core-module.h>
+#include <ns3/log.h>
+#include <ns3/network-module.h>
+#include <ns3/packet.h>
+#include <ns3/periodic-sender-helper.h>
+#include <ns3/rit-hop-latency-tag.h>
+#include <ns3/rit-wpan-helper.h>
+#include <ns3/rit-wpan-mac.h>
+#include <ns3/rit-wpan-net-device.h>
+#include <ns3/test.h>
+
+#include <map>
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-hop-latency-test");
+
+/**
+ * @brief Check that the records of several hops survive the byte tags of a packet and come
+ *        back from Collect() in hop order, without the sender-side ACK time.
+ */
+class RitHopLatencyTagTest : public TestCase
+{
+  public:
+    RitHopLatencyTagTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitHopLatencyTagTest::RitHopLatencyTagTest()
+    : TestCase("RitHopLatencyTag byte tags and Collect()")
+{
+}
+
+void
+RitHopLatencyTagTest::DoRun()
+{
+    std::vector<RitHopLatencyRecord> hops(2);
+    for (uint32_t h = 0; h < hops.size(); h++)
+    {
+        const int64_t base = 1000 * (h + 1);
+        hops[h].addr = Mac16Address(static_cast<uint16_t>(2 - h));
+        hops[h].nwkEnqueue = MilliSeconds(base);
+        hops[h].macQueueHead = MilliSeconds(base + 1);
+        hops[h].beaconWaitStart = MilliSeconds(base + 2);
+        hops[h].beaconRx = MilliSeconds(base + 300);
+        hops[h].csStart = MilliSeconds(base + 301);
+        hops[h].csEnd = MilliSeconds(base + 305);
+        hops[h].phyTxStart = MilliSeconds(base + 306);
+        hops[h].ackRx = MilliSeconds(base + 310);
+    }
+
+    // Tags added by the forwarder first: Collect() orders by PHY TX start
+    Ptr<Packet> p = Create<Packet>(20);
+    p->AddByteTag(RitHopLatencyTag(hops[1]));
+    p->AddByteTag(RitHopLatencyTag(hops[0]));
+    NS_TEST_EXPECT_MSG_EQ(RitHopLatencyTag::Collect(Create<Packet>(20)).size(), 0, "Untagged");
+
+    std::vector<RitHopLatencyRecord> collected = RitHopLatencyTag::Collect(p);
+    NS_TEST_ASSERT_MSG_EQ(collected.size(), 2, "Wrong number of hops");
+    for (uint32_t h = 0; h < hops.size(); h++)
+    {
+        const RitHopLatencyRecord& r = collected[h];
+        NS_TEST_EXPECT_MSG_EQ(r.addr, hops[h].addr, "Address of hop " << h);
+        NS_TEST_EXPECT_MSG_EQ(r.nwkEnqueue, hops[h].nwkEnqueue, "NWK enqueue of hop " << h);
+        NS_TEST_EXPECT_MSG_EQ(r.macQueueHead, hops[h].macQueueHead, "Queue head of hop " << h);
+        NS_TEST_EXPECT_MSG_EQ(r.beaconWaitStart,
+                              hops[h].beaconWaitStart,
+                              "Beacon wait of hop " << h);
+        NS_TEST_EXPECT_MSG_EQ(r.beaconRx, hops[h].beaconRx, "Beacon of hop " << h);
+        NS_TEST_EXPECT_MSG_EQ(r.csStart, hops[h].csStart, "CS start of hop " << h);
+        NS_TEST_EXPECT_MSG_EQ(r.csEnd, hops[h].csEnd, "CS end of hop " << h);
+        NS_TEST_EXPECT_MSG_EQ(r.phyTxStart, hops[h].phyTxStart, "PHY TX of hop " << h);
+        NS_TEST_EXPECT_MSG_EQ(r.ackRx, Time(), "ACK time carried by the tag");
+    }
+
+    // Byte tags follow the payload through fragment copies (header removal)
+    Ptr<Packet> payload = p->CreateFragment(0, p->GetSize());
+    NS_TEST_EXPECT_MSG_EQ(RitHopLatencyTag::Collect(payload).size(), 2, "Tags lost in a copy");
+}
+
+/**
+ * @brief Check the stage timestamps of a packet sent over two hops: one record per hop at
+ *        the sink, stages in order, the forwarding after the first hop, and the sender-side
+ *        HopLatency trace with the ACK time.
+ */
+class RitHopLatencyChainTest : public TestCase
+{
+  public:
+    RitHopLatencyChainTest();
+
+  private:
+    /**
+     * @brief Log one hop record of a packet received by the sink.
+     * @param p The packet
+     * @param hop Hop index
+     * @param record Stage timestamps of the hop
+     */
+    void RxHop(Ptr<const Packet> p, uint32_t hop, const RitHopLatencyRecord& record);
+
+    void DoRun() override;
+
+    std::map<uint64_t, std::vector<RitHopLatencyRecord>> m_rxHops; //!< Hops by packet UID
+    std::map<uint64_t, Time> m_appTx;                              //!< Send time by packet UID
+    std::vector<RitHopLatencyRecord> m_leafDone;                   //!< HopLatency of the leaf
+};
+
+RitHopLatencyChainTest::RitHopLatencyChainTest()
+    : TestCase("Per-hop latency stages over a two-hop chain")
+{
+}
+
+void
+RitHopLatencyChainTest::RxHop(Ptr<const Packet> p, uint32_t hop, const RitHopLatencyRecord& record)
+{
+    std::vector<RitHopLatencyRecord>& hops = m_rxHops[p->GetUid()];
+    NS_TEST_EXPECT_MSG_EQ(hop, hops.size(), "Hops not reported in order");
+    hops.push_back(record);
+}
+
+void
+RitHopLatencyChainTest::DoRun()
+{
+    // Sink (rank 0) <- relay (rank 1) <- leaf (rank 2): the leaf only answers rank 1 beacons
+    NodeContainer nodes;
+    nodes.Create(3);
+    RitWpanNetHelper helper;
+    helper.SetMacRitPeriod(Seconds(1));
+    helper.SetMacRitDataWaitDuration(MilliSeconds(10));
+    helper.SetMacRitTxWaitDuration(Seconds(5));
+    NetDeviceContainer devices = helper.Install(nodes);
+    for (uint32_t i = 0; i < devices.GetN(); i++)
+    {
+        Ptr<RitWpanNetDevice> dev = DynamicCast<RitWpanNetDevice>(devices.Get(i));
+        dev->SetAddress(Mac16Address(static_cast<uint16_t>(i)));
+        dev->SetRitRank(i);
+        dev->GetMac()->SetAttribute("HopLatencyEnabled", BooleanValue(true));
+    }
+    Ptr<RitWpanNetDevice> leaf = DynamicCast<RitWpanNetDevice>(devices.Get(2));
+    leaf->GetMac()->TraceConnectWithoutContext(
+        "HopLatency",
+        Callback<void, const RitHopLatencyRecord&>(
+            [this](const RitHopLatencyRecord& r) { m_leafDone.push_back(r); }));
+
+    PeriodicSenderHelper sinkApp;
+    sinkApp.SetReceiveOnly(true);
+    ApplicationContainer sinkApps = sinkApp.Install(nodes.Get(0));
+    sinkApps.Get(0)->TraceConnectWithoutContext(
+        "RxHopLatency",
+        MakeCallback(&RitHopLatencyChainTest::RxHop, this));
+    PeriodicSenderHelper leafApp;
+    leafApp.SetPeriod(Seconds(20));
+    leafApp.SetPacketSize(20);
+    leafApp.SetDstAddr(Mac16Address("00:00"));
+    ApplicationContainer leafApps = leafApp.Install(nodes.Get(2));
+    leafApps.Get(0)->TraceConnectWithoutContext(
+        "Tx",
+        Callback<void, Ptr<const Packet>>(
+            [this](Ptr<const Packet> p) { m_appTx.emplace(p->GetUid(), Simulator::Now()); }));
+
+    Simulator::Stop(Seconds(70));
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_GT(m_rxHops.size(), 0, "No packet delivered to the sink");
+    for (const auto& [uid, hops] : m_rxHops)
+    {
+        NS_TEST_ASSERT_MSG_EQ(hops.size(), 2, "Packet " << uid << " not tagged once per hop");
+        NS_TEST_EXPECT_MSG_EQ(hops[0].addr, Mac16Address("00:02"), "First hop not the leaf");
+        NS_TEST_EXPECT_MSG_EQ(hops[1].addr, Mac16Address("00:01"), "Second hop not the relay");
+        auto tx = m_appTx.find(uid);
+        NS_TEST_ASSERT_MSG_EQ((tx != m_appTx.end()), true, "Packet not sent by the leaf");
+        NS_TEST_EXPECT_MSG_GT_OR_EQ(hops[0].nwkEnqueue, tx->second, "Enqueued before sent");
+        // The relay hands the packet back to its NWK once the first hop is over
+        NS_TEST_EXPECT_MSG_GT(hops[1].nwkEnqueue, hops[0].phyTxStart, "Forwarded too early");
+
+        for (uint32_t h = 0; h < hops.size(); h++)
+        {
+            const RitHopLatencyRecord& r = hops[h];
+            NS_TEST_EXPECT_MSG_EQ(r.beaconRx.IsStrictlyPositive(), true, "No beacon, hop " << h);
+            NS_TEST_EXPECT_MSG_EQ(r.phyTxStart.IsStrictlyPositive(), true, "No TX, hop " << h);
+            NS_TEST_EXPECT_MSG_LT_OR_EQ(r.nwkEnqueue, r.macQueueHead, "Queue head, hop " << h);
+            NS_TEST_EXPECT_MSG_LT_OR_EQ(r.macQueueHead,
+                                        r.beaconWaitStart,
+                                        "Beacon wait, hop " << h);
+            NS_TEST_EXPECT_MSG_LT_OR_EQ(r.beaconWaitStart, r.beaconRx, "Beacon, hop " << h);
+            NS_TEST_EXPECT_MSG_LT_OR_EQ(r.beaconRx, r.csStart, "CS start, hop " << h);
+            NS_TEST_EXPECT_MSG_LT_OR_EQ(r.csStart, r.csEnd, "CS end, hop " << h);
+            NS_TEST_EXPECT_MSG_LT_OR_EQ(r.csEnd, r.phyTxStart, "PHY TX, hop " << h);
+            NS_TEST_EXPECT_MSG_EQ(r.ackRx, Time(), "ACK time carried, hop " << h);
+        }
+
+        // The leaf reports the same stages with the ACK time when its hop is over
+        bool found = false;
+        for (const RitHopLatencyRecord& done : m_leafDone)
+        {
+            if (done.phyTxStart != hops[0].phyTxStart)
+            {
+                continue;
+            }
+            found = true;
+            NS_TEST_EXPECT_MSG_EQ(done.nwkEnqueue, hops[0].nwkEnqueue, "NWK enqueue differs");
+            NS_TEST_EXPECT_MSG_EQ(done.beaconRx, hops[0].beaconRx, "Beacon differs");
+            NS_TEST_EXPECT_MSG_GT(done.ackRx, done.phyTxStart, "ACK before the frame");
+        }
+        NS_TEST_EXPECT_MSG_EQ(found, true, "No HopLatency at the leaf for packet " << uid);
+    }
+
+    Simulator::Destroy();
+}
+
+class RitHopLatencyTestSuite : public TestSuite
+{
+  public:
+    RitHopLatencyTestSuite();
+};
+
+RitHopLatencyTestSuite::RitHopLatencyTestSuite()
+    : TestSuite("rit-hop-latency", Type::UNIT)
+{
+    AddTestCase(new RitHopLatencyTagTest, Duration::QUICK);
+    AddTestCase(new RitHopLatencyChainTest, Duration::QUICK);
+}
+
+static RitHopLatencyTestSuite g_ritHopLatencyTestSuite;
@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/core-module.h>
+#include <ns3/log.h>
+#include <ns3/network-module.h>
+#include <ns3/packet.h>
+#include <ns3/propagation-delay-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/rit-appointment-header.h>
+#include <ns3/rit-ie.h>
+#include <ns3/rit-wpan-mac.h>
+#include <ns3/rit-wpan-net-device.h>
+#include <ns3/single-model-spectrum-channel.h>
+
+#include <cstdint>
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-ie-test");
+
+/**
+ * @brief Check the encoding of header IEs, their parsing up to the termination, the
+ *        length check of the registered types and the rejection of malformed lists.
+ */
+class RitIeCodecTest : public TestCase
+{
+  public:
+    RitIeCodecTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitIeCodecTest::RitIeCodecTest()
+    : TestCase("Encoding and parsing of RIT header IEs")
+{
+}
+
+void
+RitIeCodecTest::DoRun()
+{
+    RitIeList list;
+    list.AddU16(RIT_IE_RANK, 0x0203);
+    list.AddU8(RIT_IE_CHANNEL, 15);
+    RitAppointmentHeader appointment;
+    appointment.SetOffset(MilliSeconds(250));
+    appointment.SetPeriod(Seconds(1));
+    list.AddHeader(RIT_IE_APPOINTMENT, appointment);
+    NS_TEST_EXPECT_MSG_EQ(list.GetEncodedSize(false), 2 + 2 + 2 + 1 + 2 + 8, "Wrong size");
+
+    // Rank IE: length 2, element ID 0x40, type 0
+    std::vector<uint8_t> bytes = list.Encode(true);
+    NS_TEST_ASSERT_MSG_EQ(bytes.size(), list.GetEncodedSize(true), "Wrong encoded size");
+    NS_TEST_EXPECT_MSG_EQ(bytes[0], 0x02, "Wrong descriptor");
+    NS_TEST_EXPECT_MSG_EQ(bytes[1], 0x20, "Wrong descriptor");
+    NS_TEST_EXPECT_MSG_EQ(bytes[2], 0x03, "Content not little endian");
+    // Header Termination 2
+    NS_TEST_EXPECT_MSG_EQ(bytes[bytes.size() - 2], 0x80, "Wrong termination");
+    NS_TEST_EXPECT_MSG_EQ(bytes[bytes.size() - 1], 0x3f, "Wrong termination");
+
+    // The MAC payload follows the termination.
+    bytes.push_back(0xaa);
+    RitIeView view;
+    NS_TEST_ASSERT_MSG_EQ(view.Parse(bytes.data(), bytes.size()), true, "List not parsed");
+    NS_TEST_EXPECT_MSG_EQ(view.GetN(), 3, "Wrong number of IEs");
+    NS_TEST_EXPECT_MSG_EQ(view.GetSerializedSize(), bytes.size() - 1, "Payload not left out");
+    uint16_t rank = 0;
+    uint8_t channel = 0;
+    NS_TEST_EXPECT_MSG_EQ(view.GetU16(RIT_IE_RANK, rank), true, "Rank IE missing");
+    NS_TEST_EXPECT_MSG_EQ(rank, 0x0203, "Wrong rank");
+    NS_TEST_EXPECT_MSG_EQ(view.GetU8(RIT_IE_CHANNEL, channel), true, "Channel IE missing");
+    NS_TEST_EXPECT_MSG_EQ(+channel, 15, "Wrong channel");
+    NS_TEST_EXPECT_MSG_EQ(view.GetU8(RIT_IE_RANK, channel), false, "Rank IE read as one byte");
+    NS_TEST_EXPECT_MSG_EQ(view.Contains(RIT_IE_QUEUE_CREDIT), false, "IE not sent found");
+    RitAppointmentHeader read;
+    NS_TEST_EXPECT_MSG_EQ(view.GetHeader(RIT_IE_APPOINTMENT, read), true, "Appointment missing");
+    NS_TEST_EXPECT_MSG_EQ(read.GetOffset(), MilliSeconds(250), "Wrong appointment offset");
+    NS_TEST_EXPECT_MSG_EQ(read.GetPeriod(), Seconds(1), "Wrong appointment period");
+
+    // A copy of the view keeps the contents.
+    const RitIeView copy = view;
+    view.Parse(nullptr, 0);
+    NS_TEST_EXPECT_MSG_EQ(copy.GetU16(RIT_IE_RANK, rank) && rank == 0x0203,
+                          true,
+                          "The copy lost its contents");
+
+    // A list without termination runs to the end of the data.
+    std::vector<uint8_t> open = list.Encode(false);
+    NS_TEST_EXPECT_MSG_EQ(view.Parse(Create<Packet>(open.data(), open.size())),
+                          true,
+                          "Unterminated list not parsed");
+    NS_TEST_EXPECT_MSG_EQ(view.GetN(), 3, "Wrong number of IEs without termination");
+
+    // A registered IE of the wrong length, a truncated content, a registration of a
+    // new type, and an unregistered IE skipped by the check
+    RitIeList wrongLength;
+    wrongLength.AddU32(RIT_IE_CHANNEL, 15);
+    bytes = wrongLength.Encode(true);
+    NS_TEST_EXPECT_MSG_EQ(view.Parse(bytes.data(), bytes.size()), false, "Bad length accepted");
+    NS_TEST_EXPECT_MSG_EQ(view.GetN(), 0, "Malformed list not emptied");
+    bytes = list.Encode(false);
+    NS_TEST_EXPECT_MSG_EQ(view.Parse(bytes.data(), bytes.size() - 1), false, "Truncation");
+
+    RitIeList vendor;
+    vendor.AddU32(0x50, 0xdeadbeef);
+    bytes = vendor.Encode(true);
+    NS_TEST_EXPECT_MSG_EQ(view.Parse(bytes.data(), bytes.size()), true, "Unknown IE rejected");
+    RitIeRegistry::Register(0x50, "Vendor", 2, 2);
+    NS_TEST_EXPECT_MSG_EQ(RitIeRegistry::GetName(0x50), "Vendor", "Type not registered");
+    NS_TEST_EXPECT_MSG_EQ(view.Parse(bytes.data(), bytes.size()),
+                          false,
+                          "Length of a registered type not checked");
+    RitIeRegistry::Register(0x50, "Vendor", 0, RitIeList::MAX_LENGTH);
+
+    // More IEs than the view keeps
+    RitIeList many;
+    for (uint8_t i = 0; i <= RitIeView::MAX_IES; i++)
+    {
+        many.AddU8(RIT_IE_QUEUE_CREDIT, i);
+    }
+    bytes = many.Encode(true);
+    NS_TEST_EXPECT_MSG_EQ(view.Parse(Create<Packet>(bytes.data(), bytes.size())),
+                          false,
+                          "Overflow of the view accepted");
+}
+
+/**
+ * @brief Check that the header IEs of the beacons leave the NWK payload intact and that
+ *        the sender gets the IEs of the ACK, the appointment included (headerIesEnabled).
+ */
+class RitIeFrameTest : public TestCase
+{
+  public:
+    RitIeFrameTest();
+
+  private:
+    /**
+     * @brief Count the data frames received by the receiver.
+     * @param dev The device
+     * @param pkt The packet
+     * @param proto The protocol number
+     * @param addr The source address
+     * @return true
+     */
+    bool DataIndication(Ptr<NetDevice> dev,
+                        Ptr<const Packet> pkt,
+                        uint16_t proto,
+                        const Address& addr);
+
+    /**
+     * @brief Record the header IEs of an ACK.
+     * @param peer Receiver of the data frame
+     * @param ies Parsed IEs
+     */
+    void AckIes(Mac16Address peer, RitIeView ies);
+    void DoRun() override;
+
+    uint32_t m_nRx{0};       //!< Data frames received
+    uint32_t m_nAckIes{0};   //!< ACKs with header IEs
+    uint8_t m_credit{0};     //!< Queue credit of the last ACK
+    bool m_appointed{false}; //!< The last ACK held an appointment
+    Mac16Address m_peer;     //!< Receiver of the last ACK
+};
+
+RitIeFrameTest::RitIeFrameTest()
+    : TestCase("Header IEs in RIT Data Requests and data ACKs (RIT)")
+{
+}
+
+bool
+RitIeFrameTest::DataIndication(Ptr<NetDevice> dev,
+                               Ptr<const Packet> pkt,
+                               uint16_t proto,
+                               const Address& addr)
+{
+    m_nRx++;
+    return true;
+}
+
+void
+RitIeFrameTest::AckIes(Mac16Address peer, RitIeView ies)
+{
+    m_nAckIes++;
+    m_peer = peer;
+    ies.GetU8(RIT_IE_QUEUE_CREDIT, m_credit);
+    m_appointed = ies.Contains(RIT_IE_APPOINTMENT);
+}
+
+void
+RitIeFrameTest::DoRun()
+{
+    Ptr<Node> receiverNode = CreateObject<Node>();
+    Ptr<Node> senderNode = CreateObject<Node>();
+    Ptr<RitWpanNetDevice> receiverDevice = CreateObject<RitWpanNetDevice>();
+    Ptr<RitWpanNetDevice> senderDevice = CreateObject<RitWpanNetDevice>();
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+    receiverDevice->SetChannel(channel);
+    senderDevice->SetChannel(channel);
+
+    receiverDevice->SetAddress(Mac16Address("00:00"));
+    receiverDevice->SetRitRank(0);
+    senderDevice->SetAddress(Mac16Address("00:01"));
+    senderDevice->SetRitRank(1);
+    receiverNode->AddDevice(receiverDevice);
+    senderNode->AddDevice(senderDevice);
+    receiverDevice->SetReceiveCallback(MakeCallback(&RitIeFrameTest::DataIndication, this));
+
+    RitWpanMacModuleConfig config;
+    config.headerIesEnabled = true;
+    config.ackAppointmentsEnabled = true;
+    Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+    pibAttr->macRitPeriodTime = Time(Seconds(1));
+    for (const auto& device : {senderDevice, receiverDevice})
+    {
+        device->GetMac()->SetModuleConfig(config);
+        device->GetMac()->MlmeSetRequest(macRitPeriodTime, pibAttr);
+    }
+
+    Ptr<RitWpanMac> receiverMac = receiverDevice->GetMac();
+    RitIeList beaconIes;
+    beaconIes.AddU16(RIT_IE_RANK, 0);
+    beaconIes.AddU8(RIT_IE_CHANNEL, 11);
+    receiverMac->SetRitRequestIes(beaconIes);
+    RitIeList ackIes;
+    ackIes.AddU8(RIT_IE_QUEUE_CREDIT, 7);
+    receiverMac->SetAckIes(ackIes);
+    senderDevice->GetMac()->SetMlmeAckIeIndicationCallback(
+        MakeCallback(&RitIeFrameTest::AckIes, this));
+
+    for (double t : {8.0, 15.5})
+    {
+        Simulator::ScheduleWithContext(senderNode->GetId(), Seconds(t), [=]() {
+            senderDevice->Send(Create<Packet>(20), Mac16Address("00:00"), 0);
+        });
+    }
+
+    Simulator::Stop(Seconds(20.0));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_nRx, 2, "The IEs of the beacons broke the NWK payload");
+    NS_TEST_EXPECT_MSG_EQ(m_nAckIes, 2, "Header IEs of the ACKs not indicated");
+    NS_TEST_EXPECT_MSG_EQ(m_peer, Mac16Address("00:00"), "Wrong ACK sender");
+    NS_TEST_EXPECT_MSG_EQ(+m_credit, 7, "Wrong queue credit");
+    NS_TEST_EXPECT_MSG_EQ(m_appointed, true, "Appointment IE missing");
+    NS_TEST_EXPECT_MSG_EQ(senderDevice->GetMac()->GetNAppointmentsReceived(),
+                          2,
+                          "Appointment IE not used");
+
+    Simulator::Destroy();
+}
+
+class RitIeTestSuite : public TestSuite
+{
+  public:
+    RitIeTestSuite();
+};
+
+RitIeTestSuite::RitIeTestSuite()
+    : TestSuite("rit-ie", Type::UNIT)
+{
+    AddTestCase(new RitIeCodecTest, Duration::QUICK);
+    AddTestCase(new RitIeFrameTest, Duration::QUICK);
+}
+
+static RitIeTestSuite g_ritIeTestSuite;
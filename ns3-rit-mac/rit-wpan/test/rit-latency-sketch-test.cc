@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/log.h>
+#include <ns3/nstime.h>
+#include <ns3/rit-latency-sketch.h>
+#include <ns3/test.h>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-latency-sketch-test");
+
+/**
+ * @brief Check the quantile error bound and merging of RitLatencySketch.
+ */
+class RitLatencySketchTest : public TestCase
+{
+  public:
+    RitLatencySketchTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitLatencySketchTest::RitLatencySketchTest()
+    : TestCase("RitLatencySketch quantiles and merge")
+{
+}
+
+void
+RitLatencySketchTest::DoRun()
+{
+    // Buckets cover the value range without gaps
+    for (uint32_t i = 0; i < 4000; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(RitLatencySketch::GetBucketUpper(i) + 1,
+                              RitLatencySketch::GetBucketLower(i + 1),
+                              "Gap after bucket " << i);
+    }
+
+    // 1..10000 ms split over two sketches (odd / even samples)
+    RitLatencySketch odd;
+    RitLatencySketch even;
+    for (uint32_t ms = 1; ms <= 10000; ms++)
+    {
+        (ms % 2 ? odd : even).Record(MilliSeconds(ms));
+    }
+    RitLatencySketch merged = odd;
+    merged.Merge(even);
+
+    NS_TEST_ASSERT_MSG_EQ(merged.GetCount(), 10000, "Merge lost samples");
+    NS_TEST_EXPECT_MSG_EQ(merged.GetMin(), MilliSeconds(1), "Wrong minimum");
+    NS_TEST_EXPECT_MSG_EQ(merged.GetMax(), MilliSeconds(10000), "Wrong maximum");
+    NS_TEST_EXPECT_MSG_EQ_TOL(merged.GetMean().GetSeconds(), 5.0005, 1e-6, "Wrong mean");
+
+    // Relative error bound of a bucket is 2^-(SUB_BUCKET_BITS-1)
+    const double tol = 1.0 / (1 << (RitLatencySketch::SUB_BUCKET_BITS - 1));
+    NS_TEST_EXPECT_MSG_EQ_TOL(merged.GetQuantile(0.5).GetSeconds(), 5.0, 5.0 * tol, "Wrong p50");
+    NS_TEST_EXPECT_MSG_EQ_TOL(merged.GetQuantile(0.95).GetSeconds(), 9.5, 9.5 * tol, "Wrong p95");
+    NS_TEST_EXPECT_MSG_EQ_TOL(merged.GetQuantile(0.99).GetSeconds(), 9.9, 9.9 * tol, "Wrong p99");
+
+    merged.Reset();
+    NS_TEST_EXPECT_MSG_EQ(merged.GetCount(), 0, "Reset did not clear the sketch");
+    NS_TEST_EXPECT_MSG_EQ(merged.GetQuantile(0.99), Seconds(0), "Empty sketch quantile");
+}
+
+class RitLatencySketchTestSuite : public TestSuite
+{
+  public:
+    RitLatencySketchTestSuite();
+};
+
+RitLatencySketchTestSuite::RitLatencySketchTestSuite()
+    : TestSuite("rit-latency-sketch", Type::UNIT)
+{
+    AddTestCase(new RitLatencySketchTest, Duration::QUICK);
+}
+
+static RitLatencySketchTestSuite g_ritLatencySketchTestSuite;
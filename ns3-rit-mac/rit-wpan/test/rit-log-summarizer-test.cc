@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/core-module.h>
+#include <ns3/log.h>
+#include <ns3/rit-log-summarizer.h>
+
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-log-summarizer-test");
+
+namespace
+{
+
+/**
+ * @param path The file, its directory created
+ * @param text The contents
+ */
+void
+WriteLog(const std::string& path, const std::string& text)
+{
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path());
+    std::ofstream os(path);
+    os << text;
+}
+
+/**
+ * @param path A file
+ * @return its contents
+ */
+std::string
+ReadText(const std::string& path)
+{
+    std::ifstream in(path);
+    std::ostringstream text;
+    text << in.rdbuf();
+    return text.str();
+}
+
+/**
+ * @param text A number
+ * @return the number, NaN if it does not parse
+ */
+double
+Parse(const char* text)
+{
+    double value = NAN;
+    RitLogSummarizer::ParseDouble(text, text + std::strlen(text), value);
+    return value;
+}
+
+} // namespace
+
+/**
+ * @brief Check the number parser and the pandas number format.
+ */
+class RitLogSummarizerNumberTest : public TestCase
+{
+  public:
+    RitLogSummarizerNumberTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitLogSummarizerNumberTest::RitLogSummarizerNumberTest()
+    : TestCase("RitLogSummarizer number parsing and format")
+{
+}
+
+void
+RitLogSummarizerNumberTest::DoRun()
+{
+    NS_TEST_EXPECT_MSG_EQ(Parse("12.3457"), 12.3457, "Fixed point");
+    NS_TEST_EXPECT_MSG_EQ(Parse("1.6e-05"), 1.6e-05, "Exponent");
+    NS_TEST_EXPECT_MSG_EQ(Parse("-3"), -3.0, "Sign");
+    NS_TEST_EXPECT_MSG_EQ(Parse("0.1"), 0.1, "Not correctly rounded");
+    NS_TEST_EXPECT_MSG_EQ(Parse("123456789012345678901234"),
+                          123456789012345678901234.0,
+                          "Long mantissa");
+    NS_TEST_EXPECT_MSG_EQ(std::isnan(Parse("12a")), true, "Trailing text accepted");
+    NS_TEST_EXPECT_MSG_EQ(std::isnan(Parse("")), true, "Empty field accepted");
+
+    uint64_t uid = 0;
+    const char* text = "18446744073709551615";
+    NS_TEST_EXPECT_MSG_EQ(RitLogSummarizer::ParseUnsigned(text, text + 20, uid), true, "Max UID");
+    NS_TEST_EXPECT_MSG_EQ(uid, UINT64_MAX, "Wrong UID");
+    text = "18446744073709551616";
+    NS_TEST_EXPECT_MSG_EQ(RitLogSummarizer::ParseUnsigned(text, text + 20, uid), false, "Overflow");
+
+    // repr() of Python, as pandas writes a float column
+    NS_TEST_EXPECT_MSG_EQ(RitLogSummarizer::FormatValue(1.0), "1.0", "Integral float");
+    NS_TEST_EXPECT_MSG_EQ(RitLogSummarizer::FormatValue(0.1), "0.1", "Shortest digits");
+    NS_TEST_EXPECT_MSG_EQ(RitLogSummarizer::FormatValue(0.1 + 0.2),
+                          "0.30000000000000004",
+                          "Round trip");
+    NS_TEST_EXPECT_MSG_EQ(RitLogSummarizer::FormatValue(0.0001), "0.0001", "Small fixed");
+    NS_TEST_EXPECT_MSG_EQ(RitLogSummarizer::FormatValue(1e-05), "1e-05", "Small exponent");
+    NS_TEST_EXPECT_MSG_EQ(RitLogSummarizer::FormatValue(1e16), "1e+16", "Large exponent");
+    NS_TEST_EXPECT_MSG_EQ(RitLogSummarizer::FormatValue(123456.789), "123456.789", "Fixed");
+    NS_TEST_EXPECT_MSG_EQ(RitLogSummarizer::FormatValue(NAN), "", "NaN not empty");
+}
+
+/**
+ * @brief Check the summaries of a small run against the values of summary_utils.py, and
+ *        that the runs already summarized are skipped.
+ */
+class RitLogSummarizerRunTest : public TestCase
+{
+  public:
+    RitLogSummarizerRunTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitLogSummarizerRunTest::RitLogSummarizerRunTest()
+    : TestCase("RitLogSummarizer summaries of a run")
+{
+}
+
+void
+RitLogSummarizerRunTest::DoRun()
+{
+    const std::string root = CreateTempDirFilename("rit-log-summarizer/");
+    const std::string run = root + "default/rit-wpan/BI1000_TWD5000_DWD10_Days1/SEED01";
+    const std::string n0 = run + "/node-0/";
+    const std::string n1 = run + "/node-1/";
+    const std::string n2 = run + "/node-2/";
+
+    // APP: UID 11 of node 1 is sent twice and lost, UID 10 received twice
+    WriteLog(n0 + "app-txlog.csv", "");
+    WriteLog(n0 + "app-rxlog.csv", "1.5,10\n1.75,10\n3,20\n");
+    WriteLog(n1 + "app-txlog.csv", "1,10\n2,11\n2.5,11\n");
+    WriteLog(n2 + "app-txlog.csv", "1,20\n");
+
+    // MAC: empty logs at the sink, none at node 2; the row with a sixth field is skipped
+    for (const char* file : {"mac-txlog.csv",
+                             "mac-rxlog.csv",
+                             "mac-beacon-wait.csv",
+                             "mac-data-wait.csv",
+                             "mac-statelog.csv"})
+    {
+        WriteLog(n0 + file, "");
+    }
+    WriteLog(n1 + "mac-txlog.csv",
+             "1,Tx,Data,00:01,00:00\n1.1,TxOk,Data,00:01,00:00\n2,TxDrop,Command,00:01,00:00\n"
+             "3,Tx,Ack,00:01,00:00\n4,TxOk,Data,00:01,00:00,x\n");
+    WriteLog(n1 + "mac-rxlog.csv",
+             "1,RxOk,Data,00:00,00:01\n2,timeout,Data,00:00,00:01\n3,RxOk,Ack,00:00,00:01\n");
+    WriteLog(n1 + "mac-beacon-wait.csv", "");
+    WriteLog(n1 + "mac-data-wait.csv",
+             "1,start\n1.004,end\n2,start\n2.01,timeout\n3,start\n3.006,end\n");
+    WriteLog(n1 + "mac-statelog.csv", "0,MAC_IDLE\n1,MAC_CSMA\n1.5,MAC_IDLE\n4,MAC_SENDING\n");
+
+    // PHY: state log at nodes 0 and 2, duty cycle counters at node 1
+    WriteLog(n0 + "phy-txlog.csv", "");
+    WriteLog(n0 + "phy-rxlog.csv", "");
+    WriteLog(n0 + "phy-statelog.csv", "0,RX_ON\n10,TRX_OFF\n20,RX_ON\n");
+    WriteLog(n1 + "phy-txlog.csv", "1,TxEnd,ff:ff\n2,TxDrop,ff:ff\n");
+    WriteLog(n1 + "phy-rxlog.csv", "1,RxEnd,00:00,\n");
+    WriteLog(n1 + "phy-dutycycle.csv", "10,5,3,1,0.5,0.5\n20,10,6,2,1,1\n");
+    WriteLog(n2 + "phy-txlog.csv", "1,TxEnd,ff:ff\n");
+    WriteLog(n2 + "phy-rxlog.csv", "1,RxEnd,00:00,\n");
+    WriteLog(n2 + "phy-statelog.csv", "0,TRX_OFF\n30,RX_ON\n40,TRX_OFF\n");
+
+    const std::vector<std::string> runs = RitLogSummarizer::FindRuns(root);
+    NS_TEST_ASSERT_MSG_EQ(runs.size(), 1, "Run not found");
+    NS_TEST_EXPECT_MSG_EQ(std::filesystem::equivalent(runs[0], run), true, "Wrong run");
+
+    RitLogSummarizer summarizer;
+    summarizer.SetNThreads(2);
+    const RitRunSummary summary = summarizer.SummarizeRun(run);
+    NS_TEST_EXPECT_MSG_EQ(summarizer.GetNNodes(), 3, "Nodes not summarized");
+
+    NS_TEST_ASSERT_MSG_EQ(summary.app.size(), 3, "Wrong APP rows");
+    NS_TEST_EXPECT_MSG_EQ(summary.app[0].nodeId, 1, "Senders not first");
+    NS_TEST_EXPECT_MSG_EQ(summary.app[0].pdr, 0.5, "Wrong PDR");
+    NS_TEST_EXPECT_MSG_EQ(summary.app[0].avgDelay, 0.5, "Wrong delay");
+    NS_TEST_EXPECT_MSG_EQ(summary.app[0].txTotal, 3, "Duplicate sends not counted");
+    NS_TEST_EXPECT_MSG_EQ(summary.app[2].nodeId, 0, "Receiver not last");
+    NS_TEST_EXPECT_MSG_EQ(std::isnan(summary.app[2].pdr), true, "PDR without a send");
+    NS_TEST_EXPECT_MSG_EQ(summary.app[2].rxTotal, 3, "Wrong receptions");
+
+    NS_TEST_ASSERT_MSG_EQ(summary.mac.size(), 2, "Node without MAC logs summarized");
+    const RitMacNodeSummary& mac = summary.mac[1];
+    NS_TEST_EXPECT_MSG_EQ(mac.txOk, 1, "Row with too many fields not skipped");
+    NS_TEST_EXPECT_MSG_EQ(mac.txDrop, 1, "Wrong txDrop");
+    NS_TEST_EXPECT_MSG_EQ(mac.txCommandDrop, 1, "Wrong txCommandDrop");
+    NS_TEST_EXPECT_MSG_EQ(mac.txAck, 1, "Wrong txAck");
+    NS_TEST_EXPECT_MSG_EQ(mac.rxOk, 2, "Wrong rxOk");
+    NS_TEST_EXPECT_MSG_EQ(mac.rxDrop, 1, "Wrong rxDrop");
+    NS_TEST_EXPECT_MSG_EQ(mac.rxTimeouts, 1, "Wrong rxTimeouts");
+    NS_TEST_EXPECT_MSG_EQ_TOL(mac.avgDataWaitTimeMs, 5.0, 1e-9, "Timeout not ending the wait");
+    NS_TEST_EXPECT_MSG_EQ(std::isnan(mac.avgBeaconWaitTimeTxMs), true, "Wait without a row");
+    NS_TEST_ASSERT_MSG_EQ(mac.stateRatios.size(), 2, "Last state counted");
+    NS_TEST_EXPECT_MSG_EQ(mac.stateRatios[0].first, "MAC_IDLE_ratio", "Wrong state order");
+    NS_TEST_EXPECT_MSG_EQ(mac.stateRatios[0].second, 0.875, "Wrong MAC_IDLE ratio");
+
+    NS_TEST_ASSERT_MSG_EQ(summary.phy.size(), 3, "Wrong PHY rows");
+    NS_TEST_EXPECT_MSG_EQ(summary.phy[0].tx.has_value(), false, "Count of an empty log");
+    NS_TEST_EXPECT_MSG_EQ(summary.phy[1].stateRatios[0].second, 0.5, "Wrong duty cycle ratio");
+    NS_TEST_EXPECT_MSG_EQ(summary.phy[2].stateRatios[0].second, 0.75, "Wrong state log ratio");
+
+    const RitScenarioSummary& scenario = summary.scenario;
+    NS_TEST_EXPECT_MSG_EQ(scenario.pdr.count, 2, "Receiver counted as a sender");
+    NS_TEST_EXPECT_MSG_EQ(scenario.pdr.mean, 0.75, "Wrong PDR mean");
+    NS_TEST_EXPECT_MSG_EQ_TOL(scenario.pdr.stddev, std::sqrt(0.125), 1e-12, "Wrong PDR std");
+    NS_TEST_EXPECT_MSG_EQ(scenario.delay.mean, 1.25, "Wrong delay mean");
+    NS_TEST_EXPECT_MSG_EQ(scenario.wakeRatio.count, 3, "Wrong wake ratio nodes");
+    NS_TEST_EXPECT_MSG_EQ(scenario.wakeRatio.min, 0.25, "Wrong wake ratio min");
+
+    // The files of the notebook, then a second pass that leaves them alone
+    NS_TEST_EXPECT_MSG_EQ(summarizer.SummarizeTree(root), 1, "Run not written");
+    NS_TEST_EXPECT_MSG_EQ(ReadText(run + "/summary/app_summary.csv"),
+                          "pdr,avg_delay,tx_total,rx_total\n0.5,0.5,3,0\n1.0,2.0,1,0\n,,0,3\n",
+                          "Wrong app_summary.csv");
+    NS_TEST_EXPECT_MSG_EQ(ReadText(run + "/summary/phy_summary.csv"),
+                          "tx,rx,txDrop,rxDrop,RX_ON_ratio,TRX_OFF_ratio,BUSY_RX_ratio,"
+                          "TX_ON_ratio,BUSY_TX_ratio\n"
+                          ",,,,0.5,0.5,,,\n"
+                          "1.0,1.0,1.0,0.0,0.3,0.5,0.1,0.05,0.05\n"
+                          "1.0,1.0,0.0,0.0,0.25,0.75,,,\n",
+                          "Wrong phy_summary.csv");
+    NS_TEST_EXPECT_MSG_EQ(summarizer.SummarizeTree(root), 0, "Summarized run rewritten");
+    NS_TEST_EXPECT_MSG_EQ(summarizer.GetNRunsSkipped(), 1, "Run not skipped");
+    summarizer.SetOverwrite(true);
+    NS_TEST_EXPECT_MSG_EQ(summarizer.SummarizeTree(root), 1, "Overwrite ignored");
+
+    std::filesystem::remove_all(root);
+}
+
+class RitLogSummarizerTestSuite : public TestSuite
+{
+  public:
+    RitLogSummarizerTestSuite();
+};
+
+RitLogSummarizerTestSuite::RitLogSummarizerTestSuite()
+    : TestSuite("rit-log-summarizer", Type::UNIT)
+{
+    AddTestCase(new RitLogSummarizerNumberTest, Duration::QUICK);
+    AddTestCase(new RitLogSummarizerRunTest, Duration::QUICK);
+}
+
+static RitLogSummarizerTestSuite g_ritLogSummarizerTestSuite;
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/core-module.h>
+#include <ns3/log.h>
+#include <ns3/lr-wpan-lazy-trace.h>
+#include <ns3/network-module.h>
+#include <ns3/packet.h>
+#include <ns3/propagation-delay-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/rit-wpan-mac.h>
+#include <ns3/rit-wpan-net-device.h>
+#include <ns3/single-model-spectrum-channel.h>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-mac-footprint-test");
+
+/**
+ * @brief Check that a LazyTracedValue fires its sinks on changes only, with the old and
+ *        the new value, and stops once they are disconnected.
+ */
+class RitLazyTracedValueTest : public TestCase
+{
+  public:
+    RitLazyTracedValueTest();
+
+  private:
+    /**
+     * @brief Record a change.
+     * @param oldValue The value before the change
+     * @param newValue The value after it
+     */
+    void Changed(uint32_t oldValue, uint32_t newValue);
+
+    void DoRun() override;
+
+    uint32_t m_nChanges{0}; //!< Changes traced
+    uint32_t m_old{0};      //!< Old value of the last change
+    uint32_t m_new{0};      //!< New value of the last change
+};
+
+RitLazyTracedValueTest::RitLazyTracedValueTest()
+    : TestCase("LazyTracedValue change notifications")
+{
+}
+
+void
+RitLazyTracedValueTest::Changed(uint32_t oldValue, uint32_t newValue)
+{
+    m_nChanges++;
+    m_old = oldValue;
+    m_new = newValue;
+}
+
+void
+RitLazyTracedValueTest::DoRun()
+{
+    LazyTracedValue<uint32_t> value(3);
+    value = 4; // no sink yet
+    NS_TEST_EXPECT_MSG_EQ(value.Get(), 4, "Value not set without a sink");
+
+    const auto sink = MakeCallback(&RitLazyTracedValueTest::Changed, this);
+    value.ConnectWithoutContext(sink);
+    value = 4;
+    NS_TEST_EXPECT_MSG_EQ(m_nChanges, 0, "Sink fired without a change");
+    value = 7;
+    NS_TEST_EXPECT_MSG_EQ(m_nChanges, 1, "Change not traced");
+    NS_TEST_EXPECT_MSG_EQ(m_old, 4, "Wrong old value");
+    NS_TEST_EXPECT_MSG_EQ(m_new, 7, "Wrong new value");
+
+    LazyTracedValue<uint32_t> copy(value);
+    copy = 9;
+    NS_TEST_EXPECT_MSG_EQ(m_nChanges, 1, "Sink copied along with the value");
+
+    value.DisconnectWithoutContext(sink);
+    value = 8;
+    NS_TEST_EXPECT_MSG_EQ(m_nChanges, 1, "Sink fired after it was disconnected");
+    NS_TEST_EXPECT_MSG_EQ(static_cast<uint32_t>(value), 8, "Value not set after disconnect");
+}
+
+/**
+ * @brief Check that two RIT devices exchanging data never allocate the beacon-mode state
+ *        of their MAC, and that trace sources connected after construction still fire.
+ */
+class RitMacFootprintTest : public TestCase
+{
+  public:
+    RitMacFootprintTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitMacFootprintTest::RitMacFootprintTest()
+    : TestCase("RIT MAC without beacon-mode state")
+{
+}
+
+void
+RitMacFootprintTest::DoRun()
+{
+    const uint32_t nPackets = 5;
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    Ptr<Node> sinkNode = CreateObject<Node>();
+    Ptr<RitWpanNetDevice> sink = CreateObject<RitWpanNetDevice>();
+    sink->SetChannel(channel);
+    sink->SetAddress(Mac16Address("00:00"));
+    sink->SetRitRank(0);
+    sinkNode->AddDevice(sink);
+
+    Ptr<Node> senderNode = CreateObject<Node>();
+    Ptr<RitWpanNetDevice> sender = CreateObject<RitWpanNetDevice>();
+    sender->SetChannel(channel);
+    sender->SetAddress(Mac16Address("00:01"));
+    sender->SetRitRank(1);
+    senderNode->AddDevice(sender);
+
+    Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+    pibAttr->macRitPeriodTime = Time(Seconds(1));
+    sink->GetMac()->MlmeSetRequest(macRitPeriodTime, pibAttr);
+    sender->GetMac()->MlmeSetRequest(macRitPeriodTime, pibAttr);
+
+    uint32_t nRx = 0;
+    uint32_t nStateChanges = 0;
+    sink->GetMac()->TraceConnectWithoutContext(
+        "MacRx",
+        Callback<void, Ptr<const Packet>>([&nRx](Ptr<const Packet>) { nRx++; }));
+    sender->GetMac()->TraceConnectWithoutContext(
+        "MacStateValue",
+        Callback<void, MacState, MacState>([&nStateChanges](MacState, MacState) {
+            nStateChanges++;
+        }));
+
+    for (uint32_t k = 0; k < nPackets; k++)
+    {
+        Simulator::ScheduleWithContext(senderNode->GetId(), Seconds(2 + 2 * k), [=]() {
+            sender->Send(Create<Packet>(20), Mac16Address("00:00"), 0);
+        });
+    }
+
+    Simulator::Stop(Seconds(15));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(nRx, nPackets, "Data frames not received");
+    NS_TEST_EXPECT_MSG_GT(nStateChanges, 0, "MAC state changes not traced");
+    NS_TEST_EXPECT_MSG_EQ(sink->GetMac()->HasBeaconState(), false, "Sink beacon state allocated");
+    NS_TEST_EXPECT_MSG_EQ(sender->GetMac()->HasBeaconState(),
+                          false,
+                          "Sender beacon state allocated");
+
+    Simulator::Destroy();
+}
+
+class RitMacFootprintTestSuite : public TestSuite
+{
+  public:
+    RitMacFootprintTestSuite();
+};
+
+RitMacFootprintTestSuite::RitMacFootprintTestSuite()
+    : TestSuite("rit-mac-footprint", Type::UNIT)
+{
+    AddTestCase(new RitLazyTracedValueTest, Duration::QUICK);
+    AddTestCase(new RitMacFootprintTest, Duration::QUICK);
+}
+
+static RitMacFootprintTestSuite g_ritMacFootprintTestSuite;
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/log.h>
+#include <ns3/nstime.h>
+#include <ns3/rit-mac-timer-set.h>
+#include <ns3/simulator.h>
+#include <ns3/test.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-mac-timer-set-test");
+
+/**
+ * @brief Check the expirations of RitMacTimerSet and the scheduler events it creates.
+ */
+class RitMacTimerSetTest : public TestCase
+{
+  public:
+    RitMacTimerSetTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Record the expiration of a timer.
+     * @param test The test case
+     * @param id Timer id
+     */
+    static void Expired(RitMacTimerSetTest* test, uint32_t id);
+
+    RitMacTimerSet m_timers;                          //!< The timers under test
+    std::vector<std::pair<uint32_t, Time>> m_expired; //!< Expired timers and times
+};
+
+RitMacTimerSetTest::RitMacTimerSetTest()
+    : TestCase("RitMacTimerSet expirations and re-arming"),
+      m_timers(3)
+{
+}
+
+void
+RitMacTimerSetTest::Expired(RitMacTimerSetTest* test, uint32_t id)
+{
+    test->m_expired.emplace_back(id, Simulator::Now());
+    if (id == 2 && test->m_expired.size() == 1)
+    {
+        // Re-armed from its own handler, as the periodic RIT request does.
+        test->m_timers.Schedule(2, MilliSeconds(10));
+    }
+}
+
+void
+RitMacTimerSetTest::DoRun()
+{
+    for (uint32_t id = 0; id < 3; id++)
+    {
+        m_timers.SetHandler(id, MakeBoundCallback(&RitMacTimerSetTest::Expired, this, id));
+    }
+
+    m_timers.Schedule(0, MilliSeconds(5));
+    m_timers.Schedule(1, MilliSeconds(20));
+    m_timers.Schedule(2, MilliSeconds(2));
+    NS_TEST_EXPECT_MSG_EQ(m_timers.GetNScheduledEvents(), 2, "Later deadlines rescheduled");
+
+    // Extending and cancelling do not create scheduler events
+    Simulator::Schedule(MilliSeconds(1), [this]() {
+        m_timers.Schedule(0, MilliSeconds(7));
+        m_timers.Cancel(1);
+        NS_TEST_EXPECT_MSG_EQ(m_timers.IsPending(1), false, "Cancelled timer pending");
+        NS_TEST_EXPECT_MSG_EQ(m_timers.GetDelayLeft(0), MilliSeconds(7), "Wrong delay left");
+        NS_TEST_EXPECT_MSG_EQ(m_timers.GetNScheduledEvents(), 2, "Extension rescheduled");
+    });
+    Simulator::Run();
+
+    std::vector<std::pair<uint32_t, Time>> expected{{2, MilliSeconds(2)},
+                                                    {0, MilliSeconds(8)},
+                                                    {2, MilliSeconds(12)}};
+    NS_TEST_ASSERT_MSG_EQ(m_expired.size(), expected.size(), "Wrong number of expirations");
+    for (size_t i = 0; i < expected.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_expired[i].first, expected[i].first, "Wrong timer expired");
+        NS_TEST_EXPECT_MSG_EQ(m_expired[i].second, expected[i].second, "Wrong expiration time");
+    }
+
+    // Same deadline: arming order
+    m_expired.clear();
+    m_timers.Schedule(1, MilliSeconds(3));
+    m_timers.Schedule(0, MilliSeconds(3));
+    Simulator::Run();
+    NS_TEST_ASSERT_MSG_EQ(m_expired.size(), 2, "Wrong number of expirations");
+    NS_TEST_EXPECT_MSG_EQ(m_expired[0].first, 1, "Tie not broken by arming order");
+
+    m_timers.Schedule(0, MilliSeconds(3));
+    m_timers.CancelAll();
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(m_expired.size(), 2, "Timer expired after CancelAll");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @brief Check the order of the timers and of the other events due at the same time.
+ *
+ * The timers run in the shared event, which keeps its place in the simulator queue until
+ * an earlier deadline moves it: a timer armed for the time of the shared event runs
+ * before the events queued for that time after the shared event was scheduled.
+ */
+class RitMacTimerSetTieOrderTest : public TestCase
+{
+  public:
+    RitMacTimerSetTieOrderTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Record a timer or another event.
+     * @param test The test case
+     * @param label What ran
+     */
+    static void Ran(RitMacTimerSetTieOrderTest* test, std::string label);
+
+    RitMacTimerSet m_timers;          //!< The timers under test
+    std::vector<std::string> m_order; //!< What ran, in order
+};
+
+RitMacTimerSetTieOrderTest::RitMacTimerSetTieOrderTest()
+    : TestCase("RitMacTimerSet order against the other events at the same time"),
+      m_timers(2)
+{
+}
+
+void
+RitMacTimerSetTieOrderTest::Ran(RitMacTimerSetTieOrderTest* test, std::string label)
+{
+    test->m_order.push_back(label);
+}
+
+void
+RitMacTimerSetTieOrderTest::DoRun()
+{
+    m_timers.SetHandler(0,
+                        MakeBoundCallback(&RitMacTimerSetTieOrderTest::Ran,
+                                          this,
+                                          std::string("timer0")));
+    m_timers.SetHandler(1,
+                        MakeBoundCallback(&RitMacTimerSetTieOrderTest::Ran,
+                                          this,
+                                          std::string("timer1")));
+
+    // Timer 1 joins the shared event already queued for 10 ms, ahead of the event X queued
+    // after it (one EventId per timer would run X first).
+    m_timers.Schedule(0, MilliSeconds(10));
+    Simulator::Schedule(MilliSeconds(10), &RitMacTimerSetTieOrderTest::Ran, this, std::string("X"));
+    Simulator::Schedule(MilliSeconds(1), [this]() { m_timers.Schedule(1, MilliSeconds(9)); });
+    Simulator::Run();
+
+    std::vector<std::string> expected{"timer0", "timer1", "X"};
+    NS_TEST_EXPECT_MSG_EQ((m_order == expected), true, "Timer did not run in the shared event");
+    NS_TEST_EXPECT_MSG_EQ(m_timers.GetNScheduledEvents(), 1, "Tie rescheduled the event");
+
+    // An earlier deadline moves the shared event behind the events already queued for it.
+    m_order.clear();
+    m_timers.Schedule(0, MilliSeconds(20));
+    Simulator::Schedule(MilliSeconds(10), &RitMacTimerSetTieOrderTest::Ran, this, std::string("X"));
+    Simulator::Schedule(MilliSeconds(1), [this]() { m_timers.Schedule(1, MilliSeconds(9)); });
+    Simulator::Run();
+
+    expected = {"X", "timer1", "timer0"};
+    NS_TEST_EXPECT_MSG_EQ((m_order == expected), true, "Moved event not queued last");
+    NS_TEST_EXPECT_MSG_EQ(m_timers.GetNScheduledEvents(), 4, "Wrong number of events");
+
+    Simulator::Destroy();
+}
+
+class RitMacTimerSetTestSuite : public TestSuite
+{
+  public:
+    RitMacTimerSetTestSuite();
+};
+
+RitMacTimerSetTestSuite::RitMacTimerSetTestSuite()
+    : TestSuite("rit-mac-timer-set", Type::UNIT)
+{
+    AddTestCase(new RitMacTimerSetTest, Duration::QUICK);
+    AddTestCase(new RitMacTimerSetTieOrderTest, Duration::QUICK);
+}
+
+static RitMacTimerSetTestSuite g_ritMacTimerSetTestSuite;
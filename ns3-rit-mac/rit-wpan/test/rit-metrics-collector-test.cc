@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/core-module.h>
+#include <ns3/log.h>
+#include <ns3/lr-wpan-phy.h>
+#include <ns3/network-module.h>
+#include <ns3/periodic-sender-helper.h>
+#include <ns3/rit-metrics-collector.h>
+#include <ns3/rit-wpan-helper.h>
+#include <ns3/rit-wpan-net-device.h>
+#include <ns3/test.h>
+
+#include <fstream>
+#include <map>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-metrics-collector-test");
+
+/**
+ * @brief Check the online PDR, latency and wake ratio of RitMetricsCollector against the
+ *        same metrics computed here from the raw application and PHY traces.
+ */
+class RitMetricsCollectorAggregateTest : public TestCase
+{
+  public:
+    RitMetricsCollectorAggregateTest();
+
+  private:
+    /**
+     * @brief Log a packet sent by a leaf.
+     * @param nodeId Node of the leaf
+     * @param p The packet
+     */
+    void AppTx(uint32_t nodeId, Ptr<const Packet> p);
+
+    /**
+     * @brief Log a packet received by the sink.
+     * @param p The packet
+     */
+    void AppRx(Ptr<const Packet> p);
+
+    /**
+     * @brief Log a PHY state change, accounted like summarize_phy_node().
+     * @param nodeId Node of the PHY
+     * @param time Time of the change
+     * @param oldState Previous state
+     * @param newState New state
+     */
+    void TrxState(uint32_t nodeId, Time time, PhyEnumeration oldState, PhyEnumeration newState);
+
+    void DoRun() override;
+
+    /**
+     * @brief PHY state log of one node.
+     */
+    struct PhyLog
+    {
+        bool seen{false};                                //!< A change was logged
+        Time first;                                      //!< First change
+        Time last;                                       //!< Last change
+        PhyEnumeration state{IEEE_802_15_4_PHY_TRX_OFF}; //!< State since the last change
+        Time offTime;                                    //!< Time spent in TRX_OFF
+    };
+
+    std::map<uint64_t, std::pair<uint32_t, Time>> m_sent; //!< Origin and time by packet UID
+    std::map<uint32_t, uint32_t> m_nTx;                   //!< Packets sent per node
+    std::map<uint32_t, uint32_t> m_nDelivered;            //!< Packets delivered per origin
+    std::map<uint32_t, double> m_delaySum;                //!< Their delays per origin [s]
+    uint32_t m_nRx{0};                                    //!< Packets received by the sink
+    std::map<uint32_t, PhyLog> m_phy;                     //!< PHY state log per node
+};
+
+RitMetricsCollectorAggregateTest::RitMetricsCollectorAggregateTest()
+    : TestCase("Online PDR, latency and wake ratio match the raw traces")
+{
+}
+
+void
+RitMetricsCollectorAggregateTest::AppTx(uint32_t nodeId, Ptr<const Packet> p)
+{
+    m_nTx[nodeId]++;
+    m_sent.emplace(p->GetUid(), std::make_pair(nodeId, Simulator::Now()));
+}
+
+void
+RitMetricsCollectorAggregateTest::AppRx(Ptr<const Packet> p)
+{
+    m_nRx++;
+    auto it = m_sent.find(p->GetUid());
+    if (it == m_sent.end())
+    {
+        return;
+    }
+    m_nDelivered[it->second.first]++;
+    m_delaySum[it->second.first] += (Simulator::Now() - it->second.second).GetSeconds();
+    m_sent.erase(it);
+}
+
+void
+RitMetricsCollectorAggregateTest::TrxState(uint32_t nodeId,
+                                           Time time,
+                                           PhyEnumeration oldState,
+                                           PhyEnumeration newState)
+{
+    PhyLog& log = m_phy[nodeId];
+    if (!log.seen)
+    {
+        log.seen = true;
+        log.first = time;
+    }
+    else if (log.state == IEEE_802_15_4_PHY_TRX_OFF)
+    {
+        log.offTime += time - log.last;
+    }
+    log.last = time;
+    log.state = newState;
+}
+
+void
+RitMetricsCollectorAggregateTest::DoRun()
+{
+    NodeContainer sinks;
+    sinks.Create(1);
+    NodeContainer leaves;
+    leaves.Create(2);
+    NodeContainer nodes(sinks, leaves);
+
+    RitWpanNetHelper helper;
+    helper.SetMacRitPeriod(Seconds(1));
+    helper.SetMacRitDataWaitDuration(MilliSeconds(10));
+    helper.SetMacRitTxWaitDuration(Seconds(5));
+    NetDeviceContainer devices = helper.Install(nodes);
+    for (uint32_t i = 0; i < devices.GetN(); i++)
+    {
+        Ptr<RitWpanNetDevice> dev = DynamicCast<RitWpanNetDevice>(devices.Get(i));
+        dev->SetAddress(Mac16Address(static_cast<uint16_t>(i)));
+        dev->SetRitRank(i == 0 ? 0 : 1);
+    }
+
+    PeriodicSenderHelper sinkApp;
+    sinkApp.SetReceiveOnly(true);
+    ApplicationContainer sinkApps = sinkApp.Install(sinks);
+    PeriodicSenderHelper leafApp;
+    leafApp.SetPeriod(Seconds(10));
+    leafApp.SetPacketSize(20);
+    leafApp.SetDstAddr(Mac16Address("00:00"));
+    ApplicationContainer leafApps = leafApp.Install(leaves);
+
+    const std::string baseDir = CreateTempDirFilename("rit-metrics-collector/");
+    Ptr<RitMetricsCollector> collector = helper.EnableMetricsCollector(nodes, baseDir);
+
+    sinkApps.Get(0)->TraceConnectWithoutContext(
+        "Rx",
+        MakeCallback(&RitMetricsCollectorAggregateTest::AppRx, this));
+    for (uint32_t i = 0; i < leaves.GetN(); i++)
+    {
+        const uint32_t nodeId = leaves.Get(i)->GetId();
+        leafApps.Get(i)->TraceConnectWithoutContext(
+            "Tx",
+            Callback<void, Ptr<const Packet>>(
+                [this, nodeId](Ptr<const Packet> p) { AppTx(nodeId, p); }));
+    }
+    for (uint32_t i = 0; i < devices.GetN(); i++)
+    {
+        const uint32_t nodeId = nodes.Get(i)->GetId();
+        DynamicCast<RitWpanNetDevice>(devices.Get(i))
+            ->GetPhy()
+            ->TraceConnectWithoutContext(
+                "TrxState",
+                Callback<void, Time, PhyEnumeration, PhyEnumeration>(
+                    [this, nodeId](Time t, PhyEnumeration o, PhyEnumeration n) {
+                        TrxState(nodeId, t, o, n);
+                    }));
+    }
+
+    Simulator::Stop(Seconds(100));
+    Simulator::Run();
+
+    uint64_t delivered = 0;
+    for (uint32_t i = 0; i < leaves.GetN(); i++)
+    {
+        const uint32_t nodeId = leaves.Get(i)->GetId();
+        NS_TEST_ASSERT_MSG_GT(m_nTx[nodeId], 0, "Leaf " << nodeId << " sent nothing");
+        NS_TEST_EXPECT_MSG_EQ(collector->GetTxCount(nodeId), m_nTx[nodeId], "Sent packets");
+        NS_TEST_EXPECT_MSG_EQ(collector->GetDeliveredCount(nodeId),
+                              m_nDelivered[nodeId],
+                              "Delivered packets of node " << nodeId);
+        NS_TEST_EXPECT_MSG_EQ_TOL(collector->GetPdr(nodeId),
+                                  static_cast<double>(m_nDelivered[nodeId]) / m_nTx[nodeId],
+                                  1e-12,
+                                  "PDR of node " << nodeId);
+        delivered += m_nDelivered[nodeId];
+    }
+    NS_TEST_EXPECT_MSG_GT(delivered, 0, "Nothing delivered");
+    NS_TEST_EXPECT_MSG_LT(collector->GetPdr(sinks.Get(0)->GetId()), 0.0, "The sink sent nothing");
+
+    const std::vector<uint64_t>& histogram = collector->GetLatencyHistogram();
+    NS_TEST_EXPECT_MSG_EQ(std::accumulate(histogram.begin(), histogram.end(), uint64_t{0}),
+                          delivered,
+                          "Latency histogram does not count each delivery once");
+
+    for (uint32_t i = 0; i < nodes.GetN(); i++)
+    {
+        const uint32_t nodeId = nodes.Get(i)->GetId();
+        const PhyLog& log = m_phy[nodeId];
+        NS_TEST_ASSERT_MSG_EQ(log.seen, true, "No PHY state change at node " << nodeId);
+        const Time total = log.last - log.first;
+        const double expected = 1.0 - log.offTime.GetSeconds() / total.GetSeconds();
+        NS_TEST_EXPECT_MSG_EQ_TOL(collector->GetWakeRatio(nodeId),
+                                  expected,
+                                  1e-9,
+                                  "Wake ratio of node " << nodeId);
+        NS_TEST_EXPECT_MSG_GT(expected, 0.0, "Node " << nodeId << " never awake");
+        NS_TEST_EXPECT_MSG_LT(expected, 1.0, "Node " << nodeId << " never asleep");
+    }
+
+    Simulator::Destroy();
+
+    // The summary written at Simulator::Destroy() holds the same values
+    std::ifstream app(baseDir + "summary/app-summary.csv");
+    NS_TEST_ASSERT_MSG_EQ(app.is_open(), true, "app-summary.csv not written");
+    std::string line;
+    std::getline(app, line);
+    NS_TEST_EXPECT_MSG_EQ(line, "nodeId,pdr,avg_delay,tx_total,rx_total", "Header");
+    uint32_t nRows = 0;
+    while (std::getline(app, line))
+    {
+        std::vector<std::string> fields;
+        std::istringstream row(line);
+        for (std::string field; std::getline(row, field, ',');)
+        {
+            fields.push_back(field);
+        }
+        NS_TEST_ASSERT_MSG_EQ(fields.size(), 5, "Wrong row: " << line);
+        const uint32_t nodeId = std::stoul(fields[0]);
+        nRows++;
+        if (nodeId == sinks.Get(0)->GetId())
+        {
+            NS_TEST_EXPECT_MSG_EQ(fields[1], "", "PDR of the sink");
+            NS_TEST_EXPECT_MSG_EQ(fields[3], "0", "Packets sent by the sink");
+            NS_TEST_EXPECT_MSG_EQ(std::stoul(fields[4]), m_nRx, "Packets received by the sink");
+            continue;
+        }
+        NS_TEST_EXPECT_MSG_EQ(std::stoul(fields[3]), m_nTx[nodeId], "tx_total: " << line);
+        NS_TEST_EXPECT_MSG_EQ(fields[4], "0", "rx_total of a leaf: " << line);
+        if (m_nDelivered[nodeId] > 0)
+        {
+            NS_TEST_EXPECT_MSG_EQ_TOL(std::stod(fields[2]),
+                                      m_delaySum[nodeId] / m_nDelivered[nodeId],
+                                      1e-6,
+                                      "avg_delay: " << line);
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(nRows, nodes.GetN(), "One row per installed node");
+}
+
+class RitMetricsCollectorTestSuite : public TestSuite
+{
+  public:
+    RitMetricsCollectorTestSuite();
+};
+
+RitMetricsCollectorTestSuite::RitMetricsCollectorTestSuite()
+    : TestSuite("rit-metrics-collector", Type::UNIT)
+{
+    AddTestCase(new RitMetricsCollectorAggregateTest, Duration::QUICK);
+}
+
+static RitMetricsCollectorTestSuite g_ritMetricsCollectorTestSuite;
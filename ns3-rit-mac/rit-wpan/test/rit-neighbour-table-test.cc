@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/log.h>
+#include <ns3/mac16-address.h>
+#include <ns3/nstime.h>
+#include <ns3/rit-neighbour-table.h>
+#include <ns3/test.h>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-neighbour-table-test");
+
+/**
+ * @brief Check the averages, the eviction policy and the parent choice of RitNeighbourTable.
+ */
+class RitNeighbourTableTest : public TestCase
+{
+  public:
+    RitNeighbourTableTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitNeighbourTableTest::RitNeighbourTableTest()
+    : TestCase("RitNeighbourTable averages, eviction and parent choice")
+{
+}
+
+void
+RitNeighbourTableTest::DoRun()
+{
+    const Mac16Address a("00:01");
+    const Mac16Address b("00:02");
+    const Mac16Address c("00:03");
+    const Mac16Address d("00:04");
+    const Mac16Address e("00:05");
+
+    RitNeighbourTable table(2);
+    table.SetEwmaWeight(0.5);
+    table.SetStaleTime(Seconds(10));
+
+    // A newcomer starts with the delivery ratio given by its LQI.
+    RitNeighbour* entry = table.NotifyBeacon(a, 1, 255, Seconds(1));
+    NS_TEST_ASSERT_MSG_NE(entry, nullptr, "First neighbour left out");
+    NS_TEST_EXPECT_MSG_EQ_TOL(entry->GetEtx(), 1.0, 1e-9, "Wrong initial ETX");
+    table.NotifyBeacon(a, 1, 155, Seconds(3));
+    entry = table.Find(a);
+    NS_TEST_EXPECT_MSG_EQ_TOL(entry->lqi, 205.0, 1e-9, "Wrong LQI average");
+    NS_TEST_EXPECT_MSG_EQ(entry->period, Seconds(2), "Wrong beacon interval");
+    table.NotifyTxOutcome(a, false);
+    NS_TEST_EXPECT_MSG_EQ_TOL(entry->GetEtx(), 2.0, 1e-9, "Wrong ETX after a NO_ACK");
+
+    // Same rank, lower ETX: chosen.
+    table.NotifyBeacon(b, 1, 200, Seconds(4));
+    NS_TEST_EXPECT_MSG_EQ(table.SelectParent(0, 0.0)->addr, b, "ETX not used as tie-break");
+    NS_TEST_EXPECT_MSG_EQ(table.SelectParent(0, 1.5)->addr, b, "Parent above the ETX limit");
+    NS_TEST_EXPECT_MSG_EQ(table.SelectParent(203, 0.0)->addr, a, "LQI limit ignored");
+    NS_TEST_EXPECT_MSG_EQ(table.SelectParent(210, 0.0), nullptr, "Parent below the LQI limit");
+
+    // Full and nothing stale: a newcomer of higher rank is left out, a lower one replaces
+    // the worst entry unless it is protected.
+    NS_TEST_EXPECT_MSG_EQ(table.NotifyBeacon(c, 2, 255, Seconds(5)), nullptr, "Worse newcomer");
+    NS_TEST_EXPECT_MSG_EQ(table.GetNRejections(), 1, "Rejection not counted");
+    table.SetProtected(a);
+    NS_TEST_EXPECT_MSG_NE(table.NotifyBeacon(c, 0, 100, Seconds(6)), nullptr, "Better newcomer");
+    NS_TEST_EXPECT_MSG_NE(table.Find(a), nullptr, "Protected entry replaced");
+    NS_TEST_EXPECT_MSG_EQ(table.Find(b), nullptr, "Worst entry not replaced");
+
+    // A stale entry gives way to any newcomer.
+    table.ClearProtected();
+    table.NotifyBeacon(c, 0, 100, Seconds(14));
+    NS_TEST_EXPECT_MSG_NE(table.NotifyBeacon(d, 5, 50, Seconds(15)), nullptr, "Stale kept");
+    NS_TEST_EXPECT_MSG_EQ(table.Find(a), nullptr, "Stale entry not replaced");
+    NS_TEST_EXPECT_MSG_EQ(table.GetNEvictions(), 2, "Evictions not counted");
+    NS_TEST_EXPECT_MSG_EQ(table.GetEntries().size(), 2, "Capacity exceeded");
+
+    // A failed neighbour is skipped until its next beacon and replaced first.
+    table.MarkStale(c);
+    NS_TEST_EXPECT_MSG_EQ(table.SelectParent(0, 0.0)->addr, d, "Stale entry chosen");
+    NS_TEST_EXPECT_MSG_EQ(table.SelectParent(0, 0.0, 4), nullptr, "Rank limit ignored");
+    table.NotifyBeacon(c, 0, 100, Seconds(16));
+    NS_TEST_EXPECT_MSG_EQ(table.SelectParent(0, 0.0)->addr, c, "Beacon did not clear stale");
+    table.MarkStale(c);
+    NS_TEST_EXPECT_MSG_NE(table.NotifyBeacon(e, 9, 50, Seconds(17)), nullptr, "Failed kept");
+    NS_TEST_EXPECT_MSG_EQ(table.Find(c), nullptr, "Failed entry not replaced first");
+
+    table.SetCapacity(1);
+    NS_TEST_EXPECT_MSG_EQ(table.SelectParent(0, 0.0)->addr, d, "Best entry dropped on shrink");
+}
+
+class RitNeighbourTableTestSuite : public TestSuite
+{
+  public:
+    RitNeighbourTableTestSuite();
+};
+
+RitNeighbourTableTestSuite::RitNeighbourTableTestSuite()
+    : TestSuite("rit-neighbour-table", Type::UNIT)
+{
+    AddTestCase(new RitNeighbourTableTest, Duration::QUICK);
+}
+
+static RitNeighbourTableTestSuite g_ritNeighbourTableTestSuite;
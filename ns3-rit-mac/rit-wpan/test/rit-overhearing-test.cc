@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/core-module.h>
+#include <ns3/log.h>
+#include <ns3/lr-wpan-phy.h>
+#include <ns3/network-module.h>
+#include <ns3/packet.h>
+#include <ns3/propagation-delay-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/rit-wpan-mac.h>
+#include <ns3/rit-wpan-net-device.h>
+#include <ns3/single-model-spectrum-channel.h>
+#include <ns3/test.h>
+
+#include <string>
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-overhearing-test");
+
+namespace
+{
+
+/**
+ * @brief Create a channel with the propagation models of the MAC tests. Nodes 70 m
+ *        apart hear each other, nodes 140 m apart do not.
+ * @return the channel
+ */
+Ptr<SingleModelSpectrumChannel>
+CreateTestChannel()
+{
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+    return channel;
+}
+
+/**
+ * @brief Create a node with a RIT device on a line, with fixed random streams.
+ * @param channel The channel
+ * @param address Short address of the device
+ * @param rank RIT rank of the device
+ * @param y Position on the line [m]
+ * @param config Module configuration of the MAC
+ * @param dataWait Data wait duration of the MAC
+ * @return the device
+ */
+Ptr<RitWpanNetDevice>
+CreateTestDevice(Ptr<SingleModelSpectrumChannel> channel,
+                 uint16_t address,
+                 uint16_t rank,
+                 double y,
+                 const RitWpanMacModuleConfig& config,
+                 Time dataWait = MilliSeconds(10))
+{
+    Ptr<Node> node = CreateObject<Node>();
+    Ptr<RitWpanNetDevice> device = CreateObject<RitWpanNetDevice>();
+    device->SetChannel(channel);
+    device->SetAddress(Mac16Address(address));
+    Ptr<ConstantPositionMobilityModel> mob = CreateObject<ConstantPositionMobilityModel>();
+    mob->SetPosition(Vector(0.0, y, 0.0));
+    device->GetPhy()->SetMobility(mob);
+    node->AddDevice(device);
+    device->SetRitRank(rank);
+    device->AssignStreams(100 * address);
+    device->GetMac()->SetModuleConfig(config);
+    // Starts the RIT cycle: its initial phase comes from the streams above
+    device->GetMac()->SetRitTimes(Seconds(1), dataWait, Seconds(5));
+    return device;
+}
+
+/**
+ * @brief Times of a wait trace event.
+ * @param device The device
+ * @param trace "BeaconWaitEvent" or "DataWaitEvent"
+ * @param event The event to log
+ * @param times The times to append to
+ */
+void
+LogWaitEvent(Ptr<RitWpanNetDevice> device,
+             const std::string& trace,
+             const std::string& event,
+             std::vector<Time>* times)
+{
+    device->GetMac()->TraceConnectWithoutContext(
+        trace,
+        Callback<void, std::string, Time>([event, times](std::string e, Time t) {
+            if (e == event)
+            {
+                times->push_back(t);
+            }
+        }));
+}
+
+/**
+ * @brief Times the PHY of a device is turned off.
+ * @param device The device
+ * @param times The times to append to
+ */
+void
+LogTrxOff(Ptr<RitWpanNetDevice> device, std::vector<Time>* times)
+{
+    device->GetPhy()->TraceConnectWithoutContext(
+        "TrxState",
+        Callback<void, Time, PhyEnumeration, PhyEnumeration>(
+            [times](Time t, PhyEnumeration oldState, PhyEnumeration newState) {
+                if (newState == IEEE_802_15_4_PHY_TRX_OFF && oldState != newState)
+                {
+                    times->push_back(t);
+                }
+            }));
+}
+
+/**
+ * @brief Times the sink receives a frame.
+ * @param sink The sink
+ * @param times The times to append to
+ */
+void
+LogSinkRx(Ptr<RitWpanNetDevice> sink, std::vector<Time>* times)
+{
+    sink->SetReceiveCallback(
+        Callback<bool, Ptr<NetDevice>, Ptr<const Packet>, uint16_t, const Address&>(
+            [times](Ptr<NetDevice>, Ptr<const Packet>, uint16_t, const Address&) {
+                times->push_back(Simulator::Now());
+                return true;
+            }));
+}
+
+/**
+ * @param times Sorted times
+ * @param t A time
+ * @return the first time at or after t, Time::Max() if none
+ */
+Time
+NextAtOrAfter(const std::vector<Time>& times, Time t)
+{
+    for (const Time& time : times)
+    {
+        if (time >= t)
+        {
+            return time;
+        }
+    }
+    return Time::Max();
+}
+
+} // namespace
+
+/**
+ * @brief Check the sender-side shortcut: a sender that cannot hear the sink overhears the
+ *        data frame of another sender to it, defers its beacon wait once and sleeps at
+ *        once; nothing is deferred with the module off.
+ *
+ * Sink (0 m) <- A (70 m), B (140 m): B is in range of A only and waits for the sink.
+ */
+class RitOverheardTxDeferralTest : public TestCase
+{
+  public:
+    RitOverheardTxDeferralTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Run the line with or without overhearing avoidance.
+     * @param enabled overhearingAvoidanceEnabled of every node
+     */
+    void Run(bool enabled);
+};
+
+RitOverheardTxDeferralTest::RitOverheardTxDeferralTest()
+    : TestCase("Beacon wait deferred on an overheard data frame to the receiver")
+{
+}
+
+void
+RitOverheardTxDeferralTest::Run(bool enabled)
+{
+    RitWpanMacModuleConfig config;
+    config.overhearingAvoidanceEnabled = enabled;
+    Ptr<SingleModelSpectrumChannel> channel = CreateTestChannel();
+    Ptr<RitWpanNetDevice> sink = CreateTestDevice(channel, 0, 0, 0.0, config);
+    Ptr<RitWpanNetDevice> a = CreateTestDevice(channel, 1, 1, 70.0, config);
+    Ptr<RitWpanNetDevice> b = CreateTestDevice(channel, 2, 1, 140.0, config);
+
+    std::vector<Time> sinkRx;
+    std::vector<Time> deferred;
+    std::vector<Time> bOff;
+    LogSinkRx(sink, &sinkRx);
+    LogWaitEvent(b, "BeaconWaitEvent", "deferred", &deferred);
+    LogTrxOff(b, &bOff);
+
+    // B waits for the sink first, then A answers the next sink beacon
+    Simulator::ScheduleWithContext(b->GetNode()->GetId(), Seconds(4.9), [=]() {
+        b->Send(Create<Packet>(20), Mac16Address("00:00"), 0);
+    });
+    Simulator::ScheduleWithContext(a->GetNode()->GetId(), Seconds(5), [=]() {
+        a->Send(Create<Packet>(20), Mac16Address("00:00"), 0);
+    });
+
+    Simulator::Stop(Seconds(8));
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(sinkRx.size(), 1, "Frame of A not received by the sink");
+    if (!enabled)
+    {
+        NS_TEST_EXPECT_MSG_EQ(b->GetMac()->GetNOverheardTxDeferrals(), 0, "Deferred, module off");
+        NS_TEST_EXPECT_MSG_EQ(deferred.size(), 0, "Deferral traced, module off");
+        Simulator::Destroy();
+        return;
+    }
+
+    NS_TEST_EXPECT_MSG_EQ(b->GetMac()->GetNOverheardTxDeferrals(), 1, "Deferrals of B");
+    NS_TEST_EXPECT_MSG_EQ(a->GetMac()->GetNOverheardTxDeferrals(), 0, "Deferrals of A");
+    NS_TEST_ASSERT_MSG_EQ(deferred.size(), 1, "Deferral not traced once");
+    // Deferred at the end of the data frame, when the sink takes it
+    NS_TEST_EXPECT_MSG_LT(Abs(deferred[0] - sinkRx[0]), MilliSeconds(1), "Deferred late");
+    NS_TEST_EXPECT_MSG_LT(NextAtOrAfter(bOff, deferred[0]) - deferred[0],
+                          MilliSeconds(1),
+                          "B kept listening after the deferral");
+
+    Simulator::Destroy();
+}
+
+void
+RitOverheardTxDeferralTest::DoRun()
+{
+    Run(false);
+    Run(true);
+}
+
+/**
+ * @brief Check the receiver-side shortcut: a node in its data wait that heard the beacon
+ *        of the sink ends the wait when a data frame to the sink follows, sleeps at once,
+ *        and spends less time in RX than without the module.
+ *
+ * Sink (0 m) <- A (70 m), with C (35 m) beaconing with a long data wait between them. The
+ * sink beacons at random intervals, so its beacons fall into the data waits of C.
+ */
+class RitOverheardRxShortcutTest : public TestCase
+{
+  public:
+    RitOverheardRxShortcutTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Run the scenario with or without overhearing avoidance at C.
+     * @param enabled overhearingAvoidanceEnabled of C
+     * @return the RX time of C over the run
+     */
+    Time Run(bool enabled);
+};
+
+RitOverheardRxShortcutTest::RitOverheardRxShortcutTest()
+    : TestCase("Data wait ended on an overheard rendezvous of a neighbour")
+{
+}
+
+Time
+RitOverheardRxShortcutTest::Run(bool enabled)
+{
+    RitWpanMacModuleConfig sinkConfig;
+    sinkConfig.beaconRandomizeEnabled = true;
+    RitWpanMacModuleConfig config;
+    RitWpanMacModuleConfig cConfig;
+    cConfig.overhearingAvoidanceEnabled = enabled;
+    Ptr<SingleModelSpectrumChannel> channel = CreateTestChannel();
+    Ptr<RitWpanNetDevice> sink = CreateTestDevice(channel, 0, 0, 0.0, sinkConfig);
+    Ptr<RitWpanNetDevice> a = CreateTestDevice(channel, 1, 1, 70.0, config);
+    Ptr<RitWpanNetDevice> c = CreateTestDevice(channel, 2, 1, 35.0, cConfig, MilliSeconds(500));
+
+    std::vector<Time> sinkRx;
+    std::vector<Time> overheard;
+    std::vector<Time> cOff;
+    LogSinkRx(sink, &sinkRx);
+    LogWaitEvent(c, "DataWaitEvent", "overheard", &overheard);
+    LogTrxOff(c, &cOff);
+
+    for (uint32_t k = 0; k < 30; k++)
+    {
+        Simulator::ScheduleWithContext(a->GetNode()->GetId(), Seconds(2 + 2 * k), [=]() {
+            a->Send(Create<Packet>(20), Mac16Address("00:00"), 0);
+        });
+    }
+
+    Simulator::Stop(Seconds(65));
+    Simulator::Run();
+
+    const std::string mode = enabled ? "on" : "off";
+    NS_TEST_EXPECT_MSG_GT(sinkRx.size(), 0, "Nothing received by the sink, " << mode);
+    NS_TEST_EXPECT_MSG_EQ(c->GetMac()->GetNOverheardRxShortcuts(),
+                          overheard.size(),
+                          "Shortcuts not traced once each, " << mode);
+    if (enabled)
+    {
+        NS_TEST_EXPECT_MSG_GT(overheard.size(), 0, "No data wait of C cut short");
+        for (const Time& t : overheard)
+        {
+            NS_TEST_EXPECT_MSG_LT(NextAtOrAfter(sinkRx, t) - t,
+                                  MilliSeconds(1),
+                                  "Shortcut at " << t.As(Time::S) << " without a rendezvous");
+            NS_TEST_EXPECT_MSG_LT(NextAtOrAfter(cOff, t) - t,
+                                  MilliSeconds(1),
+                                  "C kept listening after the shortcut at " << t.As(Time::S));
+        }
+    }
+    else
+    {
+        NS_TEST_EXPECT_MSG_EQ(overheard.size(), 0, "Data wait cut short with the module off");
+    }
+    NS_TEST_EXPECT_MSG_EQ(a->GetMac()->GetNOverheardRxShortcuts(), 0, "Module off at A");
+
+    const PhyDutyCycleCounters counters = c->GetPhy()->GetDutyCycleCounters();
+    Simulator::Destroy();
+    return counters.rxOn + counters.busyRx;
+}
+
+void
+RitOverheardRxShortcutTest::DoRun()
+{
+    const Time rxOff = Run(false);
+    const Time rxOn = Run(true);
+    NS_TEST_EXPECT_MSG_LT(rxOn, rxOff, "Overhearing avoidance did not save RX time");
+}
+
+class RitOverhearingTestSuite : public TestSuite
+{
+  public:
+    RitOverhearingTestSuite();
+};
+
+RitOverhearingTestSuite::RitOverhearingTestSuite()
+    : TestSuite("rit-overhearing", Type::UNIT)
+{
+    AddTestCase(new RitOverheardTxDeferralTest, Duration::QUICK);
+    AddTestCase(new RitOverheardRxShortcutTest, Duration::QUICK);
+}
+
+static RitOverhearingTestSuite g_ritOverhearingTestSuite;
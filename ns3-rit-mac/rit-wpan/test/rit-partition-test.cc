@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/core-module.h>
+#include <ns3/log.h>
+#include <ns3/lr-wpan-spectrum-channel.h>
+#include <ns3/lr-wpan-spectrum-value-helper.h>
+#include <ns3/network-module.h>
+#include <ns3/periodic-sender-helper.h>
+#include <ns3/propagation-delay-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/rit-partition-helper.h>
+#include <ns3/rit-remote-signal-header.h>
+#include <ns3/rit-wpan-helper.h>
+#include <ns3/rit-wpan-net-device.h>
+#include <ns3/test.h>
+
+#include <cstdint>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-partition-test");
+
+/**
+ * @brief Create nodes with a ConstantPositionMobilityModel.
+ * @param positions Position of each node
+ * @return the nodes
+ */
+static NodeContainer
+CreatePlacedNodes(const std::vector<Vector>& positions)
+{
+    NodeContainer nodes;
+    for (const auto& position : positions)
+    {
+        Ptr<Node> node = CreateObject<Node>();
+        Ptr<ConstantPositionMobilityModel> mob = CreateObject<ConstantPositionMobilityModel>();
+        mob->SetPosition(position);
+        node->AggregateObject(mob);
+        nodes.Add(node);
+    }
+    return nodes;
+}
+
+/**
+ * @brief Check that Partition() cuts a grid into compact regions of equal size.
+ */
+class RitPartitionGridTest : public TestCase
+{
+  public:
+    RitPartitionGridTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitPartitionGridTest::RitPartitionGridTest()
+    : TestCase("Partition of a grid into balanced regions")
+{
+}
+
+void
+RitPartitionGridTest::DoRun()
+{
+    // 8 x 4 grid, 10 m steps
+    std::vector<Vector> positions;
+    for (uint32_t y = 0; y < 4; y++)
+    {
+        for (uint32_t x = 0; x < 8; x++)
+        {
+            positions.emplace_back(10.0 * x, 10.0 * y, 0);
+        }
+    }
+    NodeContainer nodes = CreatePlacedNodes(positions);
+    RitPartitionHelper partition;
+
+    const std::vector<uint32_t> regions = partition.Partition(nodes, 4);
+    NS_TEST_ASSERT_MSG_EQ(regions.size(), positions.size(), "One region per node expected");
+    std::vector<uint32_t> sizes(4, 0);
+    for (uint32_t i = 0; i < regions.size(); i++)
+    {
+        NS_TEST_ASSERT_MSG_LT(regions[i], 4, "Region out of range");
+        sizes[regions[i]]++;
+    }
+    for (uint32_t r = 0; r < 4; r++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(sizes[r], 8, "Unbalanced region " << r);
+    }
+    // the 8 x 4 grid is cut into four 2 x 4 columns
+    for (uint32_t i = 0; i < positions.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(regions[i],
+                              static_cast<uint32_t>(positions[i].x / 20.0),
+                              "Node " << i << " in the wrong region");
+    }
+
+    const std::vector<uint32_t> single = partition.Partition(nodes, 1);
+    NS_TEST_EXPECT_MSG_EQ(std::set<uint32_t>(single.begin(), single.end()).size(),
+                          1,
+                          "One region expected");
+    Simulator::Destroy();
+}
+
+/**
+ * @brief Check that a network whose channel is split into regions connected in
+ *        the same process delivers the same packets as the unsplit network.
+ */
+class RitPartitionInProcessTest : public TestCase
+{
+  public:
+    RitPartitionInProcessTest();
+
+  private:
+    /**
+     * @brief Record a packet delivered at the sink.
+     * @param dev The device
+     * @param pkt The packet
+     * @param proto The protocol number
+     * @param addr The source address
+     * @return true
+     */
+    bool DataIndication(Ptr<NetDevice> dev,
+                        Ptr<const Packet> pkt,
+                        uint16_t proto,
+                        const Address& addr);
+
+    /**
+     * @brief Build and run a line of a sink and seven routers, 60 m apart.
+     * @param nRegions Number of regions (1: channel not split)
+     */
+    void RunNetwork(uint32_t nRegions);
+
+    void DoRun() override;
+
+    std::vector<std::pair<uint16_t, int64_t>> m_sinkRx; //!< Source and time (ns) at the sink
+    uint64_t m_nHandovers{0};                           //!< Transmissions handed over
+    uint32_t m_nBorderNodes{0};                         //!< Transmitters that handed over
+};
+
+RitPartitionInProcessTest::RitPartitionInProcessTest()
+    : TestCase("Regions connected in process keep the results of the unsplit channel")
+{
+}
+
+bool
+RitPartitionInProcessTest::DataIndication(Ptr<NetDevice> dev,
+                                          Ptr<const Packet> pkt,
+                                          uint16_t proto,
+                                          const Address& addr)
+{
+    m_sinkRx.emplace_back(Mac16Address::ConvertFrom(addr).ConvertToInt(),
+                          Simulator::Now().GetNanoSeconds());
+    return true;
+}
+
+void
+RitPartitionInProcessTest::RunNetwork(uint32_t nRegions)
+{
+    m_sinkRx.clear();
+
+    std::vector<Vector> positions;
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        positions.emplace_back(60.0 * i, 0, 0);
+    }
+    NodeContainer nodes = CreatePlacedNodes(positions);
+    NodeContainer sink(nodes.Get(0));
+    NodeContainer routers;
+    for (uint32_t i = 1; i < nodes.GetN(); i++)
+    {
+        routers.Add(nodes.Get(i));
+    }
+
+    Ptr<LrWpanSpectrumChannel> channel = CreateObject<LrWpanSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    RitWpanNetHelper helper;
+    helper.SetChannel(channel);
+    helper.SetMacRitPeriod(Seconds(1));
+    helper.SetMacRitDataWaitDuration(MilliSeconds(10));
+    helper.SetMacRitTxWaitDuration(Seconds(5));
+    NetDeviceContainer sinkDevices = helper.InstallSinks(sink);
+    NetDeviceContainer routerDevices = helper.Install(routers);
+    for (uint32_t i = 0; i < routerDevices.GetN(); i++)
+    {
+        Ptr<RitWpanNetDevice> dev = DynamicCast<RitWpanNetDevice>(routerDevices.Get(i));
+        dev->SetAddress(Mac16Address(static_cast<uint16_t>(i + 1)));
+        dev->SetRitRank(i + 1);
+    }
+    sinkDevices.Get(0)->SetReceiveCallback(
+        MakeCallback(&RitPartitionInProcessTest::DataIndication, this));
+
+    RitPartitionHelper partition;
+    if (nRegions > 1)
+    {
+        partition.SetRegions(nodes, partition.Partition(nodes, nRegions));
+        partition.ConnectInProcess(channel);
+    }
+
+    PeriodicSenderHelper app;
+    app.SetPeriod(Seconds(10));
+    app.SetPacketSize(20);
+    app.SetDstAddr(Mac16Address("00:00"));
+    app.Install(routers);
+
+    const int64_t span = helper.AssignStreams(nodes, 0);
+    app.AssignStreams(routers, span);
+
+    Simulator::Stop(Seconds(60));
+    Simulator::Run();
+    m_nHandovers = partition.GetNHandovers();
+    m_nBorderNodes = partition.GetNBorderNodes();
+    Simulator::Destroy();
+}
+
+void
+RitPartitionInProcessTest::DoRun()
+{
+    RunNetwork(1);
+    const auto sinkRx = m_sinkRx;
+    NS_TEST_ASSERT_MSG_GT(sinkRx.size(), 0, "No packet delivered at the sink");
+    NS_TEST_EXPECT_MSG_EQ(m_nHandovers, 0, "Handover without regions");
+
+    // two regions cut between 00:03 and 00:04: the nodes far from the cut,
+    // beyond the culling range, never hand over
+    RunNetwork(2);
+    NS_TEST_EXPECT_MSG_GT(m_nHandovers, 0, "No transmission crossed the cut");
+    NS_TEST_EXPECT_MSG_GT(m_nBorderNodes, 0, "No border node");
+    NS_TEST_EXPECT_MSG_LT(m_nBorderNodes, 8, "Every node handed over");
+    NS_TEST_ASSERT_MSG_EQ(m_sinkRx.size(), sinkRx.size(), "Different number of deliveries");
+    for (size_t i = 0; i < sinkRx.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_sinkRx[i].first, sinkRx[i].first, "Different source");
+        NS_TEST_EXPECT_MSG_EQ(m_sinkRx[i].second, sinkRx[i].second, "Different delivery time");
+    }
+
+    const Time lookahead = RitPartitionHelper::GetLookahead(CreateObject<LrWpanPhy>(), 60.0);
+    NS_TEST_EXPECT_MSG_EQ(lookahead > MicroSeconds(192), true, "Lookahead below the turnaround");
+    NS_TEST_EXPECT_MSG_EQ(lookahead < MicroSeconds(193), true, "Lookahead too long");
+}
+
+/**
+ * @brief Check that a RitRemoteSignalHeader carries a signal to another process
+ *        unchanged, ahead of its frame.
+ */
+class RitRemoteSignalHeaderTest : public TestCase
+{
+  public:
+    RitRemoteSignalHeaderTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitRemoteSignalHeaderTest::RitRemoteSignalHeaderTest()
+    : TestCase("Round trip of a signal handed over to another rank")
+{
+}
+
+void
+RitRemoteSignalHeaderTest::DoRun()
+{
+    LrWpanSpectrumValueHelper psdHelper;
+    Ptr<SpectrumValue> psd = psdHelper.CreateTxPowerSpectralDensity(0.0, 15);
+
+    RitRemoteSignalHeader header;
+    header.SetTransmitter(1234, 2);
+    header.SetTxChannel(15);
+    header.SetDuration(NanoSeconds(4256001));
+    header.SetPsd(psd);
+    Ptr<Packet> p = Create<Packet>(37);
+    p->AddHeader(header);
+    NS_TEST_EXPECT_MSG_EQ(p->GetSize(),
+                          37 + header.GetSerializedSize(),
+                          "Wrong serialized size");
+
+    RitRemoteSignalHeader received;
+    p->RemoveHeader(received);
+    NS_TEST_EXPECT_MSG_EQ(p->GetSize(), 37, "Frame not restored");
+    NS_TEST_EXPECT_MSG_EQ(received.GetNodeId(), 1234, "Wrong node");
+    NS_TEST_EXPECT_MSG_EQ(received.GetIfIndex(), 2, "Wrong device");
+    NS_TEST_EXPECT_MSG_EQ(static_cast<uint32_t>(received.GetTxChannel()), 15, "Wrong channel");
+    NS_TEST_EXPECT_MSG_EQ(received.GetDuration(), NanoSeconds(4256001), "Wrong duration");
+
+    Ptr<SpectrumValue> rxPsd = received.GetPsd(psd->GetSpectrumModel());
+    NS_TEST_ASSERT_MSG_EQ(rxPsd->GetValuesN(), psd->GetValuesN(), "Wrong number of bins");
+    uint32_t nonzero = 0;
+    for (uint32_t i = 0; i < psd->GetValuesN(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ((*rxPsd)[i], (*psd)[i], "Bin " << i << " changed");
+        nonzero += (*psd)[i] != 0.0 ? 1 : 0;
+    }
+    NS_TEST_EXPECT_MSG_GT(nonzero, 0, "Empty PSD");
+    NS_TEST_EXPECT_MSG_LT(nonzero, psd->GetValuesN(), "Zero bins not left out");
+}
+
+class RitPartitionTestSuite : public TestSuite
+{
+  public:
+    RitPartitionTestSuite();
+};
+
+RitPartitionTestSuite::RitPartitionTestSuite()
+    : TestSuite("rit-partition", Type::UNIT)
+{
+    AddTestCase(new RitPartitionGridTest, Duration::QUICK);
+    AddTestCase(new RitPartitionInProcessTest, Duration::QUICK);
+    AddTestCase(new RitRemoteSignalHeaderTest, Duration::QUICK);
+}
+
+static RitPartitionTestSuite g_ritPartitionTestSuite;
@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/core-module.h>
+#include <ns3/log.h>
+#include <ns3/rit-performance-predictor.h>
+
+#include <cmath>
+#include <sstream>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-performance-predictor-test");
+
+namespace
+{
+
+/**
+ * @param predictor The predictor to fill
+ * @param nRouters Routers of each of the two ranks above the sink
+ * @param appRate Packets generated per second by each router
+ * @param neighbours Neighbour count of every node
+ */
+void
+AddTwoRankNetwork(RitPerformancePredictor& predictor,
+                  uint32_t nRouters,
+                  double appRate,
+                  uint32_t neighbours)
+{
+    RitPredictorNode sink;
+    sink.rank = 0;
+    sink.rxAlwaysOn = true;
+    sink.neighbours = neighbours;
+    predictor.AddNode(sink);
+    for (uint16_t rank = 1; rank <= 2; rank++)
+    {
+        for (uint32_t i = 0; i < nRouters; i++)
+        {
+            RitPredictorNode router;
+            router.rank = rank;
+            router.appRate = appRate;
+            router.neighbours = neighbours;
+            predictor.AddNode(router);
+        }
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Check the single-hop figures against their closed forms.
+ */
+class RitPerformancePredictorSingleHopTest : public TestCase
+{
+  public:
+    RitPerformancePredictorSingleHopTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitPerformancePredictorSingleHopTest::RitPerformancePredictorSingleHopTest()
+    : TestCase("RitPerformancePredictor single hop closed forms")
+{
+}
+
+void
+RitPerformancePredictorSingleHopTest::DoRun()
+{
+    RitPerformancePredictor predictor;
+    RitPredictorParameters parameters;
+    parameters.ritPeriod = Seconds(2);
+    parameters.alwaysOnRitPeriod = Seconds(2);
+    predictor.SetParameters(parameters);
+
+    RitPredictorNode sink;
+    sink.rank = 0;
+    sink.rxAlwaysOn = true;
+    RitPredictorNode router;
+    router.appRate = 0.01;
+    predictor.AddNode(sink);
+    predictor.AddNode(router);
+    NS_TEST_ASSERT_MSG_EQ(predictor.GetNNodes(), 2, "Nodes not added");
+
+    const RitNetworkPrediction prediction = predictor.Predict();
+    const RitNodePrediction& p = prediction.nodes[1];
+    // A lone sender neither collides nor times out: one attempt per packet
+    NS_TEST_EXPECT_MSG_EQ_TOL(p.attemptRate, 0.01, 1e-9, "Attempts without contention");
+    NS_TEST_EXPECT_MSG_EQ(p.dataCollision, 0.0, "Collision without another sender");
+    NS_TEST_EXPECT_MSG_EQ(p.txWaitTimeout, 0.0, "Timeout with TWD above BI");
+    NS_TEST_EXPECT_MSG_EQ_TOL(p.deliveryProbability, 1.0, 1e-9, "Loss without contention");
+    NS_TEST_EXPECT_MSG_EQ_TOL(prediction.pdr, 1.0, 1e-9, "Network loss without contention");
+
+    // Half a beacon interval, the exchange, and an M/D/1 wait at the sink
+    const double exchange = RitPerformancePredictor::GetFrameAirtime(30).GetSeconds() +
+                            12 * 16e-6 + RitPerformancePredictor::GetFrameAirtime(5).GetSeconds();
+    const double rho = 0.01 * 2;
+    const double expected = 1.0 + exchange + rho / (2 * (1 - rho)) * 2;
+    NS_TEST_EXPECT_MSG_EQ_TOL(p.rendezvousDelay, expected, 1e-9, "Rendezvous delay");
+    NS_TEST_EXPECT_MSG_EQ_TOL(prediction.delayMean, expected, 1e-9, "Mean path delay");
+    NS_TEST_EXPECT_MSG_EQ_TOL(prediction.nodes[0].relayUtilisation, rho, 1e-9, "Sink load");
+    NS_TEST_EXPECT_MSG_EQ(prediction.nodes[0].wakeRatio, 1.0, "RxAlwaysOn sink asleep");
+    NS_TEST_EXPECT_MSG_GT(p.wakeRatio, 0.0, "Router never awake");
+    NS_TEST_EXPECT_MSG_LT(p.wakeRatio, 1.0, "Router always awake");
+    NS_TEST_EXPECT_MSG_EQ(prediction.saturated, false, "Light load saturated");
+}
+
+/**
+ * @brief Check that the figures move the way the RIT trade-offs go: a longer beacon
+ *        interval lowers the wake ratio and raises the delay, TWD below BI loses
+ *        packets, retries recover collisions and overload saturates the relays.
+ */
+class RitPerformancePredictorTrendTest : public TestCase
+{
+  public:
+    RitPerformancePredictorTrendTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitPerformancePredictorTrendTest::RitPerformancePredictorTrendTest()
+    : TestCase("RitPerformancePredictor trends")
+{
+}
+
+void
+RitPerformancePredictorTrendTest::DoRun()
+{
+    auto predict = [](Time period, Time twd, uint32_t retries, double appRate) {
+        RitPerformancePredictor predictor;
+        RitPredictorParameters parameters;
+        parameters.ritPeriod = period;
+        parameters.alwaysOnRitPeriod = period;
+        parameters.txWaitDuration = twd;
+        parameters.maxRetries = retries;
+        predictor.SetParameters(parameters);
+        AddTwoRankNetwork(predictor, 8, appRate, 6);
+        return predictor.Predict();
+    };
+
+    // Light traffic: the beacons, not the senders waiting for them, dominate the wake ratio
+    const RitNetworkPrediction shortBi = predict(Seconds(1), Seconds(5), 0, 0.001);
+    const RitNetworkPrediction longBi = predict(Seconds(4), Seconds(5), 0, 0.001);
+    NS_TEST_EXPECT_MSG_LT(longBi.wakeRatioMean, shortBi.wakeRatioMean, "Longer BI, more wake");
+    NS_TEST_EXPECT_MSG_GT(longBi.delayMean, shortBi.delayMean, "Longer BI, less delay");
+    NS_TEST_EXPECT_MSG_LT(shortBi.nodes[1].pathDelay,
+                          shortBi.nodes[9].pathDelay,
+                          "Rank 2 not further than rank 1");
+    NS_TEST_EXPECT_MSG_GT(shortBi.nodes[1].relayRate, 0.0, "Rank 1 relays nothing");
+    NS_TEST_EXPECT_MSG_EQ(shortBi.nodes[9].relayRate, 0.0, "Top rank relays");
+
+    const RitNetworkPrediction shortTwd = predict(Seconds(4), Seconds(2), 0, 0.001);
+    NS_TEST_EXPECT_MSG_EQ_TOL(shortTwd.nodes[1].txWaitTimeout, 0.5, 1e-9, "TWD timeout");
+    NS_TEST_EXPECT_MSG_LT(shortTwd.pdr, longBi.pdr, "Short TWD loses nothing");
+
+    const RitNetworkPrediction noRetry = predict(Seconds(4), Seconds(2), 0, 0.01);
+    const RitNetworkPrediction retries = predict(Seconds(4), Seconds(2), 3, 0.01);
+    NS_TEST_EXPECT_MSG_GT(retries.pdr, noRetry.pdr, "Retries recover nothing");
+    NS_TEST_EXPECT_MSG_GT(retries.nodes[1].attemptRate,
+                          noRetry.nodes[1].attemptRate,
+                          "Retries add no attempts");
+
+    const RitNetworkPrediction overload = predict(Seconds(5), Seconds(5), 0, 0.2);
+    NS_TEST_EXPECT_MSG_EQ(overload.saturated, true, "Overloaded sink not saturated");
+    NS_TEST_EXPECT_MSG_EQ(std::isinf(overload.delayMax), true, "Saturated delay finite");
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(overload.iterations, 200U, "Iteration not bounded");
+
+    std::ostringstream summary;
+    RitPerformancePredictor::WriteSummary(shortBi, summary);
+    NS_TEST_EXPECT_MSG_NE(summary.str().find("pred_wake_ratio_mean,"),
+                          std::string::npos,
+                          "Summary key missing");
+}
+
+/**
+ * @brief Check the module effects: response slots lower the data collisions, the data
+ *        wait probe lowers the wake ratio, beacon deconfliction removes the beacon
+ *        collisions, and a rank without a parent delivers nothing.
+ */
+class RitPerformancePredictorModuleTest : public TestCase
+{
+  public:
+    RitPerformancePredictorModuleTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitPerformancePredictorModuleTest::RitPerformancePredictorModuleTest()
+    : TestCase("RitPerformancePredictor module effects")
+{
+}
+
+void
+RitPerformancePredictorModuleTest::DoRun()
+{
+    auto predict = [](const RitWpanMacModuleConfig& config) {
+        RitPerformancePredictor predictor;
+        predictor.SetModuleConfig(config);
+        AddTwoRankNetwork(predictor, 8, 0.02, 12);
+        return predictor.Predict();
+    };
+
+    const RitWpanMacModuleConfig base;
+    const RitNetworkPrediction plain = predict(base);
+    NS_TEST_EXPECT_MSG_GT(plain.nodes[1].dataCollision, 0.0, "No contention at the sink");
+    NS_TEST_EXPECT_MSG_GT(plain.beaconCollisionMean, 0.0, "No beacon collision");
+
+    RitWpanMacModuleConfig slots;
+    slots.contentionSlotsEnabled = true;
+    const RitNetworkPrediction slotted = predict(slots);
+    NS_TEST_EXPECT_MSG_LT(slotted.nodes[1].dataCollision,
+                          plain.nodes[1].dataCollision,
+                          "Slots do not spread the senders");
+    NS_TEST_EXPECT_MSG_LT(slotted.relayUtilisationMax,
+                          plain.relayUtilisationMax,
+                          "Slots do not add capacity");
+
+    RitWpanMacModuleConfig probe;
+    probe.dataWaitProbeEnabled = true;
+    NS_TEST_EXPECT_MSG_LT(predict(probe).wakeRatioMean,
+                          plain.wakeRatioMean,
+                          "Probe does not shorten the idle waits");
+
+    RitWpanMacModuleConfig deconflict;
+    deconflict.beaconDeconflictionEnabled = true;
+    NS_TEST_EXPECT_MSG_EQ(predict(deconflict).beaconCollisionMean,
+                          0.0,
+                          "Deconflicted beacons collide");
+
+    RitPerformancePredictor orphan;
+    RitPredictorNode sink;
+    sink.rank = 0;
+    sink.rxAlwaysOn = true;
+    RitPredictorNode router;
+    router.rank = 2;
+    router.appRate = 0.01;
+    orphan.AddNode(sink);
+    orphan.AddNode(router);
+    const RitNetworkPrediction unreachable = orphan.Predict();
+    NS_TEST_EXPECT_MSG_EQ(unreachable.pdr, 0.0, "Rank without parent delivers");
+    NS_TEST_EXPECT_MSG_EQ(std::isinf(unreachable.nodes[1].pathDelay), true, "Finite delay");
+}
+
+class RitPerformancePredictorTestSuite : public TestSuite
+{
+  public:
+    RitPerformancePredictorTestSuite();
+};
+
+RitPerformancePredictorTestSuite::RitPerformancePredictorTestSuite()
+    : TestSuite("rit-performance-predictor", Type::UNIT)
+{
+    AddTestCase(new RitPerformancePredictorSingleHopTest, Duration::QUICK);
+    AddTestCase(new RitPerformancePredictorTrendTest, Duration::QUICK);
+    AddTestCase(new RitPerformancePredictorModuleTest, Duration::QUICK);
+}
+
+static RitPerformancePredictorTestSuite g_ritPerformancePredictorTestSuite;
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/double.h>
+#include <ns3/log.h>
+#include <ns3/nstime.h>
+#include <ns3/rit-period-policy.h>
+#include <ns3/test.h>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-period-policy-test");
+
+/**
+ * @brief Check the period returned by the RIT period policies for a given window load.
+ */
+class RitPeriodPolicyTest : public TestCase
+{
+  public:
+    RitPeriodPolicyTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitPeriodPolicyTest::RitPeriodPolicyTest()
+    : TestCase("RIT period policies")
+{
+}
+
+void
+RitPeriodPolicyTest::DoRun()
+{
+    const Time period = Seconds(4);
+    RitPeriodLoad idle{10, 0, 0, 0};
+    RitPeriodLoad busy{10, 2, 3, 0};
+
+    Ptr<RitAimdPeriodPolicy> aimd = CreateObject<RitAimdPeriodPolicy>();
+    NS_TEST_EXPECT_MSG_EQ(aimd->Update(period, idle),
+                          Seconds(4.5),
+                          "Idle window did not add the increase step");
+    NS_TEST_EXPECT_MSG_EQ(aimd->Update(period, busy),
+                          Seconds(2),
+                          "Busy window did not divide the period");
+
+    Ptr<RitTargetUtilizationPeriodPolicy> target =
+        CreateObject<RitTargetUtilizationPeriodPolicy>();
+    NS_TEST_EXPECT_MSG_EQ(target->Update(period, RitPeriodLoad()),
+                          period,
+                          "Period changed without beacons");
+    NS_TEST_EXPECT_MSG_EQ(target->Update(period, idle),
+                          Seconds(8),
+                          "Idle window not limited to the largest step");
+    // 2 answered of 10 beacons, target 0.5: the period grows by 2.5, limited to 2
+    NS_TEST_EXPECT_MSG_EQ(target->Update(period, busy), Seconds(8), "Wrong grown period");
+    // 4 answered and 4 announcing more data: utilization 0.8
+    NS_TEST_EXPECT_MSG_EQ(target->Update(period, RitPeriodLoad{10, 4, 8, 4}),
+                          Seconds(2.5),
+                          "Backlog not counted as demand");
+
+    target->SetAttribute("TargetUtilization", DoubleValue(0.2));
+    NS_TEST_EXPECT_MSG_EQ(target->Update(period, busy), period, "Period changed on target");
+}
+
+class RitPeriodPolicyTestSuite : public TestSuite
+{
+  public:
+    RitPeriodPolicyTestSuite();
+};
+
+RitPeriodPolicyTestSuite::RitPeriodPolicyTestSuite()
+    : TestSuite("rit-period-policy", Type::UNIT)
+{
+    AddTestCase(new RitPeriodPolicyTest, Duration::QUICK);
+}
+
+static RitPeriodPolicyTestSuite g_ritPeriodPolicyTestSuite;
@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/core-module.h>
+#include <ns3/log.h>
+#include <ns3/network-module.h>
+#include <ns3/periodic-sender-helper.h>
+#include <ns3/propagation-delay-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/rit-metrics-collector.h>
+#include <ns3/rit-progress-reporter.h>
+#include <ns3/rit-wpan-helper.h>
+#include <ns3/rit-wpan-net-device.h>
+#include <ns3/single-model-spectrum-channel.h>
+#include <ns3/test.h>
+
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-progress-reporter-test");
+
+namespace
+{
+
+/**
+ * @brief Fields of a JSON-lines report (flat object of numbers, booleans and null).
+ * @param line Report line
+ * @return the value text of each key
+ */
+std::map<std::string, std::string>
+ParseReport(const std::string& line)
+{
+    std::map<std::string, std::string> fields;
+    std::istringstream in(line.substr(1, line.size() - 2));
+    std::string field;
+    while (std::getline(in, field, ','))
+    {
+        const size_t colon = field.find(':');
+        fields[field.substr(1, colon - 2)] = field.substr(colon + 1);
+    }
+    return fields;
+}
+
+/**
+ * @brief Read the reports of a JSON-lines file.
+ * @param path File
+ * @return the fields of each line, in order
+ */
+std::vector<std::map<std::string, std::string>>
+ReadReports(const std::string& path)
+{
+    std::vector<std::map<std::string, std::string>> reports;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line))
+    {
+        reports.push_back(ParseReport(line));
+    }
+    return reports;
+}
+
+} // namespace
+
+/**
+ * @brief Check the JSON-lines reports of a run: one per interval of simulated time and a
+ *        final one at Simulator::Destroy(), increasing event counts, the followed nodes
+ *        and the cumulative PDR of the metrics collector.
+ */
+class RitProgressReporterReportTest : public TestCase
+{
+  public:
+    RitProgressReporterReportTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitProgressReporterReportTest::RitProgressReporterReportTest()
+    : TestCase("Periodic and final JSON-lines progress reports")
+{
+}
+
+void
+RitProgressReporterReportTest::DoRun()
+{
+    NodeContainer sinks;
+    sinks.Create(1);
+    NodeContainer leaves;
+    leaves.Create(2);
+    NodeContainer nodes(sinks, leaves);
+
+    RitWpanNetHelper helper;
+    helper.SetMacRitPeriod(Seconds(1));
+    helper.SetMacRitDataWaitDuration(MilliSeconds(10));
+    helper.SetMacRitTxWaitDuration(Seconds(5));
+    NetDeviceContainer devices = helper.Install(nodes);
+    for (uint32_t i = 0; i < devices.GetN(); i++)
+    {
+        Ptr<RitWpanNetDevice> dev = DynamicCast<RitWpanNetDevice>(devices.Get(i));
+        dev->SetAddress(Mac16Address(static_cast<uint16_t>(i)));
+        dev->SetRitRank(i == 0 ? 0 : 1);
+    }
+
+    PeriodicSenderHelper sinkApp;
+    sinkApp.SetReceiveOnly(true);
+    sinkApp.Install(sinks);
+    PeriodicSenderHelper leafApp;
+    leafApp.SetPeriod(Seconds(10));
+    leafApp.SetPacketSize(20);
+    leafApp.SetDstAddr(Mac16Address("00:00"));
+    leafApp.Install(leaves);
+
+    const std::string baseDir = CreateTempDirFilename("rit-progress-reporter/");
+    Ptr<RitMetricsCollector> collector = helper.EnableMetricsCollector(nodes, baseDir);
+    const std::string path = CreateTempDirFilename("rit-progress-reporter.jsonl");
+    helper.EnableProgressReporter(nodes, Seconds(10), path, collector);
+
+    // Off the report grid, so that the last periodic report is at 100 s
+    Simulator::Stop(Seconds(105));
+    Simulator::Run();
+    const RitMetricsCollector::Totals totals = collector->GetTotals();
+    NS_TEST_ASSERT_MSG_GT(totals.txUnique, 0, "Nothing sent");
+
+    // The periodic reports are flushed as they are written
+    NS_TEST_EXPECT_MSG_EQ(ReadReports(path).size(), 10, "Periodic reports not flushed");
+    Simulator::Destroy();
+
+    const auto reports = ReadReports(path);
+    NS_TEST_ASSERT_MSG_EQ(reports.size(), 11, "Expected ten reports and a final one");
+    uint64_t events = 0;
+    for (size_t i = 0; i < reports.size(); i++)
+    {
+        const auto& report = reports[i];
+        const bool last = i + 1 == reports.size();
+        NS_TEST_EXPECT_MSG_EQ_TOL(std::stod(report.at("sim_time")),
+                                  last ? 105.0 : 10.0 * (i + 1),
+                                  1e-6,
+                                  "Simulated time of report " << i);
+        NS_TEST_EXPECT_MSG_EQ(report.at("final"), last ? "true" : "false", "Final flag");
+        NS_TEST_EXPECT_MSG_EQ(report.at("nodes"), "3", "Nodes followed");
+        NS_TEST_EXPECT_MSG_GT(std::stod(report.at("sim_wall_ratio")), 0.0, "Ratio of " << i);
+        const uint64_t reportEvents = std::stoull(report.at("events"));
+        NS_TEST_EXPECT_MSG_GT(reportEvents, events, "Event count of report " << i);
+        events = reportEvents;
+    }
+    NS_TEST_ASSERT_MSG_NE(reports.back().at("pdr"), "null", "No PDR in the final report");
+    NS_TEST_EXPECT_MSG_EQ_TOL(std::stod(reports.back().at("pdr")),
+                              static_cast<double>(totals.delivered) / totals.txUnique,
+                              1e-5,
+                              "Final PDR differs from the collector's");
+}
+
+/**
+ * @brief Check the MAC state in the reports: a frame for a neighbour that never sends a
+ *        beacon keeps its sender in SENDER_MODE with the frame queued for the whole TX
+ *        wait; before it, no node is a sender and the queues are empty.
+ */
+class RitProgressReporterMacStateTest : public TestCase
+{
+  public:
+    RitProgressReporterMacStateTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitProgressReporterMacStateTest::RitProgressReporterMacStateTest()
+    : TestCase("Senders and TX queue depth in the progress reports")
+{
+}
+
+void
+RitProgressReporterMacStateTest::DoRun()
+{
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+    NodeContainer nodes;
+    std::vector<Ptr<RitWpanNetDevice>> devices;
+    for (uint16_t i = 0; i < 2; i++)
+    {
+        Ptr<Node> node = CreateObject<Node>();
+        Ptr<RitWpanNetDevice> device = CreateObject<RitWpanNetDevice>();
+        device->SetChannel(channel);
+        device->SetAddress(Mac16Address(i));
+        node->AddDevice(device);
+        device->SetRitRank(i);
+        device->AssignStreams(100 * i);
+        device->GetMac()->SetRitTimes(Seconds(1), MilliSeconds(10), Seconds(5));
+        nodes.Add(node);
+        devices.push_back(device);
+    }
+
+    const std::string path = CreateTempDirFilename("rit-progress-reporter-mac.jsonl");
+    Ptr<RitProgressReporter> reporter = Create<RitProgressReporter>();
+    reporter->SetInterval(Seconds(1));
+    reporter->SetOutput(path);
+    for (uint32_t i = 0; i < nodes.GetN(); i++)
+    {
+        reporter->Install(nodes.Get(i));
+    }
+    reporter->Start();
+
+    // No beacon of 00:09 ever comes: the frame waits until 7.5 s
+    Ptr<RitWpanNetDevice> sender = devices[1];
+    Simulator::ScheduleWithContext(sender->GetNode()->GetId(), Seconds(2.5), [sender]() {
+        sender->Send(Create<Packet>(20), Mac16Address("00:09"), 0);
+    });
+
+    Simulator::Stop(Seconds(4.5));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    const auto reports = ReadReports(path);
+    NS_TEST_ASSERT_MSG_EQ(reports.size(), 5, "Expected four reports and a final one");
+    for (size_t i = 0; i < reports.size(); i++)
+    {
+        const bool waiting = i >= 2;
+        NS_TEST_EXPECT_MSG_EQ(reports[i].at("nodes"), "2", "Nodes followed");
+        NS_TEST_EXPECT_MSG_EQ(reports[i].at("senders"),
+                              waiting ? "1" : "0",
+                              "Senders in report " << i);
+        NS_TEST_EXPECT_MSG_EQ_TOL(std::stod(reports[i].at("queue_depth")),
+                                  waiting ? 0.5 : 0.0,
+                                  1e-9,
+                                  "Mean TX queue depth in report " << i);
+        NS_TEST_EXPECT_MSG_EQ(reports[i].at("pdr"), "null", "PDR without a collector");
+    }
+}
+
+class RitProgressReporterTestSuite : public TestSuite
+{
+  public:
+    RitProgressReporterTestSuite();
+};
+
+RitProgressReporterTestSuite::RitProgressReporterTestSuite()
+    : TestSuite("rit-progress-reporter", Type::UNIT)
+{
+    AddTestCase(new RitProgressReporterReportTest, Duration::QUICK);
+    AddTestCase(new RitProgressReporterMacStateTest, Duration::QUICK);
+}
+
+static RitProgressReporterTestSuite g_ritProgressReporterTestSuite;
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/core-module.h>
+#include <ns3/realtime-simulator-impl.h>
+#include <ns3/rit-mac-timer-set.h>
+#include <ns3/rit-realtime-monitor.h>
+#include <ns3/test.h>
+
+#include <chrono>
+#include <sstream>
+#include <string>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-realtime-monitor-test");
+
+/**
+ * @brief Check that RitRealtimeMonitor measures the lateness of handlers against the
+ *        wall clock of RealtimeSimulatorImpl, counts the misses of their budgets, sees the
+ *        RIT MAC timers, and records nothing on the default simulator.
+ */
+class RitRealtimeMonitorLatenessTest : public TestCase
+{
+  public:
+    RitRealtimeMonitorLatenessTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Keep the CPU busy, as a handler over its budget would.
+     * @param duration Wall time to spend
+     */
+    static void BusyWait(std::chrono::microseconds duration);
+};
+
+RitRealtimeMonitorLatenessTest::RitRealtimeMonitorLatenessTest()
+    : TestCase("Lateness of the handlers against the real-time scheduler")
+{
+}
+
+void
+RitRealtimeMonitorLatenessTest::BusyWait(std::chrono::microseconds duration)
+{
+    const auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end)
+    {
+    }
+}
+
+void
+RitRealtimeMonitorLatenessTest::DoRun()
+{
+    RitRealtimeMonitor::Reset();
+    RitRealtimeMonitor::Enable();
+    const uint32_t late = RitRealtimeMonitor::RegisterHandler("test::Late", MilliSeconds(1));
+    const uint32_t onTime = RitRealtimeMonitor::RegisterHandler("test::OnTime", MilliSeconds(50));
+
+    // Default simulator: no wall clock to compare with
+    Simulator::Schedule(MilliSeconds(1), [late]() {
+        RitRealtimeMonitor::RecordLateness(late, Simulator::Now());
+    });
+    Simulator::Run();
+    Simulator::Destroy();
+    NS_TEST_EXPECT_MSG_EQ(RitRealtimeMonitor::GetCounters("test::Late").executed,
+                          0,
+                          "Lateness recorded without the real-time scheduler");
+
+    Simulator::SetImplementation(CreateObject<RealtimeSimulatorImpl>());
+    RitMacTimerSet timers(1);
+    uint32_t nExpired = 0;
+    timers.SetHandler(0, Callback<void>([&nExpired]() { nExpired++; }), "test::Timer");
+
+    // A handler busy for 5 ms makes the next one, due 1 ms later, about 4 ms late.
+    Simulator::Schedule(MilliSeconds(10), &BusyWait, std::chrono::microseconds(5000));
+    Simulator::Schedule(MilliSeconds(11), [late]() {
+        RitRealtimeMonitor::RecordLateness(late, Simulator::Now());
+    });
+    Simulator::Schedule(MilliSeconds(100), [onTime]() {
+        RitRealtimeMonitor::RecordLateness(onTime, Simulator::Now());
+    });
+    Simulator::Schedule(MilliSeconds(120), [&timers]() { timers.Schedule(0, MilliSeconds(5)); });
+    Simulator::Stop(MilliSeconds(150));
+    Simulator::Run();
+    timers.CancelAll();
+    Simulator::Destroy();
+
+    NS_TEST_EXPECT_MSG_EQ(nExpired, 1, "RIT MAC timer did not expire");
+
+    const RitRealtimeMonitor::Counters lateCounters =
+        RitRealtimeMonitor::GetCounters("test::Late");
+    NS_TEST_EXPECT_MSG_EQ(lateCounters.executed, 1, "Late handler not recorded");
+    NS_TEST_EXPECT_MSG_EQ(lateCounters.misses, 1, "Miss of the late handler not counted");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(lateCounters.maxLateness,
+                                MilliSeconds(3),
+                                "Lateness of the late handler underestimated");
+    const RitRealtimeMonitor::Counters onTimeCounters =
+        RitRealtimeMonitor::GetCounters("test::OnTime");
+    NS_TEST_EXPECT_MSG_EQ(onTimeCounters.executed, 1, "Handler on time not recorded");
+    NS_TEST_EXPECT_MSG_EQ(onTimeCounters.misses, 0, "Handler on time taken for a miss");
+    NS_TEST_EXPECT_MSG_EQ(RitRealtimeMonitor::GetCounters("test::Timer").executed,
+                          1,
+                          "RIT MAC timer not recorded");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(RitRealtimeMonitor::GetNMisses(), 1, "Misses not summed");
+
+    std::ostringstream table;
+    RitRealtimeMonitor::WriteTable(table);
+    NS_TEST_EXPECT_MSG_EQ(table.str().rfind("handler,executed,misses,mean_us,max_us,budget_us\n",
+                                            0) == 0,
+                          true,
+                          "Wrong table header");
+    NS_TEST_EXPECT_MSG_EQ(table.str().find("test::Late,1,1,") != std::string::npos,
+                          true,
+                          "Late handler missing from the table: " << table.str());
+
+    RitRealtimeMonitor::Disable();
+    RitRealtimeMonitor::Reset();
+}
+
+class RitRealtimeMonitorTestSuite : public TestSuite
+{
+  public:
+    RitRealtimeMonitorTestSuite();
+};
+
+RitRealtimeMonitorTestSuite::RitRealtimeMonitorTestSuite()
+    : TestSuite("rit-realtime-monitor", Type::UNIT)
+{
+    AddTestCase(new RitRealtimeMonitorLatenessTest, Duration::QUICK);
+}
+
+static RitRealtimeMonitorTestSuite g_ritRealtimeMonitorTestSuite;
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/core-module.h>
+#include <ns3/log.h>
+#include <ns3/network-module.h>
+#include <ns3/packet.h>
+#include <ns3/propagation-delay-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/rit-neighbour-table.h>
+#include <ns3/rit-run-arena.h>
+#include <ns3/rit-wpan-helper.h>
+#include <ns3/rit-wpan-mac.h>
+#include <ns3/rit-wpan-net-device.h>
+#include <ns3/single-model-spectrum-channel.h>
+
+#include <memory>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-run-arena-test");
+
+/**
+ * @brief Check that the tables created while the arena is enabled allocate from it, and
+ *        that it is released once they are gone after Disable().
+ */
+class RitRunArenaReleaseTest : public TestCase
+{
+  public:
+    RitRunArenaReleaseTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitRunArenaReleaseTest::RitRunArenaReleaseTest()
+    : TestCase("RitRunArena allocation and release")
+{
+}
+
+void
+RitRunArenaReleaseTest::DoRun()
+{
+    NS_TEST_ASSERT_MSG_EQ(RitRunArena::IsEnabled(), false, "Arena enabled by default");
+    NS_TEST_EXPECT_MSG_EQ(RitRunArena::GetResource(),
+                          std::pmr::new_delete_resource(),
+                          "Default resource is not the heap");
+    const uint64_t nReleases = RitRunArena::GetNReleases();
+
+    RitRunArena::Enable(4096);
+    NS_TEST_EXPECT_MSG_NE(RitRunArena::GetResource(),
+                          std::pmr::new_delete_resource(),
+                          "Enabled arena not handed out");
+    auto table = std::make_unique<RitNeighbourTable>(8);
+    for (uint16_t i = 1; i <= 8; i++)
+    {
+        table->NotifyBeacon(Mac16Address(i), 1, 200, Seconds(i));
+    }
+    NS_TEST_EXPECT_MSG_GT(RitRunArena::GetNLiveBlocks(), 0, "Table not allocated in the arena");
+    NS_TEST_EXPECT_MSG_GT(RitRunArena::GetNBytes(), 0, "No byte allocated in the arena");
+
+    RitRunArena::Disable();
+    NS_TEST_EXPECT_MSG_EQ(RitRunArena::GetResource(),
+                          std::pmr::new_delete_resource(),
+                          "Disabled arena still handed out");
+    NS_TEST_EXPECT_MSG_NE(table->Find(Mac16Address(8)), nullptr, "Entry lost");
+    NS_TEST_EXPECT_MSG_EQ(RitRunArena::GetNReleases(), nReleases, "Arena released in use");
+
+    table.reset();
+    NS_TEST_EXPECT_MSG_EQ(RitRunArena::GetNLiveBlocks(), 0, "Blocks left in the arena");
+    NS_TEST_EXPECT_MSG_EQ(RitRunArena::GetNReleases(), nReleases + 1, "Arena not released");
+    NS_TEST_EXPECT_MSG_EQ(RitRunArena::GetNBytes(), 0, "Bytes left after the release");
+}
+
+/**
+ * @brief Check that a network built in the arena runs as usual and that
+ *        RitWpanNetHelper::Destroy() ends the bulk teardown and the arena of the run.
+ */
+class RitRunArenaBulkTeardownTest : public TestCase
+{
+  public:
+    RitRunArenaBulkTeardownTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitRunArenaBulkTeardownTest::RitRunArenaBulkTeardownTest()
+    : TestCase("RitRunArena run and bulk teardown")
+{
+}
+
+void
+RitRunArenaBulkTeardownTest::DoRun()
+{
+    const uint32_t nPackets = 5;
+    RitRunArena::Enable();
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    Ptr<Node> sinkNode = CreateObject<Node>();
+    Ptr<RitWpanNetDevice> sink = CreateObject<RitWpanNetDevice>();
+    sink->SetChannel(channel);
+    sink->SetAddress(Mac16Address("00:00"));
+    sink->SetRitRank(0);
+    sinkNode->AddDevice(sink);
+
+    Ptr<Node> senderNode = CreateObject<Node>();
+    Ptr<RitWpanNetDevice> sender = CreateObject<RitWpanNetDevice>();
+    sender->SetChannel(channel);
+    sender->SetAddress(Mac16Address("00:01"));
+    sender->SetRitRank(1);
+    senderNode->AddDevice(sender);
+    NS_TEST_EXPECT_MSG_GT(RitRunArena::GetNLiveBlocks(), 0, "Devices not allocated in the arena");
+
+    Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+    pibAttr->macRitPeriodTime = Time(Seconds(1));
+    sink->GetMac()->MlmeSetRequest(macRitPeriodTime, pibAttr);
+    sender->GetMac()->MlmeSetRequest(macRitPeriodTime, pibAttr);
+
+    uint32_t nRx = 0;
+    sink->GetMac()->TraceConnectWithoutContext(
+        "MacRx",
+        Callback<void, Ptr<const Packet>>([&nRx](Ptr<const Packet>) { nRx++; }));
+
+    for (uint32_t k = 0; k < nPackets; k++)
+    {
+        Simulator::ScheduleWithContext(senderNode->GetId(), Seconds(2 + 2 * k), [=]() {
+            sender->Send(Create<Packet>(20), Mac16Address("00:00"), 0);
+        });
+    }
+    // A packet still queued when the run stops is left to the bulk teardown
+    Simulator::ScheduleWithContext(senderNode->GetId(), Seconds(14.9), [=]() {
+        sender->Send(Create<Packet>(20), Mac16Address("00:00"), 0);
+    });
+
+    Simulator::Stop(Seconds(15));
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(nRx, nPackets, "Data frames not received");
+
+    RitWpanNetHelper::Destroy();
+    NS_TEST_EXPECT_MSG_EQ(RitRunArena::IsBulkTeardown(), false, "Bulk teardown not ended");
+    NS_TEST_EXPECT_MSG_EQ(RitRunArena::IsEnabled(), false, "Arena of the run not disabled");
+}
+
+class RitRunArenaTestSuite : public TestSuite
+{
+  public:
+    RitRunArenaTestSuite();
+};
+
+RitRunArenaTestSuite::RitRunArenaTestSuite()
+    : TestSuite("rit-run-arena", Type::UNIT)
+{
+    AddTestCase(new RitRunArenaReleaseTest, Duration::QUICK);
+    AddTestCase(new RitRunArenaBulkTeardownTest, Duration::QUICK);
+}
+
+static RitRunArenaTestSuite g_ritRunArenaTestSuite;
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/core-module.h>
+#include <ns3/log.h>
+#include <ns3/lr-wpan-spectrum-channel.h>
+#include <ns3/lr-wpan-spectrum-signal-parameters.h>
+#include <ns3/lr-wpan-spectrum-value-helper.h>
+#include <ns3/packet-burst.h>
+#include <ns3/propagation-delay-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/rit-sender-registry.h>
+#include <ns3/spectrum-phy.h>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-sender-registry-test");
+
+/**
+ * @brief SpectrumPhy ignoring the signals, for the receiver lists of the channel.
+ */
+class RitSilentPhy : public SpectrumPhy
+{
+  public:
+    void SetDevice(Ptr<NetDevice> d) override
+    {
+    }
+
+    Ptr<NetDevice> GetDevice() const override
+    {
+        return nullptr;
+    }
+
+    void SetMobility(Ptr<MobilityModel> m) override
+    {
+        m_mobility = m;
+    }
+
+    Ptr<MobilityModel> GetMobility() const override
+    {
+        return m_mobility;
+    }
+
+    void SetChannel(Ptr<SpectrumChannel> c) override
+    {
+    }
+
+    Ptr<const SpectrumModel> GetRxSpectrumModel() const override
+    {
+        return nullptr;
+    }
+
+    Ptr<Object> GetAntenna() const override
+    {
+        return nullptr;
+    }
+
+    void StartRx(Ptr<SpectrumSignalParameters> params) override
+    {
+    }
+
+    Ptr<MobilityModel> m_mobility; //!< Mobility model
+};
+
+/**
+ * @brief Senders and reach of the RitSenderRegistry of a channel, through list builds,
+ *        moves and the disposal of the channel.
+ */
+class RitSenderRegistryTest : public TestCase
+{
+  public:
+    RitSenderRegistryTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitSenderRegistryTest::RitSenderRegistryTest()
+    : TestCase("RIT sender registry of a spectrum channel")
+{
+}
+
+void
+RitSenderRegistryTest::DoRun()
+{
+    Ptr<LrWpanSpectrumChannel> channel = CreateObject<LrWpanSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    // Two PHYs 10 m apart, a third 10 km off
+    std::vector<Ptr<RitSilentPhy>> phys;
+    std::vector<Ptr<ConstantPositionMobilityModel>> mobs;
+    for (double x : {0.0, 10.0, 10000.0})
+    {
+        Ptr<RitSilentPhy> phy = CreateObject<RitSilentPhy>();
+        Ptr<ConstantPositionMobilityModel> mob = CreateObject<ConstantPositionMobilityModel>();
+        mob->SetPosition(Vector(x, 0, 0));
+        phy->SetMobility(mob);
+        channel->AddRx(phy);
+        phys.push_back(phy);
+        mobs.push_back(mob);
+    }
+    LrWpanSpectrumValueHelper psdHelper;
+    auto transmit = [&](Ptr<RitSilentPhy> txPhy) {
+        Ptr<LrWpanSpectrumSignalParameters> txParams = Create<LrWpanSpectrumSignalParameters>();
+        txParams->duration = MilliSeconds(1);
+        txParams->txPhy = txPhy;
+        txParams->psd = psdHelper.CreateTxPowerSpectralDensity(0.0, 11);
+        txParams->packetBurst = Create<PacketBurst>();
+        channel->StartTx(txParams);
+        Simulator::Run();
+    };
+
+    Ptr<RitSenderRegistry> registry = RitSenderRegistry::Get(channel);
+    NS_TEST_ASSERT_MSG_EQ(RitSenderRegistry::Get(channel), registry, "Second registry");
+    NS_TEST_EXPECT_MSG_EQ(registry->HasUnlistedSenders(), false, "Unlisted sender");
+
+    // A sender that never transmitted may reach any PHY
+    registry->Add(phys[1]);
+    NS_TEST_EXPECT_MSG_EQ(registry->GetNSenders(), 1, "Sender not registered");
+    NS_TEST_EXPECT_MSG_EQ(registry->HasUnlistedSenders(), true, "Sender without list missed");
+    NS_TEST_EXPECT_MSG_EQ(registry->IsNearSender(phys[0]), false, "Reach without a list");
+
+    // Its first transmission builds the list the registry copies
+    transmit(phys[1]);
+    NS_TEST_EXPECT_MSG_EQ(registry->HasUnlistedSenders(), false, "List not copied");
+    NS_TEST_EXPECT_MSG_EQ(registry->IsNearSender(phys[1]), true, "Sender not near itself");
+    NS_TEST_EXPECT_MSG_EQ(registry->IsNearSender(phys[0]), true, "Listed PHY not near");
+    NS_TEST_EXPECT_MSG_EQ(registry->IsNearSender(phys[2]), false, "Far PHY near");
+
+    // A list built for another transmitter changes nothing
+    transmit(phys[2]);
+    NS_TEST_EXPECT_MSG_EQ(registry->IsNearSender(phys[0]), true, "Reach lost on a refresh");
+    NS_TEST_EXPECT_MSG_EQ(registry->IsNearSender(phys[2]), false, "Far PHY near");
+
+    // Registering twice counts once
+    registry->Add(phys[1]);
+    NS_TEST_EXPECT_MSG_EQ(registry->GetNSenders(), 1, "Sender registered twice");
+    registry->Remove(phys[1]);
+    NS_TEST_EXPECT_MSG_EQ(registry->GetNSenders(), 0, "Sender not removed");
+    NS_TEST_EXPECT_MSG_EQ(registry->IsNearSender(phys[0]), false, "Reach of a removed sender");
+
+    // A PHY moving into range of a sender is near it without a new transmission
+    registry->Add(phys[1]);
+    mobs[2]->SetPosition(Vector(10, 20, 0));
+    NS_TEST_EXPECT_MSG_EQ(registry->IsNearSender(phys[2]), true, "Moved PHY not near");
+
+    // The registry goes with its channel
+    channel->Dispose();
+    NS_TEST_EXPECT_MSG_EQ(registry->GetNSenders(), 0, "Senders kept past the channel");
+    registry->Remove(phys[1]);
+
+    Simulator::Destroy();
+}
+
+class RitSenderRegistryTestSuite : public TestSuite
+{
+  public:
+    RitSenderRegistryTestSuite();
+};
+
+RitSenderRegistryTestSuite::RitSenderRegistryTestSuite()
+    : TestSuite("rit-sender-registry", Type::UNIT)
+{
+    AddTestCase(new RitSenderRegistryTest, Duration::QUICK);
+}
+
+static RitSenderRegistryTestSuite g_ritSenderRegistryTestSuite;
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/log.h>
+#include <ns3/rit-steady-state-controller.h>
+#include <ns3/test.h>
+
+#include <cmath>
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-steady-state-test");
+
+/**
+ * @brief Check the MSER-5 truncation and the batch-means interval of
+ *        RitSteadyStateController on series with a known warm-up.
+ */
+class RitSteadyStateStatisticsTest : public TestCase
+{
+  public:
+    RitSteadyStateStatisticsTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitSteadyStateStatisticsTest::RitSteadyStateStatisticsTest()
+    : TestCase("MSER-5 truncation and batch means")
+{
+}
+
+void
+RitSteadyStateStatisticsTest::DoRun()
+{
+    // 40 warm-up observations, then a stationary alternation around 1
+    std::vector<double> y(40, 5.0);
+    for (int i = 0; i < 200; i++)
+    {
+        y.push_back(0.9);
+        y.push_back(1.1);
+    }
+    NS_TEST_EXPECT_MSG_EQ(RitSteadyStateController::MserTruncation(y), 40, "Wrong warm-up");
+
+    const std::vector<double> steady(y.begin() + 40, y.end());
+    double mean = 0.0;
+    double halfWidth = 0.0;
+    NS_TEST_ASSERT_MSG_EQ(RitSteadyStateController::BatchMeans(steady, 20, mean, halfWidth),
+                          true,
+                          "No interval");
+    NS_TEST_EXPECT_MSG_EQ_TOL(mean, 1.0, 1e-12, "Wrong mean");
+    NS_TEST_EXPECT_MSG_EQ_TOL(halfWidth, 0.0, 1e-12, "Batches of a period have no spread");
+
+    // Batches of unequal means: t(19) * s / sqrt(20)
+    std::vector<double> ramp;
+    for (int b = 0; b < 20; b++)
+    {
+        ramp.insert(ramp.end(), 10, b % 2 == 0 ? 0.5 : 1.5);
+    }
+    NS_TEST_ASSERT_MSG_EQ(RitSteadyStateController::BatchMeans(ramp, 20, mean, halfWidth),
+                          true,
+                          "No interval");
+    NS_TEST_EXPECT_MSG_EQ_TOL(mean, 1.0, 1e-12, "Wrong mean");
+    NS_TEST_EXPECT_MSG_EQ_TOL(halfWidth,
+                              2.093 * std::sqrt(20.0 * 0.25 / 19) / std::sqrt(20.0),
+                              1e-9,
+                              "Wrong half-width");
+    NS_TEST_EXPECT_MSG_EQ(RitSteadyStateController::BatchMeans(ramp, 400, mean, halfWidth),
+                          false,
+                          "Interval from fewer observations than batches");
+
+    // Still drifting: the minimum lies at the end of the search range
+    std::vector<double> drift;
+    for (int i = 0; i < 200; i++)
+    {
+        drift.push_back(100.0 - i);
+    }
+    NS_TEST_EXPECT_MSG_EQ(RitSteadyStateController::MserTruncation(drift),
+                          drift.size(),
+                          "Warm-up of a drifting series found over");
+}
+
+class RitSteadyStateTestSuite : public TestSuite
+{
+  public:
+    RitSteadyStateTestSuite();
+};
+
+RitSteadyStateTestSuite::RitSteadyStateTestSuite()
+    : TestSuite("rit-steady-state", Type::UNIT)
+{
+    AddTestCase(new RitSteadyStateStatisticsTest, Duration::QUICK);
+}
+
+static RitSteadyStateTestSuite g_ritSteadyStateTestSuite;
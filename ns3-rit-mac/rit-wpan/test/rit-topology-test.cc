@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/core-module.h>
+#include <ns3/log.h>
+#include <ns3/mobility-model.h>
+#include <ns3/network-module.h>
+#include <ns3/propagation-delay-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/rit-rank-helper.h>
+#include <ns3/rit-topology-helper.h>
+#include <ns3/rit-wpan-helper.h>
+#include <ns3/rit-wpan-net-device.h>
+#include <ns3/single-model-spectrum-channel.h>
+#include <ns3/test.h>
+
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-topology-test");
+
+/**
+ * @brief Check the node counts, bounds and spacing of the generated layouts.
+ */
+class RitTopologyGeneratorTest : public TestCase
+{
+  public:
+    RitTopologyGeneratorTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitTopologyGeneratorTest::RitTopologyGeneratorTest()
+    : TestCase("Random geometric, Poisson disc and clustered layouts")
+{
+}
+
+void
+RitTopologyGeneratorTest::DoRun()
+{
+    RitTopologyHelper topologyHelper;
+    topologyHelper.AssignStreams(1);
+    auto inside = [](const std::vector<Vector>& points, double width, double height) {
+        for (const auto& p : points)
+        {
+            if (p.x < 0 || p.x > width || p.y < 0 || p.y > height)
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    RitTopology random = topologyHelper.RandomGeometric(500, 300, 200);
+    NS_TEST_ASSERT_MSG_EQ(random.sinks.size(), 1, "One sink expected");
+    NS_TEST_ASSERT_MSG_EQ(random.routers.size(), 500, "Wrong number of routers");
+    NS_TEST_EXPECT_MSG_EQ(inside(random.routers, 300, 200), true, "Router outside the area");
+
+    RitTopology disc = topologyHelper.PoissonDisc(100, 400, 400, 20);
+    NS_TEST_ASSERT_MSG_EQ(disc.routers.size(), 100, "Wrong number of routers");
+    NS_TEST_EXPECT_MSG_EQ(inside(disc.routers, 400, 400), true, "Router outside the area");
+    std::vector<Vector> all(disc.routers);
+    all.push_back(disc.sinks[0]);
+    double closest = 1e9;
+    for (size_t i = 0; i < all.size(); i++)
+    {
+        for (size_t j = i + 1; j < all.size(); j++)
+        {
+            closest = std::min(closest, CalculateDistance(all[i], all[j]));
+        }
+    }
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(closest, 20.0, "Nodes closer than the minimum distance");
+
+    RitTopology clustered = topologyHelper.Clustered(90, 3, 500, 500, 25);
+    NS_TEST_ASSERT_MSG_EQ(clustered.routers.size(), 90, "Wrong number of routers");
+    NS_TEST_EXPECT_MSG_EQ(inside(clustered.routers, 500, 500), true, "Router outside the area");
+    // Routers i and i + 3 share a building
+    for (size_t i = 0; i + 3 < clustered.routers.size(); i++)
+    {
+        const double d = CalculateDistance(clustered.routers[i], clustered.routers[i + 3]);
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(d, 50.0, "Routers of one building too far apart");
+    }
+}
+
+/**
+ * @brief Check a layout read from a file and the static ranks computed on it from
+ *        the link range of the channel.
+ */
+class RitTopologyRankTest : public TestCase
+{
+  public:
+    RitTopologyRankTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitTopologyRankTest::RitTopologyRankTest()
+    : TestCase("Imported layout ranked over the link budget graph")
+{
+}
+
+void
+RitTopologyRankTest::DoRun()
+{
+    // A line of routers 60 m apart from the sink
+    const std::string path = CreateTempDirFilename("rit-topology.csv");
+    {
+        std::ofstream out(path);
+        out << "x,y,type\n# line layout\n0,0,sink\n";
+        for (uint32_t i = 1; i <= 5; i++)
+        {
+            out << 60 * i << ",0,router\n";
+        }
+        out << "\n";
+    }
+    const RitTopology topology = RitTopologyHelper::ReadCsv(path);
+    NS_TEST_ASSERT_MSG_EQ(topology.sinks.size(), 1, "Wrong number of sinks");
+    NS_TEST_ASSERT_MSG_EQ(topology.routers.size(), 5, "Wrong number of routers");
+    NS_TEST_EXPECT_MSG_EQ_TOL(topology.routers[4].x, 300.0, 1e-9, "Wrong position");
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    NodeContainer sinks;
+    NodeContainer routers;
+    sinks.Create(1);
+    routers.Create(5);
+    RitWpanNetHelper helper;
+    helper.SetChannel(channel);
+    helper.InstallSinks(sinks);
+    NetDeviceContainer devices = helper.Install(routers);
+
+    RitTopologyHelper topologyHelper;
+    topologyHelper.Install(topology, sinks, routers);
+    NS_TEST_EXPECT_MSG_EQ_TOL(routers.Get(2)->GetObject<MobilityModel>()->GetPosition().x,
+                              180.0,
+                              1e-9,
+                              "Position not installed");
+
+    // Log-distance loss 46.6777 dB at 1 m, exponent 3; 0 dBm and -106.58 dBm
+    const double range = RitTopologyHelper::GetLinkRange(
+        channel,
+        DynamicCast<RitWpanNetDevice>(devices.Get(0))->GetPhy());
+    NS_TEST_EXPECT_MSG_EQ_TOL(range,
+                              std::pow(10.0, (106.58 - 46.6777) / 30),
+                              0.01,
+                              "Wrong link range");
+
+    RitWpanRankHelper rankHelper;
+    rankHelper.Install(routers, sinks, range);
+    // 60 m hops, ~99 m range: one hop per router
+    for (uint32_t i = 0; i < devices.GetN(); i++)
+    {
+        Ptr<RitWpanNetDevice> dev = DynamicCast<RitWpanNetDevice>(devices.Get(i));
+        NS_TEST_EXPECT_MSG_EQ(static_cast<uint32_t>(dev->GetRitRank()),
+                              i + 1,
+                              "Wrong rank of router " << i);
+    }
+
+    Simulator::Destroy();
+}
+
+class RitTopologyTestSuite : public TestSuite
+{
+  public:
+    RitTopologyTestSuite();
+};
+
+RitTopologyTestSuite::RitTopologyTestSuite()
+    : TestSuite("rit-topology", Type::UNIT)
+{
+    AddTestCase(new RitTopologyGeneratorTest, Duration::QUICK);
+    AddTestCase(new RitTopologyRankTest, Duration::QUICK);
+}
+
+static RitTopologyTestSuite g_ritTopologyTestSuite;
@@ -0,0 +1,348 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/core-module.h>
+#include <ns3/log.h>
+#include <ns3/lr-wpan-mac-header.h>
+#include <ns3/network-module.h>
+#include <ns3/periodic-sender-helper.h>
+#include <ns3/rit-trace-filter.h>
+#include <ns3/rit-trace-writer.h>
+#include <ns3/rit-wpan-helper.h>
+#include <ns3/rit-wpan-net-device.h>
+#include <ns3/test.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-trace-filter-test");
+
+namespace
+{
+
+/**
+ * @param text Text of a log
+ * @return its lines
+ */
+std::vector<std::string>
+SplitLines(const std::string& text)
+{
+    std::vector<std::string> lines;
+    std::istringstream in(text);
+    for (std::string line; std::getline(in, line);)
+    {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+/**
+ * @param path A text file
+ * @return its lines
+ */
+std::vector<std::string>
+ReadLines(const std::string& path)
+{
+    std::ifstream in(path);
+    std::ostringstream text;
+    text << in.rdbuf();
+    return SplitLines(text.str());
+}
+
+/**
+ * @param seconds Event time [s]
+ * @param frameType Frame type as RitTraceRecord::arg
+ * @return a MAC TX record with a header
+ */
+RitTraceRecord
+MacTxRecord(uint32_t seconds, uint8_t frameType)
+{
+    RitTraceRecord rec{};
+    rec.timeNs = Seconds(seconds).GetNanoSeconds();
+    rec.event = RIT_TRACE_EV_TX;
+    rec.arg = frameType;
+    rec.flags = RIT_TRACE_FLAG_HAS_HEADER;
+    return rec;
+}
+
+} // namespace
+
+/**
+ * @brief Check the family and node selection of RitTraceFilter and the per-record filter of
+ *        the binary traces: time windows, and RIT Data Requests sampled apart from the data
+ *        frames of mac-txlog only.
+ */
+class RitTraceFilterRecordTest : public TestCase
+{
+  public:
+    RitTraceFilterRecordTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitTraceFilterRecordTest::RitTraceFilterRecordTest()
+    : TestCase("RitTraceFilter families, nodes, windows and record sampling")
+{
+}
+
+void
+RitTraceFilterRecordTest::DoRun()
+{
+    NS_TEST_EXPECT_MSG_EQ(RitTraceFamilyFromLogName("mac-txlog.csv"),
+                          RIT_TRACE_FAMILY_MAC_TX,
+                          "Family of mac-txlog");
+    NS_TEST_EXPECT_MSG_EQ(RitTraceFamilyFromLogName("app-hoplatency.csv"),
+                          RIT_TRACE_FAMILY_APP,
+                          "Family of app-hoplatency");
+    NS_TEST_EXPECT_MSG_EQ(RitTraceFamilyFromLogName("custom.csv"),
+                          RIT_TRACE_FAMILY_NONE,
+                          "Family of an unknown log");
+
+    RitTraceFilter filter;
+    NS_TEST_EXPECT_MSG_EQ(filter.IsFamilyEnabled(RIT_TRACE_FAMILY_ENERGY), true, "Default");
+    NS_TEST_EXPECT_MSG_EQ(filter.HasRecordRules(RIT_TRACE_FAMILY_MAC_TX), false, "Default");
+    filter.SetFamilies(RIT_TRACE_FAMILY_MAC_TX | RIT_TRACE_FAMILY_PHY_DUTY_CYCLE);
+    NS_TEST_EXPECT_MSG_EQ(filter.IsFamilyEnabled(RIT_TRACE_FAMILY_MAC_TX), true, "MAC TX");
+    NS_TEST_EXPECT_MSG_EQ(filter.IsFamilyEnabled(RIT_TRACE_FAMILY_MAC_RX), false, "MAC RX");
+    NS_TEST_EXPECT_MSG_EQ(filter.IsFamilyEnabled(RIT_TRACE_FAMILY_NONE), true, "Unknown log");
+
+    // Node selection by rank, read from the devices
+    NodeContainer nodes;
+    nodes.Create(3);
+    RitWpanNetHelper helper;
+    NetDeviceContainer devices = helper.Install(nodes);
+    for (uint32_t i = 0; i < devices.GetN(); i++)
+    {
+        DynamicCast<RitWpanNetDevice>(devices.Get(i))->SetRitRank(i);
+    }
+    NS_TEST_EXPECT_MSG_EQ(filter.IsNodeSelected(nodes.Get(2)), true, "No predicate");
+    filter.SetMaxRank(1);
+    NS_TEST_EXPECT_MSG_EQ(filter.IsNodeSelected(nodes.Get(0)), true, "Rank 0");
+    NS_TEST_EXPECT_MSG_EQ(filter.IsNodeSelected(nodes.Get(1)), true, "Rank 1");
+    NS_TEST_EXPECT_MSG_EQ(filter.IsNodeSelected(nodes.Get(2)), false, "Rank 2");
+    NS_TEST_EXPECT_MSG_EQ(filter.IsNodeSelected(CreateObject<Node>()), false, "No RIT device");
+
+    filter.SetRitDataRequestSampling(3);
+    NS_TEST_EXPECT_MSG_EQ(filter.HasRecordRules(RIT_TRACE_FAMILY_MAC_TX), true, "RDR sampling");
+    NS_TEST_EXPECT_MSG_EQ(filter.HasRecordRules(RIT_TRACE_FAMILY_MAC_RX), false, "MAC RX rules");
+    filter.AddTimeWindow(Seconds(10), Seconds(20));
+    NS_TEST_EXPECT_MSG_EQ(filter.HasRecordRules(RIT_TRACE_FAMILY_MAC_RX), true, "Window");
+    NS_TEST_EXPECT_MSG_EQ(filter.HasRecordRules(RIT_TRACE_FAMILY_PHY_DUTY_CYCLE),
+                          false,
+                          "Duty-cycle snapshots filtered");
+    NS_TEST_EXPECT_MSG_EQ(filter.IsInWindow(Seconds(10)), true, "Window start");
+    NS_TEST_EXPECT_MSG_EQ(filter.IsInWindow(Seconds(20)), false, "Window stop");
+
+    // One RIT Data Request and one data frame per second over 30 s
+    auto macTx = filter.MakeRecordFilter(RIT_TRACE_FAMILY_MAC_TX);
+    auto macRx = filter.MakeRecordFilter(RIT_TRACE_FAMILY_MAC_RX);
+    for (uint32_t t = 0; t < 30; t++)
+    {
+        const bool inWindow = t >= 10 && t < 20;
+        const RitTraceRecord rdr = MacTxRecord(t, LrWpanMacHeader::LRWPAN_MAC_COMMAND);
+        const RitTraceRecord data = MacTxRecord(t, LrWpanMacHeader::LRWPAN_MAC_DATA);
+        NS_TEST_EXPECT_MSG_EQ(macTx(rdr), inWindow && (t - 10) % 3 == 0, "RDR at " << t);
+        NS_TEST_EXPECT_MSG_EQ(macTx(data), inWindow, "Data frame at " << t);
+        NS_TEST_EXPECT_MSG_EQ(macRx(rdr), inWindow, "Command received at " << t);
+    }
+
+    // Each predicate counts on its own: the first RDR of a new writer is kept
+    auto other = filter.MakeRecordFilter(RIT_TRACE_FAMILY_MAC_TX);
+    NS_TEST_EXPECT_MSG_EQ(other(MacTxRecord(11, LrWpanMacHeader::LRWPAN_MAC_COMMAND)),
+                          true,
+                          "Counters shared between writers");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @brief Check the ASCII line filter: lines dropped outside the windows (simulation time),
+ *        one line in N kept per event with the first one, RIT Data Requests of mac-txlog
+ *        sampled on their own, and an unterminated line forwarded by Flush().
+ */
+class RitFilteredTraceStreamTest : public TestCase
+{
+  public:
+    RitFilteredTraceStreamTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitFilteredTraceStreamTest::RitFilteredTraceStreamTest()
+    : TestCase("RitFilteredTraceStream windows, sampling and partial lines")
+{
+}
+
+void
+RitFilteredTraceStreamTest::DoRun()
+{
+    RitTraceFilter filter;
+    filter.AddTimeWindow(Seconds(10), Seconds(20));
+    filter.SetSampling(RIT_TRACE_FAMILY_MAC_TX, 2);
+    filter.SetRitDataRequestSampling(3);
+
+    std::ostringstream out;
+    Ptr<RitFilteredTraceStream> filtered =
+        Create<RitFilteredTraceStream>(filter,
+                                       RIT_TRACE_FAMILY_MAC_TX,
+                                       Create<OutputStreamWrapper>(&out));
+    Ptr<OutputStreamWrapper> stream = filtered->GetStream();
+
+    std::vector<std::string> expected;
+    for (uint32_t t = 0; t < 30; t++)
+    {
+        const std::string time = std::to_string(t);
+        Simulator::Schedule(Seconds(t), [stream, time]() {
+            *stream->GetStream() << time << ",Tx,Command,00:01,ff:ff\n"
+                                 << time << ",Tx,Data,00:01,00:00" << std::endl;
+            *stream->GetStream() << time << ",TxOk,Data,00:01,00:00" << std::endl;
+        });
+        if (t < 10 || t >= 20)
+        {
+            continue;
+        }
+        if ((t - 10) % 3 == 0)
+        {
+            expected.push_back(time + ",Tx,Command,00:01,ff:ff");
+        }
+        if ((t - 10) % 2 == 0)
+        {
+            expected.push_back(time + ",Tx,Data,00:01,00:00");
+            expected.push_back(time + ",TxOk,Data,00:01,00:00");
+        }
+    }
+    // Unterminated line, checked at the time of the flush
+    Simulator::Schedule(Seconds(15.5),
+                        [stream]() { *stream->GetStream() << "15.5,TxDrop,Data,00:01,00:00"; });
+    Simulator::Schedule(Seconds(15.6), &RitFilteredTraceStream::Flush, filtered);
+    expected.insert(expected.begin() + 8, "15.5,TxDrop,Data,00:01,00:00");
+
+    Simulator::Run();
+    Simulator::Destroy();
+
+    const std::vector<std::string> lines = SplitLines(out.str());
+    NS_TEST_ASSERT_MSG_EQ(lines.size(), expected.size(), "Bad number of kept lines");
+    for (size_t i = 0; i < lines.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(lines[i], expected[i], "Kept line " << i + 1 << " differs");
+    }
+}
+
+/**
+ * @brief Run a small network with a trace filter set on the helper and check the logs
+ *        written: none for the disabled families and the unselected nodes, only the window
+ *        in mac-txlog, and the whole run in the duty-cycle snapshots.
+ */
+class RitTraceFilterHelperTest : public TestCase
+{
+  public:
+    RitTraceFilterHelperTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitTraceFilterHelperTest::RitTraceFilterHelperTest()
+    : TestCase("RitWpanNetHelper::SetTraceFilter() on the per-node logs")
+{
+}
+
+void
+RitTraceFilterHelperTest::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(3);
+    RitWpanNetHelper helper;
+    helper.SetMacRitPeriod(Seconds(1));
+    helper.SetMacRitDataWaitDuration(MilliSeconds(10));
+    helper.SetMacRitTxWaitDuration(Seconds(5));
+    NetDeviceContainer devices = helper.Install(nodes);
+    for (uint32_t i = 0; i < devices.GetN(); i++)
+    {
+        Ptr<RitWpanNetDevice> dev = DynamicCast<RitWpanNetDevice>(devices.Get(i));
+        dev->SetAddress(Mac16Address(static_cast<uint16_t>(i)));
+        dev->SetRitRank(i);
+    }
+
+    PeriodicSenderHelper sinkApp;
+    sinkApp.SetReceiveOnly(true);
+    sinkApp.Install(nodes.Get(0));
+    PeriodicSenderHelper senderApp;
+    senderApp.SetPeriod(Seconds(2));
+    senderApp.SetPacketSize(20);
+    senderApp.SetDstAddr(Mac16Address("00:00"));
+    senderApp.Install(nodes.Get(1));
+
+    RitTraceFilter filter;
+    filter.SetFamilies(RIT_TRACE_FAMILY_MAC_TX | RIT_TRACE_FAMILY_PHY_DUTY_CYCLE);
+    filter.SetMaxRank(1);
+    filter.AddTimeWindow(Seconds(10), Seconds(30));
+    helper.SetTraceFilter(filter);
+    helper.SetPhyDutyCycleSnapshotInterval(Seconds(5));
+
+    const std::string baseDir = CreateTempDirFilename("rit-trace-filter/");
+    helper.EnableMacTxTracePerNode(nodes, baseDir);
+    helper.EnableMacRxTracePerNode(nodes, baseDir);
+    helper.EnablePhyDutyCycleTracePerNode(nodes, baseDir);
+
+    Simulator::Stop(Seconds(40));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    for (uint32_t i = 0; i < nodes.GetN(); i++)
+    {
+        const std::string nodeDir = baseDir + "node-" + std::to_string(i) + "/";
+        const bool selected = i < 2;
+        NS_TEST_EXPECT_MSG_EQ(std::filesystem::exists(nodeDir + "mac-txlog.csv"),
+                              selected,
+                              "mac-txlog of node " << i);
+        NS_TEST_EXPECT_MSG_EQ(std::filesystem::exists(nodeDir + "mac-rxlog.csv"),
+                              false,
+                              "mac-rxlog of node " << i);
+    }
+
+    const std::vector<std::string> macTx = ReadLines(baseDir + "node-1/mac-txlog.csv");
+    NS_TEST_ASSERT_MSG_GT(macTx.size(), 0, "Nothing sent in the window");
+    for (const std::string& line : macTx)
+    {
+        const double time = std::stod(line.substr(0, line.find(',')));
+        NS_TEST_EXPECT_MSG_GT_OR_EQ(time, 10.0, "Line before the window: " << line);
+        NS_TEST_EXPECT_MSG_LT(time, 30.0, "Line after the window: " << line);
+    }
+
+    // Cumulative snapshots are never filtered: 5 s, 10 s, ..., 40 s
+    const std::vector<std::string> duty = ReadLines(baseDir + "node-1/phy-dutycycle.csv");
+    NS_TEST_ASSERT_MSG_GT(duty.size(), 0, "No duty-cycle snapshot");
+    NS_TEST_EXPECT_MSG_EQ(std::stod(duty.front().substr(0, duty.front().find(','))),
+                          5.0,
+                          "Snapshot before the window dropped");
+}
+
+class RitTraceFilterTestSuite : public TestSuite
+{
+  public:
+    RitTraceFilterTestSuite();
+};
+
+RitTraceFilterTestSuite::RitTraceFilterTestSuite()
+    : TestSuite("rit-trace-filter", Type::UNIT)
+{
+    AddTestCase(new RitTraceFilterRecordTest, Duration::QUICK);
+    AddTestCase(new RitFilteredTraceStreamTest, Duration::QUICK);
+    AddTestCase(new RitTraceFilterHelperTest, Duration::QUICK);
+}
+
+static RitTraceFilterTestSuite g_ritTraceFilterTestSuite;
@@ -0,0 +1,806 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/core-module.h>
+#include <ns3/log.h>
+#include <ns3/lr-wpan-mac.h>
+#include <ns3/mobility-module.h>
+#include <ns3/network-module.h>
+#include <ns3/periodic-sender-helper.h>
+#include <ns3/rit-async-trace-writer.h>
+#include <ns3/rit-rank-helper.h>
+#include <ns3/rit-trace-mux.h>
+#include <ns3/rit-trace-writer.h>
+#include <ns3/rit-wpan-helper.h>
+#include <ns3/test.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-trace-writer-test");
+
+namespace
+{
+
+constexpr uint32_t BUFFER_RECORDS = 3; //!< Binary trace buffer, small enough to wrap often
+constexpr double SIM_TIME_SEC = 120;   //!< Simulated time of the trace scenario
+
+/// Logs compared between the ASCII and the binary run
+const std::vector<std::string> COMPARED_LOGS = {"mac-statelog", "nwk-txlog", "nwk-rxlog"};
+
+/**
+ * @param baseDir A trace directory
+ * @param nodeId A node id
+ * @param logName A log file name
+ * @return the path RitWpanNetHelper writes the log of that node to
+ */
+std::string
+NodeLogPath(const std::string& baseDir, uint32_t nodeId, const std::string& logName)
+{
+    return baseDir + "node-" + std::to_string(nodeId) + "/" + logName;
+}
+
+/**
+ * @param path A text file
+ * @return its lines
+ */
+std::vector<std::string>
+ReadLines(const std::string& path)
+{
+    std::vector<std::string> lines;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line))
+    {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+/**
+ * @param line A CSV line
+ * @return its fields
+ */
+std::vector<std::string>
+SplitFields(const std::string& line)
+{
+    std::vector<std::string> fields;
+    std::istringstream in(line);
+    std::string field;
+    while (std::getline(in, field, ','))
+    {
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+/**
+ * @param path A binary trace file
+ * @param header The file header read
+ * @param records The records read
+ * @return false if the file is missing or shorter than its header
+ */
+bool
+ReadRecords(const std::string& path,
+            RitTraceFileHeader& header,
+            std::vector<RitTraceRecord>& records)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)))
+    {
+        return false;
+    }
+    RitTraceRecord rec;
+    while (in.read(reinterpret_cast<char*>(&rec), sizeof(rec)))
+    {
+        records.push_back(rec);
+    }
+    return true;
+}
+
+/**
+ * @param rec A record
+ * @return its time as the ASCII sinks print it
+ */
+std::string
+FormatTime(const RitTraceRecord& rec)
+{
+    std::ostringstream os;
+    os << NanoSeconds(rec.timeNs).GetSeconds();
+    return os.str();
+}
+
+/**
+ * @param addr A short address as stored in a record
+ * @return the address as Mac16Address prints it
+ */
+std::string
+FormatShortAddr(uint64_t addr)
+{
+    std::ostringstream os;
+    os << std::hex << std::setfill('0') << std::setw(2) << ((addr >> 8) & 0xFF) << ":"
+       << std::setw(2) << (addr & 0xFF);
+    return os.str();
+}
+
+/**
+ * @param event A NWK record event
+ * @return the event name of the ASCII NWK logs
+ */
+std::string
+FormatNwkEvent(uint8_t event)
+{
+    switch (event)
+    {
+    case RIT_TRACE_EV_TX:
+        return "Tx";
+    case RIT_TRACE_EV_TX_OK:
+        return "TxOk";
+    case RIT_TRACE_EV_TX_DROP:
+        return "TxDrop";
+    case RIT_TRACE_EV_RE_TX:
+        return "ReTx";
+    case RIT_TRACE_EV_RX_OK:
+        return "RxOk";
+    case RIT_TRACE_EV_RX_DROP:
+        return "RxDrop";
+    default:
+        return "?";
+    }
+}
+
+/**
+ * @brief Build the small fixed-seed network of the trace tests, one sink and three routers
+ *        in a line, and enable its MAC state and NWK traces. The caller runs it.
+ * @param format The trace format
+ * @param shards Consolidated trace files (0 for per-node files)
+ * @param baseDir The trace directory
+ * @param asyncRing Ring of the async binary writer (0 writes from the simulator thread)
+ * @return the ids of the nodes traced
+ */
+std::vector<uint32_t>
+SetUpTraceScenario(RitTraceFormat format,
+                   uint32_t shards,
+                   const std::string& baseDir,
+                   uint32_t asyncRing = 0)
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    NodeContainer sinks;
+    NodeContainer routers;
+    sinks.Create(1);
+    routers.Create(3);
+    NodeContainer allNodes(sinks, routers);
+
+    RitWpanNetHelper helper;
+    helper.SetMacRitDataWaitDuration(MilliSeconds(10));
+    helper.SetMacRitTxWaitDuration(MilliSeconds(5000));
+    helper.SetMacRitPeriod(MilliSeconds(1000));
+    helper.SetRxAlwaysOn(true);
+    helper.InstallSinks(sinks);
+    helper.SetRxAlwaysOn(false);
+    helper.Install(routers);
+
+    // A line of routers below the sink, 70 m apart
+    auto positionAlloc = CreateObject<ListPositionAllocator>();
+    positionAlloc->Add(Vector(0.0, 0.0, 0.0));
+    for (uint32_t i = 0; i < routers.GetN(); i++)
+    {
+        positionAlloc->Add(Vector(0.0, 70.0 * (i + 1), 0.0));
+    }
+    MobilityHelper mob;
+    mob.SetPositionAllocator(positionAlloc);
+    mob.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mob.Install(allNodes);
+    RitWpanRankHelper rankHelper;
+    rankHelper.Install(routers, 1);
+
+    const int64_t appStream = helper.AssignStreams(allNodes, 0);
+    PeriodicSenderHelper routerApp;
+    routerApp.SetPeriod(Seconds(10));
+    routerApp.SetPacketSize(8);
+    routerApp.SetDstAddr(Mac16Address("00:00"));
+    routerApp.Install(routers);
+    routerApp.AssignStreams(routers, appStream);
+    PeriodicSenderHelper sinkApp;
+    sinkApp.SetReceiveOnly(true);
+    sinkApp.Install(sinks);
+    sinkApp.AssignStreams(sinks, appStream);
+
+    helper.SetTraceFormat(format);
+    helper.EnableConsolidatedTraces(shards);
+    if (asyncRing > 0)
+    {
+        helper.EnableAsyncTraceWriter(asyncRing, RitAsyncTraceWriter::BLOCK);
+    }
+    helper.SetBinaryTraceBufferSize(BUFFER_RECORDS);
+    helper.EnableMacStateTracePerNode(allNodes, baseDir);
+    helper.EnableNwkTxTracePerNode(allNodes, baseDir);
+    helper.EnableNwkRxTracePerNode(allNodes, baseDir);
+
+    std::vector<uint32_t> nodeIds;
+    for (uint32_t i = 0; i < allNodes.GetN(); i++)
+    {
+        nodeIds.push_back(allNodes.Get(i)->GetId());
+    }
+    return nodeIds;
+}
+
+} // namespace
+
+/**
+ * @brief Run the same small fixed-seed network with the ASCII and with the binary traces,
+ *        the latter with a buffer of a few records, and check that the decoded records
+ *        match the ASCII lines field by field.
+ *
+ * Before Simulator::Destroy() the binary files must only hold whole buffer blocks; the
+ * records still buffered must reach the disk through the Flush() scheduled at destroy.
+ */
+class RitBinaryTraceAsciiTest : public TestCase
+{
+  public:
+    RitBinaryTraceAsciiTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Build and run the network with traces under a directory.
+     * @param format The trace format
+     * @param baseDir The trace directory
+     * @return the ids of the nodes traced
+     */
+    std::vector<uint32_t> RunScenario(RitTraceFormat format, const std::string& baseDir);
+
+    /**
+     * @brief Compare a binary log with the ASCII log of the same events.
+     * @param binPath The binary file
+     * @param csvPath The ASCII file
+     * @param logName The log name without its extension
+     * @param nodeId The node the log belongs to
+     */
+    void CompareLog(const std::string& binPath,
+                    const std::string& csvPath,
+                    const std::string& logName,
+                    uint32_t nodeId);
+
+    bool m_uidOffsetSet = false;   //!< Whether m_uidOffset was taken from a record
+    int64_t m_uidOffset = 0;       //!< Packet uid shift of the second run (uids are global)
+    uint64_t m_recordsChecked = 0; //!< Records compared so far
+};
+
+RitBinaryTraceAsciiTest::RitBinaryTraceAsciiTest()
+    : TestCase("Binary trace records decode to the ASCII trace lines")
+{
+}
+
+std::vector<uint32_t>
+RitBinaryTraceAsciiTest::RunScenario(RitTraceFormat format, const std::string& baseDir)
+{
+    const std::vector<uint32_t> nodeIds = SetUpTraceScenario(format, 0, baseDir);
+    Simulator::Stop(Seconds(SIM_TIME_SEC));
+    Simulator::Run();
+
+    if (format != RitTraceFormat::BINARY)
+    {
+        Simulator::Destroy();
+        return nodeIds;
+    }
+
+    // Only whole blocks are written while the run is alive
+    const uint64_t blockBytes = BUFFER_RECORDS * sizeof(RitTraceRecord);
+    std::vector<uint64_t> sizesBefore;
+    bool wrapped = false;
+    for (uint32_t nodeId : nodeIds)
+    {
+        for (const auto& log : COMPARED_LOGS)
+        {
+            const std::string path = NodeLogPath(baseDir, nodeId, log + ".bin");
+            const uint64_t size = std::filesystem::file_size(path);
+            sizesBefore.push_back(size);
+            if (size == 0)
+            {
+                continue;
+            }
+            NS_TEST_EXPECT_MSG_EQ((size - sizeof(RitTraceFileHeader)) % blockBytes,
+                                  0,
+                                  path << " holds a partial block before destroy");
+            wrapped |= size > sizeof(RitTraceFileHeader) + blockBytes;
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(wrapped, true, "No binary trace buffer was written more than once");
+
+    Simulator::Destroy();
+
+    // The records left in the buffers reach the disk through Flush() at destroy
+    bool flushedAtDestroy = false;
+    size_t i = 0;
+    for (uint32_t nodeId : nodeIds)
+    {
+        for (const auto& log : COMPARED_LOGS)
+        {
+            const std::string path = NodeLogPath(baseDir, nodeId, log + ".bin");
+            const uint64_t size = std::filesystem::file_size(path);
+            flushedAtDestroy |= size > sizesBefore[i++];
+            if (size == 0)
+            {
+                // An empty log whose writer still buffers its header
+                continue;
+            }
+            NS_TEST_EXPECT_MSG_EQ((size - sizeof(RitTraceFileHeader)) % sizeof(RitTraceRecord),
+                                  0,
+                                  path << " holds a partial record");
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(flushedAtDestroy, true, "No record was left for the flush at destroy");
+    return nodeIds;
+}
+
+void
+RitBinaryTraceAsciiTest::CompareLog(const std::string& binPath,
+                                    const std::string& csvPath,
+                                    const std::string& logName,
+                                    uint32_t nodeId)
+{
+    RitTraceFileHeader header;
+    std::vector<RitTraceRecord> records;
+    const std::vector<std::string> lines = ReadLines(csvPath);
+    if (!ReadRecords(binPath, header, records))
+    {
+        NS_TEST_EXPECT_MSG_EQ(lines.size(), 0, binPath << " lost the events of " << csvPath);
+        return;
+    }
+    NS_TEST_EXPECT_MSG_EQ(std::string(header.magic, 4), "RITT", "Bad magic in " << binPath);
+    NS_TEST_EXPECT_MSG_EQ(header.version, RitBinaryTraceWriter::FORMAT_VERSION, "Bad version");
+    NS_TEST_EXPECT_MSG_EQ(header.recordSize, sizeof(RitTraceRecord), "Bad record size");
+    NS_TEST_EXPECT_MSG_EQ(header.nodeId, nodeId, "Bad node id in " << binPath);
+    NS_TEST_ASSERT_MSG_EQ(records.size(),
+                          lines.size(),
+                          binPath << " and " << csvPath << " hold a different number of events");
+
+    for (size_t i = 0; i < records.size(); i++)
+    {
+        const RitTraceRecord& rec = records[i];
+        const std::vector<std::string> fields = SplitFields(lines[i]);
+        const std::string where = csvPath + ":" + std::to_string(i + 1);
+        NS_TEST_EXPECT_MSG_EQ(rec.nodeId, nodeId, "Bad node id at " << where);
+        NS_TEST_ASSERT_MSG_GT(fields.size(), 1, "Short line at " << where);
+        NS_TEST_EXPECT_MSG_EQ(FormatTime(rec), fields[0], "Time differs at " << where);
+
+        if (logName == "mac-statelog")
+        {
+            NS_TEST_ASSERT_MSG_EQ(fields.size(), 2, "Bad MAC state line at " << where);
+            std::ostringstream state;
+            state << static_cast<MacState>(rec.arg);
+            NS_TEST_EXPECT_MSG_EQ(state.str(), fields[1], "MAC state differs at " << where);
+        }
+        else
+        {
+            NS_TEST_ASSERT_MSG_EQ(fields.size(), 5, "Bad NWK line at " << where);
+            NS_TEST_EXPECT_MSG_EQ(FormatNwkEvent(rec.event), fields[1], "Event at " << where);
+            NS_TEST_EXPECT_MSG_EQ(rec.flags & RIT_TRACE_FLAG_HAS_HEADER,
+                                  RIT_TRACE_FLAG_HAS_HEADER,
+                                  "NWK record without its header at " << where);
+            NS_TEST_EXPECT_MSG_EQ(FormatShortAddr(rec.src), fields[2], "Source at " << where);
+            NS_TEST_EXPECT_MSG_EQ(FormatShortAddr(rec.dst), fields[3], "Dest at " << where);
+            const int64_t offset = static_cast<int64_t>(std::stoull(fields[4])) -
+                                   static_cast<int64_t>(rec.uid);
+            if (!m_uidOffsetSet)
+            {
+                m_uidOffset = offset;
+                m_uidOffsetSet = true;
+            }
+            NS_TEST_EXPECT_MSG_EQ(offset, m_uidOffset, "Packet uid differs at " << where);
+        }
+        m_recordsChecked++;
+    }
+}
+
+void
+RitBinaryTraceAsciiTest::DoRun()
+{
+    const std::string binDir = CreateTempDirFilename("rit-trace-writer-bin/");
+    const std::string csvDir = CreateTempDirFilename("rit-trace-writer-csv/");
+
+    // The ASCII run comes second, so its packet uids are shifted by the first run
+    const std::vector<uint32_t> binNodes = RunScenario(RitTraceFormat::BINARY, binDir);
+    const std::vector<uint32_t> csvNodes = RunScenario(RitTraceFormat::ASCII, csvDir);
+    NS_TEST_ASSERT_MSG_EQ(binNodes == csvNodes, true, "The runs traced different nodes");
+
+    for (uint32_t nodeId : binNodes)
+    {
+        for (const auto& log : COMPARED_LOGS)
+        {
+            CompareLog(NodeLogPath(binDir, nodeId, log + ".bin"),
+                       NodeLogPath(csvDir, nodeId, log + ".csv"),
+                       log,
+                       nodeId);
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(m_uidOffsetSet, true, "No NWK event was traced");
+    NS_TEST_EXPECT_MSG_GT(m_recordsChecked,
+                          BUFFER_RECORDS * binNodes.size(),
+                          "Too few records compared");
+}
+
+/**
+ * @brief Check the line tagging of RitTraceMux: whole lines keep the order they were
+ *        completed in, several lines of one write are split, per-line flushes do not
+ *        reach the disk, Close() emits the unterminated lines and drops later writes.
+ */
+class RitTraceMuxLineTest : public TestCase
+{
+  public:
+    RitTraceMuxLineTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitTraceMuxLineTest::RitTraceMuxLineTest()
+    : TestCase("RitTraceMux tags, orders and closes the lines of its streams")
+{
+}
+
+void
+RitTraceMuxLineTest::DoRun()
+{
+    const std::string path = CreateTempDirFilename("rit-trace-mux/trace-00.csv");
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path());
+
+    Ptr<RitTraceMux> mux = Create<RitTraceMux>(path);
+    Ptr<OutputStreamWrapper> mac = mux->GetStream(3, "mac-txlog.csv");
+    Ptr<OutputStreamWrapper> nwk = mux->GetStream(12, "nwk-rxlog.csv");
+
+    *mac->GetStream() << "1.5,Tx" << std::endl;
+    *nwk->GetStream() << "1.5,RxOk,00:01";
+    *mac->GetStream() << "2,TxOk\n2.5,Tx\n";
+    *nwk->GetStream() << ",00:00," << 7 << std::endl;
+    *mac->GetStream() << "3,TxDrop";
+    NS_TEST_EXPECT_MSG_EQ(std::filesystem::file_size(path),
+                          0,
+                          "Per-line flushes reached the shared file");
+
+    mux->Close();
+    *mac->GetStream() << "4,Tx" << std::endl;
+    mux->Close();
+
+    const std::vector<std::string> expected = {
+        "3,mac-txlog.csv,1.5,Tx",
+        "3,mac-txlog.csv,2,TxOk",
+        "3,mac-txlog.csv,2.5,Tx",
+        "12,nwk-rxlog.csv,1.5,RxOk,00:01,00:00,7",
+        "3,mac-txlog.csv,3,TxDrop",
+    };
+    const std::vector<std::string> lines = ReadLines(path);
+    NS_TEST_ASSERT_MSG_EQ(lines.size(), expected.size(), "Bad number of tagged lines");
+    for (size_t i = 0; i < lines.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(lines[i], expected[i], "Tagged line " << i + 1 << " differs");
+    }
+}
+
+/**
+ * @brief Run the trace network with per-node ASCII logs and with consolidated files, split
+ *        the latter by their node and log tags and check that each node log comes back
+ *        line by line, in time order and in the shard of its node.
+ */
+class RitTraceMuxRoundTripTest : public TestCase
+{
+  public:
+    RitTraceMuxRoundTripTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitTraceMuxRoundTripTest::RitTraceMuxRoundTripTest()
+    : TestCase("Consolidated ASCII traces split back into the per-node logs")
+{
+}
+
+void
+RitTraceMuxRoundTripTest::DoRun()
+{
+    constexpr uint32_t shards = 2;
+    const std::string csvDir = CreateTempDirFilename("rit-trace-mux-csv/");
+    const std::string muxDir = CreateTempDirFilename("rit-trace-mux-shards/");
+
+    const std::vector<uint32_t> nodeIds = SetUpTraceScenario(RitTraceFormat::ASCII, 0, csvDir);
+    Simulator::Stop(Seconds(SIM_TIME_SEC));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    SetUpTraceScenario(RitTraceFormat::ASCII, shards, muxDir);
+    Simulator::Stop(Seconds(SIM_TIME_SEC));
+    Simulator::Run();
+    // The shared files are only complete once RitTraceMux::Close() ran at destroy
+    Simulator::Destroy();
+
+    // Split the shards back into (node, log) -> lines
+    std::map<std::pair<uint32_t, std::string>, std::vector<std::string>> split;
+    for (uint32_t shard = 0; shard < shards; shard++)
+    {
+        const std::string path = muxDir + "trace-0" + std::to_string(shard) + ".csv";
+        double lastTime = 0.0;
+        for (const auto& line : ReadLines(path))
+        {
+            const size_t nodeEnd = line.find(',');
+            const size_t logEnd = line.find(',', nodeEnd + 1);
+            NS_TEST_ASSERT_MSG_NE(logEnd, std::string::npos, "Untagged line in " << path);
+            const uint32_t nodeId = std::stoul(line.substr(0, nodeEnd));
+            const std::string logName = line.substr(nodeEnd + 1, logEnd - nodeEnd - 1);
+            const std::string rest = line.substr(logEnd + 1);
+            NS_TEST_EXPECT_MSG_EQ(nodeId % shards, shard, "Node " << nodeId << " in " << path);
+            const double time = std::stod(rest);
+            NS_TEST_EXPECT_MSG_GT_OR_EQ(time, lastTime, "Line out of time order in " << path);
+            lastTime = time;
+            split[{nodeId, logName}].push_back(rest);
+        }
+    }
+
+    bool uidOffsetSet = false;
+    int64_t uidOffset = 0;
+    for (uint32_t nodeId : nodeIds)
+    {
+        for (const auto& log : COMPARED_LOGS)
+        {
+            const std::string csvPath = NodeLogPath(csvDir, nodeId, log + ".csv");
+            const std::vector<std::string> expected = ReadLines(csvPath);
+            const std::vector<std::string>& lines = split[{nodeId, log + ".csv"}];
+            NS_TEST_ASSERT_MSG_EQ(lines.size(),
+                                  expected.size(),
+                                  "Consolidated " << csvPath << " lost or gained lines");
+            for (size_t i = 0; i < lines.size(); i++)
+            {
+                const std::string where = csvPath + ":" + std::to_string(i + 1);
+                if (log == "mac-statelog")
+                {
+                    NS_TEST_EXPECT_MSG_EQ(lines[i], expected[i], "Line differs at " << where);
+                    continue;
+                }
+                // The second run shifts the packet uids, the last NWK field
+                const std::vector<std::string> got = SplitFields(lines[i]);
+                const std::vector<std::string> want = SplitFields(expected[i]);
+                NS_TEST_ASSERT_MSG_EQ(got.size(), 5, "Bad NWK line at " << where);
+                NS_TEST_ASSERT_MSG_EQ(want.size(), 5, "Bad NWK line in " << csvPath);
+                for (size_t f = 0; f < 4; f++)
+                {
+                    NS_TEST_EXPECT_MSG_EQ(got[f], want[f], "Field " << f << " at " << where);
+                }
+                const int64_t offset = static_cast<int64_t>(std::stoull(got[4])) -
+                                       static_cast<int64_t>(std::stoull(want[4]));
+                if (!uidOffsetSet)
+                {
+                    uidOffset = offset;
+                    uidOffsetSet = true;
+                }
+                NS_TEST_EXPECT_MSG_EQ(offset, uidOffset, "Packet uid differs at " << where);
+            }
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(uidOffsetSet, true, "No NWK event was traced");
+}
+
+/**
+ * @brief Check the ring of RitAsyncTraceWriter: the records of a full ring are dropped and
+ *        counted under DROP, the producer waits under BLOCK, and Stop() drains the ring and
+ *        flushes the writers with the records in the order they were pushed.
+ */
+class RitAsyncTraceRingTest : public TestCase
+{
+  public:
+    RitAsyncTraceRingTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Check the records of a binary file.
+     * @param path The file
+     * @param count Records expected, with the uids 0 .. count - 1 in order
+     */
+    void CheckRecords(const std::string& path, uint64_t count);
+};
+
+RitAsyncTraceRingTest::RitAsyncTraceRingTest()
+    : TestCase("RitAsyncTraceWriter keeps the order, handles a full ring and flushes on stop")
+{
+}
+
+void
+RitAsyncTraceRingTest::CheckRecords(const std::string& path, uint64_t count)
+{
+    RitTraceFileHeader header;
+    std::vector<RitTraceRecord> records;
+    NS_TEST_ASSERT_MSG_EQ(ReadRecords(path, header, records), true, "Cannot read " << path);
+    NS_TEST_ASSERT_MSG_EQ(records.size(), count, "Bad number of records in " << path);
+    for (uint64_t i = 0; i < count; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(records[i].uid, i, "Record " << i << " out of order in " << path);
+        NS_TEST_EXPECT_MSG_EQ(records[i].timeNs,
+                              static_cast<int64_t>(i),
+                              "Record " << i << " altered in " << path);
+    }
+}
+
+void
+RitAsyncTraceRingTest::DoRun()
+{
+    constexpr uint32_t ring = 4;
+    const std::string dir = CreateTempDirFilename("rit-async-trace/");
+    std::filesystem::create_directories(dir);
+
+    auto makeRecord = [](uint64_t i) {
+        RitTraceRecord rec{};
+        rec.timeNs = static_cast<int64_t>(i);
+        rec.uid = i;
+        rec.event = RIT_TRACE_EV_TX;
+        return rec;
+    };
+
+    // DROP: fill the ring before the writer thread runs, the surplus is lost
+    {
+        const std::string path = dir + "drop.bin";
+        Ptr<RitBinaryTraceWriter> writer =
+            Create<RitBinaryTraceWriter>(path, RIT_TRACE_LOG_NWK_TX, 1, BUFFER_RECORDS);
+        Ptr<RitAsyncTraceWriter> async =
+            Create<RitAsyncTraceWriter>(ring, RitAsyncTraceWriter::DROP);
+        writer->AttachAsyncWriter(async);
+        uint64_t accepted = 0;
+        for (uint64_t i = 0; i < 3 * ring; i++)
+        {
+            accepted += async->Push(PeekPointer(writer), makeRecord(i)) ? 1 : 0;
+        }
+        NS_TEST_EXPECT_MSG_EQ(accepted, ring, "A full ring accepted a record");
+        NS_TEST_EXPECT_MSG_EQ(async->GetDroppedCount(), 2 * ring, "Bad drop count");
+
+        async->Start();
+        NS_TEST_EXPECT_MSG_EQ(async->IsRunning(), true, "Writer thread not started");
+        async->Stop();
+        NS_TEST_EXPECT_MSG_EQ(async->IsRunning(), false, "Writer thread not joined");
+        CheckRecords(path, ring);
+    }
+
+    // BLOCK: many more records than slots through the writer, none lost
+    {
+        const std::string path = dir + "block.bin";
+        constexpr uint64_t count = 1000;
+        Ptr<RitBinaryTraceWriter> writer =
+            Create<RitBinaryTraceWriter>(path, RIT_TRACE_LOG_NWK_TX, 2, BUFFER_RECORDS);
+        Ptr<RitAsyncTraceWriter> async =
+            Create<RitAsyncTraceWriter>(ring, RitAsyncTraceWriter::BLOCK);
+        writer->AttachAsyncWriter(async);
+        async->Start();
+        for (uint64_t i = 0; i < count; i++)
+        {
+            writer->Write(makeRecord(i));
+        }
+        // Flush() belongs to the writer thread while it runs
+        writer->Flush();
+        async->Stop();
+        NS_TEST_EXPECT_MSG_EQ(async->GetDroppedCount(), 0, "BLOCK dropped a record");
+        NS_TEST_EXPECT_MSG_EQ(writer->GetRecordCount(), count, "Bad record count");
+        CheckRecords(path, count);
+
+        // Once stopped the writer is served from the simulator thread again
+        writer->Write(makeRecord(count));
+        writer->Flush();
+        CheckRecords(path, count + 1);
+    }
+}
+
+/**
+ * @brief Run the trace network with binary traces written by the simulator thread and by
+ *        an async writer with a small ring, and check the files match record by record
+ *        once the writer was stopped at Simulator::Destroy().
+ */
+class RitAsyncTraceRunTest : public TestCase
+{
+  public:
+    RitAsyncTraceRunTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitAsyncTraceRunTest::RitAsyncTraceRunTest()
+    : TestCase("Async binary traces match the synchronous ones after destroy")
+{
+}
+
+void
+RitAsyncTraceRunTest::DoRun()
+{
+    const std::string syncDir = CreateTempDirFilename("rit-async-trace-sync/");
+    const std::string asyncDir = CreateTempDirFilename("rit-async-trace-ring/");
+
+    const std::vector<uint32_t> nodeIds =
+        SetUpTraceScenario(RitTraceFormat::BINARY, 0, syncDir);
+    Simulator::Stop(Seconds(SIM_TIME_SEC));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    SetUpTraceScenario(RitTraceFormat::BINARY, 0, asyncDir, 8);
+    Simulator::Stop(Seconds(SIM_TIME_SEC));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    bool uidOffsetSet = false;
+    int64_t uidOffset = 0;
+    uint64_t compared = 0;
+    for (uint32_t nodeId : nodeIds)
+    {
+        for (const auto& log : COMPARED_LOGS)
+        {
+            const std::string syncPath = NodeLogPath(syncDir, nodeId, log + ".bin");
+            const std::string asyncPath = NodeLogPath(asyncDir, nodeId, log + ".bin");
+            RitTraceFileHeader syncHeader;
+            RitTraceFileHeader asyncHeader;
+            std::vector<RitTraceRecord> want;
+            std::vector<RitTraceRecord> got;
+            const bool haveSync = ReadRecords(syncPath, syncHeader, want);
+            const bool haveAsync = ReadRecords(asyncPath, asyncHeader, got);
+            NS_TEST_ASSERT_MSG_EQ(haveAsync, haveSync, asyncPath << " differs in presence");
+            NS_TEST_ASSERT_MSG_EQ(got.size(), want.size(), "Record count of " << asyncPath);
+            for (size_t i = 0; i < got.size(); i++)
+            {
+                const std::string where = asyncPath + " record " + std::to_string(i);
+                NS_TEST_EXPECT_MSG_EQ(got[i].timeNs, want[i].timeNs, "Time at " << where);
+                NS_TEST_EXPECT_MSG_EQ(+got[i].event, +want[i].event, "Event at " << where);
+                NS_TEST_EXPECT_MSG_EQ(+got[i].arg, +want[i].arg, "Argument at " << where);
+                NS_TEST_EXPECT_MSG_EQ(got[i].src, want[i].src, "Source at " << where);
+                NS_TEST_EXPECT_MSG_EQ(got[i].dst, want[i].dst, "Dest at " << where);
+                NS_TEST_EXPECT_MSG_EQ(got[i].nodeId, want[i].nodeId, "Node at " << where);
+                // The second run shifts the packet uids
+                const int64_t offset =
+                    static_cast<int64_t>(got[i].uid) - static_cast<int64_t>(want[i].uid);
+                if (got[i].uid != 0 && !uidOffsetSet)
+                {
+                    uidOffset = offset;
+                    uidOffsetSet = true;
+                }
+                if (got[i].uid != 0)
+                {
+                    NS_TEST_EXPECT_MSG_EQ(offset, uidOffset, "Packet uid at " << where);
+                }
+                compared++;
+            }
+        }
+    }
+    NS_TEST_EXPECT_MSG_GT(compared, 8, "Too few records to fill the ring");
+}
+
+class RitTraceWriterTestSuite : public TestSuite
+{
+  public:
+    RitTraceWriterTestSuite();
+};
+
+RitTraceWriterTestSuite::RitTraceWriterTestSuite()
+    : TestSuite("rit-trace-writer", Type::UNIT)
+{
+    AddTestCase(new RitBinaryTraceAsciiTest, Duration::QUICK);
+    AddTestCase(new RitTraceMuxLineTest, Duration::QUICK);
+    AddTestCase(new RitTraceMuxRoundTripTest, Duration::QUICK);
+    AddTestCase(new RitAsyncTraceRingTest, Duration::QUICK);
+    AddTestCase(new RitAsyncTraceRunTest, Duration::QUICK);
+}
+
+static RitTraceWriterTestSuite g_ritTraceWriterTestSuite;
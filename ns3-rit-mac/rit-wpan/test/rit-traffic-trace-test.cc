@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/log.h>
+#include <ns3/nstime.h>
+#include <ns3/rit-traffic-trace.h>
+#include <ns3/simulator.h>
+#include <ns3/test.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-traffic-trace-test");
+
+/**
+ * @brief Check that RitTrafficTrace replays a CSV trace and its binary version the
+ *        same way: records at their times, to their node, skipping the records
+ *        before the start and those of nodes without a sender.
+ */
+class RitTrafficTraceReplayTest : public TestCase
+{
+  public:
+    RitTrafficTraceReplayTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief A packet handed to a sender.
+     */
+    struct Sent
+    {
+        Time time;        //!< Dispatch time
+        uint32_t node;    //!< Trace node id
+        uint32_t context; //!< Context of the dispatch
+        uint16_t size;    //!< Payload size
+        uint8_t priority; //!< Priority class
+    };
+
+    /**
+     * @brief Replay a trace file with senders for the nodes 1 and 2, registered at 1 s,
+     * node 2 unregistered at 5 s.
+     * @param path Trace file
+     * @return the packets handed to the senders
+     */
+    std::vector<Sent> Replay(const std::string& path);
+
+    /**
+     * @brief Sender callback.
+     * @param test The test
+     * @param node Trace node id
+     * @param size Payload size
+     * @param priority Priority class
+     */
+    static void Send(RitTrafficTraceReplayTest* test,
+                     uint32_t node,
+                     uint16_t size,
+                     uint8_t priority);
+
+    std::vector<Sent> m_sent; //!< Packets of the current replay
+};
+
+RitTrafficTraceReplayTest::RitTrafficTraceReplayTest()
+    : TestCase("Traffic trace replay from CSV and binary files")
+{
+}
+
+void
+RitTrafficTraceReplayTest::Send(RitTrafficTraceReplayTest* test,
+                                uint32_t node,
+                                uint16_t size,
+                                uint8_t priority)
+{
+    test->m_sent.push_back({Simulator::Now(), node, Simulator::GetContext(), size, priority});
+}
+
+std::vector<RitTrafficTraceReplayTest::Sent>
+RitTrafficTraceReplayTest::Replay(const std::string& path)
+{
+    m_sent.clear();
+    Ptr<RitTrafficTrace> trace = CreateObject<RitTrafficTrace>();
+    trace->Open(path);
+    for (uint32_t node : {1, 2})
+    {
+        Simulator::Schedule(Seconds(1),
+                            &RitTrafficTrace::Register,
+                            trace,
+                            node,
+                            10 + node,
+                            MakeBoundCallback(&RitTrafficTraceReplayTest::Send, this, node));
+    }
+    Simulator::Schedule(Seconds(5), &RitTrafficTrace::Unregister, trace, 2);
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(trace->GetNDispatched(), m_sent.size(), "Wrong dispatch count");
+    NS_TEST_EXPECT_MSG_EQ(trace->GetNSkipped(), 3, "Wrong skip count");
+    trace->Dispose();
+    Simulator::Destroy();
+    return m_sent;
+}
+
+void
+RitTrafficTraceReplayTest::DoRun()
+{
+    const std::string csv = CreateTempDirFilename("rit-traffic.csv");
+    {
+        std::ofstream out(csv);
+        out << "time_s,node,size,priority\n"
+            << "# before the senders start\n"
+            << "0.5,1,20,0\n"
+            << "1.0,1,20,0\n"
+            << "\n"
+            << "2.25,2,40,3\n"
+            << "2.25,1,10\n"
+            << "3,3,20,0\n"
+            << "6,2,20,0\n"
+            << "7.000000001,1,80,7\n";
+    }
+    const std::string bin = CreateTempDirFilename("rit-traffic.bin");
+    NS_TEST_ASSERT_MSG_EQ(RitTrafficTrace::ConvertToBinary(csv, bin), 7, "Wrong record count");
+
+    for (const std::string& path : {csv, bin})
+    {
+        const std::vector<Sent> sent = Replay(path);
+        NS_TEST_ASSERT_MSG_EQ(sent.size(), 4, "Wrong number of packets from " << path);
+        NS_TEST_EXPECT_MSG_EQ(sent[0].time, Seconds(1), "Record at the start not sent");
+        NS_TEST_EXPECT_MSG_EQ(sent[0].node, 1, "Wrong node");
+        NS_TEST_EXPECT_MSG_EQ(sent[1].time, Seconds(2.25), "Wrong time");
+        NS_TEST_EXPECT_MSG_EQ(sent[1].node, 2, "Wrong node");
+        NS_TEST_EXPECT_MSG_EQ(sent[1].context, 12, "Not in the context of the node");
+        NS_TEST_EXPECT_MSG_EQ(sent[1].size, 40, "Wrong size");
+        NS_TEST_EXPECT_MSG_EQ(+sent[1].priority, 3, "Wrong priority");
+        NS_TEST_EXPECT_MSG_EQ(sent[2].time, Seconds(2.25), "Tie not kept in file order");
+        NS_TEST_EXPECT_MSG_EQ(+sent[2].priority, 0, "Missing priority not 0");
+        NS_TEST_EXPECT_MSG_EQ(sent[3].time, NanoSeconds(7000000001), "Time not kept to the ns");
+        NS_TEST_EXPECT_MSG_EQ(sent[3].size, 80, "Wrong size");
+    }
+}
+
+class RitTrafficTraceTestSuite : public TestSuite
+{
+  public:
+    RitTrafficTraceTestSuite();
+};
+
+RitTrafficTraceTestSuite::RitTrafficTraceTestSuite()
+    : TestSuite("rit-traffic-trace", Type::UNIT)
+{
+    AddTestCase(new RitTrafficTraceReplayTest, Duration::QUICK);
+}
+
+static RitTrafficTraceTestSuite g_ritTrafficTraceTestSuite;
@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/core-module.h>
+#include <ns3/log.h>
+#include <ns3/lr-wpan-phy.h>
+#include <ns3/network-module.h>
+#include <ns3/packet.h>
+#include <ns3/propagation-delay-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/rit-wpan-energy-model.h>
+#include <ns3/rit-wpan-mac.h>
+#include <ns3/rit-wpan-net-device.h>
+#include <ns3/single-model-spectrum-channel.h>
+#include <ns3/test.h>
+
+#include <utility>
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-wpan-energy-model-test");
+
+namespace
+{
+
+/**
+ * @brief Create a channel with the propagation models of the MAC tests.
+ * @return the channel
+ */
+Ptr<SingleModelSpectrumChannel>
+CreateTestChannel()
+{
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+    return channel;
+}
+
+/**
+ * @brief Create a node with a RIT device of BI 1 s on a channel.
+ * @param channel The channel
+ * @param address Short address of the device
+ * @param rank RIT rank of the device
+ * @return the device
+ */
+Ptr<RitWpanNetDevice>
+CreateTestDevice(Ptr<SingleModelSpectrumChannel> channel, uint16_t address, uint16_t rank)
+{
+    Ptr<Node> node = CreateObject<Node>();
+    Ptr<RitWpanNetDevice> device = CreateObject<RitWpanNetDevice>();
+    device->SetChannel(channel);
+    device->SetAddress(Mac16Address(address));
+    node->AddDevice(device);
+    device->SetRitRank(rank);
+    Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+    pibAttr->macRitPeriodTime = Time(Seconds(1));
+    device->GetMac()->MlmeSetRequest(macRitPeriodTime, pibAttr);
+    return device;
+}
+
+/**
+ * @brief Energy of duty-cycle counters for per-state currents, as in the datasheets.
+ * @param c The counters
+ * @param off Current in TRX_OFF [A]
+ * @param rx Current in RX_ON and BUSY_RX [A]
+ * @param txOn Current in TX_ON [A]
+ * @param busyTx Current in BUSY_TX [A]
+ * @return the energy at 3 V [J]
+ */
+double
+ExpectedEnergy(const PhyDutyCycleCounters& c, double off, double rx, double txOn, double busyTx)
+{
+    return 3.0 * (c.trxOff.GetSeconds() * off + (c.rxOn + c.busyRx).GetSeconds() * rx +
+                  c.txOn.GetSeconds() * txOn + c.busyTx.GetSeconds() * busyTx);
+}
+
+} // namespace
+
+/**
+ * @brief Check that the consumed energy follows the PHY state counters and the current
+ *        draw of the radio profile, and that it is reported every UpdateInterval.
+ */
+class RitWpanEnergyAccountingTest : public TestCase
+{
+  public:
+    RitWpanEnergyAccountingTest();
+
+  private:
+    /**
+     * @brief Log a periodic energy report of the sender.
+     * @param consumed Energy consumed so far [J]
+     */
+    void EnergyReport(double consumed);
+
+    void DoRun() override;
+
+    std::vector<std::pair<Time, double>> m_reports; //!< Time and value of the reports
+};
+
+RitWpanEnergyAccountingTest::RitWpanEnergyAccountingTest()
+    : TestCase("Radio energy from the PHY state counters and the radio profile")
+{
+}
+
+void
+RitWpanEnergyAccountingTest::EnergyReport(double consumed)
+{
+    m_reports.emplace_back(Simulator::Now(), consumed);
+}
+
+void
+RitWpanEnergyAccountingTest::DoRun()
+{
+    Ptr<SingleModelSpectrumChannel> channel = CreateTestChannel();
+    Ptr<RitWpanNetDevice> sink = CreateTestDevice(channel, 0, 0);
+    Ptr<RitWpanNetDevice> sender = CreateTestDevice(channel, 1, 1);
+    sink->GetEnergyModel()->SetRadioProfile(RIT_RADIO_AT86RF233);
+    sender->GetEnergyModel()->SetAttribute("UpdateInterval", TimeValue(Seconds(1)));
+    sender->TraceConnectWithoutContext(
+        "EnergyDepletion",
+        MakeCallback(&RitWpanEnergyAccountingTest::EnergyReport, this));
+
+    for (uint32_t k = 0; k < 3; k++)
+    {
+        Simulator::ScheduleWithContext(sender->GetNode()->GetId(), Seconds(5 + 5 * k), [=]() {
+            sender->Send(Create<Packet>(20), Mac16Address("00:00"), 0);
+        });
+    }
+
+    Simulator::Stop(Seconds(20.5));
+    Simulator::Run();
+
+    // CC2538 (default) for the sender, AT86RF233 for the sink
+    const PhyDutyCycleCounters txCounters = sender->GetPhy()->GetDutyCycleCounters();
+    const PhyDutyCycleCounters rxCounters = sink->GetPhy()->GetDutyCycleCounters();
+    NS_TEST_ASSERT_MSG_EQ(txCounters.busyTx.IsStrictlyPositive(), true, "Sender never sent");
+    NS_TEST_ASSERT_MSG_EQ(rxCounters.busyRx.IsStrictlyPositive(), true, "Sink never received");
+    const double txEnergy = ExpectedEnergy(txCounters, 1.3e-6, 20e-3, 20e-3, 24e-3);
+    const double rxEnergy = ExpectedEnergy(rxCounters, 0.2e-6, 11.8e-3, 5.2e-3, 13.8e-3);
+    Ptr<RitWpanEnergyModel> txModel = sender->GetEnergyModel();
+    Ptr<RitWpanEnergyModel> rxModel = sink->GetEnergyModel();
+    NS_TEST_EXPECT_MSG_EQ_TOL(txModel->GetConsumedEnergy(), txEnergy, 1e-12, "CC2538 energy");
+    NS_TEST_EXPECT_MSG_EQ_TOL(rxModel->GetConsumedEnergy(), rxEnergy, 1e-12, "AT86RF233 energy");
+    NS_TEST_EXPECT_MSG_EQ_TOL(txModel->GetAveragePower(),
+                              txEnergy / txCounters.GetTotal().GetSeconds(),
+                              1e-12,
+                              "Average power");
+
+    // No battery: nothing depletes and the lifetime cannot be estimated
+    NS_TEST_EXPECT_MSG_EQ(txModel->IsDepleted(), false, "Unlimited battery depleted");
+    NS_TEST_EXPECT_MSG_EQ(txModel->GetRemainingFraction(), 1.0, "Unlimited battery drained");
+    NS_TEST_EXPECT_MSG_EQ(txModel->GetLifetimeEstimate(), Time::Max(), "Unlimited lifetime");
+
+    // One report per second, never decreasing, the last one up to date at 20 s
+    NS_TEST_ASSERT_MSG_EQ(m_reports.size(), 20, "Wrong number of energy reports");
+    for (size_t i = 0; i < m_reports.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_reports[i].first, Seconds(i + 1), "Report " << i << " late");
+        if (i > 0)
+        {
+            NS_TEST_EXPECT_MSG_GT_OR_EQ(m_reports[i].second,
+                                        m_reports[i - 1].second,
+                                        "Consumed energy decreased at report " << i);
+        }
+    }
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(m_reports.back().second,
+                                txModel->GetConsumedEnergy(),
+                                "Last report ahead of the counters");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @brief Check the depletion of a small battery: one EnergyExhausted, at the first update
+ *        that finds the battery empty, and a depletion time within that update interval.
+ */
+class RitWpanEnergyDepletionTest : public TestCase
+{
+  public:
+    RitWpanEnergyDepletionTest();
+
+  private:
+    void DoRun() override;
+
+    std::vector<std::pair<Time, double>> m_reports; //!< Time and value of the energy reports
+    uint32_t m_nExhausted{0};                       //!< EnergyExhausted calls
+    Time m_exhaustedAt;                             //!< Time of the last one
+};
+
+RitWpanEnergyDepletionTest::RitWpanEnergyDepletionTest()
+    : TestCase("Battery depletion of an always-on receiver")
+{
+}
+
+void
+RitWpanEnergyDepletionTest::DoRun()
+{
+    // An always-on CC2538 receiver draws at most 72 mW (while it sends its beacons):
+    // 0.24 J lasts at least 3.33 s, and it is gone well before the end.
+    const double capacity = 0.24;
+    Ptr<SingleModelSpectrumChannel> channel = CreateTestChannel();
+    Ptr<RitWpanNetDevice> device = CreateTestDevice(channel, 0, 0);
+    device->GetMac()->SetRxAlwaysOn(true);
+    Ptr<RitWpanEnergyModel> model = device->GetEnergyModel();
+    model->SetAttribute("InitialEnergy", DoubleValue(capacity));
+    model->SetAttribute("UpdateInterval", TimeValue(Seconds(1)));
+    device->TraceConnectWithoutContext("EnergyDepletion", Callback<void, double>([this](double e) {
+                                           m_reports.emplace_back(Simulator::Now(), e);
+                                       }));
+    device->TraceConnectWithoutContext("EnergyExhausted", Callback<void>([this]() {
+                                           m_nExhausted++;
+                                           m_exhaustedAt = Simulator::Now();
+                                       }));
+
+    Simulator::Stop(Seconds(10.5));
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_nExhausted, 1, "EnergyExhausted not fired once");
+    NS_TEST_EXPECT_MSG_EQ(model->IsDepleted(), true, "Battery not depleted");
+
+    // Detected by the first report at or above the capacity
+    size_t first = 0;
+    while (first < m_reports.size() && m_reports[first].second < capacity)
+    {
+        first++;
+    }
+    NS_TEST_ASSERT_MSG_LT(first, m_reports.size(), "No report of an empty battery");
+    NS_TEST_ASSERT_MSG_GT(first, 0, "Battery empty at the first report");
+    NS_TEST_EXPECT_MSG_EQ(m_exhaustedAt, m_reports[first].first, "Depletion detected late");
+
+    // Located within that interval, by the average power over it
+    const Time depletion = model->GetDepletionTime();
+    NS_TEST_EXPECT_MSG_GT(depletion, m_reports[first - 1].first, "Depletion too early");
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(depletion, m_exhaustedAt, "Depletion after its detection");
+    NS_TEST_EXPECT_MSG_GT(depletion, Seconds(capacity / 0.072), "Faster than the peak power");
+    NS_TEST_EXPECT_MSG_EQ(model->GetLifetimeEstimate(), depletion, "Lifetime of a dead node");
+    NS_TEST_EXPECT_MSG_EQ(model->GetRemainingEnergy(), 0.0, "Energy left in a dead battery");
+    NS_TEST_EXPECT_MSG_EQ(model->GetRemainingFraction(), 0.0, "Share left in a dead battery");
+
+    Simulator::Destroy();
+}
+
+class RitWpanEnergyModelTestSuite : public TestSuite
+{
+  public:
+    RitWpanEnergyModelTestSuite();
+};
+
+RitWpanEnergyModelTestSuite::RitWpanEnergyModelTestSuite()
+    : TestSuite("rit-wpan-energy-model", Type::UNIT)
+{
+    AddTestCase(new RitWpanEnergyAccountingTest, Duration::QUICK);
+    AddTestCase(new RitWpanEnergyDepletionTest, Duration::QUICK);
+}
+
+static RitWpanEnergyModelTestSuite g_ritWpanEnergyModelTestSuite;
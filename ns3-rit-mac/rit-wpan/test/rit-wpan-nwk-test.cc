@@ -0,0 +1,1404 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/core-module.h>
+#include <ns3/error-model.h>
+#include <ns3/log.h>
+#include <ns3/lr-wpan-mac-header.h>
+#include <ns3/network-module.h>
+#include <ns3/packet.h>
+#include <ns3/propagation-delay-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/rit-aggregation-header.h>
+#include <ns3/rit-broadcast-header.h>
+#include <ns3/rit-metrics-collector.h>
+#include <ns3/rit-route-header.h>
+#include <ns3/rit-timestamp-tag.h>
+#include <ns3/rit-wpan-mac.h>
+#include <ns3/rit-wpan-net-device.h>
+#include <ns3/rit-wpan-nwk-header.h>
+#include <ns3/rit-wpan-nwk.h>
+#include <ns3/single-model-spectrum-channel.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-wpan-nwk-test");
+
+/**
+ * @brief Check the serialization of the sub-frame length table.
+ */
+class RitAggregationHeaderTest : public TestCase
+{
+  public:
+    RitAggregationHeaderTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitAggregationHeaderTest::RitAggregationHeaderTest()
+    : TestCase("RitAggregationHeader length table round trip")
+{
+}
+
+void
+RitAggregationHeaderTest::DoRun()
+{
+    RitAggregationHeader hdr;
+    hdr.AddSubFrame(26);
+    hdr.AddSubFrame(14);
+    hdr.AddSubFrame(6);
+    NS_TEST_EXPECT_MSG_EQ(hdr.GetSerializedSize(), 4, "Wrong header size");
+
+    Ptr<Packet> p = Create<Packet>(46);
+    p->AddHeader(hdr);
+    RitAggregationHeader rx;
+    p->RemoveHeader(rx);
+    NS_TEST_ASSERT_MSG_EQ(rx.GetNSubFrames(), 3, "Wrong number of sub-frames");
+    NS_TEST_EXPECT_MSG_EQ(rx.GetSubFrameLength(0), 26, "Wrong sub-frame length");
+    NS_TEST_EXPECT_MSG_EQ(rx.GetSubFrameLength(2), 6, "Wrong sub-frame length");
+    NS_TEST_EXPECT_MSG_EQ(p->GetSize(), 46, "Payload changed");
+}
+
+/**
+ * @brief Check that packets queued toward the same destination travel in one MAC frame
+ * and are delivered one by one, with their timestamps, at the receiver.
+ */
+class RitWpanNwkAggregationTest : public TestCase
+{
+  public:
+    RitWpanNwkAggregationTest();
+
+  private:
+    /**
+     * @brief Record a packet delivered at the receiver.
+     * @param dev The device
+     * @param pkt The packet
+     * @param proto The protocol number
+     * @param addr The source address
+     * @return true
+     */
+    bool DataIndication(Ptr<NetDevice> dev,
+                        Ptr<const Packet> pkt,
+                        uint16_t proto,
+                        const Address& addr);
+
+    /**
+     * @brief Count the MAC data frames acknowledged at the sender.
+     * @param p The frame
+     */
+    void MacTxOk(Ptr<const Packet> p);
+
+    /**
+     * @brief Count the NWK packets confirmed at the sender.
+     * @param p The packet
+     */
+    void NwkTxOk(Ptr<const Packet> p);
+
+    void DoRun() override;
+
+    std::vector<uint32_t> m_rxSizes; //!< Delivered packet sizes
+    uint32_t m_nTimestamped{0};      //!< Delivered packets still carrying a timestamp
+    uint32_t m_nMacTxOk{0};          //!< Acknowledged MAC data frames
+    uint32_t m_nNwkTxOk{0};          //!< Confirmed NWK packets
+};
+
+RitWpanNwkAggregationTest::RitWpanNwkAggregationTest()
+    : TestCase("RitSimpleRouting aggregation of packets toward the same destination")
+{
+}
+
+bool
+RitWpanNwkAggregationTest::DataIndication(Ptr<NetDevice> dev,
+                                          Ptr<const Packet> pkt,
+                                          uint16_t proto,
+                                          const Address& addr)
+{
+    m_rxSizes.push_back(pkt->GetSize());
+    RitTimestampTag timestamp;
+    if (pkt->PeekPacketTag(timestamp))
+    {
+        m_nTimestamped++;
+    }
+    return true;
+}
+
+void
+RitWpanNwkAggregationTest::MacTxOk(Ptr<const Packet> p)
+{
+    m_nMacTxOk++;
+}
+
+void
+RitWpanNwkAggregationTest::NwkTxOk(Ptr<const Packet> p)
+{
+    m_nNwkTxOk++;
+}
+
+void
+RitWpanNwkAggregationTest::DoRun()
+{
+    Ptr<Node> receiverNode = CreateObject<Node>();
+    Ptr<Node> senderNode = CreateObject<Node>();
+    Ptr<RitWpanNetDevice> receiverDevice = CreateObject<RitWpanNetDevice>();
+    Ptr<RitWpanNetDevice> senderDevice = CreateObject<RitWpanNetDevice>();
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+    receiverDevice->SetChannel(channel);
+    senderDevice->SetChannel(channel);
+
+    receiverDevice->SetAddress(Mac16Address("00:00"));
+    receiverDevice->SetRitRank(0);
+    senderDevice->SetAddress(Mac16Address("00:01"));
+    senderDevice->SetRitRank(1);
+    receiverNode->AddDevice(receiverDevice);
+    senderNode->AddDevice(senderDevice);
+    receiverDevice->SetReceiveCallback(
+        MakeCallback(&RitWpanNwkAggregationTest::DataIndication, this));
+
+    Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+    pibAttr->macRitPeriodTime = Time(Seconds(1));
+    for (const auto& device : {senderDevice, receiverDevice})
+    {
+        device->GetNwk()->SetAttribute("AggregationEnabled", BooleanValue(true));
+        device->GetNwk()->SetAttribute("AggregationMaxDelay", TimeValue(MilliSeconds(100)));
+        device->GetMac()->MlmeSetRequest(macRitPeriodTime, pibAttr);
+    }
+    senderDevice->GetMac()->TraceConnectWithoutContext(
+        "MacTxOk",
+        MakeCallback(&RitWpanNwkAggregationTest::MacTxOk, this));
+    senderDevice->GetNwk()->TraceConnectWithoutContext(
+        "NwkTxOk",
+        MakeCallback(&RitWpanNwkAggregationTest::NwkTxOk, this));
+
+    // Three packets within the aggregation delay
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        Simulator::ScheduleWithContext(senderNode->GetId(),
+                                       Seconds(8.0) + MilliSeconds(20 * i),
+                                       [=]() {
+                                           Ptr<Packet> p = Create<Packet>(10 + 10 * i);
+                                           p->AddPacketTag(RitTimestampTag(Simulator::Now()));
+                                           senderDevice->Send(p, Mac16Address("00:00"), 0);
+                                       });
+    }
+
+    Simulator::Stop(Seconds(12.0));
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_rxSizes.size(), 3, "Not every sub-frame was delivered");
+    NS_TEST_EXPECT_MSG_EQ(m_rxSizes[0], 10, "Wrong sub-frame boundaries or order");
+    NS_TEST_EXPECT_MSG_EQ(m_rxSizes[1], 20, "Wrong sub-frame boundaries or order");
+    NS_TEST_EXPECT_MSG_EQ(m_rxSizes[2], 30, "Wrong sub-frame boundaries or order");
+    NS_TEST_EXPECT_MSG_EQ(m_nTimestamped, 3, "Timestamp lost in the aggregate");
+    NS_TEST_EXPECT_MSG_EQ(m_nMacTxOk, 1, "Packets not sent in a single MAC frame");
+    NS_TEST_EXPECT_MSG_EQ(m_nNwkTxOk, 3, "Not every packet was confirmed");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @brief Check that with AnycastEnabled a sender skips a lower-rank neighbour without
+ * queue headroom and sends straight to another lower-rank neighbour.
+ */
+class RitWpanNwkAnycastTest : public TestCase
+{
+  public:
+    RitWpanNwkAnycastTest();
+
+  private:
+    /**
+     * @brief Count the packets delivered at the sink.
+     * @param dev The device
+     * @param pkt The packet
+     * @param proto The protocol number
+     * @param addr The source address
+     * @return true
+     */
+    bool DataIndication(Ptr<NetDevice> dev,
+                        Ptr<const Packet> pkt,
+                        uint16_t proto,
+                        const Address& addr);
+
+    /**
+     * @brief Count the packets received by the relay.
+     * @param p The packet
+     */
+    void RelayRx(Ptr<const Packet> p);
+
+    void DoRun() override;
+
+    uint32_t m_nSinkRx{0};  //!< Packets delivered at the sink
+    uint32_t m_nRelayRx{0}; //!< Packets received by the relay
+};
+
+RitWpanNwkAnycastTest::RitWpanNwkAnycastTest()
+    : TestCase("RitSimpleRouting anycast to a lower-rank neighbour with headroom")
+{
+}
+
+bool
+RitWpanNwkAnycastTest::DataIndication(Ptr<NetDevice> dev,
+                                      Ptr<const Packet> pkt,
+                                      uint16_t proto,
+                                      const Address& addr)
+{
+    m_nSinkRx++;
+    return true;
+}
+
+void
+RitWpanNwkAnycastTest::RelayRx(Ptr<const Packet> p)
+{
+    m_nRelayRx++;
+}
+
+void
+RitWpanNwkAnycastTest::DoRun()
+{
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    // Sink (rank 0), relay without headroom (rank 1) and sender (rank 2), all in range
+    std::vector<Ptr<RitWpanNetDevice>> devices;
+    Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+    pibAttr->macRitPeriodTime = Time(Seconds(1));
+    for (uint8_t rank = 0; rank < 3; rank++)
+    {
+        Ptr<Node> node = CreateObject<Node>();
+        Ptr<RitWpanNetDevice> device = CreateObject<RitWpanNetDevice>();
+        device->SetChannel(channel);
+        device->SetAddress(Mac16Address(static_cast<uint16_t>(rank)));
+        device->GetNwk()->SetAttribute("AnycastEnabled", BooleanValue(true));
+        if (rank == 1)
+        {
+            device->GetNwk()->SetAttribute("AnycastQueueCapacity", UintegerValue(0));
+        }
+        node->AddDevice(device);
+        device->SetRitRank(rank);
+        device->GetMac()->MlmeSetRequest(macRitPeriodTime, pibAttr);
+        devices.push_back(device);
+    }
+    devices[0]->SetReceiveCallback(MakeCallback(&RitWpanNwkAnycastTest::DataIndication, this));
+    devices[1]->GetNwk()->TraceConnectWithoutContext(
+        "NwkRx",
+        MakeCallback(&RitWpanNwkAnycastTest::RelayRx, this));
+
+    Ptr<RitWpanNetDevice> sender = devices[2];
+    Simulator::ScheduleWithContext(sender->GetNode()->GetId(), Seconds(8.0), [=]() {
+        sender->Send(Create<Packet>(20), Mac16Address("00:00"), 0);
+    });
+
+    Simulator::Stop(Seconds(12.0));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_nSinkRx, 1, "Packet not delivered at the sink");
+    NS_TEST_EXPECT_MSG_EQ(m_nRelayRx, 0, "Packet sent to a neighbour without headroom");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @brief Check that with BackpressureEnabled a sender leaves the beacons of a parent
+ * without queue headroom unanswered, keeps the packet and the parent, and sends once
+ * the parent advertises headroom again.
+ */
+class RitWpanNwkBackpressureTest : public TestCase
+{
+  public:
+    RitWpanNwkBackpressureTest();
+
+  private:
+    /**
+     * @brief Record the delivery time of a packet at the sink.
+     * @param dev The device
+     * @param pkt The packet
+     * @param proto The protocol number
+     * @param addr The source address
+     * @return true
+     */
+    bool DataIndication(Ptr<NetDevice> dev,
+                        Ptr<const Packet> pkt,
+                        uint16_t proto,
+                        const Address& addr);
+
+    /**
+     * @brief Count a beacon left unanswered by the sender.
+     * @param neighbour Beaconing next hop
+     * @param headroom Headroom it advertised
+     */
+    void Backpressure(Mac16Address neighbour, uint8_t headroom);
+
+    /**
+     * @brief Count a parent switch of the sender.
+     * @param oldParent Parent marked stale
+     * @param newParent New parent
+     * @param rank New rank
+     */
+    void Repair(Mac16Address oldParent, Mac16Address newParent, uint16_t rank);
+
+    void DoRun() override;
+
+    std::vector<Time> m_rxTimes; //!< Delivery times at the sink
+    uint32_t m_nBackpressure{0}; //!< Beacons left unanswered
+    uint32_t m_nRepairs{0};      //!< Parent switches
+};
+
+RitWpanNwkBackpressureTest::RitWpanNwkBackpressureTest()
+    : TestCase("RitSimpleRouting backpressure from the queue headroom in the beacons")
+{
+}
+
+bool
+RitWpanNwkBackpressureTest::DataIndication(Ptr<NetDevice> dev,
+                                           Ptr<const Packet> pkt,
+                                           uint16_t proto,
+                                           const Address& addr)
+{
+    m_rxTimes.push_back(Simulator::Now());
+    return true;
+}
+
+void
+RitWpanNwkBackpressureTest::Backpressure(Mac16Address neighbour, uint8_t headroom)
+{
+    NS_TEST_EXPECT_MSG_EQ(neighbour, Mac16Address("00:00"), "Unexpected next hop");
+    NS_TEST_EXPECT_MSG_EQ(+headroom, 0, "Beacon with headroom left unanswered");
+    m_nBackpressure++;
+}
+
+void
+RitWpanNwkBackpressureTest::Repair(Mac16Address oldParent, Mac16Address newParent, uint16_t rank)
+{
+    m_nRepairs++;
+}
+
+void
+RitWpanNwkBackpressureTest::DoRun()
+{
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    // Sink without headroom (rank 0) and a router taking it as parent, repairing on the
+    // first failure
+    std::vector<Ptr<RitWpanNetDevice>> devices;
+    Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+    pibAttr->macRitPeriodTime = Time(Seconds(1));
+    for (uint16_t i = 0; i < 2; i++)
+    {
+        Ptr<Node> node = CreateObject<Node>();
+        Ptr<RitWpanNetDevice> device = CreateObject<RitWpanNetDevice>();
+        device->SetChannel(channel);
+        device->SetAddress(Mac16Address(i));
+        device->GetNwk()->SetAttribute("BackpressureEnabled", BooleanValue(true));
+        device->GetNwk()->SetAttribute("LocalRepair", BooleanValue(true));
+        device->GetNwk()->SetAttribute("RepairThreshold", UintegerValue(1));
+        if (i == 0)
+        {
+            device->GetNwk()->SetAttribute("AnycastQueueCapacity", UintegerValue(0));
+        }
+        node->AddDevice(device);
+        device->SetRitRank(0);
+        device->GetMac()->MlmeSetRequest(macRitPeriodTime, pibAttr);
+        devices.push_back(device);
+    }
+    devices[0]->SetReceiveCallback(
+        MakeCallback(&RitWpanNwkBackpressureTest::DataIndication, this));
+    devices[1]->GetNwk()->TraceConnectWithoutContext(
+        "NwkBackpressure",
+        MakeCallback(&RitWpanNwkBackpressureTest::Backpressure, this));
+    devices[1]->GetNwk()->TraceConnectWithoutContext(
+        "NwkRepair",
+        MakeCallback(&RitWpanNwkBackpressureTest::Repair, this));
+
+    Ptr<RitWpanNetDevice> sender = devices[1];
+    Simulator::ScheduleWithContext(sender->GetNode()->GetId(),
+                                   Seconds(0.5),
+                                   &RitSimpleRouting::Bootstrap,
+                                   sender->GetNwk());
+    Simulator::ScheduleWithContext(sender->GetNode()->GetId(), Seconds(8.0), [=]() {
+        sender->Send(Create<Packet>(20), Mac16Address("00:00"), 0);
+    });
+    // The sink has room again; the rank update advertises it.
+    Ptr<RitWpanNetDevice> sink = devices[0];
+    Simulator::ScheduleWithContext(sink->GetNode()->GetId(), Seconds(12.0), [=]() {
+        sink->GetNwk()->SetAttribute("AnycastQueueCapacity", UintegerValue(8));
+        sink->SetRitRank(0);
+    });
+
+    Simulator::Stop(Seconds(20.0));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_GT(m_nBackpressure, 0, "No beacon left unanswered");
+    NS_TEST_ASSERT_MSG_EQ(m_rxTimes.size(), 1, "Packet not delivered at the sink");
+    NS_TEST_EXPECT_MSG_GT(m_rxTimes[0], Seconds(12.0), "Packet sent to a full parent");
+    NS_TEST_EXPECT_MSG_EQ(m_nRepairs, 0, "Congested parent taken for a link failure");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @brief Check that routers started without a rank take rank 1 from the beacons of the
+ * sink, and send to it once their RIT cycle is back.
+ */
+class RitWpanNwkBootstrapTest : public TestCase
+{
+  public:
+    RitWpanNwkBootstrapTest();
+
+  private:
+    /**
+     * @brief Count the packets delivered at the sink.
+     * @param dev The device
+     * @param pkt The packet
+     * @param proto The protocol number
+     * @param addr The source address
+     * @return true
+     */
+    bool DataIndication(Ptr<NetDevice> dev,
+                        Ptr<const Packet> pkt,
+                        uint16_t proto,
+                        const Address& addr);
+
+    /**
+     * @brief Record the end of a bootstrap.
+     * @param rank Rank taken
+     * @param parent Parent chosen
+     * @param elapsed Duration of the bootstrap
+     */
+    void Bootstrapped(uint16_t rank, Mac16Address parent, Time elapsed);
+
+    void DoRun() override;
+
+    uint32_t m_nSinkRx{0};               //!< Packets delivered at the sink
+    std::vector<uint16_t> m_ranks;       //!< Ranks taken
+    std::vector<Mac16Address> m_parents; //!< Parents chosen
+    Time m_longest;                      //!< Longest bootstrap
+};
+
+RitWpanNwkBootstrapTest::RitWpanNwkBootstrapTest()
+    : TestCase("RitSimpleRouting bootstrap of the rank from the sink beacons")
+{
+}
+
+bool
+RitWpanNwkBootstrapTest::DataIndication(Ptr<NetDevice> dev,
+                                        Ptr<const Packet> pkt,
+                                        uint16_t proto,
+                                        const Address& addr)
+{
+    m_nSinkRx++;
+    return true;
+}
+
+void
+RitWpanNwkBootstrapTest::Bootstrapped(uint16_t rank, Mac16Address parent, Time elapsed)
+{
+    m_ranks.push_back(rank);
+    m_parents.push_back(parent);
+    m_longest = std::max(m_longest, elapsed);
+}
+
+void
+RitWpanNwkBootstrapTest::DoRun()
+{
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    // Sink (rank 0) and two routers without a configured rank, all in range
+    std::vector<Ptr<RitWpanNetDevice>> devices;
+    Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+    pibAttr->macRitPeriodTime = Time(Seconds(1));
+    for (uint16_t i = 0; i < 3; i++)
+    {
+        Ptr<Node> node = CreateObject<Node>();
+        Ptr<RitWpanNetDevice> device = CreateObject<RitWpanNetDevice>();
+        device->SetChannel(channel);
+        device->SetAddress(Mac16Address(i));
+        node->AddDevice(device);
+        device->SetRitRank(0);
+        device->GetMac()->MlmeSetRequest(macRitPeriodTime, pibAttr);
+        devices.push_back(device);
+    }
+    devices[0]->SetReceiveCallback(MakeCallback(&RitWpanNwkBootstrapTest::DataIndication, this));
+
+    for (uint32_t i = 1; i < devices.size(); i++)
+    {
+        Ptr<RitSimpleRouting> nwk = devices[i]->GetNwk();
+        nwk->TraceConnectWithoutContext(
+            "NwkBootstrap",
+            MakeCallback(&RitWpanNwkBootstrapTest::Bootstrapped, this));
+        Simulator::ScheduleWithContext(devices[i]->GetNode()->GetId(),
+                                       Seconds(0.5),
+                                       &RitSimpleRouting::Bootstrap,
+                                       nwk);
+    }
+
+    Ptr<RitWpanNetDevice> sender = devices[2];
+    Simulator::ScheduleWithContext(sender->GetNode()->GetId(), Seconds(8.0), [=]() {
+        sender->Send(Create<Packet>(20), Mac16Address("00:00"), 0);
+    });
+
+    Simulator::Stop(Seconds(12.0));
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_ranks.size(), 2, "Both routers should finish their bootstrap");
+    for (uint32_t i = 0; i < m_ranks.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_ranks[i], 1, "Wrong rank after bootstrap");
+        NS_TEST_EXPECT_MSG_EQ(m_parents[i], Mac16Address("00:00"), "Wrong parent");
+    }
+    NS_TEST_EXPECT_MSG_EQ((m_longest <= Seconds(2)), true, "Sink beacon missed in two periods");
+    NS_TEST_EXPECT_MSG_EQ(devices[1]->GetRitRank(), 1, "Device rank not updated");
+    NS_TEST_EXPECT_MSG_EQ(m_nSinkRx, 1, "Packet not delivered after the bootstrap");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @brief Check the serialization of the route option and of its address list.
+ */
+class RitRouteHeaderTest : public TestCase
+{
+  public:
+    RitRouteHeaderTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitRouteHeaderTest::RitRouteHeaderTest()
+    : TestCase("RitRouteHeader and route option round trip")
+{
+}
+
+void
+RitRouteHeaderTest::DoRun()
+{
+    RitRouteHeader route;
+    route.AddAddress(Mac16Address("00:03"));
+    route.AddAddress(Mac16Address("00:07"));
+    route.SetIndex(1);
+    NS_TEST_EXPECT_MSG_EQ(route.GetSerializedSize(), 5, "Wrong header size");
+
+    RitNwkHeader nwkHdr;
+    nwkHdr.SetRank(RitNwkHeader::MAX_RANK);
+    nwkHdr.SetPriority(RitNwkHeader::MAX_PRIORITY);
+    nwkHdr.SetOption(RitNwkHeader::OPTION_SOURCE_ROUTE);
+    nwkHdr.SetSrcAddr(Mac16Address("00:00"));
+    nwkHdr.SetDstAddr(Mac16Address("00:09"));
+
+    Ptr<Packet> p = Create<Packet>(10);
+    p->AddHeader(route);
+    p->AddHeader(nwkHdr);
+    RitNwkHeader rxNwk;
+    p->RemoveHeader(rxNwk);
+    NS_TEST_EXPECT_MSG_EQ(rxNwk.GetRank(), RitNwkHeader::MAX_RANK, "Rank not kept");
+    NS_TEST_EXPECT_MSG_EQ(rxNwk.GetPriority(), RitNwkHeader::MAX_PRIORITY, "Priority not kept");
+    NS_TEST_EXPECT_MSG_EQ(rxNwk.GetOption(), RitNwkHeader::OPTION_SOURCE_ROUTE, "Option not kept");
+    RitRouteHeader rx;
+    p->RemoveHeader(rx);
+    NS_TEST_ASSERT_MSG_EQ(rx.GetNAddresses(), 2, "Wrong number of addresses");
+    NS_TEST_EXPECT_MSG_EQ(rx.GetAddress(0), Mac16Address("00:03"), "Wrong address");
+    NS_TEST_EXPECT_MSG_EQ(rx.GetAddress(1), Mac16Address("00:07"), "Wrong address");
+    NS_TEST_EXPECT_MSG_EQ(rx.GetIndex(), 1, "Wrong index");
+    NS_TEST_EXPECT_MSG_EQ(p->GetSize(), 10, "Payload changed");
+}
+
+/**
+ * @brief Check the compressed RitNwkHeader: elided sink, broadcast and source,
+ * the rank escape, and the decoding of both formats by the same receiver.
+ */
+class RitNwkHeaderCompressionTest : public TestCase
+{
+  public:
+    RitNwkHeaderCompressionTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Serialize a header and decode it back.
+     * @param hdr The header to send
+     * @return the decoded header
+     */
+    RitNwkHeader RoundTrip(const RitNwkHeader& hdr);
+};
+
+RitNwkHeaderCompressionTest::RitNwkHeaderCompressionTest()
+    : TestCase("RitNwkHeader compressed format round trip")
+{
+}
+
+RitNwkHeader
+RitNwkHeaderCompressionTest::RoundTrip(const RitNwkHeader& hdr)
+{
+    Ptr<Packet> p = Create<Packet>(10);
+    p->AddHeader(hdr);
+    NS_TEST_EXPECT_MSG_EQ(p->GetSize(), 10 + hdr.GetSerializedSize(), "Wrong serialized size");
+    RitNwkHeader rx;
+    NS_TEST_EXPECT_MSG_EQ(p->RemoveHeader(rx), hdr.GetSerializedSize(), "Wrong decoded size");
+    NS_TEST_EXPECT_MSG_EQ(p->GetSize(), 10, "Payload changed");
+    return rx;
+}
+
+void
+RitNwkHeaderCompressionTest::DoRun()
+{
+    // Uplink to any sink from the MAC source: the dispatch word only
+    RitNwkHeader up;
+    up.SetRank(3);
+    up.SetPriority(1);
+    up.SetOption(RitNwkHeader::OPTION_ROUTE_REPORT);
+    up.SetSrcAddr(Mac16Address("00:05"));
+    up.SetDstAddr(Mac16Address(RitNwkHeader::ANY_SINK_ADDR));
+    up.SetCompressed(true);
+    up.SetSrcAddrElided(true);
+    NS_TEST_EXPECT_MSG_EQ(up.GetSerializedSize(), 2, "Uplink header not compressed");
+    RitNwkHeader rx = RoundTrip(up);
+    NS_TEST_EXPECT_MSG_EQ(rx.IsCompressed(), true, "Format not detected");
+    NS_TEST_EXPECT_MSG_EQ(rx.IsSrcAddrElided(), true, "Elision not detected");
+    NS_TEST_EXPECT_MSG_EQ(rx.GetRank(), 3, "Rank not kept");
+    NS_TEST_EXPECT_MSG_EQ(+rx.GetPriority(), 1, "Priority not kept");
+    NS_TEST_EXPECT_MSG_EQ(rx.GetOption(), RitNwkHeader::OPTION_ROUTE_REPORT, "Option not kept");
+    NS_TEST_EXPECT_MSG_EQ(rx.GetDstAddr(),
+                          Mac16Address(RitNwkHeader::ANY_SINK_ADDR),
+                          "Sink destination not restored");
+
+    // Forwarded broadcast, source inline
+    RitNwkHeader bcast = up;
+    bcast.SetSrcAddrElided(false);
+    bcast.SetDstAddr(Mac16Address::GetBroadcast());
+    NS_TEST_EXPECT_MSG_EQ(bcast.GetSerializedSize(), 4, "Broadcast header size");
+    rx = RoundTrip(bcast);
+    NS_TEST_EXPECT_MSG_EQ(rx.GetSrcAddr(), Mac16Address("00:05"), "Source not kept");
+    NS_TEST_EXPECT_MSG_EQ(rx.GetDstAddr().IsBroadcast(), true, "Broadcast not restored");
+
+    // Unicast destination and a rank past the inline code
+    RitNwkHeader down = bcast;
+    down.SetRank(RitNwkHeader::MAX_RANK);
+    down.SetDstAddr(Mac16Address("00:09"));
+    NS_TEST_EXPECT_MSG_EQ(down.GetSerializedSize(), 8, "Unicast header size");
+    rx = RoundTrip(down);
+    NS_TEST_EXPECT_MSG_EQ(rx.GetRank(), RitNwkHeader::MAX_RANK, "Escaped rank not kept");
+    NS_TEST_EXPECT_MSG_EQ(rx.GetSrcAddr(), Mac16Address("00:05"), "Source not kept");
+    NS_TEST_EXPECT_MSG_EQ(rx.GetDstAddr(), Mac16Address("00:09"), "Destination not kept");
+
+    down.SetRank(126);
+    NS_TEST_EXPECT_MSG_EQ(down.GetSerializedSize(), 6, "Largest inline rank escaped");
+    NS_TEST_EXPECT_MSG_EQ(RoundTrip(down).GetRank(), 126, "Largest inline rank not kept");
+
+    // The uncompressed format is still decoded, whatever the receiver last saw
+    RitNwkHeader plain = down;
+    plain.SetCompressed(false);
+    plain.SetSrcAddrElided(false);
+    NS_TEST_EXPECT_MSG_EQ(plain.GetSerializedSize(), 6, "Uncompressed header size");
+    rx = RoundTrip(plain);
+    NS_TEST_EXPECT_MSG_EQ(rx.IsCompressed(), false, "Uncompressed header seen as compressed");
+    NS_TEST_EXPECT_MSG_EQ(rx.GetRank(), 126, "Rank not kept");
+    NS_TEST_EXPECT_MSG_EQ(rx.GetDstAddr(), Mac16Address("00:09"), "Destination not kept");
+}
+
+/**
+ * @brief Check that the sink learns the parent of a router from its uplink packets and
+ * sends it a packet back, and drops packets toward an unknown node.
+ */
+class RitWpanNwkDownlinkTest : public TestCase
+{
+  public:
+    RitWpanNwkDownlinkTest();
+
+  private:
+    /**
+     * @brief Count the packets delivered at the router.
+     * @param dev The device
+     * @param pkt The packet
+     * @param proto The protocol number
+     * @param addr The source address
+     * @return true
+     */
+    bool DataIndication(Ptr<NetDevice> dev,
+                        Ptr<const Packet> pkt,
+                        uint16_t proto,
+                        const Address& addr);
+
+    /**
+     * @brief Record a source-routed packet delivered.
+     * @param p The packet
+     * @param latency Time since the sink sent it
+     * @param hops Length of its route
+     */
+    void DownlinkRx(Ptr<const Packet> p, Time latency, uint8_t hops);
+
+    void DoRun() override;
+
+    uint32_t m_nRouterRx{0};     //!< Packets delivered at the router
+    std::vector<uint8_t> m_hops; //!< Route lengths of the downlink packets
+    Time m_latency;              //!< Latency of the last downlink packet
+    bool m_unknownSent{true};    //!< Whether the packet toward an unknown node was accepted
+};
+
+RitWpanNwkDownlinkTest::RitWpanNwkDownlinkTest()
+    : TestCase("RitSimpleRouting source-routed downlink from the sink")
+{
+}
+
+bool
+RitWpanNwkDownlinkTest::DataIndication(Ptr<NetDevice> dev,
+                                       Ptr<const Packet> pkt,
+                                       uint16_t proto,
+                                       const Address& addr)
+{
+    m_nRouterRx++;
+    return true;
+}
+
+void
+RitWpanNwkDownlinkTest::DownlinkRx(Ptr<const Packet> p, Time latency, uint8_t hops)
+{
+    m_hops.push_back(hops);
+    m_latency = latency;
+}
+
+void
+RitWpanNwkDownlinkTest::DoRun()
+{
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    // Sink (rank 0) and one router (rank 1)
+    std::vector<Ptr<RitWpanNetDevice>> devices;
+    Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+    pibAttr->macRitPeriodTime = Time(Seconds(1));
+    for (uint16_t rank = 0; rank < 2; rank++)
+    {
+        Ptr<Node> node = CreateObject<Node>();
+        Ptr<RitWpanNetDevice> device = CreateObject<RitWpanNetDevice>();
+        device->SetChannel(channel);
+        device->SetAddress(Mac16Address(rank));
+        device->GetNwk()->SetAttribute("DownlinkEnabled", BooleanValue(true));
+        node->AddDevice(device);
+        device->SetRitRank(rank);
+        device->GetMac()->MlmeSetRequest(macRitPeriodTime, pibAttr);
+        devices.push_back(device);
+    }
+    Ptr<RitWpanNetDevice> sink = devices[0];
+    Ptr<RitWpanNetDevice> router = devices[1];
+    router->SetReceiveCallback(MakeCallback(&RitWpanNwkDownlinkTest::DataIndication, this));
+    router->GetNwk()->TraceConnectWithoutContext(
+        "NwkDownlinkRx",
+        MakeCallback(&RitWpanNwkDownlinkTest::DownlinkRx, this));
+
+    // The first packet finds the parent, the second one reports it.
+    for (double t : {4.0, 8.0})
+    {
+        Simulator::ScheduleWithContext(router->GetNode()->GetId(), Seconds(t), [=]() {
+            router->Send(Create<Packet>(20), Mac16Address("00:00"), 0);
+        });
+    }
+    Simulator::ScheduleWithContext(sink->GetNode()->GetId(), Seconds(12.0), [=]() {
+        Ptr<Packet> p = Create<Packet>(20);
+        p->AddPacketTag(RitTimestampTag(Simulator::Now()));
+        sink->Send(p, Mac16Address("00:01"), 0);
+        m_unknownSent = sink->Send(Create<Packet>(20), Mac16Address("00:05"), 0);
+    });
+
+    Simulator::Stop(Seconds(16.0));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_unknownSent, false, "Packet accepted without a route");
+    NS_TEST_EXPECT_MSG_EQ(m_nRouterRx, 1, "Downlink packet not delivered");
+    NS_TEST_ASSERT_MSG_EQ(m_hops.size(), 1, "Downlink delivery not traced");
+    NS_TEST_EXPECT_MSG_EQ(m_hops[0], 1, "Wrong route length");
+    NS_TEST_EXPECT_MSG_EQ((m_latency > Time() && m_latency <= Seconds(2)),
+                          true,
+                          "Downlink packet not sent at the next router beacon");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @brief Post-reception error model losing the first ACK frame, so that the MAC confirms
+ *        NO_ACK for a frame the receiver has.
+ */
+class RitNwkRetryAckLossErrorModel : public ErrorModel
+{
+  private:
+    bool DoCorrupt(Ptr<Packet> p) override
+    {
+        LrWpanMacHeader macHdr;
+        p->PeekHeader(macHdr);
+        if (macHdr.IsAcknowledgment() && !m_lost)
+        {
+            m_lost = true;
+            return true;
+        }
+        return false;
+    }
+
+    void DoReset() override
+    {
+    }
+
+    bool m_lost{false}; //!< Whether the ACK was lost
+};
+
+/**
+ * @brief Check that a NO_ACK confirm is retried after a delay within RetryMaxDelay, and that
+ *        the retry succeeds with header compression on.
+ */
+class RitWpanNwkRetryTest : public TestCase
+{
+  public:
+    RitWpanNwkRetryTest();
+
+  private:
+    /**
+     * @brief Count the packets delivered at the sink.
+     * @param dev The device
+     * @param pkt The packet
+     * @param proto The protocol number
+     * @param addr The source address
+     * @return true
+     */
+    bool DataIndication(Ptr<NetDevice> dev,
+                        Ptr<const Packet> pkt,
+                        uint16_t proto,
+                        const Address& addr);
+
+    /**
+     * @brief Record a retransmission scheduled by the router.
+     * @param p The packet
+     * @param attempt Retransmission number
+     * @param delay Delay before the retry
+     */
+    void ReTxBackoff(Ptr<const Packet> p, uint8_t attempt, Time delay);
+
+    /**
+     * @brief Record a packet confirmed with SUCCESS at the router.
+     * @param p The packet
+     */
+    void NwkTxOk(Ptr<const Packet> p);
+
+    /**
+     * @brief Record the NWK header format of a data frame sent by the router.
+     * @param p The frame
+     */
+    void PhyTxBegin(Ptr<const Packet> p);
+
+    /**
+     * @brief Record the transmit table occupancy of the router.
+     * @param oldValue Slots in use before
+     * @param newValue Slots in use now
+     */
+    void TxTableOccupancy(uint32_t oldValue, uint32_t newValue);
+
+    void DoRun() override;
+
+    uint32_t m_nSinkRx{0};           //!< Packets delivered at the sink
+    std::vector<uint8_t> m_attempts; //!< Retransmission numbers
+    Time m_retryDelay;               //!< Delay of the last retry
+    Time m_retryScheduled;           //!< Time the last retry was scheduled
+    std::vector<Time> m_txOk;        //!< Times of the SUCCESS confirms
+    uint32_t m_nDataTx{0};           //!< Data frames sent by the router
+    uint32_t m_nCompressedTx{0};     //!< Of which with a compressed NWK header
+    std::vector<uint32_t> m_slots;   //!< Transmit table occupancy after each change
+};
+
+RitWpanNwkRetryTest::RitWpanNwkRetryTest()
+    : TestCase("RitSimpleRouting NO_ACK, delayed retry and success with header compression")
+{
+}
+
+bool
+RitWpanNwkRetryTest::DataIndication(Ptr<NetDevice> dev,
+                                    Ptr<const Packet> pkt,
+                                    uint16_t proto,
+                                    const Address& addr)
+{
+    m_nSinkRx++;
+    return true;
+}
+
+void
+RitWpanNwkRetryTest::ReTxBackoff(Ptr<const Packet> p, uint8_t attempt, Time delay)
+{
+    m_attempts.push_back(attempt);
+    m_retryDelay = delay;
+    m_retryScheduled = Simulator::Now();
+}
+
+void
+RitWpanNwkRetryTest::NwkTxOk(Ptr<const Packet> p)
+{
+    m_txOk.push_back(Simulator::Now());
+}
+
+void
+RitWpanNwkRetryTest::PhyTxBegin(Ptr<const Packet> p)
+{
+    Ptr<Packet> frame = p->Copy();
+    LrWpanMacHeader macHdr;
+    frame->RemoveHeader(macHdr);
+    if (!macHdr.IsData())
+    {
+        return;
+    }
+    RitNwkHeader nwkHdr;
+    frame->PeekHeader(nwkHdr);
+    m_nDataTx++;
+    m_nCompressedTx += nwkHdr.IsCompressed() ? 1 : 0;
+}
+
+void
+RitWpanNwkRetryTest::TxTableOccupancy(uint32_t oldValue, uint32_t newValue)
+{
+    m_slots.push_back(newValue);
+}
+
+void
+RitWpanNwkRetryTest::DoRun()
+{
+    const Time retryMaxDelay = Seconds(2);
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    // Sink (rank 0) and one router (rank 1)
+    std::vector<Ptr<RitWpanNetDevice>> devices;
+    Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+    pibAttr->macRitPeriodTime = Time(Seconds(1));
+    for (uint16_t rank = 0; rank < 2; rank++)
+    {
+        Ptr<Node> node = CreateObject<Node>();
+        Ptr<RitWpanNetDevice> device = CreateObject<RitWpanNetDevice>();
+        device->SetChannel(channel);
+        device->SetAddress(Mac16Address(rank));
+        device->GetNwk()->SetAttribute("HeaderCompression", BooleanValue(true));
+        device->GetNwk()->SetAttribute("MaxRetries", UintegerValue(1));
+        device->GetNwk()->SetAttribute("RetryMaxDelay", TimeValue(retryMaxDelay));
+        node->AddDevice(device);
+        device->SetRitRank(rank);
+        device->GetMac()->MlmeSetRequest(macRitPeriodTime, pibAttr);
+        devices.push_back(device);
+    }
+    Ptr<RitWpanNetDevice> sink = devices[0];
+    Ptr<RitWpanNetDevice> router = devices[1];
+    sink->SetReceiveCallback(MakeCallback(&RitWpanNwkRetryTest::DataIndication, this));
+    router->GetPhy()->SetPostReceptionErrorModel(CreateObject<RitNwkRetryAckLossErrorModel>());
+    router->GetNwk()->TraceConnectWithoutContext(
+        "NwkReTxBackoff",
+        MakeCallback(&RitWpanNwkRetryTest::ReTxBackoff, this));
+    router->GetNwk()->TraceConnectWithoutContext(
+        "NwkTxOk",
+        MakeCallback(&RitWpanNwkRetryTest::NwkTxOk, this));
+    router->GetPhy()->TraceConnectWithoutContext(
+        "PhyTxBegin",
+        MakeCallback(&RitWpanNwkRetryTest::PhyTxBegin, this));
+    router->GetNwk()->TraceConnectWithoutContext(
+        "TxTableOccupancy",
+        MakeCallback(&RitWpanNwkRetryTest::TxTableOccupancy, this));
+
+    Simulator::ScheduleWithContext(router->GetNode()->GetId(), Seconds(8.0), [=]() {
+        router->Send(Create<Packet>(20), Mac16Address("00:00"), 0);
+    });
+
+    Simulator::Stop(Seconds(20.0));
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_attempts.size(), 1, "NO_ACK not retried exactly once");
+    NS_TEST_EXPECT_MSG_EQ(m_attempts[0], 1, "Wrong retransmission number");
+    NS_TEST_EXPECT_MSG_EQ((m_retryDelay >= Time() && m_retryDelay <= retryMaxDelay),
+                          true,
+                          "Retry delay " << m_retryDelay << " beyond RetryMaxDelay");
+    NS_TEST_ASSERT_MSG_EQ(m_txOk.size(), 1, "Retry not confirmed with SUCCESS");
+    NS_TEST_EXPECT_MSG_EQ((m_txOk[0] >= m_retryScheduled + m_retryDelay),
+                          true,
+                          "Retry sent before its delay elapsed");
+    // Without DuplicateDetection the sink keeps both copies: the first one lost its ACK only.
+    NS_TEST_EXPECT_MSG_EQ(m_nSinkRx, 2, "Packet or its retry not delivered");
+    NS_TEST_EXPECT_MSG_EQ(m_nDataTx, 2, "Router did not send the packet and its retry");
+    NS_TEST_EXPECT_MSG_EQ(m_nCompressedTx, m_nDataTx, "Data frame sent uncompressed");
+    // The slot of the packet is held across the retry and released at its final confirm.
+    const std::vector<uint32_t> slots{1, 0};
+    NS_TEST_EXPECT_MSG_EQ((m_slots == slots), true, "Transmit table slot not held or not freed");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @brief Check that packets sent to any sink are delivered by one of two sinks.
+ */
+class RitWpanNwkAnySinkTest : public TestCase
+{
+  public:
+    RitWpanNwkAnySinkTest();
+
+  private:
+    /**
+     * @brief Count the packets delivered at the sinks.
+     * @param dev The device
+     * @param pkt The packet
+     * @param proto The protocol number
+     * @param addr The source address
+     * @return true
+     */
+    bool DataIndication(Ptr<NetDevice> dev,
+                        Ptr<const Packet> pkt,
+                        uint16_t proto,
+                        const Address& addr);
+
+    void DoRun() override;
+
+    uint32_t m_nSinkRx{0}; //!< Packets delivered at either sink
+};
+
+RitWpanNwkAnySinkTest::RitWpanNwkAnySinkTest()
+    : TestCase("RitSimpleRouting delivery to any of several sinks")
+{
+}
+
+bool
+RitWpanNwkAnySinkTest::DataIndication(Ptr<NetDevice> dev,
+                                      Ptr<const Packet> pkt,
+                                      uint16_t proto,
+                                      const Address& addr)
+{
+    m_nSinkRx++;
+    return true;
+}
+
+void
+RitWpanNwkAnySinkTest::DoRun()
+{
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    // Two sinks (rank 0) and one router (rank 1)
+    std::vector<Ptr<RitWpanNetDevice>> devices;
+    Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+    pibAttr->macRitPeriodTime = Time(Seconds(1));
+    for (uint16_t i = 0; i < 3; i++)
+    {
+        Ptr<Node> node = CreateObject<Node>();
+        Ptr<RitWpanNetDevice> device = CreateObject<RitWpanNetDevice>();
+        device->SetChannel(channel);
+        device->SetAddress(Mac16Address(i));
+        node->AddDevice(device);
+        device->SetRitRank(i < 2 ? 0 : 1);
+        device->GetMac()->MlmeSetRequest(macRitPeriodTime, pibAttr);
+        devices.push_back(device);
+    }
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        devices[i]->SetReceiveCallback(
+            MakeCallback(&RitWpanNwkAnySinkTest::DataIndication, this));
+    }
+
+    Ptr<RitWpanNetDevice> sender = devices[2];
+    for (double t : {4.0, 8.0})
+    {
+        Simulator::ScheduleWithContext(sender->GetNode()->GetId(), Seconds(t), [=]() {
+            sender->Send(Create<Packet>(20), RitSimpleRouting::GetAnySinkAddress(), 0);
+        });
+    }
+
+    Simulator::Stop(Seconds(12.0));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_nSinkRx, 2, "Packets to any sink not delivered");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @brief Check the RitBroadcastHeader round trip.
+ */
+class RitBroadcastHeaderTest : public TestCase
+{
+  public:
+    RitBroadcastHeaderTest();
+
+  private:
+    void DoRun() override;
+};
+
+RitBroadcastHeaderTest::RitBroadcastHeaderTest()
+    : TestCase("RitBroadcastHeader round trip")
+{
+}
+
+void
+RitBroadcastHeaderTest::DoRun()
+{
+    RitBroadcastHeader hdr;
+    hdr.SetOrigin(Mac16Address("00:05"));
+    hdr.SetSequence(65535);
+    hdr.SetHops(3);
+    NS_TEST_EXPECT_MSG_EQ(hdr.GetSerializedSize(), 5, "Wrong header size");
+
+    Ptr<Packet> p = Create<Packet>(10);
+    p->AddHeader(hdr);
+    RitBroadcastHeader rx;
+    p->RemoveHeader(rx);
+    NS_TEST_EXPECT_MSG_EQ(rx.GetOrigin(), Mac16Address("00:05"), "Origin not kept");
+    NS_TEST_EXPECT_MSG_EQ(rx.GetSequence(), 65535, "Sequence number not kept");
+    NS_TEST_EXPECT_MSG_EQ(+rx.GetHops(), 3, "Hops not kept");
+    NS_TEST_EXPECT_MSG_EQ(p->GetSize(), 10, "Payload changed");
+}
+
+/**
+ * @brief Check the network-wide broadcast: a broadcast of the sink reaches every
+ * router once, whatever the forwards, and never comes back to its origin.
+ */
+class RitWpanNwkBroadcastTest : public TestCase
+{
+  public:
+    RitWpanNwkBroadcastTest();
+
+  private:
+    /**
+     * @brief Count the packets delivered per node.
+     * @param dev The device
+     * @param pkt The packet
+     * @param proto The protocol number
+     * @param addr The source address
+     * @return true
+     */
+    bool DataIndication(Ptr<NetDevice> dev,
+                        Ptr<const Packet> pkt,
+                        uint16_t proto,
+                        const Address& addr);
+
+    void DoRun() override;
+
+    std::vector<uint32_t> m_nRx{0, 0, 0}; //!< Packets delivered, by short address
+};
+
+RitWpanNwkBroadcastTest::RitWpanNwkBroadcastTest()
+    : TestCase("RitSimpleRouting network-wide broadcast")
+{
+}
+
+bool
+RitWpanNwkBroadcastTest::DataIndication(Ptr<NetDevice> dev,
+                                        Ptr<const Packet> pkt,
+                                        uint16_t proto,
+                                        const Address& addr)
+{
+    m_nRx[Mac16Address::ConvertFrom(dev->GetAddress()).ConvertToInt()]++;
+    return true;
+}
+
+void
+RitWpanNwkBroadcastTest::DoRun()
+{
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    // One sink (rank 0) and two routers (rank 1)
+    std::vector<Ptr<RitWpanNetDevice>> devices;
+    Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+    pibAttr->macRitPeriodTime = Time(Seconds(1));
+    for (uint16_t i = 0; i < 3; i++)
+    {
+        Ptr<Node> node = CreateObject<Node>();
+        Ptr<RitWpanNetDevice> device = CreateObject<RitWpanNetDevice>();
+        device->SetChannel(channel);
+        device->SetAddress(Mac16Address(i));
+        node->AddDevice(device);
+        device->SetRitRank(i == 0 ? 0 : 1);
+        device->GetMac()->MlmeSetRequest(macRitPeriodTime, pibAttr);
+        device->SetReceiveCallback(MakeCallback(&RitWpanNwkBroadcastTest::DataIndication, this));
+        devices.push_back(device);
+    }
+
+    Ptr<RitWpanNetDevice> sink = devices[0];
+    Simulator::ScheduleWithContext(sink->GetNode()->GetId(), Seconds(4), [=]() {
+        sink->Send(Create<Packet>(20), Mac16Address::GetBroadcast(), 0);
+    });
+
+    Simulator::Stop(Seconds(12.0));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_nRx[0], 0, "Broadcast delivered back to its origin");
+    NS_TEST_EXPECT_MSG_EQ(m_nRx[1], 1, "Broadcast not delivered once to the first router");
+    NS_TEST_EXPECT_MSG_EQ(m_nRx[2], 1, "Broadcast not delivered once to the second router");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @brief Check that with EnergyBalancingEnabled a child leaves a low-battery relay for
+ * the other parent of the same rank, that the relay lengthens its RIT period, and that
+ * the metrics collector reports the death of its battery as the network lifetime.
+ */
+class RitWpanNwkEnergyBalancingTest : public TestCase
+{
+  public:
+    RitWpanNwkEnergyBalancingTest();
+
+  private:
+    /**
+     * @brief Count a packet received by a relay.
+     * @param relay Index of the relay
+     * @param p The packet
+     */
+    void RelayRx(uint32_t relay, Ptr<const Packet> p);
+
+    /**
+     * @brief Count the switch of a relay to the low-battery mode.
+     * @param residual Residual share of its battery
+     */
+    void LowEnergy(double residual);
+
+    void DoRun() override;
+
+    uint32_t m_nRelayRx[2] = {0, 0}; //!< Packets received by each relay
+    uint32_t m_nLowEnergy{0};        //!< Switches to the low-battery mode
+};
+
+RitWpanNwkEnergyBalancingTest::RitWpanNwkEnergyBalancingTest()
+    : TestCase("RitSimpleRouting energy balancing over equal-rank parents")
+{
+}
+
+void
+RitWpanNwkEnergyBalancingTest::RelayRx(uint32_t relay, Ptr<const Packet> p)
+{
+    m_nRelayRx[relay]++;
+}
+
+void
+RitWpanNwkEnergyBalancingTest::LowEnergy(double residual)
+{
+    NS_TEST_EXPECT_MSG_LT(residual, 0.5, "Low-battery mode above the threshold");
+    m_nLowEnergy++;
+}
+
+void
+RitWpanNwkEnergyBalancingTest::DoRun()
+{
+    const uint32_t nPackets = 10;
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    // Sink (rank 0), a mains-powered relay and a relay with a tiny battery (rank 1), and
+    // a child of both (rank 2), all in range
+    std::vector<Ptr<RitWpanNetDevice>> devices;
+    NodeContainer nodes;
+    Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+    pibAttr->macRitPeriodTime = Time(Seconds(1));
+    const uint16_t ranks[] = {0, 1, 1, 2};
+    for (uint16_t i = 0; i < 4; i++)
+    {
+        Ptr<Node> node = CreateObject<Node>();
+        Ptr<RitWpanNetDevice> device = CreateObject<RitWpanNetDevice>();
+        device->SetChannel(channel);
+        device->SetAddress(Mac16Address(i));
+        device->GetNwk()->SetAttribute("EnergyBalancingEnabled", BooleanValue(true));
+        device->GetNwk()->SetAttribute("EnergyCheckInterval", TimeValue(Seconds(1)));
+        if (i == 2)
+        {
+            device->GetNwk()->SetAttribute("LowEnergyThreshold", DoubleValue(0.5));
+            device->GetEnergyModel()->SetAttribute("InitialEnergy", DoubleValue(0.005));
+            device->GetEnergyModel()->SetAttribute("UpdateInterval", TimeValue(Seconds(1)));
+        }
+        node->AddDevice(device);
+        device->SetRitRank(ranks[i]);
+        device->GetMac()->MlmeSetRequest(macRitPeriodTime, pibAttr);
+        devices.push_back(device);
+        nodes.Add(node);
+    }
+    for (uint32_t relay = 0; relay < 2; relay++)
+    {
+        devices[1 + relay]->GetNwk()->TraceConnectWithoutContext(
+            "NwkRx",
+            Callback<void, Ptr<const Packet>>(
+                [this, relay](Ptr<const Packet> p) { RelayRx(relay, p); }));
+    }
+    devices[2]->GetNwk()->TraceConnectWithoutContext(
+        "NwkLowEnergy",
+        MakeCallback(&RitWpanNwkEnergyBalancingTest::LowEnergy, this));
+    Ptr<RitMetricsCollector> collector = Create<RitMetricsCollector>();
+    for (uint32_t i = 0; i < nodes.GetN(); i++)
+    {
+        collector->Install(nodes.Get(i));
+    }
+
+    // The battery relay is below its threshold within a few DWDs of listening.
+    Ptr<RitWpanNetDevice> child = devices[3];
+    for (uint32_t k = 0; k < nPackets; k++)
+    {
+        Simulator::ScheduleWithContext(child->GetNode()->GetId(), Seconds(20 + 2 * k), [=]() {
+            child->Send(Create<Packet>(20), Mac16Address("00:00"), 0);
+        });
+    }
+
+    Simulator::Stop(Seconds(45.0));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_nLowEnergy, 1, "Battery relay not in the low-battery mode once");
+    NS_TEST_EXPECT_MSG_EQ(devices[2]->GetNwk()->IsLowEnergy(), true, "Low-battery mode left");
+    NS_TEST_EXPECT_MSG_EQ(devices[2]->GetNwk()->GetEnergyLevel(), 0, "Low battery advertised");
+    NS_TEST_EXPECT_MSG_EQ(devices[2]->GetMac()->GetRitPeriodTime(),
+                          Seconds(2),
+                          "RIT period of the low-battery relay not doubled");
+    NS_TEST_EXPECT_MSG_EQ(devices[1]->GetNwk()->GetEnergyLevel(), 255, "Mains relay level");
+    NS_TEST_EXPECT_MSG_GT(m_nRelayRx[0], 0, "Nothing relayed by the mains-powered relay");
+    NS_TEST_EXPECT_MSG_EQ(m_nRelayRx[1], 0, "Packet sent through the low-battery relay");
+
+    NS_TEST_EXPECT_MSG_LT(collector->GetFirstDeathTime(), Seconds(45), "Death not reported");
+    NS_TEST_EXPECT_MSG_EQ(collector->GetLifetime(0.25),
+                          collector->GetFirstDeathTime(),
+                          "First quarter of 4 nodes is the first death");
+    NS_TEST_EXPECT_MSG_EQ(collector->GetLifetime(0.5), Time::Max(), "Second death reported");
+
+    Simulator::Destroy();
+}
+
+class RitWpanNwkTestSuite : public TestSuite
+{
+  public:
+    RitWpanNwkTestSuite();
+};
+
+RitWpanNwkTestSuite::RitWpanNwkTestSuite()
+    : TestSuite("rit-wpan-nwk", Type::UNIT)
+{
+    AddTestCase(new RitAggregationHeaderTest, Duration::QUICK);
+    AddTestCase(new RitWpanNwkAggregationTest, Duration::QUICK);
+    AddTestCase(new RitWpanNwkAnycastTest, Duration::QUICK);
+    AddTestCase(new RitWpanNwkBackpressureTest, Duration::QUICK);
+    AddTestCase(new RitWpanNwkBootstrapTest, Duration::QUICK);
+    AddTestCase(new RitRouteHeaderTest, Duration::QUICK);
+    AddTestCase(new RitNwkHeaderCompressionTest, Duration::QUICK);
+    AddTestCase(new RitWpanNwkDownlinkTest, Duration::QUICK);
+    AddTestCase(new RitWpanNwkRetryTest, Duration::QUICK);
+    AddTestCase(new RitWpanNwkAnySinkTest, Duration::QUICK);
+    AddTestCase(new RitBroadcastHeaderTest, Duration::QUICK);
+    AddTestCase(new RitWpanNwkBroadcastTest, Duration::QUICK);
+    AddTestCase(new RitWpanNwkEnergyBalancingTest, Duration::QUICK);
+}
+
+static RitWpanNwkTestSuite g_ritWpanNwkTestSuite;
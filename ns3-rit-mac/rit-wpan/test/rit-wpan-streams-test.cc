@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2025 Kanazawa Institute of Technology, Japan
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Authors:
+ *  Tomoya Murata <c1039548@st.kanazawa-it.ac.jp>
+ */
+
+#include <ns3/core-module.h>
+#include <ns3/log.h>
+#include <ns3/network-module.h>
+#include <ns3/periodic-sender-helper.h>
+#include <ns3/periodic-sender.h>
+#include <ns3/rit-wpan-helper.h>
+#include <ns3/rit-wpan-net-device.h>
+#include <ns3/test.h>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::lrwpan;
+
+NS_LOG_COMPONENT_DEFINE("rit-wpan-streams-test");
+
+/**
+ * @brief Check that AssignStreams() makes a run independent of the order in which
+ *        the nodes are created and installed.
+ *
+ * The same network (a sink and three routers sending periodically) is built twice,
+ * the second time with the nodes in the reverse order, so that every random
+ * variable gets another automatic stream. With the streams assigned by short
+ * address, the initial delays and the reception times at the sink must be equal.
+ * A third run installs the devices with RitWpanNetHelper::InstallBulk(), whose
+ * shared objects must not change the results either.
+ */
+class RitWpanStreamsInstallOrderTest : public TestCase
+{
+  public:
+    RitWpanStreamsInstallOrderTest();
+
+  private:
+    /**
+     * @brief Record a packet delivered at the sink.
+     * @param dev The device
+     * @param pkt The packet
+     * @param proto The protocol number
+     * @param addr The source address
+     * @return true
+     */
+    bool DataIndication(Ptr<NetDevice> dev,
+                        Ptr<const Packet> pkt,
+                        uint16_t proto,
+                        const Address& addr);
+
+    /**
+     * @brief Build and run the network.
+     * @param reversed Create and install the nodes in the reverse order
+     * @param bulk Install the devices with InstallBulk()
+     */
+    void RunNetwork(bool reversed, bool bulk);
+
+    void DoRun() override;
+
+    static constexpr uint16_t N_NODES = 4; //!< Sink (00:00) and three routers
+
+    std::vector<std::pair<uint16_t, int64_t>> m_sinkRx; //!< Source and time (ns) at the sink
+    std::vector<int64_t> m_initialDelays;               //!< Initial delay (ns) by address
+    int64_t m_deviceSpan{0};                            //!< Streams spanned by the devices
+    RitInstallReport m_installReport;                   //!< Cost of the install
+};
+
+RitWpanStreamsInstallOrderTest::RitWpanStreamsInstallOrderTest()
+    : TestCase("AssignStreams results independent of the install order")
+{
+}
+
+bool
+RitWpanStreamsInstallOrderTest::DataIndication(Ptr<NetDevice> dev,
+                                               Ptr<const Packet> pkt,
+                                               uint16_t proto,
+                                               const Address& addr)
+{
+    m_sinkRx.emplace_back(Mac16Address::ConvertFrom(addr).ConvertToInt(),
+                          Simulator::Now().GetNanoSeconds());
+    return true;
+}
+
+void
+RitWpanStreamsInstallOrderTest::RunNetwork(bool reversed, bool bulk)
+{
+    m_sinkRx.clear();
+    m_initialDelays.assign(N_NODES, 0);
+
+    NodeContainer created;
+    created.Create(N_NODES);
+    std::vector<uint16_t> addrs;
+    NodeContainer nodes;
+    NodeContainer routers;
+    for (uint16_t i = 0; i < N_NODES; i++)
+    {
+        const uint16_t addr = reversed ? N_NODES - 1 - i : i;
+        addrs.push_back(addr);
+        nodes.Add(created.Get(i));
+        if (addr != 0)
+        {
+            routers.Add(created.Get(i));
+        }
+    }
+
+    RitWpanNetHelper helper;
+    helper.SetMacRitPeriod(Seconds(1));
+    helper.SetMacRitDataWaitDuration(MilliSeconds(10));
+    helper.SetMacRitTxWaitDuration(Seconds(5));
+    NetDeviceContainer devices = bulk ? helper.InstallBulk(nodes) : helper.Install(nodes);
+    m_installReport = helper.GetInstallReport();
+    for (uint32_t i = 0; i < devices.GetN(); i++)
+    {
+        Ptr<RitWpanNetDevice> dev = DynamicCast<RitWpanNetDevice>(devices.Get(i));
+        dev->SetAddress(Mac16Address(addrs[i]));
+        dev->SetRitRank(addrs[i] == 0 ? 0 : 1);
+    }
+
+    PeriodicSenderHelper app;
+    app.SetPeriod(Seconds(10));
+    app.SetPacketSize(20);
+    app.SetDstAddr(Mac16Address("00:00"));
+    ApplicationContainer apps = app.Install(routers);
+
+    for (uint32_t i = 0; i < devices.GetN(); i++)
+    {
+        if (addrs[i] == 0)
+        {
+            devices.Get(i)->SetReceiveCallback(
+                MakeCallback(&RitWpanStreamsInstallOrderTest::DataIndication, this));
+        }
+    }
+
+    m_deviceSpan = helper.AssignStreams(nodes, 0);
+    app.AssignStreams(routers, m_deviceSpan);
+
+    for (uint32_t i = 0; i < apps.GetN(); i++)
+    {
+        Ptr<RitWpanNetDevice> dev =
+            DynamicCast<RitWpanNetDevice>(apps.Get(i)->GetNode()->GetDevice(0));
+        TimeValue delay;
+        apps.Get(i)->GetAttribute("InitialDelay", delay);
+        m_initialDelays[dev->GetMac()->GetShortAddress().ConvertToInt()] =
+            delay.Get().GetNanoSeconds();
+    }
+
+    Simulator::Stop(Seconds(35));
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
+void
+RitWpanStreamsInstallOrderTest::DoRun()
+{
+    RunNetwork(false, false);
+    const auto sinkRx = m_sinkRx;
+    const auto initialDelays = m_initialDelays;
+    NS_TEST_EXPECT_MSG_EQ(m_deviceSpan,
+                          N_NODES * RitWpanNetHelper::STREAMS_PER_DEVICE,
+                          "Wrong stream span of the devices");
+    NS_TEST_ASSERT_MSG_GT(sinkRx.size(), 0, "No packet delivered at the sink");
+
+    RunNetwork(true, false);
+    for (uint16_t addr = 1; addr < N_NODES; addr++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_initialDelays[addr],
+                              initialDelays[addr],
+                              "Initial delay of 00:0" << addr << " depends on the install order");
+    }
+    NS_TEST_ASSERT_MSG_EQ(m_sinkRx.size(), sinkRx.size(), "Different number of deliveries");
+    for (size_t i = 0; i < sinkRx.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_sinkRx[i].first, sinkRx[i].first, "Different source");
+        NS_TEST_EXPECT_MSG_EQ(m_sinkRx[i].second, sinkRx[i].second, "Different delivery time");
+    }
+
+    RunNetwork(false, true);
+    NS_TEST_EXPECT_MSG_EQ(m_installReport.devices, N_NODES, "Wrong number of devices reported");
+    NS_TEST_EXPECT_MSG_GT(m_installReport.sharedBytes, 0, "Nothing shared by InstallBulk");
+    NS_TEST_ASSERT_MSG_EQ(m_sinkRx.size(), sinkRx.size(), "InstallBulk changed the deliveries");
+    for (size_t i = 0; i < sinkRx.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_sinkRx[i].first, sinkRx[i].first, "Different source");
+        NS_TEST_EXPECT_MSG_EQ(m_sinkRx[i].second, sinkRx[i].second, "Different delivery time");
+    }
+}
+
+class RitWpanStreamsTestSuite : public TestSuite
+{
+  public:
+    RitWpanStreamsTestSuite();
+};
+
+RitWpanStreamsTestSuite::RitWpanStreamsTestSuite()
+    : TestSuite("rit-wpan-streams", Type::UNIT)
+{
+    AddTestCase(new RitWpanStreamsInstallOrderTest, Duration::QUICK);
+}
+
+static RitWpanStreamsTestSuite g_ritWpanStreamsTestSuite;
@@ -15,17 +15,94 @@
 #include <ns3/packet.h>
 #include <ns3/propagation-delay-model.h>
 #include <ns3/propagation-loss-model.h>
+#include <ns3/rit-ie.h>
 #include <ns3/rit-wpan-mac.h>
 #include <ns3/rit-wpan-net-device.h>
 #include <ns3/rit-wpan-nwk-header.h>
+#include <ns3/rit-sub-header.h>
 #include <ns3/rit-wpan-precs.h>
 #include <ns3/single-model-spectrum-channel.h>
 
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
 using namespace ns3;
 using namespace ns3::lrwpan;
 
 NS_LOG_COMPONENT_DEFINE("rit-wpan-mac-trx-test");
 
+namespace
+{
+
+/**
+ * @param packet A frame handed to the PHY
+ * @return whether it is a RIT Data Request
+ */
+bool
+IsRitDataRequest(Ptr<const Packet> packet)
+{
+    Ptr<Packet> p = packet->Copy();
+    LrWpanMacHeader macHdr;
+    p->RemoveHeader(macHdr);
+    if (!macHdr.IsCommand())
+    {
+        return false;
+    }
+    CommandPayloadHeader cmdHdr;
+    p->PeekHeader(cmdHdr);
+    return cmdHdr.GetCommandFrameType() == CommandPayloadHeader::RIT_DATA_REQ;
+}
+
+/**
+ * @brief Build a data frame for a node, as sent over the air.
+ * @param src MAC and NWK source
+ * @param macDst MAC destination
+ * @param nwkDst NWK destination
+ * @param panId PAN of the frame
+ * @return the frame with its FCS (filled in whatever ChecksumEnabled)
+ */
+Ptr<Packet>
+MakeDataFrame(Mac16Address src, Mac16Address macDst, Mac16Address nwkDst, uint16_t panId)
+{
+    Ptr<Packet> p = Create<Packet>(10);
+    RitNwkHeader nwkHdr;
+    nwkHdr.SetRank(2);
+    nwkHdr.SetSrcAddr(src);
+    nwkHdr.SetDstAddr(nwkDst);
+    p->AddHeader(nwkHdr);
+
+    LrWpanMacHeader macHdr(LrWpanMacHeader::LRWPAN_MAC_DATA, 7);
+    macHdr.SetSrcAddrMode(SHORT_ADDR);
+    macHdr.SetSrcAddrFields(panId, src);
+    macHdr.SetDstAddrMode(SHORT_ADDR);
+    macHdr.SetDstAddrFields(panId, macDst);
+    macHdr.SetNoAckReq();
+    p->AddHeader(macHdr);
+
+    LrWpanMacTrailer macTrailer;
+    macTrailer.EnableFcs(true);
+    macTrailer.SetFcs(p);
+    p->AddTrailer(macTrailer);
+    return p;
+}
+
+/**
+ * @param frame A frame
+ * @return a copy of the frame with the last byte of its payload flipped
+ */
+Ptr<Packet>
+CorruptPayload(Ptr<const Packet> frame)
+{
+    std::vector<uint8_t> bytes(frame->GetSize());
+    frame->CopyData(bytes.data(), bytes.size());
+    bytes[bytes.size() - LrWpanMacTrailer().GetSerializedSize() - 1] ^= 0xFF;
+    return Create<Packet>(bytes.data(), bytes.size());
+}
+
+} // namespace
+
 class RitWpanMacTrxTest : public TestCase
 {
   public:
@@ -145,6 +222,1520 @@ RitWpanMacTrxTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @brief Check that continuousTxEnabled drains the whole TX queue in one rendezvous.
+ */
+class RitWpanMacBurstTest : public TestCase
+{
+  public:
+    RitWpanMacBurstTest();
+
+  private:
+    /**
+     * @brief Record the reception time of a data frame at the receiver.
+     * @param dev The device
+     * @param pkt The packet
+     * @param proto The protocol number
+     * @param addr The source address
+     * @return true
+     */
+    bool DataIndication(Ptr<NetDevice> dev,
+                        Ptr<const Packet> pkt,
+                        uint16_t proto,
+                        const Address& addr);
+    void DoRun() override;
+
+    std::vector<Time> m_rxTimes;     //!< Reception times at the receiver
+    std::vector<uint32_t> m_rxSizes; //!< Received packet sizes
+};
+
+RitWpanMacBurstTest::RitWpanMacBurstTest()
+    : TestCase("RitWpanMac continuous transmission of a queued burst (RIT)")
+{
+}
+
+bool
+RitWpanMacBurstTest::DataIndication(Ptr<NetDevice> dev,
+                                    Ptr<const Packet> pkt,
+                                    uint16_t proto,
+                                    const Address& addr)
+{
+    m_rxTimes.push_back(Simulator::Now());
+    m_rxSizes.push_back(pkt->GetSize());
+    return true;
+}
+
+void
+RitWpanMacBurstTest::DoRun()
+{
+    Ptr<Node> receiverNode = CreateObject<Node>();
+    Ptr<Node> senderNode = CreateObject<Node>();
+    Ptr<RitWpanNetDevice> receiverDevice = CreateObject<RitWpanNetDevice>();
+    Ptr<RitWpanNetDevice> senderDevice = CreateObject<RitWpanNetDevice>();
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+    receiverDevice->SetChannel(channel);
+    senderDevice->SetChannel(channel);
+
+    receiverDevice->SetAddress(Mac16Address("00:00"));
+    receiverDevice->SetRitRank(0);
+    senderDevice->SetAddress(Mac16Address("00:01"));
+    senderDevice->SetRitRank(1);
+    receiverNode->AddDevice(receiverDevice);
+    senderNode->AddDevice(senderDevice);
+    receiverDevice->SetReceiveCallback(MakeCallback(&RitWpanMacBurstTest::DataIndication, this));
+
+    RitWpanMacModuleConfig config;
+    config.continuousTxEnabled = true;
+    Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+    pibAttr->macRitPeriodTime = Time(Seconds(1));
+    for (const auto& device : {senderDevice, receiverDevice})
+    {
+        device->GetMac()->SetModuleConfig(config);
+        device->GetMac()->MlmeSetRequest(macRitPeriodTime, pibAttr);
+    }
+
+    // Three frames queued at once, before the next beacon of the receiver
+    Simulator::ScheduleWithContext(senderNode->GetId(), Seconds(8.0), [=]() {
+        for (uint32_t size : {30, 60, 90})
+        {
+            senderDevice->Send(Create<Packet>(size), Mac16Address("00:00"), 0);
+        }
+    });
+
+    Simulator::Stop(Seconds(12.0));
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_rxTimes.size(), 3, "Not every frame of the burst was received");
+    NS_TEST_EXPECT_MSG_EQ(m_rxSizes[0], 30, "Sub-header not stripped or wrong order");
+    NS_TEST_EXPECT_MSG_EQ(m_rxSizes[2], 90, "Sub-header not stripped or wrong order");
+    NS_TEST_EXPECT_MSG_LT(m_rxTimes[2] - m_rxTimes[0],
+                          MilliSeconds(100),
+                          "The burst took more than one rendezvous");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @brief Check that a sender which learned the beacon phase of its receiver only
+ * wakes up around the predicted beacon for the following packets (phaseLearningEnabled).
+ */
+class RitWpanMacPhaseLearningTest : public TestCase
+{
+  public:
+    RitWpanMacPhaseLearningTest();
+
+  private:
+    /**
+     * @brief Record the time spent in SENDER_MODE by the sender.
+     * @param oldMode The previous mode
+     * @param newMode The new mode
+     */
+    void ModeChanged(RitMacMode oldMode, RitMacMode newMode);
+
+    /**
+     * @brief Count the data frames received by the receiver.
+     * @param dev The device
+     * @param pkt The packet
+     * @param proto The protocol number
+     * @param addr The source address
+     * @return true
+     */
+    bool DataIndication(Ptr<NetDevice> dev,
+                        Ptr<const Packet> pkt,
+                        uint16_t proto,
+                        const Address& addr);
+    void DoRun() override;
+
+    Time m_senderModeStart;          //!< Start of the current SENDER_MODE period
+    std::vector<Time> m_senderTimes; //!< Length of each SENDER_MODE period
+    uint32_t m_nRx{0};               //!< Data frames received
+};
+
+RitWpanMacPhaseLearningTest::RitWpanMacPhaseLearningTest()
+    : TestCase("RitWpanMac sender wake-up on the learned beacon phase (RIT)")
+{
+}
+
+void
+RitWpanMacPhaseLearningTest::ModeChanged(RitMacMode oldMode, RitMacMode newMode)
+{
+    if (newMode == SENDER_MODE)
+    {
+        m_senderModeStart = Simulator::Now();
+    }
+    else if (oldMode == SENDER_MODE)
+    {
+        m_senderTimes.push_back(Simulator::Now() - m_senderModeStart);
+    }
+}
+
+bool
+RitWpanMacPhaseLearningTest::DataIndication(Ptr<NetDevice> dev,
+                                            Ptr<const Packet> pkt,
+                                            uint16_t proto,
+                                            const Address& addr)
+{
+    m_nRx++;
+    return true;
+}
+
+void
+RitWpanMacPhaseLearningTest::DoRun()
+{
+    Ptr<Node> receiverNode = CreateObject<Node>();
+    Ptr<Node> senderNode = CreateObject<Node>();
+    Ptr<RitWpanNetDevice> receiverDevice = CreateObject<RitWpanNetDevice>();
+    Ptr<RitWpanNetDevice> senderDevice = CreateObject<RitWpanNetDevice>();
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+    receiverDevice->SetChannel(channel);
+    senderDevice->SetChannel(channel);
+
+    receiverDevice->SetAddress(Mac16Address("00:00"));
+    receiverDevice->SetRitRank(0);
+    senderDevice->SetAddress(Mac16Address("00:01"));
+    senderDevice->SetRitRank(1);
+    receiverNode->AddDevice(receiverDevice);
+    senderNode->AddDevice(senderDevice);
+    receiverDevice->SetReceiveCallback(
+        MakeCallback(&RitWpanMacPhaseLearningTest::DataIndication, this));
+
+    RitWpanMacModuleConfig config;
+    config.phaseLearningEnabled = true;
+    Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+    pibAttr->macRitPeriodTime = Time(Seconds(1));
+    for (const auto& device : {senderDevice, receiverDevice})
+    {
+        device->GetMac()->SetModuleConfig(config);
+        device->GetMac()->MlmeSetRequest(macRitPeriodTime, pibAttr);
+    }
+    senderDevice->GetMac()->TraceConnectWithoutContext(
+        "MacMode",
+        MakeCallback(&RitWpanMacPhaseLearningTest::ModeChanged, this));
+
+    // The first packet learns the phase, the next ones use it
+    for (double t : {8.0, 20.3, 33.7})
+    {
+        Simulator::ScheduleWithContext(senderNode->GetId(), Seconds(t), [=]() {
+            senderDevice->Send(Create<Packet>(20), Mac16Address("00:00"), 0);
+        });
+    }
+
+    Simulator::Stop(Seconds(40.0));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_nRx, 3, "Not every frame was received");
+    NS_TEST_ASSERT_MSG_EQ(m_senderTimes.size(), 3, "Expected one sender cycle per packet");
+    for (size_t i = 1; i < m_senderTimes.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_LT(m_senderTimes[i],
+                              MilliSeconds(30),
+                              "Sender not woken around the predicted beacon");
+    }
+
+    Simulator::Destroy();
+}
+
+/**
+ * @brief Check that a full, prioritized TX queue drops the newest low-priority frames,
+ * lets a high-priority frame push one out and serves it right after the frame in progress.
+ */
+class RitWpanMacTxQueueTest : public TestCase
+{
+  public:
+    RitWpanMacTxQueueTest();
+
+  private:
+    /**
+     * @brief Record the size of a packet delivered at the receiver.
+     * @param dev The device
+     * @param pkt The packet
+     * @param proto The protocol number
+     * @param addr The source address
+     * @return true
+     */
+    bool DataIndication(Ptr<NetDevice> dev,
+                        Ptr<const Packet> pkt,
+                        uint16_t proto,
+                        const Address& addr);
+
+    /**
+     * @brief Record a frame dropped by the TX queue of the sender.
+     * @param packet The frame
+     * @param sojourn Time the frame spent in the queue
+     */
+    void QueueDrop(Ptr<const Packet> packet, Time sojourn);
+
+    /**
+     * @brief Record the TX queue occupancy of the sender.
+     * @param oldValue Previous occupancy
+     * @param newValue New occupancy
+     */
+    void Occupancy(uint32_t oldValue, uint32_t newValue);
+
+    void DoRun() override;
+
+    std::vector<uint32_t> m_rxSizes;  //!< Received packet sizes, in order
+    std::vector<Time> m_dropSojourns; //!< Sojourn times of the dropped frames
+    uint32_t m_maxOccupancy;          //!< Largest TX queue occupancy of the sender
+};
+
+RitWpanMacTxQueueTest::RitWpanMacTxQueueTest()
+    : TestCase("RitWpanMac bounded and prioritized TX queue (RIT)"),
+      m_maxOccupancy(0)
+{
+}
+
+bool
+RitWpanMacTxQueueTest::DataIndication(Ptr<NetDevice> dev,
+                                      Ptr<const Packet> pkt,
+                                      uint16_t proto,
+                                      const Address& addr)
+{
+    m_rxSizes.push_back(pkt->GetSize());
+    return true;
+}
+
+void
+RitWpanMacTxQueueTest::QueueDrop(Ptr<const Packet> packet, Time sojourn)
+{
+    m_dropSojourns.push_back(sojourn);
+}
+
+void
+RitWpanMacTxQueueTest::Occupancy(uint32_t oldValue, uint32_t newValue)
+{
+    m_maxOccupancy = std::max(m_maxOccupancy, newValue);
+}
+
+void
+RitWpanMacTxQueueTest::DoRun()
+{
+    Ptr<Node> receiverNode = CreateObject<Node>();
+    Ptr<Node> senderNode = CreateObject<Node>();
+    Ptr<RitWpanNetDevice> receiverDevice = CreateObject<RitWpanNetDevice>();
+    Ptr<RitWpanNetDevice> senderDevice = CreateObject<RitWpanNetDevice>();
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+    receiverDevice->SetChannel(channel);
+    senderDevice->SetChannel(channel);
+
+    receiverDevice->SetAddress(Mac16Address("00:00"));
+    receiverDevice->SetRitRank(0);
+    senderDevice->SetAddress(Mac16Address("00:01"));
+    senderDevice->SetRitRank(1);
+    receiverNode->AddDevice(receiverDevice);
+    senderNode->AddDevice(senderDevice);
+    receiverDevice->SetReceiveCallback(
+        MakeCallback(&RitWpanMacTxQueueTest::DataIndication, this));
+
+    Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+    pibAttr->macRitPeriodTime = Time(Seconds(1));
+    for (const auto& device : {senderDevice, receiverDevice})
+    {
+        device->GetMac()->MlmeSetRequest(macRitPeriodTime, pibAttr);
+    }
+
+    Ptr<RitWpanMac> senderMac = senderDevice->GetMac();
+    senderMac->SetAttribute("TxQueueCapacity", UintegerValue(2));
+    senderMac->SetAttribute("TxQueuePriorityEnabled", BooleanValue(true));
+    senderMac->TraceConnectWithoutContext("TxQueueDrop",
+                                          MakeCallback(&RitWpanMacTxQueueTest::QueueDrop, this));
+    senderMac->TraceConnectWithoutContext("TxQueueOccupancy",
+                                          MakeCallback(&RitWpanMacTxQueueTest::Occupancy, this));
+
+    // Three readings, then an alarm, queued at once before the next beacon
+    Simulator::ScheduleWithContext(senderNode->GetId(), Seconds(8.0), [=]() {
+        for (uint32_t size : {30, 40, 50})
+        {
+            senderDevice->Send(Create<Packet>(size), Mac16Address("00:00"), 0);
+        }
+        Ptr<Packet> alarm = Create<Packet>(60);
+        SocketPriorityTag priorityTag;
+        priorityTag.SetPriority(2);
+        alarm->AddPacketTag(priorityTag);
+        senderDevice->Send(alarm, Mac16Address("00:00"), 0);
+    });
+
+    Simulator::Stop(Seconds(14.0));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_maxOccupancy, 2, "TX queue grew past its capacity");
+    NS_TEST_ASSERT_MSG_EQ(m_dropSojourns.size(), 2, "Expected the third reading and a pushout");
+    NS_TEST_EXPECT_MSG_EQ(m_dropSojourns[0], Time(), "Arriving frame with a sojourn time");
+    NS_TEST_ASSERT_MSG_EQ(m_rxSizes.size(), 2, "Wrong number of received frames");
+    NS_TEST_EXPECT_MSG_EQ(m_rxSizes[0], 30, "Frame in progress overtaken");
+    NS_TEST_EXPECT_MSG_EQ(m_rxSizes[1], 60, "Alarm not kept");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @brief Check that a queued data frame is readdressed without rewriting it: the frame
+ * already addressed to the beacon sender goes out as queued, a frame announcing more data
+ * goes out as a new frame with the flag set.
+ */
+class RitWpanMacTxFrameTest : public TestCase
+{
+  public:
+    RitWpanMacTxFrameTest();
+
+  private:
+    /**
+     * @brief Record a frame queued by the sender.
+     * @param packet The frame
+     */
+    void Enqueue(Ptr<const Packet> packet);
+
+    /**
+     * @brief Record a data frame handed to the PHY by the sender.
+     * @param packet The frame
+     */
+    void Transmit(Ptr<const Packet> packet);
+
+    void DoRun() override;
+
+    std::vector<Ptr<const Packet>> m_queued; //!< Frames queued, in order
+    std::vector<Ptr<const Packet>> m_sent;   //!< Data frames transmitted, in order
+};
+
+RitWpanMacTxFrameTest::RitWpanMacTxFrameTest()
+    : TestCase("RitWpanMac queued data frames are not rewritten (RIT)")
+{
+}
+
+void
+RitWpanMacTxFrameTest::Enqueue(Ptr<const Packet> packet)
+{
+    m_queued.push_back(packet);
+}
+
+void
+RitWpanMacTxFrameTest::Transmit(Ptr<const Packet> packet)
+{
+    LrWpanMacHeader macHdr;
+    packet->PeekHeader(macHdr);
+    if (macHdr.IsData())
+    {
+        m_sent.push_back(packet);
+    }
+}
+
+void
+RitWpanMacTxFrameTest::DoRun()
+{
+    Ptr<Node> receiverNode = CreateObject<Node>();
+    Ptr<Node> senderNode = CreateObject<Node>();
+    Ptr<RitWpanNetDevice> receiverDevice = CreateObject<RitWpanNetDevice>();
+    Ptr<RitWpanNetDevice> senderDevice = CreateObject<RitWpanNetDevice>();
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+    receiverDevice->SetChannel(channel);
+    senderDevice->SetChannel(channel);
+
+    receiverDevice->SetAddress(Mac16Address("00:00"));
+    receiverDevice->SetRitRank(0);
+    senderDevice->SetAddress(Mac16Address("00:01"));
+    senderDevice->SetRitRank(1);
+    receiverNode->AddDevice(receiverDevice);
+    senderNode->AddDevice(senderDevice);
+
+    RitWpanMacModuleConfig config;
+    config.continuousTxEnabled = true;
+    Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+    pibAttr->macRitPeriodTime = Time(Seconds(1));
+    for (const auto& device : {senderDevice, receiverDevice})
+    {
+        device->GetMac()->SetModuleConfig(config);
+        device->GetMac()->MlmeSetRequest(macRitPeriodTime, pibAttr);
+    }
+    Ptr<RitWpanMac> senderMac = senderDevice->GetMac();
+    senderMac->TraceConnectWithoutContext("MacTxEnqueue",
+                                          MakeCallback(&RitWpanMacTxFrameTest::Enqueue, this));
+    senderMac->TraceConnectWithoutContext("MacTx",
+                                          MakeCallback(&RitWpanMacTxFrameTest::Transmit, this));
+
+    Simulator::ScheduleWithContext(senderNode->GetId(), Seconds(8.0), [=]() {
+        senderDevice->Send(Create<Packet>(30), Mac16Address("00:00"), 0);
+        senderDevice->Send(Create<Packet>(60), Mac16Address("00:00"), 0);
+    });
+
+    Simulator::Stop(Seconds(12.0));
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_queued.size(), 2, "Wrong number of queued frames");
+    NS_TEST_ASSERT_MSG_EQ(m_sent.size(), 2, "Wrong number of transmitted frames");
+    // First frame: more data follows, the CONTINUOUS flag is set in a new frame
+    NS_TEST_EXPECT_MSG_NE(m_sent[0], m_queued[0], "Flagged frame not rebuilt");
+    NS_TEST_EXPECT_MSG_EQ(m_sent[0]->GetSize(), m_queued[0]->GetSize(), "Wrong rebuilt size");
+    Ptr<Packet> first = m_sent[0]->Copy();
+    LrWpanMacHeader macHdr;
+    first->RemoveHeader(macHdr);
+    RitSubHeader subHdr;
+    first->RemoveHeader(subHdr);
+    NS_TEST_EXPECT_MSG_EQ(subHdr.isContinuous(), true, "CONTINUOUS flag not set");
+    NS_TEST_EXPECT_MSG_EQ(macHdr.GetShortDstAddr(), Mac16Address("00:00"), "Wrong destination");
+    // Last frame: already addressed to the receiver, sent as queued
+    NS_TEST_EXPECT_MSG_EQ(m_sent[1], m_queued[1], "Unchanged frame rewritten");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @brief Check that a sender with its own receive channel retunes to the channel of its
+ * receiver for each frame and back to its own one (RxChannel, channel plan).
+ */
+class RitWpanMacMultiChannelTest : public TestCase
+{
+  public:
+    RitWpanMacMultiChannelTest();
+
+  private:
+    /**
+     * @brief Count a data frame at the receiver.
+     * @param dev The device
+     * @param pkt The packet
+     * @param proto The protocol number
+     * @param addr The source address
+     * @return true
+     */
+    bool DataIndication(Ptr<NetDevice> dev,
+                        Ptr<const Packet> pkt,
+                        uint16_t proto,
+                        const Address& addr);
+    void DoRun() override;
+
+    uint32_t m_rxCount{0}; //!< Data frames received
+};
+
+RitWpanMacMultiChannelTest::RitWpanMacMultiChannelTest()
+    : TestCase("RitWpanMac sender retuning to the receive channel of its receiver (RIT)")
+{
+}
+
+bool
+RitWpanMacMultiChannelTest::DataIndication(Ptr<NetDevice> dev,
+                                           Ptr<const Packet> pkt,
+                                           uint16_t proto,
+                                           const Address& addr)
+{
+    m_rxCount++;
+    return true;
+}
+
+void
+RitWpanMacMultiChannelTest::DoRun()
+{
+    Ptr<Node> receiverNode = CreateObject<Node>();
+    Ptr<Node> senderNode = CreateObject<Node>();
+    Ptr<RitWpanNetDevice> receiverDevice = CreateObject<RitWpanNetDevice>();
+    Ptr<RitWpanNetDevice> senderDevice = CreateObject<RitWpanNetDevice>();
+
+    Ptr<LrWpanSpectrumChannel> channel = CreateObject<LrWpanSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+    receiverDevice->SetChannel(channel);
+    senderDevice->SetChannel(channel);
+
+    receiverDevice->SetAddress(Mac16Address("00:00"));
+    receiverDevice->SetRitRank(0);
+    senderDevice->SetAddress(Mac16Address("00:01"));
+    senderDevice->SetRitRank(1);
+    receiverNode->AddDevice(receiverDevice);
+    senderNode->AddDevice(senderDevice);
+    receiverDevice->SetReceiveCallback(
+        MakeCallback(&RitWpanMacMultiChannelTest::DataIndication, this));
+
+    // Two-channel plan: the receiver listens on 11, the sender on 12
+    Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+    pibAttr->macRitPeriodTime = Time(Seconds(1));
+    for (const auto& device : {senderDevice, receiverDevice})
+    {
+        Ptr<RitWpanMac> mac = device->GetMac();
+        mac->MlmeSetRequest(macRitPeriodTime, pibAttr);
+        mac->SetRxChannelPlan(11, 2);
+        mac->SetRxChannel(RitWpanMac::GetPlannedRxChannel(mac->GetShortAddress(), 11, 2));
+    }
+    NS_TEST_ASSERT_MSG_EQ(+senderDevice->GetMac()->GetNeighbourRxChannel(Mac16Address("00:00")),
+                          11,
+                          "Wrong planned channel of the receiver");
+    NS_TEST_ASSERT_MSG_EQ(+senderDevice->GetPhy()->GetCurrentChannelNum(),
+                          12,
+                          "Sender not on its own channel");
+
+    for (double at : {8.0, 12.0, 16.0})
+    {
+        Simulator::ScheduleWithContext(senderNode->GetId(), Seconds(at), [=]() {
+            senderDevice->Send(Create<Packet>(30), Mac16Address("00:00"), 0);
+        });
+    }
+
+    Simulator::Stop(Seconds(20.0));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_rxCount, 3, "Frames lost across the channels");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(senderDevice->GetMac()->GetNChannelSwitches(),
+                                6,
+                                "Sender did not retune for each frame");
+    NS_TEST_EXPECT_MSG_EQ(+senderDevice->GetPhy()->GetCurrentChannelNum(),
+                          12,
+                          "Sender not back on its own channel");
+    NS_TEST_EXPECT_MSG_EQ(receiverDevice->GetMac()->GetNChannelSwitches(),
+                          0,
+                          "Receiver left its channel");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @brief Check that a sender with a deep TX queue sends it as a frame train to the
+ * receiver it last reached, in one burst held open by the frame pending bit
+ * (HybridQueueThreshold).
+ */
+class RitWpanMacFrameTrainTest : public TestCase
+{
+  public:
+    RitWpanMacFrameTrainTest();
+
+  private:
+    /**
+     * @brief Record the reception time of a data frame at the receiver.
+     * @param dev The device
+     * @param pkt The packet
+     * @param proto The protocol number
+     * @param addr The source address
+     * @return true
+     */
+    bool DataIndication(Ptr<NetDevice> dev,
+                        Ptr<const Packet> pkt,
+                        uint16_t proto,
+                        const Address& addr);
+
+    /**
+     * @brief Count the frame trains of the sender.
+     * @param oldMode The previous mode
+     * @param newMode The new mode
+     */
+    void ModeChanged(RitMacMode oldMode, RitMacMode newMode);
+
+    void DoRun() override;
+
+    std::vector<Time> m_rxTimes; //!< Reception times of the data frames
+    uint32_t m_nTrains{0};       //!< Entries of the sender in STROBE_MODE
+};
+
+RitWpanMacFrameTrainTest::RitWpanMacFrameTrainTest()
+    : TestCase("RitWpanMac frame train for a deep TX queue (RIT hybrid)")
+{
+}
+
+bool
+RitWpanMacFrameTrainTest::DataIndication(Ptr<NetDevice> dev,
+                                         Ptr<const Packet> pkt,
+                                         uint16_t proto,
+                                         const Address& addr)
+{
+    m_rxTimes.push_back(Simulator::Now());
+    return true;
+}
+
+void
+RitWpanMacFrameTrainTest::ModeChanged(RitMacMode oldMode, RitMacMode newMode)
+{
+    if (newMode == STROBE_MODE)
+    {
+        m_nTrains++;
+    }
+}
+
+void
+RitWpanMacFrameTrainTest::DoRun()
+{
+    Ptr<Node> receiverNode = CreateObject<Node>();
+    Ptr<Node> senderNode = CreateObject<Node>();
+    Ptr<RitWpanNetDevice> receiverDevice = CreateObject<RitWpanNetDevice>();
+    Ptr<RitWpanNetDevice> senderDevice = CreateObject<RitWpanNetDevice>();
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+    receiverDevice->SetChannel(channel);
+    senderDevice->SetChannel(channel);
+
+    receiverDevice->SetAddress(Mac16Address("00:00"));
+    receiverDevice->SetRitRank(0);
+    senderDevice->SetAddress(Mac16Address("00:01"));
+    senderDevice->SetRitRank(1);
+    receiverNode->AddDevice(receiverDevice);
+    senderNode->AddDevice(senderDevice);
+    receiverDevice->SetReceiveCallback(
+        MakeCallback(&RitWpanMacFrameTrainTest::DataIndication, this));
+
+    Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+    pibAttr->macRitPeriodTime = Time(Seconds(1));
+    for (const auto& device : {senderDevice, receiverDevice})
+    {
+        device->GetMac()->MlmeSetRequest(macRitPeriodTime, pibAttr);
+    }
+    senderDevice->GetMac()->SetAttribute("HybridQueueThreshold", UintegerValue(1));
+    senderDevice->GetMac()->TraceConnectWithoutContext(
+        "MacMode",
+        MakeCallback(&RitWpanMacFrameTrainTest::ModeChanged, this));
+
+    // The first frame reaches the receiver through RIT; the four frames queued
+    // together leave three behind the one in progress, sent as a train.
+    Simulator::ScheduleWithContext(senderNode->GetId(), Seconds(8.0), [=]() {
+        senderDevice->Send(Create<Packet>(20), Mac16Address("00:00"), 0);
+    });
+    Simulator::ScheduleWithContext(senderNode->GetId(), Seconds(12.0), [=]() {
+        for (int i = 0; i < 4; i++)
+        {
+            senderDevice->Send(Create<Packet>(20), Mac16Address("00:00"), 0);
+        }
+    });
+
+    Simulator::Stop(Seconds(20.0));
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_rxTimes.size(), 5, "Not every frame was received");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(m_nTrains, 1, "No frame train sent");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(senderDevice->GetMac()->GetNStrobeFrames(),
+                                3,
+                                "Queued frames not sent in the train");
+    NS_TEST_EXPECT_MSG_LT(m_rxTimes[4] - m_rxTimes[2],
+                          MilliSeconds(100),
+                          "Train frames not delivered in one burst");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @brief Check that a receiver with a DutyCycleLimit keeps its beacon airtime within
+ * the budget of each window, skipping the beacons that do not fit or lengthening its
+ * period (DutyCyclePolicy).
+ */
+class RitWpanMacDutyCycleTest : public TestCase
+{
+  public:
+    RitWpanMacDutyCycleTest();
+
+  private:
+    /**
+     * @brief Record a transmission put off by the limit.
+     * @param action The deferral
+     * @param wait Time until it fits
+     */
+    void DutyCycle(std::string action, Time wait);
+
+    void DoRun() override;
+
+    std::vector<std::string> m_actions; //!< Deferrals of the current run
+};
+
+RitWpanMacDutyCycleTest::RitWpanMacDutyCycleTest()
+    : TestCase("RitWpanMac beacons within a TX duty-cycle limit (RIT)")
+{
+}
+
+void
+RitWpanMacDutyCycleTest::DutyCycle(std::string action, Time wait)
+{
+    NS_TEST_EXPECT_MSG_GT(wait, Time(), "Deferral without a wait");
+    m_actions.push_back(action);
+}
+
+void
+RitWpanMacDutyCycleTest::DoRun()
+{
+    // 0.1% of 10 s: 10 ms of airtime per window, a few beacons of a 200 ms period
+    std::map<std::string, uint64_t> deferrals;
+    for (const std::string policy : {"SkipBeacon", "LengthenPeriod"})
+    {
+        m_actions.clear();
+        Ptr<Node> node = CreateObject<Node>();
+        Ptr<RitWpanNetDevice> device = CreateObject<RitWpanNetDevice>();
+        Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+        channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+        channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+        device->SetChannel(channel);
+        device->SetAddress(Mac16Address("00:00"));
+        device->SetRitRank(0);
+        node->AddDevice(device);
+
+        Ptr<RitWpanMac> mac = device->GetMac();
+        Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+        pibAttr->macRitPeriodTime = Time(MilliSeconds(200));
+        mac->MlmeSetRequest(macRitPeriodTime, pibAttr);
+        mac->SetAttribute("DutyCycleLimit", DoubleValue(0.001));
+        mac->SetAttribute("DutyCycleWindow", TimeValue(Seconds(10)));
+        mac->SetAttribute("DutyCyclePolicy", StringValue(policy));
+        mac->TraceConnectWithoutContext("DutyCycle",
+                                        MakeCallback(&RitWpanMacDutyCycleTest::DutyCycle, this));
+
+        Simulator::Stop(Seconds(30.0));
+        Simulator::Run();
+
+        // Each window holds the budget at most, one more for the bucket granularity
+        NS_TEST_EXPECT_MSG_GT(mac->GetTxAirtime(), Time(), "No beacon sent (" << policy << ")");
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(mac->GetTxAirtime(),
+                                    MilliSeconds(40),
+                                    "Airtime over the limit (" << policy << ")");
+        NS_TEST_ASSERT_MSG_GT(m_actions.size(), 0, "No beacon skipped (" << policy << ")");
+        const std::string expected =
+            policy == "SkipBeacon" ? "beacon-skip" : "period-lengthen";
+        NS_TEST_EXPECT_MSG_EQ(m_actions.front(), expected, "Wrong deferral (" << policy << ")");
+        NS_TEST_EXPECT_MSG_EQ(mac->GetNDutyCycleDeferrals(),
+                              m_actions.size(),
+                              "Deferrals not counted (" << policy << ")");
+        deferrals[policy] = m_actions.size();
+        Simulator::Destroy();
+    }
+    NS_TEST_EXPECT_MSG_LT(deferrals["LengthenPeriod"],
+                          deferrals["SkipBeacon"],
+                          "The lengthened period still tried every beacon");
+}
+
+/**
+ * @brief Check that the cached RIT Data Request template follows each of its inputs: after
+ * every change between two cycles, the next beacon of a long-running MAC must carry the
+ * bytes of the first beacon of a new MAC given the same inputs (DSN and frame counter aside).
+ */
+class RitWpanMacBeaconTemplateTest : public TestCase
+{
+  public:
+    RitWpanMacBeaconTemplateTest();
+
+  private:
+    /**
+     * @brief Apply one input change to a MAC.
+     * @param mac The MAC
+     * @param step The change, 1 to N_STEPS - 1 (0 is the default configuration)
+     */
+    static void ApplyStep(Ptr<RitWpanMac> mac, uint32_t step);
+
+    /**
+     * @brief Apply the inputs a MAC has after a change and all those before it.
+     * @param mac The MAC
+     * @param step The last change
+     */
+    static void ApplySteps(Ptr<RitWpanMac> mac, uint32_t step);
+
+    /**
+     * @param beacon A RIT Data Request
+     * @return its bytes with the DSN, the frame counter and the FCS cleared
+     */
+    static std::vector<uint8_t> GetBeaconBytes(Ptr<const Packet> beacon);
+
+    /**
+     * @brief Record a beacon of the long-running MAC and schedule the next change.
+     * @param packet The frame
+     */
+    void CachedTxBegin(Ptr<const Packet> packet);
+
+    /**
+     * @brief Record the first beacon of a new MAC.
+     * @param test The test
+     * @param step The changes the MAC was given
+     * @param packet The frame
+     */
+    static void FreshTxBegin(RitWpanMacBeaconTemplateTest* test,
+                             uint32_t step,
+                             Ptr<const Packet> packet);
+
+    void DoRun() override;
+
+    static constexpr uint32_t N_STEPS = 14; //!< Default configuration and the 13 changes
+
+    Ptr<RitWpanMac> m_cachedMac;                      //!< MAC beaconing through the changes
+    std::vector<std::vector<uint8_t>> m_cached;       //!< Its beacons, one per step
+    std::map<uint32_t, std::vector<uint8_t>> m_fresh; //!< First beacon of each new MAC
+};
+
+RitWpanMacBeaconTemplateTest::RitWpanMacBeaconTemplateTest()
+    : TestCase("RitWpanMac cached RIT Data Request follows its inputs (RIT)")
+{
+}
+
+void
+RitWpanMacBeaconTemplateTest::ApplyStep(Ptr<RitWpanMac> mac, uint32_t step)
+{
+    RitWpanMacModuleConfig config = mac->GetModuleConfig();
+    Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+    RitIeList ies;
+    switch (step)
+    {
+    case 1:
+        pibAttr->macRitRequestPayload = {0xAA, 0xBB, 0xCC};
+        mac->MlmeSetRequest(macRitRequestPayload, pibAttr);
+        break;
+    case 2:
+        config.headerIesEnabled = true;
+        mac->SetModuleConfig(config);
+        break;
+    case 3:
+        ies.AddU16(RIT_IE_RANK, 1);
+        ies.AddU8(RIT_IE_QUEUE_CREDIT, 4);
+        mac->SetRitRequestIes(ies);
+        break;
+    case 4:
+        mac->SetRxChannel(12);
+        break;
+    case 5:
+        // Only the next beacon carries the redirect
+        mac->RedirectNextBeacon(13);
+        break;
+    case 6:
+        // No change: the beacon after the redirect advertises the own channel again
+        break;
+    case 7:
+        config.compactRitDataRequestEnabled = true;
+        mac->SetRitModuleConfig(config);
+        break;
+    case 8:
+        pibAttr->macRitRequestPayload = {0x01};
+        mac->MlmeSetRequest(macRitRequestPayload, pibAttr);
+        break;
+    case 9:
+        mac->SetShortAddress(Mac16Address("00:07"));
+        break;
+    case 10:
+        mac->SetPanId(0x0042);
+        break;
+    case 11:
+        mac->SetSecurityLevel(5);
+        break;
+    case 12:
+        // A longer MIC in the command payload
+        mac->SetSecurityLevel(7);
+        break;
+    case 13:
+        mac->SetAttribute("SecureRitDataRequest", BooleanValue(false));
+        break;
+    default:
+        break;
+    }
+}
+
+void
+RitWpanMacBeaconTemplateTest::ApplySteps(Ptr<RitWpanMac> mac, uint32_t step)
+{
+    for (uint32_t i = 1; i <= step; i++)
+    {
+        // The redirect only lives for one beacon
+        if (i != 5 || i == step)
+        {
+            ApplyStep(mac, i);
+        }
+    }
+}
+
+std::vector<uint8_t>
+RitWpanMacBeaconTemplateTest::GetBeaconBytes(Ptr<const Packet> beacon)
+{
+    Ptr<Packet> p = beacon->Copy();
+    LrWpanMacTrailer macTrailer;
+    p->RemoveTrailer(macTrailer);
+    LrWpanMacHeader macHdr;
+    p->RemoveHeader(macHdr);
+    macHdr.SetSeqNum(0);
+    if (macHdr.IsSecEnable())
+    {
+        macHdr.SetFrmCounter(0);
+    }
+    p->AddHeader(macHdr);
+    std::vector<uint8_t> bytes(p->GetSize());
+    p->CopyData(bytes.data(), bytes.size());
+    return bytes;
+}
+
+void
+RitWpanMacBeaconTemplateTest::CachedTxBegin(Ptr<const Packet> packet)
+{
+    if (!IsRitDataRequest(packet) || m_cached.size() >= N_STEPS)
+    {
+        return;
+    }
+    m_cached.push_back(GetBeaconBytes(packet));
+    // Change the next input between this cycle and the next one
+    const uint32_t step = m_cached.size();
+    if (step < N_STEPS)
+    {
+        Simulator::Schedule(MilliSeconds(500),
+                            &RitWpanMacBeaconTemplateTest::ApplyStep,
+                            m_cachedMac,
+                            step);
+    }
+}
+
+void
+RitWpanMacBeaconTemplateTest::FreshTxBegin(RitWpanMacBeaconTemplateTest* test,
+                                           uint32_t step,
+                                           Ptr<const Packet> packet)
+{
+    if (IsRitDataRequest(packet) && test->m_fresh.find(step) == test->m_fresh.end())
+    {
+        test->m_fresh[step] = GetBeaconBytes(packet);
+    }
+}
+
+void
+RitWpanMacBeaconTemplateTest::DoRun()
+{
+    // The MAC under test and one new MAC per step, each alone on its channel
+    std::vector<Ptr<RitWpanNetDevice>> devices;
+    for (uint32_t i = 0; i <= N_STEPS; i++)
+    {
+        Ptr<Node> node = CreateObject<Node>();
+        Ptr<RitWpanNetDevice> device = CreateObject<RitWpanNetDevice>();
+        Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+        channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+        channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+        device->SetChannel(channel);
+        device->SetAddress(Mac16Address("00:01"));
+        device->SetRitRank(1);
+        node->AddDevice(device);
+
+        Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+        pibAttr->macRitPeriodTime = Time(Seconds(1));
+        device->GetMac()->MlmeSetRequest(macRitPeriodTime, pibAttr);
+        devices.push_back(device);
+    }
+
+    m_cachedMac = devices[N_STEPS]->GetMac();
+    devices[N_STEPS]->GetPhy()->TraceConnectWithoutContext(
+        "PhyTxBegin",
+        MakeCallback(&RitWpanMacBeaconTemplateTest::CachedTxBegin, this));
+    for (uint32_t step = 0; step < N_STEPS; step++)
+    {
+        devices[step]->GetPhy()->TraceConnectWithoutContext(
+            "PhyTxBegin",
+            MakeBoundCallback(&RitWpanMacBeaconTemplateTest::FreshTxBegin, this, step));
+        // After the NWK set its own payload at initialization, before the first beacon
+        Simulator::Schedule(MicroSeconds(1),
+                            &RitWpanMacBeaconTemplateTest::ApplySteps,
+                            devices[step]->GetMac(),
+                            step);
+    }
+
+    Simulator::Stop(Seconds(N_STEPS + 3));
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_cached.size(), N_STEPS, "Too few beacons of the cached MAC");
+    for (uint32_t step = 0; step < N_STEPS; step++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_fresh.count(step), 1, "New MAC " << step << " sent no beacon");
+        NS_TEST_EXPECT_MSG_EQ(m_cached[step].size(),
+                              m_fresh[step].size(),
+                              "Beacon length differs after change " << step);
+        NS_TEST_EXPECT_MSG_EQ((m_cached[step] == m_fresh[step]),
+                              true,
+                              "Beacon bytes differ from a new build after change " << step);
+    }
+    // The changes did reach the beacons
+    NS_TEST_EXPECT_MSG_NE((m_cached[0] == m_cached[1]), true, "Payload change not sent");
+    NS_TEST_EXPECT_MSG_NE((m_cached[4] == m_cached[5]), true, "Redirect not sent");
+    NS_TEST_EXPECT_MSG_EQ((m_cached[4] == m_cached[6]), true, "Redirect kept past one beacon");
+    NS_TEST_EXPECT_MSG_LT(m_cached[11].size(), m_cached[12].size(), "MIC not lengthened");
+
+    m_cachedMac = nullptr;
+    Simulator::Destroy();
+}
+
+/**
+ * @brief Check the peeked receive path of a data frame heard in the data wait: with
+ * ChecksumEnabled a frame whose FCS does not match is dropped, without it the same frame
+ * is accepted.
+ */
+class RitWpanMacRxFcsTest : public TestCase
+{
+  public:
+    RitWpanMacRxFcsTest();
+
+  private:
+    /**
+     * @brief Indicate the frames of the run to the MAC after its first beacon.
+     * @param test The test
+     * @param packet The frame sent by the PHY
+     */
+    static void BeaconSent(RitWpanMacRxFcsTest* test, Ptr<const Packet> packet);
+
+    /**
+     * @brief Count a frame accepted by the MAC.
+     * @param packet The frame
+     */
+    void MacRx(Ptr<const Packet> packet);
+
+    /**
+     * @brief Count a frame dropped by the MAC.
+     * @param packet The frame
+     */
+    void MacRxDrop(Ptr<const Packet> packet);
+
+    /**
+     * @brief Run one receiver hearing one frame.
+     * @param checksum ChecksumEnabled
+     * @param corrupt Whether the frame is corrupted after its FCS was computed
+     */
+    void RunFrame(bool checksum, bool corrupt);
+
+    void DoRun() override;
+
+    Ptr<RitWpanMac> m_mac;  //!< Receiver
+    Ptr<Packet> m_frame;    //!< Frame indicated after the first beacon
+    uint32_t m_nRx{0};      //!< Frames accepted
+    uint32_t m_nRxDrop{0};  //!< Frames dropped
+};
+
+RitWpanMacRxFcsTest::RitWpanMacRxFcsTest()
+    : TestCase("RitWpanMac FCS check of a data frame with and without ChecksumEnabled (RIT)")
+{
+}
+
+void
+RitWpanMacRxFcsTest::BeaconSent(RitWpanMacRxFcsTest* test, Ptr<const Packet> packet)
+{
+    if (!IsRitDataRequest(packet) || !test->m_frame)
+    {
+        return;
+    }
+    Simulator::Schedule(MilliSeconds(1),
+                        &RitWpanMac::PdDataIndication,
+                        test->m_mac,
+                        test->m_frame->GetSize(),
+                        test->m_frame,
+                        255);
+    test->m_frame = nullptr;
+}
+
+void
+RitWpanMacRxFcsTest::MacRx(Ptr<const Packet> packet)
+{
+    m_nRx++;
+}
+
+void
+RitWpanMacRxFcsTest::MacRxDrop(Ptr<const Packet> packet)
+{
+    m_nRxDrop++;
+}
+
+void
+RitWpanMacRxFcsTest::RunFrame(bool checksum, bool corrupt)
+{
+    GlobalValue::Bind("ChecksumEnabled", BooleanValue(checksum));
+    m_nRx = 0;
+    m_nRxDrop = 0;
+
+    Ptr<Node> node = CreateObject<Node>();
+    Ptr<RitWpanNetDevice> device = CreateObject<RitWpanNetDevice>();
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+    device->SetChannel(channel);
+    device->SetAddress(Mac16Address("00:01"));
+    device->SetRitRank(1);
+    device->SetMacRitDataWaitDuration(MilliSeconds(20));
+    node->AddDevice(device);
+
+    m_mac = device->GetMac();
+    Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+    pibAttr->macRitPeriodTime = Time(Seconds(1));
+    m_mac->MlmeSetRequest(macRitPeriodTime, pibAttr);
+    m_mac->TraceConnectWithoutContext("MacRx", MakeCallback(&RitWpanMacRxFcsTest::MacRx, this));
+    m_mac->TraceConnectWithoutContext("MacRxDrop",
+                                      MakeCallback(&RitWpanMacRxFcsTest::MacRxDrop, this));
+    device->GetPhy()->TraceConnectWithoutContext(
+        "PhyTxEnd",
+        MakeBoundCallback(&RitWpanMacRxFcsTest::BeaconSent, this));
+
+    m_frame = MakeDataFrame(Mac16Address("00:02"),
+                            Mac16Address("00:01"),
+                            Mac16Address("00:01"),
+                            m_mac->GetPanId());
+    if (corrupt)
+    {
+        m_frame = CorruptPayload(m_frame);
+    }
+
+    Simulator::Stop(Seconds(3));
+    Simulator::Run();
+
+    const std::string run = std::string(checksum ? "checksum" : "no checksum") +
+                            (corrupt ? ", corrupt FCS" : ", valid FCS");
+    NS_TEST_EXPECT_MSG_EQ(m_frame, nullptr, "Frame not indicated (" << run << ")");
+    if (checksum && corrupt)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_nRx, 0, "Frame with a bad FCS accepted (" << run << ")");
+        NS_TEST_EXPECT_MSG_EQ(m_nRxDrop, 1, "Frame with a bad FCS not dropped (" << run << ")");
+    }
+    else
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_nRx, 1, "Frame not accepted (" << run << ")");
+        NS_TEST_EXPECT_MSG_EQ(m_nRxDrop, 0, "Frame dropped (" << run << ")");
+    }
+
+    m_mac = nullptr;
+    Simulator::Destroy();
+    GlobalValue::Bind("ChecksumEnabled", BooleanValue(false));
+}
+
+void
+RitWpanMacRxFcsTest::DoRun()
+{
+    RunFrame(true, true);
+    RunFrame(true, false);
+    RunFrame(false, true);
+}
+
+/**
+ * @brief Check that a broadcast data frame heard in the data wait keeps it open, so that a
+ * frame addressed to the receiver in the same wait is still received, and that this frame
+ * ends the cycle.
+ */
+class RitWpanMacBroadcastDataWaitTest : public TestCase
+{
+  public:
+    RitWpanMacBroadcastDataWaitTest();
+
+  private:
+    /**
+     * @brief Indicate the broadcast frame, then the unicast one, after the first beacon.
+     * @param test The test
+     * @param packet The frame sent by the PHY
+     */
+    static void BeaconSent(RitWpanMacBroadcastDataWaitTest* test, Ptr<const Packet> packet);
+
+    /**
+     * @brief Indicate a frame to the receiver and record its mode right after.
+     * @param frame The frame
+     */
+    void Indicate(Ptr<Packet> frame);
+
+    /**
+     * @brief Record a mode change of the receiver.
+     * @param oldMode The previous mode
+     * @param newMode The new mode
+     */
+    void ModeChanged(RitMacMode oldMode, RitMacMode newMode);
+
+    /**
+     * @brief Count a frame accepted by the receiver.
+     * @param packet The frame
+     */
+    void MacRx(Ptr<const Packet> packet);
+
+    void DoRun() override;
+
+    Ptr<RitWpanMac> m_mac;                 //!< Receiver
+    bool m_beaconSeen{false};              //!< Whether the first beacon went out
+    RitMacMode m_mode{SLEEP_MODE};         //!< Current mode of the receiver
+    std::vector<RitMacMode> m_modesAfter;  //!< Mode right after each indicated frame
+    uint32_t m_nRx{0};                     //!< Frames accepted
+};
+
+RitWpanMacBroadcastDataWaitTest::RitWpanMacBroadcastDataWaitTest()
+    : TestCase("RitWpanMac data wait kept open by a broadcast data frame (RIT)")
+{
+}
+
+void
+RitWpanMacBroadcastDataWaitTest::BeaconSent(RitWpanMacBroadcastDataWaitTest* test,
+                                            Ptr<const Packet> packet)
+{
+    if (!IsRitDataRequest(packet) || test->m_beaconSeen)
+    {
+        return;
+    }
+    test->m_beaconSeen = true;
+    const uint16_t panId = test->m_mac->GetPanId();
+    Simulator::Schedule(MilliSeconds(1),
+                        &RitWpanMacBroadcastDataWaitTest::Indicate,
+                        test,
+                        MakeDataFrame(Mac16Address("00:02"),
+                                      Mac16Address("ff:ff"),
+                                      Mac16Address("00:01"),
+                                      panId));
+    Simulator::Schedule(MilliSeconds(3),
+                        &RitWpanMacBroadcastDataWaitTest::Indicate,
+                        test,
+                        MakeDataFrame(Mac16Address("00:03"),
+                                      Mac16Address("00:01"),
+                                      Mac16Address("00:01"),
+                                      panId));
+}
+
+void
+RitWpanMacBroadcastDataWaitTest::Indicate(Ptr<Packet> frame)
+{
+    m_mac->PdDataIndication(frame->GetSize(), frame, 255);
+    m_modesAfter.push_back(m_mode);
+}
+
+void
+RitWpanMacBroadcastDataWaitTest::ModeChanged(RitMacMode oldMode, RitMacMode newMode)
+{
+    m_mode = newMode;
+}
+
+void
+RitWpanMacBroadcastDataWaitTest::MacRx(Ptr<const Packet> packet)
+{
+    m_nRx++;
+}
+
+void
+RitWpanMacBroadcastDataWaitTest::DoRun()
+{
+    Ptr<Node> node = CreateObject<Node>();
+    Ptr<RitWpanNetDevice> device = CreateObject<RitWpanNetDevice>();
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+    device->SetChannel(channel);
+    device->SetAddress(Mac16Address("00:01"));
+    device->SetRitRank(1);
+    device->SetMacRitDataWaitDuration(MilliSeconds(20));
+    node->AddDevice(device);
+
+    m_mac = device->GetMac();
+    Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+    pibAttr->macRitPeriodTime = Time(Seconds(1));
+    m_mac->MlmeSetRequest(macRitPeriodTime, pibAttr);
+    m_mac->TraceConnectWithoutContext(
+        "MacMode",
+        MakeCallback(&RitWpanMacBroadcastDataWaitTest::ModeChanged, this));
+    m_mac->TraceConnectWithoutContext(
+        "MacRx",
+        MakeCallback(&RitWpanMacBroadcastDataWaitTest::MacRx, this));
+    device->GetPhy()->TraceConnectWithoutContext(
+        "PhyTxEnd",
+        MakeBoundCallback(&RitWpanMacBroadcastDataWaitTest::BeaconSent, this));
+
+    Simulator::Stop(Seconds(3));
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_beaconSeen, true, "No beacon sent");
+    NS_TEST_ASSERT_MSG_EQ(m_modesAfter.size(), 2, "Frames not indicated");
+    NS_TEST_EXPECT_MSG_EQ(m_nRx, 2, "Frames not accepted");
+    NS_TEST_EXPECT_MSG_EQ(m_modesAfter[0],
+                          RECEIVER_MODE,
+                          "Broadcast data frame ended the data wait");
+    NS_TEST_EXPECT_MSG_NE(m_modesAfter[1],
+                          RECEIVER_MODE,
+                          "Data frame for the receiver did not end the data wait");
+
+    m_mac = nullptr;
+    Simulator::Destroy();
+}
+
+/**
+ * @brief Check that the idle cycle elision (idleCycleElisionEnabled) changes nothing but
+ * the number of events: a receiver and a sender 10 m apart exchange two data frames, and
+ * the deliveries, the beacons, the TX airtime and the time in each transceiver state are
+ * those of a run without the elision. A TrxState sink disables the elision of its node.
+ */
+class RitWpanMacIdleElisionTest : public TestCase
+{
+  public:
+    RitWpanMacIdleElisionTest();
+
+  private:
+    /**
+     * @brief What a run leaves behind.
+     */
+    struct RunResult
+    {
+        std::vector<Time> rxTimes;                 //!< Deliveries at the receiver
+        std::vector<uint32_t> nBeacons;            //!< RIT Data Requests sent, per node
+        std::vector<Time> txAirtime;               //!< TX airtime, per node
+        std::vector<PhyDutyCycleCounters> phyTime; //!< Time in each TRX state, per node
+        std::vector<uint64_t> nElided;             //!< Elided cycles, per node
+        uint64_t nEvents{0};                       //!< Events executed
+    };
+
+    /**
+     * @brief Run the exchange.
+     * @param elide Whether the elision is enabled
+     * @param traceReceiver Whether a sink is connected to the TrxState trace of the receiver
+     * @return the result of the run
+     */
+    RunResult Run(bool elide, bool traceReceiver);
+
+    /**
+     * @brief Record a data frame at the receiver.
+     * @param dev The device
+     * @param pkt The packet
+     * @param proto The protocol number
+     * @param addr The source address
+     * @return true
+     */
+    bool DataIndication(Ptr<NetDevice> dev,
+                        Ptr<const Packet> pkt,
+                        uint16_t proto,
+                        const Address& addr);
+
+    /**
+     * @brief Count a RIT Data Request handed to the PHY.
+     * @param context Index of the node
+     * @param packet The frame
+     */
+    void MacTx(std::string context, Ptr<const Packet> packet);
+
+    /**
+     * @brief Sink of the TrxState trace.
+     * @param time Time of the change
+     * @param oldState Previous state
+     * @param newState New state
+     */
+    void TrxState(Time time, PhyEnumeration oldState, PhyEnumeration newState);
+
+    void DoRun() override;
+
+    RunResult m_run; //!< Result of the current run
+};
+
+RitWpanMacIdleElisionTest::RitWpanMacIdleElisionTest()
+    : TestCase("RitWpanMac idle cycle elision against a run without it")
+{
+}
+
+bool
+RitWpanMacIdleElisionTest::DataIndication(Ptr<NetDevice> dev,
+                                          Ptr<const Packet> pkt,
+                                          uint16_t proto,
+                                          const Address& addr)
+{
+    m_run.rxTimes.push_back(Simulator::Now());
+    return true;
+}
+
+void
+RitWpanMacIdleElisionTest::MacTx(std::string context, Ptr<const Packet> packet)
+{
+    if (IsRitDataRequest(packet))
+    {
+        m_run.nBeacons[std::stoul(context)]++;
+    }
+}
+
+void
+RitWpanMacIdleElisionTest::TrxState(Time time, PhyEnumeration oldState, PhyEnumeration newState)
+{
+}
+
+RitWpanMacIdleElisionTest::RunResult
+RitWpanMacIdleElisionTest::Run(bool elide, bool traceReceiver)
+{
+    m_run = RunResult();
+    m_run.nBeacons.assign(2, 0);
+
+    Ptr<LrWpanSpectrumChannel> channel = CreateObject<LrWpanSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    RitWpanMacModuleConfig config;
+    config.idleCycleElisionEnabled = elide;
+    Ptr<MacPibAttributes> pibAttr = Create<MacPibAttributes>();
+    pibAttr->macRitPeriodTime = Time(Seconds(1));
+
+    std::vector<Ptr<RitWpanNetDevice>> devices;
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        Ptr<Node> node = CreateObject<Node>();
+        Ptr<RitWpanNetDevice> device = CreateObject<RitWpanNetDevice>();
+        Ptr<ConstantPositionMobilityModel> mobility =
+            CreateObject<ConstantPositionMobilityModel>();
+        mobility->SetPosition(Vector(10.0 * i, 0, 0));
+        device->GetPhy()->SetMobility(mobility);
+        device->SetChannel(channel);
+        device->SetAddress(Mac16Address(i == 0 ? "00:00" : "00:01"));
+        device->SetRitRank(i);
+        node->AddDevice(device);
+        Ptr<RitWpanMac> mac = device->GetMac();
+        mac->SetModuleConfig(config);
+        mac->MlmeSetRequest(macRitPeriodTime, pibAttr);
+        mac->TraceConnect("MacTx",
+                          std::to_string(i),
+                          MakeCallback(&RitWpanMacIdleElisionTest::MacTx, this));
+        devices.push_back(device);
+    }
+    devices[0]->SetReceiveCallback(
+        MakeCallback(&RitWpanMacIdleElisionTest::DataIndication, this));
+    if (traceReceiver)
+    {
+        devices[0]->GetPhy()->TraceConnectWithoutContext(
+            "TrxState",
+            MakeCallback(&RitWpanMacIdleElisionTest::TrxState, this));
+    }
+
+    const Address dst = devices[0]->GetAddress();
+    for (double at : {8.3, 12.7})
+    {
+        Simulator::ScheduleWithContext(devices[1]->GetNode()->GetId(), Seconds(at), [=]() {
+            devices[1]->Send(Create<Packet>(30), dst, 0);
+        });
+    }
+
+    const uint64_t eventsBefore = Simulator::GetEventCount();
+    Simulator::Stop(Seconds(20.0));
+    Simulator::Run();
+
+    m_run.nEvents = Simulator::GetEventCount() - eventsBefore;
+    for (const auto& device : devices)
+    {
+        m_run.txAirtime.push_back(device->GetMac()->GetTxAirtime());
+        m_run.phyTime.push_back(device->GetPhy()->GetDutyCycleCounters());
+        m_run.nElided.push_back(device->GetMac()->GetNElidedCycles());
+    }
+    Simulator::Destroy();
+    return m_run;
+}
+
+void
+RitWpanMacIdleElisionTest::DoRun()
+{
+    const RunResult plain = Run(false, false);
+    NS_TEST_ASSERT_MSG_EQ(plain.rxTimes.size(), 2, "Frames lost without the elision");
+    NS_TEST_EXPECT_MSG_EQ(plain.nElided[0] + plain.nElided[1], 0, "Elided when disabled");
+
+    for (bool traceReceiver : {false, true})
+    {
+        const RunResult elided = Run(true, traceReceiver);
+        NS_TEST_EXPECT_MSG_EQ((elided.rxTimes == plain.rxTimes), true, "Deliveries differ");
+        NS_TEST_EXPECT_MSG_EQ((elided.nBeacons == plain.nBeacons), true, "Beacons differ");
+        NS_TEST_EXPECT_MSG_EQ((elided.txAirtime == plain.txAirtime), true, "Airtime differs");
+        for (uint32_t i = 0; i < 2; i++)
+        {
+            const PhyDutyCycleCounters& a = elided.phyTime[i];
+            const PhyDutyCycleCounters& b = plain.phyTime[i];
+            NS_TEST_EXPECT_MSG_EQ(a.trxOff, b.trxOff, "TRX_OFF time of node " << i);
+            NS_TEST_EXPECT_MSG_EQ(a.rxOn, b.rxOn, "RX_ON time of node " << i);
+            NS_TEST_EXPECT_MSG_EQ(a.busyRx, b.busyRx, "BUSY_RX time of node " << i);
+            NS_TEST_EXPECT_MSG_EQ(a.txOn, b.txOn, "TX_ON time of node " << i);
+            NS_TEST_EXPECT_MSG_EQ(a.busyTx, b.busyTx, "BUSY_TX time of node " << i);
+        }
+        NS_TEST_EXPECT_MSG_GT(elided.nElided[1], 0, "No cycle of the sender elided");
+        NS_TEST_EXPECT_MSG_LT(elided.nEvents, plain.nEvents, "Elision saved no event");
+        if (traceReceiver)
+        {
+            NS_TEST_EXPECT_MSG_EQ(elided.nElided[0], 0, "Traced receiver elided its cycles");
+        }
+        else
+        {
+            NS_TEST_EXPECT_MSG_GT(elided.nElided[0], 0, "No cycle of the receiver elided");
+        }
+    }
+}
+
 class RitWpanMacTestSuite : public TestSuite
 {
   public:
@@ -155,6 +1746,17 @@ RitWpanMacTestSuite::RitWpanMacTestSuite()
     : TestSuite("rit-wpan-mac-trx-test", Type::UNIT)
 {
     AddTestCase(new RitWpanMacTrxTest, Duration::QUICK);
+    AddTestCase(new RitWpanMacBurstTest, Duration::QUICK);
+    AddTestCase(new RitWpanMacPhaseLearningTest, Duration::QUICK);
+    AddTestCase(new RitWpanMacTxQueueTest, Duration::QUICK);
+    AddTestCase(new RitWpanMacTxFrameTest, Duration::QUICK);
+    AddTestCase(new RitWpanMacMultiChannelTest, Duration::QUICK);
+    AddTestCase(new RitWpanMacFrameTrainTest, Duration::QUICK);
+    AddTestCase(new RitWpanMacDutyCycleTest, Duration::QUICK);
+    AddTestCase(new RitWpanMacBeaconTemplateTest, Duration::QUICK);
+    AddTestCase(new RitWpanMacRxFcsTest, Duration::QUICK);
+    AddTestCase(new RitWpanMacBroadcastDataWaitTest, Duration::QUICK);
+    AddTestCase(new RitWpanMacIdleElisionTest, Duration::QUICK);
 }
 
 static RitWpanMacTestSuite g_ritWpanMacTestSuite;